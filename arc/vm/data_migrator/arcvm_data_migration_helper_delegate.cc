@@ -195,6 +195,11 @@ void ArcVmDataMigrationHelperDelegate::ReportTotalSize(int total_byte_count_mb,
   metrics_->ReportTotalFileCount(total_file_count);
 }
 
+void ArcVmDataMigrationHelperDelegate::ReportMigrationSpeed(
+    int speed_kb_per_s) {
+  metrics_->ReportSpeed(speed_kb_per_s);
+}
+
 void ArcVmDataMigrationHelperDelegate::ReportFailure(
     base::File::Error error_code,
     cryptohome::data_migrator::MigrationFailedOperationType type,
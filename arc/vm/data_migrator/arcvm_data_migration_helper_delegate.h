@@ -49,6 +49,7 @@ class ArcVmDataMigrationHelperDelegate
   void ReportEndStatus(
       cryptohome::data_migrator::MigrationEndStatus status) override;
   void ReportTotalSize(int total_byte_count_mb, int total_file_count) override;
+  void ReportMigrationSpeed(int speed_kb_per_s) override;
   void ReportFailure(
       base::File::Error error_code,
       cryptohome::data_migrator::MigrationFailedOperationType type,
@@ -19,6 +19,7 @@ constexpr char kStartStatus[] = "Arc.VmDataMigration.StartStatus";
 constexpr char kEndStatus[] = "Arc.VmDataMigration.EndStatus";
 constexpr char kTotalSizeMb[] = "Arc.VmDataMigration.TotalSizeMB";
 constexpr char kTotalFileCount[] = "Arc.VmDataMigration.TotalFiles";
+constexpr char kSpeed[] = "Arc.VmDataMigration.SpeedKBPerSec";
 constexpr char kSetupResult[] = "Arc.VmDataMigration.SetupResult";
 constexpr char kFailedErrorCode[] = "Arc.VmDataMigration.FailedErrorCode";
 constexpr char kFailedOperationType[] =
@@ -71,6 +72,11 @@ void ArcVmDataMigratorMetrics::ReportTotalFileCount(int total_file_count) {
                               kNumBuckets);
 }
 
+void ArcVmDataMigratorMetrics::ReportSpeed(int speed_kb_per_s) {
+  constexpr int kMin = 1, kMax = 1024 * 1024 /* 1 GiB/s */;
+  metrics_library_->SendToUMA(kSpeed, speed_kb_per_s, kMin, kMax, kNumBuckets);
+}
+
 void ArcVmDataMigratorMetrics::ReportSetupResult(SetupResult result) {
   metrics_library_->SendEnumToUMA(kSetupResult, result);
 }
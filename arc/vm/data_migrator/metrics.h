@@ -116,6 +116,9 @@ class ArcVmDataMigratorMetrics {
   void ReportTotalByteCountInMb(int total_byte_count_mb);
   void ReportTotalFileCount(int total_file_count);
 
+  // Reports the average migration speed in KB/s.
+  void ReportSpeed(int speed_kb_per_s);
+
   // Reports the result of the setup before triggering MigrationHelper.
   void ReportSetupResult(SetupResult result);
 
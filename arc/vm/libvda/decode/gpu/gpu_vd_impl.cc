@@ -494,6 +494,13 @@ GpuVdImpl* GpuVdImpl::Create(VafConnection* conn) {
     return nullptr;
   }
 
+  // Using Unretained is safe here as the pool is destroyed first.
+  impl->session_pool_ = std::make_unique<DecodeSessionPool>(
+      base::BindRepeating(&GpuVdImpl::CreateDecodeSession,
+                          base::Unretained(impl.get())),
+      base::BindRepeating(&GpuVdImpl::CloseDecodeSession,
+                          base::Unretained(impl.get())),
+      kMaxWarmDecodeSessions, kWarmDecodeSessionIdleTimeout);
   return impl.release();
 }
 
@@ -503,6 +510,9 @@ GpuVdImpl::GpuVdImpl(VafConnection* conn)
 }
 
 GpuVdImpl::~GpuVdImpl() {
+  // Close the warm sessions while this object is alive.
+  session_pool_.reset();
+
   // Invalidate all weak pointers on the IPC thread to stop incoming callbacks.
   RunTaskOnThread(ipc_task_runner_,
                   base::BindOnce(
@@ -516,7 +526,7 @@ std::vector<vda_input_format_t> GpuVdImpl::GetSupportedInputFormats() {
   std::vector<vda_input_format_t> supported_input_formats;
 
   for (int i = 0; i < std::size(kInputFormats); i++) {
-    auto* context = InitDecodeSession(kInputFormats[i].profile);
+    auto* context = CreateDecodeSession(kInputFormats[i].profile);
     if (context) {
       supported_input_formats.emplace_back(kInputFormats[i]);
       CloseDecodeSession(context);
@@ -544,6 +554,10 @@ bool GpuVdImpl::PopulateCapabilities() {
 }
 
 VdaContext* GpuVdImpl::InitDecodeSession(vda_profile_t profile) {
+  return session_pool_->Acquire(profile);
+}
+
+VdaContext* GpuVdImpl::CreateDecodeSession(vda_profile_t profile) {
   DCHECK(!ipc_task_runner_->BelongsToCurrentThread());
   DLOG(INFO) << "Initializing decode session with profile " << profile;
 
@@ -15,6 +15,7 @@
 #include <base/threading/thread.h>
 #include <base/threading/thread_checker.h>
 
+#include "arc/vm/libvda/decode_session_pool.h"
 #include "arc/vm/libvda/decode_wrapper.h"
 #include "arc/vm/libvda/gpu/mojom/video.mojom.h"
 #include "arc/vm/libvda/gpu/vaf_connection.h"
@@ -46,6 +47,8 @@ class GpuVdImpl : public VdaImpl {
 
   std::vector<vda_input_format_t> GetSupportedInputFormats();
   bool PopulateCapabilities();
+  // Creates a new decode session, bypassing |session_pool_|.
+  VdaContext* CreateDecodeSession(vda_profile_t profile);
   void InitDecodeSessionOnIpcThread(vda_profile_t profile,
                                     base::WaitableEvent* init_complete_event,
                                     VdaContext** out_context);
@@ -62,6 +65,8 @@ class GpuVdImpl : public VdaImpl {
   scoped_refptr<base::SingleThreadTaskRunner> ipc_task_runner_;
   THREAD_CHECKER(ipc_thread_checker_);
 
+  std::unique_ptr<DecodeSessionPool> session_pool_;
+
   base::WeakPtr<GpuVdImpl> weak_this_;
   base::WeakPtrFactory<GpuVdImpl> weak_this_factory_{this};
 };
@@ -418,13 +418,16 @@ GpuVdaImpl* GpuVdaImpl::Create(VafConnection* conn) {
 
 GpuVdaImpl::GpuVdaImpl(VafConnection* conn) : connection_(conn) {}
 
-GpuVdaImpl::~GpuVdaImpl() = default;
+GpuVdaImpl::~GpuVdaImpl() {
+  // Close the warm sessions while this object is alive.
+  session_pool_.reset();
+}
 
 std::vector<vda_input_format_t> GpuVdaImpl::GetSupportedInputFormats() {
   std::vector<vda_input_format_t> supported_input_formats;
 
   for (int i = 0; i < std::size(kInputFormats); i++) {
-    auto* context = InitDecodeSession(kInputFormats[i].profile);
+    auto* context = CreateDecodeSession(kInputFormats[i].profile);
     if (context) {
       supported_input_formats.emplace_back(kInputFormats[i]);
       CloseDecodeSession(context);
@@ -459,15 +462,28 @@ bool GpuVdaImpl::Initialize() {
     return false;
   }
 
+  // Using Unretained is safe here as the pool is destroyed first.
+  session_pool_ = std::make_unique<DecodeSessionPool>(
+      base::BindRepeating(&GpuVdaImpl::CreateDecodeSession,
+                          base::Unretained(this)),
+      base::BindRepeating(&GpuVdaImpl::CloseDecodeSession,
+                          base::Unretained(this)),
+      kMaxWarmDecodeSessions, kWarmDecodeSessionIdleTimeout);
   return true;
 }
 
 VdaContext* GpuVdaImpl::InitDecodeSession(vda_profile_t profile) {
-  if (!ipc_task_runner_) {
+  if (!session_pool_) {
     DLOG(FATAL) << "InitDecodeSession called before successful Initialize().";
     return nullptr;
   }
 
+  return session_pool_->Acquire(profile);
+}
+
+VdaContext* GpuVdaImpl::CreateDecodeSession(vda_profile_t profile) {
+  DCHECK(ipc_task_runner_);
+
   // Make sure we are not running on |ipc_task_runner_| to avoid dead lock.
   // A new task is going to be scheduled on |ipc_task_runner_|, that we want
   // to block on and therefore this method can't be called on ipc thread.
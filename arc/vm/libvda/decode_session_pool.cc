@@ -0,0 +1,150 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "arc/vm/libvda/decode_session_pool.h"
+
+#include <poll.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <base/check.h>
+#include <base/functional/bind.h>
+#include <base/logging.h>
+#include <base/posix/eintr_wrapper.h>
+
+#include "arc/vm/libvda/decode_wrapper.h"
+
+namespace arc {
+namespace {
+
+// Returns true if |context| dispatched an event, which for a session which was
+// never used means that it failed.
+bool HasEvents(VdaContext* context) {
+  struct pollfd pollfd = {.fd = context->GetEventFd(), .events = POLLIN};
+  return HANDLE_EINTR(poll(&pollfd, 1, 0)) != 0;
+}
+
+}  // namespace
+
+DecodeSessionPool::DecodeSessionPool(CreateSessionCallback create_session,
+                                     CloseSessionCallback close_session,
+                                     size_t max_warm_sessions,
+                                     base::TimeDelta idle_timeout)
+    : create_session_(std::move(create_session)),
+      close_session_(std::move(close_session)),
+      max_warm_sessions_(max_warm_sessions),
+      idle_timeout_(idle_timeout),
+      warm_thread_("DecodeSessionWarmThread") {
+  CHECK(warm_thread_.Start());
+}
+
+DecodeSessionPool::~DecodeSessionPool() {
+  warm_thread_.Stop();
+
+  std::vector<WarmSession> warm_sessions;
+  {
+    base::AutoLock lock(lock_);
+    warm_sessions.swap(warm_sessions_);
+  }
+  for (const WarmSession& session : warm_sessions)
+    close_session_.Run(session.context);
+}
+
+VdaContext* DecodeSessionPool::Acquire(vda_profile_t profile) {
+  VdaContext* context = nullptr;
+  {
+    base::AutoLock lock(lock_);
+    auto it = std::find_if(
+        warm_sessions_.begin(), warm_sessions_.end(),
+        [profile](const auto& session) { return session.profile == profile; });
+    if (it != warm_sessions_.end()) {
+      context = it->context;
+      warm_sessions_.erase(it);
+    }
+  }
+
+  if (context && HasEvents(context)) {
+    LOG(WARNING) << "Dropping failed warm decode session for profile "
+                 << profile;
+    close_session_.Run(context);
+    context = nullptr;
+  }
+
+  if (context) {
+    DLOG(INFO) << "Using warm decode session for profile " << profile;
+  } else {
+    context = create_session_.Run(profile);
+    if (!context)
+      return nullptr;
+  }
+
+  // Using Unretained is safe here as the thread is stopped before the other
+  // members are destroyed.
+  warm_thread_.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&DecodeSessionPool::WarmUp,
+                                base::Unretained(this), profile));
+  return context;
+}
+
+void DecodeSessionPool::FlushForTesting() {
+  warm_thread_.FlushForTesting();
+}
+
+void DecodeSessionPool::WarmUp(vda_profile_t profile) {
+  {
+    base::AutoLock lock(lock_);
+    for (const auto& session : warm_sessions_) {
+      if (session.profile == profile)
+        return;
+    }
+  }
+
+  VdaContext* context = create_session_.Run(profile);
+  if (!context) {
+    LOG(WARNING) << "Failed to warm up a decode session for profile "
+                 << profile;
+    return;
+  }
+
+  VdaContext* evicted = nullptr;
+  {
+    base::AutoLock lock(lock_);
+    warm_sessions_.push_back({profile, context, base::TimeTicks::Now()});
+    if (warm_sessions_.size() > max_warm_sessions_) {
+      evicted = warm_sessions_.front().context;
+      warm_sessions_.erase(warm_sessions_.begin());
+    }
+  }
+  if (evicted)
+    close_session_.Run(evicted);
+
+  // Using Unretained is safe here as the thread is stopped before the other
+  // members are destroyed.
+  warm_thread_.task_runner()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&DecodeSessionPool::CloseIdleSessions,
+                     base::Unretained(this)),
+      idle_timeout_);
+}
+
+void DecodeSessionPool::CloseIdleSessions() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<VdaContext*> idle_sessions;
+  {
+    base::AutoLock lock(lock_);
+    // The sessions are sorted by |warm_time|.
+    auto it = warm_sessions_.begin();
+    while (it != warm_sessions_.end() && now - it->warm_time >= idle_timeout_) {
+      idle_sessions.push_back(it->context);
+      ++it;
+    }
+    warm_sessions_.erase(warm_sessions_.begin(), it);
+  }
+  for (VdaContext* context : idle_sessions)
+    close_session_.Run(context);
+}
+
+}  // namespace arc
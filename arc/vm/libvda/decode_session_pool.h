@@ -0,0 +1,100 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ARC_VM_LIBVDA_DECODE_SESSION_POOL_H_
+#define ARC_VM_LIBVDA_DECODE_SESSION_POOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <base/functional/callback.h>
+#include <base/synchronization/lock.h>
+#include <base/time/time.h>
+#include <base/thread_annotations.h>
+#include <base/threading/thread.h>
+
+#include "arc/vm/libvda/libvda_decode.h"
+
+namespace arc {
+
+class VdaContext;
+
+// Default maximum number of warm sessions of a decoder implementation.
+constexpr size_t kMaxWarmDecodeSessions = 2;
+
+// Default time after which an unused warm session is closed, so that hardware
+// decoder instances are not held while no app is decoding.
+constexpr base::TimeDelta kWarmDecodeSessionIdleTimeout = base::Seconds(30);
+
+// DecodeSessionPool keeps initialized decode sessions ready for the profiles
+// which were requested before, so that apps opening and closing decoders often
+// do not wait for the decoder initialization each time.
+//
+// A warm session has never been handed out, so it is indistinguishable from a
+// new one. Closed sessions are never reused since they hold the buffers of
+// their previous user. Once a warm session is handed out, another one is
+// initialized in the background for the next request of the same profile.
+//
+// This class is thread-safe.
+class DecodeSessionPool {
+ public:
+  // Creates a new decode session, blocking until it is initialized. Returns
+  // nullptr on failure.
+  using CreateSessionCallback =
+      base::RepeatingCallback<VdaContext*(vda_profile_t profile)>;
+  // Closes a decode session.
+  using CloseSessionCallback =
+      base::RepeatingCallback<void(VdaContext* context)>;
+
+  // Holds up to |max_warm_sessions| warm sessions, since each of them uses a
+  // hardware decoder instance. A warm session which is not handed out within
+  // |idle_timeout| is closed.
+  DecodeSessionPool(CreateSessionCallback create_session,
+                    CloseSessionCallback close_session,
+                    size_t max_warm_sessions,
+                    base::TimeDelta idle_timeout);
+  DecodeSessionPool(const DecodeSessionPool&) = delete;
+  DecodeSessionPool& operator=(const DecodeSessionPool&) = delete;
+
+  // Closes the warm sessions. The callbacks must remain valid until then.
+  ~DecodeSessionPool();
+
+  // Returns a decode session for |profile|, or nullptr if it could not be
+  // created.
+  VdaContext* Acquire(vda_profile_t profile);
+
+  // Waits until the background initialization of the sessions is done.
+  void FlushForTesting();
+
+ private:
+  // Initializes a warm session for |profile| if there is none. Called on
+  // |warm_thread_|.
+  void WarmUp(vda_profile_t profile);
+
+  // Closes the warm sessions which were initialized at least |idle_timeout_|
+  // ago. Called on |warm_thread_|.
+  void CloseIdleSessions();
+
+  struct WarmSession {
+    vda_profile_t profile;
+    VdaContext* context;
+    base::TimeTicks warm_time;
+  };
+
+  const CreateSessionCallback create_session_;
+  const CloseSessionCallback close_session_;
+  const size_t max_warm_sessions_;
+  const base::TimeDelta idle_timeout_;
+
+  base::Lock lock_;
+  // The warm sessions, from the least to the most recently initialized.
+  std::vector<WarmSession> warm_sessions_ GUARDED_BY(lock_);
+
+  base::Thread warm_thread_;
+};
+
+}  // namespace arc
+
+#endif  // ARC_VM_LIBVDA_DECODE_SESSION_POOL_H_
@@ -0,0 +1,130 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "arc/vm/libvda/decode_session_pool.h"
+
+#include <poll.h>
+
+#include <memory>
+
+#include <base/functional/bind.h>
+#include <base/posix/eintr_wrapper.h>
+#include <base/time/time.h>
+#include <gtest/gtest.h>
+
+#include "arc/vm/libvda/decode/fake/fake_vda_impl.h"
+
+namespace arc {
+namespace {
+
+class DecodeSessionPoolTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<DecodeSessionPool> CreatePool(
+      size_t max_warm_sessions,
+      base::TimeDelta idle_timeout = kWarmDecodeSessionIdleTimeout) {
+    return std::make_unique<DecodeSessionPool>(
+        base::BindRepeating(&DecodeSessionPoolTest::CreateSession,
+                            base::Unretained(this)),
+        base::BindRepeating(&DecodeSessionPoolTest::CloseSession,
+                            base::Unretained(this)),
+        max_warm_sessions, idle_timeout);
+  }
+
+  VdaContext* CreateSession(vda_profile_t profile) {
+    ++created_;
+    last_created_ = impl_->InitDecodeSession(profile);
+    return last_created_;
+  }
+
+  void CloseSession(VdaContext* context) {
+    ++closed_;
+    impl_->CloseDecodeSession(context);
+  }
+
+  std::unique_ptr<FakeVdaImpl> impl_{FakeVdaImpl::Create()};
+  int created_ = 0;
+  int closed_ = 0;
+  VdaContext* last_created_ = nullptr;
+};
+
+TEST_F(DecodeSessionPoolTest, WarmSessionIsUsed) {
+  auto pool = CreatePool(kMaxWarmDecodeSessions);
+  VdaContext* first = pool->Acquire(H264PROFILE_MAIN);
+  ASSERT_NE(first, nullptr);
+  pool->FlushForTesting();
+  EXPECT_EQ(created_, 2);
+  VdaContext* warm = last_created_;
+
+  VdaContext* second = pool->Acquire(H264PROFILE_MAIN);
+  EXPECT_EQ(second, warm);
+  pool->FlushForTesting();
+  // The pool is refilled.
+  EXPECT_EQ(created_, 3);
+
+  CloseSession(first);
+  CloseSession(second);
+  pool.reset();
+  EXPECT_EQ(closed_, 3);
+}
+
+TEST_F(DecodeSessionPoolTest, WarmSessionsAreBounded) {
+  auto pool = CreatePool(1);
+  VdaContext* vp8 = pool->Acquire(VP8PROFILE_MIN);
+  pool->FlushForTesting();
+  VdaContext* vp9 = pool->Acquire(VP9PROFILE_PROFILE0);
+  pool->FlushForTesting();
+  // The warm VP8 session was evicted for the VP9 one.
+  EXPECT_EQ(created_, 4);
+  EXPECT_EQ(closed_, 1);
+
+  VdaContext* other_vp8 = pool->Acquire(VP8PROFILE_MIN);
+  pool->FlushForTesting();
+  EXPECT_EQ(created_, 6);
+
+  CloseSession(vp8);
+  CloseSession(vp9);
+  CloseSession(other_vp8);
+}
+
+TEST_F(DecodeSessionPoolTest, FailedWarmSessionIsDropped) {
+  auto pool = CreatePool(kMaxWarmDecodeSessions);
+  VdaContext* first = pool->Acquire(H264PROFILE_MAIN);
+  pool->FlushForTesting();
+  VdaContext* warm = last_created_;
+
+  // Make the warm session dispatch an event, as a failure would.
+  ASSERT_EQ(warm->Flush(), SUCCESS);
+  struct pollfd pollfd = {.fd = warm->GetEventFd(), .events = POLLIN};
+  ASSERT_EQ(HANDLE_EINTR(poll(&pollfd, 1, -1)), 1);
+
+  VdaContext* second = pool->Acquire(H264PROFILE_MAIN);
+  EXPECT_NE(second, warm);
+  EXPECT_NE(second, nullptr);
+  EXPECT_EQ(closed_, 1);
+
+  CloseSession(first);
+  CloseSession(second);
+}
+
+TEST_F(DecodeSessionPoolTest, IdleWarmSessionIsClosed) {
+  auto pool = CreatePool(kMaxWarmDecodeSessions, base::TimeDelta());
+  VdaContext* first = pool->Acquire(H264PROFILE_MAIN);
+  // The first flush runs the warm-up, which posts the idle check run by the
+  // second one.
+  pool->FlushForTesting();
+  pool->FlushForTesting();
+  EXPECT_EQ(created_, 2);
+  EXPECT_EQ(closed_, 1);
+
+  // A new session is created since the warm one expired.
+  VdaContext* second = pool->Acquire(H264PROFILE_MAIN);
+  EXPECT_NE(second, nullptr);
+  EXPECT_EQ(created_, 3);
+
+  CloseSession(first);
+  CloseSession(second);
+}
+
+}  // namespace
+}  // namespace arc
@@ -4,12 +4,16 @@
 
 #include "arc/vm/libvda/event_pipe.h"
 
+#include <limits.h>
+
+#include <algorithm>
 #include <utility>
 
 #include <fcntl.h>
 
 #include <base/check.h>
 #include <base/check_op.h>
+#include <base/containers/span.h>
 #include <base/files/file_util.h>
 #include <base/functional/bind.h>
 #include <base/logging.h>
@@ -19,22 +23,9 @@
 
 namespace arc {
 
-namespace {
-// This method should only be called on the |event_write_thread| in order to
-// write |event|. This is done so that all events are sent in sequence
-// (important for PICTURE_READY events), and to ensure that a full write of
-// |event| is always done as a single operation. Using the IPC thread was
-// considered, but then in cases where the pipe buffer is close to being full,
-// write() could block, which would not be acceptable to the IPC thread.
-// Setting the pipe to non-blocking mode was also considered, but then
-// we would have to re-post a new task to complete the write which could
-// cause ordering issues.
-template <class T>
-void WriteToFd(int fd, const T event) {
-  CHECK(base::WriteFileDescriptor(fd,
-                                  base::as_bytes(base::make_span(&event, 1u))));
-}
-}  // namespace
+// Writes of at most PIPE_BUF bytes are atomic, so each event must fit.
+static_assert(sizeof(vda_event_t) <= PIPE_BUF);
+static_assert(sizeof(vea_event_t) <= PIPE_BUF);
 
 EventPipe::EventPipe() : event_write_thread_("EventWriteThread") {
   int pipe_fds[2];
@@ -54,15 +45,59 @@ int EventPipe::GetReadFd() const {
 }
 
 void EventPipe::WriteVdaEvent(const vda_event_t& event) {
-  event_write_thread_.task_runner()->PostTask(
-      FROM_HERE,
-      base::BindOnce(&WriteToFd<vda_event_t>, event_write_fd_.get(), event));
+  QueueEvent(&event, sizeof(event));
 }
 
 void EventPipe::WriteVeaEvent(const vea_event_t& event) {
+  QueueEvent(&event, sizeof(event));
+}
+
+void EventPipe::QueueEvent(const void* event, size_t size) {
+  base::AutoLock lock(lock_);
+  if (event_size_ == 0)
+    event_size_ = size;
+  DCHECK_EQ(event_size_, size);
+  const bool flush_pending = !pending_events_.empty();
+  const uint8_t* bytes = static_cast<const uint8_t*>(event);
+  pending_events_.insert(pending_events_.end(), bytes, bytes + size);
+  if (flush_pending)
+    return;
+
+  // Using Unretained is safe here as the thread is stopped before the other
+  // members are destroyed.
   event_write_thread_.task_runner()->PostTask(
       FROM_HERE,
-      base::BindOnce(&WriteToFd<vea_event_t>, event_write_fd_.get(), event));
+      base::BindOnce(&EventPipe::FlushEvents, base::Unretained(this)));
+}
+
+// All events are written on |event_write_thread_| so that they are sent in
+// sequence (important for PICTURE_READY events), and so that each event is
+// written whole. Using the IPC thread was considered, but then in cases where
+// the pipe buffer is close to being full, write() could block, which would not
+// be acceptable to the IPC thread. Setting the pipe to non-blocking mode was
+// also considered, but then we would have to re-post a new task to complete the
+// write which could cause ordering issues.
+//
+// The events queued since the last flush are written together, which saves a
+// syscall and a wakeup of the reader per event at high frame rates. Each
+// write() holds whole events and at most PIPE_BUF bytes, so that it stays
+// atomic.
+void EventPipe::FlushEvents() {
+  std::vector<uint8_t> events;
+  size_t event_size;
+  {
+    base::AutoLock lock(lock_);
+    events.swap(pending_events_);
+    event_size = event_size_;
+  }
+  const size_t max_write_size = PIPE_BUF / event_size * event_size;
+  base::span<const uint8_t> remaining(events);
+  while (!remaining.empty()) {
+    const size_t write_size = std::min(remaining.size(), max_write_size);
+    CHECK(base::WriteFileDescriptor(event_write_fd_.get(),
+                                    remaining.first(write_size)));
+    remaining = remaining.subspan(write_size);
+  }
 }
 
 }  // namespace arc
@@ -5,7 +5,14 @@
 #ifndef ARC_VM_LIBVDA_EVENT_PIPE_H_
 #define ARC_VM_LIBVDA_EVENT_PIPE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
 #include <base/files/scoped_file.h>
+#include <base/synchronization/lock.h>
+#include <base/thread_annotations.h>
 #include <base/threading/thread.h>
 
 typedef struct vda_event vda_event_t;
@@ -14,7 +21,8 @@ typedef struct vea_event vea_event_t;
 namespace arc {
 
 // EventPipe is responsible for creating a pipe and a corresponding
-// thread for atomic writes.
+// thread for atomic writes. Events queued while the thread is busy writing are
+// batched into the next write.
 class EventPipe {
  public:
   EventPipe();
@@ -35,9 +43,23 @@ class EventPipe {
   void WriteVeaEvent(const vea_event_t& event);
 
  private:
+  // Appends |size| bytes of |event| to the pending events. All the events of
+  // a pipe must have the same size.
+  void QueueEvent(const void* event, size_t size);
+
+  // Writes all the pending events, in writes of whole events of at most
+  // PIPE_BUF bytes. Called on |event_write_thread_|.
+  void FlushEvents();
+
   base::ScopedFD event_read_fd_;
   base::ScopedFD event_write_fd_;
 
+  base::Lock lock_;
+  // Events not written yet. A flush task is pending while it is not empty.
+  std::vector<uint8_t> pending_events_ GUARDED_BY(lock_);
+  // Size of the events written to the pipe, or 0 if none was queued yet.
+  size_t event_size_ GUARDED_BY(lock_) = 0;
+
   base::Thread event_write_thread_;
 };
 
@@ -0,0 +1,37 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "arc/vm/libvda/event_pipe.h"
+
+#include <base/files/file_util.h>
+#include <gtest/gtest.h>
+
+#include "arc/vm/libvda/libvda_decode.h"
+
+namespace arc {
+namespace {
+
+// Test that batched events are all received whole and in order.
+TEST(EventPipeTest, EventsAreReadInOrder) {
+  constexpr int kNumEvents = 1000;
+  EventPipe event_pipe;
+  for (int i = 0; i < kNumEvents; i++) {
+    vda_event_t event;
+    event.event_type = NOTIFY_END_OF_BITSTREAM_BUFFER;
+    event.event_data.bitstream_id = i;
+    event_pipe.WriteVdaEvent(event);
+  }
+
+  for (int i = 0; i < kNumEvents; i++) {
+    vda_event_t event;
+    ASSERT_TRUE(base::ReadFromFD(event_pipe.GetReadFd(),
+                                 reinterpret_cast<char*>(&event),
+                                 sizeof(event)));
+    EXPECT_EQ(event.event_type, NOTIFY_END_OF_BITSTREAM_BUFFER);
+    EXPECT_EQ(event.event_data.bitstream_id, i);
+  }
+}
+
+}  // namespace
+}  // namespace arc
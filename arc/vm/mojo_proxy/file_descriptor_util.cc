@@ -158,16 +158,23 @@ ssize_t Sendmsg(int fd,
                 const void* buf,
                 size_t length,
                 const std::vector<base::ScopedFD>& fds) {
+  struct iovec iov = {const_cast<void*>(buf), length};
+  return Sendmsg(fd, &iov, 1, fds);
+}
+
+ssize_t Sendmsg(int fd,
+                const struct iovec* iov,
+                size_t iovlen,
+                const std::vector<base::ScopedFD>& fds) {
   if (fds.size() >= kMaxNumFileDescriptors) {
     LOG(ERROR) << "Too many FDs: " << fds.size();
     errno = EINVAL;
     return -1;
   }
   char control_buffer[CMSG_SPACE(kMaxNumFileDescriptors * sizeof(int))];
-  struct iovec iov = {const_cast<void*>(buf), length};
   struct msghdr msg = {
-      .msg_iov = &iov,
-      .msg_iovlen = 1,
+      .msg_iov = const_cast<struct iovec*>(iov),
+      .msg_iovlen = iovlen,
       .msg_control = control_buffer,
       .msg_controllen = CMSG_SPACE(fds.size() * sizeof(int)),
   };
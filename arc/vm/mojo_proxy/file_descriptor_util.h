@@ -5,6 +5,8 @@
 #ifndef ARC_VM_MOJO_PROXY_FILE_DESCRIPTOR_UTIL_H_
 #define ARC_VM_MOJO_PROXY_FILE_DESCRIPTOR_UTIL_H_
 
+#include <sys/uio.h>
+
 #include <optional>
 #include <string>
 #include <utility>
@@ -50,6 +52,12 @@ ssize_t Sendmsg(int fd,
                 size_t length,
                 const std::vector<base::ScopedFD>& fds);
 
+// Same as above, but sends the data of the |iovlen| buffers of |iov| in order.
+ssize_t Sendmsg(int fd,
+                const struct iovec* iov,
+                size_t iovlen,
+                const std::vector<base::ScopedFD>& fds);
+
 // Calls recvmsg and returns the number of bytes received on success.
 // On error, returns -1 and sets errno appropriately.
 ssize_t Recvmsg(int fd,
@@ -4,6 +4,9 @@
 
 #include "arc/vm/mojo_proxy/message_stream.h"
 
+#include <sys/uio.h>
+
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -39,19 +42,28 @@ bool ReceiveData(int fd,
   return true;
 }
 
-// Sends data and FDs to the given socket FD and return true upon success.
+// Sends the data of |iov| and FDs to the given socket FD and returns true upon
+// success.
 bool SendMsg(int fd,
-             const char* buf,
-             size_t size,
+             const struct iovec* iov,
+             size_t iovlen,
              const std::vector<base::ScopedFD>& fds) {
-  ssize_t written = Sendmsg(fd, buf, size, fds);
+  ssize_t written = Sendmsg(fd, iov, iovlen, fds);
   if (written < 0) {
     PLOG(ERROR) << "Failed to write proto";
     return false;
   }
 
-  if (written < size) {
-    auto sp = base::StringPiece(buf + written, size - written);
+  // Write the rest, if any, in the same order.
+  size_t skip = written;
+  for (size_t i = 0; i < iovlen; ++i) {
+    if (skip >= iov[i].iov_len) {
+      skip -= iov[i].iov_len;
+      continue;
+    }
+    const char* base = static_cast<const char*>(iov[i].iov_base);
+    auto sp = base::StringPiece(base + skip, iov[i].iov_len - skip);
+    skip = 0;
     if (!base::WriteFileDescriptor(fd, std::move(sp))) {
       PLOG(ERROR) << "Failed to write proto";
       return false;
@@ -61,6 +73,103 @@ bool SendMsg(int fd,
   return true;
 }
 
+// Appends |value| to |out| as a base 128 varint.
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Appends the key of the length-delimited field |field_number| and |length|.
+void AppendLengthDelimitedKey(int field_number,
+                              uint64_t length,
+                              std::string* out) {
+  constexpr uint64_t kWireTypeLengthDelimited = 2;
+  AppendVarint(
+      (static_cast<uint64_t>(field_number) << 3) | kWireTypeLengthDelimited,
+      out);
+  AppendVarint(length, out);
+}
+
+// Returns true if the blob of |message| is large enough to be sent without
+// copying it.
+bool HasBulkData(const arc_proxy::MojoMessage& message) {
+  switch (message.command_case()) {
+    case arc_proxy::MojoMessage::kData:
+      return message.data().blob().size() >= MessageStream::kBulkDataThreshold;
+    case arc_proxy::MojoMessage::kPreadResponse:
+      return message.pread_response().blob().size() >=
+             MessageStream::kBulkDataThreshold;
+    case arc_proxy::MojoMessage::kPwriteRequest:
+      return message.pwrite_request().blob().size() >=
+             MessageStream::kBulkDataThreshold;
+    default:
+      return false;
+  }
+}
+
+// Returns the blob of |message| if HasBulkData() is true for it, and appends
+// |message| serialized without the blob, up to the blob's key and length, to
+// |header|, so that the header followed by the blob is parsed as |message|.
+// This relies on protobuf accepting fields in any order, as the blob is not
+// always the last field. Returns nullptr otherwise.
+const std::string* SerializeBulkHeader(const arc_proxy::MojoMessage& message,
+                                       std::string* header) {
+  if (!HasBulkData(message))
+    return nullptr;
+
+  std::string command;
+  const std::string* blob = nullptr;
+  int command_field_number = 0;
+  int blob_field_number = 0;
+  switch (message.command_case()) {
+    case arc_proxy::MojoMessage::kData: {
+      const auto& data = message.data();
+      arc_proxy::Data fields;
+      fields.set_handle(data.handle());
+      *fields.mutable_transferred_fd() = data.transferred_fd();
+      fields.SerializeToString(&command);
+      blob = &data.blob();
+      command_field_number = arc_proxy::MojoMessage::kDataFieldNumber;
+      blob_field_number = arc_proxy::Data::kBlobFieldNumber;
+      break;
+    }
+    case arc_proxy::MojoMessage::kPreadResponse: {
+      const auto& response = message.pread_response();
+      arc_proxy::PreadResponse fields;
+      fields.set_cookie(response.cookie());
+      fields.set_error_code(response.error_code());
+      fields.SerializeToString(&command);
+      blob = &response.blob();
+      command_field_number = arc_proxy::MojoMessage::kPreadResponseFieldNumber;
+      blob_field_number = arc_proxy::PreadResponse::kBlobFieldNumber;
+      break;
+    }
+    case arc_proxy::MojoMessage::kPwriteRequest: {
+      const auto& request = message.pwrite_request();
+      arc_proxy::PwriteRequest fields;
+      fields.set_cookie(request.cookie());
+      fields.set_handle(request.handle());
+      fields.set_offset(request.offset());
+      fields.SerializeToString(&command);
+      blob = &request.blob();
+      command_field_number = arc_proxy::MojoMessage::kPwriteRequestFieldNumber;
+      blob_field_number = arc_proxy::PwriteRequest::kBlobFieldNumber;
+      break;
+    }
+    default:
+      return nullptr;
+  }
+
+  AppendLengthDelimitedKey(blob_field_number, blob->size(), &command);
+  AppendLengthDelimitedKey(command_field_number,
+                           command.size() + blob->size(), header);
+  header->append(command);
+  return blob;
+}
+
 }  // namespace
 
 MessageStream::MessageStream(base::ScopedFD fd) : fd_(std::move(fd)) {}
@@ -93,22 +202,61 @@ bool MessageStream::Read(arc_proxy::MojoMessage* message,
 
 bool MessageStream::Write(const arc_proxy::MojoMessage& message,
                           const std::vector<base::ScopedFD>& fds) {
-  const uint64_t size = message.ByteSizeLong();
-  buf_.resize(sizeof(size) + size);
+  // Keep the order of the messages.
+  if (!Flush())
+    return false;
+
+  // Leave room for the size, which is set once the frame is built.
+  uint64_t size = 0;
+  frame_.assign(sizeof(size), '\0');
+  const std::string* blob = SerializeBulkHeader(message, &frame_);
+  if (blob) {
+    size = frame_.size() - sizeof(size) + blob->size();
+  } else {
+    if (!message.AppendToString(&frame_)) {
+      LOG(ERROR) << "Failed to serialize proto.";
+      return false;
+    }
+    size = frame_.size() - sizeof(size);
+  }
+  memcpy(frame_.data(), &size, sizeof(size));
 
-  struct Frame {
-    uint64_t size;
-    char data[];
+  struct iovec iov[] = {
+      {frame_.data(), frame_.size()},
+      {blob ? const_cast<char*>(blob->data()) : nullptr,
+       blob ? blob->size() : 0},
   };
-  Frame* frame = reinterpret_cast<Frame*>(buf_.data());
-  frame->size = size;
-  if (!message.SerializeToArray(frame->data, size)) {
+  if (!SendMsg(fd_.get(), iov, blob ? 2 : 1, fds)) {
+    PLOG(ERROR) << "Failed to write proto";
+    return false;
+  }
+  return true;
+}
+
+bool MessageStream::Enqueue(const arc_proxy::MojoMessage& message) {
+  if (HasBulkData(message))
+    return Write(message, {});
+
+  const uint64_t size = message.ByteSizeLong();
+  pending_frames_.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  if (!message.AppendToString(&pending_frames_)) {
     LOG(ERROR) << "Failed to serialize proto.";
     return false;
   }
+  if (pending_frames_.size() >= kMaxBatchSize)
+    return Flush();
+  return true;
+}
 
-  if (!SendMsg(fd_.get(), buf_.data(), buf_.size(), fds)) {
-    PLOG(ERROR) << "Failed to write proto";
+bool MessageStream::Flush() {
+  if (pending_frames_.empty())
+    return true;
+
+  struct iovec iov = {pending_frames_.data(), pending_frames_.size()};
+  const bool result = SendMsg(fd_.get(), &iov, 1, {});
+  pending_frames_.clear();
+  if (!result) {
+    PLOG(ERROR) << "Failed to write batched protos";
     return false;
   }
   return true;
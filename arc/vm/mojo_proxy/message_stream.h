@@ -5,6 +5,7 @@
 #ifndef ARC_VM_MOJO_PROXY_MESSAGE_STREAM_H_
 #define ARC_VM_MOJO_PROXY_MESSAGE_STREAM_H_
 
+#include <string>
 #include <vector>
 
 #include <base/files/scoped_file.h>
@@ -14,8 +15,20 @@
 namespace arc {
 
 // MessageStream exchanges messages with the other proxy process.
+//
+// Each message is sent as a frame made of its size followed by the serialized
+// message. Frames can be batched to be sent together, which the other side
+// reads as usual, and the large data of Data, PreadResponse and PwriteRequest
+// messages is sent from where it is stored instead of being copied into the
+// frame.
 class MessageStream {
  public:
+  // Messages carrying at least this much data have it sent without copying.
+  static constexpr size_t kBulkDataThreshold = 16 * 1024;
+
+  // Batched frames are sent once they add up to this size.
+  static constexpr size_t kMaxBatchSize = 64 * 1024;
+
   explicit MessageStream(base::ScopedFD fd);
   MessageStream(const MessageStream&) = delete;
   MessageStream& operator=(const MessageStream&) = delete;
@@ -29,14 +42,31 @@ class MessageStream {
   // message and FDs into |message| and |fds| on success. Otherwise false.
   bool Read(arc_proxy::MojoMessage* message, std::vector<base::ScopedFD>* fds);
 
-  // Writes the serialized |message| to the socket.
+  // Writes the serialized |message| to the socket, after the batched frames.
   // Returns true iff the whole message is written.
   bool Write(const arc_proxy::MojoMessage& message,
              const std::vector<base::ScopedFD>& fds);
 
+  // Adds |message| to the batch of frames to be sent by Flush(). The batch is
+  // sent right away if it is full, or if |message| carries bulk data.
+  // Returns false if the message could not be serialized or sent.
+  bool Enqueue(const arc_proxy::MojoMessage& message);
+
+  // Sends the batched frames. Returns true iff they are all written.
+  bool Flush();
+
+  // Returns true if there are batched frames not sent yet.
+  bool HasPendingFrames() const { return !pending_frames_.empty(); }
+
  private:
   base::ScopedFD fd_;
   std::vector<char> buf_;
+
+  // The frame being written by Write(), without its bulk data.
+  std::string frame_;
+
+  // Frames batched by Enqueue().
+  std::string pending_frames_;
 };
 
 }  // namespace arc
@@ -6,6 +6,7 @@
 
 #include <sys/socket.h>
 
+#include <string>
 #include <tuple>
 #include <utility>
 
@@ -40,5 +41,92 @@ TEST(MessageStreamTest, ReadWrite) {
   EXPECT_EQ(message.data().blob(), read_message.data().blob());
 }
 
+TEST(MessageStreamTest, WriteBulkData) {
+  auto sockpair = CreateSocketPair(SOCK_STREAM);
+  ASSERT_TRUE(sockpair.has_value());
+  base::ScopedFD fd1;
+  base::ScopedFD fd2;
+  std::tie(fd1, fd2) = std::move(sockpair).value();
+
+  const std::string blob(MessageStream::kBulkDataThreshold * 2, 'x');
+  arc_proxy::MojoMessage data_message;
+  data_message.mutable_data()->set_handle(10);
+  data_message.mutable_data()->set_blob(blob);
+  data_message.mutable_data()->add_transferred_fd()->set_handle(20);
+  arc_proxy::MojoMessage pwrite_message;
+  pwrite_message.mutable_pwrite_request()->set_cookie(30);
+  pwrite_message.mutable_pwrite_request()->set_handle(40);
+  pwrite_message.mutable_pwrite_request()->set_offset(50);
+  pwrite_message.mutable_pwrite_request()->set_blob(blob);
+  {
+    MessageStream stream(std::move(fd1));
+    ASSERT_TRUE(stream.Write(data_message, {}));
+    ASSERT_TRUE(stream.Write(pwrite_message, {}));
+  }
+
+  MessageStream stream(std::move(fd2));
+  arc_proxy::MojoMessage read_message;
+  ASSERT_TRUE(stream.Read(&read_message, nullptr));
+  ASSERT_TRUE(read_message.has_data());
+  EXPECT_EQ(10, read_message.data().handle());
+  EXPECT_EQ(blob, read_message.data().blob());
+  ASSERT_EQ(1, read_message.data().transferred_fd_size());
+  EXPECT_EQ(20, read_message.data().transferred_fd(0).handle());
+
+  ASSERT_TRUE(stream.Read(&read_message, nullptr));
+  ASSERT_TRUE(read_message.has_pwrite_request());
+  EXPECT_EQ(30, read_message.pwrite_request().cookie());
+  EXPECT_EQ(40, read_message.pwrite_request().handle());
+  EXPECT_EQ(50, read_message.pwrite_request().offset());
+  EXPECT_EQ(blob, read_message.pwrite_request().blob());
+}
+
+TEST(MessageStreamTest, EnqueueFlush) {
+  auto sockpair = CreateSocketPair(SOCK_STREAM);
+  ASSERT_TRUE(sockpair.has_value());
+  base::ScopedFD fd1;
+  base::ScopedFD fd2;
+  std::tie(fd1, fd2) = std::move(sockpair).value();
+
+  const std::string blob(MessageStream::kBulkDataThreshold, 'x');
+  {
+    MessageStream stream(std::move(fd1));
+    for (int i = 1; i <= 3; ++i) {
+      arc_proxy::MojoMessage message;
+      message.mutable_close()->set_handle(i);
+      ASSERT_TRUE(stream.Enqueue(message));
+    }
+    EXPECT_TRUE(stream.HasPendingFrames());
+
+    // Bulk data is sent right away, after the batched messages.
+    arc_proxy::MojoMessage message;
+    message.mutable_pread_response()->set_cookie(4);
+    message.mutable_pread_response()->set_blob(blob);
+    ASSERT_TRUE(stream.Enqueue(message));
+    EXPECT_FALSE(stream.HasPendingFrames());
+
+    message.Clear();
+    message.mutable_close()->set_handle(5);
+    ASSERT_TRUE(stream.Enqueue(message));
+    ASSERT_TRUE(stream.Flush());
+    EXPECT_FALSE(stream.HasPendingFrames());
+  }
+
+  MessageStream stream(std::move(fd2));
+  arc_proxy::MojoMessage read_message;
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_TRUE(stream.Read(&read_message, nullptr));
+    ASSERT_TRUE(read_message.has_close());
+    EXPECT_EQ(i, read_message.close().handle());
+  }
+  ASSERT_TRUE(stream.Read(&read_message, nullptr));
+  ASSERT_TRUE(read_message.has_pread_response());
+  EXPECT_EQ(4, read_message.pread_response().cookie());
+  EXPECT_EQ(blob, read_message.pread_response().blob());
+  ASSERT_TRUE(stream.Read(&read_message, nullptr));
+  ASSERT_TRUE(read_message.has_close());
+  EXPECT_EQ(5, read_message.close().handle());
+}
+
 }  // namespace
 }  // namespace arc
@@ -284,27 +284,39 @@ void ProxyFileSystem::Read(fuse_req_t req,
                            size_t size,
                            off_t off,
                            struct fuse_file_info* fi) {
+  auto state = GetState(ino);
+  const bool use_cache = state.has_value() && state->read_only;
   delegate_task_runner_->PostTask(
       FROM_HERE,
       base::BindOnce(&ProxyFileSystem::ReadInternal, base::Unretained(this),
-                     req, fi->fh, size, off));
+                     req, fi->fh, size, off, use_cache));
 }
 
 void ProxyFileSystem::ReadInternal(fuse_req_t req,
                                    int64_t handle,
                                    size_t size,
-                                   off_t off) {
-  delegate_->Pread(
-      handle, size, off,
-      base::BindOnce(
-          [](fuse_req_t req, int error_code, const std::string& blob) {
-            if (error_code == 0) {
-              fuse_reply_buf(req, blob.data(), blob.size());
-            } else {
-              fuse_reply_err(req, error_code);
-            }
-          },
-          req));
+                                   off_t off,
+                                   bool use_cache) {
+  auto callback = base::BindOnce(
+      [](fuse_req_t req, int error_code, const std::string& blob) {
+        if (error_code == 0) {
+          fuse_reply_buf(req, blob.data(), blob.size());
+        } else {
+          fuse_reply_err(req, error_code);
+        }
+      },
+      req);
+  if (!use_cache) {
+    delegate_->Pread(handle, size, off, std::move(callback));
+    return;
+  }
+
+  auto& cache = read_caches_[handle];
+  if (!cache) {
+    cache = std::make_unique<ReadAheadCache>(base::BindRepeating(
+        &Delegate::Pread, base::Unretained(delegate_), handle));
+  }
+  cache->Read(size, off, std::move(callback));
 }
 
 void ProxyFileSystem::Write(fuse_req_t req,
@@ -354,9 +366,12 @@ void ProxyFileSystem::Release(fuse_req_t req,
   // is safe.
   delegate_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce([](ProxyFileSystem* self,
-                        int64_t handle) { self->delegate_->Close(handle); },
-                     this, fi->fh));
+      base::BindOnce(
+          [](ProxyFileSystem* self, int64_t handle) {
+            self->read_caches_.erase(handle);
+            self->delegate_->Close(handle);
+          },
+          this, fi->fh));
   fuse_reply_err(req, 0);
 }
 
@@ -402,6 +417,7 @@ base::ScopedFD ProxyFileSystem::RegisterHandle(int64_t handle, int32_t flags) {
     State state = {
         .handle = handle,
         .is_open = false,
+        .read_only = (flags & O_ACCMODE) == O_RDONLY,
     };
     inode = next_inode_++;
     if (!inode_to_state_.emplace(inode, state).second) {
@@ -23,6 +23,7 @@
 #include <base/synchronization/lock.h>
 
 #include "arc/vm/mojo_proxy/mojo_proxy.h"
+#include "arc/vm/mojo_proxy/read_ahead_cache.h"
 
 namespace base {
 class TaskRunner;
@@ -113,7 +114,13 @@ class ProxyFileSystem {
   void SetAttrInternal(fuse_req_t req, int64_t handle, struct stat stat);
 
   // Helper to operate Read(). Called on the |delegate_task_runner_|.
-  void ReadInternal(fuse_req_t req, int64_t handle, size_t size, off_t off);
+  // If |use_cache| is true, the read goes through the ReadAheadCache of the
+  // handle.
+  void ReadInternal(fuse_req_t req,
+                    int64_t handle,
+                    size_t size,
+                    off_t off,
+                    bool use_cache);
 
   // Helper to operate Write(). Called on the |delegate_task_runner_|.
   void WriteInternal(fuse_req_t req,
@@ -126,6 +133,9 @@ class ProxyFileSystem {
   struct State {
     int64_t handle = 0;
     bool is_open = false;
+    // Read-only files are assumed not to be modified while they are open, so
+    // that the reads can be cached.
+    bool read_only = false;
   };
   std::optional<State> GetState(fuse_ino_t inode);
 
@@ -140,6 +150,9 @@ class ProxyFileSystem {
       2;  // 1 is reserved for the root directory.
   base::Lock inode_lock_;
 
+  // Caches of the read-only handles. Accessed on |delegate_task_runner_|.
+  std::map<int64_t, std::unique_ptr<ReadAheadCache>> read_caches_;
+
   scoped_refptr<base::TaskRunner> init_task_runner_;
 };
 
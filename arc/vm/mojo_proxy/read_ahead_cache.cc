@@ -0,0 +1,171 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "arc/vm/mojo_proxy/read_ahead_cache.h"
+
+#include <errno.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <base/functional/bind.h>
+
+namespace arc {
+
+ReadAheadCache::ReadAheadCache(ReadFunction read) : read_(std::move(read)) {}
+
+ReadAheadCache::~ReadAheadCache() {
+  for (auto& read : pending_reads_)
+    std::move(read.callback).Run(EIO, std::string());
+}
+
+void ReadAheadCache::Read(uint64_t count,
+                          uint64_t offset,
+                          ReadCallback callback) {
+  const bool sequential = offset == next_offset_;
+  next_offset_ = offset + count;
+  read_ahead_blocks_ =
+      sequential ? std::clamp<uint64_t>(read_ahead_blocks_ * 2, 1,
+                                        kMaxReadAheadBlocks)
+                 : 0;
+
+  if (count == 0) {
+    std::move(callback).Run(0, std::string());
+    return;
+  }
+
+  const uint64_t first = offset / kBlockSize;
+  const uint64_t last = (offset + count - 1) / kBlockSize;
+  if (!sequential && !HasBlocks(first, last)) {
+    // Random reads are not worth caching, so read only what is asked.
+    read_.Run(count, offset, std::move(callback));
+    return;
+  }
+
+  for (uint64_t index = first; index <= last + read_ahead_blocks_; ++index)
+    FetchBlock(index);
+  pending_reads_.push_back({count, offset, std::move(callback)});
+  CompletePendingReads();
+  EvictBlocks();
+}
+
+void ReadAheadCache::FetchBlock(uint64_t index) {
+  if (last_block_.has_value() && index > last_block_.value())
+    return;
+  if (!blocks_.emplace(index, Block()).second)
+    return;
+  read_.Run(kBlockSize, index * kBlockSize,
+            base::BindOnce(&ReadAheadCache::OnBlockRead,
+                           weak_factory_.GetWeakPtr(), index));
+}
+
+void ReadAheadCache::OnBlockRead(uint64_t index,
+                                 int error_code,
+                                 const std::string& data) {
+  auto it = blocks_.find(index);
+  if (it == blocks_.end())
+    return;
+  Block& block = it->second;
+  block.ready = true;
+  block.error_code = error_code;
+  block.data = data;
+  block.last_used = ++use_count_;
+  if (error_code == 0 && data.size() < kBlockSize) {
+    last_block_ = std::min(last_block_.value_or(index), index);
+  }
+
+  CompletePendingReads();
+  // Let the following reads try again.
+  if (error_code != 0)
+    blocks_.erase(index);
+  EvictBlocks();
+}
+
+void ReadAheadCache::CompletePendingReads() {
+  std::vector<uint64_t> missing_blocks;
+  for (auto it = pending_reads_.begin(); it != pending_reads_.end();) {
+    if (TryCompleteRead(&*it, &missing_blocks))
+      it = pending_reads_.erase(it);
+    else
+      ++it;
+  }
+  // Fetch them once done with |pending_reads_|, as the read may complete
+  // synchronously.
+  for (uint64_t index : missing_blocks)
+    FetchBlock(index);
+}
+
+bool ReadAheadCache::TryCompleteRead(PendingRead* read,
+                                     std::vector<uint64_t>* missing_blocks) {
+  const uint64_t end = read->offset + read->count;
+  std::string data;
+  for (uint64_t index = read->offset / kBlockSize; index * kBlockSize < end;
+       ++index) {
+    if (last_block_.has_value() && index > last_block_.value())
+      break;
+    auto it = blocks_.find(index);
+    if (it == blocks_.end()) {
+      // The block was dropped after an error.
+      missing_blocks->push_back(index);
+      return false;
+    }
+    Block& block = it->second;
+    if (!block.ready)
+      return false;
+    if (block.error_code != 0) {
+      std::move(read->callback).Run(block.error_code, std::string());
+      return true;
+    }
+    block.last_used = ++use_count_;
+
+    const uint64_t block_offset = index * kBlockSize;
+    const uint64_t begin = std::max(read->offset, block_offset) - block_offset;
+    const uint64_t block_end =
+        std::min<uint64_t>(end - block_offset, block.data.size());
+    if (begin < block_end)
+      data.append(block.data, begin, block_end - begin);
+    if (block.data.size() < kBlockSize)
+      break;
+  }
+  std::move(read->callback).Run(0, data);
+  return true;
+}
+
+void ReadAheadCache::EvictBlocks() {
+  while (blocks_.size() > kMaxCachedBlocks) {
+    // Keep the blocks being read, and the ones the pending reads need.
+    auto victim = blocks_.end();
+    for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+      const uint64_t block_offset = it->first * kBlockSize;
+      const bool needed = std::any_of(
+          pending_reads_.begin(), pending_reads_.end(),
+          [block_offset](const PendingRead& read) {
+            return read.offset < block_offset + kBlockSize &&
+                   block_offset < read.offset + read.count;
+          });
+      if (!it->second.ready || needed)
+        continue;
+      if (victim == blocks_.end() ||
+          it->second.last_used < victim->second.last_used) {
+        victim = it;
+      }
+    }
+    if (victim == blocks_.end())
+      return;
+    blocks_.erase(victim);
+  }
+}
+
+bool ReadAheadCache::HasBlocks(uint64_t first, uint64_t last) const {
+  for (uint64_t index = first; index <= last; ++index) {
+    if (last_block_.has_value() && index > last_block_.value())
+      return true;
+    if (blocks_.count(index) == 0)
+      return false;
+  }
+  return true;
+}
+
+}  // namespace arc
@@ -0,0 +1,108 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ARC_VM_MOJO_PROXY_READ_AHEAD_CACHE_H_
+#define ARC_VM_MOJO_PROXY_READ_AHEAD_CACHE_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <base/functional/callback.h>
+#include <base/memory/weak_ptr.h>
+
+namespace arc {
+
+// ReadAheadCache caches the blocks read from a file which is not modified
+// while it is open, and reads blocks ahead when the file is read sequentially.
+// The read-ahead window starts at a block and is doubled on each sequential
+// read, up to kMaxReadAheadBlocks. A read at another offset resets it, and is
+// passed through as is unless it is already cached.
+// This class is not thread-safe, and the read function must run its callback
+// on the same sequence.
+class ReadAheadCache {
+ public:
+  static constexpr uint64_t kBlockSize = 128 * 1024;
+  static constexpr uint64_t kMaxReadAheadBlocks = 8;
+  static constexpr size_t kMaxCachedBlocks = 16;
+
+  // Runs with the error code, which is 0 on success or errno, and the data.
+  using ReadCallback = base::OnceCallback<void(int, const std::string&)>;
+
+  // Reads |count| bytes at |offset| from the file.
+  using ReadFunction = base::RepeatingCallback<void(
+      uint64_t count, uint64_t offset, ReadCallback callback)>;
+
+  explicit ReadAheadCache(ReadFunction read);
+  ReadAheadCache(const ReadAheadCache&) = delete;
+  ReadAheadCache& operator=(const ReadAheadCache&) = delete;
+
+  // Runs the callbacks of the reads still waiting for data with EIO.
+  ~ReadAheadCache();
+
+  // Reads |count| bytes at |offset| from the file, and runs |callback| with
+  // the result.
+  void Read(uint64_t count, uint64_t offset, ReadCallback callback);
+
+ private:
+  struct Block {
+    bool ready = false;
+    int error_code = 0;
+    std::string data;
+    uint64_t last_used = 0;
+  };
+
+  struct PendingRead {
+    uint64_t count;
+    uint64_t offset;
+    ReadCallback callback;
+  };
+
+  // Reads the block at |index| if it is neither cached nor being read.
+  void FetchBlock(uint64_t index);
+
+  // Called when the block at |index| is read.
+  void OnBlockRead(uint64_t index, int error_code, const std::string& data);
+
+  // Completes the pending reads whose blocks are all read.
+  void CompletePendingReads();
+
+  // Completes |read| and returns true if its blocks are all read. Otherwise,
+  // adds the blocks to be fetched again to |missing_blocks|, and returns
+  // false.
+  bool TryCompleteRead(PendingRead* read,
+                       std::vector<uint64_t>* missing_blocks);
+
+  // Drops the least recently used blocks beyond kMaxCachedBlocks.
+  void EvictBlocks();
+
+  // Returns true if the blocks from |first| to |last| are all cached or being
+  // read.
+  bool HasBlocks(uint64_t first, uint64_t last) const;
+
+  ReadFunction read_;
+
+  // Cached blocks, keyed by their index.
+  std::map<uint64_t, Block> blocks_;
+  uint64_t use_count_ = 0;
+
+  // Index of the last block of the file, once a short block is read.
+  std::optional<uint64_t> last_block_;
+
+  std::list<PendingRead> pending_reads_;
+
+  // The offset following the last read, and the current read-ahead window.
+  uint64_t next_offset_ = 0;
+  uint64_t read_ahead_blocks_ = 0;
+
+  base::WeakPtrFactory<ReadAheadCache> weak_factory_{this};
+};
+
+}  // namespace arc
+
+#endif  // ARC_VM_MOJO_PROXY_READ_AHEAD_CACHE_H_
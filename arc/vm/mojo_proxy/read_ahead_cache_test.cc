@@ -0,0 +1,182 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "arc/vm/mojo_proxy/read_ahead_cache.h"
+
+#include <errno.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <base/functional/bind.h>
+#include <gtest/gtest.h>
+
+namespace arc {
+namespace {
+
+constexpr uint64_t kBlockSize = ReadAheadCache::kBlockSize;
+
+class ReadAheadCacheTest : public testing::Test {
+ public:
+  ReadAheadCacheTest() {
+    for (size_t i = 0; i < data_.size(); ++i)
+      data_[i] = static_cast<char>('a' + i % 26);
+  }
+  ReadAheadCacheTest(const ReadAheadCacheTest&) = delete;
+  ReadAheadCacheTest& operator=(const ReadAheadCacheTest&) = delete;
+
+ protected:
+  struct Request {
+    uint64_t count;
+    uint64_t offset;
+    ReadAheadCache::ReadCallback callback;
+  };
+
+  struct Result {
+    int error_code;
+    std::string data;
+  };
+
+  // Reads from the cache, and returns the result if the read completed.
+  std::optional<Result>* Read(uint64_t count, uint64_t offset) {
+    results_.push_back(std::make_unique<std::optional<Result>>());
+    cache_.Read(count, offset,
+                base::BindOnce(
+                    [](std::optional<Result>* result, int error_code,
+                       const std::string& data) {
+                      *result = Result{error_code, data};
+                    },
+                    results_.back().get()));
+    return results_.back().get();
+  }
+
+  // Completes the requests made to the file so far.
+  void CompleteRequests(int error_code = 0) {
+    std::vector<Request> requests = std::move(requests_);
+    requests_.clear();
+    for (auto& request : requests) {
+      if (error_code != 0) {
+        std::move(request.callback).Run(error_code, std::string());
+        continue;
+      }
+      const uint64_t offset = std::min<uint64_t>(request.offset, data_.size());
+      std::move(request.callback)
+          .Run(0, data_.substr(offset, request.count));
+    }
+  }
+
+  void OnRead(uint64_t count,
+              uint64_t offset,
+              ReadAheadCache::ReadCallback callback) {
+    requests_.push_back({count, offset, std::move(callback)});
+  }
+
+  std::string data_ = std::string(kBlockSize * 20 + 100, '\0');
+  std::vector<Request> requests_;
+  std::vector<std::unique_ptr<std::optional<Result>>> results_;
+  ReadAheadCache cache_{base::BindRepeating(&ReadAheadCacheTest::OnRead,
+                                            base::Unretained(this))};
+};
+
+TEST_F(ReadAheadCacheTest, SequentialReadsAreReadAhead) {
+  // The first read fetches its block and the next one.
+  auto* result = Read(4096, 0);
+  ASSERT_EQ(2u, requests_.size());
+  EXPECT_EQ(0u, requests_[0].offset);
+  EXPECT_EQ(kBlockSize, requests_[0].count);
+  EXPECT_EQ(kBlockSize, requests_[1].offset);
+  EXPECT_FALSE(result->has_value());
+  CompleteRequests();
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(0, (*result)->error_code);
+  EXPECT_EQ(data_.substr(0, 4096), (*result)->data);
+
+  // The window is doubled by the following sequential reads.
+  result = Read(kBlockSize - 4096, 4096);
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(data_.substr(4096, kBlockSize - 4096), (*result)->data);
+  ASSERT_EQ(1u, requests_.size());
+  EXPECT_EQ(kBlockSize * 2, requests_[0].offset);
+  CompleteRequests();
+
+  result = Read(kBlockSize, kBlockSize);
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(data_.substr(kBlockSize, kBlockSize), (*result)->data);
+  ASSERT_EQ(3u, requests_.size());
+  EXPECT_EQ(kBlockSize * 5, requests_[2].offset);
+}
+
+TEST_F(ReadAheadCacheTest, RandomReadIsPassedThrough) {
+  auto* result = Read(100, 12345);
+  ASSERT_EQ(1u, requests_.size());
+  EXPECT_EQ(100u, requests_[0].count);
+  EXPECT_EQ(12345u, requests_[0].offset);
+  CompleteRequests();
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(data_.substr(12345, 100), (*result)->data);
+
+  // The next read is sequential again.
+  Read(100, 12445);
+  ASSERT_EQ(2u, requests_.size());
+  EXPECT_EQ(0u, requests_[0].offset);
+  EXPECT_EQ(kBlockSize, requests_[1].offset);
+}
+
+TEST_F(ReadAheadCacheTest, ReadsUpToEndOfFile) {
+  data_.resize(1000);
+  auto* result = Read(4096, 0);
+  CompleteRequests();
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(data_, (*result)->data);
+
+  // Nothing is read past the end of the file.
+  result = Read(4096, 4096);
+  EXPECT_TRUE(requests_.empty());
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(0, (*result)->error_code);
+  EXPECT_TRUE((*result)->data.empty());
+}
+
+TEST_F(ReadAheadCacheTest, ErrorIsReportedAndRetried) {
+  auto* result = Read(4096, 0);
+  CompleteRequests(EIO);
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(EIO, (*result)->error_code);
+
+  // The failed blocks are fetched again.
+  result = Read(4096, 4096);
+  EXPECT_FALSE(requests_.empty());
+  EXPECT_EQ(0u, requests_[0].offset);
+  CompleteRequests();
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(data_.substr(4096, 4096), (*result)->data);
+}
+
+TEST_F(ReadAheadCacheTest, CachedBlocksAreBounded) {
+  for (uint64_t offset = 0; offset < data_.size(); offset += kBlockSize) {
+    auto* result = Read(kBlockSize, offset);
+    CompleteRequests();
+    ASSERT_TRUE(result->has_value());
+    EXPECT_EQ(data_.substr(offset, kBlockSize), (*result)->data);
+  }
+
+  // The first block was evicted.
+  Read(100, 0);
+  ASSERT_EQ(1u, requests_.size());
+  EXPECT_EQ(100u, requests_[0].count);
+
+  // The last one is still cached.
+  CompleteRequests();
+  auto* result = Read(100, data_.size() - 100);
+  EXPECT_TRUE(requests_.empty());
+  ASSERT_TRUE(result->has_value());
+  EXPECT_EQ(data_.substr(data_.size() - 100), (*result)->data);
+}
+
+}  // namespace
+}  // namespace arc
@@ -151,8 +151,20 @@ bool ServerProxy::SendMessage(const arc_proxy::MojoMessage& message,
         return false;
       }
     }
+    return message_stream_->Write(message, fds);
   }
-  return message_stream_->Write(message, fds);
+
+  // Batch the messages sent while handling the current task, so that they
+  // are sent together once it is done.
+  if (!message_stream_->Enqueue(message))
+    return false;
+  if (message_stream_->HasPendingFrames() && !flush_posted_) {
+    flush_posted_ = true;
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&ServerProxy::FlushMessages,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  return true;
 }
 
 bool ServerProxy::ReceiveMessage(arc_proxy::MojoMessage* message,
@@ -160,6 +172,16 @@ bool ServerProxy::ReceiveMessage(arc_proxy::MojoMessage* message,
   return message_stream_->Read(message, fds);
 }
 
+void ServerProxy::FlushMessages() {
+  flush_posted_ = false;
+  if (!message_stream_->Flush()) {
+    // MojoProxy stops once it fails to read from the shut down socket.
+    LOG(ERROR) << "Failed to send the batched messages";
+    if (shutdown(message_stream_->Get(), SHUT_RDWR) < 0)
+      PLOG(ERROR) << "Failed to shut down the socket";
+  }
+}
+
 void ServerProxy::OnStopped() {
   std::move(quit_closure_).Run();
 }
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include <base/memory/ref_counted.h>
+#include <base/memory/weak_ptr.h>
 
 #include "arc/vm/mojo_proxy/message_stream.h"
 #include "arc/vm/mojo_proxy/mojo_proxy.h"
@@ -62,6 +63,9 @@ class ServerProxy : public MojoProxy::Delegate,
                  FtruncateCallback callback) override;
 
  private:
+  // Sends the messages batched by SendMessage().
+  void FlushMessages();
+
   scoped_refptr<base::TaskRunner> proxy_file_system_task_runner_;
   ProxyFileSystem proxy_file_system_;
   base::OnceClosure quit_closure_;
@@ -69,6 +73,11 @@ class ServerProxy : public MojoProxy::Delegate,
   base::ScopedFD virtwl_context_;
   std::unique_ptr<MessageStream> message_stream_;
   std::unique_ptr<MojoProxy> mojo_proxy_;
+
+  // Whether FlushMessages() is posted for the batched messages.
+  bool flush_posted_ = false;
+
+  base::WeakPtrFactory<ServerProxy> weak_factory_{this};
 };
 
 }  // namespace arc
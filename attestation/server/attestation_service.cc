@@ -2612,8 +2612,9 @@ void AttestationService::Enroll(const EnrollRequest& request,
 void AttestationService::SendEnrollRequest(
     const std::shared_ptr<AttestationFlowData>& data) {
   auto pca_request = ToPcaAgentEnrollRequest(*data);
-  auto on_success = base::BindOnce(
-      &AttestationService::HandlePcaAgentEnrollReply, GetWeakPtr(), data);
+  auto on_success =
+      base::BindOnce(&AttestationService::HandlePcaAgentEnrollReply,
+                     GetWeakPtr(), data, base::TimeTicks::Now());
   auto on_error =
       base::BindOnce(&AttestationService::HandlePcaAgentEnrollRequestError,
                      GetWeakPtr(), data);
@@ -2866,12 +2867,16 @@ void AttestationService::FinishCertificateTask(
   request.set_username(data->username());
   request.set_key_label(data->key_label());
   auto reply = std::make_shared<FinishCertificateRequestReply>();
+  const base::TimeTicks finish_start = base::TimeTicks::Now();
   FinishCertificateRequestTask(request, reply);
   if (reply->status() != STATUS_SUCCESS) {
     data->set_status(reply->status());
     data->set_action(AttestationFlowAction::kAbort);
     return;
   }
+  metrics_.ReportAttestationPhaseDuration(
+      kAttestationPhaseFinishCertificate,
+      base::TimeTicks::Now() - finish_start);
   data->set_public_key(std::move(*(reply->mutable_public_key())));
   data->set_certificate(std::move(*(reply->mutable_certificate())));
   data->set_certified_key_credential(
@@ -2882,7 +2887,10 @@ void AttestationService::FinishCertificateTask(
 
 void AttestationService::HandlePcaAgentEnrollReply(
     const std::shared_ptr<AttestationFlowData>& data,
+    base::TimeTicks request_time,
     const pca_agent::EnrollReply& pca_reply) {
+  metrics_.ReportAttestationPhaseDuration(
+      kAttestationPhasePcaEnroll, base::TimeTicks::Now() - request_time);
   if (pca_reply.status() != STATUS_SUCCESS) {
     enrollment_statuses_[data->aca_type()] = EnrollmentStatus::kNotEnrolled;
     data->set_status(pca_reply.status());
@@ -2949,6 +2957,7 @@ void AttestationService::CreateCertificateRequestTask(
 
   const auto& identity_key_blob =
       database_pb.identities().Get(identity).identity_key().identity_key_blob();
+  const base::TimeTicks create_key_start = base::TimeTicks::Now();
   auto certified_key_result = hwsec_->CreateCertifiedKey(
       BlobFromString(identity_key_blob), key_type, key_usage, key_restriction,
       endorsement_auth, nonce);
@@ -2958,6 +2967,9 @@ void AttestationService::CreateCertificateRequestTask(
     result->set_status(STATUS_UNEXPECTED_DEVICE_ERROR);
     return;
   }
+  metrics_.ReportAttestationPhaseDuration(
+      kAttestationPhaseCreateCertifiedKey,
+      base::TimeTicks::Now() - create_key_start);
 
   CertifiedKey key = certified_key_result.value();
   std::string message_id;
@@ -3056,7 +3068,7 @@ void AttestationService::SendGetCertificateRequest(
   auto pca_request = ToPcaAgentCertRequest(*data);
   auto on_success =
       base::BindOnce(&AttestationService::HandlePcaAgentGetCertificateReply,
-                     GetWeakPtr(), data);
+                     GetWeakPtr(), data, base::TimeTicks::Now());
   auto on_error = base::BindOnce(
       &AttestationService::HandlePcaAgentGetCertificateRequestError,
       GetWeakPtr(), data);
@@ -3077,7 +3089,11 @@ void AttestationService::HandlePcaAgentGetCertificateRequestError(
 
 void AttestationService::HandlePcaAgentGetCertificateReply(
     const std::shared_ptr<AttestationFlowData>& data,
+    base::TimeTicks request_time,
     const pca_agent::GetCertificateReply& pca_reply) {
+  metrics_.ReportAttestationPhaseDuration(
+      kAttestationPhasePcaGetCertificate,
+      base::TimeTicks::Now() - request_time);
   if (pca_reply.status() != STATUS_SUCCESS) {
     data->set_status(pca_reply.status());
     data->set_action(AttestationFlowAction::kAbort);
@@ -22,6 +22,7 @@
 #include <base/functional/callback.h>
 #include <base/memory/weak_ptr.h>
 #include <base/threading/thread.h>
+#include <base/time/time.h>
 #include <brillo/secure_blob.h>
 #include <gtest/gtest_prod.h>
 #include <libhwsec/factory/factory.h>
@@ -671,8 +672,10 @@ class AttestationService : public AttestationInterface {
   // Calls the D-bus method callback stored in |data| with a proper
   // |AttestationStatus| depending on the response received from PCA server.
   // Passed as the success callback of |pca_agent::EnrollAsync|.
+  // |request_time| is when the request was sent.
   void HandlePcaAgentEnrollReply(
       const std::shared_ptr<AttestationFlowData>& data,
+      base::TimeTicks request_time,
       const pca_agent::EnrollReply& pca_reply);
 
   // Calls the routine corresponding to the |AttestationFlowAction| stored in
@@ -694,9 +697,11 @@ class AttestationService : public AttestationInterface {
   // Calls the D-bus method callback stored in |data| with a proper
   // |AttestationStatus| depending on the response received from PCA server via
   // |pca_agentd|. Passed as the success callback of
-  // |pca_agent::GetCertificateAsync|.
+  // |pca_agent::GetCertificateAsync|. |request_time| is when the request was
+  // sent.
   void HandlePcaAgentGetCertificateReply(
       const std::shared_ptr<AttestationFlowData>& data,
+      base::TimeTicks request_time,
       const pca_agent::GetCertificateReply& pca_reply);
 
   // Creates the enroll request and stores the return status code and the result
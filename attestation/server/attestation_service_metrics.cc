@@ -11,6 +11,8 @@ namespace {
 constexpr char kAttestationStatusHistogramPrefix[] = "Hwsec.Attestation.Status";
 constexpr char kAttestationPrepareDurationHistogram[] =
     "Hwsec.Attestation.PrepareDuration";
+constexpr char kAttestationPhaseDurationHistogramPrefix[] =
+    "Hwsec.Attestation.PhaseDuration";
 
 }  // namespace
 
@@ -41,4 +43,20 @@ void AttestationServiceMetrics::ReportAttestationPrepareDuration(
                               min_duration, max_duration, nBuckets);
 }
 
+void AttestationServiceMetrics::ReportAttestationPhaseDuration(
+    const std::string& phase, base::TimeDelta delta) {
+  if (!metrics_library_) {
+    return;
+  }
+
+  const std::string histogram =
+      std::string(kAttestationPhaseDurationHistogramPrefix) + "." + phase;
+  const int min_duration = 1;
+  const int max_duration = 100'000;
+  const int sample = static_cast<int>(delta.InMilliseconds());
+  const int nBuckets = 50;
+  metrics_library_->SendToUMA(histogram, sample, min_duration, max_duration,
+                              nBuckets);
+}
+
 }  // namespace attestation
@@ -43,6 +43,16 @@ inline constexpr char kAttestationActivateAttestationKey[] =
 inline constexpr char kAttestationPrepareForEnrollment[] =
     "PrepareForEnrollment";
 
+// Phases of the enrollment and certificate flows. These are used as suffixes
+// to kAttestationPhaseDurationHistogramPrefix defined in the .cc.
+inline constexpr char kAttestationPhaseCreateCertifiedKey[] =
+    "CreateCertifiedKey";
+inline constexpr char kAttestationPhasePcaEnroll[] = "PcaEnroll";
+inline constexpr char kAttestationPhasePcaGetCertificate[] =
+    "PcaGetCertificate";
+inline constexpr char kAttestationPhaseFinishCertificate[] =
+    "FinishCertificate";
+
 // This class provides helper functions to report attestation-related
 // metrics.
 class AttestationServiceMetrics : private MetricsLibrary {
@@ -57,6 +67,8 @@ class AttestationServiceMetrics : private MetricsLibrary {
   virtual void ReportAttestationOpsStatus(const std::string& operation,
                                           AttestationOpsStatus status);
   virtual void ReportAttestationPrepareDuration(base::TimeDelta delta);
+  virtual void ReportAttestationPhaseDuration(const std::string& phase,
+                                              base::TimeDelta delta);
 
   void set_metrics_library_for_testing(
       MetricsLibraryInterface* metrics_library) {
@@ -20,6 +20,7 @@
 #include <base/strings/string_piece.h>
 #include <base/threading/platform_thread.h>
 #include <base/time/time.h>
+#include <base/timer/elapsed_timer.h>
 #include <base/timer/timer.h>
 #include <crypto/random.h>
 #include <dbus/bus.h>
@@ -178,10 +179,14 @@ bool CrosFpBiometricsManager::UpdateRecordMetadata(
 bool CrosFpBiometricsManager::ReadRecordsForSingleUser(
     const std::string& user_id) {
   cros_dev_->SetContext(user_id);
+  base::ElapsedTimer timer;
   auto valid_records = record_manager_->GetRecordsForUser(user_id);
   for (const auto& record : valid_records) {
-    LoadRecord(std::move(record));
+    LoadRecord(record);
   }
+  LOG(INFO) << "Loaded " << loaded_records_.size() << " of "
+            << valid_records.size() << " records in "
+            << timer.Elapsed().InMilliseconds() << " ms.";
 
   if (record_manager_->UserHasInvalidRecords(user_id)) {
     record_manager_->DeleteInvalidRecords();
@@ -695,16 +700,16 @@ void CrosFpBiometricsManager::OnTaskComplete() {
 }
 
 bool CrosFpBiometricsManager::LoadRecord(
-    const BiodStorageInterface::Record record) {
-  std::string tmpl_data_str;
-  base::Base64Decode(record.data, &tmpl_data_str);
-
+    const BiodStorageInterface::Record& record) {
   if (loaded_records_.size() >= cros_dev_->MaxTemplateCount()) {
     LOG(ERROR) << "No space to upload template from "
                << LogSafeID(record.metadata.record_id) << ".";
     return false;
   }
 
+  std::string tmpl_data_str;
+  base::Base64Decode(record.data, &tmpl_data_str);
+
   biod_metrics_->SendRecordFormatVersion(record.metadata.record_format_version);
   LOG(INFO) << "Upload record " << LogSafeID(record.metadata.record_id) << ".";
   VendorTemplate tmpl(tmpl_data_str.begin(), tmpl_data_str.end());
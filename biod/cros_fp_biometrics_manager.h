@@ -101,7 +101,7 @@ class CrosFpBiometricsManager : public BiometricsManager {
       const std::vector<int>& dirty_list,
       const std::unordered_set<uint32_t>& suspicious_templates);
 
-  bool LoadRecord(const BiodStorage::Record record);
+  bool LoadRecord(const BiodStorage::Record& record);
 
   base::WeakPtrFactory<CrosFpBiometricsManager> session_weak_factory_;
   base::WeakPtrFactory<CrosFpBiometricsManager> weak_factory_;
@@ -11,6 +11,7 @@
 #define BOOTSTAT_BOOTSTAT_H_
 
 #include <linux/rtc.h>
+#include <sys/types.h>
 #include <time.h>
 
 #include <memory>
@@ -25,6 +26,14 @@
 
 namespace bootstat {
 
+// Cumulative time during which some or all tasks were stalled on a resource
+// since boot, from the pressure stall information (PSI) of the kernel.
+struct PressureStall {
+  base::TimeDelta cpu_some;
+  base::TimeDelta io_some;
+  base::TimeDelta io_full;
+};
+
 // Abstracts system operations in order to inject on testing.
 class BootStatSystem {
  public:
@@ -46,6 +55,10 @@ class BootStatSystem {
   // Returns the idle time since boot.
   std::optional<base::TimeDelta> GetIdleTime() const;
 
+  // Returns the CPU and IO pressure stall, std::nullopt if the kernel does not
+  // support PSI.
+  std::optional<PressureStall> GetPressureStall() const;
+
   // Returns a scoped FD to the RTC device (used by GetRtcTime below).
   virtual base::ScopedFD OpenRtc() const;
   // Reads and return RTC's time, std::nullopt on error.
@@ -100,6 +113,20 @@ class BRILLO_EXPORT BootStat {
   std::optional<std::vector<BootstatTiming>> GetEventTimings(
       const std::string& event_name) const;
 
+  struct BootEvent {
+    std::string name;
+    // Time since boot, with nanosecond resolution.
+    base::TimeDelta uptime;
+    // Process which logged the event.
+    pid_t pid;
+    // Pressure stall when the event was logged, if the kernel supports PSI.
+    std::optional<PressureStall> pressure_stall;
+  };
+
+  // Retrieves all the events logged since boot, in the order they were
+  // logged. Returns std::nullopt if there is an error.
+  std::optional<std::vector<BootEvent>> GetEvents() const;
+
  private:
   base::FilePath output_directory_path_;
 
@@ -108,6 +135,9 @@ class BRILLO_EXPORT BootStat {
   base::FilePath GetEventPath(const std::string& prefix,
                               const std::string& event_name) const;
 
+  // Opens the output file at |output_path| for appending, creating it if
+  // needed. Returns a scoped fd (negative on error).
+  base::ScopedFD OpenOutputFile(const base::FilePath& output_path) const;
   // Figures out the event output file name, and open it.
   // Returns a scoped fd (negative on error).
   base::ScopedFD OpenEventFile(const std::string& output_name_prefix,
@@ -115,7 +145,11 @@ class BRILLO_EXPORT BootStat {
   // Logs a disk event containing root disk statistics.
   bool LogDiskEvent(const std::string& event_name) const;
   // Logs a uptime event indicating time since boot.
-  bool LogUptimeEvent(const std::string& event_name) const;
+  bool LogUptimeEvent(const std::string& event_name,
+                      const struct timespec& uptime) const;
+  // Appends the event to the binary log of all the events.
+  bool LogBinaryEvent(const std::string& event_name,
+                      const struct timespec& uptime) const;
 
   std::optional<std::vector<BootstatTiming>> ParseUptimeEvent(
       const std::string& contents) const;
@@ -14,16 +14,21 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
+#include <unistd.h>
 
+#include <cstring>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <base/files/file.h>
 #include <base/files/file_util.h>
 #include <base/files/scoped_file.h>
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
 #include <base/strings/string_split.h>
+#include <base/strings/string_util.h>
 #include <base/strings/stringprintf.h>
 #include <base/time/time.h>
 #include <rootdev/rootdev.h>
@@ -38,6 +43,8 @@ namespace {
 static const char kDefaultOutputDirectoryName[] = "run/bootstat";
 
 static constexpr char kProcUptime[] = "proc/uptime";
+static constexpr char kProcPressureCpu[] = "proc/pressure/cpu";
+static constexpr char kProcPressureIo[] = "proc/pressure/io";
 
 static constexpr int64_t kNsecsPerSec = 1e9;
 
@@ -47,6 +54,54 @@ static constexpr int64_t kNsecsPerSec = 1e9;
 // This value is arbitrarily chosen.
 static constexpr int kBootstatMaxEventLength = 64;
 
+// Name of the binary log of all the events, in the output directory.
+static constexpr char kEventLogName[] = "events.log";
+
+// Record of the binary event log. Records have a fixed size, so that they can
+// be appended atomically.
+struct EventRecord {
+  uint32_t magic;
+  uint32_t flags;
+  // CLOCK_BOOTTIME when the event was logged.
+  uint64_t uptime_ns;
+  // Pressure stall totals, if kEventRecordHasPressureStall is set.
+  uint64_t cpu_some_us;
+  uint64_t io_some_us;
+  uint64_t io_full_us;
+  int32_t pid;
+  // NUL-terminated, and truncated like the names of the event files.
+  char name[kBootstatMaxEventLength];
+};
+static_assert(sizeof(EventRecord) == 112, "Event records must not change");
+
+static constexpr uint32_t kEventRecordMagic = 0x31455342;  // "BSE1"
+static constexpr uint32_t kEventRecordHasPressureStall = 1 << 0;
+
+// Bounds the size of the event log.
+static constexpr size_t kMaxEventLogRecords = 8192;
+
+// Parses the "total" stall time, in microseconds, of the |kind| ("some" or
+// "full") line of a /proc/pressure file, e.g.
+//   "some avg10=0.00 avg60=0.00 avg300=0.00 total=12345"
+static std::optional<base::TimeDelta> ParsePressureStallTotal(
+    const std::string& contents, base::StringPiece kind) {
+  for (base::StringPiece line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.empty() || fields[0] != kind)
+      continue;
+    for (base::StringPiece field : fields) {
+      uint64_t total_us;
+      if (base::StartsWith(field, "total=") &&
+          base::StringToUint64(field.substr(6), &total_us)) {
+        return base::Microseconds(total_us);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
 // Parse a line of text containing one or more space-separated columns of
 // decimal numbers. For example (without the quotes):
 //   "12.76543 0.89"
@@ -166,6 +221,30 @@ std::optional<base::TimeDelta> BootStatSystem::GetIdleTime() const {
   return (*numbers)[1];
 }
 
+std::optional<PressureStall> BootStatSystem::GetPressureStall() const {
+  std::string cpu;
+  std::string io;
+  if (!base::ReadFileToString(root_path_.Append(kProcPressureCpu), &cpu) ||
+      !base::ReadFileToString(root_path_.Append(kProcPressureIo), &io)) {
+    // The kernel does not support PSI.
+    return std::nullopt;
+  }
+
+  std::optional<base::TimeDelta> cpu_some =
+      ParsePressureStallTotal(cpu, "some");
+  std::optional<base::TimeDelta> io_some = ParsePressureStallTotal(io, "some");
+  std::optional<base::TimeDelta> io_full = ParsePressureStallTotal(io, "full");
+  if (!cpu_some || !io_some || !io_full) {
+    LOG(ERROR) << "Couldn't parse pressure stall information.";
+    return std::nullopt;
+  }
+  return PressureStall{
+      .cpu_some = *cpu_some,
+      .io_some = *io_some,
+      .io_full = *io_full,
+  };
+}
+
 base::ScopedFD BootStatSystem::OpenRtc() const {
   int rtc_fd = HANDLE_EINTR(open("/dev/rtc", O_RDONLY | O_CLOEXEC));
   if (rtc_fd < 0)
@@ -260,11 +339,14 @@ std::optional<struct BootStat::RtcTick> BootStat::GetRtcTick() const {
 
 base::ScopedFD BootStat::OpenEventFile(const std::string& output_name_prefix,
                                        const std::string& event_name) const {
+  return OpenOutputFile(GetEventPath(output_name_prefix, event_name));
+}
+
+base::ScopedFD BootStat::OpenOutputFile(
+    const base::FilePath& output_path) const {
   const mode_t kFileCreationMode =
       S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
 
-  base::FilePath output_path = GetEventPath(output_name_prefix, event_name);
-
   int output_fd =
       HANDLE_EINTR(open(output_path.value().c_str(),
                         O_WRONLY | O_APPEND | O_CREAT | O_NOFOLLOW | O_CLOEXEC,
@@ -320,18 +402,15 @@ bool BootStat::LogDiskEvent(const std::string& event_name) const {
   return ret;
 }
 
-bool BootStat::LogUptimeEvent(const std::string& event_name) const {
-  std::optional<struct timespec> uptime = boot_stat_system_->GetUpTime();
-  if (!uptime)
-    return false;
-
+bool BootStat::LogUptimeEvent(const std::string& event_name,
+                              const struct timespec& uptime) const {
   std::optional<base::TimeDelta> idle = boot_stat_system_->GetIdleTime();
   if (!idle)
     return false;
 
   std::string data = base::StringPrintf(
       "%" PRId64 ".%09ld %" PRId64 ".%09" PRId64 "\n",
-      static_cast<int64_t>(uptime->tv_sec), uptime->tv_nsec, idle->InSeconds(),
+      static_cast<int64_t>(uptime.tv_sec), uptime.tv_nsec, idle->InSeconds(),
       idle->InNanoseconds() % kNsecsPerSec);
 
   base::ScopedFD output_fd = OpenEventFile("uptime", event_name);
@@ -343,6 +422,49 @@ bool BootStat::LogUptimeEvent(const std::string& event_name) const {
   return ret;
 }
 
+bool BootStat::LogBinaryEvent(const std::string& event_name,
+                              const struct timespec& uptime) const {
+  base::ScopedFD output_fd =
+      OpenOutputFile(output_directory_path_.Append(kEventLogName));
+  if (!output_fd.is_valid())
+    return false;
+
+  base::stat_wrapper_t stat;
+  if (base::File::Fstat(output_fd.get(), &stat) < 0) {
+    PLOG(ERROR) << "Failed to stat event log.";
+    return false;
+  }
+  if (static_cast<size_t>(stat.st_size) >=
+      kMaxEventLogRecords * sizeof(EventRecord)) {
+    LOG(ERROR) << "Event log is full, dropping " << event_name << ".";
+    return false;
+  }
+
+  EventRecord record = {};
+  record.magic = kEventRecordMagic;
+  record.uptime_ns =
+      static_cast<uint64_t>(uptime.tv_sec) * kNsecsPerSec + uptime.tv_nsec;
+  record.pid = getpid();
+  base::strlcpy(record.name, event_name.c_str(), sizeof(record.name));
+  if (std::optional<PressureStall> pressure_stall =
+          boot_stat_system_->GetPressureStall()) {
+    record.flags |= kEventRecordHasPressureStall;
+    record.cpu_some_us = pressure_stall->cpu_some.InMicroseconds();
+    record.io_some_us = pressure_stall->io_some.InMicroseconds();
+    record.io_full_us = pressure_stall->io_full.InMicroseconds();
+  }
+
+  // A single write of a fixed size record to a file opened with O_APPEND, so
+  // that the records of concurrent processes are not interleaved.
+  ssize_t written =
+      HANDLE_EINTR(write(output_fd.get(), &record, sizeof(record)));
+  if (written != sizeof(record)) {
+    PLOG(ERROR) << "Cannot write event record.";
+    return false;
+  }
+  return true;
+}
+
 std::optional<std::vector<BootStat::BootstatTiming>> BootStat::ParseUptimeEvent(
     const std::string& contents) const {
   auto lines = base::SplitStringPiece(contents, "\n", base::TRIM_WHITESPACE,
@@ -373,7 +495,12 @@ bool BootStat::LogEvent(const std::string& event_name) const {
   bool ret = true;
 
   ret &= LogDiskEvent(event_name);
-  ret &= LogUptimeEvent(event_name);
+
+  std::optional<struct timespec> uptime = boot_stat_system_->GetUpTime();
+  if (!uptime)
+    return false;
+  ret &= LogUptimeEvent(event_name, *uptime);
+  ret &= LogBinaryEvent(event_name, *uptime);
 
   return ret;
 }
@@ -418,4 +545,42 @@ std::optional<std::vector<BootStat::BootstatTiming>> BootStat::GetEventTimings(
   return result;
 }
 
+std::optional<std::vector<BootStat::BootEvent>> BootStat::GetEvents() const {
+  base::FilePath event_log_path = output_directory_path_.Append(kEventLogName);
+
+  std::string data;
+  if (!base::ReadFileToString(event_log_path, &data)) {
+    PLOG(ERROR) << "Could not read event log: " << event_log_path;
+    return std::nullopt;
+  }
+
+  std::vector<BootEvent> events;
+  for (size_t offset = 0; offset + sizeof(EventRecord) <= data.size();
+       offset += sizeof(EventRecord)) {
+    EventRecord record;
+    memcpy(&record, data.data() + offset, sizeof(record));
+    if (record.magic != kEventRecordMagic) {
+      LOG(ERROR) << "Malformed event record at offset " << offset;
+      return std::nullopt;
+    }
+
+    BootEvent event = {
+        .name = std::string(record.name, strnlen(record.name,
+                                                 sizeof(record.name))),
+        .uptime = base::Nanoseconds(record.uptime_ns),
+        .pid = record.pid,
+    };
+    if (record.flags & kEventRecordHasPressureStall) {
+      event.pressure_stall = PressureStall{
+          .cpu_some = base::Microseconds(record.cpu_some_us),
+          .io_some = base::Microseconds(record.io_some_us),
+          .io_full = base::Microseconds(record.io_full_us),
+      };
+    }
+    events.push_back(std::move(event));
+  }
+
+  return events;
+}
+
 };  // namespace bootstat
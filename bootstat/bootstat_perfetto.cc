@@ -0,0 +1,52 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Implementation of the 'bootstat_perfetto' command, which converts the
+// events logged by bootstat since boot to a Perfetto trace.
+
+#include <libgen.h>
+#include <stdio.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+
+#include "bootstat/bootstat.h"
+#include "bootstat/perfetto_trace.h"
+
+namespace {
+
+void usage(char* cmd) {
+  fprintf(stderr, "usage: %s <output-trace>\n", basename(cmd));
+  exit(EXIT_FAILURE);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  base::CommandLine::Init(argc, argv);
+  base::CommandLine::StringVector args =
+      base::CommandLine::ForCurrentProcess()->GetArgs();
+
+  if (args.size() != 1)
+    usage(argv[0]);
+
+  std::optional<std::vector<bootstat::BootStat::BootEvent>> events =
+      bootstat::BootStat().GetEvents();
+  if (!events) {
+    fprintf(stderr, "Cannot read the bootstat event log.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!base::WriteFile(base::FilePath(args[0]),
+                       bootstat::ConvertToPerfettoTrace(*events))) {
+    fprintf(stderr, "Cannot write trace to %s.\n", args[0].c_str());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -9,6 +9,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
+#include <unistd.h>
 
 #include <memory>
 #include <optional>
@@ -40,6 +41,8 @@ namespace {
 
 constexpr char kProcPath[] = "proc";
 constexpr char kProcUptimePath[] = "proc/uptime";
+constexpr char kProcPressurePath[] = "proc/pressure";
+constexpr char kEventLogName[] = "events.log";
 
 void RemoveFile(const base::FilePath& file_path) {
   // Either this is a link, or the path exists (PathExists would resolve
@@ -108,6 +111,9 @@ class BootstatTest : public ::testing::Test {
 
   bool WriteUptime(const struct timespec& uptime, const struct timespec& idle);
 
+  // Writes CPU and IO pressure stall information to mock files.
+  bool WritePressureStall(const std::string& cpu, const std::string& io);
+
   // Checks that the stats directory only contains the expected files.
   void ValidateStatsDirectoryContent(const std::set<base::FilePath>& expected);
 
@@ -158,6 +164,15 @@ bool BootstatTest::WriteUptime(const struct timespec& uptime,
   return WriteUptime(content);
 }
 
+bool BootstatTest::WritePressureStall(const std::string& cpu,
+                                      const std::string& io) {
+  base::FilePath dir = mock_root_path_.Append(kProcPressurePath);
+  if (!base::CreateDirectoryAndGetError(dir, nullptr))
+    return false;
+  return base::WriteFile(dir.Append("cpu"), cpu) &&
+         base::WriteFile(dir.Append("io"), io);
+}
+
 void BootstatTest::ValidateStatsDirectoryContent(
     const std::set<base::FilePath>& expected) {
   std::set<base::FilePath> seen;
@@ -253,7 +268,8 @@ TEST_F(BootstatTest, ContentGeneration) {
     ValidateEventFileContents(diskstats_file_path,
                               kTestData[i].expected_disk_content);
     ValidateStatsDirectoryContent(
-        std::set{uptime_file_path, diskstats_file_path});
+        std::set{uptime_file_path, diskstats_file_path,
+                 stats_output_dir_.Append(kEventLogName)});
   }
 }
 
@@ -312,7 +328,8 @@ TEST_F(BootstatTest, EventNameTruncation) {
     ValidateEventFileContents(diskstats_file_path,
                               kDefaultTestData.mock_disk_content);
     ValidateStatsDirectoryContent(
-        std::set{uptime_file_path, diskstats_file_path});
+        std::set{uptime_file_path, diskstats_file_path,
+                 stats_output_dir_.Append(kEventLogName)});
     RemoveFile(diskstats_file_path);
     RemoveFile(uptime_file_path);
   }
@@ -550,6 +567,99 @@ TEST_F(BootstatTest, GetEventTimings) {
   }
 }
 
+TEST_F(BootstatTest, GetEvents) {
+  constexpr struct {
+    const char* event_name;
+    const struct timespec uptime;
+  } kTestData[] = {
+      {"pre-stage", {12, 345678901}},
+      {"post-stage", {13, 5}},
+      {"pre-stage", {20, 0}},
+  };
+
+  ASSERT_TRUE(WriteUptime(kDefaultTestData.uptime, kDefaultTestData.idle));
+  ASSERT_TRUE(WriteMockDiskStats(kDefaultTestData.mock_disk_content));
+  for (const auto& data : kTestData) {
+    EXPECT_CALL(*boot_stat_system_, GetUpTime())
+        .WillOnce(Return(std::make_optional(data.uptime)));
+    ASSERT_TRUE(boot_stat_->LogEvent(data.event_name));
+    Mock::VerifyAndClear(boot_stat_system_);
+  }
+
+  auto events = boot_stat_->GetEvents();
+  ASSERT_TRUE(events);
+  ASSERT_EQ(events->size(), std::size(kTestData));
+  for (int i = 0; i < std::size(kTestData); i++) {
+    auto& event = (*events)[i];
+    EXPECT_EQ(event.name, kTestData[i].event_name);
+    EXPECT_EQ(event.uptime, base::Seconds(kTestData[i].uptime.tv_sec) +
+                                base::Nanoseconds(kTestData[i].uptime.tv_nsec));
+    EXPECT_EQ(event.pid, getpid());
+    // The mock root has no PSI files.
+    EXPECT_FALSE(event.pressure_stall);
+  }
+}
+
+TEST_F(BootstatTest, GetEventsTruncatesName) {
+  EXPECT_CALL(*boot_stat_system_, GetUpTime())
+      .WillOnce(Return(std::make_optional(kDefaultTestData.uptime)));
+  ASSERT_TRUE(WriteUptime(kDefaultTestData.uptime, kDefaultTestData.idle));
+  ASSERT_TRUE(WriteMockDiskStats(kDefaultTestData.mock_disk_content));
+
+  const std::string kEventName(100, 'x');
+  ASSERT_TRUE(boot_stat_->LogEvent(kEventName));
+
+  auto events = boot_stat_->GetEvents();
+  ASSERT_TRUE(events);
+  ASSERT_EQ(events->size(), 1u);
+  EXPECT_EQ((*events)[0].name, std::string(63, 'x'));
+}
+
+TEST_F(BootstatTest, GetEventsWithoutLog) {
+  EXPECT_FALSE(boot_stat_->GetEvents());
+}
+
+TEST_F(BootstatTest, GetEventsMalformedLog) {
+  ASSERT_TRUE(base::WriteFile(stats_output_dir_.Append(kEventLogName),
+                              std::string(112, 'x')));
+  EXPECT_FALSE(boot_stat_->GetEvents());
+}
+
+TEST_F(BootstatTest, GetPressureStall) {
+  ASSERT_TRUE(WritePressureStall(
+      "some avg10=0.00 avg60=0.00 avg300=0.00 total=1500\n"
+      "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n",
+      "some avg10=1.00 avg60=0.50 avg300=0.10 total=2000000\n"
+      "full avg10=0.50 avg60=0.20 avg300=0.05 total=700\n"));
+
+  auto pressure_stall = boot_stat_system_->GetPressureStall();
+  ASSERT_TRUE(pressure_stall);
+  EXPECT_EQ(pressure_stall->cpu_some, base::Microseconds(1500));
+  EXPECT_EQ(pressure_stall->io_some, base::Seconds(2));
+  EXPECT_EQ(pressure_stall->io_full, base::Microseconds(700));
+
+  EXPECT_CALL(*boot_stat_system_, GetUpTime())
+      .WillOnce(Return(std::make_optional(kDefaultTestData.uptime)));
+  ASSERT_TRUE(WriteUptime(kDefaultTestData.uptime, kDefaultTestData.idle));
+  ASSERT_TRUE(WriteMockDiskStats(kDefaultTestData.mock_disk_content));
+  ASSERT_TRUE(boot_stat_->LogEvent("ev"));
+
+  auto events = boot_stat_->GetEvents();
+  ASSERT_TRUE(events);
+  ASSERT_EQ(events->size(), 1u);
+  ASSERT_TRUE((*events)[0].pressure_stall);
+  EXPECT_EQ((*events)[0].pressure_stall->io_some, base::Seconds(2));
+}
+
+TEST_F(BootstatTest, GetPressureStallMalformed) {
+  ASSERT_TRUE(WritePressureStall("some avg10=0.00\n", "garbage\n"));
+  EXPECT_FALSE(boot_stat_system_->GetPressureStall());
+}
+
+TEST_F(BootstatTest, GetPressureStallNotSupported) {
+  EXPECT_FALSE(boot_stat_system_->GetPressureStall());
+}
+
 TEST_F(BootstatTest, Umask) {
   constexpr char kEventName[] = "umasking";
 
@@ -0,0 +1,241 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "bootstat/perfetto_trace.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <base/strings/string_piece.h>
+#include <base/strings/string_util.h>
+
+namespace bootstat {
+
+namespace {
+
+// Field numbers of the messages of perfetto/protos/perfetto/trace, which are
+// stable since traces are meant to be read by any version of Perfetto.
+constexpr uint32_t kTracePacket = 1;
+
+constexpr uint32_t kTracePacketTimestamp = 8;
+constexpr uint32_t kTracePacketTrustedPacketSequenceId = 10;
+constexpr uint32_t kTracePacketTrackEvent = 11;
+constexpr uint32_t kTracePacketSequenceFlags = 13;
+constexpr uint32_t kTracePacketTrackDescriptor = 60;
+constexpr uint64_t kSeqIncrementalStateCleared = 1;
+
+constexpr uint32_t kTrackDescriptorUuid = 1;
+constexpr uint32_t kTrackDescriptorName = 2;
+constexpr uint32_t kTrackDescriptorParentUuid = 5;
+constexpr uint32_t kTrackDescriptorCounter = 8;
+
+constexpr uint32_t kCounterDescriptorUnitName = 6;
+
+constexpr uint32_t kTrackEventType = 9;
+constexpr uint32_t kTrackEventTrackUuid = 11;
+constexpr uint32_t kTrackEventName = 23;
+constexpr uint32_t kTrackEventDoubleCounterValue = 44;
+constexpr uint64_t kTypeSliceBegin = 1;
+constexpr uint64_t kTypeSliceEnd = 2;
+constexpr uint64_t kTypeInstant = 3;
+constexpr uint64_t kTypeCounter = 4;
+
+// All the packets are written on a single sequence.
+constexpr uint64_t kSequenceId = 1;
+
+constexpr uint64_t kBootstatTrackUuid = 1;
+constexpr uint64_t kCpuSomeTrackUuid = 2;
+constexpr uint64_t kIoSomeTrackUuid = 3;
+constexpr uint64_t kIoFullTrackUuid = 4;
+// Tracks of the stages, one per name.
+constexpr uint64_t kFirstStageTrackUuid = 100;
+
+constexpr char kStageBeginPrefix[] = "pre-";
+constexpr char kStageEndPrefix[] = "post-";
+
+// Minimal writer of the protobuf wire format, enough for trace packets.
+class ProtoWriter {
+ public:
+  void AppendVarint(uint32_t field, uint64_t value) {
+    AppendTag(field, kWireTypeVarint);
+    AppendRawVarint(value);
+  }
+
+  void AppendDouble(uint32_t field, double value) {
+    AppendTag(field, kWireTypeFixed64);
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value));
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++)
+      data_.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+
+  void AppendString(uint32_t field, base::StringPiece value) {
+    AppendTag(field, kWireTypeLengthDelimited);
+    AppendRawVarint(value.size());
+    data_.append(value.data(), value.size());
+  }
+
+  void AppendMessage(uint32_t field, const ProtoWriter& message) {
+    AppendString(field, message.data());
+  }
+
+  const std::string& data() const { return data_; }
+
+ private:
+  static constexpr int kWireTypeVarint = 0;
+  static constexpr int kWireTypeFixed64 = 1;
+  static constexpr int kWireTypeLengthDelimited = 2;
+
+  void AppendTag(uint32_t field, int wire_type) {
+    AppendRawVarint((static_cast<uint64_t>(field) << 3) | wire_type);
+  }
+
+  void AppendRawVarint(uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<char>(value));
+  }
+
+  std::string data_;
+};
+
+class TraceWriter {
+ public:
+  TraceWriter() {
+    ProtoWriter packet;
+    packet.AppendVarint(kTracePacketSequenceFlags, kSeqIncrementalStateCleared);
+    AppendPacket(&packet);
+  }
+
+  void AppendTrack(uint64_t uuid,
+                   base::StringPiece name,
+                   std::optional<base::StringPiece> counter_unit) {
+    ProtoWriter track;
+    track.AppendVarint(kTrackDescriptorUuid, uuid);
+    track.AppendString(kTrackDescriptorName, name);
+    if (uuid != kBootstatTrackUuid)
+      track.AppendVarint(kTrackDescriptorParentUuid, kBootstatTrackUuid);
+    if (counter_unit) {
+      ProtoWriter counter;
+      counter.AppendString(kCounterDescriptorUnitName, *counter_unit);
+      track.AppendMessage(kTrackDescriptorCounter, counter);
+    }
+
+    ProtoWriter packet;
+    packet.AppendMessage(kTracePacketTrackDescriptor, track);
+    AppendPacket(&packet);
+  }
+
+  void AppendEvent(base::TimeDelta timestamp,
+                   uint64_t track_uuid,
+                   uint64_t type,
+                   base::StringPiece name) {
+    ProtoWriter event;
+    event.AppendVarint(kTrackEventType, type);
+    event.AppendVarint(kTrackEventTrackUuid, track_uuid);
+    if (!name.empty())
+      event.AppendString(kTrackEventName, name);
+    AppendTrackEvent(timestamp, event);
+  }
+
+  void AppendCounter(base::TimeDelta timestamp,
+                     uint64_t track_uuid,
+                     double value) {
+    ProtoWriter event;
+    event.AppendVarint(kTrackEventType, kTypeCounter);
+    event.AppendVarint(kTrackEventTrackUuid, track_uuid);
+    event.AppendDouble(kTrackEventDoubleCounterValue, value);
+    AppendTrackEvent(timestamp, event);
+  }
+
+  const std::string& data() const { return trace_.data(); }
+
+ private:
+  void AppendTrackEvent(base::TimeDelta timestamp, const ProtoWriter& event) {
+    ProtoWriter packet;
+    packet.AppendVarint(kTracePacketTimestamp, timestamp.InNanoseconds());
+    packet.AppendMessage(kTracePacketTrackEvent, event);
+    AppendPacket(&packet);
+  }
+
+  void AppendPacket(ProtoWriter* packet) {
+    packet->AppendVarint(kTracePacketTrustedPacketSequenceId, kSequenceId);
+    trace_.AppendMessage(kTracePacket, *packet);
+  }
+
+  ProtoWriter trace_;
+};
+
+// Returns the percentage of |interval| during which tasks were stalled.
+double StallPercentage(base::TimeDelta stall, base::TimeDelta interval) {
+  return interval.is_positive() ? 100.0 * (stall / interval) : 0.0;
+}
+
+}  // namespace
+
+std::string ConvertToPerfettoTrace(
+    const std::vector<BootStat::BootEvent>& events) {
+  TraceWriter trace;
+  trace.AppendTrack(kBootstatTrackUuid, "bootstat", std::nullopt);
+  trace.AppendTrack(kCpuSomeTrackUuid, "CPU pressure stall (some)", "%");
+  trace.AppendTrack(kIoSomeTrackUuid, "IO pressure stall (some)", "%");
+  trace.AppendTrack(kIoFullTrackUuid, "IO pressure stall (full)", "%");
+
+  std::map<std::string, uint64_t> stage_tracks;
+  auto get_stage_track = [&](const std::string& stage) {
+    auto [it, inserted] = stage_tracks.emplace(
+        stage, kFirstStageTrackUuid + stage_tracks.size());
+    if (inserted)
+      trace.AppendTrack(it->second, stage, std::nullopt);
+    return it->second;
+  };
+
+  const BootStat::BootEvent* last_with_pressure_stall = nullptr;
+  for (const BootStat::BootEvent& event : events) {
+    trace.AppendEvent(event.uptime, kBootstatTrackUuid, kTypeInstant,
+                      event.name);
+
+    if (base::StartsWith(event.name, kStageBeginPrefix)) {
+      std::string stage = event.name.substr(strlen(kStageBeginPrefix));
+      trace.AppendEvent(event.uptime, get_stage_track(stage), kTypeSliceBegin,
+                        stage);
+    } else if (base::StartsWith(event.name, kStageEndPrefix)) {
+      std::string stage = event.name.substr(strlen(kStageEndPrefix));
+      auto it = stage_tracks.find(stage);
+      if (it != stage_tracks.end())
+        trace.AppendEvent(event.uptime, it->second, kTypeSliceEnd, "");
+    }
+
+    if (!event.pressure_stall)
+      continue;
+    if (last_with_pressure_stall) {
+      const PressureStall& last = *last_with_pressure_stall->pressure_stall;
+      const PressureStall& cur = *event.pressure_stall;
+      base::TimeDelta interval =
+          event.uptime - last_with_pressure_stall->uptime;
+      trace.AppendCounter(
+          event.uptime, kCpuSomeTrackUuid,
+          StallPercentage(cur.cpu_some - last.cpu_some, interval));
+      trace.AppendCounter(
+          event.uptime, kIoSomeTrackUuid,
+          StallPercentage(cur.io_some - last.io_some, interval));
+      trace.AppendCounter(
+          event.uptime, kIoFullTrackUuid,
+          StallPercentage(cur.io_full - last.io_full, interval));
+    }
+    last_with_pressure_stall = &event;
+  }
+
+  return trace.data();
+}
+
+}  // namespace bootstat
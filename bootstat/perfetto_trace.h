@@ -0,0 +1,32 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Conversion of the bootstat event log to a Perfetto trace.
+
+#ifndef BOOTSTAT_PERFETTO_TRACE_H_
+#define BOOTSTAT_PERFETTO_TRACE_H_
+
+#include <string>
+#include <vector>
+
+#include "bootstat/bootstat.h"
+
+namespace bootstat {
+
+// Returns a serialized perfetto.protos.Trace showing |events|:
+// - every event as an instant on the "bootstat" track,
+// - each "pre-<name>" and "post-<name>" events pair as a <name> slice, on its
+//   own track since stages may overlap,
+// - the share of time some tasks were stalled on CPU and IO between two
+//   events as counters, when the events have pressure stall information.
+//
+// Timestamps are in the CLOCK_BOOTTIME domain, the default clock of
+// Perfetto, so the trace can be concatenated with traces recorded during the
+// same boot, e.g. by perfetto_simple_producer.
+std::string ConvertToPerfettoTrace(
+    const std::vector<BootStat::BootEvent>& events);
+
+}  // namespace bootstat
+
+#endif  // BOOTSTAT_PERFETTO_TRACE_H_
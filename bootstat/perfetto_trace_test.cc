@@ -0,0 +1,220 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "bootstat/perfetto_trace.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <base/time/time.h>
+#include <gtest/gtest.h>
+
+namespace bootstat {
+
+namespace {
+
+// Fields of a decoded protobuf message, by field number. Length-delimited
+// fields are kept as bytes, to be decoded as messages or strings.
+struct Message {
+  std::map<uint32_t, std::vector<uint64_t>> varints;
+  std::map<uint32_t, std::vector<uint64_t>> fixed64s;
+  std::map<uint32_t, std::vector<std::string>> bytes;
+};
+
+bool ReadVarint(const std::string& data, size_t* pos, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64 && *pos < data.size(); shift += 7) {
+    uint8_t byte = data[(*pos)++];
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+Message Decode(const std::string& data) {
+  Message message;
+  size_t pos = 0;
+  while (pos < data.size()) {
+    uint64_t tag;
+    EXPECT_TRUE(ReadVarint(data, &pos, &tag));
+    uint32_t field = tag >> 3;
+    uint64_t value;
+    switch (tag & 7) {
+      case 0:
+        EXPECT_TRUE(ReadVarint(data, &pos, &value));
+        message.varints[field].push_back(value);
+        break;
+      case 1:
+        EXPECT_LE(pos + 8, data.size());
+        memcpy(&value, data.data() + pos, 8);
+        pos += 8;
+        message.fixed64s[field].push_back(value);
+        break;
+      case 2:
+        EXPECT_TRUE(ReadVarint(data, &pos, &value));
+        EXPECT_LE(pos + value, data.size());
+        message.bytes[field].push_back(data.substr(pos, value));
+        pos += value;
+        break;
+      default:
+        ADD_FAILURE() << "Unexpected wire type " << (tag & 7);
+        return message;
+    }
+  }
+  return message;
+}
+
+double AsDouble(uint64_t bits) {
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// A decoded TracePacket with a TrackEvent.
+struct TrackEvent {
+  uint64_t timestamp;
+  uint64_t type;
+  uint64_t track_uuid;
+  std::string name;
+  double counter_value;
+};
+
+class PerfettoTraceTest : public ::testing::Test {
+ protected:
+  // Decodes |trace| into |tracks_| (names by uuid) and |events_|.
+  void DecodeTrace(const std::string& trace) {
+    Message decoded = Decode(trace);
+    const std::vector<std::string>& packets = decoded.bytes[1];
+    ASSERT_FALSE(packets.empty());
+
+    // The first packet starts the sequence.
+    Message first = Decode(packets[0]);
+    EXPECT_EQ(first.varints[13], std::vector<uint64_t>{1});
+
+    for (const std::string& data : packets) {
+      Message packet = Decode(data);
+      EXPECT_EQ(packet.varints[10], std::vector<uint64_t>{1});
+      if (!packet.bytes[60].empty()) {
+        Message track = Decode(packet.bytes[60][0]);
+        tracks_[track.varints[1][0]] = track.bytes[2][0];
+      }
+      if (!packet.bytes[11].empty()) {
+        Message event = Decode(packet.bytes[11][0]);
+        TrackEvent track_event = {
+            .timestamp = packet.varints[8][0],
+            .type = event.varints[9][0],
+            .track_uuid = event.varints[11][0],
+        };
+        if (!event.bytes[23].empty())
+          track_event.name = event.bytes[23][0];
+        if (!event.fixed64s[44].empty())
+          track_event.counter_value = AsDouble(event.fixed64s[44][0]);
+        // Events may only refer to tracks described before them.
+        EXPECT_TRUE(tracks_.count(track_event.track_uuid));
+        events_.push_back(track_event);
+      }
+    }
+  }
+
+  std::vector<TrackEvent> EventsOnTrack(const std::string& track_name) {
+    std::vector<TrackEvent> result;
+    for (const TrackEvent& event : events_) {
+      if (tracks_[event.track_uuid] == track_name)
+        result.push_back(event);
+    }
+    return result;
+  }
+
+  std::map<uint64_t, std::string> tracks_;
+  std::vector<TrackEvent> events_;
+};
+
+}  // namespace
+
+TEST_F(PerfettoTraceTest, Empty) {
+  DecodeTrace(ConvertToPerfettoTrace({}));
+  EXPECT_TRUE(events_.empty());
+}
+
+TEST_F(PerfettoTraceTest, Instants) {
+  DecodeTrace(ConvertToPerfettoTrace({
+      {.name = "kernel", .uptime = base::Nanoseconds(1)},
+      {.name = "boot-complete", .uptime = base::Seconds(10)},
+  }));
+
+  std::vector<TrackEvent> events = EventsOnTrack("bootstat");
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, 3u);
+  EXPECT_EQ(events[0].timestamp, 1u);
+  EXPECT_EQ(events[0].name, "kernel");
+  EXPECT_EQ(events[1].type, 3u);
+  EXPECT_EQ(events[1].timestamp, 10000000000u);
+  EXPECT_EQ(events[1].name, "boot-complete");
+}
+
+TEST_F(PerfettoTraceTest, Stages) {
+  DecodeTrace(ConvertToPerfettoTrace({
+      {.name = "pre-a", .uptime = base::Milliseconds(1)},
+      {.name = "pre-b", .uptime = base::Milliseconds(2)},
+      {.name = "post-a", .uptime = base::Milliseconds(3)},
+      {.name = "post-b", .uptime = base::Milliseconds(4)},
+      {.name = "post-c", .uptime = base::Milliseconds(5)},
+  }));
+
+  EXPECT_EQ(EventsOnTrack("bootstat").size(), 5u);
+
+  std::vector<TrackEvent> a = EventsOnTrack("a");
+  ASSERT_EQ(a.size(), 2u);
+  EXPECT_EQ(a[0].type, 1u);
+  EXPECT_EQ(a[0].name, "a");
+  EXPECT_EQ(a[0].timestamp, 1000000u);
+  EXPECT_EQ(a[1].type, 2u);
+  EXPECT_EQ(a[1].timestamp, 3000000u);
+
+  std::vector<TrackEvent> b = EventsOnTrack("b");
+  ASSERT_EQ(b.size(), 2u);
+  EXPECT_EQ(b[0].timestamp, 2000000u);
+  EXPECT_EQ(b[1].timestamp, 4000000u);
+
+  // An end without a beginning is only an instant.
+  EXPECT_TRUE(EventsOnTrack("c").empty());
+}
+
+TEST_F(PerfettoTraceTest, PressureStall) {
+  DecodeTrace(ConvertToPerfettoTrace({
+      {.name = "first",
+       .uptime = base::Seconds(1),
+       .pressure_stall = PressureStall{}},
+      {.name = "no-psi", .uptime = base::Seconds(2)},
+      {.name = "second",
+       .uptime = base::Seconds(3),
+       .pressure_stall =
+           PressureStall{
+               .cpu_some = base::Seconds(1),
+               .io_some = base::Milliseconds(500),
+               .io_full = base::Milliseconds(100),
+           }},
+  }));
+
+  std::vector<TrackEvent> cpu_some = EventsOnTrack("CPU pressure stall (some)");
+  ASSERT_EQ(cpu_some.size(), 1u);
+  EXPECT_EQ(cpu_some[0].type, 4u);
+  EXPECT_EQ(cpu_some[0].timestamp, 3000000000u);
+  EXPECT_DOUBLE_EQ(cpu_some[0].counter_value, 50.0);
+
+  std::vector<TrackEvent> io_some = EventsOnTrack("IO pressure stall (some)");
+  ASSERT_EQ(io_some.size(), 1u);
+  EXPECT_DOUBLE_EQ(io_some[0].counter_value, 25.0);
+
+  std::vector<TrackEvent> io_full = EventsOnTrack("IO pressure stall (full)");
+  ASSERT_EQ(io_full.size(), 1u);
+  EXPECT_DOUBLE_EQ(io_full[0].counter_value, 5.0);
+}
+
+}  // namespace bootstat
@@ -6,7 +6,9 @@
 
 #include "camera/common/camera_buffer_pool.h"
 
+#include <algorithm>
 #include <optional>
+#include <utility>
 
 #include "cros-camera/common.h"
 
@@ -38,8 +40,9 @@ CameraBufferPool::Buffer& CameraBufferPool::Buffer::operator=(Buffer&& other) {
   return *this;
 }
 
-CameraBufferPool::BufferSlot::BufferSlot(ScopedBufferHandle handle)
-    : handle_(std::move(handle)) {}
+CameraBufferPool::BufferSlot::BufferSlot(CameraBufferPool* pool,
+                                         ScopedBufferHandle handle)
+    : pool_(pool), handle_(std::move(handle)) {}
 
 CameraBufferPool::Buffer CameraBufferPool::BufferSlot::Acquire() {
   DCHECK(!is_acquired_);
@@ -50,6 +53,7 @@ CameraBufferPool::Buffer CameraBufferPool::BufferSlot::Acquire() {
 void CameraBufferPool::BufferSlot::Release() {
   DCHECK(is_acquired_);
   is_acquired_ = false;
+  pool_->OnSlotReleased(this);
 }
 
 const ScopedMapping& CameraBufferPool::BufferSlot::Map() {
@@ -64,33 +68,55 @@ void CameraBufferPool::BufferSlot::Unmap() {
 }
 
 CameraBufferPool::~CameraBufferPool() {
-  auto it =
-      std::find_if(buffer_slots_.begin(), buffer_slots_.end(),
-                   [](const BufferSlot& slot) { return slot.is_acquired(); });
-  if (it != buffer_slots_.end()) {
+  if (free_slots_.size() != buffer_slots_.size()) {
     LOGF(FATAL) << "CameraBufferPool destructed when there's buffer in use";
   }
 }
 
 std::optional<CameraBufferPool::Buffer> CameraBufferPool::RequestBuffer() {
-  auto it =
-      std::find_if(buffer_slots_.begin(), buffer_slots_.end(),
-                   [](const BufferSlot& slot) { return !slot.is_acquired(); });
-  if (it != buffer_slots_.end()) {
-    return it->Acquire();
-  }
-  if (buffer_slots_.size() < options_.max_num_buffers) {
-    ScopedBufferHandle handle = CameraBufferManager::AllocateScopedBuffer(
-        options_.width, options_.height, options_.format, options_.usage);
-    if (!handle) {
+  if (free_slots_.empty()) {
+    if (buffer_slots_.size() >= options_.max_num_buffers) {
+      VLOGF(1) << "Buffer pool ran out of free buffers";
+      return std::nullopt;
+    }
+    if (!AllocateBuffer()) {
       return std::nullopt;
     }
-    buffer_slots_.emplace_back(std::move(handle));
     VLOGF(1) << "Increased pool buffer count to " << buffer_slots_.size();
-    return buffer_slots_.back().Acquire();
   }
-  VLOGF(1) << "Buffer pool ran out of free buffers";
-  return std::nullopt;
+  // Reuse the most recently released buffer, which is the most likely to be
+  // mapped and in the caches.
+  BufferSlot* slot = free_slots_.back();
+  free_slots_.pop_back();
+  max_num_buffers_in_use_ = std::max(max_num_buffers_in_use_,
+                                     buffer_slots_.size() - free_slots_.size());
+  return slot->Acquire();
+}
+
+bool CameraBufferPool::Preallocate(size_t num_buffers) {
+  num_buffers = std::min(num_buffers, options_.max_num_buffers);
+  while (buffer_slots_.size() < num_buffers) {
+    if (!AllocateBuffer()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CameraBufferPool::AllocateBuffer() {
+  ScopedBufferHandle handle = CameraBufferManager::AllocateScopedBuffer(
+      options_.width, options_.height, options_.format, options_.usage);
+  if (!handle) {
+    LOGF(ERROR) << "Failed to allocate buffer";
+    return false;
+  }
+  buffer_slots_.emplace_back(this, std::move(handle));
+  free_slots_.push_back(&buffer_slots_.back());
+  return true;
+}
+
+void CameraBufferPool::OnSlotReleased(BufferSlot* slot) {
+  free_slots_.push_back(slot);
 }
 
 }  // namespace cros
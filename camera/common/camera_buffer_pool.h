@@ -13,15 +13,16 @@
 #include <list>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "cros-camera/camera_buffer_manager.h"
 
 namespace cros {
 
 // CameraBufferPool owns a number of lazily allocated buffers, and provides
-// unique access to the buffer handles.  This class and its returned objects are
-// not thread-safe and the caller needs to ensure access to the buffers is
-// synchronized.
+// unique access to the buffer handles.  Free buffers are handed out in constant
+// time.  This class and its returned objects are not thread-safe and the caller
+// needs to ensure access to the buffers is synchronized.
 class CameraBufferPool {
  private:
   class BufferSlot;
@@ -76,10 +77,21 @@ class CameraBufferPool {
   // maximum.  The returned Buffer cannot out-live this class.
   std::optional<Buffer> RequestBuffer();
 
+  // Allocates buffers until |num_buffers|, capped at |max_num_buffers|, are
+  // allocated.  Callers can post this right after configuring the streams so
+  // that the first frames don't stall on the buffer allocation.  Returns false
+  // if an allocation failed.
+  bool Preallocate(size_t num_buffers);
+
+  size_t num_allocated_buffers() const { return buffer_slots_.size(); }
+
+  // The largest number of buffers that were in use at the same time.
+  size_t max_num_buffers_in_use() const { return max_num_buffers_in_use_; }
+
  private:
   class BufferSlot {
    public:
-    explicit BufferSlot(ScopedBufferHandle handle);
+    BufferSlot(CameraBufferPool* pool, ScopedBufferHandle handle);
 
     Buffer Acquire();
     void Release();
@@ -91,15 +103,25 @@ class CameraBufferPool {
     bool is_acquired() const { return is_acquired_; }
 
    private:
+    CameraBufferPool* const pool_;
     ScopedBufferHandle handle_;
     std::optional<ScopedMapping> mapping_;
     bool is_acquired_ = false;
   };
 
+  // Allocates a buffer into a new slot, and adds the slot to |free_slots_|.
+  bool AllocateBuffer();
+  void OnSlotReleased(BufferSlot* slot);
+
   Options options_;
 
   // Use std::list for pointer stability.
   std::list<BufferSlot> buffer_slots_;
+
+  // The slots not acquired, the most recently released last.
+  std::vector<BufferSlot*> free_slots_;
+
+  size_t max_num_buffers_in_use_ = 0;
 };
 
 }  // namespace cros
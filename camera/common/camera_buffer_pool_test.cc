@@ -68,6 +68,47 @@ TEST(CameraBufferPoolTest, RequestAndReleaseBuffers) {
   }
 }
 
+TEST(CameraBufferPoolTest, PreallocateAndTrackBuffersInUse) {
+  CameraBufferPool::Options options = {
+      .width = 320,
+      .height = 240,
+      .format = HAL_PIXEL_FORMAT_YCbCr_420_888,
+      .usage = 0,
+      .max_num_buffers = 4,
+  };
+  CameraBufferPool pool(options);
+
+  // Preallocation is capped at the maximum number of buffers.
+  ASSERT_TRUE(pool.Preallocate(2));
+  EXPECT_EQ(pool.num_allocated_buffers(), 2u);
+  ASSERT_TRUE(pool.Preallocate(10));
+  EXPECT_EQ(pool.num_allocated_buffers(), 4u);
+  EXPECT_EQ(pool.max_num_buffers_in_use(), 0u);
+
+  {
+    std::vector<CameraBufferPool::Buffer> buffers;
+    for (size_t i = 0; i < 3; ++i) {
+      std::optional<CameraBufferPool::Buffer> buffer = pool.RequestBuffer();
+      ASSERT_TRUE(buffer.has_value());
+      buffers.push_back(*std::move(buffer));
+    }
+  }
+  EXPECT_EQ(pool.max_num_buffers_in_use(), 3u);
+
+  // The most recently released buffer is handed out first.
+  buffer_handle_t* last_handle = nullptr;
+  {
+    std::optional<CameraBufferPool::Buffer> buffer = pool.RequestBuffer();
+    ASSERT_TRUE(buffer.has_value());
+    last_handle = buffer->handle();
+  }
+  std::optional<CameraBufferPool::Buffer> buffer = pool.RequestBuffer();
+  ASSERT_TRUE(buffer.has_value());
+  EXPECT_EQ(buffer->handle(), last_handle);
+  EXPECT_EQ(pool.num_allocated_buffers(), 4u);
+  EXPECT_EQ(pool.max_num_buffers_in_use(), 3u);
+}
+
 TEST(CameraBufferPoolTest, DestroyBufferPoolInUse) {
   CameraBufferPool::Options options = {
       .width = 320,
@@ -157,6 +157,9 @@ constexpr int kZoomRatioBuckets = 30;
 
 constexpr char kCameraAutoFramingError[] = "ChromeOS.Camera.AutoFraming.Error";
 
+constexpr char kCameraAutoFramingFullFrameBufferPoolUsage[] =
+    "ChromeOS.Camera.AutoFraming.FullFrameBufferPoolUsage";
+
 // *** Effects metrics ***
 constexpr char kCameraEffectUnknown[] = "Unknown";
 constexpr char kCameraEffectNone[] = "None";
@@ -473,6 +476,12 @@ void CameraMetricsImpl::SendAutoFramingError(AutoFramingError error) {
   metrics_lib_->SendEnumToUMA(kCameraAutoFramingError, error);
 }
 
+void CameraMetricsImpl::SendAutoFramingFullFrameBufferPoolUsage(
+    int percentage) {
+  metrics_lib_->SendPercentageToUMA(kCameraAutoFramingFullFrameBufferPoolUsage,
+                                    percentage);
+}
+
 void CameraMetricsImpl::SendEffectsSelectedEffect(CameraEffect effect) {
   metrics_lib_->SendEnumToUMA(kCameraEffectSelected, effect);
 }
@@ -63,6 +63,7 @@ class CameraMetricsImpl : public CameraMetrics {
   void SendAutoFramingAvgDetectionLatency(base::TimeDelta latency) override;
   void SendAutoFramingMedianZoomRatio(int zoom_ratio_tenths) override;
   void SendAutoFramingError(AutoFramingError error) override;
+  void SendAutoFramingFullFrameBufferPoolUsage(int percentage) override;
 
   void SendEffectsSelectedEffect(CameraEffect effect) override;
   void SendEffectsAvgProcessingLatency(CameraEffect effect,
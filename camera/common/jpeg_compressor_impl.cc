@@ -6,7 +6,9 @@
 
 #include "common/jpeg_compressor_impl.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include <errno.h>
@@ -15,8 +17,12 @@
 #include <time.h>
 
 #include <base/check.h>
+#include <base/functional/bind.h>
+#include <base/functional/callback.h>
 #include <base/memory/ptr_util.h>
 #include <base/memory/writable_shared_memory_region.h>
+#include <base/system/sys_info.h>
+#include <base/threading/simple_thread.h>
 #include <base/timer/elapsed_timer.h>
 #include "cros-camera/camera_buffer_manager.h"
 #include "cros-camera/camera_mojo_channel_manager.h"
@@ -38,6 +44,115 @@ struct destination_mgr {
   JpegCompressorImpl* compressor;
 };
 
+namespace {
+
+// Height and width of an MCU with the 4:2:0 subsampling used for encoding.
+constexpr int kMcuSize = 16;
+
+// Minimum number of MCU rows of a strip encoded on its own thread, so that
+// small images are not worth starting threads for.
+constexpr int kMinMcuRowsPerStrip = 32;
+
+// Maximum number of strips an image is encoded in.
+constexpr int kMaxEncodeStrips = 4;
+
+// The restart interval is stored in 2 bytes of the DRI segment.
+constexpr int kMaxRestartInterval = 65535;
+
+// Restart markers RST0 to RST7 are used in turn.
+constexpr int kNumRestartMarkers = 8;
+
+constexpr uint8_t kJpegMarkerPrefix = 0xFF;
+constexpr uint8_t kJpegSof0Marker = 0xC0;
+constexpr uint8_t kJpegSosMarker = 0xDA;
+
+// Offset of the image height in the SOF0 segment, after the marker, the
+// segment length and the sample precision.
+constexpr size_t kSofHeightOffset = 5;
+
+// Returns the size of each chroma plane of a |width| x |height| I420 image. An
+// odd height has a chroma row for its last row.
+size_t GetI420ChromaPlaneSize(int width, int height) {
+  return width / 2 * ((height + 1) / 2);
+}
+
+// Returns the number of strips a |width| x |height| image is encoded in by
+// software. A single strip means the image is encoded in one pass.
+int GetNumEncodeStrips(int width, int height) {
+  const int mcu_rows = (height + kMcuSize - 1) / kMcuSize;
+  const int mcu_cols = (width + kMcuSize - 1) / kMcuSize;
+  const int num_strips =
+      std::min({kMaxEncodeStrips, base::SysInfo::NumberOfProcessors(),
+                mcu_rows / kMinMcuRowsPerStrip});
+  if (num_strips <= 1) {
+    return 1;
+  }
+  // Each strip is one restart interval of the joined image.
+  const int strip_mcu_rows = (mcu_rows + num_strips - 1) / num_strips;
+  if (mcu_cols * strip_mcu_rows > kMaxRestartInterval) {
+    return 1;
+  }
+  return num_strips;
+}
+
+// Runs the encoding of a strip on a thread of the pool.
+class StripEncodeTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit StripEncodeTask(base::OnceCallback<bool()> encoder)
+      : encoder_(std::move(encoder)) {}
+  StripEncodeTask(const StripEncodeTask&) = delete;
+  StripEncodeTask& operator=(const StripEncodeTask&) = delete;
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override { success_ = std::move(encoder_).Run(); }
+
+  bool success() const { return success_; }
+
+ private:
+  base::OnceCallback<bool()> encoder_;
+  bool success_ = false;
+};
+
+// Where the segments are in a baseline JPEG image written by libjpeg.
+struct JpegLayout {
+  // Offset of the SOF0 marker.
+  size_t sof_offset;
+  // Offset and size of the entropy-coded data, which ends before EOI.
+  size_t scan_offset;
+  size_t scan_size;
+};
+
+std::optional<JpegLayout> ParseJpegLayout(const std::vector<uint8_t>& jpeg) {
+  if (jpeg.size() < 4 || jpeg[jpeg.size() - 2] != kJpegMarkerPrefix ||
+      jpeg[jpeg.size() - 1] != JPEG_EOI) {
+    return std::nullopt;
+  }
+  const size_t scan_end = jpeg.size() - 2;
+  std::optional<size_t> sof_offset;
+  // Skip SOI, and walk the segments up to the SOS one.
+  size_t offset = 2;
+  while (offset + 4 <= scan_end) {
+    if (jpeg[offset] != kJpegMarkerPrefix) {
+      return std::nullopt;
+    }
+    const uint8_t marker = jpeg[offset + 1];
+    const size_t length = (jpeg[offset + 2] << 8) | jpeg[offset + 3];
+    if (marker == kJpegSof0Marker) {
+      sof_offset = offset;
+    }
+    offset += 2 + length;
+    if (marker == kJpegSosMarker) {
+      if (!sof_offset.has_value() || offset > scan_end) {
+        return std::nullopt;
+      }
+      return JpegLayout{*sof_offset, offset, scan_end - offset};
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
 // static
 std::unique_ptr<JpegCompressor> JpegCompressor::GetInstance() {
   return JpegCompressor::GetInstance(CameraMojoChannelManager::GetInstance());
@@ -615,13 +730,42 @@ bool JpegCompressorImpl::EncodeSw(const android_ycbcr& input_ycbcr,
   DCHECK(input_format == V4L2_PIX_FMT_NV12 ||
          input_format == V4L2_PIX_FMT_NV12M);
 
+  const int num_strips = GetNumEncodeStrips(width, height);
+  const bool success =
+      num_strips > 1
+          ? EncodeSwInStrips(input_ycbcr, output_ptr, output_buffer_size,
+                             width, height, jpeg_quality, app1_buffer,
+                             app1_size, num_strips, out_data_size)
+          : EncodeSwInOnePass(input_ycbcr, output_ptr, output_buffer_size,
+                              width, height, jpeg_quality, app1_buffer,
+                              app1_size, out_data_size);
+  if (success) {
+    camera_metrics_->SendJpegProcessLatency(JpegProcessType::kEncode,
+                                            JpegProcessMethod::kSoftware,
+                                            timer.Elapsed());
+    camera_metrics_->SendJpegResolution(
+        JpegProcessType::kEncode, JpegProcessMethod::kSoftware, width, height);
+  }
+  return success;
+}
+
+bool JpegCompressorImpl::EncodeSwInOnePass(const android_ycbcr& input_ycbcr,
+                                           void* output_ptr,
+                                           int output_buffer_size,
+                                           int width,
+                                           int height,
+                                           int jpeg_quality,
+                                           const void* app1_buffer,
+                                           unsigned int app1_size,
+                                           uint32_t* out_data_size) {
   size_t y_plane_size = width * height;
+  size_t uv_plane_size = GetI420ChromaPlaneSize(width, height);
 
   std::vector<uint8_t> i420_buffer;
-  i420_buffer.resize(y_plane_size * 3 / 2);
+  i420_buffer.resize(y_plane_size + 2 * uv_plane_size);
   uint8_t* i420_y_plane = i420_buffer.data();
   uint8_t* i420_u_plane = i420_y_plane + y_plane_size;
-  uint8_t* i420_v_plane = i420_u_plane + y_plane_size / 4;
+  uint8_t* i420_v_plane = i420_u_plane + uv_plane_size;
 
   int result = libyuv::NV12ToI420(
       static_cast<const uint8_t*>(input_ycbcr.y), input_ycbcr.ystride,
@@ -668,15 +812,162 @@ bool JpegCompressorImpl::EncodeSw(const android_ycbcr& input_ycbcr,
 
   if (is_encode_success_) {
     *out_data_size = out_data_size_;
-    camera_metrics_->SendJpegProcessLatency(JpegProcessType::kEncode,
-                                            JpegProcessMethod::kSoftware,
-                                            timer.Elapsed());
-    camera_metrics_->SendJpegResolution(
-        JpegProcessType::kEncode, JpegProcessMethod::kSoftware, width, height);
   }
   return is_encode_success_;
 }
 
+bool JpegCompressorImpl::EncodeSwInStrips(const android_ycbcr& input_ycbcr,
+                                          void* output_ptr,
+                                          int output_buffer_size,
+                                          int width,
+                                          int height,
+                                          int jpeg_quality,
+                                          const void* app1_buffer,
+                                          unsigned int app1_size,
+                                          int num_strips,
+                                          uint32_t* out_data_size) {
+  // Every strip but the last one is a whole number of MCU rows, so that each
+  // strip is exactly one restart interval of the joined image.
+  const int mcu_rows = (height + kMcuSize - 1) / kMcuSize;
+  const int mcu_cols = (width + kMcuSize - 1) / kMcuSize;
+  const int strip_mcu_rows = (mcu_rows + num_strips - 1) / num_strips;
+  const int strip_height = strip_mcu_rows * kMcuSize;
+  const unsigned int restart_interval = mcu_cols * strip_mcu_rows;
+
+  const uint8_t* y_plane = static_cast<const uint8_t*>(input_ycbcr.y);
+  const uint8_t* uv_plane = static_cast<const uint8_t*>(input_ycbcr.cb);
+  std::vector<std::vector<uint8_t>> strips(num_strips);
+  std::vector<std::unique_ptr<StripEncodeTask>> tasks;
+  for (int i = 0; i < num_strips; ++i) {
+    const int top = i * strip_height;
+    const bool is_first = i == 0;
+    tasks.push_back(std::make_unique<StripEncodeTask>(base::BindOnce(
+        &JpegCompressorImpl::EncodeSwStrip, y_plane + top * input_ycbcr.ystride,
+        input_ycbcr.ystride, uv_plane + top / 2 * input_ycbcr.cstride,
+        input_ycbcr.cstride, width, std::min(strip_height, height - top),
+        jpeg_quality, restart_interval, is_first ? app1_buffer : nullptr,
+        is_first ? app1_size : 0, &strips[i])));
+  }
+  base::DelegateSimpleThreadPool pool(
+      "JpegEncoder",
+      std::min(num_strips, base::SysInfo::NumberOfProcessors()));
+  for (auto& task : tasks) {
+    pool.AddWork(task.get());
+  }
+  pool.Start();
+  pool.JoinAll();
+  for (const auto& task : tasks) {
+    if (!task->success()) {
+      LOGF(ERROR) << "Failed to encode a strip of the image";
+      return false;
+    }
+  }
+
+  // Keep the headers of the first strip, with the height of the whole image,
+  // and append the entropy-coded data of the other strips after restart
+  // markers.
+  std::vector<JpegLayout> layouts;
+  size_t joined_size = 0;
+  for (const auto& strip : strips) {
+    std::optional<JpegLayout> layout = ParseJpegLayout(strip);
+    if (!layout.has_value()) {
+      LOGF(ERROR) << "Failed to parse the JPEG image of a strip";
+      return false;
+    }
+    joined_size += layouts.empty() ? layout->scan_offset : 2;
+    joined_size += layout->scan_size;
+    layouts.push_back(*layout);
+  }
+  joined_size += 2;
+  if (joined_size > static_cast<size_t>(output_buffer_size)) {
+    LOGF(ERROR) << "Output buffer is too small: " << output_buffer_size
+                << " < " << joined_size;
+    return false;
+  }
+
+  uint8_t* out = static_cast<uint8_t*>(output_ptr);
+  std::copy_n(strips[0].begin(), layouts[0].scan_offset + layouts[0].scan_size,
+              out);
+  out[layouts[0].sof_offset + kSofHeightOffset] = height >> 8;
+  out[layouts[0].sof_offset + kSofHeightOffset + 1] = height & 0xFF;
+  out += layouts[0].scan_offset + layouts[0].scan_size;
+  for (int i = 1; i < num_strips; ++i) {
+    *out++ = kJpegMarkerPrefix;
+    *out++ = JPEG_RST0 + (i - 1) % kNumRestartMarkers;
+    out = std::copy_n(strips[i].begin() + layouts[i].scan_offset,
+                      layouts[i].scan_size, out);
+  }
+  *out++ = kJpegMarkerPrefix;
+  *out++ = JPEG_EOI;
+  *out_data_size = joined_size;
+  return true;
+}
+
+// static
+bool JpegCompressorImpl::EncodeSwStrip(const uint8_t* y_plane,
+                                       int y_stride,
+                                       const uint8_t* uv_plane,
+                                       int uv_stride,
+                                       int width,
+                                       int height,
+                                       int jpeg_quality,
+                                       unsigned int restart_interval,
+                                       const void* app1_buffer,
+                                       unsigned int app1_size,
+                                       std::vector<uint8_t>* output) {
+  size_t y_plane_size = width * height;
+  size_t uv_plane_size = GetI420ChromaPlaneSize(width, height);
+  std::vector<uint8_t> i420_buffer(y_plane_size + 2 * uv_plane_size);
+  uint8_t* i420_y_plane = i420_buffer.data();
+  uint8_t* i420_u_plane = i420_y_plane + y_plane_size;
+  uint8_t* i420_v_plane = i420_u_plane + uv_plane_size;
+  int result = libyuv::NV12ToI420(y_plane, y_stride, uv_plane, uv_stride,
+                                  i420_y_plane, width, i420_u_plane, width / 2,
+                                  i420_v_plane, width / 2, width, height);
+  if (result != 0) {
+    LOGF(INFO) << "Failed to convert image format when doing SW encoding: "
+               << result;
+    return false;
+  }
+
+  jpeg_compress_struct cinfo;
+  jpeg_error_mgr jerr;
+  unsigned char* mem_buffer = nullptr;
+  unsigned long mem_size = 0;  // NOLINT(runtime/int)
+
+  cinfo.err = jpeg_std_error(&jerr);
+  cinfo.err->output_message = &OutputErrorMessage;
+  jpeg_create_compress(&cinfo);
+  jpeg_mem_dest(&cinfo, &mem_buffer, &mem_size);
+
+  SetJpegCompressStruct(width, height, jpeg_quality, &cinfo);
+  // The standard Huffman tables are shared by all the strips, and must not be
+  // optimized per strip.
+  cinfo.optimize_coding = FALSE;
+  cinfo.restart_interval = restart_interval;
+
+  if (app1_buffer != nullptr && app1_size > 0) {
+    cinfo.write_Adobe_marker = false;
+    cinfo.write_JFIF_header = false;
+  }
+
+  jpeg_start_compress(&cinfo, TRUE);
+
+  if (app1_buffer != nullptr && app1_size > 0) {
+    jpeg_write_marker(&cinfo, JPEG_APP0 + 1,
+                      static_cast<const JOCTET*>(app1_buffer), app1_size);
+  }
+
+  const bool success = Compress(&cinfo, i420_y_plane);
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  if (success) {
+    output->assign(mem_buffer, mem_buffer + mem_size);
+  }
+  free(mem_buffer);
+  return success;
+}
+
 void JpegCompressorImpl::SetJpegDestination(jpeg_compress_struct* cinfo) {
   destination_mgr* dest =
       static_cast<struct destination_mgr*>((*cinfo->mem->alloc_small)(
@@ -721,7 +1012,8 @@ bool JpegCompressorImpl::Compress(jpeg_compress_struct* cinfo,
   JSAMPARRAY planes[3]{y, cb, cr};
 
   size_t y_plane_size = cinfo->image_width * cinfo->image_height;
-  size_t uv_plane_size = y_plane_size / 4;
+  size_t uv_plane_size =
+      GetI420ChromaPlaneSize(cinfo->image_width, cinfo->image_height);
   uint8_t* y_plane = const_cast<uint8_t*>(yuv);
   uint8_t* u_plane = const_cast<uint8_t*>(yuv + y_plane_size);
   uint8_t* v_plane = const_cast<uint8_t*>(yuv + y_plane_size + uv_plane_size);
@@ -740,7 +1032,7 @@ bool JpegCompressorImpl::Compress(jpeg_compress_struct* cinfo,
     // cb, cr only have half scanlines
     for (int i = 0; i < kCompressBatchSize / 2; ++i) {
       size_t scanline = cinfo->next_scanline / 2 + i;
-      if (scanline < cinfo->image_height / 2) {
+      if (scanline < (cinfo->image_height + 1) / 2) {
         int offset = scanline * (cinfo->image_width / 2);
         cb[i] = u_plane + offset;
         cr[i] = v_plane + offset;
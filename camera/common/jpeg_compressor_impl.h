@@ -26,6 +26,12 @@ extern "C" {
 
 namespace cros {
 
+namespace tests {
+
+class JpegCompressorImplTest;
+
+}  // namespace tests
+
 class JpegEncodeAccelerator;
 
 // Implementation of JpegCompressor. This class is not thread-safe.
@@ -79,6 +85,9 @@ class JpegCompressorImpl : public JpegCompressor {
                          uint32_t* out_data_size) override;
 
  private:
+  // Allow unit tests to call the software encoders directly.
+  friend class tests::JpegCompressorImplTest;
+
   // InitDestination(), EmptyOutputBuffer() and TerminateDestination() are
   // callback functions to be passed into jpeg library.
   static void InitDestination(j_compress_ptr cinfo);
@@ -128,13 +137,54 @@ class JpegCompressorImpl : public JpegCompressor {
                 unsigned int app1_size,
                 uint32_t* out_data_size);
 
+  // Encodes the whole image at once with the destination manager writing to
+  // |output_ptr|. Returns false if errors occur.
+  bool EncodeSwInOnePass(const android_ycbcr& input_ycbcr,
+                         void* output_ptr,
+                         int output_buffer_size,
+                         int width,
+                         int height,
+                         int jpeg_quality,
+                         const void* app1_ptr,
+                         unsigned int app1_size,
+                         uint32_t* out_data_size);
+
+  // Encodes |num_strips| horizontal strips of the image in parallel, and joins
+  // them into |output_ptr| as the restart intervals of a single image.
+  // Returns false if errors occur.
+  bool EncodeSwInStrips(const android_ycbcr& input_ycbcr,
+                        void* output_ptr,
+                        int output_buffer_size,
+                        int width,
+                        int height,
+                        int jpeg_quality,
+                        const void* app1_ptr,
+                        unsigned int app1_size,
+                        int num_strips,
+                        uint32_t* out_data_size);
+
+  // Encodes a strip of an NV12 image as a standalone JPEG image in |output|,
+  // with |restart_interval| set. Can run on any thread. Returns false if
+  // errors occur.
+  static bool EncodeSwStrip(const uint8_t* y_plane,
+                            int y_stride,
+                            const uint8_t* uv_plane,
+                            int uv_stride,
+                            int width,
+                            int height,
+                            int jpeg_quality,
+                            unsigned int restart_interval,
+                            const void* app1_ptr,
+                            unsigned int app1_size,
+                            std::vector<uint8_t>* output);
+
   void SetJpegDestination(jpeg_compress_struct* cinfo);
-  void SetJpegCompressStruct(int width,
-                             int height,
-                             int quality,
-                             jpeg_compress_struct* cinfo);
+  static void SetJpegCompressStruct(int width,
+                                    int height,
+                                    int quality,
+                                    jpeg_compress_struct* cinfo);
   // Returns false if errors occur.
-  bool Compress(jpeg_compress_struct* cinfo, const uint8_t* yuv);
+  static bool Compress(jpeg_compress_struct* cinfo, const uint8_t* yuv);
 
   // Metrics that used to record things like encoding latency.
   std::unique_ptr<CameraMetrics> camera_metrics_;
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 The ChromiumOS Authors
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "common/jpeg_compressor_impl.h"
+
+#include <cstdio>
+#include <vector>
+
+#include <base/at_exit.h>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <jpeglib.h>
+}
+
+namespace cros {
+
+namespace tests {
+
+constexpr int kWidth = 64;
+constexpr int kQuality = 90;
+
+class JpegCompressorImplTest : public ::testing::Test {
+ public:
+  JpegCompressorImplTest() : compressor_(/*token=*/nullptr) {}
+  JpegCompressorImplTest(const JpegCompressorImplTest&) = delete;
+  JpegCompressorImplTest& operator=(const JpegCompressorImplTest&) = delete;
+
+ protected:
+  // Fills a |kWidth| x |height| NV12 image with a pattern which varies across
+  // the MCUs, so that misplaced strips show up in the decoded image.
+  void CreateImage(int height) {
+    y_plane_.resize(kWidth * height);
+    uv_plane_.resize(kWidth * ((height + 1) / 2));
+    for (int row = 0; row < height; ++row) {
+      for (int col = 0; col < kWidth; ++col) {
+        y_plane_[row * kWidth + col] = (row * 7 + col * 3) & 0xFF;
+      }
+    }
+    for (size_t i = 0; i < uv_plane_.size(); ++i) {
+      uv_plane_[i] = (i * 5) & 0xFF;
+    }
+    ycbcr_ = {
+        .y = y_plane_.data(),
+        .cb = uv_plane_.data(),
+        .cr = uv_plane_.data() + 1,
+        .ystride = kWidth,
+        .cstride = kWidth,
+        .chroma_step = 2,
+    };
+  }
+
+  std::vector<uint8_t> EncodeInOnePass(int height) {
+    std::vector<uint8_t> jpeg(kWidth * height * 3 + kHeadersSize);
+    uint32_t size = 0;
+    EXPECT_TRUE(compressor_.EncodeSwInOnePass(ycbcr_, jpeg.data(), jpeg.size(),
+                                              kWidth, height, kQuality,
+                                              nullptr, 0, &size));
+    jpeg.resize(size);
+    return jpeg;
+  }
+
+  std::vector<uint8_t> EncodeInStrips(int height, int num_strips) {
+    std::vector<uint8_t> jpeg(kWidth * height * 3 + kHeadersSize);
+    uint32_t size = 0;
+    EXPECT_TRUE(compressor_.EncodeSwInStrips(ycbcr_, jpeg.data(), jpeg.size(),
+                                             kWidth, height, kQuality, nullptr,
+                                             0, num_strips, &size));
+    jpeg.resize(size);
+    return jpeg;
+  }
+
+  // Decodes |jpeg| to YCbCr. Returns an empty vector if it is not a valid
+  // |kWidth| x |height| image.
+  static std::vector<uint8_t> Decode(const std::vector<uint8_t>& jpeg,
+                                     int height) {
+    jpeg_decompress_struct cinfo;
+    jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, jpeg.data(), jpeg.size());
+    std::vector<uint8_t> pixels;
+    if (jpeg_read_header(&cinfo, TRUE) == JPEG_HEADER_OK &&
+        cinfo.image_width == kWidth && cinfo.image_height == height) {
+      cinfo.out_color_space = JCS_YCbCr;
+      jpeg_start_decompress(&cinfo);
+      const int row_size = cinfo.output_width * cinfo.output_components;
+      pixels.resize(row_size * cinfo.output_height);
+      while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = pixels.data() + cinfo.output_scanline * row_size;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+      }
+      jpeg_finish_decompress(&cinfo);
+    }
+    // Corrupt data only causes warnings, which are counted.
+    if (jerr.num_warnings > 0) {
+      pixels.clear();
+    }
+    jpeg_destroy_decompress(&cinfo);
+    return pixels;
+  }
+
+  // Upper bound of the size of the JPEG headers.
+  static constexpr size_t kHeadersSize = 4096;
+
+  JpegCompressorImpl compressor_;
+  std::vector<uint8_t> y_plane_;
+  std::vector<uint8_t> uv_plane_;
+  android_ycbcr ycbcr_;
+};
+
+// The image encoded in strips decodes to the same pixels as the image encoded
+// in one pass, since both have the same DCT coefficients.
+TEST_F(JpegCompressorImplTest, StripsMatchOnePass) {
+  // The heights are not multiples of the 16-row MCU, so that the last strip
+  // is partial and, for the odd heights, has a chroma row for its last row.
+  const struct {
+    int height;
+    int num_strips;
+  } kTestCases[] = {
+      {64, 2}, {70, 3}, {71, 2}, {99, 4}, {90, 3},
+  };
+  for (const auto& test_case : kTestCases) {
+    SCOPED_TRACE(testing::Message() << "height " << test_case.height << ", "
+                                    << test_case.num_strips << " strips");
+    CreateImage(test_case.height);
+    std::vector<uint8_t> one_pass =
+        Decode(EncodeInOnePass(test_case.height), test_case.height);
+    ASSERT_FALSE(one_pass.empty());
+    std::vector<uint8_t> strips = Decode(
+        EncodeInStrips(test_case.height, test_case.num_strips),
+        test_case.height);
+    EXPECT_EQ(strips, one_pass);
+  }
+}
+
+}  // namespace tests
+
+}  // namespace cros
+
+int main(int argc, char** argv) {
+  base::AtExitManager exit_manager;
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include <base/files/file_path.h>
+#include <base/strings/stringprintf.h>
 #include <base/synchronization/lock.h>
 #include <base/thread_annotations.h>
 
@@ -60,6 +61,11 @@ namespace cros {
 
 namespace {
 
+// Number of results waiting for a stage above which the stage is reported as
+// falling behind. The results are never dropped, as the framework expects all
+// of them back.
+constexpr int kMaxPendingResultsPerStage = 8;
+
 void MaybeEnableHdrNetStreamManipulator(
     const FeatureProfile& feature_profile,
     StreamManipulator::RuntimeOptions* runtime_options,
@@ -151,9 +157,7 @@ StreamManipulatorManager::StreamManipulatorManager(
     CreateOptions create_options,
     StreamManipulator::RuntimeOptions* runtime_options,
     GpuResources* gpu_resources,
-    CameraMojoChannelManagerToken* mojo_manager_token)
-    : default_capture_result_thread_("DefaultCaptureResultThread") {
-  CHECK(default_capture_result_thread_.Start());
+    CameraMojoChannelManagerToken* mojo_manager_token) {
   TRACE_COMMON();
 
   FeatureProfile feature_profile;
@@ -229,21 +233,26 @@ StreamManipulatorManager::StreamManipulatorManager(
 }
 
 StreamManipulatorManager::StreamManipulatorManager(
-    std::vector<std::unique_ptr<StreamManipulator>> stream_manipulators)
-    : default_capture_result_thread_("DefaultCaptureResultThread") {
-  CHECK(default_capture_result_thread_.Start());
+    std::vector<std::unique_ptr<StreamManipulator>> stream_manipulators) {
   TRACE_COMMON();
 
   stream_manipulators_ = std::move(stream_manipulators);
 }
 
+StreamManipulatorManager::ResultStage::ResultStage() = default;
+
+StreamManipulatorManager::ResultStage::~ResultStage() = default;
+
 StreamManipulatorManager::~StreamManipulatorManager() {
   TRACE_COMMON();
   StopProcessing();
-  // Destruct stream manipulators in the reverse order to ensure that
-  // ProcessCaptureResultOnStreamManipulator() does not post tasks to destructed
-  // stream manipulators.
+  // Destruct stream manipulators in the reverse order, each after the thread
+  // of its stage, to ensure that ProcessCaptureResultOnStreamManipulator() does
+  // not post tasks to destructed stream manipulators.
   while (!stream_manipulators_.empty()) {
+    if (result_stages_.size() == stream_manipulators_.size()) {
+      result_stages_.pop_back();
+    }
     stream_manipulators_.pop_back();
   }
 }
@@ -289,9 +298,27 @@ bool StreamManipulatorManager::Initialize(
                 &StreamManipulatorManager::NotifyOnStreamManipulator,
                 base::Unretained(this), i - 1)});
   }
+  SetUpResultStages();
   return true;
 }
 
+void StreamManipulatorManager::SetUpResultStages() {
+  if (!result_stages_.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < stream_manipulators_.size(); ++i) {
+    auto stage = std::make_unique<ResultStage>();
+    stage->task_runner = stream_manipulators_[i]->GetTaskRunner();
+    if (stage->task_runner == nullptr) {
+      stage->thread = std::make_unique<base::Thread>(
+          base::StringPrintf("CaptureResultStage%zu", i));
+      CHECK(stage->thread->Start());
+      stage->task_runner = stage->thread->task_runner();
+    }
+    result_stages_.push_back(std::move(stage));
+  }
+}
+
 bool StreamManipulatorManager::ConfigureStreams(
     Camera3StreamConfiguration* stream_config,
     const StreamEffectMap* stream_effects_map) {
@@ -410,18 +437,34 @@ void StreamManipulatorManager::ProcessCaptureResultOnStreamManipulator(
          stream_manipulator_index < stream_manipulators_.size());
   InspectResult(stream_manipulator_index + 1, result);
 
-  auto task_runner =
-      stream_manipulators_[stream_manipulator_index]->GetTaskRunner();
-  if (task_runner == nullptr) {
-    task_runner = default_capture_result_thread_.task_runner();
+  ResultStage& stage = *result_stages_[stream_manipulator_index];
+  if (++stage.num_pending_results == kMaxPendingResultsPerStage + 1) {
+    LOGF(WARNING) << "Capture result stage " << stream_manipulator_index
+                  << " is falling behind: more than "
+                  << kMaxPendingResultsPerStage << " results pending";
   }
-  task_runner->PostTask(
+  stage.task_runner->PostTask(
       FROM_HERE,
-      base::BindOnce(
-          base::IgnoreResult(&StreamManipulator::ProcessCaptureResult),
-          base::Unretained(
-              stream_manipulators_[stream_manipulator_index].get()),
-          std::move(result)));
+      base::BindOnce(&StreamManipulatorManager::RunProcessCaptureResult,
+                     base::Unretained(this), stream_manipulator_index,
+                     base::TimeTicks::Now(), std::move(result)));
+}
+
+void StreamManipulatorManager::RunProcessCaptureResult(
+    int stream_manipulator_index,
+    base::TimeTicks post_time,
+    Camera3CaptureDescriptor result) {
+  ResultStage& stage = *result_stages_[stream_manipulator_index];
+  const int num_pending_results = --stage.num_pending_results;
+  TRACE_COMMON_EVENT("SM::ProcessCaptureResult", "stage",
+                     stream_manipulator_index, "queue_delay_us",
+                     (base::TimeTicks::Now() - post_time).InMicroseconds(),
+                     "pending_results", num_pending_results,
+                     [&](perfetto::EventContext ctx) {
+                       result.PopulateEventAnnotation(ctx);
+                     });
+  stream_manipulators_[stream_manipulator_index]->ProcessCaptureResult(
+      std::move(result));
 }
 
 void StreamManipulatorManager::NotifyOnStreamManipulator(
@@ -430,12 +473,7 @@ void StreamManipulatorManager::NotifyOnStreamManipulator(
 
   DCHECK(0 <= stream_manipulator_index &&
          stream_manipulator_index < stream_manipulators_.size());
-  auto task_runner =
-      stream_manipulators_[stream_manipulator_index]->GetTaskRunner();
-  if (task_runner == nullptr) {
-    task_runner = default_capture_result_thread_.task_runner();
-  }
-  task_runner->PostTask(
+  result_stages_[stream_manipulator_index]->task_runner->PostTask(
       FROM_HERE,
       base::BindOnce(base::IgnoreResult(&StreamManipulator::Notify),
                      base::Unretained(
@@ -18,6 +18,8 @@
 #include <base/synchronization/lock.h>
 #include <base/synchronization/waitable_event.h>
 #include <base/thread_annotations.h>
+#include <base/threading/thread.h>
+#include <base/time/time.h>
 
 #include "common/camera_hal3_helpers.h"
 #include "common/camera_metadata_inspector.h"
@@ -82,10 +84,34 @@ class CROS_CAMERA_EXPORT StreamManipulatorManager {
   // for debugging if enabled.
   std::unique_ptr<CameraMetadataInspector> camera_metadata_inspector_;
 
-  // A thread where StreamManipulator::ProcessCaptureResult() runs if
-  // StreamManipulator does not specify a thread for the task via
-  // StreamManipulator::GetTaskRunner().
-  base::Thread default_capture_result_thread_;
+  // A stage of the capture result pipeline, where one StreamManipulator
+  // processes the results and messages. Each stage runs on its own thread, so
+  // that a stage can work on a result while a slower next stage is still
+  // working on the previous one.
+  struct ResultStage {
+    ResultStage();
+    ~ResultStage();
+
+    // The task runner returned by StreamManipulator::GetTaskRunner(), or the
+    // one of |thread| if the StreamManipulator does not specify one.
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner;
+    std::unique_ptr<base::Thread> thread;
+
+    // Number of results posted to |task_runner| and not processed yet.
+    std::atomic<int> num_pending_results = 0;
+  };
+
+  // Sets up |result_stages_| once the stream manipulators are initialized.
+  void SetUpResultStages();
+
+  // Runs StreamManipulator::ProcessCaptureResult() of the stage at
+  // |stream_manipulator_index|, for |result| posted at |post_time|.
+  void RunProcessCaptureResult(int stream_manipulator_index,
+                               base::TimeTicks post_time,
+                               Camera3CaptureDescriptor result);
+
+  // The stages of the capture result pipeline, one per StreamManipulator.
+  std::vector<std::unique_ptr<ResultStage>> result_stages_;
 
   // A callback that is called by StreamManipulator to call the next
   // StreamManipulator::ProcessCaptureResult(). |stream_manipulator_index| is
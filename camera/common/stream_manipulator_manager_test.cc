@@ -10,6 +10,7 @@
 
 #include <base/command_line.h>
 #include <base/synchronization/waitable_event.h>
+#include <base/threading/platform_thread.h>
 #include <base/time/time.h>
 
 // gtest's internal typedef of None and Bool conflicts with the None and Bool
@@ -70,6 +71,7 @@ class FakeStreamManipulator : public StreamManipulator {
   bool ProcessCaptureResult(Camera3CaptureDescriptor result) override {
     EXPECT_EQ(thread_.task_runner()->BelongsToCurrentThread(), use_thread_);
     ++process_capture_result_call_counts_;
+    process_capture_result_thread_id_ = base::PlatformThread::CurrentId();
     base::PlatformThread::Sleep(base::Microseconds(fake_processing_time_us_));
     callbacks_.result_callback.Run(std::move(result));
     return true;
@@ -93,12 +95,18 @@ class FakeStreamManipulator : public StreamManipulator {
     return process_capture_result_call_counts_;
   }
 
+  base::PlatformThreadId process_capture_result_thread_id() {
+    return process_capture_result_thread_id_;
+  }
+
  private:
   bool use_thread_;
   uint64_t fake_processing_time_us_;
   base::Thread thread_;
   Callbacks callbacks_;
   int process_capture_result_call_counts_ = 0;
+  base::PlatformThreadId process_capture_result_thread_id_ =
+      base::kInvalidThreadId;
 };
 
 Camera3CaptureDescriptor CreateFakeCaptureResult(uint32_t frame_number) {
@@ -335,6 +343,40 @@ TEST(StreamManipulatorManagerTest, SynchronizationTest) {
   manager.Flush();
 }
 
+// Test that the stream manipulators without their own thread process results
+// on separate threads, so that they can work on different results at once.
+TEST(StreamManipulatorManagerTest, PipelinedStagesTest) {
+  Camera3CaptureDescriptor returned_result;
+  base::WaitableEvent capture_result_returned;
+  camera3_notify_msg_t returned_msg;
+  base::WaitableEvent notify_returned;
+
+  std::vector<std::unique_ptr<StreamManipulator>> stream_manipulators;
+  stream_manipulators.emplace_back(
+      std::make_unique<FakeStreamManipulator>(/*use_thread=*/false));
+  stream_manipulators.emplace_back(
+      std::make_unique<FakeStreamManipulator>(/*use_thread=*/false));
+  auto stream_manipulator_1 =
+      static_cast<FakeStreamManipulator*>(stream_manipulators[0].get());
+  auto stream_manipulator_2 =
+      static_cast<FakeStreamManipulator*>(stream_manipulators[1].get());
+  StreamManipulatorManager manager(std::move(stream_manipulators));
+
+  android::CameraMetadata metadata;
+  manager.Initialize(metadata.getAndLock(),
+                     CreateCallbacks(&returned_result, &capture_result_returned,
+                                     &returned_msg, &notify_returned));
+
+  manager.ProcessCaptureResult(CreateFakeCaptureResult(/*frame_number=*/1));
+  ASSERT_TRUE(capture_result_returned.TimedWait(
+      base::Milliseconds(kCaptureRequestTimeoutMs)));
+  EXPECT_EQ(returned_result.frame_number(), 1);
+  EXPECT_NE(stream_manipulator_1->process_capture_result_thread_id(),
+            base::kInvalidThreadId);
+  EXPECT_NE(stream_manipulator_1->process_capture_result_thread_id(),
+            stream_manipulator_2->process_capture_result_thread_id());
+}
+
 }  // namespace tests
 
 }  // namespace cros
@@ -570,6 +570,13 @@ bool AutoFramingStreamManipulator::OnConfiguredStreamsOnThread(
           .max_num_buffers =
               base::strict_cast<size_t>(full_frame_stream_.max_buffers) + 1,
       });
+  // The full frame buffers are used by every capture.  Allocate them before
+  // the first capture results arrive so that they don't stall on allocation.
+  gpu_resources_->PostGpuTask(
+      FROM_HERE,
+      base::BindOnce(
+          &AutoFramingStreamManipulator::PreallocateFullFrameBuffersOnThread,
+          base::Unretained(this)));
 
   if (blob_stream_) {
     cropped_still_yuv_buffer_pool_ =
@@ -1202,6 +1209,17 @@ void AutoFramingStreamManipulator::ResetOnThread() {
   metrics_ = Metrics{};
 }
 
+void AutoFramingStreamManipulator::PreallocateFullFrameBuffersOnThread() {
+  DCHECK(gpu_resources_->gpu_task_runner()->BelongsToCurrentThread());
+  TRACE_AUTO_FRAMING();
+
+  if (full_frame_buffer_pool_ &&
+      !full_frame_buffer_pool_->Preallocate(
+          base::strict_cast<size_t>(full_frame_stream_.max_buffers))) {
+    LOGF(WARNING) << "Failed to preallocate full frame buffers";
+  }
+}
+
 void AutoFramingStreamManipulator::UploadMetricsOnThread() {
   DCHECK(gpu_resources_->gpu_task_runner()->BelongsToCurrentThread());
 
@@ -1265,6 +1283,13 @@ void AutoFramingStreamManipulator::UploadMetricsOnThread() {
   if (!has_error) {
     camera_metrics_->SendAutoFramingError(AutoFramingError::kNoError);
   }
+
+  if (full_frame_buffer_pool_ && full_frame_stream_.max_buffers > 0) {
+    camera_metrics_->SendAutoFramingFullFrameBufferPoolUsage(
+        base::checked_cast<int>(
+            full_frame_buffer_pool_->max_num_buffers_in_use() * 100 /
+            (base::strict_cast<size_t>(full_frame_stream_.max_buffers) + 1)));
+  }
 }
 
 void AutoFramingStreamManipulator::UpdateOptionsOnThread(
@@ -1413,14 +1438,16 @@ std::optional<base::ScopedFD> AutoFramingStreamManipulator::CropBufferOnThread(
   DCHECK(gpu_resources_->gpu_task_runner()->BelongsToCurrentThread());
   TRACE_AUTO_FRAMING();
 
-  if (input_release_fence.is_valid() &&
-      sync_wait(input_release_fence.get(), kSyncWaitTimeoutMs) != 0) {
-    LOGF(ERROR) << "sync_wait() timed out on input buffer";
+  // The buffers are only accessed by the GPU, which can wait for them without
+  // blocking the GPU thread shared with the other processing blocks.
+  if (!EglFence::WaitOnGpu(std::move(input_release_fence),
+                           kSyncWaitTimeoutMs)) {
+    LOGF(ERROR) << "Failed to wait on input buffer";
     return std::nullopt;
   }
-  if (output_acquire_fence.is_valid() &&
-      sync_wait(output_acquire_fence.get(), kSyncWaitTimeoutMs) != 0) {
-    LOGF(ERROR) << "sync_wait() timed out on output buffer";
+  if (!EglFence::WaitOnGpu(std::move(output_acquire_fence),
+                           kSyncWaitTimeoutMs)) {
+    LOGF(ERROR) << "Failed to wait on output buffer";
     return std::nullopt;
   }
 
@@ -118,6 +118,7 @@ class AutoFramingStreamManipulator : public StreamManipulator {
                           StreamManipulator::Callbacks callbacks);
   bool ConfigureStreamsOnThread(Camera3StreamConfiguration* stream_config);
   bool OnConfiguredStreamsOnThread(Camera3StreamConfiguration* stream_config);
+  void PreallocateFullFrameBuffersOnThread();
   bool ProcessCaptureRequestOnThread(Camera3CaptureDescriptor* request);
   bool ProcessCaptureResultOnThread(Camera3CaptureDescriptor* result);
 
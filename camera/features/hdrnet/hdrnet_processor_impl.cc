@@ -139,10 +139,15 @@ base::ScopedFD HdrNetProcessorImpl::Run(
     output_images.emplace_back(std::move(output_nv12));
   }
 
-  if (input_release_fence.is_valid()) {
-    if (sync_wait(input_release_fence.get(), 300)) {
+  // The input buffer is only accessed by the GPU unless it's dumped, and the
+  // GPU can wait for it without blocking the thread.
+  if (options.dump_buffer) {
+    if (input_release_fence.is_valid() &&
+        sync_wait(input_release_fence.get(), 300)) {
       ++hdrnet_metrics->errors[HdrnetError::kSyncWaitError];
     }
+  } else if (!EglFence::WaitOnGpu(std::move(input_release_fence), 300)) {
+    ++hdrnet_metrics->errors[HdrnetError::kSyncWaitError];
   }
 
   if (!options.hdrnet_enable) {
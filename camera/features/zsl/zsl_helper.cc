@@ -10,6 +10,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <functional>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -17,6 +18,7 @@
 #include <base/check_op.h>
 #include <base/functional/bind.h>
 #include <base/numerics/safe_conversions.h>
+#include <base/system/sys_info.h>
 #include <camera/camera_metadata.h>
 #include <sync/sync.h>
 #include <system/camera_metadata.h>
@@ -33,6 +35,17 @@ namespace {
 
 static constexpr int64_t kOverrideCurrentTimestampNotSet = -1;
 
+// The buffers of the lookback window may take up to 1/64 of the physical
+// memory, e.g. 64MB on a 4GB board.
+constexpr int64_t kZslMemoryBudgetDivisor = 64;
+
+// Upper bound of the bytes per pixel of the private ZSL buffers, which are RAW
+// or YUV depending on the HAL.
+constexpr int64_t kZslMaxBytesPerPixel = 2;
+
+// Number of frames kept to look back at, whatever the memory budget.
+constexpr size_t kZslMinLookbackFrames = 2;
+
 bool IsInputStream(camera3_stream_t* stream) {
   return stream->stream_type == CAMERA3_STREAM_INPUT ||
          stream->stream_type == CAMERA3_STREAM_BIDIRECTIONAL;
@@ -91,11 +104,17 @@ bool CanEnableZsl(const camera_metadata_t* metadata) {
 }  // namespace
 
 ZslBuffer::ZslBuffer()
-    : metadata_ready(false), buffer_ready(false), selected(false) {}
+    : metadata_ready(false),
+      timestamp(-1),
+      is_3a_converged(false),
+      buffer_ready(false),
+      selected(false) {}
 ZslBuffer::ZslBuffer(uint32_t frame_number, camera3_stream_buffer_t buffer)
     : frame_number(frame_number),
       buffer(std::move(buffer)),
       metadata_ready(false),
+      timestamp(-1),
+      is_3a_converged(false),
       buffer_ready(false),
       selected(false) {}
 
@@ -200,7 +219,9 @@ void ZslBufferManager::SetCameraBufferManagerForTesting(
 }
 
 ZslHelper::ZslHelper(const camera_metadata_t* static_info)
-    : zsl_buffer_manager_(new ZslBufferManager),
+    : memory_budget_bytes_(base::saturated_cast<int64_t>(
+          base::SysInfo::AmountOfPhysicalMemory() / kZslMemoryBudgetDivisor)),
+      zsl_buffer_manager_(new ZslBufferManager),
       fence_sync_thread_("FenceSyncThread"),
       override_current_timestamp_for_testing_(kOverrideCurrentTimestampNotSet) {
   if (!IsCapabilitySupported(
@@ -259,10 +280,13 @@ ZslHelper::ZslHelper(const camera_metadata_t* static_info)
       cros::CameraConfig::Create(cros::constants::kCrosCameraConfigPathString);
   // We're casting an int to int64_t here. Make sure the configured time doesn't
   // overflow (roughly 2.1s).
-  zsl_lookback_ns_ = base::strict_cast<int64_t>(camera_config->GetInteger(
-      cros::constants::kCrosZslLookback,
-      base::checked_cast<int>(kZslDefaultLookbackNs)));
-  LOGF(INFO) << "Configured ZSL lookback time = " << zsl_lookback_ns_;
+  configured_zsl_lookback_ns_ =
+      base::strict_cast<int64_t>(camera_config->GetInteger(
+          cros::constants::kCrosZslLookback,
+          base::checked_cast<int>(kZslDefaultLookbackNs)));
+  zsl_lookback_ns_ = configured_zsl_lookback_ns_;
+  LOGF(INFO) << "Configured ZSL lookback time = "
+             << configured_zsl_lookback_ns_;
 }
 
 ZslHelper::~ZslHelper() {
@@ -340,13 +364,30 @@ bool ZslHelper::Initialize(Camera3StreamConfiguration* stream_config) {
   VLOGF(1) << "Max buffers for still capture streams = " << still_max_buffers;
 
   // We look back at most
-  // ceil(|zsl_lookback_ns_| / |bi_stream_min_frame_duration_| frames, and there
-  // will be at most |bi_stream_max_buffers_| being processed. We also need to
-  // have |still_max_buffers| additional buffers in the buffer pool.
+  // ceil(|zsl_lookback_ns_| / |bi_stream_min_frame_duration_| frames at the
+  // maximum frame rate of the sensor. On low-RAM devices the lookback time is
+  // shortened so that these frames fit in the memory budget.
+  size_t lookback_frames = static_cast<size_t>(
+      std::ceil(static_cast<double>(configured_zsl_lookback_ns_) /
+                bi_stream_min_frame_duration_));
+  const int64_t buffer_size = int64_t{bi_stream_->width} *
+                              bi_stream_->height * kZslMaxBytesPerPixel;
+  const size_t max_lookback_frames = std::max(
+      kZslMinLookbackFrames,
+      base::saturated_cast<size_t>(memory_budget_bytes_ / buffer_size));
+  zsl_lookback_ns_ = configured_zsl_lookback_ns_;
+  if (lookback_frames > max_lookback_frames) {
+    lookback_frames = max_lookback_frames;
+    zsl_lookback_ns_ = lookback_frames * bi_stream_min_frame_duration_;
+    LOGF(INFO) << "Shortened ZSL lookback time to " << zsl_lookback_ns_
+               << " to fit in the memory budget of " << memory_budget_bytes_
+               << " bytes";
+  }
+
+  // There will be at most |bi_stream_max_buffers_| being processed. We also
+  // need to have |still_max_buffers| additional buffers in the buffer pool.
   if (!zsl_buffer_manager_->Initialize(
-          static_cast<size_t>(std::ceil(static_cast<double>(zsl_lookback_ns_) /
-                                        bi_stream_min_frame_duration_)) +
-              bi_stream_max_buffers_ + still_max_buffers,
+          lookback_frames + bi_stream_max_buffers_ + still_max_buffers,
           bi_stream_.get())) {
     LOGF(ERROR) << "Failed to initialize ZSL buffer manager";
     return false;
@@ -425,9 +466,8 @@ void ZslHelper::TryReleaseBuffer() {
   if (!oldest_buffer.metadata_ready) {
     return;
   }
-  auto timestamp = GetTimestamp(oldest_buffer.metadata);
-  DCHECK_NE(timestamp, -1);
-  if (GetCurrentTimestamp() - timestamp <= zsl_lookback_ns_) {
+  DCHECK_NE(oldest_buffer.timestamp, -1);
+  if (GetCurrentTimestamp() - oldest_buffer.timestamp <= zsl_lookback_ns_) {
     // Buffer is too new that we should keep it. This will happen for the
     // initial buffers.
     return;
@@ -551,10 +591,7 @@ void ZslHelper::ProcessZslCaptureResult(Camera3CaptureDescriptor* result,
   }
 
   base::AutoLock ring_buffer_lock(ring_buffer_lock_);
-  auto it = std::find_if(ring_buffer_.begin(), ring_buffer_.end(),
-                         [&](const ZslBuffer& buffer) {
-                           return buffer.frame_number == result->frame_number();
-                         });
+  auto it = FindZslBuffer(result->frame_number());
   if (it == ring_buffer_.end()) {
     return;
   }
@@ -569,7 +606,7 @@ void ZslHelper::ProcessZslCaptureResult(Camera3CaptureDescriptor* result,
     }
     result->Unlock();
     if (result->partial_result() == partial_result_count_) {
-      it->metadata_ready = true;
+      SetMetadataReady(&*it);
     }
   }
 }
@@ -596,10 +633,7 @@ void ZslHelper::WaitAttachedFrameOnFenceSyncThread(
     LOGF(WARNING) << "Failed to wait for release fence on attached ZSL buffer";
   } else {
     base::AutoLock ring_buffer_lock(ring_buffer_lock_);
-    auto it = std::find_if(ring_buffer_.begin(), ring_buffer_.end(),
-                           [&](const ZslBuffer& buffer) {
-                             return buffer.frame_number == frame_number;
-                           });
+    auto it = FindZslBuffer(frame_number);
     if (it != ring_buffer_.end()) {
       it->buffer_ready = true;
     }
@@ -729,37 +763,34 @@ ZslHelper::ZslBufferIterator ZslHelper::SelectZslBuffer(
     return ring_buffer_.end();
   }
 
-  // For CLOSEST or CLOSEST_3A strategies.
+  // For CLOSEST or CLOSEST_3A strategies. The closest buffer is the oldest one
+  // not older than what is displayed, so walk the ring from its oldest end and
+  // stop at the first buffer that fits, which is usually one of the first few.
   int64_t cur_timestamp = GetCurrentTimestamp();
   LOGF(INFO) << "Current timestamp = " << cur_timestamp;
   ZslBufferIterator selected_buffer_it = ring_buffer_.end();
-  int64_t min_diff = zsl_lookback_ns_;
   int64_t ideal_timestamp = cur_timestamp - zsl_lookback_ns_;
-  for (auto it = ring_buffer_.begin(); it != ring_buffer_.end(); it++) {
+  for (auto it = ring_buffer_.rbegin(); it != ring_buffer_.rend(); it++) {
     if (!it->metadata_ready || !it->buffer_ready || it->selected) {
       continue;
     }
-    int64_t timestamp = GetTimestamp(it->metadata);
-    bool satisfy_3a = strategy == CLOSEST ||
-                      (strategy == CLOSEST_3A && Is3AConverged(it->metadata));
-    int64_t diff = timestamp - ideal_timestamp;
-    VLOGF(1) << "Candidate timestamp = " << timestamp
+    bool satisfy_3a =
+        strategy == CLOSEST || (strategy == CLOSEST_3A && it->is_3a_converged);
+    int64_t diff = it->timestamp - ideal_timestamp;
+    VLOGF(1) << "Candidate timestamp = " << it->timestamp
              << " (Satisfy 3A = " << satisfy_3a << ", "
              << "Difference from desired timestamp = " << diff << ")";
-    if (diff > kZslLookbackLengthNs) {
-      continue;
-    } else if (diff < 0) {
+    if (diff < 0) {
       // We don't select buffers that are older than what is displayed.
+      continue;
+    } else if (diff > kZslLookbackLengthNs) {
+      // The newer buffers are even further from the desired timestamp.
       break;
     }
     if (satisfy_3a) {
-      if (diff < min_diff) {
-        min_diff = diff;
-        selected_buffer_it = it;
-      } else {
-        // Not possible to find a better buffer
-        break;
-      }
+      // |it| is a reverse iterator, whose base() points to the next element.
+      selected_buffer_it = std::prev(it.base());
+      break;
     }
   }
   if (selected_buffer_it == ring_buffer_.end()) {
@@ -768,7 +799,7 @@ ZslHelper::ZslBufferIterator ZslHelper::SelectZslBuffer(
     return selected_buffer_it;
   }
   LOGF(INFO) << "Timestamp of the selected buffer = "
-             << GetTimestamp(selected_buffer_it->metadata);
+             << selected_buffer_it->timestamp;
   selected_buffer_it->selected = true;
   return selected_buffer_it;
 }
@@ -842,6 +873,25 @@ bool ZslHelper::Is3AConverged(const android::CameraMetadata& android_metadata) {
   return awb_converged;
 }
 
+void ZslHelper::SetMetadataReady(ZslBuffer* buffer) {
+  buffer->timestamp = GetTimestamp(buffer->metadata);
+  buffer->is_3a_converged = Is3AConverged(buffer->metadata);
+  buffer->metadata_ready = true;
+}
+
+ZslHelper::ZslBufferIterator ZslHelper::FindZslBuffer(uint32_t frame_number) {
+  ring_buffer_lock_.AssertAcquired();
+  auto it = std::lower_bound(ring_buffer_.begin(), ring_buffer_.end(),
+                             frame_number,
+                             [](const ZslBuffer& buffer, uint32_t number) {
+                               return buffer.frame_number > number;
+                             });
+  if (it == ring_buffer_.end() || it->frame_number != frame_number) {
+    return ring_buffer_.end();
+  }
+  return it;
+}
+
 void ZslHelper::SetZslBufferManagerForTesting(
     std::unique_ptr<ZslBufferManager> zsl_buffer_manager) {
   zsl_buffer_manager_ = std::move(zsl_buffer_manager);
@@ -851,6 +901,10 @@ void ZslHelper::OverrideCurrentTimestampForTesting(int64_t timestamp) {
   override_current_timestamp_for_testing_ = timestamp;
 }
 
+void ZslHelper::SetMemoryBudgetForTesting(int64_t memory_budget_bytes) {
+  memory_budget_bytes_ = memory_budget_bytes;
+}
+
 bool AddVendorTags(VendorTagManager& vendor_tag_manager) {
   if (!vendor_tag_manager.Add(kCrosZslVendorTagCanAttempt,
                               kCrosZslVendorTagSectionName,
@@ -66,6 +66,12 @@ struct ZslBuffer {
   // Whether all metadata have been returned.
   bool metadata_ready;
 
+  // ANDROID_SENSOR_TIMESTAMP and the 3A convergence of |metadata|, cached once
+  // |metadata_ready| so that selecting a buffer doesn't look up the metadata
+  // of every buffer in the ring.
+  int64_t timestamp;
+  bool is_3a_converged;
+
   // Whether the buffer has been returned.
   bool buffer_ready;
 
@@ -229,6 +235,14 @@ class ZslHelper {
   // Whether this buffer is 3A-converged (AE, AF, AWB).
   bool Is3AConverged(const android::CameraMetadata& android_metadata);
 
+  // Marks all the metadata of |buffer| returned, and caches the states
+  // selection depends on.
+  void SetMetadataReady(ZslBuffer* buffer);
+
+  // Finds the buffer of |frame_number| in |ring_buffer_|, which is sorted by
+  // decreasing frame numbers. Returns the end iterator if there is none.
+  ZslBufferIterator FindZslBuffer(uint32_t frame_number);
+
   // Sets the ZslBufferManager used for testing. Should be called before
   // ZslHelper::Initialize().
   void SetZslBufferManagerForTesting(
@@ -237,6 +251,9 @@ class ZslHelper {
   // Overrides the current timestamp for testing.
   void OverrideCurrentTimestampForTesting(int64_t timestamp);
 
+  // Overrides the memory budget of the ZSL buffers for testing.
+  void SetMemoryBudgetForTesting(int64_t memory_budget_bytes);
+
   // The actual ZSL stream.
   std::unique_ptr<camera3_stream_t> bi_stream_;
   int64_t bi_stream_min_frame_duration_;
@@ -245,8 +262,16 @@ class ZslHelper {
   // The duration of time ZSL should go back to find a raw buffer to be sent for
   // private reprocessing. It's currently configured in chromeos-config but
   // might be moved to CameraConfig in the future.
+  int64_t configured_zsl_lookback_ns_;
+
+  // The lookback duration in use, which is |configured_zsl_lookback_ns_|
+  // shortened if the buffers it needs don't fit in |memory_budget_bytes_|.
   int64_t zsl_lookback_ns_;
 
+  // The memory the buffers of the lookback window may take, which scales with
+  // the physical memory of the device.
+  int64_t memory_budget_bytes_;
+
   // Manages the buffer used for ZSL, essentially a buffer pool.
   std::unique_ptr<ZslBufferManager> zsl_buffer_manager_;
 
@@ -7,6 +7,7 @@
 #include "features/zsl/zsl_helper.h"
 
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -44,6 +45,8 @@ constexpr int32_t kMaxNumInputStreams = 1;
 
 constexpr int64_t kMockCurrentTimestamp = 1'000'000'000LL;
 
+constexpr int64_t kUnlimitedMemoryBudget = std::numeric_limits<int64_t>::max();
+
 class MockCameraBufferManager : public cros::CameraBufferManager {
  public:
   MOCK_METHOD(int,
@@ -268,6 +271,9 @@ class ZslHelperTest : public ::testing::Test {
 
     cbm_ = std::make_unique<MockCameraBufferManager>();
     zsl_helper_ = std::make_unique<ZslHelper>(static_metadata.getAndLock());
+    // Make sure the whole lookback window fits, whatever the memory of the
+    // machine running the tests.
+    DoSetMemoryBudgetForTesting(kUnlimitedMemoryBudget);
   }
 
   void TearDown() override {
@@ -377,7 +383,7 @@ class ZslHelperTest : public ::testing::Test {
                 0);
       // |buffer| is not selected by default, so these buffers can all be
       // selected for private reprocessing.
-      buffer.metadata_ready = true;
+      zsl_helper_->SetMetadataReady(&buffer);
       buffer.buffer_ready = true;
       zsl_helper_->ring_buffer_.push_front(std::move(buffer));
     }
@@ -404,6 +410,10 @@ class ZslHelperTest : public ::testing::Test {
     zsl_helper_->OverrideCurrentTimestampForTesting(timestamp);
   }
 
+  void DoSetMemoryBudgetForTesting(int64_t memory_budget_bytes) {
+    zsl_helper_->SetMemoryBudgetForTesting(memory_budget_bytes);
+  }
+
   std::unique_ptr<ZslHelper> zsl_helper_;
   MockZslBufferManager* zsl_buffer_manager_;
   std::unique_ptr<MockCameraBufferManager> cbm_;
@@ -483,6 +493,47 @@ TEST_F(ZslHelperTest, InitializeTest) {
   EXPECT_TRUE(zsl_helper_->Initialize(&stream_config));
 }
 
+// Test that ZSL keeps fewer buffers to look back at when they don't fit in the
+// memory budget.
+TEST_F(ZslHelperTest, InitializeWithMemoryBudgetTest) {
+  constexpr size_t kBudgetLookbackFrames = 5;
+  // The budget assumes up to 2 bytes per pixel.
+  DoSetMemoryBudgetForTesting(kBudgetLookbackFrames * kZslBiStreamWidth *
+                              kZslBiStreamHeight * 2);
+  camera3_stream_t* bi_stream = GetZslBiStream();
+  bi_stream->max_buffers = kZslBiStreamMaxBuffers;
+
+  MockZslBufferManager* zsl_buffer_manager = new MockZslBufferManager();
+  EXPECT_CALL(*zsl_buffer_manager,
+              Initialize(kBudgetLookbackFrames + kZslBiStreamMaxBuffers +
+                             kStillCaptureStreamMaxBuffers,
+                         bi_stream))
+      .WillOnce(Return(true));
+  DoSetZslBufferManagerForTesting(
+      std::unique_ptr<MockZslBufferManager>(zsl_buffer_manager));
+
+  std::vector<camera3_stream_t*> streams = {GetZslBiStream(),
+                                            &still_capture_stream_};
+  Camera3StreamConfiguration stream_config(camera3_stream_configuration_t{
+      .num_streams = static_cast<uint32_t>(streams.size()),
+      .streams = streams.data()});
+  EXPECT_TRUE(zsl_helper_->Initialize(&stream_config));
+
+  // The selected buffer is the one the shortened lookback time goes back to.
+  InitializeZslHelper();
+  DoOverrideCurrentTimestampForTesting(kMockCurrentTimestamp);
+  FillZslRingBuffer(/*ring_buffer_3a_converged=*/true);
+  Camera3CaptureDescriptor mock_request =
+      GetMockCaptureRequest(ANDROID_CONTROL_CAPTURE_INTENT_STILL_CAPTURE);
+  ASSERT_TRUE(zsl_helper_->ProcessZslCaptureRequest(&mock_request));
+  base::span<const int64_t> timestamp =
+      mock_request.GetMetadata<int64_t>(ANDROID_SENSOR_TIMESTAMP);
+  ASSERT_EQ(timestamp.size(), 1u);
+  EXPECT_EQ(timestamp[0],
+            kMockCurrentTimestamp -
+                kBudgetLookbackFrames * kZslBiStreamMinFrameDuration);
+}
+
 // Test that |ZslHelper| correctly attaches a private buffer to a preview
 // request rather than transforming it.
 TEST_F(ZslHelperTest, ProcessZslCaptureRequestPreview) {
@@ -6,6 +6,9 @@
 
 #include "gpu/egl/egl_fence.h"
 
+#include <sync/sync.h>
+
+#include <tuple>
 #include <utility>
 
 #include <GLES3/gl3.h>
@@ -18,6 +21,7 @@ namespace {
 PFNEGLCREATESYNCKHRPROC g_eglCreateSyncKHR = nullptr;
 PFNEGLDESTROYSYNCKHRPROC g_eglDestroySyncKHR = nullptr;
 PFNEGLDUPNATIVEFENCEFDANDROIDPROC g_eglDupNativeFenceFDANDROID = nullptr;
+PFNEGLWAITSYNCKHRPROC g_eglWaitSyncKHR = nullptr;
 
 }  // namespace
 
@@ -40,6 +44,33 @@ bool EglFence::IsSupported() {
   return supported;
 }
 
+// static
+bool EglFence::IsServerWaitSupported() {
+  static bool supported = []() -> bool {
+    g_eglWaitSyncKHR = reinterpret_cast<PFNEGLWAITSYNCKHRPROC>(
+        eglGetProcAddress("eglWaitSyncKHR"));
+    return IsSupported() && (g_eglWaitSyncKHR != nullptr);
+  }();
+  return supported;
+}
+
+// static
+bool EglFence::WaitOnGpu(base::ScopedFD fence_fd, int timeout_ms) {
+  TRACE_GPU_DEBUG();
+
+  if (!fence_fd.is_valid()) {
+    return true;
+  }
+  if (IsServerWaitSupported()) {
+    return EglFence(std::move(fence_fd)).ServerWait();
+  }
+  if (sync_wait(fence_fd.get(), timeout_ms) != 0) {
+    LOGF(ERROR) << "sync_wait() timed out";
+    return false;
+  }
+  return true;
+}
+
 EglFence::EglFence() {
   TRACE_GPU_DEBUG();
 
@@ -59,6 +90,29 @@ EglFence::EglFence() {
   }
 }
 
+EglFence::EglFence(base::ScopedFD native_fd) {
+  TRACE_GPU_DEBUG();
+
+  if (!IsSupported()) {
+    LOGF(ERROR) << "Creating EGLSyncKHR isn't supported";
+    return;
+  }
+
+  display_ = eglGetCurrentDisplay();
+  if (display_ != EGL_NO_DISPLAY) {
+    const EGLint attribs[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID,
+                              native_fd.get(), EGL_NONE};
+    sync_ =
+        g_eglCreateSyncKHR(display_, EGL_SYNC_NATIVE_FENCE_ANDROID, attribs);
+  }
+  if (sync_ == EGL_NO_SYNC_KHR) {
+    LOGF(ERROR) << "Failed to import native sync FD";
+    return;
+  }
+  // The EGLSyncKHR owns the FD now.
+  std::ignore = native_fd.release();
+}
+
 EglFence::EglFence(EglFence&& other) {
   *this = std::move(other);
 }
@@ -91,6 +145,19 @@ base::ScopedFD EglFence::GetNativeFd() {
   return base::ScopedFD(sync_fd);
 }
 
+bool EglFence::ServerWait() {
+  TRACE_GPU_DEBUG();
+
+  if (!IsValid() || !IsServerWaitSupported()) {
+    return false;
+  }
+  if (g_eglWaitSyncKHR(display_, sync_, 0) != EGL_TRUE) {
+    LOGF(ERROR) << "Failed to wait on EGL sync";
+    return false;
+  }
+  return true;
+}
+
 void EglFence::Invalidate() {
   TRACE_GPU_DEBUG();
 
@@ -19,9 +19,25 @@ class EglFence {
  public:
   static bool IsSupported();
 
+  // Whether ServerWait() is supported, in addition to IsSupported().
+  static bool IsServerWaitSupported();
+
+  // Makes the GPU commands submitted afterwards on the current context wait
+  // for the native sync FD |fence_fd|, without blocking the calling thread.
+  // Falls back to waiting on the CPU for at most |timeout_ms| if server waits
+  // aren't supported. Returns false if the wait failed or timed out.
+  //
+  // Processing blocks sharing the GPU context can chain their work this way
+  // without a CPU round-trip between each of them.
+  [[nodiscard]] static bool WaitOnGpu(base::ScopedFD fence_fd, int timeout_ms);
+
   // Creates a EGLSyncKHR and insert the fence into the command queue.
   EglFence();
 
+  // Creates a EGLSyncKHR from the native sync FD |native_fd|, which the
+  // EGLSyncKHR takes the ownership of.
+  explicit EglFence(base::ScopedFD native_fd);
+
   EglFence(const EglFence& other) = delete;
   EglFence(EglFence&& other);
   EglFence& operator=(const EglFence& other) = delete;
@@ -35,6 +51,10 @@ class EglFence {
   // object.
   base::ScopedFD GetNativeFd();
 
+  // Makes the GPU wait for the fence to signal before executing the commands
+  // submitted afterwards on the current context. Returns immediately.
+  bool ServerWait();
+
  private:
   void Invalidate();
 
@@ -247,6 +247,10 @@ class CROS_CAMERA_EXPORT CameraMetrics {
   // Records auto-framing average zoom ratio per session.
   virtual void SendAutoFramingError(AutoFramingError error) = 0;
 
+  // Records the largest number of full frame buffers in use at the same time in
+  // a session, in percentage of the size of the buffer pool.
+  virtual void SendAutoFramingFullFrameBufferPoolUsage(int percentage) = 0;
+
   // *** Effects metrics ***
 
   // Records the user selecting an effect during the session.
@@ -4,10 +4,15 @@
 
 #include "chaps/chaps_adaptor.h"
 
+#include <limits>
+#include <tuple>
 #include <utility>
 
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
+#include <base/functional/bind.h>
+#include <base/functional/callback.h>
+#include <base/location.h>
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
 #include <dbus/object_path.h>
@@ -16,10 +21,12 @@
 #include "chaps/chaps_interface.h"
 #include "chaps/chaps_utility.h"
 #include "chaps/dbus_bindings/constants.h"
+#include "chaps/slot_manager.h"
 #include "chaps/token_manager_interface.h"
 
 using base::FilePath;
 using brillo::SecureBlob;
+using brillo::dbus_utils::DBusMethodResponse;
 using std::string;
 using std::vector;
 
@@ -27,15 +34,23 @@ namespace chaps {
 
 ChapsAdaptor::ChapsAdaptor(scoped_refptr<dbus::Bus> bus,
                            ChapsInterface* service,
-                           TokenManagerInterface* token_manager)
+                           TokenManagerInterface* token_manager,
+                           SlotManager* slot_manager)
     : dbus_object_(nullptr, bus, dbus::ObjectPath(kChapsServicePath)),
       service_(service),
-      token_manager_(token_manager) {
+      token_manager_(token_manager),
+      slot_manager_(slot_manager) {
   CHECK(service_);
   CHECK(token_manager_);
+  CHECK(slot_manager_);
 }
 
-ChapsAdaptor::~ChapsAdaptor() {}
+ChapsAdaptor::~ChapsAdaptor() {
+  // Let the calls running on the worker threads finish while the service and
+  // the slot manager they use still exist.
+  for (auto& slot_worker_thread : slot_worker_threads_)
+    slot_worker_thread.second->Stop();
+}
 
 void ChapsAdaptor::RegisterAsync(
     brillo::dbus_utils::AsyncEventSequencer::CompletionAction cb) {
@@ -55,158 +70,137 @@ void ChapsAdaptor::RegisterAsync(
                                     &ChapsAdaptor::SetLogLevel);
   interface->AddSimpleMethodHandler(kGetSlotListMethod, base::Unretained(this),
                                     &ChapsAdaptor::GetSlotList);
-  interface->AddSimpleMethodHandler(kGetSlotInfoMethod, base::Unretained(this),
-                                    &ChapsAdaptor::GetSlotInfo);
-  interface->AddSimpleMethodHandler(kGetTokenInfoMethod, base::Unretained(this),
-                                    &ChapsAdaptor::GetTokenInfo);
-  interface->AddSimpleMethodHandler(kGetMechanismListMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GetMechanismList);
-  interface->AddSimpleMethodHandler(kGetMechanismInfoMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GetMechanismInfo);
-  interface->AddSimpleMethodHandler(kInitTokenMethod, base::Unretained(this),
-                                    &ChapsAdaptor::InitToken);
-  interface->AddSimpleMethodHandler(kInitPINMethod, base::Unretained(this),
-                                    &ChapsAdaptor::InitPIN);
-  interface->AddSimpleMethodHandler(kSetPINMethod, base::Unretained(this),
-                                    &ChapsAdaptor::SetPIN);
-  interface->AddSimpleMethodHandler(kOpenSessionMethod, base::Unretained(this),
-                                    &ChapsAdaptor::OpenSession);
-  interface->AddSimpleMethodHandler(kCloseSessionMethod, base::Unretained(this),
-                                    &ChapsAdaptor::CloseSession);
-  interface->AddSimpleMethodHandler(kGetSessionInfoMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GetSessionInfo);
-  interface->AddSimpleMethodHandler(kGetOperationStateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GetOperationState);
-  interface->AddSimpleMethodHandler(kSetOperationStateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::SetOperationState);
-  interface->AddSimpleMethodHandler(kLoginMethod, base::Unretained(this),
-                                    &ChapsAdaptor::Login);
-  interface->AddSimpleMethodHandler(kLogoutMethod, base::Unretained(this),
-                                    &ChapsAdaptor::Logout);
-  interface->AddSimpleMethodHandler(kCreateObjectMethod, base::Unretained(this),
-                                    &ChapsAdaptor::CreateObject);
-  interface->AddSimpleMethodHandler(kCopyObjectMethod, base::Unretained(this),
-                                    &ChapsAdaptor::CopyObject);
-  interface->AddSimpleMethodHandler(kDestroyObjectMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::DestroyObject);
-  interface->AddSimpleMethodHandler(kGetObjectSizeMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GetObjectSize);
-  interface->AddSimpleMethodHandler(kGetAttributeValueMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GetAttributeValue);
-  interface->AddSimpleMethodHandler(kSetAttributeValueMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::SetAttributeValue);
-  interface->AddSimpleMethodHandler(kFindObjectsInitMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::FindObjectsInit);
-  interface->AddSimpleMethodHandler(kFindObjectsMethod, base::Unretained(this),
-                                    &ChapsAdaptor::FindObjects);
-  interface->AddSimpleMethodHandler(kFindObjectsFinalMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::FindObjectsFinal);
-  interface->AddSimpleMethodHandler(kEncryptInitMethod, base::Unretained(this),
-                                    &ChapsAdaptor::EncryptInit);
-  interface->AddSimpleMethodHandler(kEncryptMethod, base::Unretained(this),
-                                    &ChapsAdaptor::Encrypt);
-  interface->AddSimpleMethodHandler(kEncryptUpdateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::EncryptUpdate);
-  interface->AddSimpleMethodHandler(kEncryptFinalMethod, base::Unretained(this),
-                                    &ChapsAdaptor::EncryptFinal);
-  interface->AddSimpleMethodHandler(kEncryptCancelMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::EncryptCancel);
-  interface->AddSimpleMethodHandler(kDecryptInitMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DecryptInit);
-  interface->AddSimpleMethodHandler(kDecryptMethod, base::Unretained(this),
-                                    &ChapsAdaptor::Decrypt);
-  interface->AddSimpleMethodHandler(kDecryptUpdateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::DecryptUpdate);
-  interface->AddSimpleMethodHandler(kDecryptFinalMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DecryptFinal);
-  interface->AddSimpleMethodHandler(kDecryptCancelMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::DecryptCancel);
-  interface->AddSimpleMethodHandler(kDigestInitMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DigestInit);
-  interface->AddSimpleMethodHandler(kDigestMethod, base::Unretained(this),
-                                    &ChapsAdaptor::Digest);
-  interface->AddSimpleMethodHandler(kDigestUpdateMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DigestUpdate);
-  interface->AddSimpleMethodHandler(kDigestKeyMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DigestKey);
-  interface->AddSimpleMethodHandler(kDigestFinalMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DigestFinal);
-  interface->AddSimpleMethodHandler(kDigestCancelMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DigestCancel);
-  interface->AddSimpleMethodHandler(kSignInitMethod, base::Unretained(this),
-                                    &ChapsAdaptor::SignInit);
-  interface->AddSimpleMethodHandler(kSignMethod, base::Unretained(this),
-                                    &ChapsAdaptor::Sign);
-  interface->AddSimpleMethodHandler(kSignUpdateMethod, base::Unretained(this),
-                                    &ChapsAdaptor::SignUpdate);
-  interface->AddSimpleMethodHandler(kSignFinalMethod, base::Unretained(this),
-                                    &ChapsAdaptor::SignFinal);
-  interface->AddSimpleMethodHandler(kSignCancelMethod, base::Unretained(this),
-                                    &ChapsAdaptor::SignCancel);
-  interface->AddSimpleMethodHandler(kSignRecoverInitMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::SignRecoverInit);
-  interface->AddSimpleMethodHandler(kSignRecoverMethod, base::Unretained(this),
-                                    &ChapsAdaptor::SignRecover);
-  interface->AddSimpleMethodHandler(kVerifyInitMethod, base::Unretained(this),
-                                    &ChapsAdaptor::VerifyInit);
-  interface->AddSimpleMethodHandler(kVerifyMethod, base::Unretained(this),
-                                    &ChapsAdaptor::Verify);
-  interface->AddSimpleMethodHandler(kVerifyUpdateMethod, base::Unretained(this),
-                                    &ChapsAdaptor::VerifyUpdate);
-  interface->AddSimpleMethodHandler(kVerifyFinalMethod, base::Unretained(this),
-                                    &ChapsAdaptor::VerifyFinal);
-  interface->AddSimpleMethodHandler(kVerifyCancelMethod, base::Unretained(this),
-                                    &ChapsAdaptor::VerifyCancel);
-  interface->AddSimpleMethodHandler(kVerifyRecoverInitMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::VerifyRecoverInit);
-  interface->AddSimpleMethodHandler(kVerifyRecoverMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::VerifyRecover);
-  interface->AddSimpleMethodHandler(kDigestEncryptUpdateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::DigestEncryptUpdate);
-  interface->AddSimpleMethodHandler(kDecryptDigestUpdateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::DecryptDigestUpdate);
-  interface->AddSimpleMethodHandler(kSignEncryptUpdateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::SignEncryptUpdate);
-  interface->AddSimpleMethodHandler(kDecryptVerifyUpdateMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::DecryptVerifyUpdate);
-  interface->AddSimpleMethodHandler(kGenerateKeyMethod, base::Unretained(this),
-                                    &ChapsAdaptor::GenerateKey);
-  interface->AddSimpleMethodHandler(kGenerateKeyPairMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GenerateKeyPair);
-  interface->AddSimpleMethodHandler(kWrapKeyMethod, base::Unretained(this),
-                                    &ChapsAdaptor::WrapKey);
-  interface->AddSimpleMethodHandler(kUnwrapKeyMethod, base::Unretained(this),
-                                    &ChapsAdaptor::UnwrapKey);
-  interface->AddSimpleMethodHandler(kDeriveKeyMethod, base::Unretained(this),
-                                    &ChapsAdaptor::DeriveKey);
-  interface->AddSimpleMethodHandler(kSeedRandomMethod, base::Unretained(this),
-                                    &ChapsAdaptor::SeedRandom);
-  interface->AddSimpleMethodHandler(kGenerateRandomMethod,
-                                    base::Unretained(this),
-                                    &ChapsAdaptor::GenerateRandom);
+  interface->AddMethodHandler(kGetSlotInfoMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetSlotInfoAsync);
+  interface->AddMethodHandler(kGetTokenInfoMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetTokenInfoAsync);
+  interface->AddMethodHandler(kGetMechanismListMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetMechanismListAsync);
+  interface->AddMethodHandler(kGetMechanismInfoMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetMechanismInfoAsync);
+  interface->AddMethodHandler(kInitTokenMethod, base::Unretained(this),
+                              &ChapsAdaptor::InitTokenAsync);
+  interface->AddMethodHandler(kInitPINMethod, base::Unretained(this),
+                              &ChapsAdaptor::InitPINAsync);
+  interface->AddMethodHandler(kSetPINMethod, base::Unretained(this),
+                              &ChapsAdaptor::SetPINAsync);
+  interface->AddMethodHandler(kOpenSessionMethod, base::Unretained(this),
+                              &ChapsAdaptor::OpenSessionAsync);
+  interface->AddMethodHandler(kCloseSessionMethod, base::Unretained(this),
+                              &ChapsAdaptor::CloseSessionAsync);
+  interface->AddMethodHandler(kGetSessionInfoMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetSessionInfoAsync);
+  interface->AddMethodHandler(kGetOperationStateMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetOperationStateAsync);
+  interface->AddMethodHandler(kSetOperationStateMethod, base::Unretained(this),
+                              &ChapsAdaptor::SetOperationStateAsync);
+  interface->AddMethodHandler(kLoginMethod, base::Unretained(this),
+                              &ChapsAdaptor::LoginAsync);
+  interface->AddMethodHandler(kLogoutMethod, base::Unretained(this),
+                              &ChapsAdaptor::LogoutAsync);
+  interface->AddMethodHandler(kCreateObjectMethod, base::Unretained(this),
+                              &ChapsAdaptor::CreateObjectAsync);
+  interface->AddMethodHandler(kCopyObjectMethod, base::Unretained(this),
+                              &ChapsAdaptor::CopyObjectAsync);
+  interface->AddMethodHandler(kDestroyObjectMethod, base::Unretained(this),
+                              &ChapsAdaptor::DestroyObjectAsync);
+  interface->AddMethodHandler(kGetObjectSizeMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetObjectSizeAsync);
+  interface->AddMethodHandler(kGetAttributeValueMethod, base::Unretained(this),
+                              &ChapsAdaptor::GetAttributeValueAsync);
+  interface->AddMethodHandler(kSetAttributeValueMethod, base::Unretained(this),
+                              &ChapsAdaptor::SetAttributeValueAsync);
+  interface->AddMethodHandler(kFindObjectsInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::FindObjectsInitAsync);
+  interface->AddMethodHandler(kFindObjectsMethod, base::Unretained(this),
+                              &ChapsAdaptor::FindObjectsAsync);
+  interface->AddMethodHandler(kFindObjectsFinalMethod, base::Unretained(this),
+                              &ChapsAdaptor::FindObjectsFinalAsync);
+  interface->AddMethodHandler(kEncryptInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::EncryptInitAsync);
+  interface->AddMethodHandler(kEncryptMethod, base::Unretained(this),
+                              &ChapsAdaptor::EncryptAsync);
+  interface->AddMethodHandler(kEncryptUpdateMethod, base::Unretained(this),
+                              &ChapsAdaptor::EncryptUpdateAsync);
+  interface->AddMethodHandler(kEncryptFinalMethod, base::Unretained(this),
+                              &ChapsAdaptor::EncryptFinalAsync);
+  interface->AddMethodHandler(kEncryptCancelMethod, base::Unretained(this),
+                              &ChapsAdaptor::EncryptCancelAsync);
+  interface->AddMethodHandler(kDecryptInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::DecryptInitAsync);
+  interface->AddMethodHandler(kDecryptMethod, base::Unretained(this),
+                              &ChapsAdaptor::DecryptAsync);
+  interface->AddMethodHandler(kDecryptUpdateMethod, base::Unretained(this),
+                              &ChapsAdaptor::DecryptUpdateAsync);
+  interface->AddMethodHandler(kDecryptFinalMethod, base::Unretained(this),
+                              &ChapsAdaptor::DecryptFinalAsync);
+  interface->AddMethodHandler(kDecryptCancelMethod, base::Unretained(this),
+                              &ChapsAdaptor::DecryptCancelAsync);
+  interface->AddMethodHandler(kDigestInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::DigestInitAsync);
+  interface->AddMethodHandler(kDigestMethod, base::Unretained(this),
+                              &ChapsAdaptor::DigestAsync);
+  interface->AddMethodHandler(kDigestUpdateMethod, base::Unretained(this),
+                              &ChapsAdaptor::DigestUpdateAsync);
+  interface->AddMethodHandler(kDigestKeyMethod, base::Unretained(this),
+                              &ChapsAdaptor::DigestKeyAsync);
+  interface->AddMethodHandler(kDigestFinalMethod, base::Unretained(this),
+                              &ChapsAdaptor::DigestFinalAsync);
+  interface->AddMethodHandler(kDigestCancelMethod, base::Unretained(this),
+                              &ChapsAdaptor::DigestCancelAsync);
+  interface->AddMethodHandler(kSignInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignInitAsync);
+  interface->AddMethodHandler(kSignMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignAsync);
+  interface->AddMethodHandler(kSignUpdateMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignUpdateAsync);
+  interface->AddMethodHandler(kSignFinalMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignFinalAsync);
+  interface->AddMethodHandler(kSignCancelMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignCancelAsync);
+  interface->AddMethodHandler(kSignRecoverInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignRecoverInitAsync);
+  interface->AddMethodHandler(kSignRecoverMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignRecoverAsync);
+  interface->AddMethodHandler(kVerifyInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::VerifyInitAsync);
+  interface->AddMethodHandler(kVerifyMethod, base::Unretained(this),
+                              &ChapsAdaptor::VerifyAsync);
+  interface->AddMethodHandler(kVerifyUpdateMethod, base::Unretained(this),
+                              &ChapsAdaptor::VerifyUpdateAsync);
+  interface->AddMethodHandler(kVerifyFinalMethod, base::Unretained(this),
+                              &ChapsAdaptor::VerifyFinalAsync);
+  interface->AddMethodHandler(kVerifyCancelMethod, base::Unretained(this),
+                              &ChapsAdaptor::VerifyCancelAsync);
+  interface->AddMethodHandler(kVerifyRecoverInitMethod, base::Unretained(this),
+                              &ChapsAdaptor::VerifyRecoverInitAsync);
+  interface->AddMethodHandler(kVerifyRecoverMethod, base::Unretained(this),
+                              &ChapsAdaptor::VerifyRecoverAsync);
+  interface->AddMethodHandler(kDigestEncryptUpdateMethod,
+                              base::Unretained(this),
+                              &ChapsAdaptor::DigestEncryptUpdateAsync);
+  interface->AddMethodHandler(kDecryptDigestUpdateMethod,
+                              base::Unretained(this),
+                              &ChapsAdaptor::DecryptDigestUpdateAsync);
+  interface->AddMethodHandler(kSignEncryptUpdateMethod, base::Unretained(this),
+                              &ChapsAdaptor::SignEncryptUpdateAsync);
+  interface->AddMethodHandler(kDecryptVerifyUpdateMethod,
+                              base::Unretained(this),
+                              &ChapsAdaptor::DecryptVerifyUpdateAsync);
+  interface->AddMethodHandler(kGenerateKeyMethod, base::Unretained(this),
+                              &ChapsAdaptor::GenerateKeyAsync);
+  interface->AddMethodHandler(kGenerateKeyPairMethod, base::Unretained(this),
+                              &ChapsAdaptor::GenerateKeyPairAsync);
+  interface->AddMethodHandler(kWrapKeyMethod, base::Unretained(this),
+                              &ChapsAdaptor::WrapKeyAsync);
+  interface->AddMethodHandler(kUnwrapKeyMethod, base::Unretained(this),
+                              &ChapsAdaptor::UnwrapKeyAsync);
+  interface->AddMethodHandler(kDeriveKeyMethod, base::Unretained(this),
+                              &ChapsAdaptor::DeriveKeyAsync);
+  interface->AddMethodHandler(kSeedRandomMethod, base::Unretained(this),
+                              &ChapsAdaptor::SeedRandomAsync);
+  interface->AddMethodHandler(kGenerateRandomMethod, base::Unretained(this),
+                              &ChapsAdaptor::GenerateRandomAsync);
   dbus_object_.RegisterAsync(std::move(cb));
 }
 
@@ -303,6 +297,7 @@ void ChapsAdaptor::GetSlotInfo(const brillo::SecureVector& isolate_credential,
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "slot_id=" << slot_id;
+  base::AutoLockMaybe slot_lock(GetSlotLock(slot_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -319,6 +314,7 @@ void ChapsAdaptor::GetTokenInfo(const brillo::SecureVector& isolate_credential,
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "slot_id=" << slot_id;
+  base::AutoLockMaybe slot_lock(GetSlotLock(slot_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -336,6 +332,7 @@ void ChapsAdaptor::GetMechanismList(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "slot_id=" << slot_id;
+  base::AutoLockMaybe slot_lock(GetSlotLock(slot_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -357,6 +354,7 @@ void ChapsAdaptor::GetMechanismInfo(
           << "slot_id=" << slot_id;
   VLOG(2) << "IN: "
           << "mechanism_type=" << mechanism_type;
+  base::AutoLockMaybe slot_lock(GetSlotLock(slot_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -383,6 +381,7 @@ uint32_t ChapsAdaptor::InitToken(const brillo::SecureVector& isolate_credential,
   VLOG(2) << "IN: "
           << "new_token_label=" << ConvertByteVectorToString(new_token_label);
   const string* tmp_pin = use_null_pin ? NULL : &optional_so_pin;
+  base::AutoLockMaybe slot_lock(GetSlotLock(slot_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -400,6 +399,7 @@ uint32_t ChapsAdaptor::InitPIN(const brillo::SecureVector& isolate_credential,
   VLOG(2) << "IN: "
           << "use_null_pin=" << use_null_pin;
   const string* tmp_pin = use_null_pin ? NULL : &optional_user_pin;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -421,6 +421,7 @@ uint32_t ChapsAdaptor::SetPIN(const brillo::SecureVector& isolate_credential,
           << "use_null_new_pin=" << use_null_new_pin;
   const string* tmp_old_pin = use_null_old_pin ? NULL : &optional_old_pin;
   const string* tmp_new_pin = use_null_new_pin ? NULL : &optional_new_pin;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -438,6 +439,7 @@ void ChapsAdaptor::OpenSession(const brillo::SecureVector& isolate_credential,
           << "slot_id=" << slot_id;
   VLOG(2) << "IN: "
           << "flags=" << flags;
+  base::AutoLockMaybe slot_lock(GetSlotLock(slot_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -452,6 +454,7 @@ uint32_t ChapsAdaptor::CloseSession(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -466,6 +469,7 @@ void ChapsAdaptor::GetSessionInfo(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -488,6 +492,7 @@ void ChapsAdaptor::GetOperationState(
     vector<uint8_t>* operation_state,
     uint32_t* result) {
   VLOG(1) << "CALL: " << __func__;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -502,6 +507,7 @@ uint32_t ChapsAdaptor::SetOperationState(
     uint64_t encryption_key_handle,
     uint64_t authentication_key_handle) {
   VLOG(1) << "CALL: " << __func__;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -523,6 +529,7 @@ uint32_t ChapsAdaptor::Login(const brillo::SecureVector& isolate_credential,
   VLOG(2) << "IN: "
           << "use_null_pin=" << use_null_pin;
   const string* pin = use_null_pin ? NULL : &optional_pin;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -534,6 +541,7 @@ uint32_t ChapsAdaptor::Logout(const brillo::SecureVector& isolate_credential,
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -550,6 +558,7 @@ void ChapsAdaptor::CreateObject(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "attributes=" << PrintAttributes(attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -572,6 +581,7 @@ void ChapsAdaptor::CopyObject(const brillo::SecureVector& isolate_credential,
           << "object_handle=" << object_handle;
   VLOG(2) << "IN: "
           << "attributes=" << PrintAttributes(attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -590,6 +600,7 @@ uint32_t ChapsAdaptor::DestroyObject(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "object_handle=" << object_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -607,6 +618,7 @@ void ChapsAdaptor::GetObjectSize(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "object_handle=" << object_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -630,6 +642,7 @@ void ChapsAdaptor::GetAttributeValue(
           << "object_handle=" << object_handle;
   VLOG(2) << "IN: "
           << "attributes_in=" << PrintAttributes(attributes_in, false);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -653,6 +666,7 @@ uint32_t ChapsAdaptor::SetAttributeValue(
           << "object_handle=" << object_handle;
   VLOG(2) << "IN: "
           << "attributes=" << PrintAttributes(attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -669,6 +683,7 @@ uint32_t ChapsAdaptor::FindObjectsInit(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "attributes=" << PrintAttributes(attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -686,6 +701,7 @@ void ChapsAdaptor::FindObjects(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_object_count=" << max_object_count;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -701,6 +717,7 @@ uint32_t ChapsAdaptor::FindObjectsFinal(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -722,6 +739,7 @@ uint32_t ChapsAdaptor::EncryptInit(
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
   VLOG(2) << "IN: "
           << "key_handle=" << key_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -741,6 +759,7 @@ void ChapsAdaptor::Encrypt(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -762,6 +781,7 @@ void ChapsAdaptor::EncryptUpdate(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -783,6 +803,7 @@ void ChapsAdaptor::EncryptFinal(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -795,6 +816,7 @@ void ChapsAdaptor::EncryptFinal(const brillo::SecureVector& isolate_credential,
 void ChapsAdaptor::EncryptCancel(const brillo::SecureVector& isolate_credential,
                                  uint64_t session_id) {
   VLOG(1) << "CALL: " << __func__;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -816,6 +838,7 @@ uint32_t ChapsAdaptor::DecryptInit(
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
   VLOG(2) << "IN: "
           << "key_handle=" << key_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -835,6 +858,7 @@ void ChapsAdaptor::Decrypt(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -856,6 +880,7 @@ void ChapsAdaptor::DecryptUpdate(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -877,6 +902,7 @@ void ChapsAdaptor::DecryptFinal(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -889,6 +915,7 @@ void ChapsAdaptor::DecryptFinal(const brillo::SecureVector& isolate_credential,
 void ChapsAdaptor::DecryptCancel(const brillo::SecureVector& isolate_credential,
                                  uint64_t session_id) {
   VLOG(1) << "CALL: " << __func__;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -907,6 +934,7 @@ uint32_t ChapsAdaptor::DigestInit(
           << "mechanism_type=" << mechanism_type;
   VLOG(2) << "IN: "
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -926,6 +954,7 @@ void ChapsAdaptor::Digest(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -942,6 +971,7 @@ uint32_t ChapsAdaptor::DigestUpdate(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -956,6 +986,7 @@ uint32_t ChapsAdaptor::DigestKey(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "key_handle=" << key_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -973,6 +1004,7 @@ void ChapsAdaptor::DigestFinal(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -985,6 +1017,7 @@ void ChapsAdaptor::DigestFinal(const brillo::SecureVector& isolate_credential,
 void ChapsAdaptor::DigestCancel(const brillo::SecureVector& isolate_credential,
                                 uint64_t session_id) {
   VLOG(1) << "CALL: " << __func__;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1005,6 +1038,7 @@ uint32_t ChapsAdaptor::SignInit(const brillo::SecureVector& isolate_credential,
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
   VLOG(2) << "IN: "
           << "key_handle=" << key_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1024,6 +1058,7 @@ void ChapsAdaptor::Sign(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1040,6 +1075,7 @@ uint32_t ChapsAdaptor::SignUpdate(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1057,6 +1093,7 @@ void ChapsAdaptor::SignFinal(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1069,6 +1106,7 @@ void ChapsAdaptor::SignFinal(const brillo::SecureVector& isolate_credential,
 void ChapsAdaptor::SignCancel(const brillo::SecureVector& isolate_credential,
                               uint64_t session_id) {
   VLOG(1) << "CALL: " << __func__;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1090,6 +1128,7 @@ uint32_t ChapsAdaptor::SignRecoverInit(
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
   VLOG(2) << "IN: "
           << "key_handle=" << key_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1110,6 +1149,7 @@ void ChapsAdaptor::SignRecover(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1134,6 +1174,7 @@ uint32_t ChapsAdaptor::VerifyInit(
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
   VLOG(2) << "IN: "
           << "key_handle=" << key_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1148,6 +1189,7 @@ uint32_t ChapsAdaptor::Verify(const brillo::SecureVector& isolate_credential,
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1161,6 +1203,7 @@ uint32_t ChapsAdaptor::VerifyUpdate(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1174,6 +1217,7 @@ uint32_t ChapsAdaptor::VerifyFinal(
   VLOG(1) << "CALL: " << __func__;
   VLOG(2) << "IN: "
           << "session_id=" << session_id;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1183,6 +1227,7 @@ uint32_t ChapsAdaptor::VerifyFinal(
 void ChapsAdaptor::VerifyCancel(const brillo::SecureVector& isolate_credential,
                                 uint64_t session_id) {
   VLOG(1) << "CALL: " << __func__;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1204,6 +1249,7 @@ uint32_t ChapsAdaptor::VerifyRecoverInit(
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
   VLOG(2) << "IN: "
           << "key_handle=" << key_handle;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1224,6 +1270,7 @@ void ChapsAdaptor::VerifyRecover(const brillo::SecureVector& isolate_credential,
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1247,6 +1294,7 @@ void ChapsAdaptor::DigestEncryptUpdate(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1270,6 +1318,7 @@ void ChapsAdaptor::DecryptDigestUpdate(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1293,6 +1342,7 @@ void ChapsAdaptor::SignEncryptUpdate(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1316,6 +1366,7 @@ void ChapsAdaptor::DecryptVerifyUpdate(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1342,6 +1393,7 @@ void ChapsAdaptor::GenerateKey(const brillo::SecureVector& isolate_credential,
           << "mechanism_parameter=" << PrintIntVector(mechanism_parameter);
   VLOG(2) << "IN: "
           << "attributes=" << PrintAttributes(attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1373,6 +1425,7 @@ void ChapsAdaptor::GenerateKeyPair(
           << "public_attributes=" << PrintAttributes(public_attributes, true);
   VLOG(2) << "IN: "
           << "private_attributes=" << PrintAttributes(private_attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1409,6 +1462,7 @@ void ChapsAdaptor::WrapKey(const brillo::SecureVector& isolate_credential,
           << "key_handle=" << key_handle;
   VLOG(2) << "IN: "
           << "max_out_length=" << max_out_length;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1440,6 +1494,7 @@ void ChapsAdaptor::UnwrapKey(const brillo::SecureVector& isolate_credential,
           << "wrapping_key_handle=" << wrapping_key_handle;
   VLOG(2) << "IN: "
           << "attributes=" << PrintAttributes(attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1469,6 +1524,7 @@ void ChapsAdaptor::DeriveKey(const brillo::SecureVector& isolate_credential,
           << "base_key_handle=" << base_key_handle;
   VLOG(2) << "IN: "
           << "attributes=" << PrintAttributes(attributes, true);
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1488,6 +1544,7 @@ uint32_t ChapsAdaptor::SeedRandom(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "num_bytes=" << seed.size();
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1505,6 +1562,7 @@ void ChapsAdaptor::GenerateRandom(
           << "session_id=" << session_id;
   VLOG(2) << "IN: "
           << "num_bytes=" << num_bytes;
+  base::AutoLockMaybe slot_lock(GetSessionLock(session_id));
   SecureBlob isolate_credential_blob(isolate_credential.begin(),
                                      isolate_credential.end());
 
@@ -1512,4 +1570,850 @@ void ChapsAdaptor::GenerateRandom(
                                      num_bytes, random_data);
 }
 
+void ChapsAdaptor::GetSlotInfoAsync(
+    Response<SlotInfo, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t slot_id) {
+  RunOnSlotWorkerThread(
+      FindSlot(slot_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetSlotInfo, base::Unretained(this),
+                     isolate_credential, slot_id));
+}
+
+void ChapsAdaptor::GetTokenInfoAsync(
+    Response<TokenInfo, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t slot_id) {
+  RunOnSlotWorkerThread(
+      FindSlot(slot_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetTokenInfo, base::Unretained(this),
+                     isolate_credential, slot_id));
+}
+
+void ChapsAdaptor::GetMechanismListAsync(
+    Response<std::vector<uint64_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t slot_id) {
+  RunOnSlotWorkerThread(
+      FindSlot(slot_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetMechanismList, base::Unretained(this),
+                     isolate_credential, slot_id));
+}
+
+void ChapsAdaptor::GetMechanismInfoAsync(
+    Response<MechanismInfo, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t slot_id,
+    uint64_t mechanism_type) {
+  RunOnSlotWorkerThread(
+      FindSlot(slot_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetMechanismInfo, base::Unretained(this),
+                     isolate_credential, slot_id, mechanism_type));
+}
+
+void ChapsAdaptor::InitTokenAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t slot_id,
+    bool use_null_pin,
+    const std::string& optional_so_pin,
+    const std::vector<uint8_t>& new_token_label) {
+  RunOnSlotWorkerThread(
+      FindSlot(slot_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::InitToken, base::Unretained(this),
+                     isolate_credential, slot_id, use_null_pin, optional_so_pin,
+                     new_token_label));
+}
+
+void ChapsAdaptor::InitPINAsync(Response<uint32_t> response,
+                                const brillo::SecureVector& isolate_credential,
+                                uint64_t session_id,
+                                bool use_null_pin,
+                                const std::string& optional_user_pin) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::InitPIN, base::Unretained(this),
+                     isolate_credential, session_id, use_null_pin,
+                     optional_user_pin));
+}
+
+void ChapsAdaptor::SetPINAsync(Response<uint32_t> response,
+                               const brillo::SecureVector& isolate_credential,
+                               uint64_t session_id,
+                               bool use_null_old_pin,
+                               const std::string& optional_old_pin,
+                               bool use_null_new_pin,
+                               const std::string& optional_new_pin) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SetPIN, base::Unretained(this),
+                     isolate_credential, session_id, use_null_old_pin,
+                     optional_old_pin, use_null_new_pin, optional_new_pin));
+}
+
+void ChapsAdaptor::OpenSessionAsync(
+    Response<uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t slot_id,
+    uint64_t flags) {
+  RunOnSlotWorkerThread(
+      FindSlot(slot_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::OpenSession, base::Unretained(this),
+                     isolate_credential, slot_id, flags));
+}
+
+void ChapsAdaptor::CloseSessionAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::CloseSession, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::GetSessionInfoAsync(
+    Response<SessionInfo, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetSessionInfo, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::GetOperationStateAsync(
+    Response<std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetOperationState, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::SetOperationStateAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& operation_state,
+    uint64_t encryption_key_handle,
+    uint64_t authentication_key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SetOperationState, base::Unretained(this),
+                     isolate_credential, session_id, operation_state,
+                     encryption_key_handle, authentication_key_handle));
+}
+
+void ChapsAdaptor::LoginAsync(Response<uint32_t> response,
+                              const brillo::SecureVector& isolate_credential,
+                              uint64_t session_id,
+                              uint64_t user_type,
+                              bool use_null_pin,
+                              const std::string& optional_pin) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::Login, base::Unretained(this),
+                     isolate_credential, session_id, user_type, use_null_pin,
+                     optional_pin));
+}
+
+void ChapsAdaptor::LogoutAsync(Response<uint32_t> response,
+                               const brillo::SecureVector& isolate_credential,
+                               uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::Logout, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::CreateObjectAsync(
+    Response<uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::CreateObject, base::Unretained(this),
+                     isolate_credential, session_id, attributes));
+}
+
+void ChapsAdaptor::CopyObjectAsync(
+    Response<uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t object_handle,
+    const std::vector<uint8_t>& attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::CopyObject, base::Unretained(this),
+                     isolate_credential, session_id, object_handle,
+                     attributes));
+}
+
+void ChapsAdaptor::DestroyObjectAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t object_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DestroyObject, base::Unretained(this),
+                     isolate_credential, session_id, object_handle));
+}
+
+void ChapsAdaptor::GetObjectSizeAsync(
+    Response<uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t object_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetObjectSize, base::Unretained(this),
+                     isolate_credential, session_id, object_handle));
+}
+
+void ChapsAdaptor::GetAttributeValueAsync(
+    Response<std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t object_handle,
+    const std::vector<uint8_t>& attributes_in) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GetAttributeValue, base::Unretained(this),
+                     isolate_credential, session_id, object_handle,
+                     attributes_in));
+}
+
+void ChapsAdaptor::SetAttributeValueAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t object_handle,
+    const std::vector<uint8_t>& attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SetAttributeValue, base::Unretained(this),
+                     isolate_credential, session_id, object_handle,
+                     attributes));
+}
+
+void ChapsAdaptor::FindObjectsInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::FindObjectsInit, base::Unretained(this),
+                     isolate_credential, session_id, attributes));
+}
+
+void ChapsAdaptor::FindObjectsAsync(
+    Response<std::vector<uint64_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t max_object_count) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::FindObjects, base::Unretained(this),
+                     isolate_credential, session_id, max_object_count));
+}
+
+void ChapsAdaptor::FindObjectsFinalAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::FindObjectsFinal, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::EncryptInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::EncryptInit, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, key_handle));
+}
+
+void ChapsAdaptor::EncryptAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::Encrypt, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::EncryptUpdateAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::EncryptUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::EncryptFinalAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::EncryptFinal, base::Unretained(this),
+                     isolate_credential, session_id, max_out_length));
+}
+
+void ChapsAdaptor::EncryptCancelAsync(
+    Response<> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::EncryptCancel, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::DecryptInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DecryptInit, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, key_handle));
+}
+
+void ChapsAdaptor::DecryptAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::Decrypt, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::DecryptUpdateAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DecryptUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::DecryptFinalAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DecryptFinal, base::Unretained(this),
+                     isolate_credential, session_id, max_out_length));
+}
+
+void ChapsAdaptor::DecryptCancelAsync(
+    Response<> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DecryptCancel, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::DigestInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DigestInit, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter));
+}
+
+void ChapsAdaptor::DigestAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::Digest, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::DigestUpdateAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DigestUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_in));
+}
+
+void ChapsAdaptor::DigestKeyAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DigestKey, base::Unretained(this),
+                     isolate_credential, session_id, key_handle));
+}
+
+void ChapsAdaptor::DigestFinalAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DigestFinal, base::Unretained(this),
+                     isolate_credential, session_id, max_out_length));
+}
+
+void ChapsAdaptor::DigestCancelAsync(
+    Response<> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DigestCancel, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::SignInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SignInit, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, key_handle));
+}
+
+void ChapsAdaptor::SignAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::Sign, base::Unretained(this),
+                     isolate_credential, session_id, data, max_out_length));
+}
+
+void ChapsAdaptor::SignUpdateAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_part) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SignUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_part));
+}
+
+void ChapsAdaptor::SignFinalAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SignFinal, base::Unretained(this),
+                     isolate_credential, session_id, max_out_length));
+}
+
+void ChapsAdaptor::SignCancelAsync(
+    Response<> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SignCancel, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::SignRecoverInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SignRecoverInit, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, key_handle));
+}
+
+void ChapsAdaptor::SignRecoverAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SignRecover, base::Unretained(this),
+                     isolate_credential, session_id, data, max_out_length));
+}
+
+void ChapsAdaptor::VerifyInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::VerifyInit, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, key_handle));
+}
+
+void ChapsAdaptor::VerifyAsync(Response<uint32_t> response,
+                               const brillo::SecureVector& isolate_credential,
+                               uint64_t session_id,
+                               const std::vector<uint8_t>& data,
+                               const std::vector<uint8_t>& signature) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::Verify, base::Unretained(this),
+                     isolate_credential, session_id, data, signature));
+}
+
+void ChapsAdaptor::VerifyUpdateAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_part) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::VerifyUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_part));
+}
+
+void ChapsAdaptor::VerifyFinalAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& signature) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::VerifyFinal, base::Unretained(this),
+                     isolate_credential, session_id, signature));
+}
+
+void ChapsAdaptor::VerifyCancelAsync(
+    Response<> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::VerifyCancel, base::Unretained(this),
+                     isolate_credential, session_id));
+}
+
+void ChapsAdaptor::VerifyRecoverInitAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t key_handle) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::VerifyRecoverInit, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, key_handle));
+}
+
+void ChapsAdaptor::VerifyRecoverAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& signature,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::VerifyRecover, base::Unretained(this),
+                     isolate_credential, session_id, signature,
+                     max_out_length));
+}
+
+void ChapsAdaptor::DigestEncryptUpdateAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DigestEncryptUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::DecryptDigestUpdateAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DecryptDigestUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::SignEncryptUpdateAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SignEncryptUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::DecryptVerifyUpdateAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& data_in,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DecryptVerifyUpdate, base::Unretained(this),
+                     isolate_credential, session_id, data_in, max_out_length));
+}
+
+void ChapsAdaptor::GenerateKeyAsync(
+    Response<uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    const std::vector<uint8_t>& attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GenerateKey, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, attributes));
+}
+
+void ChapsAdaptor::GenerateKeyPairAsync(
+    Response<uint64_t, uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    const std::vector<uint8_t>& public_attributes,
+    const std::vector<uint8_t>& private_attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GenerateKeyPair, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, public_attributes,
+                     private_attributes));
+}
+
+void ChapsAdaptor::WrapKeyAsync(
+    Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t wrapping_key_handle,
+    uint64_t key_handle,
+    uint64_t max_out_length) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::WrapKey, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, wrapping_key_handle, key_handle,
+                     max_out_length));
+}
+
+void ChapsAdaptor::UnwrapKeyAsync(
+    Response<uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t wrapping_key_handle,
+    const std::vector<uint8_t>& wrapped_key,
+    const std::vector<uint8_t>& attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::UnwrapKey, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, wrapping_key_handle, wrapped_key,
+                     attributes));
+}
+
+void ChapsAdaptor::DeriveKeyAsync(
+    Response<uint64_t, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t mechanism_type,
+    const std::vector<uint8_t>& mechanism_parameter,
+    uint64_t base_key_handle,
+    const std::vector<uint8_t>& attributes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::DeriveKey, base::Unretained(this),
+                     isolate_credential, session_id, mechanism_type,
+                     mechanism_parameter, base_key_handle, attributes));
+}
+
+void ChapsAdaptor::SeedRandomAsync(
+    Response<uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    const std::vector<uint8_t>& seed) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::SeedRandom, base::Unretained(this),
+                     isolate_credential, session_id, seed));
+}
+
+void ChapsAdaptor::GenerateRandomAsync(
+    Response<std::vector<uint8_t>, uint32_t> response,
+    const brillo::SecureVector& isolate_credential,
+    uint64_t session_id,
+    uint64_t num_bytes) {
+  RunOnSlotWorkerThread(
+      FindSessionSlot(session_id), std::move(response),
+      base::BindOnce(&ChapsAdaptor::GenerateRandom, base::Unretained(this),
+                     isolate_credential, session_id, num_bytes));
+}
+
+base::Lock* ChapsAdaptor::GetSessionLock(uint64_t session_id) {
+  int slot_id = 0;
+  if (session_id > std::numeric_limits<int>::max() ||
+      !slot_manager_->GetSessionSlot(session_id, &slot_id)) {
+    return nullptr;
+  }
+  return slot_manager_->GetSlotLock(slot_id);
+}
+
+base::Lock* ChapsAdaptor::GetSlotLock(uint64_t slot_id) {
+  if (slot_id > std::numeric_limits<int>::max())
+    return nullptr;
+  return slot_manager_->GetSlotLock(slot_id);
+}
+
+std::optional<int> ChapsAdaptor::FindSessionSlot(uint64_t session_id) {
+  int slot_id = 0;
+  if (session_id > std::numeric_limits<int>::max() ||
+      !slot_manager_->GetSessionSlot(session_id, &slot_id)) {
+    return std::nullopt;
+  }
+  return slot_id;
+}
+
+std::optional<int> ChapsAdaptor::FindSlot(uint64_t slot_id) {
+  if (!GetSlotLock(slot_id))
+    return std::nullopt;
+  return static_cast<int>(slot_id);
+}
+
+template <typename... Outs>
+void ChapsAdaptor::RunOnSlotWorkerThread(
+    std::optional<int> slot_id,
+    Response<Outs...> response,
+    base::OnceCallback<void(Outs*...)> handler) {
+  base::OnceCallback<std::tuple<Outs...>()> task = base::BindOnce(
+      [](base::OnceCallback<void(Outs*...)> handler) {
+        std::tuple<Outs...> outputs;
+        std::apply(
+            [&handler](Outs&... outs) { std::move(handler).Run(&outs...); },
+            outputs);
+        return outputs;
+      },
+      std::move(handler));
+  base::OnceCallback<void(std::tuple<Outs...>)> reply = base::BindOnce(
+      [](std::unique_ptr<DBusMethodResponse<Outs...>> response,
+         std::tuple<Outs...> outputs) {
+        std::apply(
+            [&response](const Outs&... outs) { response->Return(outs...); },
+            outputs);
+      },
+      std::move(response));
+
+  if (!slot_id.has_value()) {
+    // The call fails with an invalid handle, no need for a thread.
+    std::move(reply).Run(std::move(task).Run());
+    return;
+  }
+  std::unique_ptr<base::Thread>& thread = slot_worker_threads_[*slot_id];
+  if (!thread) {
+    thread = std::make_unique<base::Thread>("chaps_slot_" +
+                                            base::NumberToString(*slot_id));
+    CHECK(thread->Start());
+  }
+  thread->task_runner()->PostTaskAndReplyWithResult(
+      FROM_HERE, std::move(task), std::move(reply));
+}
+
+void ChapsAdaptor::RunOnSlotWorkerThread(
+    std::optional<int> slot_id,
+    Response<uint32_t> response,
+    base::OnceCallback<uint32_t()> handler) {
+  RunOnSlotWorkerThread(
+      slot_id, std::move(response),
+      base::BindOnce(
+          [](base::OnceCallback<uint32_t()> handler, uint32_t* result) {
+            *result = std::move(handler).Run();
+          },
+          std::move(handler)));
+}
+
 }  // namespace chaps
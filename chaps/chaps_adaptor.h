@@ -5,10 +5,18 @@
 #ifndef CHAPS_CHAPS_ADAPTOR_H_
 #define CHAPS_CHAPS_ADAPTOR_H_
 
+#include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include <base/memory/scoped_refptr.h>
+#include <base/synchronization/lock.h>
+#include <base/task/task_runner.h>
+#include <base/threading/thread.h>
 #include <brillo/dbus/async_event_sequencer.h>
+#include <brillo/dbus/dbus_method_response.h>
 #include <brillo/dbus/dbus_object.h>
 #include <brillo/secure_blob.h>
 #include <dbus/bus.h>
@@ -19,15 +27,23 @@ namespace chaps {
 inline constexpr char kPersistentLogLevelPath[] = "/var/lib/chaps/.loglevel";
 
 class ChapsInterface;
+class SlotManager;
 class TokenManagerInterface;
 
 // The ChapsAdaptor class implements the D-Bus interface and redirects IPC
 // calls to a ChapsInterface or TokenManagerInterface.
+//
+// The calls acting on a slot or on a session run on a worker thread of the
+// slot, such that a slow TPM operation on a slot doesn't block the calls on
+// the other slots. The calls on a slot and its sessions are serialized by the
+// lock of the slot. The isolate and token calls, which change the slot list,
+// run on the D-Bus thread.
 class ChapsAdaptor {
  public:
   ChapsAdaptor(scoped_refptr<dbus::Bus> bus,
                ChapsInterface* service,
-               TokenManagerInterface* token_manager);
+               TokenManagerInterface* token_manager,
+               SlotManager* slot_manager);
   ChapsAdaptor(const ChapsAdaptor&) = delete;
   ChapsAdaptor& operator=(const ChapsAdaptor&) = delete;
 
@@ -381,11 +397,358 @@ class ChapsAdaptor {
                       std::vector<uint8_t>* random_data,
                       uint32_t* result);
 
+  // Asynchronous versions of the D-Bus methods acting on a slot or on a
+  // session. They run the methods above on the worker thread of the slot,
+  // and the responses hold the outputs of the methods (or their result).
+  template <typename... Outs>
+  using Response =
+      std::unique_ptr<brillo::dbus_utils::DBusMethodResponse<Outs...>>;
+  void GetSlotInfoAsync(Response<SlotInfo, uint32_t> response,
+                        const brillo::SecureVector& isolate_credential,
+                        uint64_t slot_id);
+  void GetTokenInfoAsync(Response<TokenInfo, uint32_t> response,
+                         const brillo::SecureVector& isolate_credential,
+                         uint64_t slot_id);
+  void GetMechanismListAsync(Response<std::vector<uint64_t>, uint32_t> response,
+                             const brillo::SecureVector& isolate_credential,
+                             uint64_t slot_id);
+  void GetMechanismInfoAsync(Response<MechanismInfo, uint32_t> response,
+                             const brillo::SecureVector& isolate_credential,
+                             uint64_t slot_id,
+                             uint64_t mechanism_type);
+  void InitTokenAsync(Response<uint32_t> response,
+                      const brillo::SecureVector& isolate_credential,
+                      uint64_t slot_id,
+                      bool use_null_pin,
+                      const std::string& optional_so_pin,
+                      const std::vector<uint8_t>& new_token_label);
+  void InitPINAsync(Response<uint32_t> response,
+                    const brillo::SecureVector& isolate_credential,
+                    uint64_t session_id,
+                    bool use_null_pin,
+                    const std::string& optional_user_pin);
+  void SetPINAsync(Response<uint32_t> response,
+                   const brillo::SecureVector& isolate_credential,
+                   uint64_t session_id,
+                   bool use_null_old_pin,
+                   const std::string& optional_old_pin,
+                   bool use_null_new_pin,
+                   const std::string& optional_new_pin);
+  void OpenSessionAsync(Response<uint64_t, uint32_t> response,
+                        const brillo::SecureVector& isolate_credential,
+                        uint64_t slot_id,
+                        uint64_t flags);
+  void CloseSessionAsync(Response<uint32_t> response,
+                         const brillo::SecureVector& isolate_credential,
+                         uint64_t session_id);
+  void GetSessionInfoAsync(Response<SessionInfo, uint32_t> response,
+                           const brillo::SecureVector& isolate_credential,
+                           uint64_t session_id);
+  void GetOperationStateAsync(Response<std::vector<uint8_t>, uint32_t> response,
+                              const brillo::SecureVector& isolate_credential,
+                              uint64_t session_id);
+  void SetOperationStateAsync(Response<uint32_t> response,
+                              const brillo::SecureVector& isolate_credential,
+                              uint64_t session_id,
+                              const std::vector<uint8_t>& operation_state,
+                              uint64_t encryption_key_handle,
+                              uint64_t authentication_key_handle);
+  void LoginAsync(Response<uint32_t> response,
+                  const brillo::SecureVector& isolate_credential,
+                  uint64_t session_id,
+                  uint64_t user_type,
+                  bool use_null_pin,
+                  const std::string& optional_pin);
+  void LogoutAsync(Response<uint32_t> response,
+                   const brillo::SecureVector& isolate_credential,
+                   uint64_t session_id);
+  void CreateObjectAsync(Response<uint64_t, uint32_t> response,
+                         const brillo::SecureVector& isolate_credential,
+                         uint64_t session_id,
+                         const std::vector<uint8_t>& attributes);
+  void CopyObjectAsync(Response<uint64_t, uint32_t> response,
+                       const brillo::SecureVector& isolate_credential,
+                       uint64_t session_id,
+                       uint64_t object_handle,
+                       const std::vector<uint8_t>& attributes);
+  void DestroyObjectAsync(Response<uint32_t> response,
+                          const brillo::SecureVector& isolate_credential,
+                          uint64_t session_id,
+                          uint64_t object_handle);
+  void GetObjectSizeAsync(Response<uint64_t, uint32_t> response,
+                          const brillo::SecureVector& isolate_credential,
+                          uint64_t session_id,
+                          uint64_t object_handle);
+  void GetAttributeValueAsync(Response<std::vector<uint8_t>, uint32_t> response,
+                              const brillo::SecureVector& isolate_credential,
+                              uint64_t session_id,
+                              uint64_t object_handle,
+                              const std::vector<uint8_t>& attributes_in);
+  void SetAttributeValueAsync(Response<uint32_t> response,
+                              const brillo::SecureVector& isolate_credential,
+                              uint64_t session_id,
+                              uint64_t object_handle,
+                              const std::vector<uint8_t>& attributes);
+  void FindObjectsInitAsync(Response<uint32_t> response,
+                            const brillo::SecureVector& isolate_credential,
+                            uint64_t session_id,
+                            const std::vector<uint8_t>& attributes);
+  void FindObjectsAsync(Response<std::vector<uint64_t>, uint32_t> response,
+                        const brillo::SecureVector& isolate_credential,
+                        uint64_t session_id,
+                        uint64_t max_object_count);
+  void FindObjectsFinalAsync(Response<uint32_t> response,
+                             const brillo::SecureVector& isolate_credential,
+                             uint64_t session_id);
+  void EncryptInitAsync(Response<uint32_t> response,
+                        const brillo::SecureVector& isolate_credential,
+                        uint64_t session_id,
+                        uint64_t mechanism_type,
+                        const std::vector<uint8_t>& mechanism_parameter,
+                        uint64_t key_handle);
+  void EncryptAsync(Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+                    const brillo::SecureVector& isolate_credential,
+                    uint64_t session_id,
+                    const std::vector<uint8_t>& data_in,
+                    uint64_t max_out_length);
+  void EncryptUpdateAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& data_in,
+      uint64_t max_out_length);
+  void EncryptFinalAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      uint64_t max_out_length);
+  void EncryptCancelAsync(Response<> response,
+                          const brillo::SecureVector& isolate_credential,
+                          uint64_t session_id);
+  void DecryptInitAsync(Response<uint32_t> response,
+                        const brillo::SecureVector& isolate_credential,
+                        uint64_t session_id,
+                        uint64_t mechanism_type,
+                        const std::vector<uint8_t>& mechanism_parameter,
+                        uint64_t key_handle);
+  void DecryptAsync(Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+                    const brillo::SecureVector& isolate_credential,
+                    uint64_t session_id,
+                    const std::vector<uint8_t>& data_in,
+                    uint64_t max_out_length);
+  void DecryptUpdateAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& data_in,
+      uint64_t max_out_length);
+  void DecryptFinalAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      uint64_t max_out_length);
+  void DecryptCancelAsync(Response<> response,
+                          const brillo::SecureVector& isolate_credential,
+                          uint64_t session_id);
+  void DigestInitAsync(Response<uint32_t> response,
+                       const brillo::SecureVector& isolate_credential,
+                       uint64_t session_id,
+                       uint64_t mechanism_type,
+                       const std::vector<uint8_t>& mechanism_parameter);
+  void DigestAsync(Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+                   const brillo::SecureVector& isolate_credential,
+                   uint64_t session_id,
+                   const std::vector<uint8_t>& data_in,
+                   uint64_t max_out_length);
+  void DigestUpdateAsync(Response<uint32_t> response,
+                         const brillo::SecureVector& isolate_credential,
+                         uint64_t session_id,
+                         const std::vector<uint8_t>& data_in);
+  void DigestKeyAsync(Response<uint32_t> response,
+                      const brillo::SecureVector& isolate_credential,
+                      uint64_t session_id,
+                      uint64_t key_handle);
+  void DigestFinalAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      uint64_t max_out_length);
+  void DigestCancelAsync(Response<> response,
+                         const brillo::SecureVector& isolate_credential,
+                         uint64_t session_id);
+  void SignInitAsync(Response<uint32_t> response,
+                     const brillo::SecureVector& isolate_credential,
+                     uint64_t session_id,
+                     uint64_t mechanism_type,
+                     const std::vector<uint8_t>& mechanism_parameter,
+                     uint64_t key_handle);
+  void SignAsync(Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+                 const brillo::SecureVector& isolate_credential,
+                 uint64_t session_id,
+                 const std::vector<uint8_t>& data,
+                 uint64_t max_out_length);
+  void SignUpdateAsync(Response<uint32_t> response,
+                       const brillo::SecureVector& isolate_credential,
+                       uint64_t session_id,
+                       const std::vector<uint8_t>& data_part);
+  void SignFinalAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      uint64_t max_out_length);
+  void SignCancelAsync(Response<> response,
+                       const brillo::SecureVector& isolate_credential,
+                       uint64_t session_id);
+  void SignRecoverInitAsync(Response<uint32_t> response,
+                            const brillo::SecureVector& isolate_credential,
+                            uint64_t session_id,
+                            uint64_t mechanism_type,
+                            const std::vector<uint8_t>& mechanism_parameter,
+                            uint64_t key_handle);
+  void SignRecoverAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& data,
+      uint64_t max_out_length);
+  void VerifyInitAsync(Response<uint32_t> response,
+                       const brillo::SecureVector& isolate_credential,
+                       uint64_t session_id,
+                       uint64_t mechanism_type,
+                       const std::vector<uint8_t>& mechanism_parameter,
+                       uint64_t key_handle);
+  void VerifyAsync(Response<uint32_t> response,
+                   const brillo::SecureVector& isolate_credential,
+                   uint64_t session_id,
+                   const std::vector<uint8_t>& data,
+                   const std::vector<uint8_t>& signature);
+  void VerifyUpdateAsync(Response<uint32_t> response,
+                         const brillo::SecureVector& isolate_credential,
+                         uint64_t session_id,
+                         const std::vector<uint8_t>& data_part);
+  void VerifyFinalAsync(Response<uint32_t> response,
+                        const brillo::SecureVector& isolate_credential,
+                        uint64_t session_id,
+                        const std::vector<uint8_t>& signature);
+  void VerifyCancelAsync(Response<> response,
+                         const brillo::SecureVector& isolate_credential,
+                         uint64_t session_id);
+  void VerifyRecoverInitAsync(Response<uint32_t> response,
+                              const brillo::SecureVector& isolate_credential,
+                              uint64_t session_id,
+                              uint64_t mechanism_type,
+                              const std::vector<uint8_t>& mechanism_parameter,
+                              uint64_t key_handle);
+  void VerifyRecoverAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& signature,
+      uint64_t max_out_length);
+  void DigestEncryptUpdateAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& data_in,
+      uint64_t max_out_length);
+  void DecryptDigestUpdateAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& data_in,
+      uint64_t max_out_length);
+  void SignEncryptUpdateAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& data_in,
+      uint64_t max_out_length);
+  void DecryptVerifyUpdateAsync(
+      Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+      const brillo::SecureVector& isolate_credential,
+      uint64_t session_id,
+      const std::vector<uint8_t>& data_in,
+      uint64_t max_out_length);
+  void GenerateKeyAsync(Response<uint64_t, uint32_t> response,
+                        const brillo::SecureVector& isolate_credential,
+                        uint64_t session_id,
+                        uint64_t mechanism_type,
+                        const std::vector<uint8_t>& mechanism_parameter,
+                        const std::vector<uint8_t>& attributes);
+  void GenerateKeyPairAsync(Response<uint64_t, uint64_t, uint32_t> response,
+                            const brillo::SecureVector& isolate_credential,
+                            uint64_t session_id,
+                            uint64_t mechanism_type,
+                            const std::vector<uint8_t>& mechanism_parameter,
+                            const std::vector<uint8_t>& public_attributes,
+                            const std::vector<uint8_t>& private_attributes);
+  void WrapKeyAsync(Response<uint64_t, std::vector<uint8_t>, uint32_t> response,
+                    const brillo::SecureVector& isolate_credential,
+                    uint64_t session_id,
+                    uint64_t mechanism_type,
+                    const std::vector<uint8_t>& mechanism_parameter,
+                    uint64_t wrapping_key_handle,
+                    uint64_t key_handle,
+                    uint64_t max_out_length);
+  void UnwrapKeyAsync(Response<uint64_t, uint32_t> response,
+                      const brillo::SecureVector& isolate_credential,
+                      uint64_t session_id,
+                      uint64_t mechanism_type,
+                      const std::vector<uint8_t>& mechanism_parameter,
+                      uint64_t wrapping_key_handle,
+                      const std::vector<uint8_t>& wrapped_key,
+                      const std::vector<uint8_t>& attributes);
+  void DeriveKeyAsync(Response<uint64_t, uint32_t> response,
+                      const brillo::SecureVector& isolate_credential,
+                      uint64_t session_id,
+                      uint64_t mechanism_type,
+                      const std::vector<uint8_t>& mechanism_parameter,
+                      uint64_t base_key_handle,
+                      const std::vector<uint8_t>& attributes);
+  void SeedRandomAsync(Response<uint32_t> response,
+                       const brillo::SecureVector& isolate_credential,
+                       uint64_t session_id,
+                       const std::vector<uint8_t>& seed);
+  void GenerateRandomAsync(Response<std::vector<uint8_t>, uint32_t> response,
+                           const brillo::SecureVector& isolate_credential,
+                           uint64_t session_id,
+                           uint64_t num_bytes);
+
  private:
+  // Returns the lock of the slot of |session_id|, or nullptr if there is no
+  // such session. The call then fails without using any session.
+  base::Lock* GetSessionLock(uint64_t session_id);
+  // Returns the lock of |slot_id|, or nullptr if there is no such slot.
+  base::Lock* GetSlotLock(uint64_t slot_id);
+
+  // Returns the slot of |session_id|, or std::nullopt if there is no such
+  // session.
+  std::optional<int> FindSessionSlot(uint64_t session_id);
+  // Returns |slot_id| if it is an existing slot, or std::nullopt otherwise.
+  std::optional<int> FindSlot(uint64_t slot_id);
+
+  // Runs |handler| with pointers to its outputs on the worker thread of
+  // |slot_id|, and sends the outputs with |response| on the D-Bus thread.
+  // Runs |handler| on the D-Bus thread if there is no slot: the call then
+  // fails right away without using any slot.
+  template <typename... Outs>
+  void RunOnSlotWorkerThread(std::optional<int> slot_id,
+                             Response<Outs...> response,
+                             base::OnceCallback<void(Outs*...)> handler);
+  // Same as above for the methods returning their result.
+  void RunOnSlotWorkerThread(std::optional<int> slot_id,
+                             Response<uint32_t> response,
+                             base::OnceCallback<uint32_t()> handler);
+
   brillo::dbus_utils::DBusObject dbus_object_;
 
   ChapsInterface* service_;
   TokenManagerInterface* token_manager_;
+  SlotManager* slot_manager_;
+
+  // Key: A slot identifier.
+  // Value: The worker thread of the slot, started on first use.
+  std::map<int, std::unique_ptr<base::Thread>> slot_worker_threads_;
 };
 
 }  // namespace chaps
@@ -0,0 +1,199 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chaps/chaps_adaptor.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <base/files/file_path.h>
+#include <base/memory/scoped_refptr.h>
+#include <base/run_loop.h>
+#include <base/synchronization/lock.h>
+#include <base/synchronization/waitable_event.h>
+#include <base/test/bind.h>
+#include <base/test/task_environment.h>
+#include <base/threading/platform_thread.h>
+#include <brillo/dbus/mock_dbus_method_response.h>
+#include <dbus/mock_bus.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "chaps/chaps_proxy_mock.h"
+#include "chaps/slot_manager_mock.h"
+#include "chaps/token_manager_interface.h"
+#include "pkcs11/cryptoki.h"
+
+using brillo::SecureBlob;
+using brillo::dbus_utils::MockDBusMethodResponse;
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+namespace chaps {
+
+namespace {
+
+constexpr uint64_t kSlot0Session = 10;
+constexpr uint64_t kSlot1Session = 11;
+constexpr uint64_t kUnknownSession = 12;
+
+class TokenManagerMock : public TokenManagerInterface {
+ public:
+  MOCK_METHOD(bool, OpenIsolate, (SecureBlob*, bool*), (override));
+  MOCK_METHOD(void, CloseIsolate, (const SecureBlob&), (override));
+  MOCK_METHOD(bool,
+              LoadToken,
+              (const SecureBlob&,
+               const base::FilePath&,
+               const SecureBlob&,
+               const std::string&,
+               int*),
+              (override));
+  MOCK_METHOD(bool,
+              UnloadToken,
+              (const SecureBlob&, const base::FilePath&),
+              (override));
+  MOCK_METHOD(bool,
+              GetTokenPath,
+              (const SecureBlob&, int, base::FilePath*),
+              (override));
+};
+
+class ChapsAdaptorTest : public ::testing::Test {
+ public:
+  ChapsAdaptorTest()
+      : bus_(base::MakeRefCounted<dbus::MockBus>(dbus::Bus::Options())),
+        service_(/*is_initialized=*/true) {
+    ON_CALL(slot_manager_, GetSessionSlot(kSlot0Session, _))
+        .WillByDefault(DoAll(SetArgPointee<1>(0), Return(true)));
+    ON_CALL(slot_manager_, GetSessionSlot(kSlot1Session, _))
+        .WillByDefault(DoAll(SetArgPointee<1>(1), Return(true)));
+    ON_CALL(slot_manager_, GetSessionSlot(kUnknownSession, _))
+        .WillByDefault(Return(false));
+    ON_CALL(slot_manager_, GetSlotLock(0)).WillByDefault(Return(&slot0_lock_));
+    ON_CALL(slot_manager_, GetSlotLock(1)).WillByDefault(Return(&slot1_lock_));
+    adaptor_ = std::make_unique<ChapsAdaptor>(bus_, &service_, &token_manager_,
+                                              &slot_manager_);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  scoped_refptr<dbus::MockBus> bus_;
+  NiceMock<ChapsProxyMock> service_;
+  NiceMock<TokenManagerMock> token_manager_;
+  NiceMock<SlotManagerMock> slot_manager_;
+  base::Lock slot0_lock_;
+  base::Lock slot1_lock_;
+  std::unique_ptr<ChapsAdaptor> adaptor_;
+};
+
+TEST_F(ChapsAdaptorTest, SlowCallDoesNotBlockOtherSlots) {
+  base::WaitableEvent slot0_sign_started;
+  base::WaitableEvent slot0_sign_release;
+  EXPECT_CALL(service_, Sign(_, kSlot0Session, _, _, _, _))
+      .WillOnce(Invoke([&](const SecureBlob&, uint64_t,
+                           const std::vector<uint8_t>&, uint64_t,
+                           uint64_t* actual_out_length,
+                           std::vector<uint8_t>* signature) {
+        slot0_sign_started.Signal();
+        slot0_sign_release.Wait();
+        *actual_out_length = 1;
+        *signature = {0};
+        return CKR_OK;
+      }));
+  EXPECT_CALL(service_, Sign(_, kSlot1Session, _, _, _, _))
+      .WillOnce(Invoke([](const SecureBlob&, uint64_t,
+                          const std::vector<uint8_t>&, uint64_t,
+                          uint64_t* actual_out_length,
+                          std::vector<uint8_t>* signature) {
+        *actual_out_length = 1;
+        *signature = {1};
+        return CKR_OK;
+      }));
+
+  base::RunLoop slot0_loop;
+  std::optional<uint32_t> slot0_result;
+  auto slot0_response = std::make_unique<
+      MockDBusMethodResponse<uint64_t, std::vector<uint8_t>, uint32_t>>();
+  slot0_response->set_return_callback(base::BindLambdaForTesting(
+      [&](const uint64_t&, const std::vector<uint8_t>& signature,
+          const uint32_t& result) {
+        EXPECT_EQ(signature, std::vector<uint8_t>({0}));
+        slot0_result = result;
+        slot0_loop.Quit();
+      }));
+  adaptor_->SignAsync(std::move(slot0_response), {}, kSlot0Session, {}, 1);
+  slot0_sign_started.Wait();
+
+  base::RunLoop slot1_loop;
+  std::optional<uint32_t> slot1_result;
+  auto slot1_response = std::make_unique<
+      MockDBusMethodResponse<uint64_t, std::vector<uint8_t>, uint32_t>>();
+  slot1_response->set_return_callback(base::BindLambdaForTesting(
+      [&](const uint64_t&, const std::vector<uint8_t>& signature,
+          const uint32_t& result) {
+        EXPECT_EQ(signature, std::vector<uint8_t>({1}));
+        slot1_result = result;
+        slot1_loop.Quit();
+      }));
+  adaptor_->SignAsync(std::move(slot1_response), {}, kSlot1Session, {}, 1);
+
+  // The call on slot 1 completes while the call on slot 0 is still running.
+  slot1_loop.Run();
+  EXPECT_EQ(slot1_result, CKR_OK);
+  EXPECT_FALSE(slot0_result.has_value());
+
+  slot0_sign_release.Signal();
+  slot0_loop.Run();
+  EXPECT_EQ(slot0_result, CKR_OK);
+}
+
+TEST_F(ChapsAdaptorTest, ResultCallRunsOnSlotWorkerThread) {
+  const base::PlatformThreadId main_thread = base::PlatformThread::CurrentId();
+  std::optional<base::PlatformThreadId> call_thread;
+  EXPECT_CALL(service_, CloseSession(_, kSlot0Session))
+      .WillOnce(Invoke([&](const SecureBlob&, uint64_t) {
+        call_thread = base::PlatformThread::CurrentId();
+        return CKR_OK;
+      }));
+
+  base::RunLoop loop;
+  std::optional<uint32_t> result;
+  auto response = std::make_unique<MockDBusMethodResponse<uint32_t>>();
+  response->set_return_callback(
+      base::BindLambdaForTesting([&](const uint32_t& value) {
+        result = value;
+        loop.Quit();
+      }));
+  adaptor_->CloseSessionAsync(std::move(response), {}, kSlot0Session);
+  loop.Run();
+
+  EXPECT_EQ(result, CKR_OK);
+  ASSERT_TRUE(call_thread.has_value());
+  EXPECT_NE(*call_thread, main_thread);
+}
+
+TEST_F(ChapsAdaptorTest, UnknownSessionFailsOnDBusThread) {
+  EXPECT_CALL(service_, CloseSession(_, kUnknownSession))
+      .WillOnce(Return(CKR_SESSION_HANDLE_INVALID));
+
+  std::optional<uint32_t> result;
+  auto response = std::make_unique<MockDBusMethodResponse<uint32_t>>();
+  response->save_return_args(&result);
+  adaptor_->CloseSessionAsync(std::move(response), {}, kUnknownSession);
+
+  // No worker thread is involved, the response is sent right away.
+  EXPECT_EQ(result, CKR_SESSION_HANDLE_INVALID);
+}
+
+}  // namespace
+
+}  // namespace chaps
@@ -6,10 +6,22 @@
 
 #include <string>
 
+#include <base/time/time.h>
 #include <metrics/metrics_library.h>
 
 namespace chaps {
 
+namespace {
+
+constexpr base::TimeDelta kTokenLoadTimeMin = base::Milliseconds(1);
+constexpr base::TimeDelta kTokenLoadTimeMax = base::Seconds(30);
+constexpr int kTokenLoadTimeBuckets = 50;
+constexpr int kTokenObjectCountMin = 1;
+constexpr int kTokenObjectCountMax = 10000;
+constexpr int kTokenObjectCountBuckets = 50;
+
+}  // namespace
+
 void ChapsMetrics::ReportReinitializingTokenStatus(
     ReinitializingTokenStatus status) {
 #ifndef NO_METRICS
@@ -54,4 +66,18 @@ void ChapsMetrics::ReportChapsTokenManagerStatus(const std::string& operation,
 #endif
 }
 
+void ChapsMetrics::ReportTokenObjectsLoaded(const std::string& object_type,
+                                            base::TimeDelta duration,
+                                            int object_count) {
+#ifndef NO_METRICS
+  metrics_library_->SendTimeToUMA(
+      std::string(kChapsTokenLoadTimeHistogramPrefix) + "." + object_type,
+      duration, kTokenLoadTimeMin, kTokenLoadTimeMax, kTokenLoadTimeBuckets);
+  metrics_library_->SendToUMA(
+      std::string(kChapsTokenObjectCountHistogramPrefix) + "." + object_type,
+      object_count, kTokenObjectCountMin, kTokenObjectCountMax,
+      kTokenObjectCountBuckets);
+#endif
+}
+
 }  // namespace chaps
@@ -33,6 +33,16 @@ inline constexpr char kChapsSessionHistogramPrefix[] = "Platform.Chaps.Session";
 inline constexpr char kChapsTokenManagerHistogramPrefix[] =
     "Platform.Chaps.TokenManager";
 
+inline constexpr char kChapsTokenLoadTimeHistogramPrefix[] =
+    "Platform.Chaps.TokenLoadTime";
+
+inline constexpr char kChapsTokenObjectCountHistogramPrefix[] =
+    "Platform.Chaps.TokenObjectCount";
+
+// Suffixes of the token load histograms for the public and private objects.
+inline constexpr char kPublicObjectsSuffix[] = "Public";
+inline constexpr char kPrivateObjectsSuffix[] = "Private";
+
 // List of reasons to initializing token. These entries
 // should not be renumbered and numeric values should never be reused.
 // These values are persisted to logs.
@@ -109,6 +119,14 @@ class ChapsMetrics : private MetricsLibrary {
   virtual void ReportChapsTokenManagerStatus(const std::string& operation,
                                              TokenManagerStatus status);
 
+  // The time taken to read and decrypt the |object_type| objects of a token
+  // and the number of objects are reported to the
+  // "Platform.Chaps.TokenLoadTime" and "Platform.Chaps.TokenObjectCount"
+  // histograms.
+  virtual void ReportTokenObjectsLoaded(const std::string& object_type,
+                                        base::TimeDelta duration,
+                                        int object_count);
+
   void set_metrics_library_for_testing(
       MetricsLibraryInterface* metrics_library) {
     metrics_library_ = metrics_library;
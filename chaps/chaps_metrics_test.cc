@@ -127,4 +127,19 @@ TEST_F(ChapsMetricsTest, ReportChapsSessionStatus) {
   }
 }
 
+TEST_F(ChapsMetricsTest, ReportTokenObjectsLoaded) {
+  const base::TimeDelta duration = base::Milliseconds(123);
+  EXPECT_CALL(
+      mock_metrics_library_,
+      SendTimeToUMA(std::string(kChapsTokenLoadTimeHistogramPrefix) + ".Public",
+                    duration, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_CALL(mock_metrics_library_,
+              SendToUMA(std::string(kChapsTokenObjectCountHistogramPrefix) +
+                            ".Public",
+                        42, _, _, _))
+      .WillOnce(Return(true));
+  chaps_metrics_.ReportTokenObjectsLoaded(kPublicObjectsSuffix, duration, 42);
+}
+
 }  // namespace chaps
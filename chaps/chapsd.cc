@@ -147,7 +147,8 @@ class Daemon : public brillo::DBusServiceDaemon {
 
   void RegisterDBusObjectsAsync(
       brillo::dbus_utils::AsyncEventSequencer* sequencer) override {
-    adaptor_.reset(new ChapsAdaptor(bus_, service_.get(), slot_manager_.get()));
+    adaptor_.reset(new ChapsAdaptor(bus_, service_.get(), slot_manager_.get(),
+                                    slot_manager_.get()));
     adaptor_->RegisterAsync(
         sequencer->GetHandler("RegisterAsync() failed", true));
   }
@@ -0,0 +1,106 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Microbenchmark of searching objects in an object pool holding thousands of
+// certificates and keys, as NSS does when listing the certificates. The
+// numbers of searches per second are reported as "items_per_second".
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <base/check.h>
+#include <base/strings/string_number_conversions.h>
+#include <benchmark/benchmark.h>
+
+#include "chaps/chaps_factory_impl.h"
+#include "chaps/handle_generator.h"
+#include "chaps/object.h"
+#include "chaps/object_pool_impl.h"
+
+namespace chaps {
+
+namespace {
+
+class SimpleHandleGenerator : public HandleGenerator {
+ public:
+  int CreateHandle() override { return ++last_handle_; }
+
+ private:
+  int last_handle_ = 0;
+};
+
+// An object pool with |num_objects| certificates and as many private keys.
+class ObjectPoolFixture {
+ public:
+  explicit ObjectPoolFixture(int num_objects)
+      : factory_(/*chaps_metrics=*/nullptr),
+        pool_(&factory_, &handle_generator_, /*slot_policy=*/nullptr,
+              /*store=*/nullptr) {
+    CHECK(pool_.Init());
+    for (int i = 0; i < num_objects; ++i) {
+      const std::string id = base::NumberToString(i);
+      InsertObject(CKO_CERTIFICATE, id, "cert" + id);
+      InsertObject(CKO_PRIVATE_KEY, id, "key" + id);
+    }
+  }
+
+  ObjectPool& pool() { return pool_; }
+
+ private:
+  void InsertObject(CK_OBJECT_CLASS object_class,
+                    const std::string& id,
+                    const std::string& label) {
+    Object* object = factory_.CreateObject();
+    object->SetAttributeInt(CKA_CLASS, object_class);
+    object->SetAttributeString(CKA_ID, id);
+    object->SetAttributeString(CKA_LABEL, label);
+    object->SetAttributeBool(CKA_PRIVATE, false);
+    CHECK(pool_.Insert(object) == ObjectPool::Result::Success);
+  }
+
+  ChapsFactoryImpl factory_;
+  SimpleHandleGenerator handle_generator_;
+  ObjectPoolImpl pool_;
+};
+
+}  // namespace
+
+// Finds the private key of each certificate by its CKA_ID.
+static void BM_FindById(benchmark::State& state) {
+  const int num_objects = state.range(0);
+  ObjectPoolFixture fixture(num_objects);
+  ChapsFactoryImpl factory(/*chaps_metrics=*/nullptr);
+  std::unique_ptr<Object> search_template(factory.CreateObject());
+  search_template->SetAttributeInt(CKA_CLASS, CKO_PRIVATE_KEY);
+  int i = 0;
+  for (auto _ : state) {
+    const std::string id = base::NumberToString(i++ % num_objects);
+    search_template->SetAttributeString(CKA_ID, id);
+    std::vector<const Object*> objects;
+    fixture.pool().Find(search_template.get(), &objects);
+    benchmark::DoNotOptimize(objects);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindById)->Arg(100)->Arg(1000)->Arg(5000);
+
+// Lists all the certificates.
+static void BM_FindByClass(benchmark::State& state) {
+  ObjectPoolFixture fixture(state.range(0));
+  ChapsFactoryImpl factory(/*chaps_metrics=*/nullptr);
+  std::unique_ptr<Object> search_template(factory.CreateObject());
+  search_template->SetAttributeInt(CKA_CLASS, CKO_CERTIFICATE);
+  for (auto _ : state) {
+    std::vector<const Object*> objects;
+    fixture.pool().Find(search_template.get(), &objects);
+    benchmark::DoNotOptimize(objects);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindByClass)->Arg(100)->Arg(1000)->Arg(5000);
+
+}  // namespace chaps
+
+BENCHMARK_MAIN();
@@ -7,10 +7,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <base/check.h>
 #include <base/logging.h>
+#include <base/synchronization/lock.h>
 
 #include "chaps/chaps.h"
 #include "chaps/chaps_factory.h"
@@ -30,6 +32,15 @@ using Result = chaps::ObjectPool::Result;
 
 namespace chaps {
 
+namespace {
+
+// The attributes commonly used to search objects, e.g. by NSS when listing the
+// certificates and keys.
+const CK_ATTRIBUTE_TYPE kIndexedAttributes[] = {CKA_CLASS, CKA_ID, CKA_LABEL,
+                                                CKA_KEY_TYPE};
+
+}  // namespace
+
 ObjectPoolImpl::ObjectPoolImpl(ChapsFactory* factory,
                                HandleGenerator* handle_generator,
                                SlotPolicy* slot_policy,
@@ -43,6 +54,7 @@ ObjectPoolImpl::ObjectPoolImpl(ChapsFactory* factory,
 ObjectPoolImpl::~ObjectPoolImpl() {}
 
 bool ObjectPoolImpl::Init() {
+  base::AutoLock lock(lock_);
   if (store_.get()) {
     if (!LoadPublicObjects())
       return false;
@@ -54,18 +66,21 @@ bool ObjectPoolImpl::Init() {
 }
 
 bool ObjectPoolImpl::GetInternalBlob(int blob_id, string* blob) {
+  base::AutoLock lock(lock_);
   if (store_.get())
     return store_->GetInternalBlob(blob_id, blob);
   return false;
 }
 
 bool ObjectPoolImpl::SetInternalBlob(int blob_id, const string& blob) {
+  base::AutoLock lock(lock_);
   if (store_.get())
     return store_->SetInternalBlob(blob_id, blob);
   return false;
 }
 
 bool ObjectPoolImpl::SetEncryptionKey(const SecureBlob& key) {
+  base::AutoLock lock(lock_);
   if (key.empty())
     LOG(WARNING) << "WARNING: Private object services will not be available.";
   if (store_.get() && !key.empty()) {
@@ -81,6 +96,7 @@ bool ObjectPoolImpl::SetEncryptionKey(const SecureBlob& key) {
 }
 
 Result ObjectPoolImpl::Insert(Object* object) {
+  base::AutoLock lock(lock_);
   // If it's a private object we need to wait until private objects have been
   // loaded.
   if (object->IsPrivate() && !is_private_loaded_) {
@@ -90,6 +106,7 @@ Result ObjectPoolImpl::Insert(Object* object) {
 }
 
 Result ObjectPoolImpl::Import(Object* object) {
+  base::AutoLock lock(lock_);
   return AddObject(object, /*from_external_source=*/true);
 }
 
@@ -123,10 +140,12 @@ Result ObjectPoolImpl::AddObject(Object* object, bool from_external_source) {
   object->set_handle(handle_generator_->CreateHandle());
   objects_.insert(object);
   handle_object_map_[object->handle()] = shared_ptr<const Object>(object);
+  AddToIndex(object);
   return Result::Success;
 }
 
 Result ObjectPoolImpl::Delete(const Object* object) {
+  base::AutoLock lock(lock_);
   if (objects_.find(object) == objects_.end())
     return Result::Failure;
   if (store_.get()) {
@@ -137,14 +156,20 @@ Result ObjectPoolImpl::Delete(const Object* object) {
     if (!store_->DeleteObjectBlob(object->store_id()))
       return Result::Failure;
   }
+  RemoveFromIndex(object);
+  modified_objects_.erase(object);
   handle_object_map_.erase(object->handle());
   objects_.erase(object);
   return Result::Success;
 }
 
 Result ObjectPoolImpl::DeleteAll() {
+  base::AutoLock lock(lock_);
   objects_.clear();
   handle_object_map_.clear();
+  attribute_index_.clear();
+  object_index_keys_.clear();
+  modified_objects_.clear();
   if (store_.get())
     return store_->DeleteAllObjectBlobs() ? Result::Success : Result::Failure;
   return Result::Success;
@@ -152,6 +177,7 @@ Result ObjectPoolImpl::DeleteAll() {
 
 Result ObjectPoolImpl::Find(const Object* search_template,
                             vector<const Object*>* matching_objects) {
+  base::AutoLock lock(lock_);
   // If we're looking for private objects we need to wait until private objects
   // have been loaded.
   if (((search_template->IsAttributePresent(CKA_PRIVATE) &&
@@ -160,7 +186,12 @@ Result ObjectPoolImpl::Find(const Object* search_template,
         search_template->GetObjectClass() == CKO_PRIVATE_KEY)) &&
       !is_private_loaded_)
     return Result::WaitForPrivateObjects;
-  for (ObjectSet::iterator it = objects_.begin(); it != objects_.end(); ++it) {
+  ObjectSet candidates;
+  const ObjectSet* objects_to_check = &objects_;
+  if (GetIndexedCandidates(search_template, &candidates))
+    objects_to_check = &candidates;
+  for (ObjectSet::const_iterator it = objects_to_check->begin();
+       it != objects_to_check->end(); ++it) {
     if (Matches(search_template, *it))
       matching_objects->push_back(*it);
   }
@@ -168,6 +199,7 @@ Result ObjectPoolImpl::Find(const Object* search_template,
 }
 
 Result ObjectPoolImpl::FindByHandle(int handle, const Object** object) {
+  base::AutoLock lock(lock_);
   CHECK(object);
   HandleObjectMap::iterator it = handle_object_map_.find(handle);
   if (it == handle_object_map_.end())
@@ -177,12 +209,22 @@ Result ObjectPoolImpl::FindByHandle(int handle, const Object** object) {
 }
 
 Object* ObjectPoolImpl::GetModifiableObject(const Object* object) {
+  base::AutoLock lock(lock_);
+  if (objects_.find(object) != objects_.end())
+    modified_objects_.insert(object);
   return const_cast<Object*>(object);
 }
 
 Result ObjectPoolImpl::Flush(const Object* object) {
+  base::AutoLock lock(lock_);
   if (objects_.find(object) == objects_.end())
     return Result::Failure;
+  // The in-memory object has been modified regardless of whether the store can
+  // be updated.
+  if (modified_objects_.erase(object)) {
+    RemoveFromIndex(object);
+    AddToIndex(object);
+  }
   if (store_.get()) {
     ObjectBlob serialized;
     if (!Serialize(object, &serialized))
@@ -198,6 +240,7 @@ Result ObjectPoolImpl::Flush(const Object* object) {
 }
 
 bool ObjectPoolImpl::IsPrivateLoaded() {
+  base::AutoLock lock(lock_);
   return is_private_loaded_;
 }
 
@@ -278,6 +321,7 @@ bool ObjectPoolImpl::LoadBlobs(const map<int, ObjectBlob>& object_blobs) {
       object->set_store_id(it->first);
       objects_.insert(object.get());
       handle_object_map_[object->handle()] = object;
+      AddToIndex(object.get());
     } else {
       LOG(WARNING) << "Object not parsable: " << it->first;
     }
@@ -301,4 +345,53 @@ bool ObjectPoolImpl::LoadPrivateObjects() {
   return LoadBlobs(object_blobs);
 }
 
+void ObjectPoolImpl::AddToIndex(const Object* object) {
+  vector<std::pair<CK_ATTRIBUTE_TYPE, string>>& keys =
+      object_index_keys_[object];
+  for (CK_ATTRIBUTE_TYPE type : kIndexedAttributes) {
+    if (!object->IsAttributePresent(type))
+      continue;
+    std::pair<CK_ATTRIBUTE_TYPE, string> key(type,
+                                             object->GetAttributeString(type));
+    attribute_index_[key].insert(object);
+    keys.push_back(std::move(key));
+  }
+}
+
+void ObjectPoolImpl::RemoveFromIndex(const Object* object) {
+  auto keys_it = object_index_keys_.find(object);
+  if (keys_it == object_index_keys_.end())
+    return;
+  for (const auto& key : keys_it->second) {
+    AttributeIndex::iterator index_it = attribute_index_.find(key);
+    if (index_it == attribute_index_.end())
+      continue;
+    index_it->second.erase(object);
+    if (index_it->second.empty())
+      attribute_index_.erase(index_it);
+  }
+  object_index_keys_.erase(keys_it);
+}
+
+bool ObjectPoolImpl::GetIndexedCandidates(const Object* search_template,
+                                          ObjectSet* candidates) {
+  const ObjectSet* smallest = nullptr;
+  const ObjectSet kEmptySet;
+  for (CK_ATTRIBUTE_TYPE type : kIndexedAttributes) {
+    if (!search_template->IsAttributePresent(type))
+      continue;
+    AttributeIndex::const_iterator it = attribute_index_.find(
+        std::make_pair(type, search_template->GetAttributeString(type)));
+    const ObjectSet* objects =
+        it == attribute_index_.end() ? &kEmptySet : &it->second;
+    if (!smallest || objects->size() < smallest->size())
+      smallest = objects;
+  }
+  if (!smallest)
+    return false;
+  *candidates = *smallest;
+  candidates->insert(modified_objects_.begin(), modified_objects_.end());
+  return true;
+}
+
 }  // namespace chaps
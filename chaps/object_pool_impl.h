@@ -11,9 +11,13 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <base/synchronization/lock.h>
+
 #include "chaps/object_store.h"
+#include "pkcs11/cryptoki.h"
 
 namespace chaps {
 
@@ -25,6 +29,10 @@ class SlotPolicy;
 // Value: Object shared pointer.
 typedef std::map<int, std::shared_ptr<const Object>> HandleObjectMap;
 typedef std::set<const Object*> ObjectSet;
+// Key: Attribute type and value.
+// Value: Objects which hold the attribute with this value.
+typedef std::map<std::pair<CK_ATTRIBUTE_TYPE, std::string>, ObjectSet>
+    AttributeIndex;
 
 class ObjectPoolImpl : public ObjectPool {
  public:
@@ -68,9 +76,32 @@ class ObjectPoolImpl : public ObjectPool {
   bool LoadBlobs(const std::map<int, ObjectBlob>& object_blobs);
   bool LoadPublicObjects();
   bool LoadPrivateObjects();
+  // Adds the values of the indexed attributes of 'object' to the index.
+  void AddToIndex(const Object* object);
+  // Removes 'object' from the index, using the values it was indexed with.
+  void RemoveFromIndex(const Object* object);
+  // Gets the objects which may match 'search_template' according to the
+  // index. Returns false if the template has no indexed attribute, then all
+  // objects need to be checked.
+  bool GetIndexedCandidates(const Object* search_template,
+                            ObjectSet* candidates);
 
+  // Guards the members below. The pool of a token is used by its sessions,
+  // possibly from another thread than the one loading its private objects.
+  base::Lock lock_;
   // Allows us to quickly check whether an object exists in the pool.
   ObjectSet objects_;
+  // Indexes the objects by the values of common search attributes, such that
+  // Find doesn't need to check every object.
+  AttributeIndex attribute_index_;
+  // The index keys each object has been added to 'attribute_index_' with.
+  std::map<const Object*,
+           std::vector<std::pair<CK_ATTRIBUTE_TYPE, std::string>>>
+      object_index_keys_;
+  // Objects returned by GetModifiableObject and not flushed yet. Their
+  // attributes may have changed since they were indexed, so they are always
+  // considered by Find.
+  ObjectSet modified_objects_;
   HandleObjectMap handle_object_map_;
   ChapsFactory* factory_;
   HandleGenerator* handle_generator_;
@@ -246,6 +246,67 @@ TEST_F(TestObjectPool, InsertFindUpdateDelete) {
   EXPECT_EQ(0, v.size());
 }
 
+// Test that Find returns the right objects when searching by indexed
+// attributes, also after the attributes of an object changed.
+TEST_F(TestObjectPool, FindByIndexedAttributes) {
+  PreparePools();
+  Object* cert = CreateObjectMock();
+  cert->SetAttributeInt(CKA_CLASS, CKO_CERTIFICATE);
+  cert->SetAttributeString(CKA_ID, "id1");
+  cert->SetAttributeString(CKA_LABEL, "label1");
+  Object* key = CreateObjectMock();
+  key->SetAttributeInt(CKA_CLASS, CKO_PRIVATE_KEY);
+  key->SetAttributeString(CKA_ID, "id1");
+  Object* no_id = CreateObjectMock();
+  no_id->SetAttributeInt(CKA_CLASS, CKO_CERTIFICATE);
+  EXPECT_EQ(Result::Success, pool2_->Insert(cert));
+  EXPECT_EQ(Result::Success, pool2_->Insert(key));
+  EXPECT_EQ(Result::Success, pool2_->Insert(no_id));
+
+  std::unique_ptr<Object> find_id(CreateObjectMock());
+  find_id->SetAttributeString(CKA_ID, "id1");
+  vector<const Object*> v;
+  EXPECT_EQ(Result::Success, pool2_->Find(find_id.get(), &v));
+  EXPECT_EQ(2, v.size());
+
+  std::unique_ptr<Object> find_cert(CreateObjectMock());
+  find_cert->SetAttributeInt(CKA_CLASS, CKO_CERTIFICATE);
+  find_cert->SetAttributeString(CKA_ID, "id1");
+  v.clear();
+  EXPECT_EQ(Result::Success, pool2_->Find(find_cert.get(), &v));
+  ASSERT_EQ(1, v.size());
+  EXPECT_EQ(cert, v[0]);
+
+  std::unique_ptr<Object> find_label(CreateObjectMock());
+  find_label->SetAttributeString(CKA_LABEL, "label2");
+  v.clear();
+  EXPECT_EQ(Result::Success, pool2_->Find(find_label.get(), &v));
+  EXPECT_EQ(0, v.size());
+
+  // The modified object should be found before and after being flushed.
+  Object* o = pool2_->GetModifiableObject(key);
+  o->SetAttributeString(CKA_LABEL, "label2");
+  o->SetAttributeString(CKA_ID, "id2");
+  v.clear();
+  EXPECT_EQ(Result::Success, pool2_->Find(find_label.get(), &v));
+  ASSERT_EQ(1, v.size());
+  EXPECT_EQ(key, v[0]);
+  EXPECT_EQ(Result::Success, pool2_->Flush(o));
+  v.clear();
+  EXPECT_EQ(Result::Success, pool2_->Find(find_label.get(), &v));
+  ASSERT_EQ(1, v.size());
+  EXPECT_EQ(key, v[0]);
+  v.clear();
+  EXPECT_EQ(Result::Success, pool2_->Find(find_id.get(), &v));
+  ASSERT_EQ(1, v.size());
+  EXPECT_EQ(cert, v[0]);
+
+  EXPECT_EQ(Result::Success, pool2_->Delete(cert));
+  v.clear();
+  EXPECT_EQ(Result::Success, pool2_->Find(find_id.get(), &v));
+  EXPECT_EQ(0, v.size());
+}
+
 // Test handling of an invalid object pointer.
 TEST_F(TestObjectPool, UnknownObject) {
   PreparePools();
@@ -17,6 +17,7 @@
 #include <base/strings/string_piece.h>
 #include <base/strings/string_util.h>
 #include <base/strings/stringprintf.h>
+#include <base/time/time.h>
 #include <brillo/secure_blob.h>
 #include <brillo/files/file_util.h>
 #include <leveldb/db.h>
@@ -112,6 +113,7 @@ ObjectStoreImpl::~ObjectStoreImpl() {
 bool ObjectStoreImpl::Init(const FilePath& database_path,
                            ChapsMetrics* chaps_metrics) {
   LOG(INFO) << "Opening database in: " << database_path.value();
+  chaps_metrics_ = chaps_metrics;
   chaps_metrics->ReportCrosEvent(kDatabaseOpenAttempt);
   leveldb::Options options;
   options.create_if_missing = true;
@@ -282,9 +284,16 @@ bool ObjectStoreImpl::LoadPrivateObjectBlobs(map<int, ObjectBlob>* blobs) {
 
 bool ObjectStoreImpl::LoadObjectBlobs(BlobType type,
                                       map<int, ObjectBlob>* blobs) {
-  std::unique_ptr<leveldb::Iterator> it(
-      db_->NewIterator(leveldb::ReadOptions()));
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  // The blobs are read once, so keep them out of the block cache. All the keys
+  // of the blobs of |type| share the same prefix, only this range is read.
+  leveldb::ReadOptions read_options;
+  read_options.fill_cache = false;
+  std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(read_options));
+  const string key_prefix = CreateBlobKeyPrefix(type);
+  int object_count = 0;
+  for (it->Seek(key_prefix); it->Valid() && it->key().starts_with(key_prefix);
+       it->Next()) {
     BlobType it_type;
     int id = 0;
     if (ParseBlobKey(it->key().ToString(), &it_type, &id) && type == it_type) {
@@ -298,8 +307,14 @@ bool ObjectStoreImpl::LoadObjectBlobs(BlobType type,
       }
       (*blobs)[id] = blob;
       blob_type_map_[id] = type;
+      ++object_count;
     }
   }
+  if (chaps_metrics_) {
+    chaps_metrics_->ReportTokenObjectsLoaded(
+        type == kPrivate ? kPrivateObjectsSuffix : kPublicObjectsSuffix,
+        base::TimeTicks::Now() - start_time, object_count);
+  }
   return true;
 }
 
@@ -370,6 +385,11 @@ bool ObjectStoreImpl::VerifyAndStripHMAC(const string& input,
 }
 
 string ObjectStoreImpl::CreateBlobKey(BlobType type, int blob_id) {
+  return base::StringPrintf("%s%d", CreateBlobKeyPrefix(type).c_str(),
+                            blob_id);
+}
+
+string ObjectStoreImpl::CreateBlobKeyPrefix(BlobType type) {
   const char* prefix = NULL;
   switch (type) {
     case kInternal:
@@ -384,7 +404,7 @@ string ObjectStoreImpl::CreateBlobKey(BlobType type, int blob_id) {
     default:
       LOG(FATAL) << "Invalid enum value.";
   }
-  return base::StringPrintf("%s%s%d", prefix, kBlobKeySeparator, blob_id);
+  return base::StringPrintf("%s%s", prefix, kBlobKeySeparator);
 }
 
 bool ObjectStoreImpl::ParseBlobKey(const string& key,
@@ -30,7 +30,8 @@ class ObjectStoreImpl : public ObjectStore {
 
   ~ObjectStoreImpl() override;
 
-  // Initializes the object store with the given database path.
+  // Initializes the object store with the given database path. The
+  // |chaps_metrics| must outlive this object.
   bool Init(const base::FilePath& database_path, ChapsMetrics* chaps_metrics);
 
   // ObjectStore methods.
@@ -68,6 +69,9 @@ class ObjectStoreImpl : public ObjectStore {
   // Creates and returns a unique database key for a blob.
   std::string CreateBlobKey(BlobType type, int blob_id);
 
+  // Returns the prefix shared by the database keys of all the blobs of a type.
+  std::string CreateBlobKeyPrefix(BlobType type);
+
   // Given a valid blob key (as created by CreateBlobKey), determines whether
   // the blob is internal, public, or private and the blob id. Returns true on
   // success.
@@ -120,6 +124,7 @@ class ObjectStoreImpl : public ObjectStore {
   std::unique_ptr<leveldb::DB> db_;
   std::map<int, BlobType> blob_type_map_;
   base::FilePath database_name_;
+  ChapsMetrics* chaps_metrics_ = nullptr;
 
   friend class TestObjectStoreEncryption;
   FRIEND_TEST(TestObjectStoreEncryption, EncryptionInit);
@@ -18,6 +18,7 @@ using base::FilePath;
 using brillo::SecureBlob;
 using std::map;
 using std::string;
+using ::testing::_;
 using ::testing::StrictMock;
 
 namespace chaps {
@@ -148,6 +149,21 @@ TEST(TestObjectStore, InsertLoad) {
   string tmp(32, 'A');
   SecureBlob key(tmp.begin(), tmp.end());
   EXPECT_TRUE(store.SetEncryptionKey(key));
+  const string public_count_histogram =
+      string(kChapsTokenObjectCountHistogramPrefix) + "." +
+      kPublicObjectsSuffix;
+  const string private_count_histogram =
+      string(kChapsTokenObjectCountHistogramPrefix) + "." +
+      kPrivateObjectsSuffix;
+  EXPECT_CALL(mock_metrics_library, SendTimeToUMA(_, _, _, _, _)).Times(4);
+  EXPECT_CALL(mock_metrics_library,
+              SendToUMA(public_count_histogram, 0, _, _, _));
+  EXPECT_CALL(mock_metrics_library,
+              SendToUMA(private_count_histogram, 0, _, _, _));
+  EXPECT_CALL(mock_metrics_library,
+              SendToUMA(public_count_histogram, 2, _, _, _));
+  EXPECT_CALL(mock_metrics_library,
+              SendToUMA(private_count_histogram, 2, _, _, _));
   map<int, ObjectBlob> objects, objects2;
   EXPECT_TRUE(store.LoadPublicObjectBlobs(&objects));
   EXPECT_TRUE(store.LoadPrivateObjectBlobs(&objects2));
@@ -197,6 +213,8 @@ TEST(TestObjectStore, UpdateDelete) {
   string tmp(32, 'A');
   SecureBlob key(tmp.begin(), tmp.end());
   EXPECT_TRUE(store.SetEncryptionKey(key));
+  EXPECT_CALL(mock_metrics_library, SendTimeToUMA(_, _, _, _, _)).Times(3);
+  EXPECT_CALL(mock_metrics_library, SendToUMA(_, _, _, _, _)).Times(3);
   int handle1;
   ObjectBlob blob1 = {"blob1", false};
   EXPECT_TRUE(store.InsertObjectBlob(blob1, &handle1));
@@ -257,6 +275,8 @@ TEST(TestObjectStore, DeleteAll) {
   EXPECT_TRUE(store.InsertObjectBlob(blob2, &handle2));
   EXPECT_TRUE(store.SetInternalBlob(1, "internal"));
   EXPECT_TRUE(store.DeleteAllObjectBlobs());
+  EXPECT_CALL(mock_metrics_library, SendTimeToUMA(_, _, _, _, _)).Times(2);
+  EXPECT_CALL(mock_metrics_library, SendToUMA(_, _, _, _, _)).Times(2);
   map<int, ObjectBlob> objects, objects2;
   EXPECT_TRUE(store.LoadPublicObjectBlobs(&objects));
   EXPECT_TRUE(store.LoadPrivateObjectBlobs(&objects2));
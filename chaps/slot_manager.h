@@ -8,6 +8,7 @@
 #include <map>
 #include <string>
 
+#include <base/synchronization/lock.h>
 #include <brillo/secure_blob.h>
 
 #include "pkcs11/cryptoki.h"
@@ -58,6 +59,13 @@ class SlotManager {
   virtual bool GetSession(const brillo::SecureBlob& isolate_credential,
                           int session_id,
                           Session** session) const = 0;
+  // Gets the slot of the session identified by |session_id|. Returns false if
+  // there is no such session.
+  virtual bool GetSessionSlot(int session_id, int* slot_id) const = 0;
+  // Returns the lock serializing the use of the sessions and the token of the
+  // given slot, or nullptr if there is no such slot. Calls on the sessions of a
+  // slot may be made from several threads, each of them must hold this lock.
+  virtual base::Lock* GetSlotLock(int slot_id) = 0;
 };
 
 }  // namespace chaps
@@ -7,7 +7,6 @@
 #include <string.h>
 
 #include <iterator>
-#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -285,6 +284,7 @@ bool SlotManagerImpl::HwsecIsReady() {
 
 bool SlotManagerImpl::Init() {
   LogTokenReinitializedFromFlagFile();
+  base::AutoLock lock(lock_);
 
   // If the SRK is ready we expect the rest of the init work to succeed.
   bool tpm_available = HwsecIsEnabled();
@@ -323,7 +323,8 @@ bool SlotManagerImpl::InitStage2() {
       if (!LoadTokenInternal(
               IsolateCredentialManager::GetDefaultIsolateCredential(),
               FilePath(kSystemTokenPath), SecureBlob(kSystemTokenAuthData),
-              kSystemTokenLabel, &system_slot_id)) {
+              kSystemTokenLabel, /*unlock_while_loading=*/false,
+              &system_slot_id)) {
         LOG(ERROR) << "Failed to load the system token.";
         return false;
       }
@@ -337,12 +338,19 @@ bool SlotManagerImpl::InitStage2() {
 }
 
 int SlotManagerImpl::GetSlotCount() {
+  base::AutoLock lock(lock_);
   InitStage2();
   return slot_list_.size();
 }
 
 bool SlotManagerImpl::IsTokenAccessible(const SecureBlob& isolate_credential,
                                         int slot_id) const {
+  base::AutoLock lock(lock_);
+  return IsTokenAccessibleLocked(isolate_credential, slot_id);
+}
+
+bool SlotManagerImpl::IsTokenAccessibleLocked(
+    const SecureBlob& isolate_credential, int slot_id) const {
   map<SecureBlob, Isolate>::const_iterator isolate_iter =
       isolate_map_.find(isolate_credential);
   if (isolate_iter == isolate_map_.end()) {
@@ -354,7 +362,8 @@ bool SlotManagerImpl::IsTokenAccessible(const SecureBlob& isolate_credential,
 
 bool SlotManagerImpl::IsTokenPresent(const SecureBlob& isolate_credential,
                                      int slot_id) const {
-  CHECK(IsTokenAccessible(isolate_credential, slot_id));
+  base::AutoLock lock(lock_);
+  CHECK(IsTokenAccessibleLocked(isolate_credential, slot_id));
   return IsTokenPresent(slot_id);
 }
 
@@ -362,8 +371,9 @@ void SlotManagerImpl::GetSlotInfo(const SecureBlob& isolate_credential,
                                   int slot_id,
                                   CK_SLOT_INFO* slot_info) const {
   CHECK(slot_info);
+  base::AutoLock lock(lock_);
   CHECK_LT(static_cast<size_t>(slot_id), slot_list_.size());
-  CHECK(IsTokenAccessible(isolate_credential, slot_id));
+  CHECK(IsTokenAccessibleLocked(isolate_credential, slot_id));
 
   *slot_info = slot_list_[slot_id].slot_info;
 }
@@ -372,8 +382,9 @@ void SlotManagerImpl::GetTokenInfo(const SecureBlob& isolate_credential,
                                    int slot_id,
                                    CK_TOKEN_INFO* token_info) const {
   CHECK(token_info);
+  base::AutoLock lock(lock_);
   CHECK_LT(static_cast<size_t>(slot_id), slot_list_.size());
-  CHECK(IsTokenAccessible(isolate_credential, slot_id));
+  CHECK(IsTokenAccessibleLocked(isolate_credential, slot_id));
   CHECK(IsTokenPresent(slot_id));
 
   *token_info = slot_list_[slot_id].token_info;
@@ -381,8 +392,9 @@ void SlotManagerImpl::GetTokenInfo(const SecureBlob& isolate_credential,
 
 const MechanismMap* SlotManagerImpl::GetMechanismInfo(
     const SecureBlob& isolate_credential, int slot_id) const {
+  base::AutoLock lock(lock_);
   CHECK_LT(static_cast<size_t>(slot_id), slot_list_.size());
-  CHECK(IsTokenAccessible(isolate_credential, slot_id));
+  CHECK(IsTokenAccessibleLocked(isolate_credential, slot_id));
   CHECK(IsTokenPresent(slot_id));
 
   return &mechanism_info_;
@@ -391,8 +403,9 @@ const MechanismMap* SlotManagerImpl::GetMechanismInfo(
 int SlotManagerImpl::OpenSession(const SecureBlob& isolate_credential,
                                  int slot_id,
                                  bool is_read_only) {
+  base::AutoLock lock(lock_);
   CHECK_LT(static_cast<size_t>(slot_id), slot_list_.size());
-  CHECK(IsTokenAccessible(isolate_credential, slot_id));
+  CHECK(IsTokenAccessibleLocked(isolate_credential, slot_id));
   CHECK(IsTokenPresent(slot_id));
 
   shared_ptr<Session> session(factory_->CreateSession(
@@ -407,13 +420,14 @@ int SlotManagerImpl::OpenSession(const SecureBlob& isolate_credential,
 
 bool SlotManagerImpl::CloseSession(const SecureBlob& isolate_credential,
                                    int session_id) {
+  base::AutoLock lock(lock_);
   Session* session = NULL;
-  if (!GetSession(isolate_credential, session_id, &session))
+  if (!GetSessionLocked(isolate_credential, session_id, &session))
     return false;
   CHECK(session);
   int slot_id = session_slot_map_[session_id];
   CHECK_LT(static_cast<size_t>(slot_id), slot_list_.size());
-  CHECK(IsTokenAccessible(isolate_credential, slot_id));
+  CHECK(IsTokenAccessibleLocked(isolate_credential, slot_id));
   session_slot_map_.erase(session_id);
   slot_list_[slot_id].sessions.erase(session_id);
   return true;
@@ -421,8 +435,14 @@ bool SlotManagerImpl::CloseSession(const SecureBlob& isolate_credential,
 
 void SlotManagerImpl::CloseAllSessions(const SecureBlob& isolate_credential,
                                        int slot_id) {
+  base::AutoLock lock(lock_);
+  CloseAllSessionsLocked(isolate_credential, slot_id);
+}
+
+void SlotManagerImpl::CloseAllSessionsLocked(
+    const SecureBlob& isolate_credential, int slot_id) {
   CHECK_LT(static_cast<size_t>(slot_id), slot_list_.size());
-  CHECK(IsTokenAccessible(isolate_credential, slot_id));
+  CHECK(IsTokenAccessibleLocked(isolate_credential, slot_id));
 
   for (map<int, shared_ptr<Session>>::iterator iter =
            slot_list_[slot_id].sessions.begin();
@@ -435,6 +455,13 @@ void SlotManagerImpl::CloseAllSessions(const SecureBlob& isolate_credential,
 bool SlotManagerImpl::GetSession(const SecureBlob& isolate_credential,
                                  int session_id,
                                  Session** session) const {
+  base::AutoLock lock(lock_);
+  return GetSessionLocked(isolate_credential, session_id, session);
+}
+
+bool SlotManagerImpl::GetSessionLocked(const SecureBlob& isolate_credential,
+                                       int session_id,
+                                       Session** session) const {
   CHECK(session);
 
   // Lookup which slot this session belongs to.
@@ -444,7 +471,7 @@ bool SlotManagerImpl::GetSession(const SecureBlob& isolate_credential,
     return false;
   int slot_id = session_slot_iter->second;
   CHECK_LT(static_cast<size_t>(slot_id), slot_list_.size());
-  if (!IsTokenAccessible(isolate_credential, slot_id)) {
+  if (!IsTokenAccessibleLocked(isolate_credential, slot_id)) {
     return false;
   }
 
@@ -457,11 +484,30 @@ bool SlotManagerImpl::GetSession(const SecureBlob& isolate_credential,
   return true;
 }
 
+bool SlotManagerImpl::GetSessionSlot(int session_id, int* slot_id) const {
+  CHECK(slot_id);
+  base::AutoLock lock(lock_);
+  map<int, int>::const_iterator session_slot_iter =
+      session_slot_map_.find(session_id);
+  if (session_slot_iter == session_slot_map_.end())
+    return false;
+  *slot_id = session_slot_iter->second;
+  return true;
+}
+
+base::Lock* SlotManagerImpl::GetSlotLock(int slot_id) {
+  base::AutoLock lock(lock_);
+  if (slot_id < 0 || static_cast<size_t>(slot_id) >= slot_list_.size())
+    return nullptr;
+  return slot_list_[slot_id].lock.get();
+}
+
 bool SlotManagerImpl::OpenIsolate(SecureBlob* isolate_credential,
                                   bool* new_isolate_created) {
   VLOG(1) << "SlotManagerImpl::OpenIsolate enter";
 
   CHECK(new_isolate_created);
+  base::AutoLock lock(lock_);
   if (isolate_map_.find(*isolate_credential) != isolate_map_.end()) {
     VLOG(1) << "Incrementing open count for existing isolate.";
     Isolate& isolate = isolate_map_[*isolate_credential];
@@ -501,6 +547,22 @@ bool SlotManagerImpl::OpenIsolate(SecureBlob* isolate_credential,
 
 void SlotManagerImpl::CloseIsolate(const SecureBlob& isolate_credential) {
   VLOG(1) << "SlotManagerImpl::CloseIsolate enter";
+  // The tokens of the isolate may be unloaded, which requires the locks of
+  // their slots. They are acquired in the order of the slot identifiers.
+  vector<base::Lock*> slot_locks;
+  {
+    base::AutoLock lock(lock_);
+    map<SecureBlob, Isolate>::const_iterator isolate_iter =
+        isolate_map_.find(isolate_credential);
+    if (isolate_iter != isolate_map_.end()) {
+      for (int slot_id : isolate_iter->second.slot_ids)
+        slot_locks.push_back(slot_list_[slot_id].lock.get());
+    }
+  }
+  vector<std::unique_ptr<base::AutoLock>> slot_auto_locks;
+  for (base::Lock* slot_lock : slot_locks)
+    slot_auto_locks.push_back(std::make_unique<base::AutoLock>(*slot_lock));
+  base::AutoLock lock(lock_);
   if (isolate_map_.find(isolate_credential) == isolate_map_.end()) {
     LOG(ERROR) << "Attempted Close isolate with invalid isolate credential";
     return;
@@ -519,18 +581,21 @@ bool SlotManagerImpl::LoadToken(const SecureBlob& isolate_credential,
                                 const SecureBlob& auth_data,
                                 const string& label,
                                 int* slot_id) {
+  base::AutoLock lock(lock_);
   if (!InitStage2()) {
     chaps_metrics_->ReportChapsTokenManagerStatus(
         "LoadToken", TokenManagerStatus::kInitStage2Failed);
     return false;
   }
-  return LoadTokenInternal(isolate_credential, path, auth_data, label, slot_id);
+  return LoadTokenInternal(isolate_credential, path, auth_data, label,
+                           /*unlock_while_loading=*/true, slot_id);
 }
 
 bool SlotManagerImpl::LoadTokenInternal(const SecureBlob& isolate_credential,
                                         const FilePath& path,
                                         const SecureBlob& auth_data,
                                         const string& label,
+                                        bool unlock_while_loading,
                                         int* slot_id) {
   CHECK(slot_id);
   VLOG(1) << "SlotManagerImpl::LoadToken enter";
@@ -558,25 +623,35 @@ bool SlotManagerImpl::LoadTokenInternal(const SecureBlob& isolate_credential,
 
   // Setup the object pool.
   *slot_id = FindEmptySlot();
-  shared_ptr<ObjectPool> object_pool(factory_->CreateObjectPool(
-      this, slot_policy.get(), factory_->CreateObjectStore(path)));
-  CHECK(object_pool.get());
+  shared_ptr<ObjectPool> object_pool;
+  {
+    // Reading the object store and loading the token can be slow, don't block
+    // the calls on the other slots meanwhile. The empty slot stays ours since
+    // the tokens are only loaded and unloaded on the D-Bus thread.
+    std::optional<base::AutoUnlock> unlock;
+    if (unlock_while_loading)
+      unlock.emplace(lock_);
+    object_pool.reset(factory_->CreateObjectPool(
+        this, slot_policy.get(), factory_->CreateObjectStore(path)));
+    CHECK(object_pool.get());
 
-  if (HwsecIsEnabled()) {
-    if (!MigrateTokenIfNeeded(path, auth_data, object_pool)) {
-      // Asynchronously Decrypting (or creating) the root key.
-      // This has the effect that queries for public objects are responsive but
-      // queries for private objects will be waiting for the root key to be
-      // ready.
-      LoadHwsecToken(base::DoNothing(), *slot_id, path, auth_data, object_pool);
-    }
-  } else {
-    // Load a software-only token.
-    LOG(WARNING) << "No HWSec is available. Loading a software-only token.";
-    if (!LoadSoftwareToken(auth_data, object_pool.get())) {
-      chaps_metrics_->ReportChapsTokenManagerStatus(
-          "LoadToken", TokenManagerStatus::kFailedToLoadSoftwareToken);
-      return false;
+    if (HwsecIsEnabled()) {
+      if (!MigrateTokenIfNeeded(path, auth_data, object_pool)) {
+        // Asynchronously Decrypting (or creating) the root key.
+        // This has the effect that queries for public objects are responsive
+        // but queries for private objects will be waiting for the root key to
+        // be ready.
+        LoadHwsecToken(base::DoNothing(), *slot_id, path, auth_data,
+                       object_pool);
+      }
+    } else {
+      // Load a software-only token.
+      LOG(WARNING) << "No HWSec is available. Loading a software-only token.";
+      if (!LoadSoftwareToken(auth_data, object_pool.get())) {
+        chaps_metrics_->ReportChapsTokenManagerStatus(
+            "LoadToken", TokenManagerStatus::kFailedToLoadSoftwareToken);
+        return false;
+      }
     }
   }
 
@@ -916,6 +991,22 @@ bool SlotManagerImpl::IsSharedSlot(const FilePath& path) {
 
 bool SlotManagerImpl::UnloadToken(const SecureBlob& isolate_credential,
                                   const FilePath& path) {
+  // The sessions of the token may be in use, acquire the lock of its slot
+  // before closing them.
+  base::Lock* slot_lock = nullptr;
+  {
+    base::AutoLock lock(lock_);
+    map<FilePath, int>::const_iterator path_iter = path_slot_map_.find(path);
+    if (path_iter != path_slot_map_.end())
+      slot_lock = slot_list_[path_iter->second].lock.get();
+  }
+  base::AutoLockMaybe slot_auto_lock(slot_lock);
+  base::AutoLock lock(lock_);
+  return UnloadTokenLocked(isolate_credential, path);
+}
+
+bool SlotManagerImpl::UnloadTokenLocked(const SecureBlob& isolate_credential,
+                                        const FilePath& path) {
   VLOG(1) << "SlotManagerImpl::UnloadToken";
   if (isolate_map_.find(isolate_credential) == isolate_map_.end()) {
     LOG(WARNING) << "Invalid isolate credential for UnloadToken.";
@@ -934,14 +1025,14 @@ bool SlotManagerImpl::UnloadToken(const SecureBlob& isolate_credential,
     return false;
   }
   int slot_id = path_slot_map_[path];
-  if (!IsTokenAccessible(isolate_credential, slot_id)) {
+  if (!IsTokenAccessibleLocked(isolate_credential, slot_id)) {
     LOG(WARNING) << "Attempted to unload token with invalid isolate credential";
     chaps_metrics_->ReportChapsTokenManagerStatus(
         "UnloadToken", TokenManagerStatus::kInvalidIsolateCredential);
     return false;
   }
 
-  CloseAllSessions(isolate_credential, slot_id);
+  CloseAllSessionsLocked(isolate_credential, slot_id);
   slot_list_[slot_id].token_object_pool.reset();
   slot_list_[slot_id].slot_info.flags &= ~CKF_TOKEN_PRESENT;
   path_slot_map_.erase(path);
@@ -958,7 +1049,8 @@ bool SlotManagerImpl::UnloadToken(const SecureBlob& isolate_credential,
 bool SlotManagerImpl::GetTokenPath(const SecureBlob& isolate_credential,
                                    int slot_id,
                                    FilePath* path) {
-  if (!IsTokenAccessible(isolate_credential, slot_id))
+  base::AutoLock lock(lock_);
+  if (!IsTokenAccessibleLocked(isolate_credential, slot_id))
     return false;
   if (!IsTokenPresent(slot_id))
     return false;
@@ -973,9 +1065,10 @@ bool SlotManagerImpl::IsTokenPresent(int slot_id) const {
 }
 
 int SlotManagerImpl::CreateHandle() {
+  int handle = ++last_handle_;
   // If we use this many handles, we have a problem.
-  CHECK(last_handle_ < std::numeric_limits<int>::max());
-  return ++last_handle_;
+  CHECK_GT(handle, 0);
+  return handle;
 }
 
 void SlotManagerImpl::GetDefaultInfo(CK_SLOT_INFO* slot_info,
@@ -1032,8 +1125,9 @@ void SlotManagerImpl::AddSlots(int num_slots) {
   for (int i = 0; i < num_slots; ++i) {
     Slot slot;
     GetDefaultInfo(&slot.slot_info, &slot.token_info);
+    slot.lock = std::make_unique<base::Lock>();
     LOG(INFO) << "Adding slot: " << slot_list_.size();
-    slot_list_.push_back(slot);
+    slot_list_.push_back(std::move(slot));
   }
 }
 
@@ -1052,7 +1146,7 @@ void SlotManagerImpl::DestroyIsolate(const Isolate& isolate) {
     int slot_id = *isolate.slot_ids.begin();
     FilePath path;
     CHECK(PathFromSlotId(slot_id, &path));
-    UnloadToken(isolate.credential, path);
+    UnloadTokenLocked(isolate.credential, path);
   }
 
   isolate_map_.erase(isolate.credential);
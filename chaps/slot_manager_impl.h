@@ -11,6 +11,7 @@
 #include "chaps/system_shutdown_blocker.h"
 #include "chaps/token_manager_interface.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <optional>
@@ -18,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include <base/synchronization/lock.h>
 #include <libhwsec/frontend/chaps/frontend.h>
 
 #include "chaps/chaps_factory.h"
@@ -35,6 +37,11 @@ class SessionFactory;
 //      ...
 //    }
 //    // Ready for use by SlotManager clients.
+//
+// The SlotManager methods may be called from several threads: the calls on the
+// sessions of a slot are made while holding the lock of that slot, see
+// GetSlotLock(). The TokenManagerInterface methods must be called on the thread
+// which created the SlotManagerImpl.
 class SlotManagerImpl : public SlotManager,
                         public TokenManagerInterface,
                         public HandleGenerator {
@@ -76,6 +83,8 @@ class SlotManagerImpl : public SlotManager,
   bool GetSession(const brillo::SecureBlob& isolate_credential,
                   int session_id,
                   Session** session) const override;
+  bool GetSessionSlot(int session_id, int* slot_id) const override;
+  base::Lock* GetSlotLock(int slot_id) override;
 
   // TokenManagerInterface methods.
   bool OpenIsolate(brillo::SecureBlob* isolate_credential,
@@ -113,6 +122,9 @@ class SlotManagerImpl : public SlotManager,
     // Key: A session identifier.
     // Value: The associated session object.
     std::map<int, std::shared_ptr<Session>> sessions;
+    // Serializes the use of the sessions and of the token object pool. This is
+    // a pointer so the address of the lock is stable when slots are added.
+    std::unique_ptr<base::Lock> lock;
   };
 
   // The HWSec object is enabled or not.
@@ -124,6 +136,18 @@ class SlotManagerImpl : public SlotManager,
   // Internal token presence check without isolate_credential check.
   bool IsTokenPresent(int slot_id) const;
 
+  // Versions of the public methods for callers already holding |lock_|.
+  bool IsTokenAccessibleLocked(const brillo::SecureBlob& isolate_credential,
+                               int slot_id) const;
+  bool GetSessionLocked(const brillo::SecureBlob& isolate_credential,
+                        int session_id,
+                        Session** session) const;
+  void CloseAllSessionsLocked(const brillo::SecureBlob& isolate_credential,
+                              int slot_id);
+  // The lock of the slot of the token needs to be held as well.
+  bool UnloadTokenLocked(const brillo::SecureBlob& isolate_credential,
+                         const base::FilePath& path);
+
   // Provides default PKCS #11 slot and token information. This method fills
   // the given information structures with constant default values formatted to
   // be PKCS #11 compliant.
@@ -154,7 +178,8 @@ class SlotManagerImpl : public SlotManager,
   // Creates a new isolate with the given isolate credential.
   void AddIsolate(const brillo::SecureBlob& isolate_credential);
 
-  // Destroy isolate and unload any tokens in that isolate.
+  // Destroy isolate and unload any tokens in that isolate. The locks of the
+  // slots of the isolate need to be held.
   void DestroyIsolate(const Isolate& isolate);
 
   // Get the path of the token loaded in the given slot.
@@ -171,11 +196,14 @@ class SlotManagerImpl : public SlotManager,
                             const brillo::SecureBlob& auth_data,
                             std::shared_ptr<ObjectPool> object_pool);
 
-  // LoadToken for internal callers.
+  // LoadToken for internal callers. Releases |lock_| while reading the token
+  // if |unlock_while_loading| is true, which must only be the case once
+  // InitStage2 has succeeded.
   bool LoadTokenInternal(const brillo::SecureBlob& isolate_credential,
                          const base::FilePath& path,
                          const brillo::SecureBlob& auth_data,
                          const std::string& label,
+                         bool unlock_while_loading,
                          int* slot_id);
 
   // Loads the root key for a HWSec token.
@@ -241,8 +269,12 @@ class SlotManagerImpl : public SlotManager,
   bool IsSharedSlot(const base::FilePath& path);
 
   ChapsFactory* factory_;
-  int last_handle_;
+  // Handles are created from the threads using the sessions.
+  std::atomic<int> last_handle_;
   MechanismMap mechanism_info_;
+  // Guards the state of the slot manager below. When the lock of a slot is
+  // needed as well, it must be acquired first.
+  mutable base::Lock lock_;
   // Key: A path to a token's storage directory.
   // Value: The identifier of the associated slot.
   std::map<base::FilePath, int> path_slot_map_;
@@ -38,6 +38,8 @@ class SlotManagerMock : public SlotManager {
   MOCK_METHOD2(CloseAllSessions, void(const brillo::SecureBlob&, int));
   MOCK_CONST_METHOD3(GetSession,
                      bool(const brillo::SecureBlob&, int, Session**));
+  MOCK_CONST_METHOD2(GetSessionSlot, bool(int, int*));
+  MOCK_METHOD1(GetSlotLock, base::Lock*(int));
 };
 
 }  // namespace chaps
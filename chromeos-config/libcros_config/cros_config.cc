@@ -39,7 +39,20 @@ bool CrosConfig::GetString(const std::string& path,
     filepath = filepath.Append(part);
   }
   filepath = filepath.Append(property);
-  return base::ReadFileToString(filepath, val_out);
+
+  base::AutoLock lock(cache_lock_);
+  auto it = cache_.find(filepath.value());
+  if (it != cache_.end()) {
+    *val_out = it->second;
+    return true;
+  }
+  // Misses are not kept, since the property may be read before the config is
+  // mounted.
+  if (!base::ReadFileToString(filepath, val_out)) {
+    return false;
+  }
+  cache_.emplace(filepath.value(), *val_out);
+  return true;
 }
 
 }  // namespace brillo
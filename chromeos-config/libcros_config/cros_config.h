@@ -7,9 +7,12 @@
 #ifndef CHROMEOS_CONFIG_LIBCROS_CONFIG_CROS_CONFIG_H_
 #define CHROMEOS_CONFIG_LIBCROS_CONFIG_CROS_CONFIG_H_
 
+#include <map>
 #include <memory>
 #include <string>
 
+#include <base/synchronization/lock.h>
+#include <base/thread_annotations.h>
 #include <brillo/brillo_export.h>
 #include "chromeos-config/libcros_config/cros_config_interface.h"
 
@@ -27,6 +30,12 @@ class BRILLO_EXPORT CrosConfig : public CrosConfigInterface {
   bool GetString(const std::string& path,
                  const std::string& property,
                  std::string* val_out) override;
+
+ private:
+  // The config doesn't change after boot, so the value of each property file
+  // read is kept for later lookups. Keyed by the property file path.
+  base::Lock cache_lock_;
+  std::map<std::string, std::string> cache_ GUARDED_BY(cache_lock_);
 };
 
 }  // namespace brillo
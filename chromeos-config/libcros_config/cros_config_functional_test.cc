@@ -8,6 +8,9 @@
 // Testcase(s):
 //     CrosConfigTest.CheckName -
 //               Verifies cros_config initializes and can read 'Name' property
+//     CrosConfigTest.RepeatedLookups -
+//               Verifies repeated lookups of a property and of a missing one
+//               give the same results as the first ones
 
 #include <string>
 
@@ -23,6 +26,18 @@ TEST_F(CrosConfigTest, CheckName) {
   EXPECT_NE(name, "");
 }
 
+TEST_F(CrosConfigTest, RepeatedLookups) {
+  brillo::CrosConfig cros_config;
+  std::string name;
+  ASSERT_TRUE(cros_config.GetString("/", "name", &name));
+  for (int i = 0; i < 2; ++i) {
+    std::string value;
+    EXPECT_TRUE(cros_config.GetString("/", "name", &value));
+    EXPECT_EQ(value, name);
+    EXPECT_FALSE(cros_config.GetString("/", "missing-test-property", &value));
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include <anomaly_detector/proto_bindings/anomaly_detector.pb.h>
+#include <base/check.h>
 #include <base/logging.h>
 #include <base/rand_util.h>
 #include <base/strings/strcat.h>
@@ -22,6 +23,7 @@
 #include <dbus/message.h>
 #include <metrics/metrics_library.h>
 #include <re2/re2.h>
+#include <re2/set.h>
 
 #include "crash-reporter/util.h"
 
@@ -265,10 +267,39 @@ constexpr LazyRE2 smmu_fault = {R"(Unhandled context fault: fsr=0x)"};
 static constexpr LazyRE2 kernel_lc_suspend_warning = {
     R"((intel_pmc_core.+CPU did not enter SLP_S0!!!))"};
 
+// Returns whether |line| may start any of the reports KernelParser looks for
+// when it is not in the middle of a multi-line one. All the trigger patterns
+// are matched in a single pass over |line|, since most kernel lines match
+// none of them and would otherwise be scanned once per pattern.
+bool MayStartKernelReport(const std::string& line) {
+  static const RE2::Set* const triggers = [] {
+    auto* set = new RE2::Set(RE2::DefaultOptions, RE2::UNANCHORED);
+    for (const std::string& pattern :
+         {RE2::QuoteMeta(cut_here),
+          std::string(kernel_lc_suspend_warning.pattern),
+          std::string(start_ath10k_dump.pattern),
+          std::string(start_iwlwifi_dump.pattern),
+          std::string(smmu_fault.pattern),
+          RE2::QuoteMeta(crash_report_rlimit)}) {
+      CHECK_GE(set->Add(pattern, nullptr), 0) << pattern;
+    }
+    CHECK(set->Compile());
+    return set;
+  }();
+  return triggers->Match(line, nullptr);
+}
+
 KernelParser::KernelParser(bool testonly_send_all)
     : testonly_send_all_(testonly_send_all) {}
 
 MaybeCrashReport KernelParser::ParseLogEntry(const std::string& line) {
+  if (last_line_ == LineType::None &&
+      ath10k_last_line_ == Ath10kLineType::None &&
+      iwlwifi_last_line_ == IwlwifiLineType::None &&
+      !MayStartKernelReport(line)) {
+    return std::nullopt;
+  }
+
   if (last_line_ == LineType::None) {
     if (line.find(cut_here) != std::string::npos)
       last_line_ = LineType::Start;
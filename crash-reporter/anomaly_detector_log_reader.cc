@@ -5,20 +5,26 @@
 #include "crash-reporter/anomaly_detector_log_reader.h"
 #include "crash-reporter/anomaly_detector_text_file_reader.h"
 
+#include <inttypes.h>
+
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
+#include <base/files/important_file_writer.h>
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
+#include <base/strings/string_split.h>
+#include <base/strings/stringprintf.h>
 
 namespace anomaly {
 
 LogReader::LogReader(const base::FilePath& path)
     : log_file_path_(path), log_file_(path) {
   // Go directly to the end of the file.  We don't want to parse the same
-  // anomalies multiple times on reboot/restart.  We might miss some
-  // anomalies, but so be it---it's too hard to keep track reliably of the
-  // last parsed position in the syslog.
+  // anomalies multiple times on reboot/restart.  RestoreCursor brings us back
+  // to the last parsed position instead if it is still valid.
   log_file_.SeekToEnd();
 }
 
@@ -28,8 +34,55 @@ void LogReader::SeekToBegin() {
   log_file_.SeekToBegin();
 }
 
+void LogReader::RestoreCursor(const base::FilePath& cursor_path) {
+  cursor_path_ = cursor_path;
+
+  std::string contents;
+  if (!base::ReadFileToString(cursor_path_, &contents))
+    return;
+
+  // The cursor is saved as "<inode> <offset> <hash>".
+  std::vector<std::string_view> fields = base::SplitStringPiece(
+      contents, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  uint64_t inode;
+  if (fields.size() != 3 || !base::StringToUint64(fields[0], &inode) ||
+      !base::StringToInt64(fields[1], &saved_cursor_.offset) ||
+      !base::StringToUint(fields[2], &saved_cursor_.hash)) {
+    LOG(WARNING) << "Ignoring invalid cursor in " << cursor_path_.value();
+    return;
+  }
+  saved_cursor_.inode = inode;
+
+  if (!log_file_.SeekToCursor(saved_cursor_)) {
+    LOG(INFO) << log_file_path_.value() << " changed since "
+              << cursor_path_.value() << " was saved, skipping to its end";
+  }
+}
+
+void LogReader::SaveCursor() {
+  TextFileReader::Cursor cursor;
+  if (cursor_path_.empty() || !log_file_.GetCursor(&cursor))
+    return;
+
+  if (cursor.inode == saved_cursor_.inode &&
+      cursor.offset == saved_cursor_.offset &&
+      cursor.hash == saved_cursor_.hash)
+    return;
+
+  const std::string contents =
+      base::StringPrintf("%" PRIu64 " %" PRId64 " %u\n",
+                         static_cast<uint64_t>(cursor.inode), cursor.offset,
+                         cursor.hash);
+  if (!base::ImportantFileWriter::WriteFileAtomically(cursor_path_,
+                                                       contents)) {
+    LOG(ERROR) << "Failed to save cursor to " << cursor_path_.value();
+    return;
+  }
+  saved_cursor_ = cursor;
+}
+
 bool LogReader::GetNextEntry(LogEntry* entry) {
-  std::string line;
+  std::string_view line;
   while (log_file_.GetLine(&line)) {
     // ReadLine returns true if the line contains a valid LogEntry.
     if (ReadLine(line, entry))
@@ -38,7 +91,7 @@ bool LogReader::GetNextEntry(LogEntry* entry) {
   return false;
 }
 
-bool AuditReader::ReadLine(const std::string& line, LogEntry* entry) {
+bool AuditReader::ReadLine(std::string_view line, LogEntry* entry) {
   std::string log_time, log_message;
   if (!RE2::FullMatch(line, pattern_, &log_time, &log_message)) {
     return false;
@@ -58,7 +111,7 @@ bool AuditReader::ReadLine(const std::string& line, LogEntry* entry) {
   return true;
 }
 
-bool MessageReader::ReadLine(const std::string& line, LogEntry* entry) {
+bool MessageReader::ReadLine(std::string_view line, LogEntry* entry) {
   std::string log_time, service_name, log_message;
   if (!RE2::FullMatch(line, pattern_, &log_time, &service_name, &log_message)) {
     return false;
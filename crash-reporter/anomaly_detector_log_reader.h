@@ -13,6 +13,7 @@
 #include "crash-reporter/anomaly_detector_text_file_reader.h"
 
 #include <string>
+#include <string_view>
 
 #include <base/files/file_util.h>
 #include <base/time/time.h>
@@ -86,14 +87,26 @@ class LogReader {
   // the output parameter 'entry' if one is found.
   bool GetNextEntry(LogEntry* entry);
 
+  // Resumes reading where a previous LogReader of the same file stopped, as
+  // recorded in |cursor_path| by SaveCursor, if the file was not rotated since.
+  // Subsequent calls to SaveCursor write to |cursor_path|.
+  void RestoreCursor(const base::FilePath& cursor_path);
+
+  // Records the current position to the path given to RestoreCursor, if any.
+  void SaveCursor();
+
  private:
   const base::FilePath log_file_path_;
 
   // TextFileReader is defined in anomaly_detector_text_file_reader.h.
   TextFileReader log_file_;
 
+  // Where the cursor of log_file_ is saved, and its last saved value.
+  base::FilePath cursor_path_;
+  TextFileReader::Cursor saved_cursor_;
+
   // Parses a line from log_file_ to generate LogEntry.
-  virtual bool ReadLine(const std::string& line, LogEntry* entry) = 0;
+  virtual bool ReadLine(std::string_view line, LogEntry* entry) = 0;
 
   // Moves the position of log_file_ to the beginning.
   // Only used for testing.
@@ -115,7 +128,7 @@ class AuditReader : public LogReader {
   const RE2 pattern_;
 
  private:
-  bool ReadLine(const std::string& line, LogEntry* entry) override;
+  bool ReadLine(std::string_view line, LogEntry* entry) override;
 };
 
 // MessageReader specialises in parsing syslog formatted logs in
@@ -130,7 +143,7 @@ class MessageReader : public LogReader {
   const RE2 pattern_;
 
  private:
-  bool ReadLine(const std::string& line, LogEntry* entry) override;
+  bool ReadLine(std::string_view line, LogEntry* entry) override;
 };
 
 }  // namespace anomaly
@@ -10,6 +10,8 @@
 #include <vector>
 
 #include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
 #include <gtest/gtest.h>
 #include <re2/re2.h>
 
@@ -134,4 +136,32 @@ TEST(AnomalyDetectorLogReaderTest, UpstartMessageReaderTest) {
   ReaderTest(mr, want);
 }
 
+// A restarted LogReader resumes reading where the previous one stopped.
+TEST(AnomalyDetectorLogReaderTest, RestoreCursorTest) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath log_path = temp_dir.GetPath().Append("messages");
+  const base::FilePath cursor_path = temp_dir.GetPath().Append("cursor");
+  ASSERT_TRUE(base::WriteFile(
+      log_path, "2020-05-10T22:45:04.419261Z ERR tpm_managerd[790]: old\n"));
+
+  auto mr = std::make_unique<MessageReader>(log_path, kMessageLogPattern);
+  mr->RestoreCursor(cursor_path);
+  ASSERT_TRUE(base::AppendToFile(
+      log_path, "2020-05-10T22:45:05.419261Z ERR tpm_managerd[790]: seen\n"));
+  LogEntry entry;
+  ASSERT_TRUE(mr->GetNextEntry(&entry));
+  EXPECT_EQ(entry.message, "seen");
+  mr->SaveCursor();
+  mr.reset();
+
+  ASSERT_TRUE(base::AppendToFile(
+      log_path, "2020-05-10T22:45:06.419261Z ERR tpm_managerd[790]: new\n"));
+  mr = std::make_unique<MessageReader>(log_path, kMessageLogPattern);
+  mr->RestoreCursor(cursor_path);
+  ASSERT_TRUE(mr->GetNextEntry(&entry));
+  EXPECT_EQ(entry.message, "new");
+  EXPECT_FALSE(mr->GetNextEntry(&entry));
+}
+
 }  // namespace anomaly
@@ -59,6 +59,14 @@ std::unique_ptr<dbus::Signal> MakeOomSignal(const int64_t oom_timestamp_ms) {
   return signal;
 }
 
+// Returns where the cursor of the reader of |log_path| is saved. It is in /run
+// so that it doesn't carry over reboots.
+base::FilePath GetCursorPath(const base::FilePath& log_path) {
+  return base::FilePath(paths::kSystemRunStateDirectory)
+      .Append(base::StrCat(
+          {paths::kAnomalyDetectorCursorPrefix, log_path.BaseName().value()}));
+}
+
 }  // namespace
 
 // Time between calls to Parser::PeriodicUpdate.
@@ -96,12 +104,20 @@ Service::Service(base::OnceClosure shutdown_callback, bool testonly_send_all)
   // GetNextEntry method call. After multiple attempts however LogReader will
   // give up and logs the error. Note that some boards do not have SELinux and
   // thus no audit.log.
+  //
+  // The readers resume where the previous instance stopped if
+  // anomaly_detector was restarted, instead of skipping what was logged in
+  // between.
   log_readers_.push_back(std::make_unique<anomaly::AuditReader>(
       kAuditLogPath, anomaly::kAuditLogPattern));
+  log_readers_.back()->RestoreCursor(GetCursorPath(kAuditLogPath));
+  const base::FilePath message_log_path(paths::kMessageLogPath);
   log_readers_.push_back(std::make_unique<anomaly::MessageReader>(
-      base::FilePath(paths::kMessageLogPath), anomaly::kMessageLogPattern));
+      message_log_path, anomaly::kMessageLogPattern));
+  log_readers_.back()->RestoreCursor(GetCursorPath(message_log_path));
   log_readers_.push_back(std::make_unique<anomaly::MessageReader>(
       kUpstartLogPath, anomaly::kUpstartLogPattern));
+  log_readers_.back()->RestoreCursor(GetCursorPath(kUpstartLogPath));
 }
 
 bool Service::Init() {
@@ -188,6 +204,7 @@ void Service::ReadLogs() {
             MakeOomSignal(static_cast<int>(entry.timestamp.ToDoubleT() * 1000))
                 .get());
     }
+    reader->SaveCursor();
   }
 }
 
@@ -383,6 +383,19 @@ TEST(AnomalyDetectorTest, KernelSMMU_FAULT) {
   ParserTest("TEST_SMMU_FAULT", {smmu_error}, &parser);
 }
 
+TEST(AnomalyDetectorTest, KernelUnrelatedLinesIgnored) {
+  KernelParser parser(true);
+  auto crash_reports = ParseLogMessages(
+      &parser,
+      {"[   73.001234] usb 1-1: new high-speed USB device number 2",
+       "[   73.004321] EXT4-fs (dm-1): mounted filesystem with ordered data",
+       "[   74.047205] arm-smmu 15000000.iommu: Unhandled context fault: "
+       "fsr=0x402"});
+  ASSERT_EQ(1u, crash_reports.size());
+  EXPECT_EQ(std::vector<std::string>{"--kernel_smmu_fault"},
+            crash_reports[0].flags);
+}
+
 TEST(AnomalyDetectorTest, KernelWarning) {
   ParserRun second{
       .find_this = "ttm_bo_vm.c",
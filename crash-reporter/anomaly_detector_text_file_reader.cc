@@ -5,14 +5,18 @@
 #include "crash-reporter/anomaly_detector_text_file_reader.h"
 
 #include <stdio.h>
+#include <string.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <sys/stat.h>
 
 #include <base/check_op.h>
+#include <base/hash/hash.h>
 #include <base/logging.h>
 
 namespace anomaly {
@@ -25,26 +29,46 @@ TextFileReader::TextFileReader(const base::FilePath& path)
 TextFileReader::~TextFileReader() {}
 
 bool TextFileReader::GetLine(std::string* line) {
+  std::string_view view;
+  if (!GetLine(&view))
+    return false;
+
+  line->assign(view);
+  return true;
+}
+
+bool TextFileReader::GetLine(std::string_view* line) {
   if (!file_.IsValid() && !Open())
     return false;
 
   bool end_of_file = false;
   while (!end_of_file) {
-    for (; pos_ < end_pos_; pos_++) {
-      if (buf_[pos_] == '\n') {
-        if (skip_next_) {
-          skip_next_ = false;
-          line_fragment_.clear();
-          continue;
-        }
-
-        pos_++;
-        *line = std::string(line_fragment_.begin(), line_fragment_.end());
+    while (pos_ < end_pos_) {
+      const char* begin = buf_.data() + pos_;
+      const char* newline =
+          static_cast<const char*>(memchr(begin, '\n', end_pos_ - pos_));
+      if (!newline) {
+        line_fragment_.append(begin, end_pos_ - pos_);
+        pos_ = end_pos_;
+        break;
+      }
+
+      pos_ += newline - begin + 1;
+      if (skip_next_) {
+        skip_next_ = false;
         line_fragment_.clear();
-        return true;
+        continue;
       }
 
-      line_fragment_.push_back(buf_[pos_]);
+      if (line_fragment_.empty()) {
+        *line = std::string_view(begin, newline - begin);
+      } else {
+        line_fragment_.append(begin, newline - begin);
+        line_.swap(line_fragment_);
+        line_fragment_.clear();
+        *line = line_;
+      }
+      return true;
     }
 
     end_of_file = true;
@@ -56,6 +80,44 @@ bool TextFileReader::GetLine(std::string* line) {
   return false;
 }
 
+bool TextFileReader::GetCursor(Cursor* cursor) {
+  if (!file_.IsValid() || skip_next_)
+    return false;
+
+  cursor->inode = inode_number_;
+  cursor->offset =
+      buf_offset_ + pos_ - static_cast<int64_t>(line_fragment_.size());
+  return HashBefore(cursor->offset, &cursor->hash);
+}
+
+bool TextFileReader::SeekToCursor(const Cursor& cursor) {
+  if (!file_.IsValid() || cursor.inode != inode_number_ ||
+      cursor.offset < 0 || cursor.offset > file_.GetLength())
+    return false;
+
+  uint32_t hash;
+  if (!HashBefore(cursor.offset, &hash) || hash != cursor.hash)
+    return false;
+
+  if (file_.Seek(base::File::FROM_BEGIN, cursor.offset) < 0)
+    return false;
+
+  skip_next_ = false;
+  Clear();
+  buf_offset_ = cursor.offset;
+  return true;
+}
+
+bool TextFileReader::HashBefore(int64_t offset, uint32_t* hash) {
+  const int size = std::min<int64_t>(offset, kCursorHashSize_);
+  char data[kCursorHashSize_];
+  if (file_.Read(offset - size, data, size) != size)
+    return false;
+
+  *hash = base::PersistentHash(std::string_view(data, size));
+  return true;
+}
+
 bool TextFileReader::Open() {
   if (kMaxOpenRetries_ == open_tries_) {
     // Simply return false if the number of retries have reached the limit.
@@ -85,10 +147,12 @@ bool TextFileReader::Open() {
   CHECK_GE(fstat(file_.GetPlatformFile(), &st), 0);
   inode_number_ = st.st_ino;
   Clear();
+  buf_offset_ = 0;
   return true;
 }
 
 bool TextFileReader::LoadToBuffer() {
+  buf_offset_ += end_pos_;
   pos_ = 0;
   end_pos_ = 0;
 
@@ -131,7 +195,7 @@ void TextFileReader::SeekToEnd() {
 
   skip_next_ = true;
   Clear();
-  file_.Seek(base::File::FROM_END, -1);
+  buf_offset_ = std::max<int64_t>(file_.Seek(base::File::FROM_END, -1), 0);
 }
 
 void TextFileReader::SeekToBegin() {
@@ -140,6 +204,7 @@ void TextFileReader::SeekToBegin() {
 
   skip_next_ = false;
   Clear();
+  buf_offset_ = 0;
   file_.Seek(base::File::FROM_BEGIN, 0);
 }
 
@@ -9,6 +9,12 @@
 // the characters read so far in line_fragment_ and waits for '\n'. This
 // behaviour is useful when read and write is happening concurrently.
 //
+// The file is read in blocks of kBufferSize_ bytes and lines are returned as
+// views into the buffer whenever they don't straddle two reads.
+//
+// The read position can be saved as a Cursor and restored later, e.g. by a
+// new process, as long as the file was not rotated or rewritten in between.
+//
 // If underlying base::File file_ is invalid, TextFileReader tries to reopen the
 // file every time GetLine is called until it reaches kMaxOpenRetries_. Once the
 // limit is reached, it will simply return false on GetLine().
@@ -16,7 +22,11 @@
 #ifndef CRASH_REPORTER_ANOMALY_DETECTOR_TEXT_FILE_READER_H_
 #define CRASH_REPORTER_ANOMALY_DETECTOR_TEXT_FILE_READER_H_
 
+#include <sys/types.h>
+
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <base/files/file.h>
@@ -35,6 +45,29 @@ class TextFileReader {
   // file_path_ has been replaced by a new file and if so updates file_ to point
   // to the new file.
   bool GetLine(std::string* line);
+  // Same as above, but |line| points into the internal buffers of the reader
+  // and is only valid until the next call.
+  bool GetLine(std::string_view* line);
+
+  // Position right after the last line returned by GetLine.
+  struct Cursor {
+    // The inode number of the file.
+    ino_t inode = 0;
+    // Offset of the position in the file.
+    int64_t offset = 0;
+    // Hash of the up to kCursorHashSize_ bytes preceding |offset|, to detect
+    // files that were truncated and rewritten in place.
+    uint32_t hash = 0;
+  };
+
+  // Returns the current cursor in |cursor|. Returns false if there is no
+  // valid position yet, e.g. while skipping the partial line after SeekToEnd.
+  bool GetCursor(Cursor* cursor);
+
+  // Moves the position of read to |cursor| and returns true if it still
+  // matches the content of the open file. Otherwise leaves the position
+  // unchanged and returns false.
+  bool SeekToCursor(const Cursor& cursor);
 
   // Sets the position of read to -1 from the end of file and sets skip_next_ to
   // true. This results in GetLine discarding all characters from just before
@@ -64,15 +97,24 @@ class TextFileReader {
   // inode number stored. It uses stat(2) system call.
   bool CheckForNewFile();
 
+  // Computes the hash of the bytes of file_ preceding |offset| for Cursor.
+  bool HashBefore(int64_t offset, uint32_t* hash);
+
   const base::FilePath file_path_;
   base::File file_;
-  static constexpr int kBufferSize_ = 1024;
+  static constexpr int kBufferSize_ = 64 * 1024;
+  static constexpr int kCursorHashSize_ = 256;
   std::vector<char> buf_;
-  std::vector<char> line_fragment_;
+  // Beginning of a line that continues past the end of buf_.
+  std::string line_fragment_;
+  // Holds the last line returned by GetLine if it was built from a fragment.
+  std::string line_;
   // Current position of read within buf_.
   int pos_ = 0;
   // The end position of the used part of the buf_.
   int end_pos_ = 0;
+  // Offset in file_ of the beginning of buf_.
+  int64_t buf_offset_ = 0;
   // The inode number of the file_.
   ino_t inode_number_;
   // If true, skip the next line. This is set to true if SeekToEnd was called to
@@ -93,6 +135,7 @@ class TextFileReader {
   FRIEND_TEST(AnomalyDetectorFileReaderConcurrentTest,
               OpenFileRetryExceededTest);
   FRIEND_TEST(AnomalyDetectorFileReaderConcurrentTest, HandleFileMoveTest);
+  FRIEND_TEST(AnomalyDetectorFileReaderConcurrentTest, SeekToCursorTest);
 };
 
 }  // namespace anomaly
@@ -274,4 +274,30 @@ TEST_F(AnomalyDetectorFileReaderConcurrentTest, HandleFileMoveTest) {
   ReaderTest(r, want);
 }
 
+// A cursor taken by a reader lets a new reader resume exactly where the first
+// one stopped, unless the file was rewritten in between.
+TEST_F(AnomalyDetectorFileReaderConcurrentTest, SeekToCursorTest) {
+  AppendToFile({"line 1", "line 2"});
+
+  auto r = std::make_unique<TextFileReader>(path_);
+  ReaderTest(r, {"line 1", "line 2"});
+  TextFileReader::Cursor cursor;
+  ASSERT_TRUE(r->GetCursor(&cursor));
+  EXPECT_EQ(cursor.offset, 14);
+
+  AppendToFile({"line 3"});
+  auto resumed = std::make_unique<TextFileReader>(path_);
+  resumed->SeekToEnd();
+  EXPECT_TRUE(resumed->SeekToCursor(cursor));
+  ReaderTest(resumed, {"line 3"});
+
+  // Rewrite the file in place with content of the same size.
+  file_.SetLength(0);
+  AppendToFile({"LINE 1", "LINE 2", "LINE 3"});
+  auto rewritten = std::make_unique<TextFileReader>(path_);
+  rewritten->SeekToEnd();
+  EXPECT_FALSE(rewritten->SeekToCursor(cursor));
+  ReaderTest(rewritten, {});
+}
+
 }  // namespace anomaly
@@ -8,6 +8,7 @@
 #include <fcntl.h>  // For file creation modes.
 #include <inttypes.h>
 #include <linux/limits.h>  // PATH_MAX
+#include <signal.h>        // For kill.
 #include <sys/mman.h>      // for memfd_create
 #include <sys/types.h>     // for mode_t and gid_t.
 #include <sys/utsname.h>   // For uname.
@@ -16,8 +17,10 @@
 
 #include <ctime>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -26,8 +29,10 @@
 #include <base/files/file_enumerator.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
+#include <base/files/important_file_writer.h>
 #include <base/files/scoped_file.h>
 #include <base/functional/bind.h>
+#include <base/hash/hash.h>
 #include <base/logging.h>
 #include <base/memory/ref_counted.h>
 #include <base/memory/scoped_refptr.h>
@@ -43,6 +48,8 @@
 #include <base/strings/string_util.h>
 #include <base/strings/stringprintf.h>
 #include <base/task/single_thread_task_runner.h>
+#include <base/threading/platform_thread.h>
+#include <base/time/time.h>
 #include <brillo/dbus/data_serialization.h>
 #include <brillo/key_value_store.h>
 #include <brillo/process/process.h>
@@ -151,6 +158,125 @@ constexpr size_t kMaxParentProcessLogs = 8;
 
 const char kCollectionErrorSignature[] = "crash_reporter-user-collection";
 
+// Log commands run by GetMultipleLogContents are killed after this long.
+constexpr base::TimeDelta kLogCommandTimeout = base::Seconds(30);
+
+// Log commands taking longer than this are logged, to find slow entries of
+// crash_reporter_logs.conf.
+constexpr base::TimeDelta kSlowLogCommandTime = base::Seconds(5);
+
+// Outputs of log commands are reused by the collectors running the same command
+// within this long, e.g. for the several reports of one kernel event.
+constexpr base::TimeDelta kLogCacheMaxAge = base::Seconds(10);
+
+constexpr char kLogCollectionTimeHistogram[] =
+    "Crash.Collector.LogCollectionTime";
+
+FilePath GetLogCachePath(const std::string& command) {
+  return paths::GetAt(paths::kSystemRunStateDirectory,
+                      paths::kLogCacheDirectory)
+      .Append(StringPrintf("%08" PRIx32, base::PersistentHash(command)));
+}
+
+// Cache entries hold the command, a NUL character and the output of the
+// command.
+bool ReadCachedLogOutput(const std::string& command,
+                         size_t max_size,
+                         std::string* output) {
+  const FilePath path = GetLogCachePath(command);
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info))
+    return false;
+  const base::TimeDelta age = base::Time::Now() - info.last_modified;
+  if (age.is_negative() || age >= kLogCacheMaxAge)
+    return false;
+
+  std::string contents;
+  if (!base::ReadFileToStringWithMaxSize(path, &contents,
+                                         command.size() + 1 + max_size))
+    return false;
+  if (contents.size() <= command.size() ||
+      contents.compare(0, command.size(), command) != 0 ||
+      contents[command.size()] != '\0')
+    return false;
+
+  output->assign(contents, command.size() + 1);
+  return true;
+}
+
+void WriteCachedLogOutput(const std::string& command,
+                          const std::string& output) {
+  const FilePath path = GetLogCachePath(command);
+  // The outputs are not redacted yet, so keep them private.
+  if (!base::CreateDirectory(path.DirName()) ||
+      !base::SetPosixFilePermissions(path.DirName(), 0700))
+    return;
+  if (!base::ImportantFileWriter::WriteFileAtomically(
+          path, base::StrCat({command, std::string(1, '\0'), output}))) {
+    LOG(WARNING) << "Failed to cache log output to " << path.value();
+  }
+}
+
+struct LogCommand {
+  std::string exec_name;
+  std::string command;
+  FilePath raw_output_file;
+  std::unique_ptr<brillo::ProcessImpl> process;
+  base::TimeTicks start_time;
+  int result = 0;
+  bool timed_out = false;
+  // Set if the output was found in the cache.
+  std::optional<std::string> cached_output;
+};
+
+// Waits for the processes of |commands| to exit, sets their |result|, and
+// kills those still running after kLogCommandTimeout.
+void WaitForLogCommands(std::vector<LogCommand>& commands) {
+  const base::TimeTicks deadline = base::TimeTicks::Now() + kLogCommandTimeout;
+  size_t running = base::ranges::count_if(
+      commands, [](const LogCommand& c) { return c.process != nullptr; });
+  while (running > 0) {
+    const bool past_deadline = base::TimeTicks::Now() >= deadline;
+    for (LogCommand& command : commands) {
+      if (!command.process)
+        continue;
+
+      const pid_t pid = command.process->pid();
+      if (past_deadline) {
+        // The command runs in its own process group; kill all of it.
+        kill(-pid, SIGKILL);
+        command.timed_out = true;
+      }
+      int status;
+      const pid_t ret =
+          HANDLE_EINTR(waitpid(pid, &status, past_deadline ? 0 : WNOHANG));
+      if (ret == 0)
+        continue;
+
+      if (ret < 0) {
+        PLOG(WARNING) << "waitpid failed for log command";
+        command.result = -1;
+      } else if (WIFEXITED(status)) {
+        command.result = WEXITSTATUS(status);
+      } else {
+        command.result = -1;
+      }
+      command.process->Release();
+      command.process.reset();
+      --running;
+
+      const base::TimeDelta duration =
+          base::TimeTicks::Now() - command.start_time;
+      if (duration >= kSlowLogCommandTime) {
+        LOG(WARNING) << "Log command for '" << command.exec_name << "' took "
+                     << duration.InSecondsF() << "s";
+      }
+    }
+    if (running > 0 && !past_deadline)
+      base::PlatformThread::Sleep(base::Milliseconds(10));
+  }
+}
+
 #if USE_ARCPP
 constexpr char kARCStatus[] = "Built with ARC++";
 #elif USE_ARCVM
@@ -1241,6 +1367,71 @@ bool CrashCollector::CheckHasCapacity(const FilePath& crash_directory) {
   return CheckHasCapacity(crash_directory, crash_directory.value());
 }
 
+bool CrashCollector::DeduplicateCrash(const std::string& exec_name,
+                                      const std::string& signature,
+                                      int weight,
+                                      int* skipped_weight) {
+  is_recent_duplicate_ = false;
+  if (skipped_weight)
+    *skipped_weight = 0;
+  // Integration tests expect every crash they trigger to be collected in full.
+  if (util::IsCrashTestInProgress())
+    return false;
+
+  const FilePath signatures_dir = paths::GetAt(
+      paths::kSystemRunStateDirectory, paths::kRecentCrashSignaturesDirectory);
+  if (!base::CreateDirectory(signatures_dir)) {
+    PLOG(WARNING) << "Failed to create " << signatures_dir.value();
+    return false;
+  }
+  const uint32_t hash =
+      base::PersistentHash(base::StrCat({exec_name, "\n", signature}));
+  const FilePath entry_path =
+      signatures_dir.Append(StringPrintf("%08" PRIx32, hash));
+
+  // The entry holds the time of the last crash collected in full and the
+  // number of repeats seen since.
+  int64_t collected_time_t = 0;
+  int repeats = 0;
+  std::string contents;
+  if (base::ReadFileToStringWithMaxSize(entry_path, &contents, 64)) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        contents, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.size() != 2 ||
+        !base::StringToInt64(fields[0], &collected_time_t) ||
+        !base::StringToInt(fields[1], &repeats)) {
+      LOG(WARNING) << "Ignoring invalid entry " << entry_path.value();
+      collected_time_t = 0;
+      repeats = 0;
+    }
+  }
+
+  const base::Time now = test_clock_ ? test_clock_->Now() : base::Time::Now();
+  const base::Time collected_time = base::Time::FromTimeT(collected_time_t);
+  if (collected_time_t > 0 && collected_time <= now &&
+      now - collected_time < kDuplicateCrashWindow) {
+    is_recent_duplicate_ = true;
+    repeats += weight;
+    AddCrashMetaUploadData("logs_skipped_as_duplicate", "true");
+  } else {
+    if (repeats > 0) {
+      AddCrashMetaUploadData("skipped_duplicates",
+                             base::NumberToString(repeats));
+      if (skipped_weight)
+        *skipped_weight = repeats;
+    }
+    collected_time_t = now.ToTimeT();
+    repeats = 0;
+  }
+
+  if (!base::ImportantFileWriter::WriteFileAtomically(
+          entry_path,
+          StringPrintf("%" PRId64 " %d\n", collected_time_t, repeats))) {
+    LOG(WARNING) << "Failed to write " << entry_path.value();
+  }
+  return is_recent_duplicate_;
+}
+
 bool CrashCollector::GetLogContents(const FilePath& config_path,
                                     const std::string& exec_name,
                                     const FilePath& output_file) {
@@ -1251,6 +1442,11 @@ bool CrashCollector::GetMultipleLogContents(
     const FilePath& config_path,
     const std::vector<std::string>& exec_names,
     const FilePath& output_file) {
+  if (is_recent_duplicate_) {
+    LOG(INFO) << "Not collecting logs for a repeated crash";
+    return false;
+  }
+
   brillo::KeyValueStore store;
   if (!store.Load(config_path)) {
     LOG(WARNING) << "Unable to read log configuration file "
@@ -1258,31 +1454,60 @@ bool CrashCollector::GetMultipleLogContents(
     return false;
   }
 
-  std::string collated_log_contents;
-  for (auto exec_name : exec_names) {
-    std::string command;
-    if (!store.GetString(exec_name, &command)) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
+  // Start all the commands at once, since some of them spend most of their
+  // time waiting, e.g. on the journal.
+  std::vector<LogCommand> commands;
+  for (const auto& exec_name : exec_names) {
+    LogCommand command{.exec_name = exec_name};
+    if (!store.GetString(exec_name, &command.command)) {
       LOG(WARNING) << "exec name '" << exec_name << "' not found in log file";
       continue;
     }
 
-    FilePath raw_output_file;
-    if (!base::CreateTemporaryFile(&raw_output_file)) {
+    std::string cached_output;
+    if (ReadCachedLogOutput(command.command, max_log_size_, &cached_output)) {
+      command.cached_output = std::move(cached_output);
+      commands.push_back(std::move(command));
+      continue;
+    }
+
+    if (!base::CreateTemporaryFile(&command.raw_output_file)) {
       PLOG(WARNING) << "Failed to create temporary file for raw log output.";
       continue;
     }
 
-    brillo::ProcessImpl diag_process;
-    diag_process.AddArg(kShellPath);
-    diag_process.AddStringOption("-c", command);
-    diag_process.RedirectOutput(raw_output_file.value());
+    command.process = std::make_unique<brillo::ProcessImpl>();
+    command.process->AddArg(kShellPath);
+    command.process->AddStringOption("-c", command.command);
+    command.process->RedirectOutput(command.raw_output_file.value());
+    // Use a new process group so that the whole pipeline of the command can be
+    // killed on timeout.
+    command.process->SetPgid(0);
+    command.start_time = base::TimeTicks::Now();
+    if (!command.process->Start()) {
+      LOG(WARNING) << "Failed to start log command for '" << exec_name << "'";
+      command.process.reset();
+      command.result = -1;
+    }
+    commands.push_back(std::move(command));
+  }
 
-    const int result = diag_process.Run();
+  WaitForLogCommands(commands);
 
+  std::string collated_log_contents;
+  for (LogCommand& command : commands) {
     std::string log_contents;
+    if (command.cached_output) {
+      log_contents = std::move(*command.cached_output);
+      collated_log_contents.append(log_contents);
+      continue;
+    }
+
     const bool fully_read = base::ReadFileToStringWithMaxSize(
-        raw_output_file, &log_contents, max_log_size_);
-    base::DeleteFile(raw_output_file);
+        command.raw_output_file, &log_contents, max_log_size_);
+    base::DeleteFile(command.raw_output_file);
 
     if (!fully_read) {
       if (log_contents.empty()) {
@@ -1294,14 +1519,23 @@ bool CrashCollector::GetMultipleLogContents(
       LOG(WARNING) << "Log is larger than " << max_log_size_
                    << " bytes. Truncating.";
       log_contents.append("\n<TRUNCATED>\n");
+    } else if (command.result == 0 && !command.timed_out) {
+      WriteCachedLogOutput(command.command, log_contents);
     }
 
     // If the registered command failed, we include any (partial) output it
     // might have produced to improve crash reports.  But make a note of the
     // failure.
-    if (result != 0) {
-      const std::string warning = StringPrintf(
-          "\nLog command \"%s\" exited with %i\n", command.c_str(), result);
+    if (command.timed_out) {
+      const std::string warning =
+          StringPrintf("\nLog command \"%s\" timed out after %" PRId64 "s\n",
+                       command.command.c_str(), kLogCommandTimeout.InSeconds());
+      log_contents.append(warning);
+      LOG(WARNING) << warning;
+    } else if (command.result != 0) {
+      const std::string warning =
+          StringPrintf("\nLog command \"%s\" exited with %i\n",
+                       command.command.c_str(), command.result);
       log_contents.append(warning);
       LOG(WARNING) << warning;
     }
@@ -1309,6 +1543,11 @@ bool CrashCollector::GetMultipleLogContents(
     collated_log_contents.append(log_contents);
   }
 
+  metrics_lib_->data->SendTimeToUMA(
+      kLogCollectionTimeHistogram, base::TimeTicks::Now() - start_time,
+      base::Milliseconds(1), kLogCommandTimeout + base::Seconds(1),
+      /*num_buckets=*/50);
+
   if (collated_log_contents.empty())
     return false;
 
@@ -270,6 +270,7 @@ class CrashCollector {
   FRIEND_TEST(CrashCollectorTest, GetCrashPath);
   FRIEND_TEST(CrashCollectorTest, GetLogContents);
   FRIEND_TEST(CrashCollectorTest, GetMultipleLogContents);
+  FRIEND_TEST(CrashCollectorTest, DeduplicateCrash);
   FRIEND_TEST(CrashCollectorTest, GetProcessTree);
   FRIEND_TEST(CrashCollectorTest, GetProcessPath);
   FRIEND_TEST(CrashCollectorTest, GetUptime);
@@ -486,6 +487,23 @@ class CrashCollector {
                               const std::vector<std::string>& exec_names,
                               const base::FilePath& output_file);
 
+  // Crashes with the same exec name and signature as a crash collected less
+  // than this long ago are considered repeats by DeduplicateCrash.
+  static constexpr base::TimeDelta kDuplicateCrashWindow = base::Minutes(10);
+
+  // Checks whether a crash with the same |exec_name| and |signature|, e.g. the
+  // stack or warning signature, was collected in the last
+  // kDuplicateCrashWindow, and records this crash otherwise. Returns true for
+  // such repeats, in which case GetLogContents and GetMultipleLogContents
+  // don't run the log commands, so that crash loops don't keep the device busy
+  // collecting the same logs. The next crash collected in full reports how
+  // many repeats were seen, each repeat counting for its |weight|, and sets
+  // |skipped_weight| (if not null) to that count.
+  bool DeduplicateCrash(const std::string& exec_name,
+                        const std::string& signature,
+                        int weight = 1,
+                        int* skipped_weight = nullptr);
+
   // Write details about the process tree of |pid| to |output_file|.
   bool GetProcessTree(pid_t pid, const base::FilePath& output_file);
 
@@ -549,6 +567,8 @@ class CrashCollector {
   bool ShouldHandleChromeCrashes();
 
   std::string extra_metadata_;
+  // Set by DeduplicateCrash if the crash repeats a recently collected one.
+  bool is_recent_duplicate_ = false;
   const std::string collector_name_;
   base::FilePath forced_crash_directory_;
   base::FilePath lsb_release_;
@@ -52,6 +52,7 @@ using base::StringPrintf;
 using brillo::FindLog;
 using ::testing::_;
 using ::testing::Eq;
+using ::testing::HasSubstr;
 using ::testing::Invoke;
 using ::testing::IsEmpty;
 using ::testing::Optional;
@@ -2172,6 +2173,41 @@ TEST_F(CrashCollectorTest, GetLogContents) {
   EXPECT_EQ("hello world\n", contents);
 }
 
+TEST_F(CrashCollectorTest, DeduplicateCrash) {
+  auto test_clock = std::make_unique<base::SimpleTestClock>();
+  base::SimpleTestClock* clock = test_clock.get();
+  clock->SetNow(base::Time::UnixEpoch() + base::Days(10000));
+  collector_.set_test_clock(std::move(test_clock));
+  FilePath config_file = test_dir_.Append("crash_config");
+  ASSERT_TRUE(test_util::CreateFile(config_file, "foobar=echo hello"));
+
+  EXPECT_FALSE(collector_.DeduplicateCrash("foobar", "sig"));
+  EXPECT_TRUE(collector_.GetLogContents(config_file, "foobar",
+                                        test_dir_.Append("log1")));
+
+  // The same crash a minute later is a repeat and skips the log commands.
+  clock->Advance(base::Minutes(1));
+  EXPECT_TRUE(collector_.DeduplicateCrash("foobar", "sig"));
+  EXPECT_FALSE(collector_.GetLogContents(config_file, "foobar",
+                                         test_dir_.Append("log2")));
+  EXPECT_FALSE(base::PathExists(test_dir_.Append("log2")));
+  EXPECT_THAT(collector_.extra_metadata_,
+              HasSubstr("upload_var_logs_skipped_as_duplicate=true"));
+
+  // Other signatures are not repeats.
+  EXPECT_FALSE(collector_.DeduplicateCrash("foobar", "other sig"));
+  EXPECT_FALSE(collector_.DeduplicateCrash("barfoo", "sig"));
+
+  // Past the window, the crash is collected in full again and reports the
+  // repeats.
+  clock->Advance(CrashCollector::kDuplicateCrashWindow);
+  EXPECT_FALSE(collector_.DeduplicateCrash("foobar", "sig"));
+  EXPECT_TRUE(collector_.GetLogContents(config_file, "foobar",
+                                        test_dir_.Append("log3")));
+  EXPECT_THAT(collector_.extra_metadata_,
+              HasSubstr("upload_var_skipped_duplicates=1"));
+}
+
 TEST_F(CrashCollectorTest, GetMultipleLogContents) {
   FilePath config_file = test_dir_.Append("crash_config");
   FilePath output_file = test_dir_.Append("crash_log");
@@ -2206,6 +2242,30 @@ TEST_F(CrashCollectorTest, GetMultipleLogContents) {
   EXPECT_EQ("foobaz\nbazbar\n", contents);
 }
 
+TEST_F(CrashCollectorTest, GetMultipleLogContentsReusesRecentOutput) {
+  FilePath config_file = test_dir_.Append("crash_config");
+  FilePath counter_file = test_dir_.Append("counter");
+  ASSERT_TRUE(test_util::CreateFile(
+      config_file, "foobar=echo x >> " + counter_file.value() + " && cat " +
+                       counter_file.value()));
+  FilePath output_file = test_dir_.Append("crash_log");
+  std::string contents;
+
+  EXPECT_TRUE(
+      collector_.GetMultipleLogContents(config_file, {"foobar"}, output_file));
+  EXPECT_TRUE(base::ReadFileToString(output_file, &contents));
+  EXPECT_EQ("x\n", contents);
+  base::DeleteFile(output_file);
+
+  // The command is not run again right after.
+  EXPECT_TRUE(
+      collector_.GetMultipleLogContents(config_file, {"foobar"}, output_file));
+  EXPECT_TRUE(base::ReadFileToString(output_file, &contents));
+  EXPECT_EQ("x\n", contents);
+  EXPECT_TRUE(base::ReadFileToString(counter_file, &contents));
+  EXPECT_EQ("x\n", contents);
+}
+
 TEST_F(CrashCollectorTest, GetProcessPath) {
   // We want to use the real proc filesystem.
   paths::SetPrefixForTesting(base::FilePath());
@@ -171,6 +171,7 @@ int RunChildMain(int argc, const char* argv[]) {
   options.consent_already_checked_by_crash_reporter =
       flags.consent_already_checked_by_crash_reporter;
   options.dry_run = flags.dry_run;
+  options.paced_uploads = flags.paced_uploads;
   util::Sender sender(std::move(metrics_lib), std::move(clock), options);
 
   // If you add sigificant code past this point, consider updating
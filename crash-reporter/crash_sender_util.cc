@@ -34,7 +34,9 @@
 #include <brillo/files/file_util.h>
 #include <brillo/files/safe_fd.h>
 #include <brillo/http/http_proxy.h>
+#include <brillo/http/curl_api.h>
 #include <brillo/http/http_transport.h>
+#include <brillo/http/http_transport_curl.h>
 #include <brillo/http/http_utils.h>
 #include <brillo/mime_utils.h>
 #include <brillo/syslog_logging.h>
@@ -141,6 +143,10 @@ void ParseCommandLine(int argc,
       "If set, does not upload crashes, delete crashes, or update uploads.log; "
       "instead, writes the uploads.log content to standard output. "
       "(To be implemented.)");
+  DEFINE_bool(paced_uploads, false,
+              "Send crash reports back to back over one connection, pacing "
+              "them by upload size instead of random sleeps. Used to drain "
+              "large backlogs.");
 
   brillo::FlagHelper::Init(argc, argv, "ChromeOS Crash Sender");
   if (FLAGS_max_spread_time < 0) {
@@ -160,6 +166,7 @@ void ParseCommandLine(int argc,
   flags->consent_already_checked_by_crash_reporter =
       FLAGS_consent_already_checked_by_crash_reporter;
   flags->dry_run = FLAGS_dry_run;
+  flags->paced_uploads = FLAGS_paced_uploads;
   // We should only be skipping the consent check if we are sure it has been
   // checked prior to crash_sender being invoked. This only happens when the
   // flag is set via debugd, which also sets the crash_directory flag.
@@ -418,7 +425,8 @@ Sender::Sender(std::unique_ptr<MetricsLibraryInterface> metrics_lib,
       force_upload_on_test_images_(options.force_upload_on_test_images),
       consent_already_checked_by_crash_reporter_(
           options.consent_already_checked_by_crash_reporter),
-      dry_run_(options.dry_run) {}
+      dry_run_(options.dry_run),
+      paced_uploads_(options.paced_uploads) {}
 
 bool Sender::HasCrashUploadingConsent(const CrashInfo& info) {
   if (util::HasMockConsent()) {
@@ -561,19 +569,32 @@ void Sender::SendCrashes(const std::vector<MetaFile>& crash_meta_files) {
   std::string client_id = GetClientId();
 
   base::File lock(AcquireLockFileOrDie());
+  bool first_report = true;
   for (const auto& pair : crash_meta_files) {
     const base::FilePath& meta_file = pair.first;
     const CrashInfo& info = pair.second;
     LOG(INFO) << "Evaluating crash report: " << meta_file.value();
 
+    // Max spread time set to 0 under the dry run mode, and after the first
+    // report with paced uploads.
+    base::TimeDelta max_spread_time = max_spread_time_;
+    if (dry_run_ || (paced_uploads_ && !first_report)) {
+      max_spread_time = base::TimeDelta();
+    }
+    first_report = false;
+
     base::TimeDelta sleep_time;
-    if (!GetSleepTime(meta_file,
-                      // max spread time set to 0 under the dry run mode
-                      dry_run_ ? base::TimeDelta() : max_spread_time_,
-                      hold_off_time_, &sleep_time)) {
+    if (!GetSleepTime(meta_file, max_spread_time, hold_off_time_,
+                      &sleep_time)) {
       LOG(WARNING) << "Failed to compute sleep time for " << meta_file.value();
       continue;
     }
+    if (paced_uploads_) {
+      sleep_time =
+          std::max(sleep_time, base::Seconds(last_upload_size_) /
+                                   kPacedUploadBytesPerSecond);
+      last_upload_size_ = 0;
+    }
 
     LOG(INFO) << "Scheduled to send in " << sleep_time.InSeconds() << "s";
     lock.Close();  // Don't hold lock during sleep.
@@ -748,11 +769,26 @@ std::unique_ptr<brillo::http::FormData> Sender::CreateCrashFormData(
 }
 
 std::shared_ptr<brillo::http::Transport> Sender::GetTransport() {
+  if (!paced_uploads_) {
+    if (proxy_servers_.empty() || proxy_servers_[0] == "direct://") {
+      return brillo::http::Transport::CreateDefault();
+    } else {
+      return brillo::http::Transport::CreateDefaultWithProxy(proxy_servers_[0]);
+    }
+  }
+
+  auto curl_api = std::make_shared<brillo::http::CurlApi>();
+  std::shared_ptr<brillo::http::curl::Transport> transport;
   if (proxy_servers_.empty() || proxy_servers_[0] == "direct://") {
-    return brillo::http::Transport::CreateDefault();
+    transport = std::make_shared<brillo::http::curl::Transport>(curl_api);
   } else {
-    return brillo::http::Transport::CreateDefaultWithProxy(proxy_servers_[0]);
+    transport = std::make_shared<brillo::http::curl::Transport>(
+        curl_api, proxy_servers_[0]);
   }
+  // Keep the connection, DNS and TLS session to the crash server between the
+  // uploads instead of paying a new TLS handshake per report.
+  transport->SetConnectionOptions({.share_connections = true, .http2 = true});
+  return transport;
 }
 
 void Sender::RemoveReportFiles(const base::FilePath& meta_file) {
@@ -923,6 +959,7 @@ SenderBase::CrashRemoveReason Sender::RequestToSendCrash(
     size = static_cast<int>(uncompressed_size);
   }
   RecordSendAttempt(timestamps_dir, size);
+  last_upload_size_ = size;
 
   if (IsMock()) {
     CHECK(!crash_during_testing_) << "crashing as requested";
@@ -947,7 +984,13 @@ SenderBase::CrashRemoveReason Sender::RequestToSendCrash(
     }
   }
 
-  std::shared_ptr<brillo::http::Transport> transport = GetTransport();
+  std::shared_ptr<brillo::http::Transport> transport = transport_;
+  if (!transport) {
+    transport = GetTransport();
+    if (paced_uploads_) {
+      transport_ = transport;
+    }
+  }
 
   brillo::ErrorPtr upload_error;
   std::unique_ptr<brillo::http::Response> response;
@@ -50,6 +50,9 @@ inline constexpr int kMaxCrashBytes = 24 * 1024 * 1024;
 // immediately.
 inline constexpr int kMaxSpreadTimeInSeconds = 600;
 
+// Upload rate that paced uploads stay under, see Sender::Options.
+inline constexpr int kPacedUploadBytesPerSecond = 64 * 1024;
+
 // Parsed command line flags.
 struct CommandLineFlags {
   base::TimeDelta max_spread_time;
@@ -63,6 +66,7 @@ struct CommandLineFlags {
   bool force_upload_on_test_images = false;
   bool consent_already_checked_by_crash_reporter = false;
   bool dry_run = false;
+  bool paced_uploads = false;
 };
 
 // Represents a metadata file name, and its parsed metadata.
@@ -181,6 +185,12 @@ class Sender : public SenderBase {
     // If true, crash_sender will run under the dry run mode -- it will not
     // upload any crashes and writes log content to stdout.
     bool dry_run = false;
+
+    // If true, crash reports are sent back to back over a single connection:
+    // only the first report waits for up to |max_spread_time|, the following
+    // ones wait for as long as the previous upload takes to stay below
+    // kPacedUploadBytesPerSecond. Used to drain large backlogs of reports.
+    bool paced_uploads = false;
   };
 
   Sender(std::unique_ptr<MetricsLibraryInterface> metrics_lib,
@@ -202,13 +212,15 @@ class Sender : public SenderBase {
   void RemoveAndPickCrashFiles(const base::FilePath& directory,
                                std::vector<MetaFile>* reports_to_send);
 
-  // Creates an Http transport object for invoking the Crash Server.
+  // Creates an Http transport object for invoking the Crash Server. With
+  // |paced_uploads|, the transport keeps its connections open for reuse.
   virtual std::shared_ptr<brillo::http::Transport> GetTransport();
 
   // Sends each crash in |crash_meta_files|, in multiple steps:
   //
   // For each meta file:
-  // - Sleeps to avoid overloading the network
+  // - Sleeps to avoid overloading the network, by a random spread time or, with
+  //   |paced_uploads|, by the size of the previous upload.
   // - Checks if the device enters guest mode, and stops if entered.
   // - Enforces the rate limit per 24 hours.
   // - Removes crash files that are successfully uploaded.
@@ -291,6 +303,11 @@ class Sender : public SenderBase {
   const bool force_upload_on_test_images_;
   const bool consent_already_checked_by_crash_reporter_;
   const bool dry_run_;
+  const bool paced_uploads_;
+  // With |paced_uploads_|, the transport shared by all the uploads and the
+  // size in bytes of the last upload attempt.
+  std::shared_ptr<brillo::http::Transport> transport_;
+  int last_upload_size_ = 0;
 };
 
 }  // namespace util
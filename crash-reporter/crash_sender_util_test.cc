@@ -687,6 +687,7 @@ TEST_F(CrashSenderUtilTest, ParseCommandLine_NoFlags) {
   EXPECT_FALSE(flags.force_upload_on_test_images);
   EXPECT_FALSE(flags.consent_already_checked_by_crash_reporter);
   EXPECT_FALSE(flags.dry_run);
+  EXPECT_FALSE(flags.paced_uploads);
   // Test here because the setting of ChromeCrashLog is done during CLI parsing.
   EXPECT_STREQ(paths::ChromeCrashLog::Get(), kChromeCrashLog);
 }
@@ -2478,6 +2479,73 @@ TEST_F(CrashSenderUtilTest, SendCrashes_TooManyRequests) {
   EXPECT_FALSE(base::PathExists(user_processing));
 }
 
+TEST_F(CrashSenderUtilTest, SendCrashes_PacedUploads) {
+  // Set up the mock session manager client.
+  auto mock =
+      std::make_unique<org::chromium::SessionManagerInterfaceProxyMock>();
+  test_util::SetActiveSessions(mock.get(), {{"user", "hash"}});
+  std::vector<MetaFile> crashes_to_send;
+
+  // Establish the client ID.
+  ASSERT_TRUE(CreateClientIdFile());
+
+  // Create a user crash directory, and two crash reports in it.
+  const base::FilePath user_dir = paths::Get("/home/user/hash/crash");
+  ASSERT_TRUE(base::CreateDirectory(user_dir));
+  for (const char* basename : {"0.0.0.0.0", "1.1.1.1.1"}) {
+    const base::FilePath meta_file =
+        user_dir.Append(basename).AddExtension("meta");
+    const base::FilePath log = user_dir.Append(basename).AddExtension("log");
+    const std::string meta = base::StrCat(
+        {"payload=", log.BaseName().value(), "\n",
+         "exec_name=exec_bar\n"
+         "upload_var_prod=bar\n"
+         "done=1\n"});
+    ASSERT_TRUE(test_util::CreateFile(meta_file, meta));
+    ASSERT_TRUE(test_util::CreateFile(log, "some log"));
+    CrashInfo info;
+    EXPECT_TRUE(info.metadata.LoadFromString(meta));
+    info.payload_file = log;
+    info.payload_kind = "log";
+    crashes_to_send.emplace_back(meta_file, std::move(info));
+  }
+
+  // Set up the conditions to emulate a device with metrics enabled.
+  ASSERT_TRUE(SetConditions(kOfficialBuild, kSignInMode, kMetricsEnabled));
+
+  // Set up the crash sender so that it succeeds.
+  SetMockCrashSending(true);
+
+  // Set up the sender.
+  std::vector<base::TimeDelta> sleep_times;
+  Sender::Options options;
+  options.session_manager_proxy = mock.release();
+  options.sleep_function = base::BindRepeating(&FakeSleep, &sleep_times);
+  options.always_write_uploads_log = true;
+  options.hold_off_time = base::TimeDelta();
+  options.max_spread_time = base::TimeDelta();
+  options.paced_uploads = true;
+  MockSender sender(true /*success*/,
+                    "123",  // upload_id
+                    std::move(metrics_lib_),
+                    std::make_unique<test_util::AdvancingClock>(), options);
+
+  // Both reports are sent with the same transport.
+  EXPECT_CALL(sender, GetTransport()).Times(1);
+  sender.SendCrashes(crashes_to_send);
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(paths::Get(paths::ChromeCrashLog::Get()),
+                                     &contents));
+  EXPECT_EQ(2, ParseChromeUploadsLog(contents).size());
+
+  // The second report waits for the first one to be paced out.
+  ASSERT_EQ(2, sleep_times.size());
+  EXPECT_EQ(sleep_times[0], base::TimeDelta());
+  EXPECT_GT(sleep_times[1], base::TimeDelta());
+  EXPECT_LT(sleep_times[1], base::Seconds(1));
+}
+
 TEST_F(CrashSenderUtilTest, SendCrashes_DroppedDueToThrottling) {
   // Set up the mock session manager client.
   auto mock =
@@ -84,8 +84,19 @@ bool GenericFailureCollector::CollectFull(const std::string& exec_name,
   std::string dump_basename = FormatDumpBasename(exec_name, time(nullptr), 0);
   FilePath log_path = GetCrashPath(crash_directory, dump_basename, "log");
   FilePath meta_path = GetCrashPath(crash_directory, dump_basename, "meta");
-  if (weight) {
-    AddCrashMetaUploadData("weight", StringPrintf("%d", *weight));
+
+  // The logs are the payload of the report, so repeats of a recent failure
+  // (e.g. a respawning service) are not reported again. They are counted in
+  // the weight of the next report of that failure instead.
+  int skipped_weight = 0;
+  if (DeduplicateCrash(exec_name, failure_signature, weight.value_or(1),
+                       &skipped_weight)) {
+    LOG(INFO) << "Not reporting a repeat of a recent failure";
+    return true;
+  }
+  if (weight || skipped_weight > 0) {
+    AddCrashMetaUploadData(
+        "weight", StringPrintf("%d", weight.value_or(1) + skipped_weight));
   }
 
   AddCrashMetaData(kSignatureKey, failure_signature);
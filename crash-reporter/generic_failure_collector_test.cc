@@ -14,11 +14,14 @@
 #include <base/logging.h>
 #include <base/memory/ref_counted.h>
 #include <base/memory/scoped_refptr.h>
+#include <base/test/simple_test_clock.h>
+#include <base/time/time.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <metrics/metrics_library.h>
 #include <metrics/metrics_library_mock.h>
 
+#include "crash-reporter/paths.h"
 #include "crash-reporter/test_util.h"
 
 using base::FilePath;
@@ -64,8 +67,12 @@ class GenericFailureCollectorTest : public ::testing::Test {
         test_util::GetTestDataPath(kLogConfigFileName,
                                    /*use_testdata=*/false)
             .value());
+    // Keep the signatures of the recent crashes in the test directory.
+    paths::SetPrefixForTesting(scoped_temp_dir_.GetPath());
   }
 
+  void TearDown() override { paths::SetPrefixForTesting(base::FilePath()); }
+
  protected:
   GenericFailureCollectorMock collector_;
   base::ScopedTempDir scoped_temp_dir_;
@@ -183,6 +190,41 @@ TEST_F(GenericFailureCollectorTest, CollectFullGuestOOM) {
   EXPECT_TRUE(contents.find(log) != std::string::npos) << contents;
 }
 
+TEST_F(GenericFailureCollectorTest, RepeatedFailureCountsInNextReport) {
+  auto test_clock = std::make_unique<base::SimpleTestClock>();
+  base::SimpleTestClock* clock = test_clock.get();
+  clock->SetNow(base::Time::UnixEpoch() + base::Days(10000));
+  collector_.set_test_clock(std::move(test_clock));
+  const char kFailure[] =
+      "crash-crash main process (2563) terminated with status 2\n";
+
+  ASSERT_TRUE(test_util::CreateFile(test_path_, kFailure));
+  EXPECT_TRUE(collector_.CollectFull(
+      "service-failure-crash-crash", GenericFailureCollector::kServiceFailure,
+      /*weight=*/50, /*use_log_conf_file=*/true));
+  EXPECT_FALSE(IsDirectoryEmpty(test_failure_directory_));
+  ASSERT_TRUE(base::DeletePathRecursively(test_failure_directory_));
+  ASSERT_TRUE(base::CreateDirectory(test_failure_directory_));
+
+  // A repeat a minute later is not reported.
+  clock->Advance(base::Minutes(1));
+  ASSERT_TRUE(test_util::CreateFile(test_path_, kFailure));
+  EXPECT_TRUE(collector_.CollectFull(
+      "service-failure-crash-crash", GenericFailureCollector::kServiceFailure,
+      /*weight=*/50, /*use_log_conf_file=*/true));
+  EXPECT_TRUE(IsDirectoryEmpty(test_failure_directory_));
+
+  // The next report past the window also counts the repeat.
+  clock->Advance(CrashCollector::kDuplicateCrashWindow);
+  ASSERT_TRUE(test_util::CreateFile(test_path_, kFailure));
+  EXPECT_TRUE(collector_.CollectFull(
+      "service-failure-crash-crash", GenericFailureCollector::kServiceFailure,
+      /*weight=*/50, /*use_log_conf_file=*/true));
+  EXPECT_TRUE(test_util::DirectoryHasFileWithPatternAndContents(
+      test_failure_directory_, "service_failure_crash_crash.*.meta",
+      "upload_var_weight=100"));
+}
+
 struct ComputeCrashSeverityTestParams {
   std::string exec_name;
   CrashCollector::CrashSeverity expected_severity;
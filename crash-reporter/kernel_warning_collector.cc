@@ -351,7 +351,9 @@ bool KernelWarningCollector::Collect(int weight, WarningType type) {
 
   AddCrashMetaData(kKernelWarningSignatureKey, warning_signature);
 
-  // Get the log contents, compress, and attach to crash report.
+  // Get the log contents, compress, and attach to crash report, unless the
+  // same warning was just reported.
+  DeduplicateCrash(exec_name, warning_signature);
   bool result = GetLogContents(log_config_path_, exec_name, log_path);
   if (result) {
     AddCrashMetaUploadFile("log", log_path.BaseName().value());
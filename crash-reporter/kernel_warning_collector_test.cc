@@ -20,6 +20,7 @@
 #include <metrics/metrics_library.h>
 #include <metrics/metrics_library_mock.h>
 
+#include "crash-reporter/paths.h"
 #include "crash-reporter/test_util.h"
 
 using base::FilePath;
@@ -54,8 +55,12 @@ class KernelWarningCollectorTest : public ::testing::Test {
         scoped_temp_dir_.GetPath().Append(kTestCrashDirectory);
     CreateDirectory(test_crash_directory_);
     collector_.set_crash_directory_for_test(test_crash_directory_);
+    // Keep the signatures of the recent crashes in the test directory.
+    paths::SetPrefixForTesting(scoped_temp_dir_.GetPath());
   }
 
+  void TearDown() override { paths::SetPrefixForTesting(base::FilePath()); }
+
  protected:
   KernelWarningCollectorMock collector_;
   base::ScopedTempDir scoped_temp_dir_;
@@ -93,6 +93,23 @@ inline constexpr char kMockConsent[] = "mock-consent";
 // ready for anomalies.
 inline constexpr char kAnomalyDetectorReady[] = "anomaly-detector-ready";
 
+// Prefix of the base names of the files where the anomaly detector records how
+// far it read each log file, followed by the base name of the log file. Files
+// will be in directory kSystemRunStateDirectory.
+inline constexpr char kAnomalyDetectorCursorPrefix[] =
+    "anomaly-detector-cursor.";
+
+// Base name of the directory where collectors record the signatures of the
+// crashes they recently collected, see CrashCollector::DeduplicateCrash.
+// Directory will be in directory kSystemRunStateDirectory.
+inline constexpr char kRecentCrashSignaturesDirectory[] =
+    "recent-crash-signatures";
+
+// Base name of the directory where collectors share the recent outputs of the
+// log commands of crash_reporter_logs.conf. Directory will be in directory
+// kSystemRunStateDirectory.
+inline constexpr char kLogCacheDirectory[] = "log-cache";
+
 // Base name of file whose contents tell us which crashes, if any, to filter.
 // Used for tests only. Exact details of how the file is interpreted can be
 // found on the method documentation of `utils::SkipCrashCollection`
@@ -8,7 +8,10 @@
 #include <elf.h>
 #include <fcntl.h>
 #include <stdint.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
 
+#include <algorithm>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -27,6 +30,7 @@
 #include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
 #include <base/strings/stringprintf.h>
+#include <base/system/sys_info.h>
 #include <brillo/process/process.h>
 #include <metrics/metrics_library.h>
 
@@ -500,6 +504,88 @@ bool UserCollector::CopyPipeToCoreFile(int input_fd,
   return false;
 }
 
+bool UserCollector::KeepCoreInMemory() const {
+  // Cores of early Chrome crashes have their own size limits, and crash loop
+  // mode sends the files over D-Bus, which doesn't produce a core2md output
+  // to speak of.
+  return !util::IsDeveloperImage() && !handling_early_chrome_crash_ &&
+         crash_sending_mode_ == kNormalCrashSendMode;
+}
+
+bool UserCollector::CopyStdinToCoreMemfd(const base::FilePath& core_path,
+                                         base::ScopedFD* core_fd) {
+  const int64_t available_memory =
+      base::SysInfo::AmountOfAvailablePhysicalMemory();
+  const int64_t max_memory_size =
+      std::min(kMaxInMemoryCoreSize, available_memory / 2);
+  return CopyPipeToCoreMemfd(STDIN_FILENO, core_path, max_memory_size,
+                             core_fd);
+}
+
+bool UserCollector::CopyPipeToCoreMemfd(int input_fd,
+                                        const base::FilePath& core_path,
+                                        int64_t max_memory_size,
+                                        base::ScopedFD* core_fd) {
+  // Not close-on-exec: core2md inherits the descriptor and opens the core
+  // through /proc/self/fd.
+  base::ScopedFD memfd(memfd_create("core", 0));
+  if (!memfd.is_valid()) {
+    PLOG(WARNING) << "Could not create memfd for the core, using a file";
+    return CopyPipeToCoreFile(input_fd, core_path);
+  }
+
+  // Read one byte past the limit so that a core of exactly |max_memory_size|
+  // bytes is kept in memory.
+  int64_t size = 0;
+  while (size <= max_memory_size) {
+    ssize_t res = splice(input_fd, /*off_in=*/nullptr, memfd.get(),
+                         /*off_out=*/nullptr,
+                         /*length=*/max_memory_size - size + 1, /*flags=*/0);
+    if (res < 0) {
+      PLOG(ERROR) << "Could not read core data";
+      return false;
+    }
+    if (res == 0) {
+      *core_fd = std::move(memfd);
+      return true;
+    }
+    size += res;
+  }
+
+  // Too big to be kept in memory: move what we have so far to |core_path| and
+  // write the rest of the core there directly.
+  LOG(INFO) << "Core is larger than " << max_memory_size
+            << " bytes, writing it to " << core_path.value();
+  core_fd->reset();
+  base::ScopedFD file = GetNewFileHandle(core_path);
+  if (!file.is_valid()) {
+    LOG(ERROR) << "Could not write core file " << core_path.value();
+    return false;
+  }
+  off_t offset = 0;
+  while (offset < size) {
+    ssize_t res = sendfile(file.get(), memfd.get(), &offset, size - offset);
+    if (res <= 0) {
+      PLOG(ERROR) << "Could not write core file " << core_path.value();
+      base::DeleteFile(core_path);
+      return false;
+    }
+  }
+  memfd.reset();
+  while (true) {
+    ssize_t res = splice(input_fd, /*off_in=*/nullptr, file.get(),
+                         /*off_out=*/nullptr, /*length=*/1 << 20, /*flags=*/0);
+    if (res == 0) {
+      return true;
+    }
+    if (res < 0) {
+      PLOG(ERROR) << "Could not write core file " << core_path.value();
+      base::DeleteFile(core_path);
+      return false;
+    }
+  }
+}
+
 bool UserCollector::RunCoreToMinidump(const FilePath& core_path,
                                       const FilePath& procfs_directory,
                                       const FilePath& minidump_path,
@@ -745,7 +831,14 @@ UserCollector::ErrorType UserCollector::ConvertCoreToMinidump(
   bool proc_files_usable =
       CopyOffProcFiles(pid, container_dir) && ValidateProcFiles(container_dir);
 
-  if (!CopyStdinToCoreFile(core_path)) {
+  // Unless the core file is kept for debugging, keep the core in memory for
+  // core2md rather than writing it to disk only to delete it right after.
+  base::ScopedFD core_memfd;
+  if (KeepCoreInMemory() && proc_files_usable) {
+    if (!CopyStdinToCoreMemfd(core_path, &core_memfd)) {
+      return kErrorReadCoreData;
+    }
+  } else if (!CopyStdinToCoreFile(core_path)) {
     return kErrorReadCoreData;
   }
 
@@ -755,12 +848,16 @@ UserCollector::ErrorType UserCollector::ConvertCoreToMinidump(
     return kErrorUnusableProcFiles;
   }
 
-  ErrorType error = ValidateCoreFile(core_path);
+  const FilePath core_file =
+      core_memfd.is_valid()
+          ? FilePath(base::StringPrintf("/proc/self/fd/%d", core_memfd.get()))
+          : core_path;
+  ErrorType error = ValidateCoreFile(core_file);
   if (error != kErrorNone) {
     return error;
   }
 
-  if (!RunCoreToMinidump(core_path,
+  if (!RunCoreToMinidump(core_file,
                          container_dir,  // procfs directory
                          minidump_path,
                          container_dir)) {  // temporary directory
@@ -16,6 +16,7 @@
 #include <string>
 
 #include <base/files/file_path.h>
+#include <base/files/scoped_file.h>
 #include <base/memory/ref_counted.h>
 #include <base/memory/scoped_refptr.h>
 #include <gtest/gtest_prod.h>  // for FRIEND_TEST
@@ -90,6 +91,7 @@ class UserCollector : public UserCollectorBase {
   FRIEND_TEST(UserCollectorTest, ClobberContainerDirectory);
   FRIEND_TEST(UserCollectorTest, CopyOffProcFilesBadPid);
   FRIEND_TEST(UserCollectorTest, CopyOffProcFilesOK);
+  FRIEND_TEST(UserCollectorTest, GetCrashSiteSignature);
   FRIEND_TEST(UserCollectorTest, GetExecutableBaseNameFromPid);
   FRIEND_TEST(UserCollectorTest, GetFirstLineWithPrefix);
   FRIEND_TEST(UserCollectorTest, GetIdFromStatus);
@@ -117,6 +119,8 @@ class UserCollector : public UserCollectorBase {
   FRIEND_TEST(ShouldCaptureEarlyChromeCrashTest, FalseIfNotChrome);
   friend class CopyStdinToCoreFileTest;
   FRIEND_TEST(CopyStdinToCoreFileTest, Test);
+  FRIEND_TEST(CopyStdinToCoreFileTest, MemfdKeepsSmallCoreInMemory);
+  FRIEND_TEST(CopyStdinToCoreFileTest, MemfdSpillsLargeCoreToDisk);
   FRIEND_TEST(BeginHandlingCrashTest, SetsUpForEarlyChromeCrashes);
   FRIEND_TEST(BeginHandlingCrashTest, DISABLED_SetsUpForEarlyChromeCrashes);
   FRIEND_TEST(BeginHandlingCrashTest, IgnoresNonEarlyBrowser);
@@ -158,6 +162,21 @@ class UserCollector : public UserCollectorBase {
   // Heart of CopyStdinToCoreFile. Split out for easier unit testing. Does NOT
   // take ownership of input_fd and will not close it. input_fd must be a pipe.
   bool CopyPipeToCoreFile(int input_fd, const base::FilePath& core_path);
+  // Returns true if the core should be kept in memory instead of being
+  // written to the crash directory, i.e. when nobody is going to look at the
+  // core file once the minidump is generated.
+  bool KeepCoreInMemory() const;
+  // Copy off stdin to a memfd, see CopyPipeToCoreMemfd.
+  bool CopyStdinToCoreMemfd(const base::FilePath& core_path,
+                            base::ScopedFD* core_fd);
+  // Copies the core from the pipe |input_fd| to a memfd returned in |core_fd|,
+  // so that core2md can read it without the core being written to disk. If the
+  // core exceeds |max_memory_size| bytes, it is written to |core_path| instead
+  // and |core_fd| is reset. Does NOT take ownership of input_fd.
+  bool CopyPipeToCoreMemfd(int input_fd,
+                           const base::FilePath& core_path,
+                           int64_t max_memory_size,
+                           base::ScopedFD* core_fd);
   bool RunCoreToMinidump(const base::FilePath& core_path,
                          const base::FilePath& procfs_directory,
                          const base::FilePath& minidump_path,
@@ -221,6 +240,10 @@ class UserCollector : public UserCollectorBase {
   // tests non-is_official_build Chrome builds, which produce larger cores.
   static constexpr int kMaxChromeCoreSizeLoose = 100 * 1024 * 1024;
 
+  // Cores are kept in memory up to this size, or half of the available memory
+  // if less, and written to disk past that; see CopyPipeToCoreMemfd.
+  static constexpr int64_t kMaxInMemoryCoreSize = 512 * 1024 * 1024;
+
   // Force a core2md failure for testing.
   bool core2md_failure_;
 };
@@ -4,10 +4,13 @@
 
 #include "crash-reporter/user_collector_base.h"
 
+#include <inttypes.h>
 #include <signal.h>  // SIGSYS
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include <base/check.h>
 #include <base/files/file_enumerator.h>
@@ -275,6 +278,62 @@ bool UserCollectorBase::GetRustSignature(pid_t pid, std::string* panic_sig) {
   return false;
 }
 
+bool UserCollectorBase::GetCrashSiteSignature(pid_t pid,
+                                              std::string* crash_site) {
+  const FilePath proc_path = GetProcessPath(pid);
+
+  // The kernel only reports the instruction pointer (kstkeip) of a process
+  // which is dumping its core. Skip "pid" and "comm", see proc(5).
+  std::string stat;
+  if (!base::ReadFileToString(proc_path.Append("stat"), &stat))
+    return false;
+  const auto comm_end = stat.find_last_of(')');
+  if (comm_end == std::string::npos)
+    return false;
+  const std::vector<base::StringPiece> stat_fields = base::SplitStringPiece(
+      base::StringPiece(stat).substr(comm_end + 1), " ", base::TRIM_WHITESPACE,
+      base::SPLIT_WANT_NONEMPTY);
+  constexpr size_t kInstructionPointerPos = 27;
+  uint64_t ip = 0;
+  if (stat_fields.size() <= kInstructionPointerPos ||
+      !base::StringToUint64(stat_fields[kInstructionPointerPos], &ip) ||
+      ip == 0) {
+    return false;
+  }
+
+  // Lines look like "start-end perms offset dev inode path".
+  std::string maps;
+  if (!base::ReadFileToString(proc_path.Append("maps"), &maps))
+    return false;
+  for (base::StringPiece line : base::SplitStringPiece(
+           maps, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    const std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.size() < 6)
+      continue;
+    const std::vector<base::StringPiece> range = base::SplitStringPiece(
+        fields[0], "-", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+    uint64_t start, end, offset;
+    if (range.size() != 2 || !base::HexStringToUInt64(range[0], &start) ||
+        !base::HexStringToUInt64(range[1], &end) ||
+        !base::HexStringToUInt64(fields[2], &offset)) {
+      continue;
+    }
+    if (ip < start || ip >= end)
+      continue;
+    // Anonymous and special mappings, e.g. JIT code or "[vdso]", don't
+    // identify the code that crashed.
+    const FilePath mapped_file(fields[5]);
+    if (!mapped_file.IsAbsolute())
+      return false;
+    *crash_site = StringPrintf("%s+0x%" PRIx64,
+                               mapped_file.BaseName().value().c_str(),
+                               ip - start + offset);
+    return true;
+  }
+  return false;
+}
+
 bool UserCollectorBase::ClobberContainerDirectory(
     const base::FilePath& container_dir) {
   // Delete a pre-existing directory from crash reporter that may have
@@ -332,6 +391,20 @@ UserCollectorBase::ErrorType UserCollectorBase::ConvertAndEnqueueCrash(
   util::JoinSessionKeyring();
 #endif  // USE_DIRENCRYPTION
 
+  std::string rust_panic_sig;
+  if (GetRustSignature(pid, &rust_panic_sig)) {
+    AddCrashMetaData("sig", rust_panic_sig);
+  }
+
+  // The stack is only known once the minidump is processed, so repeats are
+  // recognized by the panic signature or by the crash site. Crashes without
+  // either are always collected in full.
+  std::string crash_site;
+  if (!rust_panic_sig.empty()) {
+    DeduplicateCrash(exec, rust_panic_sig);
+  } else if (GetCrashSiteSignature(pid, &crash_site)) {
+    DeduplicateCrash(exec, crash_site);
+  }
   if (GetLogContents(FilePath(log_config_path_), exec, log_path)) {
     AddCrashMetaUploadFile("log", log_path.BaseName().value());
   }
@@ -340,15 +413,10 @@ UserCollectorBase::ErrorType UserCollectorBase::ConvertAndEnqueueCrash(
     AddCrashMetaUploadFile("process_tree", proc_log_path.BaseName().value());
   }
 
-  std::string rust_panic_sig;
-  if (GetRustSignature(pid, &rust_panic_sig)) {
-    AddCrashMetaData("sig", rust_panic_sig);
-  }
-
   ErrorType error_type =
       ConvertCoreToMinidump(pid, container_dir, core_path, minidump_path);
   if (error_type != kErrorNone) {
-    if (error_type != kErrorReadCoreData)
+    if (error_type != kErrorReadCoreData && base::PathExists(core_path))
       LOG(INFO) << "Leaving core file at " << core_path.value()
                 << " due to conversion error";
     return error_type;
@@ -94,6 +94,12 @@ class UserCollectorBase : public CrashCollector {
   // and if so, returns true and sets |panic_sig|.
   bool GetRustSignature(pid_t pid, std::string* panic_sig);
 
+  // Gets the place where process |pid| crashed, as the file mapped at its
+  // instruction pointer and the offset in that file, e.g. "libfoo.so+0x1f2c",
+  // which doesn't depend on where the file was loaded. Returns false if the
+  // instruction pointer is unknown or not in a mapped file.
+  bool GetCrashSiteSignature(pid_t pid, std::string* crash_site);
+
   bool ClobberContainerDirectory(const base::FilePath& container_dir);
 
   // Returns the command and arguments for process |pid|. Returns an empty list
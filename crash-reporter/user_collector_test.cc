@@ -599,6 +599,41 @@ TEST_F(UserCollectorTest, GetRustSignature) {
   EXPECT_EQ("Rust panic signature", panic_sig);
 }
 
+TEST_F(UserCollectorTest, GetCrashSiteSignature) {
+  constexpr pid_t kPid = 4321;
+  const FilePath proc_path = test_dir_.Append("proc/4321");
+  ASSERT_TRUE(base::CreateDirectory(proc_path));
+  ASSERT_TRUE(test_util::CreateFile(
+      proc_path.Append("maps"),
+      "5a0000000000-5a0000002000 r--p 00000000 b3:03 100 /usr/bin/foo\n"
+      "5a0000002000-5a0000008000 r-xp 00002000 b3:03 100 /usr/bin/foo\n"
+      "7f0000000000-7f0000001000 rwxp 00000000 00:00 0\n"
+      "7ffc00000000-7ffc00002000 r-xp 00000000 00:00 0 [vdso]\n"));
+  // The instruction pointer is the 30th field of stat.
+  const std::string stat_prefix =
+      "4321 (foo bar) S 1 4321 4321 0 -1 4194560 100 0 0 0 1 1 0 0 20 0 1 0 "
+      "100 1000000 100 18446744073709551615 1 1 0 0 ";
+  std::string crash_site;
+
+  ASSERT_TRUE(test_util::CreateFile(proc_path.Append("stat"),
+                                    stat_prefix + "98956046512128 0 0 0 0\n"));
+  EXPECT_TRUE(collector_.GetCrashSiteSignature(kPid, &crash_site));
+  EXPECT_EQ(crash_site, "foo+0x3000");
+
+  // Crashes in anonymous or special mappings have no crash site.
+  ASSERT_TRUE(test_util::CreateFile(proc_path.Append("stat"),
+                                    stat_prefix + "139637976727552 0 0 0 0\n"));
+  EXPECT_FALSE(collector_.GetCrashSiteSignature(kPid, &crash_site));
+  ASSERT_TRUE(test_util::CreateFile(proc_path.Append("stat"),
+                                    stat_prefix + "140720308486144 0 0 0 0\n"));
+  EXPECT_FALSE(collector_.GetCrashSiteSignature(kPid, &crash_site));
+
+  // Neither have processes whose instruction pointer is hidden.
+  ASSERT_TRUE(test_util::CreateFile(proc_path.Append("stat"),
+                                    stat_prefix + "0 0 0 0 0\n"));
+  EXPECT_FALSE(collector_.GetCrashSiteSignature(kPid, &crash_site));
+}
+
 TEST_F(UserCollectorTest, ValidateProcFiles) {
   FilePath container_dir = test_dir_;
 
@@ -964,6 +999,56 @@ TEST_P(CopyStdinToCoreFileTest, Test) {
   }
 }
 
+TEST_F(CopyStdinToCoreFileTest, MemfdKeepsSmallCoreInMemory) {
+  const base::FilePath kOutputPath = test_dir_.Append("output.txt");
+  CopyStdinToCoreFileTestParams params{};
+  params.input = "Hello I am core";
+
+  int pipefd[2];
+  ASSERT_EQ(pipe(pipefd), 0) << strerror(errno);
+  base::ScopedFD read_fd(pipefd[0]);
+  base::ScopedFD write_fd(pipefd[1]);
+  base::ThreadPool::PostTask(
+      FROM_HERE, base::BindOnce(&CopyStdinToCoreFileTest::WriteToFileDescriptor,
+                                params, std::move(write_fd)));
+
+  base::ScopedFD core_fd;
+  EXPECT_TRUE(collector_.CopyPipeToCoreMemfd(
+      read_fd.get(), kOutputPath, /*max_memory_size=*/params.input.size(),
+      &core_fd));
+  ASSERT_TRUE(core_fd.is_valid());
+  EXPECT_FALSE(base::PathExists(kOutputPath));
+
+  std::string contents;
+  EXPECT_TRUE(base::ReadFileToString(
+      base::FilePath(base::StringPrintf("/proc/self/fd/%d", core_fd.get())),
+      &contents));
+  EXPECT_EQ(contents, params.input);
+}
+
+TEST_F(CopyStdinToCoreFileTest, MemfdSpillsLargeCoreToDisk) {
+  const base::FilePath kOutputPath = test_dir_.Append("output.txt");
+  CopyStdinToCoreFileTestParams params{};
+  params.input = StringOfSize(1024 * 1024, "Too big for memory");
+
+  int pipefd[2];
+  ASSERT_EQ(pipe(pipefd), 0) << strerror(errno);
+  base::ScopedFD read_fd(pipefd[0]);
+  base::ScopedFD write_fd(pipefd[1]);
+  base::ThreadPool::PostTask(
+      FROM_HERE, base::BindOnce(&CopyStdinToCoreFileTest::WriteToFileDescriptor,
+                                params, std::move(write_fd)));
+
+  base::ScopedFD core_fd;
+  EXPECT_TRUE(collector_.CopyPipeToCoreMemfd(
+      read_fd.get(), kOutputPath, /*max_memory_size=*/4096, &core_fd));
+  EXPECT_FALSE(core_fd.is_valid());
+
+  std::string contents;
+  EXPECT_TRUE(base::ReadFileToString(kOutputPath, &contents));
+  EXPECT_EQ(contents, params.input);
+}
+
 TEST(UserCollectorNoFixtureTest, GuessChromeProductNameTest) {
   paths::SetPrefixForTesting(base::FilePath());
   struct Test {
@@ -129,10 +129,14 @@ std::unique_ptr<SandboxedProcess> ArchiveMounter::PrepareSandbox(
     }
   }
 
-  // Prepare command line arguments.
+  // Prepare command line arguments. The archive is mounted read-only and the
+  // FUSE helpers index it once at startup, so the kernel can keep the page
+  // cache of member files across opens instead of reading and decompressing
+  // them again from the (often slow, removable) source drive.
   sandbox->AddArgument("-o");
-  sandbox->AddArgument(base::StringPrintf("ro,umask=0222,uid=%d,gid=%d",
-                                          kChronosUID, kChronosAccessGID));
+  sandbox->AddArgument(
+      base::StringPrintf("ro,umask=0222,uid=%d,gid=%d,kernel_cache",
+                         kChronosUID, kChronosAccessGID));
 
   if (std::string encoding; GetParamValue(params, "encoding", &encoding)) {
     // Validate the encoding string before passing it to the FUSE mounter
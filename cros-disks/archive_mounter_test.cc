@@ -127,7 +127,8 @@ TEST_F(ArchiveMounterTest, AppArgs) {
       base::SplitString(sandbox->arguments()[1], ",", base::KEEP_WHITESPACE,
                         base::SPLIT_WANT_ALL);
   EXPECT_THAT(opts,
-              UnorderedElementsAre("umask=0222", "uid=1000", "gid=1001", "ro"));
+              UnorderedElementsAre("umask=0222", "uid=1000", "gid=1001", "ro",
+                                   "kernel_cache"));
 }
 
 TEST_F(ArchiveMounterTest, SimulateProgressForTesting) {
@@ -199,7 +200,8 @@ TEST_F(ArchiveMounterTest, WithPassword) {
       base::SplitString(sandbox->arguments()[1], ",", base::KEEP_WHITESPACE,
                         base::SPLIT_WANT_ALL);
   EXPECT_THAT(opts,
-              UnorderedElementsAre("umask=0222", "uid=1000", "gid=1001", "ro"));
+              UnorderedElementsAre("umask=0222", "uid=1000", "gid=1001", "ro",
+                                   "kernel_cache"));
 }
 
 TEST_F(ArchiveMounterTest, NoPassword) {
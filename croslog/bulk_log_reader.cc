@@ -0,0 +1,248 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "croslog/bulk_log_reader.h"
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/threading/simple_thread.h"
+
+#include "croslog/line_scanner.h"
+
+#include <base/check_op.h>
+#include <base/logging.h>
+
+namespace croslog {
+
+namespace {
+
+// Size of chunk parsed by a thread at once.
+static int64_t g_chunk_size = 1024 * 1024;
+
+// Number of chunks per thread parsed in a round. More than one to even out
+// the load of threads.
+constexpr int kChunksPerThread = 2;
+
+}  // namespace
+
+// Parses the lines in a chunk. This runs on a thread of the pool.
+class BulkLogReader::ChunkParser : public base::DelegateSimpleThread::Delegate {
+ public:
+  ChunkParser(std::unique_ptr<LogParser> parser,
+              const uint8_t* buffer,
+              uint64_t length)
+      : parser_(std::move(parser)), buffer_(buffer), length_(length) {}
+  ChunkParser(const ChunkParser&) = delete;
+  ChunkParser& operator=(const ChunkParser&) = delete;
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override {
+    std::list<std::string> succeeding_lines;
+    uint64_t pos = 0;
+    while (pos < length_) {
+      const uint64_t line_length =
+          FindFirstLineFeed(buffer_ + pos, length_ - pos);
+      // Chunks are aligned to lines, so every line is terminated by LF.
+      DCHECK_LT(pos + line_length, length_);
+      std::string line(reinterpret_cast<const char*>(buffer_ + pos),
+                       line_length);
+      pos += line_length + 1;
+
+      // The line is left as is if the parse fails.
+      MaybeLogEntry entry = parser_->Parse(std::move(line));
+      if (!entry.has_value()) {
+        // A line which is not the first line of an entry belongs to the
+        // previous entry, which may be in the previous chunk.
+        if (entries_.empty())
+          leading_lines_.push_back(std::move(line));
+        else
+          succeeding_lines.push_back(std::move(line));
+        continue;
+      }
+
+      if (!entries_.empty() && !succeeding_lines.empty()) {
+        entries_.back().AppendLinesToMessage(succeeding_lines);
+        succeeding_lines.clear();
+      }
+      entries_.push_back(std::move(*entry));
+    }
+
+    if (!entries_.empty() && !succeeding_lines.empty())
+      entries_.back().AppendLinesToMessage(succeeding_lines);
+  }
+
+  const std::list<std::string>& leading_lines() const {
+    return leading_lines_;
+  }
+  std::vector<LogEntry>& entries() { return entries_; }
+
+ private:
+  const std::unique_ptr<LogParser> parser_;
+  const uint8_t* const buffer_;
+  const uint64_t length_;
+
+  std::list<std::string> leading_lines_;
+  std::vector<LogEntry> entries_;
+};
+
+// static
+void BulkLogReader::SetChunkSizeForTest(int64_t chunk_size) {
+  CHECK_GT(chunk_size, 0);
+  g_chunk_size = chunk_size;
+}
+
+BulkLogReader::BulkLogReader(const base::FilePath& log_file,
+                             LogParserFactory parser_factory,
+                             int num_threads)
+    : parser_factory_(std::move(parser_factory)), num_threads_(num_threads) {
+  DCHECK_GE(num_threads_, 1);
+  // Empty files can't be mapped and have nothing to read.
+  int64_t file_size = 0;
+  if (!base::GetFileSize(log_file, &file_size) || file_size == 0)
+    return;
+  if (!mmap_.Initialize(log_file))
+    LOG(ERROR) << "Could not map " << log_file;
+}
+
+BulkLogReader::~BulkLogReader() = default;
+
+MaybeLogEntry BulkLogReader::GetNextEntry() {
+  // Keeps the last entry until the next chunk is parsed, since the following
+  // lines of the entry may be there.
+  while (entries_.size() <= 1 && mmap_.IsValid() &&
+         next_chunk_start_ < static_cast<int64_t>(mmap_.length())) {
+    ParseNextChunks();
+  }
+
+  if (entries_.empty())
+    return std::nullopt;
+
+  MaybeLogEntry entry(std::move(entries_.front()));
+  entries_.pop_front();
+  return entry;
+}
+
+void BulkLogReader::ParseNextChunks() {
+  const uint8_t* const data = mmap_.data();
+  const int64_t file_size = mmap_.length();
+
+  // Splits the file into chunks at line boundaries. The last line without LF
+  // is ignored as LogLineReader does, since it may be being written.
+  std::vector<std::unique_ptr<ChunkParser>> chunks;
+  const size_t max_chunks = num_threads_ * kChunksPerThread;
+  while (chunks.size() < max_chunks &&
+         next_chunk_start_ < file_size) {
+    const int64_t start = next_chunk_start_;
+
+    // Finds the LF at the end of the chunk: the first one at or after the
+    // chunk size, or the last one in the file.
+    int64_t end = file_size;
+    const int64_t search_start = start + g_chunk_size - 1;
+    if (search_start < file_size) {
+      end = search_start +
+            FindFirstLineFeed(data + search_start, file_size - search_start);
+    }
+    if (end == file_size) {
+      const int64_t last_lf = FindLastLineFeed(data + start, file_size - start);
+      end = (last_lf == file_size - start) ? file_size : start + last_lf;
+    }
+
+    if (end == file_size) {
+      // There is no complete line anymore.
+      next_chunk_start_ = file_size;
+      break;
+    }
+
+    next_chunk_start_ = end + 1;
+    chunks.push_back(std::make_unique<ChunkParser>(
+        parser_factory_.Run(), data + start, end + 1 - start));
+  }
+
+  if (num_threads_ == 1 || chunks.size() == 1) {
+    for (auto& chunk : chunks)
+      chunk->Run();
+  } else {
+    base::DelegateSimpleThreadPool pool(
+        "croslog_parser", std::min<size_t>(num_threads_, chunks.size()));
+    for (auto& chunk : chunks)
+      pool.AddWork(chunk.get());
+    pool.Start();
+    pool.JoinAll();
+  }
+
+  for (auto& chunk : chunks) {
+    if (!chunk->leading_lines().empty() && !entries_.empty())
+      entries_.back().AppendLinesToMessage(chunk->leading_lines());
+    // Leading lines at the beginning of the file are skipped, as
+    // LogEntryReader does.
+    for (auto& entry : chunk->entries())
+      entries_.push_back(std::move(entry));
+  }
+}
+
+BulkMultiplexer::LogSource::LogSource(size_t index,
+                                      const base::FilePath& log_file,
+                                      LogParserFactory parser_factory,
+                                      int num_threads)
+    : index(index), reader(log_file, std::move(parser_factory), num_threads) {}
+
+BulkMultiplexer::BulkMultiplexer(int num_threads) : num_threads_(num_threads) {}
+
+BulkMultiplexer::~BulkMultiplexer() = default;
+
+void BulkMultiplexer::AddSource(const base::FilePath& log_file,
+                                LogParserFactory parser_factory) {
+  CHECK(!heap_initialized_) << "Sources must be added before reading.";
+  sources_.emplace_back(std::make_unique<LogSource>(
+      sources_.size(), log_file, std::move(parser_factory), num_threads_));
+}
+
+// static
+bool BulkMultiplexer::Compare(const LogSource* a, const LogSource* b) {
+  // The oldest entry comes first. The former source wins on a tie.
+  const base::Time a_time = a->cache_next_forward->time();
+  const base::Time b_time = b->cache_next_forward->time();
+  if (a_time != b_time)
+    return a_time > b_time;
+  return a->index > b->index;
+}
+
+MaybeLogEntry BulkMultiplexer::Forward() {
+  if (!heap_initialized_) {
+    for (auto& source : sources_) {
+      MaybeLogEntry entry = source->reader.GetNextEntry();
+      if (!entry.has_value())
+        continue;
+      source->cache_next_forward.emplace(std::move(*entry));
+      heap_.push_back(source.get());
+    }
+    std::make_heap(heap_.begin(), heap_.end(), &Compare);
+    heap_initialized_ = true;
+  }
+
+  if (heap_.empty())
+    return std::nullopt;
+
+  std::pop_heap(heap_.begin(), heap_.end(), &Compare);
+  LogSource* next_source = heap_.back();
+  MaybeLogEntry entry = std::move(next_source->cache_next_forward);
+  next_source->cache_next_forward.reset();
+
+  // Refill the cache of the source and put it back to the heap.
+  MaybeLogEntry following_entry = next_source->reader.GetNextEntry();
+  if (following_entry.has_value()) {
+    next_source->cache_next_forward.emplace(std::move(*following_entry));
+    std::push_heap(heap_.begin(), heap_.end(), &Compare);
+  } else {
+    heap_.pop_back();
+  }
+
+  return entry;
+}
+
+}  // namespace croslog
@@ -0,0 +1,108 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CROSLOG_BULK_LOG_READER_H_
+#define CROSLOG_BULK_LOG_READER_H_
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/functional/callback.h"
+
+#include "croslog/log_entry.h"
+#include "croslog/log_parser.h"
+
+namespace croslog {
+
+using LogParserFactory =
+    base::RepeatingCallback<std::unique_ptr<LogParser>(void)>;
+
+/*
+ * This class is responsible for
+ * - Reading all the logs in a file from the beginning to the end at once.
+ * - Splitting the file into line-aligned chunks and parsing them on multiple
+ *   threads, while returning the entries in the order in the file.
+ * Unlike LogEntryReader, this doesn't support reading backward nor following
+ * the file.
+ */
+class BulkLogReader {
+ public:
+  // Sets the size of chunk to be parsed by a thread.
+  static void SetChunkSizeForTest(int64_t chunk_size);
+
+  BulkLogReader(const base::FilePath& log_file,
+                LogParserFactory parser_factory,
+                int num_threads);
+  BulkLogReader(const BulkLogReader&) = delete;
+  BulkLogReader& operator=(const BulkLogReader&) = delete;
+
+  ~BulkLogReader();
+
+  // Returns the parsed next entry, or a nullopt, if the current position
+  // reaches the end of the file.
+  MaybeLogEntry GetNextEntry();
+
+ private:
+  class ChunkParser;
+
+  // Parses the next chunks on the threads and appends the entries.
+  void ParseNextChunks();
+
+  const LogParserFactory parser_factory_;
+  const int num_threads_;
+  base::MemoryMappedFile mmap_;
+  // Start of the chunk to be parsed next.
+  int64_t next_chunk_start_ = 0;
+  // Parsed entries which are not returned yet. The last one may have its
+  // succeeding lines in the next chunk, so it's returned only after the next
+  // chunk is parsed.
+  std::deque<LogEntry> entries_;
+};
+
+// Read logs from multiple files at once with merging the lines.
+class BulkMultiplexer {
+ public:
+  explicit BulkMultiplexer(int num_threads);
+  BulkMultiplexer(const BulkMultiplexer&) = delete;
+  BulkMultiplexer& operator=(const BulkMultiplexer&) = delete;
+
+  ~BulkMultiplexer();
+
+  // Add a source log file to read.
+  void AddSource(const base::FilePath& log_file,
+                 LogParserFactory parser_factory);
+
+  // Read the next line from log.
+  MaybeLogEntry Forward();
+
+ private:
+  struct LogSource {
+    LogSource(size_t index,
+              const base::FilePath& log_file,
+              LogParserFactory parser_factory,
+              int num_threads);
+
+    // Index in |sources_|, used to break ties of the timestamps.
+    const size_t index;
+    BulkLogReader reader;
+    MaybeLogEntry cache_next_forward;
+  };
+
+  // Returns true if the entry of |a| should be returned after that of |b|.
+  static bool Compare(const LogSource* a, const LogSource* b);
+
+  const int num_threads_;
+  std::vector<std::unique_ptr<LogSource>> sources_;
+  // Heap of the sources which have a cached entry. The top is the source of
+  // the entry to be returned next.
+  std::vector<LogSource*> heap_;
+  bool heap_initialized_ = false;
+};
+
+}  // namespace croslog
+
+#endif  // CROSLOG_BULK_LOG_READER_H_
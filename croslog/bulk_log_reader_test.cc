@@ -0,0 +1,118 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "croslog/bulk_log_reader.h"
+
+#include <inttypes.h>
+
+#include <memory>
+#include <string>
+
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/functional/bind.h>
+#include <base/strings/stringprintf.h>
+#include <gtest/gtest.h>
+
+#include "croslog/log_entry_reader.h"
+#include "croslog/log_parser_syslog.h"
+
+namespace croslog {
+
+namespace {
+
+std::unique_ptr<LogParser> CreateSyslogParser() {
+  return std::make_unique<LogParserSyslog>();
+}
+
+}  // namespace
+
+class BulkLogReaderTest : public ::testing::Test {
+ public:
+  BulkLogReaderTest() = default;
+  BulkLogReaderTest(const BulkLogReaderTest&) = delete;
+  BulkLogReaderTest& operator=(const BulkLogReaderTest&) = delete;
+
+  void TearDown() override { BulkLogReader::SetChunkSizeForTest(1024 * 1024); }
+
+  // Reads |log_file| with both BulkLogReader and LogEntryReader, and checks
+  // the entries are identical.
+  void ExpectSameAsLogEntryReader(const base::FilePath& log_file,
+                                  int num_threads) {
+    BulkLogReader bulk_reader(
+        log_file, base::BindRepeating(&CreateSyslogParser), num_threads);
+    LogEntryReader reader(log_file, CreateSyslogParser(), false);
+
+    while (true) {
+      MaybeLogEntry expected = reader.GetNextEntry();
+      MaybeLogEntry actual = bulk_reader.GetNextEntry();
+      ASSERT_EQ(expected.has_value(), actual.has_value());
+      if (!expected.has_value())
+        break;
+      EXPECT_EQ(expected->pid(), actual->pid());
+      EXPECT_EQ(expected->time(), actual->time());
+      EXPECT_EQ(expected->message(), actual->message());
+      EXPECT_EQ(expected->entire_line(), actual->entire_line());
+    }
+  }
+};
+
+TEST_F(BulkLogReaderTest, MultilineLog) {
+  // Chunks of a few bytes split the multi-line entries.
+  for (int64_t chunk_size : {1, 7, 30, 1024 * 1024}) {
+    BulkLogReader::SetChunkSizeForTest(chunk_size);
+    for (int num_threads : {1, 3}) {
+      SCOPED_TRACE(base::StringPrintf("chunk_size=%" PRId64 " num_threads=%d",
+                                      chunk_size, num_threads));
+      ExpectSameAsLogEntryReader(
+          base::FilePath("./testdata/TEST_MULTILINE_LOG"), num_threads);
+    }
+  }
+}
+
+TEST_F(BulkLogReaderTest, LargeLog) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath log_file = temp_dir.GetPath().Append("messages");
+
+  std::string content;
+  for (int i = 0; i < 1000; i++) {
+    base::StringAppendF(&content,
+                        "2020-05-25T14:%02d:%02d.%06dZ INFO chrome[%d]: "
+                        "This is log line %d.\n",
+                        i / 600, i / 10 % 60, i % 10, 1000 + i, i);
+    if (i % 7 == 0)
+      content += "continued line\n";
+  }
+  // The last line without LF is not read.
+  content += "2020-05-25T15:00:00.000000Z INFO chrome[1]: Being written";
+  ASSERT_TRUE(base::WriteFile(log_file, content));
+
+  BulkLogReader::SetChunkSizeForTest(1000);
+  ExpectSameAsLogEntryReader(log_file, 4);
+}
+
+TEST_F(BulkLogReaderTest, EmptyFile) {
+  BulkLogReader reader(base::FilePath("./testdata/TEST_EMPTY_FILE"),
+                       base::BindRepeating(&CreateSyslogParser), 2);
+  EXPECT_FALSE(reader.GetNextEntry().has_value());
+}
+
+TEST_F(BulkLogReaderTest, Multiplexer) {
+  BulkMultiplexer multiplexer(2);
+  multiplexer.AddSource(base::FilePath("./testdata/TEST_NORMAL_LOG1"),
+                        base::BindRepeating(&CreateSyslogParser));
+  multiplexer.AddSource(base::FilePath("./testdata/TEST_NORMAL_LOG2"),
+                        base::BindRepeating(&CreateSyslogParser));
+
+  for (int pid : {5963, 5964, 5965, 5966}) {
+    MaybeLogEntry e = multiplexer.Forward();
+    ASSERT_TRUE(e.has_value());
+    EXPECT_EQ(pid, e->pid());
+  }
+  EXPECT_FALSE(multiplexer.Forward().has_value());
+}
+
+}  // namespace croslog
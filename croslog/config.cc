@@ -4,11 +4,13 @@
 
 #include "croslog/config.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
 #include <base/strings/string_util.h>
+#include <base/system/sys_info.h>
 #include <brillo/flag_helper.h>
 
 #include "croslog/relative_time_util.h"
@@ -27,6 +29,10 @@ bool Config::ParseCommandLineArgs(int argc, const char* const argv[]) {
   DEFINE_string(cursor, "", "Show logs starting from the specified cursor.");
   DEFINE_bool(quiet, false, "Suppress informational messages.");
   DEFINE_bool(follow, false, "Show continiously new logs as they are written.");
+  DEFINE_int32(jobs, 0,
+               "Number of threads to parse logs with, when all logs are shown "
+               "without --follow, --lines or --since. 0 uses one per CPU, up "
+               "to 4.");
   DEFINE_string(
       since, "",
       "Show entries not older than the specified date in YYYY-MM-DD "
@@ -143,6 +149,14 @@ bool Config::ParseCommandLineArgs(int argc, const char* const argv[]) {
     result = false;
   }
 
+  jobs = FLAGS_jobs;
+  if (jobs == 0) {
+    jobs = std::min(base::SysInfo::NumberOfProcessors(), kMaxDefaultJobs);
+  } else if (jobs < 0) {
+    LOG(ERROR) << "--jobs argument value must not be negative.";
+    result = false;
+  }
+
   // "--boot" distinguishes an empty argument and undefined.
   if (command_line->HasSwitch("boot")) {
     boot = FLAGS_boot;
@@ -19,6 +19,9 @@ enum class SourceMode { JOURNAL_LOG, PLAINTEXT_LOG };
 enum class OutputMode { SHORT, EXPORT, JSON };
 
 struct Config {
+  // Largest number of threads used to parse logs when --jobs isn't given.
+  static constexpr int kMaxDefaultJobs = 4;
+
   bool ParseCommandLineArgs(int argc, const char* const argv[]);
 
   // Source of logs: see |SourceMode| enum class.
@@ -55,6 +58,9 @@ struct Config {
   base::Time since;
   // Time to show entries not newer than (in UTC).
   base::Time until;
+  // Number of threads to parse logs with, when all logs are dumped at once.
+  // ParseCommandLineArgs() defaults it to one per CPU, up to |kMaxDefaultJobs|.
+  int jobs = 1;
 };
 
 }  // namespace croslog
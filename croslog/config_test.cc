@@ -4,9 +4,11 @@
 
 #include "croslog/config.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <base/files/file_path.h>
+#include <base/system/sys_info.h>
 #include <brillo/flag_helper.h>
 #include <gtest/gtest.h>
 
@@ -148,4 +150,35 @@ TEST_F(ParseCommandLineTest, ParseSince) {
   }
 }
 
+TEST_F(ParseCommandLineTest, ParseJobs) {
+  {
+    Config config;
+    std::vector<const char*> args = {kCrosLogPath};
+    EXPECT_TRUE(config.ParseCommandLineArgs(args.size(), args.data()));
+    EXPECT_EQ(std::min(base::SysInfo::NumberOfProcessors(),
+                       Config::kMaxDefaultJobs),
+              config.jobs);
+  }
+
+  {
+    Config config;
+    std::vector<const char*> args = {kCrosLogPath, "--jobs=4"};
+    EXPECT_TRUE(config.ParseCommandLineArgs(args.size(), args.data()));
+    EXPECT_EQ(4, config.jobs);
+  }
+
+  {
+    Config config;
+    std::vector<const char*> args = {kCrosLogPath, "--jobs=1"};
+    EXPECT_TRUE(config.ParseCommandLineArgs(args.size(), args.data()));
+    EXPECT_EQ(1, config.jobs);
+  }
+
+  {
+    Config config;
+    std::vector<const char*> args = {kCrosLogPath, "--jobs=-1"};
+    EXPECT_FALSE(config.ParseCommandLineArgs(args.size(), args.data()));
+  }
+}
+
 }  // namespace croslog
@@ -0,0 +1,83 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "croslog/line_scanner.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace croslog {
+
+namespace {
+
+constexpr uint8_t kLineFeed = '\n';
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+// Number of bytes compared at once.
+constexpr uint64_t kBlockSize = 16;
+
+#if defined(__SSE2__)
+// Number of bits in the mask per byte of the block.
+constexpr int kMaskBitsPerByte = 1;
+#else
+constexpr int kMaskBitsPerByte = 4;
+#endif
+
+// Returns a bitmask where the bits for |block[N]| are set if it is LF. Each
+// byte takes |kMaskBitsPerByte| bits.
+inline uint64_t LineFeedMask(const uint8_t* block) {
+#if defined(__SSE2__)
+  const __m128i chars =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+  const __m128i matches = _mm_cmpeq_epi8(chars, _mm_set1_epi8(kLineFeed));
+  return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+#else
+  // NEON doesn't have movemask. Narrows each matched byte to a nibble.
+  const uint8x16_t matches = vceqq_u8(vld1q_u8(block), vdupq_n_u8(kLineFeed));
+  return vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+#endif
+}
+#endif
+
+}  // namespace
+
+uint64_t FindFirstLineFeed(const uint8_t* buffer, uint64_t length) {
+  uint64_t i = 0;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+    const uint64_t mask = LineFeedMask(buffer + i);
+    if (mask != 0)
+      return i + __builtin_ctzll(mask) / kMaskBitsPerByte;
+  }
+#endif
+  // Scalar fallback, also used for the tail.
+  for (; i < length; i++) {
+    if (buffer[i] == kLineFeed)
+      return i;
+  }
+  return length;
+}
+
+uint64_t FindLastLineFeed(const uint8_t* buffer, uint64_t length) {
+  uint64_t i = length;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+  for (; i >= kBlockSize; i -= kBlockSize) {
+    const uint64_t mask = LineFeedMask(buffer + i - kBlockSize);
+    if (mask != 0)
+      return i - kBlockSize + (63 - __builtin_clzll(mask)) / kMaskBitsPerByte;
+  }
+#endif
+  // Scalar fallback, also used for the head.
+  for (; i > 0; i--) {
+    if (buffer[i - 1] == kLineFeed)
+      return i - 1;
+  }
+  return length;
+}
+
+}  // namespace croslog
@@ -0,0 +1,22 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CROSLOG_LINE_SCANNER_H_
+#define CROSLOG_LINE_SCANNER_H_
+
+#include <stdint.h>
+
+namespace croslog {
+
+// Returns the index of the first LF in |buffer[0, length)|, or |length| if
+// there is no LF. This is vectorized with SSE2 or NEON when available.
+uint64_t FindFirstLineFeed(const uint8_t* buffer, uint64_t length);
+
+// Returns the index of the last LF in |buffer[0, length)|, or |length| if
+// there is no LF. This is vectorized with SSE2 or NEON when available.
+uint64_t FindLastLineFeed(const uint8_t* buffer, uint64_t length);
+
+}  // namespace croslog
+
+#endif  // CROSLOG_LINE_SCANNER_H_
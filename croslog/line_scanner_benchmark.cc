@@ -0,0 +1,99 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Microbenchmark of the line scanning and reading. The numbers of lines read
+// per second are reported as "items_per_second".
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "base/strings/stringprintf.h"
+
+#include "croslog/line_scanner.h"
+#include "croslog/log_line_reader.h"
+
+namespace croslog {
+
+namespace {
+
+// Generates a syslog-like content with |num_lines| lines.
+std::string GenerateLog(int num_lines) {
+  std::string log;
+  for (int i = 0; i < num_lines; i++) {
+    base::StringAppendF(&log,
+                        "2020-05-25T14:15:22.%06d+09:00 INFO chrome[%d]: "
+                        "[%d:%d:0525/141522.%06d:INFO:example.cc(%d)] "
+                        "This is a log line for the benchmark.\n",
+                        i % 1000000, 1000 + i % 100, i, i, i % 1000000, i);
+  }
+  return log;
+}
+
+constexpr int kNumLines = 100000;
+
+}  // namespace
+
+static void BM_FindFirstLineFeed(benchmark::State& state) {
+  const std::string log = GenerateLog(kNumLines);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(log.data());
+  for (auto _ : state) {
+    uint64_t pos = 0;
+    while (pos < log.size())
+      pos += FindFirstLineFeed(data + pos, log.size() - pos) + 1;
+    benchmark::DoNotOptimize(pos);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLines);
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_FindFirstLineFeed);
+
+static void BM_FindLastLineFeed(benchmark::State& state) {
+  const std::string log = GenerateLog(kNumLines);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(log.data());
+  for (auto _ : state) {
+    uint64_t end = log.size() - 1;
+    while (end > 0) {
+      const uint64_t lf = FindLastLineFeed(data, end);
+      end = (lf == end) ? 0 : lf;
+    }
+    benchmark::DoNotOptimize(end);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLines);
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_FindLastLineFeed);
+
+static void BM_LogLineReaderForward(benchmark::State& state) {
+  const std::string log = GenerateLog(kNumLines);
+  for (auto _ : state) {
+    LogLineReader reader(LogLineReader::Backend::MEMORY_FOR_TEST);
+    reader.OpenMemoryBufferForTest(log.data(), log.size());
+    while (std::get<1>(reader.Forward()) ==
+           LogLineReader::ReadResult::NO_ERROR) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLines);
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_LogLineReaderForward);
+
+static void BM_LogLineReaderBackward(benchmark::State& state) {
+  const std::string log = GenerateLog(kNumLines);
+  for (auto _ : state) {
+    LogLineReader reader(LogLineReader::Backend::MEMORY_FOR_TEST);
+    reader.OpenMemoryBufferForTest(log.data(), log.size());
+    reader.SetPositionLast();
+    while (std::get<1>(reader.Backward()) ==
+           LogLineReader::ReadResult::NO_ERROR) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLines);
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_LogLineReaderBackward);
+
+}  // namespace croslog
+
+BENCHMARK_MAIN();
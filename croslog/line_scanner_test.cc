@@ -0,0 +1,56 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "croslog/line_scanner.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace croslog {
+
+namespace {
+
+const uint8_t* AsBytes(const std::string& str) {
+  return reinterpret_cast<const uint8_t*>(str.data());
+}
+
+}  // namespace
+
+TEST(LineScannerTest, Empty) {
+  EXPECT_EQ(0u, FindFirstLineFeed(nullptr, 0));
+  EXPECT_EQ(0u, FindLastLineFeed(nullptr, 0));
+}
+
+TEST(LineScannerTest, NoLineFeed) {
+  const std::string str(100, 'a');
+  EXPECT_EQ(str.size(), FindFirstLineFeed(AsBytes(str), str.size()));
+  EXPECT_EQ(str.size(), FindLastLineFeed(AsBytes(str), str.size()));
+}
+
+TEST(LineScannerTest, EveryPosition) {
+  // Covers the positions in the vectorized blocks and the scalar remainder,
+  // with several lengths which are not multiple of the block size.
+  for (size_t length = 1; length < 70; length++) {
+    for (size_t pos = 0; pos < length; pos++) {
+      std::string str(length, 'a');
+      str[pos] = '\n';
+      EXPECT_EQ(pos, FindFirstLineFeed(AsBytes(str), length));
+      EXPECT_EQ(pos, FindLastLineFeed(AsBytes(str), length));
+    }
+  }
+}
+
+TEST(LineScannerTest, MultipleLineFeeds) {
+  const std::string str =
+      "first line\nsecond line which is longer than a block\nthird\nlast";
+  EXPECT_EQ(10u, FindFirstLineFeed(AsBytes(str), str.size()));
+  EXPECT_EQ(str.rfind('\n'), FindLastLineFeed(AsBytes(str), str.size()));
+
+  // The search doesn't go beyond the given length.
+  EXPECT_EQ(5u, FindFirstLineFeed(AsBytes(str), 5));
+  EXPECT_EQ(10u, FindLastLineFeed(AsBytes(str), 20));
+}
+
+}  // namespace croslog
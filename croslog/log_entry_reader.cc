@@ -4,6 +4,7 @@
 
 #include "croslog/log_entry_reader.h"
 
+#include <algorithm>
 #include <list>
 #include <optional>
 #include <utility>
@@ -20,7 +21,8 @@ LogEntryReader::LogEntryReader(base::FilePath log_file,
     : file_path_(log_file),
       line_reader_(install_change_watcher ? LogLineReader::Backend::FILE_FOLLOW
                                           : LogLineReader::Backend::FILE),
-      parser_(std::move(parser_in)) {
+      parser_(std::move(parser_in)),
+      index_(log_file) {
   line_reader_.OpenFile(std::move(log_file));
 }
 
@@ -105,6 +107,67 @@ void LogEntryReader::SetPositionLast() {
   line_reader_.SetPositionLast();
 }
 
+void LogEntryReader::SeekToTime(base::Time time) {
+  UpdateIndex();
+
+  next_entry_.reset();
+  line_reader_.SetPosition(index_.FindOffsetBefore(time));
+}
+
+void LogEntryReader::UpdateIndex() {
+  const int64_t file_size = line_reader_.file_size();
+  const ino_t inode = line_reader_.file_inode();
+  if (!index_loaded_) {
+    index_.Load(inode, file_size);
+    index_loaded_ = true;
+  } else if (index_.inode() != inode) {
+    // The file has been rotated and reopened.
+    index_.Reset(inode);
+  }
+
+  if (index_.indexed_size() >= file_size)
+    return;
+
+  const int64_t interval = LogIndex::interval();
+  const size_t previous_num_entries = index_.entries().size();
+  const int64_t original_position = line_reader_.position();
+
+  // Indexes the first entry after each boundary of |interval| bytes.
+  int64_t last_offset =
+      index_.entries().empty() ? -1 : index_.entries().back().offset;
+  int64_t boundary =
+      (last_offset < 0) ? 0 : (last_offset / interval + 1) * interval;
+  while (boundary < file_size) {
+    line_reader_.SetPosition(boundary);
+
+    while (line_reader_.position() < file_size) {
+      const int64_t line_start = line_reader_.position();
+      auto [line, result] = line_reader_.Forward();
+      if (result != LogLineReader::ReadResult::NO_ERROR)
+        break;
+      // The line may start before the boundary and be indexed already.
+      if (line_start <= last_offset)
+        continue;
+
+      MaybeLogEntry entry = parser_->Parse(std::move(line));
+      if (entry.has_value()) {
+        index_.Append(line_start, entry->time());
+        last_offset = line_start;
+        break;
+      }
+    }
+
+    boundary =
+        (std::max(line_reader_.position(), boundary) / interval + 1) * interval;
+  }
+
+  index_.set_indexed_size(file_size);
+  line_reader_.SetPosition(original_position);
+
+  if (index_.entries().size() != previous_num_entries)
+    index_.Save();
+}
+
 void LogEntryReader::AddObserver(LogLineReader::Observer* obs) {
   line_reader_.AddObserver(obs);
 }
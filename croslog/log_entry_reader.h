@@ -12,6 +12,7 @@
 #include "base/files/file_path.h"
 
 #include "croslog/log_entry.h"
+#include "croslog/log_index.h"
 #include "croslog/log_line_reader.h"
 #include "croslog/log_parser.h"
 
@@ -40,6 +41,13 @@ class LogEntryReader {
 
   // Moves the current position to the current end of the file.
   void SetPositionLast();
+  // Moves the current position to an entry shortly before |time|, so that the
+  // next GetNextEntry() doesn't need to parse the whole file to reach |time|.
+  void SeekToTime(base::Time time);
+
+  // Extends the timestamp index to cover the current end of the file, and
+  // persists it if new entries are added. The current position is kept.
+  void UpdateIndex();
 
   // Returns the file path of the target.
   const base::FilePath& file_path() const { return file_path_; }
@@ -54,6 +62,9 @@ class LogEntryReader {
   LogLineReader line_reader_;
   MaybeLogEntry next_entry_;
   std::unique_ptr<LogParser> parser_;
+
+  LogIndex index_;
+  bool index_loaded_ = false;
 };
 
 }  // namespace croslog
@@ -4,11 +4,18 @@
 
 #include "croslog/multiplexer.h"
 
+#include <string>
+
 #include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/strings/stringprintf.h>
 #include <gtest/gtest.h>
 
 #include "croslog/log_entry_reader.h"
+#include "croslog/log_index.h"
 #include "croslog/log_parser_syslog.h"
+#include "croslog/test_util.h"
 
 namespace croslog {
 
@@ -110,4 +117,53 @@ TEST_F(LogEntryReaderTest, InterleaveGetNextEntryAndGetPreviousEntry) {
   EXPECT_FALSE(reader.GetNextEntry().has_value());
 }
 
+TEST_F(LogEntryReaderTest, SeekToTime) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath log_file = temp_dir.GetPath().Append("messages");
+
+  // Prepares a log with one entry per second.
+  std::string content;
+  for (int i = 0; i < 100; i++) {
+    base::StringAppendF(&content,
+                        "2020-05-25T14:%02d:%02d.000000+09:00 INFO "
+                        "chrome[%d]: This is log line %d.\n",
+                        i / 60, i % 60, 1000 + i, i);
+  }
+  ASSERT_TRUE(base::WriteFile(log_file, content));
+
+  LogIndex::SetIntervalForTest(256);
+
+  {
+    LogEntryReader reader(log_file, std::make_unique<LogParserSyslog>(), false);
+    // 14:01:10 is the time of the 70th entry.
+    reader.SeekToTime(TimeFromExploded(2020, 5, 25, 14, 1, 10, 0, 9));
+
+    MaybeLogEntry e = reader.GetNextEntry();
+    ASSERT_TRUE(e.has_value());
+    // The reader is placed shortly before the specified time.
+    EXPECT_LT(e->pid(), 1070);
+    EXPECT_GT(e->pid(), 1060);
+
+    // The entries are read sequentially from there.
+    int pid = e->pid();
+    for (e = reader.GetNextEntry(); e.has_value(); e = reader.GetNextEntry())
+      EXPECT_EQ(++pid, e->pid());
+    EXPECT_EQ(1099, pid);
+  }
+
+  // The index is persisted next to the log file and reused.
+  EXPECT_TRUE(base::PathExists(LogIndex::GetIndexPath(log_file)));
+  {
+    LogEntryReader reader(log_file, std::make_unique<LogParserSyslog>(), false);
+    reader.SeekToTime(TimeFromExploded(2020, 5, 25, 14, 0, 0, 0, 9));
+
+    MaybeLogEntry e = reader.GetNextEntry();
+    ASSERT_TRUE(e.has_value());
+    EXPECT_EQ(1000, e->pid());
+  }
+
+  LogIndex::SetIntervalForTest(128 * 1024);
+}
+
 }  // namespace croslog
@@ -0,0 +1,149 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "croslog/log_index.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+
+#include <base/check_op.h>
+#include <base/logging.h>
+
+namespace croslog {
+
+namespace {
+
+// Interval between index entries in bytes.
+static int64_t g_index_interval = 128 * 1024;
+
+// Upper limit of the size of the index file, to avoid reading a broken file.
+constexpr int64_t kMaxIndexFileSize = 4 * 1024 * 1024;
+
+constexpr char kIndexFileSuffix[] = ".croslog-index";
+constexpr char kIndexFileHeader[] = "croslog-index-v1";
+
+}  // namespace
+
+// static
+base::FilePath LogIndex::GetIndexPath(const base::FilePath& log_file) {
+  return log_file.AddExtension(kIndexFileSuffix);
+}
+
+// static
+void LogIndex::SetIntervalForTest(int64_t interval) {
+  CHECK_GT(interval, 0);
+  g_index_interval = interval;
+}
+
+// static
+int64_t LogIndex::interval() {
+  return g_index_interval;
+}
+
+LogIndex::LogIndex(const base::FilePath& log_file)
+    : index_path_(GetIndexPath(log_file)) {}
+
+bool LogIndex::Load(ino_t inode, int64_t file_size) {
+  Reset(inode);
+
+  std::string content;
+  if (!base::ReadFileToStringWithMaxSize(index_path_, &content,
+                                         kMaxIndexFileSize)) {
+    return false;
+  }
+
+  std::vector<base::StringPiece> lines = base::SplitStringPiece(
+      content, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  // The first two lines are the header and "<inode> <indexed size>".
+  if (lines.size() < 2 || lines[0] != kIndexFileHeader)
+    return false;
+
+  std::vector<LogIndex::Entry> entries;
+  int64_t values[2];
+  for (size_t i = 1; i < lines.size(); i++) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        lines[i], " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.size() != 2 || !base::StringToInt64(fields[0], &values[0]) ||
+        !base::StringToInt64(fields[1], &values[1])) {
+      LOG(WARNING) << "Ignoring broken log index: " << index_path_;
+      return false;
+    }
+
+    if (i == 1) {
+      // The index is for another file, or the file has been truncated.
+      if (values[0] != static_cast<int64_t>(inode) || values[1] < 0 ||
+          values[1] > file_size) {
+        return false;
+      }
+      indexed_size_ = values[1];
+      continue;
+    }
+
+    if (values[0] < 0 || values[0] >= indexed_size_ ||
+        (!entries.empty() && entries.back().offset >= values[0])) {
+      LOG(WARNING) << "Ignoring broken log index: " << index_path_;
+      indexed_size_ = 0;
+      return false;
+    }
+    entries.push_back(
+        {values[0], base::Time::FromDeltaSinceWindowsEpoch(
+                        base::Microseconds(values[1]))});
+  }
+
+  entries_ = std::move(entries);
+  return true;
+}
+
+bool LogIndex::Save() const {
+  std::string content = kIndexFileHeader;
+  content += "\n";
+  base::StringAppendF(&content, "%" PRId64 " %" PRId64 "\n",
+                      static_cast<int64_t>(inode_), indexed_size_);
+  for (const auto& entry : entries_) {
+    base::StringAppendF(
+        &content, "%" PRId64 " %" PRId64 "\n", entry.offset,
+        entry.time.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  }
+
+  if (!base::ImportantFileWriter::WriteFileAtomically(index_path_, content)) {
+    VLOG(1) << "Failed to save the log index: " << index_path_;
+    return false;
+  }
+  return true;
+}
+
+void LogIndex::Reset(ino_t inode) {
+  inode_ = inode;
+  indexed_size_ = 0;
+  entries_.clear();
+}
+
+void LogIndex::Append(int64_t offset, base::Time time) {
+  DCHECK(entries_.empty() || entries_.back().offset < offset);
+  entries_.push_back({offset, time});
+}
+
+int64_t LogIndex::FindOffsetBefore(base::Time time) const {
+  // Finds the first entry whose time is not before |time|. The entry just
+  // before it is the last one which is surely older than |time|.
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), time,
+      [](const Entry& entry, base::Time t) { return entry.time < t; });
+  if (it == entries_.begin())
+    return 0;
+  return std::prev(it)->offset;
+}
+
+}  // namespace croslog
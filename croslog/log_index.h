@@ -0,0 +1,83 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CROSLOG_LOG_INDEX_H_
+#define CROSLOG_LOG_INDEX_H_
+
+#include <sys/types.h>
+
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/time/time.h"
+
+namespace croslog {
+
+// A sparse index from timestamps to byte offsets in a log file.
+// How to use:
+// - Call Load() to restore the index persisted next to the log file.
+// - Call Append() for the first entry found after every |interval()| bytes
+//   beyond |indexed_size()|, then update |indexed_size()|.
+// - Call FindOffsetBefore() to get the position to start reading from.
+// Requisites:
+// - The log file is append-only and its timestamps are (mostly) monotonic. An
+//   out-of-order entry only makes the search start earlier than necessary.
+class LogIndex {
+ public:
+  struct Entry {
+    // Offset of the first line of an entry.
+    int64_t offset;
+    // Timestamp of the entry.
+    base::Time time;
+  };
+
+  // Returns the path of the file where the index of |log_file| is persisted.
+  static base::FilePath GetIndexPath(const base::FilePath& log_file);
+
+  // Sets the interval between index entries in bytes for test.
+  static void SetIntervalForTest(int64_t interval);
+  // Returns the interval between index entries in bytes.
+  static int64_t interval();
+
+  explicit LogIndex(const base::FilePath& log_file);
+  LogIndex(const LogIndex&) = delete;
+  LogIndex& operator=(const LogIndex&) = delete;
+
+  // Restores the persisted index. The index is reset and false is returned
+  // if the persisted one is missing, broken or for another file (eg. it was
+  // written before rotation).
+  bool Load(ino_t inode, int64_t file_size);
+  // Persists the index next to the log file. This is best-effort, since the
+  // directory may not be writable by the current user.
+  bool Save() const;
+
+  // Clears all entries and associates the index with |inode|.
+  void Reset(ino_t inode);
+
+  // Adds an entry. |offset| must be larger than that of the last entry.
+  void Append(int64_t offset, base::Time time);
+
+  // Returns the offset of the last entry whose time is before |time|, or 0 if
+  // there is no such entry.
+  int64_t FindOffsetBefore(base::Time time) const;
+
+  // Returns the inode of the file which the index is associated with.
+  ino_t inode() const { return inode_; }
+
+  // The file has been scanned up to this offset.
+  int64_t indexed_size() const { return indexed_size_; }
+  void set_indexed_size(int64_t indexed_size) { indexed_size_ = indexed_size; }
+
+  const std::vector<Entry>& entries() const { return entries_; }
+
+ private:
+  const base::FilePath index_path_;
+  ino_t inode_ = 0;
+  int64_t indexed_size_ = 0;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace croslog
+
+#endif  // CROSLOG_LOG_INDEX_H_
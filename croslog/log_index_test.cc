@@ -0,0 +1,104 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "croslog/log_index.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "gtest/gtest.h"
+
+#include "croslog/test_util.h"
+
+namespace croslog {
+
+class LogIndexTest : public ::testing::Test {
+ public:
+  LogIndexTest() = default;
+  LogIndexTest(const LogIndexTest&) = delete;
+  LogIndexTest& operator=(const LogIndexTest&) = delete;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    log_file_ = temp_dir_.GetPath().Append("messages");
+  }
+
+ protected:
+  base::ScopedTempDir temp_dir_;
+  base::FilePath log_file_;
+};
+
+TEST_F(LogIndexTest, FindOffsetBefore) {
+  LogIndex index(log_file_);
+  index.Reset(1);
+  EXPECT_EQ(0, index.FindOffsetBefore(TimeFromExploded(2020, 5, 25, 0, 0, 0)));
+
+  index.Append(0, TimeFromExploded(2020, 5, 25, 14, 0, 0));
+  index.Append(100, TimeFromExploded(2020, 5, 25, 15, 0, 0));
+  index.Append(200, TimeFromExploded(2020, 5, 25, 16, 0, 0));
+
+  EXPECT_EQ(0, index.FindOffsetBefore(TimeFromExploded(2020, 5, 25, 13, 0, 0)));
+  EXPECT_EQ(0, index.FindOffsetBefore(TimeFromExploded(2020, 5, 25, 14, 0, 0)));
+  EXPECT_EQ(0,
+            index.FindOffsetBefore(TimeFromExploded(2020, 5, 25, 14, 30, 0)));
+  EXPECT_EQ(0, index.FindOffsetBefore(TimeFromExploded(2020, 5, 25, 15, 0, 0)));
+  EXPECT_EQ(100,
+            index.FindOffsetBefore(TimeFromExploded(2020, 5, 25, 15, 30, 0)));
+  EXPECT_EQ(200,
+            index.FindOffsetBefore(TimeFromExploded(2020, 5, 25, 17, 0, 0)));
+}
+
+TEST_F(LogIndexTest, SaveAndLoad) {
+  {
+    LogIndex index(log_file_);
+    index.Reset(1234);
+    index.Append(0, TimeFromExploded(2020, 5, 25, 14, 0, 0));
+    index.Append(100, TimeFromExploded(2020, 5, 25, 15, 0, 0, 123456));
+    index.set_indexed_size(150);
+    EXPECT_TRUE(index.Save());
+  }
+  EXPECT_TRUE(base::PathExists(LogIndex::GetIndexPath(log_file_)));
+
+  {
+    LogIndex index(log_file_);
+    EXPECT_TRUE(index.Load(1234, 150));
+    EXPECT_EQ(150, index.indexed_size());
+    ASSERT_EQ(2u, index.entries().size());
+    EXPECT_EQ(0, index.entries()[0].offset);
+    EXPECT_EQ(TimeFromExploded(2020, 5, 25, 14, 0, 0),
+              index.entries()[0].time);
+    EXPECT_EQ(100, index.entries()[1].offset);
+    EXPECT_EQ(TimeFromExploded(2020, 5, 25, 15, 0, 0, 123456),
+              index.entries()[1].time);
+  }
+
+  // The file was rotated.
+  {
+    LogIndex index(log_file_);
+    EXPECT_FALSE(index.Load(5678, 150));
+    EXPECT_EQ(0, index.indexed_size());
+    EXPECT_TRUE(index.entries().empty());
+  }
+
+  // The file was truncated.
+  {
+    LogIndex index(log_file_);
+    EXPECT_FALSE(index.Load(1234, 149));
+    EXPECT_TRUE(index.entries().empty());
+  }
+}
+
+TEST_F(LogIndexTest, LoadBrokenIndex) {
+  ASSERT_TRUE(base::WriteFile(LogIndex::GetIndexPath(log_file_),
+                              "croslog-index-v1\n1234 150\n100 0\n0 0\n"));
+
+  LogIndex index(log_file_);
+  EXPECT_FALSE(index.Load(1234, 150));
+  EXPECT_EQ(0, index.indexed_size());
+  EXPECT_TRUE(index.entries().empty());
+}
+
+}  // namespace croslog
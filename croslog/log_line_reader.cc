@@ -19,6 +19,7 @@
 #include "base/strings/string_util.h"
 
 #include "croslog/file_map_reader.h"
+#include "croslog/line_scanner.h"
 
 #include <base/check.h>
 #include <base/check_op.h>
@@ -92,28 +93,34 @@ void LogLineReader::OpenMemoryBufferForTest(const char* buffer, size_t size) {
 }
 
 void LogLineReader::SetPositionLast() {
-  // At first, sets the position to EOF.
-  pos_ = reader_->GetFileSize();
-  DCHECK_LE(0, pos_);
+  SetPosition(reader_->GetFileSize());
+}
+
+void LogLineReader::SetPosition(int64_t pos) {
+  CHECK_GE(pos, 0);
+  CHECK_LE(pos, reader_->GetFileSize());
+  pos_ = pos;
 
   // Calculates the maximum traversable range in the file and allocate a buffer.
   int64_t pos_traversal_start = std::max(pos_ - g_max_line_length, INT64_C(0));
-  int64_t traversal_length = std::min(g_max_line_length, pos_);
+  int64_t traversal_length = pos_ - pos_traversal_start;
 
-  // Allocates a buffer of the segment from |pos_traversal_start| to EOF.
+  // Allocates a buffer of the segment from |pos_traversal_start| to |pos|.
   auto buffer = reader_->MapBuffer(pos_traversal_start, traversal_length);
   CHECK(buffer->valid()) << "Mmap failed. Maybe the file has been truncated.";
 
   // Traverses in reverse order to find the last LF.
-  while (pos_ > pos_traversal_start && buffer->GetChar(pos_ - 1) != '\n')
-    pos_--;
+  auto [data, data_length] =
+      buffer->GetBuffer(pos_traversal_start, traversal_length);
+  const uint64_t last_lf = FindLastLineFeed(data, data_length);
+  pos_ = pos_traversal_start + (last_lf == data_length ? 0 : last_lf + 1);
 
   if (pos_ != 0 && pos_ <= pos_traversal_start) {
-    LOG(ERROR) << "The last line is too long to handle (more than: "
+    LOG(ERROR) << "The line is too long to handle (more than: "
                << g_max_line_length
                << "bytes). Lines around here may be broken.";
-    // Sets the position to the last as a sloppy solution.
-    pos_ = reader_->GetFileSize();
+    // Sets the position to the given one as a sloppy solution.
+    pos_ = pos;
   }
 }
 
@@ -184,12 +191,9 @@ std::tuple<std::string, LogLineReader::ReadResult> LogLineReader::Forward() {
   }
 
   // Finds the next LF (end of line).
-  int64_t pos_line_end = pos_;
-
-  while (pos_line_end < pos_traversal_end &&
-         buffer->GetChar(pos_line_end) != '\n') {
-    pos_line_end++;
-  }
+  auto [data, data_length] = buffer->GetBuffer(pos_, traversal_length);
+  int64_t pos_line_end = pos_ + FindFirstLineFeed(data, data_length);
+  DCHECK_LE(pos_line_end, pos_traversal_end);
 
   if (pos_line_end == reader_->GetFileSize()) {
     // Reaches EOF without '\n'.
@@ -262,12 +266,13 @@ std::tuple<std::string, LogLineReader::ReadResult> LogLineReader::Backward() {
                  << " The lines read may be broken.";
   }
 
-  // Finds the next LF (at the beginning of the line).
-  int64_t last_start = pos_ - 1;
-  while (last_start > pos_traversal_start &&
-         buffer->GetChar(last_start - 1) != '\n') {
-    last_start--;
-  }
+  // Finds the next LF (at the beginning of the line), excluding the LF at the
+  // end of the line.
+  auto [data, data_length] =
+      buffer->GetBuffer(pos_traversal_start, traversal_length - 1);
+  const uint64_t last_lf = FindLastLineFeed(data, data_length);
+  int64_t last_start =
+      pos_traversal_start + (last_lf == data_length ? 0 : last_lf + 1);
 
   // Ensures the next LF is found.
   if (last_start != 0 && last_start <= pos_traversal_start) {
@@ -70,6 +70,8 @@ class LogLineReader : public FileChangeWatcher::Observer {
 
   // Set the position to read last.
   void SetPositionLast();
+  // Set the position to the beginning of the line containing |pos|.
+  void SetPosition(int64_t pos);
   // Add a observer to retrieve file change events.
   void AddObserver(Observer* obs);
   // Remove a observer to retrieve file change events.
@@ -78,8 +80,13 @@ class LogLineReader : public FileChangeWatcher::Observer {
   // Retrieve the current position in bytes.
   off_t position() const { return pos_; }
 
+  // Retrieve the size of the file at (or shortly before) the last read.
+  int64_t file_size() const { return reader_->GetFileSize(); }
+
   // Returns the file path of the target.
   const base::FilePath& file_path() const { return file_path_; }
+  // Returns the inode of the target. This is 0 for MEMORY_FOR_TEST backend.
+  ino_t file_inode() const { return file_inode_; }
 
  private:
   void ReloadRotatedFile();
@@ -6,7 +6,6 @@
 
 #include <algorithm>
 #include <string>
-#include <vector>
 
 #include <base/files/file_enumerator.h>
 #include <base/files/file_util.h>
@@ -100,23 +99,21 @@ void LogRotator::CleanUpFiles(int max_index) {
 }
 
 void LogRotator::RotateLogFile(int max_index) {
-  std::vector<base::FileEnumerator::FileInfo> info;
-
-  base::FilePath max_index_path = GetFilePathWithIndex(max_index);
-  if (base::PathExists(max_index_path))
-    base::DeleteFile(max_index_path);
+  // DeleteFile() succeeds when the file doesn't exist.
+  base::DeleteFile(GetFilePathWithIndex(max_index));
 
   for (int i = (max_index - 1); i >= 0; --i) {
     base::FilePath old_path = GetFilePathWithIndex(i);
     base::FilePath new_path = GetFilePathWithIndex(i + 1);
 
-    if (!base::PathExists(old_path))
-      continue;
-
-    if (!base::Move(old_path, new_path)) {
+    // All the generations are in the same directory, so a plain rename is
+    // enough. A missing generation is not an error, which saves checking for
+    // each file beforehand.
+    base::File::Error error;
+    if (!base::ReplaceFile(old_path, new_path, &error) &&
+        error != base::File::FILE_ERROR_NOT_FOUND) {
       LOG(ERROR) << "File error while moving " << old_path << " to " << new_path
-                 << ": "
-                 << base::File::ErrorToString(base::File::GetLastFileError());
+                 << ": " << base::File::ErrorToString(error);
     }
   }
 
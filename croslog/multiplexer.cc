@@ -4,6 +4,7 @@
 
 #include "croslog/multiplexer.h"
 
+#include <algorithm>
 #include <optional>
 #include <utility>
 
@@ -15,20 +16,24 @@
 
 namespace croslog {
 
-Multiplexer::LogSource::LogSource(base::FilePath log_file,
+Multiplexer::LogSource::LogSource(size_t index,
+                                  base::FilePath log_file,
                                   std::unique_ptr<LogParser> parser_in,
                                   bool install_change_watcher)
-    : reader(log_file, std::move(parser_in), install_change_watcher) {}
+    : index(index),
+      reader(log_file, std::move(parser_in), install_change_watcher) {}
 
 Multiplexer::Multiplexer() = default;
 
 void Multiplexer::AddSource(base::FilePath log_file,
                             std::unique_ptr<LogParser> parser,
                             bool install_change_watcher) {
-  auto source = std::make_unique<LogSource>(
-      std::move(log_file), std::move(parser), install_change_watcher);
+  auto source =
+      std::make_unique<LogSource>(sources_.size(), std::move(log_file),
+                                  std::move(parser), install_change_watcher);
   source->reader.AddObserver(this);
   sources_.emplace_back(std::move(source));
+  heap_direction_ = Direction::NONE;
 }
 
 void Multiplexer::OnFileChanged(LogLineReader* reader) {
@@ -45,91 +50,127 @@ void Multiplexer::OnFileChanged(LogLineReader* reader) {
       source->cache_next_forward.reset();
       source->reader.GetPreviousEntry();
     }
+
+    // Extend the index to cover the appended logs.
+    source->reader.UpdateIndex();
   }
 
+  // The changed source may have new entries. Rebuild the heap on next read.
+  heap_direction_ = Direction::NONE;
+
   for (Observer& obs : observers_)
     obs.OnLogFileChanged();
 }
 
-MaybeLogEntry Multiplexer::Forward() {
-  for (auto&& source : sources_) {
-    if (source->cache_next_backward.has_value()) {
-      CHECK(!source->cache_next_forward.has_value());
-      source->cache_next_backward.reset();
-      source->reader.GetNextEntry();
-    }
+// static
+bool Multiplexer::CompareForward(const LogSource* a, const LogSource* b) {
+  // The oldest entry comes first. The former source wins on a tie.
+  const base::Time a_time = a->cache_next_forward->time();
+  const base::Time b_time = b->cache_next_forward->time();
+  if (a_time != b_time)
+    return a_time > b_time;
+  return a->index > b->index;
+}
 
-    if (!source->cache_next_forward.has_value()) {
-      MaybeLogEntry entry = source->reader.GetNextEntry();
-      if (!entry.has_value()) {
-        // No more entry from this source.
-        continue;
-      }
-      // Reading an entry succeeds. Use this.
-      source->cache_next_forward.emplace(std::move(*entry));
-    }
-  }
+// static
+bool Multiplexer::CompareBackward(const LogSource* a, const LogSource* b) {
+  // The newest entry comes first. The latter source wins on a tie.
+  const base::Time a_time = a->cache_next_backward->time();
+  const base::Time b_time = b->cache_next_backward->time();
+  if (a_time != b_time)
+    return a_time < b_time;
+  return a->index < b->index;
+}
 
-  Multiplexer::LogSource* next_source = nullptr;
+void Multiplexer::PrepareHeap(Direction direction) {
+  if (heap_direction_ == direction)
+    return;
+
+  heap_.clear();
   for (auto&& source : sources_) {
-    if (!source->cache_next_forward.has_value()) {
-      // This source doesn't have a next entry.
-      continue;
-    }
+    if (direction == Direction::FORWARD) {
+      if (source->cache_next_backward.has_value()) {
+        CHECK(!source->cache_next_forward.has_value());
+        source->cache_next_backward.reset();
+        source->reader.GetNextEntry();
+      }
+
+      if (!source->cache_next_forward.has_value()) {
+        MaybeLogEntry entry = source->reader.GetNextEntry();
+        if (!entry.has_value()) {
+          // No more entry from this source.
+          continue;
+        }
+        // Reading an entry succeeds. Use this.
+        source->cache_next_forward.emplace(std::move(*entry));
+      }
+    } else {
+      if (source->cache_next_forward.has_value()) {
+        CHECK(!source->cache_next_backward.has_value());
+        source->cache_next_forward.reset();
+        source->reader.GetPreviousEntry();
+      }
 
-    if (next_source == nullptr || next_source->cache_next_forward->time() >
-                                      source->cache_next_forward->time()) {
-      next_source = source.get();
+      if (!source->cache_next_backward.has_value()) {
+        MaybeLogEntry entry = source->reader.GetPreviousEntry();
+        if (!entry.has_value()) {
+          // No more entry from this source.
+          continue;
+        }
+        // Reading an entry succeeds. Use this.
+        source->cache_next_backward.emplace(std::move(*entry));
+      }
     }
+    heap_.push_back(source.get());
   }
 
-  if (next_source == nullptr) {
+  std::make_heap(heap_.begin(), heap_.end(),
+                 direction == Direction::FORWARD ? &CompareForward
+                                                 : &CompareBackward);
+  heap_direction_ = direction;
+}
+
+MaybeLogEntry Multiplexer::Forward() {
+  PrepareHeap(Direction::FORWARD);
+  if (heap_.empty())
     return std::nullopt;
-  }
 
+  std::pop_heap(heap_.begin(), heap_.end(), &CompareForward);
+  LogSource* next_source = heap_.back();
   MaybeLogEntry entry = std::move(next_source->cache_next_forward);
   next_source->cache_next_forward.reset();
-  return entry;
-}
 
-MaybeLogEntry Multiplexer::Backward() {
-  for (auto&& source : sources_) {
-    if (source->cache_next_forward.has_value()) {
-      CHECK(!source->cache_next_backward.has_value());
-      source->cache_next_forward.reset();
-      source->reader.GetPreviousEntry();
-    }
-
-    if (!source->cache_next_backward.has_value()) {
-      MaybeLogEntry entry = source->reader.GetPreviousEntry();
-      if (!entry.has_value()) {
-        // No more entry from this source.
-        continue;
-      }
-      // Reading an entry succeeds. Use this.
-      source->cache_next_backward.emplace(std::move(*entry));
-    }
+  // Refill the cache of the source and put it back to the heap.
+  MaybeLogEntry following_entry = next_source->reader.GetNextEntry();
+  if (following_entry.has_value()) {
+    next_source->cache_next_forward.emplace(std::move(*following_entry));
+    std::push_heap(heap_.begin(), heap_.end(), &CompareForward);
+  } else {
+    heap_.pop_back();
   }
 
-  Multiplexer::LogSource* next_source = nullptr;
-  for (auto&& source : sources_) {
-    if (!source->cache_next_backward.has_value()) {
-      // This source doesn't have a next entry.
-      continue;
-    }
-
-    if (next_source == nullptr || next_source->cache_next_backward->time() <=
-                                      source->cache_next_backward->time()) {
-      next_source = source.get();
-    }
-  }
+  return entry;
+}
 
-  if (next_source == nullptr) {
+MaybeLogEntry Multiplexer::Backward() {
+  PrepareHeap(Direction::BACKWARD);
+  if (heap_.empty())
     return std::nullopt;
-  }
 
+  std::pop_heap(heap_.begin(), heap_.end(), &CompareBackward);
+  LogSource* next_source = heap_.back();
   MaybeLogEntry entry = std::move(next_source->cache_next_backward);
   next_source->cache_next_backward.reset();
+
+  // Refill the cache of the source and put it back to the heap.
+  MaybeLogEntry preceding_entry = next_source->reader.GetPreviousEntry();
+  if (preceding_entry.has_value()) {
+    next_source->cache_next_backward.emplace(std::move(*preceding_entry));
+    std::push_heap(heap_.begin(), heap_.end(), &CompareBackward);
+  } else {
+    heap_.pop_back();
+  }
+
   return entry;
 }
 
@@ -147,6 +188,7 @@ void Multiplexer::SetLinesFromLast(uint32_t pos) {
     source->cache_next_forward.reset();
     source->reader.SetPositionLast();
   }
+  heap_direction_ = Direction::NONE;
 
   for (int i = 0; i < pos; i++) {
     MaybeLogEntry s = Backward();
@@ -155,4 +197,13 @@ void Multiplexer::SetLinesFromLast(uint32_t pos) {
   }
 }
 
+void Multiplexer::SeekToTime(base::Time time) {
+  for (auto& source : sources_) {
+    source->cache_next_backward.reset();
+    source->cache_next_forward.reset();
+    source->reader.SeekToTime(time);
+  }
+  heap_direction_ = Direction::NONE;
+}
+
 }  // namespace croslog
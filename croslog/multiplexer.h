@@ -12,6 +12,7 @@
 #include "base/files/file_path.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/time/time.h"
 
 #include "croslog/log_entry.h"
 #include "croslog/log_entry_reader.h"
@@ -45,6 +46,9 @@ class Multiplexer : public LogLineReader::Observer {
 
   // Set the position to read next.
   void SetLinesFromLast(uint32_t pos);
+  // Set the position to read next shortly before |time|, using the timestamp
+  // index of each source. Entries before |time| may still be returned.
+  void SeekToTime(base::Time time);
 
   // Add a observer to retrieve file change events.
   void AddObserver(Observer* obs);
@@ -53,18 +57,39 @@ class Multiplexer : public LogLineReader::Observer {
 
  private:
   struct LogSource {
-    LogSource(base::FilePath log_file,
+    LogSource(size_t index,
+              base::FilePath log_file,
               std::unique_ptr<LogParser> parser_in,
               bool install_change_watcher);
 
+    // Index in |sources_|, used to break ties of the timestamps.
+    const size_t index;
     LogEntryReader reader;
     MaybeLogEntry cache_next_forward;
     MaybeLogEntry cache_next_backward;
   };
 
+  // Direction of the last read. The heap is built for this direction.
+  enum class Direction {
+    NONE,
+    FORWARD,
+    BACKWARD,
+  };
+
   void OnFileChanged(LogLineReader* reader) override;
 
+  // Ensures every source has a cached entry for |direction| if available,
+  // and rebuilds the heap of the sources if the direction has changed.
+  void PrepareHeap(Direction direction);
+  // Returns true if the entry of |a| should be returned after that of |b|.
+  static bool CompareForward(const LogSource* a, const LogSource* b);
+  static bool CompareBackward(const LogSource* a, const LogSource* b);
+
   std::vector<std::unique_ptr<LogSource>> sources_;
+  // Heap of the sources which have a cached entry for |heap_direction_|. The
+  // top is the source of the entry to be returned next.
+  std::vector<LogSource*> heap_;
+  Direction heap_direction_ = Direction::NONE;
   base::ObserverList<Observer> observers_;
 };
 
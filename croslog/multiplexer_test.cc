@@ -4,7 +4,12 @@
 
 #include "croslog/multiplexer.h"
 
+#include <string>
+
 #include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/strings/stringprintf.h>
 #include <gtest/gtest.h>
 
 #include "croslog/log_parser_syslog.h"
@@ -152,4 +157,45 @@ TEST_F(MultiplexerTest, InterleaveForwardAndBackward2) {
   }
 }
 
+TEST_F(MultiplexerTest, ManySources) {
+  constexpr int kNumSources = 20;
+  constexpr int kNumEntriesPerSource = 5;
+
+  // Prepares sources whose entries are interleaved with each other. The pid
+  // is the global order of the entry.
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  Multiplexer Multiplexer;
+  for (int i = 0; i < kNumSources; i++) {
+    std::string content;
+    for (int j = 0; j < kNumEntriesPerSource; j++) {
+      const int order = j * kNumSources + i;
+      base::StringAppendF(&content,
+                          "2020-05-25T14:%02d:%02d.000000Z INFO "
+                          "chrome[%d]: This is log line %d-%d.\n",
+                          order / 60, order % 60, 1000 + order, i, j);
+    }
+    base::FilePath path =
+        temp_dir.GetPath().Append(base::StringPrintf("LOG%d", i));
+    ASSERT_TRUE(base::WriteFile(path, content));
+    Multiplexer.AddSource(path, std::make_unique<LogParserSyslog>(), false);
+  }
+
+  for (int order = 0; order < kNumSources * kNumEntriesPerSource; order++) {
+    MaybeLogEntry e = Multiplexer.Forward();
+    ASSERT_TRUE(e.has_value());
+    EXPECT_EQ(1000 + order, e->pid());
+  }
+  EXPECT_FALSE(Multiplexer.Forward().has_value());
+
+  Multiplexer.SetLinesFromLast(0);
+  for (int order = kNumSources * kNumEntriesPerSource - 1; order >= 0;
+       order--) {
+    MaybeLogEntry e = Multiplexer.Backward();
+    ASSERT_TRUE(e.has_value());
+    EXPECT_EQ(1000 + order, e->pid());
+  }
+  EXPECT_FALSE(Multiplexer.Backward().has_value());
+}
+
 }  // namespace croslog
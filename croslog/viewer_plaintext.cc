@@ -9,10 +9,12 @@
 #include <utility>
 
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/json/string_escape.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 
+#include "croslog/bulk_log_reader.h"
 #include "croslog/constants.h"
 #include "croslog/cursor_util.h"
 #include "croslog/log_parser_audit.h"
@@ -31,6 +33,11 @@ int64_t ToMicrosecondsSinceUnixEpoch(base::Time time) {
   return (time - base::Time::UnixEpoch()).InMicroseconds();
 }
 
+template <typename T>
+std::unique_ptr<LogParser> CreateParser() {
+  return std::make_unique<T>();
+}
+
 }  // anonymous namespace
 
 ViewerPlaintext::ViewerPlaintext(const croslog::Config& config)
@@ -75,6 +82,13 @@ void ViewerPlaintext::Initialize() {
 }
 
 bool ViewerPlaintext::Run() {
+  // Dumping all the logs doesn't need the position control nor the file
+  // watch, so the logs can be parsed in parallel.
+  if (config_.jobs > 1 && !config_.follow && config_.lines < 0 &&
+      config_.since.is_null()) {
+    return ReadAllLogsInBulk();
+  }
+
   bool install_change_watcher = config_.follow;
   for (const auto& log_path_str : croslog::kLogSources) {
     base::FilePath path(log_path_str.data());
@@ -96,6 +110,9 @@ bool ViewerPlaintext::Run() {
 
   if (config_.lines >= 0) {
     multiplexer_.SetLinesFromLast(config_.lines);
+  } else if (!config_.since.is_null()) {
+    // Skip the entries before |since| without parsing them.
+    multiplexer_.SeekToTime(config_.since);
   } else if (config_.follow) {
     multiplexer_.SetLinesFromLast(10);
   }
@@ -182,12 +199,53 @@ void ViewerPlaintext::ReadRemainingLogs() {
         last_shown_log_time = e->time();
     }
 
-    if (!last_shown_log_time.is_null()) {
-      WriteOutput("-- cursor: ");
-      WriteOutput(GenerateCursor(last_shown_log_time));
-      WriteOutput("\n");
-    }
+    if (!last_shown_log_time.is_null())
+      WriteCursor(last_shown_log_time);
+  }
+}
+
+bool ViewerPlaintext::ReadAllLogsInBulk() {
+  BulkMultiplexer multiplexer(config_.jobs);
+  for (const auto& log_path_str : croslog::kLogSources) {
+    base::FilePath path(log_path_str.data());
+    if (!base::PathExists(path))
+      continue;
+    multiplexer.AddSource(path,
+                          base::BindRepeating(&CreateParser<LogParserSyslog>));
+  }
+
+  for (const auto& log_path_str : croslog::kAuditLogSources) {
+    base::FilePath path(log_path_str.data());
+    if (!base::PathExists(path))
+      continue;
+    multiplexer.AddSource(path,
+                          base::BindRepeating(&CreateParser<LogParserAudit>));
   }
+
+  base::Time last_read_log_time;
+  while (true) {
+    const MaybeLogEntry& e = multiplexer.Forward();
+    if (!e.has_value())
+      break;
+
+    last_read_log_time = e->time();
+    if (ShouldFilterOutEntry(*e))
+      continue;
+
+    WriteLog(*e);
+  }
+
+  // The last entry read is the last one in the logs, regardless of visibility.
+  if (config_show_cursor_ && !last_read_log_time.is_null())
+    WriteCursor(last_read_log_time);
+
+  return true;
+}
+
+void ViewerPlaintext::WriteCursor(base::Time time) {
+  WriteOutput("-- cursor: ");
+  WriteOutput(GenerateCursor(time));
+  WriteOutput("\n");
 }
 
 std::vector<std::pair<std::string, std::string>>
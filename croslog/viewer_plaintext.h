@@ -66,6 +66,10 @@ class ViewerPlaintext : public Multiplexer::Observer {
   bool ShouldFilterOutEntry(const LogEntry& e);
 
   void ReadRemainingLogs();
+  // Reads and shows all the logs at once with parsing them on |config_.jobs|
+  // threads.
+  bool ReadAllLogsInBulk();
+  void WriteCursor(base::Time time);
 
   std::string GetBootIdAt(base::Time time);
   std::vector<std::pair<std::string, std::string>> GenerateKeyValues(
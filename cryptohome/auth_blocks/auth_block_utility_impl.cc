@@ -139,17 +139,25 @@ void AuthBlockUtilityImpl::DeriveKeyBlobsWithAuthBlock(
   ReportDeriveAuthBlock(auth_block_type);
 
   // This lambda functions to keep the auth_block reference valid until
-  // the results are returned through derive_callback.
+  // the results are returned through derive_callback. It also reports how long
+  // the derivation took for this type of auth block.
   AuthBlock* auth_block_ptr = auth_block->get();
   auto managed_callback = base::BindOnce(
       [](std::unique_ptr<AuthBlock> owned_auth_block,
+         std::unique_ptr<AuthSessionPerformanceTimer> timer,
          AuthBlock::DeriveCallback callback, CryptohomeStatus error,
          std::unique_ptr<KeyBlobs> key_blobs,
          std::optional<AuthBlock::SuggestedAction> suggested_action) {
+        if (error.ok()) {
+          ReportTimerDuration(timer.get());
+        }
         std::move(callback).Run(std::move(error), std::move(key_blobs),
                                 suggested_action);
       },
-      std::move(auth_block.value()), std::move(derive_callback));
+      std::move(auth_block.value()),
+      std::make_unique<AuthSessionPerformanceTimer>(kAuthBlockDeriveTimer,
+                                                    auth_block_type),
+      std::move(derive_callback));
 
   auth_block_ptr->Derive(auth_input, auth_state, std::move(managed_callback));
 }
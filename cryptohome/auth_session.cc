@@ -702,6 +702,7 @@ void AuthSession::CreateAndPersistVaultKeyset(
   AuthFactorType auth_factor_type = AuthFactorType::kPassword;
   if (added_auth_factor) {
     auth_factor_type = added_auth_factor->type();
+    derived_key_cache_.Invalidate(added_auth_factor->label());
     auth_factor_map_.Add(std::move(added_auth_factor),
                          AuthFactorStorageType::kVaultKeyset);
   } else {
@@ -1632,6 +1633,7 @@ void AuthSession::AuthForDecrypt::RemoveAuthFactor(
   // Remove the AuthFactor from the map.
   session_->auth_factor_map_.Remove(auth_factor_label);
   session_->verifier_forwarder_.RemoveVerifier(auth_factor_label);
+  session_->derived_key_cache_.Invalidate(auth_factor_label);
 
   // Report time taken for a successful remove.
   ReportTimerDuration(kAuthSessionRemoveAuthFactorVKTimer, remove_timer_start,
@@ -1710,6 +1712,7 @@ void AuthSession::ClearAuthFactorInMemoryObjects(
   // Remove the AuthFactor from the map.
   auth_factor_map_.Remove(auth_factor_label);
   verifier_forwarder_.RemoveVerifier(auth_factor_label);
+  derived_key_cache_.Invalidate(auth_factor_label);
   ReportTimerDuration(kAuthSessionRemoveAuthFactorUSSTimer, remove_timer_start,
                       "" /*append_string*/);
   std::move(on_done).Run(OkStatus<CryptohomeError>());
@@ -2079,6 +2082,7 @@ void AuthSession::ResaveUssWithFactorUpdated(
 
   LOG(INFO) << "AuthSession: updated auth factor " << auth_factor->label()
             << " in USS.";
+  derived_key_cache_.Invalidate(auth_factor->label());
   auth_factor_map_.Add(std::move(auth_factor),
                        AuthFactorStorageType::kUserSecretStash);
   ReportTimerDuration(auth_session_performance_timer.get());
@@ -2900,6 +2904,7 @@ CryptohomeStatus AuthSession::PersistAuthFactorToUserSecretStashImpl(
 
   LOG(INFO) << "AuthSession: added auth factor " << auth_factor->label()
             << " into USS.";
+  derived_key_cache_.Invalidate(auth_factor->label());
   auth_factor_map_.Add(std::move(auth_factor),
                        AuthFactorStorageType::kUserSecretStash);
 
@@ -3254,6 +3259,19 @@ void AuthSession::AuthenticateViaUserSecretStash(
   // Parameterize timer by AuthBlockType.
   auth_session_performance_timer->auth_block_type = *auth_block_type;
 
+  // Reuse the key blobs derived by a previous authentication with the same
+  // factor and input in this session, if any.
+  if (std::optional<KeyBlobs> cached_key_blobs = derived_key_cache_.Get(
+          auth_factor_label, *auth_block_type, auth_input)) {
+    LoadUSSMainKeyAndFsKeyset(
+        auth_factor.type(), auth_factor_label, auth_input,
+        std::move(auth_session_performance_timer), std::move(on_done),
+        OkStatus<CryptohomeError>(),
+        std::make_unique<KeyBlobs>(std::move(*cached_key_blobs)),
+        std::nullopt);
+    return;
+  }
+
   // Derive the keyset and then use USS to complete the authentication.
   auto derive_callback = base::BindOnce(
       &AuthSession::LoadUSSMainKeyAndFsKeyset, weak_factory_.GetWeakPtr(),
@@ -3436,6 +3454,14 @@ void AuthSession::LoadUSSMainKeyAndFsKeyset(
   user_secret_stash_ = std::move(user_secret_stash_status).value();
   user_secret_stash_main_key_ = decrypted_main_key;
 
+  // The key blobs are known to be valid, cache them for the next
+  // authentications with this factor.
+  if (auth_session_performance_timer->auth_block_type) {
+    derived_key_cache_.Put(auth_factor_label,
+                           *auth_session_performance_timer->auth_block_type,
+                           auth_input, *key_blobs);
+  }
+
   // Populate data fields from the USS.
   file_system_keyset_ = user_secret_stash_->GetFileSystemKeyset();
 
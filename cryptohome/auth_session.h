@@ -39,6 +39,7 @@
 #include "cryptohome/auth_intent.h"
 #include "cryptohome/credential_verifier.h"
 #include "cryptohome/crypto.h"
+#include "cryptohome/derived_key_cache.h"
 #include "cryptohome/error/cryptohome_error.h"
 #include "cryptohome/features.h"
 #include "cryptohome/key_objects.h"
@@ -850,6 +851,8 @@ class AuthSession final {
   bool user_exists_;
   // Map containing the auth factors already configured for this user.
   AuthFactorMap auth_factor_map_;
+  // Key blobs derived by previous authentications of this session.
+  DerivedKeyCache derived_key_cache_;
   // Key used by AuthenticateAuthFactor for cryptohome recovery AuthFactor.
   // It's set only after GetRecoveryRequest() call, and is std::nullopt in other
   // cases.
@@ -2613,6 +2613,103 @@ TEST_F(AuthSessionWithUssExperimentTest, AuthenticatePasswordAuthFactorViaUss) {
                   IsVerifierPtrWithLabelAndPassword(kFakeLabel, kFakePass)));
 }
 
+// Test that authenticating again with the same password in the same session
+// reuses the key blobs derived for the first authentication.
+TEST_F(AuthSessionWithUssExperimentTest,
+       ReauthenticatePasswordAuthFactorViaUssUsesCachedKeyBlobs) {
+  // Setup.
+  const ObfuscatedUsername obfuscated_username =
+      SanitizeUserName(kFakeUsername);
+  const brillo::SecureBlob kFakePerCredentialSecret("fake-vkk");
+  // Setting the expectation that the user exists.
+  EXPECT_CALL(platform_, DirectoryExists(_)).WillRepeatedly(Return(true));
+  // Generating the USS.
+  CryptohomeStatusOr<std::unique_ptr<UserSecretStash>> uss_status =
+      UserSecretStash::CreateRandom(FileSystemKeyset::CreateRandom());
+  ASSERT_TRUE(uss_status.ok());
+  std::unique_ptr<UserSecretStash> uss = std::move(uss_status).value();
+  std::optional<brillo::SecureBlob> uss_main_key =
+      UserSecretStash::CreateRandomMainKey();
+  ASSERT_TRUE(uss_main_key.has_value());
+  // Creating the auth factor. An arbitrary auth block state is used in this
+  // test.
+  auto auth_factor = std::make_unique<AuthFactor>(
+      AuthFactorType::kPassword, kFakeLabel,
+      AuthFactorMetadata{.metadata = auth_factor::PasswordMetadata()},
+      AuthBlockState{.state = TpmBoundToPcrAuthBlockState()});
+  EXPECT_TRUE(
+      auth_factor_manager_.SaveAuthFactor(obfuscated_username, *auth_factor)
+          .ok());
+  AuthFactorMap auth_factor_map;
+  auth_factor_map.Add(std::move(auth_factor),
+                      AuthFactorStorageType::kUserSecretStash);
+  // Adding the auth factor into the USS and persisting the latter.
+  const KeyBlobs key_blobs = {.vkk_key = kFakePerCredentialSecret};
+  std::optional<brillo::SecureBlob> wrapping_key =
+      key_blobs.DeriveUssCredentialSecret();
+  ASSERT_TRUE(wrapping_key.has_value());
+  EXPECT_TRUE(uss->AddWrappedMainKey(uss_main_key.value(), kFakeLabel,
+                                     wrapping_key.value(),
+                                     OverwriteExistingKeyBlock::kDisabled)
+                  .ok());
+  CryptohomeStatusOr<brillo::Blob> encrypted_uss =
+      uss->GetEncryptedContainer(uss_main_key.value());
+  ASSERT_TRUE(encrypted_uss.ok());
+  EXPECT_TRUE(
+      uss_storage_.Persist(encrypted_uss.value(), obfuscated_username).ok());
+  // Creating the auth session.
+  AuthSession auth_session({.username = kFakeUsername,
+                            .is_ephemeral_user = false,
+                            .intent = AuthIntent::kDecrypt,
+                            .auth_factor_status_update_timer =
+                                std::make_unique<base::WallClockTimer>(),
+                            .user_exists = true,
+                            .auth_factor_map = std::move(auth_factor_map)},
+                           backing_apis_);
+  EXPECT_TRUE(auth_session.user_exists());
+
+  // Test.
+  // Setting the expectation that the auth block utility will derive key blobs
+  // only once.
+  EXPECT_CALL(auth_block_utility_,
+              GetAuthBlockTypeFromState(
+                  AuthBlockStateTypeIs<TpmBoundToPcrAuthBlockState>()))
+      .WillRepeatedly(Return(AuthBlockType::kTpmBoundToPcr));
+  EXPECT_CALL(auth_block_utility_, DeriveKeyBlobsWithAuthBlock(
+                                       AuthBlockType::kTpmBoundToPcr, _, _, _))
+      .WillOnce([&kFakePerCredentialSecret](
+                    AuthBlockType auth_block_type, const AuthInput& auth_input,
+                    const AuthBlockState& auth_state,
+                    AuthBlock::DeriveCallback derive_callback) {
+        auto key_blobs = std::make_unique<KeyBlobs>();
+        key_blobs->vkk_key = kFakePerCredentialSecret;
+        std::move(derive_callback)
+            .Run(OkStatus<CryptohomeCryptoError>(), std::move(key_blobs),
+                 std::nullopt);
+      });
+  std::vector<std::string> auth_factor_labels{kFakeLabel};
+  user_data_auth::AuthInput auth_input_proto;
+  auth_input_proto.mutable_password_input()->set_secret(kFakePass);
+  AuthenticateTestFuture authenticate_future;
+  auth_session.AuthenticateAuthFactor(
+      ToAuthenticateRequest(auth_factor_labels, auth_input_proto),
+      authenticate_future.GetCallback());
+  auto& [action, status] = authenticate_future.Get();
+  EXPECT_THAT(status, IsOk());
+
+  // Authenticating again does not derive the key blobs.
+  AuthenticateTestFuture reauthenticate_future;
+  auth_session.AuthenticateAuthFactor(
+      ToAuthenticateRequest(auth_factor_labels, auth_input_proto),
+      reauthenticate_future.GetCallback());
+
+  // Verify.
+  auto& [reauth_action, reauth_status] = reauthenticate_future.Get();
+  EXPECT_THAT(reauth_status, IsOk());
+  EXPECT_EQ(reauth_action.action_type, AuthSession::PostAuthActionType::kNone);
+  EXPECT_TRUE(auth_session.has_user_secret_stash());
+}
+
 // Test that an existing user with an existing password auth factor can be
 // authenticated, using asynchronous key derivation.
 TEST_F(AuthSessionWithUssExperimentTest,
@@ -184,6 +184,16 @@ constexpr TimerHistogramParams kTimerHistogramParams[] = {
     {kStoreUserPolicyTimer, "Cryptohome.TimeToStoreUserPolicyInFile", 0, 5000,
      50},
     {kLoadUserPolicyTimer, "Cryptohome.TimeToLoadUserPolicyFromFile", 0, 5000,
+     50},
+    // The time taken by an auth block to derive the key blobs, parameterized by
+    // the type of the auth block.
+    {kAuthBlockDeriveTimer, "Cryptohome.TimeToDeriveAuthBlock", 0, 6000, 60},
+    // The time taken by the out-of-process helper to bind mount the user and
+    // root homes, and MyFiles/Downloads.
+    {kMountHomesTimer, "Cryptohome.TimeToMountHomes", 0, 3000, 50},
+    // The time taken to bind mount the daemon-store directories, with a
+    // ".Cache" suffix for the daemon-store-cache ones.
+    {kMountDaemonStoresTimer, "Cryptohome.TimeToMountDaemonStores", 0, 3000,
      50}};
 
 static_assert(std::size(kTimerHistogramParams) == kNumTimerTypes,
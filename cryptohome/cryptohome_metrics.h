@@ -114,6 +114,9 @@ enum TimerType {
   kSELinuxRelabelTimer = 21,
   kStoreUserPolicyTimer = 22,
   kLoadUserPolicyTimer = 23,
+  kAuthBlockDeriveTimer = 24,
+  kMountHomesTimer = 25,
+  kMountDaemonStoresTimer = 26,
   kNumTimerTypes  // For the number of timer types.
 };
 
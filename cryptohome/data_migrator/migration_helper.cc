@@ -24,6 +24,7 @@
 #include <base/strings/string_number_conversions.h>
 #include <base/synchronization/condition_variable.h>
 #include <base/system/sys_info.h>
+#include <base/threading/platform_thread.h>
 #include <base/threading/thread.h>
 #include <base/timer/elapsed_timer.h>
 
@@ -52,6 +53,9 @@ constexpr size_t kDefaultMaxJobListSize = 100000;
 // frequency.
 constexpr base::TimeDelta kStatusSignalInterval = base::Seconds(1);
 
+// Interval between logs of the estimated migration speed and remaining time.
+constexpr base::TimeDelta kSpeedLogInterval = base::Seconds(30);
+
 // Sends the UMA stat for the start/end status of migration respectively in the
 // constructor/destructor. By default the "generic error" end status is set, so
 // to report other status, call an appropriate method to overwrite it.
@@ -121,7 +125,7 @@ class MigrationStartAndEndStatusReporter {
 const char kSourceURLXattrName[] = "user.xdg.origin.url";
 const char kReferrerURLXattrName[] = "user.xdg.referrer.url";
 
-// Job represents a job to migrate a file or a symlink.
+// Job represents a job to migrate a file, a symlink or a directory.
 struct MigrationHelper::Job {
   Job() = default;
   ~Job() = default;
@@ -130,6 +134,8 @@ struct MigrationHelper::Job {
 };
 
 // WorkerPool manages jobs and job threads.
+// Job threads push the jobs for the entries of the directories they migrate,
+// such that the directory tree is traversed in parallel.
 // All public methods must be called on the main thread unless otherwise
 // specified.
 class MigrationHelper::WorkerPool {
@@ -145,6 +151,7 @@ class MigrationHelper::WorkerPool {
 
   // Starts job threads.
   bool Start(size_t num_job_threads, size_t max_job_list_size) {
+    main_thread_ = base::PlatformThread::CurrentRef();
     job_threads_.resize(num_job_threads);
     job_thread_results_.resize(num_job_threads, false);
     max_job_list_size_ = max_job_list_size;
@@ -166,11 +173,16 @@ class MigrationHelper::WorkerPool {
     return true;
   }
 
-  // Adds a job to the job list.
+  // Adds a job to the job list. On the main thread, waits for the job list to
+  // be smaller than |max_job_list_size_|. Job threads do not wait, as the job
+  // list could not shrink if all of them were waiting.
+  // Can be called on any thread.
   bool PushJob(const Job& job) {
     base::AutoLock lock(jobs_lock_);
-    while (jobs_.size() >= max_job_list_size_ && !should_abort_) {
-      main_thread_wakeup_condition_.Wait();
+    if (base::PlatformThread::CurrentRef() == main_thread_) {
+      while (jobs_.size() >= max_job_list_size_ && !should_abort_) {
+        main_thread_wakeup_condition_.Wait();
+      }
     }
     if (should_abort_) {
       return false;
@@ -209,10 +221,10 @@ class MigrationHelper::WorkerPool {
   }
 
  private:
-  // Processes jobs fed by the main thread.
+  // Processes jobs fed by the main thread and the job threads.
   // Must be called on a job thread.
   void ProcessJobs(bool* result) {
-    // Continue running on a job thread while the main thread feeds jobs.
+    // Continue running on a job thread while jobs are fed.
     while (true) {
       Job job;
       if (!PopJob(&job)) {  // No more new jobs.
@@ -225,6 +237,7 @@ class MigrationHelper::WorkerPool {
         *result = false;
         return;
       }
+      FinishJob();
     }
   }
 
@@ -233,7 +246,8 @@ class MigrationHelper::WorkerPool {
   bool PopJob(Job* job) {
     base::AutoLock lock(jobs_lock_);
     while (jobs_.empty()) {
-      if (no_more_new_jobs_)
+      // Running jobs may still push new jobs.
+      if (should_abort_ || (no_more_new_jobs_ && num_running_jobs_ == 0))
         return false;
       job_thread_wakeup_condition_.Wait();
     }
@@ -242,21 +256,35 @@ class MigrationHelper::WorkerPool {
     }
     *job = jobs_.front();
     jobs_.pop_front();
+    ++num_running_jobs_;
     // Let the main thread feed new jobs.
     main_thread_wakeup_condition_.Signal();
     return true;
   }
 
+  // Marks a job popped by PopJob() as processed.
+  // Must be called on a job thread.
+  void FinishJob() {
+    base::AutoLock lock(jobs_lock_);
+    --num_running_jobs_;
+    if (jobs_.empty() && num_running_jobs_ == 0) {
+      // Let the waiting job threads stop if the main thread is done.
+      job_thread_wakeup_condition_.Broadcast();
+    }
+  }
+
   MigrationHelper* migration_helper_;
+  base::PlatformThreadRef main_thread_;
   std::vector<std::unique_ptr<base::Thread>> job_threads_;  // The job threads.
   // deque instead of vector to avoid vector<bool> specialization.
   std::deque<bool> job_thread_results_;
   size_t max_job_list_size_ = 0;
 
   std::deque<Job> jobs_;  // The FIFO job list.
+  size_t num_running_jobs_ = 0;  // The number of jobs being processed.
   bool no_more_new_jobs_ = false;
   bool should_abort_ = false;
-  // Lock for jobs_, no_more_new_jobs_, and should_abort_.
+  // Lock for jobs_, num_running_jobs_, no_more_new_jobs_, and should_abort_.
   base::Lock jobs_lock_;
   // Condition variables associated with jobs_lock_.
   base::ConditionVariable job_thread_wakeup_condition_;
@@ -388,8 +416,13 @@ bool MigrationHelper::Migrate(const ProgressCallback& progress_callback) {
   delegate_->ReportStartTime();
   LOG(INFO) << "Preparation took " << timer.Elapsed().InMilliseconds()
             << " ms.";
-  // MigrateDir() recursively traverses the directory tree on the main thread,
-  // while the job threads migrate files and symlinks.
+  {
+    base::AutoLock lock(migrated_byte_count_lock_);
+    copy_start_time_ = base::TimeTicks::Now();
+    next_speed_log_ = copy_start_time_ + kSpeedLogInterval;
+  }
+  // MigrateDir() migrates the top directory on the main thread, while the job
+  // threads migrate its subdirectories, files and symlinks.
   bool success =
       worker_pool_->Start(num_job_threads_, max_job_list_size_) &&
       MigrateDir(base::FilePath(base::FilePath::kCurrentDirectory), from_stat);
@@ -418,6 +451,8 @@ bool MigrationHelper::Migrate(const ProgressCallback& progress_callback) {
   if (delegate_->ShouldReportProgress()) {
     LOG(INFO) << "Migrated " << total_byte_count_ << " bytes in " << elapsed_ms
               << " ms at " << speed_kb_per_s << " KB/s.";
+    if (!resumed)
+      delegate_->ReportMigrationSpeed(speed_kb_per_s);
   } else {
     LOG(INFO) << "Minimal migration took " << elapsed_ms << " ms.";
   }
@@ -468,8 +503,32 @@ bool MigrationHelper::CalculateDataToMigrate(const base::FilePath& from) {
 void MigrationHelper::IncrementMigratedBytes(uint64_t bytes) {
   base::AutoLock lock(migrated_byte_count_lock_);
   migrated_byte_count_ += bytes;
-  if (next_report_ < base::TimeTicks::Now())
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (next_report_ < now)
     ReportStatus();
+  if (next_speed_log_ < now)
+    LogSpeed(now);
+}
+
+void MigrationHelper::LogSpeed(base::TimeTicks now) {
+  next_speed_log_ = now + kSpeedLogInterval;
+  const double elapsed_s = (now - copy_start_time_).InSecondsF();
+  if (elapsed_s <= 0 || !delegate_->ShouldReportProgress()) {
+    return;
+  }
+  const double bytes_per_s = migrated_byte_count_ / elapsed_s;
+  const uint64_t remaining_bytes =
+      total_byte_count_ > migrated_byte_count_
+          ? total_byte_count_ - migrated_byte_count_
+          : 0;
+  LOG(INFO) << "Migrated " << migrated_byte_count_ << " of "
+            << total_byte_count_ << " bytes at "
+            << static_cast<uint64_t>(bytes_per_s / 1024) << " KB/s, "
+            << "about "
+            << (bytes_per_s > 0
+                    ? static_cast<int64_t>(remaining_bytes / bytes_per_s)
+                    : -1)
+            << " s remaining.";
 }
 
 void MigrationHelper::ReportStatus() {
@@ -529,18 +588,11 @@ bool MigrationHelper::MigrateDir(const base::FilePath& child,
     }
 
     IncrementChildCount(child);
-    if (S_ISDIR(entry_stat.st_mode)) {
-      // Directory.
-      if (!MigrateDir(new_child, entry_stat))
-        return false;
-      IncrementMigratedBytes(entry_stat.st_size);
-    } else {
-      Job job;
-      job.child = new_child;
-      job.stat = entry_stat;
-      if (!worker_pool_->PushJob(job))
-        return false;
-    }
+    Job job;
+    job.child = new_child;
+    job.stat = entry_stat;
+    if (!worker_pool_->PushJob(job))
+      return false;
   }
   enumerator.reset();
   // Decrement the placeholder child count.
@@ -673,6 +725,15 @@ bool MigrationHelper::MigrateFile(const base::FilePath& child,
       to_read = effective_chunk_size_;
     }
     off_t offset = from_length - to_read;
+    // Chunks are copied from the end of the file. Ask the kernel to read ahead
+    // the next chunk while this one is being copied. This is only a hint, and
+    // errors are ignored.
+    if (offset > 0) {
+      const off_t next_offset = std::max<off_t>(
+          0, offset - static_cast<off_t>(effective_chunk_size_));
+      posix_fadvise(from_file.GetPlatformFile(), next_offset,
+                    offset - next_offset, POSIX_FADV_WILLNEED);
+    }
     if (to_file.Seek(base::File::FROM_BEGIN, offset) != offset) {
       LOG(ERROR) << "Failed to seek in " << to_child.value();
       RecordFileErrorWithCurrentErrno(kMigrationFailedAtSeek, child,
@@ -960,6 +1021,14 @@ void MigrationHelper::RecordFileErrorWithCurrentErrno(
 }
 
 bool MigrationHelper::ProcessJob(const Job& job) {
+  if (S_ISDIR(job.stat.st_mode)) {
+    // Directory. MigrateDir() pushes the jobs of its entries, and the source
+    // directory is deleted once all of them are migrated.
+    if (!MigrateDir(job.child, job.stat))
+      return false;
+    IncrementMigratedBytes(job.stat.st_size);
+    return true;
+  }
   if (S_ISLNK(job.stat.st_mode)) {
     // Symlink
     if (!MigrateLink(job.child, job.stat))
@@ -114,8 +114,11 @@ class BRILLO_EXPORT MigrationHelper {
   // Call |progress_callback_| with the number of bytes already migrated and the
   // total number of bytes to be migrated.
   void ReportStatus();
+  // Logs the average migration speed since |copy_start_time_| and the
+  // estimated remaining time.
+  void LogSpeed(base::TimeTicks now);
   // Creates a new directory that is the result of appending |child| to |to|,
-  // migrating recursively all contents of the source directory.
+  // and pushes the jobs to migrate all contents of the source directory.
   //
   // Parameters
   //   child - relative path under the base path to migrate.
@@ -196,7 +199,10 @@ class BRILLO_EXPORT MigrationHelper {
 
   uint64_t migrated_byte_count_;
   base::TimeTicks next_report_;
-  // Lock for migrated_byte_count_ and next_report_.
+  base::TimeTicks copy_start_time_;
+  base::TimeTicks next_speed_log_;
+  // Lock for migrated_byte_count_, next_report_, copy_start_time_ and
+  // next_speed_log_.
   base::Lock migrated_byte_count_lock_;
 
   MigrationFailedOperationType failed_operation_type_;
@@ -95,6 +95,10 @@ class BRILLO_EXPORT MigrationHelperDelegate {
   // Called before the migration starts.
   virtual void ReportTotalSize(int total_byte_count_mb, int total_file_count) {}
 
+  // Reports the average migration speed in KB/s.
+  // Called after a migration that was not resumed succeeds.
+  virtual void ReportMigrationSpeed(int speed_kb_per_s) {}
+
   // Called when a migration failure happens. Reports the error code, the failed
   // operation type, the relative path to the failed file from the migration
   // root, and the type of the location of the failed file (whether it is in the
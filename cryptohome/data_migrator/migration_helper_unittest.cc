@@ -286,6 +286,47 @@ TEST_F(MigrationHelperTest, OneEmptyFileInNestedDirectory) {
       to_dir_.Append(kDir1).Append(kDir2).Append(kFileName)));
 }
 
+TEST_F(MigrationHelperTest, DeeplyNestedDirectories) {
+  MigrationHelper helper(&platform_, &delegate_, from_dir_, to_dir_,
+                         status_files_dir_, kDefaultChunkSize);
+  // Job threads push the jobs of the subdirectories they migrate without
+  // waiting for the job list to shrink.
+  helper.set_num_job_threads_for_testing(4);
+  helper.set_max_job_list_size_for_testing(1);
+
+  // Create a tree of nested directories with a file in each of them.
+  constexpr int kDepth = 5;
+  constexpr int kNumSubdirectories = 3;
+  constexpr char kFileName[] = "file";
+  std::vector<FilePath> dirs = {FilePath(FilePath::kCurrentDirectory)};
+  std::vector<int> depths = {0};
+  for (size_t i = 0; i < dirs.size(); ++i) {
+    SCOPED_TRACE(dirs[i].value());
+    ASSERT_TRUE(platform_.CreateDirectory(from_dir_.Append(dirs[i])));
+    ASSERT_TRUE(platform_.WriteStringToFile(
+        from_dir_.Append(dirs[i]).Append(kFileName), dirs[i].value()));
+    if (depths[i] < kDepth) {
+      for (int j = 0; j < kNumSubdirectories; ++j) {
+        dirs.push_back(dirs[i].AppendASCII(base::NumberToString(j)));
+        depths.push_back(depths[i] + 1);
+      }
+    }
+  }
+
+  EXPECT_TRUE(helper.Migrate(base::BindRepeating(
+      &MigrationHelperTest::ProgressCaptor, base::Unretained(this))));
+
+  // All the files and directories are moved.
+  for (const FilePath& dir : dirs) {
+    SCOPED_TRACE(dir.value());
+    std::string data;
+    EXPECT_TRUE(platform_.ReadFileToString(
+        to_dir_.Append(dir).Append(kFileName), &data));
+    EXPECT_EQ(dir.value(), data);
+  }
+  EXPECT_TRUE(platform_.IsDirectoryEmpty(from_dir_));
+}
+
 TEST_F(MigrationHelperTest, UnreadableFile) {
   MigrationHelper helper(&platform_, &delegate_, from_dir_, to_dir_,
                          status_files_dir_, kDefaultChunkSize);
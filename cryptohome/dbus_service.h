@@ -9,6 +9,7 @@
 
 #include <base/check.h>
 #include <brillo/daemons/dbus_daemon.h>
+#include <libhwsec-foundation/tracing/tracing.h>
 
 #include "cryptohome/service_userdataauth.h"
 #include "cryptohome/userdataauth.h"
@@ -34,6 +35,9 @@ class UserDataAuthDaemon : public brillo::DBusServiceDaemon {
 
   void RegisterDBusObjectsAsync(
       brillo::dbus_utils::AsyncEventSequencer* sequencer) override {
+    // Record the hwsec trace events, e.g. the TPM commands sent during login.
+    hwsec_foundation::InitTracing();
+
     // Initialize the UserDataAuth service.
     // Note that the initialization should be done after setting the options.
     CHECK(service_->Initialize(nullptr));
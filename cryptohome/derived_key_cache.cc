@@ -0,0 +1,109 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cryptohome/derived_key_cache.h"
+
+#include <utility>
+
+#include <brillo/secure_string.h>
+#include <libhwsec-foundation/crypto/hmac.h>
+#include <libhwsec-foundation/crypto/secure_blob_util.h>
+#include <openssl/sha.h>
+
+namespace cryptohome {
+namespace {
+
+using ::hwsec_foundation::CreateSecureRandomBlob;
+using ::hwsec_foundation::HmacSha256;
+
+}  // namespace
+
+DerivedKeyCache::DerivedKeyCache(base::TimeDelta ttl)
+    : ttl_(ttl), hmac_key_(CreateSecureRandomBlob(SHA256_DIGEST_LENGTH)) {}
+
+DerivedKeyCache::~DerivedKeyCache() = default;
+
+// static
+bool DerivedKeyCache::IsCacheable(AuthBlockType type) {
+  switch (type) {
+    case AuthBlockType::kDoubleWrappedCompat:
+    case AuthBlockType::kTpmBoundToPcr:
+    case AuthBlockType::kTpmNotBoundToPcr:
+    case AuthBlockType::kScrypt:
+    case AuthBlockType::kTpmEcc:
+      return true;
+    // Deriving these consumes an attempt of a rate-limiter or requires a fresh
+    // response of a challenge, which must not be skipped.
+    case AuthBlockType::kPinWeaver:
+    case AuthBlockType::kChallengeCredential:
+    case AuthBlockType::kCryptohomeRecovery:
+    case AuthBlockType::kFingerprint:
+      return false;
+  }
+}
+
+void DerivedKeyCache::Put(const std::string& label,
+                          AuthBlockType type,
+                          const AuthInput& auth_input,
+                          const KeyBlobs& key_blobs) {
+  if (!IsCacheable(type)) {
+    return;
+  }
+  std::optional<brillo::SecureBlob> input_hmac = GetInputHmac(auth_input);
+  if (!input_hmac) {
+    return;
+  }
+  entries_.insert_or_assign(
+      label, Entry{
+                 .type = type,
+                 .input_hmac = std::move(*input_hmac),
+                 .locked_to_single_user = auth_input.locked_to_single_user,
+                 .key_blobs = key_blobs,
+                 .expiration_time = base::TimeTicks::Now() + ttl_,
+             });
+}
+
+std::optional<KeyBlobs> DerivedKeyCache::Get(const std::string& label,
+                                             AuthBlockType type,
+                                             const AuthInput& auth_input) {
+  auto it = entries_.find(label);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  if (base::TimeTicks::Now() >= it->second.expiration_time) {
+    entries_.erase(it);
+    return std::nullopt;
+  }
+  const Entry& entry = it->second;
+  // The state of the PCRs changes the result of TPM-bound derivations.
+  if (entry.type != type ||
+      entry.locked_to_single_user != auth_input.locked_to_single_user) {
+    return std::nullopt;
+  }
+  std::optional<brillo::SecureBlob> input_hmac = GetInputHmac(auth_input);
+  if (!input_hmac || input_hmac->size() != entry.input_hmac.size() ||
+      brillo::SecureMemcmp(input_hmac->data(), entry.input_hmac.data(),
+                           entry.input_hmac.size()) != 0) {
+    return std::nullopt;
+  }
+  return entry.key_blobs;
+}
+
+void DerivedKeyCache::Invalidate(const std::string& label) {
+  entries_.erase(label);
+}
+
+void DerivedKeyCache::Clear() {
+  entries_.clear();
+}
+
+std::optional<brillo::SecureBlob> DerivedKeyCache::GetInputHmac(
+    const AuthInput& auth_input) {
+  if (!auth_input.user_input.has_value()) {
+    return std::nullopt;
+  }
+  return HmacSha256(hmac_key_, *auth_input.user_input);
+}
+
+}  // namespace cryptohome
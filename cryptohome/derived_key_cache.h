@@ -0,0 +1,85 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CRYPTOHOME_DERIVED_KEY_CACHE_H_
+#define CRYPTOHOME_DERIVED_KEY_CACHE_H_
+
+#include <map>
+#include <optional>
+#include <string>
+
+#include <base/time/time.h>
+#include <brillo/secure_blob.h>
+
+#include "cryptohome/auth_blocks/auth_block_type.h"
+#include "cryptohome/key_objects.h"
+
+namespace cryptohome {
+
+// Caches the key blobs derived by the auth blocks of the factors of an
+// AuthSession, such that authenticating again with the same factor and the
+// same secret does not require running the KDF or the TPM operations again.
+//
+// Entries are keyed by the factor label and can only be retrieved with the
+// same user input they were derived from: the input is stored as an HMAC with
+// a key generated for each cache and compared in constant time. Only
+// derivations without side effects are cached, i.e. not those of auth blocks
+// backed by a rate-limiter or a challenge. Entries expire after |ttl| and must
+// be invalidated when their factor is updated or removed.
+class DerivedKeyCache {
+ public:
+  static constexpr base::TimeDelta kDefaultTtl = base::Minutes(5);
+
+  explicit DerivedKeyCache(base::TimeDelta ttl = kDefaultTtl);
+  DerivedKeyCache(const DerivedKeyCache&) = delete;
+  DerivedKeyCache& operator=(const DerivedKeyCache&) = delete;
+  ~DerivedKeyCache();
+
+  // Returns whether the key blobs derived by auth blocks of |type| can be
+  // cached.
+  static bool IsCacheable(AuthBlockType type);
+
+  // Caches |key_blobs| derived by an auth block of |type| from |auth_input|
+  // for the factor |label|. Does nothing if the derivation is not cacheable.
+  void Put(const std::string& label,
+           AuthBlockType type,
+           const AuthInput& auth_input,
+           const KeyBlobs& key_blobs);
+
+  // Returns the unexpired key blobs cached for the factor |label| if they were
+  // derived by an auth block of |type| from an input matching |auth_input|.
+  std::optional<KeyBlobs> Get(const std::string& label,
+                              AuthBlockType type,
+                              const AuthInput& auth_input);
+
+  // Removes the key blobs cached for the factor |label|.
+  void Invalidate(const std::string& label);
+
+  // Removes all the cached key blobs.
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    AuthBlockType type;
+    brillo::SecureBlob input_hmac;
+    std::optional<bool> locked_to_single_user;
+    KeyBlobs key_blobs;
+    base::TimeTicks expiration_time;
+  };
+
+  // Returns the HMAC of the user input of |auth_input|, or std::nullopt if it
+  // has none.
+  std::optional<brillo::SecureBlob> GetInputHmac(const AuthInput& auth_input);
+
+  const base::TimeDelta ttl_;
+  // The key of the HMACs of the user inputs.
+  const brillo::SecureBlob hmac_key_;
+  std::map<std::string, Entry> entries_;
+};
+
+}  // namespace cryptohome
+
+#endif  // CRYPTOHOME_DERIVED_KEY_CACHE_H_
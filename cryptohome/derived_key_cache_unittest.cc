@@ -0,0 +1,124 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cryptohome/derived_key_cache.h"
+
+#include <optional>
+
+#include <base/test/task_environment.h>
+#include <brillo/secure_blob.h>
+#include <gtest/gtest.h>
+
+using brillo::SecureBlob;
+
+namespace cryptohome {
+
+namespace {
+
+constexpr char kLabel[] = "password";
+constexpr char kOtherLabel[] = "other-password";
+
+AuthInput GetAuthInput(const char* user_input) {
+  return AuthInput{
+      .user_input = SecureBlob(user_input),
+      .locked_to_single_user = false,
+  };
+}
+
+KeyBlobs GetFakeKeyBlobs() {
+  return KeyBlobs{
+      .vkk_key = SecureBlob("fake key"),
+  };
+}
+
+class DerivedKeyCacheTest : public ::testing::Test {
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  DerivedKeyCache cache_;
+};
+
+}  // namespace
+
+TEST_F(DerivedKeyCacheTest, GetWithSameInput) {
+  cache_.Put(kLabel, AuthBlockType::kTpmEcc, GetAuthInput("secret"),
+             GetFakeKeyBlobs());
+
+  std::optional<KeyBlobs> key_blobs =
+      cache_.Get(kLabel, AuthBlockType::kTpmEcc, GetAuthInput("secret"));
+  ASSERT_TRUE(key_blobs.has_value());
+  EXPECT_EQ(key_blobs->vkk_key, GetFakeKeyBlobs().vkk_key);
+}
+
+TEST_F(DerivedKeyCacheTest, GetWithDifferentInputFails) {
+  cache_.Put(kLabel, AuthBlockType::kTpmEcc, GetAuthInput("secret"),
+             GetFakeKeyBlobs());
+
+  EXPECT_FALSE(
+      cache_.Get(kLabel, AuthBlockType::kTpmEcc, GetAuthInput("wrong secret"))
+          .has_value());
+  EXPECT_FALSE(
+      cache_.Get(kOtherLabel, AuthBlockType::kTpmEcc, GetAuthInput("secret"))
+          .has_value());
+  EXPECT_FALSE(
+      cache_.Get(kLabel, AuthBlockType::kScrypt, GetAuthInput("secret"))
+          .has_value());
+
+  AuthInput locked_input = GetAuthInput("secret");
+  locked_input.locked_to_single_user = true;
+  EXPECT_FALSE(
+      cache_.Get(kLabel, AuthBlockType::kTpmEcc, locked_input).has_value());
+}
+
+TEST_F(DerivedKeyCacheTest, RateLimitedBlocksNotCached) {
+  cache_.Put(kLabel, AuthBlockType::kPinWeaver, GetAuthInput("1234"),
+             GetFakeKeyBlobs());
+
+  EXPECT_EQ(cache_.size(), 0);
+  EXPECT_FALSE(
+      cache_.Get(kLabel, AuthBlockType::kPinWeaver, GetAuthInput("1234"))
+          .has_value());
+}
+
+TEST_F(DerivedKeyCacheTest, InputWithoutSecretNotCached) {
+  cache_.Put(kLabel, AuthBlockType::kScrypt, AuthInput(), GetFakeKeyBlobs());
+
+  EXPECT_EQ(cache_.size(), 0);
+}
+
+TEST_F(DerivedKeyCacheTest, EntriesExpire) {
+  cache_.Put(kLabel, AuthBlockType::kScrypt, GetAuthInput("secret"),
+             GetFakeKeyBlobs());
+
+  task_environment_.FastForwardBy(DerivedKeyCache::kDefaultTtl -
+                                  base::Seconds(1));
+  EXPECT_TRUE(cache_.Get(kLabel, AuthBlockType::kScrypt, GetAuthInput("secret"))
+                  .has_value());
+
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_FALSE(
+      cache_.Get(kLabel, AuthBlockType::kScrypt, GetAuthInput("secret"))
+          .has_value());
+  EXPECT_EQ(cache_.size(), 0);
+}
+
+TEST_F(DerivedKeyCacheTest, Invalidate) {
+  cache_.Put(kLabel, AuthBlockType::kScrypt, GetAuthInput("secret"),
+             GetFakeKeyBlobs());
+  cache_.Put(kOtherLabel, AuthBlockType::kScrypt, GetAuthInput("secret"),
+             GetFakeKeyBlobs());
+
+  cache_.Invalidate(kLabel);
+  EXPECT_FALSE(
+      cache_.Get(kLabel, AuthBlockType::kScrypt, GetAuthInput("secret"))
+          .has_value());
+  EXPECT_TRUE(
+      cache_.Get(kOtherLabel, AuthBlockType::kScrypt, GetAuthInput("secret"))
+          .has_value());
+
+  cache_.Clear();
+  EXPECT_EQ(cache_.size(), 0);
+}
+
+}  // namespace cryptohome
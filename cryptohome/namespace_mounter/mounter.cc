@@ -19,6 +19,7 @@
 #include <base/location.h>
 #include <base/logging.h>
 #include <base/strings/stringprintf.h>
+#include <base/time/time.h>
 #include <brillo/cryptohome.h>
 #include <brillo/secure_blob.h>
 
@@ -701,16 +702,26 @@ bool Mounter::BindAndPush(const FilePath& src,
 
 bool Mounter::MountDaemonStoreCacheDirectories(
     const FilePath& root_home, const ObfuscatedUsername& obfuscated_username) {
-  return InternalMountDaemonStoreDirectories(
-      root_home.Append(kDaemonStoreCacheDir), obfuscated_username,
-      kEtcDaemonStoreBaseDir, kRunDaemonStoreCacheBaseDir);
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  if (!InternalMountDaemonStoreDirectories(
+          root_home.Append(kDaemonStoreCacheDir), obfuscated_username,
+          kEtcDaemonStoreBaseDir, kRunDaemonStoreCacheBaseDir)) {
+    return false;
+  }
+  ReportTimerDuration(kMountDaemonStoresTimer, start_time, ".Cache");
+  return true;
 }
 
 bool Mounter::MountDaemonStoreDirectories(
     const FilePath& root_home, const ObfuscatedUsername& obfuscated_username) {
-  return InternalMountDaemonStoreDirectories(root_home, obfuscated_username,
-                                             kEtcDaemonStoreBaseDir,
-                                             kRunDaemonStoreBaseDir);
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  if (!InternalMountDaemonStoreDirectories(root_home, obfuscated_username,
+                                           kEtcDaemonStoreBaseDir,
+                                           kRunDaemonStoreBaseDir)) {
+    return false;
+  }
+  ReportTimerDuration(kMountDaemonStoresTimer, start_time, "");
+  return true;
 }
 
 bool Mounter::InternalMountDaemonStoreDirectories(
@@ -813,6 +824,8 @@ bool Mounter::MountHomesAndDaemonStores(
     const ObfuscatedUsername& obfuscated_username,
     const FilePath& user_home,
     const FilePath& root_home) {
+  ReportTimerStart(kMountHomesTimer);
+
   // Bind mount user directory as a shared bind mount.
   // This allows us to set up user mounts as subsidiary mounts without needing
   // to replicate that across multiple mount points.
@@ -848,6 +861,8 @@ bool Mounter::MountHomesAndDaemonStores(
     return false;
   }
 
+  ReportTimerStop(kMountHomesTimer);
+
   // Mount directories used by daemons to store per-user data.
   if (!MountDaemonStoreDirectories(root_home, obfuscated_username))
     return false;
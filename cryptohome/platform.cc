@@ -1279,10 +1279,25 @@ bool Platform::SetFileTimes(const base::FilePath& path,
 }
 
 bool Platform::SendFile(int fd_to, int fd_from, off_t offset, size_t count) {
+  // copy_file_range() lets the filesystem copy the data without going through
+  // the page cache of both files, or share the extents of the source file
+  // (reflink) when it supports it. It does not work across filesystems on
+  // recent kernels, in which case we fall back to sendfile().
+  bool use_copy_file_range = true;
   while (count > 0) {
-    ssize_t written = sendfile(fd_to, fd_from, &offset, count);
+    ssize_t written;
+    if (use_copy_file_range) {
+      written = copy_file_range(fd_from, &offset, fd_to, nullptr, count, 0);
+      if (written < 0 && (errno == EXDEV || errno == EINVAL ||
+                          errno == ENOSYS || errno == EOPNOTSUPP)) {
+        use_copy_file_range = false;
+        continue;
+      }
+    } else {
+      written = sendfile(fd_to, fd_from, &offset, count);
+    }
     if (written < 0) {
-      PLOG(ERROR) << "sendfile failed to copy data";
+      PLOG(ERROR) << "Failed to copy data";
       return false;
     }
     if (written == 0) {
@@ -842,7 +842,8 @@ class BRILLO_EXPORT Platform {
   // Copies |count| bytes of data from |from| to |to|, starting at |offset| in
   // |from| and the current file offset in |to|.  If
   // the copy fails or is only partially successful (bytes written does not
-  // equal |count|) false is returned.
+  // equal |count|) false is returned. The data is copied in the kernel with
+  // copy_file_range() when both files support it, sendfile() otherwise.
   //
   // Parameters
   //   fd_to - The file to copy data to.
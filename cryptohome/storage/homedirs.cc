@@ -5,6 +5,7 @@
 #include "cryptohome/storage/homedirs.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -380,6 +381,9 @@ StorageStatusOr<EncryptedContainerType> HomeDirs::GetVaultType(
 StorageStatusOr<EncryptedContainerType> HomeDirs::PickVaultType(
     const ObfuscatedUsername& obfuscated_username,
     const CryptohomeVault::Options& options) {
+  // The vault is about to be mounted, which may change its contents.
+  may_contain_android_data_.erase(obfuscated_username);
+
   // See if the vault exists.
   ASSIGN_OR_RETURN(EncryptedContainerType vault_type,
                    GetVaultType(obfuscated_username));
@@ -479,6 +483,7 @@ bool HomeDirs::Create(const Username& username) {
 
 bool HomeDirs::Remove(const ObfuscatedUsername& obfuscated) {
   remove_callback_.Run(obfuscated);
+  may_contain_android_data_.erase(obfuscated);
   FilePath user_dir = UserPath(obfuscated);
   FilePath user_path =
       brillo::cryptohome::home::GetUserPathPrefix().Append(*obfuscated);
@@ -593,20 +598,33 @@ bool HomeDirs::NeedsDircryptoMigration(
 int32_t HomeDirs::GetUnmountedAndroidDataCount() {
   const auto homedirs = GetHomeDirs();
 
-  return std::count_if(
-      homedirs.begin(), homedirs.end(), [this](const HomeDirs::HomeDir& dir) {
-        if (dir.is_mounted)
-          return false;
+  // Only keep the entries of the vaults which are still unmounted.
+  std::map<ObfuscatedUsername, bool> may_contain_android_data;
+  int32_t count = 0;
+  for (const auto& dir : homedirs) {
+    if (dir.is_mounted)
+      continue;
 
-        if (EcryptfsCryptohomeExists(dir.obfuscated))
-          return false;
+    auto it = may_contain_android_data_.find(dir.obfuscated);
+    bool android_data;
+    if (it != may_contain_android_data_.end()) {
+      android_data = it->second;
+    } else if (EcryptfsCryptohomeExists(dir.obfuscated)) {
+      android_data = false;
+    } else {
+      FilePath shadow_dir = UserPath(dir.obfuscated);
+      FilePath root_home_dir;
+      android_data = GetTrackedDirectory(shadow_dir, FilePath(kRootHomeSuffix),
+                                         &root_home_dir) &&
+                     MayContainAndroidData(root_home_dir);
+    }
+    may_contain_android_data.emplace(dir.obfuscated, android_data);
+    if (android_data)
+      count++;
+  }
+  may_contain_android_data_ = std::move(may_contain_android_data);
 
-        FilePath shadow_dir = UserPath(dir.obfuscated);
-        FilePath root_home_dir;
-        return GetTrackedDirectory(shadow_dir, FilePath(kRootHomeSuffix),
-                                   &root_home_dir) &&
-               MayContainAndroidData(root_home_dir);
-      });
+  return count;
 }
 
 bool HomeDirs::MayContainAndroidData(
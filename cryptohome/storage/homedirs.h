@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -167,7 +168,8 @@ class HomeDirs {
 
   // Get the number of unmounted android-data directory. Each android users
   // that is not currently logged in should have exactly one android-data
-  // directory.
+  // directory. The result of the check of each unmounted vault is cached
+  // until the vault gets mounted or removed.
   virtual int32_t GetUnmountedAndroidDataCount();
 
   // Marks that the device got locked to be able to use only data of a single
@@ -264,6 +266,11 @@ class HomeDirs {
   // latency of reading /proc/crypto for every cryptohome::Mount call.
   std::optional<bool> is_aes_keylocker_supported_;
 
+  // Caches whether the vaults of unmounted users may contain android-data.
+  // The contents of a vault only change while it is mounted, so entries are
+  // dropped when the vault is mounted (see PickVaultType()) or removed.
+  std::map<ObfuscatedUsername, bool> may_contain_android_data_;
+
   // The container a not-shifted system UID in ARC++ container (AID_SYSTEM).
   static constexpr uid_t kAndroidSystemUid = 1000;
 
@@ -7,6 +7,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <base/files/file_path.h>
@@ -514,6 +515,15 @@ TEST_P(HomeDirsTest, GetUnmountedAndroidDataCount) {
 
   // Expect 1 home directory with android-data: homedir_paths_[0].
   EXPECT_EQ(1, homedirs_->GetUnmountedAndroidDataCount());
+
+  // The result is kept while the vault stays unmounted...
+  ASSERT_TRUE(platform_.DeletePathRecursively(android_data));
+  EXPECT_EQ(1, homedirs_->GetUnmountedAndroidDataCount());
+
+  // ...and checked again once it has been mounted.
+  std::ignore = homedirs_->PickVaultType(users_[0].obfuscated,
+                                        CryptohomeVault::Options());
+  EXPECT_EQ(0, homedirs_->GetUnmountedAndroidDataCount());
 }
 
 TEST_P(HomeDirsTest, GetHomedirsAllMounted) {
@@ -0,0 +1,131 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cups_proxy/ipp_response_cache.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <base/logging.h>
+#include <chromeos/libipp/builder.h>
+#include <chromeos/libipp/frame.h>
+#include <chromeos/libipp/ipp_enums.h>
+#include <chromeos/libipp/parser.h>
+
+namespace cups_proxy {
+
+namespace {
+
+// Every IPP message starts with the version (2 bytes), the operation id or
+// status code (2 bytes) and the request-id (4 bytes). See section 3.1.1 of
+// RFC 8010.
+constexpr size_t kStatusCodeOffset = 2;
+constexpr size_t kRequestIdOffset = 4;
+constexpr size_t kIppHeaderSize = 8;
+
+// Status codes below this value are successful. See section 4.1.6.1 of RFC
+// 8011.
+constexpr int kIppFirstErrorStatusCode = 0x0100;
+
+constexpr int kHttpOk = 200;
+
+IppResponse CloneResponse(const IppResponse& response) {
+  IppResponse clone;
+  clone.http_status_code = response.http_status_code;
+  for (const auto& header : response.headers) {
+    clone.headers.push_back(header.Clone());
+  }
+  clone.body = response.body;
+  return clone;
+}
+
+}  // namespace
+
+IppResponseCache::IppResponseCache(const base::TickClock* clock)
+    : clock_(clock) {}
+
+IppResponseCache::~IppResponseCache() = default;
+
+// static
+std::optional<std::string> IppResponseCache::GetKey(
+    const MHDHttpRequest& request) {
+  if (request.method() != "POST") {
+    return std::nullopt;
+  }
+
+  const IppBody& body = request.body();
+  ipp::SimpleParserLog log;
+  ipp::Frame frame = ipp::Parse(body.data(), body.size(), log);
+  // Skip malformed requests, since the parser may have dropped the parts of
+  // them that make them different.
+  if (!log.Errors().empty() ||
+      frame.OperationId() != ipp::Operation::Get_Printer_Attributes) {
+    return std::nullopt;
+  }
+
+  // The request-id is different in every request. Everything else, including
+  // the attributes requested, selects the response.
+  frame.RequestId() = 0;
+  const std::vector<uint8_t> canonical_frame = ipp::BuildBinaryFrame(frame);
+  return request.url() + '\n' +
+         std::string(canonical_frame.begin(), canonical_frame.end());
+}
+
+std::optional<IppResponse> IppResponseCache::Get(
+    const std::string& key, const MHDHttpRequest& request) {
+  Evict();
+  auto it = entries_.find(key);
+  if (it == entries_.end() || request.body().size() < kIppHeaderSize) {
+    return std::nullopt;
+  }
+
+  DVLOG(1) << "Serving cached response to " << request.url();
+  IppResponse response = CloneResponse(it->second.response);
+  std::copy_n(request.body().begin() + kRequestIdOffset,
+              kIppHeaderSize - kRequestIdOffset,
+              response.body.begin() + kRequestIdOffset);
+  return response;
+}
+
+void IppResponseCache::Put(const std::string& key,
+                           const IppResponse& response) {
+  if (response.http_status_code != kHttpOk ||
+      response.body.size() < kIppHeaderSize) {
+    return;
+  }
+  const int status_code = response.body[kStatusCodeOffset] << 8 |
+                          response.body[kStatusCodeOffset + 1];
+  if (status_code >= kIppFirstErrorStatusCode) {
+    return;
+  }
+
+  entries_.insert_or_assign(
+      key, Entry{clock_->NowTicks(), CloneResponse(response)});
+  Evict();
+}
+
+void IppResponseCache::Clear() {
+  entries_.clear();
+}
+
+void IppResponseCache::Evict() {
+  const base::TimeTicks now = clock_->NowTicks();
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (now - it->second.time >= kTtl) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  while (entries_.size() > kMaxEntries) {
+    entries_.erase(std::min_element(
+        entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+          return a.second.time < b.second.time;
+        }));
+  }
+}
+
+}  // namespace cups_proxy
@@ -0,0 +1,73 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CUPS_PROXY_IPP_RESPONSE_CACHE_H_
+#define CUPS_PROXY_IPP_RESPONSE_CACHE_H_
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+
+#include <base/time/default_tick_clock.h>
+#include <base/time/tick_clock.h>
+#include <base/time/time.h>
+
+#include "cups_proxy/mhd_http_request.h"
+#include "cups_proxy/mojo_handler.h"
+
+namespace cups_proxy {
+
+// IppResponseCache keeps the responses to IPP Get-Printer-Attributes requests
+// for a short time. Print setup flows send the same Get-Printer-Attributes
+// request many times in a row, and each of them would otherwise take a round
+// trip through Chrome to CUPS.
+//
+// This class is not thread-safe.
+class IppResponseCache {
+ public:
+  // How long a response is served from the cache.
+  static constexpr base::TimeDelta kTtl = base::Seconds(3);
+  // Maximum number of responses kept.
+  static constexpr size_t kMaxEntries = 16;
+
+  explicit IppResponseCache(
+      const base::TickClock* clock = base::DefaultTickClock::GetInstance());
+  IppResponseCache(const IppResponseCache&) = delete;
+  IppResponseCache& operator=(const IppResponseCache&) = delete;
+  ~IppResponseCache();
+
+  // Returns the key the response to |request| is cached under, or
+  // std::nullopt if it can't be cached. Requests differing only by their
+  // request-id have the same key.
+  static std::optional<std::string> GetKey(const MHDHttpRequest& request);
+
+  // Returns the response cached under |key| if it hasn't expired, with its
+  // request-id set to the request-id of |request|.
+  std::optional<IppResponse> Get(const std::string& key,
+                                 const MHDHttpRequest& request);
+
+  // Caches |response| under |key|, unless it is an error.
+  void Put(const std::string& key, const IppResponse& response);
+
+  // Drops all the cached responses.
+  void Clear();
+
+ private:
+  struct Entry {
+    base::TimeTicks time;
+    IppResponse response;
+  };
+
+  // Drops the expired responses, and the oldest ones if there are still too
+  // many.
+  void Evict();
+
+  const base::TickClock* clock_;
+  std::map<std::string, Entry> entries_;
+};
+
+}  // namespace cups_proxy
+
+#endif  // CUPS_PROXY_IPP_RESPONSE_CACHE_H_
@@ -0,0 +1,165 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cups_proxy/ipp_response_cache.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <base/strings/string_piece.h>
+#include <base/test/simple_test_tick_clock.h>
+#include <chromeos/libipp/builder.h>
+#include <chromeos/libipp/frame.h>
+#include <chromeos/libipp/ipp_enums.h>
+#include <gtest/gtest.h>
+
+namespace cups_proxy {
+namespace {
+
+constexpr char kUrl[] = "/printers/test";
+constexpr char kPrinterUri[] = "ipp://localhost/printers/test";
+
+MHDHttpRequest MakeRequest(ipp::Operation operation,
+                           int32_t request_id,
+                           const std::string& url = kUrl,
+                           const std::string& printer_uri = kPrinterUri) {
+  ipp::Frame frame(operation, ipp::Version::_1_1, request_id);
+  frame.Groups(ipp::GroupTag::operation_attributes)[0].AddAttr(
+      "printer-uri", ipp::ValueTag::uri, printer_uri);
+  const std::vector<uint8_t> data = ipp::BuildBinaryFrame(frame);
+
+  MHDHttpRequest request;
+  request.SetStatusLine("POST", url, "HTTP/1.1");
+  request.PushToBody(base::StringPiece(
+      reinterpret_cast<const char*>(data.data()), data.size()));
+  request.Finalize();
+  return request;
+}
+
+IppResponse MakeResponse(ipp::Status status,
+                         int32_t request_id,
+                         int http_status_code = 200) {
+  ipp::Frame frame(status, ipp::Version::_1_1, request_id);
+  IppResponse response;
+  response.http_status_code = http_status_code;
+  auto header = mojom::HttpHeader::New();
+  header->key = "Content-Type";
+  header->value = "application/ipp";
+  response.headers.push_back(std::move(header));
+  response.body = ipp::BuildBinaryFrame(frame);
+  return response;
+}
+
+TEST(IppResponseCacheTest, GetKeyIgnoresRequestId) {
+  const auto key = IppResponseCache::GetKey(
+      MakeRequest(ipp::Operation::Get_Printer_Attributes, 1));
+  ASSERT_TRUE(key);
+  EXPECT_EQ(key, IppResponseCache::GetKey(MakeRequest(
+                     ipp::Operation::Get_Printer_Attributes, 2)));
+  EXPECT_NE(key, IppResponseCache::GetKey(
+                     MakeRequest(ipp::Operation::Get_Printer_Attributes, 1,
+                                 "/printers/other")));
+  EXPECT_NE(key, IppResponseCache::GetKey(MakeRequest(
+                     ipp::Operation::Get_Printer_Attributes, 1, kUrl,
+                     "ipp://localhost/printers/other")));
+}
+
+TEST(IppResponseCacheTest, GetKeySkipsOtherRequests) {
+  EXPECT_FALSE(
+      IppResponseCache::GetKey(MakeRequest(ipp::Operation::Print_Job, 1)));
+
+  MHDHttpRequest get_request;
+  get_request.SetStatusLine("GET", kUrl, "HTTP/1.1");
+  EXPECT_FALSE(IppResponseCache::GetKey(get_request));
+
+  MHDHttpRequest malformed_request;
+  malformed_request.SetStatusLine("POST", kUrl, "HTTP/1.1");
+  malformed_request.PushToBody("not an IPP request");
+  EXPECT_FALSE(IppResponseCache::GetKey(malformed_request));
+}
+
+TEST(IppResponseCacheTest, GetSetsRequestId) {
+  base::SimpleTestTickClock clock;
+  IppResponseCache cache(&clock);
+  const MHDHttpRequest request =
+      MakeRequest(ipp::Operation::Get_Printer_Attributes, 7);
+  const std::string key = *IppResponseCache::GetKey(request);
+  EXPECT_FALSE(cache.Get(key, request));
+
+  cache.Put(key, MakeResponse(ipp::Status::successful_ok, 1));
+  std::optional<IppResponse> response = cache.Get(key, request);
+  ASSERT_TRUE(response);
+  EXPECT_EQ(response->http_status_code, 200);
+  ASSERT_EQ(response->headers.size(), 1);
+  EXPECT_EQ(response->headers[0]->key, "Content-Type");
+  EXPECT_EQ(response->body,
+            MakeResponse(ipp::Status::successful_ok, 7).body);
+}
+
+TEST(IppResponseCacheTest, ResponsesExpire) {
+  base::SimpleTestTickClock clock;
+  IppResponseCache cache(&clock);
+  const MHDHttpRequest request =
+      MakeRequest(ipp::Operation::Get_Printer_Attributes, 1);
+  const std::string key = *IppResponseCache::GetKey(request);
+
+  cache.Put(key, MakeResponse(ipp::Status::successful_ok, 1));
+  clock.Advance(IppResponseCache::kTtl - base::Milliseconds(1));
+  EXPECT_TRUE(cache.Get(key, request));
+  clock.Advance(base::Milliseconds(1));
+  EXPECT_FALSE(cache.Get(key, request));
+}
+
+TEST(IppResponseCacheTest, ErrorsAreNotCached) {
+  base::SimpleTestTickClock clock;
+  IppResponseCache cache(&clock);
+  const MHDHttpRequest request =
+      MakeRequest(ipp::Operation::Get_Printer_Attributes, 1);
+  const std::string key = *IppResponseCache::GetKey(request);
+
+  cache.Put(key, MakeResponse(ipp::Status::successful_ok, 1,
+                              /*http_status_code=*/500));
+  EXPECT_FALSE(cache.Get(key, request));
+  cache.Put(key, MakeResponse(ipp::Status::client_error_not_found, 1));
+  EXPECT_FALSE(cache.Get(key, request));
+  cache.Put(key, IppResponse{.http_status_code = 200});
+  EXPECT_FALSE(cache.Get(key, request));
+}
+
+TEST(IppResponseCacheTest, Clear) {
+  base::SimpleTestTickClock clock;
+  IppResponseCache cache(&clock);
+  const MHDHttpRequest request =
+      MakeRequest(ipp::Operation::Get_Printer_Attributes, 1);
+  const std::string key = *IppResponseCache::GetKey(request);
+
+  cache.Put(key, MakeResponse(ipp::Status::successful_ok, 1));
+  cache.Clear();
+  EXPECT_FALSE(cache.Get(key, request));
+}
+
+TEST(IppResponseCacheTest, EvictsOldestResponses) {
+  base::SimpleTestTickClock clock;
+  IppResponseCache cache(&clock);
+  std::vector<MHDHttpRequest> requests;
+  for (size_t i = 0; i <= IppResponseCache::kMaxEntries; ++i) {
+    requests.push_back(MakeRequest(ipp::Operation::Get_Printer_Attributes, 1,
+                                   kUrl + std::to_string(i)));
+    cache.Put(*IppResponseCache::GetKey(requests.back()),
+              MakeResponse(ipp::Status::successful_ok, 1));
+    clock.Advance(base::Milliseconds(1));
+  }
+
+  EXPECT_FALSE(
+      cache.Get(*IppResponseCache::GetKey(requests.front()), requests.front()));
+  for (size_t i = 1; i < requests.size(); ++i) {
+    EXPECT_TRUE(
+        cache.Get(*IppResponseCache::GetKey(requests[i]), requests[i]));
+  }
+}
+
+}  // namespace
+}  // namespace cups_proxy
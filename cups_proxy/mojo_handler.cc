@@ -5,6 +5,7 @@
 #include "cups_proxy/mojo_handler.h"
 
 #include <map>
+#include <optional>
 #include <utility>
 
 #include <base/check.h>
@@ -13,6 +14,8 @@
 #include <base/task/thread_pool.h>
 #include <chromeos/dbus/service_constants.h>
 
+#include "cups_proxy/ipp_response_cache.h"
+
 namespace cups_proxy {
 
 namespace {
@@ -51,7 +54,8 @@ IppHeaders ConvertHeadersToMojom(
 
 }  // namespace
 
-MojoHandler::MojoHandler() = default;
+MojoHandler::MojoHandler()
+    : response_cache_(std::make_unique<IppResponseCache>()) {}
 
 MojoHandler::~MojoHandler() {
   // The message pipe is bound on the mojo task runner, and it has to be closed
@@ -127,6 +131,19 @@ void MojoHandler::ProxyRequestOnThread(
 IppResponse MojoHandler::ProxyRequestSync(const MHDHttpRequest& request) {
   DCHECK(!mojo_task_runner_->BelongsToCurrentThread());
 
+  const std::optional<std::string> cache_key =
+      IppResponseCache::GetKey(request);
+  if (cache_key) {
+    std::optional<IppResponse> cached_response =
+        response_cache_->Get(*cache_key, request);
+    if (cached_response) {
+      return std::move(*cached_response);
+    }
+  } else {
+    // Any other request may change the attributes of the printers.
+    response_cache_->Clear();
+  }
+
   const std::string& url = request.url();
   const std::string& method = request.method();
   const std::string& version = request.version();
@@ -163,6 +180,9 @@ IppResponse MojoHandler::ProxyRequestSync(const MHDHttpRequest& request) {
   DVLOG(2) << "response headers = " << ShowHeaders(response.headers);
   DVLOG(2) << "response body = " << ShowBody(response.body);
 
+  if (cache_key) {
+    response_cache_->Put(*cache_key, response);
+  }
   return response;
 }
 
@@ -5,6 +5,7 @@
 #ifndef CUPS_PROXY_MOJO_HANDLER_H_
 #define CUPS_PROXY_MOJO_HANDLER_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,6 +20,8 @@
 
 namespace cups_proxy {
 
+class IppResponseCache;
+
 using IppHeaders = std::vector<mojom::HttpHeaderPtr>;
 using IppBody = std::vector<uint8_t>;
 
@@ -48,7 +51,8 @@ class MojoHandler {
   //
   // This calls method ProxyRequest@0 on the mojo interface. If called before
   // the mojo pipe is bound, the request would be queued and send after pipe is
-  // bound.
+  // bound. Get-Printer-Attributes requests may be answered from a short-lived
+  // cache instead. This must always be called from the same thread.
   IppResponse ProxyRequestSync(const MHDHttpRequest& request);
 
  private:
@@ -73,6 +77,9 @@ class MojoHandler {
 
   // Queued requests that come before |chrome_proxy_| is ready.
   std::vector<base::OnceClosure> queued_requests_;
+
+  // Responses to recent requests. Only used by ProxyRequestSync().
+  std::unique_ptr<IppResponseCache> response_cache_;
 };
 }  // namespace cups_proxy
 
@@ -203,6 +203,19 @@ bool DebugdDBusAdaptor::GetPerfOutputV2(
                                      session_id, error);
 }
 
+bool DebugdDBusAdaptor::StartContinuousPerf(brillo::ErrorPtr* error) {
+  return perf_tool_->StartContinuousPerf(error);
+}
+
+bool DebugdDBusAdaptor::StopContinuousPerf(brillo::ErrorPtr* error) {
+  return perf_tool_->StopContinuousPerf(error);
+}
+
+bool DebugdDBusAdaptor::GetContinuousPerfSnapshot(
+    brillo::ErrorPtr* error, const base::ScopedFD& stdout_fd) {
+  return perf_tool_->GetContinuousPerfSnapshot(stdout_fd, error);
+}
+
 void DebugdDBusAdaptor::DumpDebugLogs(bool is_compressed,
                                       const base::ScopedFD& fd) {
   debug_logs_tool_->GetDebugLogs(is_compressed, fd);
@@ -113,6 +113,10 @@ class DebugdDBusAdaptor : public org::chromium::debugdAdaptor,
                        bool disable_cpu_idle,
                        const base::ScopedFD& stdout_fd,
                        uint64_t* session_id) override;
+  bool StartContinuousPerf(brillo::ErrorPtr* error) override;
+  bool StopContinuousPerf(brillo::ErrorPtr* error) override;
+  bool GetContinuousPerfSnapshot(brillo::ErrorPtr* error,
+                                 const base::ScopedFD& stdout_fd) override;
   void DumpDebugLogs(bool is_compressed, const base::ScopedFD& fd) override;
   void SetDebugMode(const std::string& subsystem) override;
   std::string GetLog(const std::string& name) override;
@@ -17,6 +17,7 @@
 #include <pwd.h>
 #include <stdint.h>
 #include <string>
+#include <string_view>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -31,6 +32,7 @@
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
 #include <base/json/json_writer.h>
+#include <base/json/string_escape.h>
 #include <base/logging.h>
 #include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
@@ -677,6 +679,46 @@ void SerializeLogsAsJSON(const base::Value::Dict& dictionary,
   base::WriteFileDescriptor(fd.get(), logs_json);
 }
 
+// Writes a JSON dictionary to a file descriptor one member at a time, so that
+// the logs don't all have to be held in memory to be serialized.
+class JSONDictionaryStreamWriter {
+ public:
+  explicit JSONDictionaryStreamWriter(const base::ScopedFD& fd) : fd_(fd) {}
+  JSONDictionaryStreamWriter(const JSONDictionaryStreamWriter&) = delete;
+  JSONDictionaryStreamWriter& operator=(const JSONDictionaryStreamWriter&) =
+      delete;
+
+  void WriteValue(std::string_view key, const base::Value& value) {
+    std::string value_json;
+    base::JSONWriter::Write(value, &value_json);
+    WriteMember(key, value_json);
+  }
+
+  void WriteString(std::string_view key, std::string_view value) {
+    std::string value_json;
+    base::EscapeJSONString(value, /*put_in_quotes=*/true, &value_json);
+    WriteMember(key, value_json);
+  }
+
+  // Closes the dictionary. Nothing may be written after this.
+  void Finish() {
+    base::WriteFileDescriptor(fd_.get(), is_empty_ ? "{}\n" : "\n}\n");
+  }
+
+ private:
+  void WriteMember(std::string_view key, std::string_view value_json) {
+    std::string prefix = is_empty_ ? "{\n   " : ",\n   ";
+    base::EscapeJSONString(key, /*put_in_quotes=*/true, &prefix);
+    prefix += ": ";
+    base::WriteFileDescriptor(fd_.get(), prefix);
+    base::WriteFileDescriptor(fd_.get(), value_json);
+    is_empty_ = false;
+  }
+
+  const base::ScopedFD& fd_;
+  bool is_empty_ = true;
+};
+
 template <std::size_t N>
 bool GetNamedLogFrom(const string& name,
                      const std::array<Log, N>& logs,
@@ -1099,7 +1141,8 @@ bool LogTool::ParallelLogCollector::StartGetLogs(
   return true;
 }
 
-void LogTool::ParallelLogCollector::EndGetLogs(base::Value::Dict* dict) {
+void LogTool::ParallelLogCollector::EndGetLogs(const base::Value::Dict& dict,
+                                               const base::ScopedFD& fd) {
   const base::TimeDelta sleep_interval = base::Seconds(1);
   // Wait for the controller to finish or until the deadline.
   int status;
@@ -1110,27 +1153,36 @@ void LogTool::ParallelLogCollector::EndGetLogs(base::Value::Dict* dict) {
     sleep(sleep_interval.InSeconds());
   }
 
+  JSONDictionaryStreamWriter writer(fd);
+  for (const auto [name, value] : dict) {
+    writer.WriteValue(name, value);
+  }
   for (auto const& pair : file_log_map_) {
     const Log& log = pair.second;
+    if (dict.contains(log.GetName()))
+      continue;
     std::string data;
     if (base::ReadFileToString(pair.first, &data)) {
       if (data.empty()) {
-        dict->Set(pair.second.GetName(), kLogEmpty);
+        writer.WriteString(log.GetName(), kLogEmpty);
       } else {
         // If the log size exceeds the specified limit, tail it.
         if (data.size() > log.GetMaxBytes()) {
           data.erase(0, data.size() - log.GetMaxBytes());
         }
-        std::string encoded_data =
-            LogTool::EncodeString(std::move(data), log.GetEncoding());
-        dict->Set(log.GetName(), std::move(encoded_data));
+        writer.WriteString(
+            log.GetName(),
+            LogTool::EncodeString(std::move(data), log.GetEncoding()));
       }
     } else {
       LOG(ERROR) << "EndGetLogs: failed to read file=" << pair.first.value()
                  << ", log=" << log.GetName();
-      dict->Set(log.GetName(), kLogNotAvailable);
+      writer.WriteString(log.GetName(), kLogNotAvailable);
     }
+    // The temp dir may be in memory, so release each log once it is written.
+    brillo::DeleteFile(pair.first);
   }
+  writer.Finish();
 }
 
 void LogTool::ParallelLogCollector::CollectLogs(
@@ -1462,9 +1514,6 @@ void LogTool::GetFeedbackLogsV3(const base::ScopedFD& fd,
     dictionary.Set(map.first, map.second);
   }
 
-  // Wait for all child processes to complete and load the log data.
-  log_helper.EndGetLogs(&dictionary);
-
   // The /usr/bin/chromeos-pgmem command gave the following error when run in
   // log_helper: WARNING chromeos-pgmem: [process_meter.cc(255)] Unknown chrome
   // process t.
@@ -1487,7 +1536,9 @@ void LogTool::GetFeedbackLogsV3(const base::ScopedFD& fd,
     dictionary.Set(kNetLog.GetName(), kNetLog.GetLogData());
   }
 
-  SerializeLogsAsJSON(dictionary, fd);
+  // Wait for all child processes to complete and stream their logs to |fd|
+  // along with |dictionary|, one log at a time.
+  log_helper.EndGetLogs(dictionary, fd);
 }
 
 std::string GetSanitizedUsername(
@@ -124,10 +124,12 @@ class LogTool : public debugd::LogProvider {
     // Starts asynchronous log collection. Each log will be saved to a temp
     // file. Returns false if temp folder creation fails.
     bool StartGetLogs(const std::vector<Log>& log_list);
-    // Insert logs collected to the |dict|. Must be called after StartGetLogs().
-    // It will wait maximum !timeout_seconds| seconds. The logs which have not
+    // Writes the logs collected and the entries of |dict| to |fd| as one JSON
+    // dictionary. The entries of |dict| replace the collected logs of the same
+    // name. Must be called after StartGetLogs(). It will wait at most the
+    // |max_wait_time| given to the constructor. The logs which have not
     // finished on time may not be collected.
-    void EndGetLogs(base::Value::Dict* dict);
+    void EndGetLogs(const base::Value::Dict& dict, const base::ScopedFD& fd);
 
    private:
     void CollectLogs(const std::map<base::FilePath, Log>& filepath_logs,
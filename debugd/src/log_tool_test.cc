@@ -7,12 +7,18 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include <base/files/file.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
+#include <base/files/scoped_file.h>
 #include <base/files/scoped_temp_dir.h>
+#include <base/json/json_reader.h>
+#include <base/time/time.h>
+#include <base/values.h>
 #include <dbus/mock_bus.h>
 #include <gtest/gtest.h>
 #include <cryptohome/proto_bindings/rpc.pb.h>
@@ -331,4 +337,45 @@ TEST_F(LogTest, GetCommandLogData) {
   log_three.DisableMinijailForTest();
   EXPECT_EQ(log_three.GetLogData(), "b\n");
 }
+
+TEST_F(LogTest, ParallelLogCollectorWritesJSON) {
+  base::ScopedTempDir temp;
+  ASSERT_TRUE(temp.CreateUniqueTempDir());
+
+  base::FilePath file_one = temp.GetPath().Append("test/file_one");
+  ASSERT_TRUE(CreateDirectoryAndWriteFile(file_one, "test_one_contents"));
+  base::FilePath file_two = temp.GetPath().Append("test/file_two");
+  ASSERT_TRUE(CreateDirectoryAndWriteFile(file_two, "test_two_contents"));
+  base::FilePath file_missing = temp.GetPath().Append("test/file_missing");
+  const std::vector<LogTool::Log> logs = {
+      LogTool::Log(LogTool::Log::kFile, "test_log_one", file_one.value(),
+                   user_name_, group_name_),
+      LogTool::Log(LogTool::Log::kFile, "test_log_two", file_two.value(),
+                   user_name_, group_name_),
+      LogTool::Log(LogTool::Log::kFile, "test_log_missing",
+                   file_missing.value(), user_name_, group_name_),
+  };
+
+  LogTool::ParallelLogCollector collector(base::Seconds(30));
+  ASSERT_TRUE(collector.StartGetLogs(logs));
+
+  base::Value::Dict dict;
+  dict.Set("test_log_two", "in_process_contents");
+  dict.Set("test_extra", "test_extra_contents");
+  base::FilePath output = temp.GetPath().Append("output.json");
+  base::File output_file(output,
+                         base::File::FLAG_CREATE | base::File::FLAG_WRITE);
+  ASSERT_TRUE(output_file.IsValid());
+  collector.EndGetLogs(dict, base::ScopedFD(output_file.TakePlatformFile()));
+
+  std::string json;
+  ASSERT_TRUE(base::ReadFileToString(output, &json));
+  std::optional<base::Value::Dict> result = base::JSONReader::ReadDict(json);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->size(), 4);
+  EXPECT_EQ(*result->FindString("test_log_one"), "test_one_contents");
+  EXPECT_EQ(*result->FindString("test_log_two"), "in_process_contents");
+  EXPECT_EQ(*result->FindString("test_log_missing"), "<not available>");
+  EXPECT_EQ(*result->FindString("test_extra"), "test_extra_contents");
+}
 }  // namespace debugd
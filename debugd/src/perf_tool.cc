@@ -13,6 +13,7 @@
 
 #include <base/check.h>
 #include <base/check_op.h>
+#include <base/files/file_enumerator.h>
 #include <base/functional/bind.h>
 #include <base/json/json_reader.h>
 #include <base/json/json_writer.h>
@@ -44,6 +45,24 @@ const char kArgsError[] =
 
 // Location of quipper on ChromeOS.
 const char kQuipperLocation[] = "/usr/bin/quipper";
+// Location of perf on ChromeOS.
+const char kPerfLocation[] = "/usr/bin/perf";
+const char kCatLocation[] = "/bin/cat";
+
+// Directory where the continuous profiling keeps its profiles.
+constexpr char kContinuousPerfDir[] = "/var/cache/debugd/perf_tool";
+// perf writes the profile to this file and renames it to
+// perf.data.<timestamp> every kContinuousPerfSwitchOutput.
+constexpr char kContinuousPerfOutputFile[] = "perf.data";
+constexpr char kContinuousPerfSnapshotPattern[] = "perf.data.*";
+// A sampling frequency this low still catches what keeps the CPUs busy over
+// minutes. With call graphs of all CPUs, an hour of profile still takes about
+// 100 MB, so perf rotates the output by size: the 8 completed files and the
+// one being written take at most 72 MiB.
+constexpr char kContinuousPerfFrequency[] = "11";
+constexpr char kContinuousPerfMmapPages[] = "16";
+constexpr char kContinuousPerfSwitchOutput[] = "--switch-output=8M";
+constexpr char kContinuousPerfMaxFiles[] = "--switch-max-files=8";
 
 // Location of the file which contains the range of online CPU numbers.
 const char kCpuTopologyLocation[] = "/sys/devices/system/cpu/online";
@@ -233,8 +252,32 @@ void RestoreCpuIdleStates() {
   brillo::DeleteFile(cpuidle_states_map);
 }
 
+// Deletes the profiles left by a previous continuous profiling session.
+void DeleteContinuousPerfProfiles(const base::FilePath& dir) {
+  base::FileEnumerator files(dir, /*recursive=*/false,
+                             base::FileEnumerator::FILES,
+                             std::string(kContinuousPerfOutputFile) + "*");
+  for (base::FilePath file = files.Next(); !file.empty(); file = files.Next())
+    brillo::DeleteFile(file);
+}
+
 }  // namespace
 
+std::optional<base::FilePath> GetLatestContinuousPerfSnapshot(
+    const base::FilePath& dir) {
+  // The snapshots are named after the time they were taken, so the latest one
+  // sorts last.
+  std::optional<base::FilePath> latest;
+  base::FileEnumerator files(dir, /*recursive=*/false,
+                             base::FileEnumerator::FILES,
+                             kContinuousPerfSnapshotPattern);
+  for (base::FilePath file = files.Next(); !file.empty(); file = files.Next()) {
+    if (!latest || latest->BaseName().value() < file.BaseName().value())
+      latest = file;
+  }
+  return latest;
+}
+
 bool ValidateQuipperArguments(const std::vector<std::string>& qp_args,
                               PerfSubcommand& subcommand,
                               brillo::ErrorPtr* error) {
@@ -528,6 +571,117 @@ bool PerfTool::StopPerf(uint64_t session_id, brillo::ErrorPtr* error) {
   return true;
 }
 
+bool PerfTool::StartContinuousPerf(brillo::ErrorPtr* error) {
+  if (continuous_perf_running()) {
+    DEBUGD_ADD_ERROR(error, kProcessErrorName,
+                     "Continuous profiling is already running.");
+    return false;
+  }
+
+  const base::FilePath dir(kContinuousPerfDir);
+  DeleteContinuousPerfProfiles(dir);
+
+  auto perf_process = std::make_unique<SandboxedProcess>();
+  perf_process->SandboxAs("root", "root");
+  if (!perf_process->Init()) {
+    DEBUGD_ADD_ERROR(error, kProcessErrorName,
+                     "Process initialization failure.");
+    return false;
+  }
+
+  for (const char* arg :
+       {kPerfLocation, "record", "-a", "-g", "-F", kContinuousPerfFrequency,
+        "-m", kContinuousPerfMmapPages, kContinuousPerfSwitchOutput,
+        kContinuousPerfMaxFiles, "-o"}) {
+    perf_process->AddArg(arg);
+  }
+  perf_process->AddArg(dir.Append(kContinuousPerfOutputFile).value());
+  // perf reports each switch of the output file, which nobody reads.
+  perf_process->RedirectOutput("/dev/null");
+
+  if (!perf_process->Start()) {
+    DEBUGD_ADD_ERROR(error, kProcessErrorName, "Process start failure.");
+    return false;
+  }
+  continuous_perf_process_ = std::move(perf_process);
+  DCHECK_GT(continuous_perf_process_->pid(), 0);
+
+  process_reaper_.WatchForChild(
+      FROM_HERE, continuous_perf_process_->pid(),
+      base::BindOnce(&PerfTool::OnContinuousPerfProcessExited,
+                     base::Unretained(this)));
+  return true;
+}
+
+bool PerfTool::StopContinuousPerf(brillo::ErrorPtr* error) {
+  if (!continuous_perf_running()) {
+    DEBUGD_ADD_ERROR(error, kStopProcessErrorName,
+                     "Continuous profiling not started");
+    return false;
+  }
+
+  // Stop by sending SIGINT, so that perf exits cleanly. The process will be
+  // reaped in OnContinuousPerfProcessExited(), which deletes the profiles.
+  DCHECK_GT(continuous_perf_process_->pid(), 0);
+  if (kill(continuous_perf_process_->pid(), SIGINT) != 0) {
+    PLOG(WARNING) << "Failed to stop the continuous profiling.";
+  }
+  return true;
+}
+
+bool PerfTool::GetContinuousPerfSnapshot(const base::ScopedFD& stdout_fd,
+                                         brillo::ErrorPtr* error) {
+  std::optional<base::FilePath> snapshot =
+      GetLatestContinuousPerfSnapshot(base::FilePath(kContinuousPerfDir));
+  if (!snapshot) {
+    DEBUGD_ADD_ERROR(error, kProcessErrorName,
+                     "No continuous profiling snapshot available.");
+    return false;
+  }
+
+  // The snapshot can take a while to go through |stdout_fd|, so it is copied
+  // in the background. The copy keeps the file open, and so its content, even
+  // if perf rotates it out or the continuous profiling stops meanwhile.
+  auto cat_process = std::make_unique<SandboxedProcess>();
+  cat_process->SandboxAs("root", "root");
+  if (!cat_process->Init()) {
+    DEBUGD_ADD_ERROR(error, kProcessErrorName,
+                     "Process initialization failure.");
+    return false;
+  }
+  cat_process->AddArg(kCatLocation);
+  cat_process->AddArg(snapshot->value());
+  cat_process->BindFd(stdout_fd.get(), STDOUT_FILENO);
+  if (!cat_process->Start()) {
+    DEBUGD_ADD_ERROR(error, kProcessErrorName, "Process start failure.");
+    return false;
+  }
+  const pid_t pid = cat_process->pid();
+  DCHECK_GT(pid, 0);
+  snapshot_processes_[pid] = std::move(cat_process);
+  process_reaper_.WatchForChild(
+      FROM_HERE, pid,
+      base::BindOnce(&PerfTool::OnSnapshotProcessExited,
+                     base::Unretained(this), pid));
+  return true;
+}
+
+void PerfTool::OnContinuousPerfProcessExited(const siginfo_t& siginfo) {
+  continuous_perf_process_->Wait();
+  continuous_perf_process_ = nullptr;
+  // Don't leave up to 72 MiB of profiles behind.
+  DeleteContinuousPerfProfiles(base::FilePath(kContinuousPerfDir));
+}
+
+void PerfTool::OnSnapshotProcessExited(pid_t pid, const siginfo_t& siginfo) {
+  auto it = snapshot_processes_.find(pid);
+  DCHECK(it != snapshot_processes_.end());
+  it->second->Wait();
+  if (siginfo.si_code != CLD_EXITED || siginfo.si_status != 0)
+    LOG(WARNING) << "Failed to write the continuous profiling snapshot.";
+  snapshot_processes_.erase(it);
+}
+
 void PerfTool::EtmStrobbingSettings() {
   const base::FilePath window_path = base::FilePath(
       base::StringPrintf(kStrobbingSettingPathPattern, "window"));
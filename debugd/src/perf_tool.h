@@ -5,6 +5,7 @@
 #ifndef DEBUGD_SRC_PERF_TOOL_H_
 #define DEBUGD_SRC_PERF_TOOL_H_
 
+#include <sys/types.h>
 #include <sys/utsname.h>
 
 #include <cstdint>
@@ -14,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include <base/files/file_path.h>
 #include <base/files/file_util.h>
 #include <base/files/scoped_file.h>
 #include <brillo/asynchronous_signal_handler.h>
@@ -35,6 +37,11 @@ bool ValidateQuipperArguments(const std::vector<std::string>& qp_args,
                               PerfSubcommand& subcommand,
                               brillo::ErrorPtr* error);
 
+// Returns the most recent perf.data file that the continuous profiling has
+// finished writing in |dir|, if any.
+std::optional<base::FilePath> GetLatestContinuousPerfSnapshot(
+    const base::FilePath& dir);
+
 class PerfTool {
  public:
   PerfTool();
@@ -80,9 +87,29 @@ class PerfTool {
                        uint64_t* session_id,
                        brillo::ErrorPtr* error);
 
+  // Starts continuous, low frequency, system-wide profiling until
+  // StopContinuousPerf() is called. perf writes the profile to a rotating set
+  // of files on disk, so the total size stays bounded. Profiles from a
+  // previous continuous profiling session are deleted.
+  bool StartContinuousPerf(brillo::ErrorPtr* error);
+
+  // Stops the continuous profiling and deletes the profiles recorded so far.
+  bool StopContinuousPerf(brillo::ErrorPtr* error);
+
+  // Writes the most recent complete profile of the continuous profiling, in
+  // the perf.data format, to |stdout_fd|. The profile is written in the
+  // background, after this returns.
+  bool GetContinuousPerfSnapshot(const base::ScopedFD& stdout_fd,
+                                 brillo::ErrorPtr* error);
+
  private:
   inline bool perf_running() const { return quipper_process_ != nullptr; }
+  inline bool continuous_perf_running() const {
+    return continuous_perf_process_ != nullptr;
+  }
   void OnQuipperProcessExited(const siginfo_t& siginfo);
+  void OnContinuousPerfProcessExited(const siginfo_t& siginfo);
+  void OnSnapshotProcessExited(pid_t pid, const siginfo_t& siginfo);
 
   // Change the proper strobbing settings before starting ETM collection.
   // TODO(b/209861754): remove this when we have implemented a preset for
@@ -92,6 +119,9 @@ class PerfTool {
   std::optional<uint64_t> profiler_session_id_;
   std::unique_ptr<SandboxedProcess> quipper_process_;
   base::ScopedFD quipper_process_output_fd_;
+  std::unique_ptr<SandboxedProcess> continuous_perf_process_;
+  // Processes writing continuous profiling snapshots, by pid.
+  std::map<pid_t, std::unique_ptr<SandboxedProcess>> snapshot_processes_;
   brillo::AsynchronousSignalHandler signal_handler_;
   brillo::ProcessReaper process_reaper_;
   bool etm_available;
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
 #include <gtest/gtest.h>
 
 #include "debugd/src/perf_tool.h"
@@ -60,4 +63,22 @@ TEST(PerfToolTest, UnsupportedPerfSubcommand) {
   EXPECT_EQ(subcommand, PERF_COMMAND_UNSUPPORTED);
 }
 
+TEST(PerfToolTest, GetLatestContinuousPerfSnapshot) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath& dir = temp_dir.GetPath();
+
+  EXPECT_FALSE(GetLatestContinuousPerfSnapshot(dir));
+
+  // The profile perf is still writing is not a snapshot.
+  ASSERT_TRUE(base::WriteFile(dir.Append("perf.data"), ""));
+  EXPECT_FALSE(GetLatestContinuousPerfSnapshot(dir));
+
+  ASSERT_TRUE(base::WriteFile(dir.Append("perf.data.20240101120500000"), ""));
+  ASSERT_TRUE(base::WriteFile(dir.Append("perf.data.20240101121000000"), ""));
+  ASSERT_TRUE(base::WriteFile(dir.Append("perf.data.20240101120000000"), ""));
+  EXPECT_EQ(GetLatestContinuousPerfSnapshot(dir),
+            dir.Append("perf.data.20240101121000000"));
+}
+
 }  // namespace debugd
@@ -567,6 +567,11 @@ void EventSubscriber::OnEvent(const mojom::EventInfoPtr info) {
     case mojom::EventInfo::Tag::kCrashEventInfo:
       OutputCrashEventInfo(info->get_crash_event_info());
       break;
+    case mojom::EventInfo::Tag::kCoalescedEventInfo:
+      for (auto& event : info->get_coalesced_event_info()->events) {
+        OnEvent(std::move(event));
+      }
+      break;
   }
 }
 
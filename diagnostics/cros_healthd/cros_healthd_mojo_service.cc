@@ -87,6 +87,14 @@ void CrosHealthdMojoService::IsEventSupported(
   event_aggregator_->IsEventSupported(category, std::move(callback));
 }
 
+void CrosHealthdMojoService::AddEventObserverWithOptions(
+    mojom::EventCategoryEnum category,
+    mojo::PendingRemote<mojom::EventObserver> observer,
+    mojom::EventObserverOptionsPtr options) {
+  event_aggregator_->AddObserver(category, std::move(observer),
+                                 std::move(options));
+}
+
 void CrosHealthdMojoService::ProbeProcessInfo(
     uint32_t process_id, ProbeProcessInfoCallback callback) {
   ProcessFetcher(context_).FetchProcessInfo(static_cast<pid_t>(process_id),
@@ -107,4 +115,10 @@ void CrosHealthdMojoService::ProbeMultipleProcessInfo(
       process_ids, ignore_single_process_info, std::move(callback));
 }
 
+void CrosHealthdMojoService::ProbeResourceUsageSummary(
+    uint32_t window_seconds, ProbeResourceUsageSummaryCallback callback) {
+  std::move(callback).Run(
+      resource_usage_sampler_.GetSummary(base::Seconds(window_seconds)));
+}
+
 }  // namespace diagnostics
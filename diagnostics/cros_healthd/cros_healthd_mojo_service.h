@@ -15,6 +15,7 @@
 
 #include "diagnostics/cros_healthd/event_aggregator.h"
 #include "diagnostics/cros_healthd/fetch_aggregator.h"
+#include "diagnostics/cros_healthd/fetchers/resource_usage_sampler.h"
 #include "diagnostics/cros_healthd/routines/routine_service.h"
 #include "diagnostics/cros_healthd/utils/mojo_service_provider.h"
 #include "diagnostics/mojom/external/network_health.mojom.h"
@@ -72,6 +73,10 @@ class CrosHealthdMojoService final
       override;
   void IsEventSupported(ash::cros_healthd::mojom::EventCategoryEnum category,
                         IsEventSupportedCallback callback) override;
+  void AddEventObserverWithOptions(
+      ash::cros_healthd::mojom::EventCategoryEnum category,
+      mojo::PendingRemote<ash::cros_healthd::mojom::EventObserver> observer,
+      ash::cros_healthd::mojom::EventObserverOptionsPtr options) override;
 
   // ash::cros_healthd::mojom::CrosHealthdProbeService overrides:
   void ProbeProcessInfo(uint32_t process_id,
@@ -82,6 +87,9 @@ class CrosHealthdMojoService final
       const std::optional<std::vector<uint32_t>>& process_ids,
       bool ignore_single_process_info,
       ProbeMultipleProcessInfoCallback callback) override;
+  void ProbeResourceUsageSummary(
+      uint32_t window_seconds,
+      ProbeResourceUsageSummaryCallback callback) override;
 
  private:
   // Mojo service providers to provide services to mojo service manager.
@@ -96,6 +104,8 @@ class CrosHealthdMojoService final
   Context* const context_ = nullptr;
   FetchAggregator* const fetch_aggregator_ = nullptr;
   EventAggregator* const event_aggregator_ = nullptr;
+  // Samples the CPU and memory usage while clients request summaries.
+  ResourceUsageSampler resource_usage_sampler_{context_};
 };
 
 }  // namespace diagnostics
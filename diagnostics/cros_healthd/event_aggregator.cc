@@ -5,6 +5,7 @@
 #include <memory>
 #include <utility>
 
+#include <base/functional/bind.h>
 #include <metrics/metrics_library.h>
 
 #include "diagnostics/cros_healthd/event_aggregator.h"
@@ -113,6 +114,34 @@ void EventAggregator::AddObserver(
   }
 }
 
+void EventAggregator::AddObserver(
+    mojom::EventCategoryEnum category,
+    mojo::PendingRemote<mojom::EventObserver> observer,
+    mojom::EventObserverOptionsPtr options) {
+  if (options->max_batch_delay_ms == 0 || options->max_batch_size <= 1) {
+    AddObserver(category, std::move(observer));
+    return;
+  }
+
+  // The event source delivers the events to the batcher, which forwards them
+  // to |observer| in batches.
+  mojo::PendingRemote<mojom::EventObserver> batcher_remote;
+  auto event_batcher = std::make_unique<EventBatcher>(
+      std::move(observer), batcher_remote.InitWithNewPipeAndPassReceiver(),
+      base::Milliseconds(options->max_batch_delay_ms), options->max_batch_size,
+      base::BindOnce(&EventAggregator::RemoveEventBatcher,
+                     weak_ptr_factory_.GetWeakPtr()));
+  event_batchers_.insert(std::move(event_batcher));
+  AddObserver(category, std::move(batcher_remote));
+}
+
+void EventAggregator::RemoveEventBatcher(EventBatcher* event_batcher) {
+  auto it = event_batchers_.find(event_batcher);
+  if (it != event_batchers_.end()) {
+    event_batchers_.erase(it);
+  }
+}
+
 void EventAggregator::IsEventSupported(
     mojom::EventCategoryEnum category,
     mojom::CrosHealthdEventService::IsEventSupportedCallback callback) {
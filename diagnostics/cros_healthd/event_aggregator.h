@@ -7,12 +7,16 @@
 
 #include <memory>
 
+#include <base/containers/flat_set.h>
+#include <base/containers/unique_ptr_adapters.h>
+#include <base/memory/weak_ptr.h>
 #include <mojo/public/cpp/bindings/pending_remote.h>
 
 #include "diagnostics/cros_healthd/events/audio_events.h"
 #include "diagnostics/cros_healthd/events/audio_jack_events.h"
 #include "diagnostics/cros_healthd/events/bluetooth_events.h"
 #include "diagnostics/cros_healthd/events/crash_events.h"
+#include "diagnostics/cros_healthd/events/event_batcher.h"
 #include "diagnostics/cros_healthd/events/event_reporter.h"
 #include "diagnostics/cros_healthd/events/lid_events.h"
 #include "diagnostics/cros_healthd/events/power_events.h"
@@ -40,6 +44,13 @@ class EventAggregator final {
       ash::cros_healthd::mojom::EventCategoryEnum category,
       mojo::PendingRemote<ash::cros_healthd::mojom::EventObserver> observer);
 
+  // Like above, but batches the events delivered to |observer| as described by
+  // |options|.
+  void AddObserver(
+      ash::cros_healthd::mojom::EventCategoryEnum category,
+      mojo::PendingRemote<ash::cros_healthd::mojom::EventObserver> observer,
+      ash::cros_healthd::mojom::EventObserverOptionsPtr options);
+
   void IsEventSupported(ash::cros_healthd::mojom::EventCategoryEnum category,
                         ash::cros_healthd::mojom::CrosHealthdEventService::
                             IsEventSupportedCallback callback);
@@ -65,6 +76,8 @@ class EventAggregator final {
           observer);
 
  private:
+  void RemoveEventBatcher(EventBatcher* event_batcher);
+
   // The pointer to the Context object for accessing system utilities.
   Context* const context_;
 
@@ -81,6 +94,12 @@ class EventAggregator final {
   std::unique_ptr<CrashEvents> crash_events_;
   EventReporter event_reporter_{context_};
   GroundTruth ground_truth_{context_};
+  // The batchers of the observers added with batching options.
+  base::flat_set<std::unique_ptr<EventBatcher>, base::UniquePtrComparator>
+      event_batchers_;
+
+  // Must be the last class member.
+  base::WeakPtrFactory<EventAggregator> weak_ptr_factory_{this};
 };
 
 }  // namespace diagnostics
@@ -0,0 +1,80 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "diagnostics/cros_healthd/events/event_batcher.h"
+
+#include <utility>
+
+#include <base/check.h>
+#include <base/functional/bind.h>
+
+namespace diagnostics {
+
+namespace {
+
+namespace mojom = ::ash::cros_healthd::mojom;
+
+}  // namespace
+
+EventBatcher::EventBatcher(
+    mojo::PendingRemote<mojom::EventObserver> observer,
+    mojo::PendingReceiver<mojom::EventObserver> receiver,
+    base::TimeDelta max_batch_delay,
+    size_t max_batch_size,
+    base::OnceCallback<void(EventBatcher*)> on_disconnect)
+    : observer_(std::move(observer)),
+      receiver_(this, std::move(receiver)),
+      max_batch_delay_(max_batch_delay),
+      max_batch_size_(max_batch_size),
+      on_disconnect_(std::move(on_disconnect)) {
+  DCHECK_GT(max_batch_size_, 1u);
+  observer_.set_disconnect_handler(base::BindOnce(
+      &EventBatcher::OnObserverDisconnect, base::Unretained(this)));
+  receiver_.set_disconnect_with_reason_handler(base::BindOnce(
+      &EventBatcher::OnSourceDisconnect, base::Unretained(this)));
+}
+
+EventBatcher::~EventBatcher() = default;
+
+void EventBatcher::OnEvent(mojom::EventInfoPtr info) {
+  pending_events_.push_back(std::move(info));
+  if (pending_events_.size() >= max_batch_size_) {
+    Flush();
+  } else if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, max_batch_delay_,
+                       base::BindOnce(&EventBatcher::Flush,
+                                      base::Unretained(this)));
+  }
+}
+
+void EventBatcher::Flush() {
+  flush_timer_.Stop();
+  if (pending_events_.empty()) {
+    return;
+  }
+  // A single event is delivered as is, which needs no unpacking.
+  if (pending_events_.size() == 1) {
+    observer_->OnEvent(std::move(pending_events_[0]));
+  } else {
+    observer_->OnEvent(mojom::EventInfo::NewCoalescedEventInfo(
+        mojom::CoalescedEventInfo::New(std::move(pending_events_))));
+  }
+  pending_events_.clear();
+}
+
+void EventBatcher::OnObserverDisconnect() {
+  flush_timer_.Stop();
+  pending_events_.clear();
+  receiver_.reset();
+  std::move(on_disconnect_).Run(this);
+}
+
+void EventBatcher::OnSourceDisconnect(uint32_t custom_reason,
+                                      const std::string& description) {
+  Flush();
+  observer_.ResetWithReason(custom_reason, description);
+  std::move(on_disconnect_).Run(this);
+}
+
+}  // namespace diagnostics
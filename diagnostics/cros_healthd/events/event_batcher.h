@@ -0,0 +1,65 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef DIAGNOSTICS_CROS_HEALTHD_EVENTS_EVENT_BATCHER_H_
+#define DIAGNOSTICS_CROS_HEALTHD_EVENTS_EVENT_BATCHER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <base/functional/callback.h>
+#include <base/time/time.h>
+#include <base/timer/timer.h>
+#include <mojo/public/cpp/bindings/pending_receiver.h>
+#include <mojo/public/cpp/bindings/pending_remote.h>
+#include <mojo/public/cpp/bindings/receiver.h>
+#include <mojo/public/cpp/bindings/remote.h>
+
+#include "diagnostics/mojom/public/cros_healthd_events.mojom.h"
+
+namespace diagnostics {
+
+// Sits between an event source and an observer added with batching options.
+// The events sent by the source to |receiver| are held back and delivered to
+// |observer| as one |CoalescedEventInfo|, once |max_batch_size| events are
+// held back or |max_batch_delay| passed since the first of them.
+//
+// Disconnecting either side disconnects the other, with the reason given by
+// the source, and then runs |on_disconnect| with this instance, which should
+// destroy it.
+class EventBatcher final : public ash::cros_healthd::mojom::EventObserver {
+ public:
+  EventBatcher(
+      mojo::PendingRemote<ash::cros_healthd::mojom::EventObserver> observer,
+      mojo::PendingReceiver<ash::cros_healthd::mojom::EventObserver> receiver,
+      base::TimeDelta max_batch_delay,
+      size_t max_batch_size,
+      base::OnceCallback<void(EventBatcher*)> on_disconnect);
+  EventBatcher(const EventBatcher&) = delete;
+  EventBatcher& operator=(const EventBatcher&) = delete;
+  ~EventBatcher() override;
+
+  // ash::cros_healthd::mojom::EventObserver overrides:
+  void OnEvent(ash::cros_healthd::mojom::EventInfoPtr info) override;
+
+ private:
+  // Delivers the events held back, if any.
+  void Flush();
+  void OnObserverDisconnect();
+  void OnSourceDisconnect(uint32_t custom_reason,
+                          const std::string& description);
+
+  mojo::Remote<ash::cros_healthd::mojom::EventObserver> observer_;
+  mojo::Receiver<ash::cros_healthd::mojom::EventObserver> receiver_;
+  const base::TimeDelta max_batch_delay_;
+  const size_t max_batch_size_;
+  base::OnceCallback<void(EventBatcher*)> on_disconnect_;
+  std::vector<ash::cros_healthd::mojom::EventInfoPtr> pending_events_;
+  base::OneShotTimer flush_timer_;
+};
+
+}  // namespace diagnostics
+
+#endif  // DIAGNOSTICS_CROS_HEALTHD_EVENTS_EVENT_BATCHER_H_
@@ -0,0 +1,119 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "diagnostics/cros_healthd/events/event_batcher.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <base/functional/bind.h>
+#include <base/test/task_environment.h>
+#include <base/test/test_future.h>
+#include <gtest/gtest.h>
+#include <mojo/public/cpp/bindings/remote.h>
+
+#include "diagnostics/cros_healthd/events/event_observer_test_future.h"
+#include "diagnostics/mojom/public/cros_healthd_events.mojom.h"
+
+namespace diagnostics {
+namespace {
+
+namespace mojom = ::ash::cros_healthd::mojom;
+
+constexpr base::TimeDelta kMaxBatchDelay = base::Milliseconds(50);
+constexpr size_t kMaxBatchSize = 3;
+
+mojom::EventInfoPtr CreateLidEvent() {
+  return mojom::EventInfo::NewLidEventInfo(
+      mojom::LidEventInfo::New(mojom::LidEventInfo::State::kClosed));
+}
+
+class EventBatcherTest : public ::testing::Test {
+ protected:
+  EventBatcherTest() = default;
+  EventBatcherTest(const EventBatcherTest&) = delete;
+  EventBatcherTest& operator=(const EventBatcherTest&) = delete;
+
+  void SetUp() override {
+    event_batcher_ = std::make_unique<EventBatcher>(
+        event_observer_.BindNewPendingRemote(),
+        source_.BindNewPipeAndPassReceiver(), kMaxBatchDelay, kMaxBatchSize,
+        base::BindOnce(&EventBatcherTest::OnDisconnect,
+                       base::Unretained(this)));
+  }
+
+  void OnDisconnect(EventBatcher* event_batcher) {
+    EXPECT_EQ(event_batcher, event_batcher_.get());
+    event_batcher_.reset();
+  }
+
+  void EmitLidEvents(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      source_->OnEvent(CreateLidEvent());
+    }
+    source_.FlushForTesting();
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  EventObserverTestFuture event_observer_;
+  mojo::Remote<mojom::EventObserver> source_;
+  std::unique_ptr<EventBatcher> event_batcher_;
+};
+
+// Test that a full batch is delivered without waiting for the delay.
+TEST_F(EventBatcherTest, DeliversFullBatch) {
+  EmitLidEvents(kMaxBatchSize);
+
+  auto event = event_observer_.WaitForEvent();
+  ASSERT_TRUE(event->is_coalesced_event_info());
+  const auto& events = event->get_coalesced_event_info()->events;
+  ASSERT_EQ(events.size(), kMaxBatchSize);
+  for (const auto& info : events) {
+    EXPECT_TRUE(info->is_lid_event_info());
+  }
+}
+
+// Test that the events held back are delivered after the delay.
+TEST_F(EventBatcherTest, DeliversPartialBatchAfterDelay) {
+  EmitLidEvents(2);
+  task_environment_.FastForwardBy(kMaxBatchDelay);
+
+  auto event = event_observer_.WaitForEvent();
+  ASSERT_TRUE(event->is_coalesced_event_info());
+  EXPECT_EQ(event->get_coalesced_event_info()->events.size(), 2u);
+}
+
+// Test that a single event is not wrapped.
+TEST_F(EventBatcherTest, DeliversSingleEventAsIs) {
+  EmitLidEvents(1);
+  task_environment_.FastForwardBy(kMaxBatchDelay);
+
+  EXPECT_TRUE(event_observer_.WaitForEvent()->is_lid_event_info());
+}
+
+// Test that the events held back are delivered when the source disconnects.
+TEST_F(EventBatcherTest, FlushesOnSourceDisconnect) {
+  EmitLidEvents(2);
+  source_.reset();
+
+  auto event = event_observer_.WaitForEvent();
+  ASSERT_TRUE(event->is_coalesced_event_info());
+  EXPECT_EQ(event->get_coalesced_event_info()->events.size(), 2u);
+  EXPECT_FALSE(event_batcher_);
+}
+
+// Test that the source is disconnected when the observer disconnects.
+TEST_F(EventBatcherTest, DisconnectsSourceOnObserverDisconnect) {
+  base::test::TestFuture<void> source_disconnected;
+  source_.set_disconnect_handler(source_disconnected.GetCallback());
+  event_observer_.Reset();
+
+  EXPECT_TRUE(source_disconnected.Wait());
+  EXPECT_FALSE(event_batcher_);
+}
+
+}  // namespace
+}  // namespace diagnostics
@@ -30,4 +30,9 @@ void FakeProbeService::ProbeMultipleProcessInfo(
   NOTIMPLEMENTED();
 }
 
+void FakeProbeService::ProbeResourceUsageSummary(
+    uint32_t window_seconds, ProbeResourceUsageSummaryCallback callback) {
+  NOTIMPLEMENTED();
+}
+
 }  // namespace diagnostics
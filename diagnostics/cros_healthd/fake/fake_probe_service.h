@@ -32,6 +32,9 @@ class FakeProbeService final
       const std::optional<std::vector<uint32_t>>& process_ids,
       bool ignore_single_process_info,
       ProbeMultipleProcessInfoCallback callback) override;
+  void ProbeResourceUsageSummary(
+      uint32_t window_seconds,
+      ProbeResourceUsageSummaryCallback callback) override;
 };
 
 }  // namespace diagnostics
@@ -4,6 +4,7 @@
 
 #include "diagnostics/cros_healthd/fetch_aggregator.h"
 
+#include <iterator>
 #include <memory>
 #include <set>
 #include <utility>
@@ -50,6 +51,27 @@ base::OnceCallback<void(T)> CreateFetchCallback(CallbackBarrier* barrier,
                                  "The fetch callback was dropped")));
 }
 
+// Adapts a synchronous fetch to a FetchFunction.
+template <typename T>
+base::OnceCallback<void(base::OnceCallback<void(T)>)> FromSync(
+    base::OnceCallback<T()> fetch) {
+  return base::BindOnce(
+      [](base::OnceCallback<T()> fetch, base::OnceCallback<void(T)> callback) {
+        std::move(callback).Run(std::move(fetch).Run());
+      },
+      std::move(fetch));
+}
+
+// The categories whose data is reused by default, since they are polled by
+// telemetry clients and read a lot of procfs and sysfs files.
+constexpr std::pair<mojom::ProbeCategoryEnum, base::TimeDelta>
+    kDefaultMaxCacheAges[] = {
+        {mojom::ProbeCategoryEnum::kCpu, base::Seconds(1)},
+        {mojom::ProbeCategoryEnum::kMemory, base::Seconds(1)},
+        {mojom::ProbeCategoryEnum::kNonRemovableBlockDevices, base::Seconds(5)},
+        {mojom::ProbeCategoryEnum::kStatefulPartition, base::Seconds(5)},
+};
+
 void OnFinish(
     std::set<mojom::ProbeCategoryEnum> categories,
     mojom::CrosHealthdProbeService::ProbeTelemetryInfoCallback callback,
@@ -72,7 +94,9 @@ FetchAggregator::FetchAggregator(Context* context)
       memory_fetcher_(context),
       timezone_fetcher_(context),
       tpm_fetcher_(context),
-      context_(context) {}
+      context_(context),
+      max_cache_ages_(std::begin(kDefaultMaxCacheAges),
+                      std::end(kDefaultMaxCacheAges)) {}
 
 FetchAggregator::~FetchAggregator() = default;
 
@@ -99,110 +123,224 @@ void FetchAggregator::Run(
         break;
       }
       case mojom::ProbeCategoryEnum::kBattery: {
-        info->battery_result = battery_fetcher_.FetchBatteryInfo();
+        FetchCategory(category, &mojom::TelemetryInfo::battery_result,
+                      FromSync(base::BindOnce(
+                          &BatteryFetcher::FetchBatteryInfo,
+                          base::Unretained(&battery_fetcher_))),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kCpu: {
-        FetchCpuInfo(context_,
-                     CreateFetchCallback(&barrier, &info->cpu_result));
+        FetchCategory(category, &mojom::TelemetryInfo::cpu_result,
+                      base::BindOnce(&FetchCpuInfo, context_), info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kNonRemovableBlockDevices: {
-        info->block_device_result =
-            disk_fetcher_.FetchNonRemovableBlockDevicesInfo();
+        FetchCategory(category, &mojom::TelemetryInfo::block_device_result,
+                      FromSync(base::BindOnce(
+                          &DiskFetcher::FetchNonRemovableBlockDevicesInfo,
+                          base::Unretained(&disk_fetcher_))),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kTimezone: {
-        info->timezone_result = timezone_fetcher_.FetchTimezoneInfo();
+        FetchCategory(category, &mojom::TelemetryInfo::timezone_result,
+                      FromSync(base::BindOnce(
+                          &TimezoneFetcher::FetchTimezoneInfo,
+                          base::Unretained(&timezone_fetcher_))),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kMemory: {
-        memory_fetcher_.FetchMemoryInfo(
-            CreateFetchCallback(&barrier, &info->memory_result));
+        FetchCategory(category, &mojom::TelemetryInfo::memory_result,
+                      base::BindOnce(&MemoryFetcher::FetchMemoryInfo,
+                                     base::Unretained(&memory_fetcher_)),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kBacklight: {
-        info->backlight_result = backlight_fetcher_.FetchBacklightInfo();
+        FetchCategory(category, &mojom::TelemetryInfo::backlight_result,
+                      FromSync(base::BindOnce(
+                          &BacklightFetcher::FetchBacklightInfo,
+                          base::Unretained(&backlight_fetcher_))),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kFan: {
-        fan_fetcher_.FetchFanInfo(
-            CreateFetchCallback(&barrier, &info->fan_result));
+        FetchCategory(category, &mojom::TelemetryInfo::fan_result,
+                      base::BindOnce(&FanFetcher::FetchFanInfo,
+                                     base::Unretained(&fan_fetcher_)),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kStatefulPartition: {
-        FetchStatefulPartitionInfo(
-            context_,
-            CreateFetchCallback(&barrier, &info->stateful_partition_result));
+        FetchCategory(category,
+                      &mojom::TelemetryInfo::stateful_partition_result,
+                      base::BindOnce(&FetchStatefulPartitionInfo, context_),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kBluetooth: {
-        info->bluetooth_result = FetchBluetoothInfo(context_);
+        FetchCategory(category, &mojom::TelemetryInfo::bluetooth_result,
+                      FromSync(base::BindOnce(&FetchBluetoothInfo, context_)),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kSystem: {
-        FetchSystemInfo(context_,
-                        CreateFetchCallback(&barrier, &info->system_result));
+        FetchCategory(category, &mojom::TelemetryInfo::system_result,
+                      base::BindOnce(&FetchSystemInfo, context_), info,
+                      &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kNetwork: {
-        FetchNetworkInfo(context_,
-                         CreateFetchCallback(&barrier, &info->network_result));
+        FetchCategory(category, &mojom::TelemetryInfo::network_result,
+                      base::BindOnce(&FetchNetworkInfo, context_), info,
+                      &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kAudio: {
-        FetchAudioInfo(context_,
-                       CreateFetchCallback(&barrier, &info->audio_result));
+        FetchCategory(category, &mojom::TelemetryInfo::audio_result,
+                      base::BindOnce(&FetchAudioInfo, context_), info,
+                      &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kBootPerformance: {
-        context_->executor()->FetchBootPerformance(
-            CreateFetchCallback(&barrier, &info->boot_performance_result));
+        FetchCategory(category, &mojom::TelemetryInfo::boot_performance_result,
+                      base::BindOnce(&mojom::Executor::FetchBootPerformance,
+                                     base::Unretained(context_->executor())),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kBus: {
-        FetchBusDevices(context_,
-                        CreateFetchCallback(&barrier, &info->bus_result));
+        FetchCategory(category, &mojom::TelemetryInfo::bus_result,
+                      base::BindOnce(&FetchBusDevices, context_), info,
+                      &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kTpm: {
-        tpm_fetcher_.FetchTpmInfo(
-            CreateFetchCallback(&barrier, &info->tpm_result));
+        FetchCategory(
+            category, &mojom::TelemetryInfo::tpm_result,
+            base::BindOnce(
+                [](TpmFetcher* fetcher,
+                   base::OnceCallback<void(mojom::TpmResultPtr)> callback) {
+                  fetcher->FetchTpmInfo(std::move(callback));
+                },
+                base::Unretained(&tpm_fetcher_)),
+            info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kNetworkInterface: {
-        FetchNetworkInterfaceInfo(
-            context_,
-            CreateFetchCallback(&barrier, &info->network_interface_result));
+        FetchCategory(category,
+                      &mojom::TelemetryInfo::network_interface_result,
+                      base::BindOnce(&FetchNetworkInterfaceInfo, context_),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kGraphics: {
-        info->graphics_result = FetchGraphicsInfo();
+        FetchCategory(category, &mojom::TelemetryInfo::graphics_result,
+                      FromSync(base::BindOnce(&FetchGraphicsInfo)), info,
+                      &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kDisplay: {
-        context_->executor()->FetchDisplayInfo(
-            CreateFetchCallback(&barrier, &info->display_result));
+        FetchCategory(category, &mojom::TelemetryInfo::display_result,
+                      base::BindOnce(&mojom::Executor::FetchDisplayInfo,
+                                     base::Unretained(context_->executor())),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kInput: {
-        input_fetcher_.Fetch(
-            CreateFetchCallback(&barrier, &info->input_result));
+        FetchCategory(category, &mojom::TelemetryInfo::input_result,
+                      base::BindOnce(&InputFetcher::Fetch,
+                                     base::Unretained(&input_fetcher_)),
+                      info, &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kAudioHardware: {
-        FetchAudioHardwareInfo(
-            context_,
-            CreateFetchCallback(&barrier, &info->audio_hardware_result));
+        FetchCategory(category, &mojom::TelemetryInfo::audio_hardware_result,
+                      base::BindOnce(&FetchAudioHardwareInfo, context_), info,
+                      &barrier);
         break;
       }
       case mojom::ProbeCategoryEnum::kSensor: {
-        FetchSensorInfo(context_,
-                        CreateFetchCallback(&barrier, &info->sensor_result));
+        FetchCategory(category, &mojom::TelemetryInfo::sensor_result,
+                      base::BindOnce(&FetchSensorInfo, context_), info,
+                      &barrier);
         break;
       }
     }
   }
 }
 
+void FetchAggregator::SetMaxCacheAge(mojom::ProbeCategoryEnum category,
+                                     base::TimeDelta max_age) {
+  max_cache_ages_[category] = max_age;
+  if (max_age.is_zero()) {
+    cache_.erase(category);
+  }
+}
+
+base::TimeDelta FetchAggregator::GetMaxCacheAge(
+    mojom::ProbeCategoryEnum category) const {
+  auto it = max_cache_ages_.find(category);
+  return it == max_cache_ages_.end() ? base::TimeDelta() : it->second;
+}
+
+template <typename T>
+void FetchAggregator::FetchCategory(mojom::ProbeCategoryEnum category,
+                                    T mojom::TelemetryInfo::*field,
+                                    FetchFunction<T> fetch,
+                                    mojom::TelemetryInfo* info,
+                                    CallbackBarrier* barrier) {
+  auto cached = cache_.find(category);
+  if (cached != cache_.end() &&
+      base::TimeTicks::Now() - cached->second.fetch_time <
+          GetMaxCacheAge(category)) {
+    info->*field = (cached->second.info.get()->*field).Clone();
+    return;
+  }
+
+  std::vector<CategoryCallback>& callbacks = pending_callbacks_[category];
+  callbacks.push_back(base::BindOnce(
+      [](T mojom::TelemetryInfo::*field, base::OnceCallback<void(T)> callback,
+         const mojom::TelemetryInfo& result) {
+        std::move(callback).Run((result.*field).Clone());
+      },
+      field, CreateFetchCallback(barrier, &(info->*field))));
+  // Wait for the in-flight fetch, if any.
+  if (callbacks.size() > 1) {
+    return;
+  }
+  // If the fetcher drops the callback, the waiting requests get an error and
+  // the next request of |category| fetches it again.
+  std::move(fetch).Run(mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+      base::BindOnce(&FetchAggregator::OnCategoryFetched<T>,
+                     weak_factory_.GetWeakPtr(), category, field),
+      T::Struct::NewError(
+          mojom::ProbeError::New(mojom::ErrorType::kServiceUnavailable,
+                                 "The fetch callback was dropped"))));
+}
+
+template <typename T>
+void FetchAggregator::OnCategoryFetched(mojom::ProbeCategoryEnum category,
+                                        T mojom::TelemetryInfo::*field,
+                                        T result) {
+  auto info = mojom::TelemetryInfo::New();
+  info.get()->*field = std::move(result);
+
+  std::vector<CategoryCallback> callbacks =
+      std::move(pending_callbacks_[category]);
+  pending_callbacks_.erase(category);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(*info);
+  }
+
+  const T& fetched = info.get()->*field;
+  if (fetched && !fetched->is_error() &&
+      GetMaxCacheAge(category).is_positive()) {
+    cache_[category] = CachedResult{.fetch_time = base::TimeTicks::Now(),
+                                    .info = std::move(info)};
+  }
+}
+
 }  // namespace diagnostics
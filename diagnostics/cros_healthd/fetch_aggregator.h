@@ -5,8 +5,13 @@
 #ifndef DIAGNOSTICS_CROS_HEALTHD_FETCH_AGGREGATOR_H_
 #define DIAGNOSTICS_CROS_HEALTHD_FETCH_AGGREGATOR_H_
 
+#include <map>
 #include <vector>
 
+#include <base/functional/callback.h>
+#include <base/memory/weak_ptr.h>
+#include <base/time/time.h>
+
 #include "diagnostics/cros_healthd/fetchers/backlight_fetcher.h"
 #include "diagnostics/cros_healthd/fetchers/battery_fetcher.h"
 #include "diagnostics/cros_healthd/fetchers/disk_fetcher.h"
@@ -21,9 +26,16 @@
 
 namespace diagnostics {
 
+class CallbackBarrier;
+
 // This class is responsible for aggregating probe data from various fetchers,
 // some of which may be asynchronous, and running the given callback when all
 // probe data has been fetched.
+//
+// All the categories of a request are fetched concurrently. Requests asking
+// for a category being fetched wait for that fetch instead of starting another
+// one, and the data of some categories is cached for a short while, since
+// telemetry clients poll them every few seconds.
 class FetchAggregator final {
  public:
   explicit FetchAggregator(Context* context);
@@ -38,7 +50,45 @@ class FetchAggregator final {
            ash::cros_healthd::mojom::CrosHealthdProbeService::
                ProbeTelemetryInfoCallback callback);
 
+  // Sets how long the data fetched for |category| is reused by the following
+  // requests. Errors are never reused. A zero |max_age| disables the cache of
+  // |category|.
+  void SetMaxCacheAge(ash::cros_healthd::mojom::ProbeCategoryEnum category,
+                      base::TimeDelta max_age);
+
  private:
+  // Runs the callback passed to it with the fetched data.
+  template <typename T>
+  using FetchFunction = base::OnceCallback<void(base::OnceCallback<void(T)>)>;
+
+  // Called with a TelemetryInfo holding the data of a single category.
+  using CategoryCallback =
+      base::OnceCallback<void(const ash::cros_healthd::mojom::TelemetryInfo&)>;
+
+  struct CachedResult {
+    base::TimeTicks fetch_time;
+    // Only the field of the category is set.
+    ash::cros_healthd::mojom::TelemetryInfoPtr info;
+  };
+
+  // Sets |info->*field|, the field of |category|, from the cache or from the
+  // in-flight fetch of |category|. Otherwise runs |fetch|. |barrier| is
+  // notified when the field is set.
+  template <typename T>
+  void FetchCategory(ash::cros_healthd::mojom::ProbeCategoryEnum category,
+                     T ash::cros_healthd::mojom::TelemetryInfo::*field,
+                     FetchFunction<T> fetch,
+                     ash::cros_healthd::mojom::TelemetryInfo* info,
+                     CallbackBarrier* barrier);
+
+  template <typename T>
+  void OnCategoryFetched(ash::cros_healthd::mojom::ProbeCategoryEnum category,
+                         T ash::cros_healthd::mojom::TelemetryInfo::*field,
+                         T result);
+
+  base::TimeDelta GetMaxCacheAge(
+      ash::cros_healthd::mojom::ProbeCategoryEnum category) const;
+
   BacklightFetcher backlight_fetcher_;
   BatteryFetcher battery_fetcher_;
   DiskFetcher disk_fetcher_;
@@ -50,6 +100,17 @@ class FetchAggregator final {
 
   // The pointer to the Context object for accessing system utilities.
   Context* const context_;
+
+  std::map<ash::cros_healthd::mojom::ProbeCategoryEnum, base::TimeDelta>
+      max_cache_ages_;
+  std::map<ash::cros_healthd::mojom::ProbeCategoryEnum, CachedResult> cache_;
+  // The callbacks waiting for the in-flight fetch of each category.
+  std::map<ash::cros_healthd::mojom::ProbeCategoryEnum,
+           std::vector<CategoryCallback>>
+      pending_callbacks_;
+
+  // Must be the last member of the class.
+  base::WeakPtrFactory<FetchAggregator> weak_factory_{this};
 };
 
 }  // namespace diagnostics
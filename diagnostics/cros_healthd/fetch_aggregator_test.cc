@@ -0,0 +1,153 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "diagnostics/cros_healthd/fetch_aggregator.h"
+
+#include <utility>
+#include <vector>
+
+#include <base/test/task_environment.h>
+#include <base/test/test_future.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "diagnostics/cros_healthd/executor/mock_executor.h"
+#include "diagnostics/cros_healthd/system/mock_context.h"
+#include "diagnostics/mojom/public/cros_healthd_probe.mojom.h"
+
+namespace diagnostics {
+namespace {
+
+namespace mojom = ::ash::cros_healthd::mojom;
+
+using ::testing::_;
+
+constexpr double kBootUpSeconds = 7.5;
+
+class FetchAggregatorTest : public ::testing::Test {
+ protected:
+  FetchAggregatorTest() = default;
+  FetchAggregatorTest(const FetchAggregatorTest&) = delete;
+  FetchAggregatorTest& operator=(const FetchAggregatorTest&) = delete;
+
+  void ProbeBootPerformance(
+      base::test::TestFuture<mojom::TelemetryInfoPtr>* future) {
+    fetch_aggregator_.Run({mojom::ProbeCategoryEnum::kBootPerformance},
+                          future->GetCallback());
+  }
+
+  // Captures the callbacks of the boot performance fetches of the executor.
+  void ExpectBootPerformanceFetches(int times) {
+    EXPECT_CALL(*mock_context_.mock_executor(), FetchBootPerformance(_))
+        .Times(times)
+        .WillRepeatedly(
+            [this](MockExecutor::FetchBootPerformanceCallback callback) {
+              executor_callbacks_.push_back(std::move(callback));
+            });
+  }
+
+  void CompleteBootPerformanceFetches() {
+    for (auto& callback : executor_callbacks_) {
+      auto info = mojom::BootPerformanceInfo::New();
+      info->boot_up_seconds = kBootUpSeconds;
+      std::move(callback).Run(
+          mojom::BootPerformanceResult::NewBootPerformanceInfo(
+              std::move(info)));
+    }
+    executor_callbacks_.clear();
+  }
+
+  void ExpectBootPerformanceResult(
+      base::test::TestFuture<mojom::TelemetryInfoPtr>* future) {
+    const auto& result = future->Get()->boot_performance_result;
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(result->is_boot_performance_info());
+    EXPECT_EQ(result->get_boot_performance_info()->boot_up_seconds,
+              kBootUpSeconds);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  MockContext mock_context_;
+  FetchAggregator fetch_aggregator_{&mock_context_};
+  std::vector<MockExecutor::FetchBootPerformanceCallback> executor_callbacks_;
+};
+
+// Test that concurrent requests for the same category share one fetch.
+TEST_F(FetchAggregatorTest, ConcurrentRequestsShareFetch) {
+  ExpectBootPerformanceFetches(1);
+  base::test::TestFuture<mojom::TelemetryInfoPtr> first;
+  base::test::TestFuture<mojom::TelemetryInfoPtr> second;
+  ProbeBootPerformance(&first);
+  ProbeBootPerformance(&second);
+  EXPECT_FALSE(first.IsReady());
+
+  CompleteBootPerformanceFetches();
+  ExpectBootPerformanceResult(&first);
+  ExpectBootPerformanceResult(&second);
+}
+
+// Test that the data of a category is reused until it is too old.
+TEST_F(FetchAggregatorTest, ReusesRecentData) {
+  fetch_aggregator_.SetMaxCacheAge(mojom::ProbeCategoryEnum::kBootPerformance,
+                                   base::Seconds(10));
+  ExpectBootPerformanceFetches(2);
+  base::test::TestFuture<mojom::TelemetryInfoPtr> first;
+  ProbeBootPerformance(&first);
+  CompleteBootPerformanceFetches();
+  ExpectBootPerformanceResult(&first);
+
+  task_environment_.FastForwardBy(base::Seconds(5));
+  base::test::TestFuture<mojom::TelemetryInfoPtr> cached;
+  ProbeBootPerformance(&cached);
+  EXPECT_TRUE(executor_callbacks_.empty());
+  ExpectBootPerformanceResult(&cached);
+
+  task_environment_.FastForwardBy(base::Seconds(5));
+  base::test::TestFuture<mojom::TelemetryInfoPtr> refetched;
+  ProbeBootPerformance(&refetched);
+  EXPECT_EQ(executor_callbacks_.size(), 1u);
+  CompleteBootPerformanceFetches();
+  ExpectBootPerformanceResult(&refetched);
+}
+
+// Test that errors are not reused.
+TEST_F(FetchAggregatorTest, DoesNotReuseErrors) {
+  fetch_aggregator_.SetMaxCacheAge(mojom::ProbeCategoryEnum::kBootPerformance,
+                                   base::Seconds(10));
+  ExpectBootPerformanceFetches(2);
+  base::test::TestFuture<mojom::TelemetryInfoPtr> first;
+  ProbeBootPerformance(&first);
+  ASSERT_EQ(executor_callbacks_.size(), 1u);
+  std::move(executor_callbacks_[0])
+      .Run(mojom::BootPerformanceResult::NewError(mojom::ProbeError::New(
+          mojom::ErrorType::kFileReadError, "error")));
+  executor_callbacks_.clear();
+  EXPECT_TRUE(first.Get()->boot_performance_result->is_error());
+
+  base::test::TestFuture<mojom::TelemetryInfoPtr> second;
+  ProbeBootPerformance(&second);
+  CompleteBootPerformanceFetches();
+  ExpectBootPerformanceResult(&second);
+}
+
+// Test that a dropped fetch fails its requests and doesn't block later ones.
+TEST_F(FetchAggregatorTest, DroppedFetchDoesNotBlockLaterRequests) {
+  ExpectBootPerformanceFetches(2);
+  base::test::TestFuture<mojom::TelemetryInfoPtr> first;
+  base::test::TestFuture<mojom::TelemetryInfoPtr> second;
+  ProbeBootPerformance(&first);
+  ProbeBootPerformance(&second);
+  executor_callbacks_.clear();
+  EXPECT_TRUE(first.Get()->boot_performance_result->is_error());
+  EXPECT_TRUE(second.Get()->boot_performance_result->is_error());
+
+  base::test::TestFuture<mojom::TelemetryInfoPtr> third;
+  ProbeBootPerformance(&third);
+  CompleteBootPerformanceFetches();
+  ExpectBootPerformanceResult(&third);
+}
+
+}  // namespace
+}  // namespace diagnostics
@@ -4,26 +4,32 @@
 
 #include "diagnostics/cros_healthd/fetchers/process_fetcher.h"
 
+#include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include <base/check.h>
 #include <base/files/file_enumerator.h>
 #include <base/files/file_path.h>
+#include <base/files/scoped_file.h>
 #include <base/functional/bind.h>
 #include <base/numerics/safe_conversions.h>
+#include <base/posix/eintr_wrapper.h>
+#include <base/ranges/algorithm.h>
 #include <base/strings/string_number_conversions.h>
-#include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
 #include <base/strings/stringprintf.h>
-#include <re2/re2.h>
 
 #include "diagnostics/base/file_utils.h"
 #include "diagnostics/cros_healthd/utils/error_utils.h"
@@ -36,17 +42,109 @@ namespace {
 
 namespace mojom = ::ash::cros_healthd::mojom;
 
-// Regex used to parse a process's statm file.
-constexpr char kProcessStatmFileRegex[] =
-    R"((\d+)\s+(\d+)\s+\d+\s+\d+\s+\d+\s+\d+\s+\d+)";
-// Regex used to parse procfs's uptime file.
-constexpr char kUptimeFileRegex[] = R"(([.\d]+)\s+[.\d]+)";
-// Regex used to parse the process's Uid field in the status file.
-constexpr char kUidStatusRegex[] = R"(Uid:\s*(\d+)\s+\d+\s+\d+\s+\d+)";
-// Regex used to parse a process's I/O file.
-constexpr char kProcessIOFileRegex[] =
-    R"(rchar:\s+(\d+)\nwchar:\s+(\d+)\nsyscr:\s+(\d+)\nsyscw:\s+(\d+)\nread)"
-    R"(_bytes:\s+(\d+)\nwrite_bytes:\s+(\d+)\ncancelled_write_bytes:\s+(\d+))";
+// Number of fields in a process's statm file.
+constexpr size_t kProcessStatmFields = 7;
+// The Uid field in a process's status file.
+constexpr char kUidStatusKey[] = "Uid:";
+// Number of values of the Uid field.
+constexpr size_t kUidStatusValues = 4;
+// Size of the buffer first allocated to read the files of the processes. Most
+// of the files are smaller, and the buffer is grown for the others.
+constexpr size_t kInitialReadBufferSize = 4096;
+
+// The fields of a process's I/O file, in order.
+constexpr struct {
+  const char* key;
+  uint64_t mojom::ProcessInfo::*field;
+} kProcessIOFields[] = {
+    {"rchar", &mojom::ProcessInfo::bytes_read},
+    {"wchar", &mojom::ProcessInfo::bytes_written},
+    {"syscr", &mojom::ProcessInfo::read_system_calls},
+    {"syscw", &mojom::ProcessInfo::write_system_calls},
+    {"read_bytes", &mojom::ProcessInfo::physical_bytes_read},
+    {"write_bytes", &mojom::ProcessInfo::physical_bytes_written},
+    {"cancelled_write_bytes", &mojom::ProcessInfo::cancelled_bytes_written},
+};
+
+// Reads the files of a /proc/|pid| directory. The directory is opened once and
+// the files are opened relative to it, which saves resolving its path for each
+// file, and makes sure all the files belong to the same process: if the
+// process exits and its PID is reused meanwhile, the reads fail instead.
+class ProcPidDirReader {
+ public:
+  // The contents of the files are read into |buffer|.
+  ProcPidDirReader(const base::FilePath& proc_pid_dir, std::string* buffer)
+      : proc_pid_dir_(proc_pid_dir),
+        dir_fd_(HANDLE_EINTR(open(proc_pid_dir.value().c_str(),
+                                  O_RDONLY | O_DIRECTORY | O_CLOEXEC))),
+        buffer_(buffer) {}
+  ProcPidDirReader(const ProcPidDirReader&) = delete;
+  ProcPidDirReader& operator=(const ProcPidDirReader&) = delete;
+
+  bool is_valid() const { return dir_fd_.is_valid(); }
+  const base::FilePath& proc_pid_dir() const { return proc_pid_dir_; }
+
+  // Returns the contents of |file|, with the leading and trailing whitespace
+  // trimmed, or std::nullopt if it cannot be read. The returned view is valid
+  // until the next call.
+  std::optional<std::string_view> ReadFile(const char* file) {
+    base::ScopedFD fd(
+        HANDLE_EINTR(openat(dir_fd_.get(), file, O_RDONLY | O_CLOEXEC)));
+    if (!fd.is_valid())
+      return std::nullopt;
+
+    size_t size = 0;
+    while (true) {
+      if (size == buffer_->size()) {
+        buffer_->resize(std::max(2 * size, kInitialReadBufferSize));
+      }
+      const ssize_t bytes_read = HANDLE_EINTR(
+          read(fd.get(), buffer_->data() + size, buffer_->size() - size));
+      if (bytes_read < 0)
+        return std::nullopt;
+      if (bytes_read == 0)
+        break;
+      size += static_cast<size_t>(bytes_read);
+    }
+    return base::TrimWhitespaceASCII(std::string_view(buffer_->data(), size),
+                                     base::TRIM_ALL);
+  }
+
+ private:
+  const base::FilePath proc_pid_dir_;
+  const base::ScopedFD dir_fd_;
+  std::string* const buffer_;
+};
+
+// Returns the next token of |input| delimited by ASCII whitespace, and removes
+// it from |input|. Returns an empty string once |input| has no token left.
+std::string_view NextToken(std::string_view* input) {
+  const size_t start = input->find_first_not_of(base::kWhitespaceASCII);
+  if (start == std::string_view::npos) {
+    *input = std::string_view();
+    return std::string_view();
+  }
+  input->remove_prefix(start);
+  const size_t end =
+      std::min(input->find_first_of(base::kWhitespaceASCII), input->size());
+  const std::string_view token = input->substr(0, end);
+  input->remove_prefix(end);
+  return token;
+}
+
+// Returns the next line of |input| and removes it from |input|.
+std::string_view NextLine(std::string_view* input) {
+  const size_t end = std::min(input->find('\n'), input->size());
+  const std::string_view line = input->substr(0, end);
+  input->remove_prefix(std::min(end + 1, input->size()));
+  return line;
+}
+
+bool IsDecimalNumber(std::string_view str) {
+  return !str.empty() && base::ranges::all_of(str, [](char c) {
+    return base::IsAsciiDigit(c);
+  });
+}
 
 // Converts the raw process state read from procfs to a mojom::ProcessState.
 // If the conversion is successful, returns std::nullopt and sets
@@ -108,77 +206,226 @@ std::optional<mojom::ProbeErrorPtr> GetInt8FromString(base::StringPiece str,
 }
 
 std::optional<mojom::ProbeErrorPtr> ParseIOContents(
-    std::string io_content, mojom::ProcessInfoPtr& process_info) {
-  std::string bytes_read_str;
-  std::string bytes_written_str;
-  std::string read_system_calls_str;
-  std::string write_system_calls_str;
-  std::string physical_bytes_read_str;
-  std::string physical_bytes_written_str;
-  std::string cancelled_bytes_written_str;
-  if (!RE2::FullMatch(io_content, kProcessIOFileRegex, &bytes_read_str,
-                      &bytes_written_str, &read_system_calls_str,
-                      &write_system_calls_str, &physical_bytes_read_str,
-                      &physical_bytes_written_str,
-                      &cancelled_bytes_written_str)) {
+    std::string_view io_content, mojom::ProcessInfo* process_info) {
+  io_content = base::TrimWhitespaceASCII(io_content, base::TRIM_ALL);
+  for (const auto& [key, field] : kProcessIOFields) {
+    std::string_view line = NextLine(&io_content);
+    const size_t key_size = strlen(key);
+    if (line.size() <= key_size || line.substr(0, key_size) != key ||
+        line[key_size] != ':') {
+      return CreateAndLogProbeError(mojom::ErrorType::kParseError,
+                                    "Failed to parse process IO file");
+    }
+
+    line.remove_prefix(key_size + 1);
+    const std::string_view value =
+        base::TrimWhitespaceASCII(line, base::TRIM_ALL);
+    if (!IsDecimalNumber(value) ||
+        !base::StringToUint64(value, &(process_info->*field))) {
+      return CreateAndLogProbeError(
+          mojom::ErrorType::kParseError,
+          base::StringPrintf("Failed to convert %s to uint64_t: %s", key,
+                             std::string(value).c_str()));
+    }
+  }
+
+  if (!io_content.empty()) {
     return CreateAndLogProbeError(mojom::ErrorType::kParseError,
                                   "Failed to parse process IO file");
   }
+  return std::nullopt;
+}
+
+// Parses the relevant fields of the stat file of a process into
+// |process_info|. |start_time_ticks| is set to the number of ticks after system
+// boot that the process started.
+std::optional<mojom::ProbeErrorPtr> ParseProcPidStat(
+    std::string_view stat_contents,
+    const base::FilePath& stat_file,
+    mojom::ProcessInfo* process_info,
+    uint64_t* start_time_ticks) {
+  DCHECK(process_info);
+  DCHECK(start_time_ticks);
+
+  // The filename of the executable is displayed in parentheses, and may
+  // contain whitespace and parentheses itself.
+  const size_t name_start = stat_contents.find('(');
+  const size_t name_end = stat_contents.rfind(')');
+  if (name_start == std::string_view::npos ||
+      name_end == std::string_view::npos || name_end < name_start) {
+    return CreateAndLogProbeError(mojom::ErrorType::kParseError,
+                                  "Failed to tokenize " + stat_file.value());
+  }
+
+  std::array<std::string_view, ProcPidStatIndices::kMaxValue + 1> stat_tokens;
+  stat_tokens[ProcPidStatIndices::kProcessID] = base::TrimWhitespaceASCII(
+      stat_contents.substr(0, name_start), base::TRIM_ALL);
+  stat_tokens[ProcPidStatIndices::kName] =
+      stat_contents.substr(name_start + 1, name_end - name_start - 1);
+  std::string_view remaining_contents = stat_contents.substr(name_end + 1);
+  for (size_t i = ProcPidStatIndices::kName + 1; i < stat_tokens.size(); ++i) {
+    stat_tokens[i] = NextToken(&remaining_contents);
+    if (stat_tokens[i].empty()) {
+      return CreateAndLogProbeError(mojom::ErrorType::kParseError,
+                                    "Failed to tokenize " + stat_file.value());
+    }
+  }
+
+  auto error = GetProcessState(stat_tokens[ProcPidStatIndices::kState],
+                               &process_info->state);
+  if (error.has_value())
+    return error;
+
+  error = GetInt8FromString(stat_tokens[ProcPidStatIndices::kPriority],
+                            &process_info->priority);
+  if (error.has_value())
+    return error;
+
+  error = GetInt8FromString(stat_tokens[ProcPidStatIndices::kNice],
+                            &process_info->nice);
+  if (error.has_value())
+    return error;
+
+  const std::string_view start_time_str =
+      stat_tokens[ProcPidStatIndices::kStartTime];
+  if (!base::StringToUint64(start_time_str, start_time_ticks)) {
+    return CreateAndLogProbeError(mojom::ErrorType::kParseError,
+                                  "Failed to convert starttime to uint64: " +
+                                      std::string(start_time_str));
+  }
+
+  const std::string_view process_id_str =
+      stat_tokens[ProcPidStatIndices::kProcessID];
+  if (!base::StringToUint(process_id_str, &process_info->process_id)) {
+    return CreateAndLogProbeError(mojom::ErrorType::kParseError,
+                                  "Failed to convert process id to uint32: " +
+                                      std::string(process_id_str));
+  }
+
+  process_info->name = std::string(stat_tokens[ProcPidStatIndices::kName]);
 
-  if (!base::StringToUint64(bytes_read_str, &process_info->bytes_read)) {
+  const std::string_view parent_process_id_str =
+      stat_tokens[ProcPidStatIndices::kParentProcessID];
+  if (!base::StringToUint(parent_process_id_str,
+                          &process_info->parent_process_id)) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert bytes_read to uint64_t: " + bytes_read_str);
+        "Failed to convert parent process id to uint32: " +
+            std::string(parent_process_id_str));
   }
 
-  if (!base::StringToUint64(bytes_written_str, &process_info->bytes_written)) {
+  const std::string_view process_group_id_str =
+      stat_tokens[ProcPidStatIndices::kProcessGroupID];
+  if (!base::StringToUint(process_group_id_str,
+                          &process_info->process_group_id)) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert bytes_written to uint64_t: " + bytes_written_str);
+        "Failed to convert process group id to uint32: " +
+            std::string(process_group_id_str));
   }
 
-  if (!base::StringToUint64(read_system_calls_str,
-                            &process_info->read_system_calls)) {
+  const std::string_view threads_str =
+      stat_tokens[ProcPidStatIndices::kThreads];
+  if (!base::StringToUint(threads_str, &process_info->threads)) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert read_system_calls to uint64_t: " +
-            read_system_calls_str);
+        "Failed to convert threads to uint32: " + std::string(threads_str));
   }
 
-  if (!base::StringToUint64(write_system_calls_str,
-                            &process_info->write_system_calls)) {
+  return std::nullopt;
+}
+
+// Parses the memory usage from the statm file of a process into
+// |process_info|.
+std::optional<mojom::ProbeErrorPtr> ParseProcPidStatm(
+    std::string_view statm_contents,
+    uint64_t page_size_kib,
+    mojom::ProcessInfo* process_info) {
+  DCHECK(process_info);
+
+  std::array<std::string_view, kProcessStatmFields> statm_tokens;
+  std::string_view remaining_contents = statm_contents;
+  for (auto& token : statm_tokens) {
+    token = NextToken(&remaining_contents);
+  }
+  if (!base::ranges::all_of(statm_tokens, &IsDecimalNumber) ||
+      !NextToken(&remaining_contents).empty()) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert write_system_calls to uint64_t: " +
-            write_system_calls_str);
+        "Failed to parse process's statm file: " + std::string(statm_contents));
   }
 
-  if (!base::StringToUint64(physical_bytes_read_str,
-                            &process_info->physical_bytes_read)) {
+  uint32_t total_memory_pages;
+  if (!base::StringToUint(statm_tokens[0], &total_memory_pages)) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert physical_bytes_read to uint64_t: " +
-            physical_bytes_read_str);
+        "Failed to convert total memory to uint32_t: " +
+            std::string(statm_tokens[0]));
   }
 
-  if (!base::StringToUint64(physical_bytes_written_str,
-                            &process_info->physical_bytes_written)) {
+  uint32_t resident_memory_pages;
+  if (!base::StringToUint(statm_tokens[1], &resident_memory_pages)) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert physical_bytes_written to uint64_t: " +
-            physical_bytes_written_str);
+        "Failed to convert resident memory to uint32_t: " +
+            std::string(statm_tokens[1]));
   }
 
-  if (!base::StringToUint64(cancelled_bytes_written_str,
-                            &process_info->cancelled_bytes_written)) {
+  if (resident_memory_pages > total_memory_pages) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert cancelled_bytes_written to uint64_t: " +
-            cancelled_bytes_written_str);
+        base::StringPrintf("Process's resident memory (%u pages) higher than "
+                           "total memory (%u pages).",
+                           resident_memory_pages, total_memory_pages));
   }
+
+  process_info->total_memory_kib =
+      static_cast<uint32_t>(total_memory_pages * page_size_kib);
+  process_info->resident_memory_kib =
+      static_cast<uint32_t>(resident_memory_pages * page_size_kib);
+  process_info->free_memory_kib = static_cast<uint32_t>(
+      (total_memory_pages - resident_memory_pages) * page_size_kib);
+
   return std::nullopt;
 }
 
+// Parses the real user ID of the process from its status file into
+// |process_info|.
+std::optional<mojom::ProbeErrorPtr> ParseProcPidStatus(
+    std::string_view status_contents, mojom::ProcessInfo* process_info) {
+  DCHECK(process_info);
+
+  while (!status_contents.empty()) {
+    std::string_view line = base::TrimWhitespaceASCII(
+        NextLine(&status_contents), base::TRIM_ALL);
+    if (!base::StartsWith(line, kUidStatusKey))
+      continue;
+
+    line.remove_prefix(strlen(kUidStatusKey));
+    std::array<std::string_view, kUidStatusValues> uid_tokens;
+    for (auto& token : uid_tokens) {
+      token = NextToken(&line);
+    }
+    if (!base::ranges::all_of(uid_tokens, &IsDecimalNumber) ||
+        !NextToken(&line).empty()) {
+      continue;
+    }
+
+    unsigned int user_id_uint;
+    if (!base::StringToUint(uid_tokens[0], &user_id_uint)) {
+      return CreateAndLogProbeError(
+          mojom::ErrorType::kParseError,
+          "Failed to convert Uid to uint: " + std::string(uid_tokens[0]));
+    }
+
+    process_info->user_id = static_cast<uint32_t>(user_id_uint);
+    return std::nullopt;
+  }
+
+  return CreateAndLogProbeError(mojom::ErrorType::kParseError,
+                                "Failed to find Uid key.");
+}
+
 void FinishFetchingProcessInfo(
     base::OnceCallback<void(mojom::ProcessResultPtr)> callback,
     uint32_t process_id,
@@ -192,7 +439,8 @@ void FinishFetchingProcessInfo(
   }
 
   mojom::ProcessInfoPtr process_info_ptr = process_info.Clone();
-  auto error = ParseIOContents(io_contents.at(process_id), process_info_ptr);
+  auto error =
+      ParseIOContents(io_contents.at(process_id), process_info_ptr.get());
   if (error.has_value()) {
     std::move(callback).Run(mojom::ProcessResult::NewError(error->Clone()));
     return;
@@ -222,7 +470,7 @@ void FinishFetchingMultipleProcessInfo(
       it = multiple_process_info.erase(it);
       continue;
     }
-    auto error = ParseIOContents(all_io_contents.at(pid), it->second);
+    auto error = ParseIOContents(all_io_contents.at(pid), it->second.get());
     if (error.has_value()) {
       if (!ignore_single_process_error) {
         errors.push_back({pid, error->Clone()});
@@ -251,8 +499,10 @@ ProcessFetcher::ProcessFetcher(Context* context, const base::FilePath& root_dir)
 void ProcessFetcher::FetchProcessInfo(
     uint32_t process_id,
     base::OnceCallback<void(mojom::ProcessResultPtr)> callback) {
+  ScanContext scan_context;
+  InitScanContext(&scan_context);
   mojom::ProcessInfo process_info;
-  auto error = GetProcessInfo(process_id, &process_info);
+  auto error = GetProcessInfo(process_id, &scan_context, &process_info);
   if (error.has_value()) {
     std::move(callback).Run(
         mojom::ProcessResult::NewError(std::move(error.value())));
@@ -288,10 +538,12 @@ void ProcessFetcher::FetchMultipleProcessInfo(
     }
   }
 
+  ScanContext scan_context;
+  InitScanContext(&scan_context);
   for (auto it = process_ids.begin(); it != process_ids.end();) {
     mojom::ProcessInfo process_info;
     uint32_t process_id = *it;
-    auto error = GetProcessInfo(process_id, &process_info);
+    auto error = GetProcessInfo(process_id, &scan_context, &process_info);
     if (error.has_value()) {
       if (!ignore_single_process_error) {
         errors.push_back({process_id, error->Clone()});
@@ -310,304 +562,121 @@ void ProcessFetcher::FetchMultipleProcessInfo(
                      std::move(errors)));
 }
 
-std::optional<mojom::ProbeErrorPtr> ProcessFetcher::GetProcessInfo(
-    uint32_t pid, mojom::ProcessInfo* process_info) {
-  base::FilePath proc_pid_dir = GetProcProcessDirectoryPath(root_dir_, pid);
-
-  // Number of ticks after system boot that the process started.
-  uint64_t start_time_ticks;
-  auto error = ParseProcPidStat(
-      &process_info->state, &process_info->priority, &process_info->nice,
-      &start_time_ticks, &process_info->name, &process_info->parent_process_id,
-      &process_info->process_group_id, &process_info->threads,
-      &process_info->process_id, proc_pid_dir);
-  if (error.has_value()) {
-    return error;
-  }
-
-  error = CalculateProcessUptime(start_time_ticks, &process_info->uptime_ticks);
-  if (error.has_value()) {
-    return error;
-  }
-
-  error = ParseProcPidStatm(&process_info->total_memory_kib,
-                            &process_info->resident_memory_kib,
-                            &process_info->free_memory_kib, proc_pid_dir);
-  if (error.has_value()) {
-    return error;
-  }
-
-  uid_t user_id;
-  error = GetProcessUid(&user_id, proc_pid_dir);
-  if (error.has_value()) {
-    return error;
-  }
-
-  process_info->user_id = static_cast<uint32_t>(user_id);
-  if (!ReadAndTrimString(proc_pid_dir, kProcessCmdlineFile,
-                         &process_info->command)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kFileReadError,
-        "Failed to read " + proc_pid_dir.Append(kProcessCmdlineFile).value());
-  }
-
-  // In "/proc/{PID}/cmdline", the arguments are separated by 0x00, we need
-  // to replace them by space for better output.
-  for (auto& ch : process_info->command) {
-    if (ch == '\0') {
-      ch = ' ';
-    }
-  }
-  base::TrimWhitespaceASCII(process_info->command, base::TRIM_ALL,
-                            &process_info->command);
-
-  return std::nullopt;
-}
-
-std::optional<mojom::ProbeErrorPtr> ProcessFetcher::ParseProcPidStat(
-    mojom::ProcessState* state,
-    int8_t* priority,
-    int8_t* nice,
-    uint64_t* start_time_ticks,
-    std::optional<std::string>* name,
-    uint32_t* parent_process_id,
-    uint32_t* process_group_id,
-    uint32_t* threads,
-    uint32_t* process_id,
-    base::FilePath proc_pid_dir) {
-  // Note that start_time_ticks, name, parent_process_id, process_group_id,
-  // threads, process_id are the only pointers actually dereferenced in this
-  // function. The helper functions which set |state|, |priority| and |nice| are
-  // responsible for checking the validity of those three pointers.
-  DCHECK(start_time_ticks);
-  DCHECK(name);
-  DCHECK(parent_process_id);
-  DCHECK(process_group_id);
-  DCHECK(threads);
-  DCHECK(process_id);
-
-  std::string stat_contents;
-  const base::FilePath kProcPidStatFile = proc_pid_dir.Append(kProcessStatFile);
-  if (!ReadAndTrimString(proc_pid_dir, kProcessStatFile, &stat_contents)) {
-    return CreateAndLogProbeError(mojom::ErrorType::kFileReadError,
-                                  "Failed to read " + kProcPidStatFile.value());
-  }
+ProcessFetcher::ScanContext::ScanContext() = default;
 
-  std::vector<base::StringPiece> stat_tokens =
-      base::SplitStringPiece(stat_contents, base::kWhitespaceASCII,
-                             base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+ProcessFetcher::ScanContext::~ScanContext() = default;
 
-  if (stat_tokens.size() <= ProcPidStatIndices::kMaxValue) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to tokenize " + kProcPidStatFile.value());
-  }
-
-  auto error = GetProcessState(stat_tokens[ProcPidStatIndices::kState], state);
-  if (error.has_value())
-    return error;
-
-  error =
-      GetInt8FromString(stat_tokens[ProcPidStatIndices::kPriority], priority);
-  if (error.has_value())
-    return error;
-
-  error = GetInt8FromString(stat_tokens[ProcPidStatIndices::kNice], nice);
-  if (error.has_value())
-    return error;
-
-  base::StringPiece start_time_str =
-      stat_tokens[ProcPidStatIndices::kStartTime];
-  if (!base::StringToUint64(start_time_str, start_time_ticks)) {
-    return CreateAndLogProbeError(mojom::ErrorType::kParseError,
-                                  "Failed to convert starttime to uint64: " +
-                                      std::string(start_time_str));
-  }
-
-  base::StringPiece process_id_str =
-      stat_tokens[ProcPidStatIndices::kProcessID];
-  if (!base::StringToUint(process_id_str, process_id)) {
-    return CreateAndLogProbeError(mojom::ErrorType::kParseError,
-                                  "Failed to convert process id to uint32: " +
-                                      std::string(process_id_str));
+void ProcessFetcher::InitScanContext(ScanContext* scan_context) {
+  std::string uptime_contents;
+  const base::FilePath uptime_path = GetProcUptimePath(root_dir_);
+  if (!ReadAndTrimString(uptime_path, &uptime_contents)) {
+    scan_context->error =
+        CreateAndLogProbeError(mojom::ErrorType::kFileReadError,
+                               "Failed to read " + uptime_path.value());
+    return;
   }
 
-  // In "/proc/{PID}/stat", the filename of the executable is displayed in
-  // parentheses, we need to remove them to get original value.
-  std::string name_str = std::string(stat_tokens[ProcPidStatIndices::kName]);
-  name_str = name_str.substr(1, name_str.size() - 2);
-  *name = std::optional<std::string>(name_str);
-
-  base::StringPiece parent_process_id_str =
-      stat_tokens[ProcPidStatIndices::kParentProcessID];
-  if (!base::StringToUint(parent_process_id_str, parent_process_id)) {
-    return CreateAndLogProbeError(
+  std::string_view remaining_contents = uptime_contents;
+  const std::string_view system_uptime_str = NextToken(&remaining_contents);
+  double system_uptime_seconds;
+  if (NextToken(&remaining_contents).empty() ||
+      !base::StringToDouble(system_uptime_str, &system_uptime_seconds)) {
+    scan_context->error = CreateAndLogProbeError(
         mojom::ErrorType::kParseError,
-        "Failed to convert parent process id to uint32: " +
-            std::string(parent_process_id_str));
+        "Failed to parse uptime file: " + uptime_contents);
+    return;
   }
 
-  base::StringPiece process_group_id_str =
-      stat_tokens[ProcPidStatIndices::kProcessGroupID];
-  if (!base::StringToUint(process_group_id_str, process_group_id)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to convert process group id to uint32: " +
-            std::string(process_group_id_str));
+  const auto kClockTicksPerSecond = sysconf(_SC_CLK_TCK);
+  if (kClockTicksPerSecond == -1) {
+    scan_context->error = CreateAndLogProbeError(
+        mojom::ErrorType::kSystemUtilityError,
+        "Failed to run sysconf(_SC_CLK_TCK).");
+    return;
   }
+  scan_context->system_uptime_ticks = static_cast<uint64_t>(
+      system_uptime_seconds * static_cast<double>(kClockTicksPerSecond));
 
-  base::StringPiece threads_str = stat_tokens[ProcPidStatIndices::kThreads];
-  if (!base::StringToUint(threads_str, threads)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to convert threads to uint32: " + std::string(threads_str));
+  const auto kPageSizeInBytes = sysconf(_SC_PAGESIZE);
+  if (kPageSizeInBytes == -1) {
+    scan_context->error =
+        CreateAndLogProbeError(mojom::ErrorType::kSystemUtilityError,
+                               "Failed to run sysconf(_SC_PAGESIZE).");
+    return;
   }
-
-  return std::nullopt;
+  scan_context->page_size_kib = kPageSizeInBytes / 1024;
 }
 
-std::optional<mojom::ProbeErrorPtr> ProcessFetcher::ParseProcPidStatm(
-    uint32_t* total_memory_kib,
-    uint32_t* resident_memory_kib,
-    uint32_t* free_memory_kib,
-    base::FilePath proc_pid_dir) {
-  DCHECK(total_memory_kib);
-  DCHECK(resident_memory_kib);
-  DCHECK(free_memory_kib);
-
-  std::string statm_contents;
-  if (!ReadAndTrimString(proc_pid_dir, kProcessStatmFile, &statm_contents)) {
+std::optional<mojom::ProbeErrorPtr> ProcessFetcher::GetProcessInfo(
+    uint32_t pid,
+    ScanContext* scan_context,
+    mojom::ProcessInfo* process_info) {
+  ProcPidDirReader reader(GetProcProcessDirectoryPath(root_dir_, pid),
+                          &scan_context->buffer);
+  if (!reader.is_valid()) {
     return CreateAndLogProbeError(
         mojom::ErrorType::kFileReadError,
-        "Failed to read " + proc_pid_dir.Append(kProcessStatmFile).value());
+        "Failed to open " + reader.proc_pid_dir().value());
   }
-
-  std::string total_memory_pages_str;
-  std::string resident_memory_pages_str;
-  if (!RE2::FullMatch(statm_contents, kProcessStatmFileRegex,
-                      &total_memory_pages_str, &resident_memory_pages_str)) {
+  auto read_error = [&reader](const char* file) {
     return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to parse process's statm file: " + statm_contents);
-  }
+        mojom::ErrorType::kFileReadError,
+        "Failed to read " + reader.proc_pid_dir().Append(file).value());
+  };
 
-  uint32_t total_memory_pages;
-  if (!base::StringToUint(total_memory_pages_str, &total_memory_pages)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to convert total memory to uint32_t: " +
-            total_memory_pages_str);
+  std::optional<std::string_view> contents =
+      reader.ReadFile(kProcessStatFile);
+  if (!contents) {
+    return read_error(kProcessStatFile);
   }
-
-  uint32_t resident_memory_pages;
-  if (!base::StringToUint(resident_memory_pages_str, &resident_memory_pages)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to convert resident memory to uint32_t: " +
-            resident_memory_pages_str);
+  uint64_t start_time_ticks;
+  auto error = ParseProcPidStat(
+      *contents, reader.proc_pid_dir().Append(kProcessStatFile), process_info,
+      &start_time_ticks);
+  if (error.has_value()) {
+    return error;
   }
 
-  if (resident_memory_pages > total_memory_pages) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        base::StringPrintf("Process's resident memory (%u pages) higher than "
-                           "total memory (%u pages).",
-                           resident_memory_pages, total_memory_pages));
+  if (scan_context->error.has_value()) {
+    return scan_context->error.value().Clone();
   }
+  process_info->uptime_ticks =
+      scan_context->system_uptime_ticks - start_time_ticks;
 
-  const auto kPageSizeInBytes = sysconf(_SC_PAGESIZE);
-  if (kPageSizeInBytes == -1) {
-    return CreateAndLogProbeError(mojom::ErrorType::kSystemUtilityError,
-                                  "Failed to run sysconf(_SC_PAGESIZE).");
+  contents = reader.ReadFile(kProcessStatmFile);
+  if (!contents) {
+    return read_error(kProcessStatmFile);
   }
-
-  const auto kPageSizeInKiB = kPageSizeInBytes / 1024;
-
-  *total_memory_kib =
-      static_cast<uint32_t>(total_memory_pages * kPageSizeInKiB);
-  *resident_memory_kib =
-      static_cast<uint32_t>(resident_memory_pages * kPageSizeInKiB);
-  *free_memory_kib = static_cast<uint32_t>(
-      (total_memory_pages - resident_memory_pages) * kPageSizeInKiB);
-
-  return std::nullopt;
-}
-
-std::optional<mojom::ProbeErrorPtr> ProcessFetcher::CalculateProcessUptime(
-    uint64_t start_time_ticks, uint64_t* process_uptime_ticks) {
-  DCHECK(process_uptime_ticks);
-
-  std::string uptime_contents;
-  base::FilePath uptime_path = GetProcUptimePath(root_dir_);
-  if (!ReadAndTrimString(uptime_path, &uptime_contents)) {
-    return CreateAndLogProbeError(mojom::ErrorType::kFileReadError,
-                                  "Failed to read " + uptime_path.value());
+  error = ParseProcPidStatm(*contents, scan_context->page_size_kib,
+                            process_info);
+  if (error.has_value()) {
+    return error;
   }
 
-  std::string system_uptime_str;
-  if (!RE2::FullMatch(uptime_contents, kUptimeFileRegex, &system_uptime_str)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to parse uptime file: " + uptime_contents);
+  contents = reader.ReadFile(kProcessStatusFile);
+  if (!contents) {
+    return read_error(kProcessStatusFile);
   }
-
-  double system_uptime_seconds;
-  if (!base::StringToDouble(system_uptime_str, &system_uptime_seconds)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kParseError,
-        "Failed to convert system uptime to double: " + system_uptime_str);
+  error = ParseProcPidStatus(*contents, process_info);
+  if (error.has_value()) {
+    return error;
   }
 
-  const auto kClockTicksPerSecond = sysconf(_SC_CLK_TCK);
-  if (kClockTicksPerSecond == -1) {
-    return CreateAndLogProbeError(mojom::ErrorType::kSystemUtilityError,
-                                  "Failed to run sysconf(_SC_CLK_TCK).");
+  contents = reader.ReadFile(kProcessCmdlineFile);
+  if (!contents) {
+    return read_error(kProcessCmdlineFile);
   }
+  process_info->command = std::string(*contents);
 
-  *process_uptime_ticks =
-      static_cast<uint64_t>(system_uptime_seconds *
-                            static_cast<double>(kClockTicksPerSecond)) -
-      start_time_ticks;
-  return std::nullopt;
-}
-
-std::optional<mojom::ProbeErrorPtr> ProcessFetcher::GetProcessUid(
-    uid_t* user_id, base::FilePath proc_pid_dir) {
-  DCHECK(user_id);
-
-  std::string status_contents;
-  if (!ReadAndTrimString(proc_pid_dir, kProcessStatusFile, &status_contents)) {
-    return CreateAndLogProbeError(
-        mojom::ErrorType::kFileReadError,
-        "Failed to read " + proc_pid_dir.Append(kProcessStatusFile).value());
-  }
-
-  std::vector<std::string> status_lines = base::SplitString(
-      status_contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-
-  bool uid_key_found = false;
-  std::string uid_str;
-  for (const auto& line : status_lines) {
-    if (!RE2::FullMatch(line, kUidStatusRegex, &uid_str))
-      continue;
-
-    unsigned int user_id_uint;
-    if (!base::StringToUint(uid_str, &user_id_uint)) {
-      return CreateAndLogProbeError(
-          mojom::ErrorType::kParseError,
-          "Failed to convert Uid to uint: " + uid_str);
+  // In "/proc/{PID}/cmdline", the arguments are separated by 0x00, we need
+  // to replace them by space for better output.
+  for (auto& ch : process_info->command) {
+    if (ch == '\0') {
+      ch = ' ';
     }
-
-    *user_id = static_cast<uid_t>(user_id_uint);
-
-    uid_key_found = true;
-    break;
-  }
-
-  if (!uid_key_found) {
-    return CreateAndLogProbeError(mojom::ErrorType::kParseError,
-                                  "Failed to find Uid key.");
   }
+  base::TrimWhitespaceASCII(process_info->command, base::TRIM_ALL,
+                            &process_info->command);
 
   return std::nullopt;
 }
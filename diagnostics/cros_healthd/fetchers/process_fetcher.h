@@ -50,49 +50,35 @@ class ProcessFetcher final : public BaseFetcher {
           void(ash::cros_healthd::mojom::MultipleProcessResultPtr)> callback);
 
  private:
-  // Collects |process_info| through `ParseProcPidStat`, `ParseProcPidStatm`,
-  // `CalculateProcessUptime`, `GetProcessUid` for |pid|.
-  std::optional<ash::cros_healthd::mojom::ProbeErrorPtr> GetProcessInfo(
-      uint32_t pid, ash::cros_healthd::mojom::ProcessInfo* process_info);
-  // Parses relevant fields from /proc/|process_id_|/stat. Returns the first
-  // error encountered or std::nullopt if no errors occurred. |priority|,
-  // |nice|, |start_time_ticks|, |name|, |parent_process_id|,
-  // |process_group_id|, |threads| and |process_id| are only valid if
-  // std::nullopt was returned.
-  std::optional<ash::cros_healthd::mojom::ProbeErrorPtr> ParseProcPidStat(
-      ash::cros_healthd::mojom::ProcessState* state,
-      int8_t* priority,
-      int8_t* nice,
-      uint64_t* start_time_ticks,
-      std::optional<std::string>* name,
-      uint32_t* parent_process_id,
-      uint32_t* process_group_id,
-      uint32_t* threads,
-      uint32_t* process_id,
-      base::FilePath proc_pid_dir);
-
-  // Parses relevant fields from /proc/|process_id_|/statm. Returns the first
+  // State shared by the processes fetched at once.
+  struct ScanContext {
+    ScanContext();
+    ScanContext(const ScanContext&) = delete;
+    ScanContext& operator=(const ScanContext&) = delete;
+    ~ScanContext();
+
+    // Uptime of the system, in clock ticks.
+    uint64_t system_uptime_ticks = 0;
+    // Size of a memory page, in KiB.
+    uint64_t page_size_kib = 0;
+    // Set if the above could not be determined.
+    std::optional<ash::cros_healthd::mojom::ProbeErrorPtr> error;
+    // Holds the contents of the file of a process being parsed, so that it is
+    // allocated once for all the processes.
+    std::string buffer;
+  };
+
+  // Reads the system-wide data needed to fetch the processes into
+  // |scan_context|.
+  void InitScanContext(ScanContext* scan_context);
+
+  // Collects |process_info| from the files in /proc/|pid|, which is opened once
+  // such that all the files are read from the same process. Returns the first
   // error encountered or std::nullopt if no errors occurred.
-  // |total_memory_kib|, |resident_memory_kib| and |free_memory_kib| are only
-  // valid if std::nullopt was returned.
-  std::optional<ash::cros_healthd::mojom::ProbeErrorPtr> ParseProcPidStatm(
-      uint32_t* total_memory_kib,
-      uint32_t* resident_memory_kib,
-      uint32_t* free_memory_kib,
-      base::FilePath proc_pid_dir);
-
-  // Calculates the uptime of the process in clock ticks using
-  // |start_time_ticks|. Returns the first error encountered or std::nullopt if
-  // no errors occurred. |process_uptime_ticks| is only valid if std::nullopt
-  // was returned.
-  std::optional<ash::cros_healthd::mojom::ProbeErrorPtr> CalculateProcessUptime(
-      uint64_t start_time_ticks, uint64_t* process_uptime_ticks);
-
-  // Fetches the real user ID of the process. Returns the first error
-  // encountered or std::nullopt if no errors occurred. |user_id| is only
-  // valid if std::nullopt was returned.
-  std::optional<ash::cros_healthd::mojom::ProbeErrorPtr> GetProcessUid(
-      uid_t* user_id, base::FilePath proc_pid_dir);
+  std::optional<ash::cros_healthd::mojom::ProbeErrorPtr> GetProcessInfo(
+      uint32_t pid,
+      ScanContext* scan_context,
+      ash::cros_healthd::mojom::ProcessInfo* process_info);
 
   // File paths read will be relative to |root_dir_|. In production, this should
   // be "/", but it can be overridden for testing.
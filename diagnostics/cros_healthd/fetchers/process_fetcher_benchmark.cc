@@ -0,0 +1,70 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Microbenchmark of fetching the information of all the processes of the
+// device running the benchmark, as telemetry clients do. The I/O statistics
+// read by the executor are faked. The numbers of fetches per second are
+// reported as "items_per_second".
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <base/containers/flat_map.h>
+#include <base/test/task_environment.h>
+#include <base/test/test_future.h>
+#include <benchmark/benchmark.h>
+#include <gmock/gmock.h>
+
+#include "diagnostics/cros_healthd/fetchers/process_fetcher.h"
+#include "diagnostics/cros_healthd/system/mock_context.h"
+#include "diagnostics/mojom/public/cros_healthd_probe.mojom.h"
+
+namespace diagnostics {
+namespace {
+
+namespace mojom = ::ash::cros_healthd::mojom;
+
+constexpr char kFakeProcPidIOContents[] =
+    "rchar: 44846\n"
+    "wchar: 10617\n"
+    "syscr: 248\n"
+    "syscw: 317\n"
+    "read_bytes: 56799232\n"
+    "write_bytes: 32768\n"
+    "cancelled_write_bytes: 0";
+
+void BM_FetchAllProcesses(benchmark::State& state) {
+  base::test::TaskEnvironment task_environment;
+  MockContext mock_context;
+  ON_CALL(*mock_context.mock_executor(), GetProcessIOContents)
+      .WillByDefault([](const std::vector<uint32_t>& pids,
+                        MockExecutor::GetProcessIOContentsCallback callback) {
+        base::flat_map<uint32_t, std::string> io_contents;
+        for (uint32_t pid : pids) {
+          io_contents[pid] = kFakeProcPidIOContents;
+        }
+        std::move(callback).Run(std::move(io_contents));
+      });
+  ProcessFetcher fetcher(&mock_context);
+
+  size_t num_processes = 0;
+  for (auto _ : state) {
+    base::test::TestFuture<mojom::MultipleProcessResultPtr> future;
+    fetcher.FetchMultipleProcessInfo(
+        /*input_process_ids=*/std::nullopt,
+        /*ignore_single_process_error=*/true, future.GetCallback());
+    num_processes = future.Get()->process_infos.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["processes"] = num_processes;
+}
+BENCHMARK(BM_FetchAllProcesses);
+
+}  // namespace
+}  // namespace diagnostics
+
+BENCHMARK_MAIN();
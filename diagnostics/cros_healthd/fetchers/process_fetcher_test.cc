@@ -320,6 +320,25 @@ TEST_F(ProcessFetcherTest, FetchProcessInfo) {
   EXPECT_EQ(process_info->process_id, kPid);
 }
 
+// Test that the name of the executable can contain spaces and parentheses.
+TEST_F(ProcessFetcherTest, FetchProcessInfoNameWithSpaces) {
+  ASSERT_TRUE(WriteFileAndCreateParentDirs(
+      GetProcProcessDirectoryPath(temp_dir_path(), kPid)
+          .Append(kProcessStatFile),
+      "6098 (fake (exe) 2) S 1 1015 1015 0 -1 4210944 1536 158 1 0 10956 "
+      "17428 19 37 20 0 1 0 358 36884480 3515"));
+  ExpectAndSetExecutorGetProcessIOContentsResponse(
+      kFakeProcPidIOContentsResult);
+
+  auto process_result = FetchProcessInfo();
+
+  ASSERT_TRUE(process_result->is_process_info());
+  const auto& process_info = process_result->get_process_info();
+  EXPECT_EQ(process_info->name, "fake (exe) 2");
+  EXPECT_EQ(process_info->state, kExpectedMojoState);
+  EXPECT_EQ(process_info->threads, kExpectedThreads);
+}
+
 // Test that we handle a missing /proc/uptime file.
 TEST_F(ProcessFetcherTest, MissingProcUptimeFile) {
   ASSERT_TRUE(brillo::DeleteFile(GetProcUptimePath(temp_dir_path())));
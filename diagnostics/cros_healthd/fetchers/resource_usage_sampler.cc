@@ -0,0 +1,280 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "diagnostics/cros_healthd/fetchers/resource_usage_sampler.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/functional/bind.h>
+#include <base/logging.h>
+#include <base/numerics/safe_conversions.h>
+#include <base/ranges/algorithm.h>
+#include <base/strings/string_number_conversions.h>
+#include <base/strings/string_split.h>
+#include <base/strings/string_util.h>
+
+#include "diagnostics/base/file_utils.h"
+#include "diagnostics/cros_healthd/fetchers/cpu_fetcher.h"
+#include "diagnostics/cros_healthd/utils/error_utils.h"
+#include "diagnostics/cros_healthd/utils/memory_info.h"
+#include "diagnostics/cros_healthd/utils/procfs_utils.h"
+#include "diagnostics/mojom/public/nullable_primitives.mojom.h"
+
+namespace diagnostics {
+
+namespace {
+
+namespace mojom = ::ash::cros_healthd::mojom;
+
+// File reporting the memory pressure stall information.
+constexpr char kRelativeProcPressureMemoryPath[] = "proc/pressure/memory";
+
+// Number of the times of the CPU lines of /proc/stat which add up to the total
+// time: user, nice, system, idle, iowait, irq, softirq and steal. The guest
+// times are already included in the user times.
+constexpr size_t kCpuTimeFields = 8;
+// Indices of the idle and iowait times among the times of a CPU line.
+constexpr size_t kIdleTimeIndex = 3;
+constexpr size_t kIoWaitTimeIndex = 4;
+
+// Returns the total time some tasks were stalled on memory, from the "total="
+// field of the "some" line of /proc/pressure/memory.
+std::optional<base::TimeDelta> ReadMemoryStallTime(
+    const base::FilePath& root_dir) {
+  std::string contents;
+  if (!ReadAndTrimString(root_dir.Append(kRelativeProcPressureMemoryPath),
+                         &contents)) {
+    return std::nullopt;
+  }
+
+  for (std::string_view line :
+       base::SplitStringPiece(contents, "\n", base::TRIM_WHITESPACE,
+                              base::SPLIT_WANT_NONEMPTY)) {
+    if (!base::StartsWith(line, "some "))
+      continue;
+    for (std::string_view field :
+         base::SplitStringPiece(line, " ", base::TRIM_WHITESPACE,
+                                base::SPLIT_WANT_NONEMPTY)) {
+      constexpr std::string_view kTotalPrefix = "total=";
+      uint64_t total_us;
+      if (base::StartsWith(field, kTotalPrefix) &&
+          base::StringToUint64(field.substr(kTotalPrefix.size()), &total_us)) {
+        return base::Microseconds(total_us);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+ResourceUsageSampler::Sample::Sample() = default;
+ResourceUsageSampler::Sample::Sample(Sample&&) = default;
+ResourceUsageSampler::Sample& ResourceUsageSampler::Sample::operator=(
+    Sample&&) = default;
+ResourceUsageSampler::Sample::~Sample() = default;
+
+ResourceUsageSampler::ResourceUsageSampler(Context* context,
+                                           base::TimeDelta sampling_interval)
+    : context_(context), sampling_interval_(sampling_interval) {
+  DCHECK(context_);
+  DCHECK(sampling_interval_.is_positive());
+  AddSample();
+}
+
+ResourceUsageSampler::~ResourceUsageSampler() = default;
+
+mojom::ResourceUsageSummaryResultPtr ResourceUsageSampler::GetSummary(
+    base::TimeDelta window) {
+  last_request_time_ = base::TimeTicks::Now();
+  if (!timer_.IsRunning()) {
+    timer_.Start(FROM_HERE, sampling_interval_,
+                 base::BindRepeating(&ResourceUsageSampler::OnSamplingTimer,
+                                     base::Unretained(this)));
+    OnSamplingTimer();
+  }
+
+  const base::TimeTicks window_start =
+      last_request_time_ - std::min(window, kMaxWindow);
+  auto first = base::ranges::lower_bound(samples_, window_start, {},
+                                         &Sample::time);
+  // Start from the baseline, or the last sample kept when sampling stopped.
+  if (std::distance(first, samples_.end()) < 2 && first != samples_.begin()) {
+    --first;
+  }
+  const size_t sample_count = std::distance(first, samples_.end());
+  if (sample_count < 2 || first->time == samples_.back().time) {
+    return mojom::ResourceUsageSummaryResult::NewError(CreateAndLogProbeError(
+        mojom::ErrorType::kServiceUnavailable,
+        "Not enough resource usage samples in the window yet"));
+  }
+
+  const Sample& first_sample = *first;
+  const Sample& last_sample = samples_.back();
+  auto summary = mojom::ResourceUsageSummary::New();
+  summary->window_seconds = base::checked_cast<uint32_t>(
+      (last_sample.time - first_sample.time).InSeconds());
+  summary->sample_count = base::checked_cast<uint32_t>(sample_count);
+
+  for (const auto& [logical_id, last_core] : last_sample.cores) {
+    // Skip the CPUs brought online during the window.
+    const auto first_core = first_sample.cores.find(logical_id);
+    if (first_core == first_sample.cores.end())
+      continue;
+
+    auto usage = mojom::CpuCoreUsage::New();
+    usage->logical_id = logical_id;
+    usage->average_utilization_percent =
+        GetUtilizationPercent(first_core->second, last_core);
+
+    uint64_t frequency_sum_khz = 0;
+    uint64_t frequency_count = 0;
+    const CoreSample* previous_core = nullptr;
+    for (auto it = first; it != samples_.end(); ++it) {
+      const auto core = it->cores.find(logical_id);
+      if (core == it->cores.end()) {
+        previous_core = nullptr;
+        continue;
+      }
+      frequency_sum_khz += core->second.frequency_khz;
+      ++frequency_count;
+      if (previous_core) {
+        usage->peak_utilization_percent =
+            std::max(usage->peak_utilization_percent,
+                     GetUtilizationPercent(*previous_core, core->second));
+      }
+      previous_core = &core->second;
+    }
+    usage->average_frequency_khz =
+        static_cast<uint32_t>(frequency_sum_khz / frequency_count);
+    summary->cpu_cores.push_back(std::move(usage));
+  }
+
+  uint64_t available_memory_sum_kib = 0;
+  summary->min_available_memory_kib = first_sample.available_memory_kib;
+  for (auto it = first; it != samples_.end(); ++it) {
+    available_memory_sum_kib += it->available_memory_kib;
+    summary->min_available_memory_kib =
+        std::min(summary->min_available_memory_kib, it->available_memory_kib);
+  }
+  summary->average_available_memory_kib =
+      static_cast<uint32_t>(available_memory_sum_kib / sample_count);
+
+  if (first_sample.memory_stall_time && last_sample.memory_stall_time &&
+      *last_sample.memory_stall_time >= *first_sample.memory_stall_time) {
+    summary->memory_pressure_percent = mojom::NullableDouble::New(
+        100.0 *
+        (*last_sample.memory_stall_time - *first_sample.memory_stall_time) /
+        (last_sample.time - first_sample.time));
+  }
+
+  return mojom::ResourceUsageSummaryResult::NewSummary(std::move(summary));
+}
+
+// static
+double ResourceUsageSampler::GetUtilizationPercent(const CoreSample& from,
+                                                   const CoreSample& to) {
+  // The times go backwards if the CPU went offline meanwhile.
+  if (to.total_time_user_hz <= from.total_time_user_hz ||
+      to.idle_time_user_hz < from.idle_time_user_hz) {
+    return 0;
+  }
+  const uint64_t total = to.total_time_user_hz - from.total_time_user_hz;
+  const uint64_t idle =
+      std::min(to.idle_time_user_hz - from.idle_time_user_hz, total);
+  return 100.0 * static_cast<double>(total - idle) /
+         static_cast<double>(total);
+}
+
+void ResourceUsageSampler::OnSamplingTimer() {
+  if (base::TimeTicks::Now() - last_request_time_ >= kIdleTimeout) {
+    timer_.Stop();
+    // Keep the last sample as the baseline of the next start.
+    while (samples_.size() > 1) {
+      samples_.pop_front();
+    }
+    return;
+  }
+
+  AddSample();
+}
+
+void ResourceUsageSampler::AddSample() {
+  std::optional<Sample> sample = TakeSample();
+  if (!sample.has_value())
+    return;
+  samples_.push_back(std::move(sample.value()));
+  // Keep one sample older than the longest window, which the aggregates start
+  // from when the window has too few samples.
+  while (samples_.size() > 1 &&
+         samples_.back().time - samples_[1].time >= kMaxWindow) {
+    samples_.pop_front();
+  }
+}
+
+std::optional<ResourceUsageSampler::Sample>
+ResourceUsageSampler::TakeSample() {
+  const base::FilePath& root_dir = context_->root_dir();
+  std::string stat_contents;
+  const base::FilePath stat_path = GetProcStatPath(root_dir);
+  if (!base::ReadFileToString(stat_path, &stat_contents)) {
+    LOG(ERROR) << "Unable to read stat file: " << stat_path.value();
+    return std::nullopt;
+  }
+  std::optional<MemoryInfo> memory_info = MemoryInfo::ParseFrom(root_dir);
+  if (!memory_info.has_value()) {
+    return std::nullopt;
+  }
+
+  Sample sample;
+  sample.time = base::TimeTicks::Now();
+  sample.available_memory_kib = memory_info->available_memory_kib;
+  sample.memory_stall_time = ReadMemoryStallTime(root_dir);
+
+  // Parse the lines of the format "cpu%d %d %d %d ...", where each line
+  // corresponds to a separate logical CPU.
+  for (std::string_view line :
+       base::SplitStringPiece(stat_contents, "\n", base::TRIM_WHITESPACE,
+                              base::SPLIT_WANT_NONEMPTY)) {
+    const std::vector<std::string_view> fields = base::SplitStringPiece(
+        line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    // This skips the first line, which aggregates all the logical CPUs.
+    uint32_t logical_id;
+    if (fields.size() <= kCpuTimeFields ||
+        !base::StartsWith(fields[0], "cpu") ||
+        !base::StringToUint(fields[0].substr(3), &logical_id)) {
+      continue;
+    }
+
+    CoreSample core = {};
+    for (size_t i = 0; i < kCpuTimeFields; ++i) {
+      uint64_t time_user_hz;
+      if (!base::StringToUint64(fields[i + 1], &time_user_hz)) {
+        LOG(ERROR) << "Unable to parse stat line: " << line;
+        return std::nullopt;
+      }
+      core.total_time_user_hz += time_user_hz;
+      if (i == kIdleTimeIndex || i == kIoWaitTimeIndex) {
+        core.idle_time_user_hz += time_user_hz;
+      }
+    }
+    // Not every CPU supports frequency scaling.
+    if (!ReadInteger(GetCpuFreqDirectoryPath(root_dir, logical_id),
+                     kScalingCurFreqFileName, &base::StringToUint,
+                     &core.frequency_khz)) {
+      core.frequency_khz = 0;
+    }
+    sample.cores[logical_id] = core;
+  }
+
+  return sample;
+}
+
+}  // namespace diagnostics
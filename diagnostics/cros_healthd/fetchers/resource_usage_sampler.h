@@ -0,0 +1,92 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef DIAGNOSTICS_CROS_HEALTHD_FETCHERS_RESOURCE_USAGE_SAMPLER_H_
+#define DIAGNOSTICS_CROS_HEALTHD_FETCHERS_RESOURCE_USAGE_SAMPLER_H_
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+#include <base/containers/circular_deque.h>
+#include <base/time/time.h>
+#include <base/timer/timer.h>
+
+#include "diagnostics/cros_healthd/system/context.h"
+#include "diagnostics/mojom/public/cros_healthd_probe.mojom.h"
+
+namespace diagnostics {
+
+// Samples the utilization and frequency of each logical CPU and the available
+// memory at a fixed rate, and aggregates the samples over windows. Monitoring
+// clients get accurate rates this way, without each of them fetching the whole
+// CpuInfo and MemoryInfo every few seconds.
+//
+// Sampling starts with the first request and stops once no request came for
+// |kIdleTimeout|, so that devices which are not monitored do not pay for it.
+// A baseline sample is taken on construction, and the last sample is kept when
+// sampling stops, so that the first request after a start can be answered.
+class ResourceUsageSampler {
+ public:
+  static constexpr base::TimeDelta kDefaultSamplingInterval = base::Seconds(1);
+  // Samples are kept for this long, which is the longest window.
+  static constexpr base::TimeDelta kMaxWindow = base::Minutes(10);
+  static constexpr base::TimeDelta kIdleTimeout = base::Minutes(30);
+
+  explicit ResourceUsageSampler(
+      Context* context,
+      base::TimeDelta sampling_interval = kDefaultSamplingInterval);
+  ResourceUsageSampler(const ResourceUsageSampler&) = delete;
+  ResourceUsageSampler& operator=(const ResourceUsageSampler&) = delete;
+  ~ResourceUsageSampler();
+
+  // Returns the aggregates of the samples taken during the last |window|, at
+  // most |kMaxWindow|. If fewer than two samples were taken in the window, the
+  // aggregates start from the last sample taken before it, so they cover a
+  // longer span, which is reported in |window_seconds|. Returns an error if
+  // there is no such sample either. Starts sampling if needed.
+  ash::cros_healthd::mojom::ResourceUsageSummaryResultPtr GetSummary(
+      base::TimeDelta window);
+
+ private:
+  struct CoreSample {
+    uint64_t total_time_user_hz;
+    uint64_t idle_time_user_hz;
+    uint32_t frequency_khz;
+  };
+
+  struct Sample {
+    Sample();
+    Sample(Sample&&);
+    Sample& operator=(Sample&&);
+    ~Sample();
+
+    base::TimeTicks time;
+    // Keyed by the logical IDs of the CPUs.
+    std::map<uint32_t, CoreSample> cores;
+    uint32_t available_memory_kib;
+    // Total time tasks were stalled on memory, if the kernel reports it.
+    std::optional<base::TimeDelta> memory_stall_time;
+  };
+
+  // Returns the percentage of the time the CPU was busy between two samples.
+  static double GetUtilizationPercent(const CoreSample& from,
+                                      const CoreSample& to);
+  // Takes a sample, and stops sampling if no request came for |kIdleTimeout|.
+  void OnSamplingTimer();
+  // Takes a sample and adds it to |samples_|.
+  void AddSample();
+  std::optional<Sample> TakeSample();
+
+  // Unowned pointer that outlives this instance.
+  Context* const context_;
+  const base::TimeDelta sampling_interval_;
+  base::RepeatingTimer timer_;
+  base::circular_deque<Sample> samples_;
+  base::TimeTicks last_request_time_;
+};
+
+}  // namespace diagnostics
+
+#endif  // DIAGNOSTICS_CROS_HEALTHD_FETCHERS_RESOURCE_USAGE_SAMPLER_H_
@@ -0,0 +1,150 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "diagnostics/cros_healthd/fetchers/resource_usage_sampler.h"
+
+#include <string>
+
+#include <base/files/file_path.h>
+#include <base/strings/string_number_conversions.h>
+#include <base/test/task_environment.h>
+#include <gtest/gtest.h>
+
+#include "diagnostics/base/file_test_utils.h"
+#include "diagnostics/cros_healthd/fetchers/cpu_fetcher.h"
+#include "diagnostics/cros_healthd/system/mock_context.h"
+#include "diagnostics/cros_healthd/utils/procfs_utils.h"
+#include "diagnostics/mojom/public/cros_healthd_probe.mojom.h"
+#include "diagnostics/mojom/public/nullable_primitives.mojom.h"
+
+namespace diagnostics {
+namespace {
+
+namespace mojom = ::ash::cros_healthd::mojom;
+
+constexpr char kRelativeProcMeminfoPath[] = "proc/meminfo";
+constexpr char kRelativeProcPressureMemoryPath[] = "proc/pressure/memory";
+
+class ResourceUsageSamplerTest : public ::testing::Test {
+ protected:
+  ResourceUsageSamplerTest() = default;
+  ResourceUsageSamplerTest(const ResourceUsageSamplerTest&) = delete;
+  ResourceUsageSamplerTest& operator=(const ResourceUsageSamplerTest&) =
+      delete;
+
+  const base::FilePath& root_dir() { return mock_context_.root_dir(); }
+
+  // Writes the files read by a sample: the times of two CPUs, the frequency of
+  // the first one, the available memory and the memory stall time.
+  void SetUpSample(const std::string& cpu0_times,
+                   const std::string& cpu1_times,
+                   uint32_t cpu0_frequency_khz,
+                   uint32_t available_memory_kib,
+                   uint64_t memory_stall_time_us) {
+    ASSERT_TRUE(WriteFileAndCreateParentDirs(
+        GetProcStatPath(root_dir()),
+        "cpu  0 0 0 0 0 0 0 0 0 0\n"
+        "cpu0 " +
+            cpu0_times +
+            "\n"
+            "cpu1 " +
+            cpu1_times + "\nintr 0\n"));
+    ASSERT_TRUE(WriteFileAndCreateParentDirs(
+        GetCpuFreqDirectoryPath(root_dir(), 0).Append(kScalingCurFreqFileName),
+        base::NumberToString(cpu0_frequency_khz)));
+    ASSERT_TRUE(WriteFileAndCreateParentDirs(
+        root_dir().Append(kRelativeProcMeminfoPath),
+        "MemTotal: 8000000 kB\n"
+        "MemFree: 1000000 kB\n"
+        "MemAvailable: " +
+            base::NumberToString(available_memory_kib) + " kB\n"));
+    ASSERT_TRUE(WriteFileAndCreateParentDirs(
+        root_dir().Append(kRelativeProcPressureMemoryPath),
+        "some avg10=0.00 avg60=0.00 avg300=0.00 total=" +
+            base::NumberToString(memory_stall_time_us) +
+            "\n"
+            "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"));
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  MockContext mock_context_;
+  ResourceUsageSampler sampler_{&mock_context_, base::Seconds(1)};
+};
+
+// Test that the samples are aggregated over the window.
+TEST_F(ResourceUsageSamplerTest, SummarizesSamples) {
+  // user nice system idle iowait irq softirq steal guest guest_nice
+  SetUpSample("100 0 100 800 0 0 0 0 0 0", "0 0 0 1000 0 0 0 0 0 0",
+              /*cpu0_frequency_khz=*/1000000, /*available_memory_kib=*/4000,
+              /*memory_stall_time_us=*/1000000);
+  // A single sample is not enough.
+  EXPECT_TRUE(sampler_.GetSummary(base::Seconds(60))->is_error());
+
+  // The first CPU is busy half of the second, the other one is idle.
+  SetUpSample("125 0 125 850 0 0 0 0 0 0", "0 0 0 1100 0 0 0 0 0 0",
+              /*cpu0_frequency_khz=*/2000000, /*available_memory_kib=*/2000,
+              /*memory_stall_time_us=*/1100000);
+  task_environment_.FastForwardBy(base::Seconds(1));
+
+  const auto result = sampler_.GetSummary(base::Seconds(60));
+  ASSERT_TRUE(result->is_summary());
+  const auto& summary = result->get_summary();
+  EXPECT_EQ(summary->window_seconds, 1u);
+  EXPECT_EQ(summary->sample_count, 2u);
+  ASSERT_EQ(summary->cpu_cores.size(), 2u);
+  EXPECT_EQ(summary->cpu_cores[0]->logical_id, 0u);
+  EXPECT_DOUBLE_EQ(summary->cpu_cores[0]->average_utilization_percent, 50.0);
+  EXPECT_DOUBLE_EQ(summary->cpu_cores[0]->peak_utilization_percent, 50.0);
+  EXPECT_EQ(summary->cpu_cores[0]->average_frequency_khz, 1500000u);
+  EXPECT_EQ(summary->cpu_cores[1]->logical_id, 1u);
+  EXPECT_DOUBLE_EQ(summary->cpu_cores[1]->average_utilization_percent, 0.0);
+  EXPECT_EQ(summary->cpu_cores[1]->average_frequency_khz, 0u);
+  EXPECT_EQ(summary->average_available_memory_kib, 3000u);
+  EXPECT_EQ(summary->min_available_memory_kib, 2000u);
+  ASSERT_TRUE(summary->memory_pressure_percent);
+  EXPECT_DOUBLE_EQ(summary->memory_pressure_percent->value, 10.0);
+}
+
+// Test that the first request starts from the baseline sample taken on
+// construction.
+TEST_F(ResourceUsageSamplerTest, FirstRequestUsesBaselineSample) {
+  SetUpSample("100 0 100 800 0 0 0 0 0 0", "0 0 0 1000 0 0 0 0 0 0",
+              /*cpu0_frequency_khz=*/1000000, /*available_memory_kib=*/4000,
+              /*memory_stall_time_us=*/0);
+  ResourceUsageSampler sampler{&mock_context_, base::Seconds(1)};
+  task_environment_.FastForwardBy(base::Seconds(120));
+
+  SetUpSample("150 0 150 900 0 0 0 0 0 0", "0 0 0 1200 0 0 0 0 0 0",
+              /*cpu0_frequency_khz=*/1000000, /*available_memory_kib=*/2000,
+              /*memory_stall_time_us=*/0);
+  // The window has a single sample, so the summary covers a longer span.
+  const auto result = sampler.GetSummary(base::Seconds(60));
+  ASSERT_TRUE(result->is_summary());
+  const auto& summary = result->get_summary();
+  EXPECT_EQ(summary->window_seconds, 120u);
+  EXPECT_EQ(summary->sample_count, 2u);
+  ASSERT_EQ(summary->cpu_cores.size(), 2u);
+  EXPECT_DOUBLE_EQ(summary->cpu_cores[0]->average_utilization_percent, 50.0);
+  EXPECT_EQ(summary->min_available_memory_kib, 2000u);
+}
+
+// Test that sampling stops once idle, and restarts from the last sample.
+TEST_F(ResourceUsageSamplerTest, StopsSamplingWhenIdle) {
+  SetUpSample("100 0 100 800 0 0 0 0 0 0", "0 0 0 1000 0 0 0 0 0 0",
+              /*cpu0_frequency_khz=*/1000000, /*available_memory_kib=*/4000,
+              /*memory_stall_time_us=*/0);
+  EXPECT_TRUE(sampler_.GetSummary(base::Seconds(60))->is_error());
+  task_environment_.FastForwardBy(ResourceUsageSampler::kIdleTimeout +
+                                  base::Seconds(1));
+
+  // Only the last sample taken before sampling stopped is kept.
+  const auto result = sampler_.GetSummary(base::Seconds(60));
+  ASSERT_TRUE(result->is_summary());
+  EXPECT_EQ(result->get_summary()->sample_count, 2u);
+  EXPECT_EQ(result->get_summary()->window_seconds, 2u);
+}
+
+}  // namespace
+}  // namespace diagnostics
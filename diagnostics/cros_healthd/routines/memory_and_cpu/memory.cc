@@ -9,10 +9,13 @@
 #include <utility>
 #include <vector>
 
+#include <base/barrier_closure.h>
 #include <base/check.h>
+#include <base/containers/contains.h>
 #include <base/files/file.h>
 #include <base/files/platform_file.h>
 #include <base/strings/string_number_conversions.h>
+#include <base/system/sys_info.h>
 #include <base/task/single_thread_task_runner.h>
 #include <base/time/time.h>
 #include <re2/re2.h>
@@ -208,6 +211,25 @@ SubtestProgressInfo SubtestEnumToProgressInfo(
 #endif
 }
 
+// Merges |other|, the result of another memtester process, into |detail|. A
+// subtest passes only if it passed in all the processes.
+void MergeMemtesterDetail(const mojom::MemoryRoutineDetail& other,
+                          mojom::MemoryRoutineDetail* detail) {
+  detail->bytes_tested += other.bytes_tested;
+  std::vector<mojom::MemtesterTestItemEnum>& failed_items =
+      detail->result->failed_items;
+  for (mojom::MemtesterTestItemEnum item : other.result->failed_items) {
+    if (!base::Contains(failed_items, item)) {
+      failed_items.push_back(item);
+    }
+  }
+  std::erase_if(detail->result->passed_items,
+                [&](mojom::MemtesterTestItemEnum item) {
+                  return base::Contains(failed_items, item) ||
+                         !base::Contains(other.result->passed_items, item);
+                });
+}
+
 }  // namespace
 
 MemoryRoutine::MemoryRoutine(Context* context,
@@ -251,46 +273,71 @@ void MemoryRoutine::Run(
   }
   testing_mem_kib = std::max(testing_mem_kib, kMemoryRoutineMinimumRequireKiB);
 
-  SetRunningState();
-  context_->executor()->RunMemtester(
-      testing_mem_kib, scoped_process_control_.BindNewPipeAndPassReceiver());
-  scoped_process_control_.AddOnTerminateCallback(
-      std::move(notify_resource_queue_finished));
+  // memtester is single-threaded, so a large amount of memory is tested
+  // faster by several processes each testing a share of it.
+  const uint32_t num_processes = std::clamp<uint32_t>(
+      std::min<uint32_t>(base::SysInfo::NumberOfProcessors(),
+                         testing_mem_kib / kMemtesterMinKiBPerProcess),
+      1, kMaxMemtesterProcesses);
+  // The resource queue is notified once all the processes have terminated.
+  base::RepeatingClosure on_process_terminated = base::BarrierClosure(
+      num_processes, notify_resource_queue_finished.Release());
 
+  SetRunningState();
   CallbackBarrier barrier{base::BindOnce(&MemoryRoutine::DetermineRoutineResult,
                                          weak_ptr_factory_.GetWeakPtr()),
                           base::BindOnce(&MemoryRoutine::RaiseException,
                                          weak_ptr_factory_.GetWeakPtr(),
                                          "Error in calling memtester")};
 
-  scoped_process_control_->GetStdout(barrier.Depend(base::BindOnce(
-      &MemoryRoutine::SetUpStdout, weak_ptr_factory_.GetWeakPtr())));
+  for (uint32_t i = 0; i < num_processes; ++i) {
+    // The last process also tests the remainder of the division.
+    uint32_t process_mem_kib = testing_mem_kib / num_processes;
+    if (i == num_processes - 1) {
+      process_mem_kib += testing_mem_kib % num_processes;
+    }
 
-  scoped_process_control_->GetReturnCode(barrier.Depend(base::BindOnce(
-      &MemoryRoutine::HandleGetReturnCode, weak_ptr_factory_.GetWeakPtr())));
+    memtester_processes_.push_back(std::make_unique<MemtesterProcess>());
+    MemtesterProcess* process = memtester_processes_.back().get();
+    context_->executor()->RunMemtester(
+        process_mem_kib,
+        process->scoped_process_control.BindNewPipeAndPassReceiver());
+    process->scoped_process_control.AddOnTerminateCallback(
+        base::ScopedClosureRunner(on_process_terminated));
+
+    process->scoped_process_control->GetStdout(barrier.Depend(base::BindOnce(
+        &MemoryRoutine::SetUpStdout, weak_ptr_factory_.GetWeakPtr(),
+        base::Unretained(process))));
+
+    process->scoped_process_control->GetReturnCode(
+        barrier.Depend(base::BindOnce(&MemoryRoutine::HandleGetReturnCode,
+                                      weak_ptr_factory_.GetWeakPtr(),
+                                      base::Unretained(process))));
+  }
 }
 
-void MemoryRoutine::HandleGetReturnCode(int return_code) {
-  memtester_return_code_ = return_code;
+void MemoryRoutine::HandleGetReturnCode(MemtesterProcess* process,
+                                        int return_code) {
+  process->return_code = return_code;
 }
 
-void MemoryRoutine::ReadNewMemtesterResult() {
+void MemoryRoutine::ReadNewMemtesterResult(MemtesterProcess* process) {
   // Read and parse the new output.
   std::string output;
   char buf[kBufSize];
-  int64_t offset = read_stdout_size_;
-  int64_t current_stdout_size = stdout_file_.GetLength();
+  int64_t offset = process->read_stdout_size;
+  int64_t current_stdout_size = process->stdout_file.GetLength();
 
   // Should not happen. But just in case reset everything and reread again.
   if (current_stdout_size < offset) {
     offset = 0;
-    read_stdout_size_ = 0;
+    process->read_stdout_size = 0;
     // Initialize an empty std::vector<std::vector<std::string>>.
-    parsed_memtester_result_ = {{""}};
+    process->parsed_result = {{""}};
   }
 
   while (offset < current_stdout_size) {
-    int read_len = stdout_file_.Read(
+    int read_len = process->stdout_file.Read(
         offset, buf, std::min<int64_t>(kBufSize, current_stdout_size - offset));
     if (read_len < 0) {
       LOG(ERROR) << "Read memtester stdout unsuccessful";
@@ -302,30 +349,33 @@ void MemoryRoutine::ReadNewMemtesterResult() {
 
   // Append a new std::vector<std::string> for each line, and
   // delimit the line by '\b' characters.
-  read_stdout_size_ = current_stdout_size;
+  process->read_stdout_size = current_stdout_size;
+  std::vector<std::vector<std::string>>& parsed_result = process->parsed_result;
   for (const char& c : output) {
     if (c == '\n') {
-      parsed_memtester_result_.emplace_back(std::vector<std::string>{""});
+      parsed_result.emplace_back(std::vector<std::string>{""});
     } else if (c == '\r') {
       continue;
     } else if (c == '\b') {
-      if (parsed_memtester_result_.back().back().length() > 0)
-        parsed_memtester_result_.back().emplace_back("");
+      if (parsed_result.back().back().length() > 0)
+        parsed_result.back().emplace_back("");
     } else {
-      parsed_memtester_result_.back().back().push_back(c);
+      parsed_result.back().back().push_back(c);
     }
   }
 }
 
-std::optional<int8_t> MemoryRoutine::CalculatePercentage() {
+std::optional<int8_t> MemoryRoutine::CalculatePercentage(
+    const MemtesterProcess& process) {
+  const std::vector<std::vector<std::string>>& parsed_result =
+      process.parsed_result;
   std::string subtest_name;
-  if (parsed_memtester_result_.empty() ||
-      parsed_memtester_result_.back().empty()) {
+  if (parsed_result.empty() || parsed_result.back().empty()) {
     LOG(ERROR) << "Parsed memtester result should never be empty";
     return std::nullopt;
   }
-  if (!RE2::PartialMatch(parsed_memtester_result_.back()[0],
-                         kMemtesterSubtestRegex, &subtest_name)) {
+  if (!RE2::PartialMatch(parsed_result.back()[0], kMemtesterSubtestRegex,
+                         &subtest_name)) {
     return std::nullopt;
   }
   // Process |subtest_name| so it's formatted without whitespace.
@@ -336,11 +386,11 @@ std::optional<int8_t> MemoryRoutine::CalculatePercentage() {
 
   std::string subtest_iteration_str;
   int subtest_iteration;
-  if (parsed_memtester_result_.back().back().find(
-          kMemtesterSubtestSuccessSubstring) != std::string::npos) {
+  if (parsed_result.back().back().find(kMemtesterSubtestSuccessSubstring) !=
+      std::string::npos) {
     return progress_info.cumulative_percentage +
            progress_info.subtest_percentage;
-  } else if (RE2::PartialMatch(parsed_memtester_result_.back().back(),
+  } else if (RE2::PartialMatch(parsed_result.back().back(),
                                kMemtesterSubtestProgressRegex,
                                &subtest_iteration_str)) {
     if (!base::StringToInt(subtest_iteration_str, &subtest_iteration)) {
@@ -359,10 +409,19 @@ std::optional<int8_t> MemoryRoutine::CalculatePercentage() {
 }
 
 void MemoryRoutine::UpdatePercentage() {
-  // Read the new output and update the percentage if applicable.
-  ReadNewMemtesterResult();
-
-  std::optional<int8_t> percentage_opt = CalculatePercentage();
+  // Read the new outputs and update the percentage if applicable. The routine
+  // is as far as the slowest process.
+  std::optional<int8_t> percentage_opt;
+  for (const auto& process : memtester_processes_) {
+    ReadNewMemtesterResult(process.get());
+    std::optional<int8_t> process_percentage = CalculatePercentage(*process);
+    if (!process_percentage.has_value()) {
+      percentage_opt = std::nullopt;
+      break;
+    }
+    percentage_opt = std::min(percentage_opt.value_or(INT8_MAX),
+                              process_percentage.value());
+  }
   if (percentage_opt.has_value() &&
       percentage_opt.value() > state()->percentage &&
       percentage_opt.value() < 100) {
@@ -378,16 +437,21 @@ void MemoryRoutine::UpdatePercentage() {
   }
 }
 
-void MemoryRoutine::SetUpStdout(mojo::ScopedHandle handle) {
+void MemoryRoutine::SetUpStdout(MemtesterProcess* process,
+                                mojo::ScopedHandle handle) {
   base::ScopedPlatformFile stdout_fd =
       mojo_utils::UnwrapMojoHandle(std::move(handle));
   if (!stdout_fd.is_valid()) {
     return;
   }
-  stdout_file_ = base::File(std::move(stdout_fd));
-  read_stdout_size_ = 0;
+  process->stdout_file = base::File(std::move(stdout_fd));
+  process->read_stdout_size = 0;
   // Initialize an empty std::vector<std::vector<std::string>>.
-  parsed_memtester_result_ = {{""}};
+  process->parsed_result = {{""}};
+  if (updating_percentage_) {
+    return;
+  }
+  updating_percentage_ = true;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostDelayedTask(
       FROM_HERE,
       base::BindOnce(&MemoryRoutine::UpdatePercentage,
@@ -396,8 +460,9 @@ void MemoryRoutine::SetUpStdout(mojo::ScopedHandle handle) {
 }
 
 // Parses memtester output and return memtester details.
-mojom::MemoryRoutineDetailPtr MemoryRoutine::ParseMemtesterResult() {
-  ReadNewMemtesterResult();
+mojom::MemoryRoutineDetailPtr MemoryRoutine::ParseMemtesterResult(
+    MemtesterProcess* process) {
+  ReadNewMemtesterResult(process);
   // The following regexes are pre-compiled for better performance.
   RE2 bytes_tested_regex(kMemtesterBytesTestedRegex);
   RE2 subtest_regex(kMemtesterSubtestRegex);
@@ -405,7 +470,7 @@ mojom::MemoryRoutineDetailPtr MemoryRoutine::ParseMemtesterResult() {
   auto detail = mojom::MemoryRoutineDetail::New();
   detail->result = mojom::MemtesterResult::New();
 
-  for (const std::vector<std::string>& line : parsed_memtester_result_) {
+  for (const std::vector<std::string>& line : process->parsed_result) {
     // The following strings are used to hold values matched from regexes.
     std::string bytes_tested_str;
     std::string subtest_name;
@@ -436,26 +501,39 @@ mojom::MemoryRoutineDetailPtr MemoryRoutine::ParseMemtesterResult() {
 }
 
 void MemoryRoutine::DetermineRoutineResult() {
-  scoped_process_control_.Reset();
+  // The return codes are bit flags, so combine those of all the processes.
+  int memtester_return_code = EXIT_SUCCESS;
+  for (const auto& process : memtester_processes_) {
+    process->scoped_process_control.Reset();
+    memtester_return_code |= process->return_code;
+  }
 
   // A return code of 1 may be given in two scenarios. Both scenarios should
   // raise an exception:
   //    1. The binary failed to run.
   //    2. There was memory allocating lock error in memtester.
-  if (memtester_return_code_ &
+  if (memtester_return_code &
       MemtesterErrorCodes::kAllocatingLockingInvokingError) {
     RaiseException(
         "Error allocating or locking memory, or invoking the memtester "
         "binary");
     return;
   }
-  auto memtester_detail = ParseMemtesterResult();
-  if (memtester_detail.is_null()) {
-    RaiseException("Error parsing memtester output");
-    return;
+  mojom::MemoryRoutineDetailPtr memtester_detail;
+  for (const auto& process : memtester_processes_) {
+    auto process_detail = ParseMemtesterResult(process.get());
+    if (process_detail.is_null()) {
+      RaiseException("Error parsing memtester output");
+      return;
+    }
+    if (memtester_detail.is_null()) {
+      memtester_detail = std::move(process_detail);
+    } else {
+      MergeMemtesterDetail(*process_detail, memtester_detail.get());
+    }
   }
 
-  bool has_passed = memtester_return_code_ == EXIT_SUCCESS;
+  bool has_passed = memtester_return_code == EXIT_SUCCESS;
   SetFinishedState(
       has_passed, mojom::RoutineDetail::NewMemory(std::move(memtester_detail)));
 }
@@ -28,6 +28,11 @@ namespace diagnostics {
 
 // Update the progress bar every kMemoryRoutineUpdatePeriod.
 inline constexpr base::TimeDelta kMemoryRoutineUpdatePeriod = base::Seconds(1);
+// The memory to test is split between up to kMaxMemtesterProcesses memtester
+// processes running in parallel, each testing at least
+// kMemtesterMinKiBPerProcess.
+inline constexpr uint32_t kMaxMemtesterProcesses = 4;
+inline constexpr uint32_t kMemtesterMinKiBPerProcess = 4 * 1024 * 1024;
 
 // The memory routine checks that the device's memory is working correctly.
 class MemoryRoutine final : public BaseRoutineControl {
@@ -43,49 +48,56 @@ class MemoryRoutine final : public BaseRoutineControl {
   void OnStart() override;
 
  private:
+  // A memtester process testing a share of the memory.
+  struct MemtesterProcess {
+    // A scoped version of process control that manages the lifetime of the
+    // memtester process.
+    ScopedProcessControl scoped_process_control;
+    // The return code of the memtester process.
+    int return_code = 0;
+    // A file descriptor that points to memtester stdout to allow for real time
+    // output capturing.
+    base::File stdout_file;
+    // Stores the number of bytes the stdout file has been read so far.
+    int64_t read_stdout_size = 0;
+    // Stores the parsed stdout result.
+    std::vector<std::vector<std::string>> parsed_result;
+  };
+
   // The |Run| function is added to the memory resource queue as a callback and
   // will be called when memory resource is available.
   void Run(base::ScopedClosureRunner notify_resource_queue_finished);
 
-  // Initialize variables needed to read stdout.
-  void SetUpStdout(mojo::ScopedHandle handle);
+  // Initialize variables needed to read stdout of |process|.
+  void SetUpStdout(MemtesterProcess* process, mojo::ScopedHandle handle);
 
-  // Read memtester return code and parses memtester output.
+  // Read memtester return codes and parses memtester outputs.
   void DetermineRoutineResult();
 
-  // Accepts a return code and store it inside a class variable.
-  void HandleGetReturnCode(int return_code);
+  // Accepts a return code and store it inside |process|.
+  void HandleGetReturnCode(MemtesterProcess* process, int return_code);
 
   // Update the percentage progress of the routine.
   void UpdatePercentage();
 
-  // Read and parse the memtester stdout from read_stdout_size_ to
+  // Read and parse the memtester stdout of |process| from read_stdout_size to
   // current_stdout_size.
-  void ReadNewMemtesterResult();
+  void ReadNewMemtesterResult(MemtesterProcess* process);
 
-  // Parse the memtester output to determine the results.
-  ash::cros_healthd::mojom::MemoryRoutineDetailPtr ParseMemtesterResult();
+  // Parse the memtester output of |process| to determine its results.
+  ash::cros_healthd::mojom::MemoryRoutineDetailPtr ParseMemtesterResult(
+      MemtesterProcess* process);
 
-  // Calculate the percentage progress based on the current parsed output.
-  std::optional<int8_t> CalculatePercentage();
+  // Calculate the percentage progress of |process| based on its current parsed
+  // output.
+  std::optional<int8_t> CalculatePercentage(const MemtesterProcess& process);
 
   // Unowned. Should outlive this instance.
   Context* const context_ = nullptr;
-  // Once the memory resource is finished (when memtester finish running), run
-  // this callback to notify the resource queue of resource availability.
-  base::ScopedClosureRunner notify_resource_queue_finished_;
-  // A scoped version of process control that manages the lifetime of the
-  // memtester process.
-  ScopedProcessControl scoped_process_control_;
-  // The return code of memtester process.
-  int memtester_return_code_;
-  // A file descriptor that points to memtester stdout to allow for real time
-  // output capturing.
-  base::File stdout_file_;
-  // Stores the number of bytes the stdout file has been read so far.
-  int64_t read_stdout_size_;
-  // Stores the parsed stdout result.
-  std::vector<std::vector<std::string>> parsed_memtester_result_;
+  // The memtester processes, each testing a share of the memory.
+  std::vector<std::unique_ptr<MemtesterProcess>> memtester_processes_;
+  // Whether the progress is being updated periodically.
+  bool updating_percentage_ = false;
   // Stores the number of kib the memtester should test for as requested by the
   // user. Has value of std::nullopt if the user did not specify.
   std::optional<uint32_t> max_testing_mem_kib_;
@@ -19,6 +19,8 @@
 #include <base/functional/callback_helpers.h>
 #include <base/json/json_reader.h>
 #include <base/json/json_writer.h>
+#include <base/strings/stringprintf.h>
+#include <base/system/sys_info.h>
 #include <base/test/bind.h>
 #include <base/test/task_environment.h>
 #include <base/values.h>
@@ -556,6 +558,59 @@ TEST_F(MemoryRoutineAdapterTest, SettingMaxTestingMemKibValue) {
   EXPECT_EQ(received_testing_mem_kib_, 1000);
 }
 
+// Test that a large amount of memory is split between several memtester
+// processes, and that their results are merged.
+TEST_F(MemoryRoutineTest, SplitBetweenProcesses) {
+  constexpr uint32_t kTestingMemKib = 4 * kMemtesterMinKiBPerProcess;
+  SetMockMemoryInfo(base::StringPrintf(
+      "MemTotal:        %u kB\n"
+      "MemFree:         %u kB\n"
+      "MemAvailable:    %u kB\n",
+      kTestingMemKib * 2, kTestingMemKib + kCpuMemoryRoutineReservedSizeKiB,
+      kTestingMemKib + kCpuMemoryRoutineReservedSizeKiB));
+
+  std::vector<std::unique_ptr<FakeProcessControl>> process_controls;
+  uint32_t total_testing_mem_kib = 0;
+  EXPECT_CALL(*mock_context_.mock_executor(), RunMemtester(_, _))
+      .WillRepeatedly(WithArgs<0, 1>(
+          [&](uint32_t testing_mem_kib,
+              mojo::PendingReceiver<mojom::ProcessControl> receiver) {
+            auto process_control = std::make_unique<FakeProcessControl>();
+            std::string output;
+            // Only the first process finds an error.
+            const bool first = process_controls.empty();
+            EXPECT_TRUE(base::ReadFileToString(
+                base::FilePath(kTestDataRoot)
+                    .Append(first ? "stuck_address_failed_output"
+                                  : "all_test_passed_output"),
+                &output));
+            process_control->SetStdoutFileContent(output);
+            process_control->SetReturnCode(
+                first ? MemtesterErrorCodes::kStuckAddressTestError
+                      : EXIT_SUCCESS);
+            process_control->BindReceiver(std::move(receiver));
+            process_controls.push_back(std::move(process_control));
+            total_testing_mem_kib += testing_mem_kib;
+          }));
+
+  mojom::RoutineStatePtr result = RunRoutineAndWaitForExit();
+  const size_t expected_processes = std::min<size_t>(
+      base::SysInfo::NumberOfProcessors(), kMaxMemtesterProcesses);
+  EXPECT_EQ(process_controls.size(), expected_processes);
+  EXPECT_EQ(total_testing_mem_kib, kTestingMemKib);
+
+  EXPECT_TRUE(result->state_union->is_finished());
+  EXPECT_FALSE(result->state_union->get_finished()->has_passed);
+  const auto& detail =
+      result->state_union->get_finished()->detail->get_memory();
+  EXPECT_EQ(detail->bytes_tested, expected_processes * 104857600);
+  std::set<mojom::MemtesterTestItemEnum> expected_failed{
+      mojom::MemtesterTestItemEnum::kStuckAddress};
+  EXPECT_EQ(VectorToSet(detail->result->passed_items),
+            GetExpectedMemtesterTests(expected_failed));
+  EXPECT_EQ(VectorToSet(detail->result->failed_items), expected_failed);
+}
+
 // Test that the memory routine is able to detect incremental progress.
 TEST_F(MemoryRoutineTest, IncrementalProgress) {
   std::string progress_0_output, progress_bit_flip_output,
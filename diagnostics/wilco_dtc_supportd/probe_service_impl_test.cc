@@ -50,6 +50,10 @@ class MockProbeService : public mojo_ipc::CrosHealthdProbeService {
                bool,
                ProbeMultipleProcessInfoCallback),
               (override));
+  MOCK_METHOD(void,
+              ProbeResourceUsageSummary,
+              (uint32_t, ProbeResourceUsageSummaryCallback),
+              (override));
 };
 
 class MockProbeServiceDelegate : public ProbeService::Delegate {
@@ -45,6 +45,11 @@ bool DBusService::Install(brillo::ErrorPtr* err,
   return dlc_service_->Install(install_request, err);
 }
 
+bool DBusService::InstallBatch(
+    brillo::ErrorPtr* err, const InstallBatchRequest& install_batch_request) {
+  return dlc_service_->InstallBatch(install_batch_request, err);
+}
+
 bool DBusService::Uninstall(brillo::ErrorPtr* err, const string& id_in) {
   return dlc_service_->Uninstall(id_in, err);
 }
@@ -32,6 +32,8 @@ class DBusService : public org::chromium::DlcServiceInterfaceInterface {
                            const std::string& omaha_url_in) override;
   bool Install(brillo::ErrorPtr* err,
                const InstallRequest& install_request) override;
+  bool InstallBatch(brillo::ErrorPtr* err,
+                    const InstallBatchRequest& install_batch_request) override;
   bool Uninstall(brillo::ErrorPtr* err, const std::string& id_in) override;
   bool Purge(brillo::ErrorPtr* err, const std::string& id_in) override;
   bool Deploy(brillo::ErrorPtr* err, const std::string& id_in) override;
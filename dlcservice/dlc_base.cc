@@ -17,6 +17,7 @@
 #include <base/strings/stringprintf.h>
 #include <base/strings/string_number_conversions.h>
 #include <base/strings/string_util.h>
+#include <base/timer/elapsed_timer.h>
 #include <brillo/errors/error.h>
 #include <brillo/files/file_util.h>
 #include <chromeos/constants/imageloader.h>
@@ -25,6 +26,7 @@
 #include <dlcservice/proto_bindings/dlcservice.pb.h>
 
 #include "dlcservice/error.h"
+#include "dlcservice/metrics.h"
 #include "dlcservice/prefs.h"
 #include "dlcservice/system_state.h"
 #include "dlcservice/utils.h"
@@ -36,6 +38,24 @@ using std::vector;
 
 namespace dlcservice {
 
+namespace {
+
+// Calls CopyAndHashFile() and reports the time it took as the copy phase of
+// the installation.
+bool CopyAndHashImage(const FilePath& from,
+                      const FilePath& to,
+                      int64_t size,
+                      vector<uint8_t>* sha256) {
+  base::ElapsedTimer timer;
+  if (!CopyAndHashFile(from, to, size, sha256))
+    return false;
+  SystemState::Get()->metrics()->SendInstallPhaseTime(
+      metrics::InstallPhase::kCopy, timer.Elapsed());
+  return true;
+}
+
+}  // namespace
+
 // TODO(ahassani): Instead of initialize function, create a factory method so
 // we can develop different types of DLC classes.
 bool DlcBase::Initialize() {
@@ -341,10 +361,13 @@ bool DlcBase::Verify() {
   auto image_path = GetImagePath(SystemState::Get()->active_boot_slot());
 
   vector<uint8_t> image_sha256;
+  base::ElapsedTimer timer;
   if (!VerifyInternal(image_path, &image_sha256)) {
     LOG(ERROR) << "Failed to verify DLC=" << id_;
     return false;
   }
+  SystemState::Get()->metrics()->SendInstallPhaseTime(
+      metrics::InstallPhase::kVerify, timer.Elapsed());
 
   const auto& manifest_image_sha256 = manifest_->image_sha256();
   if (image_sha256 != manifest_image_sha256) {
@@ -397,8 +420,8 @@ bool DlcBase::PreloadedCopier(ErrorPtr* err) {
 
   FilePath image_path = GetImagePath(SystemState::Get()->active_boot_slot());
   vector<uint8_t> image_sha256;
-  if (!CopyAndHashFile(preloaded_image_path_, image_path, manifest_->size(),
-                       &image_sha256)) {
+  if (!CopyAndHashImage(preloaded_image_path_, image_path, manifest_->size(),
+                        &image_sha256)) {
     auto err_str =
         base::StringPrintf("Failed to copy preload DLC (%s) into path %s",
                            id_.c_str(), image_path.value().c_str());
@@ -446,8 +469,8 @@ bool DlcBase::FactoryInstallCopier() {
 
   FilePath image_path = GetImagePath(SystemState::Get()->active_boot_slot());
   vector<uint8_t> image_sha256;
-  if (!CopyAndHashFile(factory_install_image_path_, image_path,
-                       manifest_->size(), &image_sha256)) {
+  if (!CopyAndHashImage(factory_install_image_path_, image_path,
+                        manifest_->size(), &image_sha256)) {
     LOG(WARNING) << "Failed to copy factory installed DLC (" << id_
                  << ") into path " << image_path;
     return false;
@@ -500,8 +523,8 @@ bool DlcBase::DeployCopier(ErrorPtr* err) {
 
   FilePath image_path = GetImagePath(SystemState::Get()->active_boot_slot());
   vector<uint8_t> image_sha256;
-  if (!CopyAndHashFile(deployed_image_path_, image_path, manifest_->size(),
-                       &image_sha256)) {
+  if (!CopyAndHashImage(deployed_image_path_, image_path, manifest_->size(),
+                        &image_sha256)) {
     auto err_str =
         base::StringPrintf("Failed to copy deployed DLC (%s) into path %s",
                            id_.c_str(), image_path.value().c_str());
@@ -706,9 +729,12 @@ bool DlcBase::CancelInstall(const ErrorPtr& err_in, ErrorPtr* err) {
 
 bool DlcBase::Mount(ErrorPtr* err) {
   string mount_point;
+  base::ElapsedTimer timer;
   if (!MountInternal(&mount_point, err)) {
     return false;
   }
+  SystemState::Get()->metrics()->SendInstallPhaseTime(
+      metrics::InstallPhase::kMount, timer.Elapsed());
   mount_point_ = FilePath(mount_point);
 
   // Creates a file which holds the root mount path, allowing for indirect
@@ -186,37 +186,7 @@ bool DlcService::InstallInternal(const InstallRequest& install_request,
 
   // Try to install and figure out if install through update_engine is needed.
   bool external_install_needed = false;
-  auto manager_install = [this](const InstallRequest& install_request,
-                                bool* external_install_needed, ErrorPtr* err) {
-    DCHECK(err);
-    const auto id = install_request.id();
-    auto* dlc = GetDlc(id, err);
-    if (dlc == nullptr) {
-      return false;
-    }
-
-    dlc->SetReserve(install_request.reserve());
-
-    // If the DLC is being installed, nothing can be done anymore.
-    if (dlc->IsInstalling()) {
-      return true;
-    }
-
-    // Otherwise proceed to install the DLC.
-    if (!dlc->Install(err)) {
-      Error::AddInternalTo(
-          err, FROM_HERE, error::kFailedInternal,
-          base::StringPrintf("Failed to initialize installation for DLC=%s",
-                             id.c_str()));
-      return false;
-    }
-
-    // If the DLC is now in installing state, it means it now needs
-    // update_engine installation.
-    *external_install_needed = dlc->IsInstalling();
-    return true;
-  };
-  if (!manager_install(install_request, &external_install_needed, err)) {
+  if (!InitializeInstall(install_request, &external_install_needed, err)) {
     LOG(ERROR) << "Failed to install DLC=" << install_request.id();
     return false;
   }
@@ -259,6 +229,108 @@ bool DlcService::InstallInternal(const InstallRequest& install_request,
   return true;
 }
 
+bool DlcService::InstallBatch(const InstallBatchRequest& install_batch_request,
+                              ErrorPtr* err) {
+  bool result = InstallBatchInternal(install_batch_request, err);
+  // Only send error metrics in here. Install success metrics is sent in
+  // |DlcBase|.
+  if (!result) {
+    LOG(ERROR) << AlertLogTag(kCategoryInstall)
+               << "Failed to install a batch of "
+               << install_batch_request.requests_size() << " DLC(s).";
+    SystemState::Get()->metrics()->SendInstallResultFailure(err);
+    Error::ConvertToDbusError(err);
+  }
+  return result;
+}
+
+bool DlcService::InstallBatchInternal(
+    const InstallBatchRequest& install_batch_request, ErrorPtr* err) {
+  if (installing_dlc_id_ || !install_queue_.Empty()) {
+    auto err_str = base::StringPrintf(
+        "Installation already in progress for (%s), can't install a batch of "
+        "DLCs right now.",
+        installing_dlc_id_.value_or("").c_str());
+    LOG(ERROR) << err_str;
+    *err = Error::Create(FROM_HERE, kErrorBusy, err_str);
+    return false;
+  }
+
+  // DLCs with an available image are installed right away, the others are
+  // queued for update_engine.
+  for (const auto& install_request : install_batch_request.requests()) {
+    bool external_install_needed = false;
+    if (!InitializeInstall(install_request, &external_install_needed, err)) {
+      LOG(ERROR) << "Failed to install DLC=" << install_request.id();
+      CancelInstall(*err);
+      return false;
+    }
+    if (external_install_needed) {
+      install_queue_.Push(install_request.id());
+      queued_install_requests_[install_request.id()] = install_request;
+    }
+  }
+
+  if (install_queue_.Empty())
+    return true;
+
+  batch_size_ = queued_install_requests_.size();
+  batch_finished_ = 0;
+  return InstallNextQueued(err);
+}
+
+bool DlcService::InitializeInstall(const InstallRequest& install_request,
+                                   bool* external_install_needed,
+                                   ErrorPtr* err) {
+  DCHECK(err);
+  const auto id = install_request.id();
+  auto* dlc = GetDlc(id, err);
+  if (dlc == nullptr) {
+    return false;
+  }
+
+  dlc->SetReserve(install_request.reserve());
+
+  // If the DLC is being installed, nothing can be done anymore.
+  if (dlc->IsInstalling()) {
+    return true;
+  }
+
+  // Otherwise proceed to install the DLC.
+  if (!dlc->Install(err)) {
+    Error::AddInternalTo(
+        err, FROM_HERE, error::kFailedInternal,
+        base::StringPrintf("Failed to initialize installation for DLC=%s",
+                           id.c_str()));
+    return false;
+  }
+
+  // If the DLC is now in installing state, it means it now needs
+  // update_engine installation.
+  *external_install_needed = dlc->IsInstalling();
+  return true;
+}
+
+bool DlcService::InstallNextQueued(ErrorPtr* err) {
+  DCHECK(!install_queue_.Empty());
+  const DlcId id = install_queue_.Peek();
+  install_queue_.Pop();
+  auto node = queued_install_requests_.extract(id);
+
+  if (!InstallWithUpdateEngine(node.mapped(), err)) {
+    // dlcservice must cancel the install as update_engine won't be able to
+    // install the initialized DLC, and the rest of the batch with it.
+    CancelInstall(*err);
+    return false;
+  }
+
+  // By now the update_engine is installing the DLC, so schedule a periodic
+  // install checker in case we miss update_engine signals.
+  SchedulePeriodicInstallCheck();
+
+  return true;
+}
+
 bool DlcService::InstallWithUpdateEngine(const InstallRequest& install_request,
                                          ErrorPtr* err) {
   const auto id = install_request.id();
@@ -436,7 +508,7 @@ bool DlcService::FinishInstall(ErrorPtr* err) {
 }
 
 void DlcService::CancelInstall(const ErrorPtr& err_in) {
-  if (!installing_dlc_id_) {
+  if (!installing_dlc_id_ && install_queue_.Empty()) {
     LOG(ERROR) << "No DLC installation to cancel.";
     return;
   }
@@ -447,11 +519,21 @@ void DlcService::CancelInstall(const ErrorPtr& err_in) {
     auto* dlc = GetDlc(id, err);
     return dlc && (!dlc->IsInstalling() || dlc->CancelInstall(err_in, err));
   };
-  auto id = installing_dlc_id_.value();
+  DlcIdList ids;
+  if (installing_dlc_id_)
+    ids.push_back(installing_dlc_id_.value());
   installing_dlc_id_.reset();
-  ErrorPtr tmp_err;
-  if (!manager_cancel(id, err_in, &tmp_err))
-    LOG(ERROR) << "Failed to cancel install for DLC=" << id;
+  for (; !install_queue_.Empty(); install_queue_.Pop())
+    ids.push_back(install_queue_.Peek());
+  queued_install_requests_.clear();
+  batch_size_ = 0;
+  batch_finished_ = 0;
+
+  for (const auto& id : ids) {
+    ErrorPtr tmp_err;
+    if (!manager_cancel(id, err_in, &tmp_err))
+      LOG(ERROR) << "Failed to cancel install for DLC=" << id;
+  }
 }
 
 void DlcService::PeriodicInstallCheck() {
@@ -518,6 +600,8 @@ bool DlcService::HandleStatusResult(brillo::ErrorPtr* err) {
   // Reset the tolerance if a valid status is handled.
   tolerance_count_ = 0;
 
+  bool install_succeeded = true;
+  ErrorPtr tmp_err;
   switch (status.current_operation()) {
     case update_engine::UPDATED_NEED_REBOOT:
       *err =
@@ -531,9 +615,20 @@ bool DlcService::HandleStatusResult(brillo::ErrorPtr* err) {
       // be executing this call for multiple DLCs.
       if (!FinishInstall(err)) {
         LOG(ERROR) << "Failed to finish install.";
-        return false;
+        // A failure to finish one DLC shouldn't hold up the rest of the batch.
+        install_succeeded = false;
       }
-      return true;
+      if (install_queue_.Empty()) {
+        batch_size_ = 0;
+        batch_finished_ = 0;
+        return install_succeeded;
+      }
+      ++batch_finished_;
+      if (!InstallNextQueued(&tmp_err)) {
+        LOG(ERROR) << "Failed to install the next DLC of the batch.";
+        SystemState::Get()->metrics()->SendInstallResultFailure(&tmp_err);
+      }
+      return install_succeeded;
     case Operation::REPORTING_ERROR_EVENT:
       *err =
           Error::CreateInternal(FROM_HERE, error::kFailedInstallInUpdateEngine,
@@ -552,7 +647,12 @@ bool DlcService::HandleStatusResult(brillo::ErrorPtr* err) {
           }
         }
       };
-      manager_change_progress(status.progress());
+      // Report the progress of the whole batch, as its DLCs are installed one
+      // after the other.
+      double progress = status.progress();
+      if (batch_size_ > 1)
+        progress = (batch_finished_ + progress) / batch_size_;
+      manager_change_progress(progress);
 
       [[fallthrough]];
     }
@@ -5,6 +5,8 @@
 #ifndef DLCSERVICE_DLC_SERVICE_H_
 #define DLCSERVICE_DLC_SERVICE_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -27,6 +29,7 @@
 #include "dlcservice/dlc_creator_interface.h"
 #include "dlcservice/system_state.h"
 #include "dlcservice/types.h"
+#include "dlcservice/unique_queue.h"
 
 namespace dlcservice {
 
@@ -52,6 +55,17 @@ class DlcServiceInterface {
   virtual bool Install(const InstallRequest& install_request,
                        brillo::ErrorPtr* err) = 0;
 
+  // Installs all the DLCs of |install_batch_request|. The DLCs that need to be
+  // installed through update_engine are queued and installed one after the
+  // other, and the progress of the whole batch is reported for each of them.
+  // Args:
+  //   install_batch_request: The install requests of the DLCs.
+  //   err: The error that's set when returned false.
+  // Return:
+  //   True on success, otherwise false.
+  virtual bool InstallBatch(const InstallBatchRequest& install_batch_request,
+                            brillo::ErrorPtr* err) = 0;
+
   // DLC Uninstall/Purge Flow
   //
   // To delete the DLC this can be invoked, no prior step is required.
@@ -107,6 +121,10 @@ class DlcService : public DlcServiceInterface {
   // Calls |InstallInternal| and sends the metrics for unsuccessful installs.
   bool Install(const InstallRequest& install_request,
                brillo::ErrorPtr* err) override;
+  // Calls |InstallBatchInternal| and sends the metrics for unsuccessful
+  // installs.
+  bool InstallBatch(const InstallBatchRequest& install_batch_request,
+                    brillo::ErrorPtr* err) override;
   bool Uninstall(const std::string& id, brillo::ErrorPtr* err) override;
   bool Deploy(const DlcId& id, brillo::ErrorPtr* err) override;
   DlcIdList GetInstalled() override;
@@ -155,7 +173,11 @@ class DlcService : public DlcServiceInterface {
   FRIEND_TEST(DlcServiceTest, FinishInstallTestNotInstalling);
   FRIEND_TEST(DlcServiceTest, FinishInstallTestSuccess);
 
-  // Cancels the currently running installation.
+  // Installs the next queued DLC of the batch through update_engine. Cancels
+  // the rest of the batch on failure.
+  bool InstallNextQueued(brillo::ErrorPtr* err);
+
+  // Cancels the currently running installation and the queued ones.
   // The |err_in| argument is the error that causes the install to be cancelled.
   void CancelInstall(const brillo::ErrorPtr& err_in);
   FRIEND_TEST(DlcServiceTest, CancelInstallNoOpTest);
@@ -183,6 +205,20 @@ class DlcService : public DlcServiceInterface {
   bool InstallInternal(const InstallRequest& install_request,
                        brillo::ErrorPtr* err);
 
+  // Installs a batch of DLCs without sending metrics when the install fails.
+  bool InstallBatchInternal(const InstallBatchRequest& install_batch_request,
+                            brillo::ErrorPtr* err);
+  FRIEND_TEST(DlcServiceTest, InstallBatchTestQueuesExternalInstalls);
+  FRIEND_TEST(DlcServiceTest, InstallBatchTestFailureCancelsQueue);
+  FRIEND_TEST(DlcServiceTest, InstallBatchTestBusy);
+
+  // Initializes the installation of a DLC, which installs it right away if its
+  // image is available. |external_install_needed| is set to true if the DLC
+  // still has to be installed through update_engine.
+  bool InitializeInstall(const InstallRequest& install_request,
+                         bool* external_install_needed,
+                         brillo::ErrorPtr* err);
+
   // Called on receiving update_engine's |StatusUpdate| signal.
   void OnStatusUpdateAdvancedSignal(
       const update_engine::StatusResult& status_result);
@@ -204,6 +240,16 @@ class DlcService : public DlcServiceInterface {
   // Holds the DLC that is being installed by update_engine.
   std::optional<DlcId> installing_dlc_id_;
 
+  // Holds the DLCs of a batch waiting for update_engine to install them, and
+  // their install requests.
+  UniqueQueue<DlcId, std::hash<DlcId>> install_queue_;
+  std::map<DlcId, InstallRequest> queued_install_requests_;
+
+  // Holds the number of DLCs of the current batch that go through
+  // update_engine, and how many of them are done.
+  size_t batch_size_ = 0;
+  size_t batch_finished_ = 0;
+
   // Holds the tolerance signal count during an installation.
   size_t tolerance_count_ = 0;
 
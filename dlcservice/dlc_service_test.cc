@@ -41,6 +41,7 @@ using testing::DoAll;
 using testing::ElementsAre;
 using testing::HasSubstr;
 using testing::Invoke;
+using testing::InvokeWithoutArgs;
 using testing::NiceMock;
 using testing::Return;
 using testing::SaveArg;
@@ -324,6 +325,117 @@ TEST_F(DlcServiceTest, InstallTestExternalRequirementInstallSuccess) {
   EXPECT_TRUE(dlc_service_->Install(CreateInstallRequest("foo-dlc"), &err));
 }
 
+// Tests related to `InstallBatch`.
+
+TEST_F(DlcServiceTest, InstallBatchTestQueuesExternalInstalls) {
+  DlcMap supported;
+  bool installing[2] = {false, false};
+  const DlcId ids[2] = {"foo-dlc", "bar-dlc"};
+  std::vector<MockDlc*> mock_dlcs;
+  for (int i = 0; i < 2; ++i) {
+    auto mock_dlc = std::make_unique<MockDlc>();
+    bool* dlc_installing = &installing[i];
+    EXPECT_CALL(*mock_dlc, Install(_))
+        .WillOnce(InvokeWithoutArgs([dlc_installing]() {
+          *dlc_installing = true;
+          return true;
+        }));
+    EXPECT_CALL(*mock_dlc, IsInstalling())
+        .WillRepeatedly(
+            InvokeWithoutArgs([dlc_installing]() { return *dlc_installing; }));
+    EXPECT_CALL(*mock_dlc, FinishInstall(true, _))
+        .WillOnce(InvokeWithoutArgs([dlc_installing]() {
+          *dlc_installing = false;
+          return true;
+        }));
+    EXPECT_CALL(*mock_dlc, IsScaled()).WillOnce(Return(false));
+    mock_dlcs.push_back(mock_dlc.get());
+    supported.emplace(ids[i], std::move(mock_dlc));
+  }
+  dlc_service_->SetSupportedForTesting(std::move(supported));
+
+  SystemState::Get()->set_update_engine_service_available(true);
+  EXPECT_CALL(*mock_update_engine_proxy_ptr_, Install(_, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(true));
+
+  InstallBatchRequest install_batch_request;
+  *install_batch_request.add_requests() = CreateInstallRequest(ids[0]);
+  *install_batch_request.add_requests() = CreateInstallRequest(ids[1]);
+  brillo::ErrorPtr err;
+  EXPECT_TRUE(dlc_service_->InstallBatch(install_batch_request, &err));
+  EXPECT_EQ(dlc_service_->installing_dlc_id_, ids[0]);
+
+  StatusResult status_result;
+  status_result.set_is_install(true);
+
+  // The progress is reported for the whole batch.
+  EXPECT_CALL(*mock_dlcs[0], ChangeProgress(0.25));
+  EXPECT_CALL(*mock_dlcs[1], ChangeProgress(0.25));
+  status_result.set_current_operation(Operation::DOWNLOADING);
+  status_result.set_progress(0.5);
+  dlc_service_->OnStatusUpdateAdvancedSignal(status_result);
+
+  // Finishing the first DLC starts installing the next one.
+  status_result.set_current_operation(Operation::IDLE);
+  dlc_service_->OnStatusUpdateAdvancedSignal(status_result);
+  EXPECT_EQ(dlc_service_->installing_dlc_id_, ids[1]);
+
+  EXPECT_CALL(*mock_dlcs[1], ChangeProgress(0.75));
+  status_result.set_current_operation(Operation::DOWNLOADING);
+  dlc_service_->OnStatusUpdateAdvancedSignal(status_result);
+
+  status_result.set_current_operation(Operation::IDLE);
+  dlc_service_->OnStatusUpdateAdvancedSignal(status_result);
+  EXPECT_FALSE(dlc_service_->installing_dlc_id_.has_value());
+  EXPECT_EQ(dlc_service_->batch_size_, 0u);
+}
+
+TEST_F(DlcServiceTest, InstallBatchTestFailureCancelsQueue) {
+  DlcMap supported;
+  for (const auto* id : {"foo-dlc", "bar-dlc"}) {
+    auto mock_dlc = std::make_unique<MockDlc>();
+    EXPECT_CALL(*mock_dlc, Install(_)).WillOnce(Return(true));
+    EXPECT_CALL(*mock_dlc, IsInstalling())
+        .WillOnce(Return(false))
+        // External requirement.
+        .WillOnce(Return(true))
+        // For cancelling.
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mock_dlc, CancelInstall(_, _)).WillOnce(Return(true));
+    supported.emplace(id, std::move(mock_dlc));
+  }
+  dlc_service_->SetSupportedForTesting(std::move(supported));
+
+  SystemState::Get()->set_update_engine_service_available(true);
+
+  EXPECT_CALL(*mock_metrics_,
+              SendInstallResult(InstallResult::kFailedUpdateEngineBusy));
+  EXPECT_CALL(*mock_update_engine_proxy_ptr_, Install(_, _, _))
+      .WillOnce(Return(false));
+
+  InstallBatchRequest install_batch_request;
+  *install_batch_request.add_requests() = CreateInstallRequest("foo-dlc");
+  *install_batch_request.add_requests() = CreateInstallRequest("bar-dlc");
+  brillo::ErrorPtr err;
+  EXPECT_FALSE(dlc_service_->InstallBatch(install_batch_request, &err));
+  EXPECT_FALSE(dlc_service_->installing_dlc_id_.has_value());
+  EXPECT_TRUE(dlc_service_->install_queue_.Empty());
+}
+
+TEST_F(DlcServiceTest, InstallBatchTestBusy) {
+  dlc_service_->installing_dlc_id_ = "foo-dlc";
+
+  EXPECT_CALL(*mock_metrics_,
+              SendInstallResult(InstallResult::kFailedUpdateEngineBusy));
+
+  InstallBatchRequest install_batch_request;
+  *install_batch_request.add_requests() = CreateInstallRequest("bar-dlc");
+  brillo::ErrorPtr err;
+  EXPECT_FALSE(dlc_service_->InstallBatch(install_batch_request, &err));
+  EXPECT_EQ(dlc_service_->installing_dlc_id_, "foo-dlc");
+}
+
 // Tests related to `Uninstall`.
 
 TEST_F(DlcServiceTest, UninstallTestUnsupported) {
@@ -98,19 +98,6 @@ bool LvmdProxyWrapper::GetLogicalVolume(const std::string& lv_name,
   return true;
 }
 
-bool LvmdProxyWrapper::CreateLogicalVolume(
-    const lvmd::Thinpool& thinpool,
-    const lvmd::LogicalVolumeConfiguration& lv_config,
-    lvmd::LogicalVolume* lv) {
-  brillo::ErrorPtr err;
-  if (!lvmd_proxy_->CreateLogicalVolume(thinpool, lv_config, lv, &err)) {
-    LOG(WARNING) << "Failed to CreateLogicalVolume in lvmd: "
-                 << Error::ToString(err);
-    return false;
-  }
-  return true;
-}
-
 bool LvmdProxyWrapper::RemoveLogicalVolume(const lvmd::LogicalVolume& lv) {
   brillo::ErrorPtr err;
   if (!lvmd_proxy_->RemoveLogicalVolume(lv, &err)) {
@@ -160,27 +147,42 @@ bool LvmdProxyWrapper::CreateLogicalVolumes(
     return false;
   }
 
-  // Prefer using thinpool's volume group as thinpool is passed into creating
-  // the logical volumes.
-  lvmd::LogicalVolume lv;
-  for (const auto& lv_config : lv_configs) {
-    auto lv_name = lv_config.name();
-    if (GetLogicalVolume(thinpool.volume_group(), lv_name, &lv)) {
+  // Logical volumes can't be created during resume from hibernate, so only
+  // activate the existing ones.
+  if (SystemState::Get()->resuming_from_hibernate()) {
+    // Prefer using thinpool's volume group as thinpool is passed into creating
+    // the logical volumes.
+    lvmd::LogicalVolume lv;
+    for (const auto& lv_config : lv_configs) {
+      auto lv_name = lv_config.name();
+      if (!GetLogicalVolume(thinpool.volume_group(), lv_name, &lv)) {
+        LOG(ERROR) << "Failed to CreateLogicalVolume "
+                      "during resume from hibernate, name="
+                   << lv_name;
+        return false;
+      }
       if (!ToggleLogicalVolumeActivation(lv, /*activate=*/true)) {
         LOG(ERROR) << "Failed to ToggleLogicalVolumeActivation name="
                    << lv_name;
         return false;
       }
-    } else if (SystemState::Get()->resuming_from_hibernate()) {
-      LOG(ERROR) << "Failed to CreateLogicalVolume "
-                    "during resume from hibernate, name="
-                 << lv_name;
-      return false;
-
-    } else if (!CreateLogicalVolume(thinpool, lv_config, &lv)) {
-      LOG(ERROR) << "Failed to CreateLogicalVolume name=" << lv_name;
-      return false;
     }
+    return true;
+  }
+
+  // lvmd creates the missing logical volumes and activates the existing ones
+  // in a single call.
+  lvmd::LogicalVolumeConfigurationList lv_config_list;
+  for (const auto& lv_config : lv_configs)
+    *lv_config_list.add_logical_volume_configuration() = lv_config;
+
+  lvmd::LogicalVolumeList lv_list;
+  brillo::ErrorPtr err;
+  if (!lvmd_proxy_->CreateLogicalVolumes(thinpool, lv_config_list, &lv_list,
+                                         &err)) {
+    LOG(ERROR) << "Failed to CreateLogicalVolumes in lvmd: "
+               << Error::ToString(err);
+    return false;
   }
   // TODO(b/254373821): Unsparse the logical volumes.
   return true;
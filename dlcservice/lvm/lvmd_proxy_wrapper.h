@@ -65,9 +65,6 @@ class LvmdProxyWrapper : public LvmdProxyWrapperInterface {
                         const std::string& lv_name,
                         lvmd::LogicalVolume* lv);
   bool GetLogicalVolume(const std::string& lv_name, lvmd::LogicalVolume* lv);
-  bool CreateLogicalVolume(const lvmd::Thinpool& thinpool,
-                           const lvmd::LogicalVolumeConfiguration& lv_config,
-                           lvmd::LogicalVolume* lv);
   bool RemoveLogicalVolume(const lvmd::LogicalVolume& lv);
   bool ToggleLogicalVolumeActivation(const lvmd::LogicalVolume& lv,
                                      bool activate);
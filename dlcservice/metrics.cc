@@ -9,6 +9,7 @@
 #include "dlcservice/error.h"
 #include "dlcservice/metrics.h"
 
+using dlcservice::metrics::InstallPhase;
 using dlcservice::metrics::InstallResult;
 using dlcservice::metrics::UninstallResult;
 using std::string;
@@ -19,6 +20,7 @@ namespace metrics {
 
 const char kMetricInstallResult[] = "Platform.DlcService.InstallResult";
 const char kMetricUninstallResult[] = "Platform.DlcService.UninstallResult";
+const char kMetricInstallPhaseTime[] = "Platform.DlcService.InstallPhaseTime";
 }  // namespace metrics
 
 // IMPORTANT: To obsolete a metric enum value, just remove it from the map
@@ -90,4 +92,23 @@ void Metrics::SendUninstallResult(UninstallResult result) {
       static_cast<int>(UninstallResult::kNumConstants));
 }
 
+void Metrics::SendInstallPhaseTime(InstallPhase phase,
+                                   base::TimeDelta duration) {
+  string suffix;
+  switch (phase) {
+    case InstallPhase::kCopy:
+      suffix = "Copy";
+      break;
+    case InstallPhase::kVerify:
+      suffix = "Verify";
+      break;
+    case InstallPhase::kMount:
+      suffix = "Mount";
+      break;
+  }
+  metrics_library_->SendToUMA(
+      string(metrics::kMetricInstallPhaseTime) + "." + suffix,
+      duration.InMilliseconds(), 1, base::Minutes(5).InMilliseconds(), 50);
+}
+
 }  // namespace dlcservice
@@ -10,6 +10,7 @@
 #include <string>
 #include <utility>
 
+#include <base/time/time.h>
 #include <metrics/metrics_library.h>
 
 #include "dlcservice/error.h"
@@ -19,6 +20,7 @@ namespace dlcservice {
 namespace metrics {
 extern const char kMetricInstallResult[];
 extern const char kMetricUninstallResult[];
+extern const char kMetricInstallPhaseTime[];
 
 // IMPORTANT: Please read this before making any changes to the file:
 // - Never change existing numerical values on the enums, because the same
@@ -51,6 +53,17 @@ enum class UninstallResult {
   kFailedUpdateEngineBusy = 3,
   kNumConstants
 };
+
+// Phases of an installation, reported as separate |kMetricInstallPhaseTime|
+// histograms.
+enum class InstallPhase {
+  // Copying (and hashing) a preloaded, factory installed or deployed image.
+  kCopy,
+  // Hashing an image already in place.
+  kVerify,
+  // Mounting the verified image.
+  kMount,
+};
 }  // namespace metrics
 
 // Performs UMA metrics logging for the dlcservice daemon.
@@ -76,6 +89,10 @@ class Metrics {
   // otherwise send a failure value.
   void SendUninstallResult(brillo::ErrorPtr* err);
 
+  // Sends the time spent in |phase| of an installation.
+  virtual void SendInstallPhaseTime(metrics::InstallPhase phase,
+                                    base::TimeDelta duration);
+
  protected:
   // For testing.
   Metrics() = default;
@@ -184,4 +184,25 @@ TEST_F(MetricsTest, SendUninstallResult_Failures) {
   // Check that all values were tested.
   EXPECT_EQ(4, static_cast<int>(UninstallResult::kNumConstants));
 }
+
+TEST_F(MetricsTest, SendInstallPhaseTime) {
+  const int max_ms = base::Minutes(5).InMilliseconds();
+  EXPECT_CALL(*metrics_library_,
+              SendToUMA("Platform.DlcService.InstallPhaseTime.Copy", 1500, 1,
+                        max_ms, 50));
+  metrics_->SendInstallPhaseTime(metrics::InstallPhase::kCopy,
+                                 base::Milliseconds(1500));
+
+  EXPECT_CALL(*metrics_library_,
+              SendToUMA("Platform.DlcService.InstallPhaseTime.Verify", 20, 1,
+                        max_ms, 50));
+  metrics_->SendInstallPhaseTime(metrics::InstallPhase::kVerify,
+                                 base::Milliseconds(20));
+
+  EXPECT_CALL(*metrics_library_,
+              SendToUMA("Platform.DlcService.InstallPhaseTime.Mount", 300, 1,
+                        max_ms, 50));
+  metrics_->SendInstallPhaseTime(metrics::InstallPhase::kMount,
+                                 base::Milliseconds(300));
+}
 }  // namespace dlcservice
@@ -20,6 +20,10 @@ class MockDlcService : public DlcServiceInterface {
               Install,
               (const InstallRequest&, brillo::ErrorPtr*),
               (override));
+  MOCK_METHOD(bool,
+              InstallBatch,
+              (const InstallBatchRequest&, brillo::ErrorPtr*),
+              (override));
   MOCK_METHOD(bool,
               Uninstall,
               (const std::string& id, brillo::ErrorPtr* err),
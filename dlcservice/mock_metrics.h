@@ -25,6 +25,11 @@ class MockMetrics : public Metrics {
               (metrics::UninstallResult result),
               (override));
 
+  MOCK_METHOD(void,
+              SendInstallPhaseTime,
+              (metrics::InstallPhase phase, base::TimeDelta duration),
+              (override));
+
  private:
   MockMetrics(const MockMetrics&) = delete;
   MockMetrics& operator=(const MockMetrics&) = delete;
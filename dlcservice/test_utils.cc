@@ -87,6 +87,9 @@ void BaseTest::SetUp() {
 
   auto mock_metrics = std::make_unique<testing::StrictMock<MockMetrics>>();
   mock_metrics_ = mock_metrics.get();
+  // Install phases are timed whenever images are copied, verified or mounted.
+  EXPECT_CALL(*mock_metrics_, SendInstallPhaseTime(_, _))
+      .Times(testing::AnyNumber());
 
   auto mock_system_properties =
       std::make_unique<testing::StrictMock<MockSystemProperties>>();
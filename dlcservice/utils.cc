@@ -5,6 +5,8 @@
 #include "dlcservice/utils.h"
 
 #include <fcntl.h>
+#include <linux/falloc.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -65,6 +67,51 @@ bool WriteFile(const FilePath& path, const string& data, bool truncate) {
   return base::WriteFileDescriptor(fd.get(), data);
 }
 
+// Number of bytes read, written and hashed at once.
+constexpr int64_t kCopyBufSize = 256 * 1024;
+
+// Returns the end of the range of |file| starting at |offset| and ending
+// before |size| that is entirely data (|is_data|) or entirely a hole. Files
+// which don't report holes (e.g. block devices) are data up to |size|.
+int64_t GetExtentEnd(base::File* file,
+                     int64_t offset,
+                     int64_t size,
+                     bool* is_data) {
+  off_t data = lseek(file->GetPlatformFile(), offset, SEEK_DATA);
+  if (data == -1) {
+    // ENXIO means that there is no data after |offset|.
+    *is_data = errno != ENXIO;
+    return size;
+  }
+  if (data > offset) {
+    *is_data = false;
+    return std::min<int64_t>(data, size);
+  }
+  *is_data = true;
+  off_t hole = lseek(file->GetPlatformFile(), offset, SEEK_HOLE);
+  return hole == -1 ? size : std::min<int64_t>(hole, size);
+}
+
+// Zeroes |length| bytes of |file| at |offset|, without writing them if the
+// filesystem (or block device) can, and hashes them into |hash|.
+bool ZeroAndHashRange(base::File* file,
+                      int64_t offset,
+                      int64_t length,
+                      SecureHash* hash) {
+  const vector<char> zeros(std::min(kCopyBufSize, length));
+  bool zeroed = fallocate(file->GetPlatformFile(),
+                          FALLOC_FL_ZERO_RANGE | FALLOC_FL_KEEP_SIZE, offset,
+                          length) == 0;
+  for (int64_t end = offset + length; offset < end;) {
+    int bytes = std::min<int64_t>(zeros.size(), end - offset);
+    if (!zeroed && file->Write(offset, zeros.data(), bytes) != bytes)
+      return false;
+    hash->Update(zeros.data(), bytes);
+    offset += bytes;
+  }
+  return true;
+}
+
 }  // namespace
 
 char kDlcDirAName[] = "dlc_a";
@@ -257,12 +304,11 @@ bool HashFile(const base::FilePath& path,
     }
   }
 
-  constexpr int64_t kMaxBufSize = 4096;
   unique_ptr<SecureHash> hash(SecureHash::Create(SecureHash::SHA256));
 
-  vector<char> buf(kMaxBufSize);
-  for (; size > 0; size -= kMaxBufSize) {
-    int bytes = std::min(kMaxBufSize, size);
+  vector<char> buf(kCopyBufSize);
+  for (; size > 0; size -= kCopyBufSize) {
+    int bytes = std::min(kCopyBufSize, size);
     if (f.ReadAtCurrentPos(buf.data(), bytes) != bytes) {
       PLOG(ERROR) << "Failed to read from file at " << path.value();
       return false;
@@ -302,21 +348,43 @@ bool CopyAndHashFile(const base::FilePath& from,
     return false;
   }
 
-  constexpr int64_t kMaxBufSize = 4096;
+  // Only the data of sparse files is read and written; their holes are
+  // zeroed in the destination, which may hold a previous image.
   unique_ptr<SecureHash> hash(SecureHash::Create(SecureHash::SHA256));
-
-  vector<char> buf(kMaxBufSize);
-  for (; size > 0; size -= kMaxBufSize) {
-    int bytes = std::min(kMaxBufSize, size);
-    if (f_from.ReadAtCurrentPos(buf.data(), bytes) != bytes) {
-      PLOG(ERROR) << "Failed to read from file at " << from.value();
-      return false;
+  vector<char> buf(kCopyBufSize);
+  for (int64_t offset = 0; offset < size;) {
+    bool is_data;
+    int64_t extent_end = GetExtentEnd(&f_from, offset, size, &is_data);
+    if (!is_data) {
+      if (!ZeroAndHashRange(&f_to, offset, extent_end - offset, hash.get())) {
+        PLOG(ERROR) << "Failed to write to file at " << to.value();
+        return false;
+      }
+      offset = extent_end;
+      continue;
     }
-    if (f_to.WriteAtCurrentPos(buf.data(), bytes) != bytes) {
-      PLOG(ERROR) << "Failed to write to file at " << from.value();
-      return false;
+    for (; offset < extent_end;) {
+      int bytes = std::min(kCopyBufSize, extent_end - offset);
+      if (f_from.Read(offset, buf.data(), bytes) != bytes) {
+        PLOG(ERROR) << "Failed to read from file at " << from.value();
+        return false;
+      }
+      if (f_to.Write(offset, buf.data(), bytes) != bytes) {
+        PLOG(ERROR) << "Failed to write to file at " << to.value();
+        return false;
+      }
+      hash->Update(buf.data(), bytes);
+      offset += bytes;
     }
-    hash->Update(buf.data(), bytes);
+  }
+  // Holes zeroed at the end of a shorter regular file don't extend it. (Block
+  // devices, e.g. logical volumes, report a zero length.)
+  struct stat to_stat;
+  if (fstat(f_to.GetPlatformFile(), &to_stat) == 0 &&
+      S_ISREG(to_stat.st_mode) && to_stat.st_size < size &&
+      !f_to.SetLength(size)) {
+    PLOG(ERROR) << "Failed to extend file at " << to.value();
+    return false;
   }
   sha256->resize(crypto::kSHA256Length);
   hash->Finish(sha256->data(), sha256->size());
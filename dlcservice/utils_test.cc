@@ -10,6 +10,7 @@
 #include <string>
 
 #include <base/check.h>
+#include <base/files/file.h>
 #include <base/files/file_util.h>
 #include <base/files/scoped_temp_dir.h>
 #include <base/functional/bind.h>
@@ -181,6 +182,39 @@ TEST_F(FixtureUtilsTest, CopyAndHashFile) {
   CheckPerms(dst_path, kDlcFilePerms);
 }
 
+TEST_F(FixtureUtilsTest, CopyAndHashSparseFile) {
+  auto src_path = JoinPaths(scoped_temp_dir_.GetPath(), "src_file");
+  auto dst_path = JoinPaths(scoped_temp_dir_.GetPath(), "dst_file");
+
+  // A source with a hole between two data ranges and a trailing hole.
+  constexpr int64_t kSize = 4 * 1024 * 1024;
+  constexpr int kDataSize = 4096;
+  const std::string data(kDataSize, 'a');
+  {
+    base::File src(src_path, base::File::FLAG_CREATE | base::File::FLAG_WRITE);
+    ASSERT_TRUE(src.IsValid());
+    ASSERT_EQ(kDataSize, src.Write(0, data.data(), kDataSize));
+    ASSERT_EQ(kDataSize, src.Write(kSize / 2, data.data(), kDataSize));
+    ASSERT_TRUE(src.SetLength(kSize));
+  }
+  // The holes have to be zeroed in a destination with previous content.
+  ASSERT_TRUE(base::WriteFile(dst_path, std::string(kSize / 4, 'b')));
+
+  std::string file_content;
+  EXPECT_TRUE(base::ReadFileToString(src_path, &file_content));
+  std::vector<uint8_t> expected_sha256(crypto::kSHA256Length);
+  crypto::SHA256HashString(file_content, expected_sha256.data(),
+                           expected_sha256.size());
+
+  std::vector<uint8_t> actual_sha256;
+  EXPECT_TRUE(CopyAndHashFile(src_path, dst_path, kSize, &actual_sha256));
+  EXPECT_THAT(actual_sha256, testing::ElementsAreArray(expected_sha256));
+
+  std::string dst_content;
+  EXPECT_TRUE(base::ReadFileToString(dst_path, &dst_content));
+  EXPECT_EQ(file_content, dst_content);
+}
+
 TEST_F(FixtureUtilsTest, CopyAndHashFileFailOnSize) {
   auto src_path = JoinPaths(scoped_temp_dir_.GetPath(), "src_file");
   auto dst_path = JoinPaths(scoped_temp_dir_.GetPath(), "dst_file");
@@ -40,6 +40,9 @@ namespace dlp {
 
 namespace {
 
+// Maximum number of files remembered as not DLP-protected.
+constexpr size_t kMaxUnrestrictedFiles = 10000;
+
 // Serializes |proto| to a vector of bytes. CHECKs for success (should
 // never fail if there are no required proto fields).
 std::vector<uint8_t> SerializeProto(
@@ -227,6 +230,12 @@ void DlpAdaptor::AddFiles(
     files_ids.emplace_back(id);
   }
 
+  // Open requests for the new files must go through the database again.
+  for (const FileId& id : files_ids) {
+    unrestricted_files_.erase(id);
+  }
+  unrestricted_files_generation_++;
+
   if (!db_) {
     LOG(WARNING) << "Database is not ready, pending addition of the file";
     pending_files_to_add_.insert(pending_files_to_add_.end(),
@@ -485,6 +494,7 @@ void DlpAdaptor::SetFanotifyWatcherStartedForTesting(bool is_started) {
 
 void DlpAdaptor::CloseDatabaseForTesting() {
   db_.reset();
+  ResetUnrestrictedFiles();
 }
 
 void DlpAdaptor::SetMetricsLibraryForTesting(
@@ -644,17 +654,39 @@ void DlpAdaptor::ProcessFileOpenRequest(
     return;
   }
 
-  db_->GetFileEntriesByIds(
+  if (base::Contains(unrestricted_files_, id)) {
+    std::move(callback).Run(/*allowed=*/true);
+    return;
+  }
+
+  db_->TryGetFileEntriesByIds(
       {id}, /*ignore_crtime=*/false,
       base::BindOnce(&DlpAdaptor::ProcessFileOpenRequestWithData,
-                     base::Unretained(this), pid, std::move(callback)));
+                     base::Unretained(this), id,
+                     unrestricted_files_generation_, pid,
+                     std::move(callback)));
 }
 
 void DlpAdaptor::ProcessFileOpenRequestWithData(
+    FileId id,
+    uint64_t generation,
     int pid,
     base::OnceCallback<void(bool)> callback,
-    std::map<FileId, FileEntry> file_entries) {
+    std::optional<std::map<FileId, FileEntry>> maybe_file_entries) {
+  if (!maybe_file_entries) {
+    // The lookup failed. Allow this request, but don't remember the file as
+    // unrestricted: it may well be in the database.
+    std::move(callback).Run(/*allowed=*/true);
+    return;
+  }
+  const std::map<FileId, FileEntry>& file_entries = *maybe_file_entries;
   if (file_entries.size() != 1) {
+    if (generation == unrestricted_files_generation_) {
+      if (unrestricted_files_.size() >= kMaxUnrestrictedFiles) {
+        unrestricted_files_.clear();
+      }
+      unrestricted_files_.insert(id);
+    }
     std::move(callback).Run(/*allowed=*/true);
     return;
   }
@@ -691,6 +723,11 @@ void DlpAdaptor::ProcessFileOpenRequestWithData(
                      base::Unretained(this), std::move(callbacks.second)));
 }
 
+void DlpAdaptor::ResetUnrestrictedFiles() {
+  unrestricted_files_.clear();
+  unrestricted_files_generation_++;
+}
+
 void DlpAdaptor::OnFileDeleted(ino64_t inode) {
   if (!db_) {
     LOG(WARNING) << "DLP database is not ready yet.";
@@ -1046,6 +1083,7 @@ void DlpAdaptor::OnDatabaseCleaned(std::unique_ptr<DlpDatabase> db,
                                    bool success) {
   if (success) {
     db_.swap(db);
+    ResetUnrestrictedFiles();
     LOG(INFO) << "Database is initialized";
     // If fanotify watcher is already started, we need to add watches for all
     // files from the database.
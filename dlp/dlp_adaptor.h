@@ -7,6 +7,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -115,9 +116,19 @@ class DlpAdaptor : public org::chromium::DlpAdaptor,
   void OnDatabaseError(DatabaseError error) override;
 
   // Callback on ProcessFileOpenRequest after getting data from database.
-  void ProcessFileOpenRequestWithData(int pid,
-                                      base::OnceCallback<void(bool)> callback,
-                                      std::map<FileId, FileEntry> file_entry);
+  // |generation| is the value of |unrestricted_files_generation_| when the
+  // lookup of |id| started. |maybe_file_entries| is std::nullopt if the lookup
+  // failed.
+  void ProcessFileOpenRequestWithData(
+      FileId id,
+      uint64_t generation,
+      int pid,
+      base::OnceCallback<void(bool)> callback,
+      std::optional<std::map<FileId, FileEntry>> maybe_file_entries);
+
+  // Forgets the files known to be unrestricted, e.g. when they may have been
+  // added to the database.
+  void ResetUnrestrictedFiles();
 
   // Callbacks on DlpPolicyMatched D-Bus request for ProcessFileOpenRequest.
   void OnDlpPolicyMatched(base::OnceCallback<void(bool)> callback,
@@ -280,6 +291,15 @@ class DlpAdaptor : public org::chromium::DlpAdaptor,
   // Files that were added before database was initialized, so they need to be
   // added once it's ready.
   std::vector<FileEntry> pending_files_to_add_;
+
+  // Ids of the files found not to be in the database, whose open requests are
+  // allowed without another database lookup. Most files opened under the
+  // watched directory are not DLP-protected, so this answers e.g. builds and
+  // unzips in Downloads without a round trip to the database thread.
+  // |unrestricted_files_generation_| is bumped whenever files are added to the
+  // database, so that lookups in flight then don't record stale results.
+  std::set<FileId> unrestricted_files_;
+  uint64_t unrestricted_files_generation_ = 0;
 };
 
 }  // namespace dlp
@@ -19,6 +19,7 @@
 #include <brillo/dbus/mock_dbus_method_response.h>
 #include <brillo/files/file_util.h>
 #include <gtest/gtest.h>
+#include <sqlite3.h>
 
 #include "dlp/dlp_adaptor_test_helper.h"
 #include "dlp/file_id.h"
@@ -335,6 +336,21 @@ class DlpAdaptorTest : public ::testing::Test {
     run_loop.Run();
   }
 
+  // Runs |sql| on the database opened by InitDatabase() through a separate
+  // connection, e.g. to make the queries of the adaptor fail.
+  void ExecSqlOnDatabase(const std::string& sql) {
+    sqlite3* db = nullptr;
+    ASSERT_EQ(sqlite3_open(database_directory_->GetPath()
+                               .Append("database")
+                               .MaybeAsASCII()
+                               .c_str(),
+                           &db),
+              SQLITE_OK);
+    EXPECT_EQ(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr),
+              SQLITE_OK);
+    sqlite3_close(db);
+  }
+
   void SetRulesAndInitFanotify() {
     GetDlpAdaptor()->SetFanotifyWatcherStartedForTesting(false);
     SetDlpFilesPolicyRequest request;
@@ -384,6 +400,76 @@ TEST_F(DlpAdaptorTest, AllowedWithDatabase) {
   EXPECT_THAT(helper_.GetMetrics(kDlpAdaptorErrorHistogram), ElementsAre());
 }
 
+TEST_F(DlpAdaptorTest, UnknownFileCheckedAgainAfterAdded) {
+  InitDatabase();
+
+  base::FilePath file_path;
+  base::CreateTemporaryFile(&file_path);
+  FileId id = GetFileId(file_path.value());
+
+  // The file isn't in the database, so it is allowed without asking Chrome,
+  // including when it is opened again.
+  EXPECT_CALL(*GetMockDlpFilesPolicyServiceProxy(),
+              DoCallMethodWithErrorCallback(_, _, _, _))
+      .Times(0);
+  for (int i = 0; i < 2; ++i) {
+    FileOpenRequestResultWaiter waiter;
+    helper_.ProcessFileOpenRequest(id, kPid, waiter.GetCallback());
+    EXPECT_TRUE(waiter.GetResult());
+  }
+  testing::Mock::VerifyAndClearExpectations(
+      GetMockDlpFilesPolicyServiceProxy());
+
+  AddFilesAndCheck({CreateAddFileRequest(file_path, "source", "referrer")},
+                   /*expected_result=*/true);
+
+  is_file_policy_restricted_ = true;
+  EXPECT_CALL(*GetMockDlpFilesPolicyServiceProxy(),
+              DoCallMethodWithErrorCallback(_, _, _, _))
+      .WillOnce(Invoke(this, &DlpAdaptorTest::StubIsDlpPolicyMatched));
+
+  FileOpenRequestResultWaiter waiter;
+  helper_.ProcessFileOpenRequest(id, kPid, waiter.GetCallback());
+
+  EXPECT_FALSE(waiter.GetResult());
+  EXPECT_THAT(helper_.GetMetrics(kDlpAdaptorErrorHistogram), ElementsAre());
+}
+
+TEST_F(DlpAdaptorTest, FileCheckedAgainAfterDatabaseError) {
+  InitDatabase();
+
+  base::FilePath file_path;
+  base::CreateTemporaryFile(&file_path);
+  AddFilesAndCheck({CreateAddFileRequest(file_path, "source", "referrer")},
+                   /*expected_result=*/true);
+  FileId id = GetFileId(file_path.value());
+
+  // The lookup fails, so the open is allowed without asking Chrome.
+  ExecSqlOnDatabase("ALTER TABLE file_entries_crtime RENAME TO hidden");
+  EXPECT_CALL(*GetMockDlpFilesPolicyServiceProxy(),
+              DoCallMethodWithErrorCallback(_, _, _, _))
+      .Times(0);
+  {
+    FileOpenRequestResultWaiter waiter;
+    helper_.ProcessFileOpenRequest(id, kPid, waiter.GetCallback());
+    EXPECT_TRUE(waiter.GetResult());
+  }
+  testing::Mock::VerifyAndClearExpectations(
+      GetMockDlpFilesPolicyServiceProxy());
+
+  // Once the database works again, the file is still restricted.
+  ExecSqlOnDatabase("ALTER TABLE hidden RENAME TO file_entries_crtime");
+  is_file_policy_restricted_ = true;
+  EXPECT_CALL(*GetMockDlpFilesPolicyServiceProxy(),
+              DoCallMethodWithErrorCallback(_, _, _, _))
+      .WillOnce(Invoke(this, &DlpAdaptorTest::StubIsDlpPolicyMatched));
+
+  FileOpenRequestResultWaiter waiter;
+  helper_.ProcessFileOpenRequest(id, kPid, waiter.GetCallback());
+
+  EXPECT_FALSE(waiter.GetResult());
+}
+
 TEST_F(DlpAdaptorTest, NotRestrictedFileAddedAndAllowed) {
   InitDatabase();
 
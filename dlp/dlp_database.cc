@@ -5,6 +5,7 @@
 #include "dlp/dlp_database.h"
 
 #include <cinttypes>
+#include <optional>
 #include <utility>
 #include "dlp/dlp_metrics.h"
 
@@ -139,8 +140,8 @@ class DlpDatabase::Core {
   bool UpsertFileEntry(const FileEntry& file_entry);
   bool UpsertLegacyFileEntryForTesting(const FileEntry& file_entry);
   bool UpsertFileEntries(const std::vector<FileEntry>& file_entries);
-  std::map<FileId, FileEntry> GetFileEntriesByIds(std::vector<FileId> ids,
-                                                  bool ignore_crtime) const;
+  std::optional<std::map<FileId, FileEntry>> GetFileEntriesByIds(
+      std::vector<FileId> ids, bool ignore_crtime) const;
   bool DeleteFileEntryByInode(ino64_t inode);
   bool DeleteFileEntriesWithIdsNotInSet(std::set<FileId> ids_to_keep);
   bool MigrateDatabase(const std::vector<FileId>& existing_files);
@@ -354,11 +355,13 @@ bool DlpDatabase::Core::UpsertFileEntries(
   return true;
 }
 
-std::map<FileId, FileEntry> DlpDatabase::Core::GetFileEntriesByIds(
-    std::vector<FileId> ids, bool ignore_crtime) const {
-  std::map<FileId, FileEntry> file_entries;
+std::optional<std::map<FileId, FileEntry>>
+DlpDatabase::Core::GetFileEntriesByIds(std::vector<FileId> ids,
+                                       bool ignore_crtime) const {
   if (!IsOpen())
-    return file_entries;
+    return std::nullopt;
+
+  std::map<FileId, FileEntry> file_entries;
 
   std::string sql;
   if (ignore_crtime) {
@@ -392,8 +395,7 @@ std::map<FileId, FileEntry> DlpDatabase::Core::GetFileEntriesByIds(
     LOG(ERROR) << "Failed to query: (" << result.code << ") "
                << result.error_msg;
     ForwardUMAErrorToParentThread(DatabaseError::kQueryError);
-    file_entries.clear();
-    return file_entries;
+    return std::nullopt;
   }
 
   return file_entries;
@@ -605,6 +607,23 @@ void DlpDatabase::GetFileEntriesByIds(
     std::vector<FileId> ids,
     bool ignore_crtime,
     base::OnceCallback<void(std::map<FileId, FileEntry>)> callback) const {
+  TryGetFileEntriesByIds(
+      std::move(ids), ignore_crtime,
+      base::BindOnce(
+          [](base::OnceCallback<void(std::map<FileId, FileEntry>)> callback,
+             std::optional<std::map<FileId, FileEntry>> file_entries) {
+            std::move(callback).Run(file_entries
+                                        ? std::move(*file_entries)
+                                        : std::map<FileId, FileEntry>());
+          },
+          std::move(callback)));
+}
+
+void DlpDatabase::TryGetFileEntriesByIds(
+    std::vector<FileId> ids,
+    bool ignore_crtime,
+    base::OnceCallback<void(std::optional<std::map<FileId, FileEntry>>)>
+        callback) const {
   CHECK(!task_runner_->RunsTasksInCurrentSequence());
   task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
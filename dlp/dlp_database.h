@@ -9,6 +9,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -91,6 +92,15 @@ class DlpDatabase : public DlpDatabaseDelegate {
       bool ignore_crtime,
       base::OnceCallback<void(std::map<FileId, FileEntry>)> callback) const;
 
+  // Same as GetFileEntriesByIds(), but returns std::nullopt to the |callback|
+  // if the query failed, so that an error can be told apart from no entries
+  // found.
+  void TryGetFileEntriesByIds(
+      std::vector<FileId> ids,
+      bool ignore_crtime,
+      base::OnceCallback<void(std::optional<std::map<FileId, FileEntry>>)>
+          callback) const;
+
   // Deletes file entry with |inode| from database. Returns true to the
   // |callback| if no error occurred.
   void DeleteFileEntryByInode(ino64_t inode,
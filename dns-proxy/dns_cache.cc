@@ -0,0 +1,305 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "dns-proxy/dns_cache.h"
+
+#include <arpa/inet.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include <base/strings/string_util.h>
+#include <chromeos/patchpanel/dns/dns_protocol.h>
+#include <chromeos/patchpanel/dns/dns_response.h>
+
+namespace dns_proxy {
+namespace {
+// Masks of the header flags that are not defined in dns_protocol.h.
+constexpr uint16_t kOpcodeMask = 0x7800;
+constexpr uint16_t kRcodeMask = 0xf;
+
+// Size of QTYPE and QCLASS following the name of a question.
+constexpr size_t kQuestionTypeAndClassSize = 4;
+
+// Size of the fixed fields of an SOA record following its names: SERIAL,
+// REFRESH, RETRY, EXPIRE and MINIMUM.
+constexpr size_t kSoaFixedFieldsSize = 20;
+
+// RFC 2181, section 8: TTL values with the most significant bit set are
+// treated as zero.
+constexpr uint32_t kMaxTtlValue = 0x7fffffff;
+
+uint16_t ReadUint16(const char* p) {
+  uint16_t value;
+  memcpy(&value, p, sizeof(value));
+  return ntohs(value);
+}
+
+uint32_t ReadUint32(const char* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return ntohl(value);
+}
+
+void WriteUint32(uint32_t value, char* p) {
+  value = htonl(value);
+  memcpy(p, &value, sizeof(value));
+}
+
+base::TimeDelta TtlToTimeDelta(uint32_t ttl) {
+  return base::Seconds(ttl > kMaxTtlValue ? 0 : ttl);
+}
+
+// Returns true if the wire-format name at |name| equals the lowercased
+// wire-format name |lower_name| regardless of the case. |name| must be at least
+// as long as |lower_name|.
+bool NameEqualsIgnoreCase(const char* name, const std::string& lower_name) {
+  for (size_t i = 0; i < lower_name.size(); i++) {
+    if (base::ToLowerASCII(name[i]) != lower_name[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+DnsCache::DnsCache(size_t max_entries) : max_entries_(max_entries) {}
+
+DnsCache::~DnsCache() = default;
+
+// static
+std::optional<DnsCache::Key> DnsCache::GetKey(const char* msg, size_t len) {
+  if (len < sizeof(patchpanel::dns_protocol::Header)) {
+    return std::nullopt;
+  }
+  patchpanel::dns_protocol::Header header;
+  memcpy(&header, msg, sizeof(header));
+  const uint16_t flags = ntohs(header.flags);
+  if ((flags & patchpanel::dns_protocol::kFlagResponse) ||
+      (flags & kOpcodeMask) || ntohs(header.qdcount) != 1) {
+    return std::nullopt;
+  }
+
+  // Read the question name. Compression pointers are not expected in the
+  // question of a query and are not supported.
+  Key key;
+  size_t offset = sizeof(header);
+  while (true) {
+    if (offset >= len) {
+      return std::nullopt;
+    }
+    const uint8_t label_len = static_cast<uint8_t>(msg[offset]);
+    if (label_len & patchpanel::dns_protocol::kLabelMask) {
+      return std::nullopt;
+    }
+    if (offset + 1 + label_len > len) {
+      return std::nullopt;
+    }
+    key.qname.push_back(static_cast<char>(label_len));
+    for (size_t i = offset + 1; i < offset + 1 + label_len; i++) {
+      key.qname.push_back(base::ToLowerASCII(msg[i]));
+    }
+    if (key.qname.size() > patchpanel::dns_protocol::kMaxNameLength) {
+      return std::nullopt;
+    }
+    offset += 1 + label_len;
+    if (label_len == 0) {
+      break;
+    }
+  }
+
+  if (offset + kQuestionTypeAndClassSize > len) {
+    return std::nullopt;
+  }
+  key.qtype = ReadUint16(msg + offset);
+  key.qclass = ReadUint16(msg + offset + 2);
+  return key;
+}
+
+// static
+bool DnsCache::MatchQuery(const Key& key,
+                          const char* query,
+                          std::string* response) {
+  const size_t qname_offset = sizeof(patchpanel::dns_protocol::Header);
+  if (response->size() <
+      qname_offset + key.qname.size() + kQuestionTypeAndClassSize) {
+    return false;
+  }
+  if (!NameEqualsIgnoreCase(response->data() + qname_offset, key.qname)) {
+    return false;
+  }
+  // Copy the ID.
+  memcpy(response->data(), query, sizeof(uint16_t));
+  // Copy the question name. Both names have the same length.
+  memcpy(response->data() + qname_offset, query + qname_offset,
+         key.qname.size());
+  return true;
+}
+
+std::optional<std::string> DnsCache::Get(const Key& key, const char* query) {
+  base::AutoLock lock(lock_);
+  const auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (now >= it->second.expiration_time) {
+    entries_.erase(it);
+    return std::nullopt;
+  }
+
+  const Entry& entry = it->second;
+  std::string response = entry.response;
+  const auto elapsed =
+      static_cast<uint32_t>((now - entry.creation_time).InSeconds());
+  for (const auto& [offset, ttl] : entry.ttls) {
+    WriteUint32(ttl > elapsed ? ttl - elapsed : 0, response.data() + offset);
+  }
+  if (!MatchQuery(key, query, &response)) {
+    return std::nullopt;
+  }
+  return response;
+}
+
+void DnsCache::Put(const Key& key, const unsigned char* msg, size_t len) {
+  if (max_entries_ == 0 || !msg) {
+    return;
+  }
+  Entry entry;
+  entry.response.assign(reinterpret_cast<const char*>(msg), len);
+  const auto ttl = ParseResponse(key, entry.response, &entry);
+  if (!ttl) {
+    return;
+  }
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::AutoLock lock(lock_);
+  if (entries_.find(key) == entries_.end() && entries_.size() >= max_entries_) {
+    Evict(now);
+  }
+  entry.creation_time = now;
+  entry.expiration_time = now + *ttl;
+  entries_.insert_or_assign(key, std::move(entry));
+}
+
+void DnsCache::Clear() {
+  base::AutoLock lock(lock_);
+  entries_.clear();
+}
+
+size_t DnsCache::size() const {
+  base::AutoLock lock(lock_);
+  return entries_.size();
+}
+
+// static
+std::optional<base::TimeDelta> DnsCache::ParseResponse(const Key& key,
+                                                       const std::string& msg,
+                                                       Entry* entry) {
+  patchpanel::dns_protocol::Header header;
+  const size_t question_offset = sizeof(header);
+  const size_t answer_offset =
+      question_offset + key.qname.size() + kQuestionTypeAndClassSize;
+  if (msg.size() < answer_offset) {
+    return std::nullopt;
+  }
+  memcpy(&header, msg.data(), sizeof(header));
+
+  // Only cache complete responses of successful or NXDOMAIN standard queries.
+  const uint16_t flags = ntohs(header.flags);
+  const uint16_t rcode = flags & kRcodeMask;
+  if (!(flags & patchpanel::dns_protocol::kFlagResponse) ||
+      (flags & patchpanel::dns_protocol::kFlagTC) || (flags & kOpcodeMask)) {
+    return std::nullopt;
+  }
+  if (rcode != patchpanel::dns_protocol::kRcodeNOERROR &&
+      rcode != patchpanel::dns_protocol::kRcodeNXDOMAIN) {
+    return std::nullopt;
+  }
+
+  // The question must be the one of the query.
+  if (ntohs(header.qdcount) != 1 ||
+      !NameEqualsIgnoreCase(msg.data() + question_offset, key.qname) ||
+      ReadUint16(msg.data() + answer_offset - 4) != key.qtype ||
+      ReadUint16(msg.data() + answer_offset - 2) != key.qclass) {
+    return std::nullopt;
+  }
+
+  const unsigned ancount = ntohs(header.ancount);
+  const unsigned nscount = ntohs(header.nscount);
+  const unsigned arcount = ntohs(header.arcount);
+  std::optional<base::TimeDelta> answer_ttl;
+  std::optional<base::TimeDelta> soa_ttl;
+  patchpanel::DnsRecordParser parser(msg.data(), msg.size(), answer_offset);
+  for (unsigned i = 0; i < ancount + nscount + arcount; i++) {
+    patchpanel::DnsResourceRecord record;
+    if (!parser.ReadRecord(&record)) {
+      return std::nullopt;
+    }
+    // The TTL precedes RDLENGTH and RDATA.
+    const size_t ttl_offset =
+        parser.GetOffset() - record.rdata.size() - sizeof(uint16_t) -
+        sizeof(uint32_t);
+    // The TTL field of OPT pseudo-records holds flags.
+    if (record.type == patchpanel::dns_protocol::kTypeOPT) {
+      continue;
+    }
+    entry->ttls.emplace_back(ttl_offset,
+                             record.ttl > kMaxTtlValue ? 0 : record.ttl);
+
+    // Records of the additional section do not affect the lifetime of the
+    // response.
+    if (i >= ancount + nscount) {
+      continue;
+    }
+    const base::TimeDelta ttl = TtlToTimeDelta(record.ttl);
+    answer_ttl = answer_ttl ? std::min(*answer_ttl, ttl) : ttl;
+    if (i >= ancount && record.type == patchpanel::dns_protocol::kTypeSOA &&
+        record.rdata.size() >= kSoaFixedFieldsSize) {
+      // RFC 2308, section 5: the TTL of negative answers is the minimum of the
+      // TTL of the SOA record and of its MINIMUM field.
+      const base::TimeDelta minimum = TtlToTimeDelta(
+          ReadUint32(record.rdata.data() + record.rdata.size() - 4));
+      soa_ttl = std::min(ttl, minimum);
+    }
+  }
+
+  std::optional<base::TimeDelta> ttl;
+  if (rcode == patchpanel::dns_protocol::kRcodeNXDOMAIN || ancount == 0) {
+    // RFC 2308, section 5: negative answers without SOA record should not be
+    // cached.
+    if (soa_ttl) {
+      ttl = std::min(*soa_ttl, kMaxNegativeTtl);
+    }
+  } else if (answer_ttl) {
+    ttl = std::min(*answer_ttl, kMaxTtl);
+  }
+  if (!ttl || !ttl->is_positive()) {
+    return std::nullopt;
+  }
+  return ttl;
+}
+
+void DnsCache::Evict(base::TimeTicks now) {
+  auto first_to_expire = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (now >= it->second.expiration_time) {
+      it = entries_.erase(it);
+      continue;
+    }
+    if (first_to_expire == entries_.end() ||
+        it->second.expiration_time <
+            first_to_expire->second.expiration_time) {
+      first_to_expire = it;
+    }
+    ++it;
+  }
+  if (entries_.size() >= max_entries_ && first_to_expire != entries_.end()) {
+    entries_.erase(first_to_expire);
+  }
+}
+
+}  // namespace dns_proxy
@@ -0,0 +1,113 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef DNS_PROXY_DNS_CACHE_H_
+#define DNS_PROXY_DNS_CACHE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <base/synchronization/lock.h>
+#include <base/thread_annotations.h>
+#include <base/time/time.h>
+
+namespace dns_proxy {
+
+// DnsCache stores wire-format DNS responses keyed by the question of the
+// query (name, type and class). Entries expire following the TTLs of the
+// records of the response. Negative responses (NXDOMAIN and NODATA) are cached
+// following the rules of RFC 2308: for the TTL of the SOA record of the
+// authority section, bounded by its MINIMUM field. Responses that cannot be
+// cached reliably (truncated responses, errors other than NXDOMAIN, negative
+// responses without SOA record) are ignored.
+//
+// Responses returned by the cache have their TTLs decremented by the time
+// spent in the cache and their ID and question rewritten to match the query.
+//
+// DnsCache is thread-safe such that it can be shared by the resolvers of
+// multiple threads.
+class DnsCache {
+ public:
+  // Question of a DNS query. |qname| is the name in DNS wire format, lowercased
+  // as names are case-insensitive.
+  struct Key {
+    std::string qname;
+    uint16_t qtype;
+    uint16_t qclass;
+
+    bool operator<(const Key& other) const {
+      return std::tie(qname, qtype, qclass) <
+             std::tie(other.qname, other.qtype, other.qclass);
+    }
+  };
+
+  // Maximum number of entries stored by default.
+  static constexpr size_t kDefaultMaxEntries = 512;
+  // Upper bounds on the time positive and negative responses are cached.
+  static constexpr base::TimeDelta kMaxTtl = base::Days(1);
+  static constexpr base::TimeDelta kMaxNegativeTtl = base::Hours(3);
+
+  explicit DnsCache(size_t max_entries = kDefaultMaxEntries);
+  DnsCache(const DnsCache&) = delete;
+  DnsCache& operator=(const DnsCache&) = delete;
+  ~DnsCache();
+
+  // Returns the key of the DNS query |msg| of length |len|, or std::nullopt if
+  // the query is not a standard query with exactly one question that can be
+  // cached.
+  static std::optional<Key> GetKey(const char* msg, size_t len);
+
+  // Copies the ID and the question name of |query| into |response|, both
+  // being for |key|. The question name is copied so that the case of the name
+  // matches the one of the query. Returns false if |response| is malformed.
+  static bool MatchQuery(const Key& key,
+                         const char* query,
+                         std::string* response);
+
+  // Returns the unexpired response cached for |key| with its TTLs updated and
+  // its ID and question matching |query|, or std::nullopt.
+  std::optional<std::string> Get(const Key& key, const char* query);
+
+  // Caches the response |msg| of length |len| to a query of |key| if it is
+  // cacheable.
+  void Put(const Key& key, const unsigned char* msg, size_t len);
+
+  // Removes all entries.
+  void Clear();
+
+  size_t size() const;
+
+ private:
+  struct Entry {
+    std::string response;
+    // Offsets of the TTL fields of the records of |response| and their
+    // original values.
+    std::vector<std::pair<size_t, uint32_t>> ttls;
+    base::TimeTicks creation_time;
+    base::TimeTicks expiration_time;
+  };
+
+  // Parses |response| into |entry| and returns the time |response| can be
+  // cached for, or std::nullopt if it is not cacheable.
+  static std::optional<base::TimeDelta> ParseResponse(const Key& key,
+                                                      const std::string& msg,
+                                                      Entry* entry);
+
+  // Makes room for a new entry by removing expired entries or else the entry
+  // expiring first.
+  void Evict(base::TimeTicks now) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const size_t max_entries_;
+  mutable base::Lock lock_;
+  std::map<Key, Entry> entries_ GUARDED_BY(lock_);
+};
+
+}  // namespace dns_proxy
+
+#endif  // DNS_PROXY_DNS_CACHE_H_
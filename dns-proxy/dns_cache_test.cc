@@ -0,0 +1,322 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "dns-proxy/dns_cache.h"
+
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+
+#include <base/test/task_environment.h>
+#include <base/time/time.h>
+#include <gtest/gtest.h>
+
+namespace dns_proxy {
+namespace {
+
+constexpr uint16_t kTypeA = 1;
+constexpr uint16_t kTypeSOA = 6;
+constexpr uint16_t kTypeAAAA = 28;
+constexpr uint16_t kTypeOPT = 41;
+constexpr uint16_t kClassIN = 1;
+
+// Flags of a response with RD and RA set.
+constexpr uint16_t kFlagsNoError = 0x8180;
+constexpr uint16_t kFlagsNXDomain = 0x8183;
+constexpr uint16_t kFlagsServFail = 0x8182;
+constexpr uint16_t kFlagsTruncated = 0x8380;
+// Flags of a query with RD set.
+constexpr uint16_t kFlagsQuery = 0x0100;
+
+void AppendUint16(uint16_t value, std::string* out) {
+  out->push_back(static_cast<char>(value >> 8));
+  out->push_back(static_cast<char>(value & 0xff));
+}
+
+void AppendUint32(uint32_t value, std::string* out) {
+  AppendUint16(static_cast<uint16_t>(value >> 16), out);
+  AppendUint16(static_cast<uint16_t>(value & 0xffff), out);
+}
+
+// Builds a DNS message (query or response) of one question for "Example.com".
+class MessageBuilder {
+ public:
+  MessageBuilder(uint16_t id,
+                 uint16_t flags,
+                 uint16_t qtype = kTypeA,
+                 const std::string& qname = std::string("\x07"
+                                                        "Example\x03"
+                                                        "com\x00",
+                                                        13)) {
+    AppendUint16(id, &header_);
+    AppendUint16(flags, &header_);
+    question_ = qname;
+    AppendUint16(qtype, &question_);
+    AppendUint16(kClassIN, &question_);
+  }
+
+  // Adds a record whose name points to the question name.
+  MessageBuilder& AddAnswer(uint16_t type,
+                            uint32_t ttl,
+                            const std::string& rdata) {
+    AppendRecord(type, ttl, rdata, &answers_);
+    ancount_++;
+    return *this;
+  }
+  MessageBuilder& AddAuthority(uint16_t type,
+                               uint32_t ttl,
+                               const std::string& rdata) {
+    AppendRecord(type, ttl, rdata, &answers_);
+    nscount_++;
+    return *this;
+  }
+  MessageBuilder& AddAdditional(uint16_t type,
+                                uint32_t ttl,
+                                const std::string& rdata) {
+    AppendRecord(type, ttl, rdata, &answers_);
+    arcount_++;
+    return *this;
+  }
+
+  std::string Build() const {
+    std::string msg = header_;
+    AppendUint16(1, &msg);
+    AppendUint16(ancount_, &msg);
+    AppendUint16(nscount_, &msg);
+    AppendUint16(arcount_, &msg);
+    return msg + question_ + answers_;
+  }
+
+ private:
+  static void AppendRecord(uint16_t type,
+                           uint32_t ttl,
+                           const std::string& rdata,
+                           std::string* out) {
+    if (type == kTypeOPT) {
+      out->push_back('\0');
+    } else {
+      AppendUint16(0xc00c, out);
+    }
+    AppendUint16(type, out);
+    AppendUint16(kClassIN, out);
+    AppendUint32(ttl, out);
+    AppendUint16(static_cast<uint16_t>(rdata.size()), out);
+    out->append(rdata);
+  }
+
+  std::string header_;
+  std::string question_;
+  std::string answers_;
+  uint16_t ancount_ = 0;
+  uint16_t nscount_ = 0;
+  uint16_t arcount_ = 0;
+};
+
+// Returns the RDATA of an SOA record with root names and |minimum|.
+std::string SoaRdata(uint32_t minimum) {
+  std::string rdata("\x00\x00", 2);
+  for (uint32_t value : {1u, 2u, 3u, 4u}) {
+    AppendUint32(value, &rdata);
+  }
+  AppendUint32(minimum, &rdata);
+  return rdata;
+}
+
+const std::string kAddress("\x01\x02\x03\x04", 4);
+
+class DnsCacheTest : public testing::Test {
+ protected:
+  void Put(const std::string& response) {
+    cache_.Put(key_, reinterpret_cast<const unsigned char*>(response.data()),
+               response.size());
+  }
+
+  std::optional<std::string> Get() {
+    return cache_.Get(key_, query_.c_str());
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  const std::string query_ = MessageBuilder(0x1234, kFlagsQuery).Build();
+  const DnsCache::Key key_ =
+      DnsCache::GetKey(query_.c_str(), query_.size()).value();
+  DnsCache cache_;
+};
+
+TEST_F(DnsCacheTest, GetKey) {
+  EXPECT_EQ(std::string("\x07"
+                        "example\x03"
+                        "com\x00",
+                        13),
+            key_.qname);
+  EXPECT_EQ(kTypeA, key_.qtype);
+  EXPECT_EQ(kClassIN, key_.qclass);
+
+  // Queries for other types have other keys.
+  const std::string query = MessageBuilder(1, kFlagsQuery, kTypeAAAA).Build();
+  const auto key = DnsCache::GetKey(query.c_str(), query.size());
+  ASSERT_TRUE(key);
+  EXPECT_TRUE(key_ < *key || *key < key_);
+}
+
+TEST_F(DnsCacheTest, GetKey_InvalidQuery) {
+  // Responses.
+  const std::string response = MessageBuilder(1, kFlagsNoError).Build();
+  EXPECT_FALSE(DnsCache::GetKey(response.c_str(), response.size()));
+  // Truncated queries.
+  EXPECT_FALSE(DnsCache::GetKey(query_.c_str(), 11));
+  EXPECT_FALSE(DnsCache::GetKey(query_.c_str(), query_.size() - 1));
+  // Compressed question name.
+  const std::string compressed =
+      MessageBuilder(1, kFlagsQuery, kTypeA, "\xc0\x0c").Build();
+  EXPECT_FALSE(DnsCache::GetKey(compressed.c_str(), compressed.size()));
+  // Queries with more than one question.
+  std::string query = query_;
+  query[5] = 2;
+  EXPECT_FALSE(DnsCache::GetKey(query.c_str(), query.size()));
+}
+
+TEST_F(DnsCacheTest, PositiveResponse) {
+  const std::string response = MessageBuilder(0x5678, kFlagsNoError)
+                                   .AddAnswer(kTypeA, 300, kAddress)
+                                   .AddAnswer(kTypeA, 60, kAddress)
+                                   .AddAdditional(kTypeOPT, 0x8000, "")
+                                   .Build();
+  Put(response);
+  EXPECT_EQ(1u, cache_.size());
+
+  // The ID of the query is used.
+  std::string expected = response;
+  expected[0] = '\x12';
+  expected[1] = '\x34';
+  EXPECT_EQ(expected, Get());
+
+  // TTLs are decremented but the flags of OPT records are left untouched.
+  task_environment_.FastForwardBy(base::Seconds(50));
+  const std::string updated = MessageBuilder(0x1234, kFlagsNoError)
+                                  .AddAnswer(kTypeA, 250, kAddress)
+                                  .AddAnswer(kTypeA, 10, kAddress)
+                                  .AddAdditional(kTypeOPT, 0x8000, "")
+                                  .Build();
+  EXPECT_EQ(updated, Get());
+
+  // The response expires with its first record.
+  task_environment_.FastForwardBy(base::Seconds(10));
+  EXPECT_FALSE(Get());
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(DnsCacheTest, QuestionCaseMatchesQuery) {
+  Put(MessageBuilder(1, kFlagsNoError)
+          .AddAnswer(kTypeA, 300, kAddress)
+          .Build());
+  const std::string query = MessageBuilder(2, kFlagsQuery, kTypeA,
+                                           std::string("\x07"
+                                                       "eXAMPLE\x03"
+                                                       "cOm\x00",
+                                                       13))
+                                .Build();
+  const auto key = DnsCache::GetKey(query.c_str(), query.size());
+  ASSERT_TRUE(key);
+  const auto response = cache_.Get(*key, query.c_str());
+  ASSERT_TRUE(response);
+  EXPECT_EQ(query.substr(0, 2), response->substr(0, 2));
+  EXPECT_EQ(query.substr(12, 13), response->substr(12, 13));
+}
+
+TEST_F(DnsCacheTest, NegativeResponse) {
+  // The TTL of negative responses is the minimum of the SOA TTL and MINIMUM.
+  Put(MessageBuilder(1, kFlagsNXDomain)
+          .AddAuthority(kTypeSOA, 600, SoaRdata(30))
+          .Build());
+  EXPECT_TRUE(Get());
+  task_environment_.FastForwardBy(base::Seconds(30));
+  EXPECT_FALSE(Get());
+
+  // NODATA responses.
+  Put(MessageBuilder(1, kFlagsNoError)
+          .AddAuthority(kTypeSOA, 20, SoaRdata(900))
+          .Build());
+  EXPECT_TRUE(Get());
+  task_environment_.FastForwardBy(base::Seconds(20));
+  EXPECT_FALSE(Get());
+}
+
+TEST_F(DnsCacheTest, NegativeResponseWithoutSoa) {
+  Put(MessageBuilder(1, kFlagsNXDomain).Build());
+  Put(MessageBuilder(1, kFlagsNoError).Build());
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(DnsCacheTest, UncacheableResponses) {
+  Put(MessageBuilder(1, kFlagsServFail)
+          .AddAuthority(kTypeSOA, 600, SoaRdata(600))
+          .Build());
+  Put(MessageBuilder(1, kFlagsTruncated)
+          .AddAnswer(kTypeA, 300, kAddress)
+          .Build());
+  Put(MessageBuilder(1, kFlagsNoError).AddAnswer(kTypeA, 0, kAddress).Build());
+  // The question does not match the key.
+  Put(MessageBuilder(1, kFlagsNoError, kTypeAAAA)
+          .AddAnswer(kTypeAAAA, 300, kAddress)
+          .Build());
+  // Malformed responses.
+  std::string response =
+      MessageBuilder(1, kFlagsNoError).AddAnswer(kTypeA, 300, kAddress).Build();
+  Put(response.substr(0, response.size() - 1));
+  Put(response.substr(0, 20));
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(DnsCacheTest, TtlIsBounded) {
+  Put(MessageBuilder(1, kFlagsNoError)
+          .AddAnswer(kTypeA, 7 * 24 * 3600, kAddress)
+          .Build());
+  task_environment_.FastForwardBy(DnsCache::kMaxTtl - base::Seconds(1));
+  EXPECT_TRUE(Get());
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_FALSE(Get());
+}
+
+TEST_F(DnsCacheTest, Clear) {
+  Put(MessageBuilder(1, kFlagsNoError)
+          .AddAnswer(kTypeA, 300, kAddress)
+          .Build());
+  EXPECT_EQ(1u, cache_.size());
+  cache_.Clear();
+  EXPECT_EQ(0u, cache_.size());
+  EXPECT_FALSE(Get());
+}
+
+TEST_F(DnsCacheTest, EvictFirstToExpire) {
+  DnsCache cache(/*max_entries=*/2);
+  auto put = [&cache](uint16_t qtype, uint32_t ttl) {
+    const std::string query = MessageBuilder(1, kFlagsQuery, qtype).Build();
+    const auto key = DnsCache::GetKey(query.c_str(), query.size()).value();
+    const std::string response = MessageBuilder(1, kFlagsNoError, qtype)
+                                     .AddAnswer(qtype, ttl, kAddress)
+                                     .Build();
+    cache.Put(key, reinterpret_cast<const unsigned char*>(response.data()),
+              response.size());
+    return key;
+  };
+  const auto key_a = put(kTypeA, 60);
+  const auto key_aaaa = put(kTypeAAAA, 30);
+  const auto key_txt = put(/*qtype=*/16, 300);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.Get(key_a, query_.c_str()));
+  EXPECT_FALSE(cache.Get(key_aaaa, query_.c_str()));
+  EXPECT_TRUE(cache.Get(key_txt, query_.c_str()));
+
+  // Expired entries are evicted first.
+  task_environment_.FastForwardBy(base::Seconds(60));
+  put(kTypeAAAA, 30);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.Get(key_aaaa, query_.c_str()));
+  EXPECT_TRUE(cache.Get(key_txt, query_.c_str()));
+}
+
+}  // namespace
+}  // namespace dns_proxy
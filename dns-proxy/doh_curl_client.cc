@@ -4,6 +4,8 @@
 
 #include "dns-proxy/doh_curl_client.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include <base/containers/contains.h>
@@ -20,6 +22,16 @@ constexpr char kLinuxUserAgent[] =
 constexpr std::array<const char*, 2> kDoHHeaderList{
     {"Accept: application/dns-message",
      "Content-Type: application/dns-message"}};
+
+// In connection pool mode, TCP keepalive probes are sent on idle connections
+// after |kKeepAliveIdleSeconds| and then every |kKeepAliveIntervalSeconds|,
+// such that the connections to the DoH providers are not dropped by
+// middleboxes.
+constexpr long kKeepAliveIdleSeconds = 30;      // NOLINT(runtime/int)
+constexpr long kKeepAliveIntervalSeconds = 15;  // NOLINT(runtime/int)
+// Idle connections older than this are closed instead of being reused. CURL
+// defaults to 118 seconds.
+constexpr long kMaxConnectionAgeSeconds = 300;  // NOLINT(runtime/int)
 }  // namespace
 
 DoHCurlClient::CurlResult::CurlResult(CURLcode curl_code,
@@ -29,8 +41,49 @@ DoHCurlClient::CurlResult::CurlResult(CURLcode curl_code,
       http_code(http_code),
       retry_delay_ms(retry_delay_ms) {}
 
-DoHCurlClient::State::State(CURL* curl, const QueryCallback& callback)
-    : curl(curl), callback(callback), header_list(nullptr) {}
+void DoHCurlClient::LatencyHistogram::Record(base::TimeDelta latency,
+                                             bool new_connection) {
+  const auto it =
+      std::upper_bound(kBucketBounds.begin(), kBucketBounds.end(), latency);
+  buckets_[std::distance(kBucketBounds.begin(), it)]++;
+  num_queries_++;
+  if (new_connection) {
+    num_new_connections_++;
+  }
+}
+
+base::TimeDelta DoHCurlClient::LatencyHistogram::GetPercentile(
+    int percentile) const {
+  if (num_queries_ == 0) {
+    return base::TimeDelta();
+  }
+  int count = 0;
+  for (size_t i = 0; i < kBucketBounds.size(); i++) {
+    count += buckets_[i];
+    if (count * 100 >= percentile * num_queries_) {
+      return kBucketBounds[i];
+    }
+  }
+  return base::TimeDelta::Max();
+}
+
+std::ostream& operator<<(
+    std::ostream& stream,
+    const DoHCurlClientInterface::LatencyHistogram& histogram) {
+  stream << histogram.num_queries() << " queries, "
+         << histogram.num_new_connections() << " new connections, p50 < "
+         << histogram.GetPercentile(50) << ", p90 < "
+         << histogram.GetPercentile(90);
+  return stream;
+}
+
+DoHCurlClient::State::State(CURL* curl,
+                            const QueryCallback& callback,
+                            const std::string& doh_provider)
+    : curl(curl),
+      callback(callback),
+      doh_provider(doh_provider),
+      header_list(nullptr) {}
 
 DoHCurlClient::State::~State() {
   curl_easy_cleanup(curl);
@@ -51,12 +104,29 @@ void DoHCurlClient::State::SetResponse(char* msg, size_t len) {
   response.insert(response.end(), msg, msg + len);
 }
 
-DoHCurlClient::DoHCurlClient(base::TimeDelta timeout)
-    : timeout_seconds_(timeout.InSeconds()) {
+DoHCurlClient::DoHCurlClient(base::TimeDelta timeout, bool connection_pool)
+    : timeout_seconds_(timeout.InSeconds()), connection_pool_(connection_pool) {
   // Initialize CURL.
   curl_global_init(CURL_GLOBAL_DEFAULT);
   curlm_ = curl_multi_init();
 
+  if (connection_pool_) {
+    // Multiplex concurrent queries to the same DoH provider as HTTP/2 streams
+    // of the same connection.
+    curl_multi_setopt(curlm_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    // Share the resolutions of the DoH providers and the TLS sessions such
+    // that new connections skip the DNS lookup and resume the TLS session.
+    // All queries run on the same thread, no lock is needed.
+    curlsh_ = curl_share_init();
+    if (curlsh_) {
+      curl_share_setopt(curlsh_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      curl_share_setopt(curlsh_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    } else {
+      LOG(ERROR) << "Failed to initialize curl share handle";
+    }
+  }
+
   // Set socket callback to `SocketCallback(...)`. This function will be called
   // whenever a CURL socket state is changed. DoHCurlClient class |this| will
   // passed as a parameter of the callback.
@@ -80,6 +150,11 @@ DoHCurlClient::~DoHCurlClient() {
   states_.clear();
   curl_multi_cleanup(curlm_);
   curlm_ = nullptr;
+  // The share handle must outlive the easy handles using it.
+  if (curlsh_) {
+    curl_share_cleanup(curlsh_);
+    curlsh_ = nullptr;
+  }
   curl_global_cleanup();
 }
 
@@ -97,6 +172,10 @@ void DoHCurlClient::HandleResult(CURLMsg* curl_msg) {
   int64_t http_code = 0;
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
 
+  if (connection_pool_ && curl_msg->data.result == CURLE_OK) {
+    RecordLatency(*state);
+  }
+
   // Run the callback.
   state->RunCallback(curl_msg, http_code);
 
@@ -105,6 +184,28 @@ void DoHCurlClient::HandleResult(CURLMsg* curl_msg) {
   states_.erase(state->curl);
 }
 
+void DoHCurlClient::RecordLatency(const State& state) {
+  curl_off_t total_time_us = 0;
+  long num_connects = 0;  // NOLINT(runtime/int)
+  if (curl_easy_getinfo(state.curl, CURLINFO_TOTAL_TIME_T, &total_time_us) !=
+          CURLE_OK ||
+      curl_easy_getinfo(state.curl, CURLINFO_NUM_CONNECTS, &num_connects) !=
+          CURLE_OK) {
+    return;
+  }
+  latency_histograms_[state.doh_provider].Record(
+      base::Microseconds(total_time_us), num_connects > 0);
+}
+
+const DoHCurlClientInterface::LatencyHistogram*
+DoHCurlClient::GetLatencyHistogram(const std::string& doh_provider) const {
+  const auto it = latency_histograms_.find(doh_provider);
+  if (it == latency_histograms_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
 void DoHCurlClient::CheckMultiInfo() {
   CURLMsg* curl_msg = nullptr;
   int msgs_left = 0;
@@ -251,7 +352,8 @@ std::unique_ptr<DoHCurlClient::State> DoHCurlClient::InitCurl(
   }
 
   // Allocate a state for the request.
-  std::unique_ptr<State> state = std::make_unique<State>(curl, callback);
+  std::unique_ptr<State> state =
+      std::make_unique<State>(curl, callback, doh_provider);
 
   // Set the target URL which is the DoH provider to query to.
   curl_easy_setopt(curl, CURLOPT_URL, doh_provider.c_str());
@@ -292,6 +394,25 @@ std::unique_ptr<DoHCurlClient::State> DoHCurlClient::InitCurl(
   curl_easy_setopt(curl, CURLOPT_REDIR_PROTOCOLS, 1L);
   curl_easy_setopt(curl, CURLOPT_POSTREDIR, CURL_REDIR_POST_ALL);
 
+  if (connection_pool_) {
+    // Negotiate HTTP/2 through ALPN and fall back to HTTP/1.1.
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+
+    // Wait for a connection being established to the DoH provider to be able
+    // to multiplex the query instead of opening another connection.
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+
+    // Keep the idle connections alive between queries.
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, kKeepAliveIdleSeconds);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, kKeepAliveIntervalSeconds);
+    curl_easy_setopt(curl, CURLOPT_MAXAGE_CONN, kMaxConnectionAgeSeconds);
+
+    if (curlsh_) {
+      curl_easy_setopt(curl, CURLOPT_SHARE, curlsh_);
+    }
+  }
+
   return state;
 }
 
@@ -7,8 +7,10 @@
 
 #include <curl/curl.h>
 
+#include <array>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <set>
 #include <string>
 #include <vector>
@@ -34,6 +36,39 @@ class DoHCurlClientInterface {
     int64_t retry_delay_ms;
   };
 
+  // Latency distribution of the queries sent to a DoH provider.
+  class LatencyHistogram {
+   public:
+    // Upper bounds of the buckets of the histogram. The last bucket counts the
+    // queries slower than the last bound.
+    static constexpr std::array<base::TimeDelta, 8> kBucketBounds = {
+        base::Milliseconds(10),   base::Milliseconds(25),
+        base::Milliseconds(50),   base::Milliseconds(100),
+        base::Milliseconds(250),  base::Milliseconds(500),
+        base::Milliseconds(1000), base::Milliseconds(2500),
+    };
+
+    // Records a query of latency |latency|. |new_connection| tells if a new
+    // connection was opened for the query.
+    void Record(base::TimeDelta latency, bool new_connection);
+
+    // Returns the smallest bucket bound under which at least |percentile|
+    // percent of the queries are, or base::TimeDelta::Max() if it lies in the
+    // last bucket. Returns base::TimeDelta() if no query is recorded.
+    base::TimeDelta GetPercentile(int percentile) const;
+
+    int num_queries() const { return num_queries_; }
+    int num_new_connections() const { return num_new_connections_; }
+
+    friend std::ostream& operator<<(std::ostream& stream,
+                                    const LatencyHistogram& histogram);
+
+   private:
+    std::array<int, kBucketBounds.size() + 1> buckets_ = {};
+    int num_queries_ = 0;
+    int num_new_connections_ = 0;
+  };
+
   // Callback to be invoked back to the client upon request completion.
   // |res| stores the CURL result code, HTTP code, retry delay of the CURL
   // query.
@@ -54,6 +89,13 @@ class DoHCurlClientInterface {
                        const QueryCallback& callback,
                        const std::vector<std::string>& name_servers,
                        const std::string& doh_provider) = 0;
+
+  // Returns the latency histogram of the queries sent to |doh_provider|, or
+  // nullptr if it is not tracked.
+  virtual const LatencyHistogram* GetLatencyHistogram(
+      const std::string& doh_provider) const {
+    return nullptr;
+  }
 };
 
 // DoHCurlClient receives a wire-format DNS query and re-send it using secure
@@ -61,9 +103,16 @@ class DoHCurlClientInterface {
 // response done through CURL. Given multiple DoH servers, DoHCurlClient will
 // query each servers concurrently. It will return only the first successful
 // response OR the last failing response.
+//
+// In connection pool mode, queries to the same DoH provider are sent as
+// HTTP/2 streams multiplexed over one persistent connection that is kept warm
+// with TCP keepalives between queries. DNS resolutions of the DoH providers and
+// TLS sessions are shared across queries, and the latency of the queries is
+// tracked per DoH provider.
 class DoHCurlClient : public DoHCurlClientInterface {
  public:
-  explicit DoHCurlClient(base::TimeDelta timeout);
+  explicit DoHCurlClient(base::TimeDelta timeout,
+                         bool connection_pool = false);
   DoHCurlClient(const DoHCurlClient&) = delete;
   DoHCurlClient& operator=(const DoHCurlClient&) = delete;
   virtual ~DoHCurlClient();
@@ -83,6 +132,9 @@ class DoHCurlClient : public DoHCurlClientInterface {
                const std::vector<std::string>& name_servers,
                const std::string& doh_provider) override;
 
+  const LatencyHistogram* GetLatencyHistogram(
+      const std::string& doh_provider) const override;
+
   // Returns a weak pointer to ensure that callbacks don't run after this class
   // is destroyed.
   base::WeakPtr<DoHCurlClient> GetWeakPtr() {
@@ -92,7 +144,9 @@ class DoHCurlClient : public DoHCurlClientInterface {
  private:
   // State of an individual query.
   struct State {
-    State(CURL* curl, const QueryCallback& callback);
+    State(CURL* curl,
+          const QueryCallback& callback,
+          const std::string& doh_provider);
     ~State();
 
     // Fetch the necessary response and run |callback|.
@@ -113,6 +167,9 @@ class DoHCurlClient : public DoHCurlClientInterface {
     // |callback| to be invoked back to the client upon request completion.
     QueryCallback callback;
 
+    // DoH provider the query is sent to.
+    std::string doh_provider;
+
     // |header_list| is owned by this struct. It is stored here in order to
     // free it when the request is done.
     curl_slist* header_list;
@@ -204,6 +261,10 @@ class DoHCurlClient : public DoHCurlClientInterface {
   void CheckMultiInfo();
   void HandleResult(CURLMsg* curl_msg);
 
+  // Records the latency of the completed query of |state| in connection pool
+  // mode.
+  void RecordLatency(const State& state);
+
   // Cancel an in-flight request denoted by a set of states |states|.
   void CancelRequest(const std::set<State*>& states);
 
@@ -227,6 +288,16 @@ class DoHCurlClient : public DoHCurlClientInterface {
   // CURL multi handle to do asynchronous requests.
   CURLM* curlm_;
 
+  // Whether queries are multiplexed over persistent connections.
+  const bool connection_pool_;
+
+  // CURL share handle to share DNS and TLS session caches across queries in
+  // connection pool mode. Null otherwise.
+  CURLSH* curlsh_ = nullptr;
+
+  // Latency of the queries keyed by DoH provider in connection pool mode.
+  std::map<std::string, LatencyHistogram> latency_histograms_;
+
   base::WeakPtrFactory<DoHCurlClient> weak_factory_{this};
 };
 }  // namespace dns_proxy
@@ -19,6 +19,9 @@ int main(int argc, char* argv[]) {
   DEFINE_int32(
       fd, -1,
       "File descriptor for the proxies to communicate with the controller");
+  DEFINE_int32(resolver_workers, 0,
+               "Number of additional resolver threads of the proxy sharing its "
+               "listening sockets");
   brillo::FlagHelper::Init(argc, argv, "DNS Proxy daemon");
 
   int flags = brillo::kLogToSyslog | brillo::kLogHeader;
@@ -33,7 +36,10 @@ int main(int argc, char* argv[]) {
   }
 
   if (auto t = dns_proxy::Proxy::StringToType(FLAGS_t)) {
-    dns_proxy::Proxy proxy({.type = t.value(), .ifname = FLAGS_i}, FLAGS_fd);
+    dns_proxy::Proxy proxy({.type = t.value(),
+                            .ifname = FLAGS_i,
+                            .num_resolver_workers = FLAGS_resolver_workers},
+                           FLAGS_fd);
     return proxy.Run();
   }
 
@@ -33,6 +33,8 @@ constexpr char kQueryResultsWithRetriesTemplate[] =
 constexpr char kQueryErrorsTemplate[] = "Network.DnsProxy.$1Query.Errors";
 constexpr char kHttpErrors[] = "Network.DnsProxy.DnsOverHttpsQuery.HttpErrors";
 
+constexpr char kQueryCacheResults[] = "Network.DnsProxy.Query.CacheResults";
+
 constexpr char kProbeResultsTemplate[] =
     "Network.DnsProxy.PlainTextProbe.$1.Results";
 constexpr char kProbeErrorsTemplate[] =
@@ -210,6 +212,10 @@ void Metrics::RecordQueryResultWithRetries(Metrics::QueryType type,
   metrics_.SendEnumToUMA(name, result);
 }
 
+void Metrics::RecordCacheResult(Metrics::CacheResult result) {
+  metrics_.SendEnumToUMA(kQueryCacheResults, result);
+}
+
 void Metrics::RecordQueryDuration(const char* stage, int64_t ms, bool success) {
   const char* prefix = !success ? kQueryDurationFailed : "";
   auto name = base::ReplaceStringPlaceholders(kQueryDurationTemplate,
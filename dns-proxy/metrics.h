@@ -136,6 +136,16 @@ class Metrics {
     kMaxValue = kOtherServerError,
   };
 
+  // These values are persisted to logs. Entries should not be renumbered and
+  // numeric values should never be reused.
+  enum class CacheResult {
+    kHit = 0,
+    kMiss = 1,
+    kCoalesced = 2,
+
+    kMaxValue = kCoalesced,
+  };
+
   // Helper class for measuring time elapsed during different stages of the
   // name resolution process. Accumulates stage timings for later use so that
   // logging metrics do not impact the time spans with i/o overhead.
@@ -192,6 +202,7 @@ class Metrics {
   void RecordDnsOverHttpsMode(DnsOverHttpsMode mode);
   void RecordQueryResult(QueryType type, QueryError error, int http_code = -1);
   void RecordQueryResultWithRetries(QueryType type, bool success);
+  void RecordCacheResult(CacheResult result);
   void RecordQueryDuration(const char* stage, int64_t ms, bool success = true);
   void RecordQueryResolveDuration(QueryType type,
                                   int64_t ms,
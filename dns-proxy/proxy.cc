@@ -632,6 +632,9 @@ void Proxy::MaybeCreateResolver() {
   resolver_ =
       NewResolver(kRequestTimeout, kRequestRetryDelay, kRequestMaxRetry);
   doh_config_.set_resolver(resolver_.get());
+  if (opts_.num_resolver_workers > 0) {
+    resolver_->StartWorkers(opts_.num_resolver_workers);
+  }
 
   // Listen on IPv4 and IPv6. Listening on AF_INET explicitly is not needed
   // because net.ipv6.bindv6only sysctl is defaulted to 0 and is not
@@ -45,6 +45,9 @@ class Proxy : public brillo::DBusDaemon {
     // should (always) be tracked. This field is ignored (but should be empty)
     // for the system and default network proxies.
     std::string ifname;
+    // Number of resolver workers running on their own threads in addition to
+    // the main resolver. See Resolver::StartWorkers.
+    int num_resolver_workers = 0;
   };
 
   using Logger = base::RepeatingCallback<void(std::ostream& stream)>;
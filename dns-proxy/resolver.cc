@@ -4,6 +4,7 @@
 
 #include "dns-proxy/resolver.h"
 
+#include <errno.h>
 #include <sys/socket.h>
 
 #include <algorithm>
@@ -11,6 +12,7 @@
 #include <iterator>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <utility>
 
 #include <base/containers/contains.h>
@@ -19,6 +21,7 @@
 #include <base/memory/ref_counted.h>
 #include <base/rand_util.h>
 #include <base/strings/string_util.h>
+#include <base/strings/stringprintf.h>
 #include <base/task/single_thread_task_runner.h>
 #include <chromeos/patchpanel/dns/dns_protocol.h>
 #include <chromeos/patchpanel/dns/dns_query.h>
@@ -174,11 +177,14 @@ Resolver::Resolver(base::RepeatingCallback<void(std::ostream& stream)> logger,
     : logger_(logger),
       always_on_doh_(false),
       doh_enabled_(false),
+      timeout_(timeout),
       retry_delay_(retry_delay),
       max_num_retries_(max_num_retries),
-      metrics_(new Metrics) {
+      metrics_(new Metrics),
+      cache_(std::make_shared<DnsCache>()) {
   ares_client_ = std::make_unique<AresClient>(timeout);
-  curl_client_ = std::make_unique<DoHCurlClient>(timeout);
+  curl_client_ =
+      std::make_unique<DoHCurlClient>(timeout, /*connection_pool=*/true);
 }
 
 Resolver::Resolver(std::unique_ptr<AresClient> ares_client,
@@ -190,9 +196,77 @@ Resolver::Resolver(std::unique_ptr<AresClient> ares_client,
       doh_enabled_(false),
       disable_probe_(disable_probe),
       metrics_(std::move(metrics)),
+      cache_(std::make_shared<DnsCache>()),
       ares_client_(std::move(ares_client)),
       curl_client_(std::move(curl_client)) {}
 
+Resolver::~Resolver() {
+  // Worker resolvers must be destroyed on their threads.
+  for (const auto& worker : workers_) {
+    worker->thread->task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce([](Worker* worker) { worker->resolver.reset(); },
+                       base::Unretained(worker.get())));
+    worker->thread->Stop();
+  }
+}
+
+void Resolver::StartWorkers(int num_workers) {
+  reuse_port_ = true;
+  std::ostringstream name;
+  logger_.Run(name);
+  for (int i = 0; i < num_workers; i++) {
+    auto worker = std::make_unique<Worker>();
+    worker->thread =
+        std::make_unique<base::Thread>(base::StringPrintf("resolver%d", i));
+    if (!worker->thread->StartWithOptions(
+            base::Thread::Options(base::MessagePumpType::IO, 0))) {
+      LOG(ERROR) << *this << " Failed to start resolver worker " << i;
+      return;
+    }
+    worker->thread->task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&Resolver::InitWorker, base::Unretained(worker.get()),
+                       base::StringPrintf("%s[worker%d]", name.str().c_str(),
+                                          i),
+                       timeout_, retry_delay_, max_num_retries_, cache_));
+    workers_.push_back(std::move(worker));
+  }
+  LOG(INFO) << *this << " Started " << workers_.size() << " resolver workers";
+}
+
+// static
+void Resolver::InitWorker(Worker* worker,
+                          const std::string& name,
+                          base::TimeDelta timeout,
+                          base::TimeDelta retry_delay,
+                          int max_num_retries,
+                          std::shared_ptr<DnsCache> cache) {
+  // The logger of the Resolver is not bound to the worker thread, use a fixed
+  // name instead.
+  worker->resolver = std::make_unique<Resolver>(
+      base::BindRepeating(
+          [](const std::string& name, std::ostream& stream) { stream << name; },
+          name),
+      timeout, retry_delay, max_num_retries);
+  worker->resolver->cache_ = std::move(cache);
+  worker->resolver->reuse_port_ = true;
+}
+
+void Resolver::PostToWorkers(base::RepeatingCallback<void(Resolver*)> task) {
+  for (const auto& worker : workers_) {
+    worker->thread->task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(
+                       [](Worker* worker,
+                          base::RepeatingCallback<void(Resolver*)> task) {
+                         if (worker->resolver) {
+                           task.Run(worker->resolver.get());
+                         }
+                       },
+                       base::Unretained(worker.get()), task));
+  }
+}
+
 bool Resolver::ListenTCP(struct sockaddr* addr) {
   auto tcp_src = std::make_unique<patchpanel::Socket>(
       addr->sa_family, SOCK_STREAM | SOCK_NONBLOCK);
@@ -201,6 +275,13 @@ bool Resolver::ListenTCP(struct sockaddr* addr) {
     return false;
   }
 
+  const int on = 1;
+  if (reuse_port_ && setsockopt(tcp_src->fd(), SOL_SOCKET, SO_REUSEPORT, &on,
+                                sizeof(on)) < 0) {
+    PLOG(ERROR) << *this << " Failed to set SO_REUSEPORT on TCP socket";
+    return false;
+  }
+
   socklen_t len =
       addr->sa_family == AF_INET ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
   if (!tcp_src->Bind(addr, len)) {
@@ -220,6 +301,13 @@ bool Resolver::ListenTCP(struct sockaddr* addr) {
                                          weak_factory_.GetWeakPtr()));
   tcp_src_ = std::move(tcp_src);
 
+  struct sockaddr_storage worker_addr = {};
+  memcpy(&worker_addr, addr, len);
+  PostToWorkers(base::BindRepeating(
+      [](struct sockaddr_storage addr, Resolver* resolver) {
+        resolver->ListenTCP(reinterpret_cast<struct sockaddr*>(&addr));
+      },
+      worker_addr));
   return true;
 }
 
@@ -231,6 +319,13 @@ bool Resolver::ListenUDP(struct sockaddr* addr) {
     return false;
   }
 
+  const int on = 1;
+  if (reuse_port_ && setsockopt(udp_src->fd(), SOL_SOCKET, SO_REUSEPORT, &on,
+                                sizeof(on)) < 0) {
+    PLOG(ERROR) << *this << " Failed to set SO_REUSEPORT on UDP socket";
+    return false;
+  }
+
   socklen_t len =
       addr->sa_family == AF_INET ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
   if (!udp_src->Bind(addr, len)) {
@@ -240,11 +335,20 @@ bool Resolver::ListenUDP(struct sockaddr* addr) {
 
   // Start listening.
   LOG(INFO) << *this << " Accepting UDP queries on " << *addr;
+  udp_buf_.resize(kMaxUDPBatchSize * kDNSBufSize);
   udp_src_watcher_ = base::FileDescriptorWatcher::WatchReadable(
       udp_src->fd(),
-      base::BindRepeating(&Resolver::OnDNSQuery, weak_factory_.GetWeakPtr(),
-                          udp_src->fd(), SOCK_DGRAM));
+      base::BindRepeating(&Resolver::OnUDPQueries, weak_factory_.GetWeakPtr(),
+                          udp_src->fd()));
   udp_src_ = std::move(udp_src);
+
+  struct sockaddr_storage worker_addr = {};
+  memcpy(&worker_addr, addr, len);
+  PostToWorkers(base::BindRepeating(
+      [](struct sockaddr_storage addr, Resolver* resolver) {
+        resolver->ListenUDP(reinterpret_cast<struct sockaddr*>(&addr));
+      },
+      worker_addr));
   return true;
 }
 
@@ -308,7 +412,7 @@ void Resolver::HandleAresResult(base::WeakPtr<SocketFd> sock_fd,
 
   if (status == ARES_SUCCESS) {
     ReplyDNS(sock_fd, msg, len);
-    sock_fds_.erase(sock_fd->id);
+    CompleteQuery(sock_fd, msg, len);
     return;
   }
 
@@ -317,7 +421,7 @@ void Resolver::HandleAresResult(base::WeakPtr<SocketFd> sock_fd,
   if (sock_fd->num_retries++ >= max_num_retries_) {
     LOG(ERROR) << *this
                << " Failed to do ares lookup: " << ares_strerror(status);
-    sock_fds_.erase(sock_fd->id);
+    CompleteQuery(sock_fd);
     return;
   }
 
@@ -365,7 +469,7 @@ void Resolver::HandleCurlResult(base::WeakPtr<SocketFd> sock_fd,
                << curl_easy_strerror(res.curl_code);
     if (always_on_doh_) {
       // TODO(jasongustaman): Send failure reply with RCODE.
-      sock_fds_.erase(sock_fd->id);
+      CompleteQuery(sock_fd);
       return;
     }
     base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
@@ -378,14 +482,14 @@ void Resolver::HandleCurlResult(base::WeakPtr<SocketFd> sock_fd,
   switch (res.http_code) {
     case kHTTPOk: {
       ReplyDNS(sock_fd, msg, len);
-      sock_fds_.erase(sock_fd->id);
+      CompleteQuery(sock_fd, msg, len);
       return;
     }
     case kHTTPTooManyRequests: {
       if (sock_fd->num_retries >= max_num_retries_) {
         LOG(ERROR) << *this << " Failed to resolve hostname, retried "
                    << max_num_retries_ << " tries";
-        sock_fds_.erase(sock_fd->id);
+        CompleteQuery(sock_fd);
         return;
       }
 
@@ -407,7 +511,7 @@ void Resolver::HandleCurlResult(base::WeakPtr<SocketFd> sock_fd,
                  << res.http_code;
       if (always_on_doh_) {
         // TODO(jasongustaman): Send failure reply with RCODE.
-        sock_fds_.erase(sock_fd->id);
+        CompleteQuery(sock_fd);
         return;
       }
       base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
@@ -535,7 +639,13 @@ void Resolver::ReplyDNS(base::WeakPtr<SocketFd> sock_fd,
 }
 
 void Resolver::SetNameServers(const std::vector<std::string>& name_servers) {
+  cache_->Clear();
   SetServers(name_servers, /*doh=*/false);
+  PostToWorkers(base::BindRepeating(
+      [](const std::vector<std::string>& name_servers, Resolver* resolver) {
+        resolver->SetNameServers(name_servers);
+      },
+      name_servers));
 }
 
 void Resolver::SetDoHProviders(const std::vector<std::string>& doh_providers,
@@ -543,7 +653,14 @@ void Resolver::SetDoHProviders(const std::vector<std::string>& doh_providers,
   always_on_doh_ = always_on_doh;
   doh_enabled_ = !doh_providers.empty();
 
+  cache_->Clear();
   SetServers(doh_providers, /*doh=*/true);
+  PostToWorkers(base::BindRepeating(
+      [](const std::vector<std::string>& doh_providers, bool always_on_doh,
+         Resolver* resolver) {
+        resolver->SetDoHProviders(doh_providers, always_on_doh);
+      },
+      doh_providers, always_on_doh));
 }
 
 void Resolver::SetServers(const std::vector<std::string>& new_servers,
@@ -561,6 +678,13 @@ void Resolver::SetServers(const std::vector<std::string>& new_servers,
       ++it;
       continue;
     }
+    if (doh) {
+      if (const auto* histogram =
+              curl_client_->GetLatencyHistogram(it->first)) {
+        LOG(INFO) << *this << " Removing DoH provider " << it->first << ": "
+                  << *histogram;
+      }
+    }
     it = servers.erase(it);
     servers_equal = false;
   }
@@ -650,9 +774,129 @@ void Resolver::OnDNSQuery(int fd, int type) {
     sock_fd->len -= 2;
   }
 
+  HandleQuery(std::move(sock_fd));
+}
+
+void Resolver::OnUDPQueries(int fd) {
+  struct mmsghdr msgs[kMaxUDPBatchSize] = {};
+  struct iovec iovs[kMaxUDPBatchSize];
+  struct sockaddr_storage srcs[kMaxUDPBatchSize];
+  for (int i = 0; i < kMaxUDPBatchSize; i++) {
+    iovs[i].iov_base = &udp_buf_[i * kDNSBufSize];
+    iovs[i].iov_len = kDNSBufSize;
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = &srcs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(srcs[i]);
+  }
+
+  const int n = recvmmsg(fd, msgs, kMaxUDPBatchSize, MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      PLOG(WARNING) << *this << " recvmmsg failed";
+    }
+    return;
+  }
+
+  for (int i = 0; i < n; i++) {
+    if (msgs[i].msg_len == 0) {
+      continue;
+    }
+    auto sock_fd = std::make_unique<SocketFd>(SOCK_DGRAM, fd);
+    // Metrics will be recorded automatically when this object is deleted.
+    sock_fd->timer.set_metrics(metrics_.get());
+    sock_fd->timer.StartReceive();
+    sock_fd->msg = sock_fd->buf;
+    sock_fd->len = msgs[i].msg_len;
+    memcpy(sock_fd->buf, iovs[i].iov_base, msgs[i].msg_len);
+    memcpy(&sock_fd->src, &srcs[i], sizeof(srcs[i]));
+    sock_fd->socklen = msgs[i].msg_hdr.msg_namelen;
+    sock_fd->timer.StopReceive(true);
+    HandleQuery(std::move(sock_fd));
+  }
+}
+
+void Resolver::HandleQuery(std::unique_ptr<SocketFd> sock_fd) {
+  sock_fd->cache_key =
+      DnsCache::GetKey(sock_fd->msg, static_cast<size_t>(sock_fd->len));
+
   const auto& sock_fd_it =
       sock_fds_.emplace(sock_fd->id, std::move(sock_fd)).first;
-  Resolve(sock_fd_it->second->weak_factory.GetWeakPtr());
+  base::WeakPtr<SocketFd> weak_sock_fd =
+      sock_fd_it->second->weak_factory.GetWeakPtr();
+  if (weak_sock_fd->cache_key && ResolveFromCache(weak_sock_fd)) {
+    return;
+  }
+  Resolve(weak_sock_fd);
+}
+
+bool Resolver::ResolveFromCache(base::WeakPtr<SocketFd> sock_fd) {
+  const DnsCache::Key& key = *sock_fd->cache_key;
+  std::optional<std::string> response = cache_->Get(key, sock_fd->msg);
+  if (response) {
+    if (metrics_)
+      metrics_->RecordCacheResult(Metrics::CacheResult::kHit);
+    ReplyDNS(sock_fd, reinterpret_cast<unsigned char*>(response->data()),
+             response->size());
+    sock_fds_.erase(sock_fd->id);
+    return true;
+  }
+
+  // Wait for the result of an identical query instead of sending the query
+  // again.
+  const auto it = in_flight_queries_.find(key);
+  if (it != in_flight_queries_.end()) {
+    if (metrics_)
+      metrics_->RecordCacheResult(Metrics::CacheResult::kCoalesced);
+    it->second.waiters.push_back(sock_fd);
+    return true;
+  }
+
+  if (metrics_)
+    metrics_->RecordCacheResult(Metrics::CacheResult::kMiss);
+  in_flight_queries_.emplace(key, InFlightQuery{sock_fd->id, {}});
+  return false;
+}
+
+void Resolver::CompleteQuery(base::WeakPtr<SocketFd> sock_fd,
+                             const unsigned char* msg,
+                             size_t len) {
+  if (!sock_fd->cache_key) {
+    sock_fds_.erase(sock_fd->id);
+    return;
+  }
+
+  const DnsCache::Key key = *sock_fd->cache_key;
+  std::vector<base::WeakPtr<SocketFd>> waiters;
+  const auto it = in_flight_queries_.find(key);
+  if (it != in_flight_queries_.end() && it->second.leader_id == sock_fd->id) {
+    waiters = std::move(it->second.waiters);
+    in_flight_queries_.erase(it);
+  }
+  if (msg) {
+    cache_->Put(key, msg, len);
+  }
+  sock_fds_.erase(sock_fd->id);
+
+  for (const auto& waiter : waiters) {
+    if (!waiter) {
+      continue;
+    }
+    if (msg) {
+      std::string response(reinterpret_cast<const char*>(msg), len);
+      if (DnsCache::MatchQuery(key, waiter->msg, &response)) {
+        ReplyDNS(waiter, reinterpret_cast<unsigned char*>(response.data()),
+                 response.size());
+        sock_fds_.erase(waiter->id);
+        continue;
+      }
+    }
+    // The query failed, resolve the waiting query by itself.
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&Resolver::Resolve,
+                                  weak_factory_.GetWeakPtr(), waiter,
+                                  false /* fallback */));
+  }
 }
 
 bool Resolver::ResolveDNS(base::WeakPtr<SocketFd> sock_fd, bool doh) {
@@ -834,7 +1078,7 @@ void Resolver::Resolve(base::WeakPtr<SocketFd> sock_fd, bool fallback) {
            response.io_buffer_size());
 
   // Query is completed, remove SocketFd.
-  sock_fds_.erase(sock_fd->id);
+  CompleteQuery(sock_fd);
 }
 
 patchpanel::DnsResponse Resolver::ConstructServFailResponse(const char* msg,
@@ -10,17 +10,20 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include <base/files/file_descriptor_watcher_posix.h>
 #include <base/functional/callback.h>
 #include <base/memory/weak_ptr.h>
+#include <base/threading/thread.h>
 #include <base/time/time.h>
 #include <chromeos/patchpanel/dns/dns_response.h>
 #include <chromeos/patchpanel/socket.h>
 
 #include "dns-proxy/ares_client.h"
+#include "dns-proxy/dns_cache.h"
 #include "dns-proxy/doh_curl_client.h"
 #include "dns-proxy/metrics.h"
 
@@ -30,6 +33,9 @@ namespace dns_proxy {
 // size of a TCP packet.
 constexpr uint32_t kDNSBufSize = 65536;
 
+// |kMaxUDPBatchSize| is the maximum number of UDP queries read at once.
+constexpr int kMaxUDPBatchSize = 8;
+
 // Resolver receives wire-format DNS queries and proxies them to DNS server(s).
 // This class supports standard plain-text resolving using c-ares and secure
 // DNS / DNS-over-HTTPS (DoH) using CURL.
@@ -43,6 +49,11 @@ constexpr uint32_t kDNSBufSize = 65536;
 // to standard plain-text DNS.
 //
 // Resolver listens on UDP and TCP port 53.
+//
+// Optionally, Resolver runs additional resolvers on worker threads. Workers
+// listen on the same addresses through SO_REUSEPORT such that the kernel
+// spreads the queries across them, follow the name servers and DoH providers
+// of the Resolver and share its answer cache.
 class Resolver {
  public:
   // |SocketFd| stores client's socket data.
@@ -83,6 +94,10 @@ class Resolver {
     // can be used for multiple SocketFds.
     const int id;
 
+    // Key of the query in the answer cache. Empty if the query is not
+    // cacheable.
+    std::optional<DnsCache::Key> cache_key;
+
     // Records timings for metrics.
     Metrics::QueryTimer timer;
     base::WeakPtrFactory<SocketFd> weak_factory{this};
@@ -124,7 +139,11 @@ class Resolver {
            std::unique_ptr<DoHCurlClientInterface> curl_client,
            bool disable_probe = true,
            std::unique_ptr<Metrics> metrics = nullptr);
-  virtual ~Resolver() = default;
+  virtual ~Resolver();
+
+  // Start |num_workers| resolver workers on their own threads. This must be
+  // called before ListenTCP and ListenUDP.
+  void StartWorkers(int num_workers);
 
   // Listen on an incoming DNS query on address |addr| for UDP and TCP.
   // Listening on default DNS port (53) requires CAP_NET_BIND_SERVICE.
@@ -214,6 +233,21 @@ class Resolver {
     std::unique_ptr<base::FileDescriptorWatcher::Controller> watcher;
   };
 
+  // |Worker| is a resolver running on its own thread. |resolver| is only
+  // accessed on |thread|.
+  struct Worker {
+    std::unique_ptr<base::Thread> thread;
+    std::unique_ptr<Resolver> resolver;
+  };
+
+  // |InFlightQuery| tracks the queries waiting for the result of an identical
+  // query being resolved. |leader_id| is the ID of the SocketFd of the query
+  // being resolved.
+  struct InFlightQuery {
+    int leader_id;
+    std::vector<base::WeakPtr<SocketFd>> waiters;
+  };
+
   // Callback to handle newly opened connections on TCP sockets.
   void OnTCPConnection();
 
@@ -221,6 +255,26 @@ class Resolver {
   // or SOCK STREAM, for UDP and TCP respectively.
   void OnDNSQuery(int fd, int type);
 
+  // Handle a batch of up to |kMaxUDPBatchSize| DNS queries from UDP clients
+  // on |fd|.
+  void OnUDPQueries(int fd);
+
+  // Resolve the query received in |sock_fd|.
+  void HandleQuery(std::unique_ptr<SocketFd> sock_fd);
+
+  // Reply to the query of |sock_fd| using the answer cache or wait for the
+  // result of an identical query in flight. Returns false if the query needs
+  // to be resolved. Otherwise, |sock_fd| is handled.
+  bool ResolveFromCache(base::WeakPtr<SocketFd> sock_fd);
+
+  // Remove |sock_fd| once its query is completed. |msg| of length |len| is the
+  // response sent to the client, or nullptr if the query failed. The response
+  // is cached and sent to the queries waiting for |sock_fd|. Upon failure, the
+  // waiting queries are resolved separately.
+  void CompleteQuery(base::WeakPtr<SocketFd> sock_fd,
+                     const unsigned char* msg = nullptr,
+                     size_t len = 0);
+
   // Send back data taken from CURL or Ares to the client.
   void ReplyDNS(base::WeakPtr<SocketFd> sock_fd,
                 unsigned char* msg,
@@ -252,6 +306,17 @@ class Resolver {
   // is no longer interesting.
   void Probe(base::WeakPtr<ProbeState> probe_state);
 
+  // Run |task| on the resolvers of the workers.
+  void PostToWorkers(base::RepeatingCallback<void(Resolver*)> task);
+
+  // Create the resolver of |worker| on its thread.
+  static void InitWorker(Worker* worker,
+                         const std::string& name,
+                         base::TimeDelta timeout,
+                         base::TimeDelta retry_delay,
+                         int max_num_retries,
+                         std::shared_ptr<DnsCache> cache);
+
   // A logging name for this Resolver to distinguish its logs from lots of other
   // Resolvers owner by other Proxy instances.
   base::RepeatingCallback<void(std::ostream& stream)> logger_;
@@ -273,6 +338,15 @@ class Resolver {
   std::unique_ptr<patchpanel::Socket> udp_src_;
   std::unique_ptr<base::FileDescriptorWatcher::Controller> udp_src_watcher_;
 
+  // Buffers of |kMaxUDPBatchSize| UDP queries of size |kDNSBufSize|.
+  std::vector<char> udp_buf_;
+
+  // Set SO_REUSEPORT on the listening sockets to share them with workers.
+  bool reuse_port_ = false;
+
+  // Resolvers running on worker threads.
+  std::vector<std::unique_ptr<Worker>> workers_;
+
   // Name servers and DoH providers validated through probes.
   std::vector<std::string> validated_name_servers_;
   std::vector<std::string> validated_doh_providers_;
@@ -285,6 +359,9 @@ class Resolver {
   // Provided for testing only. Boolean to disable probe.
   bool disable_probe_ = false;
 
+  // Timeout of the queries.
+  base::TimeDelta timeout_;
+
   // Delay before retrying a failing query.
   base::TimeDelta retry_delay_;
 
@@ -297,6 +374,14 @@ class Resolver {
   // Map of SocketFds keyed by its SocketFd ID.
   std::map<int, std::unique_ptr<SocketFd>> sock_fds_;
 
+  // Answers of successful queries, flushed when the name servers or the DoH
+  // providers are set. Shared with the workers.
+  std::shared_ptr<DnsCache> cache_;
+
+  // Queries being resolved keyed by their cache key alongside the identical
+  // queries waiting for their result.
+  std::map<DnsCache::Key, InFlightQuery> in_flight_queries_;
+
   // Ares client to resolve DNS through standard plain-text DNS.
   std::unique_ptr<AresClient> ares_client_;
 
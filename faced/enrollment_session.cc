@@ -12,7 +12,9 @@
 #include <absl/status/status.h>
 #include <base/functional/bind.h>
 #include <base/location.h>
+#include <base/logging.h>
 #include <base/task/sequenced_task_runner.h>
+#include <base/time/time.h>
 
 #include "faced/common/face_status.h"
 #include "faced/util/task.h"
@@ -176,11 +178,22 @@ void EnrollmentSession::ProcessAvailableFrame(ProcessFrameCallback callback,
     return;
   }
 
+  // If newer frames are already queued behind this one, the camera is ahead of
+  // us and this frame is stale: skip to the newest frame, so that the user's
+  // current pose is processed rather than where they were several frames ago.
+  if (frame.expedite) {
+    stream_reader_->Read(
+        base::BindOnce(&EnrollmentSession::ProcessAvailableFrame,
+                       base::Unretained(this), std::move(callback)));
+    return;
+  }
+
   // Convert input frame to CameraFrame for request.
   ProcessFrameForEnrollmentRequest request;
   std::unique_ptr<Frame> frame_ptr = std::move(*frame.value.value());
   *request.mutable_frame() = FrameToCameraFrame(std::move(frame_ptr));
 
+  process_frame_start_time_ = base::TimeTicks::Now();
   (*rpc_client_)
       ->CallRpc(
           &faceauth::eora::FaceService::Stub::AsyncProcessFrameForEnrollment,
@@ -190,6 +203,11 @@ void EnrollmentSession::ProcessAvailableFrame(ProcessFrameCallback callback,
 void EnrollmentSession::CompleteProcessFrame(
     grpc::Status status,
     std::unique_ptr<ProcessFrameForEnrollmentResponse> response) {
+  VLOG(1) << "Processed enrollment frame in "
+          << (base::TimeTicks::Now() - process_frame_start_time_)
+                 .InMilliseconds()
+          << " ms";
+
   if (!status.ok()) {
     NotifyError(absl::UnavailableError(status.error_message()));
     return;
@@ -12,6 +12,7 @@
 #include <absl/status/status.h>
 #include <absl/status/statusor.h>
 #include <base/functional/callback_forward.h>
+#include <base/time/time.h>
 #include <brillo/grpc/async_grpc_client.h>
 #include <mojo/public/cpp/bindings/receiver.h>
 #include <mojo/public/cpp/bindings/remote.h>
@@ -136,6 +137,9 @@ class EnrollmentSession
   Lease<brillo::AsyncGrpcClient<faceauth::eora::FaceService>> rpc_client_;
 
   std::unique_ptr<StreamReader<InputFrame>> stream_reader_;
+
+  // When the frame being processed was sent to the face service.
+  base::TimeTicks process_frame_start_time_;
 };
 
 }  // namespace faced
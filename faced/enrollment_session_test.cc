@@ -104,6 +104,60 @@ TEST(TestEnrollmentSession, TestSessionComplete) {
   // was called.
 }
 
+TEST(TestEnrollmentSession, TestSessionSkipsStaleFrames) {
+  StrictMock<MockFaceEnrollmentSessionDelegate> mock_delegate;
+  EXPECT_CALL(mock_delegate, OnEnrollmentComplete(_)).Times(1);
+
+  FACE_ASSERT_OK_AND_ASSIGN(std::unique_ptr<FakeFaceServiceManager> service_mgr,
+                            FakeFaceServiceManager::Create());
+  EXPECT_CALL(*(service_mgr->mock_service()), StartEnrollment)
+      .WillOnce(GrpcReplyOk(StartEnrollmentSuccessResponse()));
+  // Only the newest of the queued frames is processed.
+  EXPECT_CALL(*(service_mgr->mock_service()), ProcessFrameForEnrollment)
+      .WillOnce(Invoke([](auto request, auto&& callback) {
+        EXPECT_EQ(request->frame().width(), 3u);
+        GrpcReplyOk(EnrollmentCompleteResponse())(std::move(request),
+                                                  std::move(callback));
+      }));
+  EXPECT_CALL(*(service_mgr->mock_service()), CompleteEnrollment)
+      .WillOnce(GrpcReplyOk(CompleteEnrollmentSuccessResponse(TestUserData())));
+
+  FACE_ASSERT_OK_AND_ASSIGN(
+      Lease<brillo::AsyncGrpcClient<faceauth::eora::FaceService>> client,
+      service_mgr->LeaseClient());
+
+  // Create an enrollment session.
+  mojo::Receiver<FaceEnrollmentSessionDelegate> delegate(&mock_delegate);
+  mojo::Remote<FaceEnrollmentSession> session_remote;
+  QueueingStream<EnrollmentSession::InputFrame> stream(/*max_queue_size=*/3);
+  FACE_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<EnrollmentSession> session,
+      EnrollmentSession::Create(
+          bitgen, session_remote.BindNewPipeAndPassReceiver(),
+          delegate.BindNewPipeAndPassRemote(),
+          EnrollmentSessionConfig::New(SampleUserHash(),
+                                       /*accessibility=*/false),
+          std::move(client), stream.GetReader()));
+
+  // Set up a loop to run until the client disconnects.
+  base::RunLoop run_loop;
+
+  // Queue up frames, told apart by their width.
+  for (int width = 1; width <= 3; ++width) {
+    auto frame = std::make_unique<Frame>();
+    frame->width = width;
+    stream.Write(std::move(frame));
+  }
+
+  // Start the session and run the loop until the service is disconnected.
+  session->Start(base::BindLambdaForTesting([]() {}),
+                 base::BindLambdaForTesting([&](absl::Status status) {
+                   EXPECT_TRUE(status.ok());
+                   run_loop.Quit();
+                 }));
+  run_loop.Run();
+}
+
 TEST(TestEnrollmentSession, TestStartSessionError) {
   // Create a mock session delegate, that expects no events to be triggered.
   StrictMock<MockFaceEnrollmentSessionDelegate> mock_delegate;
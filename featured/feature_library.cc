@@ -14,6 +14,7 @@
 #include <base/strings/escape.h>
 #include <base/strings/strcat.h>
 #include <base/synchronization/lock.h>
+#include <base/task/sequenced_task_runner.h>
 #include <brillo/dbus/dbus_connection.h>
 #include <brillo/dbus/dbus_method_invoker.h>
 #include <brillo/dbus/dbus_proxy_util.h>
@@ -96,6 +97,12 @@ void PlatformFeatures::IsEnabled(const VariationsFeature& feature,
                                  IsEnabledCallback callback) {
   DCHECK(CheckFeatureIdentity(feature)) << feature.name;
 
+  if (std::optional<bool> cached = GetCachedIsEnabled(feature)) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), *cached));
+    return;
+  }
+
   chrome_proxy_->WaitForServiceToBeAvailable(base::BindOnce(
       &PlatformFeatures::OnWaitForServiceIsEnabled,
       weak_ptr_factory_.GetWeakPtr(), feature, std::move(callback)));
@@ -105,6 +112,11 @@ bool PlatformFeatures::IsEnabledBlockingWithTimeout(
     const VariationsFeature& feature, int timeout_ms) {
   DCHECK(CheckFeatureIdentity(feature)) << feature.name;
 
+  if (std::optional<bool> cached = GetCachedIsEnabled(feature)) {
+    return *cached;
+  }
+
+  const uint64_t cache_generation = GetIsEnabledCacheGeneration();
   dbus::MethodCall call(chromeos::kChromeFeaturesServiceInterface,
                         chromeos::kChromeFeaturesServiceIsFeatureEnabledMethod);
   dbus::MessageWriter writer(&call);
@@ -122,6 +134,7 @@ bool PlatformFeatures::IsEnabledBlockingWithTimeout(
     return feature.default_state == FEATURE_ENABLED_BY_DEFAULT;
   }
 
+  CacheIsEnabled(feature, feature_enabled, cache_generation);
   return feature_enabled;
 }
 
@@ -143,11 +156,12 @@ void PlatformFeatures::OnWaitForServiceIsEnabled(
       &call, dbus::ObjectProxy::TIMEOUT_USE_DEFAULT,
       base::BindOnce(&PlatformFeatures::HandleIsEnabledResponse,
                      weak_ptr_factory_.GetWeakPtr(), feature,
-                     std::move(callback)));
+                     std::move(callback), GetIsEnabledCacheGeneration()));
 }
 
 void PlatformFeatures::HandleIsEnabledResponse(const VariationsFeature& feature,
                                                IsEnabledCallback callback,
+                                               uint64_t cache_generation,
                                                dbus::Response* response) {
   if (!response) {
     LOG(ERROR) << "dbus call failed; using default value";
@@ -165,6 +179,7 @@ void PlatformFeatures::HandleIsEnabledResponse(const VariationsFeature& feature,
     return;
   }
 
+  CacheIsEnabled(feature, feature_enabled, cache_generation);
   std::move(callback).Run(feature_enabled);
 }
 
@@ -363,6 +378,67 @@ void PlatformFeatures::ListenForRefetchNeeded(
                      std::move(attached_callback)));
 }
 
+void PlatformFeatures::EnableIsEnabledCache(
+    base::OnceCallback<void(bool)> attached_callback) {
+  feature_proxy_->ConnectToSignal(
+      kFeatureLibInterface, kRefetchSignal,
+      base::BindRepeating(&PlatformFeatures::OnRefetchNeeded,
+                          weak_ptr_factory_.GetWeakPtr()),
+      base::BindOnce(&PlatformFeatures::OnIsEnabledCacheConnected,
+                     weak_ptr_factory_.GetWeakPtr(),
+                     std::move(attached_callback)));
+}
+
+std::optional<bool> PlatformFeatures::GetCachedIsEnabled(
+    const VariationsFeature& feature) {
+  base::AutoLock auto_lock(lock_);
+  if (!is_enabled_cache_active_) {
+    return std::nullopt;
+  }
+  auto it = is_enabled_cache_.find(feature.name);
+  if (it == is_enabled_cache_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+uint64_t PlatformFeatures::GetIsEnabledCacheGeneration() {
+  base::AutoLock auto_lock(lock_);
+  return is_enabled_cache_generation_;
+}
+
+void PlatformFeatures::CacheIsEnabled(const VariationsFeature& feature,
+                                      bool enabled,
+                                      uint64_t cache_generation) {
+  base::AutoLock auto_lock(lock_);
+  // A refetch signal received while the lookup was in flight means chrome
+  // restarted, so |enabled| may already be stale.
+  if (!is_enabled_cache_active_ ||
+      cache_generation != is_enabled_cache_generation_) {
+    return;
+  }
+  is_enabled_cache_[feature.name] = enabled;
+}
+
+void PlatformFeatures::OnRefetchNeeded(dbus::Signal* signal) {
+  base::AutoLock auto_lock(lock_);
+  is_enabled_cache_generation_++;
+  is_enabled_cache_.clear();
+}
+
+void PlatformFeatures::OnIsEnabledCacheConnected(
+    base::OnceCallback<void(bool)> attached_callback,
+    const std::string& interface,
+    const std::string& signal,
+    bool success) {
+  if (success) {
+    base::AutoLock auto_lock(lock_);
+    is_enabled_cache_active_ = true;
+  }
+  OnConnectedCallback(std::move(attached_callback), interface, signal,
+                      success);
+}
+
 // static
 void PlatformFeatures::OnConnectedCallback(
     base::OnceCallback<void(bool)> attached_callback,
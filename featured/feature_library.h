@@ -9,6 +9,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -200,6 +201,14 @@ class FEATURE_EXPORT PlatformFeatures : public PlatformFeaturesInterface {
       base::RepeatingCallback<void(void)> signal_callback,
       base::OnceCallback<void(bool)> attached_callback) override;
 
+  // Opts into caching the results of IsEnabled{,Blocking{,WithTimeout}}()
+  // until featured signals that feature state must be refetched, i.e. until
+  // chrome restarts. This lets processes that check features on hot paths
+  // skip the D-Bus round trip to chrome for every check. The cache is only used
+  // once the signal handler is attached; |attached_callback| is run with
+  // whether that succeeded.
+  void EnableIsEnabledCache(base::OnceCallback<void(bool)> attached_callback);
+
   static void ShutdownForTesting();
 
  private:
@@ -229,10 +238,38 @@ class FEATURE_EXPORT PlatformFeatures : public PlatformFeaturesInterface {
                                  bool available);
 
   // Callback that is invoked when chrome_proxy_->CallMethod() finishes.
+  // |cache_generation| is the cache generation when the call was made.
   void HandleIsEnabledResponse(const VariationsFeature& feature,
                                IsEnabledCallback callback,
+                               uint64_t cache_generation,
                                dbus::Response* response);
 
+  // Returns the cached state of |feature|, if the cache is in use and holds
+  // it.
+  std::optional<bool> GetCachedIsEnabled(const VariationsFeature& feature)
+      LOCKS_EXCLUDED(lock_);
+
+  // Returns the current generation of the IsEnabled() cache, to be passed to
+  // CacheIsEnabled() once the lookup finishes.
+  uint64_t GetIsEnabledCacheGeneration() LOCKS_EXCLUDED(lock_);
+
+  // Caches the state of |feature| looked up from chrome, unless the cache was
+  // invalidated since |cache_generation|.
+  void CacheIsEnabled(const VariationsFeature& feature,
+                      bool enabled,
+                      uint64_t cache_generation) LOCKS_EXCLUDED(lock_);
+
+  // Drops the cached IsEnabled() results when feature state must be refetched.
+  void OnRefetchNeeded(dbus::Signal* signal) LOCKS_EXCLUDED(lock_);
+
+  // Callback that is invoked when EnableIsEnabledCache() finishes connecting
+  // to the refetch signal.
+  void OnIsEnabledCacheConnected(
+      base::OnceCallback<void(bool)> attached_callback,
+      const std::string& interface,
+      const std::string& signal,
+      bool success);
+
   // Creates the default response for GetParamsAndEnabled{,Blocking}()
   ParamsResult CreateDefaultGetParamsAndEnabledResponse(
       const std::vector<const VariationsFeature*>& features);
@@ -311,6 +348,13 @@ class FEATURE_EXPORT PlatformFeatures : public PlatformFeaturesInterface {
   std::map<std::string, const VariationsFeature*> feature_identity_tracker_
       GUARDED_BY(lock_);
 
+  // Results of IsEnabled() lookups, keyed by feature name. Only used once
+  // EnableIsEnabledCache() has attached to the refetch signal, and cleared
+  // (bumping the generation) every time that signal is received.
+  bool is_enabled_cache_active_ GUARDED_BY(lock_) = false;
+  uint64_t is_enabled_cache_generation_ GUARDED_BY(lock_) = 0;
+  std::map<std::string, bool> is_enabled_cache_ GUARDED_BY(lock_);
+
   // Directory where active trial files are written.
   base::FilePath active_trial_file_dir_;
 
@@ -917,6 +917,45 @@ TEST_F(FeatureLibraryTest, RegisterSignalHandler_Failure) {
   EXPECT_FALSE(result);
 }
 
+// Test that once the cache is enabled, IsEnabledBlocking() only queries chrome
+// again after a refetch signal.
+TEST_F(FeatureLibraryTest, IsEnabledCache) {
+  dbus::ObjectProxy::SignalCallback refetch_cb;
+  EXPECT_CALL(*mock_feature_proxy_,
+              DoConnectToSignal(kFeatureLibInterface, kRefetchSignal, _, _))
+      .WillOnce([&refetch_cb](
+                    const std::string& interface, const std::string& signal,
+                    dbus::ObjectProxy::SignalCallback signal_cb,
+                    dbus::ObjectProxy::OnConnectedCallback* on_connected) {
+        refetch_cb = signal_cb;
+        std::move(*on_connected).Run(interface, signal, true);
+      });
+  bool result = false;
+  features_->EnableIsEnabledCache(
+      base::BindLambdaForTesting(
+          [&result](bool success) { result = success; }));
+  EXPECT_TRUE(result);
+
+  EXPECT_CALL(
+      *mock_chrome_proxy_,
+      CallMethodAndBlockDeprecated(_, dbus::ObjectProxy::TIMEOUT_USE_DEFAULT))
+      .WillOnce(Invoke([this](dbus::MethodCall* call, int timeout_ms) {
+        return CreateIsEnabledResponse(call, true);
+      }))
+      .WillOnce(Invoke([this](dbus::MethodCall* call, int timeout_ms) {
+        return CreateIsEnabledResponse(call, false);
+      }));
+
+  VariationsFeature f{"Feature", FEATURE_DISABLED_BY_DEFAULT};
+  EXPECT_TRUE(features_->IsEnabledBlocking(f));
+  EXPECT_TRUE(features_->IsEnabledBlocking(f));
+
+  dbus::Signal signal(kFeatureLibInterface, kRefetchSignal);
+  refetch_cb.Run(&signal);
+  EXPECT_FALSE(features_->IsEnabledBlocking(f));
+  EXPECT_FALSE(features_->IsEnabledBlocking(f));
+}
+
 // Test that an active trial file is written.
 TEST_F(FeatureLibraryTest, RecordSingleActiveTrial) {
   featured::FeatureOverride trial;
@@ -0,0 +1,79 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "federated/cpu_load_training_condition.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <base/check_op.h>
+#include <base/files/file_util.h>
+#include <base/logging.h>
+#include <base/strings/string_number_conversions.h>
+#include <base/strings/string_split.h>
+#include <base/strings/string_util.h>
+#include <base/system/sys_info.h>
+
+namespace federated {
+namespace {
+
+constexpr char kLoadAvgPath[] = "/proc/loadavg";
+// "<1min> <5min> <15min> <runnable>/<total> <last pid>" is well below this.
+constexpr size_t kMaxLoadAvgSize = 128;
+
+// Training is allowed while the 1-minute load average per CPU is below this,
+// i.e. while at least half of the CPUs are idle on average.
+constexpr double kMaxLoadPerCpu = 0.5;
+// During training, the training itself keeps about one task runnable. That
+// much of the load is discounted so that training doesn't abort itself on
+// devices with few CPUs.
+constexpr double kTrainingLoad = 1.0;
+
+}  // namespace
+
+CpuLoadTrainingCondition::CpuLoadTrainingCondition()
+    : CpuLoadTrainingCondition(base::FilePath(kLoadAvgPath),
+                               base::SysInfo::NumberOfProcessors()) {}
+
+CpuLoadTrainingCondition::CpuLoadTrainingCondition(
+    const base::FilePath& loadavg_path, const int num_cpus)
+    : loadavg_path_(loadavg_path), num_cpus_(num_cpus) {
+  DCHECK_GT(num_cpus_, 0);
+}
+
+bool CpuLoadTrainingCondition::IsTrainingConditionSatisfied() const {
+  return IsLoadLowEnough(/*discounted_load=*/0.0);
+}
+
+bool CpuLoadTrainingCondition::IsTrainingConditionSatisfiedDuringTraining()
+    const {
+  return IsLoadLowEnough(kTrainingLoad);
+}
+
+bool CpuLoadTrainingCondition::IsLoadLowEnough(
+    const double discounted_load) const {
+  std::string contents;
+  if (!base::ReadFileToStringWithMaxSize(loadavg_path_, &contents,
+                                         kMaxLoadAvgSize)) {
+    LOG(ERROR) << "Failed to read " << loadavg_path_.value();
+    return false;
+  }
+
+  const std::vector<std::string_view> fields = base::SplitStringPiece(
+      contents, base::kWhitespaceASCII, base::TRIM_WHITESPACE,
+      base::SPLIT_WANT_NONEMPTY);
+  double load = 0;
+  if (fields.empty() || !base::StringToDouble(fields[0], &load)) {
+    LOG(ERROR) << "Failed to parse load average: " << contents;
+    return false;
+  }
+
+  const double load_per_cpu = std::max(load - discounted_load, 0.0) / num_cpus_;
+  DVLOG(1) << "CpuLoadTrainingCondition: load per cpu = " << load_per_cpu;
+  return load_per_cpu < kMaxLoadPerCpu;
+}
+
+}  // namespace federated
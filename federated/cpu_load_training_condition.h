@@ -0,0 +1,43 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FEDERATED_CPU_LOAD_TRAINING_CONDITION_H_
+#define FEDERATED_CPU_LOAD_TRAINING_CONDITION_H_
+
+#include <base/files/file_path.h>
+
+#include "federated/training_condition.h"
+
+namespace federated {
+
+// Answers whether the CPUs are idle enough for a federated computation task,
+// based on the 1-minute load average per CPU. This keeps training off the CPUs
+// while the user is busy with them, and stops it when the load goes up.
+class CpuLoadTrainingCondition : public TrainingCondition {
+ public:
+  CpuLoadTrainingCondition();
+  // Reads the load average from `loadavg_path` instead of /proc/loadavg, and
+  // normalizes it by `num_cpus`. For testing.
+  CpuLoadTrainingCondition(const base::FilePath& loadavg_path, int num_cpus);
+  CpuLoadTrainingCondition(const CpuLoadTrainingCondition&) = delete;
+  CpuLoadTrainingCondition& operator=(const CpuLoadTrainingCondition&) = delete;
+  ~CpuLoadTrainingCondition() override = default;
+
+  // TrainingCondition:
+  [[nodiscard]] bool IsTrainingConditionSatisfied() const override;
+  [[nodiscard]] bool IsTrainingConditionSatisfiedDuringTraining()
+      const override;
+
+ private:
+  // Returns whether the load per CPU, not counting `discounted_load`, is low
+  // enough for training.
+  bool IsLoadLowEnough(double discounted_load) const;
+
+  const base::FilePath loadavg_path_;
+  const int num_cpus_;
+};
+
+}  // namespace federated
+
+#endif  // FEDERATED_CPU_LOAD_TRAINING_CONDITION_H_
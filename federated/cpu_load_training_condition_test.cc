@@ -0,0 +1,92 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <gtest/gtest.h>
+
+#include "federated/cpu_load_training_condition.h"
+
+namespace federated {
+namespace {
+
+class CpuLoadTrainingConditionTest : public ::testing::Test {
+ public:
+  CpuLoadTrainingConditionTest() = default;
+  CpuLoadTrainingConditionTest(const CpuLoadTrainingConditionTest&) = delete;
+  CpuLoadTrainingConditionTest& operator=(const CpuLoadTrainingConditionTest&) =
+      delete;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    loadavg_path_ = temp_dir_.GetPath().Append("loadavg");
+  }
+
+ protected:
+  void WriteLoadAvg(const std::string& contents) {
+    ASSERT_TRUE(base::WriteFile(loadavg_path_, contents));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath loadavg_path_;
+};
+
+}  // namespace
+
+TEST_F(CpuLoadTrainingConditionTest, LowLoad) {
+  WriteLoadAvg("0.20 0.30 0.40 1/123 4567\n");
+  EXPECT_TRUE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/1)
+                  .IsTrainingConditionSatisfied());
+}
+
+TEST_F(CpuLoadTrainingConditionTest, HighLoad) {
+  WriteLoadAvg("2.50 1.30 0.40 3/123 4567\n");
+  EXPECT_FALSE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/2)
+                   .IsTrainingConditionSatisfied());
+}
+
+TEST_F(CpuLoadTrainingConditionTest, NormalizedByCpuCount) {
+  WriteLoadAvg("3.00 0.30 0.40 3/123 4567\n");
+  EXPECT_FALSE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/4)
+                   .IsTrainingConditionSatisfied());
+  EXPECT_TRUE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/8)
+                  .IsTrainingConditionSatisfied());
+}
+
+// The load of the training itself doesn't stop it, even on a single CPU.
+TEST_F(CpuLoadTrainingConditionTest, TrainingLoadDiscounted) {
+  WriteLoadAvg("1.20 0.80 0.40 2/123 4567\n");
+  EXPECT_TRUE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/1)
+                  .IsTrainingConditionSatisfiedDuringTraining());
+}
+
+// Before training starts, all the load is someone else's.
+TEST_F(CpuLoadTrainingConditionTest, NoLoadDiscountedBeforeTraining) {
+  WriteLoadAvg("2.00 1.30 0.40 3/123 4567\n");
+  EXPECT_FALSE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/2)
+                   .IsTrainingConditionSatisfied());
+  WriteLoadAvg("1.20 0.80 0.40 2/123 4567\n");
+  EXPECT_FALSE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/1)
+                   .IsTrainingConditionSatisfied());
+}
+
+TEST_F(CpuLoadTrainingConditionTest, Malformed) {
+  WriteLoadAvg("not a load average\n");
+  EXPECT_FALSE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/8)
+                   .IsTrainingConditionSatisfied());
+
+  WriteLoadAvg("");
+  EXPECT_FALSE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/8)
+                   .IsTrainingConditionSatisfied());
+}
+
+TEST_F(CpuLoadTrainingConditionTest, MissingFile) {
+  EXPECT_FALSE(CpuLoadTrainingCondition(loadavg_path_, /*num_cpus=*/8)
+                   .IsTrainingConditionSatisfied());
+}
+
+}  // namespace federated
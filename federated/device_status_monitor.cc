@@ -9,6 +9,7 @@
 #include <memory>
 #include <utility>
 
+#include "federated/cpu_load_training_condition.h"
 #include "federated/device_status_monitor.h"
 #include "federated/network_status_training_condition.h"
 #include "federated/power_supply_training_condition.h"
@@ -23,10 +24,11 @@ DeviceStatusMonitor::DeviceStatusMonitor(
 
 std::unique_ptr<DeviceStatusMonitor> DeviceStatusMonitor::CreateFromDBus(
     dbus::Bus* bus) {
-  std::vector<std::unique_ptr<TrainingCondition>> training_conditions(2);
+  std::vector<std::unique_ptr<TrainingCondition>> training_conditions(3);
   training_conditions[0] = std::make_unique<PowerSupplyTrainingCondition>(bus);
   training_conditions[1] = std::make_unique<NetworkStatusTrainingCondition>(
       std::make_unique<shill::Client>(bus));
+  training_conditions[2] = std::make_unique<CpuLoadTrainingCondition>();
 
   return std::make_unique<DeviceStatusMonitor>(std::move(training_conditions));
 }
@@ -39,4 +41,13 @@ bool DeviceStatusMonitor::TrainingConditionsSatisfied() const {
                      });
 }
 
+bool DeviceStatusMonitor::TrainingConditionsSatisfiedDuringTraining() const {
+  DVLOG(1) << __func__;
+  return std::all_of(
+      training_conditions_.begin(), training_conditions_.end(),
+      [](auto const& condition) {
+        return condition->IsTrainingConditionSatisfiedDuringTraining();
+      });
+}
+
 }  // namespace federated
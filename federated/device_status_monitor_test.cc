@@ -22,6 +22,10 @@ class MockTrainingCondition : public TrainingCondition {
   MockTrainingCondition() = default;
   ~MockTrainingCondition() override = default;
   MOCK_METHOD(bool, IsTrainingConditionSatisfied, (), (const, override));
+  MOCK_METHOD(bool,
+              IsTrainingConditionSatisfiedDuringTraining,
+              (),
+              (const, override));
 };
 }  // namespace
 
@@ -86,4 +90,27 @@ TEST_F(DeviceStatusMonitorTest, TwoTrainingConditions) {
       .WillOnce(Return(true));
   EXPECT_TRUE(device_status_monitor.TrainingConditionsSatisfied());
 }
+
+TEST_F(DeviceStatusMonitorTest, DuringTraining) {
+  auto training_condition1 =
+      std::make_unique<StrictMock<MockTrainingCondition>>();
+  auto training_condition_1 = training_condition1.get();
+
+  std::vector<std::unique_ptr<TrainingCondition>> training_conditions;
+  training_conditions.push_back(std::move(training_condition1));
+  auto device_status_monitor =
+      DeviceStatusMonitor(std::move(training_conditions));
+
+  EXPECT_CALL(*training_condition_1,
+              IsTrainingConditionSatisfiedDuringTraining())
+      .WillOnce(Return(false));
+  EXPECT_FALSE(
+      device_status_monitor.TrainingConditionsSatisfiedDuringTraining());
+
+  EXPECT_CALL(*training_condition_1,
+              IsTrainingConditionSatisfiedDuringTraining())
+      .WillOnce(Return(true));
+  EXPECT_TRUE(
+      device_status_monitor.TrainingConditionsSatisfiedDuringTraining());
+}
 }  // namespace federated
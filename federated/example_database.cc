@@ -15,6 +15,7 @@
 #include <base/strings/string_number_conversions.h>
 #include <base/strings/string_util.h>
 #include <base/strings/stringprintf.h>
+#include <base/synchronization/lock.h>
 #include <bits/stdint-intn.h>
 #include <sqlite3.h>
 
@@ -257,6 +258,19 @@ bool ExampleDatabase::Init(const std::unordered_set<std::string>& clients) {
     return false;
   }
 
+  // Write-ahead logging turns each insertion into an append to the log rather
+  // than a rewrite of the database file, and lets the iterators read while
+  // examples are being inserted. With WAL, synchronous=NORMAL only syncs on
+  // checkpoints and is still safe against corruption.
+  for (const char* pragma :
+       {"PRAGMA journal_mode=WAL;", "PRAGMA synchronous=NORMAL;"}) {
+    const ExecResult exec_result = ExecSql(pragma);
+    if (exec_result.code != SQLITE_OK) {
+      LOG(WARNING) << "Failed to run " << pragma << ": "
+                   << exec_result.error_msg;
+    }
+  }
+
   // Prepares meta table.
   if (!TableExists(kMetaTableName) && !CreateMetaTable()) {
     LOG(ERROR) << "Failed to prepare meta table";
@@ -266,7 +280,8 @@ bool ExampleDatabase::Init(const std::unordered_set<std::string>& clients) {
 
   // Prepares client tables.
   for (const auto& client : clients) {
-    if ((!TableExists(client) && !CreateClientTable(client))) {
+    if ((!TableExists(client) && !CreateClientTable(client)) ||
+        !CreateClientTableIndex(client)) {
       LOG(ERROR) << "Failed to prepare table for client " << client;
       Close();
 
@@ -286,6 +301,13 @@ bool ExampleDatabase::Close() {
     return true;
   }
 
+  {
+    base::AutoLock lock(insert_stmts_lock_);
+    for (const auto& [client_name, stmt] : insert_stmts_)
+      sqlite3_finalize(stmt);
+    insert_stmts_.clear();
+  }
+
   // If the database is successfully closed, db_ pointer must be released.
   // Otherwise sqlite3_close will be called again on already released db_
   // pointer by the destructor, which will result in undefined behavior.
@@ -454,18 +476,27 @@ bool ExampleDatabase::InsertExample(const std::string& client_name,
     return false;
   }
 
-  // Compile the insertion statement.
-  sqlite3_stmt* stmt = nullptr;
-  const std::string sql_code =
-      base::StringPrintf("INSERT INTO '%s' (example, timestamp) VALUES (?, ?);",
-                         client_name.c_str());
-  const int result =
-      sqlite3_prepare_v2(db_.get(), sql_code.c_str(), -1, &stmt, nullptr);
-  if (result != SQLITE_OK) {
-    LOG(ERROR) << "Couldn't compile insertion statement: "
-               << sqlite3_errmsg(db_.get());
-    return false;
+  // The statement is shared by all the callers, which may be on different
+  // threads, so it's held for the whole bind / step / reset sequence.
+  base::AutoLock lock(insert_stmts_lock_);
+
+  // Compile the insertion statement, unless it's been compiled already.
+  auto stmt_it = insert_stmts_.find(client_name);
+  if (stmt_it == insert_stmts_.end()) {
+    sqlite3_stmt* stmt = nullptr;
+    const std::string sql_code = base::StringPrintf(
+        "INSERT INTO '%s' (example, timestamp) VALUES (?, ?);",
+        client_name.c_str());
+    const int result =
+        sqlite3_prepare_v2(db_.get(), sql_code.c_str(), -1, &stmt, nullptr);
+    if (result != SQLITE_OK) {
+      LOG(ERROR) << "Couldn't compile insertion statement: "
+                 << sqlite3_errmsg(db_.get());
+      return false;
+    }
+    stmt_it = insert_stmts_.emplace(client_name, stmt).first;
   }
+  sqlite3_stmt* const stmt = stmt_it->second;
 
   // Run the insertion statement.
   const bool ok =
@@ -475,7 +506,8 @@ bool ExampleDatabase::InsertExample(const std::string& client_name,
       sqlite3_bind_int64(stmt, 2, example_record.timestamp.ToJavaTime()) ==
           SQLITE_OK &&
       sqlite3_step(stmt) == SQLITE_DONE;
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
 
   if (!ok) {
     LOG(ERROR) << "Failed to insert example: " << sqlite3_errmsg(db_.get());
@@ -546,6 +578,25 @@ bool ExampleDatabase::CreateClientTable(const std::string& client_name) {
   return true;
 }
 
+bool ExampleDatabase::CreateClientTableIndex(const std::string& client_name) {
+  if (!IsOpen()) {
+    LOG(ERROR) << "Trying to create index in a closed database";
+    return false;
+  }
+
+  // Serves the time range scans of GetIterator() and ExampleCount(), and the
+  // expiry in DeleteOutdatedExamples().
+  const std::string sql = base::StringPrintf(
+      "CREATE INDEX IF NOT EXISTS '%s_timestamp' ON '%s' (timestamp);",
+      client_name.c_str(), client_name.c_str());
+  const ExecResult result = ExecSql(sql);
+  if (result.code != SQLITE_OK) {
+    LOG(ERROR) << "Failed to create index: " << result.error_msg;
+    return false;
+  }
+  return true;
+}
+
 bool ExampleDatabase::MetaTableExists() const {
   return TableExists(std::string(kMetaTableName));
 }
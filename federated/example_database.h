@@ -14,6 +14,8 @@
 
 #include <absl/status/statusor.h>
 #include <base/files/file_path.h>
+#include <base/synchronization/lock.h>
+#include <base/thread_annotations.h>
 #include <base/time/time.h>
 #include <sqlite3.h>
 
@@ -237,6 +239,10 @@ class ExampleDatabase {
   // Returns true if the client's table is created without error.
   bool CreateClientTable(const std::string& client_name);
 
+  // Returns true if the timestamp index of the client's table exists or is
+  // created without error.
+  bool CreateClientTableIndex(const std::string& client_name);
+
   // Returns true if the metatable exists.
   bool MetaTableExists() const;
   // Returns true if metatable is created without error.
@@ -250,6 +256,12 @@ class ExampleDatabase {
 
   const base::FilePath db_path_;
   std::unique_ptr<sqlite3, decltype(&sqlite3_close)> db_;
+
+  // Compiled insertion statements, keyed by client name, reused across
+  // InsertExample() calls and finalized on Close().
+  base::Lock insert_stmts_lock_;
+  std::unordered_map<std::string, sqlite3_stmt*> insert_stmts_
+      GUARDED_BY(insert_stmts_lock_);
 };
 
 }  // namespace federated
@@ -596,6 +596,55 @@ TEST_F(ExampleDatabaseTest, InsertExampleMalformed) {
   EXPECT_TRUE(db_->Close());
 }
 
+// Tests that the cached insertion statements don't outlive the connection.
+TEST_F(ExampleDatabaseTest, InsertExampleAfterReopen) {
+  ASSERT_TRUE(CreateExampleDatabaseAndInitialize());
+  EXPECT_TRUE(db_->InsertExample("test_client_2",
+                                 {-1, "example_1", SecondsAfterEpoch(1)}));
+  ASSERT_TRUE(db_->Close());
+
+  const std::unordered_set<std::string> clients(kTestClients.begin(),
+                                                kTestClients.end());
+  ASSERT_TRUE(db_->Init(clients));
+  EXPECT_TRUE(db_->InsertExample("test_client_2",
+                                 {-1, "example_2", SecondsAfterEpoch(2)}));
+  EXPECT_EQ(db_->ExampleCountForTesting("test_client_2"), 2);
+
+  EXPECT_TRUE(db_->Close());
+}
+
+TEST_F(ExampleDatabaseTest, JournalModeAndIndexes) {
+  ASSERT_TRUE(CreateExampleDatabaseAndInitialize());
+
+  std::string journal_mode;
+  ASSERT_EQ(sqlite3_exec(
+                db_->sqlite3_for_testing(), "PRAGMA journal_mode;",
+                [](void* data, int col_count, char** cols, char**) {
+                  static_cast<std::string*>(data)->assign(cols[0]);
+                  return SQLITE_OK;
+                },
+                &journal_mode, nullptr),
+            SQLITE_OK);
+  EXPECT_EQ(journal_mode, "wal");
+
+  // Both the pre-existing and the newly created client tables are indexed.
+  for (const char* client : kTestClients) {
+    sqlite3_stmt* stmt = nullptr;
+    ASSERT_EQ(sqlite3_prepare_v2(
+                  db_->sqlite3_for_testing(),
+                  "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' "
+                  "AND tbl_name = ?;",
+                  -1, &stmt, nullptr),
+              SQLITE_OK);
+    sqlite3_bind_text(stmt, 1, client, -1, SQLITE_STATIC);
+    ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+    EXPECT_EQ(sqlite3_column_int(stmt, 0), 1) << client;
+    sqlite3_finalize(stmt);
+  }
+
+  EXPECT_TRUE(db_->Close());
+}
+
 TEST_F(ExampleDatabaseTest, CountExamples) {
   ASSERT_TRUE(CreateExampleDatabaseAndInitialize());
 
@@ -195,7 +195,8 @@ bool FederatedClient::Context::TrainingConditionsSatisfied(
   }
 
   const bool condition_satisfied =
-      typed_context->device_status_monitor_->TrainingConditionsSatisfied();
+      typed_context->device_status_monitor_
+          ->TrainingConditionsSatisfiedDuringTraining();
 
   if (!condition_satisfied) {
     Metrics::GetInstance()->LogClientEvent(
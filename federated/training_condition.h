@@ -15,6 +15,12 @@ class TrainingCondition {
   // Called before training to see if the device is in a good condition, and
   // during the training to see if the training should be aborted.
   [[nodiscard]] virtual bool IsTrainingConditionSatisfied() const = 0;
+  // Called during the training instead of IsTrainingConditionSatisfied(), for
+  // the conditions affected by the training itself.
+  [[nodiscard]] virtual bool IsTrainingConditionSatisfiedDuringTraining()
+      const {
+    return IsTrainingConditionSatisfied();
+  }
 };
 
 }  // namespace federated
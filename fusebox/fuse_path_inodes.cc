@@ -42,6 +42,10 @@ std::string GetChildNodeName(const char* name) {
   return std::string("/").append(entry.data(), entry.size());
 }
 
+// Number of timed node stats cached, enough for the stats of a large
+// directory listing to survive until they are used.
+constexpr size_t kStatCacheSize = 8192;
+
 inline Node* NodeError(int error) {
   errno = error;
   return nullptr;
@@ -51,7 +55,7 @@ inline Node* NodeError(int error) {
 
 namespace fusebox {
 
-InodeTable::InodeTable() : stat_cache_(1024) {
+InodeTable::InodeTable() : stat_cache_(kStatCacheSize) {
   root_node_ = InsertNode(CreateNode(0, "/", FUSE_ROOT_ID));
 }
 
@@ -200,8 +204,16 @@ void InodeTable::SetStat(ino_t ino, struct stat stat, double timeout) {
   DCHECK(ino);
   stat.st_ino = ino;
 
+  if (!timeout) {
+    ForgetStat(ino);
+    pinned_stat_map_[ino] = stat;
+    return;
+  }
+
+  pinned_stat_map_.erase(ino);
+
   struct Stat item;
-  item.time = timeout ? std::time(nullptr) + time_t(timeout) : time_t(0);
+  item.time = std::time(nullptr) + time_t(timeout);
   item.stat = stat;
 
   stat_cache_.Put(stat.st_ino, item);
@@ -210,12 +222,18 @@ void InodeTable::SetStat(ino_t ino, struct stat stat, double timeout) {
 bool InodeTable::GetStat(ino_t ino, struct stat* stat) {
   DCHECK(stat);
 
+  if (auto pinned = pinned_stat_map_.find(ino);
+      pinned != pinned_stat_map_.end()) {
+    *stat = pinned->second;
+    return true;
+  }
+
   auto it = stat_cache_.Get(ino);
   if (it == stat_cache_.end())
     return false;
 
   const auto& item = it->second;
-  if (item.time && item.time < std::time(nullptr)) {
+  if (item.time < std::time(nullptr)) {
     stat_cache_.Erase(it);  // stat time out
     return false;
   }
@@ -225,6 +243,8 @@ bool InodeTable::GetStat(ino_t ino, struct stat* stat) {
 }
 
 void InodeTable::ForgetStat(ino_t ino) {
+  pinned_stat_map_.erase(ino);
+
   auto it = stat_cache_.Peek(ino);
   if (it != stat_cache_.end())
     stat_cache_.Erase(it);
@@ -110,7 +110,8 @@ class InodeTable {
   // Returns the node device: |node| must be in the node table.
   Device GetDevice(Node* node) const;
 
-  // Cache a stat for the node.
+  // Cache a stat for the node. Stats cached with a |timeout| are subject to
+  // LRU eviction; stats cached without one are kept until forgotten.
   void SetStat(ino_t ino, struct stat stat, double timeout = 0);
 
   // Get the cached stat for the node. Returns true on success.
@@ -160,6 +161,9 @@ class InodeTable {
   // Node stat cache.
   base::HashingLRUCache<ino_t, struct Stat> stat_cache_;
 
+  // Map ino to the node stats that have no timeout (e.g., device nodes).
+  std::unordered_map<ino_t, struct stat> pinned_stat_map_;
+
   // Root node.
   Node* root_node_ = nullptr;
 };
@@ -457,6 +457,34 @@ TEST(FusePathInodesTest, NodeStatCacheForget) {
   EXPECT_FALSE(inodes.GetStat(node->ino, &stat));
 }
 
+TEST(FusePathInodesTest, NodeStatCacheNoTimeoutIsNotEvicted) {
+  InodeTable inodes;
+
+  // Cache a stat without timeout on the root node.
+  struct stat stbuf = {0};
+  stbuf.st_mode = S_IFDIR | 0755;
+  inodes.SetStat(1, stbuf);
+
+  // Cache many more stats with a timeout than the cache can hold.
+  stbuf.st_mode = S_IFREG | 0644;
+  for (ino_t ino = FIRST_UNRESERVED_INO; ino < FIRST_UNRESERVED_INO + 10000;
+       ++ino) {
+    inodes.SetStat(ino, stbuf, 5.0);
+  }
+
+  // The least recently used timed stats are evicted, not the root stat.
+  struct stat stat = {0};
+  EXPECT_FALSE(inodes.GetStat(FIRST_UNRESERVED_INO, &stat));
+  EXPECT_TRUE(inodes.GetStat(FIRST_UNRESERVED_INO + 9999, &stat));
+  EXPECT_EQ(S_IFREG | 0644, stat.st_mode);
+  EXPECT_TRUE(inodes.GetStat(1, &stat));
+  EXPECT_EQ(S_IFDIR | 0755, stat.st_mode);
+
+  // Caching a stat with a timeout replaces the stat without timeout.
+  inodes.SetStat(1, stbuf, -5.0);
+  EXPECT_FALSE(inodes.GetStat(1, &stat));
+}
+
 TEST(FusePathInodesTest, DeviceMakeFromName) {
   InodeTable inodes;
 
@@ -227,6 +227,10 @@ class FuseBoxClient : public FileSystem {
       BuiltInGetStat(node->ino, &stat);
       request->ReplyAttr(stat, kStatTimeoutSeconds);
       return;
+    } else if (struct stat stat; GetInodeTable().GetStat(node->ino, &stat)) {
+      // Cached by ReadDir2Response: no need to ask the server again.
+      request->ReplyAttr(stat, kStatTimeoutSeconds);
+      return;
     }
 
     Stat2RequestProto request_proto;
@@ -287,6 +291,18 @@ class FuseBoxClient : public FileSystem {
       return;
     }
 
+    // Entries of a recently read directory have a cached stat.
+    if (Node* node = GetInodeTable().Lookup(parent, name)) {
+      fuse_entry_param entry = {0};
+      if (GetInodeTable().GetStat(node->ino, &entry.attr)) {
+        entry.ino = static_cast<fuse_ino_t>(node->ino);
+        entry.attr_timeout = kEntryTimeoutSeconds;
+        entry.entry_timeout = kEntryTimeoutSeconds;
+        request->ReplyEntry(entry);
+        return;
+      }
+    }
+
     Stat2RequestProto request_proto;
     request_proto.set_file_system_url(
         base::StrCat({GetInodeTable().GetDevicePath(parent_node), "/", name}));
@@ -472,8 +488,9 @@ class FuseBoxClient : public FileSystem {
       return;
     }
 
-    request->ReplyAttr(MakeStatFromProto(ino, response_proto.stat()),
-                       kStatTimeoutSeconds);
+    struct stat stat = MakeStatFromProto(ino, response_proto.stat());
+    GetInodeTable().SetStat(ino, stat, kStatTimeoutSeconds);
+    request->ReplyAttr(stat, kStatTimeoutSeconds);
   }
 
   void Unlink(std::unique_ptr<OkRequest> request,
@@ -525,6 +542,7 @@ class FuseBoxClient : public FileSystem {
     }
 
     if (ino) {
+      GetInodeTable().ForgetStat(ino);
       GetInodeTable().Forget(ino);
     }
     request->ReplyOk();
@@ -665,6 +683,13 @@ class FuseBoxClient : public FileSystem {
       if (Node* node = GetInodeTable().Ensure(parent_ino, name)) {
         entries.push_back(
             {node->ino, item.name(), MakeStatModeBits(item.mode_bits())});
+        // The entries carry full attributes: cache them so the getattr or
+        // lookup that usually follows each entry needs no D-Bus round-trip.
+        if (item.has_mode_bits() && item.has_size()) {
+          GetInodeTable().SetStat(node->ino,
+                                  MakeStatFromProto(node->ino, item),
+                                  kStatTimeoutSeconds);
+        }
       } else {
         dir_entry_buffer->AppendResponse(errno);
         PLOG(ERROR) << "readdir2-resp";
@@ -812,6 +837,7 @@ class FuseBoxClient : public FileSystem {
     }
 
     if (ino) {
+      GetInodeTable().ForgetStat(ino);
       GetInodeTable().Forget(ino);
     }
     request->ReplyOk();
@@ -873,8 +899,12 @@ class FuseBoxClient : public FileSystem {
       return;
     }
 
+    if (Node* target = GetInodeTable().Lookup(new_parent, new_name.c_str())) {
+      GetInodeTable().ForgetStat(target->ino);
+    }
     Node* node = GetInodeTable().Lookup(old_parent, old_name.c_str());
     if (node) {
+      GetInodeTable().ForgetStat(node->ino);
       GetInodeTable().Move(node, new_parent, new_name.c_str());
     }
 
@@ -1082,11 +1112,12 @@ class FuseBoxClient : public FileSystem {
 
     auto write2_response = base::BindOnce(&FuseBoxClient::Write2Response,
                                           weak_ptr_factory_.GetWeakPtr(),
-                                          std::move(request), size);
+                                          std::move(request), ino, size);
     CallFuseBoxServerMethod(&method, std::move(write2_response));
   }
 
   void Write2Response(std::unique_ptr<WriteRequest> request,
+                      ino_t ino,
                       size_t length,
                       dbus::Response* response) {
     VLOG(1) << "write2-resp";
@@ -1101,6 +1132,7 @@ class FuseBoxClient : public FileSystem {
       return;
     }
 
+    GetInodeTable().ForgetStat(ino);
     request->ReplyWrite(length);
   }
 
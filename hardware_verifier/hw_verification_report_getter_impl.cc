@@ -30,23 +30,27 @@ std::optional<HwVerificationReport> HwVerificationReportGetterImpl::Get(
     const base::StringPiece& hw_verification_spec_file,
     ErrorCode* out_error_code) const {
   DVLOG(1) << "Get the verification payload.";
-  std::optional<HwVerificationSpec> hw_verification_spec;
+  std::optional<HwVerificationSpec> hw_verification_spec_from_file;
+  const HwVerificationSpec* hw_verification_spec;
   if (hw_verification_spec_file.empty()) {
-    hw_verification_spec = vs_getter_->GetDefault();
-    if (!hw_verification_spec) {
+    if (!default_hw_verification_spec_)
+      default_hw_verification_spec_ = vs_getter_->GetDefault();
+    if (!default_hw_verification_spec_) {
       if (out_error_code)
         *out_error_code =
             ErrorCode::kErrorCodeMissingDefaultHwVerificationSpecFile;
       return std::nullopt;
     }
+    hw_verification_spec = &default_hw_verification_spec_.value();
   } else {
-    hw_verification_spec =
+    hw_verification_spec_from_file =
         vs_getter_->GetFromFile(base::FilePath(hw_verification_spec_file));
-    if (!hw_verification_spec) {
+    if (!hw_verification_spec_from_file) {
       if (out_error_code)
         *out_error_code = ErrorCode::kErrorCodeInvalidHwVerificationSpecFile;
       return std::nullopt;
     }
+    hw_verification_spec = &hw_verification_spec_from_file.value();
   }
 
   DVLOG(1) << "Get the probe result.";
@@ -73,7 +77,7 @@ std::optional<HwVerificationReport> HwVerificationReportGetterImpl::Get(
 
   DVLOG(1) << "Verify the probe result by the verification payload.";
   const auto verifier_result =
-      verifier_->Verify(probe_result.value(), hw_verification_spec.value());
+      verifier_->Verify(probe_result.value(), *hw_verification_spec);
   if (out_error_code) {
     if (!verifier_result)
       *out_error_code =
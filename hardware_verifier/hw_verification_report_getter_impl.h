@@ -48,6 +48,9 @@ class HwVerificationReportGetterImpl : public HwVerificationReportGetter {
   std::unique_ptr<ProbeResultGetter> pr_getter_;
   std::unique_ptr<HwVerificationSpecGetter> vs_getter_;
   std::unique_ptr<Verifier> verifier_;
+  // The default spec doesn't change during the lifetime of the process, so
+  // it is loaded once and reused by the following requests.
+  mutable std::optional<HwVerificationSpec> default_hw_verification_spec_;
 };
 
 }  // namespace hardware_verifier
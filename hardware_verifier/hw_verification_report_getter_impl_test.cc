@@ -178,6 +178,12 @@ TEST_F(HwVerificationReportGetterImplTest,
             ReportGetterErrorCode::kErrorCodeInvalidHwVerificationSpecFile);
 }
 
+TEST_F(HwVerificationReportGetterImplTest, TestLoadDefaultSpecOnce) {
+  EXPECT_CALL(*mock_vs_getter_, GetDefault()).Times(1);
+  EXPECT_TRUE(vr_getter_->Get("path", "", nullptr));
+  EXPECT_TRUE(vr_getter_->Get("path", "", nullptr));
+}
+
 TEST_F(HwVerificationReportGetterImplTest, TestVerifyFail) {
   ReportGetterErrorCode error_code;
 
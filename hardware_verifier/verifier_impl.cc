@@ -5,11 +5,13 @@
 
 #include "hardware_verifier/verifier_impl.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include <base/check.h>
@@ -77,14 +79,15 @@ void AddFoundComponentInfo(HwVerificationReport* hw_verification_report,
   }
 }
 
-bool IsModelComponent(const ComponentInfo& comp_info,
-                      const std::string& model_name) {
+// Returns the prefix of the uuids of the components of |model_name|, or an
+// empty string if all the components belong to the model.
+std::string GetModelComponentPrefix(const std::string& model_name) {
   if (model_name.empty())
-    return true;
+    return "";
 
   const auto& parts = base::SplitString(model_name, "_", base::KEEP_WHITESPACE,
                                         base::SPLIT_WANT_ALL);
-  return base::StartsWith(comp_info.component_uuid(), parts[0] + "_");
+  return parts[0] + "_";
 }
 
 }  // namespace
@@ -152,51 +155,21 @@ VerifierImpl::VerifierImpl() {
 std::optional<HwVerificationReport> VerifierImpl::Verify(
     const runtime_probe::ProbeResult& probe_result,
     const HwVerificationSpec& hw_verification_spec) const {
+  const auto* spec_index = GetSpecIndex(hw_verification_spec, GetModelName());
+  if (!spec_index)
+    return std::nullopt;
+
   // A dictionary of 'expected_component_category => seen'.
   std::map<SupportCategory, bool> seen_comp;
-  // Collect the categories of generic components we found.
-  std::set<SupportCategory> seen_generic_comp;
-
-  // A dictionary which maps (component_category, component_uuid) to its
-  // qualification status.
-  std::map<SupportCategory, std::map<std::string, QualificationStatus>>
-      qual_status_dict;
-  const auto model_name = GetModelName();
-  for (const auto& comp_info : hw_verification_spec.component_infos()) {
-    if (!IsModelComponent(comp_info, model_name))
-      continue;
-    const auto& category = comp_info.component_category();
-    const auto& uuid = comp_info.component_uuid();
-    const auto& qualification_status = comp_info.qualification_status();
-    const auto& insert_result =
-        qual_status_dict[category].emplace(uuid, qualification_status);
-    if (!insert_result.second) {
-      LOG(ERROR)
-          << "The verification spec contains duplicated component infos.";
-      return std::nullopt;
-    }
-
-    // We expect to see this component in probe result.
+  for (const auto& [category, unused_comps] : spec_index->qual_status) {
+    // We expect to see a component of this category in probe result.
     seen_comp[category] = false;
   }
+  // Collect the categories of generic components we found.
+  std::set<SupportCategory> seen_generic_comp;
 
-  // A dictionary which maps component_category to the field names in the
-  // allowlist.
-  std::map<SupportCategory, std::set<std::string>>
-      generic_comp_value_allowlists;
-  for (const auto& spec_info :
-       hw_verification_spec.generic_component_value_allowlists()) {
-    const auto& insert_result = generic_comp_value_allowlists.emplace(
-        spec_info.component_category(),
-        std::set<std::string>(spec_info.field_names().cbegin(),
-                              spec_info.field_names().cend()));
-    if (!insert_result.second) {
-      LOG(ERROR) << "Duplicated allowlist tables for category (num="
-                 << spec_info.component_category() << ") are detected in the "
-                 << "verification spec.";
-      return std::nullopt;
-    }
-  }
+  const std::unordered_map<std::string, QualificationStatus> no_comps;
+  const std::set<std::string> empty_allowlist;
 
   HwVerificationReport hw_verification_report;
   hw_verification_report.set_is_compliant(true);
@@ -209,12 +182,19 @@ std::optional<HwVerificationReport> VerifierImpl::Verify(
     if (comp_category_info.enum_value ==
         runtime_probe::ProbeRequest_SupportCategory_UNKNOWN)
       continue;
+    const auto category_it =
+        spec_index->qual_status.find(comp_category_info.enum_value);
     const auto& comp_name_to_qual_status =
-        qual_status_dict[comp_category_info.enum_value];
+        category_it != spec_index->qual_status.end() ? category_it->second
+                                                     : no_comps;
 
     // the default allowlist is empty.
+    const auto allowlist_it = spec_index->generic_comp_value_allowlists.find(
+        comp_category_info.enum_value);
     const auto& generic_comp_value_allowlist =
-        generic_comp_value_allowlists[comp_category_info.enum_value];
+        allowlist_it != spec_index->generic_comp_value_allowlists.end()
+            ? allowlist_it->second
+            : empty_allowlist;
 
     const auto& num_comps = probe_result_refl->FieldSize(
         probe_result, comp_category_info.probe_result_comp_field);
@@ -288,6 +268,56 @@ void VerifierImpl::SetCrosConfigForTesting(
   cros_config_ = std::move(cros_config);
 }
 
+const VerifierImpl::SpecIndex* VerifierImpl::GetSpecIndex(
+    const HwVerificationSpec& hw_verification_spec,
+    const std::string& model_name) const {
+  // Hashing the serialized spec is cheaper than comparing it field by field
+  // through reflection, and saves keeping a copy of it.
+  const size_t spec_fingerprint =
+      std::hash<std::string>{}(hw_verification_spec.SerializeAsString());
+  if (spec_index_ && model_name == indexed_model_name_ &&
+      spec_fingerprint == indexed_spec_fingerprint_) {
+    return &*spec_index_;
+  }
+  spec_index_.reset();
+
+  SpecIndex spec_index;
+  const auto model_prefix = GetModelComponentPrefix(model_name);
+  for (const auto& comp_info : hw_verification_spec.component_infos()) {
+    const auto& uuid = comp_info.component_uuid();
+    if (!base::StartsWith(uuid, model_prefix))
+      continue;
+    const auto& insert_result =
+        spec_index.qual_status[comp_info.component_category()].emplace(
+            uuid, comp_info.qualification_status());
+    if (!insert_result.second) {
+      LOG(ERROR)
+          << "The verification spec contains duplicated component infos.";
+      return nullptr;
+    }
+  }
+
+  for (const auto& spec_info :
+       hw_verification_spec.generic_component_value_allowlists()) {
+    const auto& insert_result =
+        spec_index.generic_comp_value_allowlists.emplace(
+            spec_info.component_category(),
+            std::set<std::string>(spec_info.field_names().cbegin(),
+                                  spec_info.field_names().cend()));
+    if (!insert_result.second) {
+      LOG(ERROR) << "Duplicated allowlist tables for category (num="
+                 << spec_info.component_category() << ") are detected in the "
+                 << "verification spec.";
+      return nullptr;
+    }
+  }
+
+  spec_index_ = std::move(spec_index);
+  indexed_spec_fingerprint_ = spec_fingerprint;
+  indexed_model_name_ = model_name;
+  return &*spec_index_;
+}
+
 std::string VerifierImpl::GetModelName() const {
   std::string model_name;
 
@@ -10,7 +10,9 @@
 
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <chromeos-config/libcros_config/cros_config.h>
@@ -34,6 +36,22 @@ class VerifierImpl : public Verifier {
       std::unique_ptr<brillo::CrosConfigInterface> cros_config);
 
  private:
+  using SupportCategory = runtime_probe::ProbeRequest_SupportCategory;
+
+  // The verification spec of one model compiled into lookup tables.
+  struct SpecIndex {
+    // Maps each category to the qualification status of its components, by
+    // component uuid.
+    std::unordered_map<SupportCategory,
+                       std::unordered_map<std::string, QualificationStatus>>
+        qual_status;
+
+    // Maps each category to the allowed field names of its generic
+    // components.
+    std::unordered_map<SupportCategory, std::set<std::string>>
+        generic_comp_value_allowlists;
+  };
+
   struct CompCategoryInfo {
     // Enum value of of this category.
     runtime_probe::ProbeRequest_SupportCategory enum_value;
@@ -63,7 +81,18 @@ class VerifierImpl : public Verifier {
   // value and name.
   std::vector<CompCategoryInfo> comp_category_infos_;
 
+  // The index of the last verification spec, which is usually the same for
+  // every call to Verify() in the daemon. It was built for the model
+  // |indexed_model_name_| and the spec with |indexed_spec_fingerprint_|.
+  mutable std::optional<SpecIndex> spec_index_;
+  mutable size_t indexed_spec_fingerprint_ = 0;
+  mutable std::string indexed_model_name_;
+
   std::string GetModelName() const;
+  // Returns the index of |hw_verification_spec| for |model_name|, building it
+  // if needed, or nullptr if the spec is invalid.
+  const SpecIndex* GetSpecIndex(const HwVerificationSpec& hw_verification_spec,
+                                const std::string& model_name) const;
 };
 
 }  // namespace hardware_verifier
@@ -82,6 +82,14 @@ class TestVerifierImpl : public testing::Test {
     }
   }
 
+  // Sets a fake cros_config with an empty model name to |verifier|.
+  void SetUpVerifier(VerifierImpl* verifier) {
+    auto cros_config = std::make_unique<brillo::FakeCrosConfig>();
+    cros_config_ = cros_config.get();
+    verifier->SetCrosConfigForTesting(std::move(cros_config));
+    SetModelName("");
+  }
+
   void TestVerifySuccWithSampleData(const std::string& probe_result_sample_name,
                                     const std::string& spec_sample_name,
                                     const std::string& report_sample_name) {
@@ -93,10 +101,7 @@ class TestVerifierImpl : public testing::Test {
         GetSampleDataPath().Append(report_sample_name + kPrototxtExtension));
 
     VerifierImpl verifier;
-    auto cros_config = std::make_unique<brillo::FakeCrosConfig>();
-    cros_config_ = cros_config.get();
-    verifier.SetCrosConfigForTesting(std::move(cros_config));
-    SetModelName("");
+    SetUpVerifier(&verifier);
     const auto& actual_hw_verification_report =
         verifier.Verify(probe_result, hw_verification_spec);
     EXPECT_TRUE(actual_hw_verification_report);
@@ -112,10 +117,7 @@ class TestVerifierImpl : public testing::Test {
         GetSampleDataPath().Append(spec_sample_name + kPrototxtExtension));
 
     VerifierImpl verifier;
-    auto cros_config = std::make_unique<brillo::FakeCrosConfig>();
-    cros_config_ = cros_config.get();
-    verifier.SetCrosConfigForTesting(std::move(cros_config));
-    SetModelName("");
+    SetUpVerifier(&verifier);
     EXPECT_FALSE(verifier.Verify(probe_result, hw_verification_spec));
   }
 
@@ -150,6 +152,27 @@ TEST_F(TestVerifierImpl, TestVerifySuccWithSample4) {
                                "expect_hw_verification_report_4");
 }
 
+TEST_F(TestVerifierImpl, TestVerifyWithDifferentSpecs) {
+  const auto& probe_result = LoadProbeResult(
+      GetSampleDataPath().Append(std::string("probe_result_1") +
+                                 kPrototxtExtension));
+  const auto& good_spec = LoadHwVerificationSpec(
+      GetSampleDataPath().Append(std::string("hw_verification_spec_1") +
+                                 kPrototxtExtension));
+  const auto& bad_spec = LoadHwVerificationSpec(
+      GetSampleDataPath().Append(std::string("hw_verification_spec_bad_1") +
+                                 kPrototxtExtension));
+
+  // The same verifier must not keep using the spec it verified against
+  // earlier.
+  VerifierImpl verifier;
+  SetUpVerifier(&verifier);
+  EXPECT_TRUE(verifier.Verify(probe_result, good_spec));
+  EXPECT_TRUE(verifier.Verify(probe_result, good_spec));
+  EXPECT_FALSE(verifier.Verify(probe_result, bad_spec));
+  EXPECT_TRUE(verifier.Verify(probe_result, good_spec));
+}
+
 TEST_F(TestVerifierImpl, TestVerifyFailWithSample1) {
   TestVerifyFailWithSampleData("probe_result_bad_1", "hw_verification_spec_1");
 }
@@ -64,6 +64,7 @@ Euicc::Euicc(uint8_t physical_slot, EuiccSlotInfo slot_info)
     EuiccCache::Read(physical_slot, &cached_euicc);
     dbus_adaptor_->SetProfilesRefreshedAtLeastOnce(
         cached_euicc.profiles_refreshed_at_least_once());
+    LoadCachedProfiles(cached_euicc);
   } else {
     dbus_adaptor_->SetProfilesRefreshedAtLeastOnce(false);
   }
@@ -196,6 +197,55 @@ void Euicc::DeleteProfile(std::string iccid, DbusResult<> dbus_result) {
       });
 }
 
+void Euicc::LoadCachedProfiles(const CachedEuicc& cached_euicc) {
+  // Profile object paths are derived from the EID, so the cached profiles are
+  // only usable if they were read from this very card.
+  if (slot_info_.eid_.empty() || cached_euicc.eid() != slot_info_.eid_)
+    return;
+  std::vector<dbus::ObjectPath> profile_paths;
+  for (const auto& serialized_info : cached_euicc.installed_profiles()) {
+    ProfileInfo info;
+    if (!info.ParseFromString(serialized_info) || !info.has_iccid()) {
+      LOG(ERROR) << "Ignoring corrupt cached profile";
+      continue;
+    }
+    if (!is_test_mode_ &&
+        info.profile_class() == lpa::proto::ProfileClass::TESTING)
+      continue;
+    auto profile =
+        Profile::Create(info, physical_slot_, slot_info_.eid_,
+                        /*is_pending*/ false,
+                        base::BindRepeating(&Euicc::OnProfileEnabled,
+                                            weak_factory_.GetWeakPtr()));
+    if (profile) {
+      profile_paths.push_back(profile->object_path());
+      profiles_[profile->GetIccid()] = std::move(profile);
+    }
+  }
+  VLOG(2) << "Loaded " << profile_paths.size() << " profiles from cache";
+  // The next read of the installed profiles from the card, by a refresh or
+  // after an install, uninstall or reset, replaces the cached ones.
+  dbus_adaptor_->SetInstalledProfiles(profile_paths);
+  dbus_adaptor_->SetProfiles(profile_paths);
+}
+
+void Euicc::CacheInstalledProfiles(
+    const std::vector<lpa::proto::ProfileInfo>& profile_infos) {
+  CachedEuicc cached_euicc;
+  if (EuiccCache::CacheExists(physical_slot_) &&
+      !EuiccCache::Read(physical_slot_, &cached_euicc)) {
+    LOG(ERROR) << "Couldn't read cache";
+  }
+  if (slot_info_.eid_.empty() || cached_euicc.eid() != slot_info_.eid_)
+    return;
+  cached_euicc.clear_installed_profiles();
+  for (const auto& info : profile_infos)
+    cached_euicc.add_installed_profiles(info.SerializeAsString());
+  if (!EuiccCache::Write(physical_slot_, std::move(cached_euicc))) {
+    LOG(ERROR) << "Couldn't write installed profiles to cache";
+  }
+}
+
 void Euicc::UpdateProfilesProperty() {
   std::vector<dbus::ObjectPath> profile_paths;
   LOG(INFO) << __func__;
@@ -258,7 +308,9 @@ void Euicc::OnProfileInstalled(const lpa::proto::ProfileInfo& profile_info,
             context_->executor(),
             [this, dbus_result{std::move(dbus_result)}, profile_path](
                 std::vector<lpa::proto::ProfileInfo>& profile_infos,
-                int /*error*/) {
+                int error) {
+              if (!error)
+                CacheInstalledProfiles(profile_infos);
               EndEuiccOp(EuiccOp::INSTALL, dbus_result, profile_path);
             });
       });
@@ -302,7 +354,11 @@ void Euicc::SendNotifications(
             context_->executor(),
             [this, euicc_op, dbus_result{std::move(dbus_result)}](
                 std::vector<lpa::proto::ProfileInfo>& profile_infos,
-                int /*error*/) { EndEuiccOp(euicc_op, dbus_result); });
+                int error) {
+              if (!error)
+                CacheInstalledProfiles(profile_infos);
+              EndEuiccOp(euicc_op, dbus_result);
+            });
       });
 }
 
@@ -356,6 +412,7 @@ void Euicc::OnInstalledProfilesReceived(
       ++it;
     }
   }
+  CacheInstalledProfiles(profile_infos);
   for (const auto& info : profile_infos) {
     if (!is_test_mode_ &&
         info.profile_class() == lpa::proto::ProfileClass::TESTING)
@@ -15,6 +15,7 @@
 #include <google-lpa/lpa/data/proto/profile_info.pb.h>
 
 #include "hermes/adaptor_interfaces.h"
+#include "hermes/cached_euicc.pb.h"
 #include "hermes/context.h"
 #include "hermes/dbus_result.h"
 #include "hermes/euicc_slot_info.h"
@@ -68,6 +69,13 @@ class Euicc {
                             int error,
                             DbusResult<> dbus_result);
 
+  // Publishes the profiles cached by CacheInstalledProfiles() if the cache
+  // belongs to the eUICC in this slot, so that they are visible before the
+  // first refresh has read them from the card.
+  void LoadCachedProfiles(const CachedEuicc& cached_euicc);
+  void CacheInstalledProfiles(
+      const std::vector<lpa::proto::ProfileInfo>& profile_infos);
+
   void UpdateProfilesProperty();
   void SendNotifications(EuiccOp euicc_op, DbusResult<> dbus_result);
 
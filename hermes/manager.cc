@@ -46,6 +46,9 @@ void Manager::OnEuiccUpdated(uint8_t physical_slot, EuiccSlotInfo slot_info) {
     slot_info.eid_ = cached_euicc.eid();
     VLOG(2) << "Loaded EID from cache: " << cached_euicc.eid();
   } else {
+    // The cached profiles belong to the card that was in the slot before.
+    if (cached_euicc.eid() != slot_info.eid_)
+      cached_euicc.clear_installed_profiles();
     cached_euicc.set_eid(slot_info.eid_);
     if (!EuiccCache::Write(physical_slot, std::move(cached_euicc))) {
       LOG(ERROR) << "Couldn't write EID to cache";
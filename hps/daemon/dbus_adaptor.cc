@@ -4,6 +4,7 @@
 
 #include "hps/daemon/dbus_adaptor.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -20,6 +21,10 @@ constexpr char kErrorPath[] = "org.chromium.Hps.GetFeatureResultError";
 
 namespace {
 
+// Number of polls returning unchanged filtered results before the poll
+// interval is doubled.
+constexpr int kStablePollsBeforeBackoff = 10;
+
 std::vector<uint8_t> HpsResultToSerializedBytes(HpsResult result) {
   HpsResultProto result_proto;
   result_proto.set_value(result);
@@ -105,11 +110,14 @@ void DBusAdaptor::FeatureState::SerializeInternal(HpsResultProto& result_proto,
 
 DBusAdaptor::DBusAdaptor(scoped_refptr<dbus::Bus> bus,
                          std::unique_ptr<HPS> hps,
-                         uint32_t poll_time_ms)
+                         uint32_t poll_time_ms,
+                         uint32_t max_poll_time_ms)
     : org::chromium::HpsAdaptor(this),
       dbus_object_(nullptr, bus, dbus::ObjectPath(::hps::kHpsServicePath)),
       hps_(std::move(hps)),
-      poll_time_ms_(poll_time_ms) {
+      poll_time_ms_(poll_time_ms),
+      max_poll_time_ms_(std::max(poll_time_ms, max_poll_time_ms)),
+      poll_interval_(base::Milliseconds(poll_time_ms)) {
   ShutDown();
 }
 
@@ -127,19 +135,61 @@ void DBusAdaptor::PollTask() {
   // system suspend state.
   CommitState();
 
+  bool results_changed = false;
   for (uint8_t i = 0; i < kFeatures; ++i) {
     auto& feature = features_[i];
     if (feature.enabled()) {
       FeatureResult result = this->hps_->Result(i);
       DCHECK(feature.filter());
       DCHECK(!feature.needs_commit());
+      const HpsResult previous = feature.filter()->GetCurrentResult();
       const auto res = feature.ProcessResult(result);
+      results_changed |= res != previous;
       VLOG(2) << "Poll: Feature: " << static_cast<int>(i)
               << " Valid: " << result.valid
               << " Result: " << static_cast<int>(result.inference_result)
               << " Filter: " << static_cast<int>(res);
     }
   }
+  UpdatePollInterval(results_changed);
+}
+
+void DBusAdaptor::StartPollTimer() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Restarting a running timer schedules its next run |poll_interval_| from
+  // now.
+  poll_timer_.Start(
+      FROM_HERE, poll_interval_,
+      base::BindRepeating(&DBusAdaptor::PollTask, base::Unretained(this)));
+}
+
+// Slows polling down while nothing happens in front of the sensor, to save
+// host wakeups and bus traffic, and speeds it up again on the first change.
+void DBusAdaptor::UpdatePollInterval(bool results_changed) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const base::TimeDelta min_interval = base::Milliseconds(poll_time_ms_);
+  const base::TimeDelta max_interval = base::Milliseconds(max_poll_time_ms_);
+  if (!poll_timer_.IsRunning() || min_interval == max_interval) {
+    return;
+  }
+
+  if (results_changed) {
+    stable_polls_ = 0;
+    if (poll_interval_ != min_interval) {
+      poll_interval_ = min_interval;
+      StartPollTimer();
+    }
+    return;
+  }
+
+  if (poll_interval_ >= max_interval ||
+      ++stable_polls_ < kStablePollsBeforeBackoff) {
+    return;
+  }
+  stable_polls_ = 0;
+  poll_interval_ = std::min(poll_interval_ * 2, max_interval);
+  VLOG(1) << "Results stable, polling every " << poll_interval_;
+  StartPollTimer();
 }
 
 void DBusAdaptor::BootIfNeeded() {
@@ -154,6 +204,8 @@ void DBusAdaptor::BootIfNeeded() {
 void DBusAdaptor::ShutDown() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   poll_timer_.Stop();
+  poll_interval_ = base::Milliseconds(poll_time_ms_);
+  stable_polls_ = 0;
   if (!hps_->ShutDown()) {
     LOG(FATAL) << "Failed to shutdown";
   }
@@ -221,9 +273,7 @@ bool DBusAdaptor::CommitState() {
   if (!active_features && hps_booted_) {
     ShutDown();
   } else if (active_features && !poll_timer_.IsRunning()) {
-    poll_timer_.Start(
-        FROM_HERE, base::Milliseconds(poll_time_ms_),
-        base::BindRepeating(&DBusAdaptor::PollTask, base::Unretained(this)));
+    StartPollTimer();
   }
   return result;
 }
@@ -240,6 +290,12 @@ bool DBusAdaptor::EnableFeature(brillo::ErrorPtr* error,
     return false;
   }
   features_[feature].Enable(config, std::move(callback));
+  // Poll at the full rate until the new feature's results settle.
+  poll_interval_ = base::Milliseconds(poll_time_ms_);
+  stable_polls_ = 0;
+  if (poll_timer_.IsRunning()) {
+    StartPollTimer();
+  }
   CommitState();
   return true;
 }
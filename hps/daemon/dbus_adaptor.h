@@ -25,9 +25,14 @@ using FeatureCallback =
 class DBusAdaptor : public org::chromium::HpsAdaptor,
                     public org::chromium::HpsInterface {
  public:
+  // While the filtered results of all the enabled features stay unchanged, the
+  // poll interval backs off from |poll_time_ms| up to |max_poll_time_ms|, and
+  // goes back to |poll_time_ms| as soon as a result changes. Passing a
+  // |max_poll_time_ms| no greater than |poll_time_ms| disables the backoff.
   DBusAdaptor(scoped_refptr<dbus::Bus> bus,
               std::unique_ptr<HPS>,
-              uint32_t poll_time_ms);
+              uint32_t poll_time_ms,
+              uint32_t max_poll_time_ms);
 
   DBusAdaptor(const DBusAdaptor&) = delete;
   DBusAdaptor& operator=(const DBusAdaptor&) = delete;
@@ -55,6 +60,8 @@ class DBusAdaptor : public org::chromium::HpsAdaptor,
   void BootIfNeeded();
   void ShutDown();
   bool CommitState();
+  void StartPollTimer();
+  void UpdatePollInterval(bool results_changed);
   bool EnableFeature(brillo::ErrorPtr* error,
                      const hps::FeatureConfig& config,
                      uint8_t feature,
@@ -98,6 +105,10 @@ class DBusAdaptor : public org::chromium::HpsAdaptor,
   std::unique_ptr<HPS> hps_;
   bool hps_booted_ = true;
   const uint32_t poll_time_ms_;
+  const uint32_t max_poll_time_ms_;
+  base::TimeDelta poll_interval_;
+  // Number of consecutive polls which returned the same filtered results.
+  int stable_polls_ = 0;
   base::RepeatingTimer poll_timer_;
   std::array<FeatureState, kFeatures> features_;
 
@@ -15,6 +15,7 @@ namespace hps {
 
 HpsDaemon::HpsDaemon(std::unique_ptr<DevInterface> dev,
                      uint32_t poll_time_ms,
+                     uint32_t max_poll_time_ms,
                      bool skip_boot,
                      uint32_t version,
                      const base::FilePath& mcu_fw_image,
@@ -22,7 +23,8 @@ HpsDaemon::HpsDaemon(std::unique_ptr<DevInterface> dev,
                      const base::FilePath& fpga_app_image)
     : brillo::DBusServiceDaemon(::hps::kHpsServiceName),
       hps_(std::make_unique<HPS_impl>(std::move(dev))),
-      poll_time_ms_(poll_time_ms) {
+      poll_time_ms_(poll_time_ms),
+      max_poll_time_ms_(max_poll_time_ms) {
   hps_->Init(version, mcu_fw_image, fpga_bitstream, fpga_app_image);
   if (!skip_boot) {
     LOG(INFO) << "Booting HPS device";
@@ -34,7 +36,8 @@ HpsDaemon::~HpsDaemon() = default;
 
 void HpsDaemon::RegisterDBusObjectsAsync(
     brillo::dbus_utils::AsyncEventSequencer* sequencer) {
-  adaptor_.reset(new DBusAdaptor(bus_, std::move(hps_), poll_time_ms_));
+  adaptor_.reset(new DBusAdaptor(bus_, std::move(hps_), poll_time_ms_,
+                                 max_poll_time_ms_));
   adaptor_->RegisterAsync(
       sequencer->GetHandler("RegisterAsync() failed", true));
 }
@@ -20,6 +20,7 @@ class HpsDaemon : public brillo::DBusServiceDaemon {
  public:
   HpsDaemon(std::unique_ptr<DevInterface> dev,
             uint32_t poll_time_ms,
+            uint32_t max_poll_time_ms,
             bool skip_boot,
             uint32_t version,
             const base::FilePath& mcu_fw_image,
@@ -38,6 +39,7 @@ class HpsDaemon : public brillo::DBusServiceDaemon {
   std::unique_ptr<DBusAdaptor> adaptor_;
   std::unique_ptr<HPS> hps_;
   const uint32_t poll_time_ms_;
+  const uint32_t max_poll_time_ms_;
 };
 
 }  // namespace hps
@@ -74,7 +74,8 @@ class HpsDaemonTest : public testing::Test {
     EXPECT_CALL(*mock_hps_, ShutDown()).WillOnce(Return(true));
     hps_daemon_.reset(
         new DBusAdaptor(mock_bus_, std::move(hps),
-                        static_cast<uint32_t>(kPollTime.InMilliseconds())));
+                        static_cast<uint32_t>(kPollTime.InMilliseconds()),
+                        static_cast<uint32_t>(kMaxPollTime.InMilliseconds())));
 
     feature_config_.set_allocated_basic_filter_config(
         new FeatureConfig_BasicFilterConfig());
@@ -95,6 +96,7 @@ class HpsDaemonTest : public testing::Test {
   std::unique_ptr<DBusAdaptor> hps_daemon_;
   FeatureConfig feature_config_;
   static constexpr base::TimeDelta kPollTime = base::Milliseconds(500);
+  static constexpr base::TimeDelta kMaxPollTime = base::Milliseconds(2000);
 };
 
 // Failing to enable or disable a feature at the hardware level should trigger a
@@ -479,4 +481,42 @@ TEST_F(HpsDaemonTest, ResetFilterOnResume) {
   EXPECT_EQ(value.value(), HpsResult::NEGATIVE);
 }
 
+TEST_F(HpsDaemonTest, PollTimerBacksOffWhileResultsAreStable) {
+  FeatureResult feature_result1{.inference_result = 100, .valid = true};
+  FeatureResult feature_result1b{.inference_result = 50, .valid = true};
+  FeatureResult feature_result2{.inference_result = -100, .valid = true};
+  EXPECT_CALL(*mock_hps_, Boot());
+  EXPECT_CALL(*mock_hps_, Enable(0)).WillOnce(Return(true));
+  EXPECT_CALL(*mock_hps_, IsRunning()).WillRepeatedly(Return(true));
+  // The first result differs from the initial one, then 10 stable filtered
+  // results double the poll interval, even though the raw results change.
+  EXPECT_CALL(*mock_hps_, Result(0))
+      .Times(11)
+      .WillOnce(Return(feature_result1))
+      .WillRepeatedly(Return(feature_result1b));
+
+  brillo::ErrorPtr error;
+  EXPECT_TRUE(hps_daemon_->EnableHpsSense(&error, feature_config_));
+  task_environment_.FastForwardBy(kPollTime * 11);
+  testing::Mock::VerifyAndClearExpectations(mock_hps_);
+
+  EXPECT_CALL(*mock_hps_, IsRunning()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock_hps_, Result(0)).WillOnce(Return(feature_result1));
+  task_environment_.FastForwardBy(kPollTime * 2);
+  testing::Mock::VerifyAndClearExpectations(mock_hps_);
+
+  // A change returns to the full poll rate.
+  EXPECT_CALL(*mock_hps_, IsRunning()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock_hps_, Result(0))
+      .Times(2)
+      .WillRepeatedly(Return(feature_result2));
+  task_environment_.FastForwardBy(kPollTime * 3);
+  testing::Mock::VerifyAndClearExpectations(mock_hps_);
+
+  EXPECT_CALL(*mock_hps_, IsRunning()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock_hps_, Disable(0)).WillOnce(Return(true));
+  EXPECT_CALL(*mock_hps_, ShutDown()).WillOnce(Return(true));
+  EXPECT_TRUE(hps_daemon_->DisableHpsSense(&error));
+}
+
 }  // namespace hps
@@ -42,6 +42,10 @@ int main(int argc, char* argv[]) {
   DEFINE_string(fpga_app_image, "", "FPGA application file");
   DEFINE_uint32(poll_timer_ms, 200,
                 "How frequently to poll HPS hardware for results (in ms).");
+  DEFINE_uint32(max_poll_timer_ms, 1000,
+                "Longest poll interval to back off to while filtered results "
+                "are unchanged (in ms). Backoff is disabled if not greater "
+                "than --poll_timer_ms.");
   brillo::FlagHelper::Init(argc, argv, "hps_daemon - HPS services daemon");
 
   // Always log to syslog and log to stderr if we are connected to a tty.
@@ -84,8 +88,9 @@ int main(int argc, char* argv[]) {
   CHECK(dev) << "Hardware device failed to initialise";
 
   int exit_code =
-      hps::HpsDaemon(std::move(dev), FLAGS_poll_timer_ms, FLAGS_skipboot,
-                     version, base::FilePath(FLAGS_mcu_fw_image),
+      hps::HpsDaemon(std::move(dev), FLAGS_poll_timer_ms,
+                     FLAGS_max_poll_timer_ms, FLAGS_skipboot, version,
+                     base::FilePath(FLAGS_mcu_fw_image),
                      base::FilePath(FLAGS_fpga_bitstream),
                      base::FilePath(FLAGS_fpga_app_image))
           .Run();
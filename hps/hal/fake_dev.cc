@@ -285,6 +285,10 @@ bool FakeDev::WriteMemory(HpsBank bank, const uint8_t* data, size_t len) {
   if (this->Flag(Flags::kMemFail)) {
     return false;
   }
+  if (this->mem_write_failure_count_) {
+    this->mem_write_failure_count_--;
+    return false;
+  }
   // Don't allow writes that exceed the max block size.
   if (len > (this->block_size_b_ + sizeof(uint32_t))) {
     return false;
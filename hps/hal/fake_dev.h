@@ -74,6 +74,7 @@ class FakeDev : public DevInterface {
   }
   size_t GetBankLen(hps::HpsBank bank);
   void SetPowerOnFailureCount(int n) { power_on_failure_count_ = n; }
+  void SetMemWriteFailureCount(int n) { mem_write_failure_count_ = n; }
   // Return a DevInterface accessing the simulator.
   std::unique_ptr<DevInterface> CreateDevInterface();
 
@@ -107,6 +108,7 @@ class FakeDev : public DevInterface {
   uint16_t f1_result_ = 0;               // Register value for feature 1
   int wake_lock_count_ = 0;
   int power_on_failure_count_ = 0;
+  int mem_write_failure_count_ = 0;  // Memory writes left to fail.
 };
 
 }  // namespace hps
@@ -37,6 +37,11 @@ namespace {
 static constexpr base::TimeDelta kBankReadySleep = base::Microseconds(500);
 static constexpr base::TimeDelta kBankReadyTimeout = base::Seconds(240);
 
+// Number of times a firmware block is sent before giving up on the update.
+// Resending just the failed block avoids erasing and rewriting the whole bank
+// after a transient I2C error.
+static constexpr int kMaxBlockWriteAttempts = 3;
+
 // After reset, we poll the magic number register for this long.
 // Stage0 comes out of reset and responds on I2C in under 1ms,
 // but launching stage1 takes around 1000ms due to signature validation.
@@ -802,6 +807,7 @@ bool HPS_impl::WriteFile(uint8_t bank,
   auto buf = std::make_unique<uint8_t[]>(block_size + sizeof(uint32_t));
   // Iterate over the firmware contents in blocks of *block_size* bytes.
   auto block_begin = contents.begin();
+  int retries = 0;
   while (block_begin != contents.end()) {
     // The current block ends after *block_size* bytes,
     // or at end of *contents* if there are fewer bytes remaining.
@@ -818,10 +824,25 @@ bool HPS_impl::WriteFile(uint8_t bank,
     buf[3] = address & 0xff;
     std::copy(block_begin, block_end, &buf[sizeof(uint32_t)]);
     size_t length = std::distance(block_begin, block_end) + sizeof(uint32_t);
-    if (!this->device_->Write(I2cMemWrite(bank), &buf[0], length)) {
-      LOG(ERROR) << "WriteFile: device write error. bank: "
-                 << static_cast<int>(bank);
-      return false;
+    for (int attempt = 1;
+         !this->device_->Write(I2cMemWrite(bank), &buf[0], length);
+         ++attempt) {
+      if (attempt >= kMaxBlockWriteAttempts) {
+        LOG(ERROR) << "WriteFile: device write error. bank: "
+                   << static_cast<int>(bank);
+        return false;
+      }
+      LOG(WARNING) << "WriteFile: device write error. bank: "
+                   << static_cast<int>(bank) << " address: " << address
+                   << ", retrying";
+      // The failed transfer may still have reached the device, so let it
+      // finish before sending the block again.
+      if (!this->WaitForBankReady(bank)) {
+        LOG(ERROR) << "WriteFile: bank " << static_cast<int>(bank)
+                   << " not ready after write error";
+        return false;
+      }
+      retries++;
     }
     // Wait for the bank to become ready, indicating that the previous write has
     // finished.
@@ -837,8 +858,15 @@ bool HPS_impl::WriteFile(uint8_t bank,
     }
     block_begin = block_end;
   }
-  VLOG(1) << "Wrote " << contents.size() << " bytes from " << source << " in "
-          << timer.Elapsed().InMilliseconds() << "ms";
+  base::TimeDelta elapsed = timer.Elapsed();
+  LOG(INFO) << "Wrote " << contents.size() << " bytes from " << source << " in "
+            << elapsed.InMilliseconds() << "ms"
+            << base::StringPrintf(
+                   " (%.1f KiB/s, %d retries)",
+                   elapsed.is_positive()
+                       ? contents.size() / 1024.0 / elapsed.InSecondsF()
+                       : 0.0,
+                   retries);
   return true;
 }
 
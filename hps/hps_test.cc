@@ -340,6 +340,26 @@ TEST_F(HPSTest, Download) {
   EXPECT_EQ(fake_->GetBankLen(hps::HpsBank::kSpiFlash), 0);
 }
 
+/*
+ * Download testing with transient write errors.
+ */
+TEST_F(HPSTest, DownloadRetriesFailedBlock) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  auto f = temp_dir.GetPath().Append("blob");
+  const int len = 1021;
+  CreateBlob(f, len);
+
+  // A block failing once is resent without restarting the download.
+  fake_->SetMemWriteFailureCount(1);
+  ASSERT_TRUE(hps_->Download(hps::HpsBank::kMcuFlash, f));
+  EXPECT_EQ(fake_->GetBankLen(hps::HpsBank::kMcuFlash), len);
+
+  // A block failing every attempt fails the download.
+  fake_->SetMemWriteFailureCount(3);
+  ASSERT_FALSE(hps_->Download(hps::HpsBank::kMcuFlash, f));
+}
+
 /*
  * Download testing with small block size
  */
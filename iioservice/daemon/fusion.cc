@@ -168,6 +168,7 @@ Fusion::Fusion() {
 
 void Fusion::Init() {
   init_types_.clear();
+  has_estimate_ = false;
 
   gyro_rate_ = 0;
 
@@ -211,10 +212,7 @@ android::mat33_t Fusion::GetRotationMatrix() const {
 }
 
 bool Fusion::HasEstimate() const {
-  return init_types_.find(cros::mojom::DeviceType::ACCEL) !=
-             init_types_.end() &&
-         init_types_.find(cros::mojom::DeviceType::ANGLVEL) !=
-             init_types_.end();
+  return has_estimate_;
 }
 
 bool Fusion::CheckInitComplete(cros::mojom::DeviceType type,
@@ -243,6 +241,9 @@ bool Fusion::CheckInitComplete(cros::mojom::DeviceType type,
       break;
   }
 
+  has_estimate_ =
+      init_types_.find(cros::mojom::DeviceType::ACCEL) != init_types_.end() &&
+      init_types_.find(cros::mojom::DeviceType::ANGLVEL) != init_types_.end();
   if (HasEstimate()) {
     // Average all the values we collected so far
     init_data_[0] *= 1.0f / init_count_[0];
@@ -358,8 +359,11 @@ void Fusion::Predict(const android::vec3_t& w, float dT) {
   const android::vec3_t b = x1_;
   android::vec3_t we = w - b;
 
-  if (length(we) < WVEC_EPS)
+  float lwe = length(we);
+  if (lwe < WVEC_EPS) {
     we = (we[0] > 0.f) ? WVEC_EPS : -WVEC_EPS;
+    lwe = length(we);
+  }
 
   // q(k+1) = O(we)*q(k)
   // --------------------
@@ -391,13 +395,17 @@ void Fusion::Predict(const android::vec3_t& w, float dT) {
   const android::mat33_t I33dT(dT);
   const android::mat33_t wx(crossMatrix(we, 0));
   const android::mat33_t wx2(wx * wx);
-  const float lwedT = length(we) * dT;
+  const float lwedT = lwe * dT;
   const float hlwedT = 0.5f * lwedT;
-  const float ilwe = 1.f / length(we);
-  const float k0 = (1 - cosf(lwedT)) * (ilwe * ilwe);
-  const float k1 = sinf(lwedT);
+  const float ilwe = 1.f / lwe;
+  // Only the half angle goes through sinf() and cosf(), using
+  //   1 - cos(x) = 2.sin(x/2)^2  and  sin(x) = 2.sin(x/2).cos(x/2)
+  // The former also avoids the cancellation of 1 - cosf() at small angles.
+  const float shlwedT = sinf(hlwedT);
   const float k2 = cosf(hlwedT);
-  const android::vec3_t psi(sinf(hlwedT) * ilwe * we);
+  const float k0 = 2 * shlwedT * shlwedT * (ilwe * ilwe);
+  const float k1 = 2 * shlwedT * k2;
+  const android::vec3_t psi(shlwedT * ilwe * we);
   const android::mat33_t O33(crossMatrix(-psi, k2));
   android::mat44_t O;
   O[0].xyz = O33[0];
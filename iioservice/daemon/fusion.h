@@ -57,6 +57,8 @@ class Fusion {
   android::mat<android::mat33_t, 2, 2> Phi_;
   android::vec3_t Ba_, Bm_;
   std::set<cros::mojom::DeviceType> init_types_;
+  // Whether both accel and gyro samples have been received since Init().
+  bool has_estimate_ = false;
   float gyro_rate_;
   android::vec<android::vec3_t, 3> init_data_;
   size_t init_count_[3] = {0, 0, 0};
@@ -0,0 +1,54 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "iioservice/daemon/fusion.h"
+
+#include <gtest/gtest.h>
+
+namespace iioservice {
+
+namespace {
+
+constexpr float kGravity = 9.80665f;
+constexpr float kDeltaTime = 0.01f;  // 100 Hz
+
+android::vec3_t MakeVec(float x, float y, float z) {
+  android::vec3_t v;
+  v[0] = x;
+  v[1] = y;
+  v[2] = z;
+  return v;
+}
+
+TEST(FusionTest, NoEstimateBeforeBothSensors) {
+  Fusion fusion;
+  EXPECT_FALSE(fusion.HasEstimate());
+
+  fusion.HandleAccel(MakeVec(0, 0, kGravity), kDeltaTime);
+  EXPECT_FALSE(fusion.HasEstimate());
+
+  fusion.HandleGyro(MakeVec(0, 0, 0), kDeltaTime);
+  EXPECT_TRUE(fusion.HasEstimate());
+
+  fusion.Init();
+  EXPECT_FALSE(fusion.HasEstimate());
+}
+
+TEST(FusionTest, GravityAtRest) {
+  Fusion fusion;
+  for (int i = 0; i < 1000; ++i) {
+    fusion.HandleGyro(MakeVec(0, 0, 0), kDeltaTime);
+    fusion.HandleAccel(MakeVec(0, 0, kGravity), kDeltaTime);
+  }
+  ASSERT_TRUE(fusion.HasEstimate());
+
+  const android::vec3_t up = fusion.GetRotationMatrix()[2];
+  EXPECT_NEAR(up[0], 0.0f, 1e-3f);
+  EXPECT_NEAR(up[1], 0.0f, 1e-3f);
+  EXPECT_NEAR(up[2], 1.0f, 1e-3f);
+}
+
+}  // namespace
+
+}  // namespace iioservice
@@ -34,16 +34,31 @@ void SamplesHandlerBase::SampleData::SetTimeoutTask() {
   if (!client_data_ || client_data_->timeout == 0)
     return;
 
+  base::TimeDelta timeout = base::Milliseconds(client_data_->GetTimeout());
+  timeout_deadline_ = base::TimeTicks::Now() + timeout;
+  // The pending task, if any, reposts itself until the new deadline.
+  if (!timeout_task_posted_)
+    PostTimeoutTask(timeout);
+}
+
+void SamplesHandlerBase::SampleData::PostTimeoutTask(base::TimeDelta delay) {
+  timeout_task_posted_ = true;
   task_runner_->PostDelayedTask(
       FROM_HERE,
       base::BindOnce(&SamplesHandlerBase::SampleData::SampleTimeout,
-                     weak_factory_.GetWeakPtr(), sample_index_),
-      base::Milliseconds(client_data_->GetTimeout()));
+                     weak_factory_.GetWeakPtr()),
+      delay);
 }
 
-void SamplesHandlerBase::SampleData::SampleTimeout(uint64_t sample_index) {
-  if (sample_index != sample_index_ ||
-      !client_data_->samples_observer.is_bound()) {
+void SamplesHandlerBase::SampleData::SampleTimeout() {
+  timeout_task_posted_ = false;
+  if (!client_data_->samples_observer.is_bound())
+    return;
+
+  base::TimeDelta remaining = timeout_deadline_ - base::TimeTicks::Now();
+  if (remaining.is_positive()) {
+    // Samples were sent since this task was posted.
+    PostTimeoutTask(remaining);
     return;
   }
 
@@ -13,6 +13,7 @@
 
 #include <base/memory/weak_ptr.h>
 #include <base/task/sequenced_task_runner.h>
+#include <base/time/time.h>
 
 #include "iioservice/daemon/common_types.h"
 
@@ -25,12 +26,19 @@ class SamplesHandlerBase {
     explicit SampleData(ClientData* client_data = nullptr);
     ~SampleData();
 
+    // Moves the timeout deadline to the client's timeout from now. At most one
+    // timeout task is pending per client, so that delivering a sample doesn't
+    // post a new delayed task.
     void SetTimeoutTask();
-    void SampleTimeout(uint64_t sample_index);
+    void PostTimeoutTask(base::TimeDelta delay);
+    void SampleTimeout();
 
     ClientData* client_data_ = nullptr;
     scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
+    base::TimeTicks timeout_deadline_;
+    bool timeout_task_posted_ = false;
+
     // The starting index of the next sample.
     uint64_t sample_index_ = 0;
     // Moving averages of channels except for channels that have no batch mode
@@ -184,6 +184,18 @@ const Manifest& Component::manifest() {
 
 bool Component::Mount(HelperProcessProxy* mounter,
                       const base::FilePath& dest_dir) {
+  base::ScopedFD image_fd;
+  MountRequest request;
+  if (!PrepareMount(dest_dir, &image_fd, &request))
+    return false;
+
+  return mounter->SendMountCommand(request.fd, request.path, request.fs_type,
+                                   request.table);
+}
+
+bool Component::PrepareMount(const base::FilePath& dest_dir,
+                             base::ScopedFD* image_fd,
+                             MountRequest* request) {
   // Read the table in and verify the hash.
   std::string table;
   if (!GetAndVerifyTable(GetTablePath(component_dir_), manifest_.table_sha256(),
@@ -198,10 +210,13 @@ bool Component::Mount(HelperProcessProxy* mounter,
     LOG(ERROR) << "Could not open image file.";
     return false;
   }
-  base::ScopedFD image_fd(image.TakePlatformFile());
+  image_fd->reset(image.TakePlatformFile());
 
-  return mounter->SendMountCommand(image_fd.get(), dest_dir.value(),
-                                   manifest_.fs_type(), table);
+  request->fd = image_fd->get();
+  request->path = dest_dir.value();
+  request->fs_type = manifest_.fs_type();
+  request->table = std::move(table);
+  return true;
 }
 
 bool Component::LoadManifestWithoutVerifyingKeyForTestingOnly() {
@@ -22,6 +22,7 @@
 
 #include <base/files/file.h>
 #include <base/files/file_path.h>
+#include <base/files/scoped_file.h>
 #include <base/gtest_prod_util.h>
 #include <crypto/secure_hash.h>
 
@@ -54,6 +55,14 @@ class Component {
   // Mounts the component into |mount_point|. |mount_point| must already exist.
   bool Mount(HelperProcessProxy* proxy, const base::FilePath& mount_point);
 
+  // Reads and verifies the dm-verity table and opens the image of the
+  // component, filling |request| to mount it into |mount_point| with
+  // HelperProcessProxy::SendMountBatchCommand(). |image_fd| holds the image
+  // open and must outlive the use of |request|.
+  bool PrepareMount(const base::FilePath& mount_point,
+                    base::ScopedFD* image_fd,
+                    MountRequest* request);
+
   // Return a reference to the parsed manifest object, which is stored in
   // memory.
   const Manifest& manifest();
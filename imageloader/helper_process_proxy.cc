@@ -8,6 +8,7 @@
 #include <signal.h>
 #include <sys/socket.h>
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -28,6 +29,27 @@ namespace {
 // Use a timeout for polling that's greater than the DBus timeout in case the
 // component/DLC to mount is very large.
 constexpr int kPollingTimeoutSeconds = 60;
+
+// Fills |command| with the arguments of a mount command.
+void SetMountCommand(const std::string& path,
+                     FileSystem fs_type,
+                     const std::string& table,
+                     MountCommand* command) {
+  command->set_mount_path(path);
+  command->set_table(table);
+
+  // Convert the internal enum to the protobuf enum.
+  switch (fs_type) {
+    case FileSystem::kExt4:
+      command->set_fs_type(MountCommand::EXT4);
+      break;
+    case FileSystem::kSquashFS:
+      command->set_fs_type(MountCommand::SQUASH);
+      break;
+    default:
+      LOG(FATAL) << "Unknown file system type passed to helper process.";
+  }
+}
 }  // namespace
 
 void HelperProcessProxy::Start(int argc,
@@ -88,20 +110,7 @@ bool HelperProcessProxy::SendMountCommand(int fd,
 
   // 1. Construct message object.
   ImageCommand image_command;
-  image_command.mutable_mount_command()->set_mount_path(path);
-  image_command.mutable_mount_command()->set_table(table);
-
-  // Convert the internal enum to the protobuf enum.
-  switch (fs_type) {
-    case FileSystem::kExt4:
-      image_command.mutable_mount_command()->set_fs_type(MountCommand::EXT4);
-      break;
-    case FileSystem::kSquashFS:
-      image_command.mutable_mount_command()->set_fs_type(MountCommand::SQUASH);
-      break;
-    default:
-      LOG(FATAL) << "Unknown file system type passed to helper process.";
-  }
+  SetMountCommand(path, fs_type, table, image_command.mutable_mount_command());
 
   // 2. Encode the fd into message.
   msg.msg_control = fds;
@@ -120,6 +129,54 @@ bool HelperProcessProxy::SendMountCommand(int fd,
   return SendCommand(image_command, &msg)->success();
 }
 
+bool HelperProcessProxy::SendMountBatchCommand(
+    const std::vector<MountRequest>& requests, std::vector<bool>* results) {
+  results->clear();
+  bool success = true;
+  for (size_t begin = 0; begin < requests.size(); begin += kMaxMountBatchSize) {
+    const size_t count = std::min(requests.size() - begin, kMaxMountBatchSize);
+    struct msghdr msg = {0};
+    int fds[kMaxMountBatchSize];
+    char control[CMSG_SPACE(sizeof(fds))];
+    memset(control, '\0', sizeof(control));
+
+    // 1. Construct message object.
+    ImageCommand image_command;
+    for (size_t i = 0; i < count; i++) {
+      const MountRequest& request = requests[begin + i];
+      SetMountCommand(request.path, request.fs_type, request.table,
+                      image_command.mutable_mount_batch_command()
+                          ->add_mount_commands());
+      fds[i] = request.fd;
+    }
+
+    // 2. Encode the fds into message, in the same order as the commands.
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+
+    memmove(CMSG_DATA(cmsg), fds, sizeof(int) * count);
+    msg.msg_controllen = cmsg->cmsg_len;
+
+    // 3. Send the command.
+    std::unique_ptr<CommandResponse> response =
+        SendCommand(image_command, &msg);
+
+    // 4. Process return value.
+    for (size_t i = 0; i < count; i++) {
+      bool mounted = i < static_cast<size_t>(response->results_size()) &&
+                     response->results(i);
+      results->push_back(mounted);
+      success &= mounted;
+    }
+  }
+  return success;
+}
+
 bool HelperProcessProxy::SendUnmountAllCommand(
     bool dry_run,
     const std::string& rootpath,
@@ -24,6 +24,18 @@ namespace imageloader {
 class ImageCommand;
 class CommandResponse;
 
+// Maximum number of images mounted by the helper process in one round-trip. It
+// bounds the number of fds passed in a single message.
+constexpr size_t kMaxMountBatchSize = 16;
+
+// The arguments of a mount command, see SendMountCommand().
+struct MountRequest {
+  int fd;
+  std::string path;
+  FileSystem fs_type;
+  std::string table;
+};
+
 // Tracks a helper subprocess. Handles forking, cleaning up on termination, and
 // IPC.
 class HelperProcessProxy {
@@ -46,6 +58,12 @@ class HelperProcessProxy {
                                 FileSystem fs_type,
                                 const std::string& table);
 
+  // Sends messages telling the helper process to mount all of |requests|,
+  // |kMaxMountBatchSize| of them per round-trip. Sets |results| to whether each
+  // of them was mounted and returns true if all of them were.
+  virtual bool SendMountBatchCommand(const std::vector<MountRequest>& requests,
+                                     std::vector<bool>* results);
+
   // Sends a message telling the helper process to enumerate all mount point
   // paths with prefix of |rootpath| and returns them with |paths|. If
   // |dry_run| is true, no mount points are unmounted. If |dry_run| is false,
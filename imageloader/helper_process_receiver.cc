@@ -117,26 +117,38 @@ CommandResponse HelperProcessReceiver::HandleCommand(
 
     memmove(&pending_fd_, CMSG_DATA(cmsg), sizeof(pending_fd_));
 
-    // Convert the fs type to a string.
-    std::string fs_type;
-    switch (command.fs_type()) {
-      case MountCommand::EXT4:
-        fs_type = "ext4";
-        break;
-      case MountCommand::SQUASH:
-        fs_type = "squashfs";
-        break;
-      default:
-        LOG(FATAL) << "unknown filesystem type";
+    response.set_success(MountImage(command, base::ScopedFD(pending_fd_)));
+  } else if (image_command.has_mount_batch_command()) {
+    const auto& commands = image_command.mount_batch_command().mount_commands();
+    if (cmsg == nullptr)
+      LOG(FATAL) << "no cmsg";
+
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+      LOG(FATAL) << "cmsg is wrong type";
+
+    // Take ownership of all the fds first so none of them leaks.
+    std::vector<base::ScopedFD> fds;
+    const size_t num_fds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < num_fds; i++) {
+      int fd;
+      memmove(&fd, CMSG_DATA(cmsg) + i * sizeof(fd), sizeof(fd));
+      fds.emplace_back(fd);
     }
 
-    bool status = mounter_.Mount(base::ScopedFD(pending_fd_),
-                                 base::FilePath(command.mount_path()), fs_type,
-                                 command.table());
-    if (!status)
-      LOG(ERROR) << "mount failed";
+    if (fds.size() != static_cast<size_t>(commands.size())) {
+      LOG(ERROR) << "got " << fds.size() << " fds for " << commands.size()
+                 << " mount commands";
+      response.set_success(false);
+      return response;
+    }
 
-    response.set_success(status);
+    bool success = true;
+    for (int i = 0; i < commands.size(); i++) {
+      bool status = MountImage(commands[i], std::move(fds[i]));
+      response.add_results(status);
+      success &= status;
+    }
+    response.set_success(success);
   } else if (image_command.has_unmount_all_command()) {
     UnmountAllCommand command = image_command.unmount_all_command();
     std::vector<base::FilePath> paths;
@@ -157,6 +169,28 @@ CommandResponse HelperProcessReceiver::HandleCommand(
   return response;
 }
 
+bool HelperProcessReceiver::MountImage(const MountCommand& command,
+                                       base::ScopedFD image_fd) {
+  // Convert the fs type to a string.
+  std::string fs_type;
+  switch (command.fs_type()) {
+    case MountCommand::EXT4:
+      fs_type = "ext4";
+      break;
+    case MountCommand::SQUASH:
+      fs_type = "squashfs";
+      break;
+    default:
+      LOG(FATAL) << "unknown filesystem type";
+  }
+
+  bool status = mounter_.Mount(image_fd, base::FilePath(command.mount_path()),
+                               fs_type, command.table());
+  if (!status)
+    LOG(ERROR) << "mount failed";
+  return status;
+}
+
 void HelperProcessReceiver::SendResponse(const CommandResponse& response) {
   if (!response.SerializeToFileDescriptor(control_fd_.get()))
     LOG(ERROR) << "failed to serialize protobuf";
@@ -37,6 +37,8 @@ class HelperProcessReceiver : public brillo::Daemon {
   void OnCommandReady();
   CommandResponse HandleCommand(const ImageCommand& image_command,
                                 struct cmsghdr* cmsg);
+  // Mounts the image backed by |image_fd| as described by |command|.
+  bool MountImage(const MountCommand& command, base::ScopedFD image_fd);
   void SendResponse(const CommandResponse& response);
 
   base::ScopedFD control_fd_;
@@ -127,6 +127,14 @@ bool ImageLoader::LoadComponent(brillo::ErrorPtr* err,
   return true;
 }
 
+bool ImageLoader::LoadComponents(brillo::ErrorPtr* err,
+                                 const std::vector<std::string>& names,
+                                 std::vector<std::string>* out_mount_points) {
+  *out_mount_points = impl_.LoadComponents(names, helper_process_proxy_.get());
+  PostponeShutdown();
+  return true;
+}
+
 bool ImageLoader::LoadComponentAtPath(brillo::ErrorPtr* err,
                                       const std::string& name,
                                       const std::string& absolute_path,
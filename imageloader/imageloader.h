@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <signal.h>
 
@@ -60,6 +61,11 @@ class ImageLoader : public brillo::DBusServiceDaemon,
                      const std::string& name,
                      std::string* out_mount_point) override;
 
+  // Load and mount several components in one go.
+  bool LoadComponents(brillo::ErrorPtr* err,
+                      const std::vector<std::string>& names,
+                      std::vector<std::string>* out_mount_points) override;
+
   // Load and mount a component from the specified path, which can exist
   // outside of imageloader's reserved storage.
   bool LoadComponentAtPath(brillo::ErrorPtr* err,
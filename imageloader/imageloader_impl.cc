@@ -10,11 +10,14 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <base/containers/adapters.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
 #include <base/files/important_file_writer.h>
+#include <base/files/scoped_file.h>
 #include <base/json/json_string_value_serializer.h>
 #include <base/logging.h>
 #include <base/values.h>
@@ -112,6 +115,53 @@ std::string ImageLoaderImpl::LoadComponent(const std::string& name,
   return LoadComponentAtPath(name, component_path, proxy);
 }
 
+std::vector<std::string> ImageLoaderImpl::LoadComponents(
+    const std::vector<std::string>& names, HelperProcessProxy* proxy) {
+  std::vector<std::string> mount_points(names.size(), kBadResult);
+
+  // Verify all the components first, then set up all their dm-verity targets
+  // in a single batch.
+  std::vector<base::ScopedFD> image_fds;
+  std::vector<MountRequest> requests;
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < names.size(); i++) {
+    const std::string& name = names[i];
+    base::FilePath component_path;
+    if (!IsIdValid(name) ||
+        !GetPathToCurrentComponentVersion(name, &component_path)) {
+      continue;
+    }
+
+    std::unique_ptr<Component> component =
+        Component::Create(component_path, config_.keys);
+    if (!component) {
+      LOG(ERROR) << "Failed to initialize component: " << name;
+      continue;
+    }
+
+    base::FilePath mount_point(GetMountPoint(config_.mount_path, name,
+                                             component->manifest().version()));
+    base::ScopedFD image_fd;
+    MountRequest request;
+    if (!component->PrepareMount(mount_point, &image_fd, &request))
+      continue;
+    image_fds.push_back(std::move(image_fd));
+    requests.push_back(std::move(request));
+    indices.push_back(i);
+  }
+
+  if (requests.empty())
+    return mount_points;
+
+  std::vector<bool> results;
+  proxy->SendMountBatchCommand(requests, &results);
+  for (size_t i = 0; i < results.size() && i < indices.size(); i++) {
+    if (results[i])
+      mount_points[indices[i]] = requests[i].path;
+  }
+  return mount_points;
+}
+
 std::string ImageLoaderImpl::LoadDlcImage(const std::string& id,
                                           const std::string& package,
                                           const std::string& a_or_b,
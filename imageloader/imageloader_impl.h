@@ -73,6 +73,12 @@ class ImageLoaderImpl {
   // string on failure.
   std::string LoadComponent(const std::string& name, HelperProcessProxy* proxy);
 
+  // Load the specified components, mounting all of them through |proxy| with as
+  // few round-trips as possible. This returns the mount point of each of the
+  // components, an empty string for the ones that failed.
+  std::vector<std::string> LoadComponents(const std::vector<std::string>& names,
+                                          HelperProcessProxy* proxy);
+
   // Load the specified DLC module image. This returns the mount point or an
   // empty string on failure.
   std::string LoadDlcImage(const std::string& id,
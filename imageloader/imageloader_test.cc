@@ -156,6 +156,36 @@ TEST_F(ImageLoaderTest, MountValidImage) {
                                    helper_mock.get()));
 }
 
+TEST_F(ImageLoaderTest, LoadComponents) {
+  Keys keys;
+  keys.push_back(
+      std::vector<uint8_t>(std::begin(kDevPublicKey), std::end(kDevPublicKey)));
+
+  // Only the registered component is sent to the helper process.
+  auto helper_mock = std::make_unique<MockHelperProcessProxy>();
+  EXPECT_CALL(*helper_mock, SendMountCommand(_, _, _, _)).Times(0);
+  EXPECT_CALL(*helper_mock, SendMountBatchCommand(testing::SizeIs(1), _))
+      .WillOnce(testing::DoAll(
+          testing::SetArgPointee<1>(std::vector<bool>{true}),
+          testing::Return(true)));
+
+  base::ScopedTempDir scoped_mount_dir;
+  ASSERT_TRUE(scoped_mount_dir.CreateUniqueTempDir());
+
+  ImageLoaderConfig config(keys, temp_dir_.value().c_str(),
+                           scoped_mount_dir.GetPath().value().c_str());
+  ImageLoaderImpl loader(std::move(config));
+  ASSERT_TRUE(loader.RegisterComponent(kTestComponentName, kTestDataVersion,
+                                       GetTestComponentPath().value()));
+
+  const std::string expected_path =
+      scoped_mount_dir.GetPath().value() + "/PepperFlashPlayer/22.0.0.158";
+  EXPECT_EQ(
+      std::vector<std::string>({"", expected_path}),
+      loader.LoadComponents({"UnknownComponent", kTestComponentName},
+                            helper_mock.get()));
+}
+
 TEST_F(ImageLoaderTest, LoadComponentAtPath) {
   Keys keys;
   keys.push_back(
@@ -31,6 +31,11 @@ class MockHelperProcessProxy : public HelperProcessProxy {
               (int, const std::string&, FileSystem, const std::string&),
               (override));
 
+  MOCK_METHOD(bool,
+              SendMountBatchCommand,
+              (const std::vector<MountRequest>&, std::vector<bool>*),
+              (override));
+
   MOCK_METHOD(bool,
               SendUnmountAllCommand,
               (bool, const std::string&, std::vector<std::string>* paths),
@@ -26,6 +26,7 @@
 #include <base/files/file_util.h>
 #include <base/files/scoped_file.h>
 #include <base/logging.h>
+#include <base/posix/safe_strerror.h>
 #include <base/process/launch.h>
 #include <base/rand_util.h>
 #include <base/strings/string_number_conversions.h>
@@ -52,6 +53,26 @@ enum class MountStatus { FAIL, RETRY, SUCCESS };
 
 constexpr int GET_LOOP_DEVICE_MAX_RETRY = 5;
 
+// Size of the sectors dm-verity tables are expressed in.
+constexpr uint64_t kSectorSize = 512;
+
+// Starts reading the hash tree of the image into the page cache in the
+// background, so the first reads from the verity device don't all wait on the
+// disk for their hash blocks.
+void PrefetchHashTree(const base::ScopedFD& image_fd,
+                      const std::string& table) {
+  uint64_t hash_start;
+  if (!TableToHashStart(table, &hash_start))
+    return;
+  // The hash tree goes up to the end of the image.
+  int rc = posix_fadvise(image_fd.get(), hash_start * kSectorSize, 0,
+                         POSIX_FADV_WILLNEED);
+  if (rc != 0) {
+    LOG(WARNING) << "Failed to prefetch the hash tree: "
+                 << base::safe_strerror(rc);
+  }
+}
+
 // Fetches the device mapper table entry with the specified name and writes the
 // type and parameters into the provided pointers.
 // Returns true on success.
@@ -465,6 +486,7 @@ bool VerityMounter::Mount(const base::ScopedFD& image_fd,
     return false;
   }
 
+  PrefetchHashTree(image_fd, table);
   return true;
 }
 
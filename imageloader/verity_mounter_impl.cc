@@ -4,11 +4,13 @@
 
 #include "imageloader/verity_mounter_impl.h"
 
+#include <cstring>
 #include <vector>
 
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
 #include <base/strings/string_split.h>
+#include <base/strings/string_util.h>
 
 namespace imageloader {
 
@@ -34,6 +36,20 @@ bool MapperParametersToLoop(const std::string& verity_mount_parameters,
   return base::StringToInt(tokens[1], loop);
 }
 
+bool TableToHashStart(const std::string& table, uint64_t* hash_start) {
+  // Tables should be of the form:
+  // "0 8000 verity payload=ROOT_DEV hashtree=HASH_DEV hashstart=8000 ..."
+  constexpr char kHashStartKey[] = "hashstart=";
+  for (const auto& token : base::SplitStringPiece(
+           table, " \n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (base::StartsWith(token, kHashStartKey))
+      return base::StringToUint64(token.substr(strlen(kHashStartKey)),
+                                  hash_start);
+  }
+  LOG(ERROR) << "No hashstart in table";
+  return false;
+}
+
 bool IsAncestor(const base::FilePath& ancenstor,
                 const base::FilePath& descendant) {
   std::vector<std::string> ancenstor_components = ancenstor.GetComponents();
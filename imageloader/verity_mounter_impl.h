@@ -18,6 +18,11 @@ namespace imageloader {
 bool MapperParametersToLoop(const std::string& verity_mount_parameters,
                             int32_t* loop);
 
+// Parses the "hashstart" argument of a dm-verity table, which is the offset of
+// the hash tree in the image in 512 byte sectors.
+// Returns true on success.
+bool TableToHashStart(const std::string& table, uint64_t* hash_start);
+
 // Returns true if an ancestor-descendant relationship holds for the given
 // paths.
 bool IsAncestor(const base::FilePath& ancenstor,
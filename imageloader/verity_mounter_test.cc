@@ -24,6 +24,19 @@ TEST(VerityMounterTest, MapperParametersToLoop) {
   EXPECT_FALSE(MapperParametersToLoop("0 7:a 7:6", &loop));
 }
 
+TEST(VerityMounterTest, TableToHashStart) {
+  uint64_t hash_start = 0;
+  EXPECT_TRUE(TableToHashStart(
+      "0 8000 verity payload=ROOT_DEV hashtree=HASH_DEV hashstart=8000 "
+      "alg=sha256 root_hexdigest=d0ab1712e8c34b72be9b0f568fad8f95...",
+      &hash_start));
+  EXPECT_EQ(hash_start, 8000u);
+
+  EXPECT_FALSE(TableToHashStart("", &hash_start));
+  EXPECT_FALSE(TableToHashStart("0 8000 verity hashstart=", &hash_start));
+  EXPECT_FALSE(TableToHashStart("0 8000 verity hashstart=a", &hash_start));
+}
+
 TEST(VerityMounterTest, IsAncestor) {
   // Test valid case.
   const base::FilePath ancestor("/dev/mapper/");
@@ -13,19 +13,31 @@
 #include <unistd.h>
 
 #include <linux/fs.h>
+#include <linux/stat.h>
 
+#include <algorithm>
+#include <deque>
+#include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <base/check.h>
 #include <base/files/file_path.h>
 #include <base/files/scoped_file.h>
 #include <base/logging.h>
+#include <base/synchronization/condition_variable.h>
+#include <base/synchronization/lock.h>
+#include <base/system/sys_info.h>
+#include <base/threading/simple_thread.h>
 
 namespace file_attrs_cleaner {
 
 namespace {
 
+// Maximum number of threads scanning a directory tree.
+constexpr int kMaxScanThreads = 4;
+
 struct ScopedDirDeleter {
   inline void operator()(DIR* dirp) const {
     if (dirp)
@@ -64,11 +76,84 @@ AttributeCheckStatus CheckFileAttributes(const base::FilePath& path,
   return AttributeCheckStatus::NO_ATTR;
 }
 
-bool ScanDir(const base::FilePath& dir,
-             const std::vector<std::string>& skip_recurse) {
+namespace {
+
+// Scans a directory tree on a bounded pool of threads. Each thread takes a
+// directory from the queue, checks its entries and queues its subdirectories,
+// until no directory is left and all the threads are idle.
+class DirScanner : public base::DelegateSimpleThread::Delegate {
+ public:
+  DirScanner(const base::FilePath& dir,
+             const std::vector<std::string>& skip_recurse)
+      : skip_recurse_(skip_recurse), cv_(&lock_) {
+    pending_.push_back(dir);
+  }
+  DirScanner(const DirScanner&) = delete;
+  DirScanner& operator=(const DirScanner&) = delete;
+  ~DirScanner() override = default;
+
+  bool Scan() {
+    // Leave some CPUs to the rest of the boot.
+    const int num_threads = std::clamp(base::SysInfo::NumberOfProcessors() / 2,
+                                       1, kMaxScanThreads);
+    base::DelegateSimpleThreadPool pool("file_attrs_cleaner", num_threads);
+    pool.Start();
+    pool.AddWork(this, num_threads);
+    pool.JoinAll();
+    return ret_;
+  }
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override {
+    while (true) {
+      base::FilePath dir;
+      {
+        base::AutoLock lock(lock_);
+        while (pending_.empty() && busy_ > 0)
+          cv_.Wait();
+        if (pending_.empty())
+          return;
+        dir = std::move(pending_.front());
+        pending_.pop_front();
+        busy_++;
+      }
+
+      std::vector<base::FilePath> subdirs;
+      bool ret = ScanOneDir(dir, &subdirs);
+
+      base::AutoLock lock(lock_);
+      busy_--;
+      ret_ &= ret;
+      pending_.insert(pending_.end(), std::make_move_iterator(subdirs.begin()),
+                      std::make_move_iterator(subdirs.end()));
+      // Wake up the idle threads, either to scan the new subdirectories or to
+      // exit if the scan is over.
+      cv_.Broadcast();
+    }
+  }
+
+ private:
+  // Checks the file attributes of |dir| and the files in it, and appends its
+  // subdirectories to |subdirs|.
+  bool ScanOneDir(const base::FilePath& dir,
+                  std::vector<base::FilePath>* subdirs);
+
+  const std::vector<std::string>& skip_recurse_;
+
+  base::Lock lock_;
+  // Signalled when directories are queued or a thread becomes idle.
+  base::ConditionVariable cv_;
+  std::deque<base::FilePath> pending_;
+  // Number of threads scanning a directory.
+  int busy_ = 0;
+  bool ret_ = true;
+};
+
+bool DirScanner::ScanOneDir(const base::FilePath& dir,
+                            std::vector<base::FilePath>* subdirs) {
   // Internally glibc will use O_CLOEXEC when opening the directory.
-  // Unfortunately, there is no opendirat() helper we could use (so that ScanDir
-  // could accept a fd argument).
+  // Unfortunately, there is no opendirat() helper we could use (so that the
+  // scanner could queue fds of subdirectories).
   //
   // We could use openat() ourselves and pass that to fdopendir(), but that has
   // two downsides: (1) We can't use ScopedFD because opendir() will take over
@@ -80,8 +165,8 @@ bool ScanDir(const base::FilePath& dir,
   // Along those lines, we could dup() the fd passed in, but that would also add
   // syscall overhead with no real benefit.
   //
-  // So unless we change the signature of ScanDir to take a fd of the open dir
-  // to scan, we stick with opendir() here.  Since this program only runs during
+  // So unless we change the scanner to pass fds of the open dirs around, we
+  // stick with opendir() here.  Since this program only runs during
   // early OS init, there shouldn't be other programs in the system racing with
   // us to cause problems.
 
@@ -107,7 +192,6 @@ bool ScanDir(const base::FilePath& dir,
   // Scan all the entries in this directory.
   bool ret = true;
   struct dirent* de;
-  std::vector<base::FilePath> subdirs;
   while ((de = readdir(dirp.get())) != nullptr) {
     CHECK(de->d_type != DT_UNKNOWN);
 
@@ -121,8 +205,8 @@ bool ScanDir(const base::FilePath& dir,
       continue;
 
     // If the path component is listed in |skip_recurse|, skip it.
-    if (std::find(skip_recurse.begin(), skip_recurse.end(), name) !=
-        skip_recurse.end())
+    if (std::find(skip_recurse_.begin(), skip_recurse_.end(), name) !=
+        skip_recurse_.end())
       continue;
 
     const base::FilePath path = dir.Append(de->d_name);
@@ -157,10 +241,20 @@ bool ScanDir(const base::FilePath& dir,
         // directory open for that long causes problems if the tool is still
         // running when a user logs in. This can happen if the user has a lot of
         // files in their home directory.
-        subdirs.push_back(path);
+        subdirs->push_back(path);
         break;
       }
       case DT_REG: {
+        // Most files have no attribute set, which statx() tells without
+        // opening them.
+        struct statx stx;
+        if (statx(dfd, de->d_name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT, 0,
+                  &stx) == 0 &&
+            (stx.stx_attributes_mask & STATX_ATTR_IMMUTABLE) &&
+            !(stx.stx_attributes & STATX_ATTR_IMMUTABLE)) {
+          break;
+        }
+
         // Check the settings on this file.
         base::ScopedFD fd(openat(
             dfd, de->d_name, O_RDONLY | O_NONBLOCK | O_NOFOLLOW | O_CLOEXEC));
@@ -203,4 +297,11 @@ bool ScanDir(const base::FilePath& dir,
   return ret;
 }
 
+}  // namespace
+
+bool ScanDir(const base::FilePath& dir,
+             const std::vector<std::string>& skip_recurse) {
+  return DirScanner(dir, skip_recurse).Scan();
+}
+
 }  // namespace file_attrs_cleaner
@@ -193,6 +193,34 @@ TEST_F(ScanDirTest, Nested) {
   EXPECT_TRUE(ScanDir(test_dir_, {}));
 }
 
+// Directories are scanned concurrently, make sure the whole tree is covered.
+TEST_F(ScanDirTest, ClearNestedFiles) {
+  base::FilePath dir = test_dir_;
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++)
+      EXPECT_TRUE(
+          base::CreateDirectory(dir.Append("sibling" + std::to_string(j))));
+    dir = dir.Append("dir");
+  }
+  const base::FilePath path = dir.Append("file");
+  ASSERT_TRUE(CreateFile(path, ""));
+
+  base::ScopedFD fd(open(path.value().c_str(), O_RDONLY | O_CLOEXEC));
+  ASSERT_TRUE(fd.is_valid());
+  long flags;  // NOLINT(runtime/int)
+  ASSERT_EQ(0, ioctl(fd.get(), FS_IOC_GETFLAGS, &flags));
+  flags |= FS_IMMUTABLE_FL;
+  if (ioctl(fd.get(), FS_IOC_SETFLAGS, &flags) != 0) {
+    // Setting file attributes requires privileges, only check the scan itself.
+    EXPECT_TRUE(ScanDir(test_dir_, {}));
+    return;
+  }
+
+  EXPECT_TRUE(ScanDir(test_dir_, {}));
+  ASSERT_EQ(0, ioctl(fd.get(), FS_IOC_GETFLAGS, &flags));
+  EXPECT_FALSE(flags & FS_IMMUTABLE_FL);
+}
+
 TEST_F(ScanDirTest, InvalidDirSucceeds) {
   const base::FilePath subdir(
       test_dir_.Append("this_dir_definitely_does_not_exist"));
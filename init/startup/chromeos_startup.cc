@@ -17,6 +17,7 @@
 #include <base/files/file_enumerator.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
+#include <base/functional/bind.h>
 #include <base/logging.h>
 #include <base/strings/string_split.h>
 #include <brillo/blkdev_utils/lvm.h>
@@ -37,6 +38,7 @@
 #include "init/startup/platform_impl.h"
 #include "init/startup/security_manager.h"
 #include "init/startup/standard_mount_helper.h"
+#include "init/startup/startup_stages.h"
 #include "init/startup/stateful_mount.h"
 #include "init/startup/test_mode_mount_helper.h"
 #include "init/startup/uefi_startup.h"
@@ -121,6 +123,14 @@ const std::array<const char*, 4> kPreserveDirs = {
     "usr/local/etc/wifi_creds",
 };
 
+// Unlocks the encrypted reboot vault, or creates it again if it cannot be
+// unlocked (due to power loss/reboot/invalid vault).
+void SetupEncryptedRebootVault() {
+  if (!utils::UnlockEncryptedRebootVault()) {
+    utils::CreateEncryptedRebootVault();
+  }
+}
+
 }  // namespace
 
 namespace startup {
@@ -708,18 +718,28 @@ int ChromeosStartup::Run() {
 
   CheckForStatefulWipe();
 
+  StartupStages stateful_stages(&bootstat_);
   // Cleanup the file attributes in the unencrypted stateful directory.
   base::FilePath unencrypted = stateful_.Append(kUnencrypted);
-  ForceCleanFileAttrs(unencrypted);
-
+  stateful_stages.Add("clean-unencrypted-attrs", {},
+                      base::BindOnce(&ChromeosStartup::ForceCleanFileAttrs,
+                                     base::Unretained(this), unencrypted));
+  // tmpfiles.d changes the owner of files in the unencrypted directory, which
+  // fails on immutable ones.
   std::vector<std::string> tmpfiles = {stateful_.value()};
-  TmpfilesConfiguration(tmpfiles);
-
-  MountHome();
-
-  StartTpm2Simulator();
-
-  CleanupTpm();
+  stateful_stages.Add("stateful-tmpfiles", {"clean-unencrypted-attrs"},
+                      base::BindOnce(&ChromeosStartup::TmpfilesConfiguration,
+                                     base::Unretained(this), tmpfiles));
+  stateful_stages.Add("mount-home", {"stateful-tmpfiles"},
+                      base::BindOnce(&ChromeosStartup::MountHome,
+                                     base::Unretained(this)));
+  stateful_stages.Add("start-tpm2-simulator", {"stateful-tmpfiles"},
+                      base::BindOnce(&ChromeosStartup::StartTpm2Simulator,
+                                     base::Unretained(this)));
+  stateful_stages.Add("cleanup-tpm", {"start-tpm2-simulator"},
+                      base::BindOnce(&ChromeosStartup::CleanupTpm,
+                                     base::Unretained(this)));
+  stateful_stages.Run();
 
   base::FilePath encrypted_failed = stateful_.Append(kMountEncryptedFailedFile);
   struct stat stbuf;
@@ -739,18 +759,21 @@ int ChromeosStartup::Run() {
   base::FilePath encrypted_state_mnt = stateful_.Append(kEncryptedStatefulMnt);
   mount_helper_->RememberMount(encrypted_state_mnt);
 
+  StartupStages var_stages(&bootstat_);
   // Setup the encrypted reboot vault once the encrypted stateful partition
-  // is available. If unlocking the encrypted reboot vault failed (due to
-  // power loss/reboot/invalid vault), attempt to recreate the encrypted reboot
-  // vault.
+  // is available.
   if (flags_.encrypted_reboot_vault) {
-    if (!utils::UnlockEncryptedRebootVault()) {
-      utils::CreateEncryptedRebootVault();
-    }
-  }
-
-  ForceCleanFileAttrs(root_.Append(kVar));
-  ForceCleanFileAttrs(root_.Append(kHome).Append(kChronos));
+    var_stages.Add("reboot-vault", {},
+                   base::BindOnce(&SetupEncryptedRebootVault));
+  }
+  var_stages.Add("clean-var-attrs", {},
+                 base::BindOnce(&ChromeosStartup::ForceCleanFileAttrs,
+                                base::Unretained(this), root_.Append(kVar)));
+  const base::FilePath home_chronos = root_.Append(kHome).Append(kChronos);
+  var_stages.Add("clean-home-chronos-attrs", {},
+                 base::BindOnce(&ChromeosStartup::ForceCleanFileAttrs,
+                                base::Unretained(this), home_chronos));
+  var_stages.Run();
 
   // If /var is too full, delete the logs so the device can boot successfully.
   // It is possible that the fullness of /var was not due to logs, but that
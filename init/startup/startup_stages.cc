@@ -0,0 +1,131 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "init/startup/startup_stages.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <base/check.h>
+#include <base/containers/contains.h>
+#include <base/threading/simple_thread.h>
+
+namespace startup {
+
+class StartupStages::Stage : public base::DelegateSimpleThread::Delegate {
+ public:
+  Stage(StartupStages* stages,
+        const std::string& name,
+        std::vector<Stage*> deps,
+        base::OnceClosure task)
+      : stages_(stages),
+        name_(name),
+        deps_(std::move(deps)),
+        task_(std::move(task)) {}
+  Stage(const Stage&) = delete;
+  Stage& operator=(const Stage&) = delete;
+  ~Stage() override = default;
+
+  bool CanStart() const {
+    if (thread_ || done_)
+      return false;
+    for (const Stage* dep : deps_) {
+      if (!dep->done_)
+        return false;
+    }
+    return true;
+  }
+
+  void Start() {
+    thread_ = std::make_unique<base::DelegateSimpleThread>(this, name_);
+    thread_->Start();
+  }
+
+  // Waits for the thread of the stage to exit, once the stage is done.
+  void Join() {
+    thread_->Join();
+    thread_.reset();
+    done_ = true;
+  }
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override {
+    stages_->bootstat_->LogEvent("pre-" + name_);
+    std::move(task_).Run();
+    stages_->bootstat_->LogEvent("post-" + name_);
+    stages_->OnStageDone(this);
+  }
+
+ private:
+  StartupStages* const stages_;
+  const std::string name_;
+  const std::vector<Stage*> deps_;
+  base::OnceClosure task_;
+
+  // Only accessed on the thread running StartupStages::Run().
+  std::unique_ptr<base::DelegateSimpleThread> thread_;
+  bool done_ = false;
+};
+
+StartupStages::StartupStages(const bootstat::BootStat* bootstat)
+    : bootstat_(bootstat), stage_done_(&lock_) {}
+
+StartupStages::~StartupStages() = default;
+
+void StartupStages::Add(const std::string& name,
+                        const std::vector<std::string>& deps,
+                        base::OnceClosure task) {
+  CHECK(!base::Contains(stages_by_name_, name)) << "Duplicate stage " << name;
+
+  std::vector<Stage*> dep_stages;
+  for (const std::string& dep : deps) {
+    auto it = stages_by_name_.find(dep);
+    CHECK(it != stages_by_name_.end())
+        << "Stage " << name << " depends on unknown stage " << dep;
+    dep_stages.push_back(it->second);
+  }
+
+  stages_.push_back(std::make_unique<Stage>(this, name, std::move(dep_stages),
+                                            std::move(task)));
+  stages_by_name_[name] = stages_.back().get();
+}
+
+void StartupStages::Run() {
+  size_t running = 0;
+  size_t remaining = stages_.size();
+  while (remaining > 0) {
+    for (const auto& stage : stages_) {
+      if (stage->CanStart()) {
+        stage->Start();
+        running++;
+      }
+    }
+    // Dependencies always point to earlier stages, so one can always start
+    // while some remain.
+    DCHECK_GT(running, 0u);
+
+    std::vector<Stage*> done_stages;
+    {
+      base::AutoLock lock(lock_);
+      while (done_stages_.empty())
+        stage_done_.Wait();
+      done_stages.swap(done_stages_);
+    }
+    for (Stage* stage : done_stages) {
+      stage->Join();
+      running--;
+      remaining--;
+    }
+  }
+}
+
+void StartupStages::OnStageDone(Stage* stage) {
+  base::AutoLock lock(lock_);
+  done_stages_.push_back(stage);
+  stage_done_.Signal();
+}
+
+}  // namespace startup
@@ -0,0 +1,64 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef INIT_STARTUP_STARTUP_STAGES_H_
+#define INIT_STARTUP_STARTUP_STAGES_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <base/functional/callback.h>
+#include <base/synchronization/condition_variable.h>
+#include <base/synchronization/lock.h>
+#include <metrics/bootstat.h>
+
+namespace startup {
+
+// Runs the stages of startup which do not depend on each other concurrently,
+// to take them off the boot critical path. Each stage declares the stages it
+// depends on, and only starts once they all completed.
+//
+// The start and the end of each stage are recorded with bootstat, as the
+// "pre-<name>" and "post-<name>" events, to measure their duration across the
+// fleet.
+class StartupStages {
+ public:
+  explicit StartupStages(const bootstat::BootStat* bootstat);
+  StartupStages(const StartupStages&) = delete;
+  StartupStages& operator=(const StartupStages&) = delete;
+  ~StartupStages();
+
+  // Adds the stage |name|, running |task| once all the stages in |deps| are
+  // done. Stages can only depend on the ones added before them, which rules
+  // out dependency cycles.
+  void Add(const std::string& name,
+           const std::vector<std::string>& deps,
+           base::OnceClosure task);
+
+  // Runs all the stages, each on its own thread, and returns once they are
+  // all done.
+  void Run();
+
+ private:
+  class Stage;
+
+  // Called on the thread of |stage| once its task returns.
+  void OnStageDone(Stage* stage);
+
+  const bootstat::BootStat* const bootstat_;
+  std::vector<std::unique_ptr<Stage>> stages_;
+  std::map<std::string, Stage*> stages_by_name_;
+
+  base::Lock lock_;
+  // Signalled when a stage is done.
+  base::ConditionVariable stage_done_;
+  // Stages done whose thread was not joined yet.
+  std::vector<Stage*> done_stages_;
+};
+
+}  // namespace startup
+
+#endif  // INIT_STARTUP_STARTUP_STAGES_H_
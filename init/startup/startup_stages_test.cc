@@ -0,0 +1,98 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "init/startup/startup_stages.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/functional/bind.h>
+#include <base/synchronization/lock.h>
+#include <base/synchronization/waitable_event.h>
+#include <base/test/test_timeouts.h>
+#include <gtest/gtest.h>
+#include <metrics/bootstat.h>
+
+namespace startup {
+
+class StartupStagesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    bootstat_ = std::make_unique<bootstat::BootStat>(
+        temp_dir_.GetPath(), std::make_unique<bootstat::BootStatSystem>());
+  }
+
+  base::OnceClosure Record(const std::string& name) {
+    return base::BindOnce(
+        [](base::Lock* lock, std::vector<std::string>* order,
+           const std::string& name) {
+          base::AutoLock auto_lock(*lock);
+          order->push_back(name);
+        },
+        &lock_, &order_, name);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<bootstat::BootStat> bootstat_;
+  base::Lock lock_;
+  std::vector<std::string> order_;
+};
+
+TEST_F(StartupStagesTest, DependenciesRunFirst) {
+  StartupStages stages(bootstat_.get());
+  stages.Add("a", {}, Record("a"));
+  stages.Add("b", {"a"}, Record("b"));
+  stages.Add("c", {"b"}, Record("c"));
+  stages.Add("d", {"a", "c"}, Record("d"));
+  stages.Run();
+
+  EXPECT_EQ(order_, (std::vector<std::string>{"a", "b", "c", "d"}));
+}
+
+TEST_F(StartupStagesTest, IndependentStagesRunConcurrently) {
+  base::WaitableEvent a_started;
+  base::WaitableEvent b_started;
+  bool a_saw_b = false;
+  bool b_saw_a = false;
+
+  // Each stage waits for the other one to start, which only happens if they
+  // run at the same time.
+  auto wait_for_other = [](base::WaitableEvent* started,
+                           base::WaitableEvent* other_started, bool* saw) {
+    started->Signal();
+    *saw = other_started->TimedWait(TestTimeouts::action_timeout());
+  };
+  StartupStages stages(bootstat_.get());
+  stages.Add("a", {},
+             base::BindOnce(wait_for_other, &a_started, &b_started, &a_saw_b));
+  stages.Add("b", {},
+             base::BindOnce(wait_for_other, &b_started, &a_started, &b_saw_a));
+  stages.Add("c", {"a", "b"}, Record("c"));
+  stages.Run();
+
+  EXPECT_TRUE(a_saw_b);
+  EXPECT_TRUE(b_saw_a);
+  EXPECT_EQ(order_, std::vector<std::string>{"c"});
+}
+
+TEST_F(StartupStagesTest, LogBootstatEvents) {
+  StartupStages stages(bootstat_.get());
+  stages.Add("foo", {}, Record("foo"));
+  stages.Run();
+
+  EXPECT_TRUE(base::PathExists(temp_dir_.GetPath().Append("uptime-pre-foo")));
+  EXPECT_TRUE(base::PathExists(temp_dir_.GetPath().Append("uptime-post-foo")));
+}
+
+TEST_F(StartupStagesTest, NoStages) {
+  StartupStages stages(bootstat_.get());
+  stages.Run();
+  EXPECT_TRUE(order_.empty());
+}
+
+}  // namespace startup
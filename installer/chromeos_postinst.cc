@@ -21,6 +21,7 @@
 #include <base/logging.h>
 #include <base/strings/strcat.h>
 #include <base/strings/string_util.h>
+#include <base/threading/simple_thread.h>
 
 #include "installer/cgpt_manager.h"
 #include "installer/chromeos_install_config.h"
@@ -58,6 +59,40 @@ bool GetKernelCommandLine(string* kernel_cmd_line) {
   }
   return true;
 }
+
+// Extracts the FSPM of the current firmware on a background thread, since
+// reading the flash takes a while and doesn't depend on the new image. The
+// extraction is waited for, and the FSPM file deleted, on destruction.
+class PreFwUpdateTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  PreFwUpdateTask() : thread_(this, "pre_fw_update") {
+    if (CreateTemporaryFile(&fspm_main_))
+      thread_.Start();
+  }
+  PreFwUpdateTask(const PreFwUpdateTask&) = delete;
+  PreFwUpdateTask& operator=(const PreFwUpdateTask&) = delete;
+
+  ~PreFwUpdateTask() override {
+    Wait();
+    if (!fspm_main_.empty())
+      base::DeleteFile(fspm_main_);
+  }
+
+  // Waits for the extraction to finish.
+  void Wait() {
+    if (thread_.HasBeenStarted() && !thread_.HasBeenJoined())
+      thread_.Join();
+  }
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override { SlowBootNotifyPreFwUpdate(fspm_main_); }
+
+  const base::FilePath& fspm_main() const { return fspm_main_; }
+
+ private:
+  base::FilePath fspm_main_;
+  base::DelegateSimpleThread thread_;
+};
 }  // namespace
 
 bool ConfigureInstall(const base::FilePath& install_dev,
@@ -558,6 +593,28 @@ bool ChromeosChrootPostinst(const InstallConfig& install_config,
   bool is_update = !is_factory_install && !is_recovery_install && !is_install &&
                    !IsRunningMiniOS();
 
+  // Use `--force_update_firmware` to bypass this tag check.
+  base::FilePath firmware_tag_file =
+      install_config.root.mount().Append("root/.force_update_firmware");
+
+  bool attempt_firmware_update =
+      (!is_factory_install && base::PathExists(firmware_tag_file));
+
+  if (install_config.force_update_firmware) {
+    if (attempt_firmware_update) {
+      LOG(INFO) << "Firmware update is already set to be attempted.";
+    } else {
+      LOG(INFO) << "Forcing the firmware update.";
+    }
+    attempt_firmware_update = true;
+  }
+
+  // Overlap extracting the FSPM of the current firmware with setting up the
+  // new image.
+  std::unique_ptr<PreFwUpdateTask> pre_fw_update;
+  if (attempt_firmware_update)
+    pre_fw_update = std::make_unique<PreFwUpdateTask>();
+
   switch (install_config.defer_update_action) {
     case DeferUpdateAction::kAuto:
     case DeferUpdateAction::kHold: {
@@ -697,28 +754,11 @@ bool ChromeosChrootPostinst(const InstallConfig& install_config,
       break;
   }
 
-  // Use `--force_update_firmware` to bypass this tag check.
-  base::FilePath firmware_tag_file =
-      install_config.root.mount().Append("root/.force_update_firmware");
-
-  bool attempt_firmware_update =
-      (!is_factory_install && base::PathExists(firmware_tag_file));
-
-  if (install_config.force_update_firmware) {
-    if (attempt_firmware_update) {
-      LOG(INFO) << "Firmware update is already set to be attempted.";
-    } else {
-      LOG(INFO) << "Forcing the firmware update.";
-    }
-    attempt_firmware_update = true;
-  }
-
   // In factory process, firmware is either pre-flashed or assigned by
   // mini-omaha server, and we don't want to try updates inside postinst.
   if (attempt_firmware_update) {
-    base::FilePath fspm_main;
-    if (CreateTemporaryFile(&fspm_main))
-      SlowBootNotifyPreFwUpdate(fspm_main);
+    // The firmware about to be replaced must have been read first.
+    pre_fw_update->Wait();
 
     *exit_code = FirmwareUpdate(install_config, is_update);
     if (*exit_code == 0) {
@@ -726,18 +766,15 @@ bool ChromeosChrootPostinst(const InstallConfig& install_config,
       if (CreateTemporaryFile(&fspm_next))
         SlowBootNotifyPostFwUpdate(fspm_next);
 
-      if (SlowBootNotifyRequired(fspm_main, fspm_next)) {
+      if (SlowBootNotifyRequired(pre_fw_update->fspm_main(), fspm_next)) {
         base::FilePath slow_boot_req_file(string(kStatefulMount) +
                                           "/etc/slow_boot_required");
         if (WriteFile(slow_boot_req_file, "1", 1) != 1)
           PLOG(ERROR) << "Unable to write to file:"
                       << slow_boot_req_file.value();
       }
-      base::DeleteFile(fspm_main);
       base::DeleteFile(fspm_next);
     } else {
-      base::DeleteFile(fspm_main);
-
       LOG(INFO)
           << "Rolling back update due to failure calling firmware updater";
       // Note: This will only rollback the ChromeOS verified boot target.
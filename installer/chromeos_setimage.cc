@@ -8,11 +8,13 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <vector>
 
 #include <base/logging.h>
 #include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
+#include <base/system/sys_info.h>
 #include <verity/dm-bht.h>
 
 #include "installer/chromeos_install_config.h"
@@ -21,6 +23,13 @@
 
 using std::string;
 
+namespace {
+
+// Maximum number of threads hashing the root filesystem.
+constexpr int kMaxVerityThreads = 4;
+
+}  // namespace
+
 //
 // There is nothing in our codebase that calls chromeos-setimage,
 // except for post install, so only it's use case is required
@@ -107,13 +116,16 @@ bool SetImage(const InstallConfig& install_config) {
   if (!enable_rootfs_verification)
     MakeFileSystemRw(install_config.root.device());
 
-  LOG(INFO) << "Setting up verity.";
+  // Leave some CPUs to the user while the update is applied.
+  const int num_threads = std::clamp(base::SysInfo::NumberOfProcessors() / 2, 1,
+                                     kMaxVerityThreads);
+  LOG(INFO) << "Setting up verity on " << num_threads << " thread(s).";
   LoggingTimerStart();
   verity::DmBht bht;
-  int result = chromeos_verity(&bht, verity_algorithm,
-                               install_config.root.device(), getpagesize(),
-                               (uint64_t)(atoi(rootfs_sectors.c_str()) / 8),
-                               salt, expected_hash, enable_rootfs_verification);
+  int result = chromeos_verity(
+      &bht, verity_algorithm, install_config.root.device(), getpagesize(),
+      (uint64_t)(atoi(rootfs_sectors.c_str()) / 8), salt, expected_hash,
+      enable_rootfs_verification, num_threads);
   LoggingTimerFinish();
 
   return result == 0;
@@ -19,17 +19,21 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 
+#include <base/files/file.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
 #include <base/files/scoped_file.h>
+#include <base/functional/bind.h>
 #include <base/logging.h>
 #include <base/memory/aligned_memory.h>
 #include <base/scoped_generic.h>
 #include <base/strings/string_number_conversions.h>
 #include <verity/dm-bht.h>
+#include <verity/range_hasher.h>
 
 namespace {
 
@@ -189,6 +193,42 @@ struct ScopedDmBhtDestroyTraits {
 typedef base::ScopedGeneric<struct verity::dm_bht*, ScopedDmBhtDestroyTraits>
     ScopedDmBht;
 
+// Reads |count| blocks from |first| of |file| and stores their hashes in
+// |bht|, IO_BUF_SIZE at a time.
+bool StoreBlocks(verity::DmBhtInterface* bht,
+                 base::File* file,
+                 unsigned blocksize,
+                 uint32_t first,
+                 uint32_t count) {
+  std::unique_ptr<uint8_t, base::AlignedFreeDeleter> io_buffer(
+      static_cast<uint8_t*>(base::AlignedAlloc(IO_BUF_SIZE, blocksize)));
+  if (!io_buffer) {
+    PLOG(ERROR) << "aligned_alloc io_buffer failed";
+    return false;
+  }
+
+  const uint64_t end = uint64_t{first} + count;
+  uint64_t cur_block = first;
+  while (cur_block < end) {
+    const int size = std::min((end - cur_block) * blocksize, IO_BUF_SIZE);
+    if (file->Read(cur_block * blocksize,
+                   reinterpret_cast<char*>(io_buffer.get()), size) != size) {
+      PLOG(ERROR) << "read returned error";
+      return false;
+    }
+
+    for (unsigned int i = 0; i < size / blocksize; i++) {
+      int ret = bht->StoreBlock(cur_block, io_buffer.get() + (i * blocksize));
+      if (ret) {
+        LOG(ERROR) << "dm_bht_store_block returned error: " << ret;
+        return false;
+      }
+      cur_block++;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 int chromeos_verity(verity::DmBhtInterface* bht,
@@ -198,7 +238,13 @@ int chromeos_verity(verity::DmBhtInterface* bht,
                     uint64_t fs_blocks,
                     const std::string& salt,
                     const std::string& expected,
-                    bool enforce_rootfs_verification) {
+                    bool enforce_rootfs_verification,
+                    unsigned num_threads) {
+  if (fs_blocks > std::numeric_limits<uint32_t>::max()) {
+    LOG(ERROR) << "Too many blocks: " << fs_blocks;
+    return -1;
+  }
+
   int ret;
   if ((ret = bht->Create(fs_blocks, alg))) {
     LOG(ERROR) << "dm_bht_create failed: " << ret;
@@ -206,12 +252,6 @@ int chromeos_verity(verity::DmBhtInterface* bht,
   }
 
   DCHECK(IO_BUF_SIZE % blocksize == 0) << "Alignment mismatch";
-  std::unique_ptr<uint8_t, base::AlignedFreeDeleter> io_buffer(
-      static_cast<uint8_t*>(base::AlignedAlloc(IO_BUF_SIZE, blocksize)));
-  if (!io_buffer) {
-    PLOG(ERROR) << "aligned_alloc io_buffer failed";
-    return errno;
-  }
 
   // We aren't going to do any automatic reading.
   bht->SetReadCallback(verity::dm_bht_zeroread_callback);
@@ -229,35 +269,20 @@ int chromeos_verity(verity::DmBhtInterface* bht,
   memset(hash_buffer.get(), 0, hash_size);
   bht->SetBuffer(hash_buffer.get());
 
-  base::ScopedFD fd(
-      HANDLE_EINTR(open(device.value().c_str(), O_RDONLY | O_CLOEXEC)));
-  if (!fd.is_valid()) {
+  base::File file(device, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
     PLOG(ERROR) << "error opening " << device;
     return errno;
   }
 
-  uint64_t cur_block = 0;
-  while (cur_block < fs_blocks) {
-    unsigned int i;
-    size_t count = std::min((fs_blocks - cur_block) * blocksize, IO_BUF_SIZE);
-
-    if (!base::ReadFromFD(fd.get(), reinterpret_cast<char*>(io_buffer.get()),
-                          count)) {
-      PLOG(ERROR) << "read returned error";
-      return -1;
-    }
-
-    for (i = 0; i < (count / blocksize); i++) {
-      ret = bht->StoreBlock(cur_block, io_buffer.get() + (i * blocksize));
-      if (ret) {
-        LOG(ERROR) << "dm_bht_store_block returned error: " << ret;
-        return ret;
-      }
-      cur_block++;
-    }
+  // The blocks are hashed into disjoint leaves of the tree, so the threads
+  // only need their own IO buffer.
+  if (!verity::HashInRanges(
+          fs_blocks, num_threads,
+          base::BindRepeating(&StoreBlocks, bht, &file, blocksize))) {
+    return -1;
   }
-  io_buffer.reset();
-  fd.reset();
+  file.Close();
 
   if ((ret = bht->Compute())) {
     LOG(ERROR) << "dm_bht_compute returned error: " << ret;
@@ -279,7 +304,7 @@ int chromeos_verity(verity::DmBhtInterface* bht,
   }
 
   ssize_t written =
-      WriteHash(device, hash_buffer.get(), hash_size, cur_block * blocksize);
+      WriteHash(device, hash_buffer.get(), hash_size, fs_blocks * blocksize);
   if (written < static_cast<ssize_t>(hash_size)) {
     PLOG(ERROR) << "Writing out hash failed: written" << written
                 << ", expected %d" << hash_size;
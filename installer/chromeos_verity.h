@@ -26,6 +26,7 @@
  * @expected - ascii string with the exptected final root hash value
  * @enforce_rootfs_verification - bool indicating whether we should complain if
  *   expected doesn't matchp
+ * @num_threads - number of threads reading and hashing the blocks of the fs
  * return - 0 for success, non-zero indicates failure
  *
  */
@@ -36,6 +37,7 @@ int chromeos_verity(verity::DmBhtInterface* bht,
                     uint64_t fs_blocks,
                     const std::string& salt,
                     const std::string& expected,
-                    bool enforce_rootfs_verification);
+                    bool enforce_rootfs_verification,
+                    unsigned num_threads);
 
 #endif  // INSTALLER_CHROMEOS_VERITY_H_
@@ -47,7 +47,8 @@ TEST_F(ChromeOSVerityTest, VerityTest) {
                                /*fs_blocks=*/kNumBlocks,
                                /*salt=*/"",
                                /*expected=*/"",
-                               /*enforce_rootfs_verification=*/false));
+                               /*enforce_rootfs_verification=*/false,
+                               /*num_threads=*/1));
 }
 
 TEST_F(ChromeOSVerityTest, VerityMultiplePageTest) {
@@ -69,7 +70,56 @@ TEST_F(ChromeOSVerityTest, VerityMultiplePageTest) {
                                /*fs_blocks=*/kNumBlocks,
                                /*salt=*/"",
                                /*expected=*/"",
-                               /*enforce_rootfs_verification=*/false));
+                               /*enforce_rootfs_verification=*/false,
+                               /*num_threads=*/1));
+}
+
+TEST_F(ChromeOSVerityTest, VerityMultipleThreadsTest) {
+  base::FilePath device = scoped_temp_dir_.GetPath().Append("device");
+
+  // Create device bits, with blocks split unevenly between the threads.
+  constexpr int kBlockSize = PAGE_SIZE / 8;
+  constexpr int kNumBlocks = 1027;
+  std::vector<char> buf(kBlockSize * kNumBlocks);
+
+  EXPECT_CALL(mock_bht_, Sectors()).WillOnce(Return(1));
+  for (unsigned int block = 0; block < kNumBlocks; block++)
+    EXPECT_CALL(mock_bht_, StoreBlock(block, _)).Times(1);
+
+  brillo::WriteToFile(device, buf.data(), buf.size());
+  EXPECT_EQ(0, chromeos_verity(&mock_bht_,
+                               /*alg=*/"",
+                               /*device=*/device,
+                               /*blocksize=*/kBlockSize,
+                               /*fs_blocks=*/kNumBlocks,
+                               /*salt=*/"",
+                               /*expected=*/"",
+                               /*enforce_rootfs_verification=*/false,
+                               /*num_threads=*/4));
+}
+
+TEST_F(ChromeOSVerityTest, VerityStoreBlockFailureTest) {
+  base::FilePath device = scoped_temp_dir_.GetPath().Append("device");
+
+  constexpr int kBlockSize = PAGE_SIZE / 8;
+  constexpr int kNumBlocks = 64;
+  std::vector<char> buf(kBlockSize * kNumBlocks);
+
+  EXPECT_CALL(mock_bht_, Sectors()).WillOnce(Return(1));
+  EXPECT_CALL(mock_bht_, StoreBlock(_, _)).WillRepeatedly(Return(0));
+  EXPECT_CALL(mock_bht_, StoreBlock(40, _)).WillOnce(Return(1));
+  EXPECT_CALL(mock_bht_, Compute()).Times(0);
+
+  brillo::WriteToFile(device, buf.data(), buf.size());
+  EXPECT_NE(0, chromeos_verity(&mock_bht_,
+                               /*alg=*/"",
+                               /*device=*/device,
+                               /*blocksize=*/kBlockSize,
+                               /*fs_blocks=*/kNumBlocks,
+                               /*salt=*/"",
+                               /*expected=*/"",
+                               /*enforce_rootfs_verification=*/false,
+                               /*num_threads=*/2));
 }
 
 }  // namespace verity
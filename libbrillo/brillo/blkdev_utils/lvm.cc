@@ -247,6 +247,18 @@ std::optional<LogicalVolume> LogicalVolumeManager::CreateLogicalVolume(
              : std::nullopt;
 }
 
+bool LogicalVolumeManager::ActivateLogicalVolumes(
+    const VolumeGroup& vg, const std::vector<std::string>& lv_names) {
+  if (lv_names.empty())
+    return true;
+
+  std::vector<std::string> cmd = {"lvchange", "-ay"};
+  for (const auto& lv_name : lv_names)
+    cmd.push_back(vg.GetName() + "/" + lv_name);
+
+  return lvm_->RunCommand(cmd);
+}
+
 bool LogicalVolumeManager::RemoveLogicalVolume(const VolumeGroup& vg,
                                                const std::string& lv_name) {
   std::optional<LogicalVolume> lv = GetLogicalVolume(vg, lv_name);
@@ -68,6 +68,11 @@ class BRILLO_EXPORT LogicalVolumeManager {
       const Thinpool& thinpool,
       const base::Value::Dict& config);
 
+  // Activates the logical volumes |lv_names| of volume group |vg| with a
+  // single command. Activating an already active logical volume has no effect.
+  virtual bool ActivateLogicalVolumes(const VolumeGroup& vg,
+                                      const std::vector<std::string>& lv_names);
+
   // Removes a logical volume, if it exists. Returns false if the logical volume
   // exists and failed removal.
   virtual bool RemoveLogicalVolume(const VolumeGroup& vg,
@@ -326,7 +326,13 @@ bool Thinpool::GetFreeSpace(int64_t* size) {
 
 LvmCommandRunner::LvmCommandRunner() {}
 
-LvmCommandRunner::~LvmCommandRunner() {}
+LvmCommandRunner::LvmCommandRunner(bool keep_session)
+    : keep_session_(keep_session) {}
+
+LvmCommandRunner::~LvmCommandRunner() {
+  if (lvm_handle_)
+    lvm2_exit(lvm_handle_);
+}
 
 bool LvmCommandRunner::RunCommand(const std::vector<std::string>& cmd) {
   // lvm2_run() does not exec/fork a separate process, instead it parses the
@@ -338,7 +344,15 @@ bool LvmCommandRunner::RunCommand(const std::vector<std::string>& cmd) {
   // executing.
   brillo::ScopedUmask lvm_umask(0);
 
-  int rc = lvm2_run(nullptr, lvm_cmd.c_str());
+  // Without a handle, lvm2_run() sets up and tears down a context for this
+  // command only.
+  if (keep_session_ && !lvm_handle_) {
+    lvm_handle_ = lvm2_init();
+    if (!lvm_handle_)
+      LOG(WARNING) << "Failed to initialize lvm2 context";
+  }
+
+  int rc = lvm2_run(lvm_handle_, lvm_cmd.c_str());
   LogLvmError(rc, lvm_cmd);
 
   return rc == LVM2_COMMAND_SUCCEEDED;
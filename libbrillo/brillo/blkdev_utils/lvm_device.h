@@ -19,6 +19,12 @@ namespace brillo {
 class BRILLO_EXPORT LvmCommandRunner {
  public:
   LvmCommandRunner();
+  // If |keep_session| is true, a single liblvm2cmd context is kept across
+  // RunCommand() calls, instead of having each command read the configuration
+  // and set up its own. Intended for daemons running many commands.
+  explicit LvmCommandRunner(bool keep_session);
+  LvmCommandRunner(const LvmCommandRunner&) = delete;
+  LvmCommandRunner& operator=(const LvmCommandRunner&) = delete;
   virtual ~LvmCommandRunner();
 
   // Run the command using liblvm2cmd: the command looks the same as what
@@ -34,6 +40,11 @@ class BRILLO_EXPORT LvmCommandRunner {
   // Unwraps LVM2 JSON reports into the contents stored at |key|.
   virtual std::optional<base::Value> UnwrapReportContents(
       const std::string& output, const std::string& key);
+
+ private:
+  const bool keep_session_ = false;
+  // liblvm2cmd context kept across commands, if |keep_session_|.
+  void* lvm_handle_ = nullptr;
 };
 
 // LVM objects are short-lived objects that represent the state of the system
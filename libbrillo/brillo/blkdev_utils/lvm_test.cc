@@ -211,6 +211,38 @@ TEST(ListLogicalVolumesTest, PatternMatchingTest) {
   }
 }
 
+TEST(ActivateLogicalVolumesTest, SingleCommandTest) {
+  auto lvm = std::make_shared<MockLvmCommandRunner>();
+  LogicalVolumeManager lvmanager(lvm);
+  VolumeGroup vg("bar", lvm);
+  std::vector<std::string> lv_activate = {"lvchange", "-ay", "bar/foo0",
+                                          "bar/foo1"};
+
+  EXPECT_CALL(*lvm, RunCommand(lv_activate)).WillOnce(Return(true));
+
+  EXPECT_TRUE(lvmanager.ActivateLogicalVolumes(vg, {"foo0", "foo1"}));
+}
+
+TEST(ActivateLogicalVolumesTest, NoLogicalVolumesTest) {
+  auto lvm = std::make_shared<MockLvmCommandRunner>();
+  LogicalVolumeManager lvmanager(lvm);
+  VolumeGroup vg("bar", lvm);
+
+  EXPECT_CALL(*lvm, RunCommand(_)).Times(0);
+
+  EXPECT_TRUE(lvmanager.ActivateLogicalVolumes(vg, {}));
+}
+
+TEST(ActivateLogicalVolumesTest, FailedActivationTest) {
+  auto lvm = std::make_shared<MockLvmCommandRunner>();
+  LogicalVolumeManager lvmanager(lvm);
+  VolumeGroup vg("bar", lvm);
+
+  EXPECT_CALL(*lvm, RunCommand(_)).WillOnce(Return(false));
+
+  EXPECT_FALSE(lvmanager.ActivateLogicalVolumes(vg, {"foo"}));
+}
+
 TEST(RemoveLogicalVolumeTest, NonexistingLvTest) {
   auto lvm = std::make_shared<MockLvmCommandRunner>();
   LogicalVolumeManager lvmanager(lvm);
@@ -81,6 +81,10 @@ class MockLogicalVolumeManager : public LogicalVolumeManager {
               CreateLogicalVolume,
               (const VolumeGroup&, const Thinpool&, const base::Value::Dict&),
               (override));
+  MOCK_METHOD(bool,
+              ActivateLogicalVolumes,
+              (const VolumeGroup&, const std::vector<std::string>&),
+              (override));
   MOCK_METHOD(bool,
               RemoveLogicalVolume,
               (const VolumeGroup&, const std::string&),
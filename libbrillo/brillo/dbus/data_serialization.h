@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -357,6 +358,15 @@ struct DBusType<brillo::Any> {
 template <typename T, typename ALLOC>
 typename std::enable_if<IsTypeSupported<T>::value>::type AppendValueToWriter(
     ::dbus::MessageWriter* writer, const std::vector<T, ALLOC>& value) {
+  // Arrays of bytes and doubles are written in one go as D-Bus fixed arrays
+  // instead of element by element.
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    writer->AppendArrayOfBytes(value.data(), value.size());
+    return;
+  } else if constexpr (std::is_same_v<T, double>) {
+    writer->AppendArrayOfDoubles(value.data(), value.size());
+    return;
+  }
   ::dbus::MessageWriter array_writer(nullptr);
   writer->OpenArray(GetDBusSignature<T>(), &array_writer);
   for (const auto& element : value) {
@@ -374,8 +384,23 @@ PopValueFromReader(::dbus::MessageReader* reader,
                    std::vector<T, ALLOC>* value) {
   ::dbus::MessageReader variant_reader(nullptr);
   ::dbus::MessageReader array_reader(nullptr);
-  if (!details::DescendIntoVariantIfPresent(&reader, &variant_reader) ||
-      !reader->PopArray(&array_reader))
+  if (!details::DescendIntoVariantIfPresent(&reader, &variant_reader))
+    return false;
+  // Fixed arrays are copied straight from the message buffer.
+  if constexpr (std::is_same_v<T, uint8_t> || std::is_same_v<T, double>) {
+    const T* data = nullptr;
+    size_t size = 0;
+    bool success;
+    if constexpr (std::is_same_v<T, uint8_t>)
+      success = reader->PopArrayOfBytes(&data, &size);
+    else
+      success = reader->PopArrayOfDoubles(&data, &size);
+    if (!success)
+      return false;
+    value->assign(data, data + size);
+    return true;
+  }
+  if (!reader->PopArray(&array_reader))
     return false;
   value->clear();
   while (array_reader.HasMoreData()) {
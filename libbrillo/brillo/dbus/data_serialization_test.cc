@@ -351,6 +351,35 @@ TEST(DBusUtils, ArrayOfBytes_Empty) {
   EXPECT_EQ(bytes, bytes_out);
 }
 
+TEST(DBusUtils, ArrayOfBytes_WrongType) {
+  std::unique_ptr<Response> message = Response::CreateEmpty();
+  MessageWriter writer(message.get());
+  AppendValueToWriter(&writer, std::vector<int32_t>{1, 2, 3});
+
+  MessageReader reader(message.get());
+  std::vector<uint8_t> bytes_out;
+  EXPECT_FALSE(PopValueFromReader(&reader, &bytes_out));
+}
+
+TEST(DBusUtils, ArrayOfDoubles) {
+  std::unique_ptr<Response> message = Response::CreateEmpty();
+  MessageWriter writer(message.get());
+  std::vector<double> values{-1.5, 0.0, 3.25, 1e100};
+  AppendValueToWriter(&writer, values);
+  AppendValueToWriterAsVariant(&writer, values);
+
+  EXPECT_EQ("adv", message->GetSignature());
+
+  MessageReader reader(message.get());
+  std::vector<double> values_out;
+  EXPECT_TRUE(PopValueFromReader(&reader, &values_out));
+  EXPECT_EQ(values, values_out);
+  Any any_out;
+  EXPECT_TRUE(PopVariantValueFromReader(&reader, &any_out));
+  EXPECT_FALSE(reader.HasMoreData());
+  EXPECT_EQ(values, any_out.Get<std::vector<double>>());
+}
+
 TEST(DBusUtils, ArrayOfStrings) {
   std::unique_ptr<Response> message = Response::CreateEmpty();
   MessageWriter writer(message.get());
@@ -5,6 +5,7 @@
 #include <base/check.h>
 #include <brillo/dbus/dbus_object.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -16,6 +17,7 @@
 #include <brillo/dbus/async_event_sequencer.h>
 #include <brillo/dbus/exported_object_manager.h>
 #include <brillo/dbus/exported_property_set.h>
+#include <brillo/tracing_categories.h>
 #include <dbus/property.h>
 
 namespace brillo {
@@ -36,6 +38,13 @@ void SetupDefaultPropertyHandlers(DBusInterface* prop_interface,
       &ExportedPropertySet::HandleSet);
 }
 
+// Returns a new trace track for a D-Bus method call handled by |itf|, so calls
+// answered asynchronously show up as separate slices.
+perfetto::Track GetMethodCallTrack(const DBusInterface* itf) {
+  static std::atomic<uint64_t> next_call_id{0};
+  return perfetto::Track(next_call_id++, perfetto::Track::FromPointer(itf));
+}
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////////////
@@ -209,6 +218,20 @@ void DBusInterface::HandleMethodCall(dbus::MethodCall* method_call,
     return;
   }
   VLOG(1) << "Dispatching DBus method call: " << method_name;
+  if (TRACE_EVENT_CATEGORY_ENABLED("dbus")) {
+    perfetto::Track track = GetMethodCallTrack(this);
+    TRACE_EVENT_BEGIN("dbus",
+                      perfetto::DynamicString(interface_name + "." +
+                                              method_name),
+                      track, "sender", method_call->GetSender());
+    sender = base::BindOnce(
+        [](perfetto::Track track, ResponseSender sender,
+           std::unique_ptr<dbus::Response> response) {
+          TRACE_EVENT_END("dbus", track);
+          std::move(sender).Run(std::move(response));
+        },
+        track, std::move(sender));
+  }
   pair->second->HandleMethod(method_call, std::move(sender));
 }
 
@@ -194,5 +194,20 @@ CURLMcode CurlApi::MultiWait(CURLM* multi_handle,
                          numfds);
 }
 
+CURLSH* CurlApi::ShareInit() {
+  return curl_share_init();
+}
+
+CURLSHcode CurlApi::ShareCleanup(CURLSH* share_handle) {
+  return curl_share_cleanup(share_handle);
+}
+
+CURLSHcode CurlApi::ShareSetOptInt(CURLSH* share_handle,
+                                   CURLSHoption option,
+                                   int value) {
+  // NOLINTNEXTLINE(runtime/int)
+  return curl_share_setopt(share_handle, option, static_cast<long>(value));
+}
+
 }  // namespace http
 }  // namespace brillo
@@ -123,6 +123,18 @@ class CurlInterface {
                               unsigned int extra_nfds,
                               int timeout_ms,
                               int* numfds) = 0;
+
+  // Wrapper around curl_share_init().
+  virtual CURLSH* ShareInit() = 0;
+
+  // Wrapper around curl_share_cleanup().
+  virtual CURLSHcode ShareCleanup(CURLSH* share_handle) = 0;
+
+  // Wrapper around curl_share_setopt() for options taking a long value, such
+  // as CURLSHOPT_SHARE.
+  virtual CURLSHcode ShareSetOptInt(CURLSH* share_handle,
+                                    CURLSHoption option,
+                                    int value) = 0;
 };
 
 class BRILLO_EXPORT CurlApi : public CurlInterface {
@@ -218,6 +230,17 @@ class BRILLO_EXPORT CurlApi : public CurlInterface {
                       unsigned int extra_nfds,
                       int timeout_ms,
                       int* numfds) override;
+
+  // Wrapper around curl_share_init().
+  CURLSH* ShareInit() override;
+
+  // Wrapper around curl_share_cleanup().
+  CURLSHcode ShareCleanup(CURLSH* share_handle) override;
+
+  // Wrapper around curl_share_setopt() for options taking a long value.
+  CURLSHcode ShareSetOptInt(CURLSH* share_handle,
+                            CURLSHoption option,
+                            int value) override;
 };
 
 }  // namespace http
@@ -166,6 +166,8 @@ bool Connection::FinishRequest(brillo::ErrorPtr* error) {
       return false;
     LOG(INFO) << "Response: " << GetResponseStatusCode() << " ("
               << GetResponseStatusText() << ")";
+    if (sync_transfer_complete_callback_)
+      std::move(sync_transfer_complete_callback_).Run();
   }
   return (ret == CURLE_OK);
 }
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include <base/functional/callback.h>
 #include <brillo/brillo_export.h>
 #include <brillo/http/http_connection.h>
 #include <brillo/http/http_transport_curl.h>
@@ -98,6 +99,9 @@ class BRILLO_EXPORT Connection : public http::Connection {
 
  private:
   friend class http::curl::Transport;
+
+  // Set by the transport to be run after a successful FinishRequest().
+  base::OnceClosure sync_transfer_complete_callback_;
 };
 
 }  // namespace curl
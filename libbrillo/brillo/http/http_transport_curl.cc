@@ -6,6 +6,7 @@
 #include <base/check_op.h>
 #include <brillo/http/http_transport_curl.h>
 
+#include <algorithm>
 #include <limits>
 #include <optional>
 #include <utility>
@@ -140,6 +141,10 @@ Transport::Transport(const std::shared_ptr<CurlInterface>& curl_interface,
 Transport::~Transport() {
   ClearHost();
   ShutDownAsyncCurl();
+  if (curl_share_handle_) {
+    curl_interface_->ShareCleanup(curl_share_handle_);
+    curl_share_handle_ = nullptr;
+  }
   VLOG(2) << "curl::Transport destroyed";
 }
 
@@ -237,6 +242,10 @@ std::shared_ptr<http::Connection> Transport::CreateConnection(
         curl_handle, CURLOPT_UPLOAD_BUFFERSIZE, upload_buffer_size_.value());
   }
 
+  if (code == CURLE_OK) {
+    code = SetUpConnectionReuse(curl_handle);
+  }
+
   // Setup HTTP request method and optional request body.
   if (code == CURLE_OK) {
     if (method == request_type::kGet) {
@@ -265,8 +274,15 @@ std::shared_ptr<http::Connection> Transport::CreateConnection(
     return connection;
   }
 
-  connection = std::make_shared<http::curl::Connection>(
+  auto curl_connection = std::make_shared<http::curl::Connection>(
       curl_handle, method, curl_interface_, shared_from_this());
+  if (connection_options_.share_connections) {
+    // Asynchronous transfers are accounted for in OnTransferComplete().
+    curl_connection->sync_transfer_complete_callback_ =
+        base::BindOnce(&Transport::RecordConnectionStats,
+                       weak_ptr_factory_.GetWeakPtr(), curl_handle);
+  }
+  connection = std::move(curl_connection);
   if (!connection->SendHeaders(headers, error)) {
     connection.reset();
   }
@@ -397,6 +413,10 @@ void Transport::SetUploadBufferSize(std::optional<int> buffer_size) {
   upload_buffer_size_ = buffer_size;
 }
 
+void Transport::SetConnectionOptions(const ConnectionOptions& options) {
+  connection_options_ = options;
+}
+
 void Transport::ClearHost() {
   curl_slist_free_all(host_list_);
   host_list_ = nullptr;
@@ -445,6 +465,86 @@ bool Transport::SetupAsyncCurl(brillo::ErrorPtr* error) {
   return true;
 }
 
+CURLcode Transport::SetUpConnectionReuse(CURL* curl_handle) {
+  CURLcode code = CURLE_OK;
+  if (connection_options_.share_connections && !curl_share_handle_) {
+    curl_share_handle_ = curl_interface_->ShareInit();
+    CURLSHcode share_code = curl_share_handle_ ? CURLSHE_OK : CURLSHE_NOMEM;
+    for (int data :
+         {CURL_LOCK_DATA_CONNECT, CURL_LOCK_DATA_DNS,
+          CURL_LOCK_DATA_SSL_SESSION}) {
+      if (share_code == CURLSHE_OK) {
+        share_code = curl_interface_->ShareSetOptInt(curl_share_handle_,
+                                                     CURLSHOPT_SHARE, data);
+      }
+    }
+    if (share_code != CURLSHE_OK) {
+      // Requests still work without the share handle, they just don't reuse
+      // the connections of the previous ones.
+      LOG(WARNING) << "Failed to set up CURL connection sharing: "
+                   << share_code;
+      if (curl_share_handle_)
+        curl_interface_->ShareCleanup(curl_share_handle_);
+      curl_share_handle_ = nullptr;
+      connection_options_.share_connections = false;
+    }
+  }
+  if (curl_share_handle_ && connection_options_.share_connections) {
+    code = curl_interface_->EasySetOptPtr(curl_handle, CURLOPT_SHARE,
+                                          curl_share_handle_);
+  }
+  if (code == CURLE_OK && connection_options_.http2) {
+    code = curl_interface_->EasySetOptInt(curl_handle, CURLOPT_HTTP_VERSION,
+                                          CURL_HTTP_VERSION_2TLS);
+    // Wait for an existing connection to confirm whether it can multiplex
+    // rather than opening a new connection right away.
+    if (code == CURLE_OK) {
+      code = curl_interface_->EasySetOptInt(curl_handle, CURLOPT_PIPEWAIT, 1);
+    }
+  }
+  if (code == CURLE_OK && connection_options_.tcp_keepalive_interval) {
+    int interval_s = std::max<int64_t>(
+        1, connection_options_.tcp_keepalive_interval->InSeconds());
+    code =
+        curl_interface_->EasySetOptInt(curl_handle, CURLOPT_TCP_KEEPALIVE, 1);
+    if (code == CURLE_OK) {
+      code = curl_interface_->EasySetOptInt(curl_handle, CURLOPT_TCP_KEEPIDLE,
+                                            interval_s);
+    }
+    if (code == CURLE_OK) {
+      code = curl_interface_->EasySetOptInt(curl_handle, CURLOPT_TCP_KEEPINTVL,
+                                            interval_s);
+    }
+  }
+  return code;
+}
+
+void Transport::RecordConnectionStats(CURL* curl_handle) {
+  int num_connects = 0;
+  double connect_time = 0.0;
+  double app_connect_time = 0.0;
+  if (curl_interface_->EasyGetInfoInt(curl_handle, CURLINFO_NUM_CONNECTS,
+                                      &num_connects) != CURLE_OK ||
+      curl_interface_->EasyGetInfoDbl(curl_handle, CURLINFO_CONNECT_TIME,
+                                      &connect_time) != CURLE_OK ||
+      curl_interface_->EasyGetInfoDbl(curl_handle, CURLINFO_APPCONNECT_TIME,
+                                      &app_connect_time) != CURLE_OK) {
+    return;
+  }
+  connection_stats_.transfers++;
+  if (num_connects == 0)
+    connection_stats_.reused_connections++;
+  // APPCONNECT_TIME is zero unless a TLS handshake was made for this transfer.
+  if (app_connect_time > 0.0) {
+    connection_stats_.tls_handshakes++;
+    connection_stats_.tls_handshake_time +=
+        base::Seconds(std::max(0.0, app_connect_time - connect_time));
+  }
+  VLOG(2) << "Transfer " << (num_connects == 0 ? "reused" : "opened")
+          << " a connection, " << connection_stats_.reused_connections << "/"
+          << connection_stats_.transfers << " reused";
+}
+
 void Transport::ShutDownAsyncCurl() {
   if (!curl_multi_handle_)
     return;
@@ -551,6 +651,8 @@ void Transport::OnTransferComplete(Connection* connection, CURLcode code) {
   AsyncRequestData* request_data = p->second.get();
   VLOG(1) << "HTTP request # " << request_data->request_id << " has completed "
           << (code == CURLE_OK ? "successfully" : "with an error");
+  if (code == CURLE_OK && connection_options_.share_connections)
+    RecordConnectionStats(connection->curl_handle_);
   if (code != CURLE_OK) {
     brillo::ErrorPtr error;
     AddEasyCurlError(&error, FROM_HERE, code, curl_interface_.get());
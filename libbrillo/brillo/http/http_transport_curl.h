@@ -14,6 +14,7 @@
 
 #include <base/location.h>
 #include <base/memory/weak_ptr.h>
+#include <base/time/time.h>
 #include <brillo/brillo_export.h>
 #include <brillo/http/curl_api.h>
 #include <brillo/http/http_transport.h>
@@ -89,6 +90,37 @@ class BRILLO_EXPORT Transport : public http::Transport {
   void SetBufferSize(std::optional<int> buffer_size) override;
   void SetUploadBufferSize(std::optional<int> buffer_size) override;
 
+  // Options controlling how the connections made by this transport are set up
+  // and reused.
+  struct ConnectionOptions {
+    // Share the connection, DNS and TLS session caches between all the
+    // requests of this transport, including synchronous ones which otherwise
+    // close their connection when done. Also enables |connection_stats()|.
+    bool share_connections = false;
+    // Negotiate HTTP/2 over TLS via ALPN and multiplex concurrent requests to
+    // the same host over a single connection instead of opening a new one.
+    bool http2 = false;
+    // If set, enables TCP keepalive probes on idle connections with this
+    // interval, so pooled connections closed by middleboxes are detected.
+    std::optional<base::TimeDelta> tcp_keepalive_interval;
+  };
+
+  // Sets the options applied to the connections created from now on.
+  void SetConnectionOptions(const ConnectionOptions& options);
+
+  // Statistics of the completed requests when |share_connections| is enabled.
+  struct ConnectionStats {
+    // Number of completed transfers.
+    int transfers = 0;
+    // Number of transfers that reused an existing connection.
+    int reused_connections = 0;
+    // Number of TLS handshakes performed and the total time spent in them.
+    int tls_handshakes = 0;
+    base::TimeDelta tls_handshake_time;
+  };
+
+  const ConnectionStats& connection_stats() const { return connection_stats_; }
+
   // Helper methods to convert CURL error codes (CURLcode and CURLMcode)
   // into brillo::Error object.
   static void AddEasyCurlError(brillo::ErrorPtr* error,
@@ -125,6 +157,13 @@ class BRILLO_EXPORT Transport : public http::Transport {
   // on a connection.
   void CleanAsyncConnection(http::curl::Connection* connection);
 
+  // Creates |curl_share_handle_| if needed and attaches it to |curl_handle|,
+  // and applies the other |connection_options_|.
+  CURLcode SetUpConnectionReuse(CURL* curl_handle);
+
+  // Updates |connection_stats_| with the transfer of |curl_handle|.
+  void RecordConnectionStats(CURL* curl_handle);
+
   // Called after a timeout delay requested by CURL has elapsed.
   void OnTimer();
 
@@ -166,6 +205,11 @@ class BRILLO_EXPORT Transport : public http::Transport {
   curl_slist* host_list_{nullptr};
   std::optional<int> buffer_size_;
   std::optional<int> upload_buffer_size_;
+  ConnectionOptions connection_options_;
+  // CURL "share"-handle holding the caches shared between the requests when
+  // |connection_options_.share_connections| is set.
+  CURLSH* curl_share_handle_{nullptr};
+  ConnectionStats connection_stats_;
 
   base::WeakPtrFactory<Transport> weak_ptr_factory_for_timer_{this};
   base::WeakPtrFactory<Transport> weak_ptr_factory_{this};
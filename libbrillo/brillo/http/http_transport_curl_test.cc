@@ -578,6 +578,72 @@ TEST_F(HttpCurlTransportTest, SetInterfaceAndLocalIpAddress) {
   connection.reset();
 }
 
+TEST_F(HttpCurlTransportTest, ShareConnections) {
+  CURLSH* share_handle = reinterpret_cast<CURLSH*>(200);
+  EXPECT_CALL(*curl_api_, ShareInit()).WillOnce(Return(share_handle));
+  EXPECT_CALL(*curl_api_, ShareSetOptInt(share_handle, CURLSHOPT_SHARE,
+                                         CURL_LOCK_DATA_CONNECT))
+      .WillOnce(Return(CURLSHE_OK));
+  EXPECT_CALL(*curl_api_,
+              ShareSetOptInt(share_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS))
+      .WillOnce(Return(CURLSHE_OK));
+  EXPECT_CALL(*curl_api_, ShareSetOptInt(share_handle, CURLSHOPT_SHARE,
+                                         CURL_LOCK_DATA_SSL_SESSION))
+      .WillOnce(Return(CURLSHE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptPtr(handle_, CURLOPT_SHARE, share_handle))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_,
+              EasySetOptStr(handle_, CURLOPT_URL, "http://foo.bar/get"))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptInt(handle_, CURLOPT_HTTPGET, 1))
+      .WillOnce(Return(CURLE_OK));
+
+  transport_->SetConnectionOptions({.share_connections = true});
+  auto connection = transport_->CreateConnection(
+      "http://foo.bar/get", request_type::kGet, {}, "", "", nullptr);
+
+  testing::Mock::VerifyAndClearExpectations(curl_api_.get());
+  EXPECT_NE(nullptr, connection.get());
+
+  EXPECT_CALL(*curl_api_, EasyCleanup(handle_)).Times(1);
+  connection.reset();
+
+  EXPECT_CALL(*curl_api_, ShareCleanup(share_handle))
+      .WillOnce(Return(CURLSHE_OK));
+  transport_.reset();
+}
+
+TEST_F(HttpCurlTransportTest, Http2AndKeepalive) {
+  EXPECT_CALL(*curl_api_, ShareInit()).Times(0);
+  EXPECT_CALL(*curl_api_,
+              EasySetOptStr(handle_, CURLOPT_URL, "https://foo.bar/get"))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptInt(handle_, CURLOPT_HTTP_VERSION,
+                                        CURL_HTTP_VERSION_2TLS))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptInt(handle_, CURLOPT_PIPEWAIT, 1))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptInt(handle_, CURLOPT_TCP_KEEPALIVE, 1))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptInt(handle_, CURLOPT_TCP_KEEPIDLE, 30))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptInt(handle_, CURLOPT_TCP_KEEPINTVL, 30))
+      .WillOnce(Return(CURLE_OK));
+  EXPECT_CALL(*curl_api_, EasySetOptInt(handle_, CURLOPT_HTTPGET, 1))
+      .WillOnce(Return(CURLE_OK));
+
+  transport_->SetConnectionOptions(
+      {.http2 = true, .tcp_keepalive_interval = base::Seconds(30)});
+  auto connection = transport_->CreateConnection(
+      "https://foo.bar/get", request_type::kGet, {}, "", "", nullptr);
+
+  testing::Mock::VerifyAndClearExpectations(curl_api_.get());
+  EXPECT_NE(nullptr, connection.get());
+
+  EXPECT_CALL(*curl_api_, EasyCleanup(handle_)).Times(1);
+  connection.reset();
+}
+
 }  // namespace curl
 }  // namespace http
 }  // namespace brillo
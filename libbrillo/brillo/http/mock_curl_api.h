@@ -83,6 +83,12 @@ class MockCurlInterface : public CurlInterface {
               MultiWait,
               (CURLM*, curl_waitfd[], unsigned int, int, int*),
               (override));
+  MOCK_METHOD(CURLSH*, ShareInit, (), (override));
+  MOCK_METHOD(CURLSHcode, ShareCleanup, (CURLSH*), (override));
+  MOCK_METHOD(CURLSHcode,
+              ShareSetOptInt,
+              (CURLSH*, CURLSHoption, int),
+              (override));
 };
 
 }  // namespace http
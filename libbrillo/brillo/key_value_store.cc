@@ -4,7 +4,10 @@
 
 #include "brillo/key_value_store.h"
 
+#include <algorithm>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <base/check.h>
@@ -12,7 +15,6 @@
 #include <base/files/important_file_writer.h>
 #include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
-#include <brillo/strings/string_utils.h>
 #include <brillo/map_utils.h>
 
 using std::string;
@@ -26,10 +28,9 @@ namespace {
 const char kTrueValue[] = "true";
 const char kFalseValue[] = "false";
 
-// Returns a copy of |key| with leading and trailing whitespace removed.
-string TrimKey(const string& key) {
-  string trimmed_key;
-  base::TrimWhitespaceASCII(key, base::TRIM_ALL, &trimmed_key);
+// Returns |key| with leading and trailing whitespace removed.
+std::string_view TrimKey(std::string_view key) {
+  std::string_view trimmed_key = base::TrimWhitespaceASCII(key, base::TRIM_ALL);
   CHECK(!trimmed_key.empty());
   return trimmed_key;
 }
@@ -49,37 +50,57 @@ bool KeyValueStore::Load(const base::FilePath& path) {
 }
 
 bool KeyValueStore::LoadFromString(const std::string& data) {
+  // Parse all the pairs first and merge them into |store_| at once, instead of
+  // inserting one by one into the sorted vector.
+  vector<std::pair<string, string>> entries;
+  bool success = true;
+
   // Split along '\n', then along '='.
-  vector<string> lines = base::SplitString(data, "\n", base::KEEP_WHITESPACE,
-                                           base::SPLIT_WANT_ALL);
+  vector<std::string_view> lines = base::SplitStringPiece(
+      data, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
   for (auto it = lines.begin(); it != lines.end(); ++it) {
-    std::string line;
-    base::TrimWhitespaceASCII(*it, base::TRIM_LEADING, &line);
+    std::string_view line = base::TrimWhitespaceASCII(*it, base::TRIM_LEADING);
     if (line.empty() || line.front() == '#')
       continue;
 
-    std::string key;
-    std::string value;
-    if (!string_utils::SplitAtFirst(line, "=", &key, &value, false))
-      return false;
-
-    base::TrimWhitespaceASCII(key, base::TRIM_TRAILING, &key);
-    if (key.empty())
-      return false;
+    size_t pos = line.find('=');
+    if (pos == std::string_view::npos) {
+      success = false;
+      break;
+    }
+    std::string_view key =
+        base::TrimWhitespaceASCII(line.substr(0, pos), base::TRIM_TRAILING);
+    if (key.empty()) {
+      success = false;
+      break;
+    }
+    string value(line.substr(pos + 1));
 
     // Append additional lines to the value as long as we see trailing
     // backslashes.
     while (!value.empty() && value.back() == '\\') {
       ++it;
-      if (it == lines.end() || it->empty())
-        return false;
+      if (it == lines.end() || it->empty()) {
+        success = false;
+        break;
+      }
       value.pop_back();
-      value += *it;
+      value.append(it->data(), it->size());
     }
+    if (!success)
+      break;
 
-    store_[key] = value;
+    entries.emplace_back(string(key), std::move(value));
   }
-  return true;
+
+  // flat_map keeps the first of duplicate keys, so put the new pairs first,
+  // with the last occurrence of a key in |data| ahead of the earlier ones.
+  std::reverse(entries.begin(), entries.end());
+  entries.reserve(entries.size() + store_.size());
+  for (auto& key_value : store_)
+    entries.emplace_back(std::move(key_value));
+  store_ = base::flat_map<string, string, std::less<>>(std::move(entries));
+  return success;
 }
 
 bool KeyValueStore::Save(const base::FilePath& path) const {
@@ -106,7 +127,7 @@ bool KeyValueStore::GetString(const string& key, string* value) const {
 }
 
 void KeyValueStore::SetString(const string& key, const string& value) {
-  store_[TrimKey(key)] = value;
+  store_.insert_or_assign(string(TrimKey(key)), value);
 }
 
 bool KeyValueStore::GetBoolean(const string& key, bool* value) const {
@@ -134,6 +134,20 @@ TEST_F(KeyValueStoreTest, MultipleLoads) {
   EXPECT_EQ(2, store_.GetKeys().size());
 }
 
+TEST_F(KeyValueStoreTest, LaterValuesOverride) {
+  // The last value of a key wins, within a load and across loads.
+  EXPECT_TRUE(store_.LoadFromString("A=1\nB=2\nA=3\n"));
+  EXPECT_TRUE(store_.LoadFromString("B=4\nC=5\n"));
+  string value;
+  EXPECT_TRUE(store_.GetString("A", &value));
+  EXPECT_EQ("3", value);
+  EXPECT_TRUE(store_.GetString("B", &value));
+  EXPECT_EQ("4", value);
+  EXPECT_TRUE(store_.GetString("C", &value));
+  EXPECT_EQ("5", value);
+  EXPECT_EQ(3, store_.GetKeys().size());
+}
+
 TEST_F(KeyValueStoreTest, PartialLoad) {
   // The 2nd line is broken, but the pair from the first line should be kept.
   EXPECT_FALSE(store_.LoadFromString("A=B\n=\n"));
@@ -83,11 +83,36 @@ MessageLoop::TaskId BaseMessageLoop::PostDelayedTask(
     base::OnceClosure task,
     base::TimeDelta delay) {
   TaskId task_id = NextTaskId();
-  bool base_scheduled = task_runner_->PostDelayedTask(
-      from_here,
-      base::BindOnce(&BaseMessageLoop::OnRanPostedTask,
-                     weak_ptr_factory_.GetWeakPtr(), task_id),
-      delay);
+  bool base_scheduled = true;
+  if (delay.is_positive() && delayed_task_slack_.is_positive()) {
+    base::TimeTicks now = base::TimeTicks::Now();
+    base::TimeTicks deadline =
+        (now + delay).SnappedToNextTick(base::TimeTicks(), delayed_task_slack_);
+    auto [it, inserted] = coalesced_tasks_.try_emplace(deadline);
+    if (inserted) {
+      base_scheduled = task_runner_->PostDelayedTask(
+          from_here,
+          base::BindOnce(&BaseMessageLoop::OnCoalescedTasksWakeup,
+                         weak_ptr_factory_.GetWeakPtr(), deadline),
+          deadline - now);
+      if (!base_scheduled)
+        coalesced_tasks_.erase(it);
+    }
+    if (base_scheduled)
+      it->second.push_back(task_id);
+  } else if (delay.is_positive()) {
+    base_scheduled = task_runner_->PostDelayedTask(
+        from_here,
+        base::BindOnce(&BaseMessageLoop::OnDelayedTaskWakeup,
+                       weak_ptr_factory_.GetWeakPtr(), task_id),
+        delay);
+  } else {
+    base_scheduled = task_runner_->PostDelayedTask(
+        from_here,
+        base::BindOnce(&BaseMessageLoop::OnRanPostedTask,
+                       weak_ptr_factory_.GetWeakPtr(), task_id),
+        delay);
+  }
   DVLOG_LOC(from_here, 1) << "Scheduling delayed task_id " << task_id
                           << " to run in " << delay << ".";
   if (!base_scheduled)
@@ -125,6 +150,7 @@ bool BaseMessageLoop::CancelTask(TaskId task_id) {
 
 bool BaseMessageLoop::RunOnce(bool may_block) {
   run_once_ = true;
+  quit_requested_ = false;
   // Uses the base::SingleThreadTaskExecutor implicitly.
   base::RunLoop run_loop;
   base_run_loop_ = &run_loop;
@@ -142,6 +168,7 @@ bool BaseMessageLoop::RunOnce(bool may_block) {
 }
 
 void BaseMessageLoop::Run() {
+  quit_requested_ = false;
   // Uses the base::SingleThreadTaskExecutor implicitly.
   base::RunLoop run_loop;
   base_run_loop_ = &run_loop;
@@ -154,13 +181,24 @@ void BaseMessageLoop::BreakLoop() {
     DVLOG(1) << "Message loop not running, ignoring BreakLoop().";
     return;  // Message loop not running, nothing to do.
   }
+  quit_requested_ = true;
   base_run_loop_->Quit();
 }
 
 base::RepeatingClosure BaseMessageLoop::QuitClosure() const {
   if (base_run_loop_ == nullptr)
     return base::DoNothing();
-  return base_run_loop_->QuitClosure();
+  return base::BindRepeating(
+      [](base::WeakPtr<BaseMessageLoop> loop, base::RepeatingClosure quit) {
+        if (loop)
+          loop->quit_requested_ = true;
+        quit.Run();
+      },
+      weak_ptr_factory_.GetWeakPtr(), base_run_loop_->QuitClosure());
+}
+
+void BaseMessageLoop::SetDelayedTaskSlack(base::TimeDelta slack) {
+  delayed_task_slack_ = slack;
 }
 
 MessageLoop::TaskId BaseMessageLoop::NextTaskId() {
@@ -193,6 +231,37 @@ void BaseMessageLoop::OnRanPostedTask(MessageLoop::TaskId task_id) {
   delayed_tasks_.erase(task_it);
 }
 
+void BaseMessageLoop::OnDelayedTaskWakeup(MessageLoop::TaskId task_id) {
+  delayed_task_wakeups_++;
+  OnRanPostedTask(task_id);
+}
+
+void BaseMessageLoop::OnCoalescedTasksWakeup(base::TimeTicks deadline) {
+  auto it = coalesced_tasks_.find(deadline);
+  DCHECK(it != coalesced_tasks_.end());
+  std::vector<TaskId> task_ids = std::move(it->second);
+  coalesced_tasks_.erase(it);
+  delayed_task_wakeups_++;
+  RunCoalescedTasks(std::move(task_ids));
+}
+
+void BaseMessageLoop::RunCoalescedTasks(std::vector<TaskId> task_ids) {
+  for (size_t i = 0; i < task_ids.size(); ++i) {
+    OnRanPostedTask(task_ids[i]);
+    // The loop was quit by the task, or by OnRanPostedTask() for RunOnce(): the
+    // rest of the batch runs the next time the loop runs.
+    if (quit_requested_ && i + 1 < task_ids.size()) {
+      task_runner_->PostTask(
+          FROM_HERE,
+          base::BindOnce(&BaseMessageLoop::RunCoalescedTasks,
+                         weak_ptr_factory_.GetWeakPtr(),
+                         std::vector<TaskId>(task_ids.begin() + i + 1,
+                                             task_ids.end())));
+      return;
+    }
+  }
+}
+
 int BaseMessageLoop::ParseBinderMinor(const std::string& file_contents) {
   int result = kInvalidMinor;
   // Split along '\n', then along the ' '. Note that base::SplitString trims all
@@ -16,6 +16,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <base/files/file_descriptor_watcher_posix.h>
 #include <base/location.h>
@@ -59,6 +60,17 @@ class BRILLO_EXPORT BaseMessageLoop : public MessageLoop {
   // loop is not running, an empty (null) callback is returned.
   base::RepeatingClosure QuitClosure() const;
 
+  // Lets delayed tasks run up to |slack| late so that the ones due around the
+  // same time share a single wakeup of the loop. Deadlines are rounded up to a
+  // multiple of |slack| and all the tasks with the same rounded deadline are
+  // run from one libchrome delayed task. A zero |slack|, the default, posts
+  // each delayed task to libchrome on its own.
+  void SetDelayedTaskSlack(base::TimeDelta slack);
+
+  // Returns the number of times the loop woke up to run delayed tasks, not
+  // counting tasks posted without a delay.
+  uint64_t delayed_task_wakeups() const { return delayed_task_wakeups_; }
+
  private:
   FRIEND_TEST(BaseMessageLoopTest, ParseBinderMinor);
 
@@ -74,6 +86,18 @@ class BRILLO_EXPORT BaseMessageLoop : public MessageLoop {
   // scheduled with Post*Task() of id |task_id|, even if it was canceled.
   void OnRanPostedTask(MessageLoop::TaskId task_id);
 
+  // Called by base::SingleThreadTaskExecutor when a delayed task posted on its
+  // own is due.
+  void OnDelayedTaskWakeup(MessageLoop::TaskId task_id);
+
+  // Called by base::SingleThreadTaskExecutor at the rounded |deadline| of the
+  // coalesced delayed tasks.
+  void OnCoalescedTasksWakeup(base::TimeTicks deadline);
+
+  // Runs the delayed tasks of |task_ids| in order. If RunOnce() is running,
+  // the tasks left after the first one that ran are run on a later iteration.
+  void RunCoalescedTasks(std::vector<MessageLoop::TaskId> task_ids);
+
   // Return a new unused task_id.
   TaskId NextTaskId();
 
@@ -94,9 +118,23 @@ class BRILLO_EXPORT BaseMessageLoop : public MessageLoop {
   // Tasks blocked on a timeout.
   std::map<MessageLoop::TaskId, DelayedTask> delayed_tasks_;
 
+  // See SetDelayedTaskSlack().
+  base::TimeDelta delayed_task_slack_;
+
+  // The ids of the delayed tasks coalesced at each rounded deadline, in the
+  // order they were posted.
+  std::map<base::TimeTicks, std::vector<MessageLoop::TaskId>>
+      coalesced_tasks_;
+
+  uint64_t delayed_task_wakeups_{0};
+
   // Flag to mark that we should run the message loop only one iteration.
   bool run_once_{false};
 
+  // Whether the loop was quit since it started running, so that no more
+  // coalesced tasks are run.
+  bool quit_requested_{false};
+
   // The last used TaskId. While base::SingleThreadTaskExecutor doesn't allow to
   // cancel delayed tasks, we handle that functionality by not running the
   // callback if it fires at a later point.
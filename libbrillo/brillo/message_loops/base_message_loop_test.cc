@@ -4,9 +4,14 @@
 
 #include <brillo/message_loops/base_message_loop.h>
 
+#include <vector>
+
+#include <base/functional/bind.h>
+#include <base/time/time.h>
 #include <gtest/gtest.h>
 
 #include <brillo/message_loops/message_loop.h>
+#include <brillo/message_loops/message_loop_utils.h>
 
 namespace brillo {
 
@@ -22,4 +27,67 @@ TEST(BaseMessageLoopTest, ParseBinderMinor) {
             BaseMessageLoop::ParseBinderMinor("227 foo\n239 bar\n"));
 }
 
+TEST(BaseMessageLoopTest, DelayedTaskSlackCoalescesWakeups) {
+  BaseMessageLoop loop;
+  loop.SetDelayedTaskSlack(base::Seconds(1));
+  std::vector<int> ran;
+  auto task = base::BindRepeating(
+      [](std::vector<int>* ran, int i) { ran->push_back(i); }, &ran);
+  for (int i = 0; i < 3; ++i)
+    loop.PostDelayedTask(FROM_HERE, base::BindOnce(task, i),
+                         base::Milliseconds(1 + i));
+
+  auto all_ran = base::BindRepeating(
+      [](std::vector<int>* ran) { return ran->size() == 3; }, &ran);
+  MessageLoopRunUntil(&loop, base::Seconds(5), all_ran);
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), ran);
+  EXPECT_EQ(1u, loop.delayed_task_wakeups());
+}
+
+TEST(BaseMessageLoopTest, DelayedTaskSlackCancelAndRunOnce) {
+  BaseMessageLoop loop;
+  loop.SetDelayedTaskSlack(base::Milliseconds(100));
+  int ran = 0;
+  auto task = base::BindRepeating([](int* ran) { (*ran)++; }, &ran);
+  MessageLoop::TaskId canceled =
+      loop.PostDelayedTask(FROM_HERE, task, base::Milliseconds(1));
+  loop.PostDelayedTask(FROM_HERE, task, base::Milliseconds(1));
+  loop.PostDelayedTask(FROM_HERE, task, base::Milliseconds(1));
+  EXPECT_TRUE(loop.CancelTask(canceled));
+
+  // Each RunOnce() runs one of the coalesced tasks.
+  EXPECT_TRUE(loop.RunOnce(true));
+  EXPECT_EQ(1, ran);
+  EXPECT_TRUE(loop.RunOnce(true));
+  EXPECT_EQ(2, ran);
+  EXPECT_FALSE(loop.RunOnce(false));
+  EXPECT_EQ(2, ran);
+}
+
+TEST(BaseMessageLoopTest, DelayedTaskSlackStopsAfterBreakLoop) {
+  BaseMessageLoop loop;
+  loop.SetDelayedTaskSlack(base::Milliseconds(100));
+  std::vector<int> ran;
+  auto task = base::BindRepeating(
+      [](BaseMessageLoop* loop, std::vector<int>* ran, int i) {
+        ran->push_back(i);
+        if (i == 0)
+          loop->BreakLoop();
+      },
+      &loop, &ran);
+  for (int i = 0; i < 3; ++i)
+    loop.PostDelayedTask(FROM_HERE, base::BindOnce(task, i),
+                         base::Milliseconds(1));
+
+  // The tasks coalesced with the one which quit the loop are left for the next
+  // run.
+  loop.Run();
+  EXPECT_EQ((std::vector<int>{0}), ran);
+
+  auto all_ran = base::BindRepeating(
+      [](std::vector<int>* ran) { return ran->size() == 3; }, &ran);
+  MessageLoopRunUntil(&loop, base::Seconds(5), all_ran);
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), ran);
+}
+
 }  // namespace brillo
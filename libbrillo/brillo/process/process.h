@@ -272,6 +272,14 @@ class BRILLO_EXPORT ProcessImpl : public Process {
   bool IsFileDescriptorInPipeMap(int fd) const;
   void CloseUnusedFileDescriptors();
 
+  // Returns whether the child can be started with posix_spawn(), i.e. nothing
+  // needs to run in the child that posix_spawn() cannot do.
+  bool CanUsePosixSpawn() const;
+  // Starts the child with posix_spawn(), which does not copy the page tables
+  // of the parent like fork() does. Returns the pid of the child, or -1 if it
+  // could not be started this way.
+  pid_t PosixSpawn(char* const argv[]);
+
   // Pid of currently managed process or 0 if no currently managed
   // process.  pid must not be modified except by calling
   // UpdatePid(new_pid).
@@ -286,6 +294,9 @@ class BRILLO_EXPORT ProcessImpl : public Process {
   gid_t gid_;
   pid_t pgid_;
   PreExecCallback pre_exec_;
+  // Whether a pre-exec callback was set, which requires starting the child
+  // with fork().
+  bool has_pre_exec_;
   bool search_path_;
   // Flag indicating to inherit signal mask from the parent process. It
   // is set to false by default, which means by default the child process
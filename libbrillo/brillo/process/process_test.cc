@@ -409,6 +409,17 @@ TEST_F(ProcessTest, KillSleeper) {
   EXPECT_EQ(0, process_.pid());
 }
 
+TEST_F(ProcessTest, NewProcessGroup) {
+  process_.AddArg(kBinSleep);
+  process_.AddArg("10000");
+  process_.SetPgid(0);
+  ASSERT_TRUE(process_.Start());
+  pid_t pid = process_.pid();
+  ASSERT_GT(pid, 1);
+  EXPECT_EQ(pid, getpgid(pid));
+  EXPECT_TRUE(process_.Kill(SIGTERM, 1));
+}
+
 TEST_F(ProcessTest, Reset) {
   process_.AddArg(kBinFalse);
   process_.Reset(0);
@@ -44,6 +44,8 @@ class FileDescriptor : public FileStream::FileDescriptorInterface {
   // Overrides for FileStream::FileDescriptorInterface methods.
   bool IsOpen() const override { return fd_ >= 0; }
 
+  int GetFileDescriptor() const override { return fd_; }
+
   ssize_t Read(void* buf, size_t nbyte) override {
     return HANDLE_EINTR(read(fd_, buf, nbyte));
   }
@@ -355,6 +357,10 @@ bool FileStream::CanGetSize() const {
   return IsOpen() && can_get_size_;
 }
 
+int FileStream::GetFileDescriptor() const {
+  return IsOpen() ? fd_interface_->GetFileDescriptor() : -1;
+}
+
 uint64_t FileStream::GetSize() const {
   return IsOpen() ? fd_interface_->GetSize() : 0;
 }
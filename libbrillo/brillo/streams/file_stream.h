@@ -39,6 +39,7 @@ class BRILLO_EXPORT FileStream : public Stream {
     virtual ~FileDescriptorInterface() = default;
 
     virtual bool IsOpen() const = 0;
+    virtual int GetFileDescriptor() const = 0;
     virtual ssize_t Read(void* buf, size_t nbyte) = 0;
     virtual ssize_t Write(const void* buf, size_t nbyte) = 0;
     virtual off64_t Seek(off64_t offset, int whence) = 0;
@@ -99,6 +100,7 @@ class BRILLO_EXPORT FileStream : public Stream {
   bool CanWrite() const override;
   bool CanSeek() const override;
   bool CanGetSize() const override;
+  int GetFileDescriptor() const override;
 
   // == Stream size operations ================================================
   uint64_t GetSize() const override;
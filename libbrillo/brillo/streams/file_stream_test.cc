@@ -135,6 +135,7 @@ void SetToTrue(bool* target, const Error* /* error */) {
 class MockFileDescriptor : public FileStream::FileDescriptorInterface {
  public:
   MOCK_METHOD(bool, IsOpen, (), (const, override));
+  MOCK_METHOD(int, GetFileDescriptor, (), (const, override));
   MOCK_METHOD(ssize_t, Read, (void*, size_t), (override));
   MOCK_METHOD(ssize_t, Write, (const void*, size_t), (override));
   MOCK_METHOD(off64_t, Seek, (off64_t, int), (override));
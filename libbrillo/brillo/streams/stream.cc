@@ -393,6 +393,10 @@ void Stream::FlushAsyncCallback(base::OnceClosure success_callback,
   }
 }
 
+int Stream::GetFileDescriptor() const {
+  return -1;
+}
+
 void Stream::CancelPendingAsyncOperations() {
   weak_ptr_factory_.InvalidateWeakPtrs();
   is_async_read_pending_ = false;
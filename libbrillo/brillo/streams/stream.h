@@ -134,6 +134,12 @@ class BRILLO_EXPORT Stream {
   // method can be used to check how reliable a call to GetSize() is.
   virtual bool CanGetSize() const = 0;
 
+  // Returns the file descriptor backing the stream, or -1 if the stream isn't
+  // backed by one. The descriptor remains owned by the stream. This lets
+  // stream_utils::CopyDataBlocking() move the data between two descriptors
+  // without copying it through userspace.
+  virtual int GetFileDescriptor() const;
+
   // == Stream size operations ================================================
 
   // Returns the size of stream data.
@@ -5,6 +5,11 @@
 #include <base/check_op.h>
 #include <brillo/streams/stream_utils.h>
 
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <limits>
 #include <memory>
@@ -12,12 +17,103 @@
 #include <vector>
 
 #include <base/functional/bind.h>
+#include <base/posix/eintr_wrapper.h>
+#include <brillo/errors/error_codes.h>
 #include <brillo/message_loops/message_loop.h>
 #include <brillo/streams/stream_errors.h>
 
 namespace brillo {
 namespace stream_utils {
 
+namespace {
+
+// Maximum size moved by a single copy system call, or copied through the
+// userspace buffer at once. Matches the default capacity of a pipe.
+constexpr size_t kCopyChunkSize = 64 * 1024;
+
+enum class KernelCopyMethod {
+  kNone,
+  kCopyFileRange,
+  kSendfile,
+  kSplice,
+};
+
+KernelCopyMethod GetKernelCopyMethod(int in_fd, int out_fd) {
+  struct stat in_stat;
+  struct stat out_stat;
+  if (fstat(in_fd, &in_stat) < 0 || fstat(out_fd, &out_stat) < 0)
+    return KernelCopyMethod::kNone;
+  if (S_ISFIFO(in_stat.st_mode) || S_ISFIFO(out_stat.st_mode))
+    return KernelCopyMethod::kSplice;
+  if (S_ISREG(in_stat.st_mode) && S_ISREG(out_stat.st_mode))
+    return KernelCopyMethod::kCopyFileRange;
+  // sendfile() requires an input that supports mmap, e.g. a regular file, but
+  // takes any output such as a socket.
+  if (S_ISREG(in_stat.st_mode))
+    return KernelCopyMethod::kSendfile;
+  return KernelCopyMethod::kNone;
+}
+
+ssize_t KernelCopy(KernelCopyMethod method, int in_fd, int out_fd) {
+  switch (method) {
+    case KernelCopyMethod::kCopyFileRange:
+      return HANDLE_EINTR(
+          copy_file_range(in_fd, nullptr, out_fd, nullptr, kCopyChunkSize, 0));
+    case KernelCopyMethod::kSendfile:
+      return HANDLE_EINTR(sendfile(out_fd, in_fd, nullptr, kCopyChunkSize));
+    case KernelCopyMethod::kSplice:
+      return HANDLE_EINTR(splice(in_fd, nullptr, out_fd, nullptr,
+                                 kCopyChunkSize,
+                                 SPLICE_F_MOVE | SPLICE_F_NONBLOCK));
+    case KernelCopyMethod::kNone:
+      break;
+  }
+  errno = EINVAL;
+  return -1;
+}
+
+// Copies the data between the file descriptors of the streams in the kernel.
+// Sets |use_buffer| if the kernel can't copy between these descriptors, in
+// which case the copy must be finished by the caller.
+bool CopyFileDescriptorData(Stream* in_stream,
+                            Stream* out_stream,
+                            uint64_t* size_copied,
+                            bool* use_buffer,
+                            ErrorPtr* error) {
+  const int in_fd = in_stream->GetFileDescriptor();
+  const int out_fd = out_stream->GetFileDescriptor();
+  const KernelCopyMethod method = GetKernelCopyMethod(in_fd, out_fd);
+  for (;;) {
+    ssize_t copied = KernelCopy(method, in_fd, out_fd);
+    if (copied > 0) {
+      *size_copied += copied;
+      continue;
+    }
+    if (copied == 0)
+      return true;
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      // The streams are non-blocking and either side may not be ready.
+      if (!in_stream->WaitForDataReadBlocking(base::TimeDelta::Max(), error) ||
+          !out_stream->WaitForDataWriteBlocking(base::TimeDelta::Max(),
+                                                error)) {
+        return false;
+      }
+      continue;
+    }
+    // The file offsets are kept up to date by the system calls, so the
+    // buffered copy can take over from where they stopped.
+    if (errno == EINVAL || errno == ENOSYS || errno == EXDEV ||
+        errno == EOPNOTSUPP) {
+      *use_buffer = true;
+      return true;
+    }
+    errors::system::AddSystemError(error, FROM_HERE, errno);
+    return false;
+  }
+}
+
+}  // namespace
+
 bool ErrorStreamClosed(const base::Location& location, ErrorPtr* error) {
   Error::AddTo(error, location, errors::stream::kDomain,
                errors::stream::kStreamClosed, "Stream is closed");
@@ -105,5 +201,44 @@ bool CalculateStreamPosition(const base::Location& location,
   return true;
 }
 
+bool CopyDataBlocking(Stream* in_stream,
+                      Stream* out_stream,
+                      uint64_t* size_copied,
+                      ErrorPtr* error) {
+  uint64_t copied = 0;
+  bool use_buffer = true;
+  bool success = true;
+  if (in_stream->GetFileDescriptor() >= 0 &&
+      out_stream->GetFileDescriptor() >= 0) {
+    use_buffer = false;
+    success =
+        CopyFileDescriptorData(in_stream, out_stream, &copied, &use_buffer,
+                               error);
+  }
+
+  if (success && use_buffer) {
+    std::vector<char> buffer(kCopyChunkSize);
+    for (;;) {
+      size_t size_read = 0;
+      if (!in_stream->ReadBlocking(buffer.data(), buffer.size(), &size_read,
+                                   error)) {
+        success = false;
+        break;
+      }
+      if (size_read == 0)
+        break;
+      if (!out_stream->WriteAllBlocking(buffer.data(), size_read, error)) {
+        success = false;
+        break;
+      }
+      copied += size_read;
+    }
+  }
+
+  if (size_copied)
+    *size_copied = copied;
+  return success;
+}
+
 }  // namespace stream_utils
 }  // namespace brillo
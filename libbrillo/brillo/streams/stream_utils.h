@@ -57,6 +57,19 @@ BRILLO_EXPORT bool CalculateStreamPosition(const base::Location& location,
                                            uint64_t* new_position,
                                            ErrorPtr* error);
 
+// Copies the data of |in_stream| from its current position to its end into
+// |out_stream|, blocking until done. When both streams are backed by file
+// descriptors (see Stream::GetFileDescriptor()), the data is moved in the
+// kernel with copy_file_range(), sendfile() or splice(), depending on the
+// types of the descriptors. Otherwise, or if the kernel can't copy between
+// these descriptors, the data is copied through a userspace buffer.
+// Returns false and fills in |error| on failure. The number of bytes copied,
+// even on failure, is returned in |size_copied| if not null.
+BRILLO_EXPORT bool CopyDataBlocking(Stream* in_stream,
+                                    Stream* out_stream,
+                                    uint64_t* size_copied,
+                                    ErrorPtr* error);
+
 // Checks if |mode| allows read access.
 inline bool IsReadAccessMode(Stream::AccessMode mode) {
   return mode == Stream::AccessMode::READ ||
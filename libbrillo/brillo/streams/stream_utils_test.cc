@@ -4,11 +4,18 @@
 
 #include <brillo/streams/stream_utils.h>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include <base/files/file_util.h>
+#include <base/posix/eintr_wrapper.h>
+#include <brillo/streams/file_stream.h>
+#include <brillo/streams/memory_stream.h>
 #include <brillo/streams/stream_errors.h>
 #include <gtest/gtest.h>
 
@@ -118,4 +125,84 @@ TEST(StreamUtils, CalculateStreamPosition) {
       FROM_HERE, 1, Whence::FROM_CURRENT, max_int64, end_pos, &pos, nullptr));
 }
 
+namespace {
+
+// Larger than the chunks copied at once.
+std::string MakeTestData() {
+  std::string data;
+  for (int i = 0; i < 100000; ++i)
+    data.push_back(static_cast<char>(i * 7));
+  return data;
+}
+
+std::string ReadAll(Stream* stream) {
+  std::string data(stream->GetSize(), '\0');
+  EXPECT_TRUE(stream->SetPosition(0, nullptr));
+  EXPECT_TRUE(stream->ReadAllBlocking(data.data(), data.size(), nullptr));
+  return data;
+}
+
+}  // namespace
+
+TEST(StreamUtils, CopyDataBlockingFileToFile) {
+  const std::string data = MakeTestData();
+  StreamPtr in_stream = FileStream::CreateTemporary(nullptr);
+  StreamPtr out_stream = FileStream::CreateTemporary(nullptr);
+  ASSERT_NE(nullptr, in_stream);
+  ASSERT_NE(nullptr, out_stream);
+  ASSERT_TRUE(in_stream->WriteAllBlocking(data.data(), data.size(), nullptr));
+  ASSERT_TRUE(in_stream->SetPosition(0, nullptr));
+
+  uint64_t size_copied = 0;
+  EXPECT_TRUE(stream_utils::CopyDataBlocking(in_stream.get(), out_stream.get(),
+                                             &size_copied, nullptr));
+  EXPECT_EQ(data.size(), size_copied);
+  EXPECT_EQ(data.size(), in_stream->GetPosition());
+  EXPECT_EQ(data.size(), out_stream->GetPosition());
+  EXPECT_EQ(data, ReadAll(out_stream.get()));
+}
+
+TEST(StreamUtils, CopyDataBlockingPipeToFile) {
+  const std::string data = MakeTestData();
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  StreamPtr in_stream = FileStream::FromFileDescriptor(fds[0], true, nullptr);
+  ASSERT_NE(nullptr, in_stream);
+  StreamPtr out_stream = FileStream::CreateTemporary(nullptr);
+  ASSERT_NE(nullptr, out_stream);
+  // The data is larger than the capacity of the pipe so write it from the
+  // other end of the pipe on a child process.
+  pid_t pid = fork();
+  ASSERT_NE(-1, pid);
+  if (pid == 0) {
+    close(fds[0]);
+    _exit(base::WriteFileDescriptor(fds[1], data) ? 0 : 1);
+  }
+  close(fds[1]);
+
+  uint64_t size_copied = 0;
+  EXPECT_TRUE(stream_utils::CopyDataBlocking(in_stream.get(), out_stream.get(),
+                                             &size_copied, nullptr));
+  EXPECT_EQ(data.size(), size_copied);
+  EXPECT_EQ(data, ReadAll(out_stream.get()));
+  int status = 0;
+  ASSERT_EQ(pid, HANDLE_EINTR(waitpid(pid, &status, 0)));
+  EXPECT_EQ(0, status);
+}
+
+TEST(StreamUtils, CopyDataBlockingMemoryToFile) {
+  const std::string data = MakeTestData();
+  StreamPtr in_stream = MemoryStream::OpenCopyOf(data, nullptr);
+  StreamPtr out_stream = FileStream::CreateTemporary(nullptr);
+  ASSERT_NE(nullptr, in_stream);
+  ASSERT_NE(nullptr, out_stream);
+  EXPECT_EQ(-1, in_stream->GetFileDescriptor());
+
+  uint64_t size_copied = 0;
+  EXPECT_TRUE(stream_utils::CopyDataBlocking(in_stream.get(), out_stream.get(),
+                                             &size_copied, nullptr));
+  EXPECT_EQ(data.size(), size_copied);
+  EXPECT_EQ(data, ReadAll(out_stream.get()));
+}
+
 }  // namespace brillo
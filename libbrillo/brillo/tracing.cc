@@ -7,6 +7,10 @@
 #include <base/trace_event/trace_log.h>
 #include <perfetto/perfetto.h>
 
+#include "brillo/tracing_categories.h"
+
+PERFETTO_TRACK_EVENT_STATIC_STORAGE_IN_NAMESPACE(brillo);
+
 namespace brillo {
 
 void InitPerfettoTracing() {
@@ -16,6 +20,7 @@ void InitPerfettoTracing() {
     perfetto::Tracing::Initialize(init_args);
   }
   base::TrackEvent::Register();
+  brillo::TrackEvent::Register();
 }
 
 }  // namespace brillo
@@ -16,8 +16,9 @@ namespace brillo {
 // view recorded traces. Traces can also be recorded using the `perfetto`
 // command line tool.
 //
-// By default, just built-in events from libchrome will be recorded. To add your
-// own events:
+// By default, just built-in events from libchrome and libbrillo will be
+// recorded. The latter include a "dbus" category tracing every D-Bus method
+// call handled through brillo::dbus_utils::DBusObject. To add your own events:
 //
 // 1. Define tracing categories (in a header file):
 //
@@ -0,0 +1,19 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIBBRILLO_BRILLO_TRACING_CATEGORIES_H_
+#define LIBBRILLO_BRILLO_TRACING_CATEGORIES_H_
+
+#include <perfetto/perfetto.h>
+
+// Trace categories of the events emitted by libbrillo itself. They are
+// registered by brillo::InitPerfettoTracing(), so every daemon that enables
+// tracing also records them.
+PERFETTO_DEFINE_CATEGORIES_IN_NAMESPACE(
+    brillo,
+    perfetto::Category("dbus").SetDescription(
+        "D-Bus method calls handled through brillo::dbus_utils, from dispatch "
+        "until the response is sent"));
+
+#endif  // LIBBRILLO_BRILLO_TRACING_CATEGORIES_H_
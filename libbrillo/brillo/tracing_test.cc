@@ -13,6 +13,8 @@
 #include <gtest/gtest.h>
 #include <perfetto/perfetto.h>
 
+#include "brillo/tracing_categories.h"
+
 namespace brillo {
 
 class TracingTest : public ::testing::Test {
@@ -65,4 +67,23 @@ TEST_F(TracingTest, RunLoopTracing) {
   EXPECT_THAT(trace_str, testing::HasSubstr("RunLoop::Run"));
 }
 
+TEST_F(TracingTest, BrilloCategories) {
+  perfetto::TracingInitArgs init_args;
+  init_args.backends = perfetto::BackendType::kInProcessBackend;
+  perfetto::Tracing::Initialize(init_args);
+  brillo::InitPerfettoTracing();
+  EXPECT_FALSE(TRACE_EVENT_CATEGORY_ENABLED("dbus"));
+
+  perfetto::TraceConfig cfg;
+  cfg.add_buffers()->set_size_kb(1024);
+  auto* ds_cfg = cfg.add_data_sources()->mutable_config();
+  ds_cfg->set_name("track_event");
+
+  auto tracing_session = perfetto::Tracing::NewTrace();
+  tracing_session->Setup(cfg);
+  tracing_session->StartBlocking();
+  EXPECT_TRUE(TRACE_EVENT_CATEGORY_ENABLED("dbus"));
+  tracing_session->StopBlocking();
+}
+
 }  // namespace brillo
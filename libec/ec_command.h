@@ -7,6 +7,7 @@
 
 #include <sys/ioctl.h>
 
+#include <array>
 #include <cerrno>
 #include <cstddef>
 #include <cstdint>
@@ -16,6 +17,7 @@
 
 #include <string>
 
+#include <base/check_op.h>
 #include <base/logging.h>
 #include <chromeos/ec/cros_ec_dev.h>
 #include <chromeos/ec/ec_commands.h>
@@ -264,15 +266,17 @@ bool EcCommand<Params, Response>::Run(ec::EcUsbEndpointInterface& uep) {
     return false;
   }
 
+  // The request and response are at most as large as |request_| and
+  // |response_|, so the packets are built on the stack rather than allocated
+  // for every command.
+  CHECK_LE(cmd_.outsize, realsizeof<Params>);
+  CHECK_LE(cmd_.insize, realsizeof<Response>);
+  alignas(struct ec_host_request) std::array<
+      uint8_t, sizeof(struct ec_host_request) + realsizeof<Params>>
+      req_buf{};
   size_t req_len = sizeof(struct ec_host_request) + cmd_.outsize;
-  uint8_t* req_buf = reinterpret_cast<uint8_t*>(malloc(req_len));
-  if (req_buf == nullptr) {
-    LOG(ERROR) << "Failed to allocate memory for request";
-    uep.ReleaseInterface();
-    return false;
-  }
-  struct ec_host_request* req = (struct ec_host_request*)req_buf;
-  uint8_t* req_data = req_buf + sizeof(struct ec_host_request);
+  struct ec_host_request* req = (struct ec_host_request*)req_buf.data();
+  uint8_t* req_data = req_buf.data() + sizeof(struct ec_host_request);
 
   req->struct_version = EC_HOST_REQUEST_VERSION; /* 3 */
   req->checksum = 0;
@@ -284,17 +288,12 @@ bool EcCommand<Params, Response>::Run(ec::EcUsbEndpointInterface& uep) {
     memcpy(req_data, &request_, cmd_.outsize);
   req->checksum = (uint8_t)(-sum_bytes(req, req_len));
 
+  alignas(struct ec_host_response) std::array<
+      uint8_t, sizeof(struct ec_host_response) + realsizeof<Response>>
+      res_buf{};
   size_t res_len = sizeof(struct ec_host_response) + cmd_.insize;
-  uint8_t* res_buf = reinterpret_cast<uint8_t*>(malloc(res_len));
-  if (res_buf == nullptr) {
-    LOG(ERROR) << "Failed to allocate memory for response";
-    free(req);
-    uep.ReleaseInterface();
-    return false;
-  }
-  struct ec_host_response* res = (struct ec_host_response*)res_buf;
-  uint8_t* res_data = res_buf + sizeof(struct ec_host_response);
-  memset(res_buf, 0, res_len);
+  struct ec_host_response* res = (struct ec_host_response*)res_buf.data();
+  uint8_t* res_data = res_buf.data() + sizeof(struct ec_host_response);
 
   if (usb_xfer(uep.GetEndpointPtr(), req, req_len, res, res_len)) {
     LOG(ERROR) << "Command 0x" << std::hex << cmd_.command << std::dec
@@ -306,9 +305,6 @@ bool EcCommand<Params, Response>::Run(ec::EcUsbEndpointInterface& uep) {
     }
   }
 
-  free(req);
-  free(res);
-
   /* We may fail here but the command was successfully executed. */
   uep.ReleaseInterface();
 
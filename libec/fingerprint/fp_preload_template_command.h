@@ -34,7 +34,7 @@ class BRILLO_EXPORT FpPreloadTemplateCommand
 
     // Using new to access non-public constructor. See
     // https://abseil.io/tips/134.
-    return base::WrapUnique(new T(finger, tmpl, max_write_size));
+    return base::WrapUnique(new T(finger, std::move(tmpl), max_write_size));
   }
 
   ~FpPreloadTemplateCommand() override = default;
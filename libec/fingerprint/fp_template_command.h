@@ -32,7 +32,7 @@ class BRILLO_EXPORT FpTemplateCommand
 
     // Using new to access non-public constructor. See
     // https://abseil.io/tips/134.
-    return base::WrapUnique(new T(tmpl, max_write_size));
+    return base::WrapUnique(new T(std::move(tmpl), max_write_size));
   }
 
   ~FpTemplateCommand() override = default;
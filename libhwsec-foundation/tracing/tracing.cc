@@ -0,0 +1,40 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "libhwsec-foundation/tracing/tracing.h"
+
+#include <string_view>
+
+#include <brillo/tracing.h>
+#include <perfetto/perfetto.h>
+
+// The category lives in the shared library, so that all the hwsec code loaded
+// in a process shares the same track event data source.
+PERFETTO_DEFINE_CATEGORIES_IN_NAMESPACE(
+    hwsec_foundation,
+    perfetto::Category("hwsec").SetDescription(
+        "Events from the hardware security stack"));
+
+PERFETTO_TRACK_EVENT_STATIC_STORAGE_IN_NAMESPACE(hwsec_foundation);
+
+namespace hwsec_foundation {
+
+void InitTracing() {
+  brillo::InitPerfettoTracing();
+  TrackEvent::Register();
+}
+
+bool IsTracingEnabled() {
+  return TRACE_EVENT_CATEGORY_ENABLED("hwsec");
+}
+
+ScopedTrace::ScopedTrace(std::string_view name) {
+  TRACE_EVENT_BEGIN("hwsec", perfetto::DynamicString(name.data(), name.size()));
+}
+
+ScopedTrace::~ScopedTrace() {
+  TRACE_EVENT_END("hwsec");
+}
+
+}  // namespace hwsec_foundation
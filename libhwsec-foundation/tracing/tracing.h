@@ -0,0 +1,42 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIBHWSEC_FOUNDATION_TRACING_TRACING_H_
+#define LIBHWSEC_FOUNDATION_TRACING_TRACING_H_
+
+#include <string_view>
+
+#include "libhwsec-foundation/hwsec-foundation_export.h"
+
+namespace hwsec_foundation {
+
+// Connects the process to the system tracing service and registers the "hwsec"
+// Perfetto track event category. Needs to be called once from the main
+// function for the events below to be recorded.
+HWSEC_FOUNDATION_EXPORT void InitTracing();
+
+// Returns true if a tracing session currently records the "hwsec" category.
+// Useful to skip building the name of an event nobody records.
+HWSEC_FOUNDATION_EXPORT bool IsTracingEnabled();
+
+// Records a slice named |name| in the "hwsec" category, covering the lifetime
+// of the object. This costs a single check when no session records the
+// category.
+//
+// Example:
+//   {
+//     ScopedTrace trace("Sign");
+//     ...
+//   }
+class HWSEC_FOUNDATION_EXPORT ScopedTrace {
+ public:
+  explicit ScopedTrace(std::string_view name);
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+  ~ScopedTrace();
+};
+
+}  // namespace hwsec_foundation
+
+#endif  // LIBHWSEC_FOUNDATION_TRACING_TRACING_H_
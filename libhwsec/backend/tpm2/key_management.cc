@@ -638,8 +638,16 @@ StatusOr<ScopedKey> KeyManagementTpm2::LoadKey(
     const OperationPolicy& policy,
     const brillo::Blob& key_blob,
     const LoadKeyOptions& load_key_options) {
-  if (load_key_options.auto_reload == true && policy.device_configs.none()) {
-    for (auto& [token, key_data] : key_map_) {
+  const brillo::Blob key_blob_digest = Sha256(key_blob);
+  auto index_it = reloadable_key_tokens_.find(key_blob_digest);
+  if (load_key_options.auto_reload == true && policy.device_configs.none() &&
+      index_it != reloadable_key_tokens_.end()) {
+    for (KeyToken token : index_it->second) {
+      auto key_it = key_map_.find(token);
+      if (key_it == key_map_.end()) {
+        continue;
+      }
+      KeyTpm2& key_data = key_it->second;
       if (IsKeyDataMatch(key_data, key_blob, policy)) {
         if (key_data.reload_data->flush_timer != nullptr) {
           key_data.reload_data->flush_timer->Stop();
@@ -683,7 +691,13 @@ StatusOr<ScopedKey> KeyManagementTpm2::LoadKey(
     };
   }
 
-  return LoadKeyInternal(policy, key_type, key_handle, std::move(reload_data));
+  ASSIGN_OR_RETURN(
+      ScopedKey key,
+      LoadKeyInternal(policy, key_type, key_handle, std::move(reload_data)));
+  if (key_type == KeyTpm2::Type::kReloadableTransientKey) {
+    reloadable_key_tokens_[key_blob_digest].push_back(key.GetKey().token);
+  }
+  return key;
 }
 
 StatusOr<ScopedKey> KeyManagementTpm2::GetPolicyEndorsementKey(
@@ -951,6 +965,10 @@ Status KeyManagementTpm2::FlushTransientKey(Key key, KeyTpm2& key_data) {
 
 Status KeyManagementTpm2::FlushKeyTokenAndHandle(KeyToken token,
                                                  trunks::TPM_HANDLE handle) {
+  // The key is dropped by its clients even if the flush fails, so it must not
+  // be handed out again by LoadKey().
+  EraseReloadableKeyToken(token);
+
   RETURN_IF_ERROR(MakeStatus<TPM2Error>(
                       context_.GetTrunksFactory().GetTpm()->FlushContextSync(
                           handle, nullptr)))
@@ -960,6 +978,25 @@ Status KeyManagementTpm2::FlushKeyTokenAndHandle(KeyToken token,
   return OkStatus();
 }
 
+void KeyManagementTpm2::EraseReloadableKeyToken(KeyToken token) {
+  auto key_it = key_map_.find(token);
+  if (key_it == key_map_.end() || !key_it->second.reload_data.has_value()) {
+    return;
+  }
+
+  auto index_it = reloadable_key_tokens_.find(
+      Sha256(key_it->second.reload_data->key_blob));
+  if (index_it == reloadable_key_tokens_.end()) {
+    return;
+  }
+
+  std::vector<KeyToken>& tokens = index_it->second;
+  tokens.erase(std::remove(tokens.begin(), tokens.end(), token), tokens.end());
+  if (tokens.empty()) {
+    reloadable_key_tokens_.erase(index_it);
+  }
+}
+
 StatusOr<std::reference_wrapper<KeyTpm2>> KeyManagementTpm2::GetKeyData(
     Key key) {
   auto it = key_map_.find(key.token);
@@ -11,6 +11,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
@@ -149,6 +150,7 @@ class KeyManagementTpm2 : public KeyManagement {
       std::optional<KeyReloadDataTpm2> reload_data);
   Status FlushTransientKey(Key key, KeyTpm2& key_data);
   Status FlushKeyTokenAndHandle(KeyToken token, trunks::TPM_HANDLE handle);
+  void EraseReloadableKeyToken(KeyToken token);
   StatusOr<ECCPublicInfo> GetECCPublicInfoFromPublicData(
       const trunks::TPMT_PUBLIC& public_data);
   StatusOr<crypto::ScopedEC_KEY> GetEccPublicKey(
@@ -164,6 +166,11 @@ class KeyManagementTpm2 : public KeyManagement {
   KeyToken current_token_ = 0;
   absl::flat_hash_map<KeyToken, KeyTpm2> key_map_;
   absl::flat_hash_map<PersistentKeyType, KeyToken> persistent_key_map_;
+  // The tokens of the reloadable transient keys, indexed by the SHA-256 digest
+  // of their key blob, to reuse a loaded key when the same blob is loaded
+  // again.
+  absl::flat_hash_map<brillo::Blob, std::vector<KeyToken>>
+      reloadable_key_tokens_;
   bool shall_flush_immediately_ = false;
 };
 
@@ -1229,6 +1229,99 @@ TEST_F(BackendKeyManagementTpm2Test, LoadRefCountReloadKey) {
       .WillOnce(Return(trunks::TPM_RC_SUCCESS));
 }
 
+TEST_F(BackendKeyManagementTpm2Test, LoadDifferentReloadKeys) {
+  const OperationPolicy kFakePolicy{};
+  const std::string kFakeKeyBlob = "fake_key_blob";
+  const std::string kFakeKeyBlob2 = "fake_key_blob2";
+  const uint32_t kFakeKeyHandle = 0x1337;
+  const uint32_t kFakeKeyHandle2 = 0x7331;
+  const uint32_t kFakeKeyHandle3 = 0x7133;
+
+  EXPECT_CALL(proxy_->GetMockTpmUtility(), LoadKey(kFakeKeyBlob, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(kFakeKeyHandle),
+                      Return(trunks::TPM_RC_SUCCESS)));
+  EXPECT_CALL(proxy_->GetMockTpmUtility(), LoadKey(kFakeKeyBlob2, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(kFakeKeyHandle2),
+                      Return(trunks::TPM_RC_SUCCESS)));
+  EXPECT_CALL(proxy_->GetMockTpmUtility(), GetKeyPublicArea(_, _))
+      .WillRepeatedly(Return(trunks::TPM_RC_SUCCESS));
+
+  auto result1 = backend_->GetKeyManagementTpm2().LoadKey(
+      kFakePolicy, brillo::BlobFromString(kFakeKeyBlob),
+      Backend::KeyManagement::LoadKeyOptions{.auto_reload = true});
+  ASSERT_OK(result1);
+
+  auto result2 = backend_->GetKeyManagementTpm2().LoadKey(
+      kFakePolicy, brillo::BlobFromString(kFakeKeyBlob2),
+      Backend::KeyManagement::LoadKeyOptions{.auto_reload = true});
+  ASSERT_OK(result2);
+
+  EXPECT_NE(result1->GetKey().token, result2->GetKey().token);
+
+  EXPECT_CALL(proxy_->GetMockTpm(), FlushContextSync(kFakeKeyHandle, _))
+      .WillOnce(Return(trunks::TPM_RC_SUCCESS));
+
+  {
+    // Move out the key and drop it.
+    ScopedKey drop_key = std::move(result1).value();
+  }
+
+  // The flushed key should be loaded again.
+  EXPECT_CALL(proxy_->GetMockTpmUtility(), LoadKey(kFakeKeyBlob, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(kFakeKeyHandle3),
+                      Return(trunks::TPM_RC_SUCCESS)));
+
+  auto result3 = backend_->GetKeyManagementTpm2().LoadKey(
+      kFakePolicy, brillo::BlobFromString(kFakeKeyBlob),
+      Backend::KeyManagement::LoadKeyOptions{.auto_reload = true});
+  ASSERT_OK(result3);
+
+  EXPECT_CALL(proxy_->GetMockTpm(), FlushContextSync(kFakeKeyHandle2, _))
+      .WillOnce(Return(trunks::TPM_RC_SUCCESS));
+  EXPECT_CALL(proxy_->GetMockTpm(), FlushContextSync(kFakeKeyHandle3, _))
+      .WillOnce(Return(trunks::TPM_RC_SUCCESS));
+}
+
+TEST_F(BackendKeyManagementTpm2Test, LoadReloadKeyAfterFailedFlush) {
+  const OperationPolicy kFakePolicy{};
+  const std::string kFakeKeyBlob = "fake_key_blob";
+  const uint32_t kFakeKeyHandle = 0x1337;
+  const uint32_t kFakeKeyHandle2 = 0x7331;
+
+  EXPECT_CALL(proxy_->GetMockTpmUtility(), LoadKey(kFakeKeyBlob, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(kFakeKeyHandle),
+                      Return(trunks::TPM_RC_SUCCESS)));
+  EXPECT_CALL(proxy_->GetMockTpmUtility(), GetKeyPublicArea(_, _))
+      .WillRepeatedly(Return(trunks::TPM_RC_SUCCESS));
+
+  auto result1 = backend_->GetKeyManagementTpm2().LoadKey(
+      kFakePolicy, brillo::BlobFromString(kFakeKeyBlob),
+      Backend::KeyManagement::LoadKeyOptions{.auto_reload = true});
+  ASSERT_OK(result1);
+
+  EXPECT_CALL(proxy_->GetMockTpm(), FlushContextSync(kFakeKeyHandle, _))
+      .WillOnce(Return(trunks::TPM_RC_FAILURE))
+      .WillOnce(Return(trunks::TPM_RC_SUCCESS));
+
+  {
+    // Move out the key and drop it.
+    ScopedKey drop_key = std::move(result1).value();
+  }
+
+  // The dropped key should not be reused, even though it failed to flush.
+  EXPECT_CALL(proxy_->GetMockTpmUtility(), LoadKey(kFakeKeyBlob, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(kFakeKeyHandle2),
+                      Return(trunks::TPM_RC_SUCCESS)));
+
+  auto result2 = backend_->GetKeyManagementTpm2().LoadKey(
+      kFakePolicy, brillo::BlobFromString(kFakeKeyBlob),
+      Backend::KeyManagement::LoadKeyOptions{.auto_reload = true});
+  ASSERT_OK(result2);
+
+  EXPECT_CALL(proxy_->GetMockTpm(), FlushContextSync(kFakeKeyHandle2, _))
+      .WillOnce(Return(trunks::TPM_RC_SUCCESS));
+}
+
 TEST_F(BackendKeyManagementTpm2Test, LoadAndLazyFlushKey) {
   const OperationPolicy kFakePolicy{
       .permission = Permission{.auth_value = brillo::SecureBlob("auth_value")}};
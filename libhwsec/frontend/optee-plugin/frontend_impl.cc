@@ -5,6 +5,7 @@
 #include "libhwsec/frontend/optee-plugin/frontend_impl.h"
 
 #include <optional>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -20,33 +21,37 @@ using hwsec_foundation::status::MakeStatus;
 
 namespace hwsec {
 
+namespace {
+
+StatusOr<brillo::Blob> ReadRoSpace(const Middleware& middleware,
+                                   RoSpace space) {
+  // Checks and reads the space in a single middleware task, the result of the
+  // read is dropped if the space is not ready.
+  auto [is_ready_result, read_result] =
+      middleware.CallSyncBatch<&Backend::RoData::IsReady,
+                               &Backend::RoData::Read>(std::make_tuple(space),
+                                                       std::make_tuple(space));
+  ASSIGN_OR_RETURN(bool is_ready, std::move(is_ready_result),
+                   _.WithStatus<TPMError>("NV space not ready"));
+  if (!is_ready) {
+    return MakeStatus<TPMError>("NV space not ready", TPMRetryAction::kNoRetry);
+  }
+  return std::move(read_result);
+}
+
+}  // namespace
+
 StatusOr<brillo::Blob> OpteePluginFrontendImpl::SendRawCommand(
     const brillo::Blob& command) const {
   return middleware_.CallSync<&Backend::Vendor::SendRawCommand>(command);
 }
 
 StatusOr<brillo::Blob> OpteePluginFrontendImpl::GetRootOfTrustCert() const {
-  ASSIGN_OR_RETURN(bool is_ready,
-                   middleware_.CallSync<&Backend::RoData::IsReady>(
-                       RoSpace::kWidevineRootOfTrustCert),
-                   _.WithStatus<TPMError>("NV space not ready"));
-  if (!is_ready) {
-    return MakeStatus<TPMError>("NV space not ready", TPMRetryAction::kNoRetry);
-  }
-  return middleware_.CallSync<&Backend::RoData::Read>(
-      RoSpace::kWidevineRootOfTrustCert);
+  return ReadRoSpace(middleware_, RoSpace::kWidevineRootOfTrustCert);
 }
 
 StatusOr<brillo::Blob> OpteePluginFrontendImpl::GetChipIdentifyKeyCert() const {
-  ASSIGN_OR_RETURN(bool is_ready,
-                   middleware_.CallSync<&Backend::RoData::IsReady>(
-                       RoSpace::kChipIdentityKeyCert),
-                   _.WithStatus<TPMError>("NV space not ready"));
-  if (!is_ready) {
-    return MakeStatus<TPMError>("NV space not ready", TPMRetryAction::kNoRetry);
-  }
-  return middleware_.CallSync<&Backend::RoData::Read>(
-      RoSpace::kChipIdentityKeyCert);
+  return ReadRoSpace(middleware_, RoSpace::kChipIdentityKeyCert);
 }
 
 }  // namespace hwsec
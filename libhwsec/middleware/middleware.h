@@ -6,6 +6,7 @@
 #define LIBHWSEC_MIDDLEWARE_MIDDLEWARE_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -25,6 +26,7 @@
 #include <base/task/task_runner.h>
 #include <base/threading/thread.h>
 
+#include "libhwsec-foundation/tracing/tracing.h"
 #include "libhwsec/backend/backend.h"
 #include "libhwsec/error/tpm_retry_action.h"
 #include "libhwsec/error/tpm_retry_handler.h"
@@ -118,6 +120,62 @@ class Middleware {
     middleware_derivative_.task_runner->PostTask(FROM_HERE, std::move(task));
   }
 
+  // Call multiple synchronous backend functions in a single middleware task,
+  // to avoid a thread hop per function. Each argument is a tuple of the
+  // parameters of the corresponding function. The functions are called in the
+  // given order, and the results are returned together.
+  //
+  // Example:
+  //   auto [is_enabled, is_ready] =
+  //       middleware.CallSyncBatch<&Backend::State::IsEnabled,
+  //                                &Backend::State::IsReady>(std::tuple<>(),
+  //                                                          std::tuple<>());
+  template <auto... Funcs, typename... ArgsTuples>
+  auto CallSyncBatch(ArgsTuples&&... args_tuples) const {
+    static_assert(sizeof...(Funcs) == sizeof...(ArgsTuples),
+                  "Every function needs a tuple of parameters!");
+    static_assert(
+        ((SubClassHelper<decltype(Funcs)>::type == CallType::kSync) && ...),
+        "Only synchronous backend functions can be batched!");
+    using Results = std::tuple<SubClassResult<decltype(Funcs)>...>;
+
+    base::OnceCallback<Results()> task = base::BindOnce(
+        [](base::WeakPtr<MiddlewareOwner> middleware,
+           std::decay_t<ArgsTuples>... args) {
+          // The braced initialization guarantees the calling order.
+          return Results{std::apply(
+              [&middleware](auto&&... func_args) {
+                return DoSyncBackendCall<Funcs>(middleware,
+                                                std::move(func_args)...);
+              },
+              std::move(args))...};
+        },
+        middleware_derivative_.middleware,
+        std::decay_t<ArgsTuples>(std::forward<ArgsTuples>(args_tuples))...);
+
+    if (middleware_derivative_.thread_id == base::PlatformThread::CurrentId()) {
+      return std::move(task).Run();
+    }
+
+    CHECK(middleware_derivative_.task_runner);
+
+    base::WaitableEvent event(base::WaitableEvent::ResetPolicy::MANUAL,
+                              base::WaitableEvent::InitialState::NOT_SIGNALED);
+    std::optional<Results> results;
+    base::OnceClosure closure =
+        std::move(task)
+            .Then(base::BindOnce(
+                [](std::optional<Results>* results_ptr, Results value) {
+                  results_ptr->emplace(std::move(value));
+                },
+                &results))
+            .Then(base::BindOnce(&base::WaitableEvent::Signal,
+                                 base::Unretained(&event)));
+    middleware_derivative_.task_runner->PostTask(FROM_HERE, std::move(closure));
+    event.Wait();
+    return std::move(*results);
+  }
+
   // Run a blocking task in the middleware.
   template <typename Result>
   Result RunBlockingTask(base::OnceCallback<Result()> task) const {
@@ -283,11 +341,13 @@ class Middleware {
     }
 
     Type* sub = *std::get_if<Type*>(&quick_result);
+    const std::string func_name = GetFuncName<Func>();
 
     for (TPMRetryHandler retry_handler;;) {
+      hwsec_foundation::ScopedTrace trace(func_name);
       SubClassResult<decltype(Func)> result = (sub->*Func)(args...);
 
-      TrackFuncResult(GetFuncName<Func>(), middleware->metrics_.get(), result);
+      TrackFuncResult(func_name, middleware->metrics_.get(), result);
 
       if (retry_handler.HandleResult(result, *middleware->backend_, args...)) {
         return result;
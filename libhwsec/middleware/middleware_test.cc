@@ -0,0 +1,94 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "libhwsec/middleware/middleware.h"
+
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include <base/test/task_environment.h>
+#include <brillo/secure_blob.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <libhwsec-foundation/error/testing_helper.h>
+
+#include "libhwsec/backend/mock_backend.h"
+#include "libhwsec/middleware/middleware_owner.h"
+#include "libhwsec/structures/threading_mode.h"
+
+using hwsec_foundation::error::testing::IsOkAndHolds;
+using hwsec_foundation::error::testing::NotOk;
+using hwsec_foundation::error::testing::ReturnError;
+using hwsec_foundation::error::testing::ReturnValue;
+using testing::InSequence;
+
+namespace hwsec {
+
+class MiddlewareTest : public testing::TestWithParam<ThreadingMode> {
+ public:
+  void SetUp() override {
+    auto mock_backend = std::make_unique<MockBackend>();
+    mock_backend_ = mock_backend.get();
+    middleware_owner_ =
+        std::make_unique<MiddlewareOwner>(std::move(mock_backend), GetParam());
+  }
+
+  void TearDown() override { middleware_owner_.reset(); }
+
+ protected:
+  MockBackend::MockBackendData& GetMock() { return mock_backend_->GetMock(); }
+
+  Middleware GetMiddleware() {
+    return Middleware(middleware_owner_->Derive());
+  }
+
+  base::test::SingleThreadTaskEnvironment task_environment_;
+  MockBackend* mock_backend_ = nullptr;
+  std::unique_ptr<MiddlewareOwner> middleware_owner_;
+};
+
+TEST_P(MiddlewareTest, CallSyncBatch) {
+  const brillo::Blob kFakeBlob = brillo::BlobFromString("fake_blob");
+  {
+    InSequence seq;
+    EXPECT_CALL(GetMock().state, IsEnabled).WillOnce(ReturnValue(true));
+    EXPECT_CALL(GetMock().state, IsReady).WillOnce(ReturnValue(false));
+    EXPECT_CALL(GetMock().random, RandomBlob(kFakeBlob.size()))
+        .WillOnce(ReturnValue(kFakeBlob));
+  }
+
+  auto [is_enabled, is_ready, random] =
+      GetMiddleware()
+          .CallSyncBatch<&Backend::State::IsEnabled, &Backend::State::IsReady,
+                         &Backend::Random::RandomBlob>(
+              std::tuple<>(), std::tuple<>(),
+              std::make_tuple(kFakeBlob.size()));
+
+  EXPECT_THAT(is_enabled, IsOkAndHolds(true));
+  EXPECT_THAT(is_ready, IsOkAndHolds(false));
+  EXPECT_THAT(random, IsOkAndHolds(kFakeBlob));
+}
+
+TEST_P(MiddlewareTest, CallSyncBatchPartialFailure) {
+  EXPECT_CALL(GetMock().state, IsEnabled)
+      .WillOnce(ReturnError<TPMError>("fake", TPMRetryAction::kNoRetry));
+  EXPECT_CALL(GetMock().state, IsReady).WillOnce(ReturnValue(true));
+
+  auto [is_enabled, is_ready] =
+      GetMiddleware()
+          .CallSyncBatch<&Backend::State::IsEnabled, &Backend::State::IsReady>(
+              std::tuple<>(), std::tuple<>());
+
+  EXPECT_THAT(is_enabled, NotOk());
+  EXPECT_THAT(is_ready, IsOkAndHolds(true));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ThreadingModes,
+    MiddlewareTest,
+    testing::Values(ThreadingMode::kStandaloneWorkerThread,
+                    ThreadingMode::kCurrentThread));
+
+}  // namespace hwsec
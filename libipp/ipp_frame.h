@@ -6,7 +6,9 @@
 #define LIBIPP_IPP_FRAME_H_
 
 #include <cstdint>
+#include <deque>
 #include <list>
+#include <string_view>
 #include <vector>
 
 #include "ipp_enums.h"
@@ -24,15 +26,25 @@ struct TagNameValue {
   std::vector<uint8_t> value;
 };
 
+// The same as TagNameValue but |name| and |value| point into the buffer being
+// parsed, so the buffer must outlive it. Used by the parser to avoid copying
+// every TNV before it is decoded.
+struct TagNameValueView {
+  uint8_t tag;
+  std::string_view name;
+  std::string_view value;
+};
+
 // This represents single IPP frame, described in rfc8010.
 struct FrameData {
   // Variables save to/load from a frame's header.
   uint16_t version_;
   int16_t operation_id_or_status_code_;
   int32_t request_id_;
-  // The content of frame being (internal buffer).
+  // The content of frame being (internal buffer). The TNVs of parsed frames
+  // point into the input buffer.
   std::vector<GroupTag> groups_tags_;
-  std::vector<std::list<TagNameValue>> groups_content_;
+  std::vector<std::deque<TagNameValueView>> groups_content_;
   std::vector<uint8_t> data_;
 };
 
@@ -4,6 +4,7 @@
 
 #include "libipp/ipp_parser.h"
 #include <set>
+#include <string_view>
 
 #include "libipp/frame.h"
 #include "libipp/ipp_encoding.h"
@@ -20,27 +21,27 @@ constexpr int kMaxCollectionLevel = 16;
 // Decodes 1-, 2- or 4-bytes integers (two's-complement binary encoding).
 // Returns false if (data.size() != BytesCount) or (out == nullptr).
 template <size_t BytesCount>
-bool LoadInteger(const std::vector<uint8_t>& data, int32_t* out) {
+bool LoadInteger(std::string_view data, int32_t* out) {
   if ((data.size() != BytesCount) || (out == nullptr))
     return false;
-  const uint8_t* ptr = data.data();
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data.data());
   ParseSignedInteger<BytesCount>(&ptr, out);
   return true;
 }
 
 // Reads simple string from buf.
-std::string LoadString(const std::vector<uint8_t>& buf) {
-  return std::string(buf.data(), buf.data() + buf.size());
+std::string LoadString(std::string_view buf) {
+  return std::string(buf);
 }
 
 // Reads textWithLanguage/nameWithLanguage (see [rfc8010], section 3.9) from
 // buf. Returns false if given content is invalid or (out == nullptr).
-bool LoadStringWithLanguage(const std::vector<uint8_t>& buf,
+bool LoadStringWithLanguage(std::string_view buf,
                             ipp::StringWithLanguage* out) {
   // The shortest possible value has 4 bytes: 2 times 2-bytes zero.
   if ((buf.size() < 4) || (out == nullptr))
     return false;
-  const uint8_t* ptr = buf.data();
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(buf.data());
   size_t length;
   if (!ParseUnsignedInteger<2>(&ptr, &length))
     return false;
@@ -58,10 +59,10 @@ bool LoadStringWithLanguage(const std::vector<uint8_t>& buf,
 
 // Reads dateTime (see [rfc8010]) from buf.
 // Fails when binary representation has invalid size or (out == nullptr).
-bool LoadDateTime(const std::vector<uint8_t>& buf, ipp::DateTime* out) {
+bool LoadDateTime(std::string_view buf, ipp::DateTime* out) {
   if ((buf.size() != 11) || (out == nullptr))
     return false;
-  const uint8_t* ptr = buf.data();
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(buf.data());
   return (ParseUnsignedInteger<2>(&ptr, &out->year) &&
           ParseUnsignedInteger<1>(&ptr, &out->month) &&
           ParseUnsignedInteger<1>(&ptr, &out->day) &&
@@ -76,10 +77,10 @@ bool LoadDateTime(const std::vector<uint8_t>& buf, ipp::DateTime* out) {
 
 // Reads resolution (see [rfc8010]) from buf.
 // Fails when binary representation has invalid size or (out == nullptr).
-bool LoadResolution(const std::vector<uint8_t>& buf, ipp::Resolution* out) {
+bool LoadResolution(std::string_view buf, ipp::Resolution* out) {
   if ((buf.size() != 9) || (out == nullptr))
     return false;
-  const uint8_t* ptr = buf.data();
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(buf.data());
   ParseSignedInteger<4>(&ptr, &out->xres);
   ParseSignedInteger<4>(&ptr, &out->yres);
   int8_t units;
@@ -90,11 +91,10 @@ bool LoadResolution(const std::vector<uint8_t>& buf, ipp::Resolution* out) {
 
 // Reads rangeOfInteger (see [rfc8010]) from buf.
 // Fails when binary representation has invalid size or (out == nullptr).
-bool LoadRangeOfInteger(const std::vector<uint8_t>& buf,
-                        ipp::RangeOfInteger* out) {
+bool LoadRangeOfInteger(std::string_view buf, ipp::RangeOfInteger* out) {
   if ((buf.size() != 8) || (out == nullptr))
     return false;
-  const uint8_t* ptr = buf.data();
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(buf.data());
   ParseSignedInteger<4>(&ptr, &out->min_value);
   ParseSignedInteger<4>(&ptr, &out->max_value);
   return true;
@@ -165,12 +165,13 @@ void Parser::LogParserErrors(const std::vector<ParserCode>& error_codes) {
 struct RawValue {
   // original tag (IsValid(tag))
   ValueTag tag;
-  // original data, empty when (tag == collection), content not verified
-  std::vector<uint8_t> data;
+  // original data, empty when (tag == collection), content not verified;
+  // points into the buffer being parsed
+  std::string_view data;
   // (not nullptr) <=> (tag == collection)
   std::unique_ptr<RawCollection> collection;
   // create as standard value
-  RawValue(ValueTag tag, const std::vector<uint8_t>& data)
+  RawValue(ValueTag tag, std::string_view data)
       : tag(tag), data(data) {}
   // create as collection
   explicit RawValue(RawCollection* coll)
@@ -185,7 +186,7 @@ struct RawAttribute {
   std::string name;
   // parsed values (see RawValue)
   std::vector<RawValue> values;
-  explicit RawAttribute(const std::string& name) : name(name) {}
+  explicit RawAttribute(std::string name) : name(std::move(name)) {}
 };
 
 // Temporary representation of a collection parsed from TNVs.
@@ -440,10 +441,10 @@ bool Parser::ReadFrameFromBuffer(const uint8_t* ptr,
 // output is saved but parsing occurs as usual.
 bool Parser::ReadTNVsFromBuffer(const uint8_t** ptr2,
                                 const uint8_t* const buf_end,
-                                std::list<TagNameValue>* tnvs) {
+                                std::deque<TagNameValueView>* tnvs) {
   const uint8_t*& ptr = *ptr2;
   while ((ptr < buf_end) && (*ptr > max_begin_attribute_group_tag)) {
-    TagNameValue tnv;
+    TagNameValueView tnv;
 
     if (buf_end - ptr < 5) {
       // Expected at least 1-byte tag, 2-bytes name-length and 2-bytes
@@ -464,7 +465,8 @@ bool Parser::ReadTNVsFromBuffer(const uint8_t** ptr2,
       LogParserError(ParserCode::kUnexpectedEndOfFrame, ptr);
       return false;
     }
-    tnv.name.assign(ptr, ptr + length);
+    tnv.name =
+        std::string_view(reinterpret_cast<const char*>(ptr), length);
     ptr += length;
     if (!ParseUnsignedInteger<2>(&ptr, &length)) {
       LogParserError(ParserCode::kNegativeValueLengthInTNV, ptr);
@@ -474,10 +476,11 @@ bool Parser::ReadTNVsFromBuffer(const uint8_t** ptr2,
       LogParserError(ParserCode::kUnexpectedEndOfFrame, ptr);
       return false;
     }
-    tnv.value.assign(ptr, ptr + length);
+    tnv.value =
+        std::string_view(reinterpret_cast<const char*>(ptr), length);
     ptr += length;
     if (tnvs != nullptr)
-      tnvs->push_back(std::move(tnv));
+      tnvs->push_back(tnv);
   }
   return true;
 }
@@ -495,8 +498,8 @@ void Parser::ResetContent() {
 // have level 0. Returns false <=> critical parsing error was spotted.
 // See section 3.5.2 from rfc8010 for details.
 bool Parser::ParseRawValue(int coll_level,
-                           const TagNameValue& tnv,
-                           std::list<TagNameValue>* tnvs,
+                           const TagNameValueView& tnv,
+                           std::deque<TagNameValueView>* tnvs,
                            RawAttribute* attr) {
   // Is it correct attribute's value tag? If not then fail.
   if (tnv.tag == endCollection_value_tag ||
@@ -532,7 +535,7 @@ bool Parser::ParseRawValue(int coll_level,
 // have level 1. Both |tnvs| and |coll| cannot be nullptr.
 // Returns false <=> critical parsing error was spotted.
 bool Parser::ParseRawCollection(int coll_level,
-                                std::list<TagNameValue>* tnvs,
+                                std::deque<TagNameValueView>* tnvs,
                                 RawCollection* coll) {
   if (coll_level > kMaxCollectionLevel) {
     LogParserError(ParserCode::kLimitOnCollectionsLevelExceeded);
@@ -543,7 +546,7 @@ bool Parser::ParseRawCollection(int coll_level,
       LogParserError(ParserCode::kUnexpectedEndOfGroup);
       return false;
     }
-    TagNameValue tnv = tnvs->front();
+    TagNameValueView tnv = tnvs->front();
     tnvs->pop_front();
     // exit if the end of the collection was reached
     if (tnv.tag == endCollection_value_tag) {
@@ -563,7 +566,7 @@ bool Parser::ParseRawCollection(int coll_level,
       return false;
     }
     // parse name & create attribute
-    const std::string name = LoadString(tnv.value);
+    std::string name = LoadString(tnv.value);
     parser_context_.Back().attribute_name = name;
     if (!tnv.name.empty()) {
       LogParserError(ParserCode::kEmptyNameExpectedInTNV);
@@ -573,7 +576,7 @@ bool Parser::ParseRawCollection(int coll_level,
       LogParserErrors({ParserCode::kAttributeNameIsEmpty});
       return false;
     }
-    coll->attributes.emplace_back(name);
+    coll->attributes.emplace_back(std::move(name));
     RawAttribute* attr = &coll->attributes.back();
     // parse tag
     if (tnvs->empty()) {
@@ -598,18 +601,19 @@ bool Parser::ParseRawCollection(int coll_level,
 // Parses attributes group from given TNVs and saves it to |coll|. Both |tnvs|
 // and |coll| cannot be nullptr. Returns false <=> critical parsing error was
 // spotted.
-bool Parser::ParseRawGroup(std::list<TagNameValue>* tnvs, RawCollection* coll) {
+bool Parser::ParseRawGroup(std::deque<TagNameValueView>* tnvs,
+                           RawCollection* coll) {
   while (!tnvs->empty()) {
-    TagNameValue tnv = tnvs->front();
+    TagNameValueView tnv = tnvs->front();
     tnvs->pop_front();
     // parse name & create attribute
-    const std::string name = LoadString(tnv.name);
+    std::string name = LoadString(tnv.name);
     parser_context_.Back().attribute_name = name;
     if (name.empty()) {
       LogParserErrors({ParserCode::kAttributeNameIsEmpty});
       return false;
     }
-    coll->attributes.emplace_back(name);
+    coll->attributes.emplace_back(std::move(name));
     RawAttribute* attr = &coll->attributes.back();
     // parse all values
     while (true) {
@@ -6,7 +6,7 @@
 #define LIBIPP_IPP_PARSER_H_
 
 #include <cstdint>
-#include <list>
+#include <deque>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -58,17 +58,18 @@ class Parser {
   // to the parameter. Returns false <=> error occurred.
   bool ReadTNVsFromBuffer(const uint8_t** ptr,
                           const uint8_t* const end_buf,
-                          std::list<TagNameValue>*);
+                          std::deque<TagNameValueView>*);
 
   // Parser helpers.
   bool ParseRawValue(int coll_level,
-                     const TagNameValue& tnv,
-                     std::list<TagNameValue>* data_chunks,
+                     const TagNameValueView& tnv,
+                     std::deque<TagNameValueView>* data_chunks,
                      RawAttribute* attr);
   bool ParseRawCollection(int coll_level,
-                          std::list<TagNameValue>* data_chunks,
+                          std::deque<TagNameValueView>* data_chunks,
                           RawCollection* coll);
-  bool ParseRawGroup(std::list<TagNameValue>* data_chunks, RawCollection* coll);
+  bool ParseRawGroup(std::deque<TagNameValueView>* data_chunks,
+                     RawCollection* coll);
   void DecodeCollection(RawCollection* raw, Collection* coll);
 
   // Internal buffer.
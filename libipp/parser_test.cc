@@ -4,6 +4,10 @@
 
 #include "parser.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "binary_content.h"
@@ -201,5 +205,46 @@ TEST(Parser, RangeOfInteger) {
   EXPECT_EQ(value.max_value, 1234567890);
 }
 
+// The parser keeps views into the input buffer until the frame is built. The
+// returned frame must not depend on the buffer.
+TEST(Parser, FrameOutlivesBuffer) {
+  BinaryContent c;
+  c.u2(0x0101u);     // version-number = 1.1
+  c.u2(0x0000u);     // status-code = successful-ok
+  c.u4(1);           // request-id
+  c.u1(0x01u);       // group-tag = operation-attributes-tag
+  c.u1(0x44);        // value-tag = keyword
+  c.u2(9);           // name-length
+  c.s("test-attr");  // name
+  c.u2(8);           // value-length
+  c.s("whatever");   // value
+  c.u1(0x44);        // value-tag = keyword
+  c.u2(0);           // name-length = 0 (next value in the same attribute)
+  c.u2(5);           // value-length
+  c.s("hello");      // value
+  c.u1(0x03u);       // end-of-attributes-tag
+  c.s("document");   // data
+
+  ipp::SimpleParserLog log;
+  const ipp::Frame frame = ipp::Parse(c.data.data(), c.data.size(), log);
+  std::fill(c.data.begin(), c.data.end(), 0);
+  EXPECT_TRUE(log.Errors().empty());
+
+  ASSERT_EQ(frame.Groups(ipp::GroupTag::operation_attributes).size(), 1);
+  const ipp::Collection& coll =
+      frame.Groups(ipp::GroupTag::operation_attributes)[0];
+  ASSERT_EQ(coll.size(), 1);
+  EXPECT_EQ(coll.begin()->Name(), "test-attr");
+  ASSERT_EQ(coll.begin()->Size(), 2);
+
+  std::string value;
+  ASSERT_EQ(coll.begin()->GetValue(0, value), ipp::Code::kOK);
+  EXPECT_EQ(value, "whatever");
+  ASSERT_EQ(coll.begin()->GetValue(1, value), ipp::Code::kOK);
+  EXPECT_EQ(value, "hello");
+  const std::vector<uint8_t>& data = frame.Data();
+  EXPECT_EQ(std::string(data.begin(), data.end()), "document");
+}
+
 }  // namespace
 }  // namespace ipp
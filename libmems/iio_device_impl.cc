@@ -322,6 +322,11 @@ bool IioDeviceImpl::CreateBuffer() {
     return false;
   }
 
+  if (!ComputeSampleLayout()) {
+    buffer_.reset();
+    return false;
+  }
+
   return true;
 }
 
@@ -352,13 +357,12 @@ std::optional<IioDevice::IioSample> IioDeviceImpl::ReadSample() {
   }
 
   const auto buf_step = iio_buffer_step(buffer_.get());
-  size_t sample_size = GetSampleSize().value_or(0);
 
   // There is something wrong when refilling the buffer.
-  if (buf_step != sample_size) {
+  if (buf_step != sample_size_) {
     LOG(ERROR) << log_prefix_
                << "sample_size doesn't match in refill: " << buf_step
-               << ", sample_size: " << sample_size;
+               << ", sample_size: " << sample_size_;
 
     return std::nullopt;
   }
@@ -370,6 +374,8 @@ std::optional<IioDevice::IioSample> IioDeviceImpl::ReadSample() {
 
 void IioDeviceImpl::FreeBuffer() {
   buffer_.reset();
+  sample_layout_.clear();
+  sample_size_ = 0;
 }
 
 std::optional<int32_t> IioDeviceImpl::GetEventFd() {
@@ -416,9 +422,14 @@ void IioDeviceImpl::IioBufferDeleter(iio_buffer* buffer) {
   iio_buffer_destroy(buffer);
 }
 
-IioDevice::IioSample IioDeviceImpl::DeserializeSample(const uint8_t* src) {
-  IioSample sample;
-  int64_t pos = 0;
+bool IioDeviceImpl::ComputeSampleLayout() {
+  std::optional<size_t> sample_size = GetSampleSize();
+  if (!sample_size.has_value())
+    return false;
+
+  sample_size_ = sample_size.value();
+  sample_layout_.clear();
+  size_t pos = 0;
 
   auto channels = GetAllChannels();
   for (int32_t i = 0; i < channels.size(); ++i) {
@@ -436,11 +447,23 @@ IioDevice::IioSample IioDeviceImpl::DeserializeSample(const uint8_t* src) {
       pos += space_in_block;
     }
 
-    std::optional<int64_t> value = chn->Convert(src + pos);
+    sample_layout_.push_back({.index = i, .chn = chn, .offset = pos});
     pos += len;
+  }
+
+  return true;
+}
+
+IioDevice::IioSample IioDeviceImpl::DeserializeSample(const uint8_t* src) {
+  IioSample sample;
+  sample.reserve(sample_layout_.size());
 
+  // |sample_layout_| is sorted by channel index, so each value is appended at
+  // the end of |sample|.
+  for (const ChannelLayout& layout : sample_layout_) {
+    std::optional<int64_t> value = layout.chn->Convert(src + layout.offset);
     if (value.has_value())
-      sample[i] = value.value();
+      sample.emplace_hint(sample.end(), layout.index, value.value());
   }
 
   return sample;
@@ -78,6 +78,9 @@ class LIBMEMS_EXPORT IioDeviceImpl : public IioDevice {
  private:
   static void IioBufferDeleter(iio_buffer* buffer);
 
+  // Computes |sample_layout_| and |sample_size_| from the channels enabled
+  // when the buffer is created, which stay fixed for the buffer's lifetime.
+  bool ComputeSampleLayout();
   IioSample DeserializeSample(const uint8_t* src);
 
   IioContextImpl* context_;   // non-owned
@@ -89,6 +92,15 @@ class LIBMEMS_EXPORT IioDeviceImpl : public IioDevice {
   ScopedBuffer buffer_;
   std::optional<int32_t> event_fd_;
 
+  // Position of an enabled channel's value in a sample read from |buffer_|.
+  struct ChannelLayout {
+    int32_t index;
+    IioChannelImpl* chn;
+    size_t offset;
+  };
+  std::vector<ChannelLayout> sample_layout_;
+  size_t sample_size_ = 0;
+
   std::string log_prefix_;
 };
 
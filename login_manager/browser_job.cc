@@ -281,6 +281,12 @@ bool BrowserJob::RunInBackground() {
   const std::vector<std::string> env_vars(ExportEnvironmentVariables());
   LOG(INFO) << "Running browser " << base::JoinString(argv, " ");
 
+  // After a crash or a restart to apply new flags, parts of the binary may
+  // have been evicted from the page cache. Reading them in large chunks now is
+  // faster than faulting them in one by one once the browser runs.
+  if (!argv.empty())
+    system_->PrefetchFile(base::FilePath(argv[0]));
+
   bool enter_existing_mount_ns = false;
   if (IsGuestSession()) {
     if (config_.isolate_guest_session &&
@@ -253,6 +253,24 @@ TEST_F(BrowserJobTest, EnterMountNamespaceForRegularUser) {
   ASSERT_TRUE(job.RunInBackground());
 }
 
+TEST_F(BrowserJobTest, PrefetchBinaryBeforeRunning) {
+  const gid_t kFakeGid = 1000;
+  const pid_t kFakePid = 4;
+  EXPECT_CALL(utils_, GetGidAndGroups(getuid(), _, _))
+      .WillOnce(DoAll(SetArgPointee<1>(kFakeGid), Return(true)));
+  EXPECT_CALL(utils_, time(nullptr)).WillRepeatedly(Return(0));
+  EXPECT_CALL(metrics_, HasRecordedChromeExec()).WillRepeatedly(Return(false));
+  EXPECT_CALL(metrics_, RecordStats(_)).Times(AnyNumber());
+  {
+    testing::InSequence seq;
+    EXPECT_CALL(utils_, PrefetchFile(base::FilePath(kArgv[0])));
+    EXPECT_CALL(utils_, RunInMinijail(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<3>(kFakePid), Return(true)));
+  }
+
+  ASSERT_TRUE(job_->RunInBackground());
+}
+
 TEST_F(BrowserJobTest, ShouldStopTest) {
   EXPECT_CALL(utils_, time(nullptr))
       .WillRepeatedly(Return(BrowserJob::kRestartWindowSeconds));
@@ -4,13 +4,17 @@
 
 #include "login_manager/device_local_account_manager.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include <base/files/file_enumerator.h>
 #include <base/files/file_util.h>
 #include <base/logging.h>
 #include <base/memory/ptr_util.h>
 #include <base/strings/string_util.h>
+#include <base/system/sys_info.h>
+#include <base/threading/simple_thread.h>
 #include <brillo/cryptohome.h>
 #include <brillo/files/file_util.h>
 
@@ -22,6 +26,28 @@ namespace em = enterprise_management;
 
 namespace login_manager {
 
+namespace {
+
+// Maximum number of threads loading device-local account policy.
+constexpr int kMaxLoadThreads = 4;
+
+// Loads the Chrome policy of a device-local account on a pool thread.
+class PolicyLoadTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit PolicyLoadTask(PolicyService* service) : service_(service) {}
+  PolicyLoadTask(const PolicyLoadTask&) = delete;
+  PolicyLoadTask& operator=(const PolicyLoadTask&) = delete;
+  ~PolicyLoadTask() override = default;
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override { service_->EnsureLoaded(MakeChromePolicyNamespace()); }
+
+ private:
+  PolicyService* service_;
+};
+
+}  // namespace
+
 // Device-local account state directory.
 constexpr char DeviceLocalAccountManager::kPolicyDir[] = "policy";
 
@@ -89,6 +115,30 @@ bool DeviceLocalAccountManager::MigrateUppercaseDirs() {
   return true;
 }
 
+void DeviceLocalAccountManager::LoadPolicies() {
+  std::vector<std::unique_ptr<PolicyLoadTask>> tasks;
+  for (auto& entry : policy_map_) {
+    if (entry.second)
+      continue;
+    entry.second = CreatePolicyService(entry.first);
+    if (entry.second)
+      tasks.push_back(std::make_unique<PolicyLoadTask>(entry.second.get()));
+  }
+  if (tasks.empty())
+    return;
+
+  // Leave some CPUs to the rest of the boot.
+  const int num_threads =
+      std::clamp(base::SysInfo::NumberOfProcessors() / 2, 1,
+                 std::min(kMaxLoadThreads, static_cast<int>(tasks.size())));
+  base::DelegateSimpleThreadPool pool("device_local_account_policy",
+                                      num_threads);
+  pool.Start();
+  for (const auto& task : tasks)
+    pool.AddWork(task.get());
+  pool.JoinAll();
+}
+
 PolicyService* DeviceLocalAccountManager::GetPolicyService(
     const std::string& account_id) {
   const std::string key = GetAccountKey(account_id);
@@ -97,20 +147,24 @@ PolicyService* DeviceLocalAccountManager::GetPolicyService(
     return nullptr;
 
   // Lazily create and initialize the policy service instance.
-  if (!entry->second) {
-    const base::FilePath policy_dir =
-        state_dir_.AppendASCII(key).Append(kPolicyDir);
-    if (!base::CreateDirectory(policy_dir)) {
-      LOG(ERROR) << "Failed to create device-local account policy directory "
-                 << policy_dir.value();
-      return nullptr;
-    }
+  if (!entry->second)
+    entry->second = CreatePolicyService(key);
 
-    entry->second =
-        std::make_unique<PolicyService>(policy_dir, owner_key_, nullptr, false);
+  return entry->second.get();
+}
+
+std::unique_ptr<PolicyService> DeviceLocalAccountManager::CreatePolicyService(
+    const std::string& account_key) {
+  const base::FilePath policy_dir =
+      state_dir_.AppendASCII(account_key).Append(kPolicyDir);
+  if (!base::CreateDirectory(policy_dir)) {
+    LOG(ERROR) << "Failed to create device-local account policy directory "
+               << policy_dir.value();
+    return nullptr;
   }
 
-  return entry->second.get();
+  return std::make_unique<PolicyService>(policy_dir, owner_key_, nullptr,
+                                         false);
 }
 
 std::string DeviceLocalAccountManager::GetAccountKey(
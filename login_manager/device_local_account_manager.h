@@ -48,6 +48,11 @@ class DeviceLocalAccountManager {
   void UpdateDeviceSettings(
       const enterprise_management::ChromeDeviceSettingsProto& device_settings);
 
+  // Creates the PolicyService instances that are not present yet and loads
+  // their Chrome policy from disk, on several threads. This saves loading the
+  // accounts one by one on the first GetPolicyService() calls.
+  void LoadPolicies();
+
   // Obtains the PolicyService instance that manages disk storage for
   // |account_id| after checking that |account_id| is valid. The PolicyService
   // is lazily created on the fly if not present yet.
@@ -58,6 +63,11 @@ class DeviceLocalAccountManager {
   // This is to repair the damage caused by http://crbug.com/225472.
   bool MigrateUppercaseDirs();
 
+  // Creates the PolicyService instance for |account_key| and its policy
+  // directory. Returns nullptr if the directory can't be created.
+  std::unique_ptr<PolicyService> CreatePolicyService(
+      const std::string& account_key);
+
   // Returns the identifier for a given |account_id|. The value returned is safe
   // to use as a file system name. This may fail, in which case the returned
   // string will be empty.
@@ -6,7 +6,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <base/compiler_specific.h>
 #include <base/files/file_util.h>
@@ -116,6 +118,43 @@ TEST_F(DeviceLocalAccountManagerTest, GetPolicyServiceSucceeds) {
   EXPECT_TRUE(base::PathExists(fake_account_policy_path_));
 }
 
+TEST_F(DeviceLocalAccountManagerTest, LoadPolicies) {
+  const std::string kOtherAccount = "other@example.com";
+  const base::FilePath other_account_policy_path =
+      temp_dir_.GetPath()
+          .Append(*brillo::cryptohome::home::SanitizeUserName(
+              brillo::cryptohome::home::Username(kOtherAccount)))
+          .Append(DeviceLocalAccountManager::kPolicyDir)
+          .Append(PolicyService::kChromePolicyFileName);
+  ASSERT_TRUE(base::CreateDirectory(fake_account_policy_path_.DirName()));
+  ASSERT_TRUE(WriteBlobToFile(fake_account_policy_path_, GetTestPolicyBlob()));
+
+  em::ChromeDeviceSettingsProto device_settings;
+  for (const std::string& account_id : {fake_account_, kOtherAccount}) {
+    em::DeviceLocalAccountInfoProto* account =
+        device_settings.mutable_device_local_accounts()->add_account();
+    account->set_type(
+        em::DeviceLocalAccountInfoProto::ACCOUNT_TYPE_PUBLIC_SESSION);
+    account->set_account_id(account_id);
+  }
+  manager_->UpdateDeviceSettings(device_settings);
+  manager_->LoadPolicies();
+
+  // The policy directory is created for accounts without policy.
+  EXPECT_TRUE(base::DirectoryExists(other_account_policy_path.DirName()));
+
+  std::vector<uint8_t> policy_blob;
+  PolicyService* service = manager_->GetPolicyService(fake_account_);
+  ASSERT_TRUE(service);
+  ASSERT_TRUE(service->Retrieve(MakeChromePolicyNamespace(), &policy_blob));
+  EXPECT_EQ(GetTestPolicyBlob(), policy_blob);
+
+  service = manager_->GetPolicyService(kOtherAccount);
+  ASSERT_TRUE(service);
+  ASSERT_TRUE(service->Retrieve(MakeChromePolicyNamespace(), &policy_blob));
+  EXPECT_TRUE(policy_blob.empty());
+}
+
 TEST_F(DeviceLocalAccountManagerTest, PurgeStaleAccounts) {
   SetupKey();
 
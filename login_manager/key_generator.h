@@ -22,6 +22,16 @@ namespace login_manager {
 
 class SystemUtils;
 
+// Generates the Owner keypair in a separate keygen process on the first
+// sign-in of an unmanaged device. The session doesn't wait for it: Start()
+// returns as soon as the job is running, and the delegate is told about the
+// public key once the job exits.
+//
+// The private key is created directly in the owner's NSS database, inside
+// their cryptohome, which only exists once they have signed in. It is
+// deliberately not generated ahead of time (e.g. during OOBE), since that
+// would keep the private half outside of the owner's encrypted storage until
+// sign-in.
 class KeyGenerator : public ChildExitHandler {
  public:
   class Delegate {
@@ -56,6 +56,12 @@ const char kLivenessPingResponseTimeMetric[] =
 
 const char kLivenessPingResultMetric[] = "ChromeOS.Liveness.PingResult";
 
+// Metrics to track the time spent verifying the signature of a stored policy
+// and loading the policy of all the device-local accounts.
+const char kPolicyVerificationTimeMetric[] = "Login.PolicyVerificationTime";
+const char kDeviceLocalAccountPolicyLoadTimeMetric[] =
+    "Login.DeviceLocalAccountPolicyLoadTime";
+
 }  // namespace
 
 LoginMetrics::LoginMetrics(const base::FilePath& per_boot_flag_dir)
@@ -162,6 +168,25 @@ void LoginMetrics::SendLivenessPingResult(bool success) {
   metrics_lib_.SendBoolToUMA(kLivenessPingResultMetric, success);
 }
 
+void LoginMetrics::SendPolicyVerificationTime(
+    base::TimeDelta verification_time) {
+  // Verification takes well under a second, so report it in microseconds.
+  metrics_lib_.SendToUMA(
+      kPolicyVerificationTimeMetric,
+      static_cast<int>(verification_time.InMicroseconds()),
+      static_cast<int>(base::Microseconds(1).InMicroseconds()),
+      static_cast<int>(base::Seconds(1).InMicroseconds()), 50);
+}
+
+void LoginMetrics::SendDeviceLocalAccountPolicyLoadTime(
+    base::TimeDelta load_time) {
+  metrics_lib_.SendToUMA(
+      kDeviceLocalAccountPolicyLoadTimeMetric,
+      static_cast<int>(load_time.InMilliseconds()),
+      static_cast<int>(base::Milliseconds(1).InMilliseconds()),
+      static_cast<int>(base::Seconds(10).InMilliseconds()), 50);
+}
+
 void LoginMetrics::ReportCrosEvent(const std::string& event) {
   metrics_lib_.SendCrosEventToUMA(event);
 }
@@ -173,6 +173,14 @@ class LoginMetrics {
   // Submits to UMA the liveness ping result.
   virtual void SendLivenessPingResult(bool success);
 
+  // Submits to UMA the time it took to verify the signature of a policy
+  // before storing it.
+  virtual void SendPolicyVerificationTime(base::TimeDelta verification_time);
+
+  // Submits to UMA the time it took to load the policy of all the
+  // device-local accounts from disk.
+  virtual void SendDeviceLocalAccountPolicyLoadTime(base::TimeDelta load_time);
+
   // CrOS events are translated to an enum and reported to the generic
   // "Platform.CrOSEvent" enum histogram. The |event| string must be registered
   // in metrics/metrics_library.cc:kCrosEventNames.
@@ -82,6 +82,7 @@ class MockSystemUtils : public SystemUtils {
               WriteStringToFile,
               (const base::FilePath&, const std::string&),
               (override));
+  MOCK_METHOD(void, PrefetchFile, (const base::FilePath&), (override));
 
   MOCK_METHOD(bool,
               ChangeBlockedSignals,
@@ -13,6 +13,7 @@
 #include <base/files/file_util.h>
 #include <base/logging.h>
 #include <crypto/rsa_private_key.h>
+#include <crypto/sha2.h>
 #include <crypto/signature_verifier.h>
 
 #include "login_manager/nss_util.h"
@@ -20,6 +21,15 @@
 
 namespace login_manager {
 
+namespace {
+
+// Maximum number of verifications remembered. Bounds the memory used by
+// clients storing many different blobs, while covering the policies of all
+// the device-local accounts of a device.
+constexpr size_t kMaxVerifiedDigests = 128;
+
+}  // namespace
+
 PolicyKey::PolicyKey(const base::FilePath& key_file, NssUtil* nss)
     : key_file_(key_file), nss_(nss), utils_(new SystemUtilsImpl) {}
 
@@ -68,7 +78,7 @@ bool PolicyKey::PopulateFromDiskIfPossible() {
     LOG(ERROR) << "Policy key " << key_file_.value() << " is corrupted!";
     return false;
   }
-  key_.assign(buffer.begin(), buffer.end());
+  SetKey(buffer);
   return true;
 }
 
@@ -83,7 +93,7 @@ bool PolicyKey::PopulateFromBuffer(const std::vector<uint8_t>& public_key_der) {
     return false;
   }
   // Only get here if we've checked disk AND we didn't load a key.
-  key_ = public_key_der;
+  SetKey(public_key_der);
   return true;
 }
 
@@ -128,7 +138,7 @@ bool PolicyKey::Rotate(
     return false;
   }
   if (Verify(public_key_der, signature, algorithm)) {
-    key_ = public_key_der;
+    SetKey(public_key_der);
     have_replaced_ = true;
     return true;
   }
@@ -143,7 +153,7 @@ bool PolicyKey::ClobberCompromisedKey(
   // It is a programming error to call this without a key already loaded.
   CHECK(IsPopulated()) << "Don't yet have an owner key!";
 
-  key_ = public_key_der;
+  SetKey(public_key_der);
   return have_replaced_ = true;
 }
 
@@ -151,11 +161,39 @@ bool PolicyKey::Verify(
     const std::vector<uint8_t>& data,
     const std::vector<uint8_t>& signature,
     const crypto::SignatureVerifier::SignatureAlgorithm algorithm) {
+  const std::string digest = GetVerificationDigest(data, signature, algorithm);
+  if (verified_digests_.count(digest))
+    return true;
+
   if (!nss_->Verify(signature, data, key_, algorithm)) {
     LOG(ERROR) << "Signature verification failed";
     return false;
   }
+
+  if (verified_digests_.size() >= kMaxVerifiedDigests)
+    verified_digests_.clear();
+  verified_digests_.insert(digest);
   return true;
 }
 
+void PolicyKey::SetKey(const std::vector<uint8_t>& key_der) {
+  key_ = key_der;
+  verified_digests_.clear();
+}
+
+// static
+std::string PolicyKey::GetVerificationDigest(
+    const std::vector<uint8_t>& data,
+    const std::vector<uint8_t>& signature,
+    crypto::SignatureVerifier::SignatureAlgorithm algorithm) {
+  // Prefix the variable-length fields with their size, so that the boundary
+  // between the signature and the data is unambiguous.
+  std::string message;
+  message += std::to_string(static_cast<int>(algorithm)) + ":";
+  message += std::to_string(signature.size()) + ":";
+  message.append(signature.begin(), signature.end());
+  message.append(data.begin(), data.end());
+  return crypto::SHA256HashString(message);
+}
+
 }  // namespace login_manager
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -85,6 +86,8 @@ class PolicyKey {
   // Verify that |signature| is a valid signature over the data in
   // |data| with |key_| signed with |algorithm|.
   // Returns false if the sig is invalid, or there's an error.
+  // Successful verifications are remembered until |key_| changes, so that
+  // storing the same blob again doesn't go through NSS.
   virtual bool Verify(
       const std::vector<uint8_t>& data,
       const std::vector<uint8_t>& signature,
@@ -94,10 +97,25 @@ class PolicyKey {
   virtual const std::vector<uint8_t>& public_key_der() const { return key_; }
 
  private:
+  const base::FilePath key_file_;
+  bool have_checked_disk_ = false;
+  bool have_replaced_ = false;
+  // Replaces |key_| and forgets the verifications made with the old key.
+  void SetKey(const std::vector<uint8_t>& key_der);
+
+  // Returns the digest identifying a verification of |signature| over |data|
+  // with |algorithm|.
+  static std::string GetVerificationDigest(
+      const std::vector<uint8_t>& data,
+      const std::vector<uint8_t>& signature,
+      crypto::SignatureVerifier::SignatureAlgorithm algorithm);
+
   const base::FilePath key_file_;
   bool have_checked_disk_ = false;
   bool have_replaced_ = false;
   std::vector<uint8_t> key_;
+  // Digests of the blobs successfully verified with |key_|.
+  std::set<std::string> verified_digests_;
   NssUtil* nss_;
   std::unique_ptr<SystemUtils> utils_;
 };
@@ -19,12 +19,16 @@
 #include <crypto/nss_util.h>
 #include <crypto/nss_util_internal.h>
 #include <crypto/rsa_private_key.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "login_manager/blob_util.h"
 #include "login_manager/mock_nss_util.h"
 #include "login_manager/nss_util.h"
 
+using testing::_;
+using testing::Return;
+
 namespace login_manager {
 
 class PolicyKeyTest : public ::testing::Test {
@@ -280,4 +284,54 @@ TEST_F(PolicyKeyTest, ResetKey) {
   ASSERT_FALSE(base::PathExists(tmpfile_));
 }
 
+TEST_F(PolicyKeyTest, VerifyRemembersSuccess) {
+  StartUnowned();
+  MockNssUtil nss_util;
+  PolicyKey key(tmpfile_, &nss_util);
+  ASSERT_TRUE(key.PopulateFromDiskIfPossible());
+  ASSERT_TRUE(key.PopulateFromBuffer({1}));
+
+  const std::vector<uint8_t> data = StringToBlob("data");
+  const std::vector<uint8_t> good_sig = StringToBlob("good");
+  const std::vector<uint8_t> bad_sig = StringToBlob("bad");
+  EXPECT_CALL(nss_util, Verify(good_sig, data, _, _))
+      .Times(1)
+      .WillOnce(Return(true));
+  EXPECT_CALL(nss_util, Verify(bad_sig, data, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(false));
+
+  // Only the first successful verification goes through NSS.
+  EXPECT_TRUE(
+      key.Verify(data, good_sig, crypto::SignatureVerifier::RSA_PKCS1_SHA1));
+  EXPECT_TRUE(
+      key.Verify(data, good_sig, crypto::SignatureVerifier::RSA_PKCS1_SHA1));
+
+  // Failures are not remembered.
+  EXPECT_FALSE(
+      key.Verify(data, bad_sig, crypto::SignatureVerifier::RSA_PKCS1_SHA1));
+  EXPECT_FALSE(
+      key.Verify(data, bad_sig, crypto::SignatureVerifier::RSA_PKCS1_SHA1));
+}
+
+TEST_F(PolicyKeyTest, VerifyForgetsOnKeyChange) {
+  StartUnowned();
+  MockNssUtil nss_util;
+  PolicyKey key(tmpfile_, &nss_util);
+  ASSERT_TRUE(key.PopulateFromDiskIfPossible());
+  ASSERT_TRUE(key.PopulateFromBuffer({1}));
+
+  const std::vector<uint8_t> data = StringToBlob("data");
+  const std::vector<uint8_t> sig = StringToBlob("sig");
+  EXPECT_CALL(nss_util, Verify(sig, data, std::vector<uint8_t>{1}, _))
+      .WillOnce(Return(true));
+  EXPECT_CALL(nss_util, Verify(sig, data, std::vector<uint8_t>{2}, _))
+      .WillOnce(Return(false));
+
+  EXPECT_TRUE(key.Verify(data, sig, crypto::SignatureVerifier::RSA_PKCS1_SHA1));
+  EXPECT_TRUE(key.ClobberCompromisedKey({2}));
+  EXPECT_FALSE(
+      key.Verify(data, sig, crypto::SignatureVerifier::RSA_PKCS1_SHA1));
+}
+
 }  // namespace login_manager
@@ -17,6 +17,7 @@
 #include <base/logging.h>
 #include <base/notreached.h>
 #include <base/synchronization/waitable_event.h>
+#include <base/timer/elapsed_timer.h>
 #include <brillo/message_loops/message_loop.h>
 #include <chromeos/dbus/service_constants.h>
 
@@ -24,6 +25,7 @@
 #include "crypto/signature_verifier.h"
 #include "login_manager/blob_util.h"
 #include "login_manager/dbus_util.h"
+#include "login_manager/login_metrics.h"
 #include "login_manager/nss_util.h"
 #include "login_manager/policy_key.h"
 #include "login_manager/policy_store.h"
@@ -88,6 +90,10 @@ bool PolicyService::Store(const PolicyNamespace& ns,
   return StorePolicy(ns, policy, key_flags, std::move(completion));
 }
 
+void PolicyService::EnsureLoaded(const PolicyNamespace& ns) {
+  GetOrCreateStore(ns);
+}
+
 bool PolicyService::Retrieve(const PolicyNamespace& ns,
                              std::vector<uint8_t>* policy_blob) {
   *policy_blob = SerializeAsBlob(GetOrCreateStore(ns)->Get());
@@ -164,9 +170,14 @@ bool PolicyService::StorePolicy(const PolicyNamespace& ns,
   }
 
   // Validate signature on policy and persist to disk.
-  if (!key()->Verify(StringToBlob(policy.policy_data()),
-                     StringToBlob(policy.policy_data_signature()),
-                     crypto::SignatureVerifier::RSA_PKCS1_SHA1)) {
+  base::ElapsedTimer verification_timer;
+  const bool verified =
+      key()->Verify(StringToBlob(policy.policy_data()),
+                    StringToBlob(policy.policy_data_signature()),
+                    crypto::SignatureVerifier::RSA_PKCS1_SHA1);
+  if (metrics_)
+    metrics_->SendPolicyVerificationTime(verification_timer.Elapsed());
+  if (!verified) {
     std::move(completion)
         .Run(CREATE_ERROR_AND_LOG(dbus_error::kVerifyFail,
                                   "Signature could not be verified."));
@@ -106,6 +106,11 @@ class PolicyService {
   virtual bool Retrieve(const PolicyNamespace& ns,
                         std::vector<uint8_t>* policy_blob);
 
+  // Loads the policy of the namespace |ns| from disk, unless it is loaded
+  // already. This only touches the state of this instance, so different
+  // instances may be loaded on different threads.
+  void EnsureLoaded(const PolicyNamespace& ns);
+
   // Persists policy of the namespace |ns| to disk synchronously and passes
   // |completion| and the result to OnPolicyPersisted().
   virtual void PersistPolicy(const PolicyNamespace& ns, Completion completion);
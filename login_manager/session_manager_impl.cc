@@ -37,6 +37,7 @@
 #include <base/task/single_thread_task_runner.h>
 #include <base/time/default_tick_clock.h>
 #include <base/time/time.h>
+#include <base/timer/elapsed_timer.h>
 #include <brillo/cryptohome.h>
 #include <brillo/dbus/dbus_object.h>
 #include <brillo/dbus/utils.h>
@@ -601,6 +602,11 @@ bool SessionManagerImpl::Initialize() {
         base::FilePath(kDeviceLocalAccountStateDir), owner_key_),
     device_local_account_manager_->UpdateDeviceSettings(
         device_policy_->GetSettings());
+    // Chrome retrieves the policy of every device-local account right after
+    // starting, so load them all at once.
+    base::ElapsedTimer load_timer;
+    device_local_account_manager_->LoadPolicies();
+    login_metrics_->SendDeviceLocalAccountPolicyLoadTime(load_timer.Elapsed());
     if (device_policy_->MayUpdateSystemSettings())
       device_policy_->UpdateSystemSettings(PolicyService::Completion());
   } else {
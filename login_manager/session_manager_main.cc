@@ -137,6 +137,13 @@ int main(int argc, char* argv[]) {
       base::SplitString(command_flag, base::kWhitespaceASCII,
                         base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
 
+  // Shim that wraps system calls, file system ops, etc.
+  SystemUtilsImpl system;
+
+  // Start reading the browser binary while its flags are computed below.
+  if (!command.empty())
+    system.PrefetchFile(base::FilePath(command[0]));
+
   brillo::CrosConfig cros_config;
 
   // Detect small cores and restrict non-urgent tasks to small cores.
@@ -155,9 +162,6 @@ int main(int argc, char* argv[]) {
   for (const auto& it : env_var_map)
     env_vars.push_back(it.first + "=" + it.second);
 
-  // Shim that wraps system calls, file system ops, etc.
-  SystemUtilsImpl system;
-
   // Checks magic file that causes the session_manager to stop managing the
   // browser process. Devs and tests can use this to keep the session_manager
   // running while stopping and starting the browser manaually.
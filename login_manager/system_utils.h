@@ -162,6 +162,10 @@ class SystemUtils {
   virtual bool WriteStringToFile(const base::FilePath& path,
                                  const std::string& data) = 0;
 
+  // Asks the kernel to start reading the file at |path| into the page cache,
+  // without waiting for the data. Best effort: failures are only logged.
+  virtual void PrefetchFile(const base::FilePath& path) = 0;
+
   // Changes blocked signals. |how| takes one of |SIG_BLOCK|, |SIG_UNBLOCK|, and
   // |SIG_SETMASK|. See man page of sigprocmask(2) for more details. |signals|
   // contains all signals to operate on.
@@ -5,6 +5,7 @@
 #include "login_manager/system_utils_impl.h"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <grp.h>
 #include <pwd.h>
 #include <sched.h>
@@ -32,8 +33,11 @@
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
 #include <base/files/important_file_writer.h>
+#include <base/files/scoped_file.h>
 #include <base/files/scoped_temp_dir.h>
 #include <base/logging.h>
+#include <base/posix/eintr_wrapper.h>
+#include <base/posix/safe_strerror.h>
 #include <base/process/launch.h>
 #include <base/strings/string_util.h>
 #include <base/system/sys_info.h>
@@ -406,6 +410,21 @@ bool SystemUtilsImpl::WriteStringToFile(const base::FilePath& path,
   return brillo::WriteStringToFile(path, data);
 }
 
+void SystemUtilsImpl::PrefetchFile(const base::FilePath& path) {
+  base::ScopedFD fd(
+      HANDLE_EINTR(open(path.value().c_str(), O_RDONLY | O_CLOEXEC)));
+  if (!fd.is_valid()) {
+    PLOG(WARNING) << "Failed to open " << path.value() << " for prefetching";
+    return;
+  }
+  // posix_fadvise() returns the error instead of setting errno.
+  const int ret = posix_fadvise(fd.get(), 0, 0, POSIX_FADV_WILLNEED);
+  if (ret != 0) {
+    LOG(WARNING) << "Failed to prefetch " << path.value() << ": "
+                 << base::safe_strerror(ret);
+  }
+}
+
 bool SystemUtilsImpl::ChangeBlockedSignals(int how,
                                            const std::vector<int>& signals) {
   sigset_t sigset;
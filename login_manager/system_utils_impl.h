@@ -75,6 +75,7 @@ class SystemUtilsImpl : public SystemUtils {
                         std::string* str_out) override;
   bool WriteStringToFile(const base::FilePath& path,
                          const std::string& data) override;
+  void PrefetchFile(const base::FilePath& path) override;
   bool ChangeBlockedSignals(int how, const std::vector<int>& signals) override;
   bool LaunchAndWait(const std::vector<std::string>& args,
                      int* exit_code_out) override;
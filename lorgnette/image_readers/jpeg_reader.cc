@@ -42,14 +42,14 @@ bool JpegReader::ReadRow(brillo::ErrorPtr* error, uint8_t* data) {
   DCHECK(valid_);
 
   JSAMPROW row_pointer[1];
-  std::vector<uint8_t> expanded;
   switch (params_.depth) {
     case 1:
       // Expand each bit of `data` to a byte, which is what libjpeg expects.
+      expanded_row_.resize(params_.pixels_per_line);
       for (int i = 0; i < params_.pixels_per_line; i++) {
-        expanded.push_back((data[i / 8] >> (7 - (i % 8))) & 0x01 ? 0x00 : 0xFF);
+        expanded_row_[i] = (data[i / 8] >> (7 - (i % 8))) & 0x01 ? 0x00 : 0xFF;
       }
-      row_pointer[0] = expanded.data();
+      row_pointer[0] = expanded_row_.data();
       break;
     case 8:
       row_pointer[0] = data;
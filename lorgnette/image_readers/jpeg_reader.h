@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include <jerror.h>
 #include <jpeglib.h>
@@ -46,6 +47,9 @@ class JpegReader final : public ImageReader {
 
   jpeg_compress_struct cinfo_ = {0};
   jpeg_error_mgr jerr_ = {0};
+
+  // Row buffer reused to expand 1-bit rows to the 8 bits libjpeg expects.
+  std::vector<uint8_t> expanded_row_;
 };
 
 }  // namespace lorgnette
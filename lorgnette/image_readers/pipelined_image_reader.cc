@@ -0,0 +1,182 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "lorgnette/image_readers/pipelined_image_reader.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <base/check.h>
+#include <base/functional/bind.h>
+#include <base/functional/callback_helpers.h>
+#include <base/location.h>
+#include <dbus/lorgnette/dbus-constants.h>
+
+#include "lorgnette/constants.h"
+
+namespace lorgnette {
+
+namespace {
+
+// Approximate size of the batches of rows handed to the encoder thread.
+constexpr size_t kBatchSize = 1024 * 1024;
+
+// Maximum number of batches waiting to be encoded.
+constexpr size_t kMaxPendingBatches = 8;
+
+}  // namespace
+
+// static
+std::unique_ptr<ImageReader> PipelinedImageReader::Create(
+    brillo::ErrorPtr* error,
+    const ScanParameters& params,
+    std::unique_ptr<ImageReader> reader) {
+  DCHECK(reader);
+  std::unique_ptr<PipelinedImageReader> pipelined_reader(
+      new PipelinedImageReader(params, std::move(reader)));
+
+  if (!pipelined_reader->ValidateParams(error) ||
+      !pipelined_reader->Initialize(error, std::nullopt)) {
+    return nullptr;  // brillo::Error::AddTo already called.
+  }
+
+  return pipelined_reader;
+}
+
+PipelinedImageReader::~PipelinedImageReader() {
+  // Let the encoder finish with any queued rows before |reader_| goes away.
+  encoder_thread_.Stop();
+}
+
+bool PipelinedImageReader::ReadRow(brillo::ErrorPtr* error, uint8_t* data) {
+  batch_.insert(batch_.end(), data, data + params_.bytes_per_line);
+  if (++batch_rows_ < rows_per_batch_) {
+    return true;
+  }
+
+  return FlushBatch(error);
+}
+
+bool PipelinedImageReader::Finalize(brillo::ErrorPtr* error) {
+  if (batch_rows_ > 0 && !FlushBatch(error)) {
+    return false;  // brillo::Error::AddTo already called.
+  }
+
+  encoder_thread_.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&PipelinedImageReader::FinalizeImage,
+                                base::Unretained(this)));
+  // Stopping the thread runs all the tasks posted so far.
+  encoder_thread_.Stop();
+
+  return !TakeEncoderError(error);
+}
+
+PipelinedImageReader::PipelinedImageReader(const ScanParameters& params,
+                                           std::unique_ptr<ImageReader> reader)
+    : ImageReader(params, base::ScopedFILE()),
+      reader_(std::move(reader)),
+      encoder_thread_("lorgnette_encoder"),
+      rows_per_batch_(
+          std::max<size_t>(1, kBatchSize / std::max(1, params.bytes_per_line))),
+      batch_done_(&lock_) {}
+
+bool PipelinedImageReader::Initialize(brillo::ErrorPtr* error,
+                                      const std::optional<int>& resolution) {
+  if (!encoder_thread_.Start()) {
+    brillo::Error::AddTo(error, FROM_HERE, kDbusDomain, kManagerServiceError,
+                         "Failed to start image encoder thread");
+    return false;
+  }
+
+  batch_.reserve(rows_per_batch_ * params_.bytes_per_line);
+  return true;
+}
+
+bool PipelinedImageReader::FlushBatch(brillo::ErrorPtr* error) {
+  bool failed = false;
+  {
+    base::AutoLock auto_lock(lock_);
+    while (pending_batches_ >= kMaxPendingBatches && !failed_) {
+      batch_done_.Wait();
+    }
+    failed = failed_;
+    if (!failed) {
+      pending_batches_++;
+    }
+  }
+  if (failed) {
+    return !TakeEncoderError(error);
+  }
+
+  std::vector<uint8_t> batch;
+  batch.reserve(rows_per_batch_ * params_.bytes_per_line);
+  std::swap(batch, batch_);
+  encoder_thread_.task_runner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&PipelinedImageReader::EncodeBatch, base::Unretained(this),
+                     std::move(batch), batch_rows_));
+  batch_rows_ = 0;
+  return true;
+}
+
+void PipelinedImageReader::EncodeBatch(std::vector<uint8_t> batch,
+                                       size_t rows) {
+  base::ScopedClosureRunner batch_done(base::BindOnce(
+      [](PipelinedImageReader* self) {
+        base::AutoLock auto_lock(self->lock_);
+        self->pending_batches_--;
+        self->batch_done_.Signal();
+      },
+      base::Unretained(this)));
+
+  {
+    base::AutoLock auto_lock(lock_);
+    if (failed_) {
+      return;
+    }
+  }
+
+  for (size_t i = 0; i < rows; i++) {
+    brillo::ErrorPtr error;
+    if (!reader_->ReadRow(&error, batch.data() + i * params_.bytes_per_line)) {
+      base::AutoLock auto_lock(lock_);
+      failed_ = true;
+      encoder_error_ = std::move(error);
+      return;
+    }
+  }
+}
+
+void PipelinedImageReader::FinalizeImage() {
+  {
+    base::AutoLock auto_lock(lock_);
+    if (failed_) {
+      return;
+    }
+  }
+
+  brillo::ErrorPtr error;
+  if (!reader_->Finalize(&error)) {
+    base::AutoLock auto_lock(lock_);
+    failed_ = true;
+    encoder_error_ = std::move(error);
+  }
+}
+
+bool PipelinedImageReader::TakeEncoderError(brillo::ErrorPtr* error) {
+  base::AutoLock auto_lock(lock_);
+  if (!failed_) {
+    return false;
+  }
+
+  if (error && encoder_error_) {
+    *error = std::move(encoder_error_);
+  } else if (error && !*error) {
+    brillo::Error::AddTo(error, FROM_HERE, kDbusDomain, kManagerServiceError,
+                         "Image encoding failed");
+  }
+  return true;
+}
+
+}  // namespace lorgnette
@@ -0,0 +1,79 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LORGNETTE_IMAGE_READERS_PIPELINED_IMAGE_READER_H_
+#define LORGNETTE_IMAGE_READERS_PIPELINED_IMAGE_READER_H_
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <base/synchronization/condition_variable.h>
+#include <base/synchronization/lock.h>
+#include <base/thread_annotations.h>
+#include <base/threading/thread.h>
+
+#include "lorgnette/image_readers/image_reader.h"
+
+namespace lorgnette {
+
+// This class wraps another ImageReader and runs it on a separate encoder
+// thread, so that reading scan data from the scanner overlaps with encoding
+// the image. Rows are copied and handed to the encoder in batches, and at most
+// a few batches are kept in flight so memory use stays bounded when the
+// encoder is slower than the scanner.
+class PipelinedImageReader final : public ImageReader {
+ public:
+  // |reader| must have been created with the same |params|.
+  static std::unique_ptr<ImageReader> Create(
+      brillo::ErrorPtr* error,
+      const ScanParameters& params,
+      std::unique_ptr<ImageReader> reader);
+  ~PipelinedImageReader();
+
+  // Queues the row for encoding. Returns false once encoding an earlier row
+  // has failed.
+  bool ReadRow(brillo::ErrorPtr* error, uint8_t* data) override;
+  // Waits for all the queued rows to be encoded, then finalizes the image.
+  bool Finalize(brillo::ErrorPtr* error) override;
+
+ private:
+  PipelinedImageReader(const ScanParameters& params,
+                       std::unique_ptr<ImageReader> reader);
+  bool Initialize(brillo::ErrorPtr* error,
+                  const std::optional<int>& resolution) override;
+
+  // Hands |batch_| to the encoder thread, waiting first if too many batches
+  // are already in flight. Returns false if encoding has failed.
+  bool FlushBatch(brillo::ErrorPtr* error);
+
+  // Encodes |rows| rows from |batch|. Runs on |encoder_thread_|.
+  void EncodeBatch(std::vector<uint8_t> batch, size_t rows);
+
+  // Finalizes the image. Runs on |encoder_thread_|.
+  void FinalizeImage();
+
+  // Moves the encoder error into |error|, if encoding has failed. Returns
+  // whether encoding has failed.
+  bool TakeEncoderError(brillo::ErrorPtr* error);
+
+  std::unique_ptr<ImageReader> reader_;
+  base::Thread encoder_thread_;
+
+  // Rows copied since the last batch was handed to the encoder.
+  std::vector<uint8_t> batch_;
+  size_t batch_rows_ = 0;
+  const size_t rows_per_batch_;
+
+  base::Lock lock_;
+  // Signalled when the encoder is done with a batch.
+  base::ConditionVariable batch_done_;
+  size_t pending_batches_ GUARDED_BY(lock_) = 0;
+  bool failed_ GUARDED_BY(lock_) = false;
+  brillo::ErrorPtr encoder_error_ GUARDED_BY(lock_);
+};
+
+}  // namespace lorgnette
+
+#endif  // LORGNETTE_IMAGE_READERS_PIPELINED_IMAGE_READER_H_
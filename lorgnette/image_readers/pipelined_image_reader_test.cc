@@ -0,0 +1,131 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "lorgnette/image_readers/pipelined_image_reader.h"
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <brillo/errors/error.h>
+#include <dbus/lorgnette/dbus-constants.h>
+#include <gtest/gtest.h>
+
+#include "lorgnette/constants.h"
+#include "lorgnette/sane_client.h"
+
+namespace lorgnette {
+
+namespace {
+
+constexpr int kBytesPerLine = 100;
+constexpr int kLines = 50000;
+
+ScanParameters CreateScanParameters() {
+  ScanParameters parameters;
+  parameters.format = kGrayscale;
+  parameters.bytes_per_line = kBytesPerLine;
+  parameters.pixels_per_line = kBytesPerLine;
+  parameters.lines = kLines;
+  parameters.depth = 8;
+  return parameters;
+}
+
+// Records the first byte of every row it is given, and fails on row
+// |fail_row| if set.
+class FakeImageReader : public ImageReader {
+ public:
+  FakeImageReader(const ScanParameters& params,
+                  std::vector<uint8_t>* rows,
+                  bool* finalized,
+                  std::optional<size_t> fail_row)
+      : ImageReader(params, base::ScopedFILE()),
+        rows_(rows),
+        finalized_(finalized),
+        fail_row_(fail_row) {}
+
+  bool ReadRow(brillo::ErrorPtr* error, uint8_t* data) override {
+    if (fail_row_ == rows_->size()) {
+      brillo::Error::AddTo(error, FROM_HERE, kDbusDomain, kManagerServiceError,
+                           "Fake row failure");
+      return false;
+    }
+    rows_->push_back(data[0]);
+    return true;
+  }
+
+  bool Finalize(brillo::ErrorPtr* error) override {
+    *finalized_ = true;
+    return true;
+  }
+
+ private:
+  bool Initialize(brillo::ErrorPtr* error,
+                  const std::optional<int>& resolution) override {
+    return true;
+  }
+
+  std::vector<uint8_t>* rows_;
+  bool* finalized_;
+  std::optional<size_t> fail_row_;
+};
+
+}  // namespace
+
+TEST(PipelinedImageReaderTest, EncodesAllRowsInOrder) {
+  const ScanParameters parameters = CreateScanParameters();
+  std::vector<uint8_t> rows;
+  bool finalized = false;
+
+  brillo::ErrorPtr error;
+  std::unique_ptr<ImageReader> reader = PipelinedImageReader::Create(
+      &error, parameters,
+      std::make_unique<FakeImageReader>(parameters, &rows, &finalized,
+                                        std::nullopt));
+  ASSERT_TRUE(reader);
+
+  std::vector<uint8_t> row(kBytesPerLine);
+  for (int i = 0; i < kLines; i++) {
+    row[0] = i % 256;
+    ASSERT_TRUE(reader->ReadRow(&error, row.data()));
+  }
+  EXPECT_TRUE(reader->Finalize(&error));
+  EXPECT_FALSE(error);
+
+  EXPECT_TRUE(finalized);
+  ASSERT_EQ(rows.size(), kLines);
+  for (int i = 0; i < kLines; i++) {
+    EXPECT_EQ(rows[i], i % 256);
+  }
+}
+
+TEST(PipelinedImageReaderTest, ReportsEncoderFailure) {
+  const ScanParameters parameters = CreateScanParameters();
+  std::vector<uint8_t> rows;
+  bool finalized = false;
+
+  brillo::ErrorPtr error;
+  std::unique_ptr<ImageReader> reader = PipelinedImageReader::Create(
+      &error, parameters,
+      std::make_unique<FakeImageReader>(parameters, &rows, &finalized, 10));
+  ASSERT_TRUE(reader);
+
+  std::vector<uint8_t> row(kBytesPerLine);
+  bool read_failed = false;
+  for (int i = 0; i < kLines && !read_failed; i++) {
+    read_failed = !reader->ReadRow(&error, row.data());
+  }
+  if (!read_failed) {
+    EXPECT_FALSE(reader->Finalize(&error));
+  }
+
+  EXPECT_FALSE(finalized);
+  EXPECT_EQ(rows.size(), 10);
+  ASSERT_TRUE(error);
+  EXPECT_EQ(error->GetCode(), kManagerServiceError);
+  EXPECT_EQ(error->GetMessage(), "Fake row failure");
+}
+
+}  // namespace lorgnette
@@ -21,6 +21,7 @@
 #include <base/strings/stringprintf.h>
 #include <base/strings/string_util.h>
 #include <base/time/time.h>
+#include <base/timer/elapsed_timer.h>
 #include <chromeos/dbus/service_constants.h>
 #include <libusb.h>
 
@@ -32,6 +33,7 @@
 #include "lorgnette/guess_source.h"
 #include "lorgnette/image_readers/image_reader.h"
 #include "lorgnette/image_readers/jpeg_reader.h"
+#include "lorgnette/image_readers/pipelined_image_reader.h"
 #include "lorgnette/image_readers/png_reader.h"
 #include "lorgnette/ippusb_device.h"
 #include "lorgnette/scanner_match.h"
@@ -841,6 +843,15 @@ ScanState Manager::RunScanLoop(brillo::ErrorPtr* error,
     return SCAN_STATE_FAILED;
   }
 
+  // Encode on a separate thread so that the scanner doesn't wait on the
+  // encoder between reads.
+  image_reader = PipelinedImageReader::Create(error, params.value(),
+                                              std::move(image_reader));
+  if (!image_reader) {
+    return SCAN_STATE_FAILED;  // brillo::Error::AddTo already called.
+  }
+  base::ElapsedTimer page_timer;
+
   base::TimeTicks last_progress_sent_time = base::TimeTicks::Now();
   uint32_t last_progress_value = 0;
   size_t rows_written = 0;
@@ -931,6 +942,15 @@ ScanState Manager::RunScanLoop(brillo::ErrorPtr* error,
     return SCAN_STATE_FAILED;  // brillo::Error::AddTo already called.
   }
 
+  const base::TimeDelta page_time = page_timer.Elapsed();
+  const int64_t page_bytes =
+      static_cast<int64_t>(params->bytes_per_line) * params->lines;
+  LOG(INFO) << __func__ << ": Page " << scan_state->current_page << ": "
+            << page_bytes / 1024 << " KiB of image data scanned and encoded in "
+            << page_time.InMilliseconds() << " ms ("
+            << page_bytes / 1024 / std::max(page_time.InSecondsF(), 0.001)
+            << " KiB/s)";
+
   return SCAN_STATE_PAGE_COMPLETED;
 }
 
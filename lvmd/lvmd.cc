@@ -5,10 +5,13 @@
 #include "lvmd/lvmd.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <base/files/file_path.h>
 #include <base/strings/stringprintf.h>
 #include <base/task/single_thread_task_runner.h>
+#include <base/time/time.h>
 #include <brillo/errors/error.h>
 #include <brillo/errors/error_codes.h>
 #include <brillo/strings/string_utils.h>
@@ -33,9 +36,10 @@ Lvmd::Lvmd(std::unique_ptr<brillo::LogicalVolumeManager> lvm)
 bool Lvmd::GetPhysicalVolume(brillo::ErrorPtr* error,
                              const std::string& in_device_path,
                              lvmd::PhysicalVolume* out_physical_volume) {
-  auto opt_pv = lvm_->GetPhysicalVolume(base::FilePath(in_device_path));
-
-  if (!opt_pv) {
+  ExpireCache();
+  // Physical volumes with a cached volume group are known to exist.
+  if (!volume_groups_.count(in_device_path) &&
+      !lvm_->GetPhysicalVolume(base::FilePath(in_device_path))) {
     *error = CreateError(
         FROM_HERE, kErrorInternal,
         base::StringPrintf("Failed to GetPhysicalVolume on device path (%s)",
@@ -43,26 +47,31 @@ bool Lvmd::GetPhysicalVolume(brillo::ErrorPtr* error,
     return false;
   }
 
-  out_physical_volume->set_device_path(opt_pv->GetPath().value());
+  out_physical_volume->set_device_path(in_device_path);
   return true;
 }
 
 bool Lvmd::GetVolumeGroup(brillo::ErrorPtr* error,
                           const lvmd::PhysicalVolume& in_physical_volume,
                           lvmd::VolumeGroup* out_volume_group) {
+  ExpireCache();
   auto device_path = base::FilePath(in_physical_volume.device_path());
-  auto pv = brillo::PhysicalVolume(device_path, {});
-  auto opt_vg = lvm_->GetVolumeGroup(pv);
+  auto it = volume_groups_.find(device_path.value());
+  if (it == volume_groups_.end()) {
+    auto pv = brillo::PhysicalVolume(device_path, {});
+    auto opt_vg = lvm_->GetVolumeGroup(pv);
 
-  if (!opt_vg) {
-    *error =
-        CreateError(FROM_HERE, kErrorInternal,
-                    base::StringPrintf("Failed to GetVolumeGroup for pv (%s)",
-                                       device_path.value().c_str()));
-    return false;
+    if (!opt_vg) {
+      *error =
+          CreateError(FROM_HERE, kErrorInternal,
+                      base::StringPrintf("Failed to GetVolumeGroup for pv (%s)",
+                                         device_path.value().c_str()));
+      return false;
+    }
+    it = volume_groups_.emplace(device_path.value(), opt_vg->GetName()).first;
   }
 
-  out_volume_group->set_name(opt_vg->GetName());
+  out_volume_group->set_name(it->second);
   return true;
 }
 
@@ -70,23 +79,34 @@ bool Lvmd::GetThinpool(brillo::ErrorPtr* error,
                        const lvmd::VolumeGroup& in_volume_group,
                        const std::string& in_thinpool_name,
                        lvmd::Thinpool* out_thinpool) {
+  ExpireCache();
   auto vg_name = in_volume_group.name();
-  auto vg = brillo::VolumeGroup(vg_name, {});
-  auto opt_thinpool = lvm_->GetThinpool(vg, in_thinpool_name);
-
-  if (!opt_thinpool) {
-    *error = CreateError(
-        FROM_HERE, kErrorInternal,
-        base::StringPrintf("Failed to GetThinpool for thinpool (%s) in vg (%s)",
-                           in_thinpool_name.c_str(), vg_name.c_str()));
-    return false;
+  auto it = thinpools_.find({vg_name, in_thinpool_name});
+  if (it == thinpools_.end()) {
+    auto vg = brillo::VolumeGroup(vg_name, {});
+    auto opt_thinpool = lvm_->GetThinpool(vg, in_thinpool_name);
+
+    if (!opt_thinpool) {
+      *error = CreateError(
+          FROM_HERE, kErrorInternal,
+          base::StringPrintf(
+              "Failed to GetThinpool for thinpool (%s) in vg (%s)",
+              in_thinpool_name.c_str(), vg_name.c_str()));
+      return false;
+    }
+    it = thinpools_
+             .emplace(std::make_pair(vg_name, in_thinpool_name),
+                      std::move(*opt_thinpool))
+             .first;
   }
+  // The space used changes all the time, so it is always read.
+  brillo::Thinpool& thinpool = it->second;
 
   *out_thinpool->mutable_volume_group() = in_volume_group;
-  out_thinpool->set_name(opt_thinpool->GetRawName());
+  out_thinpool->set_name(thinpool.GetRawName());
 
   int64_t total_bytes;
-  if (!opt_thinpool->GetTotalSpace(&total_bytes)) {
+  if (!thinpool.GetTotalSpace(&total_bytes)) {
     *error =
         CreateError(FROM_HERE, kErrorInternal,
                     base::StringPrintf(
@@ -97,7 +117,7 @@ bool Lvmd::GetThinpool(brillo::ErrorPtr* error,
   out_thinpool->set_total_bytes(total_bytes);
 
   int64_t free_bytes;
-  if (!opt_thinpool->GetFreeSpace(&free_bytes)) {
+  if (!thinpool.GetFreeSpace(&free_bytes)) {
     *error =
         CreateError(FROM_HERE, kErrorInternal,
                     base::StringPrintf(
@@ -114,8 +134,11 @@ bool Lvmd::ListLogicalVolumes(
     brillo::ErrorPtr* error,
     const lvmd::VolumeGroup& in_volume_group,
     lvmd::LogicalVolumeList* out_logical_volume_list) {
+  ExpireCache();
+  // Listing is always done afresh, and refreshes the cache.
   auto vg = brillo::VolumeGroup(in_volume_group.name(), {});
-  auto lvs = lvm_->ListLogicalVolumes(vg);
+  auto& lvs = logical_volumes_[in_volume_group.name()];
+  lvs = lvm_->ListLogicalVolumes(vg);
 
   for (auto& lv : lvs) {
     auto* new_lv = out_logical_volume_list->add_logical_volume();
@@ -132,9 +155,9 @@ bool Lvmd::GetLogicalVolume(brillo::ErrorPtr* error,
                             const lvmd::VolumeGroup& in_volume_group,
                             const std::string& in_logical_volume_name,
                             lvmd::LogicalVolume* out_logical_volume) {
+  ExpireCache();
   auto vg_name = in_volume_group.name();
-  auto vg = brillo::VolumeGroup(vg_name, {});
-  auto opt_lv = lvm_->GetLogicalVolume(vg, in_logical_volume_name);
+  auto opt_lv = FindLogicalVolume(vg_name, in_logical_volume_name);
 
   if (!opt_lv) {
     *error = CreateError(
@@ -155,44 +178,70 @@ bool Lvmd::CreateLogicalVolume(
     const lvmd::Thinpool& in_thinpool,
     const lvmd::LogicalVolumeConfiguration& in_logical_volume_configuration,
     lvmd::LogicalVolume* out_logical_volume) {
-  auto vg_name = in_thinpool.volume_group().name();
-  auto vg = brillo::VolumeGroup(vg_name, {});
+  ExpireCache();
+  auto opt_lv = CreateLogicalVolumeInternal(error, in_thinpool,
+                                            in_logical_volume_configuration);
+  if (!opt_lv)
+    return false;
 
-  auto thinpool_name = in_thinpool.name();
-  auto thinpool = brillo::Thinpool(thinpool_name, vg_name, {});
+  *out_logical_volume->mutable_volume_group() = in_thinpool.volume_group();
+  out_logical_volume->set_name(opt_lv->GetName());
+  out_logical_volume->set_path(opt_lv->GetPath().value());
+  return true;
+}
 
-  base::Value::Dict config;
-  auto lv_name = in_logical_volume_configuration.name();
-  config.Set("name", lv_name);
-  config.Set("size", brillo::string_utils::ToString(
-                         in_logical_volume_configuration.size()));
+bool Lvmd::CreateLogicalVolumes(
+    brillo::ErrorPtr* error,
+    const lvmd::Thinpool& in_thinpool,
+    const lvmd::LogicalVolumeConfigurationList&
+        in_logical_volume_configuration_list,
+    lvmd::LogicalVolumeList* out_logical_volume_list) {
+  ExpireCache();
+  auto vg_name = in_thinpool.volume_group().name();
 
-  auto opt_lv = lvm_->CreateLogicalVolume(vg, thinpool, config);
+  std::vector<std::string> existing_lv_names;
+  for (const auto& lv_config :
+       in_logical_volume_configuration_list.logical_volume_configuration()) {
+    auto opt_lv = FindLogicalVolume(vg_name, lv_config.name());
+    if (opt_lv) {
+      existing_lv_names.push_back(lv_config.name());
+    } else {
+      opt_lv = CreateLogicalVolumeInternal(error, in_thinpool, lv_config);
+      if (!opt_lv)
+        return false;
+    }
 
-  if (!opt_lv) {
-    *error =
-        CreateError(FROM_HERE, kErrorInternal,
-                    base::StringPrintf("Failed to CreateLogicalVolume for lv "
-                                       "name (%s) in thinpool (%s) in vg (%s)",
-                                       lv_name.c_str(), thinpool_name.c_str(),
-                                       vg_name.c_str()));
+    auto* new_lv = out_logical_volume_list->add_logical_volume();
+    *new_lv->mutable_volume_group() = in_thinpool.volume_group();
+    new_lv->set_name(opt_lv->GetRawName());
+    new_lv->set_path(opt_lv->GetPath().value());
+  }
+
+  // Newly created logical volumes are already active.
+  if (!lvm_->ActivateLogicalVolumes(brillo::VolumeGroup(vg_name, {}),
+                                    existing_lv_names)) {
+    InvalidateLogicalVolumes(vg_name);
+    *error = CreateError(
+        FROM_HERE, kErrorInternal,
+        base::StringPrintf("Failed to activate %zu lv(s) in vg (%s)",
+                           existing_lv_names.size(), vg_name.c_str()));
     return false;
   }
 
-  *out_logical_volume->mutable_volume_group() = in_thinpool.volume_group();
-  out_logical_volume->set_name(opt_lv->GetName());
-  out_logical_volume->set_path(opt_lv->GetPath().value());
   return true;
 }
 
 bool Lvmd::RemoveLogicalVolume(brillo::ErrorPtr* error,
                                const lvmd::LogicalVolume& in_logical_volume) {
+  ExpireCache();
   auto vg_name = in_logical_volume.volume_group().name();
   auto vg = brillo::VolumeGroup(vg_name, {});
 
   std::string lv_name = in_logical_volume.name();
 
-  if (!lvm_->RemoveLogicalVolume(vg, lv_name)) {
+  bool removed = lvm_->RemoveLogicalVolume(vg, lv_name);
+  InvalidateLogicalVolumes(vg_name);
+  if (!removed) {
     *error =
         CreateError(FROM_HERE, kErrorInternal,
                     base::StringPrintf("Failed to RemoveLogicalVolume for lv "
@@ -208,11 +257,11 @@ bool Lvmd::ToggleLogicalVolumeActivation(
     brillo::ErrorPtr* error,
     const lvmd::LogicalVolume& in_logical_volume,
     bool activate) {
+  ExpireCache();
   auto vg_name = in_logical_volume.volume_group().name();
-  auto vg = brillo::VolumeGroup(vg_name, {});
 
   std::string lv_name = in_logical_volume.name();
-  auto opt_lv = lvm_->GetLogicalVolume(vg, lv_name);
+  auto opt_lv = FindLogicalVolume(vg_name, lv_name);
 
   if (!opt_lv) {
     *error = CreateError(
@@ -224,6 +273,7 @@ bool Lvmd::ToggleLogicalVolumeActivation(
 
   if (activate) {
     if (!opt_lv->Activate()) {
+      InvalidateLogicalVolumes(vg_name);
       *error =
           CreateError(FROM_HERE, kErrorInternal,
                       base::StringPrintf("Failed to activate for lv "
@@ -232,6 +282,7 @@ bool Lvmd::ToggleLogicalVolumeActivation(
       return false;
     }
   } else if (!opt_lv->Deactivate()) {
+    InvalidateLogicalVolumes(vg_name);
     *error = CreateError(FROM_HERE, kErrorInternal,
                          base::StringPrintf("Failed to deactivate for lv "
                                             "name (%s) in vg (%s)",
@@ -265,6 +316,80 @@ void Lvmd::OnShutdown(int* return_code) {
   brillo::DBusServiceDaemon::OnShutdown(return_code);
 }
 
+const std::vector<brillo::LogicalVolume>& Lvmd::GetCachedLogicalVolumes(
+    const std::string& vg_name) {
+  auto it = logical_volumes_.find(vg_name);
+  if (it == logical_volumes_.end()) {
+    auto vg = brillo::VolumeGroup(vg_name, {});
+    it = logical_volumes_.emplace(vg_name, lvm_->ListLogicalVolumes(vg)).first;
+  }
+  return it->second;
+}
+
+std::optional<brillo::LogicalVolume> Lvmd::FindLogicalVolume(
+    const std::string& vg_name, const std::string& lv_name) {
+  for (const auto& lv : GetCachedLogicalVolumes(vg_name)) {
+    if (lv.GetRawName() == lv_name)
+      return lv;
+  }
+
+  auto opt_lv =
+      lvm_->GetLogicalVolume(brillo::VolumeGroup(vg_name, {}), lv_name);
+  if (opt_lv)
+    InvalidateLogicalVolumes(vg_name);
+  return opt_lv;
+}
+
+std::optional<brillo::LogicalVolume> Lvmd::CreateLogicalVolumeInternal(
+    brillo::ErrorPtr* error,
+    const lvmd::Thinpool& in_thinpool,
+    const lvmd::LogicalVolumeConfiguration& in_logical_volume_configuration) {
+  auto vg_name = in_thinpool.volume_group().name();
+  auto vg = brillo::VolumeGroup(vg_name, {});
+
+  auto thinpool_name = in_thinpool.name();
+  auto thinpool = brillo::Thinpool(thinpool_name, vg_name, {});
+
+  base::Value::Dict config;
+  auto lv_name = in_logical_volume_configuration.name();
+  config.Set("name", lv_name);
+  config.Set("size", brillo::string_utils::ToString(
+                         in_logical_volume_configuration.size()));
+
+  auto opt_lv = lvm_->CreateLogicalVolume(vg, thinpool, config);
+
+  if (!opt_lv) {
+    InvalidateLogicalVolumes(vg_name);
+    *error =
+        CreateError(FROM_HERE, kErrorInternal,
+                    base::StringPrintf("Failed to CreateLogicalVolume for lv "
+                                       "name (%s) in thinpool (%s) in vg (%s)",
+                                       lv_name.c_str(), thinpool_name.c_str(),
+                                       vg_name.c_str()));
+    return std::nullopt;
+  }
+
+  auto it = logical_volumes_.find(vg_name);
+  if (it != logical_volumes_.end())
+    it->second.push_back(*opt_lv);
+  return opt_lv;
+}
+
+void Lvmd::InvalidateLogicalVolumes(const std::string& vg_name) {
+  logical_volumes_.erase(vg_name);
+}
+
+void Lvmd::ExpireCache() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (now - cache_start_time_ < kCacheTimeout)
+    return;
+
+  volume_groups_.clear();
+  thinpools_.clear();
+  logical_volumes_.clear();
+  cache_start_time_ = now;
+}
+
 void Lvmd::PostponeShutdown() {
   shutdown_callback_.Reset(
       base::BindRepeating(&brillo::Daemon::Quit, weak_factory_.GetWeakPtr()));
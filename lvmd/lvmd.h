@@ -5,13 +5,17 @@
 #ifndef LVMD_LVMD_H_
 #define LVMD_LVMD_H_
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <base/cancelable_callback.h>
 #include <base/functional/callback.h>
 #include <base/memory/weak_ptr.h>
+#include <base/time/time.h>
 #include <brillo/daemons/dbus_daemon.h>
 #include <brillo/blkdev_utils/lvm.h>
 #include <lvmd/proto_bindings/lvmd.pb.h>
@@ -66,6 +70,15 @@ class Lvmd : public brillo::DBusServiceDaemon,
       const lvmd::LogicalVolumeConfiguration& in_logical_volume_configuration,
       lvmd::LogicalVolume* out_logical_volume) override;
 
+  // Returns the logical volumes created. Logical volumes which already exist
+  // are activated instead.
+  bool CreateLogicalVolumes(
+      brillo::ErrorPtr* error,
+      const lvmd::Thinpool& in_thinpool,
+      const lvmd::LogicalVolumeConfigurationList&
+          in_logical_volume_configuration_list,
+      lvmd::LogicalVolumeList* out_logical_volume_list) override;
+
   // Removes the logical volume, if it exists.
   bool RemoveLogicalVolume(
       brillo::ErrorPtr* error,
@@ -88,15 +101,58 @@ class Lvmd : public brillo::DBusServiceDaemon,
  private:
   void PostponeShutdown();
 
+  // Returns the thin logical volumes of volume group |vg_name|, reading them
+  // only if they aren't cached.
+  const std::vector<brillo::LogicalVolume>& GetCachedLogicalVolumes(
+      const std::string& vg_name);
+
+  // Returns the logical volume |lv_name| of volume group |vg_name|, if it
+  // exists. Logical volumes missing from the cache, eg. created by another
+  // process, are looked up directly.
+  std::optional<brillo::LogicalVolume> FindLogicalVolume(
+      const std::string& vg_name, const std::string& lv_name);
+
+  // Creates the logical volume |in_logical_volume_configuration| on
+  // |in_thinpool| and adds it to the cache.
+  std::optional<brillo::LogicalVolume> CreateLogicalVolumeInternal(
+      brillo::ErrorPtr* error,
+      const lvmd::Thinpool& in_thinpool,
+      const lvmd::LogicalVolumeConfiguration& in_logical_volume_configuration);
+
+  // Drops the cached logical volumes of |vg_name|, when they may no longer
+  // match the system.
+  void InvalidateLogicalVolumes(const std::string& vg_name);
+
+  // Drops the whole cache once it is older than |kCacheTimeout|, so that the
+  // LVM objects changed by other processes are eventually seen.
+  void ExpireCache();
+
   // Daemon will automatically shutdown after this length of idle time.
   static constexpr base::TimeDelta kShutdownTimeout = base::Seconds(30);
 
+  // Longest time the cached LVM objects are served without reading them again.
+  // Long enough to cover the lookups of a single client operation.
+  static constexpr base::TimeDelta kCacheTimeout = base::Seconds(2);
+
   // The shutdown callback so daemon can shutdown.
   base::CancelableRepeatingClosure shutdown_callback_;
 
   // The brillo library implementation of managing logical volumes.
   std::unique_ptr<brillo::LogicalVolumeManager> lvm_;
 
+  // Cached view of the LVM objects, so that repeated lookups don't each run
+  // an LVM report. The logical volumes of a volume group are dropped whenever
+  // lvmd changes it, and the whole view after |kCacheTimeout|, since other
+  // processes may change the LVM objects too.
+  // Maps physical volume device paths to their volume group names.
+  std::map<std::string, std::string> volume_groups_;
+  // Maps (volume group, thinpool) names to the known thinpools.
+  std::map<std::pair<std::string, std::string>, brillo::Thinpool> thinpools_;
+  // Maps volume group names to their thin logical volumes.
+  std::map<std::string, std::vector<brillo::LogicalVolume>> logical_volumes_;
+  // When the cache was last emptied.
+  base::TimeTicks cache_start_time_;
+
   // DBus related members.
   std::unique_ptr<brillo::dbus_utils::DBusObject> dbus_object_;
   org::chromium::LvmdAdaptor dbus_adaptor_{this};
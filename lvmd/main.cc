@@ -25,7 +25,9 @@ int main(int argc, char* argv[]) {
     return EX_USAGE;
   }
 
-  auto lvm = std::make_unique<brillo::LogicalVolumeManager>();
+  // lvmd runs many commands in a row, so keep the lvm2 context around.
+  auto lvm = std::make_unique<brillo::LogicalVolumeManager>(
+      std::make_shared<brillo::LvmCommandRunner>(/*keep_session=*/true));
 
   lvmd::Lvmd daemon(std::move(lvm));
   daemon.Run();
@@ -4,6 +4,7 @@
 
 #include "metrics/metrics_daemon.h"
 
+#include <algorithm>
 #include <fcntl.h>
 #include <fstream>
 #include <inttypes.h>
@@ -32,6 +33,7 @@
 #include <dbus/object_proxy.h>
 
 #include "metrics/process_meter.h"
+#include "metrics/serialization/serialization_utils.h"
 #include "uploader/upload_service.h"
 
 // Returns a pointer for use in PostDelayedTask.  The daemon never exits on its
@@ -97,6 +99,14 @@ const char kCroutonStartedFile[] =
 
 constexpr base::TimeDelta kVmlogInterval = base::Seconds(2);
 
+// Interval between drains of the UMA spool. The spool holds
+// MetricsSpool::kNumSlots samples, and writers fall back to the metrics file
+// when it is full.
+constexpr base::TimeDelta kUmaSpoolDrainInterval = base::Seconds(1);
+// The interval doubles while the spool stays empty, up to this one. Writers
+// can't wake metrics_daemon up, so the drains can't stop altogether.
+constexpr base::TimeDelta kUmaSpoolMaxDrainInterval = base::Seconds(32);
+
 constexpr char kVmlogDir[] = "/var/log/vmlog";
 
 // Memory use stats collection intervals.  We collect some memory use interval
@@ -430,6 +440,15 @@ int MetricsDaemon::OnInit() {
 
   vmlog_writer_.reset(new chromeos_metrics::VmlogWriter(
       base::FilePath(kVmlogDir), kVmlogInterval));
+
+  uma_spool_ =
+      metrics::MetricsSpool::CreateForReading(base::FilePath(kUMASpoolPath));
+  if (uma_spool_) {
+    DrainUmaSpoolCallback(kUmaSpoolDrainInterval);
+  } else {
+    LOG(WARNING) << "UMA spool is unavailable. Clients write to "
+                 << metrics_file_ << " directly.";
+  }
   bus_->AssertOnDBusThread();
   CHECK(bus_->SetUpAsyncOperations());
 
@@ -891,6 +910,32 @@ void MetricsDaemon::ScheduleReportProcessMemory(base::TimeDelta interval) {
       interval);
 }
 
+void MetricsDaemon::DrainUmaSpoolCallback(base::TimeDelta interval) {
+  // Drains in batches, so that the metrics file is locked once per batch
+  // instead of once per sample.
+  std::vector<metrics::MetricSample> samples;
+  size_t num_drained = 0;
+  while (size_t num_slots =
+             uma_spool_->Drain(&samples, metrics::MetricsSpool::kNumSlots)) {
+    num_drained += num_slots;
+    if (!samples.empty() && !metrics::SerializationUtils::WriteMetricsToFile(
+                                samples, metrics_file_)) {
+      LOG(ERROR) << "Failed to write " << samples.size()
+                 << " samples from the UMA spool";
+    }
+    samples.clear();
+  }
+
+  interval = num_drained > 0
+                 ? kUmaSpoolDrainInterval
+                 : std::min(interval * 2, kUmaSpoolMaxDrainInterval);
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&MetricsDaemon::DrainUmaSpoolCallback,
+                     GET_THIS_FOR_POSTTASK(), interval),
+      interval);
+}
+
 void MetricsDaemon::ReportProcessMemoryCallback(base::TimeDelta wait) {
   ReportProcessMemory();
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostDelayedTask(
@@ -20,6 +20,7 @@
 #include "metrics/metrics_library.h"
 #include "metrics/persistent_integer.h"
 #include "metrics/process_meter.h"
+#include "metrics/serialization/metrics_spool.h"
 #include "metrics/vmlog_writer.h"
 #include "uploader/upload_service.h"
 
@@ -283,6 +284,11 @@ class MetricsDaemon : public brillo::DBusDaemon {
   // Runs ReportProcessMemory every |interval| time delta.
   void ReportProcessMemoryCallback(base::TimeDelta interval);
 
+  // Moves the samples written to the UMA spool by other processes to the
+  // metrics file. Reschedules itself with twice |interval| if the spool was
+  // empty, and with the shortest interval otherwise.
+  void DrainUmaSpoolCallback(base::TimeDelta interval);
+
   // Classifies all processes into groups and reports the sum of their memory
   // usage (total, anon, file, and shmem).
   void ReportProcessMemory();
@@ -456,6 +462,7 @@ class MetricsDaemon : public brillo::DBusDaemon {
 
   std::unique_ptr<UploadService> upload_service_;
   std::unique_ptr<VmlogWriter> vmlog_writer_;
+  std::unique_ptr<metrics::MetricsSpool> uma_spool_;
 
   // The backing directory for persistent integers.
   base::FilePath backing_dir_;
@@ -4,13 +4,16 @@
 
 #include "metrics/metrics_writer.h"
 
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <base/files/file_path.h>
+#include <base/functional/bind.h>
 #include <base/logging.h>
 #include <base/location.h>
+#include <base/notreached.h>
 #include <base/synchronization/waitable_event.h>
 
 #include "metrics/serialization/serialization_utils.h"
@@ -88,3 +91,156 @@ void AsynchronousMetricsWriter::SetOutputFileOnThread(
     base::FilePath output_file) {
   uma_events_file_ = std::move(output_file);
 }
+
+SpoolMetricsWriter::SpoolMetricsWriter(bool use_nonblocking_lock,
+                                       base::FilePath spool_file,
+                                       base::FilePath uma_events_file)
+    : use_nonblocking_lock_(use_nonblocking_lock),
+      spool_file_(std::move(spool_file)),
+      uma_events_file_(std::move(uma_events_file)) {}
+
+SpoolMetricsWriter::~SpoolMetricsWriter() = default;
+
+bool SpoolMetricsWriter::WriteMetrics(
+    std::vector<metrics::MetricSample> samples) {
+  if (!spool_)
+    spool_ = metrics::MetricsSpool::OpenForWriting(spool_file_);
+
+  std::vector<metrics::MetricSample> rejected_samples;
+  for (auto& sample : samples) {
+    if (!spool_ || !spool_->Write(sample))
+      rejected_samples.push_back(std::move(sample));
+  }
+  if (rejected_samples.empty())
+    return true;
+
+  return metrics::SerializationUtils::WriteMetricsToFile(
+      rejected_samples, uma_events_file_.value(),
+      /*use_nonblocking_lock=*/use_nonblocking_lock_);
+}
+
+bool SpoolMetricsWriter::SetOutputFile(const std::string& output_file) {
+  uma_events_file_ = base::FilePath(output_file);
+  return true;
+}
+
+AggregatingMetricsWriter::AggregatingMetricsWriter(
+    scoped_refptr<MetricsWriter> writer, base::TimeDelta flush_interval)
+    : writer_(std::move(writer)) {
+  if (flush_interval.is_positive()) {
+    task_runner_ = base::SequencedTaskRunner::GetCurrentDefault();
+    flush_timer_ = std::make_unique<base::RepeatingTimer>();
+    // Unretained is safe since the timer is owned by this.
+    flush_timer_->Start(FROM_HERE, flush_interval,
+                        base::BindRepeating(
+                            [](AggregatingMetricsWriter* writer) {
+                              if (!writer->Flush())
+                                LOG(ERROR) << "Failed to flush metrics";
+                            },
+                            base::Unretained(this)));
+  }
+}
+
+AggregatingMetricsWriter::~AggregatingMetricsWriter() {
+  // The last reference may be released on another sequence: the timer is then
+  // stopped and destroyed on its own sequence, before the final flush.
+  if (flush_timer_ && !task_runner_->RunsTasksInCurrentSequence()) {
+    base::WaitableEvent destroyed;
+    if (task_runner_->PostTask(
+            FROM_HERE,
+            base::BindOnce(
+                [](std::unique_ptr<base::RepeatingTimer> timer,
+                   base::WaitableEvent* destroyed) {
+                  timer.reset();
+                  destroyed->Signal();
+                },
+                std::move(flush_timer_), &destroyed))) {
+      destroyed.Wait();
+    }
+  }
+  flush_timer_.reset();
+
+  if (!Flush())
+    LOG(ERROR) << "Failed to flush metrics";
+}
+
+bool AggregatingMetricsWriter::WriteMetrics(
+    std::vector<metrics::MetricSample> samples) {
+  bool result = true;
+  for (const auto& sample : samples) {
+    if (!sample.IsValid()) {
+      LOG(ERROR) << "Dropping invalid sample " << sample.name();
+      result = false;
+      continue;
+    }
+    SampleKey key = GetKey(sample);
+    auto it = pending_samples_.find(key);
+    if (it != pending_samples_.end() &&
+        it->second > std::numeric_limits<int>::max() - sample.num_samples()) {
+      result &= Flush();
+    }
+    pending_samples_[std::move(key)] += sample.num_samples();
+  }
+  if (pending_samples_.size() >= kMaxPendingSamples)
+    result &= Flush();
+  return result;
+}
+
+bool AggregatingMetricsWriter::SetOutputFile(const std::string& output_file) {
+  const bool flushed = Flush();
+  return writer_->SetOutputFile(output_file) && flushed;
+}
+
+bool AggregatingMetricsWriter::Flush() {
+  if (pending_samples_.empty())
+    return true;
+
+  std::vector<metrics::MetricSample> samples;
+  samples.reserve(pending_samples_.size());
+  for (const auto& [key, num_samples] : pending_samples_)
+    samples.push_back(MakeSample(key, num_samples));
+  pending_samples_.clear();
+  return writer_->WriteMetrics(std::move(samples));
+}
+
+// static
+AggregatingMetricsWriter::SampleKey AggregatingMetricsWriter::GetKey(
+    const metrics::MetricSample& sample) {
+  switch (sample.type()) {
+    case metrics::MetricSample::HISTOGRAM:
+      return {sample.type(), sample.name(),  sample.sample(),
+              sample.min(),  sample.max(),   sample.bucket_count()};
+    case metrics::MetricSample::LINEAR_HISTOGRAM:
+      return {sample.type(), sample.name(), sample.sample(), 0, sample.max(),
+              0};
+    case metrics::MetricSample::SPARSE_HISTOGRAM:
+      return {sample.type(), sample.name(), sample.sample(), 0, 0, 0};
+    default:
+      return {sample.type(), sample.name(), 0, 0, 0, 0};
+  }
+}
+
+// static
+metrics::MetricSample AggregatingMetricsWriter::MakeSample(const SampleKey& key,
+                                                           int num_samples) {
+  const auto& [type, name, sample, min, max, bucket_count] = key;
+  switch (type) {
+    case metrics::MetricSample::CRASH:
+      return metrics::MetricSample::CrashSample(name, num_samples);
+    case metrics::MetricSample::HISTOGRAM:
+      return metrics::MetricSample::HistogramSample(name, sample, min, max,
+                                                    bucket_count, num_samples);
+    case metrics::MetricSample::LINEAR_HISTOGRAM:
+      return metrics::MetricSample::LinearHistogramSample(name, sample, max,
+                                                          num_samples);
+    case metrics::MetricSample::SPARSE_HISTOGRAM:
+      return metrics::MetricSample::SparseHistogramSample(name, sample,
+                                                          num_samples);
+    case metrics::MetricSample::USER_ACTION:
+      return metrics::MetricSample::UserActionSample(name, num_samples);
+    case metrics::MetricSample::INVALID:
+      break;
+  }
+  NOTREACHED();
+  return metrics::MetricSample();
+}
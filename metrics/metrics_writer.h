@@ -5,15 +5,21 @@
 #ifndef METRICS_METRICS_WRITER_H_
 #define METRICS_METRICS_WRITER_H_
 
+#include <map>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <base/files/file_path.h>
 #include <base/memory/ref_counted.h>
 #include <base/memory/scoped_refptr.h>
 #include <base/task/sequenced_task_runner.h>
+#include <base/time/time.h>
+#include <base/timer/timer.h>
 
 #include "metrics/serialization/metric_sample.h"
+#include "metrics/serialization/metrics_spool.h"
 
 constexpr char kUMAEventsPath[] = "/var/lib/metrics/uma-events";
 
@@ -109,4 +115,101 @@ class AsynchronousMetricsWriter : public MetricsWriter {
   base::WeakPtrFactory<AsynchronousMetricsWriter> weak_ptr_factory_{this};
 };
 
+// Write UMA metrics to the shared memory spool drained by metrics_daemon.
+//
+// Writing to the spool doesn't take the file lock nor make a syscall, so this
+// writer is suitable for processes that report metrics frequently. Samples
+// that the spool can't take (the spool doesn't exist yet, is full, or the
+// sample is too large) are written using
+// `metrics::SerializationUtils::WriteMetricsToFile` as SynchronousMetricsWriter
+// does.
+//
+// To use this writer, pass it to `MetricsLibrary(scoped_refptr<MetricsWriter>)`.
+//
+// This class is not thread-safe.
+class SpoolMetricsWriter : public MetricsWriter {
+ public:
+  explicit SpoolMetricsWriter(
+      bool use_nonblocking_lock = false,
+      base::FilePath spool_file = base::FilePath(kUMASpoolPath),
+      base::FilePath uma_events_file = base::FilePath(kUMAEventsPath));
+
+  bool WriteMetrics(std::vector<metrics::MetricSample> samples) override;
+  // Change the path of the file used when the spool is unavailable.
+  bool SetOutputFile(const std::string& output_file) override;
+
+ private:
+  ~SpoolMetricsWriter() override;
+
+  const bool use_nonblocking_lock_;
+  const base::FilePath spool_file_;
+  base::FilePath uma_events_file_;
+  // Opened on demand, since metrics_daemon may create the spool after this
+  // writer.
+  std::unique_ptr<metrics::MetricsSpool> spool_;
+};
+
+// Aggregate UMA metrics in memory and write them to another `MetricsWriter` as
+// repeated samples.
+//
+// Samples of the same histogram with the same value are merged into one
+// sample whose `num_samples` is the sum, so a caller sending the same
+// histogram in a hot loop writes one sample per distinct value per flush
+// instead of one per call. Pending samples are flushed every `flush_interval`
+// on the sequence the writer is created on, when too many distinct samples
+// are pending, on `Flush()`, and on destruction. Use a zero `flush_interval`
+// to disable the periodic flush, eg. when there is no task runner.
+//
+// Samples pending at a crash are lost, so keep `flush_interval` short for
+// metrics that matter around crashes.
+//
+// To use this writer, pass it to `MetricsLibrary(scoped_refptr<MetricsWriter>)`:
+//
+//    MetricsLibrary metrics(base::MakeRefCounted<AggregatingMetricsWriter>(
+//        base::MakeRefCounted<SynchronousMetricsWriter>()));
+//
+// This class is not thread-safe. It may be released on any sequence, but then
+// waits for its sequence to stop the periodic flush, like
+// AsynchronousMetricsWriter waits for its writes.
+class AggregatingMetricsWriter : public MetricsWriter {
+ public:
+  static constexpr base::TimeDelta kDefaultFlushInterval = base::Seconds(30);
+  // Number of distinct pending samples at which they are flushed regardless of
+  // the interval.
+  static constexpr size_t kMaxPendingSamples = 1024;
+
+  explicit AggregatingMetricsWriter(
+      scoped_refptr<MetricsWriter> writer,
+      base::TimeDelta flush_interval = kDefaultFlushInterval);
+
+  // Merges the samples into the pending ones. Returns false if a sample is
+  // invalid, and dropped, or if a flush triggered by this call fails.
+  bool WriteMetrics(std::vector<metrics::MetricSample> samples) override;
+  // Flushes the pending samples to the previous output file and changes the
+  // output file of the underlying writer.
+  bool SetOutputFile(const std::string& output_file) override;
+  // Writes the pending samples to the underlying writer.
+  bool Flush();
+
+ private:
+  // Type, name, sample, min, max and bucket count of a sample. The fields
+  // unused by the type are zero.
+  using SampleKey =
+      std::tuple<metrics::MetricSample::SampleType, std::string, int, int, int,
+                 int>;
+
+  ~AggregatingMetricsWriter() override;
+
+  static SampleKey GetKey(const metrics::MetricSample& sample);
+  static metrics::MetricSample MakeSample(const SampleKey& key,
+                                          int num_samples);
+
+  const scoped_refptr<MetricsWriter> writer_;
+  // Number of samples for each pending sample.
+  std::map<SampleKey, int> pending_samples_;
+  // The sequence |flush_timer_| runs on, if there is a periodic flush.
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  std::unique_ptr<base::RepeatingTimer> flush_timer_;
+};
+
 #endif  // METRICS_METRICS_WRITER_H_
@@ -5,12 +5,15 @@
 #include "metrics/metrics_writer.h"
 
 #include <base/files/file_path.h>
+#include <base/files/file_util.h>
 #include <base/files/scoped_temp_dir.h>
+#include <base/functional/bind.h>
 #include <base/memory/scoped_refptr.h>
 #include <base/task/thread_pool.h>
 #include <base/test/task_environment.h>
 #include <gtest/gtest.h>
 
+#include "metrics/serialization/metrics_spool.h"
 #include "metrics/serialization/serialization_utils.h"
 
 TEST(SynchronousMetricsWriterTest, WriteMetrics) {
@@ -145,3 +148,155 @@ TEST_F(AsynchronousMetricsWriterTest, SetOutputFile) {
   EXPECT_EQ(samples.size(), 1);
   EXPECT_EQ(samples[0].name(), sample2.name());
 }
+
+TEST(SpoolMetricsWriterTest, WriteMetricsToSpool) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  auto spool_path = temp_dir.GetPath().Append("spool");
+  auto file_path = temp_dir.GetPath().Append("metrics");
+  auto spool = metrics::MetricsSpool::CreateForReading(spool_path);
+  ASSERT_NE(spool, nullptr);
+  auto writer = base::MakeRefCounted<SpoolMetricsWriter>(
+      /*use_nonblocking_lock=*/false, spool_path, file_path);
+
+  auto sample1 = metrics::MetricSample::LinearHistogramSample(
+      "Test1", 1, 2, /*num_samples=*/1);
+  auto sample2 = metrics::MetricSample::LinearHistogramSample(
+      "Test2", 1, 2, /*num_samples=*/2);
+  EXPECT_TRUE(writer->WriteMetrics({sample1, sample2}));
+  std::vector<metrics::MetricSample> samples;
+  EXPECT_EQ(spool->Drain(&samples, metrics::MetricsSpool::kNumSlots), 2);
+  ASSERT_EQ(samples.size(), 2);
+  EXPECT_EQ(samples[0].name(), sample1.name());
+  EXPECT_EQ(samples[1].name(), sample2.name());
+  EXPECT_FALSE(base::PathExists(file_path));
+}
+
+TEST(SpoolMetricsWriterTest, FallBackToFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  auto spool_path = temp_dir.GetPath().Append("spool");
+  auto file_path = temp_dir.GetPath().Append("metrics");
+  auto writer = base::MakeRefCounted<SpoolMetricsWriter>(
+      /*use_nonblocking_lock=*/false, spool_path, file_path);
+
+  // The spool doesn't exist.
+  auto sample1 = metrics::MetricSample::LinearHistogramSample(
+      "Test1", 1, 2, /*num_samples=*/1);
+  EXPECT_TRUE(writer->WriteMetrics({sample1}));
+  std::vector<metrics::MetricSample> samples;
+  ASSERT_TRUE(metrics::SerializationUtils::ReadAndTruncateMetricsFromFile(
+      file_path.value(), &samples,
+      metrics::SerializationUtils::kSampleBatchMaxLength));
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_EQ(samples[0].name(), sample1.name());
+
+  // The spool is created later and used from the next write.
+  auto spool = metrics::MetricsSpool::CreateForReading(spool_path);
+  ASSERT_NE(spool, nullptr);
+  auto sample2 = metrics::MetricSample::LinearHistogramSample(
+      "Test2", 1, 2, /*num_samples=*/1);
+  EXPECT_TRUE(writer->WriteMetrics({sample2}));
+  samples.clear();
+  EXPECT_EQ(spool->Drain(&samples, metrics::MetricsSpool::kNumSlots), 1);
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_EQ(samples[0].name(), sample2.name());
+}
+
+class AggregatingMetricsWriterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    file_path_ = temp_dir_.GetPath().Append("metrics");
+    writer_ = base::MakeRefCounted<AggregatingMetricsWriter>(
+        base::MakeRefCounted<SynchronousMetricsWriter>(
+            /*use_nonblocking_lock=*/false, file_path_),
+        kFlushInterval);
+  }
+
+  std::vector<metrics::MetricSample> ReadSamples() {
+    std::vector<metrics::MetricSample> samples;
+    EXPECT_TRUE(metrics::SerializationUtils::ReadAndTruncateMetricsFromFile(
+        file_path_.value(), &samples,
+        metrics::SerializationUtils::kSampleBatchMaxLength));
+    return samples;
+  }
+
+  static constexpr base::TimeDelta kFlushInterval = base::Seconds(10);
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  scoped_refptr<AggregatingMetricsWriter> writer_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath file_path_;
+};
+
+TEST_F(AggregatingMetricsWriterTest, MergeSamples) {
+  auto sample1 = metrics::MetricSample::LinearHistogramSample(
+      "Test1", 1, 10, /*num_samples=*/1);
+  auto sample2 = metrics::MetricSample::LinearHistogramSample(
+      "Test1", 2, 10, /*num_samples=*/1);
+  auto sample3 = metrics::MetricSample::SparseHistogramSample(
+      "Test2", 5, /*num_samples=*/3);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(writer_->WriteMetrics({sample1}));
+    EXPECT_TRUE(writer_->WriteMetrics({sample2, sample3}));
+  }
+  // Nothing is written until the flush.
+  EXPECT_FALSE(base::PathExists(file_path_));
+
+  EXPECT_TRUE(writer_->Flush());
+  std::vector<metrics::MetricSample> samples = ReadSamples();
+  ASSERT_EQ(samples.size(), 3);
+  EXPECT_TRUE(samples[0].IsEqual(metrics::MetricSample::LinearHistogramSample(
+      "Test1", 1, 10, /*num_samples=*/100)));
+  EXPECT_TRUE(samples[1].IsEqual(metrics::MetricSample::LinearHistogramSample(
+      "Test1", 2, 10, /*num_samples=*/100)));
+  EXPECT_TRUE(samples[2].IsEqual(metrics::MetricSample::SparseHistogramSample(
+      "Test2", 5, /*num_samples=*/300)));
+}
+
+TEST_F(AggregatingMetricsWriterTest, FlushPeriodically) {
+  auto sample = metrics::MetricSample::UserActionSample("Test", 1);
+  EXPECT_TRUE(writer_->WriteMetrics({sample}));
+  EXPECT_TRUE(writer_->WriteMetrics({sample}));
+
+  task_environment_.FastForwardBy(kFlushInterval);
+  std::vector<metrics::MetricSample> samples = ReadSamples();
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_EQ(samples[0].num_samples(), 2);
+}
+
+TEST_F(AggregatingMetricsWriterTest, FlushOnDestruction) {
+  auto sample = metrics::MetricSample::CrashSample("Test", 1);
+  EXPECT_TRUE(writer_->WriteMetrics({sample}));
+  writer_.reset();
+
+  std::vector<metrics::MetricSample> samples = ReadSamples();
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_TRUE(samples[0].IsEqual(sample));
+}
+
+TEST_F(AggregatingMetricsWriterTest, FlushTooManySamples) {
+  for (size_t i = 0; i < AggregatingMetricsWriter::kMaxPendingSamples; i++) {
+    EXPECT_TRUE(writer_->WriteMetrics(
+        {metrics::MetricSample::SparseHistogramSample("Test", i, 1)}));
+  }
+  EXPECT_EQ(ReadSamples().size(), AggregatingMetricsWriter::kMaxPendingSamples);
+}
+
+TEST_F(AggregatingMetricsWriterTest, ReleaseOnAnotherSequence) {
+  auto sample = metrics::MetricSample::UserActionSample("Test", 1);
+  EXPECT_TRUE(writer_->WriteMetrics({sample}));
+
+  // The writer waits for its sequence to destroy the flush timer.
+  base::ThreadPool::PostTask(
+      FROM_HERE, {base::WithBaseSyncPrimitives()},
+      base::BindOnce([](scoped_refptr<AggregatingMetricsWriter> writer) {},
+                     std::move(writer_)));
+  task_environment_.RunUntilIdle();
+
+  std::vector<metrics::MetricSample> samples = ReadSamples();
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_TRUE(samples[0].IsEqual(sample));
+}
@@ -7,6 +7,7 @@
 #include <errno.h>
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -33,6 +34,10 @@ namespace {
 // A string which crosvm's command line for ARCVM always has.
 constexpr char const* kArcVmCommandLine = "androidboot.hardware=bertha";
 
+// stat: pid (comm) run_state ppid etc. The only parentheses in the file
+// are around <comm>.
+constexpr LazyRE2 kStatRegexp = {R"(.*\((.*)\) \w+ (\d+)(.|\n)*)"};
+
 bool IsArcVmProcess(const ProcessNode& node) {
   return node.GetCmdlineString().find(kArcVmCommandLine) != std::string::npos;
 }
@@ -41,6 +46,48 @@ bool IsNotArcVmProcess(const ProcessNode& node) {
   return !IsArcVmProcess(node);
 }
 
+// Parses the memory usage out of the content of a smaps_rollup or totmaps
+// file. Returns false if some fields aren't present.
+bool ParseMemoryUsage(const std::string& file_content,
+                      ProcessMemoryStats* stats) {
+  const std::vector<std::string_view> lines = base::SplitStringPiece(
+      file_content, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  struct NameValuePair {
+    const std::string name;
+    uint64_t value;
+  };
+  std::vector<NameValuePair> pairs = {{"Pss:", 0},
+                                      {"Pss_Anon:", 0},
+                                      {"Pss_File:", 0},
+                                      {"Pss_Shmem:", 0},
+                                      {"Swap:", 0}};
+  int index = 0;
+  for (const auto& line : lines) {
+    if (base::StartsWith(line, pairs[index].name,
+                         base::CompareCase::SENSITIVE)) {
+      std::vector<std::string_view> fields = base::SplitStringPiece(
+          line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+      if (fields.size() != 3)
+        LOG(FATAL) << "bad rollup line: " << line;
+      if (!base::StringToUint64(fields[1], &pairs[index].value))
+        LOG(FATAL) << "bad integer in rollup line: " << line;
+      index++;
+      if (index == pairs.size())
+        break;
+    }
+  }
+  if (index < pairs.size()) {
+    return false;
+  }
+
+  stats->rss_sizes[MEM_TOTAL] = pairs[0].value * 1024;
+  stats->rss_sizes[MEM_ANON] = pairs[1].value * 1024;
+  stats->rss_sizes[MEM_FILE] = pairs[2].value * 1024;
+  stats->rss_sizes[MEM_SHMEM] = pairs[3].value * 1024;
+  stats->rss_sizes[MEM_SWAP] = pairs[4].value * 1024;
+  return true;
+}
+
 }  // namespace
 
 // UMA histogram names for process memory usage, split by process groups and
@@ -294,10 +341,7 @@ bool ProcessNode::RetrieveProcessData(const base::FilePath& procfs_root) {
     // Assume process has exited.
     return false;
   }
-  // stat: pid (comm) run_state ppid etc. The only parentheses in the file
-  // are around <comm>.
-  RE2 re(R"(.*\((.*)\) \w+ (\d+)(.|\n)*)");
-  if (!RE2::FullMatch(file_content, re, &name_, &ppid_)) {
+  if (!RE2::FullMatch(file_content, *kStatRegexp, &name_, &ppid_)) {
     // Since there's no guarantees about a processes name -- it might not
     // be UTF-8, for example -- this is just a warning.
     LOG(WARNING) << "cannot parse /proc/pid/stat: " << file_content;
@@ -381,47 +425,19 @@ const std::vector<ProcessNode*>& ProcessInfo::GetGroup(
 void GetMemoryUsage(const base::FilePath& procfs_path,
                     int pid,
                     ProcessMemoryStats* stats) {
+  // Prefer the upstream smaps_rollup, and fall back to totmaps on kernels which
+  // don't have it or whose smaps_rollup doesn't split the Pss (before 5.8).
+  // If some fields aren't present in either, return zeros instead of crashing.
   std::string file_content;
-  const std::string file_name = base::StringPrintf("%d/totmaps", pid);
-  const base::FilePath file_path = procfs_path.Append(file_name);
-  if (!base::ReadFileToString(file_path, &file_content))
+  const base::FilePath pid_path =
+      procfs_path.Append(base::StringPrintf("%d", pid));
+  if (base::ReadFileToString(pid_path.Append("smaps_rollup"), &file_content) &&
+      ParseMemoryUsage(file_content, stats)) {
     return;
-  const std::vector<std::string> lines = base::SplitString(
-      file_content, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-  struct NameValuePair {
-    const std::string name;
-    uint64_t value;
-  };
-  std::vector<NameValuePair> pairs = {{"Pss:", 0},
-                                      {"Pss_Anon:", 0},
-                                      {"Pss_File:", 0},
-                                      {"Pss_Shmem:", 0},
-                                      {"Swap:", 0}};
-  int index = 0;
-  for (const auto& line : lines) {
-    if (base::StartsWith(line, pairs[index].name,
-                         base::CompareCase::SENSITIVE)) {
-      std::vector<std::string> fields = base::SplitString(
-          line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-      if (fields.size() != 3)
-        LOG(FATAL) << "bad rollup line: " << line;
-      if (!base::StringToUint64(fields[1], &pairs[index].value))
-        LOG(FATAL) << "bad integer in rollup line: " << line;
-      index++;
-      if (index == pairs.size())
-        break;
-    }
   }
-  if (index < pairs.size() && index != 0) {
-    // If some fields aren't present, return zeros instead of crashing.
-    return;
+  if (base::ReadFileToString(pid_path.Append("totmaps"), &file_content)) {
+    ParseMemoryUsage(file_content, stats);
   }
-
-  stats->rss_sizes[MEM_TOTAL] = pairs[0].value * 1024;
-  stats->rss_sizes[MEM_ANON] = pairs[1].value * 1024;
-  stats->rss_sizes[MEM_FILE] = pairs[2].value * 1024;
-  stats->rss_sizes[MEM_SHMEM] = pairs[3].value * 1024;
-  stats->rss_sizes[MEM_SWAP] = pairs[4].value * 1024;
 }
 
 void AccumulateProcessGroupStats(const base::FilePath& procfs_path,
@@ -272,6 +272,58 @@ void CheckMem(int mem, const char* field) {
   }
 }
 
+// Test that smaps_rollup is used rather than totmaps when it exists.
+TEST_F(ProcessMeterTest, GetMemoryUsage_SmapsRollup) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath procfs_path = temp_dir.GetPath();
+  CreateProcEntry(procfs_path, 100, 1, "daemon", "/usr/bin/daemon", 100, 50,
+                  40, 10, 5);
+  CreateFile(procfs_path.Append("100/smaps_rollup"),
+             "00400000-ffffffffff600000 ---p 00000000 00:00 0 [rollup]\n"
+             "Rss:               4096 kB\n"
+             "Pss:               2048 kB\n"
+             "Pss_Dirty:          512 kB\n"
+             "Pss_Anon:          1024 kB\n"
+             "Pss_File:           768 kB\n"
+             "Pss_Shmem:          256 kB\n"
+             "Shared_Clean:         0 kB\n"
+             "Swap:               128 kB\n"
+             "SwapPss:             64 kB\n");
+
+  ProcessMemoryStats stats;
+  GetMemoryUsage(procfs_path, 100, &stats);
+  EXPECT_EQ(stats.rss_sizes[MEM_TOTAL], 2048 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_ANON], 1024 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_FILE], 768 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_SHMEM], 256 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_SWAP], 128 * 1024);
+}
+
+// Test that totmaps is used when smaps_rollup doesn't split the Pss.
+TEST_F(ProcessMeterTest, GetMemoryUsage_SmapsRollupWithoutPssSplit) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath procfs_path = temp_dir.GetPath();
+  CreateProcEntry(procfs_path, 100, 1, "daemon", "/usr/bin/daemon", 100, 50,
+                  40, 10, 5);
+  CreateFile(procfs_path.Append("100/smaps_rollup"),
+             "00400000-ffffffffff600000 ---p 00000000 00:00 0 [rollup]\n"
+             "Rss:               4096 kB\n"
+             "Pss:               2048 kB\n"
+             "Shared_Clean:         0 kB\n"
+             "Swap:               128 kB\n"
+             "SwapPss:             64 kB\n");
+
+  ProcessMemoryStats stats;
+  GetMemoryUsage(procfs_path, 100, &stats);
+  EXPECT_EQ(stats.rss_sizes[MEM_TOTAL], 100 * 1024 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_ANON], 50 * 1024 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_FILE], 40 * 1024 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_SHMEM], 10 * 1024 * 1024);
+  EXPECT_EQ(stats.rss_sizes[MEM_SWAP], 5 * 1024 * 1024);
+}
+
 // Test that the enum constants for process kind and memory kind match the UMA
 // histogram names.
 TEST_F(ProcessMeterTest, CheckUMANames) {
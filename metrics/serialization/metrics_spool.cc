@@ -0,0 +1,348 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "metrics/serialization/metrics_spool.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+
+#include <base/check.h>
+#include <base/check_op.h>
+
+#define READ_WRITE_ALL_FILE_FLAGS \
+  (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH)
+
+namespace metrics {
+
+namespace {
+
+// "UMAS" in little endian. Written last on initialization, so writers never
+// see a partially initialized spool.
+constexpr uint32_t kSpoolMagic = 0x53414d55;
+constexpr uint32_t kSpoolVersion = 1;
+
+static_assert((MetricsSpool::kNumSlots & (MetricsSpool::kNumSlots - 1)) == 0,
+              "The number of slots must be a power of two");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "The spool requires lock-free atomics in shared memory");
+
+// Appends |value| to |*out| if there is enough space in [*out, end).
+bool PutInt32(int32_t value, uint8_t** out, const uint8_t* end) {
+  if (end - *out < static_cast<ptrdiff_t>(sizeof(value)))
+    return false;
+  memcpy(*out, &value, sizeof(value));
+  *out += sizeof(value);
+  return true;
+}
+
+// Reads an int32 from |*in| if there are enough bytes in [*in, end).
+bool GetInt32(const uint8_t** in, const uint8_t* end, int32_t* value) {
+  if (end - *in < static_cast<ptrdiff_t>(sizeof(*value)))
+    return false;
+  memcpy(value, *in, sizeof(*value));
+  *in += sizeof(*value);
+  return true;
+}
+
+}  // namespace
+
+struct MetricsSpool::Header {
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t num_slots;
+  uint32_t slot_size;
+  // The producers and the consumer touch different cache lines.
+  alignas(64) std::atomic<uint32_t> enqueue_position;
+  alignas(64) std::atomic<uint32_t> dequeue_position;
+};
+
+struct MetricsSpool::Slot {
+  // Equals to the position when the slot is free to write at the position,
+  // and to the position + 1 when the sample written at the position is ready
+  // to read.
+  std::atomic<uint32_t> sequence;
+  uint32_t size;
+  uint8_t data[kMaxEncodedSampleSize];
+};
+
+// static
+size_t MetricsSpool::GetFileSize() {
+  return sizeof(Header) + sizeof(Slot) * kNumSlots;
+}
+
+// static
+std::unique_ptr<MetricsSpool> MetricsSpool::CreateForReading(
+    const base::FilePath& path) {
+  base::File file(path, base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_READ |
+                            base::File::FLAG_WRITE);
+  if (!file.IsValid()) {
+    LOG(ERROR) << path << ": cannot open: "
+               << base::File::ErrorToString(file.error_details());
+    return nullptr;
+  }
+  // All the processes sending metrics write to the spool.
+  if (HANDLE_EINTR(fchmod(file.GetPlatformFile(), READ_WRITE_ALL_FILE_FLAGS)))
+    PLOG(WARNING) << path << ": cannot change the permission";
+
+  const bool size_matched = file.GetLength() == GetFileSize();
+  if (!size_matched && !file.SetLength(GetFileSize())) {
+    PLOG(ERROR) << path << ": cannot resize";
+    return nullptr;
+  }
+
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(std::move(file),
+                               base::MemoryMappedFile::READ_WRITE)) {
+    LOG(ERROR) << path << ": cannot map";
+    return nullptr;
+  }
+
+  std::unique_ptr<MetricsSpool> spool(new MetricsSpool(std::move(mapped_file)));
+  Header* header = spool->header();
+  if (size_matched &&
+      header->magic.load(std::memory_order_acquire) == kSpoolMagic &&
+      header->version == kSpoolVersion && header->num_slots == kNumSlots &&
+      header->slot_size == sizeof(Slot)) {
+    // Keeps the samples left by the previous reader.
+    return spool;
+  }
+
+  // Initializes the spool. Writers don't use it until the magic is set.
+  header->magic.store(0, std::memory_order_relaxed);
+  header->version = kSpoolVersion;
+  header->num_slots = kNumSlots;
+  header->slot_size = sizeof(Slot);
+  new (&header->enqueue_position) std::atomic<uint32_t>(0);
+  new (&header->dequeue_position) std::atomic<uint32_t>(0);
+  for (uint32_t i = 0; i < kNumSlots; i++) {
+    Slot* slot = spool->slot(i);
+    new (&slot->sequence) std::atomic<uint32_t>(i);
+    slot->size = 0;
+  }
+  header->magic.store(kSpoolMagic, std::memory_order_release);
+  return spool;
+}
+
+// static
+std::unique_ptr<MetricsSpool> MetricsSpool::OpenForWriting(
+    const base::FilePath& path) {
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ |
+                            base::File::FLAG_WRITE);
+  // Missing spool is normal when metrics_daemon isn't running.
+  if (!file.IsValid() || file.GetLength() != GetFileSize())
+    return nullptr;
+
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(std::move(file),
+                               base::MemoryMappedFile::READ_WRITE)) {
+    LOG(ERROR) << path << ": cannot map";
+    return nullptr;
+  }
+
+  std::unique_ptr<MetricsSpool> spool(new MetricsSpool(std::move(mapped_file)));
+  Header* header = spool->header();
+  if (header->magic.load(std::memory_order_acquire) != kSpoolMagic ||
+      header->version != kSpoolVersion || header->num_slots != kNumSlots ||
+      header->slot_size != sizeof(Slot)) {
+    return nullptr;
+  }
+  return spool;
+}
+
+// static
+size_t MetricsSpool::EncodeSample(const MetricSample& sample,
+                                  uint8_t* buffer,
+                                  size_t buffer_size) {
+  // The format is:
+  //   type (1 byte), name length (1 byte), name, fields of the type
+  // where each field is a 4-byte integer in the architecture's endianness,
+  // since the spool never leaves the device.
+  if (!sample.IsValid() || sample.name().size() > UINT8_MAX ||
+      buffer_size < 2 + sample.name().size()) {
+    return 0;
+  }
+
+  uint8_t* out = buffer;
+  const uint8_t* const end = buffer + buffer_size;
+  *out++ = static_cast<uint8_t>(sample.type());
+  *out++ = static_cast<uint8_t>(sample.name().size());
+  memcpy(out, sample.name().data(), sample.name().size());
+  out += sample.name().size();
+
+  bool result = true;
+  switch (sample.type()) {
+    case MetricSample::CRASH:
+    case MetricSample::USER_ACTION:
+      break;
+    case MetricSample::HISTOGRAM:
+      result = PutInt32(sample.sample(), &out, end) &&
+               PutInt32(sample.min(), &out, end) &&
+               PutInt32(sample.max(), &out, end) &&
+               PutInt32(sample.bucket_count(), &out, end);
+      break;
+    case MetricSample::LINEAR_HISTOGRAM:
+      result = PutInt32(sample.sample(), &out, end) &&
+               PutInt32(sample.max(), &out, end);
+      break;
+    case MetricSample::SPARSE_HISTOGRAM:
+      result = PutInt32(sample.sample(), &out, end);
+      break;
+    case MetricSample::INVALID:
+      return 0;
+  }
+  if (!result || !PutInt32(sample.num_samples(), &out, end))
+    return 0;
+
+  return out - buffer;
+}
+
+// static
+MetricSample MetricsSpool::DecodeSample(const uint8_t* buffer, size_t size) {
+  const uint8_t* in = buffer;
+  const uint8_t* const end = buffer + size;
+  if (size < 2)
+    return MetricSample();
+
+  const uint8_t type = *in++;
+  const uint8_t name_size = *in++;
+  if (end - in < name_size)
+    return MetricSample();
+  const std::string name(reinterpret_cast<const char*>(in), name_size);
+  in += name_size;
+
+  int32_t values[4] = {};
+  int num_values = 0;
+  switch (type) {
+    case MetricSample::CRASH:
+    case MetricSample::USER_ACTION:
+      break;
+    case MetricSample::HISTOGRAM:
+      num_values = 4;
+      break;
+    case MetricSample::LINEAR_HISTOGRAM:
+      num_values = 2;
+      break;
+    case MetricSample::SPARSE_HISTOGRAM:
+      num_values = 1;
+      break;
+    default:
+      LOG(ERROR) << "invalid sample type in metrics spool: "
+                 << static_cast<int>(type);
+      return MetricSample();
+  }
+  for (int i = 0; i < num_values; i++) {
+    if (!GetInt32(&in, end, &values[i]))
+      return MetricSample();
+  }
+  int32_t num_samples;
+  if (!GetInt32(&in, end, &num_samples) || in != end)
+    return MetricSample();
+
+  switch (type) {
+    case MetricSample::CRASH:
+      return MetricSample::CrashSample(name, num_samples);
+    case MetricSample::USER_ACTION:
+      return MetricSample::UserActionSample(name, num_samples);
+    case MetricSample::HISTOGRAM:
+      return MetricSample::HistogramSample(name, values[0], values[1],
+                                           values[2], values[3], num_samples);
+    case MetricSample::LINEAR_HISTOGRAM:
+      return MetricSample::LinearHistogramSample(name, values[0], values[1],
+                                                 num_samples);
+    case MetricSample::SPARSE_HISTOGRAM:
+      return MetricSample::SparseHistogramSample(name, values[0], num_samples);
+  }
+  return MetricSample();
+}
+
+MetricsSpool::MetricsSpool(std::unique_ptr<base::MemoryMappedFile> mapped_file)
+    : mapped_file_(std::move(mapped_file)) {
+  CHECK_EQ(mapped_file_->length(), GetFileSize());
+}
+
+MetricsSpool::~MetricsSpool() = default;
+
+MetricsSpool::Header* MetricsSpool::header() {
+  return reinterpret_cast<Header*>(mapped_file_->data());
+}
+
+MetricsSpool::Slot* MetricsSpool::slot(uint32_t position) {
+  Slot* slots = reinterpret_cast<Slot*>(mapped_file_->data() + sizeof(Header));
+  return &slots[position & (kNumSlots - 1)];
+}
+
+bool MetricsSpool::Write(const MetricSample& sample) {
+  uint8_t data[kMaxEncodedSampleSize];
+  const size_t size = EncodeSample(sample, data, sizeof(data));
+  if (size == 0)
+    return false;
+
+  Header* const header = this->header();
+  uint32_t position = header->enqueue_position.load(std::memory_order_relaxed);
+  while (true) {
+    Slot* const target = slot(position);
+    const uint32_t sequence = target->sequence.load(std::memory_order_acquire);
+    const int32_t diff =
+        static_cast<int32_t>(sequence) - static_cast<int32_t>(position);
+    if (diff == 0) {
+      // The slot is free. Claims it, or retries with the updated position if
+      // another writer claimed it first.
+      if (header->enqueue_position.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        memcpy(target->data, data, size);
+        target->size = size;
+        target->sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // The slot still holds the sample written a round ago. Full.
+      return false;
+    } else {
+      // Another writer claimed the slot. Catch up with it.
+      position = header->enqueue_position.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+size_t MetricsSpool::Drain(std::vector<MetricSample>* samples,
+                           size_t max_samples) {
+  Header* const header = this->header();
+  uint32_t position = header->dequeue_position.load(std::memory_order_relaxed);
+  size_t num_consumed = 0;
+  while (num_consumed < max_samples) {
+    Slot* const target = slot(position);
+    if (target->sequence.load(std::memory_order_acquire) != position + 1) {
+      // The slot is not written yet, or the writer is still writing it.
+      break;
+    }
+
+    MetricSample sample = DecodeSample(
+        target->data, std::min<size_t>(target->size, kMaxEncodedSampleSize));
+    if (sample.IsValid())
+      samples->push_back(std::move(sample));
+    else
+      LOG(ERROR) << "broken sample in metrics spool";
+
+    // Frees the slot for the position of the next round.
+    target->sequence.store(position + kNumSlots, std::memory_order_release);
+    position++;
+    num_consumed++;
+  }
+  header->dequeue_position.store(position, std::memory_order_relaxed);
+  return num_consumed;
+}
+
+}  // namespace metrics
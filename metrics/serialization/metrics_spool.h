@@ -0,0 +1,96 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef METRICS_SERIALIZATION_METRICS_SPOOL_H_
+#define METRICS_SERIALIZATION_METRICS_SPOOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include <base/files/file_path.h>
+#include <base/files/memory_mapped_file.h>
+
+#include "metrics/serialization/metric_sample.h"
+
+constexpr char kUMASpoolPath[] = "/run/metrics/uma-spool";
+
+namespace metrics {
+
+// A ring buffer of metric samples in a shared memory file, which lets
+// processes hand samples to metrics_daemon without taking the lock of the
+// uma-events file.
+//
+// Any number of processes can write samples concurrently. Writes never block:
+// a slot is claimed with a compare-and-swap and a write fails immediately if
+// the spool is full or the sample is too large for a slot, in which case the
+// caller should fall back to SerializationUtils::WriteMetricsToFile.
+//
+// There must be a single reader, metrics_daemon, which creates the spool and
+// drains it in batches.
+//
+// The spool is a bounded MPMC queue with per-slot sequence numbers. If a
+// writer dies between claiming a slot and publishing it, the reader stops at
+// that slot until the spool is recreated (eg. on reboot, since it lives in
+// /run), and writers fall back to the file once the spool fills up.
+class MetricsSpool {
+ public:
+  // Number of slots in the spool. Must be a power of two.
+  static constexpr uint32_t kNumSlots = 4096;
+  // Maximum size of an encoded sample.
+  static constexpr size_t kMaxEncodedSampleSize = 248;
+
+  // Opens the spool at |path| for reading, creating and initializing it if it
+  // doesn't exist or is broken. Samples left by a previous reader are kept.
+  // Returns nullptr on failure.
+  static std::unique_ptr<MetricsSpool> CreateForReading(
+      const base::FilePath& path);
+  // Opens the existing spool at |path| for writing. Returns nullptr if the
+  // spool doesn't exist or isn't initialized yet.
+  static std::unique_ptr<MetricsSpool> OpenForWriting(
+      const base::FilePath& path);
+
+  // Encodes |sample| into |buffer| in a compact binary format. Returns the
+  // size of the encoded sample, or 0 if it doesn't fit into |buffer_size|.
+  static size_t EncodeSample(const MetricSample& sample,
+                             uint8_t* buffer,
+                             size_t buffer_size);
+  // Decodes a sample encoded by EncodeSample(). Returns an invalid sample on
+  // failure.
+  static MetricSample DecodeSample(const uint8_t* buffer, size_t size);
+
+  MetricsSpool(const MetricsSpool&) = delete;
+  MetricsSpool& operator=(const MetricsSpool&) = delete;
+
+  ~MetricsSpool();
+
+  // Appends |sample| to the spool. Returns false without blocking if the
+  // spool is full or the sample can't be encoded into a slot.
+  bool Write(const MetricSample& sample);
+
+  // Moves up to |max_samples| samples from the spool to |samples| in the
+  // order they were written. Returns the number of slots consumed, which
+  // includes those holding samples that failed to decode. Must be called only
+  // by the single reader.
+  size_t Drain(std::vector<MetricSample>* samples, size_t max_samples);
+
+ private:
+  struct Header;
+  struct Slot;
+
+  explicit MetricsSpool(std::unique_ptr<base::MemoryMappedFile> mapped_file);
+
+  static size_t GetFileSize();
+
+  Header* header();
+  Slot* slot(uint32_t position);
+
+  const std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+};
+
+}  // namespace metrics
+
+#endif  // METRICS_SERIALIZATION_METRICS_SPOOL_H_
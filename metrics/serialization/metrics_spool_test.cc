@@ -0,0 +1,134 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "metrics/serialization/metrics_spool.h"
+
+#include <string>
+#include <vector>
+
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <gtest/gtest.h>
+
+#include "metrics/serialization/metric_sample.h"
+
+namespace metrics {
+namespace {
+
+class MetricsSpoolTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    spool_path_ = temp_dir_.GetPath().Append("uma-spool");
+  }
+
+  void TestEncoding(const MetricSample& sample) {
+    uint8_t buffer[MetricsSpool::kMaxEncodedSampleSize];
+    const size_t size =
+        MetricsSpool::EncodeSample(sample, buffer, sizeof(buffer));
+    ASSERT_GT(size, 0);
+    EXPECT_TRUE(sample.IsEqual(MetricsSpool::DecodeSample(buffer, size)));
+    // Truncated samples are rejected.
+    EXPECT_FALSE(MetricsSpool::DecodeSample(buffer, size - 1).IsValid());
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath spool_path_;
+};
+
+TEST_F(MetricsSpoolTest, EncodeDecode) {
+  TestEncoding(MetricSample::CrashSample("crash", 1));
+  TestEncoding(MetricSample::UserActionSample("action", 3));
+  TestEncoding(MetricSample::HistogramSample("hist", -1, 0, 100, 50, 2));
+  TestEncoding(MetricSample::LinearHistogramSample("linear", 12, 30, 1));
+  TestEncoding(MetricSample::SparseHistogramSample("sparse", 42, 7));
+}
+
+TEST_F(MetricsSpoolTest, EncodeTooLongName) {
+  uint8_t buffer[MetricsSpool::kMaxEncodedSampleSize];
+  const std::string name(MetricsSpool::kMaxEncodedSampleSize, 'a');
+  EXPECT_EQ(0, MetricsSpool::EncodeSample(MetricSample::CrashSample(name, 1),
+                                          buffer, sizeof(buffer)));
+}
+
+TEST_F(MetricsSpoolTest, OpenForWritingWithoutSpool) {
+  EXPECT_EQ(nullptr, MetricsSpool::OpenForWriting(spool_path_));
+
+  // A file which is not initialized by the reader isn't used either.
+  ASSERT_TRUE(base::WriteFile(spool_path_, "garbage"));
+  EXPECT_EQ(nullptr, MetricsSpool::OpenForWriting(spool_path_));
+}
+
+TEST_F(MetricsSpoolTest, WriteAndDrain) {
+  auto reader = MetricsSpool::CreateForReading(spool_path_);
+  ASSERT_NE(nullptr, reader);
+  auto writer = MetricsSpool::OpenForWriting(spool_path_);
+  ASSERT_NE(nullptr, writer);
+
+  auto sample1 = MetricSample::LinearHistogramSample("Test1", 1, 2, 1);
+  auto sample2 = MetricSample::SparseHistogramSample("Test2", 3, 1);
+  auto sample3 = MetricSample::CrashSample("Test3", 1);
+  EXPECT_TRUE(writer->Write(sample1));
+  EXPECT_TRUE(writer->Write(sample2));
+  EXPECT_TRUE(writer->Write(sample3));
+
+  std::vector<MetricSample> samples;
+  EXPECT_EQ(2, reader->Drain(&samples, 2));
+  ASSERT_EQ(2, samples.size());
+  EXPECT_TRUE(sample1.IsEqual(samples[0]));
+  EXPECT_TRUE(sample2.IsEqual(samples[1]));
+
+  samples.clear();
+  EXPECT_EQ(1, reader->Drain(&samples, MetricsSpool::kNumSlots));
+  ASSERT_EQ(1, samples.size());
+  EXPECT_TRUE(sample3.IsEqual(samples[0]));
+
+  // Nothing is left.
+  samples.clear();
+  EXPECT_EQ(0, reader->Drain(&samples, MetricsSpool::kNumSlots));
+  EXPECT_TRUE(samples.empty());
+}
+
+TEST_F(MetricsSpoolTest, Full) {
+  auto reader = MetricsSpool::CreateForReading(spool_path_);
+  ASSERT_NE(nullptr, reader);
+  auto writer = MetricsSpool::OpenForWriting(spool_path_);
+  ASSERT_NE(nullptr, writer);
+
+  auto sample = MetricSample::SparseHistogramSample("Test", 1, 1);
+  for (uint32_t i = 0; i < MetricsSpool::kNumSlots; i++)
+    ASSERT_TRUE(writer->Write(sample));
+  EXPECT_FALSE(writer->Write(sample));
+
+  // Draining frees the slots for the next round.
+  std::vector<MetricSample> samples;
+  EXPECT_EQ(1, reader->Drain(&samples, 1));
+  EXPECT_TRUE(writer->Write(sample));
+  EXPECT_FALSE(writer->Write(sample));
+
+  samples.clear();
+  EXPECT_EQ(MetricsSpool::kNumSlots,
+            reader->Drain(&samples, MetricsSpool::kNumSlots + 1));
+  EXPECT_EQ(MetricsSpool::kNumSlots, samples.size());
+}
+
+TEST_F(MetricsSpoolTest, KeepSamplesOnReopen) {
+  auto reader = MetricsSpool::CreateForReading(spool_path_);
+  ASSERT_NE(nullptr, reader);
+  auto writer = MetricsSpool::OpenForWriting(spool_path_);
+  ASSERT_NE(nullptr, writer);
+  auto sample = MetricSample::UserActionSample("Test", 1);
+  EXPECT_TRUE(writer->Write(sample));
+
+  // The samples written before the reader restarts are drained.
+  reader = MetricsSpool::CreateForReading(spool_path_);
+  ASSERT_NE(nullptr, reader);
+  std::vector<MetricSample> samples;
+  EXPECT_EQ(1, reader->Drain(&samples, MetricsSpool::kNumSlots));
+  ASSERT_EQ(1, samples.size());
+  EXPECT_TRUE(sample.IsEqual(samples[0]));
+}
+
+}  // namespace
+}  // namespace metrics
@@ -14,6 +14,8 @@ class Recorder {
  public:
   virtual ~Recorder() {}
   virtual bool Record(const EventBase& event) = 0;
+  // Writes the events which haven't been written to disk yet, if any.
+  virtual void Flush() {}
 };
 
 }  // namespace structured
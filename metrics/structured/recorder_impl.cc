@@ -24,6 +24,9 @@ namespace {
 
 constexpr mode_t kFilePermissions = 0660;
 
+// The maximum number of events kept in memory when batching is enabled.
+constexpr int kMaxPendingEvents = 100;
+
 // Writes |events| to a file within |directory|. Fails if |directory| doesn't
 // exist. Returns whether the write was successful.
 bool WriteEventsProtoToDir(const std::string& directory,
@@ -61,7 +64,27 @@ RecorderImpl::RecorderImpl(const std::string& events_directory,
                            const std::string& keys_path)
     : events_directory_(events_directory), key_data_(keys_path) {}
 
-RecorderImpl::~RecorderImpl() = default;
+RecorderImpl::~RecorderImpl() {
+  Flush();
+}
+
+void RecorderImpl::EnableBatching(base::TimeDelta flush_delay) {
+  flush_delay_ = flush_delay;
+  if (!pending_events_)
+    pending_events_ = std::make_unique<EventsProto>();
+}
+
+void RecorderImpl::Flush() {
+  flush_timer_.Stop();
+  if (!pending_events_ || pending_events_->non_uma_events_size() == 0)
+    return;
+
+  if (!WriteEventsProtoToDir(events_directory_, *pending_events_)) {
+    LOG(ERROR) << "Dropping " << pending_events_->non_uma_events_size()
+               << " structured metrics events";
+  }
+  pending_events_->Clear();
+}
 
 bool RecorderImpl::Record(const EventBase& event) {
   // Do not record if the UMA consent is opted out, except for metrics for the
@@ -168,7 +191,19 @@ bool RecorderImpl::Record(const EventBase& event) {
     }
   }
 
-  return WriteEventsProtoToDir(events_directory_, events_proto);
+  if (!flush_delay_)
+    return WriteEventsProtoToDir(events_directory_, events_proto);
+
+  // The keys were already used above, so a key rotated before the events are
+  // written doesn't change them.
+  pending_events_->add_non_uma_events()->Swap(event_proto);
+  if (pending_events_->non_uma_events_size() >= kMaxPendingEvents) {
+    Flush();
+  } else {
+    // Restart the timer so that the events are written once recording is idle.
+    flush_timer_.Start(FROM_HERE, *flush_delay_, this, &RecorderImpl::Flush);
+  }
+  return true;
 }
 
 }  // namespace structured
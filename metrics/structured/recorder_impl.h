@@ -8,10 +8,12 @@
 #include "metrics/structured/recorder.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <base/files/file_path.h>
 #include <base/time/time.h>
+#include <base/timer/timer.h>
 #include <metrics/structured/key_data.h>
 #include <metrics/metrics_library.h>
 
@@ -34,8 +36,19 @@ class RecorderImpl : public Recorder {
   // Returns false if the event will definitely not be recorded, eg. due to
   // consent. Returns true if the event will likely be reported, though this
   // may fail if, for example, chrome fails to upload the log after collection.
+  // When batching is enabled, the event is written later, and a failure to
+  // write it is only logged.
   bool Record(const EventBase& event) override;
 
+  void Flush() override;
+
+  // Keeps the recorded events in memory instead of writing each of them to its
+  // own file, and writes them together once no event has been recorded for
+  // |flush_delay|, when too many events are pending, on Flush() or on
+  // destruction. Meant for daemons recording events at a high rate; must be
+  // called on a sequence with a task runner, which Record() is then called on.
+  void EnableBatching(base::TimeDelta flush_delay);
+
  private:
   RecorderImpl(const RecorderImpl&) = delete;
   RecorderImpl& operator=(const RecorderImpl&) = delete;
@@ -43,6 +56,12 @@ class RecorderImpl : public Recorder {
   // Where to save event protos.
   const std::string events_directory_;
 
+  // Set if batching is enabled.
+  std::optional<base::TimeDelta> flush_delay_;
+  // The events waiting to be written when batching is enabled.
+  std::unique_ptr<EventsProto> pending_events_;
+  base::OneShotTimer flush_timer_;
+
   // Used for checking the UMA consent.
   MetricsLibrary metrics_library_;
 
@@ -0,0 +1,121 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "metrics/structured/recorder_impl.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <base/files/file_enumerator.h>
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/test/task_environment.h>
+#include <base/time/time.h>
+#include <gtest/gtest.h>
+#include <metrics/structured/proto/storage.pb.h>
+#include <metrics/structured/structured_events.h>
+
+namespace metrics {
+namespace structured {
+namespace {
+
+constexpr base::TimeDelta kFlushDelay = base::Seconds(10);
+
+class RecorderImplTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    events_dir_ = temp_dir_.GetPath().Append("events");
+    ASSERT_TRUE(base::CreateDirectory(events_dir_));
+    recorder_ = std::make_unique<RecorderImpl>(
+        events_dir_.value(), temp_dir_.GetPath().Append("keys").value());
+  }
+
+  // Records an event of a project which doesn't need the UMA consent.
+  bool RecordEvent(int error_code) {
+    return recorder_->Record(events::usb_error::HubError()
+                                 .SetErrorCode(error_code)
+                                 .SetDevicePath("1-1"));
+  }
+
+  // Returns the number of events in each file of the events directory.
+  std::vector<int> GetEventsPerFile() {
+    std::vector<int> events_per_file;
+    base::FileEnumerator enumerator(events_dir_, /*recursive=*/false,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      std::string contents;
+      EventsProto events;
+      EXPECT_TRUE(base::ReadFileToString(path, &contents));
+      EXPECT_TRUE(events.ParseFromString(contents));
+      events_per_file.push_back(events.non_uma_events_size());
+    }
+    return events_per_file;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::ScopedTempDir temp_dir_;
+  base::FilePath events_dir_;
+  std::unique_ptr<RecorderImpl> recorder_;
+};
+
+TEST_F(RecorderImplTest, WritesEachEventWithoutBatching) {
+  EXPECT_TRUE(RecordEvent(1));
+  EXPECT_TRUE(RecordEvent(2));
+  EXPECT_EQ(GetEventsPerFile(), std::vector<int>({1, 1}));
+}
+
+TEST_F(RecorderImplTest, FlushesBatchOnIdle) {
+  recorder_->EnableBatching(kFlushDelay);
+  EXPECT_TRUE(RecordEvent(1));
+  task_environment_.FastForwardBy(kFlushDelay / 2);
+  EXPECT_TRUE(RecordEvent(2));
+  // The delay restarts with each event.
+  task_environment_.FastForwardBy(kFlushDelay / 2);
+  EXPECT_TRUE(GetEventsPerFile().empty());
+
+  task_environment_.FastForwardBy(kFlushDelay / 2);
+  EXPECT_EQ(GetEventsPerFile(), std::vector<int>({2}));
+}
+
+TEST_F(RecorderImplTest, FlushesBatchOnCount) {
+  recorder_->EnableBatching(kFlushDelay);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(RecordEvent(i));
+  }
+  EXPECT_EQ(GetEventsPerFile(), std::vector<int>({100}));
+
+  EXPECT_TRUE(RecordEvent(100));
+  task_environment_.FastForwardBy(kFlushDelay);
+  EXPECT_EQ(GetEventsPerFile().size(), 2u);
+}
+
+TEST_F(RecorderImplTest, FlushesBatchOnDestruction) {
+  recorder_->EnableBatching(kFlushDelay);
+  EXPECT_TRUE(RecordEvent(1));
+  EXPECT_TRUE(RecordEvent(2));
+  EXPECT_TRUE(GetEventsPerFile().empty());
+
+  recorder_.reset();
+  EXPECT_EQ(GetEventsPerFile(), std::vector<int>({2}));
+}
+
+TEST_F(RecorderImplTest, FlushWritesPendingEvents) {
+  recorder_->EnableBatching(kFlushDelay);
+  EXPECT_TRUE(RecordEvent(1));
+  recorder_->Flush();
+  EXPECT_EQ(GetEventsPerFile(), std::vector<int>({1}));
+
+  // Nothing is written when no event is pending.
+  recorder_->Flush();
+  EXPECT_EQ(GetEventsPerFile(), std::vector<int>({1}));
+}
+
+}  // namespace
+}  // namespace structured
+}  // namespace metrics
@@ -17,6 +17,7 @@ constexpr char kKeysPath[] = "/var/lib/metrics/structured/keys";
 }  // namespace
 
 std::unique_ptr<Recorder> RecorderSingleton::recorder_ = nullptr;
+RecorderImpl* RecorderSingleton::default_recorder_ = nullptr;
 
 RecorderSingleton* RecorderSingleton::GetInstance() {
   static base::NoDestructor<RecorderSingleton> recorder_singleton{};
@@ -25,16 +26,27 @@ RecorderSingleton* RecorderSingleton::GetInstance() {
 
 Recorder* RecorderSingleton::GetRecorder() {
   if (!recorder_) {
-    recorder_ = std::make_unique<RecorderImpl>(kEventsPath, kKeysPath);
+    auto recorder = std::make_unique<RecorderImpl>(kEventsPath, kKeysPath);
+    default_recorder_ = recorder.get();
+    recorder_ = std::move(recorder);
   }
   return recorder_.get();
 }
 
+void RecorderSingleton::EnableBatching(base::TimeDelta flush_delay) {
+  GetRecorder();
+  if (default_recorder_) {
+    default_recorder_->EnableBatching(flush_delay);
+  }
+}
+
 void RecorderSingleton::SetRecorderForTest(std::unique_ptr<Recorder> recorder) {
+  default_recorder_ = nullptr;
   recorder_ = std::move(recorder);
 }
 
 void RecorderSingleton::DestroyRecorderForTest() {
+  default_recorder_ = nullptr;
   recorder_ = nullptr;
 }
 
@@ -10,6 +10,7 @@
 #include <memory>
 
 #include <base/no_destructor.h>
+#include <base/time/time.h>
 #include <brillo/brillo_export.h>
 
 namespace metrics {
@@ -31,6 +32,10 @@ class BRILLO_EXPORT RecorderSingleton {
 
   static RecorderSingleton* GetInstance();
   Recorder* GetRecorder();
+  // Makes the recorder returned by GetRecorder() batch the events, see
+  // RecorderImpl::EnableBatching(). Does nothing if a recorder was set for
+  // testing.
+  void EnableBatching(base::TimeDelta flush_delay);
   void SetRecorderForTest(std::unique_ptr<Recorder> recorder);
   void DestroyRecorderForTest();
 
@@ -38,6 +43,8 @@ class BRILLO_EXPORT RecorderSingleton {
   friend class base::NoDestructor<RecorderSingleton>;
 
   static std::unique_ptr<Recorder> recorder_;
+  // Set while |recorder_| is the default RecorderImpl.
+  static RecorderImpl* default_recorder_;
 };
 
 }  // namespace structured
@@ -4,6 +4,9 @@
 
 #include "midis/subdevice_client_fd_holder.h"
 
+#include <sys/socket.h>
+#include <sys/uio.h>
+
 #include <memory>
 #include <utility>
 #include <vector>
@@ -46,15 +49,39 @@ std::unique_ptr<SubDeviceClientFdHolder> SubDeviceClientFdHolder::Create(
 void SubDeviceClientFdHolder::WriteDeviceDataToClient(const void* buffer,
                                                       size_t buf_len) {
   queue_->Add(reinterpret_cast<const uint8_t*>(buffer), buf_len);
+  std::vector<std::vector<uint8_t>> messages;
   std::vector<uint8_t> message;
   queue_->Get(&message);
   while (!message.empty()) {
-    ssize_t ret =
-        HANDLE_EINTR(write(GetRawFd(), message.data(), message.size()));
-    if (ret != static_cast<ssize_t>(message.size())) {
+    messages.push_back(std::move(message));
+    queue_->Get(&message);
+  }
+  if (messages.empty()) {
+    return;
+  }
+
+  // The client reads one MIDI message per packet, so keep the messages in
+  // separate packets but hand them all to the kernel in a single call.
+  std::vector<iovec> iovs(messages.size());
+  std::vector<mmsghdr> msgs(messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    iovs[i].iov_base = messages[i].data();
+    iovs[i].iov_len = messages[i].size();
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  size_t sent = 0;
+  while (sent < msgs.size()) {
+    int ret = HANDLE_EINTR(
+        sendmmsg(GetRawFd(), msgs.data() + sent, msgs.size() - sent, 0));
+    if (ret <= 0) {
+      // sendmmsg() only fails if the first message can't be sent. Drop that
+      // one and still try the following ones.
       PLOG(ERROR) << "Error writing to client fd.";
+      ret = 1;
     }
-    queue_->Get(&message);
+    sent += ret;
   }
 }
 
@@ -39,9 +39,11 @@ class SubDeviceClientFdHolder {
   int GetRawFd() { return fd_.get(); }
   uint32_t GetClientId() const { return client_id_; }
   // This function is used to write data *to* the client when it is received
-  // from a MIDI h/w device. NOTE: A failure in this write shouldn't result in
-  // the deletion of a client. A faulty / crashed / deleted client will be
-  // handled from the Client handling code via TriggerClientDeletion().
+  // from a MIDI h/w device. Each complete MIDI message in |buffer| is sent as
+  // a separate packet, but all of them are sent with a single syscall.
+  // NOTE: A failure in this write shouldn't result in the deletion of a
+  // client. A faulty / crashed / deleted client will be handled from the
+  // Client handling code via TriggerClientDeletion().
   void WriteDeviceDataToClient(const void* buffer, size_t buf_len);
 
  private:
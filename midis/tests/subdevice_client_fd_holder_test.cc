@@ -0,0 +1,85 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "midis/subdevice_client_fd_holder.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <base/files/scoped_file.h>
+#include <base/functional/callback_helpers.h>
+#include <base/posix/eintr_wrapper.h>
+#include <brillo/message_loops/base_message_loop.h>
+#include <gtest/gtest.h>
+
+namespace midis {
+
+class SubDeviceClientFdHolderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    message_loop_.SetAsCurrent();
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    client_fd_.reset(fds[1]);
+    holder_ = SubDeviceClientFdHolder::Create(
+        1 /* client_id */, 0 /* subdevice_id */, base::ScopedFD(fds[0]),
+        base::DoNothing());
+    ASSERT_TRUE(holder_);
+  }
+
+  // Reads one packet from the client end of the socket.
+  std::vector<uint8_t> ReadPacket() {
+    uint8_t buf[64];
+    ssize_t ret =
+        HANDLE_EINTR(recv(client_fd_.get(), buf, sizeof(buf), MSG_DONTWAIT));
+    if (ret < 0) {
+      return {};
+    }
+    return std::vector<uint8_t>(buf, buf + ret);
+  }
+
+  brillo::BaseMessageLoop message_loop_;
+  base::ScopedFD client_fd_;
+  std::unique_ptr<SubDeviceClientFdHolder> holder_;
+};
+
+// Check that several MIDI messages received at once reach the client as one
+// packet each, and that an incomplete message is held back until the rest of
+// it arrives.
+TEST_F(SubDeviceClientFdHolderTest, OnePacketPerMessage) {
+  const uint8_t kData[] = {0x90, 0x3c, 0x40, 0x80, 0x3c, 0x00, 0xb0, 0x07};
+  holder_->WriteDeviceDataToClient(kData, sizeof(kData));
+
+  EXPECT_EQ(ReadPacket(), std::vector<uint8_t>({0x90, 0x3c, 0x40}));
+  EXPECT_EQ(ReadPacket(), std::vector<uint8_t>({0x80, 0x3c, 0x00}));
+  EXPECT_TRUE(ReadPacket().empty());
+
+  const uint8_t kRest[] = {0x7f};
+  holder_->WriteDeviceDataToClient(kRest, sizeof(kRest));
+  EXPECT_EQ(ReadPacket(), std::vector<uint8_t>({0xb0, 0x07, 0x7f}));
+  EXPECT_TRUE(ReadPacket().empty());
+}
+
+// Check that a message which can't be sent doesn't drop the following ones.
+TEST_F(SubDeviceClientFdHolderTest, SendsMessagesAfterFailedOne) {
+  // A SysEx message larger than the send buffer fails with EMSGSIZE.
+  const int kSendBufferSize = 4096;
+  ASSERT_EQ(setsockopt(holder_->GetRawFd(), SOL_SOCKET, SO_SNDBUF,
+                       &kSendBufferSize, sizeof(kSendBufferSize)),
+            0);
+  std::vector<uint8_t> data = {0x90, 0x3c, 0x40, 0xf0};
+  data.insert(data.end(), 4 * kSendBufferSize, 0x01);
+  data.insert(data.end(), {0xf7, 0x80, 0x3c, 0x00});
+  holder_->WriteDeviceDataToClient(data.data(), data.size());
+
+  EXPECT_EQ(ReadPacket(), std::vector<uint8_t>({0x90, 0x3c, 0x40}));
+  EXPECT_EQ(ReadPacket(), std::vector<uint8_t>({0x80, 0x3c, 0x00}));
+  EXPECT_TRUE(ReadPacket().empty());
+}
+
+}  // namespace midis
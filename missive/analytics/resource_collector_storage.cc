@@ -5,6 +5,8 @@
 #include "missive/analytics/resource_collector_storage.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <string_view>
 
@@ -25,11 +27,13 @@ ResourceCollectorStorage::~ResourceCollectorStorage() {
   StopTimer();
 }
 
-int ResourceCollectorStorage::ConvertBytesToMibs(int bytes) {
+int ResourceCollectorStorage::ConvertBytesToMibs(int64_t bytes) {
   // Round the result to the nearest MiB.
   // As a special circumstance, if the rounded size in MiB is zero, then we give
   // it 1.
-  return std::max((bytes + 1024 * 1024 / 2) / (1024 * 1024), 1);
+  const int64_t mibs = (bytes + 1024 * 1024 / 2) / (1024 * 1024);
+  return static_cast<int>(
+      std::clamp<int64_t>(mibs, 1, std::numeric_limits<int>::max()));
 }
 
 void ResourceCollectorStorage::Collect() {
@@ -49,8 +53,8 @@ void ResourceCollectorStorage::Collect() {
   }
 }
 
-bool ResourceCollectorStorage::SendDirectorySizeToUma(std::string_view uma_name,
-                                                      int directory_size) {
+bool ResourceCollectorStorage::SendDirectorySizeToUma(
+    std::string_view uma_name, int64_t directory_size) {
   return Metrics::SendToUMA(
       /*name=*/std::string(uma_name),
       /*sample=*/ConvertBytesToMibs(directory_size),
@@ -8,6 +8,7 @@
 #include "missive/analytics/resource_collector.h"
 
 #include <atomic>
+#include <cstdint>
 #include <string_view>
 
 #include <base/files/file_path.h>
@@ -37,6 +38,7 @@ class ResourceCollectorStorage : public ResourceCollector {
   friend class ::reporting::MissiveImplTest;
   friend class ResourceCollectorStorageTest;
   FRIEND_TEST(ResourceCollectorStorageTest, SuccessfullySend);
+  FRIEND_TEST(ResourceCollectorStorageConversionTest, ConvertLargeSizes);
 
   // UMA names
   static constexpr char kUmaName[] = "Platform.Missive.StorageUsage";
@@ -51,8 +53,9 @@ class ResourceCollectorStorage : public ResourceCollector {
   // default in Chrome (50).
   static constexpr int kUmaNumberOfBuckets = 50;
 
-  // Convert bytes into MiBs.
-  static int ConvertBytesToMibs(int bytes);
+  // Convert bytes into MiBs. Takes a 64-bit size so that an over-used storage
+  // directory (2 GiB or more) is still reported in the overflow bucket.
+  static int ConvertBytesToMibs(int64_t bytes);
 
   // Collect storage usage. This is not obtained from the memory resource
   // management in Missive. Rather, the storage directory is scanned once for
@@ -61,7 +64,8 @@ class ResourceCollectorStorage : public ResourceCollector {
   void Collect() override;
 
   // Send directory size data to UMA.
-  bool SendDirectorySizeToUma(std::string_view uma_name, int directory_size);
+  bool SendDirectorySizeToUma(std::string_view uma_name,
+                              int64_t directory_size);
 
   // The directory in which record files are saved.
   const base::FilePath storage_directory_;
@@ -120,6 +120,15 @@ TEST_P(ResourceCollectorStorageTest, SuccessfullySend) {
   }
 }
 
+TEST(ResourceCollectorStorageConversionTest, ConvertLargeSizes) {
+  constexpr int64_t kMib = 1024 * 1024;
+  EXPECT_EQ(ResourceCollectorStorage::ConvertBytesToMibs(0), 1);
+  EXPECT_EQ(ResourceCollectorStorage::ConvertBytesToMibs(kMib * 3 / 2), 2);
+  // Sizes that do not fit into an int must not wrap around.
+  EXPECT_EQ(ResourceCollectorStorage::ConvertBytesToMibs(kMib * 3 * 1024),
+            3 * 1024);
+}
+
 // Each element in the array represent the size of one file.
 INSTANTIATE_TEST_SUITE_P(
     VaryingStorageFiles,
@@ -32,6 +32,7 @@
 #include "missive/proto/health.pb.h"
 #include "missive/proto/interface.pb.h"
 #include "missive/proto/record.pb.h"
+#include "missive/proto/record_constants.pb.h"
 #include "missive/scheduler/enqueue_job.h"
 #include "missive/scheduler/scheduler.h"
 #include "missive/scheduler/upload_job.h"
@@ -301,6 +302,7 @@ void MissiveImpl::OnStorageModuleConfigured(
 // static
 void MissiveImpl::AsyncStartUpload(
     base::WeakPtr<MissiveImpl> missive,
+    std::optional<Priority> priority,
     UploaderInterface::UploadReason reason,
     UploaderInterface::UploaderInterfaceResultCb uploader_result_cb) {
   if (!missive) {
@@ -308,10 +310,12 @@ void MissiveImpl::AsyncStartUpload(
         .Run(Status(error::UNAVAILABLE, "Missive service has been shut down"));
     return;
   }
-  missive->AsyncStartUploadInternal(reason, std::move(uploader_result_cb));
+  missive->AsyncStartUploadInternal(priority, reason,
+                                    std::move(uploader_result_cb));
 }
 
 void MissiveImpl::AsyncStartUploadInternal(
+    std::optional<Priority> priority,
     UploaderInterface::UploadReason reason,
     UploaderInterface::UploaderInterfaceResultCb uploader_result_cb) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -333,6 +337,7 @@ void MissiveImpl::AsyncStartUploadInternal(
     health_module_->GetHealthData(
         base::BindPostTaskToCurrentDefault(base::BindOnce(
             [](base::WeakPtr<MissiveImpl> missive,
+               std::optional<Priority> priority,
                UploaderInterface::UploadReason reason,
                UploaderInterface::UploaderInterfaceResultCb uploader_result_cb,
                ERPHealthData health_data) {
@@ -342,24 +347,25 @@ void MissiveImpl::AsyncStartUploadInternal(
                                 "Missive service has been shut down"));
                 return;
               }
-              missive->CreateUploadJob(std::move(health_data), reason,
-                                       std::move(uploader_result_cb));
+              missive->CreateUploadJob(priority, std::move(health_data),
+                                       reason, std::move(uploader_result_cb));
             },
-            weak_ptr_factory_.GetWeakPtr(), reason,
+            weak_ptr_factory_.GetWeakPtr(), priority, reason,
             std::move(uploader_result_cb))));
   } else {
-    CreateUploadJob(/*health_data=*/std::nullopt, reason,
+    CreateUploadJob(priority, /*health_data=*/std::nullopt, reason,
                     std::move(uploader_result_cb));
   }
 }
 
 void MissiveImpl::CreateUploadJob(
+    std::optional<Priority> priority,
     std::optional<ERPHealthData> health_data,
     UploaderInterface::UploadReason reason,
     UploaderInterface::UploaderInterfaceResultCb uploader_result_cb) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   auto upload_job_result = UploadJob::Create(
-      upload_client_,
+      upload_client_, priority,
       /*need_encryption_key=*/
       (encryption_module_->is_enabled() &&
        reason == UploaderInterface::UploadReason::KEY_DELIVERY),
@@ -6,6 +6,7 @@
 #define MISSIVE_MISSIVE_MISSIVE_IMPL_H_
 
 #include <memory>
+#include <optional>
 
 #include <base/files/file_path.h>
 #include <base/functional/callback_forward.h>
@@ -26,6 +27,7 @@
 #include "missive/missive/missive_args.h"
 #include "missive/missive/missive_service.h"
 #include "missive/proto/interface.pb.h"
+#include "missive/proto/record_constants.pb.h"
 #include "missive/resources/enqueuing_record_tallier.h"
 #include "missive/resources/resource_manager.h"
 #include "missive/scheduler/scheduler.h"
@@ -80,6 +82,7 @@ class MissiveImpl : public MissiveService {
 
   static void AsyncStartUpload(
       base::WeakPtr<MissiveImpl> missive,
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb uploader_result_cb);
 
@@ -146,10 +149,12 @@ class MissiveImpl : public MissiveService {
       StatusOr<scoped_refptr<StorageModule>> storage_module_result);
 
   void AsyncStartUploadInternal(
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb uploader_result_cb);
 
   void CreateUploadJob(
+      std::optional<Priority> priority,
       std::optional<ERPHealthData> health_data,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb uploader_result_cb);
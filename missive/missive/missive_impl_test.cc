@@ -202,8 +202,8 @@ class MissiveImplTest : public ::testing::Test {
 TEST_F(MissiveImplTest, AsyncStartUploadTest) {
   test::TestEvent<StatusOr<std::unique_ptr<UploaderInterface>>> uploader_event;
   MissiveImpl::AsyncStartUpload(
-      missive_->GetWeakPtr(), UploaderInterface::UploadReason::IMMEDIATE_FLUSH,
-      uploader_event.cb());
+      missive_->GetWeakPtr(), IMMEDIATE,
+      UploaderInterface::UploadReason::IMMEDIATE_FLUSH, uploader_event.cb());
   auto response_result = uploader_event.result();
   EXPECT_OK(response_result) << response_result.status();
   response_result.ValueOrDie()->Completed(
@@ -215,7 +215,7 @@ TEST_F(MissiveImplTest, AsyncNoStartUploadTest) {
   auto weak_ptr = missive_->GetWeakPtr();
   missive_.reset();
   MissiveImpl::AsyncStartUpload(
-      weak_ptr, UploaderInterface::UploadReason::IMMEDIATE_FLUSH,
+      weak_ptr, IMMEDIATE, UploaderInterface::UploadReason::IMMEDIATE_FLUSH,
       uploader_event.cb());
   auto response_result = uploader_event.result();
   EXPECT_THAT(response_result,
@@ -436,7 +436,7 @@ TEST_F(MissiveImplTest, DisabledReportingTest) {
     test::TestEvent<StatusOr<std::unique_ptr<UploaderInterface>>>
         uploader_event;
     MissiveImpl::AsyncStartUpload(
-        missive_->GetWeakPtr(),
+        missive_->GetWeakPtr(), IMMEDIATE,
         UploaderInterface::UploadReason::IMMEDIATE_FLUSH, uploader_event.cb());
     const auto& response_result = uploader_event.result();
     EXPECT_THAT(response_result,
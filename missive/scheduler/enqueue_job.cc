@@ -5,6 +5,7 @@
 #include "missive/scheduler/enqueue_job.h"
 
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include <base/strings/strcat.h>
@@ -75,6 +76,13 @@ EnqueueJob::EnqueueJob(
       health_module_(health_module),
       request_(std::move(request)) {}
 
+std::optional<Priority> EnqueueJob::priority() const {
+  if (!request_.has_priority()) {
+    return std::nullopt;
+  }
+  return request_.priority();
+}
+
 void EnqueueJob::StartImpl() {
   health_module_->set_debugging(request_.health_data_logging_enabled());
   storage_module_->AddRecord(
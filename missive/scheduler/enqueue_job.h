@@ -6,6 +6,7 @@
 #define MISSIVE_SCHEDULER_ENQUEUE_JOB_H_
 
 #include <memory>
+#include <optional>
 
 #include <base/memory/weak_ptr.h>
 #include <brillo/dbus/dbus_method_response.h>
@@ -53,6 +54,9 @@ class EnqueueJob : public Scheduler::Job {
       EnqueueRecordRequest request,
       std::unique_ptr<EnqueueResponseDelegate> delegate);
 
+  // Returns the priority of the record to be enqueued.
+  std::optional<Priority> priority() const override;
+
  protected:
   // EnqueueJob::StartImpl expects EnqueueRecordRequest to include a valid file
   // descriptor and the pid of the owner. Permissions of the file descriptor
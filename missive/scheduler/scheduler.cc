@@ -5,16 +5,23 @@
 #include "missive/scheduler/scheduler.h"
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include <base/check.h>
 #include <base/functional/bind.h>
 #include <base/logging.h>
 #include <base/sequence_checker.h>
+#include <base/strings/strcat.h>
 #include <base/task/sequenced_task_runner.h>
 #include <base/task/task_traits.h>
 #include <base/task/thread_pool.h>
+#include <base/time/time.h>
 
+#include "missive/analytics/metrics.h"
+#include "missive/proto/priority_name.h"
+#include "missive/proto/record_constants.pb.h"
 #include "missive/util/status.h"
 #include "missive/util/statusor.h"
 #include "missive/util/task_runner_context.h"
@@ -28,6 +35,13 @@ enum TaskLimit {
   OFF = 0,
 };
 
+// Maximum number of concurrently running jobs of the same priority.
+constexpr size_t kPerPriorityTaskLimit = 3u;
+
+// Queueing delay UMA parameters.
+constexpr base::TimeDelta kQueueingDelayUmaMax = base::Minutes(10);
+constexpr int kQueueingDelayUmaBuckets = 50;
+
 }  // namespace
 
 using CompleteJobResponse = Status;
@@ -95,6 +109,10 @@ Scheduler::Job::JobState Scheduler::Job::GetJobState() const {
   return job_state_;
 }
 
+std::optional<Priority> Scheduler::Job::priority() const {
+  return std::nullopt;
+}
+
 void Scheduler::Job::Finish(Status status) {
   CheckValidSequence();
 
@@ -263,7 +281,11 @@ void Scheduler::EnqueueJob(Job::SmartPtr<Job> job) {
                          }
                          return;
                        }
-                       scheduler->jobs_queue_.push(std::move(job));
+                       const std::optional<Priority> priority =
+                           job->priority();
+                       scheduler->jobs_queues_[priority].push(
+                           {.job = std::move(job),
+                            .enqueue_time = base::TimeTicks::Now()});
                        scheduler->NotifyObservers(Notification::ACCEPTED_JOB);
                        scheduler->StartJobs();
                      },
@@ -274,18 +296,22 @@ void Scheduler::StartJobs() {
   CHECK(base::SequencedTaskRunner::HasCurrentDefault());
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  if (jobs_queue_.empty()) {
+  if (jobs_queues_.empty()) {
     return;
   }
   // Get JobBlockers and assign them to jobs until job_semaphore_ returns a
-  // non-OK status.
+  // non-OK status, or all queued jobs are at their priority limit.
   StatusOr<std::unique_ptr<JobBlocker>> blocker_result =
       job_semaphore_->AcquireJobBlocker();
   while (blocker_result.ok()) {
+    auto next_job = PopNextJob();
+    if (!next_job.has_value()) {
+      // The unused blocker is released upon destruction.
+      break;
+    }
     RunJob(std::move(blocker_result.ValueOrDie()),
-           std::move(jobs_queue_.front()));
-    jobs_queue_.pop();
-    if (jobs_queue_.empty()) {
+           std::move(next_job.value()));
+    if (jobs_queues_.empty()) {
       return;
     }
     blocker_result = job_semaphore_->AcquireJobBlocker();
@@ -294,29 +320,85 @@ void Scheduler::StartJobs() {
   NotifyObservers(Notification::BLOCKED_JOB);
 }
 
-void Scheduler::MaybeStartNextJob(std::unique_ptr<JobBlocker> job_blocker) {
+void Scheduler::MaybeStartNextJob(
+    std::optional<Priority> finished_job_priority,
+    std::unique_ptr<JobBlocker> job_blocker) {
   CHECK(base::SequencedTaskRunner::HasCurrentDefault());
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  if (jobs_queue_.empty()) {
+  if (finished_job_priority.has_value()) {
+    auto it = running_jobs_per_priority_.find(finished_job_priority.value());
+    CHECK(it != running_jobs_per_priority_.end());
+    CHECK_GT(it->second, 0u);
+    if (--(it->second) == 0u) {
+      running_jobs_per_priority_.erase(it);
+    }
+  }
+
+  if (jobs_queues_.empty()) {
     return;
   }
   if (job_semaphore_->IsUnderTaskLimit()) {
-    RunJob(std::move(job_blocker), std::move(jobs_queue_.front()));
-    jobs_queue_.pop();
-    if (jobs_queue_.empty()) {
-      return;  // Last job unblocked.
+    auto next_job = PopNextJob();
+    if (next_job.has_value()) {
+      RunJob(std::move(job_blocker), std::move(next_job.value()));
+      if (jobs_queues_.empty()) {
+        return;  // Last job unblocked.
+      }
     }
   }
   // Some jobs remain blocked.
   NotifyObservers(Notification::BLOCKED_JOB);
 }
 
+std::optional<Scheduler::QueuedJob> Scheduler::PopNextJob() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto next_it = jobs_queues_.end();
+  for (auto it = jobs_queues_.begin(); it != jobs_queues_.end(); ++it) {
+    CHECK(!it->second.empty());
+    const std::optional<Priority>& priority = it->first;
+    if (priority.has_value()) {
+      const auto running_it = running_jobs_per_priority_.find(priority.value());
+      if (running_it != running_jobs_per_priority_.end() &&
+          running_it->second >= kPerPriorityTaskLimit) {
+        continue;  // Priority is at its limit.
+      }
+    }
+    if (next_it == jobs_queues_.end() ||
+        it->second.front().enqueue_time <
+            next_it->second.front().enqueue_time) {
+      next_it = it;
+    }
+  }
+  if (next_it == jobs_queues_.end()) {
+    return std::nullopt;
+  }
+  if (next_it->first.has_value()) {
+    ++running_jobs_per_priority_[next_it->first.value()];
+  }
+  QueuedJob queued_job = std::move(next_it->second.front());
+  next_it->second.pop();
+  if (next_it->second.empty()) {
+    jobs_queues_.erase(next_it);
+  }
+  return queued_job;
+}
+
 void Scheduler::RunJob(std::unique_ptr<JobBlocker> job_blocker,
-                       Job::SmartPtr<Job> job) {
+                       QueuedJob queued_job) {
   CHECK(base::SequencedTaskRunner::HasCurrentDefault());
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   CHECK(job_blocker);
+  const std::optional<Priority> priority = queued_job.job->priority();
+  const base::TimeDelta queueing_delay =
+      base::TimeTicks::Now() - queued_job.enqueue_time;
+  analytics::Metrics::SendToUMA(
+      base::StrCat({kQueueingDelayUmaPrefix,
+                    priority.has_value()
+                        ? Priority_Name_Substitute(priority.value())
+                        : "NoPriority"}),
+      queueing_delay.InMilliseconds(), /*min=*/1,
+      kQueueingDelayUmaMax.InMilliseconds(), kQueueingDelayUmaBuckets);
   auto completion_cb = base::BindOnce(
       [](scoped_refptr<base::SequencedTaskRunner> sequenced_task_runner,
          base::OnceCallback<void()> start_next_job_cb,
@@ -336,28 +418,31 @@ void Scheduler::RunJob(std::unique_ptr<JobBlocker> job_blocker,
       },
       sequenced_task_runner_,
       base::BindOnce(
-          &Scheduler::MaybeStartNextJob, base::Unretained(this),
+          &Scheduler::MaybeStartNextJob, base::Unretained(this), priority,
           std::move(job_blocker)),  // Hold at least until the job completes.
       base::BindOnce(&Scheduler::NotifyObservers, base::Unretained(this)));
 
-  Start<JobContext>(std::move(job), std::move(completion_cb),
+  Start<JobContext>(std::move(queued_job.job), std::move(completion_cb),
                     sequenced_task_runner_);
   NotifyObservers(Notification::STARTED_JOB);
 }
 
 void Scheduler::ClearQueue() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  while (!jobs_queue_.empty()) {
-    auto& job = jobs_queue_.front();
-    const Status cancel_status =
-        job->Cancel(Status(error::RESOURCE_EXHAUSTED,
-                           "Unable to process due to low system memory"));
-    if (!cancel_status.ok()) {
-      LOG(ERROR) << "Was unable to successfully cancel a job: "
-                 << cancel_status;
+  for (auto& [priority, jobs_queue] : jobs_queues_) {
+    while (!jobs_queue.empty()) {
+      auto& job = jobs_queue.front().job;
+      const Status cancel_status =
+          job->Cancel(Status(error::RESOURCE_EXHAUSTED,
+                             "Unable to process due to low system memory"));
+      if (!cancel_status.ok()) {
+        LOG(ERROR) << "Was unable to successfully cancel a job: "
+                   << cancel_status;
+      }
+      jobs_queue.pop();
     }
-    jobs_queue_.pop();
   }
+  jobs_queues_.clear();
 }
 
 #ifdef MEMORY_PRESSURE_LEVEL_ENABLED
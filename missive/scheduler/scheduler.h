@@ -5,13 +5,17 @@
 #ifndef MISSIVE_SCHEDULER_SCHEDULER_H_
 #define MISSIVE_SCHEDULER_SCHEDULER_H_
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <vector>
 
 #include <base/sequence_checker.h>
 #include <base/task/sequenced_task_runner.h>
+#include <base/time/time.h>
 
+#include "missive/proto/record_constants.pb.h"
 #include "missive/util/status.h"
 
 namespace reporting {
@@ -23,8 +27,12 @@ namespace reporting {
 // 2. REDUCED: In reduced mode Scheduler will schedule up to 2 concurrent jobs,
 //    although any currently running jobs are allowed to finish.
 // 3. OFF: In this mode Scheduler will enqueue no new jobs, all currently
-//    running jobs are allowed to finish. Jobs in the |jobs_queue_| will be
+//    running jobs are allowed to finish. Jobs in the |jobs_queues_| will be
 //    cancelled.
+// Jobs that have a priority are additionally limited per priority, so that
+// jobs of a slow priority cannot occupy all slots and delay other priorities;
+// jobs that reached their priority limit are bypassed by the jobs queued after
+// them. Otherwise jobs are started in the order they were enqueued.
 class Scheduler {
  public:
   // A Job is a unit of work with a common interface. |StartImpl| needs to be
@@ -90,6 +98,10 @@ class Scheduler {
     // Returns the |job_state_| at the time of calling.
     JobState GetJobState() const;
 
+    // Returns the priority the job works on behalf of, if any. Jobs without
+    // priority are only subject to the overall task limit.
+    virtual std::optional<Priority> priority() const;
+
    protected:
     // Constructor to be used by subcalss constructors only.
     Job(std::unique_ptr<JobDelegate> job_response_delegate,
@@ -158,14 +170,19 @@ class Scheduler {
     virtual void Notify(Notification notification) = 0;
   };
 
+  // UMA name prefix of the time jobs spend in the queue before starting,
+  // followed by the job priority name.
+  static constexpr char kQueueingDelayUmaPrefix[] =
+      "Platform.Missive.SchedulerQueueingDelay.";
+
   Scheduler();
   ~Scheduler();
 
   void AddObserver(SchedulerObserver* observer);
   void NotifyObservers(SchedulerObserver::Notification notification);
 
-  // EnqueueJob will store the job in the |job_queue_|, and it will be executed
-  // as long as system memory remains above CRITICAL.
+  // EnqueueJob will store the job in the |jobs_queues_|, and it will be
+  // executed as long as system memory remains above CRITICAL.
   void EnqueueJob(Job::SmartPtr<Job> job);
 
  private:
@@ -173,10 +190,20 @@ class Scheduler {
   class JobBlocker;
   class JobSemaphore;
 
+  // Job waiting in |jobs_queues_|.
+  struct QueuedJob {
+    Job::SmartPtr<Job> job;
+    base::TimeTicks enqueue_time;
+  };
+
   void StartJobs();
-  void MaybeStartNextJob(std::unique_ptr<JobBlocker> job_blocker);
-  void RunJob(std::unique_ptr<JobBlocker> job_blocker,
-              Job::SmartPtr<Job> job_result);
+  void MaybeStartNextJob(std::optional<Priority> finished_job_priority,
+                         std::unique_ptr<JobBlocker> job_blocker);
+  void RunJob(std::unique_ptr<JobBlocker> job_blocker, QueuedJob queued_job);
+
+  // Removes and returns the earliest enqueued job that can start without
+  // exceeding its priority limit, if any.
+  std::optional<QueuedJob> PopNextJob();
 
   void ClearQueue();
 
@@ -193,7 +220,13 @@ class Scheduler {
   SEQUENCE_CHECKER(sequence_checker_);
 
   std::unique_ptr<JobSemaphore> job_semaphore_;
-  std::queue<Job::SmartPtr<Job>> jobs_queue_;
+
+  // Queues of the jobs by priority (jobs without priority are queued under
+  // std::nullopt). Empty queues are removed.
+  std::map<std::optional<Priority>, std::queue<QueuedJob>> jobs_queues_;
+
+  // Numbers of running jobs by priority.
+  std::map<Priority, size_t> running_jobs_per_priority_;
 
   std::vector<SchedulerObserver*> observers_;
 };
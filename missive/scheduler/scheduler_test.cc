@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include <base/check_op.h>
@@ -17,6 +18,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "missive/analytics/metrics.h"
+#include "missive/analytics/metrics_test_util.h"
+#include "missive/proto/record_constants.pb.h"
 #include "missive/scheduler/scheduler.h"
 #include "missive/util/test_support_callbacks.h"
 
@@ -69,6 +73,14 @@ class FakeJob : public Scheduler::Job {
     finish_status_ = status;
   }
 
+  void SetPriority(Priority priority) {
+    CHECK_EQ(GetJobState(), JobState::NOT_RUNNING)
+        << "Called after the job started";
+    priority_ = priority;
+  }
+
+  std::optional<Priority> priority() const override { return priority_; }
+
  protected:
   void StartImpl() override {
     // Pause for 1 sec, to make sure only 5 FakeJobs can launch right away,
@@ -88,6 +100,7 @@ class FakeJob : public Scheduler::Job {
       : Job(std::move(fake_job_delegate), sequenced_task_runner) {}
 
   Status finish_status_{Status::StatusOK()};
+  std::optional<Priority> priority_;
 
   base::WeakPtrFactory<FakeJob> weak_ptr_factory_{this};
 };
@@ -256,6 +269,7 @@ class SchedulerTest : public ::testing::Test {
  protected:
   base::test::TaskEnvironment task_environment_{
       base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  analytics::Metrics::TestEnvironment metrics_test_environment_;
   Scheduler scheduler_;
   TestSchedulerObserver scheduler_observer_;
 };
@@ -343,6 +357,66 @@ TEST_F(SchedulerTest, SchedulesAndRunsJobs) {
   EXPECT_THAT(cancel_counter, Eq(kNumJobs / 2u));
 }
 
+TEST_F(SchedulerTest, SlowPriorityDoesNotBlockOtherPriorities) {
+  constexpr size_t kNumSecurityJobs = 6u;
+
+  std::atomic<size_t> security_completion_counter{0};
+  std::atomic<size_t> immediate_completion_counter{0};
+  {
+    test::TestCallbackAutoWaiter complete_waiter;
+    complete_waiter.Attach(kNumSecurityJobs + 1u);
+    const auto cancel_callback = base::BindRepeating(
+        [](test::TestCallbackWaiter* waiter, Status status) {
+          waiter->Signal();
+          return Status(error::INTERNAL, "Unexpected cancel");
+        },
+        &complete_waiter);
+    const auto make_completion_callback =
+        [&complete_waiter](std::atomic<size_t>* counter) {
+          return base::BindRepeating(
+              [](std::atomic<size_t>* counter,
+                 test::TestCallbackWaiter* waiter) {
+                *counter += 1;
+                waiter->Signal();
+                return Status::StatusOK();
+              },
+              counter, &complete_waiter);
+        };
+
+    // Saturate the SECURITY priority first, then enqueue IMMEDIATE job.
+    for (size_t i = 0; i < kNumSecurityJobs; ++i) {
+      auto job = FakeJob::Create(std::make_unique<FakeJob::FakeJobDelegate>(
+          make_completion_callback(&security_completion_counter),
+          cancel_callback));
+      job->SetPriority(SECURITY);
+      scheduler_.EnqueueJob(std::move(job));
+    }
+    auto immediate_job =
+        FakeJob::Create(std::make_unique<FakeJob::FakeJobDelegate>(
+            make_completion_callback(&immediate_completion_counter),
+            cancel_callback));
+    immediate_job->SetPriority(IMMEDIATE);
+    scheduler_.EnqueueJob(std::move(immediate_job));
+
+    // After the first second IMMEDIATE job is done, along with the first
+    // SECURITY jobs up to the per-priority limit (even though the overall
+    // limit would allow more of them).
+    task_environment_.FastForwardBy(base::Seconds(1));
+    task_environment_.RunUntilIdle();
+    EXPECT_THAT(immediate_completion_counter, Eq(1u));
+    EXPECT_THAT(security_completion_counter, Eq(3u));
+
+    // The rest of SECURITY jobs finish afterwards.
+    complete_waiter.Signal();
+    task_environment_.FastForwardBy(base::Seconds(1));
+  }
+  task_environment_.RunUntilIdle();
+
+  EXPECT_THAT(security_completion_counter, Eq(kNumSecurityJobs));
+  EXPECT_THAT(immediate_completion_counter, Eq(1u));
+  EXPECT_THAT(scheduler_observer_.started_jobs_, Eq(kNumSecurityJobs + 1u));
+}
+
 // TODO(b/193577465): Add test for Scheduler being destructed before all jobs
 // have been run. This might require changes in Scheduler itself.
 
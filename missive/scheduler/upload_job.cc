@@ -23,6 +23,7 @@
 #include "missive/dbus/upload_client.h"
 #include "missive/proto/health.pb.h"
 #include "missive/proto/record.pb.h"
+#include "missive/proto/record_constants.pb.h"
 #include "missive/resources/resource_manager.h"
 #include "missive/scheduler/scheduler.h"
 #include "missive/storage/storage_uploader_interface.h"
@@ -132,6 +133,7 @@ void UploadJob::RecordProcessor::Completed(Status final_status) {
 // static
 StatusOr<Scheduler::Job::SmartPtr<UploadJob>> UploadJob::Create(
     scoped_refptr<UploadClient> upload_client,
+    std::optional<Priority> priority,
     bool need_encryption_key,
     std::optional<ERPHealthData> health_data,
     uint64_t remaining_storage_capacity,
@@ -155,10 +157,15 @@ StatusOr<Scheduler::Job::SmartPtr<UploadJob>> UploadJob::Create(
           {base::TaskPriority::BEST_EFFORT, base::MayBlock()});
   return std::unique_ptr<UploadJob, base::OnTaskRunnerDeleter>(
       new UploadJob(std::move(upload_delegate), sequenced_task_runner,
-                    std::move(set_records_callback), std::move(start_cb)),
+                    priority, std::move(set_records_callback),
+                    std::move(start_cb)),
       base::OnTaskRunnerDeleter(sequenced_task_runner));
 }
 
+std::optional<Priority> UploadJob::priority() const {
+  return priority_;
+}
+
 void UploadJob::StartImpl() {
   std::move(start_cb_).Run(std::make_unique<RecordProcessor>(base::BindPostTask(
       sequenced_task_runner(),
@@ -179,9 +186,11 @@ void UploadJob::Done(StatusOr<EncryptedRecords> records_result,
 UploadJob::UploadJob(
     std::unique_ptr<UploadDelegate> upload_delegate,
     scoped_refptr<base::SequencedTaskRunner> sequenced_task_runner,
+    std::optional<Priority> priority,
     SetRecordsCb set_records_cb,
     UploaderInterface::UploaderInterfaceResultCb start_cb)
     : Job(std::move(upload_delegate), sequenced_task_runner),
+      priority_(priority),
       set_records_cb_(std::move(set_records_cb)),
       start_cb_(std::move(start_cb)) {}
 
@@ -16,6 +16,7 @@
 
 #include "missive/dbus/upload_client.h"
 #include "missive/proto/record.pb.h"
+#include "missive/proto/record_constants.pb.h"
 #include "missive/resources/resource_manager.h"
 #include "missive/scheduler/scheduler.h"
 #include "missive/storage/storage_uploader_interface.h"
@@ -95,8 +96,14 @@ class UploadJob : public Scheduler::Job {
   UploadJob(const UploadJob& other) = delete;
   UploadJob& operator=(const UploadJob& other) = delete;
 
+  // Returns the priority of the uploaded queue.
+  std::optional<Priority> priority() const override;
+
+  // |priority| is the priority of the queue to be uploaded, if any; the
+  // Scheduler limits the concurrent jobs by it.
   static StatusOr<SmartPtr<UploadJob>> Create(
       scoped_refptr<UploadClient> upload_client,
+      std::optional<Priority> priority,
       bool need_encryption_key,
       std::optional<ERPHealthData> health_data,
       uint64_t remaining_storage_capacity,
@@ -112,9 +119,11 @@ class UploadJob : public Scheduler::Job {
  private:
   UploadJob(std::unique_ptr<UploadDelegate> upload_delegate,
             scoped_refptr<base::SequencedTaskRunner> sequenced_task_runner,
+            std::optional<Priority> priority,
             SetRecordsCb set_records_cb,
             UploaderInterface::UploaderInterfaceResultCb start_cb);
 
+  const std::optional<Priority> priority_;
   SetRecordsCb set_records_cb_;
   UploaderInterface::UploaderInterfaceResultCb start_cb_;
 
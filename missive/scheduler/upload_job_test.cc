@@ -141,6 +141,7 @@ TEST_F(UploadJobTest, UploadsRecords) {
   test::TestEvent<StatusOr<UploadEncryptedRecordResponse>> upload_responded;
   auto job_result =
       UploadJob::Create(upload_client_,
+                        /*priority=*/IMMEDIATE,
                         /*need_encryption_keys=*/false,
                         /*health_data=*/std::nullopt,
                         /*remaining_storage_capacity=*/3000U,
@@ -151,6 +152,7 @@ TEST_F(UploadJobTest, UploadsRecords) {
   ASSERT_TRUE(job_result.ok()) << job_result.status();
   Scheduler::Job::SmartPtr<Scheduler::Job> job =
       std::move(job_result.ValueOrDie());
+  EXPECT_THAT(job->priority(), Eq(IMMEDIATE));
 
   test::TestEvent<Status> upload_started;
   job->Start(upload_started.cb());
@@ -766,6 +766,7 @@ class LegacyStorageDegradationTest
   const StorageOptions& BuildTestStorageOptions() const { return options_; }
 
   void AsyncStartMockUploader(
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb start_uploader_cb) {
     main_task_runner_->PostTask(
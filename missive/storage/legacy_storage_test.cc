@@ -1008,6 +1008,7 @@ class LegacyStorageTest
   const StorageOptions& BuildTestStorageOptions() const { return options_; }
 
   void AsyncStartMockUploader(
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb start_uploader_cb) {
     main_task_runner_->PostTask(
@@ -1052,6 +1053,7 @@ class LegacyStorageTest
   }
 
   void AsyncStartMockUploaderFailing(
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb start_uploader_cb) {
     if (reason == UploaderInterface::UploadReason::KEY_DELIVERY &&
@@ -1060,7 +1062,7 @@ class LegacyStorageTest
           .Run(Status(kKeyDeliveryError, kKeyDeliveryErrorMessage));
       return;
     }
-    AsyncStartMockUploader(reason, std::move(start_uploader_cb));
+    AsyncStartMockUploader(priority, reason, std::move(start_uploader_cb));
   }
 
   Status WriteString(Priority priority, std::string_view data) {
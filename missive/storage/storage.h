@@ -73,7 +73,7 @@ class Storage : public base::RefCountedThreadSafe<Storage> {
     const scoped_refptr<HealthModule> health_module;
     const scoped_refptr<SignatureVerificationDevFlag>
         signature_verification_dev_flag;
-    const UploaderInterface::AsyncStartUploaderCb async_start_upload_cb;
+    const UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb;
   };
 
   // Creates Storage instance and returns it with the completion callback.
@@ -212,7 +212,7 @@ class Storage : public base::RefCountedThreadSafe<Storage> {
   const std::unique_ptr<KeyInStorage> key_in_storage_;
 
   // Upload provider callback.
-  const UploaderInterface::AsyncStartUploaderCb async_start_upload_cb_;
+  const UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb_;
 
   // <DM token, Priority> -> Generation guid map
   GenerationGuidMap dmtoken_to_generation_guid_map_
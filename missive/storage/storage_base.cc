@@ -62,7 +62,7 @@ QueueUploaderInterface::QueueUploaderInterface(
 void QueueUploaderInterface::AsyncProvideUploader(
     Priority priority,
     const scoped_refptr<HealthModule> health_module,
-    UploaderInterface::AsyncStartUploaderCb async_start_upload_cb,
+    UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb,
     scoped_refptr<EncryptionModuleInterface> encryption_module,
     UploaderInterface::UploadReason reason,
     UploaderInterfaceResultCb start_uploader_cb) {
@@ -78,7 +78,7 @@ void QueueUploaderInterface::AsyncProvideUploader(
         std::string(UploaderInterface::ReasonToString(upload_reason)));
   }
   async_start_upload_cb.Run(
-      upload_reason,
+      priority, upload_reason,
       base::BindOnce(&QueueUploaderInterface::WrapInstantiatedUploader,
                      priority, std::move(recorder),
                      std::move(start_uploader_cb)));
@@ -337,7 +337,7 @@ QueuesContainer::sequenced_task_runner() const {
 std::unique_ptr<KeyDelivery, base::OnTaskRunnerDeleter> KeyDelivery::Create(
     scoped_refptr<EncryptionModuleInterface> encryption_module,
     scoped_refptr<HealthModule> health_module,
-    UploaderInterface::AsyncStartUploaderCb async_start_upload_cb) {
+    UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb) {
   auto sequence_task_runner = base::ThreadPool::CreateSequencedTaskRunner(
       {base::TaskPriority::BEST_EFFORT, base::MayBlock()});
   return std::unique_ptr<KeyDelivery, base::OnTaskRunnerDeleter>(
@@ -388,7 +388,7 @@ void KeyDelivery::StartPeriodicKeyUpdate(const base::TimeDelta period) {
 KeyDelivery::KeyDelivery(
     scoped_refptr<EncryptionModuleInterface> encryption_module,
     scoped_refptr<HealthModule> health_module,
-    UploaderInterface::AsyncStartUploaderCb async_start_upload_cb,
+    UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb,
     scoped_refptr<base::SequencedTaskRunner> sequenced_task_runner)
     : sequenced_task_runner_(sequenced_task_runner),
       async_start_upload_cb_(async_start_upload_cb),
@@ -426,7 +426,7 @@ void KeyDelivery::EuqueueRequestAndPossiblyStart(
       base::BindOnce(&KeyDelivery::EncryptionKeyReceiverReady,
                      base::Unretained(this));
   async_start_upload_cb_.Run(
-      UploaderInterface::UploadReason::KEY_DELIVERY,
+      /*priority=*/std::nullopt, UploaderInterface::UploadReason::KEY_DELIVERY,
       base::BindOnce(&KeyDelivery::WrapInstantiatedKeyUploader,
                      /*priority=*/MANUAL_BATCH, std::move(recorder),
                      std::move(start_uploader_cb)));
@@ -141,7 +141,7 @@ class QueueUploaderInterface : public UploaderInterface {
   static void AsyncProvideUploader(
       Priority priority,
       const scoped_refptr<HealthModule> health_module,
-      UploaderInterface::AsyncStartUploaderCb async_start_upload_cb,
+      UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb,
       scoped_refptr<EncryptionModuleInterface> encryption_module,
       UploaderInterface::UploadReason reason,
       UploaderInterfaceResultCb start_uploader_cb);
@@ -177,7 +177,7 @@ class KeyDelivery {
   static std::unique_ptr<KeyDelivery, base::OnTaskRunnerDeleter> Create(
       scoped_refptr<EncryptionModuleInterface> encryption_module,
       scoped_refptr<HealthModule> health_module,
-      UploaderInterface::AsyncStartUploaderCb async_start_upload_cb);
+      UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb);
 
   ~KeyDelivery();
 
@@ -192,7 +192,7 @@ class KeyDelivery {
   explicit KeyDelivery(
       scoped_refptr<EncryptionModuleInterface> encryption_module,
       scoped_refptr<HealthModule> health_module,
-      UploaderInterface::AsyncStartUploaderCb async_start_upload_cb,
+      UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb,
       scoped_refptr<base::SequencedTaskRunner> sequenced_task_runner);
 
   void RequestKeyIfNeeded();
@@ -215,7 +215,7 @@ class KeyDelivery {
   SEQUENCE_CHECKER(sequence_checker_);
 
   // Upload provider callback.
-  const UploaderInterface::AsyncStartUploaderCb async_start_upload_cb_;
+  const UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb_;
 
   // List of all request callbacks.
   std::vector<RequestCallback> callbacks_ GUARDED_BY_CONTEXT(sequence_checker_);
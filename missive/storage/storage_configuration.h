@@ -224,6 +224,10 @@ class QueueOptions {
     can_shed_records_ = can_shed_records;
     return *this;
   }
+  QueueOptions& set_mmap_reads(bool mmap_reads) {
+    mmap_reads_ = mmap_reads;
+    return *this;
+  }
   const base::FilePath& directory() const { return directory_; }
   const std::string& file_prefix() const { return file_prefix_; }
   size_t max_record_size() const { return storage_options_.max_record_size(); }
@@ -237,6 +241,7 @@ class QueueOptions {
   base::TimeDelta upload_period() const { return upload_period_; }
   base::TimeDelta upload_retry_delay() const { return upload_retry_delay_; }
   bool can_shed_records() const { return can_shed_records_; }
+  bool mmap_reads() const { return mmap_reads_; }
   scoped_refptr<ResourceManager> disk_space_resource() const {
     return storage_options_.disk_space_resource();
   }
@@ -264,6 +269,10 @@ class QueueOptions {
   // Does the queue have the ability to perform a record shedding process on
   // itself. Only SECURITY can't shed.
   bool can_shed_records_ = true;
+  // Are closed data files memory-mapped for upload, so that records are
+  // handed to the uploader straight from the mapped pages instead of being
+  // copied into a read buffer first.
+  bool mmap_reads_ = false;
   // Cut-off file size of an individual queue
   // When file exceeds this size, the new file is created
   // for further records. Note that each file must have at least
@@ -42,7 +42,7 @@ class StorageModule : public StorageModuleInterface {
     const scoped_refptr<HealthModule> health_module;
     const scoped_refptr<SignatureVerificationDevFlag>
         signature_verification_dev_flag;
-    const UploaderInterface::AsyncStartUploaderCb async_start_upload_cb;
+    const UploaderInterface::AsyncStartPriorityUploaderCb async_start_upload_cb;
   };
 
   // Factory method creates `StorageModule` object.
@@ -5,6 +5,7 @@
 #include "missive/storage/storage_module.h"
 
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <utility>
 #include <unistd.h>
@@ -38,6 +39,7 @@ class TestUploaderInterface : public UploaderInterface {
   TestUploaderInterface() = default;
   // Factory method.
   static void AsyncProvideUploader(
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterfaceResultCb start_uploader_cb) {
     std::move(start_uploader_cb).Run(std::make_unique<TestUploaderInterface>());
@@ -18,12 +18,14 @@
 #include <string_view>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <base/containers/adapters.h>
 #include <base/files/file.h>
 #include <base/files/file_enumerator.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
+#include <base/files/memory_mapped_file.h>
 #include <base/functional/bind.h>
 #include <base/functional/callback_forward.h>
 #include <base/functional/callback_helpers.h>
@@ -235,9 +237,12 @@ StorageQueue::StorageQueue(
       degradation_candidates_cb_(settings.degradation_candidates_cb),
       encryption_module_(settings.encryption_module),
       compression_module_(settings.compression_module),
-      uma_id_(settings.uma_id) {
+      uma_id_(settings.uma_id),
+      max_write_batch_size_(settings.max_write_batch_size),
+      max_write_batch_delay_(settings.max_write_batch_delay) {
   DETACH_FROM_SEQUENCE(storage_queue_sequence_checker_);
   CHECK(!uma_id_.empty());
+  CHECK_GT(max_write_batch_size_, 0u);
 }
 
 StorageQueue::~StorageQueue() {
@@ -421,7 +426,8 @@ StatusOr<int64_t> StorageQueue::AddDataFile(
                           .size = file_info.GetSize(),
                           .memory_resource = options_.memory_resource(),
                           .disk_space_resource = options_.disk_space_resource(),
-                          .completion_closure_list = completion_closure_list_});
+                          .completion_closure_list = completion_closure_list_,
+                          .mmap_reads = options_.mmap_reads()});
   if (!file_or_status.ok()) {
     return file_or_status.status();
   }
@@ -608,7 +614,8 @@ StatusOr<scoped_refptr<StorageQueue::SingleFile>> StorageQueue::AssignLastFile(
              .size = 0,
              .memory_resource = options_.memory_resource(),
              .disk_space_resource = options_.disk_space_resource(),
-             .completion_closure_list = completion_closure_list_}));
+             .completion_closure_list = completion_closure_list_,
+             .mmap_reads = options_.mmap_reads()}));
     next_sequencing_id_ = 0;
     auto insert_result = files_.emplace(next_sequencing_id_, file);
     CHECK(insert_result.second);
@@ -643,7 +650,8 @@ StorageQueue::OpenNewWriteableFile() {
            .size = /*size=*/0,
            .memory_resource = options_.memory_resource(),
            .disk_space_resource = options_.disk_space_resource(),
-           .completion_closure_list = completion_closure_list_}));
+           .completion_closure_list = completion_closure_list_,
+           .mmap_reads = options_.mmap_reads()}));
   RETURN_IF_ERROR(new_file->Open(/*read_only=*/false));
   auto insert_result = files_.emplace(next_sequencing_id_, new_file);
   if (!insert_result.second) {
@@ -729,22 +737,23 @@ Status StorageQueue::WriteHeaderAndBlock(
   return Status::StatusOK();
 }
 
-Status StorageQueue::WriteMetadata(std::string_view current_record_digest) {
+Status StorageQueue::WriteMetadata(std::string_view current_record_digest,
+                                   int64_t sequencing_id) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(storage_queue_sequence_checker_);
 
   // Test only: Simulate failure if requested
   if (test_injection_handler_) {
     RETURN_IF_ERROR(test_injection_handler_.Run(
-        test::StorageQueueOperationKind::kWriteMetadata, next_sequencing_id_));
+        test::StorageQueueOperationKind::kWriteMetadata, sequencing_id));
   }
 
   // Synchronously write the metafile.
+  const base::FilePath meta_file_path =
+      options_.directory().Append(METADATA_NAME).AddExtensionASCII(
+          base::NumberToString(sequencing_id));
   ASSIGN_OR_RETURN(scoped_refptr<SingleFile> meta_file,
                    SingleFile::Create(
-                       {.filename = options_.directory()
-                                        .Append(METADATA_NAME)
-                                        .AddExtensionASCII(base::NumberToString(
-                                            next_sequencing_id_)),
+                       {.filename = meta_file_path,
                         .size = 0,
                         .memory_resource = options_.memory_resource(),
                         .disk_space_resource = options_.disk_space_resource(),
@@ -795,7 +804,7 @@ Status StorageQueue::WriteMetadata(std::string_view current_record_digest) {
   // happen.
   low_priority_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&StorageQueue::DeleteOutdatedMetadata, this,
-                                next_sequencing_id_));
+                                sequencing_id));
   return Status::StatusOK();
 }
 
@@ -1545,6 +1554,12 @@ class StorageQueue::WriteContext : public TaskRunnerContext<Status> {
       storage_queue_->write_contexts_queue_.erase(in_contexts_queue_);
     }
 
+    // A group-committed record is completed by the head of its batch, which
+    // resumes the queue and initiates upload once for the whole batch.
+    if (written_by_batch_head_) {
+      return;
+    }
+
     // If there is the context at the front of the queue and its buffer is
     // filled in, schedule respective |Write| to happen now.
     if (!storage_queue_->write_contexts_queue_.empty() &&
@@ -1850,10 +1865,22 @@ class StorageQueue::WriteContext : public TaskRunnerContext<Status> {
     // reactivated later.
     CHECK(in_contexts_queue_ != storage_queue_->write_contexts_queue_.end());
     if (storage_queue_->write_contexts_queue_.front().get() != this) {
+      // If the head is waiting for the batch to fill up, let it know this
+      // record is ready now.
+      const auto& head = storage_queue_->write_contexts_queue_.front();
+      if (head && head->batch_wait_started_) {
+        head->Schedule(&WriteContext::OnBatchRecordReady, head);
+      }
       return;
     }
 
     CHECK(!buffer_.empty());
+
+    // Try group commit first, if enabled. Falls back to writing the head
+    // record alone when there is nothing to batch it with.
+    if (storage_queue_->max_write_batch_size_ > 1u && MaybeWriteBatch()) {
+      return;
+    }
     // active_write_reservation_size_ includes both expected size of META file
     // and increase in size of DATA file.
     storage_queue_->active_write_reservation_size_ =
@@ -1884,7 +1911,8 @@ class StorageQueue::WriteContext : public TaskRunnerContext<Status> {
     scoped_refptr<SingleFile> last_file = assign_result.ValueOrDie();
 
     // Writing metadata ahead of the data write.
-    Status write_result = storage_queue_->WriteMetadata(current_record_digest_);
+    Status write_result = storage_queue_->WriteMetadata(
+        current_record_digest_, storage_queue_->next_sequencing_id_);
     if (!write_result.ok()) {
       Response(write_result);
       return;
@@ -1909,6 +1937,177 @@ class StorageQueue::WriteContext : public TaskRunnerContext<Status> {
     Response(Status::StatusOK());
   }
 
+  // Group commit for the head of the queue. Collects the contexts at the head
+  // of `write_contexts_queue_` that are ready to be written, reserves disk
+  // space for all of them at once, writes a single metadata file matching the
+  // last record of the batch and then appends all records to the queue.
+  // Returns false if the head record needs to be written on its own (batch
+  // too small, or disk space cannot be reserved for the whole batch - in the
+  // latter case the single record path takes care of degradation).
+  // Returns true if the batch has been written (the contexts responded), or
+  // if the head decided to wait for more records to become ready.
+  bool MaybeWriteBatch() {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(
+        storage_queue_->storage_queue_sequence_checker_);
+    auto& contexts_queue = storage_queue_->write_contexts_queue_;
+    CHECK_EQ(contexts_queue.front().get(), this);
+
+    std::vector<WriteContext*> batch;
+    bool more_records_pending = false;
+    for (const auto& context : contexts_queue) {
+      if (batch.size() >= storage_queue_->max_write_batch_size_) {
+        break;
+      }
+      CHECK(context);
+      if (context->buffer_.empty()) {
+        // The record is still being prepared.
+        more_records_pending = true;
+        break;
+      }
+      if (context->buffer_.size() >
+          storage_queue_->options_.max_record_size()) {
+        // Oversized record will fail on its own.
+        break;
+      }
+      batch.push_back(context.get());
+    }
+
+    // Wait for the records in flight to join the batch, unless the delay has
+    // already expired.
+    if (batch.size() < storage_queue_->max_write_batch_size_ &&
+        more_records_pending &&
+        !storage_queue_->max_write_batch_delay_.is_zero() &&
+        !batch_delay_expired_) {
+      if (!batch_wait_started_) {
+        batch_wait_started_ = true;
+        ScheduleAfter(storage_queue_->max_write_batch_delay_,
+                      &WriteContext::OnBatchDelayExpired,
+                      weak_ptr_factory_.GetWeakPtr());
+      }
+      return true;
+    }
+    batch_wait_started_ = false;
+
+    if (batch.size() < 2u) {
+      return false;
+    }
+
+    // Reserve space for all records of the batch and a single META file.
+    size_t reservation_size =
+        sizeof(generation_id_) + batch.back()->current_record_digest_.size();
+    for (const auto* context : batch) {
+      reservation_size +=
+          RoundUpToFrameSize(sizeof(RecordHeader) + context->buffer_.size());
+    }
+    storage_queue_->active_write_reservation_size_ = reservation_size;
+    if (!storage_queue_->ReserveNewRecordDiskSpace(reservation_size).ok()) {
+      storage_queue_->active_write_reservation_size_ = 0u;
+      return false;
+    }
+
+    // All records of the batch are at the head of the queue, remove them.
+    for (auto* context : batch) {
+      CHECK_EQ(contexts_queue.front().get(), context);
+      contexts_queue.pop_front();
+      context->in_contexts_queue_ = contexts_queue.end();
+      context->written_by_batch_head_ = context != this;
+    }
+
+    std::vector<Status> write_results(batch.size(), Status::StatusOK());
+    const Status batch_result = WriteBatch(batch, write_results);
+    if (!batch_result.ok()) {
+      // Nothing has been written, fail the whole batch.
+      write_results.assign(batch.size(), batch_result);
+    }
+
+    // Return the reservation of the records that failed to be written.
+    if (storage_queue_->active_write_reservation_size_ > 0u) {
+      storage_queue_->options_.disk_space_resource()->Discard(
+          storage_queue_->active_write_reservation_size_);
+      storage_queue_->active_write_reservation_size_ = 0u;
+    }
+
+    // Respond to the rest of the batch, then to the head (`this`) that runs
+    // the batch. Every `Response` destructs the respective context; only the
+    // head resumes the next write and initiates upload.
+    for (size_t i = batch.size() - 1; i > 0; --i) {
+      batch[i]->Response(write_results[i]);
+    }
+    Response(write_results[0]);
+    return true;
+  }
+
+  // Helper method for MaybeWriteBatch: writes the metadata for the last
+  // record of the `batch`, followed by headers and blocks of all records.
+  // Returns error status if nothing was written; otherwise sets individual
+  // `write_results` (once a record fails, all records after it fail too).
+  Status WriteBatch(const std::vector<WriteContext*>& batch,
+                    std::vector<Status>& write_results) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(
+        storage_queue_->storage_queue_sequence_checker_);
+    ASSIGN_OR_RETURN(
+        scoped_refptr<SingleFile> last_file,
+        storage_queue_->AssignLastFile(batch.front()->buffer_.size()));
+
+    // Writing metadata of the last record ahead of the data write.
+    RETURN_IF_ERROR(storage_queue_->WriteMetadata(
+        batch.back()->current_record_digest_,
+        storage_queue_->next_sequencing_id_ +
+            static_cast<int64_t>(batch.size()) - 1));
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+      WriteContext* const context = batch[i];
+      Status write_result;
+      if (i > 0) {
+        auto assign_result =
+            storage_queue_->AssignLastFile(context->buffer_.size());
+        if (assign_result.ok()) {
+          last_file = std::move(assign_result.ValueOrDie());
+        } else {
+          write_result = assign_result.status();
+        }
+      }
+      if (write_result.ok()) {
+        if (context->recorder_) {
+          auto* const write_queue_record =
+              context->recorder_->mutable_storage_queue_action()
+                  ->mutable_storage_enqueue();
+          write_queue_record->set_sequencing_id(
+              storage_queue_->next_sequencing_id_);
+        }
+        // Write header and block. Store current_record_digest_ with the
+        // queue, increment next_sequencing_id_
+        write_result = storage_queue_->WriteHeaderAndBlock(
+            context->buffer_, context->current_record_digest_, last_file);
+      }
+      if (!write_result.ok()) {
+        for (size_t j = i; j < batch.size(); ++j) {
+          write_results[j] = write_result;
+        }
+        break;
+      }
+    }
+    return Status::StatusOK();
+  }
+
+  // Reactivates the head of the queue waiting for the batch, when another
+  // record becomes ready or the batch delay expires. Ignored if the head is
+  // no longer waiting (e.g. it is already writing or degrading).
+  void OnBatchRecordReady() {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(
+        storage_queue_->storage_queue_sequence_checker_);
+    if (batch_wait_started_) {
+      ResumeWriteRecord();
+    }
+  }
+
+  void OnBatchDelayExpired() {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(
+        storage_queue_->storage_queue_sequence_checker_);
+    batch_delay_expired_ = true;
+    OnBatchRecordReady();
+  }
+
   void RetryWithDegradation(
       Status reserve_result,
       std::queue<scoped_refptr<StorageQueue>> degradation_candidates) {
@@ -2029,6 +2228,19 @@ class StorageQueue::WriteContext : public TaskRunnerContext<Status> {
   std::optional<Record> record_copy_
       GUARDED_BY_CONTEXT(storage_queue_->storage_queue_sequence_checker_);
 
+  // Group commit state of the head of the queue: set while it waits for more
+  // records to join its batch, and once `max_write_batch_delay_` has expired.
+  bool batch_wait_started_
+      GUARDED_BY_CONTEXT(storage_queue_->storage_queue_sequence_checker_) =
+          false;
+  bool batch_delay_expired_
+      GUARDED_BY_CONTEXT(storage_queue_->storage_queue_sequence_checker_) =
+          false;
+  // Set for the records of a batch other than its head.
+  bool written_by_batch_head_
+      GUARDED_BY_CONTEXT(storage_queue_->storage_queue_sequence_checker_) =
+          false;
+
   // Factory for the `context_queue_`.
   base::WeakPtrFactory<WriteContext> weak_ptr_factory_
       GUARDED_BY_CONTEXT(storage_queue_->storage_queue_sequence_checker_){this};
@@ -2424,6 +2636,7 @@ StorageQueue::SingleFile::SingleFile(
       filename_(settings.filename),
       size_(settings.size),
       buffer_(settings.memory_resource),
+      mmap_reads_(settings.mmap_reads),
       memory_resource_(settings.memory_resource),
       disk_space_resource_(settings.disk_space_resource) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -2460,6 +2673,15 @@ Status StorageQueue::SingleFile::Open(bool read_only) {
                     base::StrCat({"Cannot get size of file=", name()}));
     }
     size_ = static_cast<uint64_t>(file_size);
+  } else if (mmap_reads_ && size_ > 0) {
+    // Map the read-only file. If mapping fails, fall back to buffered reads.
+    auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+    if (mapped_file->Initialize(handle_->Duplicate())) {
+      mapped_file_ = std::move(mapped_file);
+    } else {
+      LOG(WARNING) << "Cannot map file=" << name()
+                   << ", using buffered reads";
+    }
   }
   return Status::StatusOK();
 }
@@ -2468,6 +2690,7 @@ void StorageQueue::SingleFile::Close() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   is_readonly_ = std::nullopt;
   buffer_.Clear();
+  mapped_file_.reset();
   if (!handle_) {
     // TODO(b/157943192): Restart auto-closing timer.
     return;
@@ -2503,6 +2726,16 @@ StatusOr<std::string_view> StorageQueue::SingleFile::Read(
     // Empty file, return EOF right away.
     return Status(error::OUT_OF_RANGE, "End of file");
   }
+  // If the file is mapped, refer to the mapped data without copying.
+  if (mapped_file_) {
+    const size_t mapped_size = mapped_file_->length();
+    if (pos >= mapped_size) {
+      return Status(error::OUT_OF_RANGE, "End of file");
+    }
+    return std::string_view(
+        reinterpret_cast<const char*>(mapped_file_->data()) + pos,
+        std::min<size_t>(size, mapped_size - pos));
+  }
   // If no buffer yet, allocate.
   // TODO(b/157943192): Add buffer management - consider adding an UMA for
   // tracking the average + peak memory the Storage module is consuming.
@@ -17,6 +17,7 @@
 #include <base/files/file.h>
 #include <base/files/file_enumerator.h>
 #include <base/files/file_path.h>
+#include <base/files/memory_mapped_file.h>
 #include <base/functional/callback.h>
 #include <base/functional/callback_forward.h>
 #include <base/memory/ref_counted.h>
@@ -115,6 +116,14 @@ class StorageQueue : public base::RefCountedDeleteOnSequence<StorageQueue> {
     const scoped_refptr<CompressionModule> compression_module;
     const InitRetryCb init_retry_cb;
     const std::string uma_id;  // ID string for queue-specific UMAs.
+    // Group commit: up to `max_write_batch_size` records ready to be written
+    // at the same time are appended as one run, followed by a single metadata
+    // file. 1 (default) writes every record on its own.
+    const size_t max_write_batch_size = 1u;
+    // Longest time the head of the write queue waits for records still being
+    // prepared (serialized, compressed, encrypted) to join its batch. Zero
+    // (default) means the batch only includes records that are already ready.
+    const base::TimeDelta max_write_batch_delay = base::TimeDelta();
   };
 
   // UMA names
@@ -248,6 +257,8 @@ class StorageQueue : public base::RefCountedDeleteOnSequence<StorageQueue> {
       const scoped_refptr<ResourceManager> memory_resource;
       const scoped_refptr<ResourceManager> disk_space_resource;
       const scoped_refptr<RefCountedClosureList> completion_closure_list;
+      // If true, the file is memory-mapped when opened for reading.
+      const bool mmap_reads = false;
     };
 
     // Factory method creates a SingleFile object for existing
@@ -269,6 +280,9 @@ class StorageQueue : public base::RefCountedDeleteOnSequence<StorageQueue> {
     // |expect_readonly| must match to is_readonly() (when set to false,
     // the file is expected to be writeable; this only happens when scanning
     // files restarting the queue).
+    // If the file is memory-mapped, the returned data refers to the mapped
+    // pages directly and remains valid until the file is closed (no copy to
+    // the read buffer is made).
     StatusOr<std::string_view> Read(uint32_t pos,
                                     uint32_t size,
                                     size_t max_buffer_size,
@@ -322,6 +336,14 @@ class StorageQueue : public base::RefCountedDeleteOnSequence<StorageQueue> {
     uint64_t file_position_ GUARDED_BY_CONTEXT(sequence_checker_) = 0;
     ResourceManagedBuffer buffer_ GUARDED_BY_CONTEXT(sequence_checker_);
 
+    // Memory mapping of the file opened for reading, if `mmap_reads_` is set.
+    // When present, `Read` refers to it instead of `buffer_`. Released by
+    // `Close`, so the data handed out by `Read` is valid as long as the file
+    // is open (and the file itself is held by refcount).
+    const bool mmap_reads_;
+    std::unique_ptr<base::MemoryMappedFile> mapped_file_
+        GUARDED_BY_CONTEXT(sequence_checker_);
+
     const scoped_refptr<ResourceManager> memory_resource_;
     const scoped_refptr<ResourceManager> disk_space_resource_;
   };
@@ -375,12 +397,14 @@ class StorageQueue : public base::RefCountedDeleteOnSequence<StorageQueue> {
 
   // Helper method for Write(): stores a file with metadata to match the
   // incoming new record. Synchronously composes metadata to record, then
-  // asynchronously writes it into a file with next sequencing id and then
+  // asynchronously writes it into a file with |sequencing_id| (next sequencing
+  // id, or the last one of a group-committed batch) and then
   // notifies the Write operation that it can now complete. After that it
   // asynchronously deletes all other files with lower sequencing id
   // (multiple Writes can see the same files and attempt to delete them, and
   // that is not an error).
-  Status WriteMetadata(std::string_view current_record_digest);
+  Status WriteMetadata(std::string_view current_record_digest,
+                       int64_t sequencing_id);
 
   // Helper method for RestoreMetadata(): loads and verifies metadata file
   // contents. If accepted, adds the file to the set.
@@ -587,6 +611,10 @@ class StorageQueue : public base::RefCountedDeleteOnSequence<StorageQueue> {
   // ID for queue-specific UMA.
   const std::string uma_id_;
 
+  // Group commit settings (see `Settings`).
+  const size_t max_write_batch_size_;
+  const base::TimeDelta max_write_batch_delay_;
+
   // Test only: records callback to be invoked. It will be called with operation
   // kind and seq id, and will return Status (non-OK status indicates the
   // failure to be injected). In production code must be null.
@@ -683,6 +683,8 @@ class StorageQueueTest
                 /*is_enabled=*/true, kCompressionThreshold, kCompressionType),
             .init_retry_cb = init_retry_cb,
             .uma_id = kUmaId,
+            .max_write_batch_size = max_write_batch_size_,
+            .max_write_batch_delay = max_write_batch_delay_,
         },
         storage_queue_create_event.cb());
     return storage_queue_create_event.result();
@@ -867,6 +869,9 @@ class StorageQueueTest
   }
 
   std::string dm_token_;
+  // Group commit settings for the queues created by the test.
+  size_t max_write_batch_size_ = 1u;
+  base::TimeDelta max_write_batch_delay_;
   scoped_refptr<HealthModule> health_module_;
   base::test::TaskEnvironment task_environment_{
       base::test::TaskEnvironment::TimeSource::MOCK_TIME};
@@ -992,6 +997,121 @@ TEST_P(StorageQueueTest, WriteIntoStorageQueueAndUpload) {
   task_environment_.FastForwardBy(base::Seconds(1));
 }
 
+TEST_P(StorageQueueTest, WriteBatchIntoStorageQueueReopenAndUpload) {
+  max_write_batch_size_ = kData.size();
+  max_write_batch_delay_ = base::Milliseconds(100);
+  CreateTestStorageQueueOrDie(BuildStorageQueueOptionsPeriodic());
+
+  // Issue all writes at once, so that they are committed as one batch.
+  std::vector<std::unique_ptr<test::TestEvent<Status>>> write_events;
+  for (const auto* data : kData) {
+    Record record;
+    record.set_data(data);
+    record.set_destination(UPLOAD_EVENTS);
+    write_events.emplace_back(std::make_unique<test::TestEvent<Status>>());
+    storage_queue_->Write(std::move(record), NewRecorder(),
+                          write_events.back()->cb());
+  }
+  for (auto& write_event : write_events) {
+    const Status write_result = write_event->result();
+    ASSERT_OK(write_result) << write_result;
+  }
+
+  // Add more records one by one.
+  WriteStringOrDie(kMoreData[0]);
+  WriteStringOrDie(kMoreData[1]);
+
+  ResetTestStorageQueue();
+
+  // Init resume upload upon non-empty queue restart - the records and their
+  // digests chain are restored regardless of batching.
+  test::TestCallbackAutoWaiter waiter;
+  EXPECT_CALL(set_mock_uploader_expectations_,
+              Call(Eq(UploaderInterface::UploadReason::INIT_RESUME)))
+      .WillOnce(Invoke([&waiter, this](UploaderInterface::UploadReason reason) {
+        return TestUploader::SetUp(&waiter, this)
+            .Required(0, kData[0])
+            .Required(1, kData[1])
+            .Required(2, kData[2])
+            .Required(3, kMoreData[0])
+            .Required(4, kMoreData[1])
+            .Complete();
+      }))
+      .RetiresOnSaturation();
+
+  // Reopening will cause INIT_RESUME
+  SetExpectedUploadsCount();
+  CreateTestStorageQueueOrDie(BuildStorageQueueOptionsPeriodic());
+}
+
+TEST_P(StorageQueueTest, WriteIntoStorageQueueAndUploadWithMmapReads) {
+  CreateTestStorageQueueOrDie(
+      BuildStorageQueueOptionsPeriodic().set_mmap_reads(true));
+  WriteStringOrDie(kData[0]);
+  WriteStringOrDie(kData[1]);
+  WriteStringOrDie(kData[2]);
+
+  // Set uploader expectations.
+  test::TestCallbackAutoWaiter waiter;
+  EXPECT_CALL(set_mock_uploader_expectations_,
+              Call(Eq(UploaderInterface::UploadReason::PERIODIC)))
+      .WillOnce(Invoke([&waiter, this](UploaderInterface::UploadReason reason) {
+        return TestUploader::SetUp(&waiter, this)
+            .Required(0, kData[0])
+            .Required(1, kData[1])
+            .Required(2, kData[2])
+            .Complete();
+      }))
+      .RetiresOnSaturation();
+
+  // Trigger upload.
+  SetExpectedUploadsCount();
+  task_environment_.FastForwardBy(base::Seconds(1));
+}
+
+TEST_P(StorageQueueTest, WriteBatchFollowedByRecordWithInsufficientDiskSpace) {
+  max_write_batch_size_ = 2u;
+  max_write_batch_delay_ = base::Milliseconds(100);
+  CreateTestStorageQueueOrDie(BuildStorageQueueOptionsOnlyManual());
+
+  // The first two records are committed as one batch, the third one runs out
+  // of disk space and goes through degradation once the batch is done.
+  auto inject = InjectFailures();
+  EXPECT_CALL(
+      *inject,
+      Call(Eq(test::StorageQueueOperationKind::kWriteLowDiskSpace), Eq(2)))
+      .WillRepeatedly(WithArg<1>(Invoke([](int64_t seq_id) {
+        return Status(error::INTERNAL,
+                      base::StrCat({"Simulated data write low disk space, seq=",
+                                    base::NumberToString(seq_id)}));
+      })));
+  // Degradation is attempted only once for the third record.
+  EXPECT_CALL(
+      analytics::Metrics::TestEnvironment::GetMockMetricsLibrary(),
+      SendEnumToUMA(StrEq(StorageQueue::kResourceExhaustedCaseUmaName),
+                    Eq(StorageQueue::ResourceExhaustedCase::NO_DISK_SPACE),
+                    Eq(StorageQueue::ResourceExhaustedCase::kMaxValue)))
+      .WillOnce(Return(true));
+
+  std::vector<std::unique_ptr<test::TestEvent<Status>>> write_events;
+  for (const auto* data : kData) {
+    Record record;
+    record.set_data(data);
+    record.set_destination(UPLOAD_EVENTS);
+    write_events.emplace_back(std::make_unique<test::TestEvent<Status>>());
+    storage_queue_->Write(std::move(record), NewRecorder(),
+                          write_events.back()->cb());
+  }
+  for (size_t i = 0; i < 2u; ++i) {
+    const Status write_result = write_events[i]->result();
+    ASSERT_OK(write_result) << write_result;
+  }
+  const Status write_result = write_events[2]->result();
+  EXPECT_FALSE(write_result.ok());
+  EXPECT_EQ(write_result.error_code(), error::RESOURCE_EXHAUSTED);
+  task_environment_.RunUntilIdle();  // For asynchronous UMA upload.
+}
+
 TEST_P(StorageQueueTest, WriteIntoStorageQueueAndUploadWithFailures) {
   CreateTestStorageQueueOrDie(BuildStorageQueueOptionsPeriodic());
   WriteStringOrDie(kData[0]);
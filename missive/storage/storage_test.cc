@@ -1028,6 +1028,7 @@ class StorageTest : public ::testing::TestWithParam<
   const StorageOptions& BuildTestStorageOptions() const { return options_; }
 
   void AsyncStartMockUploader(
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb start_uploader_cb) {
     main_task_runner_->PostTask(
@@ -1072,6 +1073,7 @@ class StorageTest : public ::testing::TestWithParam<
   }
 
   void AsyncStartMockUploaderFailing(
+      std::optional<Priority> priority,
       UploaderInterface::UploadReason reason,
       UploaderInterface::UploaderInterfaceResultCb start_uploader_cb) {
     if (reason == UploaderInterface::UploadReason::KEY_DELIVERY &&
@@ -1080,7 +1082,7 @@ class StorageTest : public ::testing::TestWithParam<
           .Run(Status(kKeyDeliveryError, kKeyDeliveryErrorMessage));
       return;
     }
-    AsyncStartMockUploader(reason, std::move(start_uploader_cb));
+    AsyncStartMockUploader(priority, reason, std::move(start_uploader_cb));
   }
 
   Status WriteString(Priority priority, std::string_view data) {
@@ -7,11 +7,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string_view>
 
 #include <base/functional/callback.h>
 
 #include "missive/proto/record.pb.h"
+#include "missive/proto/record_constants.pb.h"
 #include "missive/resources/resource_manager.h"
 #include "missive/util/status.h"
 #include "missive/util/statusor.h"
@@ -52,6 +54,13 @@ class UploaderInterface {
   // Callback type for asynchronous UploadInterface provider.
   using AsyncStartUploaderCb = base::RepeatingCallback<void(
       UploaderInterface::UploadReason reason, UploaderInterfaceResultCb)>;
+  // Callback type for asynchronous UploadInterface provider of the storage,
+  // also given the priority of the queue to be uploaded (std::nullopt if the
+  // upload does not belong to a queue, e.g. encryption key delivery).
+  using AsyncStartPriorityUploaderCb = base::RepeatingCallback<void(
+      std::optional<Priority> priority,
+      UploaderInterface::UploadReason reason,
+      UploaderInterfaceResultCb)>;
 
   UploaderInterface(const UploaderInterface& other) = delete;
   const UploaderInterface& operator=(const UploaderInterface& other) = delete;
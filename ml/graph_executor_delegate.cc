@@ -4,6 +4,7 @@
 
 #include "ml/graph_executor_delegate.h"
 
+#include <algorithm>
 #include <iterator>
 #include <set>
 #include <utility>
@@ -54,9 +55,7 @@ ExecuteResult PopulateInput(const TensorPtr& tensor,
 
   MemoryType* const input_memory = interpreter->typed_tensor<MemoryType>(index);
   const std::vector<TensorType>& tensor_values = tensor_view.GetValues();
-  for (int i = 0; i < tensor_values.size(); ++i) {
-    input_memory[i] = tensor_values[i];
-  }
+  std::copy(tensor_values.begin(), tensor_values.end(), input_memory);
 
   return ExecuteResult::OK;
 }
@@ -118,11 +117,9 @@ ExecuteResult PopulateOutput(const int index,
   // Populate tensor values.
   const MemoryType* const output_memory =
       interpreter.typed_tensor<MemoryType>(index);
-  std::vector<TensorType>& tensor_values = tensor_view.GetValues();
-  tensor_values.resize(num_entries);
-  for (int i = 0; i < num_entries; ++i) {
-    tensor_values[i] = output_memory[i];
-  }
+  // Assign straight from the interpreter memory rather than resizing first, so
+  // that large outputs aren't zero-filled before being overwritten.
+  tensor_view.GetValues().assign(output_memory, output_memory + num_entries);
 
   return ExecuteResult::OK;
 }
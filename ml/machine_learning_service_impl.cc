@@ -5,6 +5,7 @@
 #include "ml/machine_learning_service_impl.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include <unistd.h>
@@ -49,6 +50,7 @@
 #include "ml/text_classifier_impl.h"
 #include "ml/text_suggester_impl.h"
 #include "ml/text_suggestions.h"
+#include "ml/time_metrics.h"
 #include "ml/web_platform_handwriting_recognizer_impl.h"
 #include "ml/web_platform_model_loader_impl.h"
 
@@ -165,6 +167,20 @@ void LoadDocumentScannerFromPath(
   request_metrics.RecordRequestEvent(LoadModelResult::OK);
 }
 
+// Wraps the callback of a model loading request forwarded to a worker process,
+// so that the wall time till the worker process replies is recorded.
+template <class Callback>
+Callback WithLoadModelWallTime(const std::string& model_name,
+                               Callback callback) {
+  return base::BindOnce(
+      [](const std::string& model_name, base::Time begin_time,
+         Callback callback, LoadModelResult result) {
+        RecordLoadModelWallTime(model_name, begin_time, base::Time::Now());
+        std::move(callback).Run(result);
+      },
+      model_name, base::Time::Now(), std::move(callback));
+}
+
 }  // namespace
 
 MachineLearningServiceImpl::MachineLearningServiceImpl(
@@ -212,6 +228,8 @@ void MachineLearningServiceImpl::LoadBuiltinModel(
   // If it is run in the control process, spawn a worker process and forward the
   // request to it.
   if (Process::GetInstance()->IsControlProcess()) {
+    callback = WithLoadModelWallTime(metadata_lookup->second.metrics_model_name,
+                                     std::move(callback));
     pid_t worker_pid;
     mojo::PlatformChannel channel;
     constexpr char kModelName[] = "BuiltinModel";
@@ -252,10 +270,11 @@ void MachineLearningServiceImpl::LoadBuiltinModel(
     return;
   }
 
-  ModelImpl::Create(std::make_unique<ModelDelegate>(
-                        metadata.required_inputs, metadata.required_outputs,
-                        std::move(model), metadata.metrics_model_name),
-                    std::move(receiver));
+  auto model_delegate = std::make_unique<ModelDelegate>(
+      metadata.required_inputs, metadata.required_outputs, std::move(model),
+      metadata.metrics_model_name);
+  model_delegate->set_num_threads(metadata.num_threads);
+  ModelImpl::Create(std::move(model_delegate), std::move(receiver));
 
   std::move(callback).Run(LoadModelResult::OK);
 
@@ -275,6 +294,8 @@ void MachineLearningServiceImpl::LoadFlatBufferModel(
   // If it is run in the control process, spawn a worker process and forward the
   // request to it.
   if (Process::GetInstance()->IsControlProcess()) {
+    callback =
+        WithLoadModelWallTime(spec->metrics_model_name, std::move(callback));
     pid_t worker_pid;
     mojo::PlatformChannel channel;
     constexpr char kModelName[] = "FlatBufferModel";
@@ -117,6 +117,15 @@ CreateGraphExecutorResult ModelDelegate::CreateGraphExecutorDelegate(
     return CreateGraphExecutorResult::MODEL_INTERPRETATION_ERROR;
   }
 
+  if (num_threads_ != -1 &&
+      interpreter->SetNumThreads(num_threads_) != kTfLiteOk) {
+    LOG(ERROR) << "Could not set the number of threads to " << num_threads_
+               << ".";
+    request_metrics.RecordRequestEvent(
+        CreateGraphExecutorResult::MODEL_INTERPRETATION_ERROR);
+    return CreateGraphExecutorResult::MODEL_INTERPRETATION_ERROR;
+  }
+
   // Check that any chosen delegates are mutually exclusive
   if (use_nnapi && use_gpu) {
     LOG(ERROR) << "Cannot specify GPU and NNAPI delegates simultaneously.";
@@ -77,6 +77,10 @@ class ModelDelegate {
       GpuDelegateApi gpu_delegate_api,
       GraphExecutorDelegate** graph_executor_delegate);
 
+  // Sets the number of threads used by the interpreters created afterwards.
+  // -1, the default, lets TF lite decide.
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
  private:
   const std::map<std::string, int> required_inputs_;
   const std::map<std::string, int> required_outputs_;
@@ -88,6 +92,8 @@ class ModelDelegate {
 
   // Model name as it should appear in UMA histogram names.
   const std::string metrics_model_name_;
+
+  int num_threads_ = -1;
 };
 
 }  // namespace ml
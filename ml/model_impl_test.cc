@@ -92,6 +92,26 @@ TEST_F(ModelImplTest, TestBadModel) {
   ASSERT_TRUE(callback_done);
 }
 
+// Test creating a graph executor limited to a single thread.
+TEST_F(ModelImplTest, TestNumThreads) {
+  std::unique_ptr<tflite::FlatBufferModel> tflite_model =
+      tflite::FlatBufferModel::BuildFromFile(model_path_.c_str());
+  ASSERT_NE(tflite_model.get(), nullptr);
+
+  ModelDelegate model_delegate(model_inputs_, model_outputs_,
+                               std::move(tflite_model), "TestModel");
+  model_delegate.set_num_threads(1);
+
+  GraphExecutorDelegate* graph_executor_delegate = nullptr;
+  EXPECT_EQ(model_delegate.CreateGraphExecutorDelegate(
+                /*use_nnapi=*/false, /*use_gpu=*/false,
+                GraphExecutorOptions::New()->gpu_delegate_api,
+                &graph_executor_delegate),
+            CreateGraphExecutorResult::OK);
+  EXPECT_NE(std::unique_ptr<GraphExecutorDelegate>(graph_executor_delegate),
+            nullptr);
+}
+
 // Test loading the valid example model.
 TEST_F(ModelImplTest, TestExampleModel) {
   // Read the example TF model from disk.
@@ -28,6 +28,10 @@ struct BuiltinModelMetadata {
   //
   // This variable must NOT be empty.
   std::string metrics_model_name;
+
+  // Number of threads each interpreter of the model may use, or -1 to let
+  // TF lite decide.
+  int num_threads = -1;
 };
 
 // Returns a map from model ID to model metdata for each supported model.
@@ -33,4 +33,14 @@ void RecordReapWorkerProcessWallTime(base::Time begin_time,
                              kWallTimeBuckets);
 }
 
+void RecordLoadModelWallTime(const std::string& model_name,
+                             base::Time begin_time,
+                             base::Time end_time) {
+  DCHECK_GE(end_time, begin_time);
+  MetricsLibrary().SendToUMA(
+      "MachineLearningService." + model_name + ".LoadModelWallTime",
+      (end_time - begin_time).InMicroseconds(), kWallTimeMinMicrosec,
+      kWallTimeMaxMicrosec, kWallTimeBuckets);
+}
+
 }  // namespace ml
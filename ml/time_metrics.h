@@ -28,5 +28,11 @@ class WallTimeMetric {
 void RecordReapWorkerProcessWallTime(base::Time begin_time,
                                      base::Time end_time);
 
+// Records how long a model loading request forwarded by the control process
+// takes, from spawning the worker process till the worker process replies.
+void RecordLoadModelWallTime(const std::string& model_name,
+                             base::Time begin_time,
+                             base::Time end_time);
+
 }  // namespace ml
 #endif  // ML_TIME_METRICS_H_
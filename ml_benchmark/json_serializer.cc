@@ -13,6 +13,7 @@
 #include <string>
 #include <utility>
 
+using chrome::ml_benchmark::AccelerationMode_Name;
 using chrome::ml_benchmark::BenchmarkResults;
 using chrome::ml_benchmark::Metric;
 
@@ -71,6 +72,19 @@ std::optional<std::string> metric_cardinality(const Metric::Cardinality c) {
   }
 }
 
+void WriteJsonToPath(base::ValueView doc, const base::FilePath& output_path) {
+  std::string results_string;
+  if (!base::JSONWriter::Write(doc, &results_string)) {
+    LOG(ERROR) << "Unable to serialize benchmarking results.";
+    return;
+  }
+  constexpr mode_t kFileRWMode = 0644;
+  if (!brillo::WriteToFileAtomic(output_path, results_string.c_str(),
+                                 results_string.size(), kFileRWMode)) {
+    LOG(ERROR) << "Unable to write out the benchmarking results";
+  }
+}
+
 }  // namespace
 
 namespace ml_benchmark {
@@ -136,16 +150,30 @@ void WriteResultsToPath(const BenchmarkResults& results,
     return;
   }
 
-  std::string results_string;
-  if (!base::JSONWriter::Write(*doc, &results_string)) {
-    LOG(ERROR) << "Unable to serialize benchmarking results.";
-    return;
+  WriteJsonToPath(*doc, output_path);
+}
+
+std::optional<base::Value::List> SweepResultsToJson(
+    const SweepResults& results) {
+  base::Value::List table;
+  for (const auto& [mode, mode_results] : results) {
+    std::optional<base::Value::Dict> row = BenchmarkResultsToJson(mode_results);
+    if (!row)
+      return std::nullopt;
+    row->Set("acceleration_mode", AccelerationMode_Name(mode));
+    table.Append(std::move(*row));
   }
-  constexpr mode_t kFileRWMode = 0644;
-  if (!brillo::WriteToFileAtomic(output_path, results_string.c_str(),
-                                 results_string.size(), kFileRWMode)) {
-    LOG(ERROR) << "Unable to write out the benchmarking results";
+  return table;
+}
+
+void WriteSweepResultsToPath(const SweepResults& results,
+                             const base::FilePath& output_path) {
+  std::optional<base::Value::List> table = SweepResultsToJson(results);
+  if (!table) {
+    return;
   }
+
+  WriteJsonToPath(*table, output_path);
 }
 
 }  // namespace ml_benchmark
@@ -6,6 +6,8 @@
 #define ML_BENCHMARK_JSON_SERIALIZER_H_
 
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include <base/files/file_path.h>
 #include <base/values.h>
@@ -21,6 +23,21 @@ std::optional<base::Value::Dict> BenchmarkResultsToJson(
 void WriteResultsToPath(const chrome::ml_benchmark::BenchmarkResults& results,
                         const base::FilePath& output_path);
 
+// The results of a benchmark sweep, one entry per acceleration mode the
+// driver ran with.
+using SweepResults =
+    std::vector<std::pair<chrome::ml_benchmark::AccelerationMode,
+                          chrome::ml_benchmark::BenchmarkResults>>;
+
+// Serializes |results| as a table with one row per acceleration mode. Each
+// row holds the fields of BenchmarkResultsToJson() and "acceleration_mode".
+// In case of failure reports error to LOG(ERROR) and returns std::nullopt.
+std::optional<base::Value::List> SweepResultsToJson(
+    const SweepResults& results);
+
+void WriteSweepResultsToPath(const SweepResults& results,
+                             const base::FilePath& output_path);
+
 }  // namespace ml_benchmark
 
 #endif  // ML_BENCHMARK_JSON_SERIALIZER_H_
@@ -13,6 +13,7 @@
 
 #include <base/check.h>
 
+using chrome::ml_benchmark::AccelerationMode;
 using chrome::ml_benchmark::BenchmarkResults;
 using chrome::ml_benchmark::Metric;
 using ::testing::Eq;
@@ -187,4 +188,49 @@ TEST(BenchmarkResultsToJson, PowerNormalizationFactor) {
   EXPECT_EQ(json->FindDouble("power_normalization_factor"), 100);
 }
 
+TEST(SweepResultsToJson, OneRowPerAccelerationMode) {
+  SweepResults sweep;
+  {
+    BenchmarkResults results;
+    (*results.mutable_percentile_latencies_in_us())[50] = 1000;
+    sweep.emplace_back(AccelerationMode::NO_ACCELERATION, std::move(results));
+  }
+  {
+    BenchmarkResults results;
+    results.set_status(chrome::ml_benchmark::INITIALIZATION_FAILED);
+    sweep.emplace_back(AccelerationMode::NNAPI, std::move(results));
+  }
+
+  const std::optional<base::Value::List> json =
+      ml_benchmark::SweepResultsToJson(sweep);
+  ASSERT_TRUE(json);
+  ASSERT_EQ(json->size(), 2);
+
+  ASSERT_TRUE((*json)[0].is_dict());
+  const auto& cpu = (*json)[0].GetDict();
+  EXPECT_THAT(cpu.FindString("acceleration_mode"),
+              Pointee(Eq("NO_ACCELERATION")));
+  EXPECT_EQ(cpu.FindInt("status"), chrome::ml_benchmark::OK);
+  const base::Value::Dict* latencies =
+      cpu.FindDict("percentile_latencies_in_us");
+  ASSERT_TRUE(latencies);
+  EXPECT_EQ(latencies->FindInt("50"), 1000);
+
+  ASSERT_TRUE((*json)[1].is_dict());
+  const auto& nnapi = (*json)[1].GetDict();
+  EXPECT_THAT(nnapi.FindString("acceleration_mode"), Pointee(Eq("NNAPI")));
+  EXPECT_EQ(nnapi.FindInt("status"),
+            chrome::ml_benchmark::INITIALIZATION_FAILED);
+}
+
+TEST(SweepResultsToJson, InvalidRow) {
+  SweepResults sweep;
+  BenchmarkResults results;
+  // A single cardinality metric without a value can't be serialized.
+  results.add_metrics()->set_cardinality(Metric::SINGLE);
+  sweep.emplace_back(AccelerationMode::NNAPI, std::move(results));
+
+  EXPECT_FALSE(ml_benchmark::SweepResultsToJson(sweep));
+}
+
 }  // namespace ml_benchmark
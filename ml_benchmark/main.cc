@@ -13,6 +13,7 @@
 
 #include <optional>
 #include <string>
+#include <utility>
 
 #include "ml_benchmark/json_serializer.h"
 #include "ml_benchmark/memory_sampler.h"
@@ -59,16 +60,17 @@ void PrintMetrics(const BenchmarkResults& results) {
             << results.power_normalization_factor();
 }
 
-void BenchmarkAndReportResults(
-    const std::string& driver_name,
-    const base::FilePath& driver_file_path,
-    const CrOSBenchmarkConfig& config,
-    const std::optional<base::FilePath>& output_path) {
+// Runs the benchmark and adds the memory and duration metrics to |results|.
+// Returns false if the benchmark could not be run at all.
+bool RunBenchmark(const std::string& driver_name,
+                  const base::FilePath& driver_file_path,
+                  const CrOSBenchmarkConfig& config,
+                  BenchmarkResults* results) {
   auto functions =
       std::make_unique<SharedLibraryBenchmarkFunctions>(driver_file_path);
   if (functions == nullptr || !functions->valid()) {
     LOG(ERROR) << "Unable to load the " << driver_name << " benchmark";
-    return;
+    return false;
   }
 
   const int64_t initial_memsize = ml_benchmark::GetVMSizeBytes();
@@ -80,27 +82,26 @@ void BenchmarkAndReportResults(
 
   LOG(INFO) << "Starting the " << driver_name << " benchmark";
   SharedLibraryBenchmark benchmark(std::move(functions));
-  BenchmarkResults results;
-  if (!benchmark.ExecuteBenchmark(config, &results)) {
+  const bool executed = benchmark.ExecuteBenchmark(config, results);
+  PeakMemorySampler::StopSampling(mem_sampler);
+  if (!executed) {
     LOG(ERROR) << "Unable to execute the " << driver_name << " benchmark";
-    LOG(ERROR) << "Reason: " << results.results_message();
-    return;
+    LOG(ERROR) << "Reason: " << results->results_message();
+    return false;
   }
 
-  PeakMemorySampler::StopSampling(mem_sampler);
-
-  if (results.status() == chrome::ml_benchmark::OK) {
+  if (results->status() == chrome::ml_benchmark::OK) {
     LOG(INFO) << driver_name << " finished";
 
     const int64_t final_vmpeaksize = ml_benchmark::GetVMPeakBytes();
     const int64_t peak_rss_swap = mem_sampler->GetMaxSample();
 
-    AddMemoryMetric("initial_vmsize", initial_memsize, &results);
-    AddMemoryMetric("final_vmpeak", final_vmpeaksize, &results);
-    AddMemoryMetric("initial_rss_swap", initial_rss_swap, &results);
-    AddMemoryMetric("peak_rss_swap", peak_rss_swap, &results);
+    AddMemoryMetric("initial_vmsize", initial_memsize, results);
+    AddMemoryMetric("final_vmpeak", final_vmpeaksize, results);
+    AddMemoryMetric("initial_rss_swap", initial_rss_swap, results);
+    AddMemoryMetric("peak_rss_swap", peak_rss_swap, results);
 
-    auto* benchmark_duration = results.add_metrics();
+    auto* benchmark_duration = results->add_metrics();
     benchmark_duration->set_name("benchmark_duration");
     benchmark_duration->set_units(Metric::MS);
     benchmark_duration->set_direction(Metric::SMALLER_IS_BETTER);
@@ -108,18 +109,58 @@ void BenchmarkAndReportResults(
     benchmark_duration->add_values(
         (base::Time::Now() - start_time).InMillisecondsF());
 
-    PrintMetrics(results);
-
-    if (output_path) {
-      ml_benchmark::WriteResultsToPath(results, *output_path);
-    }
+    PrintMetrics(*results);
   } else {
     LOG(ERROR) << driver_name << " Encountered an error";
-    LOG(ERROR) << "Reason: " << results.results_message();
+    LOG(ERROR) << "Reason: " << results->results_message();
+  }
+  return true;
+}
 
-    if (output_path) {
-      ml_benchmark::WriteResultsToPath(results, *output_path);
+void BenchmarkAndReportResults(
+    const std::string& driver_name,
+    const base::FilePath& driver_file_path,
+    const CrOSBenchmarkConfig& config,
+    const std::optional<base::FilePath>& output_path) {
+  BenchmarkResults results;
+  if (!RunBenchmark(driver_name, driver_file_path, config, &results))
+    return;
+
+  if (output_path) {
+    ml_benchmark::WriteResultsToPath(results, *output_path);
+  }
+}
+
+// Runs the benchmark once per acceleration mode, so that the modes can be
+// compared on the same device, and writes the results as a single table.
+// Note that "final_vmpeak" is the peak of the whole process, so it includes the
+// runs of the previous modes.
+void SweepAndReportResults(const std::string& driver_name,
+                           const base::FilePath& driver_file_path,
+                           const CrOSBenchmarkConfig& config,
+                           const std::optional<base::FilePath>& output_path) {
+  ml_benchmark::SweepResults sweep;
+  for (int mode = chrome::ml_benchmark::AccelerationMode_MIN;
+       mode <= chrome::ml_benchmark::AccelerationMode_MAX; ++mode) {
+    if (!chrome::ml_benchmark::AccelerationMode_IsValid(mode))
+      continue;
+
+    CrOSBenchmarkConfig mode_config = config;
+    mode_config.set_acceleration_mode(static_cast<AccelerationMode>(mode));
+    LOG(INFO) << "Sweeping acceleration mode "
+              << chrome::ml_benchmark::AccelerationMode_Name(
+                     mode_config.acceleration_mode());
+
+    BenchmarkResults results;
+    if (!RunBenchmark(driver_name, driver_file_path, mode_config, &results)) {
+      // Keep a row for the mode so that the table shows it failed.
+      results.set_status(chrome::ml_benchmark::RUNTIME_ERROR);
     }
+    sweep.emplace_back(mode_config.acceleration_mode(), std::move(results));
+  }
+
+  if (output_path) {
+    ml_benchmark::WriteSweepResultsToPath(sweep, *output_path);
   }
 }
 
@@ -132,6 +173,9 @@ int main(int argc, char* argv[]) {
   DEFINE_string(driver_library_path, "libsoda_benchmark_driver.so",
                 "Path to the driver shared library.");
   DEFINE_bool(use_nnapi, false, "Use NNAPI delegate.");
+  DEFINE_bool(sweep, false,
+              "Run the benchmark with every acceleration mode and write a "
+              "single table of results. Overrides --use_nnapi.");
   DEFINE_string(output_path, "", "Path to write the final results json to.");
 
   brillo::FlagHelper::Init(argc, argv, "ML Benchmark runner");
@@ -161,8 +205,13 @@ int main(int argc, char* argv[]) {
   base::ThreadPoolInstance::CreateAndStartWithDefaultParams("ml_benchmark");
 
   base::FilePath driver_library(FLAGS_driver_library_path);
-  BenchmarkAndReportResults(FLAGS_driver_library_path, driver_library,
-                            benchmark_config, output_file_path);
+  if (FLAGS_sweep) {
+    SweepAndReportResults(FLAGS_driver_library_path, driver_library,
+                          benchmark_config, output_file_path);
+  } else {
+    BenchmarkAndReportResults(FLAGS_driver_library_path, driver_library,
+                              benchmark_config, output_file_path);
+  }
 
   LOG(INFO) << "Benchmark finished, exiting";
 }
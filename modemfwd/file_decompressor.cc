@@ -6,7 +6,6 @@
 
 #include <lzma.h>
 #include <stdint.h>
-#include <stdio.h>
 
 #include <memory>
 
@@ -15,6 +14,14 @@
 
 namespace modemfwd {
 
+namespace {
+
+// Firmware images are tens of megabytes, so use buffers large enough to keep
+// the number of read and write syscalls low.
+constexpr size_t kBufferSize = 64 * 1024;
+
+}  // namespace
+
 bool DecompressXzFile(const base::FilePath& in_file_path,
                       const base::FilePath& out_file_path) {
   base::File in_file(in_file_path,
@@ -42,8 +49,8 @@ bool DecompressXzFile(const base::FilePath& in_file_path,
       &stream, &lzma_end);
 
   lzma_action action = LZMA_RUN;
-  const size_t in_buffer_size = BUFSIZ;
-  const size_t out_buffer_size = BUFSIZ;
+  const size_t in_buffer_size = kBufferSize;
+  const size_t out_buffer_size = kBufferSize;
   auto in_buffer = std::make_unique<uint8_t[]>(in_buffer_size);
   auto out_buffer = std::make_unique<uint8_t[]>(out_buffer_size);
 
@@ -57,7 +64,7 @@ bool DecompressXzFile(const base::FilePath& in_file_path,
       int read_ret = in_file.ReadAtCurrentPos(
           reinterpret_cast<char*>(in_buffer.get()), in_buffer_size);
       if (read_ret < 0) {
-        PLOG(ERROR) << "Failed to read from '" << out_file_path.value() << "'";
+        PLOG(ERROR) << "Failed to read from '" << in_file_path.value() << "'";
         return false;
       }
 
@@ -8,6 +8,7 @@
 #include <base/files/file_path.h>
 #include <base/logging.h>
 #include <base/notreached.h>
+#include <base/timer/elapsed_timer.h>
 
 #include "modemfwd/file_decompressor.h"
 
@@ -41,11 +42,14 @@ bool FirmwareFile::PrepareFrom(const base::FilePath& firmware_dir,
       base::FilePath actual_path = temp_dir_.GetPath().Append(
           firmware_path.BaseName().RemoveFinalExtension());
 
+      base::ElapsedTimer timer;
       if (!DecompressXzFile(firmware_path, actual_path)) {
         LOG(ERROR) << "Failed to decompress firmware: "
                    << firmware_path.value();
         return false;
       }
+      LOG(INFO) << "Decompressed " << firmware_path.BaseName() << " in "
+                << timer.Elapsed();
       path_for_logging_ = firmware_path;
       path_on_filesystem_ = actual_path;
       return true;
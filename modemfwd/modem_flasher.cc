@@ -13,6 +13,7 @@
 #include <base/logging.h>
 #include <base/stl_util.h>
 #include <base/strings/stringprintf.h>
+#include <base/timer/elapsed_timer.h>
 #include <chromeos/switches/modemfwd_switches.h>
 #include <dbus/modemfwd/dbus-constants.h>
 
@@ -156,6 +157,9 @@ base::OnceClosure ModemFlasher::TryFlash(Modem* modem,
   for (const auto& assoc_entry : files.assoc_firmware)
     flash_infos.emplace_back(assoc_entry.first, &assoc_entry.second);
 
+  // Time spent finding and decompressing the firmware files, reported along
+  // with the time the helper takes to flash them.
+  base::ElapsedTimer prepare_timer;
   std::map<std::string, std::unique_ptr<FirmwareFile>> flash_files;
   for (const auto& flash_info : flash_infos) {
     const FirmwareFileInfo& file_info = *flash_info.second;
@@ -256,10 +260,15 @@ base::OnceClosure ModemFlasher::TryFlash(Modem* modem,
                  std::back_inserter(fw_types),
                  [](const FirmwareConfig& cfg) { return cfg.fw_type; });
 
+  ELOG(INFO) << "Prepared " << flash_cfg.size() << " firmware file(s) in "
+             << prepare_timer.Elapsed();
+
   InhibitMode _inhibit(modem);
   journal_->MarkStartOfFlashingFirmware(fw_types, device_id, current_carrier);
   metrics_->StartFwFlashTimer();
+  base::ElapsedTimer flash_timer;
   if (!modem->FlashFirmwares(flash_cfg)) {
+    ELOG(INFO) << "Helper failed after " << flash_timer.Elapsed();
     flash_state->OnFlashFailed();
     journal_->MarkEndOfFlashingFirmware(device_id, current_carrier);
     Error::AddTo(err, FROM_HERE, kErrorResultFailureReturnedByHelper,
@@ -275,6 +284,7 @@ base::OnceClosure ModemFlasher::TryFlash(Modem* modem,
   }
   // Report flashing time in successful cases
   metrics_->SendFwFlashTime();
+  ELOG(INFO) << "Helper flashed the firmware in " << flash_timer.Elapsed();
   flash_state->fw_flashed_ = true;
   flash_state->fw_types_flashed_ = GetFirmwareTypesForMetrics(flash_cfg);
 
@@ -4,12 +4,14 @@
 
 #include "mojo_service_manager/daemon/service_manager.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <utility>
 
 #include <base/check.h>
 #include <base/logging.h>
+#include <base/time/time.h>
 
 #include "mojo_service_manager/daemon/mojo_error_util.h"
 
@@ -95,6 +97,9 @@ void ServiceManager::Register(
       mojom::ServiceEvent::New(mojom::ServiceEvent::Type::kRegistered,
                                service_name, identity.Clone()));
 
+  const base::TimeTicks now = base::TimeTicks::Now();
+  size_t dispatched = 0;
+  base::TimeDelta longest_wait;
   for (ServiceRequestQueue::ServiceRequest& request :
        service_state.request_queue.TakeAllRequests()) {
     // If a receiver become invalid before being posted, don't send it because
@@ -102,9 +107,16 @@ void ServiceManager::Register(
     // connection of service provider.
     if (!request.receiver.is_valid())
       continue;
+    ++dispatched;
+    longest_wait = std::max(longest_wait, now - request.enqueue_time);
     service_state.service_provider->Request(std::move(request.identity),
                                             std::move(request.receiver));
   }
+  if (dispatched > 0) {
+    LOG(INFO) << "Dispatched " << dispatched << " queued request(s) of "
+              << service_name << ", the longest waited "
+              << longest_wait.InMilliseconds() << " ms";
+  }
 }
 
 void ServiceManager::Request(const std::string& service_name,
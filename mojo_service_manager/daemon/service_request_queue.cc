@@ -4,6 +4,7 @@
 
 #include "mojo_service_manager/daemon/service_request_queue.h"
 
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -23,15 +24,19 @@ ServiceRequestQueue::~ServiceRequestQueue() = default;
 void ServiceRequestQueue::Push(mojom::ProcessIdentityPtr identity,
                                std::optional<base::TimeDelta> timeout,
                                mojo::ScopedMessagePipeHandle receiver) {
-  requests_.push_front(ServiceRequest{
+  // Keep the requests in arrival order so they are dispatched to the service
+  // first come, first served once it is registered.
+  requests_.push_back(ServiceRequest{
       .identity = std::move(identity),
       .receiver = std::move(receiver),
+      .enqueue_time = base::TimeTicks::Now(),
   });
   if (timeout.has_value()) {
     base::SingleThreadTaskRunner::GetCurrentDefault()->PostDelayedTask(
         FROM_HERE,
         base::BindOnce(&ServiceRequestQueue::PopAndRejectTimeoutRequest,
-                       weak_factory_.GetWeakPtr(), requests_.begin()),
+                       weak_factory_.GetWeakPtr(),
+                       std::prev(requests_.end())),
         timeout.value());
   }
 }
@@ -10,6 +10,7 @@
 #include <string>
 
 #include <base/memory/weak_ptr.h>
+#include <base/time/time.h>
 
 #include "mojo_service_manager/lib/mojom/service_manager.mojom.h"
 
@@ -27,6 +28,8 @@ class ServiceRequestQueue {
     mojom::ProcessIdentityPtr identity;
     // The receiver to be bound to the mojo service.
     mojo::ScopedMessagePipeHandle receiver;
+    // When the request was pushed to the queue.
+    base::TimeTicks enqueue_time;
   };
 
   explicit ServiceRequestQueue(const std::string& service_name);
@@ -40,8 +43,9 @@ class ServiceRequestQueue {
             std::optional<base::TimeDelta> timeout,
             mojo::ScopedMessagePipeHandle receiver);
 
-  // Takes all the service requests from the queue. This cancel all the delayed
-  // tasks of this queue which has not yet been run.
+  // Takes all the service requests from the queue, in the order they were
+  // pushed. This cancel all the delayed tasks of this queue which has not yet
+  // been run.
   std::list<ServiceRequest> TakeAllRequests();
 
  private:
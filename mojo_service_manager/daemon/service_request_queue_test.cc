@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <list>
 #include <string>
 
 #include <base/test/bind.h>
@@ -34,6 +35,26 @@ TEST_F(ServiceRequestQueueTest, PushAndTake) {
   EXPECT_TRUE(queue_.TakeAllRequests().empty());
 }
 
+TEST_F(ServiceRequestQueueTest, TakeInPushOrder) {
+  auto identity_a = mojom::ProcessIdentity::New();
+  identity_a->security_context = "a";
+  queue_.Push(std::move(identity_a), std::nullopt,
+              mojo::ScopedMessagePipeHandle{});
+  env_.FastForwardBy(base::Seconds(1));
+  auto identity_b = mojom::ProcessIdentity::New();
+  identity_b->security_context = "b";
+  queue_.Push(std::move(identity_b), base::Seconds(10),
+              mojo::ScopedMessagePipeHandle{});
+
+  std::list<ServiceRequestQueue::ServiceRequest> requests =
+      queue_.TakeAllRequests();
+  ASSERT_EQ(requests.size(), 2);
+  EXPECT_EQ(requests.front().identity->security_context, "a");
+  EXPECT_EQ(requests.back().identity->security_context, "b");
+  EXPECT_EQ(requests.back().enqueue_time - requests.front().enqueue_time,
+            base::Seconds(1));
+}
+
 TEST_F(ServiceRequestQueueTest, Timeout) {
   queue_.Push(mojom::ProcessIdentity::New(), std::nullopt,
               mojo::ScopedMessagePipeHandle{});
@@ -7,7 +7,10 @@
 #include <sys/fcntl.h>
 #include <unistd.h>
 
+#include <cstdio>
+#include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include <base/files/file_util.h>
@@ -51,16 +54,14 @@ void OcrServiceImpl::GenerateSearchablePdfFromImage(
     GenerateSearchablePdfFromImageCallback callback) {
   mojo_ipc::OpticalCharacterRecognitionServiceResponse response;
 
-  std::unique_ptr<tesseract::TessBaseAPI> api =
-      std::make_unique<tesseract::TessBaseAPI>();
-  if (api->Init(kTessdataPath, ocr_config->language.c_str())) {
+  tesseract::TessBaseAPI* const api = GetEngine(ocr_config->language);
+  if (!api) {
     LOG(ERROR) << "Could not initialize tesseract.";
     response.result = mojo_ipc::OcrResultEnum::LANGUAGE_NOT_SUPPORTED_ERROR;
     response.result_message =
         base::StringPrintf("Could not initialize tesseract with language %s.",
                            ocr_config->language.c_str());
     std::move(callback).Run(response.Clone());
-    api->End();
     return;
   }
 
@@ -72,7 +73,7 @@ void OcrServiceImpl::GenerateSearchablePdfFromImage(
     response.result = mojo_ipc::OcrResultEnum::INPUT_FILE_ERROR;
     response.result_message = "Invalid input image ScopedFD.";
     std::move(callback).Run(response.Clone());
-    api->End();
+    api->Clear();
     return;
   }
 
@@ -81,10 +82,15 @@ void OcrServiceImpl::GenerateSearchablePdfFromImage(
     response.result = mojo_ipc::OcrResultEnum::INPUT_FILE_ERROR;
     response.result_message = "Invalid input image file descriptor.";
     std::move(callback).Run(response.Clone());
-    api->End();
+    api->Clear();
     return;
   }
 
+  // Tesseract reads "stdin" through std::cin. Clear the end-of-file state left
+  // by the previous request, so that the new input is read.
+  clearerr(stdin);
+  std::cin.clear();
+
   // Redirect the standard output to the output PDF file.
   int stdout_fd_copy = HANDLE_EINTR(dup(STDOUT_FILENO));
   base::ScopedFD output_file(
@@ -94,7 +100,7 @@ void OcrServiceImpl::GenerateSearchablePdfFromImage(
     response.result = mojo_ipc::OcrResultEnum::OUTPUT_FILE_ERROR;
     response.result_message = "Invalid output PDF ScopedFD.";
     std::move(callback).Run(response.Clone());
-    api->End();
+    api->Clear();
     return;
   }
 
@@ -103,7 +109,7 @@ void OcrServiceImpl::GenerateSearchablePdfFromImage(
     response.result = mojo_ipc::OcrResultEnum::OUTPUT_FILE_ERROR;
     response.result_message = "Invalid output image file descriptor.";
     std::move(callback).Run(response.Clone());
-    api->End();
+    api->Clear();
     return;
   }
 
@@ -113,7 +119,8 @@ void OcrServiceImpl::GenerateSearchablePdfFromImage(
           "stdout", api->GetDatapath(), pdf_renderer_config->textonly);
   bool success = api->ProcessPages("stdin", nullptr, ocr_config->timeout_ms,
                                    renderer.get());
-  api->End();
+  // Free the recognition results but keep the trained data loaded.
+  api->Clear();
 
   // Restore stdout.
   if (fflush(stdout)) {
@@ -140,6 +147,21 @@ void OcrServiceImpl::GenerateSearchablePdfFromImage(
   std::move(callback).Run(response.Clone());
 }
 
+tesseract::TessBaseAPI* OcrServiceImpl::GetEngine(
+    const std::string& language) {
+  if (engine_ && engine_language_ == language)
+    return engine_.get();
+
+  engine_ = std::make_unique<tesseract::TessBaseAPI>();
+  engine_language_.clear();
+  if (engine_->Init(kTessdataPath, language.c_str())) {
+    engine_.reset();
+    return nullptr;
+  }
+  engine_language_ = language;
+  return engine_.get();
+}
+
 void OcrServiceImpl::AddReceiver(
     mojo::PendingReceiver<mojo_ipc::OpticalCharacterRecognitionService>
         pending_receiver,
@@ -5,6 +5,9 @@
 #ifndef OCR_OCR_SERVICE_IMPL_H_
 #define OCR_OCR_SERVICE_IMPL_H_
 
+#include <memory>
+#include <string>
+
 #include <base/functional/callback.h>
 #include <mojo/public/cpp/bindings/pending_receiver.h>
 #include <mojo/public/cpp/bindings/receiver_set.h>
@@ -12,6 +15,10 @@
 
 #include "ocr/mojo/ocr_service.mojom.h"
 
+namespace tesseract {
+class TessBaseAPI;
+}  // namespace tesseract
+
 namespace ocr {
 
 using OcrServiceReceiverSet =
@@ -53,6 +60,11 @@ class OcrServiceImpl final
   // context_value (should_quit) of the receiver.
   void OnDisconnect();
 
+  // Returns a Tesseract engine initialized for |language|, or nullptr if the
+  // language can't be loaded. The engine is kept warm between requests, so
+  // that consecutive pages in the same language don't reload the trained data.
+  tesseract::TessBaseAPI* GetEngine(const std::string& language);
+
   // Receiver set that connects this instance (which is an implementation of
   // chromeos::ocr::mojom::OpticalCharacterRecognitionService) with any message
   // pipes set up on top of received file descriptors.
@@ -62,6 +74,11 @@ class OcrServiceImpl final
 
   // Callback used to notify OcrDaemon of receiver disconnects.
   base::RepeatingCallback<void(bool)> on_disconnect_callback_;
+
+  // The engine returned by GetEngine(), and its language. Only one engine is
+  // kept, as each one holds the trained data of its language in memory.
+  std::unique_ptr<tesseract::TessBaseAPI> engine_;
+  std::string engine_language_;
 };
 
 }  // namespace ocr
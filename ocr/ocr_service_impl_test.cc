@@ -105,6 +105,40 @@ TEST_F(OcrServiceImplTest, GenerateSearchablePdfFromImageSuccess) {
   ASSERT_TRUE(ocr_callback_done);
 }
 
+// Tests that the engine kept between requests is reset properly, including
+// after a request in an unsupported language.
+TEST_F(OcrServiceImplTest, GenerateSearchablePdfFromImageRepeatedly) {
+  const std::string input_image_filename =
+      base::FilePath(kTestImageRelativePath).value();
+  const std::string output_filename =
+      temp_dir_path().Append(kOutputPdfFilename).value();
+
+  for (const char* language : {"eng", "deu", "eng"}) {
+    mojo_ipc::OcrConfigPtr ocr_config = mojo_ipc::OcrConfig::New();
+    ocr_config->language = language;
+    const mojo_ipc::OcrResultEnum expected_result =
+        ocr_config->language == "eng"
+            ? mojo_ipc::OcrResultEnum::SUCCESS
+            : mojo_ipc::OcrResultEnum::LANGUAGE_NOT_SUPPORTED_ERROR;
+
+    bool ocr_callback_done = false;
+    ocr_service()->GenerateSearchablePdfFromImage(
+        GetInputFileHandle(input_image_filename),
+        GetOutputFileHandle(output_filename), std::move(ocr_config),
+        mojo_ipc::PdfRendererConfig::New(),
+        base::BindOnce(
+            [](bool* ocr_callback_done, mojo_ipc::OcrResultEnum expected_result,
+               const mojo_ipc::OpticalCharacterRecognitionServiceResponsePtr
+                   response) {
+              EXPECT_EQ(response->result, expected_result);
+              *ocr_callback_done = true;
+            },
+            &ocr_callback_done, expected_result));
+    base::RunLoop().RunUntilIdle();
+    ASSERT_TRUE(ocr_callback_done) << language;
+  }
+}
+
 TEST_F(OcrServiceImplTest, OcrFailToLoadLanguage) {
   // Construct request.
   const std::string input_image_filename =
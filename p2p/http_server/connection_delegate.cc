@@ -9,6 +9,7 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <stdint.h>
+#include <sys/sendfile.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -21,6 +22,7 @@
 #include <cerrno>
 #include <cinttypes>
 #include <iomanip>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -35,6 +37,7 @@
 #include "p2p/common/server_message.h"
 #include "p2p/common/util.h"
 #include "p2p/http_server/server.h"
+#include "p2p/http_server/token_bucket.h"
 
 using std::map;
 using std::string;
@@ -64,7 +67,8 @@ ConnectionDelegate::ConnectionDelegate(int dirfd,
       pretty_addr_(pretty_addr),
       server_(server),
       max_download_rate_(max_download_rate),
-      total_bytes_sent_(0) {
+      total_bytes_sent_(0),
+      peak_speed_(0) {
   CHECK_NE(-1, fd_);
   CHECK(server_ != NULL);
 }
@@ -331,32 +335,47 @@ static bool ParseRange(const string& range_str,
   return false;
 }
 
-bool ConnectionDelegate::SendFile(int file_fd, size_t num_bytes_to_send) {
+bool ConnectionDelegate::SendFile(int file_fd,
+                                  off_t offset,
+                                  size_t num_bytes_to_send) {
   ClockInterface* clock;
   total_time_spent_ = TimeDelta();
+  peak_speed_ = 0;
   int seconds_spent_waiting = 0;
-  char buf[kPayloadBufferSize];
+  size_t window_bytes_sent = 0;
+  TimeDelta window_time_spent;
 
   clock = server_->Clock();
 
+  std::unique_ptr<TokenBucket> bucket;
+  if (max_download_rate_ != 0) {
+    bucket = std::make_unique<TokenBucket>(
+        max_download_rate_,
+        static_cast<int64_t>(max_download_rate_ *
+                             kMaxBurstDuration.InSecondsF()),
+        clock->GetMonotonicTime());
+  }
+
   total_bytes_sent_ = 0;
   while (total_bytes_sent_ < num_bytes_to_send) {
-    size_t num_to_read =
-        std::min(sizeof buf, num_bytes_to_send - total_bytes_sent_);
-    size_t num_to_send_from_buf;
-    size_t num_sent_from_buf;
-    ssize_t num_read;
+    size_t num_to_send = std::min(static_cast<size_t>(kPayloadBufferSize),
+                                  num_bytes_to_send - total_bytes_sent_);
+    ssize_t num_sent;
 
+    // sendfile(2) sends the file from the page cache, without copying it to
+    // userspace first.
     Time time_start = clock->GetMonotonicTime();
-    num_read = read(file_fd, buf, num_to_read);
-    if (num_read == 0) {
+    num_sent = sendfile(fd_, file_fd, &offset, num_to_send);
+    if (num_sent == 0) {
       // EOF - handle this by sleeping and trying again later.
       VLOG(1) << "Got EOF so sleeping one second";
       // Don't include the time sleeping in total_time_spent_.
       total_time_spent_ += clock->GetMonotonicTime() - time_start;
       clock->Sleep(base::Seconds(1));
-      time_start = clock->GetMonotonicTime();
       seconds_spent_waiting++;
+      // Likewise, waiting for content doesn't allow sending faster later.
+      if (bucket)
+        bucket->Skip(clock->GetMonotonicTime());
 
       // Give up if socket is no longer connected.
       if (IsStillConnected()) {
@@ -365,51 +384,42 @@ bool ConnectionDelegate::SendFile(int file_fd, size_t num_bytes_to_send) {
         LOG(INFO) << pretty_addr_ << " - peer no longer connected; giving up";
         return false;
       }
-    } else if (num_read < 0) {
-      // Note that the file is expected to be on a filesystem so Linux
-      // guarantees that we never get EAGAIN. In other words, we never
-      // get partial reads e.g. either we get everything we ask for or
-      // none of it.
-      PLOG(ERROR) << "Error reading";
+    } else if (num_sent < 0) {
+      PLOG(ERROR) << "Error sending";
       return false;
     }
 
-    num_to_send_from_buf = num_read;
-    num_sent_from_buf = 0;
-    while (num_to_send_from_buf > 0) {
-      ssize_t num_sent =
-          send(fd_, buf + num_sent_from_buf, num_to_send_from_buf, 0);
-      if (num_sent == -1) {
-        PLOG(ERROR) << "Error sending";
-        return false;
+    total_bytes_sent_ += num_sent;
+    window_bytes_sent += num_sent;
+
+    // Limit download speed, if requested, by waiting until the bytes sent
+    // are paid for.
+    if (bucket) {
+      bucket->Refill(clock->GetMonotonicTime());
+      TimeDelta wait = bucket->Consume(num_sent);
+      if (wait.is_positive()) {
+        clock->Sleep(wait);
+        bucket->Refill(clock->GetMonotonicTime());
       }
-      CHECK_GT(num_sent, 0);
-      num_to_send_from_buf -= num_sent;
-      num_sent_from_buf += num_sent;
     }
-    total_bytes_sent_ += num_sent_from_buf;
-    total_time_spent_ += clock->GetMonotonicTime() - time_start;
-
-    // Limit download speed, if requested. Right now the speed is
-    // calculated by considering the entire download session - this
-    // could be improved by using e.g. a sliding window over the last
-    // 30 seconds or so.
-    if (max_download_rate_ != 0) {
-      int64_t bytes_allowed =
-          max_download_rate_ * total_time_spent_.InSecondsF();
-      if (static_cast<int64_t>(total_bytes_sent_) > bytes_allowed) {
-        int64_t over_budget =
-            static_cast<int64_t>(total_bytes_sent_) - bytes_allowed;
-        int64_t usec_to_sleep =
-            (over_budget / static_cast<double>(max_download_rate_)) *
-            Time::kMicrosecondsPerSecond;
-        TimeDelta sleep_duration = base::Microseconds(usec_to_sleep);
-        clock->Sleep(sleep_duration);
-        total_time_spent_ += sleep_duration;
-      }
+    TimeDelta time_spent = clock->GetMonotonicTime() - time_start;
+    total_time_spent_ += time_spent;
+
+    // Track the peak speed over windows of |kPeakSpeedWindow|.
+    window_time_spent += time_spent;
+    if (window_time_spent >= kPeakSpeedWindow) {
+      peak_speed_ =
+          std::max(peak_speed_,
+                   window_bytes_sent / window_time_spent.InSecondsF());
+      window_bytes_sent = 0;
+      window_time_spent = TimeDelta();
     }
   }
 
+  // Transfers shorter than a window peak at their average speed.
+  if (peak_speed_ == 0 && total_time_spent_.is_positive())
+    peak_speed_ = total_bytes_sent_ / total_time_spent_.InSecondsF();
+
   // If we served a file, log the time it took us.
   double total_seconds_spent =
       total_time_spent_.InSecondsF() + seconds_spent_waiting;
@@ -418,7 +428,8 @@ bool ConnectionDelegate::SendFile(int file_fd, size_t num_bytes_to_send) {
               << " bytes of response body in " << std::fixed
               << std::setprecision(3) << total_seconds_spent << " seconds"
               << " (" << (total_bytes_sent_ / total_seconds_spent / 1e6)
-              << " MB/s) including " << seconds_spent_waiting
+              << " MB/s, peak " << (peak_speed_ / 1e6) << " MB/s) including "
+              << seconds_spent_waiting
               << " seconds spent waiting for content in the file.";
   }
 
@@ -436,9 +447,10 @@ void ConnectionDelegate::ReportSendFileMetrics(bool send_file_result) {
   server_->ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps,
                                average_speed_kbps);
 
-  // TODO(deymo): Compute and report the P2P.Server.PeakDownloadSpeedKBps also
-  // handling better the download speed computed in this function to consider
-  // only a window of time instead of the average speed for the whole file.
+  // Report P2P.Server.PeakDownloadSpeedKBps with the highest speed over a
+  // window of |kPeakSpeedWindow|, every time a file was served.
+  server_->ReportServerMessage(p2p::util::kP2PServerPeakDownloadSpeedKBps,
+                               peak_speed_ / kBytesPerKB);
 
   // Handle the error condition.
   if (!send_file_result) {
@@ -585,15 +597,6 @@ P2PServerRequestResult ConnectionDelegate::ServiceHttpRequest(
     goto out;
   }
 
-  if (range_first > 0) {
-    if (lseek(file_fd, static_cast<off_t>(range_first), SEEK_SET) !=
-        static_cast<off_t>(range_first)) {
-      PLOG(ERROR) << "Error seeking";
-      req_res = p2p::util::kP2PRequestResultNotFound;
-      goto out;
-    }
-  }
-
   // From now on, we don't report a result as Malformed. Report the
   // P2P.Server.RangeBeginPercentage at the begining of the file serving period,
   // since it is being reported either the transmission is interrupted or nor.
@@ -603,7 +606,8 @@ P2PServerRequestResult ConnectionDelegate::ServiceHttpRequest(
                                range_begin_percentage);
 
   // Send the file and report the metrics associated with the transfer.
-  send_file_result = SendFile(file_fd, range_len);
+  send_file_result =
+      SendFile(file_fd, static_cast<off_t>(range_first), range_len);
   ReportSendFileMetrics(send_file_result);
 
   req_res = send_file_result ? p2p::util::kP2PRequestResultResponseSent
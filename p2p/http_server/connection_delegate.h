@@ -6,12 +6,14 @@
 #define P2P_HTTP_SERVER_CONNECTION_DELEGATE_H_
 
 #include <glib.h>
+#include <sys/types.h>
 
 #include <map>
 #include <string>
 
 #include <base/command_line.h>
 #include <base/threading/simple_thread.h>
+#include <base/time/time.h>
 
 #include "p2p/common/server_message.h"
 #include "p2p/http_server/connection_delegate_interface.h"
@@ -89,22 +91,22 @@ class ConnectionDelegate : public ConnectionDelegateInterface {
       const std::map<std::string, std::string>& headers);
 
   // Sends |num_bytes_to_send_bytes| from the file represented by the
-  // file descriptor |file_fd|. Returns false if an error occurs while
-  // doing this.
+  // file descriptor |file_fd|, starting at |offset|. Returns false if an
+  // error occurs while doing this.
   //
-  // The implementation will read |kPayloadBufferSize| at once (except
-  // for at the end where it is clipped accordingly) and send this
-  // to the other end.
+  // The implementation will sendfile(2) up to |kPayloadBufferSize| at
+  // once (except for at the end where it is clipped accordingly) to the
+  // other end.
   //
-  // If read(2) returns EOF, will sleep for one second and then retry.
+  // If sendfile(2) hits EOF, will sleep for one second and then retry.
   // This is for situations where the final file size is known in
   // advance (e.g. read from the user.cros-p2p-filesize xattr) but
   // all content has not yet been downloaded.
   //
-  // The implementation will limit download speed by sleeping after
-  // sending each chunk, if necessary. See the |max_download_rate_|
-  // instance variable.
-  bool SendFile(int file_fd, size_t num_bytes_to_send);
+  // The implementation will limit download speed with a TokenBucket,
+  // sleeping after sending a chunk if necessary. See the
+  // |max_download_rate_| instance variable.
+  bool SendFile(int file_fd, off_t offset, size_t num_bytes_to_send);
 
   // Sends the metrics associated with the last SendFile() call.
   void ReportSendFileMetrics(bool send_file_result);
@@ -153,6 +155,10 @@ class ConnectionDelegate : public ConnectionDelegateInterface {
   // call to SendFile(). Used to report metrics.
   base::TimeDelta total_time_spent_;
 
+  // The peak speed (in bytes/second) during the last call to SendFile().
+  // Used to report metrics.
+  double peak_speed_;
+
   // Maximum number of headers support in HTTP request.
   static const unsigned int kMaxHeaders = 100;
 
@@ -162,7 +168,7 @@ class ConnectionDelegate : public ConnectionDelegateInterface {
   // Number of bytes to read at once when processing HTTP headers.
   static const unsigned int kLineBufSize = 256;
 
-  // Number of bytes to read/send at once. With a max speed of 125
+  // Number of bytes to send at once. With a max speed of 125
   // kB/s - see common/constants.h - 64 KiB works out to sending
   // approximately twice a second.
   //
@@ -172,6 +178,13 @@ class ConnectionDelegate : public ConnectionDelegateInterface {
   //
   // https://code.google.com/p/chromium/issues/detail?id=246325
   static const unsigned int kPayloadBufferSize = 65536;
+
+  // Maximum time worth of data that can be sent at once when the download
+  // rate is limited, e.g. after the peer was slow to receive.
+  static constexpr base::TimeDelta kMaxBurstDuration = base::Seconds(1);
+
+  // Window over which the peak download speed is computed.
+  static constexpr base::TimeDelta kPeakSpeedWindow = base::Seconds(1);
 };
 
 }  // namespace http_server
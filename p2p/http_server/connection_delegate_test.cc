@@ -41,6 +41,9 @@ using p2p::testutil::SetupTestDir;
 using p2p::testutil::TeardownTestDir;
 
 using testing::_;
+using testing::AllOf;
+using testing::Ge;
+using testing::Le;
 
 namespace {
 // DefaultDownloadRate used for the tests in bytes per seconds (5MB/s).
@@ -429,6 +432,8 @@ TEST_F(ConnectionDelegateTest, GetExistentFile) {
                                 p2p::util::kP2PServerServedSuccessfullyMB, 0));
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, _));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, _));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 0));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -465,6 +470,8 @@ TEST_F(ConnectionDelegateTest, PostExistentFile) {
                                   8));  // Almost 9 MB served.
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, _));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, _));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 0));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -499,6 +506,8 @@ TEST_F(ConnectionDelegateTest, GetEmptyFile) {
   // kP2PServerServedSuccessfullyMB is reported.
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, 0));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, 0));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 0));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -533,6 +542,8 @@ TEST_F(ConnectionDelegateTest, GetRangeOfFile) {
                                 p2p::util::kP2PServerServedSuccessfullyMB, 0));
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, _));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, _));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 25));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -599,6 +610,8 @@ TEST_F(ConnectionDelegateTest, GetLastPartOfFile) {
                                 p2p::util::kP2PServerServedSuccessfullyMB, 0));
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, _));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, _));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 80));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -649,6 +662,8 @@ TEST_F(ConnectionDelegateTest, GetIncompleteFile) {
               ReportServerMessage(p2p::util::kP2PServerServedInterruptedMB, 0));
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, _));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, _));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 0));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -694,6 +709,8 @@ TEST_F(ConnectionDelegateTest, GetPartOfIncompleteFile) {
                                 p2p::util::kP2PServerServedSuccessfullyMB, 0));
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, _));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, _));
   // Total file size is 10KB, but actual file size is 5KB. A range starting
   // at 2KB should be reported as 20%.
   EXPECT_CALL(mock_server_, ReportServerMessage(
@@ -838,6 +855,8 @@ TEST_F(ConnectionDelegateTest, Waiting) {
                                 p2p::util::kP2PServerServedSuccessfullyMB, 0));
   EXPECT_CALL(mock_server_,
               ReportServerMessage(p2p::util::kP2PServerDownloadSpeedKBps, _));
+  EXPECT_CALL(mock_server_, ReportServerMessage(
+                                p2p::util::kP2PServerPeakDownloadSpeedKBps, _));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 0));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -908,6 +927,10 @@ TEST_F(ConnectionDelegateTest, LimitDownloadSpeed) {
   // this test (kDefaultDownloadRate).
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerDownloadSpeedKBps, 5000));
+  // So should the peak speed, up to rounding.
+  EXPECT_CALL(mock_server_,
+              ReportServerMessage(p2p::util::kP2PServerPeakDownloadSpeedKBps,
+                                  AllOf(Ge(4999), Le(5000))));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 0));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
@@ -955,6 +978,10 @@ TEST_F(ConnectionDelegateTest, DisregardTimeWaitingFromTransferBudget) {
   // this test (kDefaultDownloadRate).
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerDownloadSpeedKBps, 5000));
+  // So should the peak speed, up to rounding.
+  EXPECT_CALL(mock_server_,
+              ReportServerMessage(p2p::util::kP2PServerPeakDownloadSpeedKBps,
+                                  AllOf(Ge(4999), Le(5000))));
   EXPECT_CALL(mock_server_, ReportServerMessage(
                                 p2p::util::kP2PServerRangeBeginPercentage, 0));
   EXPECT_CALL(mock_server_, ConnectionTerminated(delegate_));
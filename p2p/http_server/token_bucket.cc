@@ -0,0 +1,47 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "p2p/http_server/token_bucket.h"
+
+#include <algorithm>
+
+#include <base/check_op.h>
+
+namespace p2p {
+
+namespace http_server {
+
+TokenBucket::TokenBucket(int64_t rate, int64_t capacity, base::Time now)
+    : rate_(rate), capacity_(capacity), tokens_(0), last_refill_(now) {
+  CHECK_GT(rate_, 0);
+  CHECK_GE(capacity_, 0);
+}
+
+void TokenBucket::Refill(base::Time now) {
+  if (now > last_refill_) {
+    tokens_ = std::min(
+        static_cast<double>(capacity_),
+        tokens_ + (now - last_refill_).InSecondsF() * rate_);
+  }
+  last_refill_ = now;
+}
+
+void TokenBucket::Skip(base::Time now) {
+  last_refill_ = now;
+}
+
+base::TimeDelta TokenBucket::Consume(int64_t num_bytes) {
+  tokens_ -= num_bytes;
+  if (tokens_ >= 0)
+    return base::TimeDelta();
+
+  // Round down so that the next Refill() doesn't earn more than the debt;
+  // what is left of it is repaid by the next wait.
+  return base::Microseconds(static_cast<int64_t>(
+      -tokens_ * base::Time::kMicrosecondsPerSecond / rate_));
+}
+
+}  // namespace http_server
+
+}  // namespace p2p
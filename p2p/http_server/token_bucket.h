@@ -0,0 +1,63 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef P2P_HTTP_SERVER_TOKEN_BUCKET_H_
+#define P2P_HTTP_SERVER_TOKEN_BUCKET_H_
+
+#include <stdint.h>
+
+#include <base/time/time.h>
+
+namespace p2p {
+
+namespace http_server {
+
+// Token bucket used to limit the rate at which a connection sends data.
+//
+// The bucket earns |rate| tokens (bytes) per second, up to |capacity|
+// tokens, and each byte sent takes one token. Sending more than what is
+// available puts the bucket in debt, and the sender has to wait for the
+// debt to be repaid; this lets the sender use large chunks without
+// exceeding the rate on average.
+class TokenBucket {
+ public:
+  // Constructs an empty bucket earning |rate| tokens per second from
+  // |now| on. |rate| must be positive.
+  TokenBucket(int64_t rate, int64_t capacity, base::Time now);
+  TokenBucket(const TokenBucket&) = delete;
+  TokenBucket& operator=(const TokenBucket&) = delete;
+
+  // Adds the tokens earned between the last call and |now|.
+  void Refill(base::Time now);
+
+  // Moves the reference time to |now| without earning any token, e.g.
+  // when the time since the last call wasn't spent sending.
+  void Skip(base::Time now);
+
+  // Takes |num_bytes| tokens and returns how long the caller needs to wait
+  // before the bucket is out of debt.
+  base::TimeDelta Consume(int64_t num_bytes);
+
+  // Returns the number of tokens in the bucket. Negative if in debt.
+  double tokens() const { return tokens_; }
+
+ private:
+  // The number of tokens earned per second.
+  const int64_t rate_;
+
+  // The maximum number of tokens in the bucket.
+  const int64_t capacity_;
+
+  // The number of tokens currently in the bucket.
+  double tokens_;
+
+  // The time up to which tokens were earned.
+  base::Time last_refill_;
+};
+
+}  // namespace http_server
+
+}  // namespace p2p
+
+#endif  // P2P_HTTP_SERVER_TOKEN_BUCKET_H_
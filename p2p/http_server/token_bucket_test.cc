@@ -0,0 +1,83 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "p2p/http_server/token_bucket.h"
+
+#include <base/time/time.h>
+#include <gtest/gtest.h>
+
+namespace p2p {
+
+namespace http_server {
+
+namespace {
+// Rate used for the tests in bytes per seconds (1MB/s).
+constexpr int64_t kRate = 1000 * 1000;
+}  // namespace
+
+TEST(TokenBucketTest, StartsEmpty) {
+  base::Time now = base::Time::Now();
+  TokenBucket bucket(kRate, kRate, now);
+  EXPECT_DOUBLE_EQ(0, bucket.tokens());
+
+  // Sending without waiting puts the bucket in debt.
+  EXPECT_EQ(base::Milliseconds(500), bucket.Consume(kRate / 2));
+  EXPECT_DOUBLE_EQ(-kRate / 2, bucket.tokens());
+
+  // Waiting repays the debt.
+  now += base::Milliseconds(500);
+  bucket.Refill(now);
+  EXPECT_DOUBLE_EQ(0, bucket.tokens());
+  EXPECT_EQ(base::TimeDelta(), bucket.Consume(0));
+}
+
+TEST(TokenBucketTest, EarnsTokensUpToCapacity) {
+  base::Time now = base::Time::Now();
+  TokenBucket bucket(kRate, kRate / 10, now);
+
+  now += base::Milliseconds(50);
+  bucket.Refill(now);
+  EXPECT_DOUBLE_EQ(kRate / 20, bucket.tokens());
+  EXPECT_EQ(base::TimeDelta(), bucket.Consume(kRate / 20));
+
+  // A long idle period doesn't allow more than |capacity| bytes at once.
+  now += base::Seconds(10);
+  bucket.Refill(now);
+  EXPECT_DOUBLE_EQ(kRate / 10, bucket.tokens());
+  EXPECT_EQ(base::Milliseconds(100), bucket.Consume(kRate / 5));
+}
+
+TEST(TokenBucketTest, Skip) {
+  base::Time now = base::Time::Now();
+  TokenBucket bucket(kRate, kRate, now);
+  EXPECT_EQ(base::Seconds(1), bucket.Consume(kRate));
+
+  // Time skipped doesn't repay the debt.
+  now += base::Seconds(5);
+  bucket.Skip(now);
+  bucket.Refill(now);
+  EXPECT_DOUBLE_EQ(-kRate, bucket.tokens());
+
+  now += base::Seconds(1);
+  bucket.Refill(now);
+  EXPECT_DOUBLE_EQ(0, bucket.tokens());
+}
+
+TEST(TokenBucketTest, AverageRate) {
+  // Sending in chunks that don't divide the rate doesn't drift from it.
+  base::Time start = base::Time::Now();
+  base::Time now = start;
+  TokenBucket bucket(kRate, kRate, now);
+  for (int i = 0; i < 1000; ++i) {
+    now += bucket.Consume(7777);
+    bucket.Refill(now);
+  }
+  base::TimeDelta expected = base::Seconds(7777 * 1000.0 / kRate);
+  EXPECT_LE(now - start, expected);
+  EXPECT_GE(now - start, expected - base::Microseconds(1));
+}
+
+}  // namespace http_server
+
+}  // namespace p2p
@@ -109,6 +109,7 @@ void AdbProxy::OnFileCanReadWithoutBlocking() {
       auto fwd = std::make_unique<SocketForwarder>(
           base::StringPrintf("adbp%d-%d", client_conn->fd(), adbd_conn->fd()),
           std::move(client_conn), std::move(adbd_conn));
+      fwd->SetZeroCopy(true);
       fwd->Start();
       fwd_.emplace_back(std::move(fwd));
     }
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include <base/functional/bind.h>
 #include <base/logging.h>
@@ -31,7 +32,7 @@
 namespace {
 
 constexpr net_base::IPv4Address kBcastAddr(255, 255, 255, 255);
-constexpr int kBufSize = 4096;
+constexpr size_t kBufSize = 4096;
 constexpr uint16_t kIpFragOffsetMask = 0x1FFF;
 // Broadcast forwarder will not forward system ports (0 - 1023).
 constexpr uint16_t kMinValidPort = 1024;
@@ -342,95 +343,124 @@ void BroadcastForwarder::RemoveGuest(const std::string& br_ifname) {
 }
 
 void BroadcastForwarder::OnFileCanReadWithoutBlocking(int fd) {
-  alignas(4) uint8_t buffer[kBufSize];
-  uint8_t* data = buffer + sizeof(struct iphdr) + sizeof(struct udphdr);
-
-  sockaddr_ll dst_addr;
-  struct iovec iov = {
-      .iov_base = buffer,
-      .iov_len = kBufSize,
-  };
-  msghdr hdr = {
-      .msg_name = &dst_addr,
-      .msg_namelen = sizeof(dst_addr),
-      .msg_iov = &iov,
-      .msg_iovlen = 1,
-      .msg_control = nullptr,
-      .msg_controllen = 0,
-      .msg_flags = 0,
-  };
+  // Every slot of the buffer starts at a multiple of kBufSize, so that the
+  // headers taken directly from it are 4 bytes aligned.
+  receive_buffer_.resize(kMaxBatchSize * kBufSize);
+  sockaddr_ll dst_addrs[kMaxBatchSize];
+  struct iovec iovs[kMaxBatchSize];
+  struct mmsghdr msgs[kMaxBatchSize];
+  memset(msgs, 0, sizeof(msgs));
+  for (unsigned int i = 0; i < kMaxBatchSize; i++) {
+    iovs[i].iov_base = receive_buffer_.data() + i * kBufSize;
+    iovs[i].iov_len = kBufSize;
+    msgs[i].msg_hdr.msg_name = &dst_addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(dst_addrs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
 
-  ssize_t msg_len = ReceiveMessage(fd, &hdr);
-  if (msg_len < 0) {
+  stats_.receive_syscalls++;
+  int r = ReceiveMessages(fd, msgs, kMaxBatchSize);
+  if (r < 0) {
     // Ignore ENETDOWN: this can happen if the interface is not yet configured.
     if (errno != ENETDOWN) {
-      PLOG(WARNING) << "recvmsg() failed";
+      PLOG(WARNING) << "recvmmsg() failed";
     }
     return;
   }
+  const unsigned int num_msgs =
+      std::min(static_cast<unsigned int>(r), kMaxBatchSize);
+  stats_.packets_received += num_msgs;
+
+  const bool from_dev = dev_socket_ && fd == dev_socket_->fd.get();
+  const Socket* br_socket = nullptr;
+  if (!from_dev) {
+    for (auto const& socket : br_sockets_) {
+      if (fd == socket.second->fd.get()) {
+        br_socket = socket.second.get();
+        break;
+      }
+    }
+    if (!br_socket)
+      return;
+  }
 
-  // These headers are taken directly from the buffer and is 4 bytes aligned.
-  struct iphdr* ip_hdr = (struct iphdr*)(buffer);
-  struct udphdr* udp_hdr = (struct udphdr*)(buffer + sizeof(struct iphdr));
+  std::vector<Packet> ingress_packets;
+  for (unsigned int i = 0; i < num_msgs; i++) {
+    const uint8_t* buffer = static_cast<const uint8_t*>(iovs[i].iov_base);
+    const uint8_t* data = buffer + sizeof(struct iphdr) + sizeof(struct udphdr);
+    const size_t msg_len =
+        std::min(static_cast<size_t>(msgs[i].msg_len), kBufSize);
 
-  // Check that the IP header and UDP header have been filled.
-  if (msg_len < sizeof(struct iphdr) + sizeof(struct udphdr))
-    return;
+    // These headers are taken directly from the buffer and is 4 bytes aligned.
+    const struct iphdr* ip_hdr = (const struct iphdr*)(buffer);
+    const struct udphdr* udp_hdr =
+        (const struct udphdr*)(buffer + sizeof(struct iphdr));
 
-  // Drop fragmented packets.
-  if ((ntohs(ip_hdr->frag_off) & (kIpFragOffsetMask | IP_MF)) != 0)
-    return;
+    // Check that the IP header and UDP header have been filled.
+    if (msg_len < sizeof(struct iphdr) + sizeof(struct udphdr))
+      continue;
 
-  // Store the length of the message data without its headers.
-  if (ntohs(udp_hdr->len) < sizeof(struct udphdr)) {
-    return;
-  }
-  size_t len = ntohs(udp_hdr->len) - sizeof(struct udphdr);
+    // Drop fragmented packets.
+    if ((ntohs(ip_hdr->frag_off) & (kIpFragOffsetMask | IP_MF)) != 0)
+      continue;
 
-  // Validate message data length.
-  if (len + sizeof(struct udphdr) + sizeof(struct iphdr) > msg_len) {
-    return;
-  }
+    // Store the length of the message data without its headers.
+    if (ntohs(udp_hdr->len) < sizeof(struct udphdr)) {
+      continue;
+    }
+    size_t len = ntohs(udp_hdr->len) - sizeof(struct udphdr);
 
-  struct sockaddr_in fromaddr = {0};
-  fromaddr.sin_family = AF_INET;
-  fromaddr.sin_port = udp_hdr->uh_sport;
-  fromaddr.sin_addr.s_addr = ip_hdr->saddr;
+    // Validate message data length.
+    if (len + sizeof(struct udphdr) + sizeof(struct iphdr) > msg_len) {
+      continue;
+    }
 
-  struct sockaddr_in dst = {0};
-  dst.sin_family = AF_INET;
-  dst.sin_port = udp_hdr->uh_dport;
-  dst.sin_addr.s_addr = ip_hdr->daddr;
+    struct sockaddr_in fromaddr = {0};
+    fromaddr.sin_family = AF_INET;
+    fromaddr.sin_port = udp_hdr->uh_sport;
+    fromaddr.sin_addr.s_addr = ip_hdr->saddr;
 
-  // Forward ingress traffic to guests.
-  if (fd == dev_socket_->fd.get()) {
-    // Prevent looped back broadcast packets to be forwarded.
-    if (net_base::IPv4Address(fromaddr.sin_addr) == dev_socket_->addr)
-      return;
+    struct sockaddr_in dst = {0};
+    dst.sin_family = AF_INET;
+    dst.sin_port = udp_hdr->uh_dport;
+    dst.sin_addr.s_addr = ip_hdr->daddr;
 
-    SendToGuests(buffer, len, dst);
-    return;
-  }
+    // Forward ingress traffic to guests.
+    if (from_dev) {
+      // Prevent looped back broadcast packets to be forwarded.
+      if (net_base::IPv4Address(fromaddr.sin_addr) == dev_socket_->addr)
+        continue;
 
-  for (auto const& socket : br_sockets_) {
-    if (fd != socket.second->fd.get())
+      ingress_packets.push_back({buffer, len, dst});
       continue;
+    }
 
     // Prevent looped back broadcast packets to be forwarded.
-    if (net_base::IPv4Address(fromaddr.sin_addr) == socket.second->addr)
-      return;
+    if (net_base::IPv4Address(fromaddr.sin_addr) == br_socket->addr)
+      continue;
 
     // We are spoofing packets source IP to be the actual sender source IP.
     // Prevent looped back broadcast packets by not forwarding anything from
     // outside the interface netmask.
-    if ((fromaddr.sin_addr.s_addr & socket.second->netmask.ToInAddr().s_addr) !=
-        (socket.second->addr.ToInAddr().s_addr &
-         socket.second->netmask.ToInAddr().s_addr))
-      return;
+    if ((fromaddr.sin_addr.s_addr & br_socket->netmask.ToInAddr().s_addr) !=
+        (br_socket->addr.ToInAddr().s_addr &
+         br_socket->netmask.ToInAddr().s_addr))
+      continue;
 
     // Forward egress traffic from one guest to outside network.
     SendToNetwork(ntohs(fromaddr.sin_port), data, len, dst);
   }
+
+  if (!ingress_packets.empty()) {
+    SendToGuests(ingress_packets);
+  }
+}
+
+ForwarderStats BroadcastForwarder::TakeStats() {
+  ForwarderStats stats = stats_;
+  stats_ = {};
+  return stats;
 }
 
 bool BroadcastForwarder::SendToNetwork(uint16_t src_port,
@@ -450,6 +480,7 @@ bool BroadcastForwarder::SendToNetwork(uint16_t src_port,
   if (net_base::IPv4Address(dev_dst.sin_addr) != kBcastAddr)
     dev_dst.sin_addr = dev_socket_->broadaddr.ToInAddr();
 
+  stats_.send_syscalls++;
   if (SendTo(temp_fd.get(), data, len, &dev_dst) < 0) {
     // Ignore ENETDOWN: this can happen if the interface is not yet configured.
     if (errno != ENETDOWN) {
@@ -457,12 +488,11 @@ bool BroadcastForwarder::SendToNetwork(uint16_t src_port,
     }
     return false;
   }
+  stats_.packets_sent++;
   return true;
 }
 
-bool BroadcastForwarder::SendToGuests(const void* ip_pkt,
-                                      size_t len,
-                                      const struct sockaddr_in& dst) {
+bool BroadcastForwarder::SendToGuests(const std::vector<Packet>& packets) {
   bool success = true;
 
   base::ScopedFD raw(socket(AF_INET, SOCK_RAW | SOCK_CLOEXEC, IPPROTO_UDP));
@@ -481,32 +511,47 @@ bool BroadcastForwarder::SendToGuests(const void* ip_pkt,
     return false;
   }
 
-  // Copy IP packet received by the lan interface and only change its
-  // destination address.
-  alignas(4) uint8_t buffer[kBufSize];
-  memset(buffer, 0, kBufSize);
-  memcpy(buffer, reinterpret_cast<const uint8_t*>(ip_pkt),
-         sizeof(iphdr) + sizeof(udphdr) + len);
-
-  // These headers are taken directly from the buffer and is 4 bytes aligned.
-  struct iphdr* ip_hdr = (struct iphdr*)buffer;
-  struct udphdr* udp_hdr = (struct udphdr*)(buffer + sizeof(struct iphdr));
-
-  ip_hdr->check = 0;
-  udp_hdr->check = 0;
-
-  struct sockaddr_in br_dst = {0};
-  memcpy(&br_dst, &dst, sizeof(struct sockaddr_in));
+  // Copy IP packets received by the lan interface and only change their
+  // destination address. Every packet is copied in its own slot of |buffers|
+  // so that all of them are sent to a guest with as few sendmmsg() calls as
+  // possible.
+  std::vector<uint8_t> buffers(packets.size() * kBufSize);
+  std::vector<struct sockaddr_in> br_dsts(packets.size());
+  std::vector<struct iovec> iovs(packets.size());
+  std::vector<struct mmsghdr> msgs(packets.size());
+  for (size_t i = 0; i < packets.size(); i++) {
+    const size_t pkt_len =
+        sizeof(struct iphdr) + sizeof(struct udphdr) + packets[i].len;
+    memcpy(buffers.data() + i * kBufSize, packets[i].ip_pkt, pkt_len);
+    iovs[i].iov_base = buffers.data() + i * kBufSize;
+    iovs[i].iov_len = pkt_len;
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_name = &br_dsts[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
 
   for (auto const& socket : br_sockets_) {
-    // Set destination address.
-    if (net_base::IPv4Address(br_dst.sin_addr) != kBcastAddr) {
-      br_dst.sin_addr = socket.second->broadaddr.ToInAddr();
-      ip_hdr->daddr = socket.second->broadaddr.ToInAddr().s_addr;
-      ip_hdr->check = Ipv4Checksum(ip_hdr);
+    for (size_t i = 0; i < packets.size(); i++) {
+      uint8_t* buffer = buffers.data() + i * kBufSize;
+      // These headers are taken directly from the buffer and is 4 bytes
+      // aligned.
+      struct iphdr* ip_hdr = (struct iphdr*)buffer;
+      struct udphdr* udp_hdr = (struct udphdr*)(buffer + sizeof(struct iphdr));
+
+      ip_hdr->check = 0;
+      udp_hdr->check = 0;
+
+      // Set destination address.
+      memcpy(&br_dsts[i], &packets[i].dst, sizeof(struct sockaddr_in));
+      if (net_base::IPv4Address(br_dsts[i].sin_addr) != kBcastAddr) {
+        br_dsts[i].sin_addr = socket.second->broadaddr.ToInAddr();
+        ip_hdr->daddr = socket.second->broadaddr.ToInAddr().s_addr;
+        ip_hdr->check = Ipv4Checksum(ip_hdr);
+      }
+      udp_hdr->check = Udpv4Checksum(buffer, iovs[i].iov_len);
     }
-    udp_hdr->check =
-        Udpv4Checksum(buffer, sizeof(iphdr) + sizeof(udphdr) + len);
 
     struct ifreq ifr;
     memset(&ifr, 0, sizeof(ifr));
@@ -517,19 +562,39 @@ bool BroadcastForwarder::SendToGuests(const void* ip_pkt,
       continue;
     }
 
-    // Use already created broadcast fd.
-    if (SendTo(raw.get(), buffer,
-               sizeof(struct iphdr) + sizeof(struct udphdr) + len,
-               &br_dst) < 0) {
-      PLOG(WARNING) << "sendto failed";
-      success = false;
+    size_t sent = 0;
+    while (sent < msgs.size()) {
+      const unsigned int vlen = static_cast<unsigned int>(
+          std::min(msgs.size() - sent, static_cast<size_t>(kMaxBatchSize)));
+      stats_.send_syscalls++;
+      int r = SendMessages(raw.get(), msgs.data() + sent, vlen);
+      if (r <= 0) {
+        // sendmmsg() fails only if the first packet fails to be sent. Skips it
+        // and tries the following ones.
+        PLOG(WARNING) << "sendmmsg failed";
+        success = false;
+        sent++;
+        continue;
+      }
+      sent += static_cast<size_t>(r);
+      stats_.packets_sent += static_cast<uint64_t>(r);
     }
   }
   return success;
 }
 
-ssize_t BroadcastForwarder::ReceiveMessage(int fd, struct msghdr* msg) {
-  return recvmsg(fd, msg, 0);
+int BroadcastForwarder::ReceiveMessages(int fd,
+                                        struct mmsghdr* msgs,
+                                        unsigned int vlen) {
+  // The socket is readable, so at least one packet is returned without waiting
+  // for |vlen| of them.
+  return recvmmsg(fd, msgs, vlen, MSG_DONTWAIT, nullptr);
+}
+
+int BroadcastForwarder::SendMessages(int fd,
+                                     struct mmsghdr* msgs,
+                                     unsigned int vlen) {
+  return sendmmsg(fd, msgs, vlen, 0);
 }
 
 ssize_t BroadcastForwarder::SendTo(int fd,
@@ -11,12 +11,14 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <net-base/ipv4_address.h>
 #include <shill/net/rtnl_listener.h>
 #include <shill/net/rtnl_message.h>
 
 #include "patchpanel/file_descriptor_watcher_posix.h"
+#include "patchpanel/forwarder_stats.h"
 #include "patchpanel/shill_client.h"
 
 namespace patchpanel {
@@ -41,15 +43,22 @@ class BroadcastForwarder {
   bool AddGuest(const std::string& br_ifname);
   void RemoveGuest(const std::string& br_ifname);
 
-  // Receives a broadcast packet from the network or from a guest and forwards
-  // it.
+  // Receives up to kMaxBatchSize broadcast packets from the network or from a
+  // guest and forwards them.
   void OnFileCanReadWithoutBlocking(int fd);
 
+  // Returns the counters accumulated since the last call and resets them.
+  ForwarderStats TakeStats();
+
   // Callback from RTNetlink listener, invoked when the lan interface IPv4
   // address is changed.
   void AddrMsgHandler(const shill::RTNLMessage& msg);
 
  protected:
+  // Maximum number of packets received with a single recvmmsg() call or sent
+  // with a single sendmmsg() call.
+  static constexpr unsigned int kMaxBatchSize = 16;
+
   // Socket is used to keep track of an fd and its watcher.
   // It also stores addresses corresponding to the interface it is bound to.
   struct Socket {
@@ -60,6 +69,16 @@ class BroadcastForwarder {
     net_base::IPv4Address netmask;
   };
 
+  // A broadcast packet received from the network and to be forwarded to the
+  // guests.
+  struct Packet {
+    // The IP packet, starting with its IP header.
+    const uint8_t* ip_pkt;
+    // Length of the UDP payload.
+    size_t len;
+    struct sockaddr_in dst;
+  };
+
   // Bind will create a broadcast socket and return its fd.
   // This is used for sending broadcasts.
   virtual base::ScopedFD Bind(const std::string& ifname, uint16_t port);
@@ -77,14 +96,15 @@ class BroadcastForwarder {
                      size_t len,
                      const struct sockaddr_in& dst);
 
-  // SendToGuests will forward the broadcast packet to all Chrome OS guests'
+  // SendToGuests will forward the broadcast |packets| to all Chrome OS guests'
   // (ARC++, Crostini, etc) internal fd.
-  bool SendToGuests(const void* ip_pkt,
-                    size_t len,
-                    const struct sockaddr_in& dst);
+  bool SendToGuests(const std::vector<Packet>& packets);
+
+  // Wrapper around libc recvmmsg, allowing override in fuzzer tests.
+  virtual int ReceiveMessages(int fd, struct mmsghdr* msgs, unsigned int vlen);
 
-  // Wrapper around libc recvmsg, allowing override in fuzzer tests.
-  virtual ssize_t ReceiveMessage(int fd, struct msghdr* msg);
+  // Wrapper around libc sendmmsg, allowing override in fuzzer tests.
+  virtual int SendMessages(int fd, struct mmsghdr* msgs, unsigned int vlen);
 
   // Wrapper around libc sendto, allowing override in fuzzer tests.
   virtual ssize_t SendTo(int fd,
@@ -107,6 +127,10 @@ class BroadcastForwarder {
   std::unique_ptr<Socket> dev_socket_;
   // Mapping from guest bridge interface name to its sockets.
   std::map<std::string, std::unique_ptr<Socket>> br_sockets_;
+  // Buffer for the packets received at once, |kBufSize| bytes per packet.
+  std::vector<uint8_t> receive_buffer_;
+  // Counters of packets and syscalls since the last call to TakeStats().
+  ForwarderStats stats_;
 
   base::WeakPtrFactory<BroadcastForwarder> weak_factory_{this};
 };
@@ -55,12 +55,18 @@ class TestBroadcastForwarder : public BroadcastForwarder {
     return socket;
   }
 
-  ssize_t ReceiveMessage(int fd, struct msghdr* msg) override {
-    size_t msg_len = std::min(payload.size(), msg->msg_iov->iov_len);
+  int ReceiveMessages(int fd, struct mmsghdr* msgs, unsigned int vlen) override {
+    struct iovec* iov = msgs[0].msg_hdr.msg_iov;
+    size_t msg_len = std::min(payload.size(), iov->iov_len);
     if (msg_len > 0) {
-      memcpy(msg->msg_iov->iov_base, payload.data(), msg_len);
+      memcpy(iov->iov_base, payload.data(), msg_len);
     }
-    return static_cast<ssize_t>(msg_len);
+    msgs[0].msg_len = static_cast<unsigned int>(msg_len);
+    return 1;
+  }
+
+  int SendMessages(int fd, struct mmsghdr* msgs, unsigned int vlen) override {
+    return static_cast<int>(vlen);
   }
 
   ssize_t SendTo(int fd,
@@ -4,6 +4,7 @@
 
 #include "patchpanel/counters_service.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -17,6 +18,7 @@
 
 #include "patchpanel/datapath.h"
 #include "patchpanel/iptables.h"
+#include "patchpanel/iptables_counters_reader.h"
 
 namespace patchpanel {
 
@@ -53,6 +55,48 @@ constexpr LazyRE2 kCounterLine = {R"( *(\d+) +(\d+).*mark match (.*)/0x3f00)"};
 constexpr LazyRE2 kFinalCounterLine = {
     R"( *(\d+) +(\d+).*(?:0\.0\.0\.0/0|::/0)\s*)"};
 
+// Matches the name of an accounting chain, e.g. "tx_eth0", and extracts "tx"
+// (direction) and "eth0" (ifname) from this example.
+constexpr LazyRE2 kChainName = {R"((rx|tx)_(\w+))"};
+
+// Returns true if the counters of the accounting chain for |ifname| should be
+// returned.
+bool IsRequestedChain(const std::string& ifname,
+                      const std::set<std::string>& devices) {
+  // Skips this group if this ifname is not requested.
+  if (!devices.empty() && devices.find(ifname) == devices.end())
+    return false;
+
+  // Skips if this chain is for multicast traffic counting.
+  return ifname.find("mdns") == std::string::npos &&
+         ifname.find("ssdp") == std::string::npos;
+}
+
+// Adds |pkts| and |bytes| into the counter of |source| on |ifname|.
+void AddCounter(const std::string& direction,
+                const std::string& ifname,
+                TrafficSource source,
+                const TrafficCounter::IpFamily ip_family,
+                uint64_t pkts,
+                uint64_t bytes,
+                std::map<CounterKey, Counter>* counters) {
+  if (pkts == 0 && bytes == 0)
+    return;
+
+  CounterKey key = {};
+  key.ifname = ifname;
+  key.source = TrafficSourceToProto(source);
+  key.ip_family = ip_family;
+  auto& counter = (*counters)[key];
+  if (direction == "rx") {
+    counter.rx_bytes += bytes;
+    counter.rx_packets += pkts;
+  } else {
+    counter.tx_bytes += bytes;
+    counter.tx_packets += pkts;
+  }
+}
+
 bool MatchCounterLine(const std::string& line,
                       uint64_t* pkts,
                       uint64_t* bytes,
@@ -103,16 +147,9 @@ bool ParseOutput(const std::string& output,
     if (it == lines.cend())
       break;
 
-    // Skips this group if this ifname is not requested.
-    if (!devices.empty() && devices.find(ifname) == devices.end())
+    if (!IsRequestedChain(ifname, devices))
       continue;
 
-    // Skips if this chain is for multicast traffic counting.
-    if (ifname.find("mdns") != std::string::npos ||
-        ifname.find("ssdp") != std::string::npos) {
-      continue;
-    }
-
     // Skips the chain name line and the header line.
     if (lines.cend() - it <= 2) {
       LOG(ERROR) << "Invalid iptables output for " << direction << "_"
@@ -137,22 +174,7 @@ bool ParseOutput(const std::string& output,
                    << direction << "_" << ifname;
         return false;
       }
-
-      if (pkts == 0 && bytes == 0)
-        continue;
-
-      CounterKey key = {};
-      key.ifname = ifname;
-      key.source = TrafficSourceToProto(source);
-      key.ip_family = ip_family;
-      auto& counter = (*counters)[key];
-      if (direction == "rx") {
-        counter.rx_bytes += bytes;
-        counter.rx_packets += pkts;
-      } else {
-        counter.tx_bytes += bytes;
-        counter.tx_packets += pkts;
-      }
+      AddCounter(direction, ifname, source, ip_family, pkts, bytes, counters);
     }
 
     if (it == lines.cend())
@@ -161,9 +183,62 @@ bool ParseOutput(const std::string& output,
   return true;
 }
 
+// Adds the counters of the accounting chains in |chains|, which are read from
+// the mangle table by IptablesCountersReader, into |counters|. Every rule of an
+// accounting chain must be either an accounting rule for a source, with only a
+// fwmark match on the source bits, or the final accounting rule without any
+// match.
+bool ParseChains(const IptablesCountersReader::Chains& chains,
+                 const std::set<std::string>& devices,
+                 const TrafficCounter::IpFamily ip_family,
+                 std::map<CounterKey, Counter>* counters) {
+  DCHECK(counters);
+  for (const auto& [chain, rules] : chains) {
+    std::string direction, ifname;
+    if (!RE2::FullMatch(chain, *kChainName, &direction, &ifname))
+      continue;
+
+    if (!IsRequestedChain(ifname, devices))
+      continue;
+
+    // Checks that there are some counter rules defined.
+    if (rules.empty()) {
+      LOG(ERROR) << "No counter rule defined for " << chain;
+      return false;
+    }
+
+    for (const auto& rule : rules) {
+      TrafficSource source;
+      if (rule.has_other_matches) {
+        LOG(ERROR) << "Unexpected accounting rule in " << chain;
+        return false;
+      }
+      if (!rule.mark) {
+        source = TrafficSource::kUnknown;
+      } else if (rule.mark_mask == kFwmarkAllSourcesMask.Value()) {
+        Fwmark mark;
+        mark.fwmark = *rule.mark;
+        source = mark.Source();
+      } else {
+        LOG(ERROR) << "Unexpected fwmark mask in accounting rule in " << chain;
+        return false;
+      }
+      AddCounter(direction, ifname, source, ip_family, rule.packets,
+                 rule.bytes, counters);
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
-CountersService::CountersService(Datapath* datapath) : datapath_(datapath) {}
+CountersService::CountersService(Datapath* datapath)
+    : CountersService(datapath, std::make_unique<IptablesCountersReader>()) {}
+
+CountersService::CountersService(
+    Datapath* datapath,
+    std::unique_ptr<IptablesCountersReader> counters_reader)
+    : datapath_(datapath), counters_reader_(std::move(counters_reader)) {}
 
 std::map<CounterKey, Counter> CountersService::GetCounters(
     const std::set<std::string>& devices) {
@@ -171,30 +246,45 @@ std::map<CounterKey, Counter> CountersService::GetCounters(
 
   // Handles counters for IPv4 and IPv6 separately and returns failure if either
   // of the procession fails, since counters for only IPv4 or IPv6 are biased.
-  std::string iptables_result =
-      datapath_->DumpIptables(IpFamily::kIPv4, Iptables::Table::kMangle);
-  if (iptables_result.empty()) {
-    LOG(ERROR) << "Failed to query IPv4 counters";
+  if (!GetCountersForFamily(IpFamily::kIPv4, devices, &counters) ||
+      !GetCountersForFamily(IpFamily::kIPv6, devices, &counters)) {
     return {};
   }
-  if (!ParseOutput(iptables_result, devices, TrafficCounter::IPV4, &counters)) {
-    LOG(ERROR) << "Failed to parse IPv4 counters";
-    return {};
+  return counters;
+}
+
+bool CountersService::GetCountersForFamily(
+    IpFamily family,
+    const std::set<std::string>& devices,
+    std::map<CounterKey, Counter>* counters) {
+  const auto ip_family =
+      family == IpFamily::kIPv4 ? TrafficCounter::IPV4 : TrafficCounter::IPV6;
+  const char* family_name = family == IpFamily::kIPv4 ? "IPv4" : "IPv6";
+
+  if (counters_reader_) {
+    const auto chains =
+        counters_reader_->ReadChains(family, Iptables::Table::kMangle);
+    if (chains) {
+      if (!ParseChains(*chains, devices, ip_family, counters)) {
+        LOG(ERROR) << "Failed to parse " << family_name << " counters";
+        return false;
+      }
+      return true;
+    }
+    // Falls back to iptables, e.g. if the table is managed by nftables.
   }
 
-  std::string ip6tables_result =
-      datapath_->DumpIptables(IpFamily::kIPv6, Iptables::Table::kMangle);
-  if (ip6tables_result.empty()) {
-    LOG(ERROR) << "Failed to query IPv6 counters";
-    return {};
+  std::string iptables_result =
+      datapath_->DumpIptables(family, Iptables::Table::kMangle);
+  if (iptables_result.empty()) {
+    LOG(ERROR) << "Failed to query " << family_name << " counters";
+    return false;
   }
-  if (!ParseOutput(ip6tables_result, devices, TrafficCounter::IPV6,
-                   &counters)) {
-    LOG(ERROR) << "Failed to parse IPv6 counters";
-    return {};
+  if (!ParseOutput(iptables_result, devices, ip_family, counters)) {
+    LOG(ERROR) << "Failed to parse " << family_name << " counters";
+    return false;
   }
-
-  return counters;
+  return true;
 }
 
 void CountersService::OnPhysicalDeviceAdded(const std::string& ifname) {
@@ -6,6 +6,7 @@
 #define PATCHPANEL_COUNTERS_SERVICE_H_
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -15,6 +16,7 @@
 
 #include "patchpanel/datapath.h"
 #include "patchpanel/iptables.h"
+#include "patchpanel/iptables_counters_reader.h"
 #include "patchpanel/routing_service.h"
 
 namespace patchpanel {
@@ -45,9 +47,12 @@ namespace patchpanel {
 // and removed dynamically based on shill physical Device and shill vpn Device
 // creation and removal events.
 //
-// Query: Two commands (iptables and ip6tables) will be executed in the mangle
-// table to get all the chains and rules. And then we perform a text parsing on
-// the output to get the counters.
+// Query: The rules of the accounting chains in the mangle table are read
+// directly from the kernel with IptablesCountersReader for IPv4 and IPv6. If
+// the kernel can't be read, e.g. when the tables are managed by nftables, two
+// commands (iptables and ip6tables) will be executed in the mangle table to get
+// all the chains and rules. And then we perform a text parsing on the output to
+// get the counters.
 class CountersService {
  public:
   struct CounterKey {
@@ -66,6 +71,10 @@ class CountersService {
   };
 
   explicit CountersService(Datapath* datapath);
+  // If |counters_reader| is null, counters are always queried by parsing the
+  // output of iptables.
+  CountersService(Datapath* datapath,
+                  std::unique_ptr<IptablesCountersReader> counters_reader);
   ~CountersService() = default;
 
   // Adds accounting rules and jump rules for a new physical device if this is
@@ -98,7 +107,14 @@ class CountersService {
                       const std::string& rx_chain,
                       const std::string& tx_chain);
 
+  // Adds the counters for |family| into |counters|, querying them with
+  // |counters_reader_| if possible or by parsing the output of iptables.
+  bool GetCountersForFamily(IpFamily family,
+                            const std::set<std::string>& devices,
+                            std::map<CounterKey, Counter>* counters);
+
   Datapath* datapath_;
+  std::unique_ptr<IptablesCountersReader> counters_reader_;
 };
 
 TrafficCounter::Source TrafficSourceToProto(TrafficSource source);
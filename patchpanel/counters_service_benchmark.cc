@@ -0,0 +1,209 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Microbenchmark of CountersService::GetCounters() with the counters read by
+// parsing the output of iptables and with the counters read from the kernel by
+// IptablesCountersReader. Neither iptables nor the kernel are queried: both
+// paths parse a canned copy of the mangle table with the accounting chains of
+// the given number of interfaces. The numbers of queries per second are
+// reported as "items_per_second".
+
+// netinet/in.h must be included before the linux headers, which would
+// otherwise conflict with it.
+#include <netinet/in.h>
+
+#include <linux/netfilter/x_tables.h>
+#include <linux/netfilter/xt_mark.h>
+#include <linux/netfilter_ipv4/ip_tables.h>
+#include <linux/netfilter_ipv6/ip6_tables.h>
+#include <string.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <base/check.h>
+#include <base/strings/stringprintf.h>
+#include <benchmark/benchmark.h>
+
+#include "patchpanel/counters_service.h"
+#include "patchpanel/datapath.h"
+#include "patchpanel/iptables.h"
+#include "patchpanel/iptables_counters_reader.h"
+#include "patchpanel/routing_service.h"
+
+namespace patchpanel {
+namespace {
+
+// Generates the output of `iptables -t mangle -L -x -v -n` (or `ip6tables`)
+// with the accounting chains of |num_ifaces| interfaces.
+std::string GenerateIptablesOutput(IpFamily family, int num_ifaces) {
+  const char* any = family == IpFamily::kIPv4 ? "0.0.0.0/0" : "::/0";
+  std::string output;
+  for (int i = 0; i < num_ifaces; i++) {
+    for (const char* direction : {"rx", "tx"}) {
+      base::StringAppendF(&output,
+                          "Chain %s_eth%d (2 references)\n"
+                          "    pkts      bytes target     prot opt in     out  "
+                          "   source               destination\n",
+                          direction, i);
+      for (TrafficSource source : kAllSources) {
+        base::StringAppendF(
+            &output,
+            "    %d   %d RETURN     all  --  *      *       %s  %s  "
+            "mark match 0x%x/0x%x\n",
+            1000 + i, 100000 + i, any, any, Fwmark::FromSource(source).Value(),
+            kFwmarkAllSourcesMask.Value());
+      }
+      base::StringAppendF(&output,
+                          "    %d   %d            all  --  *      *       %s  "
+                          "%s\n\n",
+                          10 + i, 1000 + i, any, any);
+    }
+  }
+  return output;
+}
+
+// Appends an entry in the format returned by IPT_SO_GET_ENTRIES (or
+// IP6T_SO_GET_ENTRIES) to |entries|.
+template <typename Entry>
+void AppendEntry(uint64_t packets,
+                 uint64_t bytes,
+                 std::optional<uint32_t> mark,
+                 const char* target_name,
+                 const std::string& target_data,
+                 std::vector<uint8_t>* entries) {
+  const size_t match_size =
+      mark ? XT_ALIGN(sizeof(xt_entry_match) + sizeof(xt_mark_mtinfo1)) : 0;
+  const size_t target_size =
+      XT_ALIGN(sizeof(xt_entry_target) + XT_FUNCTION_MAXNAMELEN);
+
+  Entry entry = {};
+  entry.target_offset = static_cast<uint16_t>(sizeof(entry) + match_size);
+  entry.next_offset = static_cast<uint16_t>(entry.target_offset + target_size);
+  entry.counters.pcnt = packets;
+  entry.counters.bcnt = bytes;
+
+  const size_t offset = entries->size();
+  entries->resize(offset + entry.next_offset);
+  uint8_t* p = entries->data() + offset;
+  memcpy(p, &entry, sizeof(entry));
+  if (mark) {
+    xt_entry_match match = {};
+    match.u.user.match_size = static_cast<uint16_t>(match_size);
+    strncpy(match.u.user.name, "mark", sizeof(match.u.user.name) - 1);
+    match.u.user.revision = 1;
+    xt_mark_mtinfo1 info = {};
+    info.mark = *mark;
+    info.mask = kFwmarkAllSourcesMask.Value();
+    memcpy(p + sizeof(entry), &match, sizeof(match));
+    memcpy(p + sizeof(entry) + sizeof(match), &info, sizeof(info));
+  }
+  xt_entry_target target = {};
+  target.u.user.target_size = static_cast<uint16_t>(target_size);
+  strncpy(target.u.user.name, target_name, sizeof(target.u.user.name) - 1);
+  memcpy(p + entry.target_offset, &target, sizeof(target));
+  strncpy(reinterpret_cast<char*>(p + entry.target_offset + sizeof(target)),
+          target_data.c_str(), XT_FUNCTION_MAXNAMELEN - 1);
+}
+
+// Generates the entries of the mangle table with the accounting chains of
+// |num_ifaces| interfaces.
+template <typename Entry>
+std::vector<uint8_t> GenerateEntries(int num_ifaces) {
+  std::vector<uint8_t> entries;
+  for (int i = 0; i < num_ifaces; i++) {
+    for (const char* direction : {"rx", "tx"}) {
+      AppendEntry<Entry>(0, 0, std::nullopt, XT_ERROR_TARGET,
+                         base::StringPrintf("%s_eth%d", direction, i),
+                         &entries);
+      for (TrafficSource source : kAllSources) {
+        AppendEntry<Entry>(1000 + i, 100000 + i,
+                           Fwmark::FromSource(source).Value(),
+                           XT_STANDARD_TARGET, "", &entries);
+      }
+      AppendEntry<Entry>(10 + i, 1000 + i, std::nullopt, XT_STANDARD_TARGET,
+                         "", &entries);
+      // The implicit RETURN at the end of the chain.
+      AppendEntry<Entry>(0, 0, std::nullopt, XT_STANDARD_TARGET, "",
+                         &entries);
+    }
+  }
+  AppendEntry<Entry>(0, 0, std::nullopt, XT_ERROR_TARGET, XT_ERROR_TARGET,
+                     &entries);
+  return entries;
+}
+
+class FakeDatapath : public Datapath {
+ public:
+  explicit FakeDatapath(int num_ifaces)
+      : Datapath(nullptr, nullptr, nullptr),
+        ipv4_output_(GenerateIptablesOutput(IpFamily::kIPv4, num_ifaces)),
+        ipv6_output_(GenerateIptablesOutput(IpFamily::kIPv6, num_ifaces)) {}
+  FakeDatapath(const FakeDatapath&) = delete;
+  FakeDatapath& operator=(const FakeDatapath&) = delete;
+  ~FakeDatapath() override = default;
+
+  std::string DumpIptables(IpFamily family, Iptables::Table table) override {
+    return family == IpFamily::kIPv4 ? ipv4_output_ : ipv6_output_;
+  }
+
+ private:
+  const std::string ipv4_output_;
+  const std::string ipv6_output_;
+};
+
+// Parses canned entries instead of getting them from the kernel.
+class FakeIptablesCountersReader : public IptablesCountersReader {
+ public:
+  explicit FakeIptablesCountersReader(int num_ifaces)
+      : ipv4_entries_(GenerateEntries<ipt_entry>(num_ifaces)),
+        ipv6_entries_(GenerateEntries<ip6t_entry>(num_ifaces)) {}
+  FakeIptablesCountersReader(const FakeIptablesCountersReader&) = delete;
+  FakeIptablesCountersReader& operator=(const FakeIptablesCountersReader&) =
+      delete;
+  ~FakeIptablesCountersReader() override = default;
+
+  std::optional<Chains> ReadChains(IpFamily family,
+                                   Iptables::Table table) override {
+    return ParseEntries(
+        family, family == IpFamily::kIPv4 ? ipv4_entries_ : ipv6_entries_, {});
+  }
+
+ private:
+  const std::vector<uint8_t> ipv4_entries_;
+  const std::vector<uint8_t> ipv6_entries_;
+};
+
+}  // namespace
+
+static void BM_GetCountersFromIptablesOutput(benchmark::State& state) {
+  const int num_ifaces = static_cast<int>(state.range(0));
+  FakeDatapath datapath(num_ifaces);
+  CountersService counters_svc(&datapath, /*counters_reader=*/nullptr);
+  CHECK(!counters_svc.GetCounters({}).empty());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(counters_svc.GetCounters({}));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetCountersFromIptablesOutput)->Arg(1)->Arg(4)->Arg(16);
+
+static void BM_GetCountersFromKernel(benchmark::State& state) {
+  const int num_ifaces = static_cast<int>(state.range(0));
+  FakeDatapath datapath(num_ifaces);
+  CountersService counters_svc(
+      &datapath, std::make_unique<FakeIptablesCountersReader>(num_ifaces));
+  CHECK(!counters_svc.GetCounters({}).empty());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(counters_svc.GetCounters({}));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetCountersFromKernel)->Arg(1)->Arg(4)->Arg(16);
+
+}  // namespace patchpanel
+
+BENCHMARK_MAIN();
@@ -46,7 +46,7 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   static Environment env;
 
   FakeDatapath datapath(reinterpret_cast<const char*>(data), size);
-  CountersService counters_svc(&datapath);
+  CountersService counters_svc(&datapath, /*counters_reader=*/nullptr);
   counters_svc.GetCounters({});
 
   return 0;
@@ -7,7 +7,9 @@
 #include <net/if.h>
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <base/logging.h>
@@ -17,7 +19,9 @@
 #include <gtest/gtest.h>
 
 #include "patchpanel/iptables.h"
+#include "patchpanel/iptables_counters_reader.h"
 #include "patchpanel/mock_datapath.h"
+#include "patchpanel/routing_service.h"
 
 namespace patchpanel {
 
@@ -271,11 +275,46 @@ bool CompareCounters(std::map<CounterKey, Counter> expected,
   return success;
 }
 
+class MockIptablesCountersReader : public IptablesCountersReader {
+ public:
+  MockIptablesCountersReader() = default;
+  ~MockIptablesCountersReader() override = default;
+
+  MOCK_METHOD(std::optional<Chains>,
+              ReadChains,
+              (IpFamily family, Iptables::Table table),
+              (override));
+};
+
+IptablesCountersReader::Rule SourceRule(TrafficSource source,
+                                        uint64_t packets,
+                                        uint64_t bytes) {
+  IptablesCountersReader::Rule rule;
+  rule.packets = packets;
+  rule.bytes = bytes;
+  rule.mark = Fwmark::FromSource(source).Value();
+  rule.mark_mask = kFwmarkAllSourcesMask.Value();
+  return rule;
+}
+
+IptablesCountersReader::Rule FinalRule(uint64_t packets, uint64_t bytes) {
+  IptablesCountersReader::Rule rule;
+  rule.packets = packets;
+  rule.bytes = bytes;
+  return rule;
+}
+
 class CountersServiceTest : public testing::Test {
  protected:
   void SetUp() override {
     datapath_ = std::make_unique<MockDatapath>();
-    counters_svc_ = std::make_unique<CountersService>(datapath_.get());
+    // The counters are read by parsing the iptables output unless a test
+    // makes the reader return some chains.
+    auto counters_reader = std::make_unique<MockIptablesCountersReader>();
+    counters_reader_ = counters_reader.get();
+    ON_CALL(*counters_reader_, ReadChains).WillByDefault(Return(std::nullopt));
+    counters_svc_ = std::make_unique<CountersService>(
+        datapath_.get(), std::move(counters_reader));
   }
 
   // Makes `iptables` and `ip6tables` returning |ipv4_output| and
@@ -295,6 +334,7 @@ class CountersServiceTest : public testing::Test {
   }
 
   std::unique_ptr<MockDatapath> datapath_;
+  MockIptablesCountersReader* counters_reader_;
   std::unique_ptr<CountersService> counters_svc_;
 };
 
@@ -790,5 +830,100 @@ Chain tx_wlan0 (1 references)
   TestBadIptablesOutput(kBadOutput, kIp6tablesOutput);
 }
 
+TEST_F(CountersServiceTest, QueryTrafficCountersFromKernel) {
+  const IptablesCountersReader::Chains chains = {
+      {"PREROUTING_custom", {FinalRule(100, 1000)}},
+      {"rx_eth0",
+       {SourceRule(TrafficSource::kChrome, 73, 11938),
+        SourceRule(TrafficSource::kUser, 0, 0), FinalRule(6, 345)}},
+      {"tx_eth0",
+       {SourceRule(TrafficSource::kChrome, 1366, 244427),
+        SourceRule(TrafficSource::kArc, 5374, 876172), FinalRule(4, 123)}},
+      {"rx_mdns_eth0", {FinalRule(1, 100)}},
+  };
+  EXPECT_CALL(*counters_reader_,
+              ReadChains(IpFamily::kIPv4, Iptables::Table::kMangle))
+      .WillOnce(Return(chains));
+  EXPECT_CALL(*counters_reader_,
+              ReadChains(IpFamily::kIPv6, Iptables::Table::kMangle))
+      .WillOnce(Return(chains));
+  EXPECT_CALL(*datapath_, DumpIptables).Times(0);
+
+  auto actual = counters_svc_->GetCounters({});
+
+  std::map<CounterKey, Counter> expected;
+  for (auto ip_family : {TrafficCounter::IPV4, TrafficCounter::IPV6}) {
+    expected[{"eth0", TrafficCounter::CHROME, ip_family}] = {
+        11938 /*rx_bytes*/, 73 /*rx_packets*/, 244427 /*tx_bytes*/,
+        1366 /*tx_packets*/};
+    expected[{"eth0", TrafficCounter::ARC, ip_family}] = {
+        0 /*rx_bytes*/, 0 /*rx_packets*/, 876172 /*tx_bytes*/,
+        5374 /*tx_packets*/};
+    expected[{"eth0", TrafficCounter::UNKNOWN, ip_family}] = {
+        345 /*rx_bytes*/, 6 /*rx_packets*/, 123 /*tx_bytes*/,
+        4 /*tx_packets*/};
+  }
+  EXPECT_TRUE(CompareCounters(expected, actual));
+}
+
+TEST_F(CountersServiceTest, QueryTrafficCountersFromKernelFallBack) {
+  const IptablesCountersReader::Chains chains = {
+      {"tx_eth0",
+       {SourceRule(TrafficSource::kChrome, 1366, 244427), FinalRule(4, 123)}},
+  };
+  EXPECT_CALL(*counters_reader_,
+              ReadChains(IpFamily::kIPv4, Iptables::Table::kMangle))
+      .WillOnce(Return(chains));
+  EXPECT_CALL(*counters_reader_,
+              ReadChains(IpFamily::kIPv6, Iptables::Table::kMangle))
+      .WillOnce(Return(std::nullopt));
+  EXPECT_CALL(*datapath_,
+              DumpIptables(IpFamily::kIPv4, Iptables::Table::kMangle))
+      .Times(0);
+  EXPECT_CALL(*datapath_,
+              DumpIptables(IpFamily::kIPv6, Iptables::Table::kMangle))
+      .WillOnce(Return(R"(
+Chain tx_eth0 (1 references)
+    pkts      bytes target     prot opt in     out     source               destination
+    211 13456            all  --  any    any     ::/0             ::/0
+)"));
+
+  auto actual = counters_svc_->GetCounters({});
+
+  std::map<CounterKey, Counter> expected{
+      {{"eth0", TrafficCounter::CHROME, TrafficCounter::IPV4},
+       {0 /*rx_bytes*/, 0 /*rx_packets*/, 244427 /*tx_bytes*/,
+        1366 /*tx_packets*/}},
+      {{"eth0", TrafficCounter::UNKNOWN, TrafficCounter::IPV4},
+       {0 /*rx_bytes*/, 0 /*rx_packets*/, 123 /*tx_bytes*/, 4 /*tx_packets*/}},
+      {{"eth0", TrafficCounter::UNKNOWN, TrafficCounter::IPV6},
+       {0 /*rx_bytes*/, 0 /*rx_packets*/, 13456 /*tx_bytes*/,
+        211 /*tx_packets*/}},
+  };
+  EXPECT_TRUE(CompareCounters(expected, actual));
+}
+
+TEST_F(CountersServiceTest, QueryTrafficCountersFromKernelWithBadRules) {
+  IptablesCountersReader::Rule other_match_rule = FinalRule(1, 100);
+  other_match_rule.has_other_matches = true;
+  IptablesCountersReader::Rule other_mask_rule =
+      SourceRule(TrafficSource::kChrome, 1, 100);
+  other_mask_rule.mark_mask = 0xffffffff;
+
+  const std::vector<IptablesCountersReader::Chains> bad_chains = {
+      {{"tx_eth0", {}}},
+      {{"tx_eth0", {other_match_rule}}},
+      {{"tx_eth0", {other_mask_rule}}},
+  };
+  for (const auto& chains : bad_chains) {
+    EXPECT_CALL(*counters_reader_,
+                ReadChains(IpFamily::kIPv4, Iptables::Table::kMangle))
+        .WillOnce(Return(chains));
+    EXPECT_CALL(*datapath_, DumpIptables).Times(0);
+
+    EXPECT_TRUE(counters_svc_->GetCounters({}).empty());
+  }
+}
+
 }  // namespace
 }  // namespace patchpanel
@@ -17,7 +17,9 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <optional>
+#include <utility>
 
 #include <base/check.h>
 #include <base/files/scoped_file.h>
@@ -112,6 +114,40 @@ IpFamily ConvertIpFamily(net_base::IPFamily family) {
                                                : IpFamily::kIPv6;
 }
 
+// Returns true if |command| modifies the rules or the chains and can be applied
+// with iptables-restore.
+bool IsIptablesCommandBatchable(Iptables::Command command) {
+  switch (command) {
+    case Iptables::Command::kA:
+    case Iptables::Command::kD:
+    case Iptables::Command::kF:
+    case Iptables::Command::kI:
+    case Iptables::Command::kN:
+    case Iptables::Command::kX:
+      return true;
+    case Iptables::Command::kC:
+    case Iptables::Command::kL:
+    case Iptables::Command::kS:
+      return false;
+  }
+}
+
+// Returns |arg| quoted as needed for a line of an iptables-restore input.
+std::string QuoteIptablesRestoreArg(const std::string& arg) {
+  if (!arg.empty() && arg.find_first_of(" \t\"'\\#") == std::string::npos) {
+    return arg;
+  }
+  std::string quoted = "\"";
+  for (char c : arg) {
+    if (c == '"' || c == '\\') {
+      quoted.push_back('\\');
+    }
+    quoted.push_back(c);
+  }
+  quoted.push_back('"');
+  return quoted;
+}
+
 // ioctl helper that manages the control fd creation and destruction.
 bool Ioctl(System* system, ioctl_req_t req, const char* arg) {
   base::ScopedFD control_fd(socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
@@ -163,6 +199,10 @@ Datapath::Datapath(MinijailedProcessRunner* process_runner,
 }
 
 void Datapath::Start() {
+  // Sets up hundreds of rules. Applies them with a few iptables-restore runs
+  // instead of one iptables run per rule.
+  StartIptablesTransaction();
+
   // Restart from a clean iptables state in case of an unordered shutdown.
   ResetIptables();
 
@@ -325,18 +365,19 @@ void Datapath::Start() {
   }
 
   // Create a FORWARD ACCEPT rule for connections already established.
-  if (process_runner_->iptables(
-          Iptables::Table::kFilter, Iptables::Command::kA, "FORWARD",
+  if (!ModifyIptables(
+          IpFamily::kIPv4, Iptables::Table::kFilter, Iptables::Command::kA,
+          "FORWARD",
           {"-m", "state", "--state", "ESTABLISHED,RELATED", "-j", "ACCEPT",
-           "-w"}) != 0) {
+           "-w"})) {
     LOG(ERROR) << "Failed to install forwarding rule for established"
                << " connections.";
   }
 
   // Create a FORWARD ACCEPT rule for ICMP6.
-  if (process_runner_->ip6tables(
-          Iptables::Table::kFilter, Iptables::Command::kA, "FORWARD",
-          {"-p", "ipv6-icmp", "-j", "ACCEPT", "-w"}) != 0)
+  if (!ModifyIptables(IpFamily::kIPv6, Iptables::Table::kFilter,
+                      Iptables::Command::kA, "FORWARD",
+                      {"-p", "ipv6-icmp", "-j", "ACCEPT", "-w"}))
     LOG(ERROR) << "Failed to install forwarding rule for ICMP6";
 
   // chromium:898210: Drop any locally originated traffic that would exit a
@@ -362,11 +403,10 @@ void Datapath::Start() {
   // vpn_accept and vpn_lockdown, insert it in front of the FORWARD chain last.
   std::string snatMark =
       kFwmarkLegacySNAT.ToString() + "/" + kFwmarkLegacySNAT.ToString();
-  if (process_runner_->iptables(
-          Iptables::Table::kFilter, Iptables::Command::kI,
-          kDropGuestInvalidIpv4Chain,
-          {"-m", "mark", "--mark", snatMark, "-m", "state", "--state",
-           "INVALID", "-j", "DROP", "-w"}) != 0) {
+  if (!ModifyIptables(IpFamily::kIPv4, Iptables::Table::kFilter,
+                      Iptables::Command::kI, kDropGuestInvalidIpv4Chain,
+                      {"-m", "mark", "--mark", snatMark, "-m", "state",
+                       "--state", "INVALID", "-j", "DROP", "-w"})) {
     LOG(ERROR) << "Failed to install FORWARD rule to drop INVALID packets";
   }
   // b/196899048: IPv4 TCP packets with TCP flags FIN,PSH coming from downstream
@@ -374,11 +414,11 @@ void Datapath::Start() {
   // but the --state INVALID rule above will also not match for these packets.
   // crbug/1241756: Make sure that only egress FINPSH packets are dropped.
   for (const auto& oif : kCellularIfnamePrefixes) {
-    if (process_runner_->iptables(
-            Iptables::Table::kFilter, Iptables::Command::kI,
-            kDropGuestInvalidIpv4Chain,
-            {"-s", kGuestIPv4Subnet, "-p", "tcp", "--tcp-flags", "FIN,PSH",
-             "FIN,PSH", "-o", oif, "-j", "DROP", "-w"}) != 0) {
+    if (!ModifyIptables(IpFamily::kIPv4, Iptables::Table::kFilter,
+                        Iptables::Command::kI, kDropGuestInvalidIpv4Chain,
+                        {"-s", kGuestIPv4Subnet, "-p", "tcp", "--tcp-flags",
+                         "FIN,PSH", "FIN,PSH", "-o", oif, "-j", "DROP",
+                         "-w"})) {
       LOG(ERROR) << "Failed to install FORWARD rule to drop TCP FIN,PSH "
                     "packets egressing "
                  << oif << " interfaces";
@@ -387,9 +427,10 @@ void Datapath::Start() {
 
   // Set static SNAT rules for any IPv4 traffic originated from a guest (ARC,
   // Crostini, ...) or a connected namespace.
-  if (process_runner_->iptables(
-          Iptables::Table::kNat, Iptables::Command::kA, "POSTROUTING",
-          {"-m", "mark", "--mark", snatMark, "-j", "MASQUERADE", "-w"}) != 0) {
+  if (!ModifyIptables(
+          IpFamily::kIPv4, Iptables::Table::kNat, Iptables::Command::kA,
+          "POSTROUTING",
+          {"-m", "mark", "--mark", snatMark, "-j", "MASQUERADE", "-w"})) {
     LOG(ERROR) << "Failed to install SNAT mark rules.";
   }
 
@@ -478,6 +519,10 @@ void Datapath::Start() {
                  << " packets in OUTPUT";
     }
   }
+
+  if (!CommitIptablesTransaction()) {
+    LOG(ERROR) << "Failed to apply some of the initial iptables rules";
+  }
 }
 
 void Datapath::Stop() {
@@ -495,7 +540,11 @@ void Datapath::Stop() {
   if (!system_->SysNetSet(System::SysNet::kIPv4Forward, "0"))
     LOG(ERROR) << "Failed to restore net.ipv4.ip_forward.";
 
+  StartIptablesTransaction();
   ResetIptables();
+  if (!CommitIptablesTransaction()) {
+    LOG(ERROR) << "Failed to reset some of the iptables rules";
+  }
 }
 
 void Datapath::ResetIptables() {
@@ -866,10 +915,9 @@ void Datapath::RemoveInterface(const std::string& ifname) {
 
 bool Datapath::AddSourceIPv4DropRule(const std::string& oif,
                                      const std::string& src_ip) {
-  return process_runner_->iptables(
-             Iptables::Table::kFilter, Iptables::Command::kI,
-             kDropGuestIpv4PrefixChain,
-             {"-o", oif, "-s", src_ip, "-j", "DROP", "-w"}) == 0;
+  return ModifyIptables(IpFamily::kIPv4, Iptables::Table::kFilter,
+                        Iptables::Command::kI, kDropGuestIpv4PrefixChain,
+                        {"-o", oif, "-s", src_ip, "-j", "DROP", "-w"});
 }
 
 bool Datapath::StartRoutingNamespace(const ConnectedNamespace& nsinfo) {
@@ -1199,8 +1247,14 @@ void Datapath::AddDownstreamInterfaceRules(const std::string& int_ifname,
 void Datapath::StartRoutingDevice(const ShillClient::Device& shill_device,
                                   const std::string& int_ifname,
                                   TrafficSource source) {
-  const std::string& ext_ifname = shill_device.ifname;
+  StartIptablesTransaction();
   AddDownstreamInterfaceRules(int_ifname, source);
+  AddRoutingTagRule(shill_device.ifname, int_ifname);
+  CommitIptablesTransaction();
+}
+
+void Datapath::AddRoutingTagRule(const std::string& ext_ifname,
+                                 const std::string& int_ifname) {
   // If |ext_ifname| is not null, mark egress traffic with the
   // fwmark routing tag corresponding to |ext_ifname|.
   int ifindex = system_->IfNametoindex(ext_ifname);
@@ -1224,6 +1278,7 @@ void Datapath::StartRoutingDevice(const ShillClient::Device& shill_device,
 
 void Datapath::StartRoutingDeviceAsSystem(const std::string& int_ifname,
                                           TrafficSource source) {
+  StartIptablesTransaction();
   AddDownstreamInterfaceRules(int_ifname, source);
 
   // Set up a CONNMARK restore rule in PREROUTING to apply any fwmark routing
@@ -1234,6 +1289,7 @@ void Datapath::StartRoutingDeviceAsSystem(const std::string& int_ifname,
                              /*iif=*/"", kFwmarkRoutingMask)) {
     LOG(ERROR) << "Failed to add CONNMARK restore rule in " << subchain;
   }
+  CommitIptablesTransaction();
 }
 
 void Datapath::StartRoutingDeviceAsUser(
@@ -1241,6 +1297,7 @@ void Datapath::StartRoutingDeviceAsUser(
     const IPv4Address& int_ipv4_addr,
     TrafficSource source,
     std::optional<net_base::IPv4Address> peer_ipv4_addr) {
+  StartIptablesTransaction();
   AddDownstreamInterfaceRules(int_ifname, source);
 
   // Set up a CONNMARK restore rule in PREROUTING to apply any fwmark routing
@@ -1257,10 +1314,10 @@ void Datapath::StartRoutingDeviceAsUser(
   // source. Connected namespace interface can be identified by checking if
   // the value of |peer_ipv4_addr| is not zero.
   if (peer_ipv4_addr &&
-      process_runner_->iptables(
-          Iptables::Table::kMangle, Iptables::Command::kA, subchain,
-          {"-s", peer_ipv4_addr->ToString(), "-d", int_ipv4_addr.ToString(),
-           "-j", "ACCEPT", "-w"}) != 0) {
+      !ModifyIptables(IpFamily::kIPv4, Iptables::Table::kMangle,
+                      Iptables::Command::kA, subchain,
+                      {"-s", peer_ipv4_addr->ToString(), "-d",
+                       int_ipv4_addr.ToString(), "-j", "ACCEPT", "-w"})) {
     LOG(ERROR) << "Failed to add connected namespace IPv4 VPN bypass rule";
   }
 
@@ -1279,6 +1336,7 @@ void Datapath::StartRoutingDeviceAsUser(
   // default network is eligible to be routed through a VPN.
   if (!ModifyFwmarkVpnJumpRule(subchain, Iptables::Command::kA, {}, {}))
     LOG(ERROR) << "Failed to add jump rule to VPN chain for " << int_ifname;
+  CommitIptablesTransaction();
 }
 
 void Datapath::StopRoutingDevice(const std::string& int_ifname) {
@@ -1302,28 +1360,23 @@ void Datapath::AddInboundIPv4DNAT(AutoDNATTarget auto_dnat_target,
                                   const IPv4Address& ipv4_addr) {
   const std::string ipv4_addr_str = ipv4_addr.ToString();
   const std::string chain = AutoDNATTargetChainName(auto_dnat_target);
+  StartIptablesTransaction();
   // Direct ingress IP traffic to existing sockets.
-  bool success = true;
-  if (process_runner_->iptables(Iptables::Table::kNat, Iptables::Command::kA,
-                                chain,
+  bool success = ModifyIptables(IpFamily::kIPv4, Iptables::Table::kNat,
+                                Iptables::Command::kA, chain,
                                 {"-i", shill_device.ifname, "-m", "socket",
-                                 "--nowildcard", "-j", "ACCEPT", "-w"}) != 0) {
-    success = false;
-  }
+                                 "--nowildcard", "-j", "ACCEPT", "-w"});
 
   // Direct ingress TCP & UDP traffic to ARC interface for new connections.
-  if (process_runner_->iptables(
-          Iptables::Table::kNat, Iptables::Command::kA, chain,
-          {"-i", shill_device.ifname, "-p", "tcp", "-j", "DNAT",
-           "--to-destination", ipv4_addr_str, "-w"}) != 0) {
-    success = false;
-  }
-  if (process_runner_->iptables(
-          Iptables::Table::kNat, Iptables::Command::kA, chain,
-          {"-i", shill_device.ifname, "-p", "udp", "-j", "DNAT",
-           "--to-destination", ipv4_addr_str, "-w"}) != 0) {
-    success = false;
-  }
+  success &= ModifyIptables(IpFamily::kIPv4, Iptables::Table::kNat,
+                            Iptables::Command::kA, chain,
+                            {"-i", shill_device.ifname, "-p", "tcp", "-j",
+                             "DNAT", "--to-destination", ipv4_addr_str, "-w"});
+  success &= ModifyIptables(IpFamily::kIPv4, Iptables::Table::kNat,
+                            Iptables::Command::kA, chain,
+                            {"-i", shill_device.ifname, "-p", "udp", "-j",
+                             "DNAT", "--to-destination", ipv4_addr_str, "-w"});
+  success &= CommitIptablesTransaction();
 
   if (!success) {
     LOG(ERROR) << "Failed to configure ingress DNAT rules on "
@@ -1337,15 +1390,20 @@ void Datapath::RemoveInboundIPv4DNAT(AutoDNATTarget auto_dnat_target,
                                      const IPv4Address& ipv4_addr) {
   const std::string ipv4_addr_str = ipv4_addr.ToString();
   const std::string chain = AutoDNATTargetChainName(auto_dnat_target);
-  process_runner_->iptables(Iptables::Table::kNat, Iptables::Command::kD, chain,
-                            {"-i", shill_device.ifname, "-p", "udp", "-j",
-                             "DNAT", "--to-destination", ipv4_addr_str, "-w"});
-  process_runner_->iptables(Iptables::Table::kNat, Iptables::Command::kD, chain,
-                            {"-i", shill_device.ifname, "-p", "tcp", "-j",
-                             "DNAT", "--to-destination", ipv4_addr_str, "-w"});
-  process_runner_->iptables(Iptables::Table::kNat, Iptables::Command::kD, chain,
-                            {"-i", shill_device.ifname, "-m", "socket",
-                             "--nowildcard", "-j", "ACCEPT", "-w"});
+  StartIptablesTransaction();
+  ModifyIptables(IpFamily::kIPv4, Iptables::Table::kNat, Iptables::Command::kD,
+                 chain,
+                 {"-i", shill_device.ifname, "-p", "udp", "-j", "DNAT",
+                  "--to-destination", ipv4_addr_str, "-w"});
+  ModifyIptables(IpFamily::kIPv4, Iptables::Table::kNat, Iptables::Command::kD,
+                 chain,
+                 {"-i", shill_device.ifname, "-p", "tcp", "-j", "DNAT",
+                  "--to-destination", ipv4_addr_str, "-w"});
+  ModifyIptables(IpFamily::kIPv4, Iptables::Table::kNat, Iptables::Command::kD,
+                 chain,
+                 {"-i", shill_device.ifname, "-m", "socket", "--nowildcard",
+                  "-j", "ACCEPT", "-w"});
+  CommitIptablesTransaction();
 }
 
 bool Datapath::AddRedirectDnsRule(const ShillClient::Device& shill_device,
@@ -2038,6 +2096,22 @@ bool Datapath::ModifyIptables(IpFamily family,
                               base::StringPiece chain,
                               const std::vector<std::string>& argv,
                               bool log_failures) {
+  if (iptables_transaction_depth_ > 0) {
+    if (log_failures && IsIptablesCommandBatchable(command)) {
+      for (auto f : {IpFamily::kIPv4, IpFamily::kIPv6}) {
+        if (family == f || family == IpFamily::kDual) {
+          pending_iptables_commands_.push_back(
+              {f, table, command, std::string(chain), argv});
+        }
+      }
+      return true;
+    }
+    // Keeps the order of the commands.
+    if (!ApplyPendingIptablesCommands()) {
+      iptables_transaction_failed_ = true;
+    }
+  }
+
   bool success = true;
   if (family == IpFamily::kIPv4 || family == IpFamily::kDual) {
     success &= process_runner_->iptables(table, command, chain, argv,
@@ -2050,6 +2124,85 @@ bool Datapath::ModifyIptables(IpFamily family,
   return success;
 }
 
+void Datapath::StartIptablesTransaction() {
+  if (iptables_transaction_depth_++ == 0) {
+    iptables_transaction_failed_ = false;
+  }
+}
+
+bool Datapath::CommitIptablesTransaction() {
+  DCHECK_GT(iptables_transaction_depth_, 0);
+  if (--iptables_transaction_depth_ > 0) {
+    return true;
+  }
+  if (!ApplyPendingIptablesCommands()) {
+    iptables_transaction_failed_ = true;
+  }
+  return !iptables_transaction_failed_;
+}
+
+bool Datapath::ApplyPendingIptablesCommands() {
+  if (pending_iptables_commands_.empty()) {
+    return true;
+  }
+  std::vector<IptablesCommand> commands;
+  commands.swap(pending_iptables_commands_);
+
+  // Groups the commands by family and table, keeping the order in each group.
+  // Tables are independent of each other, so the order across groups does not
+  // matter.
+  std::map<std::pair<IpFamily, Iptables::Table>, std::vector<IptablesCommand*>>
+      groups;
+  for (auto& command : commands) {
+    groups[{command.family, command.table}].push_back(&command);
+  }
+
+  bool success = true;
+  for (const auto& [key, group] : groups) {
+    const auto& [family, table] = key;
+    std::string script = "*" + Iptables::TableName(table) + "\n";
+    for (const auto* command : group) {
+      script += Iptables::CommandName(command->command) + " " +
+                QuoteIptablesRestoreArg(command->chain);
+      for (const auto& arg : command->argv) {
+        // iptables-restore takes the lock for the whole input, and rejects -w
+        // in the rule lines.
+        if (arg == "-w") {
+          continue;
+        }
+        script += " " + QuoteIptablesRestoreArg(arg);
+      }
+      script += "\n";
+    }
+    script += "COMMIT\n";
+
+    const int ret =
+        (family == IpFamily::kIPv4)
+            ? process_runner_->iptables_restore(script)
+            : process_runner_->ip6tables_restore(script);
+    if (ret == 0) {
+      continue;
+    }
+
+    // Nothing in the table has been changed. Falls back to applying the
+    // changes one by one, so that a single bad rule doesn't drop the others.
+    LOG(WARNING) << "Failed to apply " << group.size() << " changes to "
+                 << table << " table with "
+                 << (family == IpFamily::kIPv4 ? "iptables" : "ip6tables")
+                 << "-restore, applying them one by one";
+    for (const auto* command : group) {
+      const int command_ret =
+          (family == IpFamily::kIPv4)
+              ? process_runner_->iptables(table, command->command,
+                                          command->chain, command->argv)
+              : process_runner_->ip6tables(table, command->command,
+                                           command->chain, command->argv);
+      success &= command_ret == 0;
+    }
+  }
+  return success;
+}
+
 std::string Datapath::DumpIptables(IpFamily family, Iptables::Table table) {
   std::string result;
   std::vector<std::string> argv = {"-x", "-v", "-n", "-w"};
@@ -396,6 +396,22 @@ class Datapath {
   // either IPv4 or IPv6.
   virtual std::string DumpIptables(IpFamily family, Iptables::Table table);
 
+  // Starts an iptables transaction. Until the matching
+  // CommitIptablesTransaction(), the changes sent with ModifyIptables() are
+  // collected instead of being applied one by one, and they are then applied
+  // with one iptables-restore per IP family and table. Commands that only
+  // query the state (-C, -L, -S) and commands sent with |log_failures| false,
+  // which are expected to fail sometimes, are not collected: the changes
+  // collected so far are applied before running them, so that the order of all
+  // the commands is kept. Transactions can be nested, in which case the changes
+  // are applied when the outermost transaction is committed.
+  void StartIptablesTransaction();
+  // Applies the changes collected since StartIptablesTransaction(). If
+  // iptables-restore fails for a table, the changes to that table are applied
+  // one by one instead, as they would be without a transaction. Returns false
+  // if any of the changes failed.
+  bool CommitIptablesTransaction();
+
   // Changes firewall rules based on |request|, allowing ingress traffic to a
   // port, forwarding ingress traffic to a port into ARC or Crostini, or
   // restricting localhost ports for listen(). This function corresponds to
@@ -407,6 +423,9 @@ class Datapath {
   // delete all additionals chains created by patchpanel for routing. Traffic
   // accounting chains are not deleted.
   void ResetIptables();
+  // Applies the iptables changes collected in the current transaction.
+  // Returns false if any of the changes failed.
+  bool ApplyPendingIptablesCommands();
   // Creates a virtual interface pair.
   bool AddVirtualInterfacePair(const std::string& netns_name,
                                const std::string& veth_ifname,
@@ -429,6 +448,10 @@ class Datapath {
   // Tethering, LocalOnlyNetwork).
   void AddDownstreamInterfaceRules(const std::string& int_ifname,
                                    TrafficSource source);
+  // Tags traffic from |int_ifname| with the fwmark routing tag of
+  // |ext_ifname|.
+  void AddRoutingTagRule(const std::string& ext_ifname,
+                         const std::string& int_ifname);
 
   bool ModifyChromeDnsRedirect(IpFamily family,
                                const DnsRedirectionRule& rule,
@@ -529,6 +552,21 @@ class Datapath {
   // Shill Device known by its interface name. This is used for redirecting
   // DNS queries of system services when a VPN is connected.
   std::map<std::string, std::string> physical_dns_addresses_;
+
+  // An iptables command collected in a transaction. |family| is either IPv4 or
+  // IPv6.
+  struct IptablesCommand {
+    IpFamily family;
+    Iptables::Table table;
+    Iptables::Command command;
+    std::string chain;
+    std::vector<std::string> argv;
+  };
+  // Nesting depth of the iptables transactions. No transaction is active if 0.
+  int iptables_transaction_depth_ = 0;
+  // Whether any of the changes applied in the current transaction failed.
+  bool iptables_transaction_failed_ = false;
+  std::vector<IptablesCommand> pending_iptables_commands_;
 };
 
 }  // namespace patchpanel
@@ -53,6 +53,12 @@ class FakeProcessRunner : public MinijailedProcessRunner {
     return 0;
   }
 
+  int RunIptablesRestore(std::string_view iptables_restore_path,
+                         std::string_view script,
+                         bool log_failures) override {
+    return 0;
+  }
+
   int RunIpNetns(const std::vector<std::string>& argv,
                  bool log_failures) override {
     return 0;
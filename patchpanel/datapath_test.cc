@@ -57,9 +57,12 @@ std::vector<std::string> SplitArgs(const std::string& args) {
                            base::SplitResult::SPLIT_WANT_NONEMPTY);
 }
 
+class MockProcessRunner;
+void ReplayIptablesRestore(MockProcessRunner& runner);
+
 class MockProcessRunner : public MinijailedProcessRunner {
  public:
-  MockProcessRunner() = default;
+  MockProcessRunner() { ReplayIptablesRestore(*this); }
   ~MockProcessRunner() = default;
 
   MOCK_METHOD(int,
@@ -94,6 +97,14 @@ class MockProcessRunner : public MinijailedProcessRunner {
                bool log_failures,
                std::string* output),
               (override));
+  MOCK_METHOD(int,
+              iptables_restore,
+              (std::string_view script, bool log_failures),
+              (override));
+  MOCK_METHOD(int,
+              ip6tables_restore,
+              (std::string_view script, bool log_failures),
+              (override));
   MOCK_METHOD(int,
               ip_netns_add,
               (const std::string& netns_name, bool log_failures),
@@ -222,6 +233,57 @@ void Verify_iptables_in_sequence(MockProcessRunner& runner,
   }
 }
 
+// Makes |runner| run the iptables commands in the iptables-restore input as if
+// they were sent one by one, so that the expectations on the iptables and
+// ip6tables calls are also met by the commands sent in a transaction. Every
+// MockProcessRunner does this by default.
+void ReplayIptablesRestore(MockProcessRunner& runner) {
+  auto replay = [&runner](IpFamily family, std::string_view script,
+                          bool log_failures) {
+    std::optional<Iptables::Table> table;
+    for (const auto& line :
+         base::SplitString(script, "\n", base::TRIM_WHITESPACE,
+                           base::SPLIT_WANT_NONEMPTY)) {
+      if (line[0] == '*') {
+        table = Iptables::TableFromName(line.substr(1));
+        continue;
+      }
+      if (line == "COMMIT") {
+        continue;
+      }
+      auto argv = SplitArgs(line);
+      const auto command = Iptables::CommandFromName(argv[0]);
+      const auto chain = argv[1];
+      argv.erase(argv.begin(), argv.begin() + 2);
+      // -w is not allowed in the iptables-restore input.
+      argv.push_back("-w");
+      EXPECT_TRUE(table.has_value()) << script;
+      EXPECT_TRUE(command.has_value()) << line;
+      if (!table || !command) {
+        return 1;
+      }
+      const int ret =
+          (family == IpFamily::kIPv4)
+              ? runner.iptables(*table, *command, chain, argv, log_failures,
+                                nullptr)
+              : runner.ip6tables(*table, *command, chain, argv, log_failures,
+                                 nullptr);
+      if (ret != 0) {
+        return ret;
+      }
+    }
+    return 0;
+  };
+  ON_CALL(runner, iptables_restore)
+      .WillByDefault([replay](std::string_view script, bool log_failures) {
+        return replay(IpFamily::kIPv4, script, log_failures);
+      });
+  ON_CALL(runner, ip6tables_restore)
+      .WillByDefault([replay](std::string_view script, bool log_failures) {
+        return replay(IpFamily::kIPv6, script, log_failures);
+      });
+}
+
 void Verify_ip_netns_add(MockProcessRunner& runner,
                          const std::string& netns_name) {
   EXPECT_CALL(runner, ip_netns_add(StrEq(netns_name), _));
@@ -504,6 +566,9 @@ TEST(DatapathTest, Start) {
   for (const auto& c : iptables_commands) {
     Verify_iptables(*runner, c.family, c.args);
   }
+  // The rules are set up in a transaction.
+  EXPECT_CALL(*runner, iptables_restore).Times(testing::AtLeast(1));
+  EXPECT_CALL(*runner, ip6tables_restore).Times(testing::AtLeast(1));
 
   Datapath datapath(runner, firewall, &system);
   datapath.Start();
@@ -603,6 +668,76 @@ TEST(DatapathTest, Stop) {
   datapath.Stop();
 }
 
+TEST(DatapathTest, IptablesTransaction) {
+  auto runner = new MockProcessRunner();
+  auto firewall = new MockFirewall();
+  FakeSystem system;
+  Datapath datapath(runner, firewall, &system);
+
+  Sequence sequence;
+  // The changes before the query are applied before it, grouped by family and
+  // table.
+  EXPECT_CALL(*runner, iptables_restore(StrEq("*filter\n"
+                                              "-N chain1\n"
+                                              "-A chain1 -j ACCEPT\n"
+                                              "COMMIT\n"),
+                                        _))
+      .InSequence(sequence)
+      .WillOnce(Return(0));
+  EXPECT_CALL(*runner, iptables_restore(StrEq("*nat\n"
+                                              "-A OUTPUT -m comment --comment "
+                                              "\"a \\\"b\\\"\" -j ACCEPT\n"
+                                              "COMMIT\n"),
+                                        _))
+      .InSequence(sequence)
+      .WillOnce(Return(0));
+  EXPECT_CALL(*runner, ip6tables_restore(StrEq("*filter\n"
+                                               "-N chain1\n"
+                                               "COMMIT\n"),
+                                         _))
+      .InSequence(sequence)
+      .WillOnce(Return(0));
+  Verify_iptables_in_sequence(*runner, IpFamily::kIPv4,
+                              "filter -L chain1 -w", sequence);
+  // The restore fails for the changes after the query, which are then sent
+  // one by one.
+  EXPECT_CALL(*runner, iptables_restore(StrEq("*mangle\n"
+                                              "-F chain2\n"
+                                              "-X chain2\n"
+                                              "COMMIT\n"),
+                                        _))
+      .InSequence(sequence)
+      .WillOnce(Return(1));
+  EXPECT_CALL(*runner, iptables(Iptables::Table::kMangle, Iptables::Command::kF,
+                                StrEq("chain2"), ElementsAre("-w"), _, nullptr))
+      .InSequence(sequence)
+      .WillOnce(Return(0));
+  EXPECT_CALL(*runner, iptables(Iptables::Table::kMangle, Iptables::Command::kX,
+                                StrEq("chain2"), ElementsAre("-w"), _, nullptr))
+      .InSequence(sequence)
+      .WillOnce(Return(1));
+
+  datapath.StartIptablesTransaction();
+  EXPECT_TRUE(datapath.AddChain(IpFamily::kDual, Iptables::Table::kFilter,
+                                "chain1"));
+  EXPECT_TRUE(datapath.ModifyIptables(IpFamily::kIPv4, Iptables::Table::kFilter,
+                                      Iptables::Command::kA, "chain1",
+                                      {"-j", "ACCEPT", "-w"}));
+  EXPECT_TRUE(datapath.ModifyIptables(
+      IpFamily::kIPv4, Iptables::Table::kNat, Iptables::Command::kA, "OUTPUT",
+      {"-m", "comment", "--comment", "a \"b\"", "-j", "ACCEPT", "-w"}));
+  EXPECT_TRUE(datapath.ModifyChain(IpFamily::kIPv4, Iptables::Table::kFilter,
+                                   Iptables::Command::kL, "chain1"));
+  // Nested transactions are applied with the outermost one.
+  datapath.StartIptablesTransaction();
+  EXPECT_TRUE(datapath.FlushChain(IpFamily::kIPv4, Iptables::Table::kMangle,
+                                  "chain2"));
+  EXPECT_TRUE(datapath.CommitIptablesTransaction());
+  EXPECT_TRUE(datapath.RemoveChain(IpFamily::kIPv4, Iptables::Table::kMangle,
+                                   "chain2"));
+  EXPECT_FALSE(datapath.CommitIptablesTransaction());
+}
+
 TEST(DatapathTest, AddTAP) {
   auto runner = new MockProcessRunner();
   auto firewall = new MockFirewall();
@@ -0,0 +1,32 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PATCHPANEL_FORWARDER_STATS_H_
+#define PATCHPANEL_FORWARDER_STATS_H_
+
+#include <stdint.h>
+
+namespace patchpanel {
+
+// Packet and syscall counters of a multicast or broadcast forwarder. Together
+// they tell how many packets are received or sent on average by each
+// recvmmsg() or sendmmsg() call.
+struct ForwarderStats {
+  uint64_t packets_received = 0;
+  uint64_t packets_sent = 0;
+  uint64_t receive_syscalls = 0;
+  uint64_t send_syscalls = 0;
+
+  ForwarderStats& operator+=(const ForwarderStats& other) {
+    packets_received += other.packets_received;
+    packets_sent += other.packets_sent;
+    receive_syscalls += other.receive_syscalls;
+    send_syscalls += other.send_syscalls;
+    return *this;
+  }
+};
+
+}  // namespace patchpanel
+
+#endif  // PATCHPANEL_FORWARDER_STATS_H_
@@ -0,0 +1,262 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "patchpanel/iptables_counters_reader.h"
+
+#include <errno.h>
+#include <linux/netfilter/x_tables.h>
+#include <linux/netfilter/xt_mark.h>
+#include <linux/netfilter_ipv4/ip_tables.h>
+#include <linux/netfilter_ipv6/ip6_tables.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <base/files/scoped_file.h>
+#include <base/logging.h>
+
+namespace patchpanel {
+
+namespace {
+
+// Number of attempts to read a table. The read fails with EAGAIN when the
+// table is modified between getting its size and getting its entries.
+constexpr int kMaxReadAttempts = 3;
+
+constexpr char kMarkMatchName[] = "mark";
+// Revision of the mark match using xt_mark_mtinfo1.
+constexpr uint8_t kMarkMatchRevision = 1;
+
+struct IPv4Traits {
+  using Entry = ipt_entry;
+  using GetInfo = ipt_getinfo;
+  using GetEntries = ipt_get_entries;
+  static constexpr int kDomain = AF_INET;
+  static constexpr int kLevel = IPPROTO_IP;
+  static constexpr int kGetInfoOption = IPT_SO_GET_INFO;
+  static constexpr int kGetEntriesOption = IPT_SO_GET_ENTRIES;
+};
+
+struct IPv6Traits {
+  using Entry = ip6t_entry;
+  using GetInfo = ip6t_getinfo;
+  using GetEntries = ip6t_get_entries;
+  static constexpr int kDomain = AF_INET6;
+  static constexpr int kLevel = IPPROTO_IPV6;
+  static constexpr int kGetInfoOption = IP6T_SO_GET_INFO;
+  static constexpr int kGetEntriesOption = IP6T_SO_GET_ENTRIES;
+};
+
+// Returns the NUL-terminated string in |name|, which may not be terminated if
+// it fills the array.
+template <size_t N>
+std::string NameToString(const char (&name)[N]) {
+  return std::string(name, strnlen(name, N));
+}
+
+// Parses the matches of the entry at |entry|, which are between the fixed
+// header of size |header_size| and |target_offset|, into |rule|.
+bool ParseMatches(const uint8_t* entry,
+                  size_t header_size,
+                  size_t target_offset,
+                  IptablesCountersReader::Rule* rule) {
+  size_t offset = header_size;
+  while (offset < target_offset) {
+    xt_entry_match match;
+    if (target_offset - offset < sizeof(match)) {
+      return false;
+    }
+    memcpy(&match, entry + offset, sizeof(match));
+    const size_t match_size = match.u.user.match_size;
+    if (match_size < sizeof(match) || match_size > target_offset - offset) {
+      return false;
+    }
+
+    xt_mark_mtinfo1 mark_info;
+    if (NameToString(match.u.user.name) == kMarkMatchName &&
+        match.u.user.revision == kMarkMatchRevision &&
+        match_size - sizeof(match) >= sizeof(mark_info)) {
+      memcpy(&mark_info, entry + offset + sizeof(match), sizeof(mark_info));
+      if (mark_info.invert) {
+        rule->has_other_matches = true;
+      } else {
+        rule->mark = mark_info.mark;
+        rule->mark_mask = mark_info.mask;
+      }
+    } else {
+      rule->has_other_matches = true;
+    }
+    offset += match_size;
+  }
+  return true;
+}
+
+template <typename Traits>
+std::optional<IptablesCountersReader::Chains> ParseEntriesImpl(
+    base::span<const uint8_t> entries,
+    const std::vector<size_t>& builtin_chain_offsets) {
+  using Entry = typename Traits::Entry;
+
+  IptablesCountersReader::Chains chains;
+  // The rules of the user-defined chain being parsed, or nullptr while parsing
+  // a built-in chain.
+  std::vector<IptablesCountersReader::Rule>* rules = nullptr;
+  // The last entry of a user-defined chain is the implicit RETURN, which is
+  // not a rule shown by iptables.
+  auto end_chain = [&rules]() {
+    if (rules && !rules->empty()) {
+      rules->pop_back();
+    }
+    rules = nullptr;
+  };
+
+  size_t offset = 0;
+  while (offset < entries.size()) {
+    Entry header;
+    if (entries.size() - offset < sizeof(header)) {
+      return std::nullopt;
+    }
+    const uint8_t* entry = entries.data() + offset;
+    memcpy(&header, entry, sizeof(header));
+    const size_t target_offset = header.target_offset;
+    const size_t next_offset = header.next_offset;
+    if (target_offset < sizeof(header) ||
+        next_offset > entries.size() - offset || next_offset < target_offset ||
+        next_offset - target_offset < sizeof(xt_entry_target)) {
+      return std::nullopt;
+    }
+
+    for (size_t builtin_offset : builtin_chain_offsets) {
+      if (offset == builtin_offset) {
+        end_chain();
+      }
+    }
+
+    xt_entry_target target;
+    memcpy(&target, entry + target_offset, sizeof(target));
+    if (NameToString(target.u.user.name) == XT_ERROR_TARGET) {
+      // The head of a user-defined chain, whose name is the data of the
+      // target, or the end of the table if the name is "ERROR".
+      char chain_name[XT_FUNCTION_MAXNAMELEN] = {0};
+      memcpy(chain_name, entry + target_offset + sizeof(target),
+             std::min(sizeof(chain_name),
+                      next_offset - target_offset - sizeof(target)));
+      end_chain();
+      const std::string name = NameToString(chain_name);
+      if (name != XT_ERROR_TARGET) {
+        rules = &chains[name];
+      }
+    } else if (rules) {
+      IptablesCountersReader::Rule rule;
+      rule.packets = header.counters.pcnt;
+      rule.bytes = header.counters.bcnt;
+      if (!ParseMatches(entry, sizeof(header), target_offset, &rule)) {
+        return std::nullopt;
+      }
+      rules->push_back(rule);
+    }
+    offset += next_offset;
+  }
+  end_chain();
+  return chains;
+}
+
+template <typename Traits>
+std::optional<IptablesCountersReader::Chains> ReadChainsImpl(
+    Iptables::Table table) {
+  using GetInfo = typename Traits::GetInfo;
+  using GetEntries = typename Traits::GetEntries;
+
+  base::ScopedFD fd(
+      socket(Traits::kDomain, SOCK_RAW | SOCK_CLOEXEC, IPPROTO_RAW));
+  if (!fd.is_valid()) {
+    PLOG(ERROR) << "Failed to create socket for reading iptables";
+    return std::nullopt;
+  }
+  const std::string table_name = Iptables::TableName(table);
+
+  for (int attempt = 0; attempt < kMaxReadAttempts; attempt++) {
+    GetInfo info = {};
+    strncpy(info.name, table_name.c_str(), sizeof(info.name) - 1);
+    socklen_t info_size = sizeof(info);
+    if (getsockopt(fd.get(), Traits::kLevel, Traits::kGetInfoOption, &info,
+                   &info_size) != 0) {
+      // ENOENT is expected if the table is managed by nftables.
+      PLOG(WARNING) << "Failed to get the info of " << table << " table";
+      return std::nullopt;
+    }
+
+    // Unsigned long long to keep the entries aligned for their 64-bit
+    // counters.
+    const size_t buffer_size = offsetof(GetEntries, entrytable) + info.size;
+    std::vector<unsigned long long> buffer(  // NOLINT(runtime/int)
+        (buffer_size + sizeof(unsigned long long) - 1) /  // NOLINT(runtime/int)
+        sizeof(unsigned long long));                      // NOLINT(runtime/int)
+    auto* get_entries = reinterpret_cast<GetEntries*>(buffer.data());
+    strncpy(get_entries->name, table_name.c_str(),
+            sizeof(get_entries->name) - 1);
+    get_entries->size = info.size;
+    socklen_t entries_size = static_cast<socklen_t>(buffer_size);
+    if (getsockopt(fd.get(), Traits::kLevel, Traits::kGetEntriesOption,
+                   get_entries, &entries_size) != 0) {
+      if (errno == EAGAIN) {
+        continue;
+      }
+      PLOG(ERROR) << "Failed to get the entries of " << table << " table";
+      return std::nullopt;
+    }
+
+    std::vector<size_t> builtin_chain_offsets;
+    for (int hook = 0; hook < NF_INET_NUMHOOKS; hook++) {
+      if (info.valid_hooks & (1u << hook)) {
+        builtin_chain_offsets.push_back(info.hook_entry[hook]);
+      }
+    }
+    return ParseEntriesImpl<Traits>(
+        base::make_span(reinterpret_cast<const uint8_t*>(get_entries) +
+                            offsetof(GetEntries, entrytable),
+                        info.size),
+        builtin_chain_offsets);
+  }
+  LOG(ERROR) << table << " table kept changing while being read";
+  return std::nullopt;
+}
+
+}  // namespace
+
+std::optional<IptablesCountersReader::Chains>
+IptablesCountersReader::ReadChains(IpFamily family, Iptables::Table table) {
+  switch (family) {
+    case IpFamily::kIPv4:
+      return ReadChainsImpl<IPv4Traits>(table);
+    case IpFamily::kIPv6:
+      return ReadChainsImpl<IPv6Traits>(table);
+    case IpFamily::kDual:
+      LOG(ERROR) << "Cannot read iptables and ip6tables at the same time";
+      return std::nullopt;
+  }
+}
+
+// static
+std::optional<IptablesCountersReader::Chains>
+IptablesCountersReader::ParseEntries(
+    IpFamily family,
+    base::span<const uint8_t> entries,
+    const std::vector<size_t>& builtin_chain_offsets) {
+  switch (family) {
+    case IpFamily::kIPv4:
+      return ParseEntriesImpl<IPv4Traits>(entries, builtin_chain_offsets);
+    case IpFamily::kIPv6:
+      return ParseEntriesImpl<IPv6Traits>(entries, builtin_chain_offsets);
+    case IpFamily::kDual:
+      return std::nullopt;
+  }
+}
+
+}  // namespace patchpanel
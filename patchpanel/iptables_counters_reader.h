@@ -0,0 +1,69 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PATCHPANEL_IPTABLES_COUNTERS_READER_H_
+#define PATCHPANEL_IPTABLES_COUNTERS_READER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <base/containers/span.h>
+
+#include "patchpanel/datapath.h"
+#include "patchpanel/iptables.h"
+
+namespace patchpanel {
+
+// Reads the packet and byte counters of iptables rules directly from the
+// kernel with the IPT_SO_GET_ENTRIES and IP6T_SO_GET_ENTRIES socket options.
+// This is how `iptables -L` gets the rules, but without spawning a process nor
+// formatting and parsing the text output. Only tables managed by the legacy
+// x_tables backend can be read: the read fails if the table is managed by
+// nftables.
+class IptablesCountersReader {
+ public:
+  // Counters and the fwmark match of a rule.
+  struct Rule {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    // The value and the mask of the "-m mark --mark value/mask" match of the
+    // rule, if any.
+    std::optional<uint32_t> mark;
+    std::optional<uint32_t> mark_mask;
+    // True if the rule has a match other than a non-inverted fwmark match.
+    bool has_other_matches = false;
+  };
+  // The rules of each user-defined chain, in order. The rules in the built-in
+  // chains are not included.
+  using Chains = std::map<std::string, std::vector<Rule>>;
+
+  IptablesCountersReader() = default;
+  IptablesCountersReader(const IptablesCountersReader&) = delete;
+  IptablesCountersReader& operator=(const IptablesCountersReader&) = delete;
+
+  virtual ~IptablesCountersReader() = default;
+
+  // Reads the rules of the user-defined chains in |table|. |family| must be
+  // either IPv4 or IPv6. Returns std::nullopt on failure.
+  virtual std::optional<Chains> ReadChains(IpFamily family,
+                                           Iptables::Table table);
+
+  // Parses the rule entries returned by IPT_SO_GET_ENTRIES (or
+  // IP6T_SO_GET_ENTRIES if |family| is IPv6). |builtin_chain_offsets| are the
+  // offsets of the first entries of the built-in chains in |entries|. Returns
+  // std::nullopt if |entries| is malformed.
+  static std::optional<Chains> ParseEntries(
+      IpFamily family,
+      base::span<const uint8_t> entries,
+      const std::vector<size_t>& builtin_chain_offsets);
+};
+
+}  // namespace patchpanel
+
+#endif  // PATCHPANEL_IPTABLES_COUNTERS_READER_H_
@@ -0,0 +1,222 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "patchpanel/iptables_counters_reader.h"
+
+#include <linux/netfilter/x_tables.h>
+#include <linux/netfilter/xt_mark.h>
+#include <linux/netfilter_ipv4/ip_tables.h>
+#include <linux/netfilter_ipv6/ip6_tables.h>
+#include <string.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace patchpanel {
+namespace {
+
+// Builds the entries of a table in the format returned by IPT_SO_GET_ENTRIES
+// (or IP6T_SO_GET_ENTRIES).
+template <typename Entry>
+class EntriesBuilder {
+ public:
+  // Starts a built-in chain. The following rules belong to it.
+  void StartBuiltinChain() { builtin_chain_offsets_.push_back(data_.size()); }
+
+  // Adds the head of the user-defined chain |name|.
+  void StartUserChain(const std::string& name) {
+    AddEntry(0, 0, {}, XT_ERROR_TARGET, name);
+  }
+
+  // Adds a rule with an optional fwmark match and an unknown match.
+  void AddRule(uint64_t packets,
+               uint64_t bytes,
+               std::optional<xt_mark_mtinfo1> mark_match = std::nullopt,
+               bool other_match = false) {
+    std::vector<uint8_t> matches;
+    if (mark_match) {
+      AppendMatch("mark", 1, &*mark_match, sizeof(*mark_match), &matches);
+    }
+    if (other_match) {
+      const uint32_t data = 0;
+      AppendMatch("comment", 0, &data, sizeof(data), &matches);
+    }
+    AddEntry(packets, bytes, matches, XT_STANDARD_TARGET, "");
+  }
+
+  // Adds the footer of the table.
+  void End() { StartUserChain(XT_ERROR_TARGET); }
+
+  const std::vector<uint8_t>& data() const { return data_; }
+  const std::vector<size_t>& builtin_chain_offsets() const {
+    return builtin_chain_offsets_;
+  }
+
+ private:
+  static void AppendMatch(const char* name,
+                          uint8_t revision,
+                          const void* data,
+                          size_t size,
+                          std::vector<uint8_t>* matches) {
+    xt_entry_match match = {};
+    match.u.user.match_size =
+        static_cast<uint16_t>(XT_ALIGN(sizeof(match) + size));
+    strncpy(match.u.user.name, name, sizeof(match.u.user.name) - 1);
+    match.u.user.revision = revision;
+    const size_t offset = matches->size();
+    matches->resize(offset + match.u.user.match_size);
+    memcpy(matches->data() + offset, &match, sizeof(match));
+    memcpy(matches->data() + offset + sizeof(match), data, size);
+  }
+
+  void AddEntry(uint64_t packets,
+                uint64_t bytes,
+                const std::vector<uint8_t>& matches,
+                const char* target_name,
+                const std::string& target_data) {
+    xt_entry_target target = {};
+    const size_t target_size =
+        XT_ALIGN(sizeof(target) + XT_FUNCTION_MAXNAMELEN);
+    target.u.user.target_size = static_cast<uint16_t>(target_size);
+    strncpy(target.u.user.name, target_name, sizeof(target.u.user.name) - 1);
+
+    Entry entry = {};
+    entry.target_offset =
+        static_cast<uint16_t>(sizeof(entry) + matches.size());
+    entry.next_offset =
+        static_cast<uint16_t>(entry.target_offset + target_size);
+    entry.counters.pcnt = packets;
+    entry.counters.bcnt = bytes;
+
+    const size_t offset = data_.size();
+    data_.resize(offset + entry.next_offset);
+    uint8_t* p = data_.data() + offset;
+    memcpy(p, &entry, sizeof(entry));
+    if (!matches.empty()) {
+      memcpy(p + sizeof(entry), matches.data(), matches.size());
+    }
+    memcpy(p + entry.target_offset, &target, sizeof(target));
+    memcpy(p + entry.target_offset + sizeof(target), target_data.c_str(),
+           std::min(target_data.size(), size_t{XT_FUNCTION_MAXNAMELEN - 1}));
+  }
+
+  std::vector<uint8_t> data_;
+  std::vector<size_t> builtin_chain_offsets_;
+};
+
+xt_mark_mtinfo1 MarkMatch(uint32_t mark, uint32_t mask, bool invert = false) {
+  xt_mark_mtinfo1 info = {};
+  info.mark = mark;
+  info.mask = mask;
+  info.invert = invert ? 1 : 0;
+  return info;
+}
+
+template <typename Entry>
+EntriesBuilder<Entry> BuildMangleTable() {
+  EntriesBuilder<Entry> builder;
+  builder.StartBuiltinChain();
+  // A jump rule and the policy of the built-in chain.
+  builder.AddRule(312491, 1767147156);
+  builder.AddRule(4421, 2461233);
+  builder.StartBuiltinChain();
+  builder.AddRule(22785, 136093545);
+  builder.StartUserChain("rx_eth0");
+  builder.AddRule(73, 11938, MarkMatch(0x100, 0x3f00));
+  builder.AddRule(0, 0, MarkMatch(0x200, 0x3f00));
+  builder.AddRule(6, 345);
+  // The implicit RETURN at the end of the chain.
+  builder.AddRule(1, 1);
+  builder.StartUserChain("tx_eth0");
+  builder.AddRule(1366, 244427, MarkMatch(0x100, 0x3f00, /*invert=*/true));
+  builder.AddRule(4, 123, MarkMatch(0x100, 0x3f00), /*other_match=*/true);
+  builder.AddRule(1, 1);
+  builder.StartUserChain("empty");
+  builder.AddRule(1, 1);
+  builder.End();
+  return builder;
+}
+
+template <typename Entry>
+void TestParseEntries(IpFamily family) {
+  const auto builder = BuildMangleTable<Entry>();
+  const auto chains = IptablesCountersReader::ParseEntries(
+      family, builder.data(), builder.builtin_chain_offsets());
+  ASSERT_TRUE(chains);
+  ASSERT_EQ(3u, chains->size());
+
+  const auto& rx_rules = chains->at("rx_eth0");
+  ASSERT_EQ(3u, rx_rules.size());
+  EXPECT_EQ(73u, rx_rules[0].packets);
+  EXPECT_EQ(11938u, rx_rules[0].bytes);
+  EXPECT_EQ(0x100u, rx_rules[0].mark);
+  EXPECT_EQ(0x3f00u, rx_rules[0].mark_mask);
+  EXPECT_FALSE(rx_rules[0].has_other_matches);
+  EXPECT_EQ(0u, rx_rules[1].packets);
+  EXPECT_EQ(0x200u, rx_rules[1].mark);
+  EXPECT_EQ(6u, rx_rules[2].packets);
+  EXPECT_EQ(345u, rx_rules[2].bytes);
+  EXPECT_FALSE(rx_rules[2].mark);
+  EXPECT_FALSE(rx_rules[2].mark_mask);
+  EXPECT_FALSE(rx_rules[2].has_other_matches);
+
+  const auto& tx_rules = chains->at("tx_eth0");
+  ASSERT_EQ(2u, tx_rules.size());
+  EXPECT_EQ(1366u, tx_rules[0].packets);
+  EXPECT_FALSE(tx_rules[0].mark);
+  EXPECT_TRUE(tx_rules[0].has_other_matches);
+  EXPECT_EQ(4u, tx_rules[1].packets);
+  EXPECT_EQ(0x100u, tx_rules[1].mark);
+  EXPECT_TRUE(tx_rules[1].has_other_matches);
+
+  EXPECT_TRUE(chains->at("empty").empty());
+}
+
+TEST(IptablesCountersReaderTest, ParseEntriesIPv4) {
+  TestParseEntries<ipt_entry>(IpFamily::kIPv4);
+}
+
+TEST(IptablesCountersReaderTest, ParseEntriesIPv6) {
+  TestParseEntries<ip6t_entry>(IpFamily::kIPv6);
+}
+
+TEST(IptablesCountersReaderTest, ParseTruncatedEntries) {
+  const auto builder = BuildMangleTable<ipt_entry>();
+  std::vector<uint8_t> data = builder.data();
+  // Every truncation but at the boundary of two entries is malformed.
+  data.resize(data.size() - 1);
+  EXPECT_FALSE(IptablesCountersReader::ParseEntries(
+      IpFamily::kIPv4, data, builder.builtin_chain_offsets()));
+  data.resize(sizeof(ipt_entry) - 1);
+  EXPECT_FALSE(IptablesCountersReader::ParseEntries(
+      IpFamily::kIPv4, data, builder.builtin_chain_offsets()));
+}
+
+TEST(IptablesCountersReaderTest, ParseMalformedEntries) {
+  EntriesBuilder<ipt_entry> builder;
+  builder.StartUserChain("rx_eth0");
+  builder.AddRule(1, 1, MarkMatch(0x100, 0x3f00));
+  builder.End();
+  std::vector<uint8_t> data = builder.data();
+
+  // Makes the match of the rule overflow its entry.
+  ipt_entry entry;
+  memcpy(&entry, data.data(), sizeof(entry));
+  const size_t match_offset = entry.next_offset + sizeof(ipt_entry);
+  xt_entry_match match;
+  memcpy(&match, data.data() + match_offset, sizeof(match));
+  match.u.user.match_size = 0xffff;
+  memcpy(data.data() + match_offset, &match, sizeof(match));
+  EXPECT_FALSE(IptablesCountersReader::ParseEntries(IpFamily::kIPv4, data, {}));
+
+  EXPECT_FALSE(IptablesCountersReader::ParseEntries(IpFamily::kDual,
+                                                    builder.data(), {}));
+}
+
+}  // namespace
+}  // namespace patchpanel
@@ -64,6 +64,9 @@ Manager::Manager(const base::FilePath& cmd_path,
   datapath_->Start();
   multicast_counters_svc_->Start();
   multicast_metrics_->Start(MulticastMetrics::Type::kTotal);
+  mcast_proxy_->RegisterFeedbackMessageHandler(base::BindRepeating(
+      &Manager::OnMulticastProxyMessage, weak_factory_.GetWeakPtr()));
+  mcast_proxy_->Listen();
 
   shill_client_->RegisterDevicesChangedHandler(base::BindRepeating(
       &Manager::OnShillDevicesChanged, weak_factory_.GetWeakPtr()));
@@ -839,6 +842,15 @@ bool Manager::DeleteLifelineFd(int dbus_fd) {
   return true;
 }
 
+void Manager::OnMulticastProxyMessage(const FeedbackMessage& msg) {
+  if (!msg.has_multicast_forwarder_stats()) {
+    LOG(ERROR) << "Unexpected feedback message type";
+    return;
+  }
+  multicast_metrics_->SendForwarderStatsMetrics(
+      msg.multicast_forwarder_stats());
+}
+
 void Manager::OnLifelineFdClosed(int client_fd) {
   // The process that requested this port has died/exited.
   DeleteLifelineFd(client_fd);
@@ -203,6 +203,9 @@ class Manager {
   // found.
   void OnLifelineFdClosed(int client_fd);
 
+  // Handles the feedback messages of the multicast proxy subprocess.
+  void OnMulticastProxyMessage(const FeedbackMessage& msg);
+
   void StartForwarding(const ShillClient::Device& shill_device,
                        const std::string& ifname_virtual,
                        const ForwardingSet& fs = {.ipv6 = true,
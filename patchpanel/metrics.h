@@ -51,6 +51,27 @@ constexpr char kMulticastARCWiFiMDNSInactiveCountMetrics[] =
 constexpr char kMulticastARCWiFiSSDPInactiveCountMetrics[] =
     "Network.Multicast.ARC.WiFi.SSDP.InactiveCount";
 
+// UMA metrics for the packets forwarded by the multicast proxy subprocess and
+// the average number of packets received or sent per syscall.
+constexpr char kMulticastForwarderMDNSForwardedCountMetrics[] =
+    "Network.Multicast.Forwarder.MDNS.ForwardedCount";
+constexpr char kMulticastForwarderMDNSReceiveBatchSizeMetrics[] =
+    "Network.Multicast.Forwarder.MDNS.ReceiveBatchSize";
+constexpr char kMulticastForwarderMDNSSendBatchSizeMetrics[] =
+    "Network.Multicast.Forwarder.MDNS.SendBatchSize";
+constexpr char kMulticastForwarderSSDPForwardedCountMetrics[] =
+    "Network.Multicast.Forwarder.SSDP.ForwardedCount";
+constexpr char kMulticastForwarderSSDPReceiveBatchSizeMetrics[] =
+    "Network.Multicast.Forwarder.SSDP.ReceiveBatchSize";
+constexpr char kMulticastForwarderSSDPSendBatchSizeMetrics[] =
+    "Network.Multicast.Forwarder.SSDP.SendBatchSize";
+constexpr char kMulticastForwarderBroadcastForwardedCountMetrics[] =
+    "Network.Multicast.Forwarder.Broadcast.ForwardedCount";
+constexpr char kMulticastForwarderBroadcastReceiveBatchSizeMetrics[] =
+    "Network.Multicast.Forwarder.Broadcast.ReceiveBatchSize";
+constexpr char kMulticastForwarderBroadcastSendBatchSizeMetrics[] =
+    "Network.Multicast.Forwarder.Broadcast.SendBatchSize";
+
 // UMA metrics events for |kDbusUmaEventMetrics|;
 enum class DbusUmaEvent {
   kUnknown = 0,
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include <base/check.h>
+#include <base/files/file_util.h>
 #include <base/files/scoped_file.h>
 #include <base/logging.h>
 #include <base/posix/eintr_wrapper.h>
@@ -36,6 +37,8 @@ constexpr uint64_t kIpNetnsCapMask =
 constexpr char kIpPath[] = "/bin/ip";
 constexpr char kIptablesPath[] = "/sbin/iptables";
 constexpr char kIp6tablesPath[] = "/sbin/ip6tables";
+constexpr char kIptablesRestorePath[] = "/sbin/iptables-restore";
+constexpr char kIp6tablesRestorePath[] = "/sbin/ip6tables-restore";
 constexpr char kModprobePath[] = "/sbin/modprobe";
 
 constexpr char kIptablesSeccompFilterPath[] =
@@ -73,7 +76,8 @@ int MinijailedProcessRunner::RunSyncDestroy(
     brillo::Minijail* mj,
     minijail* jail,
     bool log_failures,
-    std::string* output) {
+    std::string* output,
+    std::optional<std::string_view> input) {
   std::vector<char*> args;
   for (const auto& arg : argv) {
     args.push_back(const_cast<char*>(arg.c_str()));
@@ -81,12 +85,22 @@ int MinijailedProcessRunner::RunSyncDestroy(
   args.push_back(nullptr);
 
   pid_t pid;
+  int fd_stdin = -1;
+  int* stdin_p = input.has_value() ? &fd_stdin : nullptr;
   int fd_stdout = -1;
   int* stdout_p = output ? &fd_stdout : nullptr;
   int fd_stderr = -1;
   int* stderr_p = log_failures ? &fd_stderr : nullptr;
-  bool ran = mj->RunPipesAndDestroy(jail, args, &pid, /*stdin=*/nullptr,
-                                    stdout_p, stderr_p);
+  bool ran = mj->RunPipesAndDestroy(jail, args, &pid, stdin_p, stdout_p,
+                                    stderr_p);
+  if (input.has_value()) {
+    // Closes stdin once written so that the child sees EOF.
+    base::ScopedFD stdin_fd(fd_stdin);
+    if (ran && !base::WriteFileDescriptor(stdin_fd.get(), *input)) {
+      PLOG(ERROR) << "Could not write stdin of '" << base::JoinString(argv, " ")
+                  << "'";
+    }
+  }
   if (output) {
     *output = ReadBlockingFDToStringAndClose(base::ScopedFD(fd_stdout));
   }
@@ -217,6 +231,33 @@ int MinijailedProcessRunner::RunIptables(std::string_view iptables_path,
   return RunSyncDestroy(args, mj_, jail, log_failures, output);
 }
 
+int MinijailedProcessRunner::iptables_restore(std::string_view script,
+                                              bool log_failures) {
+  return RunIptablesRestore(kIptablesRestorePath, script, log_failures);
+}
+
+int MinijailedProcessRunner::ip6tables_restore(std::string_view script,
+                                               bool log_failures) {
+  return RunIptablesRestore(kIp6tablesRestorePath, script, log_failures);
+}
+
+int MinijailedProcessRunner::RunIptablesRestore(
+    std::string_view iptables_restore_path,
+    std::string_view script,
+    bool log_failures) {
+  std::vector<std::string> args = {std::string(iptables_restore_path),
+                                   "--noflush", "-w"};
+
+  minijail* jail = mj_->New();
+  CHECK(mj_->DropRoot(jail, kPatchpaneldUser, kPatchpaneldGroup));
+  mj_->UseCapabilities(jail, kNetRawAdminCapMask);
+
+  // iptables-restore is the same xtables binary as iptables.
+  mj_->UseSeccompFilter(jail, kIptablesSeccompFilterPath);
+
+  return RunSyncDestroy(args, mj_, jail, log_failures, nullptr, script);
+}
+
 int MinijailedProcessRunner::modprobe_all(
     const std::vector<std::string>& modules, bool log_failures) {
   minijail* jail = mj_->New();
@@ -8,6 +8,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -64,6 +65,15 @@ class MinijailedProcessRunner {
                         bool log_failures = true,
                         std::string* output = nullptr);
 
+  // Runs iptables-restore with |script| as the input. Tables are not flushed
+  // before applying the |script|, and the changes to each table in |script|
+  // are applied atomically.
+  virtual int iptables_restore(std::string_view script,
+                               bool log_failures = true);
+
+  virtual int ip6tables_restore(std::string_view script,
+                                bool log_failures = true);
+
   // Installs all |modules| via modprobe.
   virtual int modprobe_all(const std::vector<std::string>& modules,
                            bool log_failures = true);
@@ -97,6 +107,10 @@ class MinijailedProcessRunner {
                           bool log_failures,
                           std::string* output);
 
+  virtual int RunIptablesRestore(std::string_view iptables_restore_path,
+                                 std::string_view script,
+                                 bool log_failures);
+
   virtual int RunIpNetns(const std::vector<std::string>& argv,
                          bool log_failures);
 
@@ -105,7 +119,8 @@ class MinijailedProcessRunner {
                      brillo::Minijail* mj,
                      minijail* jail,
                      bool log_failures,
-                     std::string* output);
+                     std::string* output,
+                     std::optional<std::string_view> input = std::nullopt);
 
   brillo::Minijail* mj_;
   std::unique_ptr<System> system_;
@@ -7,8 +7,13 @@
 #include <linux/capability.h>
 #include <sys/types.h>
 
+#include <unistd.h>
+
 #include <memory>
+#include <string>
 
+#include <base/files/file_util.h>
+#include <base/files/scoped_file.h>
 #include <brillo/minijail/mock_minijail.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -149,5 +154,38 @@ TEST(MinijailProcessRunnerTest, ip6tables) {
                                "chain", {"arg1", "arg2"}));
 }
 
+TEST(MinijailProcessRunnerTest, iptables_restore) {
+  brillo::MockMinijail mj;
+  auto system = new MockSystem();
+  MinijailedProcessRunner runner(&mj, std::unique_ptr<System>(system));
+
+  // The runner writes the script to the stdin pipe of the child.
+  int pipe_fds[2];
+  ASSERT_EQ(0, pipe(pipe_fds));
+  base::ScopedFD read_fd(pipe_fds[0]);
+
+  pid_t pid = 123;
+  EXPECT_CALL(mj, New());
+  EXPECT_CALL(mj, DropRoot(_, _, _)).WillOnce(Return(true));
+  EXPECT_CALL(mj, UseCapabilities(_, _));
+  EXPECT_CALL(mj, RunPipesAndDestroy(
+                      _,
+                      ElementsAre(StrEq("/sbin/iptables-restore"),
+                                  StrEq("--noflush"), StrEq("-w"), nullptr),
+                      _, _, nullptr, _))
+      .WillOnce(DoAll(SetArgPointee<2>(pid), SetArgPointee<3>(pipe_fds[1]),
+                      Return(true)));
+  EXPECT_CALL(*system, WaitPid(pid, _, _))
+      .WillOnce(DoAll(SetArgPointee<1>(0), Return(pid)));
+
+  const std::string script = "*filter\n-A chain arg1 arg2\nCOMMIT\n";
+  EXPECT_EQ(0, runner.iptables_restore(script));
+
+  std::string input;
+  base::ScopedFILE read_file(fdopen(read_fd.release(), "r"));
+  ASSERT_TRUE(base::ReadStreamToString(read_file.get(), &input));
+  EXPECT_EQ(script, input);
+}
+
 }  // namespace
 }  // namespace patchpanel
@@ -12,7 +12,10 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <map>
 #include <utility>
+#include <vector>
 
 #include <base/check.h>
 #include <base/functional/bind.h>
@@ -26,7 +29,7 @@
 
 namespace {
 
-const int kBufSize = 1536;
+constexpr size_t kBufSize = 1536;
 
 // Returns the IPv4 address assigned to the interface on which the given socket
 // is bound. Or returns INADDR_ANY if the interface has no IPv4 address.
@@ -283,45 +286,57 @@ void MulticastForwarder::OnFileCanReadWithoutBlocking(int fd,
                                                       sa_family_t sa_family) {
   CHECK(sa_family == AF_INET || sa_family == AF_INET6);
 
-  char data[kBufSize];
-
-  struct sockaddr_storage fromaddr_storage = {0};
-  struct sockaddr* fromaddr =
-      reinterpret_cast<struct sockaddr*>(&fromaddr_storage);
-
-  socklen_t addrlen = sizeof(struct sockaddr_storage);
-
-  ssize_t r = Receive(fd, data, kBufSize, fromaddr, &addrlen);
+  receive_buffer_.resize(kMaxBatchSize * kBufSize);
+  struct sockaddr_storage fromaddrs[kMaxBatchSize];
+  struct iovec iovs[kMaxBatchSize];
+  struct mmsghdr msgs[kMaxBatchSize];
+  memset(fromaddrs, 0, sizeof(fromaddrs));
+  memset(msgs, 0, sizeof(msgs));
+  for (unsigned int i = 0; i < kMaxBatchSize; i++) {
+    iovs[i].iov_base = receive_buffer_.data() + i * kBufSize;
+    iovs[i].iov_len = kBufSize;
+    msgs[i].msg_hdr.msg_name = &fromaddrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  stats_.receive_syscalls++;
+  int r = ReceiveBatch(fd, msgs, kMaxBatchSize);
   if (r < 0) {
     // Ignore ENETDOWN: this can happen if the interface is not yet configured
     if (errno != ENETDOWN) {
-      PLOG(WARNING) << "recvfrom failed";
+      PLOG(WARNING) << "recvmmsg failed";
     }
     return;
   }
-  size_t len = static_cast<size_t>(r);
+  const unsigned int num_msgs =
+      std::min(static_cast<unsigned int>(r), kMaxBatchSize);
+  stats_.packets_received += num_msgs;
 
   socklen_t expectlen = sa_family == AF_INET ? sizeof(struct sockaddr_in)
                                              : sizeof(struct sockaddr_in6);
-  if (addrlen != expectlen) {
-    LOG(WARNING) << "recvfrom failed: src addr length was " << addrlen
-                 << " but expected " << expectlen;
+  // The payloads and source addresses of the valid datagrams.
+  std::vector<struct iovec> payloads;
+  std::vector<const struct sockaddr*> fromaddr_ptrs;
+  for (unsigned int i = 0; i < num_msgs; i++) {
+    const socklen_t addrlen = msgs[i].msg_hdr.msg_namelen;
+    if (addrlen != expectlen) {
+      LOG(WARNING) << "recvmmsg failed: src addr length was " << addrlen
+                   << " but expected " << expectlen;
+      continue;
+    }
+    payloads.push_back({iovs[i].iov_base,
+                        std::min(static_cast<size_t>(msgs[i].msg_len),
+                                 kBufSize)});
+    fromaddr_ptrs.push_back(reinterpret_cast<struct sockaddr*>(&fromaddrs[i]));
+  }
+  if (payloads.empty()) {
     return;
   }
 
   struct sockaddr_storage dst_storage = {0};
   struct sockaddr* dst = reinterpret_cast<struct sockaddr*>(&dst_storage);
-  uint16_t src_port;
-
-  if (sa_family == AF_INET) {
-    const struct sockaddr_in* addr4 =
-        reinterpret_cast<const struct sockaddr_in*>(fromaddr);
-    src_port = ntohs(addr4->sin_port);
-  } else if (sa_family == AF_INET6) {
-    const struct sockaddr_in6* addr6 =
-        reinterpret_cast<const struct sockaddr_in6*>(fromaddr);
-    src_port = ntohs(addr6->sin6_port);
-  }
   const auto mcast_in_addr = mcast_addr_.ToInAddr();
   const auto mcast_in6_addr = mcast_addr6_.ToIn6Addr();
   SetSockaddr(&dst_storage, sa_family, port_,
@@ -332,7 +347,7 @@ void MulticastForwarder::OnFileCanReadWithoutBlocking(int fd,
   // Forward ingress traffic to all guests.
   const auto& lan_socket = lan_socket_.find(sa_family);
   if ((lan_socket != lan_socket_.end() && fd == lan_socket->second->fd.get())) {
-    SendToGuests(data, len, dst, addrlen);
+    SendToGuests(payloads, dst, expectlen);
     return;
   }
 
@@ -343,7 +358,7 @@ void MulticastForwarder::OnFileCanReadWithoutBlocking(int fd,
   // Forward egress traffic from one guest to all other guests.
   // No IP translation is required as other guests can route to each other
   // behind the SNAT setup.
-  SendToGuests(data, len, dst, addrlen, fd);
+  SendToGuests(payloads, dst, expectlen, fd);
 
   // On mDNS, sending to physical network requires translating any IPv4
   // address specific to the guest and not visible to the physical network.
@@ -359,25 +374,92 @@ void MulticastForwarder::OnFileCanReadWithoutBlocking(int fd,
       // either direction.
       return;
     }
-    TranslateMdnsIp(
-        lan_ip, reinterpret_cast<const struct sockaddr_in*>(fromaddr)->sin_addr,
-        data, len);
+    for (size_t i = 0; i < payloads.size(); i++) {
+      TranslateMdnsIp(
+          lan_ip,
+          reinterpret_cast<const struct sockaddr_in*>(fromaddr_ptrs[i])
+              ->sin_addr,
+          static_cast<char*>(payloads[i].iov_base), payloads[i].iov_len);
+    }
+  }
+
+  // Forward egress traffic from one guest to outside network. Datagrams from
+  // the same source port are sent together.
+  std::map<uint16_t, std::vector<struct iovec>> payloads_by_src_port;
+  for (size_t i = 0; i < payloads.size(); i++) {
+    uint16_t src_port;
+    if (sa_family == AF_INET) {
+      src_port = ntohs(
+          reinterpret_cast<const struct sockaddr_in*>(fromaddr_ptrs[i])
+              ->sin_port);
+    } else {
+      src_port = ntohs(
+          reinterpret_cast<const struct sockaddr_in6*>(fromaddr_ptrs[i])
+              ->sin6_port);
+    }
+    payloads_by_src_port[src_port].push_back(payloads[i]);
+  }
+  for (const auto& [src_port, src_payloads] : payloads_by_src_port) {
+    SendTo(src_port, src_payloads, dst, expectlen);
+  }
+}
+
+ForwarderStats MulticastForwarder::TakeStats() {
+  ForwarderStats stats = stats_;
+  stats_ = {};
+  return stats;
+}
+
+bool MulticastForwarder::SendAll(int fd,
+                                 const std::vector<struct iovec>& payloads,
+                                 const struct sockaddr* dst,
+                                 socklen_t dst_len) {
+  std::vector<struct mmsghdr> msgs(payloads.size());
+  for (size_t i = 0; i < payloads.size(); i++) {
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_name = const_cast<struct sockaddr*>(dst);
+    msgs[i].msg_hdr.msg_namelen = dst_len;
+    msgs[i].msg_hdr.msg_iov = const_cast<struct iovec*>(&payloads[i]);
+    msgs[i].msg_hdr.msg_iovlen = 1;
   }
 
-  // Forward egress traffic from one guest to outside network.
-  SendTo(src_port, data, len, dst, addrlen);
+  bool success = true;
+  int saved_errno = 0;
+  size_t sent = 0;
+  while (sent < msgs.size()) {
+    const unsigned int vlen = static_cast<unsigned int>(
+        std::min(msgs.size() - sent, static_cast<size_t>(kMaxBatchSize)));
+    stats_.send_syscalls++;
+    int r = SendBatch(fd, msgs.data() + sent, vlen);
+    if (r <= 0) {
+      // sendmmsg() fails only if the first datagram fails to be sent. Skips
+      // it and tries the following ones.
+      saved_errno = errno;
+      success = false;
+      sent++;
+      continue;
+    }
+    sent += static_cast<size_t>(r);
+    stats_.packets_sent += static_cast<uint64_t>(r);
+  }
+  if (!success) {
+    errno = saved_errno;
+  }
+  return success;
 }
 
 bool MulticastForwarder::SendTo(uint16_t src_port,
-                                const void* data,
-                                size_t len,
+                                const std::vector<struct iovec>& payloads,
                                 const struct sockaddr* dst,
                                 socklen_t dst_len) {
+  if (payloads.empty()) {
+    return true;
+  }
   auto* lan_socket = lan_socket_.find(dst->sa_family)->second.get();
   if (src_port == port_) {
-    if (sendto(lan_socket->fd.get(), data, len, 0, dst, dst_len) < 0) {
+    if (!SendAll(lan_socket->fd.get(), payloads, dst, dst_len)) {
       if (lan_socket->last_errno != errno) {
-        PLOG(WARNING) << "sendto " << *dst << " on " << lan_ifname_
+        PLOG(WARNING) << "sendmmsg " << *dst << " on " << lan_ifname_
                       << " from port " << src_port << " failed";
         lan_socket->last_errno = errno;
       }
@@ -386,7 +468,6 @@ bool MulticastForwarder::SendTo(uint16_t src_port,
     lan_socket->last_errno = 0;
     return true;
   }
-
   patchpanel::Socket temp_socket(dst->sa_family, SOCK_DGRAM);
   if (!temp_socket.is_valid()) {
     PLOG(ERROR) << "Failed to create UDP socket to forward to " << *dst;
@@ -435,11 +516,11 @@ bool MulticastForwarder::SendTo(uint16_t src_port,
     return false;
   }
 
-  if (temp_socket.SendTo(data, len, dst, dst_len) < 0) {
+  if (!SendAll(temp_socket.fd(), payloads, dst, dst_len)) {
     // Use |lan_socket_| to track last errno. The only expected difference
     // between |temp_socket| and |lan_socket_| is port number.
     if (lan_socket->last_errno != errno) {
-      PLOG(WARNING) << "sendto " << *dst << " on " << lan_ifname_
+      PLOG(WARNING) << "sendmmsg " << *dst << " on " << lan_ifname_
                     << " from port " << src_port << " failed";
       lan_socket->last_errno = errno;
     }
@@ -449,11 +530,14 @@ bool MulticastForwarder::SendTo(uint16_t src_port,
   return true;
 }
 
-bool MulticastForwarder::SendToGuests(const void* data,
-                                      size_t len,
-                                      const struct sockaddr* dst,
-                                      socklen_t dst_len,
-                                      int ignore_fd) {
+bool MulticastForwarder::SendToGuests(
+    const std::vector<struct iovec>& payloads,
+    const struct sockaddr* dst,
+    socklen_t dst_len,
+    int ignore_fd) {
+  if (payloads.empty()) {
+    return true;
+  }
   bool success = true;
   for (const auto& socket : int_sockets_) {
     if (socket.first.first != dst->sa_family)
@@ -463,9 +547,9 @@ bool MulticastForwarder::SendToGuests(const void* data,
       continue;
 
     // Use already created multicast fd.
-    if (sendto(fd, data, len, 0, dst, dst_len) < 0) {
+    if (!SendAll(fd, payloads, dst, dst_len)) {
       if (socket.second->last_errno != errno) {
-        PLOG(WARNING) << "sendto " << socket.first.second << " failed";
+        PLOG(WARNING) << "sendmmsg " << socket.first.second << " failed";
         socket.second->last_errno = errno;
       }
       success = false;
@@ -529,11 +613,17 @@ void MulticastForwarder::TranslateMdnsIp(const struct in_addr& lan_ip,
   }
 }
 
-ssize_t MulticastForwarder::Receive(int fd,
-                                    char* buffer,
-                                    size_t buffer_size,
-                                    struct sockaddr* src_addr,
-                                    socklen_t* addrlen) {
-  return recvfrom(fd, buffer, buffer_size, 0, src_addr, addrlen);
+int MulticastForwarder::ReceiveBatch(int fd,
+                                     struct mmsghdr* msgs,
+                                     unsigned int vlen) {
+  // The socket is readable, so at least one datagram is returned without
+  // waiting for |vlen| of them.
+  return recvmmsg(fd, msgs, vlen, MSG_DONTWAIT, nullptr);
+}
+
+int MulticastForwarder::SendBatch(int fd,
+                                  struct mmsghdr* msgs,
+                                  unsigned int vlen) {
+  return sendmmsg(fd, msgs, vlen, 0);
 }
 }  // namespace patchpanel
@@ -14,12 +14,14 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <base/files/scoped_file.h>
 #include <net-base/ipv4_address.h>
 #include <net-base/ipv6_address.h>
 
 #include "patchpanel/file_descriptor_watcher_posix.h"
+#include "patchpanel/forwarder_stats.h"
 
 namespace patchpanel {
 
@@ -70,9 +72,18 @@ class MulticastForwarder {
                               char* data,
                               size_t len);
 
+  // Receives up to kMaxBatchSize datagrams from |fd| at once and forwards
+  // them.
   void OnFileCanReadWithoutBlocking(int fd, sa_family_t sa_family);
 
+  // Returns the counters accumulated since the last call and resets them.
+  ForwarderStats TakeStats();
+
  protected:
+  // Maximum number of datagrams received with a single recvmmsg() call or sent
+  // with a single sendmmsg() call.
+  static constexpr unsigned int kMaxBatchSize = 16;
+
   // Socket is used to keep track of an fd and its watcher.
   struct Socket {
     base::ScopedFD fd;
@@ -85,35 +96,40 @@ class MulticastForwarder {
   // Bind will create a multicast socket and return its fd.
   virtual base::ScopedFD Bind(sa_family_t sa_family, const std::string& ifname);
 
-  // SendTo sends |data| using a socket bound to |src_port| and |lan_ifname_|.
-  // If |src_port| is equal to |port_|, we will use |lan_socket_|. Otherwise,
-  // create a temporary socket.
+  // SendTo sends |payloads| using a socket bound to |src_port| and
+  // |lan_ifname_|. If |src_port| is equal to |port_|, we will use
+  // |lan_socket_|. Otherwise, create a temporary socket.
   virtual bool SendTo(uint16_t src_port,
-                      const void* data,
-                      size_t len,
+                      const std::vector<struct iovec>& payloads,
                       const struct sockaddr* dst,
                       socklen_t dst_len);
 
-  // SendToGuests will forward packet to all Chrome OS guests' (ARC++,
+  // SendToGuests will forward |payloads| to all Chrome OS guests' (ARC++,
   // Crostini, etc) internal fd using |port|.
   // However, if ignore_fd is not 0, it will skip guest with fd = ignore_fd.
-  virtual bool SendToGuests(const void* data,
-                            size_t len,
+  virtual bool SendToGuests(const std::vector<struct iovec>& payloads,
                             const struct sockaddr* dst,
                             socklen_t dst_len,
                             int ignore_fd = -1);
 
-  // Wrapper around libc recvfrom, allowing override in fuzzer tests.
-  virtual ssize_t Receive(int fd,
-                          char* buffer,
-                          size_t buffer_size,
-                          struct sockaddr* src_addr,
-                          socklen_t* addrlen);
+  // Wrapper around libc recvmmsg, allowing override in fuzzer tests.
+  virtual int ReceiveBatch(int fd, struct mmsghdr* msgs, unsigned int vlen);
+
+  // Wrapper around libc sendmmsg, allowing override in fuzzer tests.
+  virtual int SendBatch(int fd, struct mmsghdr* msgs, unsigned int vlen);
 
   virtual std::unique_ptr<Socket> CreateSocket(base::ScopedFD fd,
                                                sa_family_t family);
 
  private:
+  // Sends all |payloads| to |dst| on |fd| with as few sendmmsg() calls as
+  // possible. Returns false and leaves errno set if any payload fails to be
+  // sent.
+  bool SendAll(int fd,
+               const std::vector<struct iovec>& payloads,
+               const struct sockaddr* dst,
+               socklen_t dst_len);
+
   // Name of the physical interface that this forwarder is bound to.
   std::string lan_ifname_;
   // UDP port of the protocol that this forwarder is processing.
@@ -130,6 +146,10 @@ class MulticastForwarder {
   // A set of internal file descriptors (guest facing sockets) to its guest
   // IP address.
   std::set<std::pair<sa_family_t, int>> int_fds_;
+  // Buffer for the datagrams received at once, |kBufSize| bytes per datagram.
+  std::vector<char> receive_buffer_;
+  // Counters of packets and syscalls since the last call to TakeStats().
+  ForwarderStats stats_;
 };
 
 }  // namespace patchpanel
@@ -56,36 +56,38 @@ class TestMulticastForwarder : public MulticastForwarder {
   }
 
   bool SendTo(uint16_t src_port,
-              const void* data,
-              size_t len,
+              const std::vector<struct iovec>& payloads,
               const struct sockaddr* dst,
               socklen_t dst_len) override {
     return true;
   }
 
-  bool SendToGuests(const void* data,
-                    size_t len,
+  bool SendToGuests(const std::vector<struct iovec>& payloads,
                     const struct sockaddr* dst,
                     socklen_t dst_len,
                     int ignore_fd) override {
     return true;
   }
 
-  ssize_t Receive(int fd,
-                  char* buffer,
-                  size_t buffer_size,
-                  struct sockaddr* src_addr,
-                  socklen_t* addrlen) override {
-    *addrlen = std::min(static_cast<uint32_t>(src_sockaddr.size()), *addrlen);
-    if (*addrlen > 0) {
-      memcpy(src_addr, src_sockaddr.data(), *addrlen);
+  int ReceiveBatch(int fd, struct mmsghdr* msgs, unsigned int vlen) override {
+    struct msghdr* hdr = &msgs[0].msg_hdr;
+    hdr->msg_namelen = std::min(static_cast<uint32_t>(src_sockaddr.size()),
+                                hdr->msg_namelen);
+    struct sockaddr* src_addr = static_cast<struct sockaddr*>(hdr->msg_name);
+    if (hdr->msg_namelen > 0) {
+      memcpy(src_addr, src_sockaddr.data(), hdr->msg_namelen);
     }
-    buffer_size = std::min(payload.size(), buffer_size);
-    if (buffer_size > 0) {
-      memcpy(buffer, payload.data(), buffer_size);
+    size_t len = std::min(payload.size(), hdr->msg_iov[0].iov_len);
+    if (len > 0) {
+      memcpy(hdr->msg_iov[0].iov_base, payload.data(), len);
     }
+    msgs[0].msg_len = static_cast<unsigned int>(len);
     src_addr->sa_family = sa_family;
-    return true;
+    return 1;
+  }
+
+  int SendBatch(int fd, struct mmsghdr* msgs, unsigned int vlen) override {
+    return static_cast<int>(vlen);
   }
 
   std::vector<int> fds;
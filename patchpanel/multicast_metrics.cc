@@ -4,6 +4,7 @@
 
 #include "patchpanel/multicast_metrics.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <optional>
@@ -20,6 +21,7 @@
 #include <base/time/time.h>
 #include <metrics/metrics_library.h>
 
+#include "patchpanel/ipc.h"
 #include "patchpanel/metrics.h"
 #include "patchpanel/multicast_counters_service.h"
 #include "patchpanel/shill_client.h"
@@ -33,6 +35,10 @@ namespace {
 constexpr int kPacketCountMax = 30 * kMulticastPollDelay.InSeconds();
 constexpr int kPacketCountBuckets = 100;
 
+// Maximum recorded number of packets per recvmmsg() or sendmmsg() call of the
+// forwarders, equal to the maximum batch size of the forwarders.
+constexpr int kForwarderBatchSizeMax = 16;
+
 std::optional<MulticastMetrics::Type> ShillDeviceTypeToMulticastMetricsType(
     ShillClient::Device::Type type) {
   switch (type) {
@@ -100,6 +106,31 @@ static constexpr auto kARCMetricNames = base::MakeFixedFlatMap<
      kMulticastARCWiFiSSDPInactiveCountMetrics},
 });
 
+// Metrics names of the forwarders of a given type.
+struct ForwarderMetricNames {
+  base::StringPiece forwarded_count;
+  base::StringPiece receive_batch_size;
+  base::StringPiece send_batch_size;
+};
+
+// Map of forwarder type to its metrics names.
+static constexpr auto kForwarderMetricNames =
+    base::MakeFixedFlatMap<MulticastForwarderStatsMessage::ForwarderType,
+                           ForwarderMetricNames>({
+        {MulticastForwarderStatsMessage::MDNS,
+         {kMulticastForwarderMDNSForwardedCountMetrics,
+          kMulticastForwarderMDNSReceiveBatchSizeMetrics,
+          kMulticastForwarderMDNSSendBatchSizeMetrics}},
+        {MulticastForwarderStatsMessage::SSDP,
+         {kMulticastForwarderSSDPForwardedCountMetrics,
+          kMulticastForwarderSSDPReceiveBatchSizeMetrics,
+          kMulticastForwarderSSDPSendBatchSizeMetrics}},
+        {MulticastForwarderStatsMessage::BROADCAST,
+         {kMulticastForwarderBroadcastForwardedCountMetrics,
+          kMulticastForwarderBroadcastReceiveBatchSizeMetrics,
+          kMulticastForwarderBroadcastSendBatchSizeMetrics}},
+    });
+
 // Get metrics name for UMA.
 std::optional<base::StringPiece> GetMetricsName(
     MulticastMetrics::Type type,
@@ -318,6 +349,44 @@ void MulticastMetrics::SendARCActiveTimeMetrics(
                         wifi_enabled_duration.InSeconds())));
 }
 
+void MulticastMetrics::SendForwarderStatsMetrics(
+    const MulticastForwarderStatsMessage& msg) {
+  if (!metrics_lib_) {
+    LOG(ERROR) << "Metrics client is not valid";
+    return;
+  }
+  if (!kForwarderMetricNames.contains(msg.type())) {
+    LOG(ERROR) << "Unexpected forwarder type " << msg.type();
+    return;
+  }
+  const ForwarderMetricNames& names = kForwarderMetricNames.at(msg.type());
+
+  uint64_t packet_count = msg.packets_sent();
+  if (packet_count > kPacketCountMax) {
+    packet_count = kPacketCountMax;
+  }
+  metrics_lib_->SendToUMA(std::string(names.forwarded_count),
+                          static_cast<int>(packet_count),
+                          /*min=*/0, kPacketCountMax, kPacketCountBuckets);
+
+  if (msg.receive_syscalls() > 0) {
+    const uint64_t batch_size = std::min(
+        msg.packets_received() / msg.receive_syscalls(),
+        static_cast<uint64_t>(kForwarderBatchSizeMax));
+    metrics_lib_->SendLinearToUMA(std::string(names.receive_batch_size),
+                                  static_cast<int>(batch_size),
+                                  kForwarderBatchSizeMax + 1);
+  }
+  if (msg.send_syscalls() > 0) {
+    const uint64_t batch_size =
+        std::min(msg.packets_sent() / msg.send_syscalls(),
+                 static_cast<uint64_t>(kForwarderBatchSizeMax));
+    metrics_lib_->SendLinearToUMA(std::string(names.send_batch_size),
+                                  static_cast<int>(batch_size),
+                                  kForwarderBatchSizeMax + 1);
+  }
+}
+
 MulticastMetrics::Poller::Poller(MulticastMetrics::Type type,
                                  MulticastMetrics* metrics)
     : type_(type), metrics_(metrics) {}
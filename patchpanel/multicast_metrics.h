@@ -17,6 +17,7 @@
 #include <gtest/gtest_prod.h>  // for FRIEND_TEST
 #include <metrics/metrics_library.h>
 
+#include "patchpanel/ipc.h"
 #include "patchpanel/multicast_counters_service.h"
 #include "patchpanel/shill_client.h"
 
@@ -101,6 +102,10 @@ class MulticastMetrics {
   void SendARCActiveTimeMetrics(base::TimeDelta multicast_enabled_duration,
                                 base::TimeDelta wifi_enabled_duration);
 
+  // Send UMA metrics about the packets forwarded by the multicast proxy
+  // subprocess and the number of packets received and sent per syscall.
+  void SendForwarderStatsMetrics(const MulticastForwarderStatsMessage& msg);
+
  private:
   // Handles polling to fetch and report UMA metrics.
   class Poller {
@@ -592,4 +592,43 @@ TEST_F(MulticastMetricsTest, ARC_RecordPacketCount) {
   task_environment.FastForwardBy(kMulticastPollDelay);
 }
 
+TEST_F(MulticastMetricsTest, SendForwarderStatsMetrics) {
+  MulticastForwarderStatsMessage msg;
+  msg.set_type(MulticastForwarderStatsMessage::MDNS);
+  msg.set_packets_received(40);
+  msg.set_packets_sent(120);
+  msg.set_receive_syscalls(10);
+  msg.set_send_syscalls(20);
+
+  EXPECT_CALL(*mock_metrics_lib_,
+              SendToUMA(kMulticastForwarderMDNSForwardedCountMetrics, 120, _,
+                        _, _))
+      .Times(1);
+  EXPECT_CALL(*mock_metrics_lib_,
+              SendLinearToUMA(kMulticastForwarderMDNSReceiveBatchSizeMetrics,
+                              4, _))
+      .Times(1);
+  EXPECT_CALL(*mock_metrics_lib_,
+              SendLinearToUMA(kMulticastForwarderMDNSSendBatchSizeMetrics, 6,
+                              _))
+      .Times(1);
+  multicast_metrics_->SendForwarderStatsMetrics(msg);
+}
+
+TEST_F(MulticastMetricsTest, SendForwarderStatsMetricsNoSyscall) {
+  MulticastForwarderStatsMessage msg;
+  msg.set_type(MulticastForwarderStatsMessage::BROADCAST);
+  msg.set_packets_received(0);
+  msg.set_packets_sent(0);
+  msg.set_receive_syscalls(0);
+  msg.set_send_syscalls(0);
+
+  EXPECT_CALL(*mock_metrics_lib_,
+              SendToUMA(kMulticastForwarderBroadcastForwardedCountMetrics, 0,
+                        _, _, _))
+      .Times(1);
+  EXPECT_CALL(*mock_metrics_lib_, SendLinearToUMA(_, _, _)).Times(0);
+  multicast_metrics_->SendForwarderStatsMetrics(msg);
+}
+
 }  // namespace patchpanel
@@ -8,10 +8,12 @@
 
 #include <utility>
 
+#include <base/functional/bind.h>
 #include <base/logging.h>
 
 #include "patchpanel/ipc.h"
 #include "patchpanel/minijailed_process_runner.h"
+#include "patchpanel/multicast_metrics.h"
 
 namespace patchpanel {
 
@@ -32,15 +34,57 @@ int MulticastProxy::OnInit() {
   }
 
   EnterChildProcessJail();
+  stats_timer_.Start(FROM_HERE, kMulticastPollDelay,
+                     base::BindRepeating(&MulticastProxy::SendForwarderStats,
+                                         weak_factory_.GetWeakPtr()));
   return Daemon::OnInit();
 }
 
 void MulticastProxy::Reset() {
+  stats_timer_.Stop();
   mdns_fwds_.clear();
   ssdp_fwds_.clear();
   bcast_fwds_.clear();
 }
 
+void MulticastProxy::SendForwarderStats() {
+  ForwarderStats mdns_stats, ssdp_stats, bcast_stats;
+  for (const auto& [_, fwd] : mdns_fwds_) {
+    mdns_stats += fwd->TakeStats();
+  }
+  for (const auto& [_, fwd] : ssdp_fwds_) {
+    ssdp_stats += fwd->TakeStats();
+  }
+  for (const auto& [_, fwd] : bcast_fwds_) {
+    bcast_stats += fwd->TakeStats();
+  }
+  SendForwarderStats(MulticastForwarderStatsMessage::MDNS, mdns_stats);
+  SendForwarderStats(MulticastForwarderStatsMessage::SSDP, ssdp_stats);
+  SendForwarderStats(MulticastForwarderStatsMessage::BROADCAST, bcast_stats);
+}
+
+void MulticastProxy::SendForwarderStats(
+    MulticastForwarderStatsMessage::ForwarderType type,
+    const ForwarderStats& stats) {
+  // Nothing was received during the period, there is no forwarder of the type
+  // or they are idle.
+  if (stats.receive_syscalls == 0) {
+    return;
+  }
+
+  MulticastForwarderStatsMessage msg;
+  msg.set_type(type);
+  msg.set_packets_received(stats.packets_received);
+  msg.set_packets_sent(stats.packets_sent);
+  msg.set_receive_syscalls(stats.receive_syscalls);
+  msg.set_send_syscalls(stats.send_syscalls);
+  FeedbackMessage fm;
+  *fm.mutable_multicast_forwarder_stats() = msg;
+  SubprocessMessage root_msg;
+  *root_msg.mutable_feedback_message() = fm;
+  msg_dispatcher_.SendMessage(root_msg);
+}
+
 void MulticastProxy::OnParentProcessExit() {
   LOG(ERROR) << "Quitting because the parent process died";
   Reset();
@@ -9,9 +9,11 @@
 #include <memory>
 #include <string>
 
+#include <base/timer/timer.h>
 #include <brillo/daemons/daemon.h>
 
 #include "patchpanel/broadcast_forwarder.h"
+#include "patchpanel/forwarder_stats.h"
 #include "patchpanel/ipc.h"
 #include "patchpanel/message_dispatcher.h"
 #include "patchpanel/multicast_forwarder.h"
@@ -37,11 +39,20 @@ class MulticastProxy : public brillo::Daemon {
  private:
   void Reset();
 
+  // Sends the packet and syscall counters of the forwarders of each type to
+  // the parent process, which reports them to UMA.
+  void SendForwarderStats();
+  void SendForwarderStats(MulticastForwarderStatsMessage::ForwarderType type,
+                          const ForwarderStats& stats);
+
   MessageDispatcher<SubprocessMessage> msg_dispatcher_;
   std::map<std::string, std::unique_ptr<MulticastForwarder>> mdns_fwds_;
   std::map<std::string, std::unique_ptr<MulticastForwarder>> ssdp_fwds_;
   std::map<std::string, std::unique_ptr<BroadcastForwarder>> bcast_fwds_;
 
+  // Timer to periodically send the counters of the forwarders.
+  base::RepeatingTimer stats_timer_;
+
   base::WeakPtrFactory<MulticastProxy> weak_factory_{this};
 };
 
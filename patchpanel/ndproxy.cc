@@ -64,8 +64,14 @@ const net_base::IPv6CIDR kSolicitedNodeMulticastCIDR =
 // These filter instructions assume that the input is an IPv6 packet and check
 // that the packet is an ICMPv6 packet of whose ICMPv6 type is one of: neighbor
 // solicitation, neighbor advertisement, router solicitation, or router
-// advertisement.
+// advertisement. Packets sent by the host itself are dropped in the kernel:
+// they are seen by the socket as outgoing on every interface but never need to
+// be proxied, and the socket does not see its own proxied packets anyway.
 sock_filter kNDPacketBpfInstructions[] = {
+    // Load the packet type.
+    BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_PKTTYPE),
+    // Check if the packet is outgoing, if yes, then goto return 0.
+    BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, PACKET_OUTGOING, 8, 0),
     // Load IPv6 next header.
     BPF_STMT(BPF_LD | BPF_B | BPF_IND, offsetof(ip6_hdr, ip6_nxt)),
     // Check if equals ICMPv6, if not, then goto return 0.
@@ -221,14 +221,32 @@ uint16_t FoldChecksum(uint32_t sum) {
 }
 
 uint32_t NetChecksum(const void* data, size_t len) {
-  uint32_t sum = 0;
-  const uint16_t* word = reinterpret_cast<const uint16_t*>(data);
-  for (; len > 1; len -= 2)
-    sum += *word++;
+  // Sum 32-bit words into a 64-bit accumulator, which halves the number of
+  // additions and cannot overflow for any packet size, then fold the result
+  // back to 16 bits (RFC 1071 Section 2 (B) and (C)). memcpy() keeps the loads
+  // valid for buffers that are not aligned.
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+  uint64_t sum = 0;
+  for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+    uint32_t word;
+    memcpy(&word, ptr, sizeof(word));
+    sum += word;
+    ptr += sizeof(word);
+  }
+  if (len >= sizeof(uint16_t)) {
+    uint16_t word;
+    memcpy(&word, ptr, sizeof(word));
+    sum += word;
+    ptr += sizeof(word);
+    len -= sizeof(word);
+  }
   if (len)
     // Cast it as a uint8_t since there's only one byte left.
-    sum += *(reinterpret_cast<const uint8_t*>(word));
-  return sum;
+    sum += *ptr;
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return static_cast<uint32_t>(sum);
 }
 
 uint16_t Ipv4Checksum(const iphdr* ip) {
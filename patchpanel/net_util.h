@@ -75,6 +75,8 @@ BRILLO_EXPORT uint16_t FoldChecksum(uint32_t sum);
 
 // RFC 1071: We are doing calculation directly in network order.
 // Note this algorithm works regardless of the endianness of the host.
+// The returned partial sum is folded to 16 bits, so that callers can add
+// other 16-bit words to it before calling FoldChecksum().
 BRILLO_EXPORT uint32_t NetChecksum(const void* data, size_t len);
 
 BRILLO_EXPORT uint16_t Ipv4Checksum(const iphdr* ip);
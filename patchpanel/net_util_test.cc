@@ -92,6 +92,40 @@ TEST(Ipv6, IcmpChecksum) {
                                       ip6_packet_len));
 }
 
+TEST(NetChecksum, MatchesWordByWordSum) {
+  // Reference implementation adding one 16-bit word at a time.
+  auto reference_checksum = [](const uint8_t* data, size_t len) {
+    uint32_t sum = 0;
+    for (; len > 1; len -= 2, data += 2) {
+      uint16_t word;
+      memcpy(&word, data, sizeof(word));
+      sum += word;
+    }
+    if (len)
+      sum += *data;
+    return FoldChecksum(sum);
+  };
+
+  uint8_t buffer[IP_MAXPACKET + 3];
+  for (size_t i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  // Cover all the tail lengths and alignments, and the largest packet.
+  for (size_t offset = 0; offset < 4; offset++) {
+    for (size_t len = 0; len < 64; len++) {
+      EXPECT_EQ(reference_checksum(buffer + offset, len),
+                FoldChecksum(NetChecksum(buffer + offset, len)));
+    }
+  }
+  EXPECT_EQ(reference_checksum(buffer + 1, IP_MAXPACKET),
+            FoldChecksum(NetChecksum(buffer + 1, IP_MAXPACKET)));
+
+  // All bits set, where the sum must not wrap around to zero.
+  memset(buffer, 0xff, sizeof(buffer));
+  EXPECT_EQ(reference_checksum(buffer, IP_MAXPACKET),
+            FoldChecksum(NetChecksum(buffer, IP_MAXPACKET)));
+}
+
 TEST(Ipv6, EUI64Addr) {
   struct {
     std::string prefix;
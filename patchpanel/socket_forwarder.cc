@@ -7,16 +7,20 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <netinet/ip.h>
+#include <pthread.h>
+#include <signal.h>
 #include <string.h>
 #include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <utility>
 
 #include <base/check.h>
 #include <base/functional/bind.h>
 #include <base/logging.h>
+#include <base/posix/eintr_wrapper.h>
 #include <base/task/bind_post_task.h>
 #include <base/time/time.h>
 
@@ -52,8 +56,6 @@ SocketForwarder::SocketForwarder(const std::string& name,
     : base::SimpleThread(name),
       sock0_(std::move(sock0)),
       sock1_(std::move(sock1)),
-      len0_(0),
-      len1_(0),
       eof_(-1),
       poll_(false),
       done_(false) {
@@ -71,6 +73,11 @@ bool SocketForwarder::IsRunning() const {
   return !done_;
 }
 
+void SocketForwarder::SetZeroCopy(bool enabled) {
+  DCHECK(!HasBeenStarted());
+  zero_copy_ = enabled;
+}
+
 void SocketForwarder::SetStopQuitClosureForTesting(base::OnceClosure closure) {
   stop_quit_closure_for_testing_ =
       BindPostTaskToCurrentDefault(std::move(closure));
@@ -90,9 +97,33 @@ void SocketForwarder::Run() {
     return;
   }
 
+  if (zero_copy_) {
+    // splice() raises SIGPIPE when writing to a socket closed by its peer,
+    // unlike Socket::SendTo() which uses MSG_NOSIGNAL. Block it on this
+    // thread so that the write fails with EPIPE instead.
+    sigset_t sigpipe;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, nullptr);
+
+    for (Buffer* buf : {&buf0_, &buf1_}) {
+      int fds[2];
+      if (pipe2(fds, O_CLOEXEC | O_NONBLOCK) < 0) {
+        PLOG(WARNING) << "pipe2 failed, forwarding by copy";
+        continue;
+      }
+      buf->pipe_r.reset(fds[0]);
+      buf->pipe_w.reset(fds[1]);
+    }
+  }
+
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   Poll();
 
-  LOG(INFO) << "Forwarder stopped: " << *sock0_ << " <-> " << *sock1_;
+  const base::TimeDelta duration = base::TimeTicks::Now() - start_time;
+  LOG(INFO) << "Forwarder stopped: " << *sock0_ << " <-> " << *sock1_
+            << ", forwarded " << buf0_.bytes_forwarded.load() << " and "
+            << buf1_.bytes_forwarded.load() << " bytes in " << duration;
   done_ = true;
   sock1_.reset();
   sock0_.reset();
@@ -151,86 +182,64 @@ bool SocketForwarder::ProcessEvents(uint32_t events, int efd, int cfd) {
 
   if (events & EPOLLOUT) {
     Socket* dst;
-    char* buf;
-    size_t* len;
+    Buffer* buf;
     if (sock0_->fd() == efd) {
       dst = sock0_.get();
-      buf = buf1_;
-      len = &len1_;
+      buf = &buf1_;
     } else {
       dst = sock1_.get();
-      buf = buf0_;
-      len = &len0_;
+      buf = &buf0_;
     }
 
-    ssize_t r = dst->SendTo(buf, *len);
+    ssize_t r = Send(buf, dst);
     if (r < 0) {
       PLOG(ERROR) << "Failed to send data to " << dst;
       return false;
     }
-    size_t bytes = static_cast<size_t>(r);
 
     // Still unavailable.
-    if (bytes == 0)
+    if (r == 0)
       return true;
 
-    // Partial write.
-    if (bytes < *len)
-      memmove(&buf[0], &buf[bytes], *len - bytes);
-    *len -= bytes;
-
     // If all the buffered data was written to the socket and the peer socket is
     // still open for writing, listen for read events on the socket.
-    if (*len == 0 && eof_ != dst->fd() && !SetPollEvents(dst, cfd, EPOLLIN))
+    if (buf->len == 0 && eof_ != dst->fd() && !SetPollEvents(dst, cfd, EPOLLIN))
       return false;
   }
 
   Socket *src, *dst;
-  char* buf;
-  size_t* len;
+  Buffer* buf;
   if (sock0_->fd() == efd) {
     src = sock0_.get();
     dst = sock1_.get();
-    buf = buf0_;
-    len = &len0_;
+    buf = &buf0_;
   } else {
     src = sock1_.get();
     dst = sock0_.get();
-    buf = buf1_;
-    len = &len1_;
+    buf = &buf1_;
   }
 
   // Skip the read if this buffer is still pending write: requires that
   // epoll_wait is in level-triggered mode.
-  if (*len > 0)
+  if (buf->len > 0)
     return true;
 
   if (events & EPOLLIN) {
-    ssize_t r = src->RecvFrom(buf, kBufSize);
+    ssize_t r = Receive(src, buf);
     if (r < 0) {
       PLOG(ERROR) << "Failed to receive data from " << src;
       return false;
     }
-    *len = static_cast<size_t>(r);
 
-    if (*len == 0)
+    if (buf->len == 0)
       return HandleConnectionClosed(src, dst, cfd);
 
-    r = dst->SendTo(buf, *len);
-    if (r < 0) {
+    if (Send(buf, dst) < 0) {
       PLOG(ERROR) << "Failed to send data to " << dst;
       return false;
     }
-    size_t bytes = static_cast<size_t>(r);
 
-    if (bytes > 0) {
-      // Partial write.
-      if (bytes < *len)
-        memmove(&buf[0], &buf[bytes], *len - bytes);
-      *len -= bytes;
-    }
-
-    if (*len > 0 && !SetPollEvents(dst, cfd, EPOLLOUT))
+    if (buf->len > 0 && !SetPollEvents(dst, cfd, EPOLLOUT))
       return false;
   }
 
@@ -241,6 +250,92 @@ bool SocketForwarder::ProcessEvents(uint32_t events, int efd, int cfd) {
   return true;
 }
 
+ssize_t SocketForwarder::Receive(Socket* src, Buffer* buf) {
+  DCHECK_EQ(buf->len, 0u);
+  if (buf->pipe_w.is_valid()) {
+    ssize_t r = splice(src->fd(), nullptr, buf->pipe_w.get(), nullptr,
+                       kSpliceSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (r >= 0) {
+      buf->len = static_cast<size_t>(r);
+      return r;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return 0;
+    }
+    if (errno != EINVAL) {
+      return r;
+    }
+    // |src| does not support splice(). Nothing was read from it.
+    LOG(INFO) << "splice() is not supported by " << *src
+              << ", forwarding by copy";
+    if (!FallBackToCopy(buf)) {
+      return -1;
+    }
+  }
+
+  ssize_t r = src->RecvFrom(buf->data.data(), kBufSize);
+  if (r > 0) {
+    buf->len = static_cast<size_t>(r);
+  }
+  return r;
+}
+
+ssize_t SocketForwarder::Send(Buffer* buf, Socket* dst) {
+  if (buf->pipe_r.is_valid()) {
+    ssize_t r = splice(buf->pipe_r.get(), nullptr, dst->fd(), nullptr,
+                       buf->len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (r >= 0) {
+      buf->len -= static_cast<size_t>(r);
+      buf->bytes_forwarded += static_cast<uint64_t>(r);
+      return r;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return 0;
+    }
+    if (errno != EINVAL) {
+      return r;
+    }
+    // |dst| does not support splice(). The pending data is still in the pipe.
+    LOG(INFO) << "splice() is not supported by " << *dst
+              << ", forwarding by copy";
+    if (!FallBackToCopy(buf)) {
+      return -1;
+    }
+  }
+
+  ssize_t r = dst->SendTo(buf->data.data(), buf->len);
+  if (r <= 0) {
+    return r;
+  }
+  size_t bytes = static_cast<size_t>(r);
+  // Partial write.
+  if (bytes < buf->len)
+    memmove(&buf->data[0], &buf->data[bytes], buf->len - bytes);
+  buf->len -= bytes;
+  buf->bytes_forwarded += bytes;
+  return r;
+}
+
+bool SocketForwarder::FallBackToCopy(Buffer* buf) {
+  // The pipe can hold more data than the copy buffer.
+  if (buf->data.size() < buf->len) {
+    buf->data.resize(buf->len);
+  }
+  size_t read_len = 0;
+  while (read_len < buf->len) {
+    ssize_t r = HANDLE_EINTR(read(buf->pipe_r.get(), &buf->data[read_len],
+                                  buf->len - read_len));
+    if (r <= 0) {
+      PLOG(ERROR) << "Failed to read pending data from pipe";
+      return false;
+    }
+    read_len += static_cast<size_t>(r);
+  }
+  buf->pipe_r.reset();
+  buf->pipe_w.reset();
+  return true;
+}
+
 bool SocketForwarder::HandleConnectionClosed(Socket* src,
                                              Socket* dst,
                                              int cfd) {
@@ -11,7 +11,9 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include <base/files/scoped_file.h>
 #include <base/functional/callback.h>
 #include <base/memory/weak_ptr.h>
 // Ignore Wconversion warnings in libbase headers.
@@ -41,22 +43,60 @@ class BRILLO_EXPORT SocketForwarder : public base::SimpleThread {
   void Run() override;
   bool IsRunning() const;
 
+  // Enables or disables the zero-copy mode, which moves the data between the
+  // sockets with splice() through a pipe instead of copying it in and out of
+  // a userspace buffer. Each direction falls back to copying if one of its
+  // sockets does not support splice(). Must be called before Start().
+  void SetZeroCopy(bool enabled);
+
+  // Returns the number of bytes forwarded so far from the first socket to the
+  // second one, and from the second socket to the first one. Can be called
+  // from any thread.
+  uint64_t bytes_forwarded0() const { return buf0_.bytes_forwarded.load(); }
+  uint64_t bytes_forwarded1() const { return buf1_.bytes_forwarded.load(); }
+
   // Sets a closure for testing, which will be called when the forwarder is
   // stopped.
   void SetStopQuitClosureForTesting(base::OnceClosure closure);
 
  private:
-  static constexpr int kBufSize = 4096;
+  static constexpr size_t kBufSize = 4096;
+  // Maximum number of bytes moved with a single splice() call. This is the
+  // default capacity of a pipe.
+  static constexpr size_t kSpliceSize = 65536;
+
+  // Data received on one socket and not yet written to the other one.
+  struct Buffer {
+    // Holds the pending data in copy mode.
+    std::vector<char> data = std::vector<char>(kBufSize);
+    // Holds the pending data in zero-copy mode. Invalid in copy mode.
+    base::ScopedFD pipe_r;
+    base::ScopedFD pipe_w;
+    // Number of pending bytes.
+    size_t len = 0;
+    // Total number of bytes written to the destination socket.
+    std::atomic<uint64_t> bytes_forwarded{0};
+  };
 
   void Poll();
   bool ProcessEvents(uint32_t events, int efd, int cfd);
 
+  // Receives data from |src| into the empty |buf|. Returns the number of bytes
+  // received, 0 if no data is available or on EOF, or -1 on error.
+  ssize_t Receive(Socket* src, Buffer* buf);
+  // Sends the pending data of |buf| to |dst|. Returns the number of bytes sent,
+  // 0 if |dst| is unavailable, or -1 on error.
+  ssize_t Send(Buffer* buf, Socket* dst);
+  // Switches |buf| from zero-copy mode to copy mode, moving the pending data
+  // from its pipe. Returns false on failure.
+  bool FallBackToCopy(Buffer* buf);
+
   std::unique_ptr<Socket> sock0_;
   std::unique_ptr<Socket> sock1_;
-  char buf0_[kBufSize] = {0};
-  char buf1_[kBufSize] = {0};
-  size_t len0_;
-  size_t len1_;
+  // Data received on |sock0_| and |sock1_|, respectively.
+  Buffer buf0_;
+  Buffer buf1_;
+  bool zero_copy_ = false;
   // Indicates if an EOF has been sent (if it is greater than -1) and which
   // socket fd it was received on. This means that the socket file descriptor
   // indicated here should not be read from, only written to.
@@ -80,6 +80,8 @@ TEST_F(SocketForwarderTest, ForwardDataAndClose) {
   EXPECT_TRUE(signal.Wait());
 
   EXPECT_FALSE(forwarder_->IsRunning());
+  EXPECT_EQ(forwarder_->bytes_forwarded0(), kDataSize);
+  EXPECT_EQ(forwarder_->bytes_forwarded1(), kDataSize);
 
   // Verify that all the data has been forwarded to the peers.
   std::vector<char> expected_data_peer0(kDataSize);
@@ -91,6 +93,50 @@ TEST_F(SocketForwarderTest, ForwardDataAndClose) {
   EXPECT_THAT(expected_data_peer1, Each(1));
 }
 
+TEST_F(SocketForwarderTest, ForwardDataAndCloseZeroCopy) {
+  base::test::TestFuture<void> signal;
+  forwarder_->SetStopQuitClosureForTesting(signal.GetCallback());
+  forwarder_->SetZeroCopy(true);
+  forwarder_->Start();
+
+  std::vector<char> msg(kDataSize, 1);
+
+  EXPECT_EQ(peer0_->SendTo(msg.data(), msg.size()), kDataSize);
+  EXPECT_EQ(peer1_->SendTo(msg.data(), msg.size()), kDataSize);
+  // Close both sockets for writing.
+  EXPECT_NE(shutdown(peer0_->fd(), SHUT_WR), -1);
+  EXPECT_NE(shutdown(peer1_->fd(), SHUT_WR), -1);
+
+  EXPECT_TRUE(signal.Wait());
+
+  EXPECT_FALSE(forwarder_->IsRunning());
+  EXPECT_EQ(forwarder_->bytes_forwarded0(), kDataSize);
+  EXPECT_EQ(forwarder_->bytes_forwarded1(), kDataSize);
+
+  // Verify that all the data has been forwarded to the peers.
+  std::vector<char> expected_data_peer0(kDataSize);
+  std::vector<char> expected_data_peer1(kDataSize);
+  EXPECT_TRUE(Read(peer1_.get(), expected_data_peer1.data(), kDataSize));
+  EXPECT_TRUE(Read(peer0_.get(), expected_data_peer0.data(), kDataSize));
+
+  EXPECT_THAT(expected_data_peer0, Each(1));
+  EXPECT_THAT(expected_data_peer1, Each(1));
+}
+
+TEST_F(SocketForwarderTest, PeerSignalEPOLLHUPZeroCopy) {
+  base::test::TestFuture<void> signal;
+  forwarder_->SetStopQuitClosureForTesting(signal.GetCallback());
+  forwarder_->SetZeroCopy(true);
+  forwarder_->Start();
+
+  // Close the destination peer.
+  peer1_.reset();
+
+  EXPECT_TRUE(signal.Wait());
+
+  EXPECT_FALSE(forwarder_->IsRunning());
+}
+
 TEST_F(SocketForwarderTest, PeerSignalEPOLLHUP) {
   base::test::TestFuture<void> signal;
   forwarder_->SetStopQuitClosureForTesting(signal.GetCallback());
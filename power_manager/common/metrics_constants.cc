@@ -35,6 +35,9 @@ const char kSuspendDelayName[] = "Power.SuspendDelay";
 const int kSuspendDelayMin = 0;
 const int kSuspendDelayMax = 60;
 
+const char kSuspendDelayTimeoutsName[] = "Power.SuspendDelayTimeouts";
+const int kSuspendDelayTimeoutsMax = 10;
+
 const char kShutdownReasonName[] = "Power.ShutdownReason";
 const int kShutdownReasonMax = 10;
 
@@ -40,6 +40,9 @@ extern const char kSuspendDelayName[];
 extern const int kSuspendDelayMin;
 extern const int kSuspendDelayMax;
 
+extern const char kSuspendDelayTimeoutsName[];
+extern const int kSuspendDelayTimeoutsMax;
+
 extern const char kShutdownReasonName[];
 extern const int kShutdownReasonMax;
 
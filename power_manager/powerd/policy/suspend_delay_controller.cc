@@ -21,6 +21,18 @@
 
 namespace power_manager::policy {
 
+namespace {
+
+// Returns the trace track showing when |delay_id| of |controller| holds up
+// suspend attempts.
+perfetto::Track GetDelayTrack(const SuspendDelayController* controller,
+                              int delay_id) {
+  return perfetto::Track(static_cast<uint64_t>(delay_id),
+                         perfetto::Track::FromPointer(controller));
+}
+
+}  // namespace
+
 // static.
 constexpr base::TimeDelta
     SuspendDelayController::kDefaultMaxSuspendDelayTimeout;
@@ -75,6 +87,12 @@ void SuspendDelayController::RegisterSuspendDelay(
             << dbus_client;
   registered_delays_.insert(std::make_pair(delay_id, info));
 
+  perfetto::Track track = GetDelayTrack(this, delay_id);
+  auto track_descriptor = track.Serialize();
+  track_descriptor.set_name(GetLogDescription() + " delay: " + dbus_client +
+                            ": " + info.description);
+  TrackEvent::SetTrackDescriptor(track, track_descriptor);
+
   reply->Clear();
   reply->set_min_delay_timeout_ms(std::min(
       info.timeout.InMilliseconds(), max_delay_timeout_.InMilliseconds()));
@@ -142,10 +160,18 @@ void SuspendDelayController::PrepareForSuspend(int suspend_id,
   current_suspend_id_ = suspend_id;
 
   size_t old_count = delay_ids_being_waited_on_.size();
+  for (int delay_id : delay_ids_being_waited_on_)
+    TRACE_EVENT_END("power", GetDelayTrack(this, delay_id));
   delay_ids_being_waited_on_.clear();
+  prepare_time_ = clock_->GetCurrentBootTime();
+  delay_waits_.clear();
   for (DelayInfoMap::const_iterator it = registered_delays_.begin();
-       it != registered_delays_.end(); ++it)
+       it != registered_delays_.end(); ++it) {
     delay_ids_being_waited_on_.insert(it->first);
+    TRACE_EVENT_BEGIN("power", "SuspendDelay", GetDelayTrack(this, it->first),
+                      "suspend_id", suspend_id, "client",
+                      it->second.dbus_client);
+  }
 
   LOG(INFO) << "Announcing " << GetLogDescription() << " request "
             << current_suspend_id_ << " with "
@@ -181,6 +207,8 @@ void SuspendDelayController::FinishSuspend(int suspend_id) {
 
   max_delay_expiration_timer_.Stop();
   min_delay_expiration_timer_.Stop();
+  for (int delay_id : delay_ids_being_waited_on_)
+    TRACE_EVENT_END("power", GetDelayTrack(this, delay_id));
   delay_ids_being_waited_on_.clear();
 }
 
@@ -194,6 +222,17 @@ std::string SuspendDelayController::GetDelayDescription(int delay_id) const {
   return it != registered_delays_.end() ? it->second.description : "unknown";
 }
 
+void SuspendDelayController::RecordDelayWait(int delay_id, bool timed_out) {
+  TRACE_EVENT_END("power", GetDelayTrack(this, delay_id));
+
+  const DelayInfo& delay = registered_delays_[delay_id];
+  delay_waits_.push_back(DelayWait{
+      .description = delay.dbus_client + ": " + delay.description,
+      .duration = clock_->GetCurrentBootTime() - prepare_time_,
+      .timed_out = timed_out,
+  });
+}
+
 void SuspendDelayController::UnregisterDelayInternal(int delay_id) {
   if (!registered_delays_.count(delay_id)) {
     LOG(WARNING) << "Ignoring request to remove unknown " << GetLogDescription()
@@ -208,6 +247,7 @@ void SuspendDelayController::RemoveDelayFromWaitList(int delay_id) {
   if (!delay_ids_being_waited_on_.count(delay_id))
     return;
 
+  RecordDelayWait(delay_id, false /* timed_out */);
   delay_ids_being_waited_on_.erase(delay_id);
   if (delay_ids_being_waited_on_.empty() &&
       !min_delay_expiration_timer_.IsRunning()) {
@@ -225,6 +265,7 @@ void SuspendDelayController::OnMaxDelayExpiration() {
       tardy_delays += ", ";
     tardy_delays += base::NumberToString(delay_id) + " (" + delay.dbus_client +
                     ": " + delay.description + ")";
+    RecordDelayWait(delay_id, true /* timed_out */);
   }
   LOG(WARNING) << "Timed out while waiting for " << GetLogDescription()
                << " request " << current_suspend_id_
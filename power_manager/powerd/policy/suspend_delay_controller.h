@@ -8,11 +8,14 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <base/observer_list.h>
 #include <base/time/time.h>
 #include <base/timer/timer.h>
 
+#include "power_manager/common/clock.h"
+
 namespace power_manager {
 
 class RegisterSuspendDelayReply;
@@ -41,8 +44,26 @@ class SuspendDelayController {
   static constexpr base::TimeDelta kDefaultMaxSuspendDelayTimeout =
       base::Seconds(20);
 
+  // Time that a delay held up the current (or most-recent) suspend attempt.
+  struct DelayWait {
+    // "<D-Bus client>: <description>" of the delay.
+    std::string description;
+    // Time between PrepareForSuspend() and the delay becoming ready (or being
+    // unregistered) or timing out.
+    base::TimeDelta duration;
+    // True if the delay didn't report readiness within the maximum timeout.
+    bool timed_out = false;
+  };
+
   bool ReadyForSuspend() const;
 
+  // Returns the delays waited on by the current (or most-recent) suspend
+  // attempt, in the order in which they stopped holding it up.
+  const std::vector<DelayWait>& delay_waits() const { return delay_waits_; }
+
+  // Sets the clock used to time the delays. |clock| must outlive this object.
+  void set_clock(Clock* clock) { clock_ = clock; }
+
   void set_dark_resume_min_delay_for_testing(const base::TimeDelta& min_delay) {
     dark_resume_min_delay_ = min_delay;
   }
@@ -110,6 +131,10 @@ class SuspendDelayController {
   // Returns the human-readable description of |delay_id|.
   std::string GetDelayDescription(int delay_id) const;
 
+  // Records in |delay_waits_| that |delay_id| stopped holding up the current
+  // suspend attempt, and ends its trace slice.
+  void RecordDelayWait(int delay_id, bool timed_out);
+
   // Removes |delay_id| from |registered_delays_| and calls
   // RemoveDelayFromWaitList().
   void UnregisterDelayInternal(int delay_id);
@@ -158,6 +183,14 @@ class SuspendDelayController {
   // suspend.
   std::set<int> delay_ids_being_waited_on_;
 
+  // Time at which the current (or most-recent) suspend attempt started waiting
+  // for the delays, and how long each of them held it up.
+  base::TimeTicks prepare_time_;
+  std::vector<DelayWait> delay_waits_;
+
+  Clock default_clock_;
+  Clock* clock_ = &default_clock_;
+
   // Maximum time that the controller will wait for a suspend delay to become
   // ready.
   const base::TimeDelta max_delay_timeout_;
@@ -9,6 +9,7 @@
 #include <chromeos/dbus/service_constants.h>
 #include <gtest/gtest.h>
 
+#include "power_manager/common/clock.h"
 #include "power_manager/common/test_main_loop_runner.h"
 #include "power_manager/powerd/policy/suspend_delay_observer.h"
 #include "power_manager/powerd/testing/test_environment.h"
@@ -333,6 +334,49 @@ TEST_F(SuspendDelayControllerTest, MultipleDelays) {
   EXPECT_TRUE(controller_.ReadyForSuspend());
 }
 
+TEST_F(SuspendDelayControllerTest, DelayWaits) {
+  Clock clock;
+  clock.set_current_boot_time_for_testing(base::TimeTicks() + base::Hours(1));
+  controller_.set_clock(&clock);
+
+  // Readiness is reported synchronously below, so the delays can time out
+  // quickly.
+  const std::string kClient1 = "client1";
+  int delay_id1 = RegisterSuspendDelay(base::Milliseconds(10), kClient1);
+  const std::string kClient2 = "client2";
+  int delay_id2 = RegisterSuspendDelay(base::Milliseconds(10), kClient2);
+  const std::string kClient3 = "client3";
+  RegisterSuspendDelay(base::Milliseconds(10), kClient3);
+
+  const int kSuspendId = 5;
+  controller_.PrepareForSuspend(kSuspendId, false);
+  EXPECT_TRUE(controller_.delay_waits().empty());
+
+  // The delays are recorded in the order in which they stop holding up the
+  // suspend attempt.
+  clock.advance_current_boot_time_for_testing(base::Milliseconds(100));
+  HandleSuspendReadiness(delay_id2, kSuspendId, kClient2);
+  clock.advance_current_boot_time_for_testing(base::Milliseconds(200));
+  UnregisterSuspendDelay(delay_id1, kClient1);
+  ASSERT_EQ(2u, controller_.delay_waits().size());
+  EXPECT_EQ("client2: client2-desc", controller_.delay_waits()[0].description);
+  EXPECT_EQ(base::Milliseconds(100), controller_.delay_waits()[0].duration);
+  EXPECT_FALSE(controller_.delay_waits()[0].timed_out);
+  EXPECT_EQ("client1: client1-desc", controller_.delay_waits()[1].description);
+  EXPECT_EQ(base::Milliseconds(300), controller_.delay_waits()[1].duration);
+  EXPECT_FALSE(controller_.delay_waits()[1].timed_out);
+
+  // The last delay times out.
+  EXPECT_TRUE(observer_.RunUntilReadyForSuspend());
+  ASSERT_EQ(3u, controller_.delay_waits().size());
+  EXPECT_EQ("client3: client3-desc", controller_.delay_waits()[2].description);
+  EXPECT_TRUE(controller_.delay_waits()[2].timed_out);
+
+  // The next suspend attempt starts afresh.
+  controller_.PrepareForSuspend(kSuspendId + 1, false);
+  EXPECT_TRUE(controller_.delay_waits().empty());
+}
+
 // Controller should wait for |kDarkResumeMinDelay| on dark resume when no
 // additional delays are registered.
 TEST_F(SuspendDelayControllerTest, DarkResumeNoExternalDelays) {
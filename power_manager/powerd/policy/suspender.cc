@@ -85,6 +85,7 @@ void Suspender::Init(
   suspend_request_id_ = initial_id - 1;
   suspend_delay_controller_ = std::make_unique<SuspendDelayController>(
       initial_id, "", SuspendDelayController::kDefaultMaxSuspendDelayTimeout);
+  suspend_delay_controller_->set_clock(clock_.get());
   suspend_delay_controller_->AddObserver(this);
 
   // Default dark suspend delay same as regular suspend timeout if the pref
@@ -103,6 +104,7 @@ void Suspender::Init(
   dark_suspend_id_ = initial_dark_id - 1;
   dark_suspend_delay_controller_ = std::make_unique<SuspendDelayController>(
       initial_dark_id, "dark", max_dark_suspend_delay_timeout);
+  dark_suspend_delay_controller_->set_clock(clock_.get());
   dark_suspend_delay_controller_->AddObserver(this);
 
   display_watcher->AddObserver(this);
@@ -198,6 +200,7 @@ void Suspender::OnReadyForSuspend(SuspendDelayController* controller,
                metrics::kDefaultBuckets);
     LOG(INFO) << "Ready for suspend (" << suspend_request_id_ << ") after "
               << util::TimeDeltaToString(suspend_delay);
+    LogDelayWaits(*controller);
 
     HandleEvent(Event::SUSPEND_DELAYS_READY);
   } else if (controller == dark_suspend_delay_controller_.get() &&
@@ -219,6 +222,24 @@ void Suspender::OnReadyForSuspend(SuspendDelayController* controller,
   }
 }
 
+void Suspender::LogDelayWaits(const SuspendDelayController& controller) {
+  // The delays are recorded in the order in which they became ready, so the
+  // last one held up the suspend attempt the longest.
+  const auto& waits = controller.delay_waits();
+  const int num_timeouts =
+      std::count_if(waits.begin(), waits.end(),
+                    [](const auto& wait) { return wait.timed_out; });
+  SendEnumMetric(metrics::kSuspendDelayTimeoutsName, num_timeouts,
+                 metrics::kSuspendDelayTimeoutsMax);
+  if (waits.empty())
+    return;
+
+  LOG(INFO) << "Slowest suspend delay was " << waits.back().description
+            << " after " << util::TimeDeltaToString(waits.back().duration)
+            << (waits.back().timed_out ? " (timed out)" : "") << " with "
+            << num_timeouts << " timeout(s)";
+}
+
 void Suspender::OnDisplaysChanged(
     const std::vector<system::DisplayInfo>& new_displays) {
   std::vector<system::DisplayInfo> sorted_new_displays = new_displays;
@@ -763,8 +784,15 @@ Suspender::State Suspender::Suspend() {
   }
 
   current_num_attempts_++;
-  Delegate::SuspendResult result = delegate_->DoSuspend(
-      wakeup_count_, wakeup_count_valid_, suspend_duration_, hibernate);
+  Delegate::SuspendResult result;
+  {
+    // Spans the kernel's suspend and resume, whose phases are traced by the
+    // power:suspend_resume ftrace event.
+    TRACE_EVENT("power", "Suspender::DoSuspend", "suspend_id",
+                suspend_request_id_, "hibernate", hibernate);
+    result = delegate_->DoSuspend(wakeup_count_, wakeup_count_valid_,
+                                  suspend_duration_, hibernate);
+  }
 
   wakeup_source_identifier_->HandleResume();
 
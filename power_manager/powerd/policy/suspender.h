@@ -349,6 +349,10 @@ class Suspender : public SuspendDelayObserver,
       dbus::MethodCall* method_call,
       dbus::ExportedObject::ResponseSender response_sender);
 
+  // Logs the slowest delay of |controller|'s latest suspend attempt and reports
+  // how many of them timed out.
+  void LogDelayWaits(const SuspendDelayController& controller);
+
   // Performs actions and updates |state_| in response to |event|.
   void HandleEvent(Event event);
 
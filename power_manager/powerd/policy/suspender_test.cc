@@ -1680,13 +1680,18 @@ TEST_F(SuspenderTest, SuspendDelayMetrics) {
 
   AnnounceReadyForSuspend(test_api_.suspend_id());
 
-  ASSERT_EQ(metrics_sender_.num_metrics(), 1);
+  ASSERT_EQ(metrics_sender_.num_metrics(), 2);
   EXPECT_EQ(MetricsSenderStub::Metric::CreateExp(
                 metrics::kSuspendDelayName, kSuspendDelaySecond,
                 metrics::kSuspendDelayMin, metrics::kSuspendDelayMax,
                 metrics::kDefaultBuckets)
                 .ToString(),
             metrics_sender_.GetMetric(0));
+  EXPECT_EQ(MetricsSenderStub::Metric::CreateEnum(
+                metrics::kSuspendDelayTimeoutsName, 0,
+                metrics::kSuspendDelayTimeoutsMax)
+                .ToString(),
+            metrics_sender_.GetMetric(1));
 }
 
 }  // namespace power_manager::policy
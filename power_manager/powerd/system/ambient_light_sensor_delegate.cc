@@ -4,6 +4,8 @@
 
 #include "power_manager/powerd/system/ambient_light_sensor_delegate.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <optional>
 #include <utility>
 
@@ -11,6 +13,31 @@
 
 namespace power_manager::system {
 
+bool AdaptiveSamplingRate::Update(int lux) {
+  const bool was_slowed_down = slowed_down();
+  const int max_delta =
+      std::max(kMinStableLuxDelta,
+               static_cast<int>(std::abs(reference_lux_) * kStableLuxFraction));
+  if (num_stable_readings_ == 0 || std::abs(lux - reference_lux_) > max_delta) {
+    reference_lux_ = lux;
+    num_stable_readings_ = 1;
+  } else if (!slowed_down()) {
+    ++num_stable_readings_;
+  }
+
+  if (slowed_down() != was_slowed_down) {
+    VLOG(1) << (slowed_down() ? "Slowing down" : "Speeding up")
+            << " ambient light sampling at lux " << lux;
+    return true;
+  }
+  return false;
+}
+
+void AdaptiveSamplingRate::Reset() {
+  reference_lux_ = 0;
+  num_stable_readings_ = 0;
+}
+
 // static
 std::optional<int> AmbientLightSensorDelegate::CalculateColorTemperature(
     const std::map<ChannelType, int>& readings) {
@@ -35,6 +35,44 @@ enum class SensorLocation {
   LID,
 };
 
+// Tracks the readings of an ambient light sensor to sample it less often while
+// the ambient light is stable, and as often as before from the first reading
+// which shows that it changed. A change is thus noticed up to kSlowdownFactor
+// sampling intervals late.
+class AdaptiveSamplingRate {
+ public:
+  // Number of consecutive stable readings before slowing down the sampling.
+  static constexpr int kNumStableReadingsBeforeSlowdown = 10;
+  // Factor by which the sampling interval is multiplied once slowed down.
+  static constexpr int kSlowdownFactor = 4;
+  // A reading is stable if it is within this fraction, or kMinStableLuxDelta,
+  // of the reading that started the stable period.
+  static constexpr double kStableLuxFraction = 0.1;
+  static constexpr int kMinStableLuxDelta = 5;
+
+  AdaptiveSamplingRate() = default;
+  AdaptiveSamplingRate(const AdaptiveSamplingRate&) = delete;
+  AdaptiveSamplingRate& operator=(const AdaptiveSamplingRate&) = delete;
+
+  // Accounts a new |lux| reading. Returns true if slowed_down() changed.
+  bool Update(int lux);
+
+  // Forgets the previous readings, e.g. after the sensor was reconfigured.
+  void Reset();
+
+  // Returns true if the sensor should be sampled kSlowdownFactor times less
+  // often.
+  bool slowed_down() const {
+    return num_stable_readings_ >= kNumStableReadingsBeforeSlowdown;
+  }
+
+ private:
+  // Reading which started the current stable period.
+  int reference_lux_ = 0;
+  // Number of readings in the current stable period.
+  int num_stable_readings_ = 0;
+};
+
 class AmbientLightSensorDelegate {
  public:
   // |readings[ChannelType::X]|: red color reading value.
@@ -113,8 +113,14 @@ base::FilePath AmbientLightSensorDelegateFile::GetIlluminancePath() const {
   return base::FilePath();
 }
 
+base::TimeDelta AmbientLightSensorDelegateFile::GetPollInterval() const {
+  return sampling_rate_.slowed_down()
+             ? poll_interval_ * AdaptiveSamplingRate::kSlowdownFactor
+             : poll_interval_;
+}
+
 void AmbientLightSensorDelegateFile::StartTimer() {
-  poll_timer_.Start(FROM_HERE, poll_interval_, this,
+  poll_timer_.Start(FROM_HERE, GetPollInterval(), this,
                     &AmbientLightSensorDelegateFile::ReadAls);
 }
 
@@ -167,8 +173,10 @@ void AmbientLightSensorDelegateFile::ReadCallback(const std::string& data) {
     return;
   }
 
-  if (ParseLuxData(data, &value))
+  if (ParseLuxData(data, &value)) {
+    sampling_rate_.Update(value);
     set_lux_callback_.Run(value, std::nullopt);
+  }
 
   StartTimer();
 }
@@ -208,8 +216,10 @@ void AmbientLightSensorDelegateFile::CollectChannelReadings() {
 
   std::map<ChannelType, int> readings;
   std::optional<int> lux_value = std::nullopt;
-  if (clear_reading_.value() > -1)
+  if (clear_reading_.value() > -1) {
     lux_value = clear_reading_.value();
+    sampling_rate_.Update(lux_value.value());
+  }
 
   for (const auto& reading : color_readings_) {
     // -1 marks an invalid reading.
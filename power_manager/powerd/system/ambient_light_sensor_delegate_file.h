@@ -53,11 +53,19 @@ class AmbientLightSensorDelegateFile : public AmbientLightSensorDelegate {
   // returns false.
   bool TriggerPollTimerForTesting();
 
+  // Returns the current delay between polls of the sensor file.
+  base::TimeDelta GetPollIntervalForTesting() const {
+    return GetPollInterval();
+  }
+
   // AmbientLightSensorDelegate implementation:
   bool IsColorSensor() const override;
   base::FilePath GetIlluminancePath() const override;
 
  private:
+  // Returns |poll_interval_|, slowed down while the ambient light is stable.
+  base::TimeDelta GetPollInterval() const;
+
   // Starts |poll_timer_|.
   void StartTimer();
 
@@ -95,9 +103,12 @@ class AmbientLightSensorDelegateFile : public AmbientLightSensorDelegate {
   // Runs ReadAls().
   base::RepeatingTimer poll_timer_;
 
-  // Time between polls of the sensor file.
+  // Time between polls of the sensor file while the ambient light changes.
   base::TimeDelta poll_interval_;
 
+  // Slows down the polling while the ambient light is stable.
+  AdaptiveSamplingRate sampling_rate_;
+
   // Boolean to indicate if color support should be enabled on this ambient
   // light sensor. Color support should only be enabled if sensor is properly
   // calibrated. Only search for color support if true.
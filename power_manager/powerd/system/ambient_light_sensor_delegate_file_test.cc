@@ -140,6 +140,25 @@ TEST_F(AmbientLightSensorDelegateFileTest, Basic) {
   EXPECT_EQ(200, sensor_->GetAmbientLightLux());
 }
 
+TEST_F(AmbientLightSensorDelegateFileTest, SlowDownPollingWhenStable) {
+  CreateSensorByLocation(SensorLocation::UNKNOWN, false);
+  EXPECT_EQ(kPollInterval, als_->GetPollIntervalForTesting());
+
+  WriteLux(100);
+  for (int i = 0; i < AdaptiveSamplingRate::kNumStableReadingsBeforeSlowdown;
+       ++i) {
+    ASSERT_TRUE(observer_.RunUntilAmbientLightUpdated());
+  }
+  EXPECT_EQ(kPollInterval * AdaptiveSamplingRate::kSlowdownFactor,
+            als_->GetPollIntervalForTesting());
+
+  // The polling speeds up as soon as the ambient light changes.
+  WriteLux(300);
+  ASSERT_TRUE(observer_.RunUntilAmbientLightUpdated());
+  EXPECT_EQ(300, sensor_->GetAmbientLightLux());
+  EXPECT_EQ(kPollInterval, als_->GetPollIntervalForTesting());
+}
+
 TEST_F(AmbientLightSensorDelegateFileTest, GiveUpAfterTooManyFailures) {
   CreateSensorByLocation(SensorLocation::UNKNOWN, false);
 
@@ -105,6 +105,9 @@ void AmbientLightSensorDelegateMojo::OnSampleUpdated(
       if (num_failed_reads_ > 0)
         --num_failed_reads_;
     }
+
+    if (adaptive_sampling_enabled_ && sampling_rate_.Update(lux_value.value()))
+      UpdateFrequency();
   }
 
   if (color_channels_enabled_)
@@ -128,6 +131,7 @@ void AmbientLightSensorDelegateMojo::OnErrorOccurred(
     case cros::mojom::ObserverErrorType::FREQUENCY_INVALID:
       LOG(ERROR) << "Device " << iio_device_id_
                  << ": Observer started with an invalid frequency";
+      sampling_rate_.Reset();
       if (sensor_device_remote_.is_bound()) {
         sensor_device_remote_->SetFrequency(
             kFrequencyInHz,
@@ -214,6 +218,7 @@ void AmbientLightSensorDelegateMojo::Reset() {
 
   num_failed_reads_ = 0;
   num_recovery_reads_ = 0;
+  sampling_rate_.Reset();
 
   FinishInitialization();
 }
@@ -354,6 +359,42 @@ void AmbientLightSensorDelegateMojo::SetFrequencyCallback(double result_freq) {
   Reset();
 }
 
+void AmbientLightSensorDelegateMojo::UpdateFrequency() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!sensor_device_remote_.is_bound())
+    return;
+
+  const double frequency =
+      sampling_rate_.slowed_down()
+          ? kFrequencyInHz / AdaptiveSamplingRate::kSlowdownFactor
+          : kFrequencyInHz;
+  sensor_device_remote_->SetFrequency(
+      frequency,
+      base::BindOnce(&AmbientLightSensorDelegateMojo::UpdateFrequencyCallback,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void AmbientLightSensorDelegateMojo::UpdateFrequencyCallback(
+    double result_freq) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (result_freq > 0.0)
+    return;
+
+  // The device may not support lower frequencies: keep the default one.
+  LOG(WARNING) << "Device " << iio_device_id_
+               << ": Failed to adapt frequency, disabling adaptive sampling";
+  adaptive_sampling_enabled_ = false;
+  sampling_rate_.Reset();
+  if (sensor_device_remote_.is_bound()) {
+    sensor_device_remote_->SetFrequency(
+        kFrequencyInHz,
+        base::BindOnce(&AmbientLightSensorDelegateMojo::SetFrequencyCallback,
+                       weak_factory_.GetWeakPtr()));
+  }
+}
+
 void AmbientLightSensorDelegateMojo::SetChannelsEnabledCallback(
     const std::vector<int32_t>& failed_indices) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -90,6 +90,10 @@ class AmbientLightSensorDelegateMojo
   void OnObserverDisconnect();
 
   void SetFrequencyCallback(double result_freq);
+
+  // Sets the frequency of the samples according to |sampling_rate_|.
+  void UpdateFrequency();
+  void UpdateFrequencyCallback(double result_freq);
   void SetChannelsEnabledCallback(const std::vector<int32_t>& failed_indices);
 
   void ReadError();
@@ -122,6 +126,11 @@ class AmbientLightSensorDelegateMojo
   // The channel indices of red, green, and blue channels respectively.
   std::map<ChannelType, int32_t> color_indices_;
 
+  // Slows down the samples while the ambient light is stable, unless the
+  // device rejected a lower frequency.
+  AdaptiveSamplingRate sampling_rate_;
+  bool adaptive_sampling_enabled_ = true;
+
   // Number of failed reads. Triggers an error if it reaches
   // kNumFailedReadsBeforeGivingUp.
   uint32_t num_failed_reads_ = 0;
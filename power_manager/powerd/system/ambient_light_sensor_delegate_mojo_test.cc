@@ -190,6 +190,25 @@ TEST_F(AmbientLightSensorDelegateMojoTest, ColorSensor) {
   EXPECT_TRUE(sensor_->IsColorSensor());
 }
 
+TEST_F(AmbientLightSensorDelegateMojoTest, SlowDownSamplingWhenStable) {
+  InitSensor(/*color_delegate=*/false, /*fake_color_sensor=*/false);
+  EXPECT_EQ(fake_light_->frequency(), 1.0);
+
+  for (int i = 0; i < AdaptiveSamplingRate::kNumStableReadingsBeforeSlowdown;
+       ++i) {
+    WriteLux(100);
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(fake_light_->frequency(),
+            1.0 / AdaptiveSamplingRate::kSlowdownFactor);
+
+  // The sampling speeds up as soon as the ambient light changes.
+  WriteLux(300);
+  observer_.CheckSample(300);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(fake_light_->frequency(), 1.0);
+}
+
 TEST_F(AmbientLightSensorDelegateMojoTest, GiveUpAfterTooManyFailures) {
   InitSensor(/*color_delegate=*/false, /*fake_color_sensor=*/false);
 
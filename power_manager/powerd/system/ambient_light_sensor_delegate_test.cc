@@ -47,4 +47,51 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_pair(std::vector<std::optional<int>>{50, 50, 100}, 20921),
         std::make_pair(std::vector<std::optional<int>>{50, 60, 60}, 7253)));
 
+TEST(AdaptiveSamplingRateTest, SlowDownWhenStable) {
+  AdaptiveSamplingRate rate;
+  EXPECT_FALSE(rate.slowed_down());
+
+  // Readings within 10% of the first one are stable.
+  constexpr int kNumReadings =
+      AdaptiveSamplingRate::kNumStableReadingsBeforeSlowdown - 1;
+  for (int i = 0; i < kNumReadings; ++i) {
+    EXPECT_FALSE(rate.Update(i % 2 ? 109 : 100));
+    EXPECT_FALSE(rate.slowed_down());
+  }
+  EXPECT_TRUE(rate.Update(91));
+  EXPECT_TRUE(rate.slowed_down());
+  EXPECT_FALSE(rate.Update(100));
+  EXPECT_TRUE(rate.slowed_down());
+
+  // A change speeds the sampling up immediately.
+  EXPECT_TRUE(rate.Update(200));
+  EXPECT_FALSE(rate.slowed_down());
+}
+
+TEST(AdaptiveSamplingRateTest, MinStableLuxDelta) {
+  AdaptiveSamplingRate rate;
+  for (int i = 0; i < AdaptiveSamplingRate::kNumStableReadingsBeforeSlowdown;
+       ++i) {
+    rate.Update(i % 2 ? AdaptiveSamplingRate::kMinStableLuxDelta : 0);
+  }
+  EXPECT_TRUE(rate.slowed_down());
+
+  EXPECT_TRUE(rate.Update(AdaptiveSamplingRate::kMinStableLuxDelta + 1));
+  EXPECT_FALSE(rate.slowed_down());
+}
+
+TEST(AdaptiveSamplingRateTest, Reset) {
+  AdaptiveSamplingRate rate;
+  for (int i = 0; i < AdaptiveSamplingRate::kNumStableReadingsBeforeSlowdown;
+       ++i) {
+    rate.Update(100);
+  }
+  EXPECT_TRUE(rate.slowed_down());
+
+  rate.Reset();
+  EXPECT_FALSE(rate.slowed_down());
+  EXPECT_FALSE(rate.Update(100));
+  EXPECT_FALSE(rate.slowed_down());
+}
+
 }  // namespace power_manager::system
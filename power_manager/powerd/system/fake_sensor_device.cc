@@ -90,6 +90,7 @@ void FakeSensorDevice::GetAttributes(const std::vector<std::string>& attr_names,
 
 void FakeSensorDevice::SetFrequency(double frequency,
                                     SetFrequencyCallback callback) {
+  frequency_ = frequency;
   std::move(callback).Run(frequency);
 }
 
@@ -31,6 +31,9 @@ class FakeSensorDevice : public cros::mojom::SensorDevice {
 
   void SetAttribute(std::string attr_name, std::string value);
 
+  // Returns the last frequency set with SetFrequency.
+  std::optional<double> frequency() const { return frequency_; }
+
   virtual cros::mojom::DeviceType GetDeviceType() const = 0;
 
   void OnSampleUpdated(const base::flat_map<int32_t, int64_t>& sample);
@@ -77,6 +80,8 @@ class FakeSensorDevice : public cros::mojom::SensorDevice {
   mojo::ReceiverSet<cros::mojom::SensorDevice> receiver_set_;
 
   std::vector<cros::mojom::IioEventPtr> events_;
+
+  std::optional<double> frequency_;
 };
 
 }  // namespace power_manager::system
@@ -14,8 +14,10 @@
 #include <base/check.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
+#include <base/functional/bind.h>
 #include <base/logging.h>
 #include <base/memory/scoped_refptr.h>
+#include <base/task/sequenced_task_runner.h>
 #include <base/time/time.h>
 #include <base/values.h>
 #include <re2/re2.h>
@@ -261,6 +263,24 @@ RmadErrorCode RmadInterfaceImpl::GetInitializedStateHandler(
   return RMAD_ERROR_OK;
 }
 
+void RmadInterfaceImpl::PrefetchNextState(
+    scoped_refptr<BaseStateHandler> state_handler) const {
+  std::optional<RmadState::StateCase> next_state_case =
+      state_handler->GetLikelyNextStateCase();
+  if (!next_state_case.has_value()) {
+    return;
+  }
+  auto next_state_handler =
+      state_handler_manager_->GetStateHandler(next_state_case.value());
+  if (!next_state_handler) {
+    return;
+  }
+  // Run after the reply and the tasks of the current state.
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&BaseStateHandler::PrefetchState, next_state_handler));
+}
+
 void RmadInterfaceImpl::TryTransitionNextStateFromCurrentState() {
   DLOG(INFO) << "Trying a state transition using current state";
   TransitionNextStateInternal(TransitionNextStateRequest(), true);
@@ -287,6 +307,7 @@ GetStateReply RmadInterfaceImpl::GetCurrentStateInternal() {
     reply.set_allocated_state(new RmadState(state_handler->GetState(true)));
     reply.set_can_go_back(CanGoBack());
     reply.set_can_abort(CanAbort());
+    PrefetchNextState(state_handler);
   }
 
   return reply;
@@ -382,6 +403,7 @@ GetStateReply RmadInterfaceImpl::TransitionNextStateInternal(
   reply.set_allocated_state(new RmadState(next_state_handler->GetState(true)));
   reply.set_can_go_back(CanGoBack());
   reply.set_can_abort(CanAbort());
+  PrefetchNextState(next_state_handler);
   return reply;
 }
 
@@ -463,6 +485,7 @@ GetStateReply RmadInterfaceImpl::TransitionPreviousStateInternal() {
   reply.set_allocated_state(new RmadState(prev_state_handler->GetState(true)));
   reply.set_can_go_back(CanGoBack());
   reply.set_can_abort(CanAbort());
+  PrefetchNextState(prev_state_handler);
   return reply;
 }
 
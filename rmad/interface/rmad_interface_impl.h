@@ -119,6 +119,10 @@ class RmadInterfaceImpl final : public RmadInterface {
       RmadState::StateCase state_case,
       scoped_refptr<BaseStateHandler>* state_handler) const;
 
+  // Post a task to prepare the state that likely follows the state handled by
+  // |state_handler|, so that transitioning to it doesn't block on slow probes.
+  void PrefetchNextState(scoped_refptr<BaseStateHandler> state_handler) const;
+
   GetStateReply GetCurrentStateInternal();
   GetStateReply TransitionNextStateInternal(
       const TransitionNextStateRequest& request, bool try_at_boot);
@@ -5,6 +5,8 @@
 #ifndef RMAD_STATE_HANDLER_BASE_STATE_HANDLER_H_
 #define RMAD_STATE_HANDLER_BASE_STATE_HANDLER_H_
 
+#include <optional>
+
 #include <base/functional/callback.h>
 #include <base/memory/ref_counted.h>
 #include <base/memory/scoped_refptr.h>
@@ -64,6 +66,16 @@ class BaseStateHandler : public base::RefCounted<BaseStateHandler> {
             .state_case = GetStateCase()};
   }
 
+  // Return the state that most likely follows this one in the RMA flow, if it
+  // has slow initialization worth preparing in advance. None by default.
+  virtual std::optional<RmadState::StateCase> GetLikelyNextStateCase() const {
+    return std::nullopt;
+  }
+
+  // Prepare the slow parts of InitializeState() in advance, while the previous
+  // state is displayed. Do nothing by default.
+  virtual void PrefetchState() {}
+
   // Store the state to |json_store_|.
   bool StoreState();
 
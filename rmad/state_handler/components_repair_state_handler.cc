@@ -179,9 +179,14 @@ RmadErrorCode ComponentsRepairStateHandler::InitializeState() {
     is_component_probed[component] = false;
   }
 
-  // Call runtime_probe to get all probed components.
+  // Call runtime_probe to get all probed components, unless they were probed
+  // while the previous state was displayed.
   ComponentsWithIdentifier probed_components;
-  if (!runtime_probe_client_->ProbeCategories({}, true, &probed_components)) {
+  if (prefetched_components_.has_value()) {
+    probed_components = std::move(prefetched_components_.value());
+    prefetched_components_.reset();
+  } else if (!runtime_probe_client_->ProbeCategories({}, true,
+                                                     &probed_components)) {
     LOG(ERROR) << "Failed to get probe result from runtime_probe";
     return RMAD_ERROR_STATE_HANDLER_INITIALIZATION_FAILED;
   }
@@ -232,6 +237,22 @@ void ComponentsRepairStateHandler::CleanUpState() {
   active_ = false;
 }
 
+void ComponentsRepairStateHandler::PrefetchState() {
+  if (active_) {
+    return;
+  }
+
+  // Replace any earlier result, so that the components are re-probed every
+  // time the previous state is displayed.
+  prefetched_components_.reset();
+  ComponentsWithIdentifier probed_components;
+  if (runtime_probe_client_->ProbeCategories({}, true, &probed_components)) {
+    prefetched_components_ = std::move(probed_components);
+  } else {
+    LOG(WARNING) << "Failed to prefetch probe result from runtime_probe";
+  }
+}
+
 BaseStateHandler::GetNextStateCaseReply
 ComponentsRepairStateHandler::GetNextStateCase(const RmadState& state) {
   if (!ApplyUserSelection(state)) {
@@ -8,6 +8,7 @@
 #include "rmad/state_handler/base_state_handler.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,7 @@ class ComponentsRepairStateHandler : public BaseStateHandler {
 
   RmadErrorCode InitializeState() override;
   void CleanUpState() override;
+  void PrefetchState() override;
   GetNextStateCaseReply GetNextStateCase(const RmadState& state) override;
 
  protected:
@@ -53,6 +55,8 @@ class ComponentsRepairStateHandler : public BaseStateHandler {
   std::vector<std::string> GetReplacedComponents() const;
 
   bool active_;
+  // Probe result from PrefetchState(), used by the next InitializeState().
+  std::optional<ComponentsWithIdentifier> prefetched_components_;
   std::unique_ptr<CryptohomeClient> cryptohome_client_;
   std::unique_ptr<RuntimeProbeClient> runtime_probe_client_;
   std::unique_ptr<WriteProtectUtils> write_protect_utils_;
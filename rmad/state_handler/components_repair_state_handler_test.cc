@@ -31,6 +31,7 @@ using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
 using testing::SetArgPointee;
+using testing::StrictMock;
 
 namespace rmad {
 
@@ -89,6 +90,35 @@ TEST_F(ComponentsRepairStateHandlerTest, InitializeState_Success) {
   EXPECT_EQ(handler->InitializeState(), RMAD_ERROR_OK);
 }
 
+TEST_F(ComponentsRepairStateHandlerTest, InitializeState_Prefetched) {
+  auto mock_runtime_probe_client =
+      std::make_unique<StrictMock<MockRuntimeProbeClient>>();
+  EXPECT_CALL(*mock_runtime_probe_client, ProbeCategories(_, _, _))
+      .WillOnce(DoAll(
+          SetArgPointee<2>(ComponentsWithIdentifier{
+              {RMAD_COMPONENT_BATTERY, "battery_abcd"}}),
+          Return(true)));
+  auto handler = base::MakeRefCounted<ComponentsRepairStateHandler>(
+      json_store_, daemon_callback_,
+      std::make_unique<NiceMock<MockCryptohomeClient>>(),
+      std::move(mock_runtime_probe_client),
+      std::make_unique<NiceMock<MockWriteProtectUtils>>());
+
+  // The prefetched result is used instead of probing again.
+  handler->PrefetchState();
+  EXPECT_EQ(handler->InitializeState(), RMAD_ERROR_OK);
+
+  bool battery_found = false;
+  for (const auto& component :
+       handler->GetState().components_repair().components()) {
+    if (component.component() == RMAD_COMPONENT_BATTERY) {
+      EXPECT_EQ(component.identifier(), "battery_abcd");
+      battery_found = true;
+    }
+  }
+  EXPECT_TRUE(battery_found);
+}
+
 TEST_F(ComponentsRepairStateHandlerTest, InitializeState_Fail) {
   auto handler = CreateStateHandler(false, {}, false, true);
   EXPECT_EQ(handler->InitializeState(),
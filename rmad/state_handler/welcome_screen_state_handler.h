@@ -8,6 +8,7 @@
 #include "rmad/state_handler/base_state_handler.h"
 
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include <base/files/file_path.h>
@@ -32,6 +33,9 @@ class WelcomeScreenStateHandler : public BaseStateHandler {
 
   RmadErrorCode InitializeState() override;
   GetNextStateCaseReply GetNextStateCase(const RmadState& state) override;
+  std::optional<RmadState::StateCase> GetLikelyNextStateCase() const override {
+    return RmadState::StateCase::kComponentsRepair;
+  }
 
   void RunHardwareVerifier() const;
 
@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include <base/files/file_path.h>
 #include <base/json/json_writer.h>
 #include <base/logging.h>
 #include <base/values.h>
@@ -16,8 +17,10 @@
 #include "runtime_probe/avl_probe_config_loader.h"
 #include "runtime_probe/daemon.h"
 #include "runtime_probe/probe_config.h"
+#include "runtime_probe/probe_function_cache.h"
 #include "runtime_probe/proto_bindings/runtime_probe.pb.h"
 #include "runtime_probe/ssfc_probe_config_loader.h"
+#include "runtime_probe/system/context.h"
 
 namespace runtime_probe {
 
@@ -26,6 +29,10 @@ namespace {
 using brillo::dbus_utils::AsyncEventSequencer;
 using brillo::dbus_utils::DBusObject;
 
+base::FilePath GetBootCacheFile() {
+  return Context::Get()->root_dir().Append(ProbeFunctionCache::kBootCacheFile);
+}
+
 }  // namespace
 
 Daemon::Daemon()
@@ -59,6 +66,9 @@ void Daemon::ProbeCategories(Daemon::DBusCallback<ProbeResult> cb,
     return Quit();
   }
 
+  // The daemon exits after each request, so keep the static results in a file
+  // for the rest of the boot.
+  ProbeFunctionCache cache(GetBootCacheFile());
   base::Value probe_result;
   if (request.probe_default_category()) {
     probe_result = probe_config->Eval();
@@ -135,6 +145,7 @@ void Daemon::ProbeSsfcComponents(
     return Quit();
   }
 
+  ProbeFunctionCache cache(GetBootCacheFile());
   base::Value probe_result;
   probe_result = probe_config->Eval();
 
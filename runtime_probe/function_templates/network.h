@@ -22,6 +22,9 @@ class NetworkFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("network");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  protected:
   virtual std::optional<std::string> GetNetworkType() const;
 
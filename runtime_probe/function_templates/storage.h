@@ -23,6 +23,9 @@ class StorageFunction : public PrivilegedProbeFunction {
   DataType EvalImpl() const final;
   void PostHelperEvalImpl(DataType* result) const final;
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  protected:
   // The following are storage-type specific building blocks.
   // Must be implemented on each derived storage probe function class.
@@ -26,6 +26,9 @@ class AudioCodecFunction final : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("audio_codec");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 };
@@ -26,6 +26,9 @@ class EdidFunction final : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("edid");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 
@@ -21,6 +21,9 @@ class GenericCameraFunction : public ProbeFunction {
  public:
   NAME_PROBE_FUNCTION("generic_camera");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   // ProbeFunction overrides.
   bool PostParseArguments() override;
@@ -23,6 +23,9 @@ class GenericStorageFunction : public ProbeFunction {
  public:
   NAME_PROBE_FUNCTION("generic_storage");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   // ProbeFunction overrides.
   bool PostParseArguments() override;
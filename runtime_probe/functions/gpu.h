@@ -20,6 +20,9 @@ class GpuFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("gpu");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   // PrivilegedProbeFunction overrides.
   DataType EvalImpl() const override;
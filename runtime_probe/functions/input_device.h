@@ -29,6 +29,9 @@ class InputDeviceFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("input_device");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 
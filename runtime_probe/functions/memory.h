@@ -15,6 +15,9 @@ class MemoryFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("memory");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 };
@@ -19,6 +19,9 @@ class MipiCameraFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("mipi_camera");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 
@@ -17,6 +17,9 @@ class MmcHostFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("mmc_host");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   // PrivilegedProbeFunction overrides.
   DataType EvalImpl() const override;
@@ -23,6 +23,9 @@ class TcpcFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("tcpc");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 
@@ -21,6 +21,9 @@ class UsbCameraFunction : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("usb_camera");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 
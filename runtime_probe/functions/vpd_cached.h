@@ -30,6 +30,9 @@ class VPDCached : public PrivilegedProbeFunction {
  public:
   NAME_PROBE_FUNCTION("vpd_cached");
 
+  // ProbeFunction overrides.
+  bool CanCacheResultsForBoot() const override { return true; }
+
  private:
   DataType EvalImpl() const override;
 
@@ -16,6 +16,7 @@
 #include <brillo/map_utils.h>
 
 #include "runtime_probe/component_category.h"
+#include "runtime_probe/probe_function_cache.h"
 
 namespace runtime_probe {
 
@@ -82,6 +83,11 @@ base::Value ProbeConfig::Eval() const {
 
 base::Value ProbeConfig::Eval(const std::vector<std::string>& category) const {
   base::Value result(base::Value::Type::DICT);
+  // Components sharing a probe function are evaluated only once. The caller
+  // may keep its own cache alive, e.g. one that is kept for the boot.
+  std::optional<ProbeFunctionCache> cache;
+  if (!ProbeFunctionCache::Get())
+    cache.emplace();
 
   for (const auto& c : category) {
     auto it = category_.find(c);
@@ -101,6 +101,12 @@ class ProbeFunction {
   // function that requests sandboxing, see |PrivilegedProbeFunction|.
   virtual DataType Eval() const { return EvalImpl(); }
 
+  // Returns true if the results describe hardware which doesn't change until
+  // the next boot, except by hotplug. Such results are reused across probe
+  // requests until a udev event about a hotpluggable device drops them. See
+  // ProbeFunctionCache.
+  virtual bool CanCacheResultsForBoot() const { return false; }
+
   // This is for helper to evaluate the probe function. Helper is designed for
   // portion that need extended sandbox. See |PrivilegedProbeFunction| for more
   // detials.
@@ -125,6 +131,9 @@ class ProbeFunction {
   // Mapping from |function_name| to FromKwargsValue() of each derived classes.
   static RegisteredFunctionTableType registered_functions_;
 
+  // Gets the arguments. It is the raw arguments passed to this function.
+  const base::Value::Dict& arguments() const { return arguments_; }
+
  protected:
   ProbeFunction();
 
@@ -138,9 +147,6 @@ class ProbeFunction {
   // the |ParseArguments()| fail.
   virtual bool PostParseArguments() { return true; }
 
-  // Gets the arguments. It is the raw arguments passed to this function.
-  const base::Value::Dict& arguments() const { return arguments_; }
-
  private:
   // Parses the probe function arguments. Returns false when error.
   bool ParseArguments(const base::Value::Dict& arguments);
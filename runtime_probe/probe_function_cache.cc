@@ -0,0 +1,128 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "runtime_probe/probe_function_cache.h"
+
+#include <string>
+#include <utility>
+
+#include <base/check.h>
+#include <base/files/file_util.h>
+#include <base/json/json_reader.h>
+#include <base/json/json_writer.h>
+#include <base/logging.h>
+#include <base/timer/elapsed_timer.h>
+#include <base/values.h>
+
+namespace runtime_probe {
+
+namespace {
+
+ProbeFunctionCache* g_instance = nullptr;
+
+}  // namespace
+
+ProbeFunctionCache::ProbeFunctionCache(base::FilePath boot_cache_file)
+    : boot_cache_file_(std::move(boot_cache_file)) {
+  CHECK(!g_instance) << "Only one ProbeFunctionCache can be alive at a time";
+  g_instance = this;
+  if (!boot_cache_file_.empty())
+    LoadBootCache();
+}
+
+ProbeFunctionCache::~ProbeFunctionCache() {
+  DCHECK_EQ(g_instance, this);
+  g_instance = nullptr;
+  if (!boot_cache_file_.empty())
+    SaveBootCache();
+
+  base::TimeDelta total;
+  for (const auto& [key, entry] : entries_) {
+    total += entry.duration;
+    VLOG(1) << "Probe function \"" << entry.function_name << "\" took "
+            << entry.duration.InMilliseconds() << " ms for " << entry.count
+            << " statement(s)"
+            << (entry.from_boot_cache ? " (cached for the boot)" : "") << ": "
+            << key;
+  }
+  if (!entries_.empty()) {
+    LOG(INFO) << "Evaluated " << entries_.size() << " probe function(s) in "
+              << total.InMilliseconds() << " ms";
+  }
+}
+
+// static
+ProbeFunctionCache* ProbeFunctionCache::Get() {
+  return g_instance;
+}
+
+ProbeFunction::DataType ProbeFunctionCache::Eval(
+    const ProbeFunction& probe_function) {
+  base::Value::Dict statement;
+  statement.Set(probe_function.GetFunctionName(),
+                probe_function.arguments().Clone());
+  std::string key;
+  base::JSONWriter::Write(statement, &key);
+
+  auto [it, inserted] = entries_.try_emplace(key);
+  Entry& entry = it->second;
+  if (inserted) {
+    entry.function_name = probe_function.GetFunctionName();
+    const bool cacheable = !boot_cache_file_.empty() &&
+                           probe_function.CanCacheResultsForBoot();
+    const base::Value::List* boot_result =
+        cacheable ? boot_results_.FindList(key) : nullptr;
+    if (boot_result) {
+      entry.result = boot_result->Clone();
+      entry.from_boot_cache = true;
+    } else {
+      base::ElapsedTimer timer;
+      entry.result = probe_function.Eval();
+      entry.duration = timer.Elapsed();
+      if (cacheable) {
+        boot_results_.Set(key, entry.result.Clone());
+        boot_results_updated_ = true;
+      }
+    }
+  }
+  entry.count++;
+  return entry.result.Clone();
+}
+
+void ProbeFunctionCache::LoadBootCache() {
+  std::string content;
+  if (!base::ReadFileToString(boot_cache_file_, &content)) {
+    // Create the file so that SaveBootCache() can tell whether it was removed
+    // by a hotplug event in the meantime.
+    boot_cache_exists_ = base::WriteFile(boot_cache_file_, "{}");
+    return;
+  }
+  boot_cache_exists_ = true;
+  auto value = base::JSONReader::Read(content);
+  if (!value || !value->is_dict()) {
+    LOG(WARNING) << "Ignoring invalid probe function cache "
+                 << boot_cache_file_;
+    return;
+  }
+  boot_results_ = std::move(value->GetDict());
+}
+
+void ProbeFunctionCache::SaveBootCache() const {
+  if (!boot_results_updated_ || !boot_cache_exists_)
+    return;
+  // The cache was invalidated by a hotplug event during this request, which
+  // might have changed the results being saved.
+  if (!base::PathExists(boot_cache_file_)) {
+    VLOG(1) << "Not saving the probe function cache which was invalidated";
+    return;
+  }
+  std::string content;
+  if (!base::JSONWriter::Write(boot_results_, &content) ||
+      !base::WriteFile(boot_cache_file_, content)) {
+    LOG(ERROR) << "Failed to save the probe function cache to "
+               << boot_cache_file_;
+  }
+}
+
+}  // namespace runtime_probe
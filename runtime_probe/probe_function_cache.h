@@ -0,0 +1,87 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RUNTIME_PROBE_PROBE_FUNCTION_CACHE_H_
+#define RUNTIME_PROBE_PROBE_FUNCTION_CACHE_H_
+
+#include <map>
+#include <string>
+
+#include <base/files/file_path.h>
+#include <base/time/time.h>
+#include <base/values.h>
+
+#include "runtime_probe/probe_function.h"
+
+namespace runtime_probe {
+
+// Memoizes the results of probe functions within one probe request.
+//
+// Probe configs usually list many components of the same category which
+// evaluate the same probe function and only differ by their "expect" rules.
+// While an instance is alive, ProbeStatement::Eval() evaluates each distinct
+// probe function (same name and arguments) only once and reuses its results
+// for the other statements. When the instance is destroyed, the time spent
+// in each probe function is logged.
+//
+// If |boot_cache_file| is set, the results of the probe functions that
+// can be cached for the boot (see ProbeFunction::CanCacheResultsForBoot())
+// are also loaded from and saved to that file, so that later requests reuse
+// them. The file should live in a tmpfs such as /run, and it is removed by
+// udev/99-runtime_probe.rules whenever a hotpluggable device is added or
+// removed.
+//
+// Only one instance can be alive at a time, and it must be used on the
+// thread that created it.
+class ProbeFunctionCache {
+ public:
+  // The file used by the runtime_probe daemon to cache results for the boot.
+  static constexpr char kBootCacheFile[] =
+      "run/runtime_probe/probe_function_cache.json";
+
+  explicit ProbeFunctionCache(base::FilePath boot_cache_file = {});
+  ProbeFunctionCache(const ProbeFunctionCache&) = delete;
+  ProbeFunctionCache& operator=(const ProbeFunctionCache&) = delete;
+  ~ProbeFunctionCache();
+
+  // Returns the alive instance, or nullptr if there is none.
+  static ProbeFunctionCache* Get();
+
+  // Returns the results of |probe_function|, evaluating it if no function with
+  // the same name and arguments has been evaluated yet.
+  ProbeFunction::DataType Eval(const ProbeFunction& probe_function);
+
+ private:
+  struct Entry {
+    std::string function_name;
+    ProbeFunction::DataType result;
+    // Time spent in the evaluation of the function.
+    base::TimeDelta duration;
+    // Number of times the result was requested.
+    int count = 0;
+    // Whether the result was loaded from |boot_cache_file_|.
+    bool from_boot_cache = false;
+  };
+
+  // Loads |boot_results_| from |boot_cache_file_|.
+  void LoadBootCache();
+  // Saves |boot_results_| to |boot_cache_file_| if they were updated.
+  void SaveBootCache() const;
+
+  // Maps the serialized function name and arguments to their entry.
+  std::map<std::string, Entry> entries_;
+
+  const base::FilePath boot_cache_file_;
+  // Whether |boot_cache_file_| existed, or could be created, when the request
+  // started.
+  bool boot_cache_exists_ = false;
+  // Maps the serialized function name and arguments to their results, for the
+  // functions which can be cached for the boot.
+  base::Value::Dict boot_results_;
+  bool boot_results_updated_ = false;
+};
+
+}  // namespace runtime_probe
+
+#endif  // RUNTIME_PROBE_PROBE_FUNCTION_CACHE_H_
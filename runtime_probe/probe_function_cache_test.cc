@@ -0,0 +1,210 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "runtime_probe/probe_function_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/json/json_reader.h>
+#include <base/values.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "runtime_probe/probe_function.h"
+#include "runtime_probe/probe_function_argument.h"
+#include "runtime_probe/probe_statement.h"
+
+namespace runtime_probe {
+namespace {
+
+using ::testing::ByMove;
+using ::testing::Return;
+
+class MockProbeFunction : public ProbeFunction {
+  using ProbeFunction::ProbeFunction;
+
+ public:
+  NAME_PROBE_FUNCTION("mock_function");
+  MOCK_METHOD(DataType, Eval, (), (const, override));
+  DataType EvalImpl() const override { return {}; }
+};
+
+class CountingProbeFunction : public ProbeFunction {
+  using ProbeFunction::ProbeFunction;
+
+ public:
+  NAME_PROBE_FUNCTION("counting_function");
+  DataType EvalImpl() const override {
+    eval_count_++;
+    return {};
+  }
+
+  PROBE_FUNCTION_ARG_DEF(std::string, a_str, (std::string("")));
+
+  static int eval_count_;
+};
+
+int CountingProbeFunction::eval_count_ = 0;
+
+class CacheableCountingProbeFunction : public CountingProbeFunction {
+  using CountingProbeFunction::CountingProbeFunction;
+
+ public:
+  bool CanCacheResultsForBoot() const override { return true; }
+};
+
+base::Value::List MakeResult() {
+  return std::move(base::JSONReader::Read(R"([
+    {
+      "field_1": "value_1",
+      "field_2": "value_2"
+    }
+  ])")
+                       ->GetList());
+}
+
+// Creates a probe statement evaluating |probe_function| and filtering its
+// results by |keys|, a JSON list.
+std::unique_ptr<ProbeStatement> MakeProbeStatement(
+    std::unique_ptr<ProbeFunction> probe_function, const std::string& keys) {
+  auto dict_value = base::JSONReader::Read(
+      R"({"eval": {"memory": {}}, "keys": )" + keys + "}");
+  auto probe_statement = ProbeStatement::FromValue("component", *dict_value);
+  probe_statement->SetProbeFunctionForTesting(std::move(probe_function));
+  return probe_statement;
+}
+
+TEST(ProbeFunctionCacheTest, Get) {
+  EXPECT_EQ(ProbeFunctionCache::Get(), nullptr);
+  {
+    ProbeFunctionCache cache;
+    EXPECT_EQ(ProbeFunctionCache::Get(), &cache);
+  }
+  EXPECT_EQ(ProbeFunctionCache::Get(), nullptr);
+}
+
+TEST(ProbeFunctionCacheTest, EvalSameFunctionOnce) {
+  auto probe_function_1 = std::make_unique<MockProbeFunction>();
+  EXPECT_CALL(*probe_function_1, Eval())
+      .WillOnce(Return(ByMove(MakeResult())));
+  auto probe_function_2 = std::make_unique<MockProbeFunction>();
+  EXPECT_CALL(*probe_function_2, Eval()).Times(0);
+
+  auto probe_statement_1 = MakeProbeStatement(std::move(probe_function_1),
+                                              R"(["field_1"])");
+  auto probe_statement_2 = MakeProbeStatement(std::move(probe_function_2),
+                                              R"(["field_2"])");
+
+  ProbeFunctionCache cache;
+  // Each statement filters its own copy of the results.
+  auto res_1 = probe_statement_1->Eval();
+  auto res_2 = probe_statement_2->Eval();
+  EXPECT_EQ(res_1,
+            base::JSONReader::Read(R"([{"field_1": "value_1"}])")->GetList());
+  EXPECT_EQ(res_2,
+            base::JSONReader::Read(R"([{"field_2": "value_2"}])")->GetList());
+}
+
+TEST(ProbeFunctionCacheTest, EvalWithoutCache) {
+  auto probe_function = std::make_unique<MockProbeFunction>();
+  EXPECT_CALL(*probe_function, Eval())
+      .WillOnce(Return(ByMove(MakeResult())))
+      .WillOnce(Return(ByMove(MakeResult())));
+  auto probe_statement = MakeProbeStatement(std::move(probe_function), "[]");
+
+  EXPECT_EQ(probe_statement->Eval(), MakeResult());
+  EXPECT_EQ(probe_statement->Eval(), MakeResult());
+}
+
+TEST(ProbeFunctionCacheTest, EvalDifferentArguments) {
+  CountingProbeFunction::eval_count_ = 0;
+  auto probe_function_a = CreateProbeFunction<CountingProbeFunction>(
+      base::JSONReader::Read(R"({"a_str": "a"})")->GetDict());
+  auto probe_function_b = CreateProbeFunction<CountingProbeFunction>(
+      base::JSONReader::Read(R"({"a_str": "b"})")->GetDict());
+  ASSERT_TRUE(probe_function_a);
+  ASSERT_TRUE(probe_function_b);
+
+  ProbeFunctionCache cache;
+  cache.Eval(*probe_function_a);
+  cache.Eval(*probe_function_b);
+  cache.Eval(*probe_function_a);
+  EXPECT_EQ(CountingProbeFunction::eval_count_, 2);
+}
+
+class ProbeFunctionBootCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    boot_cache_file_ = temp_dir_.GetPath().Append("cache.json");
+    CountingProbeFunction::eval_count_ = 0;
+  }
+
+  // Evaluates |probe_function| in a new request using the boot cache.
+  void EvalInRequest(const ProbeFunction& probe_function) {
+    ProbeFunctionCache cache(boot_cache_file_);
+    cache.Eval(probe_function);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath boot_cache_file_;
+};
+
+TEST_F(ProbeFunctionBootCacheTest, ReuseResultsAcrossRequests) {
+  auto probe_function =
+      CreateProbeFunction<CacheableCountingProbeFunction>(base::Value::Dict{});
+
+  EvalInRequest(*probe_function);
+  EvalInRequest(*probe_function);
+  EXPECT_EQ(CountingProbeFunction::eval_count_, 1);
+  EXPECT_TRUE(base::PathExists(boot_cache_file_));
+}
+
+TEST_F(ProbeFunctionBootCacheTest, NotCacheableFunction) {
+  auto probe_function =
+      CreateProbeFunction<CountingProbeFunction>(base::Value::Dict{});
+
+  EvalInRequest(*probe_function);
+  EvalInRequest(*probe_function);
+  EXPECT_EQ(CountingProbeFunction::eval_count_, 2);
+}
+
+TEST_F(ProbeFunctionBootCacheTest, InvalidatedByRemovingFile) {
+  auto probe_function =
+      CreateProbeFunction<CacheableCountingProbeFunction>(base::Value::Dict{});
+
+  EvalInRequest(*probe_function);
+  ASSERT_TRUE(base::DeleteFile(boot_cache_file_));
+  EvalInRequest(*probe_function);
+  EXPECT_EQ(CountingProbeFunction::eval_count_, 2);
+}
+
+TEST_F(ProbeFunctionBootCacheTest, NotSavedWhenInvalidatedDuringRequest) {
+  auto probe_function =
+      CreateProbeFunction<CacheableCountingProbeFunction>(base::Value::Dict{});
+
+  {
+    ProbeFunctionCache cache(boot_cache_file_);
+    cache.Eval(*probe_function);
+    ASSERT_TRUE(base::DeleteFile(boot_cache_file_));
+  }
+  EXPECT_FALSE(base::PathExists(boot_cache_file_));
+}
+
+TEST_F(ProbeFunctionBootCacheTest, IgnoreInvalidFile) {
+  ASSERT_TRUE(base::WriteFile(boot_cache_file_, "not json"));
+  auto probe_function =
+      CreateProbeFunction<CacheableCountingProbeFunction>(base::Value::Dict{});
+
+  EvalInRequest(*probe_function);
+  EvalInRequest(*probe_function);
+  EXPECT_EQ(CountingProbeFunction::eval_count_, 1);
+}
+
+}  // namespace
+}  // namespace runtime_probe
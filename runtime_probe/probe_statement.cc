@@ -8,6 +8,7 @@
 #include <base/values.h>
 
 #include "runtime_probe/probe_statement.h"
+#include "runtime_probe/probe_function_cache.h"
 
 namespace runtime_probe {
 
@@ -98,7 +99,9 @@ std::unique_ptr<ProbeStatement> ProbeStatement::FromValue(
 }
 
 ProbeFunction::DataType ProbeStatement::Eval() const {
-  auto results = probe_function_->Eval();
+  auto* cache = ProbeFunctionCache::Get();
+  auto results =
+      cache ? cache->Eval(*probe_function_) : probe_function_->Eval();
 
   if (!key_.empty()) {
     std::for_each(results.begin(), results.end(),
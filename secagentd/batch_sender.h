@@ -13,8 +13,10 @@
 #include "base/functional/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "secagentd/message_sender.h"
+#include "secagentd/metrics_sender.h"
 #include "secagentd/proto/security_xdr_events.pb.h"
 
 namespace secagentd {
@@ -47,6 +49,15 @@ class BatchSenderInterface {
       VisitCallback cb) = 0;
 };
 
+// Batches are flushed on a timer whose interval adapts to the recent arrival
+// rate of events and to the latency of the enqueueing into missive:
+//   - When too few events arrive per interval for batching to pay off, the
+//     timer is shortened so that events aren't delayed for nothing.
+//   - When events arrive fast, the timer is shortened so that batches are sent
+//     before reaching the size bound.
+//   - The timer is never shorter than kEnqueueLatencyFactor times the recent
+//     enqueue latency so that a slow missive is given bigger batches.
+// batch_interval_s is the longest interval.
 template <typename KeyType, typename XdrMessage, typename AtomicVariantMessage>
 class BatchSender
     : public BatchSenderInterface<KeyType, XdrMessage, AtomicVariantMessage> {
@@ -56,6 +67,11 @@ class BatchSender
   using VisitCallback = base::OnceCallback<void(AtomicVariantMessage*)>;
 
   static constexpr size_t kMaxMessageSizeBytes = 8 * 1024 * 1024;
+  static constexpr base::TimeDelta kMinBatchInterval = base::Seconds(1);
+  // Below this number of events per batch_interval_s, flush as soon as
+  // kMinBatchInterval allows.
+  static constexpr double kMinEventsPerBatch = 16;
+  static constexpr int kEnqueueLatencyFactor = 100;
 
   BatchSender(KeyDerive kd,
               scoped_refptr<secagentd::MessageSenderInterface> message_sender,
@@ -68,10 +84,9 @@ class BatchSender
         batch_interval_s_(batch_interval_s) {}
 
   void Start() override {
-    batch_timer_.Start(FROM_HERE,
-                       base::Seconds(std::max(batch_interval_s_, 1u)),
-                       base::BindRepeating(&BatchSender::Flush,
-                                           weak_ptr_factory_.GetWeakPtr()));
+    base::AutoLock lock(events_lock_);
+    last_flush_time_ = base::TimeTicks::Now();
+    ScheduleFlush(GetMaxBatchInterval());
   }
   bool Visit(typename AtomicVariantMessage::VariantTypeCase variant_type,
              const KeyType& key,
@@ -97,8 +112,7 @@ class BatchSender
     // Reserve ~10% for overhead of packing these events into the larger
     // message.
     if (events_byte_size_ + event_byte_size >= kMaxMessageSizeBytes * 0.9) {
-      base::AutoUnlock unlock(events_lock_);
-      Flush();
+      FlushLocked(metrics::BatchFlushReason::kSizeBound);
     }
     lookup_map_.insert(
         std::make_pair(std::make_pair(atomic_event->variant_type_case(),
@@ -106,36 +120,121 @@ class BatchSender
                        atomic_event.get()));
     events_byte_size_ += event_byte_size;
     events_.emplace_back(std::move(atomic_event));
+    // The timer is stopped while there is nothing to flush.
+    if (!batch_timer_.IsRunning()) {
+      ScheduleFlush(GetBatchInterval());
+    }
   }
 
  protected:
   void Flush() {
-    if (events_byte_size_) {
-      base::AutoLock lock(events_lock_);
-      VLOG(1) << "Flushing Batch for Destination " << destination_
-              << ". Batch size = " << events_.size() << " (~"
-              << events_byte_size_ << " bytes)";
-      lookup_map_.clear();
-      auto xdr_proto = std::make_unique<XdrMessage>();
-      for (auto& event : events_) {
-        xdr_proto->add_batched_events()->Swap(event.get());
-      }
-      message_sender_->SendMessage(destination_, xdr_proto->mutable_common(),
-                                   std::move(xdr_proto), std::nullopt);
-      events_.clear();
-      events_byte_size_ = 0;
+    base::AutoLock lock(events_lock_);
+    FlushLocked(metrics::BatchFlushReason::kTimer);
+  }
+
+  void FlushLocked(metrics::BatchFlushReason reason) {
+    events_lock_.AssertAcquired();
+    UpdateArrivalRates();
+    if (events_.empty()) {
+      // Don't wake up until the next event.
+      batch_timer_.Stop();
+      return;
+    }
+    VLOG(1) << "Flushing Batch for Destination " << destination_
+            << ". Batch size = " << events_.size() << " (~"
+            << events_byte_size_ << " bytes)";
+    MetricsSender::GetInstance().IncrementBatchedMetric(
+        metrics::kBatchFlushReason, reason);
+    MetricsSender::GetInstance().IncrementBatchedMetric(
+        metrics::kBatchSize, GetBatchSizeBucket(events_.size()));
+    lookup_map_.clear();
+    auto xdr_proto = std::make_unique<XdrMessage>();
+    for (auto& event : events_) {
+      xdr_proto->add_batched_events()->Swap(event.get());
+    }
+    message_sender_->SendMessage(
+        destination_, xdr_proto->mutable_common(), std::move(xdr_proto),
+        base::BindOnce(&BatchSender::OnEnqueued,
+                       weak_ptr_factory_.GetWeakPtr(),
+                       base::TimeTicks::Now()));
+    events_.clear();
+    events_byte_size_ = 0;
+    ScheduleFlush(GetBatchInterval());
+  }
+
+  // Updates the rates at which events and bytes arrived since the last flush.
+  void UpdateArrivalRates() {
+    const base::TimeTicks now = base::TimeTicks::Now();
+    const double elapsed_s = (now - last_flush_time_).InSecondsF();
+    last_flush_time_ = now;
+    if (elapsed_s <= 0) {
+      return;
+    }
+    events_per_s_ = kRateSmoothing * (events_.size() / elapsed_s) +
+                    (1 - kRateSmoothing) * events_per_s_;
+    bytes_per_s_ = kRateSmoothing * (events_byte_size_ / elapsed_s) +
+                   (1 - kRateSmoothing) * bytes_per_s_;
+  }
+
+  void OnEnqueued(base::TimeTicks send_time, reporting::Status status) {
+    base::AutoLock lock(events_lock_);
+    enqueue_latency_ =
+        kRateSmoothing * (base::TimeTicks::Now() - send_time) +
+        (1 - kRateSmoothing) * enqueue_latency_;
+  }
+
+  base::TimeDelta GetMaxBatchInterval() const {
+    return base::Seconds(std::max(batch_interval_s_, 1u));
+  }
+
+  base::TimeDelta GetBatchInterval() const {
+    events_lock_.AssertAcquired();
+    const base::TimeDelta max_interval = GetMaxBatchInterval();
+    const base::TimeDelta min_interval =
+        std::min(max_interval, std::max(kMinBatchInterval,
+                                        kEnqueueLatencyFactor *
+                                            enqueue_latency_));
+    if (events_per_s_ * max_interval.InSecondsF() < kMinEventsPerBatch) {
+      return min_interval;
+    }
+    base::TimeDelta interval = max_interval;
+    if (bytes_per_s_ > 0) {
+      // Aim at half the size bound to leave room for bursts.
+      interval = std::min(
+          interval, base::Seconds(kMaxMessageSizeBytes * 0.45 / bytes_per_s_));
+    }
+    return std::clamp(interval, min_interval, max_interval);
+  }
+
+  static metrics::BatchSize GetBatchSizeBucket(size_t size) {
+    if (size < 2) {
+      return metrics::BatchSize::k1;
+    } else if (size < 16) {
+      return metrics::BatchSize::k2To15;
+    } else if (size < 128) {
+      return metrics::BatchSize::k16To127;
+    } else if (size < 1024) {
+      return metrics::BatchSize::k128To1023;
     }
-    // Automatically re-fires timer after the same delay.
-    batch_timer_.Reset();
+    return metrics::BatchSize::k1024OrMore;
   }
 
+  void ScheduleFlush(base::TimeDelta delay) {
+    batch_timer_.Start(FROM_HERE, delay,
+                       base::BindRepeating(&BatchSender::Flush,
+                                           weak_ptr_factory_.GetWeakPtr()));
+  }
+
+  // Weight of the latest sample in the moving averages.
+  static constexpr double kRateSmoothing = 0.5;
+
   base::WeakPtrFactory<BatchSender> weak_ptr_factory_;
   KeyDerive kd_;
   scoped_refptr<secagentd::MessageSenderInterface> message_sender_;
   const reporting::Destination destination_;
   uint32_t batch_interval_s_;
   base::RetainingOneShotTimer batch_timer_;
-  base::Lock events_lock_;
+  mutable base::Lock events_lock_;
   // Lookup Key -> &event for visitation.
   absl::flat_hash_map<
       std::pair<typename AtomicVariantMessage::VariantTypeCase, KeyType>,
@@ -145,6 +244,11 @@ class BatchSender
   std::vector<std::unique_ptr<AtomicVariantMessage>> events_;
   // Running total serialized size of currently enqueued events.
   size_t events_byte_size_ = 0;
+  // Moving averages of the arrival rates and of the enqueue latency.
+  base::TimeTicks last_flush_time_;
+  double events_per_s_ = 0;
+  double bytes_per_s_ = 0;
+  base::TimeDelta enqueue_latency_;
 };
 
 }  // namespace secagentd
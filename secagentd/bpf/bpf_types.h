@@ -71,6 +71,7 @@ struct cros_timespec {
 struct cros_image_info {
   char pathname[CROS_MAX_PATH_SIZE];
   uint64_t mnt_ns;
+  uint64_t size;
   uint32_t inode_device_id;
   uint32_t inode;
   uint32_t uid;
@@ -145,6 +146,25 @@ struct cros_process_event {
   } data;
 } __attribute__((aligned(8)));
 
+// Maximum number of executables whose process events are filtered in the
+// kernel, and of their processes being tracked until they exit.
+#define CROS_MAX_FILTERED_IMAGES (64)
+#define CROS_MAX_FILTERED_PROCESSES (1024)
+
+// Identifies an executable file whose process exec and exit events are
+// dropped by the process BPF. The device id is encoded as st_dev by stat().
+struct cros_image_key {
+  uint64_t inode_device_id;
+  uint64_t inode;
+} __attribute__((aligned(8)));
+
+// Indices of the per-CPU counters of the process BPF.
+enum cros_process_counter {
+  kProcessCounterFiltered,        // Events dropped by the image filter.
+  kProcessCounterRingBufferFull,  // Events lost as the ring buffer was full.
+  kProcessCounterCount
+};
+
 // http://www.iana.org/assignments/protocol-numbers
 #define CROS_IANA_HOPOPT (0)
 #define CROS_IANA_ICMP (1)
@@ -20,6 +20,67 @@ struct {
   __uint(max_entries, CROS_MAX_STRUCT_SIZE * 1024);
 } rb SEC(".maps");
 
+// Executables whose process events are dropped, populated by userspace.
+struct {
+  __uint(type, BPF_MAP_TYPE_HASH);
+  __uint(max_entries, CROS_MAX_FILTERED_IMAGES);
+  __type(key, struct cros_image_key);
+  __type(value, uint8_t);
+} filtered_images SEC(".maps");
+
+// Processes whose exec event was dropped, so that their exit event is dropped
+// as well. Keyed by tgid.
+struct {
+  __uint(type, BPF_MAP_TYPE_LRU_HASH);
+  __uint(max_entries, CROS_MAX_FILTERED_PROCESSES);
+  __type(key, uint32_t);
+  __type(value, uint8_t);
+} filtered_processes SEC(".maps");
+
+// Counters of dropped events, indexed by enum cros_process_counter.
+struct {
+  __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+  __uint(max_entries, kProcessCounterCount);
+  __type(key, uint32_t);
+  __type(value, uint64_t);
+} process_counters SEC(".maps");
+
+static inline __attribute__((always_inline)) void increment_counter(
+    uint32_t index) {
+  uint64_t* counter = bpf_map_lookup_elem(&process_counters, &index);
+  if (counter) {
+    // The counters are per CPU, so no atomic operation is needed.
+    *counter += 1;
+  }
+}
+
+// Mimics new_encode_dev() to get a stat-like device id.
+static inline __attribute__((always_inline)) uint32_t encode_dev(dev_t dev) {
+  unsigned major = dev >> 20;
+  unsigned minor = dev & ((1 << 20) - 1);
+  return (minor & 0xff) | (major << 8) | ((minor & ~0xff) << 12);
+}
+
+// Returns whether the exec of bprm by the task with the given tgid must be
+// dropped, and remembers the process in that case.
+static inline __attribute__((always_inline)) bool filter_exec(
+    const struct linux_binprm* bprm, uint32_t tgid) {
+  struct cros_image_key key = {
+      .inode_device_id =
+          encode_dev(BPF_CORE_READ(bprm, file, f_inode, i_sb, s_dev)),
+      .inode = BPF_CORE_READ(bprm, file, f_inode, i_ino),
+  };
+  if (bpf_map_lookup_elem(&filtered_images, &key) == NULL) {
+    // The process may have been filtered before this exec.
+    bpf_map_delete_elem(&filtered_processes, &tgid);
+    return false;
+  }
+  uint8_t value = 1;
+  bpf_map_update_elem(&filtered_processes, &tgid, &value, BPF_ANY);
+  increment_counter(kProcessCounterFiltered);
+  return true;
+}
+
 static inline __attribute__((always_inline)) void fill_ns_info(
     struct cros_namespace_info* ns_info, const struct task_struct* t) {
   ns_info->pid_ns = BPF_CORE_READ(t, nsproxy, pid_ns_for_children, ns.inum);
@@ -57,18 +118,15 @@ static inline __attribute__((always_inline)) void fill_image_info(
   image_info->uid = BPF_CORE_READ(bprm, file, f_inode, i_uid.val);
   image_info->gid = BPF_CORE_READ(bprm, file, f_inode, i_gid.val);
   image_info->mode = BPF_CORE_READ(bprm, file, f_inode, i_mode);
+  image_info->size = BPF_CORE_READ(bprm, file, f_inode, i_size);
   image_info->mtime.tv_sec = BPF_CORE_READ(bprm, file, f_inode, i_mtime.tv_sec);
   image_info->mtime.tv_nsec =
       BPF_CORE_READ(bprm, file, f_inode, i_mtime.tv_nsec);
   image_info->ctime.tv_sec = BPF_CORE_READ(bprm, file, f_inode, i_ctime.tv_sec);
   image_info->ctime.tv_nsec =
       BPF_CORE_READ(bprm, file, f_inode, i_ctime.tv_nsec);
-  // Mimic new_encode_dev() to get stat-like dev_id.
-  dev_t dev = BPF_CORE_READ(bprm, file, f_inode, i_sb, s_dev);
-  unsigned major = dev >> 20;
-  unsigned minor = dev & ((1 << 20) - 1);
   image_info->inode_device_id =
-      (minor & 0xff) | (major << 8) | ((minor & ~0xff) << 12);
+      encode_dev(BPF_CORE_READ(bprm, file, f_inode, i_sb, s_dev));
 
   // Fill in pathname from bprm. Interp is the actual binary that executed post
   // symlink and interpreter resolution.
@@ -103,10 +161,14 @@ int BPF_PROG(handle_sched_process_exec,
   if (is_kthread(current)) {
     return 0;
   }
+  if (filter_exec(bprm, BPF_CORE_READ(current, tgid))) {
+    return 0;
+  }
   // Reserve sample from BPF ringbuf.
   struct cros_event* event =
       (struct cros_event*)(bpf_ringbuf_reserve(&rb, sizeof(*event), 0));
   if (event == NULL) {
+    increment_counter(kProcessCounterRingBufferFull);
     return 0;
   }
   event->type = kProcessEvent;
@@ -139,9 +201,16 @@ int BPF_PROG(handle_sched_process_exit, struct task_struct* current) {
     // anything. So avoid reporting a terminate event for it.
     return 0;
   }
+  uint32_t tgid = BPF_CORE_READ(current, tgid);
+  if (bpf_map_lookup_elem(&filtered_processes, &tgid) != NULL) {
+    bpf_map_delete_elem(&filtered_processes, &tgid);
+    increment_counter(kProcessCounterFiltered);
+    return 0;
+  }
   struct cros_event* event =
       (struct cros_event*)(bpf_ringbuf_reserve(&rb, sizeof(*event), 0));
   if (event == NULL) {
+    increment_counter(kProcessCounterRingBufferFull);
     return 0;
   }
   event->type = kProcessEvent;
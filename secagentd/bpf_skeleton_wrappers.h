@@ -7,22 +7,31 @@
 
 #include <arpa/inet.h>
 #include <bpf/libbpf.h>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "base/files/file_descriptor_watcher_posix.h"
+#include "base/functional/bind.h"
 #include "base/functional/callback.h"
 #include "base/functional/callback_forward.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/memory/weak_ptr.h"
 #include "base/strings/strcat.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/threading/thread.h"
 #include "secagentd/bpf/bpf_types.h"
 #include "secagentd/bpf_skeletons/skeleton_network_bpf.h"
+#include "secagentd/bpf_skeletons/skeleton_process_bpf.h"
 #include "secagentd/common.h"
 #include "secagentd/metrics_sender.h"
 #include "shill/dbus/client/client.h"
@@ -32,6 +41,13 @@ namespace secagentd {
 // Directory with min_core_btf payloads. Must match the ebuild.
 constexpr char kMinCoreBtfDir[] = "/usr/share/btf/secagentd/";
 
+// How long the consumer thread of a ring buffer waits for events before
+// checking whether it should stop.
+constexpr int kConsumerPollTimeoutMs = 100;
+// Maximum number of consumed events waiting to be processed. More events are
+// dropped, so that a slow consumer does not exhaust the memory.
+constexpr size_t kMaxQueuedEvents = 16 * 1024;
+
 // The following callback definitions must have void return type since they will
 // bind to an object method.
 using BpfEventCb = base::RepeatingCallback<void(const bpf::cros_event&)>;
@@ -54,10 +70,17 @@ class BpfSkeletonInterface {
   // Consume one or more events from a BPF ring buffer, ignoring whether a ring
   // buffer has notified that data is available for read.
   virtual int ConsumeEvent() = 0;
+  // Drops the process events of the given executables in the BPF. Only
+  // supported by the process BPF.
+  virtual absl::Status FilterProcessImages(
+      const std::vector<bpf::cros_image_key>& images) {
+    return absl::UnimplementedError("Process image filter not supported.");
+  }
 
  protected:
   friend class BpfSkeletonFactory;
   friend class NetworkBpfSkeleton;
+  friend class ProcessBpfSkeleton;
   BpfSkeletonInterface() = default;
 
   virtual std::pair<absl::Status, metrics::BpfAttachResult> LoadAndAttach() = 0;
@@ -77,13 +100,25 @@ struct SkeletonCallbacks {
       open_opts;
 };
 
+// If |consume_on_thread| is set, the ring buffer is consumed on a dedicated
+// thread as soon as events are available, and the events are passed in
+// batches to the event callback on the sequence that called LoadAndAttach().
+// The read ready callback is not run in that case.
 template <typename SkeletonType>
 class BpfSkeleton : public BpfSkeletonInterface {
  public:
   BpfSkeleton(std::string_view plugin_name,
-              const SkeletonCallbacks<SkeletonType>& skel_cb)
-      : name_(plugin_name), skel_cbs_(skel_cb) {}
+              const SkeletonCallbacks<SkeletonType>& skel_cb,
+              bool consume_on_thread = false)
+      : name_(plugin_name),
+        skel_cbs_(skel_cb),
+        consume_on_thread_(consume_on_thread) {}
   ~BpfSkeleton() override {
+    // The consumer thread uses the ring buffer, so stop it first.
+    if (consumer_thread_) {
+      stop_consuming_ = true;
+      consumer_thread_->Stop();
+    }
     // The file descriptor being watched must outlive the controller.
     // Force rb_watch_readable_ destruction before closing fd.
     rb_watch_readable_ = nullptr;
@@ -96,15 +131,21 @@ class BpfSkeleton : public BpfSkeletonInterface {
     }
   }
   int ConsumeEvent() override {
-    if (rb_ == nullptr) {
+    // The ring buffer must not be consumed concurrently by two threads.
+    if (rb_ == nullptr || consumer_thread_) {
       return -1;
     }
     return ring_buffer__consume(rb_);
   }
 
+  // Returns the number of events dropped because too many consumed events
+  // were waiting to be processed.
+  uint64_t queue_full_drop_count() const { return queue_full_drop_count_; }
+
  protected:
   friend class BpfSkeletonFactory;
   friend class NetworkBpfSkeleton;
+  friend class ProcessBpfSkeleton;
   std::pair<absl::Status, metrics::BpfAttachResult> LoadAndAttach() override {
     if (callbacks_.ring_buffer_event_callback.is_null() ||
         callbacks_.ring_buffer_read_ready_callback.is_null()) {
@@ -154,9 +195,15 @@ class BpfSkeleton : public BpfSkeletonInterface {
     // ring_buffer__new will fail with an invalid fd but we explicitly check
     // anyways for code clarity.
     if (map_fd >= 0) {
-      rb_ = ring_buffer__new(
-          map_fd, indirect_c_callback,
-          static_cast<void*>(&callbacks_.ring_buffer_event_callback), nullptr);
+      if (consume_on_thread_) {
+        rb_ = ring_buffer__new(map_fd, batch_c_callback,
+                               static_cast<void*>(&consumed_events_), nullptr);
+      } else {
+        rb_ = ring_buffer__new(
+            map_fd, indirect_c_callback,
+            static_cast<void*>(&callbacks_.ring_buffer_event_callback),
+            nullptr);
+      }
       epoll_fd = ring_buffer__epoll_fd(rb_);
     }
 
@@ -166,6 +213,25 @@ class BpfSkeleton : public BpfSkeletonInterface {
                             metrics::BpfAttachResult::kErrorRingBuffer);
     }
 
+    if (consume_on_thread_) {
+      consumer_thread_ =
+          std::make_unique<base::Thread>(base::StrCat({name_, "_bpf_rb"}));
+      if (!consumer_thread_->Start()) {
+        consumer_thread_ = nullptr;
+        return std::make_pair(
+            absl::InternalError(
+                base::StrCat({name_, ": Ring buffer thread failed to start."})),
+            metrics::BpfAttachResult::kErrorRingBuffer);
+      }
+      consumer_thread_->task_runner()->PostTask(
+          FROM_HERE,
+          base::BindOnce(&BpfSkeleton::ConsumeOnThread, base::Unretained(this),
+                         base::SequencedTaskRunner::GetCurrentDefault(),
+                         weak_ptr_factory_.GetWeakPtr()));
+      return std::make_pair(absl::OkStatus(),
+                            metrics::BpfAttachResult::kSuccess);
+    }
+
     rb_watch_readable_ = base::FileDescriptorWatcher::WatchReadable(
         epoll_fd, callbacks_.ring_buffer_read_ready_callback);
     return std::make_pair(absl::OkStatus(), metrics::BpfAttachResult::kSuccess);
@@ -175,10 +241,81 @@ class BpfSkeleton : public BpfSkeletonInterface {
   BpfCallbacks callbacks_;
 
  private:
+  // Waits for events with epoll and consumes them until the skeleton is
+  // destroyed, posting each batch of consumed events to |task_runner|. Runs on
+  // |consumer_thread_|.
+  void ConsumeOnThread(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                       base::WeakPtr<BpfSkeleton> weak_this) {
+    while (!stop_consuming_) {
+      int rv = ring_buffer__poll(rb_, kConsumerPollTimeoutMs);
+      if (rv < 0 && rv != -EINTR) {
+        LOG(ERROR) << name_ << ": Failed to poll the ring buffer: " << rv;
+        return;
+      }
+      if (consumed_events_.empty()) {
+        continue;
+      }
+      const size_t count = consumed_events_.size();
+      if (queued_event_count_ + count > kMaxQueuedEvents) {
+        queue_full_drop_count_ += count;
+        consumed_events_.clear();
+        continue;
+      }
+      queued_event_count_ += count;
+      task_runner->PostTask(
+          FROM_HERE, base::BindOnce(&BpfSkeleton::RunEventCallback, weak_this,
+                                    std::move(consumed_events_)));
+      consumed_events_.clear();
+    }
+  }
+
+  // Passes the consumed events to the event callback.
+  void RunEventCallback(std::vector<bpf::cros_event> events) {
+    queued_event_count_ -= events.size();
+    for (const auto& event : events) {
+      callbacks_.ring_buffer_event_callback.Run(event);
+    }
+  }
+
   std::string name_;
   const SkeletonCallbacks<SkeletonType> skel_cbs_;
   struct ring_buffer* rb_{nullptr};
   std::unique_ptr<base::FileDescriptorWatcher::Controller> rb_watch_readable_;
+
+  const bool consume_on_thread_;
+  std::unique_ptr<base::Thread> consumer_thread_;
+  std::atomic<bool> stop_consuming_{false};
+  // Events consumed by the current poll. Only used on |consumer_thread_|.
+  std::vector<bpf::cros_event> consumed_events_;
+  // Events posted to the event callback and not processed yet.
+  std::atomic<size_t> queued_event_count_{0};
+  std::atomic<uint64_t> queue_full_drop_count_{0};
+  base::WeakPtrFactory<BpfSkeleton> weak_ptr_factory_{this};
+};
+
+// Wraps the process BPF: its ring buffer is consumed on a dedicated thread,
+// noisy executables can be filtered in the kernel, and the dropped events are
+// reported on each flush of the batched metrics.
+class ProcessBpfSkeleton : public BpfSkeletonInterface {
+ public:
+  ProcessBpfSkeleton();
+  int ConsumeEvent() override;
+  absl::Status FilterProcessImages(
+      const std::vector<bpf::cros_image_key>& images) override;
+
+ protected:
+  std::pair<absl::Status, metrics::BpfAttachResult> LoadAndAttach() override;
+  void RegisterCallbacks(BpfCallbacks cbs) override;
+
+ private:
+  // Reports the events dropped since the previous call.
+  void SendDroppedEventMetrics();
+
+  std::unique_ptr<BpfSkeleton<process_bpf>> default_bpf_skeleton_;
+  // Dropped events already reported, indexed by metrics::BpfEventDrop.
+  uint64_t reported_drops_[static_cast<int>(metrics::BpfEventDrop::kMaxValue) +
+                           1] = {};
+  base::WeakPtrFactory<ProcessBpfSkeleton> weak_ptr_factory_{this};
 };
 
 class NetworkBpfSkeleton : public BpfSkeletonInterface {
@@ -2,12 +2,36 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "base/check.h"
 #include "secagentd/bpf/bpf_types.h"
 #include "secagentd/bpf_skeleton_wrappers.h"
 #include "secagentd/common.h"
+#include "secagentd/metrics_sender.h"
 
 namespace secagentd {
+
+namespace {
+
+// Reports the |total| events dropped for |reason| minus the |reported| ones,
+// and updates |reported|.
+void SendDroppedEvents(metrics::BpfEventDrop reason,
+                       uint64_t total,
+                       uint64_t* reported) {
+  if (total > *reported) {
+    const uint64_t count = std::min<uint64_t>(total - *reported,
+                                              std::numeric_limits<int>::max());
+    MetricsSender::GetInstance().SendRepeatedEnumMetricToUMA(
+        metrics::kProcessBpfEventDrop, reason, count);
+  }
+  *reported = total;
+}
+
+}  // namespace
+
 NetworkBpfSkeleton::NetworkBpfSkeleton(uint32_t batch_interval_s,
                                        std::unique_ptr<shill::Client> shill)
     : batch_interval_s_(batch_interval_s), weak_ptr_factory_(this) {
@@ -206,4 +230,89 @@ void NetworkBpfSkeleton::RegisterCallbacks(BpfCallbacks cbs) {
   default_bpf_skeleton_->RegisterCallbacks(std::move(cbs));
 }
 
+ProcessBpfSkeleton::ProcessBpfSkeleton() {
+  SkeletonCallbacks<process_bpf> skel_cbs;
+  skel_cbs.destroy = base::BindRepeating(process_bpf__destroy);
+  skel_cbs.open = base::BindRepeating(process_bpf__open);
+  skel_cbs.open_opts = base::BindRepeating(process_bpf__open_opts);
+  // Build storms exec thousands of processes per second, so consume the ring
+  // buffer off the main sequence to keep up with them.
+  default_bpf_skeleton_ = std::make_unique<BpfSkeleton<process_bpf>>(
+      "process", skel_cbs, /*consume_on_thread=*/true);
+}
+
+int ProcessBpfSkeleton::ConsumeEvent() {
+  return default_bpf_skeleton_->ConsumeEvent();
+}
+
+std::pair<absl::Status, metrics::BpfAttachResult>
+ProcessBpfSkeleton::LoadAndAttach() {
+  auto rv = default_bpf_skeleton_->LoadAndAttach();
+  if (!rv.first.ok()) {
+    return rv;
+  }
+  MetricsSender::GetInstance().RegisterMetricOnFlushCallback(
+      base::BindRepeating(&ProcessBpfSkeleton::SendDroppedEventMetrics,
+                          weak_ptr_factory_.GetWeakPtr()));
+  return rv;
+}
+
+void ProcessBpfSkeleton::RegisterCallbacks(BpfCallbacks cbs) {
+  default_bpf_skeleton_->RegisterCallbacks(std::move(cbs));
+}
+
+absl::Status ProcessBpfSkeleton::FilterProcessImages(
+    const std::vector<bpf::cros_image_key>& images) {
+  if (images.size() > CROS_MAX_FILTERED_IMAGES) {
+    return absl::InvalidArgumentError("Process: Too many filtered images.");
+  }
+  auto map = default_bpf_skeleton_->skel_->maps.filtered_images;
+  const uint8_t value = 1;
+  for (const auto& image : images) {
+    if (bpf_map__update_elem(map, &image, sizeof(image), &value, sizeof(value),
+                             BPF_ANY) < 0) {
+      return absl::InternalError(
+          "Process: Unable to add an image to the BPF filter.");
+    }
+  }
+  return absl::OkStatus();
+}
+
+void ProcessBpfSkeleton::SendDroppedEventMetrics() {
+  const int num_cpus = libbpf_num_possible_cpus();
+  if (num_cpus <= 0) {
+    LOG(ERROR) << "Process: Failed to get the number of CPUs.";
+    return;
+  }
+  auto map = default_bpf_skeleton_->skel_->maps.process_counters;
+  uint64_t totals[bpf::kProcessCounterCount] = {};
+  std::vector<uint64_t> per_cpu_values(num_cpus);
+  for (uint32_t i = 0; i < bpf::kProcessCounterCount; ++i) {
+    if (bpf_map__lookup_elem(map, &i, sizeof(i), per_cpu_values.data(),
+                             per_cpu_values.size() * sizeof(uint64_t),
+                             0) < 0) {
+      LOG(ERROR) << "Process: Failed to read the BPF counter " << i;
+      return;
+    }
+    for (uint64_t value : per_cpu_values) {
+      totals[i] += value;
+    }
+  }
+
+  SendDroppedEvents(
+      metrics::BpfEventDrop::kFilteredInKernel,
+      totals[bpf::kProcessCounterFiltered],
+      &reported_drops_[static_cast<int>(
+          metrics::BpfEventDrop::kFilteredInKernel)]);
+  SendDroppedEvents(
+      metrics::BpfEventDrop::kRingBufferFull,
+      totals[bpf::kProcessCounterRingBufferFull],
+      &reported_drops_[static_cast<int>(
+          metrics::BpfEventDrop::kRingBufferFull)]);
+  SendDroppedEvents(
+      metrics::BpfEventDrop::kQueueFull,
+      default_bpf_skeleton_->queue_full_drop_count(),
+      &reported_drops_[static_cast<int>(metrics::BpfEventDrop::kQueueFull)]);
+}
+
 }  // namespace secagentd
@@ -9,6 +9,7 @@
 #include <string>
 #include <unistd.h>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/str_format.h"
 #include "secagentd/bpf/bpf_types.h"
@@ -25,6 +26,15 @@ extern "C" int indirect_c_callback(void* ctx, void* data, size_t size) {
   return 0;
 }
 
+extern "C" int batch_c_callback(void* ctx, void* data, size_t size) {
+  if (ctx == nullptr || size < sizeof(bpf::cros_event)) {
+    return -1;
+  }
+  auto* batch = static_cast<std::vector<bpf::cros_event>*>(ctx);
+  batch->push_back(*static_cast<bpf::cros_event*>(data));
+  return 0;
+}
+
 namespace common {
 namespace {
 scoped_refptr<dbus::Bus> dbus{nullptr};
@@ -16,6 +16,9 @@ namespace secagentd {
 // RepeatingCallback<void(const bpf::event&)>. void* data is cast into a
 // bpf::event and then passed into this RepeatingCallback.
 extern "C" int indirect_c_callback(void* ctx, void* data, size_t size);
+// Same as indirect_c_callback, except that the void* ctx shall always point to
+// a std::vector<bpf::cros_event> the event is appended to.
+extern "C" int batch_c_callback(void* ctx, void* data, size_t size);
 namespace common {
 void SetDBus(scoped_refptr<dbus::Bus>);
 
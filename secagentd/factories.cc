@@ -11,7 +11,6 @@
 #include "attestation-client/attestation/dbus-proxies.h"
 #include "base/memory/scoped_refptr.h"
 #include "secagentd/bpf_skeleton_wrappers.h"
-#include "secagentd/bpf_skeletons/skeleton_process_bpf.h"
 #include "secagentd/common.h"
 #include "secagentd/message_sender.h"
 #include "secagentd/metrics_sender.h"
@@ -30,11 +29,7 @@ std::unique_ptr<BpfSkeletonInterface> BpfSkeletonFactory::Create(
       if (di_.process) {
         rv = std::move(di_.process);
       } else {
-        SkeletonCallbacks<process_bpf> skel_cbs;
-        skel_cbs.destroy = base::BindRepeating(process_bpf__destroy);
-        skel_cbs.open = base::BindRepeating(process_bpf__open);
-        skel_cbs.open_opts = base::BindRepeating(process_bpf__open_opts);
-        rv = std::make_unique<BpfSkeleton<process_bpf>>("process", skel_cbs);
+        rv = std::make_unique<ProcessBpfSkeleton>();
       }
       break;
     case Types::BpfSkeleton::kNetwork:
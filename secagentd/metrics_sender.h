@@ -68,6 +68,16 @@ static constexpr EnumMetric<BpfAttachResult> kNetworkBpfAttach = {
 static constexpr EnumMetric<BpfAttachResult> kProcessBpfAttach = {
     .name = "Bpf.Process.AttachResult"};
 
+enum class BpfEventDrop {
+  kFilteredInKernel,
+  kRingBufferFull,
+  kQueueFull,
+  kMaxValue = kQueueFull,
+};
+
+static constexpr EnumMetric<BpfEventDrop> kProcessBpfEventDrop = {
+    .name = "Bpf.Process.DroppedEvents"};
+
 // This should always follow the missive status code.
 // https://chromium.googlesource.com/chromiumos/platform2/+/6142bdcb70dc0987f9234c2294660f798d5df05a/missive/util/status.h#26
 enum class SendMessage {
@@ -152,6 +162,27 @@ static constexpr EnumMetric<ProcessEvent> kExecEvent = {
 static constexpr EnumMetric<ProcessEvent> kTerminateEvent = {
     .name = "Process.TerminateEvent"};
 
+enum class BatchFlushReason {
+  kTimer,
+  kSizeBound,
+  kMaxValue = kSizeBound,
+};
+
+static constexpr EnumMetric<BatchFlushReason> kBatchFlushReason = {
+    .name = "Batch.FlushReason"};
+
+// Number of events per flushed batch.
+enum class BatchSize {
+  k1,
+  k2To15,
+  k16To127,
+  k128To1023,
+  k1024OrMore,
+  kMaxValue = k1024OrMore,
+};
+
+static constexpr EnumMetric<BatchSize> kBatchSize = {.name = "Batch.Size"};
+
 constexpr char kRedaction[] = "Redaction";
 static constexpr int kRedactionBucketCount = 6;
 
@@ -176,6 +207,16 @@ class MetricsSender {
         base::StrCat({metrics::kMetricNamePrefix, metric.name}), sample);
   }
 
+  // Same as SendEnumMetricToUMA except sends |count| samples at once.
+  template <typename M>
+  bool SendRepeatedEnumMetricToUMA(M metric,
+                                   typename M::Enum sample,
+                                   int count) {
+    return metrics_library_->SendRepeatedEnumToUMA(
+        base::StrCat({metrics::kMetricNamePrefix, metric.name}), sample,
+        count);
+  }
+
   // Same as SendEnumMetricToUMA except sends percentage instead.
   bool SendPercentageMetricToUMA(std::string_view name, int sample) {
     return metrics_library_->SendPercentageToUMA(
@@ -261,12 +302,19 @@ class MetricsSender {
       {metrics::kExecEvent.name,
        static_cast<int>(metrics::ProcessEvent::kMaxValue) + 1},
       {metrics::kTerminateEvent.name,
-       static_cast<int>(metrics::ProcessEvent::kMaxValue) + 1}};
+       static_cast<int>(metrics::ProcessEvent::kMaxValue) + 1},
+      {metrics::kBatchFlushReason.name,
+       static_cast<int>(metrics::BatchFlushReason::kMaxValue) + 1},
+      {metrics::kBatchSize.name,
+       static_cast<int>(metrics::BatchSize::kMaxValue) + 1}};
   const metrics::MetricsMap success_value_map_ = {
       {metrics::kSendMessage.name, 0},
       {metrics::kCache.name, 0},
       {metrics::kExecEvent.name, 0},
-      {metrics::kTerminateEvent.name, 0}};
+      {metrics::kTerminateEvent.name, 0},
+      // No sample of the batch metrics is rescaled as a success value.
+      {metrics::kBatchFlushReason.name, -1},
+      {metrics::kBatchSize.name, -1}};
 };
 }  // namespace secagentd
 
@@ -4,6 +4,7 @@
 
 #include "secagentd/process_cache.h"
 
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -24,6 +25,7 @@
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/functional/bind.h"
 #include "base/hash/md5.h"
 #include "base/logging.h"
@@ -31,6 +33,7 @@
 #include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece_forward.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
@@ -54,6 +57,10 @@ static const char kErrorFailedToRead[] = "Failed to read ";
 static const char kErrorFailedToParse[] = "Failed to parse ";
 static const char kErrorSslSha[] = "SSL SHA error";
 static const char kRedactMessage[] = "[EMAIL_REDACTED]";
+// Relative to the root path.
+static const char kImageCachePath[] = "var/lib/secagentd/image_cache";
+// Number of fields of an image cache line: the image key and the SHA256.
+static constexpr size_t kImageCacheFields = 8;
 
 std::string StableUuid(ProcessCache::InternalProcessKeyType seed) {
   base::MD5Digest md5;
@@ -233,7 +240,8 @@ VerifyStatAndGenerateImageHash(
       (image_stat.st_mtim.tv_sec != image_key.mtime.tv_sec) ||
       (image_stat.st_mtim.tv_nsec != image_key.mtime.tv_nsec) ||
       (image_stat.st_ctim.tv_sec != image_key.ctime.tv_sec) ||
-      (image_stat.st_ctim.tv_nsec != image_key.ctime.tv_nsec)) {
+      (image_stat.st_ctim.tv_nsec != image_key.ctime.tv_nsec) ||
+      (static_cast<uint64_t>(image_stat.st_size) != image_key.size)) {
     return absl::NotFoundError(
         base::StrCat({"Failed to match stat of image hashed at ",
                       image_path_in_current_ns.value()}));
@@ -276,9 +284,11 @@ void RedactCommandline(std::string* commandline,
 namespace secagentd {
 
 constexpr ProcessCache::InternalProcessCacheType::size_type
-    kProcessCacheMaxSize = 256;
+    kProcessCacheShardMaxSize = 64;
+// Large enough for all the executables commonly run on a device, as the cache
+// is saved across restarts.
 constexpr ProcessCache::InternalImageCacheType::size_type kImageCacheMaxSize =
-    256;
+    1024;
 
 uint64_t ProcessCache::LossyNsecToClockT(bpf::time_ns_t ns) {
   static constexpr uint64_t kNsecPerSec = 1000000000;
@@ -337,13 +347,18 @@ absl::StatusOr<base::FilePath> ProcessCache::SafeAppendAbsolutePath(
 ProcessCache::ProcessCache(const base::FilePath& root_path,
                            scoped_refptr<DeviceUserInterface> device_user)
     : weak_ptr_factory_(this),
-      process_cache_(
-          std::make_unique<InternalProcessCacheType>(kProcessCacheMaxSize)),
       image_cache_(
           std::make_unique<InternalImageCacheType>(kImageCacheMaxSize)),
+      image_cache_path_(root_path.Append(kImageCachePath)),
       device_user_(device_user),
       root_path_(root_path),
-      earliest_seen_exec_rel_s_(INT64_MAX) {}
+      earliest_seen_exec_rel_s_(INT64_MAX) {
+  for (auto& shard : process_cache_shards_) {
+    shard.cache =
+        std::make_unique<InternalProcessCacheType>(kProcessCacheShardMaxSize);
+  }
+  LoadImageCache();
+}
 
 ProcessCache::ProcessCache(scoped_refptr<DeviceUserInterface> device_user)
     : ProcessCache(base::FilePath("/"), device_user) {}
@@ -356,6 +371,10 @@ void ProcessCache::PutFromBpfExec(
     MetricsSender::GetInstance().RegisterMetricOnFlushCallback(
         base::BindRepeating(&ProcessCache::SendPolledMetrics,
                             weak_ptr_factory_.GetWeakPtr()));
+    // Piggyback on the flush timer to periodically save the image hashes.
+    MetricsSender::GetInstance().RegisterMetricOnFlushCallback(
+        base::BindRepeating(&ProcessCache::SaveImageCache,
+                            weak_ptr_factory_.GetWeakPtr()));
     started_reporting_cache_fullness = true;
   }
 
@@ -370,7 +389,8 @@ void ProcessCache::PutFromBpfExec(
       process_start.task_info.ppid};
   InternalImageKeyType image_key{
       process_start.image_info.inode_device_id, process_start.image_info.inode,
-      process_start.image_info.mtime, process_start.image_info.ctime};
+      process_start.image_info.mtime, process_start.image_info.ctime,
+      process_start.image_info.size};
   {
     base::AutoLock cache_lock(image_cache_lock_);
     auto it =
@@ -382,51 +402,63 @@ void ProcessCache::PutFromBpfExec(
   }
   // Execs from eBPF are always new processes.
   process_proto->set_meta_first_appearance(true);
-  if (earliest_seen_exec_rel_s_ > process_proto->rel_start_time_s()) {
-    earliest_seen_exec_rel_s_ = process_proto->rel_start_time_s();
-    LOG(INFO) << "Set first seen process exec time to "
-              << earliest_seen_exec_rel_s_;
+  int64_t earliest = earliest_seen_exec_rel_s_.load();
+  while (earliest > process_proto->rel_start_time_s()) {
+    if (earliest_seen_exec_rel_s_.compare_exchange_weak(
+            earliest, process_proto->rel_start_time_s())) {
+      LOG(INFO) << "Set first seen process exec time to "
+                << process_proto->rel_start_time_s();
+      break;
+    }
   }
 
-  base::AutoLock lock(process_cache_lock_);
-  process_cache_->Put(
+  ProcessCacheShard& shard = GetProcessCacheShard(key.pid);
+  base::AutoLock lock(shard.lock);
+  shard.cache->Put(
       key, InternalProcessValueType({std::move(process_proto), parent_key}));
 }
 
 void ProcessCache::EraseProcess(uint64_t pid, bpf::time_ns_t start_time_ns) {
   InternalProcessKeyType key{LossyNsecToClockT(start_time_ns), pid};
-  base::AutoLock lock(process_cache_lock_);
-  auto it = process_cache_->Peek(key);
-  if (it != process_cache_->end()) {
-    process_cache_->Erase(it);
+  ProcessCacheShard& shard = GetProcessCacheShard(pid);
+  base::AutoLock lock(shard.lock);
+  auto it = shard.cache->Peek(key);
+  if (it != shard.cache->end()) {
+    shard.cache->Erase(it);
   }
 }
 
+ProcessCache::ProcessCacheShard& ProcessCache::GetProcessCacheShard(
+    uint64_t pid) {
+  return process_cache_shards_[pid % kNumProcessCacheShards];
+}
+
 std::pair<ProcessCache::InternalProcessCacheType::iterator, metrics::Cache>
-ProcessCache::InclusiveGetProcess(const InternalProcessKeyType& key) {
-  process_cache_lock_.AssertAcquired();
+ProcessCache::InclusiveGetProcess(ProcessCacheShard& shard,
+                                  const InternalProcessKeyType& key) {
+  shard.lock.AssertAcquired();
   // PID 0 doesn't exist and is also used to signify the end of the process
   // "linked list".
   if (key.pid == 0) {
     // Metric will not be logged.
-    return std::make_pair(process_cache_->end(), metrics::Cache(-1));
+    return std::make_pair(shard.cache->end(), metrics::Cache(-1));
   }
-  auto it = process_cache_->Get(key);
-  if (it != process_cache_->end()) {
+  auto it = shard.cache->Get(key);
+  if (it != shard.cache->end()) {
     return std::make_pair(it, metrics::Cache::kCacheHit);
   }
 
   absl::StatusOr<InternalProcessValueType> statusor;
   {
-    base::AutoUnlock unlock(process_cache_lock_);
+    base::AutoUnlock unlock(shard.lock);
     statusor = MakeFromProcfs(key);
     if (!statusor.ok()) {
       LOG(ERROR) << statusor.status();
-      return std::make_pair(process_cache_->end(), metrics::Cache::kCacheMiss);
+      return std::make_pair(shard.cache->end(), metrics::Cache::kCacheMiss);
     }
   }
 
-  it = process_cache_->Put(key, std::move(*statusor));
+  it = shard.cache->Put(key, std::move(*statusor));
   return std::make_pair(it, metrics::Cache::kProcfsFilled);
 }
 
@@ -479,6 +511,7 @@ ProcessCache::InclusiveGetImage(const InternalImageKeyType& image_key,
   }
 
   it = image_cache_->Put(image_key, std::move(*statusorhash));
+  image_cache_dirty_ = true;
   return it;
 }
 
@@ -486,15 +519,18 @@ std::vector<std::unique_ptr<pb::Process>> ProcessCache::GetProcessHierarchy(
     uint64_t pid, bpf::time_ns_t start_time_ns, int num_generations) {
   std::vector<std::unique_ptr<pb::Process>> processes;
   InternalProcessKeyType lookup_key{LossyNsecToClockT(start_time_ns), pid};
-  base::AutoLock lock(process_cache_lock_);
   for (int i = 0; i < num_generations; ++i) {
-    auto pair = InclusiveGetProcess(lookup_key);
+    // Ancestors are usually in other shards so only hold the lock of the
+    // shard of the process being looked up.
+    ProcessCacheShard& shard = GetProcessCacheShard(lookup_key.pid);
+    base::AutoLock lock(shard.lock);
+    auto pair = InclusiveGetProcess(shard, lookup_key);
     auto it = pair.first;
     if (lookup_key.pid != 0) {
       MetricsSender::GetInstance().IncrementBatchedMetric(metrics::kCache,
                                                           pair.second);
     }
-    if (it != process_cache_->end()) {
+    if (it != shard.cache->end()) {
       auto process_proto = std::make_unique<pb::Process>();
       process_proto->CopyFrom(*it->second.process_proto);
       processes.push_back(std::move(process_proto));
@@ -632,10 +668,71 @@ bool ProcessCache::IsEventFiltered(
 }
 
 void ProcessCache::SendPolledMetrics() {
+  InternalProcessCacheType::size_type size = 0;
+  InternalProcessCacheType::size_type max_size = 0;
+  for (auto& shard : process_cache_shards_) {
+    base::AutoLock lock(shard.lock);
+    size += shard.cache->size();
+    max_size += shard.cache->max_size();
+  }
   MetricsSender::GetInstance().SendPercentageMetricToUMA(
       metrics::kCacheFullness,
-      trunc(100 * (static_cast<double>(process_cache_->size()) /
-                   static_cast<double>(process_cache_->max_size()))));
+      trunc(100 * (static_cast<double>(size) / static_cast<double>(max_size))));
+}
+
+void ProcessCache::LoadImageCache() {
+  std::string contents;
+  if (!base::ReadFileToString(image_cache_path_, &contents)) {
+    return;
+  }
+  base::AutoLock lock(image_cache_lock_);
+  for (const auto& line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    InternalImageKeyType key;
+    if (fields.size() != kImageCacheFields ||
+        !base::StringToUint64(fields[0], &key.inode_device_id) ||
+        !base::StringToUint64(fields[1], &key.inode) ||
+        !base::StringToInt64(fields[2], &key.mtime.tv_sec) ||
+        !base::StringToInt64(fields[3], &key.mtime.tv_nsec) ||
+        !base::StringToInt64(fields[4], &key.ctime.tv_sec) ||
+        !base::StringToInt64(fields[5], &key.ctime.tv_nsec) ||
+        !base::StringToUint64(fields[6], &key.size) ||
+        fields[7].size() != 2 * SHA256_DIGEST_LENGTH) {
+      LOG(WARNING) << "Ignoring malformed image cache " << image_cache_path_;
+      image_cache_->Clear();
+      return;
+    }
+    image_cache_->Put(key,
+                      InternalImageValueType{.sha256 = std::string(fields[7])});
+  }
+}
+
+void ProcessCache::SaveImageCache() {
+  std::string contents;
+  {
+    base::AutoLock lock(image_cache_lock_);
+    if (!image_cache_dirty_) {
+      return;
+    }
+    // Least recently used first so that loading the file restores the order.
+    for (auto it = image_cache_->rbegin(); it != image_cache_->rend(); ++it) {
+      const InternalImageKeyType& key = it->first;
+      base::StringAppendF(
+          &contents,
+          "%" PRIu64 " %" PRIu64 " %" PRId64 " %" PRId64 " %" PRId64
+          " %" PRId64 " %" PRIu64 " %s\n",
+          key.inode_device_id, key.inode, key.mtime.tv_sec, key.mtime.tv_nsec,
+          key.ctime.tv_sec, key.ctime.tv_nsec, key.size,
+          it->second.sha256.c_str());
+    }
+    image_cache_dirty_ = false;
+  }
+  if (!base::ImportantFileWriter::WriteFileAtomically(image_cache_path_,
+                                                      contents)) {
+    LOG(WARNING) << "Failed to save the image cache to " << image_cache_path_;
+  }
 }
 
 void ProcessCache::InitializeFilter(bool underscorify) {
@@ -687,6 +784,18 @@ void ProcessCache::InitializeFilter(bool underscorify) {
         continue;
       }
 
+      // Rules matching the image alone can also be applied in the kernel,
+      // which identifies the image by its inode.
+      if (&v.first == &filter_rules_process_ && k.commandline.empty()) {
+        struct stat stat_buf;
+        if (stat(k.image_pathname.c_str(), &stat_buf) == 0) {
+          kernel_filtered_images_.push_back(
+              {.inode_device_id = stat_buf.st_dev, .inode = stat_buf.st_ino});
+        } else {
+          PLOG(WARNING) << "Failed to stat " << k.image_pathname;
+        }
+      }
+
       v.first.emplace(std::make_pair(result.value(), std::move(k)));
     }
   }
@@ -712,6 +821,11 @@ void ProcessCache::InitializeFilter(bool underscorify) {
   }
 }
 
+std::vector<bpf::cros_image_key> ProcessCache::GetImagesFilteredInKernel()
+    const {
+  return kernel_filtered_images_;
+}
+
 absl::StatusOr<base::FilePath> ProcessCache::GetPathInCurrentMountNs(
     uint64_t pid_for_setns, const base::FilePath& image_path_in_pids_ns) const {
   const base::FilePath pid_mnt_root =
@@ -758,7 +872,8 @@ absl::Status ProcessCache::FillImageFromProcfs(
       exe_stat.st_dev,
       exe_stat.st_ino,
       {exe_stat.st_mtim.tv_sec, exe_stat.st_mtim.tv_nsec},
-      {exe_stat.st_ctim.tv_sec, exe_stat.st_ctim.tv_nsec}};
+      {exe_stat.st_ctim.tv_sec, exe_stat.st_ctim.tv_nsec},
+      static_cast<uint64_t>(exe_stat.st_size)};
   {
     base::AutoLock lock(image_cache_lock_);
     auto it = InclusiveGetImage(image_key, pid_for_setns, exe_path);
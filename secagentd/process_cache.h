@@ -5,6 +5,8 @@
 #ifndef SECAGENTD_PROCESS_CACHE_H_
 #define SECAGENTD_PROCESS_CACHE_H_
 
+#include <array>
+#include <atomic>
 #include <list>
 #include <memory>
 #include <string>
@@ -55,8 +57,17 @@ class ProcessCacheInterface
   // in the unit test uses underscores for subdirectories rather than creating
   // real ones.
   virtual void InitializeFilter(bool underscorify = false) = 0;
+
+  // Returns the executables set up by InitializeFilter() whose process events
+  // can be dropped by the BPF, before they reach the ring buffer.
+  virtual std::vector<bpf::cros_image_key> GetImagesFilteredInKernel()
+      const = 0;
 };
 
+// Caches the processes seen by the BPF or scraped from procfs, and the SHA256
+// of their images. Process lookups can be done concurrently from any thread.
+// The image hashes are saved under /var/lib/secagentd so that a restarted
+// daemon doesn't hash the same images again.
 class ProcessCache : public ProcessCacheInterface {
  public:
   struct InternalProcessKeyType {
@@ -78,11 +89,13 @@ class ProcessCache : public ProcessCacheInterface {
     uint64_t inode;
     bpf::cros_timespec mtime;
     bpf::cros_timespec ctime;
+    uint64_t size;
     bool operator<(const InternalImageKeyType& rhs) const {
       return std::tie(inode_device_id, inode, mtime.tv_sec, mtime.tv_nsec,
-                      ctime.tv_sec, ctime.tv_nsec) <
+                      ctime.tv_sec, ctime.tv_nsec, size) <
              std::tie(rhs.inode_device_id, rhs.inode, rhs.mtime.tv_sec,
-                      rhs.mtime.tv_nsec, rhs.ctime.tv_sec, rhs.ctime.tv_nsec);
+                      rhs.mtime.tv_nsec, rhs.ctime.tv_sec, rhs.ctime.tv_nsec,
+                      rhs.size);
     }
   };
   struct InternalImageValueType {
@@ -100,6 +113,10 @@ class ProcessCache : public ProcessCacheInterface {
   using InternalFilterRuleSetType =
       absl::flat_hash_map<std::string, InternalFilterRule>;
 
+  // The process cache is split in shards, chosen by pid, each with its own
+  // lock so that lookups from different threads rarely contend.
+  static constexpr size_t kNumProcessCacheShards = 8;
+
   // Converts ns (from BPF) to clock_t for use in InternalProcessKeyType. It
   // would be ideal to do this conversion in the BPF but we lack the required
   // kernel constants there.
@@ -130,6 +147,7 @@ class ProcessCache : public ProcessCacheInterface {
   bool IsEventFiltered(const cros_xdr::reporting::Process* parent_process,
                        const cros_xdr::reporting::Process* process) override;
   void InitializeFilter(bool underscorify = false) override;
+  std::vector<bpf::cros_image_key> GetImagesFilteredInKernel() const override;
   // Allow calling the private test-only constructor without befriending
   // scoped_refptr.
   template <typename... Args>
@@ -144,15 +162,21 @@ class ProcessCache : public ProcessCacheInterface {
 
  private:
   friend class testing::ProcessCacheTestFixture;
+  struct ProcessCacheShard {
+    base::Lock lock;
+    std::unique_ptr<InternalProcessCacheType> cache;
+  };
+
   // Internal constructor used for testing.
   explicit ProcessCache(const base::FilePath& root_path,
                         scoped_refptr<DeviceUserInterface> device_user);
   // Like LRUCache::Get, returns an internal iterator to the given key. Unlike
   // LRUCache::Get, best-effort tries to fetch missing keys from procfs. Then
-  // inclusively Puts them in process_cache_ if successful and returns an
-  // iterator.
+  // inclusively Puts them in the shard if successful and returns an iterator.
+  // The lock of the shard must be held.
   std::pair<ProcessCache::InternalProcessCacheType::iterator, metrics::Cache>
-  InclusiveGetProcess(const InternalProcessKeyType& key);
+  InclusiveGetProcess(ProcessCacheShard& shard,
+                      const InternalProcessKeyType& key);
   absl::StatusOr<InternalProcessValueType> MakeFromProcfs(
       const InternalProcessKeyType& key);
   // Similar to InclusiveGetProcess but operates on image_cache_.
@@ -173,17 +197,29 @@ class ProcessCache : public ProcessCacheInterface {
       const base::FilePath& image_path_in_pids_ns) const;
   // Sends what percentage of process cache is full.
   void SendPolledMetrics();
+  // Loads the image hashes saved by a previous instance of the daemon so that
+  // the images it already hashed aren't read again.
+  void LoadImageCache();
+  // Saves the image hashes if any was added since the last save.
+  void SaveImageCache();
+  // Returns the shard caching the processes of the given pid.
+  ProcessCacheShard& GetProcessCacheShard(uint64_t pid);
 
   base::WeakPtrFactory<ProcessCache> weak_ptr_factory_;
-  base::Lock process_cache_lock_;
-  std::unique_ptr<InternalProcessCacheType> process_cache_;
+  std::array<ProcessCacheShard, kNumProcessCacheShards> process_cache_shards_;
   base::Lock image_cache_lock_;
   std::unique_ptr<InternalImageCacheType> image_cache_;
+  // Whether image_cache_ has entries that aren't saved to image_cache_path_
+  // yet. Guarded by image_cache_lock_.
+  bool image_cache_dirty_ = false;
+  const base::FilePath image_cache_path_;
   scoped_refptr<DeviceUserInterface> device_user_;
   const base::FilePath root_path_;
   InternalFilterRuleSetType filter_rules_parent_;
   InternalFilterRuleSetType filter_rules_process_;
-  int64_t earliest_seen_exec_rel_s_;
+  // Images of the process rules without commandline.
+  std::vector<bpf::cros_image_key> kernel_filtered_images_;
+  std::atomic<int64_t> earliest_seen_exec_rel_s_;
 };
 
 }  // namespace secagentd
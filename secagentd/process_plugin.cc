@@ -159,6 +159,13 @@ absl::Status ProcessPlugin::Activate() {
   if (skeleton_wrapper_ == nullptr) {
     return absl::InternalError("Process BPF program loading error.");
   }
+  // Dropping the noisiest events in the kernel keeps them from filling the
+  // ring buffer. They are filtered in userspace anyway if this fails.
+  absl::Status status = skeleton_wrapper_->FilterProcessImages(
+      process_cache_->GetImagesFilteredInKernel());
+  if (!status.ok()) {
+    LOG(WARNING) << status.message();
+  }
   batch_sender_->Start();
   return absl::OkStatus();
 }
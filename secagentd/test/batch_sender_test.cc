@@ -4,6 +4,8 @@
 
 #include "secagentd/batch_sender.h"
 
+#include <optional>
+
 #include "base/functional/bind.h"
 #include "base/functional/callback_forward.h"
 #include "base/memory/scoped_refptr.h"
@@ -211,6 +213,59 @@ TEST_F(BatchSenderTestFixture, TestBatchingSizeLimit) {
   EXPECT_EQ(sent_events, sent_ids.size());
 }
 
+TEST_F(BatchSenderTestFixture, TestLowRateFlushesSooner) {
+  int sent_messages = 0;
+  EXPECT_CALL(*message_sender_,
+              SendMessage(Eq(BatchSenderTestFixture::kDestination), _, _, _))
+      .WillRepeatedly([&sent_messages](auto d, auto c, auto m, auto cb) {
+        sent_messages++;
+      });
+
+  auto process_event_1 = std::make_unique<BatchSenderTestFixture::AVM>();
+  process_event_1->CopyFrom(expected_process_exec_1_);
+  batch_sender_->Enqueue(std::move(process_event_1));
+  task_environment_.FastForwardBy(base::Seconds(kBatchInterval));
+  EXPECT_EQ(1, sent_messages);
+
+  // A single event per interval isn't worth batching so the next one is sent
+  // without waiting for the whole interval.
+  auto process_event_2 = std::make_unique<BatchSenderTestFixture::AVM>();
+  process_event_2->CopyFrom(expected_process_exec_2_);
+  batch_sender_->Enqueue(std::move(process_event_2));
+  task_environment_.FastForwardBy(BatchSenderType::kMinBatchInterval);
+  EXPECT_EQ(2, sent_messages);
+}
+
+TEST_F(BatchSenderTestFixture, TestSlowEnqueueDelaysFlush) {
+  int sent_messages = 0;
+  std::optional<reporting::ReportQueue::EnqueueCallback> enqueue_cb;
+  EXPECT_CALL(*message_sender_,
+              SendMessage(Eq(BatchSenderTestFixture::kDestination), _, _, _))
+      .WillRepeatedly([&sent_messages, &enqueue_cb](auto d, auto c, auto m,
+                                                    auto cb) {
+        sent_messages++;
+        enqueue_cb = std::move(cb);
+      });
+
+  auto process_event_1 = std::make_unique<BatchSenderTestFixture::AVM>();
+  process_event_1->CopyFrom(expected_process_exec_1_);
+  batch_sender_->Enqueue(std::move(process_event_1));
+  task_environment_.FastForwardBy(base::Seconds(kBatchInterval));
+  ASSERT_EQ(1, sent_messages);
+  // Missive takes a while to enqueue the batch.
+  task_environment_.FastForwardBy(base::Seconds(1));
+  ASSERT_TRUE(enqueue_cb.has_value());
+  std::move(enqueue_cb.value()).Run(reporting::Status::StatusOK());
+
+  auto process_event_2 = std::make_unique<BatchSenderTestFixture::AVM>();
+  process_event_2->CopyFrom(expected_process_exec_2_);
+  batch_sender_->Enqueue(std::move(process_event_2));
+  task_environment_.FastForwardBy(BatchSenderType::kMinBatchInterval);
+  EXPECT_EQ(1, sent_messages);
+  task_environment_.FastForwardBy(base::Seconds(kBatchInterval));
+  EXPECT_EQ(2, sent_messages);
+}
+
 TEST_F(BatchSenderTestFixture, TestVisit) {
   auto process_event_1 = std::make_unique<BatchSenderTestFixture::AVM>();
   process_event_1->CopyFrom(expected_process_exec_1_);
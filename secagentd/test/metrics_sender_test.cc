@@ -66,6 +66,19 @@ TEST_F(MetricsSenderTestFixture, SendEnumMetricToUMA) {
       metrics_sender_->SendEnumMetricToUMA(kTestMetric, TestEnum::kOne));
 }
 
+TEST_F(MetricsSenderTestFixture, SendRepeatedEnumMetricToUMA) {
+  EXPECT_CALL(
+      *metrics_library_mock_,
+      SendRepeatedEnumToUMA(
+          "ChromeOS.Secagentd.Bpf.Process.DroppedEvents",
+          static_cast<int>(metrics::BpfEventDrop::kRingBufferFull),
+          static_cast<int>(metrics::BpfEventDrop::kMaxValue) + 1, 42))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(metrics_sender_->SendRepeatedEnumMetricToUMA(
+      metrics::kProcessBpfEventDrop, metrics::BpfEventDrop::kRingBufferFull,
+      42));
+}
+
 TEST_F(MetricsSenderTestFixture, CheckExclusiveMaxMap) {
   EXPECT_EQ(17, GetMaxMapValue("SendMessageResult"));
   EXPECT_EQ(3, GetMaxMapValue("Cache"));
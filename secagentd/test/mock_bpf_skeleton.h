@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "secagentd/bpf_skeleton_wrappers.h"
@@ -30,6 +31,10 @@ class MockBpfSkeleton : public BpfSkeletonInterface {
               (override));
   MOCK_METHOD(void, RegisterCallbacks, (BpfCallbacks cbs), (override));
   MOCK_METHOD(int, ConsumeEvent, (), (override));
+  MOCK_METHOD(absl::Status,
+              FilterProcessImages,
+              (const std::vector<bpf::cros_image_key>& images),
+              (override));
 };
 
 class MockSkeletonFactory : public BpfSkeletonFactoryInterface {
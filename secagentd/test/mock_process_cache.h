@@ -35,6 +35,10 @@ class MockProcessCache : public ProcessCacheInterface {
               (override));
 
   MOCK_METHOD(void, InitializeFilter, (bool underscorify), (override));
+  MOCK_METHOD(std::vector<bpf::cros_image_key>,
+              GetImagesFilteredInKernel,
+              (),
+              (const, override));
 };
 
 }  // namespace secagentd::testing
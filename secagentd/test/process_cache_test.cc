@@ -17,6 +17,7 @@
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/synchronization/lock.h"
 #include "base/test/task_environment.h"
 #include "brillo/files/file_util.h"
 #include "gmock/gmock.h"
@@ -155,9 +156,17 @@ class ProcessCacheTestFixture : public ::testing::Test {
     image_info->mtime.tv_nsec = stat.st_mtim.tv_nsec;
     image_info->ctime.tv_sec = stat.st_ctim.tv_sec;
     image_info->ctime.tv_nsec = stat.st_ctim.tv_nsec;
+    image_info->size = stat.st_size;
   }
 
-  void ClearInternalCache() { process_cache_->process_cache_->Clear(); }
+  void ClearInternalCache() {
+    for (auto& shard : process_cache_->process_cache_shards_) {
+      base::AutoLock lock(shard.lock);
+      shard.cache->Clear();
+    }
+  }
+
+  void SaveImageCache() { process_cache_->SaveImageCache(); }
 
   void SetUp() override {
     device_user_ = base::MakeRefCounted<MockDeviceUser>();
@@ -817,6 +826,22 @@ TEST_F(ProcessCacheTestFixture, SpacedCliTerminateEventsAreFiltered) {
       process_cache_->IsEventFiltered(hierarchy[1].get(), hierarchy[0].get()));
 }
 
+TEST_F(ProcessCacheTestFixture, SpacedCliIsFilteredInKernel) {
+  process_cache_->InitializeFilter(true);
+  const bpf::cros_image_info& image_info =
+      mock_spawns_[kPidChildOfChild].process_start.image_info;
+  auto images = process_cache_->GetImagesFilteredInKernel();
+  EXPECT_TRUE(std::any_of(images.begin(), images.end(),
+                          [&image_info](const bpf::cros_image_key& image) {
+                            // The image info truncates both to 32 bits.
+                            return static_cast<uint32_t>(
+                                       image.inode_device_id) ==
+                                       image_info.inode_device_id &&
+                                   static_cast<uint32_t>(image.inode) ==
+                                       image_info.inode;
+                          }));
+}
+
 TEST_F(ProcessCacheTestFixture, NotEverythingIsFiltered) {
   process_cache_->InitializeFilter(true);
   // this is cryptohom
@@ -998,6 +1023,29 @@ TEST_F(ProcessCacheTestFixture, ImageCacheMissThenHit) {
                    after[0]->image().sha256().c_str());
 }
 
+TEST_F(ProcessCacheTestFixture, ImageCacheSavedAcrossRestarts) {
+  const bpf::cros_process_start& process_start =
+      mock_spawns_[kPidChildOfChild].process_start;
+  ASSERT_TRUE(base::CreateDirectory(
+      fake_root_.GetPath().Append("var/lib/secagentd")));
+  process_cache_->PutFromBpfExec(process_start);
+  SaveImageCache();
+
+  // The deleted image can only be "hashed" from the cache loaded by the new
+  // instance.
+  ASSERT_TRUE(brillo::DeleteFile(GetPathInCurrentMountNsOrDie(
+      process_start.image_info.pid_for_setns,
+      base::FilePath(process_start.image_info.pathname))));
+  process_cache_ =
+      ProcessCache::CreateForTesting(fake_root_.GetPath(), device_user_);
+  process_cache_->PutFromBpfExec(process_start);
+  auto actual = process_cache_->GetProcessHierarchy(
+      process_start.task_info.pid, process_start.task_info.start_time, 1);
+  ASSERT_EQ(1, actual.size());
+  EXPECT_STRCASEEQ(mock_spawns_[kPidChildOfChild].exe_sha256.c_str(),
+                   actual[0]->image().sha256().c_str());
+}
+
 TEST_F(ProcessCacheTestFixture, ImageCacheMissDueToModification) {
   const bpf::cros_process_start& process_start =
       mock_spawns_[kPidChildOfChild].process_start;
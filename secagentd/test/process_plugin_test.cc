@@ -4,6 +4,7 @@
 
 #include <iterator>
 #include <memory>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
@@ -39,6 +40,7 @@ using ::testing::Eq;
 using ::testing::Ref;
 using ::testing::Return;
 using ::testing::SaveArg;
+using ::testing::SizeIs;
 using ::testing::StrictMock;
 
 constexpr char kDeviceUser[] = "deviceUser@email.com";
@@ -86,6 +88,10 @@ class ProcessPluginTestFixture : public ::testing::Test {
     EXPECT_CALL(*skel_factory_, Create(Types::BpfSkeleton::kProcess, _, _))
         .WillOnce(
             DoAll(SaveArg<1>(&cbs_), Return(ByMove(std::move(bpf_skeleton_)))));
+    EXPECT_CALL(*process_cache_, GetImagesFilteredInKernel())
+        .WillOnce(Return(std::vector<bpf::cros_image_key>{{1, 2}}));
+    EXPECT_CALL(*bpf_skeleton_ref_, FilterProcessImages(SizeIs(1)))
+        .WillOnce(Return(absl::OkStatus()));
     EXPECT_CALL(*batch_sender_, Start());
     EXPECT_OK(plugin_->Activate());
 
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include <absl/strings/match.h>
 #include <base/command_line.h>
@@ -208,12 +209,15 @@ int Daemon::OnEventLoopStarted() {
 }
 
 void Daemon::ScanForAnomalies() {
+  const base::TimeTicks scan_start = base::TimeTicks::Now();
   VLOG(1) << "Scanning for W+X mounts";
   DoWXMountScan();
   VLOG(1) << "Scanning system processes";
   DoProcScan();
   VLOG(1) << "Scanning for audit log anomalies";
   DoAuditLogScan();
+  last_scan_duration_ = base::TimeTicks::Now() - scan_start;
+  VLOG(1) << "Scan took " << last_scan_duration_;
 
   if (generate_reports_) {
     DoAnomalousSystemReporting();
@@ -234,6 +238,7 @@ void Daemon::ReportUmaMetrics() {
   EmitForbiddenIntersectionProcCountUma();
   EmitMemfdExecProcCountUma();
   EmitSandboxingUma();
+  EmitScanDurationUma();
 
   brillo::MessageLoop::current()->PostDelayedTask(
       FROM_HERE,
@@ -242,7 +247,19 @@ void Daemon::ReportUmaMetrics() {
 }
 
 void Daemon::DoWXMountScan() {
-  all_mounts_ = ReadMounts();
+  std::string proc_mounts;
+  if (!ReadProcSelfMounts(&proc_mounts)) {
+    all_mounts_.reset();
+    proc_mounts_.clear();
+    return;
+  }
+  // Only re-parse the mount table when it changed since the last scan. The
+  // checks below still run on every entry since their outcome also depends on
+  // the system context.
+  if (!all_mounts_ || proc_mounts != proc_mounts_) {
+    all_mounts_ = ReadMountsFromString(proc_mounts);
+    proc_mounts_ = std::move(proc_mounts);
+  }
   if (!all_mounts_) {
     LOG(ERROR) << "Failed to read mounts";
     return;
@@ -525,4 +542,14 @@ void Daemon::EmitSandboxingUma() {
   }
 }
 
+void Daemon::EmitScanDurationUma() {
+  if (last_scan_duration_.is_zero()) {
+    return;
+  }
+  VLOG(1) << "Reporting scan duration UMA metric";
+  if (!SendScanDurationToUMA(last_scan_duration_)) {
+    LOG(WARNING) << "Could not upload scan duration UMA metric";
+  }
+}
+
 }  // namespace secanomalyd
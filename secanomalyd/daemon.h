@@ -7,8 +7,10 @@
 
 #include <memory>
 #include <set>
+#include <string>
 
 #include <base/files/file_path.h>
+#include <base/time/time.h>
 
 #include <brillo/daemons/dbus_daemon.h>
 
@@ -56,6 +58,7 @@ class Daemon : public brillo::DBusDaemon {
   void EmitForbiddenIntersectionProcCountUma();
   void EmitMemfdExecProcCountUma();
   void EmitSandboxingUma();
+  void EmitScanDurationUma();
 
   // Used to keep track of whether this daemon has attempted to send a crash
   // report for a W+X mount observation throughout its lifetime.
@@ -91,12 +94,20 @@ class Daemon : public brillo::DBusDaemon {
 
   MountEntryMap wx_mounts_;
   MaybeMountEntries all_mounts_;
+  // Unparsed /proc/self/mounts that |all_mounts_| was parsed from. The mount
+  // table only changes when something is mounted or unmounted, so most scans
+  // can reuse the parsed entries.
+  std::string proc_mounts_;
   MaybeProcEntries forbidden_intersection_procs_;
   MaybeProcEntries all_procs_;
   MaybeProcEntry init_proc_;
 
   std::set<base::FilePath> executables_attempting_memfd_exec_;
 
+  // Duration of the last |ScanForAnomalies()| pass, reported with the other
+  // UMA metrics.
+  base::TimeDelta last_scan_duration_;
+
   // Used for reading and parsing the audit log file.
   std::unique_ptr<AuditLogReader> audit_log_reader_;
 };
@@ -60,6 +60,13 @@ constexpr char kNonInitNsProcPercentageHistogramName[] =
 constexpr char kAnomalyUploadSuccess[] =
     "ChromeOS.SecurityAnomalyUploadSuccess";
 
+// Time taken by one pass of the mount, process and audit log scans.
+constexpr char kScanDurationHistogramName[] =
+    "ChromeOS.SecurityAnomalyScanDuration";
+constexpr base::TimeDelta kScanDurationHistogramMin = base::Milliseconds(1);
+constexpr base::TimeDelta kScanDurationHistogramMax = base::Seconds(10);
+constexpr int kScanDurationHistogramNumBuckets = 50;
+
 MetricsLibraryInterface* metrics_library = nullptr;
 
 void InitializeMetricsIfNecessary() {
@@ -140,3 +147,10 @@ bool SendAnomalyUploadResultToUMA(bool success) {
   InitializeMetricsIfNecessary();
   return metrics_library->SendBoolToUMA(kAnomalyUploadSuccess, success);
 }
+
+bool SendScanDurationToUMA(base::TimeDelta scan_duration) {
+  InitializeMetricsIfNecessary();
+  return metrics_library->SendTimeToUMA(
+      kScanDurationHistogramName, scan_duration, kScanDurationHistogramMin,
+      kScanDurationHistogramMax, kScanDurationHistogramNumBuckets);
+}
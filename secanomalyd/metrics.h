@@ -7,6 +7,8 @@
 
 #include <cstddef>
 
+#include <base/time/time.h>
+
 // These values are persisted to logs. Entries should not be renumbered and
 // numeric values should never be reused.
 enum class SecurityAnomaly {
@@ -40,4 +42,6 @@ bool SendNonInitNsProcPercentageToUMA(unsigned int proc_percentage);
 
 bool SendAnomalyUploadResultToUMA(bool success);
 
+bool SendScanDurationToUMA(base::TimeDelta scan_duration);
+
 #endif  // SECANOMALYD_METRICS_H_
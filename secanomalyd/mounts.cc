@@ -21,15 +21,22 @@ constexpr char kProcSelfMountsPath[] = "/proc/self/mounts";
 
 MaybeMountEntries ReadMounts() {
   std::string proc_mounts;
-  if (!base::ReadFileToStringNonBlocking(base::FilePath(kProcSelfMountsPath),
-                                         &proc_mounts)) {
-    PLOG(ERROR) << "Failed to read " << kProcSelfMountsPath;
+  if (!ReadProcSelfMounts(&proc_mounts)) {
     return std::nullopt;
   }
 
   return ReadMountsFromString(proc_mounts);
 }
 
+bool ReadProcSelfMounts(std::string* proc_mounts) {
+  if (!base::ReadFileToStringNonBlocking(base::FilePath(kProcSelfMountsPath),
+                                         proc_mounts)) {
+    PLOG(ERROR) << "Failed to read " << kProcSelfMountsPath;
+    return false;
+  }
+  return true;
+}
+
 MaybeMountEntries ReadMountsFromString(const std::string& mounts) {
   std::vector<base::StringPiece> pieces = base::SplitStringPiece(
       mounts, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
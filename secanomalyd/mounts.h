@@ -17,6 +17,8 @@ using MountEntries = std::vector<MountEntry>;
 using MaybeMountEntries = std::optional<MountEntries>;
 
 MaybeMountEntries ReadMounts();
+// Reads the unparsed contents of /proc/self/mounts into |proc_mounts|.
+bool ReadProcSelfMounts(std::string* proc_mounts);
 // Used mostly for testing.
 MaybeMountEntries ReadMountsFromString(const std::string& mounts);
 
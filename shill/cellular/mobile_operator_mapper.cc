@@ -769,8 +769,7 @@ bool MobileOperatorMapper::FilterMatches(
   }
 
   if (filter.has_regex()) {
-    re2::RE2 filter_regex = {filter.regex()};
-    if (!RE2::FullMatch(to_match, filter_regex)) {
+    if (!RE2::FullMatch(to_match, GetFilterRegex(filter.regex()))) {
       SLOG(2) << GetLogPrefix(__func__) << "Skipping because string '"
               << to_match << "' is not a "
               << "match of regexp '" << filter.regex();
@@ -782,8 +781,7 @@ bool MobileOperatorMapper::FilterMatches(
   }
 
   if (filter.has_exclude_regex()) {
-    re2::RE2 filter_regex = {filter.exclude_regex()};
-    if (RE2::FullMatch(to_match, filter_regex)) {
+    if (RE2::FullMatch(to_match, GetFilterRegex(filter.exclude_regex()))) {
       SLOG(2) << GetLogPrefix(__func__) << "Skipping because string '"
               << to_match << "' is a "
               << "match of exclude_regex '" << filter.exclude_regex();
@@ -798,6 +796,15 @@ bool MobileOperatorMapper::FilterMatches(
   return true;
 }
 
+const re2::RE2& MobileOperatorMapper::GetFilterRegex(
+    const std::string& regex) const {
+  auto& filter_regex = filter_regexes_[regex];
+  if (!filter_regex) {
+    filter_regex = std::make_unique<re2::RE2>(regex);
+  }
+  return *filter_regex;
+}
+
 void MobileOperatorMapper::RefreshDBInformation() {
   ClearDBInformation();
 
@@ -22,6 +22,10 @@
 #include "shill/event_dispatcher.h"
 #include "shill/mobile_operator_db/mobile_operator_db.pb.h"
 
+namespace re2 {
+class RE2;
+}  // namespace re2
+
 namespace shill {
 
 using MobileOperatorMapperOnOperatorChangedCallback = base::RepeatingClosure;
@@ -246,6 +250,8 @@ class MobileOperatorMapper {
   bool UpdateMVNO();
   bool FilterMatches(const shill::mobile_operator_db::Filter& filter,
                      std::string to_match = "") const;
+  // Returns the compiled form of |regex|, compiling it on first use.
+  const re2::RE2& GetFilterRegex(const std::string& regex) const;
   const mobile_operator_db::MobileNetworkOperator* PickOneFromDuplicates(
       const std::vector<const mobile_operator_db::MobileNetworkOperator*>&
           duplicates) const;
@@ -307,6 +313,10 @@ class MobileOperatorMapper {
   std::vector<const mobile_operator_db::MobileOperatorDB*> databases_;
   StringToMNOListMap mccmnc_to_mnos_;
   StringToMNOListMap name_to_mnos_;
+  // Filter regular expressions compiled so far, keyed by their pattern. Every
+  // M[V]NO update evaluates the filters of all the MVNOs of the database, so
+  // they are not compiled again each time.
+  mutable std::map<std::string, std::unique_ptr<re2::RE2>> filter_regexes_;
 
   // |candidates_by_operator_code| can be determined using MCCMNC.
   enum class OperatorCodeType {
@@ -12,7 +12,9 @@
 #include <base/check.h>
 #include <base/functional/bind.h>
 #include <base/logging.h>
+#include <base/time/time.h>
 #include <brillo/message_loops/message_loop.h>
+#include <metrics/structured/recorder_singleton.h>
 
 #include "shill/control_interface.h"
 #include "shill/dbus/dbus_control.h"
@@ -36,6 +38,15 @@ namespace Logging {
 static auto kModuleLogScope = ScopeLogger::kDaemon;
 }  // namespace Logging
 
+namespace {
+
+// How long structured metrics events are kept in memory once recording is
+// idle. WiFi devices record them at a high rate, so they are written to disk in
+// batches.
+constexpr base::TimeDelta kStructuredMetricsFlushDelay = base::Seconds(10);
+
+}  // namespace
+
 DaemonTask::DaemonTask(const Settings& settings, Config* config)
     : settings_(settings),
       config_(config),
@@ -125,6 +136,8 @@ void DaemonTask::StopAndReturnToMain() {
 }
 
 void DaemonTask::Start() {
+  metrics::structured::RecorderSingleton::GetInstance()->EnableBatching(
+      kStructuredMetricsFlushDelay);
   rtnl_handler_->Start(RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV4_ROUTE |
                        RTMGRP_IPV6_IFADDR | RTMGRP_IPV6_ROUTE |
                        RTMGRP_ND_USEROPT);
@@ -157,6 +170,7 @@ void DaemonTask::Stop() {
   manager_ = nullptr;  // Release manager resources, including DBus adaptor.
   dhcp_provider_->Stop();
   process_manager_->Stop();
+  metrics::structured::RecorderSingleton::GetInstance()->GetRecorder()->Flush();
   metrics_ = nullptr;
   // Must retain |control_|, as the D-Bus library may
   // have some work left to do. See crbug.com/537771.
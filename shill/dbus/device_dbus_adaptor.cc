@@ -10,6 +10,7 @@
 #include "shill/error.h"
 #include "shill/logging.h"
 
+#include <base/functional/bind.h>
 #include <base/logging.h>
 
 namespace shill {
@@ -28,13 +29,19 @@ DeviceDBusAdaptor::DeviceDBusAdaptor(const scoped_refptr<dbus::Bus>& bus,
                                      Device* device)
     : org::chromium::flimflam::DeviceAdaptor(this),
       DBusAdaptor(bus, kPath + SanitizePathElement(device->UniqueName())),
-      device_(device) {
+      device_(device),
+      property_changes_(
+          base::BindRepeating(&DeviceDBusAdaptor::SendPropertyChangedSignal,
+                              base::Unretained(this)),
+          {}) {
   // Register DBus object.
   RegisterWithDBusObject(dbus_object());
   dbus_object()->RegisterAndBlock();
 }
 
 DeviceDBusAdaptor::~DeviceDBusAdaptor() {
+  // Do not drop the last changes of the object.
+  property_changes_.Flush();
   dbus_object()->UnregisterAndBlock();
   device_ = nullptr;
 }
@@ -45,48 +52,48 @@ const RpcIdentifier& DeviceDBusAdaptor::GetRpcIdentifier() const {
 
 void DeviceDBusAdaptor::EmitBoolChanged(const std::string& name, bool value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitUintChanged(const std::string& name,
                                         uint32_t value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitUint16Changed(const std::string& name,
                                           uint16_t value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitIntChanged(const std::string& name, int value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitStringChanged(const std::string& name,
                                           const std::string& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitStringmapChanged(const std::string& name,
                                              const Stringmap& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitStringmapsChanged(const std::string& name,
                                               const Stringmaps& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitStringsChanged(const std::string& name,
                                            const Strings& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitKeyValueStoreChanged(const std::string& name,
@@ -94,7 +101,7 @@ void DeviceDBusAdaptor::EmitKeyValueStoreChanged(const std::string& name,
   SLOG(this, 2) << __func__ << ": " << name;
   brillo::VariantDictionary dict =
       KeyValueStore::ConvertToVariantDictionary(value);
-  SendPropertyChangedSignal(name, brillo::Any(dict));
+  property_changes_.Queue(name, brillo::Any(dict));
 }
 
 void DeviceDBusAdaptor::EmitKeyValueStoresChanged(const std::string& name,
@@ -106,13 +113,13 @@ void DeviceDBusAdaptor::EmitKeyValueStoresChanged(const std::string& name,
         KeyValueStore::ConvertToVariantDictionary(element);
     dicts.push_back(dict);
   }
-  SendPropertyChangedSignal(name, brillo::Any(dicts));
+  property_changes_.Queue(name, brillo::Any(dicts));
 }
 
 void DeviceDBusAdaptor::EmitRpcIdentifierChanged(const std::string& name,
                                                  const RpcIdentifier& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void DeviceDBusAdaptor::EmitRpcIdentifierArrayChanged(
@@ -123,7 +130,7 @@ void DeviceDBusAdaptor::EmitRpcIdentifierArrayChanged(
     paths.push_back(dbus::ObjectPath(element));
   }
 
-  SendPropertyChangedSignal(name, brillo::Any(paths));
+  property_changes_.Queue(name, brillo::Any(paths));
 }
 
 bool DeviceDBusAdaptor::GetProperties(
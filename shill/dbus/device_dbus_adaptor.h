@@ -11,6 +11,7 @@
 #include "dbus_bindings/org.chromium.flimflam.Device.h"
 #include "shill/adaptor_interfaces.h"
 #include "shill/dbus/dbus_adaptor.h"
+#include "shill/dbus/property_change_coalescer.h"
 
 namespace shill {
 
@@ -87,6 +88,7 @@ class DeviceDBusAdaptor : public org::chromium::flimflam::DeviceAdaptor,
 
  private:
   Device* device_;
+  PropertyChangeCoalescer property_changes_;
 };
 
 }  // namespace shill
@@ -4,6 +4,7 @@
 
 #include "shill/dbus/ipconfig_dbus_adaptor.h"
 
+#include <base/functional/bind.h>
 #include <base/logging.h>
 #include <base/strings/stringprintf.h>
 
@@ -33,43 +34,49 @@ IPConfigDBusAdaptor::IPConfigDBusAdaptor(const scoped_refptr<dbus::Bus>& bus,
                              SanitizePathElement(config->device_name()).c_str(),
                              config->serial(),
                              config->type().c_str())),
-      ipconfig_(config) {
+      ipconfig_(config),
+      property_changes_(
+          base::BindRepeating(&IPConfigDBusAdaptor::SendPropertyChangedSignal,
+                              base::Unretained(this)),
+          {}) {
   // Register DBus object.
   RegisterWithDBusObject(dbus_object());
   dbus_object()->RegisterAndBlock();
 }
 
 IPConfigDBusAdaptor::~IPConfigDBusAdaptor() {
+  // Do not drop the last changes of the object.
+  property_changes_.Flush();
   dbus_object()->UnregisterAndBlock();
   ipconfig_ = nullptr;
 }
 
 void IPConfigDBusAdaptor::EmitBoolChanged(const std::string& name, bool value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void IPConfigDBusAdaptor::EmitUintChanged(const std::string& name,
                                           uint32_t value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void IPConfigDBusAdaptor::EmitIntChanged(const std::string& name, int value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void IPConfigDBusAdaptor::EmitStringChanged(const std::string& name,
                                             const std::string& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void IPConfigDBusAdaptor::EmitStringsChanged(
     const std::string& name, const std::vector<std::string>& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 bool IPConfigDBusAdaptor::GetProperties(brillo::ErrorPtr* error,
@@ -11,6 +11,7 @@
 #include "dbus_bindings/org.chromium.flimflam.IPConfig.h"
 #include "shill/adaptor_interfaces.h"
 #include "shill/dbus/dbus_adaptor.h"
+#include "shill/dbus/property_change_coalescer.h"
 
 namespace shill {
 
@@ -56,6 +57,7 @@ class IPConfigDBusAdaptor : public org::chromium::flimflam::IPConfigAdaptor,
 
  private:
   IPConfig* ipconfig_;
+  PropertyChangeCoalescer property_changes_;
 };
 
 }  // namespace shill
@@ -0,0 +1,60 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "shill/dbus/property_change_coalescer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <base/functional/bind.h>
+#include <base/location.h>
+#include <base/task/single_thread_task_runner.h>
+
+namespace shill {
+
+PropertyChangeCoalescer::PropertyChangeCoalescer(
+    SendCallback send, std::set<std::string> immediate_properties)
+    : send_(std::move(send)),
+      immediate_properties_(std::move(immediate_properties)) {}
+
+PropertyChangeCoalescer::~PropertyChangeCoalescer() = default;
+
+void PropertyChangeCoalescer::Queue(const std::string& name,
+                                    brillo::Any value) {
+  if (immediate_properties_.count(name) != 0) {
+    Flush();
+    send_.Run(name, value);
+    return;
+  }
+
+  // Objects only have a few dozens of properties, a linear search is cheaper
+  // than maintaining an index.
+  auto it = std::find_if(pending_.begin(), pending_.end(),
+                         [&name](const auto& change) {
+                           return change.first == name;
+                         });
+  if (it != pending_.end()) {
+    it->second = std::move(value);
+    return;
+  }
+
+  if (pending_.empty()) {
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&PropertyChangeCoalescer::Flush,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  pending_.emplace_back(name, std::move(value));
+}
+
+void PropertyChangeCoalescer::Flush() {
+  weak_factory_.InvalidateWeakPtrs();
+  // |send_| may cause other changes to be queued.
+  auto pending = std::move(pending_);
+  pending_.clear();
+  for (const auto& [name, value] : pending) {
+    send_.Run(name, value);
+  }
+}
+
+}  // namespace shill
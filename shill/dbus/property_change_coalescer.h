@@ -0,0 +1,58 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHILL_DBUS_PROPERTY_CHANGE_COALESCER_H_
+#define SHILL_DBUS_PROPERTY_CHANGE_COALESCER_H_
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <base/functional/callback.h>
+#include <base/memory/weak_ptr.h>
+#include <brillo/any.h>
+
+namespace shill {
+
+// Coalesces the PropertyChanged signals of a D-Bus object. Changes queued
+// during one turn of the message loop are sent at the next turn, once per
+// property with its latest value and in the order in which the properties first
+// changed. A single state change of a Device or a Service often updates the
+// same properties several times, and clients wake up for every signal.
+//
+// Changes of the properties in |immediate_properties| are not delayed, for the
+// clients that need to observe every value. Pending changes are sent first such
+// that the order of the changes of different properties is preserved.
+class PropertyChangeCoalescer {
+ public:
+  using SendCallback = base::RepeatingCallback<void(const std::string& name,
+                                                    const brillo::Any& value)>;
+
+  PropertyChangeCoalescer(SendCallback send,
+                          std::set<std::string> immediate_properties);
+  PropertyChangeCoalescer(const PropertyChangeCoalescer&) = delete;
+  PropertyChangeCoalescer& operator=(const PropertyChangeCoalescer&) = delete;
+
+  ~PropertyChangeCoalescer();
+
+  // Queues the change of property |name| to |value|.
+  void Queue(const std::string& name, brillo::Any value);
+
+  // Sends the pending changes right away.
+  void Flush();
+
+  size_t pending_count() const { return pending_.size(); }
+
+ private:
+  SendCallback send_;
+  const std::set<std::string> immediate_properties_;
+  std::vector<std::pair<std::string, brillo::Any>> pending_;
+
+  base::WeakPtrFactory<PropertyChangeCoalescer> weak_factory_{this};
+};
+
+}  // namespace shill
+
+#endif  // SHILL_DBUS_PROPERTY_CHANGE_COALESCER_H_
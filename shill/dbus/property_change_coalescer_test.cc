@@ -0,0 +1,95 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "shill/dbus/property_change_coalescer.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <base/functional/bind.h>
+#include <base/test/task_environment.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+using testing::Pair;
+
+namespace shill {
+
+class PropertyChangeCoalescerTest : public testing::Test {
+ protected:
+  void CreateCoalescer(std::set<std::string> immediate_properties) {
+    coalescer_ = std::make_unique<PropertyChangeCoalescer>(
+        base::BindRepeating(&PropertyChangeCoalescerTest::Send,
+                            base::Unretained(this)),
+        std::move(immediate_properties));
+  }
+
+  void Send(const std::string& name, const brillo::Any& value) {
+    sent_.emplace_back(name, value.Get<int>());
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  std::vector<std::pair<std::string, int>> sent_;
+  std::unique_ptr<PropertyChangeCoalescer> coalescer_;
+};
+
+TEST_F(PropertyChangeCoalescerTest, CoalesceWithinOneTurn) {
+  CreateCoalescer({});
+  coalescer_->Queue("A", brillo::Any(1));
+  coalescer_->Queue("B", brillo::Any(2));
+  coalescer_->Queue("A", brillo::Any(3));
+  EXPECT_THAT(sent_, IsEmpty());
+  EXPECT_EQ(2, coalescer_->pending_count());
+
+  task_environment_.RunUntilIdle();
+  EXPECT_THAT(sent_, ElementsAre(Pair("A", 3), Pair("B", 2)));
+  EXPECT_EQ(0, coalescer_->pending_count());
+
+  // Changes of the next turn are sent separately.
+  sent_.clear();
+  coalescer_->Queue("B", brillo::Any(4));
+  task_environment_.RunUntilIdle();
+  EXPECT_THAT(sent_, ElementsAre(Pair("B", 4)));
+}
+
+TEST_F(PropertyChangeCoalescerTest, ImmediateProperty) {
+  CreateCoalescer({"State"});
+  coalescer_->Queue("A", brillo::Any(1));
+  coalescer_->Queue("State", brillo::Any(2));
+  // The pending change is sent before the immediate one.
+  EXPECT_THAT(sent_, ElementsAre(Pair("A", 1), Pair("State", 2)));
+
+  coalescer_->Queue("State", brillo::Any(3));
+  EXPECT_THAT(sent_,
+              ElementsAre(Pair("A", 1), Pair("State", 2), Pair("State", 3)));
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(3, sent_.size());
+}
+
+TEST_F(PropertyChangeCoalescerTest, Flush) {
+  CreateCoalescer({});
+  coalescer_->Queue("A", brillo::Any(1));
+  coalescer_->Flush();
+  EXPECT_THAT(sent_, ElementsAre(Pair("A", 1)));
+
+  // The task posted by the first change does not send anything.
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, sent_.size());
+}
+
+TEST_F(PropertyChangeCoalescerTest, DestroyedWithPendingChanges) {
+  CreateCoalescer({});
+  coalescer_->Queue("A", brillo::Any(1));
+  coalescer_.reset();
+  task_environment_.RunUntilIdle();
+  EXPECT_THAT(sent_, IsEmpty());
+}
+
+}  // namespace shill
@@ -7,8 +7,10 @@
 #include <cstdint>
 #include <utility>
 
+#include <base/functional/bind.h>
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
+#include <chromeos/dbus/service_constants.h>
 
 #include "shill/error.h"
 #include "shill/logging.h"
@@ -34,79 +36,85 @@ ServiceDBusAdaptor::ServiceDBusAdaptor(const scoped_refptr<dbus::Bus>& bus,
                                        Service* service)
     : org::chromium::flimflam::ServiceAdaptor(this),
       DBusAdaptor(bus, kPath + service->GetDBusObjectPathIdentifier()),
-      service_(service) {
+      service_(service),
+      property_changes_(
+          base::BindRepeating(&ServiceDBusAdaptor::SendPropertyChangedSignal,
+                              base::Unretained(this)),
+          {kStateProperty}) {
   // Register DBus object.
   RegisterWithDBusObject(dbus_object());
   dbus_object()->RegisterAndBlock();
 }
 
 ServiceDBusAdaptor::~ServiceDBusAdaptor() {
+  // Do not drop the last changes of the object.
+  property_changes_.Flush();
   dbus_object()->UnregisterAndBlock();
   service_ = nullptr;
 }
 
 void ServiceDBusAdaptor::EmitBoolChanged(const std::string& name, bool value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitUint8Changed(const std::string& name,
                                           uint8_t value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitUint16Changed(const std::string& name,
                                            uint16_t value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitUint16sChanged(const std::string& name,
                                             const Uint16s& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitUintChanged(const std::string& name,
                                          uint32_t value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitUint64Changed(const std::string& name,
                                            uint64_t value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitIntChanged(const std::string& name, int value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitRpcIdentifierChanged(const std::string& name,
                                                   const RpcIdentifier& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitStringChanged(const std::string& name,
                                            const std::string& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitStringmapChanged(const std::string& name,
                                               const Stringmap& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 void ServiceDBusAdaptor::EmitStringmapsChanged(const std::string& name,
                                                const Stringmaps& value) {
   SLOG(this, 2) << __func__ << ": " << name;
-  SendPropertyChangedSignal(name, brillo::Any(value));
+  property_changes_.Queue(name, brillo::Any(value));
 }
 
 bool ServiceDBusAdaptor::GetProperties(brillo::ErrorPtr* error,
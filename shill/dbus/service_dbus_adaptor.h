@@ -13,6 +13,7 @@
 #include "shill/adaptor_interfaces.h"
 #include "shill/data_types.h"
 #include "shill/dbus/dbus_adaptor.h"
+#include "shill/dbus/property_change_coalescer.h"
 
 namespace shill {
 
@@ -92,6 +93,7 @@ class ServiceDBusAdaptor : public org::chromium::flimflam::ServiceAdaptor,
       const VariantDictionaries& returned);
 
   Service* service_;
+  PropertyChangeCoalescer property_changes_;
   base::WeakPtrFactory<ServiceDBusAdaptor> weak_factory_{this};
 };
 
@@ -17,6 +17,7 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <optional>
@@ -194,6 +195,9 @@ constexpr base::TimeDelta kDelayedDeviceCreation = base::Seconds(5);
 
 // Time interval for polling for link statistics.
 constexpr base::TimeDelta kRequestLinkStatisticsInterval = base::Seconds(20);
+// Upper bound of the polling interval when the link statistics of all the
+// interfaces stay the same.
+constexpr base::TimeDelta kMaxRequestLinkStatisticsInterval = base::Minutes(3);
 
 // IFLA_XFRM_LINK and IFLA_XFRM_IF_ID are defined in
 // /usr/include/linux/if_link.h on 4.19+ kernels.
@@ -275,11 +279,13 @@ void DeviceInfo::Start() {
                        base::BindRepeating(&DeviceInfo::LinkMsgHandler,
                                            base::Unretained(this))));
   rtnl_handler_->RequestDump(RTNLHandler::kRequestLink);
+  link_statistics_interval_ = kRequestLinkStatisticsInterval;
+  link_statistics_changed_ = false;
   request_link_statistics_callback_.Reset(base::BindOnce(
       &DeviceInfo::RequestLinkStatistics, weak_factory_.GetWeakPtr()));
   dispatcher_->PostDelayedTask(FROM_HERE,
                                request_link_statistics_callback_.callback(),
-                               kRequestLinkStatisticsInterval);
+                               link_statistics_interval_);
 }
 
 void DeviceInfo::Stop() {
@@ -1236,8 +1242,12 @@ void DeviceInfo::RetrieveLinkStatistics(int interface_index,
           << " interface index " << interface_index << ": "
           << "receive: " << stats.rx_bytes << "; "
           << "transmit: " << stats.tx_bytes << ".";
-  infos_[interface_index].rx_bytes = stats.rx_bytes;
-  infos_[interface_index].tx_bytes = stats.tx_bytes;
+  Info& info = infos_[interface_index];
+  if (info.rx_bytes != stats.rx_bytes || info.tx_bytes != stats.tx_bytes) {
+    link_statistics_changed_ = true;
+  }
+  info.rx_bytes = stats.rx_bytes;
+  info.tx_bytes = stats.tx_bytes;
 
   DeviceRefPtr device = GetDevice(interface_index);
   if (device && device->technology() == Technology::kWiFi) {
@@ -1248,11 +1258,21 @@ void DeviceInfo::RetrieveLinkStatistics(int interface_index,
 
 void DeviceInfo::RequestLinkStatistics() {
   rtnl_handler_->RequestDump(RTNLHandler::kRequestLink);
+  // Back off while no traffic went through any interface since the previous
+  // poll, so that an idle system is woken up less often. Any traffic brings
+  // the polling back to its base interval.
+  if (link_statistics_changed_) {
+    link_statistics_interval_ = kRequestLinkStatisticsInterval;
+  } else {
+    link_statistics_interval_ = std::min(link_statistics_interval_ * 2,
+                                         kMaxRequestLinkStatisticsInterval);
+  }
+  link_statistics_changed_ = false;
   request_link_statistics_callback_.Reset(base::BindOnce(
       &DeviceInfo::RequestLinkStatistics, weak_factory_.GetWeakPtr()));
   dispatcher_->PostDelayedTask(FROM_HERE,
                                request_link_statistics_callback_.callback(),
-                               kRequestLinkStatisticsInterval);
+                               link_statistics_interval_);
 }
 
 void DeviceInfo::GetWiFiInterfaceInfo(int interface_index) {
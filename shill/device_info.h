@@ -17,6 +17,7 @@
 #include <base/files/file_path.h>
 #include <base/functional/callback.h>
 #include <base/memory/weak_ptr.h>
+#include <base/time/time.h>
 #include <chromeos/patchpanel/dbus/client.h>
 #include <gtest/gtest_prod.h>  // for FRIEND_TEST
 #include <net-base/mac_address.h>
@@ -287,6 +288,10 @@ class DeviceInfo {
 
   // Maintain a callback for the periodic link statistics poll task.
   base::CancelableOnceClosure request_link_statistics_callback_;
+  // Current interval of the link statistics poll, and whether the byte counts
+  // of any interface changed since the previous poll.
+  base::TimeDelta link_statistics_interval_;
+  bool link_statistics_changed_ = false;
 
   // Maintain the list of callbacks awaiting link ready event.
   // Used by VPNServices for tunnel (through calling CreateTunnel with
@@ -518,6 +518,43 @@ TEST_F(DeviceInfoTest, CreateDeviceCDCEthernet) {
   EXPECT_EQ(1, dispatcher_.task_environment().GetPendingMainThreadTaskCount());
 }
 
+TEST_F(DeviceInfoTest, LinkStatisticsPollingBacksOffWhileIdle) {
+  auto& task_environment = dispatcher_.task_environment();
+  EXPECT_CALL(rtnl_handler_, RequestDump(RTNLHandler::kRequestLink))
+      .Times(AnyNumber());
+  device_info_.Start();
+  EXPECT_EQ(base::Seconds(20),
+            task_environment.NextMainThreadPendingTaskDelay());
+
+  // The interval doubles while no byte count changes, up to a maximum.
+  task_environment.FastForwardBy(base::Seconds(20));
+  EXPECT_EQ(base::Seconds(40),
+            task_environment.NextMainThreadPendingTaskDelay());
+  task_environment.FastForwardBy(base::Seconds(40));
+  EXPECT_EQ(base::Seconds(80),
+            task_environment.NextMainThreadPendingTaskDelay());
+  task_environment.FastForwardBy(base::Seconds(80));
+  EXPECT_EQ(base::Seconds(160),
+            task_environment.NextMainThreadPendingTaskDelay());
+  task_environment.FastForwardBy(base::Seconds(160));
+  EXPECT_EQ(base::Minutes(3),
+            task_environment.NextMainThreadPendingTaskDelay());
+
+  // Traffic on an interface brings the interval back to its base value.
+  auto message = BuildLinkMessage(RTNLMessage::kModeAdd);
+  struct old_rtnl_link_stats64 stats;
+  memset(&stats, 0, sizeof(stats));
+  stats.rx_bytes = kReceiveByteCount;
+  message->SetAttribute(
+      IFLA_STATS64, {reinterpret_cast<const uint8_t*>(&stats), sizeof(stats)});
+  SendMessageToDeviceInfo(*message);
+  task_environment.FastForwardBy(base::Minutes(3));
+  EXPECT_EQ(base::Seconds(20),
+            task_environment.NextMainThreadPendingTaskDelay());
+
+  device_info_.Stop();
+}
+
 TEST_F(DeviceInfoTest, CreateDeviceUnknown) {
   // An unknown (blocked, unhandled, etc) device won't be flushed or
   // registered.
@@ -116,6 +116,7 @@ HttpRequest::Result HttpRequest::Start(
     StartRequest();
   } else {
     SLOG(this, 3) << "Looking up host: " << server_hostname_;
+    dns_start_time_ = base::TimeTicks::Now();
     Error error;
     if (!dns_client_->Start(dns_list_, server_hostname_, &error)) {
       LOG(ERROR) << logging_tag_
@@ -130,6 +131,7 @@ HttpRequest::Result HttpRequest::Start(
 
 void HttpRequest::StartRequest() {
   LOG(INFO) << logging_tag_ << ": Starting request to " << url_string_;
+  request_start_time_ = base::TimeTicks::Now();
   request_id_ =
       brillo::http::Get(url_string_, headers_, transport_,
                         base::BindOnce(&HttpRequest::SuccessCallback,
@@ -147,6 +149,8 @@ void HttpRequest::SuccessCallback(
     SendStatus(kResultUnknown);
     return;
   }
+  LOG(INFO) << logging_tag_ << ": Request completed in "
+            << base::TimeTicks::Now() - request_start_time_;
 
   base::OnceCallback<void(std::shared_ptr<brillo::http::Response>)>
       request_success_callback = std::move(request_success_callback_);
@@ -178,6 +182,9 @@ void HttpRequest::ErrorCallback(brillo::http::RequestID request_id,
     SendStatus(kResultUnknown);
     return;
   }
+  LOG(INFO) << logging_tag_ << ": Request failed with error code "
+            << error_code << " after "
+            << base::TimeTicks::Now() - request_start_time_;
 
   // TODO(matthewmwang): This breaks abstraction. Modify brillo::http::Transport
   // to provide an implementation agnostic error code.
@@ -220,9 +227,11 @@ void HttpRequest::Stop() {
 void HttpRequest::GetDNSResult(
     const base::expected<net_base::IPAddress, Error>& address) {
   SLOG(this, 3) << "In " << __func__;
+  const base::TimeDelta dns_duration = base::TimeTicks::Now() - dns_start_time_;
   if (!address.has_value()) {
     LOG(ERROR) << logging_tag_ << ": Could not resolve " << server_hostname_
-               << ": " << address.error().message();
+               << " after " << dns_duration << ": "
+               << address.error().message();
     if (address.error().message() == DnsClient::kErrorTimedOut) {
       SendStatus(kResultDNSTimeout);
     } else {
@@ -237,7 +246,7 @@ void HttpRequest::GetDNSResult(
   transport_->ResolveHostToIp(server_hostname_, server_port_,
                               address->ToString());
   LOG(INFO) << logging_tag_ << ": Resolved " << server_hostname_ << " to "
-            << *address;
+            << *address << " in " << dns_duration;
   StartRequest();
 }
 
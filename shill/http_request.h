@@ -13,6 +13,7 @@
 #include <base/functional/callback.h>
 #include <base/memory/ref_counted.h>
 #include <base/memory/weak_ptr.h>
+#include <base/time/time.h>
 #include <base/types/expected.h>
 #include <brillo/errors/error.h>
 #include <brillo/http/http_transport.h>
@@ -110,6 +111,10 @@ class HttpRequest {
   int server_port_;
   std::string server_path_;
   bool is_running_;
+  // Times at which the DNS lookup and the HTTP request were started, used to
+  // log how long each phase of the probe takes.
+  base::TimeTicks dns_start_time_;
+  base::TimeTicks request_start_time_;
 };
 
 }  // namespace shill
@@ -1346,6 +1346,25 @@ class Metrics {
   static constexpr int kTimerHistogramMillisecondsMaxLarge = 90 * 1000;
   static constexpr int kTimerHistogramMillisecondsMin = 1;
 
+  // Time from the start of IP provisioning on a Network to the first usable
+  // IPv4 or IPv6 configuration, reported once per family and connection. Along
+  // with TimeToConfig and TimeToOnline, this tells which family held up the
+  // connection.
+  static constexpr HistogramMetric<NameByTechnology>
+      kMetricTimeToIPv4ConfigMilliseconds = {
+          .n = NameByTechnology{"TimeToIPv4Config"},
+          .min = kTimerHistogramMillisecondsMin,
+          .max = kTimerHistogramMillisecondsMax,
+          .num_buckets = kTimerHistogramNumBuckets,
+  };
+  static constexpr HistogramMetric<NameByTechnology>
+      kMetricTimeToIPv6ConfigMilliseconds = {
+          .n = NameByTechnology{"TimeToIPv6Config"},
+          .min = kTimerHistogramMillisecondsMin,
+          .max = kTimerHistogramMillisecondsMax,
+          .num_buckets = kTimerHistogramNumBuckets,
+  };
+
   // Called with the number of detection attempts when the PortalDetector
   // completes and the result is 'online'.
   static constexpr HistogramMetric<NameByTechnology>
@@ -28,19 +28,24 @@ void EventHistory::RecordEventAndExpireEventsBefore(int seconds_ago,
 
 std::vector<std::string> EventHistory::ExtractWallClockToStrings() const {
   std::vector<std::string> strings;
-  for (std::deque<Timestamp>::const_iterator it = events_.begin();
-       it != events_.end(); ++it) {
-    strings.push_back(it->wall_clock);
+  strings.reserve(events_.size());
+  for (const auto& event : events_) {
+    strings.push_back(event.wall_clock);
   }
   return strings;
 }
 
 void EventHistory::RecordEventInternal(Timestamp now) {
-  events_.push_back(now);
-  while (!events_.empty() && max_events_specified_ &&
-         (events_.size() > static_cast<size_t>(max_events_saved_))) {
-    events_.pop_front();
+  if (max_events_specified_) {
+    if (max_events_saved_ <= 0) {
+      return;
+    }
+    // Make room first so that |events_| never grows past its capacity.
+    while (events_.size() >= static_cast<size_t>(max_events_saved_)) {
+      events_.pop_front();
+    }
   }
+  events_.push_back(now);
 }
 
 void EventHistory::ExpireEventsBeforeInternal(int seconds_ago,
@@ -48,21 +53,7 @@ void EventHistory::ExpireEventsBeforeInternal(int seconds_ago,
                                               ClockType clock_type) {
   struct timeval interval = (const struct timeval){seconds_ago};
   while (!events_.empty()) {
-    struct timeval elapsed = {0, 0};
-    switch (clock_type) {
-      case kClockTypeBoottime:
-        timersub(&now.boottime, &events_.front().boottime, &elapsed);
-        break;
-      case kClockTypeMonotonic:
-        timersub(&now.monotonic, &events_.front().monotonic, &elapsed);
-        break;
-      default: {
-        NOTIMPLEMENTED()
-            << __func__ << ": "
-            << "Invalid clock type specified - defaulting to boottime clock";
-        timersub(&now.boottime, &events_.front().boottime, &elapsed);
-      }
-    }
+    struct timeval elapsed = GetElapsed(now, events_.front(), clock_type);
     if (timercmp(&elapsed, &interval, <)) {
       break;
     }
@@ -75,30 +66,38 @@ int EventHistory::CountEventsWithinInterval(int seconds_ago,
   int num_events_in_interval = 0;
   Timestamp now = time_->GetNow();
   struct timeval interval = (const struct timeval){seconds_ago};
-  int i = 0;
-  for (const auto& event : events_) {
-    struct timeval elapsed = {0, 0};
-    switch (clock_type) {
-      case kClockTypeBoottime:
-        timersub(&now.boottime, &event.boottime, &elapsed);
-        break;
-      case kClockTypeMonotonic:
-        timersub(&now.monotonic, &event.monotonic, &elapsed);
-        break;
-      default: {
-        NOTIMPLEMENTED()
-            << __func__ << ": "
-            << "Invalid clock type specified - defaulting to boottime clock";
-        timersub(&now.boottime, &event.boottime, &elapsed);
-      }
-    }
-    if (timercmp(&elapsed, &interval, <=)) {
-      num_events_in_interval = events_.size() - i;
+  // Events are ordered, so walk back from the latest one and stop at the first
+  // event outside of the interval.
+  for (auto it = events_.rbegin(); it != events_.rend(); ++it) {
+    struct timeval elapsed = GetElapsed(now, *it, clock_type);
+    if (!timercmp(&elapsed, &interval, <=)) {
       break;
     }
-    ++i;
+    ++num_events_in_interval;
   }
   return num_events_in_interval;
 }
 
+// static
+struct timeval EventHistory::GetElapsed(const Timestamp& now,
+                                        const Timestamp& event,
+                                        ClockType clock_type) {
+  struct timeval elapsed = {0, 0};
+  switch (clock_type) {
+    case kClockTypeBoottime:
+      timersub(&now.boottime, &event.boottime, &elapsed);
+      break;
+    case kClockTypeMonotonic:
+      timersub(&now.monotonic, &event.monotonic, &elapsed);
+      break;
+    default: {
+      NOTIMPLEMENTED()
+          << __func__ << ": "
+          << "Invalid clock type specified - defaulting to boottime clock";
+      timersub(&now.boottime, &event.boottime, &elapsed);
+    }
+  }
+  return elapsed;
+}
+
 }  // namespace shill
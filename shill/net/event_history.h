@@ -77,6 +77,11 @@ class SHILL_EXPORT EventHistory {
                                   Timestamp now,
                                   ClockType clock_type);
 
+  // Returns the time elapsed between |event| and |now| on |clock_type|.
+  static struct timeval GetElapsed(const Timestamp& now,
+                                   const Timestamp& event,
+                                   ClockType clock_type);
+
   bool max_events_specified_;
   int max_events_saved_;
   std::deque<Timestamp> events_;
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <net-base/mac_address.h>
@@ -60,6 +61,16 @@ class MockRTNLHandler : public RTNLHandler {
                    uint32_t* seq) override {
     return DoSendMessage(message.get(), seq);
   }
+  // Forwards each message to DoSendMessage() such that expectations do not
+  // depend on whether messages are sent individually or in a batch.
+  bool SendMessages(
+      std::vector<std::unique_ptr<RTNLMessage>> messages) override {
+    bool ret = true;
+    for (auto& message : messages) {
+      ret = DoSendMessage(message.get(), nullptr) && ret;
+    }
+    return ret;
+  }
 };
 
 }  // namespace shill
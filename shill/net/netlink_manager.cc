@@ -374,9 +374,8 @@ uint16_t NetlinkManager::GetFamily(
     }
 
     // Read and process any messages.
-    std::vector<uint8_t> received;
-    sock_->RecvMessage(&received);
-    InputData input_data(received.data(), received.size());
+    sock_->RecvMessage(&receive_buffer_);
+    InputData input_data(receive_buffer_.data(), receive_buffer_.size());
     OnRawNlMessageReceived(&input_data);
     if (message_type.family_id != NetlinkMessage::kIllegalMessageType) {
       uint16_t family_id = message_type.family_id;
@@ -649,7 +648,9 @@ void NetlinkManager::OnRawNlMessageReceived(InputData* data) {
   const unsigned char* buf = data->buf;
   const unsigned char* end = buf + data->len;
   while (buf < end) {
-    NetlinkPacket packet({buf, end});
+    // The packet is only used within this iteration, reference its payload in
+    // |data| instead of copying it.
+    NetlinkPacket packet({buf, end}, NetlinkPacket::PayloadMode::kReference);
     if (!packet.IsValid()) {
       break;
     }
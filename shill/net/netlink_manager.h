@@ -434,6 +434,10 @@ class SHILL_EXPORT NetlinkManager {
   std::unique_ptr<IOHandler> dispatcher_handler_;
 
   std::unique_ptr<NetlinkSocket> sock_;
+  // Buffer reused across the synchronous reads of |GetFamily| such that it
+  // only grows to the size of the largest message instead of being allocated
+  // for each message.
+  std::vector<uint8_t> receive_buffer_;
   std::map<const std::string, MessageType> message_types_;
   NetlinkMessageFactory message_factory_;
   Time* time_;
@@ -11,7 +11,7 @@
 
 namespace shill {
 
-NetlinkPacket::NetlinkPacket(base::span<const uint8_t> buf)
+NetlinkPacket::NetlinkPacket(base::span<const uint8_t> buf, PayloadMode mode)
     : consumed_bytes_(0) {
   if (buf.size() < sizeof(header_)) {
     LOG(ERROR) << "Cannot retrieve header.";
@@ -24,14 +24,21 @@ NetlinkPacket::NetlinkPacket(base::span<const uint8_t> buf)
     return;
   }
 
-  payload_ = std::make_unique<std::vector<uint8_t>>(
-      buf.begin() + sizeof(header_), buf.end());
+  // Only keep the payload of this message: |buf| may hold the messages that
+  // follow it in the same datagram.
+  valid_ = true;
+  payload_ = buf.subspan(sizeof(header_), header_.nlmsg_len - sizeof(header_));
+  if (mode == PayloadMode::kCopy) {
+    owned_payload_ = std::make_unique<std::vector<uint8_t>>(payload_.begin(),
+                                                            payload_.end());
+    payload_ = {};
+  }
 }
 
 NetlinkPacket::~NetlinkPacket() = default;
 
 bool NetlinkPacket::IsValid() const {
-  return payload_ != nullptr;
+  return valid_;
 }
 
 size_t NetlinkPacket::GetLength() const {
@@ -52,7 +59,10 @@ size_t NetlinkPacket::GetRemainingLength() const {
 
 base::span<const uint8_t> NetlinkPacket::GetPayload() const {
   CHECK(IsValid());
-  return *payload_;
+  if (owned_payload_) {
+    return *owned_payload_;
+  }
+  return payload_;
 }
 
 bool NetlinkPacket::ConsumeAttributes(
@@ -69,9 +79,9 @@ bool NetlinkPacket::ConsumeData(size_t len, void* data) {
     return false;
   }
 
-  memcpy(data, payload_->data() + consumed_bytes_, len);
+  memcpy(data, GetPayload().data() + consumed_bytes_, len);
   consumed_bytes_ =
-      std::min(payload_->size(), consumed_bytes_ + NLMSG_ALIGN(len));
+      std::min(GetPayload().size(), consumed_bytes_ + NLMSG_ALIGN(len));
   return true;
 }
 
@@ -84,7 +94,7 @@ bool NetlinkPacket::GetGenlMsgHdr(genlmsghdr* header) const {
   if (GetPayload().size() < sizeof(*header)) {
     return false;
   }
-  memcpy(header, payload_->data(), sizeof(*header));
+  memcpy(header, GetPayload().data(), sizeof(*header));
   return true;
 }
 
@@ -20,7 +20,16 @@ namespace shill {
 
 class SHILL_EXPORT NetlinkPacket {
  public:
-  explicit NetlinkPacket(base::span<const uint8_t> buf);
+  // Whether the payload of the packet is copied out of the buffer given to the
+  // constructor or references it in place. Packets referencing their payload
+  // avoid a copy for each received message but must not outlive the buffer.
+  enum class PayloadMode {
+    kCopy,
+    kReference,
+  };
+
+  explicit NetlinkPacket(base::span<const uint8_t> buf,
+                         PayloadMode mode = PayloadMode::kCopy);
   NetlinkPacket(const NetlinkPacket&) = delete;
   NetlinkPacket& operator=(const NetlinkPacket&) = delete;
 
@@ -71,7 +80,7 @@ class SHILL_EXPORT NetlinkPacket {
   // These getters are protected so that derived classes may allow
   // the packet contents to be modified.
   nlmsghdr* mutable_header() { return &header_; }
-  std::vector<uint8_t>* mutable_payload() { return payload_.get(); }
+  std::vector<uint8_t>* mutable_payload() { return owned_payload_.get(); }
   void set_consumed_bytes(size_t consumed_bytes) {
     consumed_bytes_ = consumed_bytes;
   }
@@ -79,8 +88,12 @@ class SHILL_EXPORT NetlinkPacket {
  private:
   friend class NetlinkPacketTest;
 
+  bool valid_ = false;
   nlmsghdr header_;
-  std::unique_ptr<std::vector<uint8_t>> payload_;
+  // Payload referenced in the buffer given to the constructor, used if
+  // |owned_payload_| is null.
+  base::span<const uint8_t> payload_;
+  std::unique_ptr<std::vector<uint8_t>> owned_payload_;
   size_t consumed_bytes_;
 };
 
@@ -126,4 +126,31 @@ TEST(NetlinkPacketTest, ConsumeData) {
   EXPECT_EQ(0, packet.GetRemainingLength());
 }
 
+TEST(NetlinkPacketTest, PayloadMode) {
+  unsigned char data[2 * sizeof(nlmsghdr) + 4];
+  memset(data, 0, sizeof(data));
+  nlmsghdr hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.nlmsg_len = sizeof(hdr) + 4;
+  memcpy(data, &hdr, sizeof(hdr));
+  data[sizeof(nlmsghdr)] = 10;
+
+  // The payload only holds the data of the first message of the buffer.
+  NetlinkPacket copied_packet(data);
+  ASSERT_TRUE(copied_packet.IsValid());
+  EXPECT_EQ(4, copied_packet.GetPayload().size());
+  EXPECT_NE(data + sizeof(nlmsghdr), copied_packet.GetPayload().data());
+
+  NetlinkPacket referencing_packet(data,
+                                   NetlinkPacket::PayloadMode::kReference);
+  ASSERT_TRUE(referencing_packet.IsValid());
+  EXPECT_EQ(sizeof(nlmsghdr) + 4, referencing_packet.GetLength());
+  EXPECT_EQ(4, referencing_packet.GetRemainingLength());
+  EXPECT_EQ(data + sizeof(nlmsghdr), referencing_packet.GetPayload().data());
+  char payload_byte = 0;
+  EXPECT_TRUE(referencing_packet.ConsumeData(1, &payload_byte));
+  EXPECT_EQ(10, payload_byte);
+  EXPECT_EQ(0, referencing_packet.GetRemainingLength());
+}
+
 }  // namespace shill
@@ -18,6 +18,7 @@
 #include <unistd.h>
 
 #include <limits>
+#include <optional>
 #include <utility>
 
 #include <base/check.h>
@@ -45,6 +46,7 @@ const uint32_t RTNLHandler::kRequestBridgeNeighbor = 64;
 
 const int RTNLHandler::kErrorWindowSize = 16;
 const uint32_t RTNLHandler::kStoredRequestWindowSize = 32;
+const size_t RTNLHandler::kMaxBatchSize = 16384;
 
 namespace {
 base::LazyInstance<RTNLHandler>::DestructorAtExit g_rtnl_handler =
@@ -121,6 +123,8 @@ void RTNLHandler::Stop() {
   last_dump_sequence_ = 0;
   stored_requests_.clear();
   oldest_request_sequence_ = 0;
+  queued_messages_.clear();
+  batch_last_sequence_.reset();
 
   VLOG(2) << "RTNLHandler stopped";
 }
@@ -269,6 +273,7 @@ void RTNLHandler::NextRequest(uint32_t seq) {
 void RTNLHandler::ParseRTNL(InputData* data) {
   const unsigned char* buf = data->buf;
   const unsigned char* end = buf + data->len;
+  bool batch_acknowledged = false;
 
   while (buf < end) {
     const struct nlmsghdr* hdr = reinterpret_cast<const struct nlmsghdr*>(buf);
@@ -384,6 +389,11 @@ void RTNLHandler::ParseRTNL(InputData* data) {
             }
           }
 
+          // The kernel processes the messages of a batch in order.
+          if (batch_last_sequence_ == hdr->nlmsg_seq) {
+            batch_acknowledged = true;
+          }
+
           auto response_callback_iter =
               response_callbacks_.find(hdr->nlmsg_seq);
           if (response_callback_iter != response_callbacks_.end()) {
@@ -399,6 +409,11 @@ void RTNLHandler::ParseRTNL(InputData* data) {
     }
     buf += NLMSG_ALIGN(hdr->nlmsg_len);
   }
+
+  if (batch_acknowledged) {
+    batch_last_sequence_.reset();
+    SendQueuedMessages();
+  }
 }
 
 bool RTNLHandler::AddressRequest(
@@ -502,16 +517,102 @@ bool RTNLHandler::AddInterface(const std::string& interface_name,
 
 bool RTNLHandler::SendMessage(std::unique_ptr<RTNLMessage> message,
                               uint32_t* msg_seq) {
+  const ErrorMask error_mask = GetDefaultErrorMask(*message);
+  return SendMessageWithErrorMask(std::move(message), error_mask, msg_seq);
+}
+
+bool RTNLHandler::SendMessages(
+    std::vector<std::unique_ptr<RTNLMessage>> messages) {
+  for (auto& message : messages) {
+    queued_messages_.push_back(std::move(message));
+  }
+  if (batch_last_sequence_.has_value()) {
+    // Sent once the batch in flight is acknowledged.
+    return true;
+  }
+  return SendQueuedMessages();
+}
+
+bool RTNLHandler::SendQueuedMessages() {
+  // The sequences still in the error mask window are the ones of the
+  // |kErrorWindowSize| - 1 last messages sent.
+  const size_t max_batch_messages = kErrorWindowSize - 1;
+  bool ret = true;
+  std::vector<uint8_t> batch;
+  std::vector<std::unique_ptr<RTNLMessage>> batch_messages;
+  while (!queued_messages_.empty() &&
+         batch_messages.size() < max_batch_messages) {
+    RTNLMessage& message = *queued_messages_.front();
+    // Request an acknowledgment of each message, such that the kernel tells
+    // when the whole batch was processed.
+    message.set_flags(message.flags() | NLM_F_ACK);
+    message.set_seq(request_sequence_);
+    const auto msgdata = message.Encode();
+    if (msgdata.size() == 0) {
+      queued_messages_.pop_front();
+      ret = false;
+      continue;
+    }
+    // Each message of a batch must start at a NLMSG_ALIGNTO boundary.
+    if (!batch.empty() &&
+        NLMSG_ALIGN(batch.size()) + msgdata.size() > kMaxBatchSize) {
+      break;
+    }
+    SetErrorMask(request_sequence_, GetDefaultErrorMask(message));
+    request_sequence_++;
+    batch.resize(NLMSG_ALIGN(batch.size()), 0);
+    batch.insert(batch.end(), msgdata.begin(), msgdata.end());
+    batch_messages.push_back(std::move(queued_messages_.front()));
+    queued_messages_.pop_front();
+  }
+  if (batch_messages.empty()) {
+    return ret;
+  }
+
+  const uint32_t last_sequence = batch_messages.back()->seq();
+  if (!SendBatch(batch, &batch_messages)) {
+    // No acknowledgment will come to send the rest.
+    LOG(ERROR) << "Dropping " << queued_messages_.size()
+               << " queued RTNL messages";
+    queued_messages_.clear();
+    return false;
+  }
+  batch_last_sequence_ = last_sequence;
+  return ret;
+}
+
+bool RTNLHandler::SendBatch(
+    const std::vector<uint8_t>& batch,
+    std::vector<std::unique_ptr<RTNLMessage>>* messages) {
+  VLOG(5) << "RTNL sending " << messages->size() << " messages, length "
+          << batch.size();
+
+  const bool sent =
+      sockets_->Send(rtnl_socket_, batch.data(), batch.size(), 0) >= 0;
+  if (!sent) {
+    PLOG(ERROR) << "RTNL send failed";
+  } else {
+    for (auto& message : *messages) {
+      StoreRequest(std::move(message));
+    }
+  }
+  messages->clear();
+  return sent;
+}
+
+// static
+RTNLHandler::ErrorMask RTNLHandler::GetDefaultErrorMask(
+    const RTNLMessage& message) {
   ErrorMask error_mask;
-  if (message->mode() == RTNLMessage::kModeAdd) {
+  if (message.mode() == RTNLMessage::kModeAdd) {
     error_mask = {EEXIST};
-  } else if (message->mode() == RTNLMessage::kModeDelete) {
+  } else if (message.mode() == RTNLMessage::kModeDelete) {
     error_mask = {ESRCH, ENODEV};
-    if (message->type() == RTNLMessage::kTypeAddress) {
+    if (message.type() == RTNLMessage::kTypeAddress) {
       error_mask.insert(EADDRNOTAVAIL);
     }
   }
-  return SendMessageWithErrorMask(std::move(message), error_mask, msg_seq);
+  return error_mask;
 }
 
 bool RTNLHandler::SendMessageWithErrorMask(std::unique_ptr<RTNLMessage> message,
@@ -6,8 +6,10 @@
 #define SHILL_NET_RTNL_HANDLER_H_
 
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -135,6 +137,15 @@ class SHILL_EXPORT RTNLHandler {
   // not null, then it will be set to the message's assigned sequence number.
   virtual bool SendMessage(std::unique_ptr<RTNLMessage> message, uint32_t* seq);
 
+  // Sends multiple RTNL messages, concatenating them into batches sent by one
+  // send() call each. Each message is assigned its own sequence number and
+  // error mask as with SendMessage(). A batch holds fewer messages than the
+  // error mask window, and the next batch is only sent once the kernel
+  // acknowledged the previous one, so that no error goes unmatched. Returns
+  // false if a message of the first batch failed to be sent. Failures of the
+  // later batches are only logged.
+  virtual bool SendMessages(std::vector<std::unique_ptr<RTNLMessage>> messages);
+
  protected:
   RTNLHandler();
   RTNLHandler(const RTNLHandler&) = delete;
@@ -159,6 +170,9 @@ class SHILL_EXPORT RTNLHandler {
 
   // Size of the window for receiving error sequences out-of-order.
   static const int kErrorWindowSize;
+  // Maximum number of bytes of the messages sent by one send() call of
+  // SendMessages().
+  static const size_t kMaxBatchSize;
   // Size of the window for maintaining RTNLMessages in |stored_requests_| that
   // haven't yet gotten a response.
   static const uint32_t kStoredRequestWindowSize;
@@ -194,6 +208,19 @@ class SHILL_EXPORT RTNLHandler {
                                 const ErrorMask& error_mask,
                                 uint32_t* msg_seq);
 
+  // Returns the errors that are expected in response to |message| given its
+  // mode and type.
+  static ErrorMask GetDefaultErrorMask(const RTNLMessage& message);
+
+  // Sends the next batch of |queued_messages_|. Returns false if a message of
+  // the batch failed to be sent.
+  bool SendQueuedMessages();
+
+  // Sends the concatenated encoding |batch| of |messages| and stores them as
+  // pending requests on success.
+  bool SendBatch(const std::vector<uint8_t>& batch,
+                 std::vector<std::unique_ptr<RTNLMessage>>* messages);
+
   // Called by the RTNL read handler on exceptional events.
   void OnReadError(const std::string& error_msg);
 
@@ -238,6 +265,12 @@ class SHILL_EXPORT RTNLHandler {
   IOHandlerFactory* io_handler_factory_;
   std::vector<ErrorMask> error_mask_window_;
 
+  // Messages of SendMessages() waiting for the batch in flight to be
+  // acknowledged.
+  std::deque<std::unique_ptr<RTNLMessage>> queued_messages_;
+  // Sequence of the last message of the batch in flight, if any.
+  std::optional<uint32_t> batch_last_sequence_;
+
   // Once |NLMSG_ERROR| message was received, appropriate response_callback
   // matched by message sequence id must be called with encoded error in
   // |NLMSG_ERROR| message.
@@ -32,6 +32,7 @@ using testing::AtLeast;
 using testing::DoAll;
 using testing::ElementsAre;
 using testing::HasSubstr;
+using testing::Mock;
 using testing::Return;
 using testing::ReturnArg;
 using testing::StrictMock;
@@ -330,6 +331,63 @@ TEST_F(RTNLHandlerTest, SendMessageInferredErrorMasks) {
   }
 }
 
+TEST_F(RTNLHandlerTest, SendMessagesBatchesRequests) {
+  StartRTNLHandler();
+  const uint32_t kSequenceNumber = 123;
+  SetRequestSequence(kSequenceNumber);
+  std::vector<std::unique_ptr<RTNLMessage>> messages;
+  messages.push_back(std::make_unique<RTNLMessage>(
+      RTNLMessage::kTypeLink, RTNLMessage::kModeAdd, 0, 0, 0, 0, AF_UNSPEC));
+  messages.push_back(std::make_unique<RTNLMessage>(
+      RTNLMessage::kTypeLink, RTNLMessage::kModeDelete, 0, 0, 0, 0, AF_UNSPEC));
+  size_t expected_size = 0;
+  for (const auto& message : messages) {
+    expected_size += NLMSG_ALIGN(message->Encode().size());
+  }
+
+  // Both messages are sent by a single send() call.
+  EXPECT_CALL(*sockets_, Send(kTestSocket, _, expected_size, 0))
+      .WillOnce(ReturnArg<2>());
+  EXPECT_TRUE(RTNLHandler::GetInstance()->SendMessages(std::move(messages)));
+  EXPECT_EQ(kSequenceNumber + 2, GetRequestSequence());
+  EXPECT_THAT(GetAndClearErrorMask(kSequenceNumber), ElementsAre(EEXIST));
+  EXPECT_THAT(GetAndClearErrorMask(kSequenceNumber + 1),
+              ElementsAre(ESRCH, ENODEV));
+  EXPECT_NE(PopStoredRequest(kSequenceNumber), nullptr);
+  EXPECT_NE(PopStoredRequest(kSequenceNumber + 1), nullptr);
+  StopRTNLHandler();
+}
+
+TEST_F(RTNLHandlerTest, SendMessagesWaitsForBatchAcknowledgment) {
+  StartRTNLHandler();
+  const uint32_t kSequenceNumber = 123;
+  SetRequestSequence(kSequenceNumber);
+  const size_t kBatchMessages = GetErrorWindowSize() - 1;
+  std::vector<std::unique_ptr<RTNLMessage>> messages;
+  for (size_t i = 0; i < kBatchMessages + 2; ++i) {
+    messages.push_back(std::make_unique<RTNLMessage>(
+        RTNLMessage::kTypeLink, RTNLMessage::kModeAdd, 0, 0, 0, 0, AF_UNSPEC));
+  }
+  const size_t message_size = NLMSG_ALIGN(messages[0]->Encode().size());
+
+  // The first batch fits in the error mask window.
+  EXPECT_CALL(*sockets_, Send(kTestSocket, _, kBatchMessages * message_size, 0))
+      .WillOnce(ReturnArg<2>());
+  EXPECT_TRUE(RTNLHandler::GetInstance()->SendMessages(std::move(messages)));
+  EXPECT_EQ(kSequenceNumber + kBatchMessages, GetRequestSequence());
+  Mock::VerifyAndClearExpectations(sockets_);
+
+  // The rest is sent once the last message of the batch is acknowledged.
+  EXPECT_CALL(*sockets_, Send(_, _, _, _)).Times(0);
+  ReturnError(kSequenceNumber + kBatchMessages - 2, 0);
+  Mock::VerifyAndClearExpectations(sockets_);
+  EXPECT_CALL(*sockets_, Send(kTestSocket, _, 2 * message_size, 0))
+      .WillOnce(ReturnArg<2>());
+  ReturnError(kSequenceNumber + kBatchMessages - 1, 0);
+  EXPECT_EQ(kSequenceNumber + kBatchMessages + 2, GetRequestSequence());
+  StopRTNLHandler();
+}
+
 TEST_F(RTNLHandlerTest, MaskedError) {
   StartRTNLHandler();
   const uint32_t kSequenceNumber = 123;
@@ -25,6 +25,16 @@ class MockRoutingPolicyService : public RoutingPolicyService {
   MOCK_METHOD(void, Stop, (), (override));
   MOCK_METHOD(bool, AddRule, (int, const RoutingPolicyEntry&), (override));
   MOCK_METHOD(void, FlushRules, (int), (override));
+  // Forwards each entry to AddRule() such that expectations do not depend on
+  // whether rules are added individually or in a batch.
+  bool AddRules(int interface_index,
+                const std::vector<RoutingPolicyEntry>& entries) override {
+    bool ret = true;
+    for (const auto& entry : entries) {
+      ret = AddRule(interface_index, entry) && ret;
+    }
+    return ret;
+  }
   MOCK_METHOD(const std::vector<uint32_t>&, GetUserTrafficUids, (), (override));
   MOCK_METHOD(uint32_t, GetShillUid, (), (override));
 };
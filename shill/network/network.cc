@@ -96,6 +96,9 @@ void Network::Start(const Network::StartOptions& opts) {
   ignore_link_monitoring_ = opts.ignore_link_monitoring;
   ipv4_gateway_found_ = false;
   ipv6_gateway_found_ = false;
+  start_time_ = base::TimeTicks::Now();
+  ipv4_config_time_reported_ = false;
+  ipv6_config_time_reported_ = false;
 
   probing_configuration_ = opts.probing_configuration;
 
@@ -205,6 +208,7 @@ void Network::SetupConnection(IPConfig* ipconfig) {
 
   LOG(INFO) << *this << ": Setting " << *ipconfig->properties().address_family
             << " connection";
+  ReportTimeToIPConfig(*ipconfig->properties().address_family);
   ApplyAddress(ipconfig->properties());
   ApplyRoute(ipconfig->properties());
   ApplyRoutingPolicy();
@@ -638,6 +642,7 @@ void Network::OnIPv6ConfigUpdated() {
       SetupConnection(ip6config());
     } else {
       // Still apply IPv6 DNS even if the Connection is setup with IPv4.
+      ReportTimeToIPConfig(net_base::IPFamily::kIPv6);
       network_applier_->ApplyDNS(
           priority_, ipconfig_ ? &ipconfig_->properties() : nullptr,
           ip6config_ ? &ip6config_->properties() : nullptr);
@@ -1118,6 +1123,26 @@ bool Network::HasInternetConnectivity() const {
              PortalDetector::ValidationState::kInternetConnectivity;
 }
 
+void Network::ReportTimeToIPConfig(net_base::IPFamily family) {
+  // Skip VPN since its configuration comes with the tunnel setup.
+  if (technology_ == Technology::kVPN) {
+    return;
+  }
+  bool& reported = family == net_base::IPFamily::kIPv4
+                       ? ipv4_config_time_reported_
+                       : ipv6_config_time_reported_;
+  if (reported) {
+    return;
+  }
+  reported = true;
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - start_time_;
+  LOG(INFO) << *this << ": Got " << family << " configuration in " << elapsed;
+  metrics_->SendToUMA(family == net_base::IPFamily::kIPv4
+                          ? Metrics::kMetricTimeToIPv4ConfigMilliseconds
+                          : Metrics::kMetricTimeToIPv6ConfigMilliseconds,
+                      technology_, elapsed.InMilliseconds());
+}
+
 void Network::ReportIPType() {
   const bool has_ipv4 = ipconfig() && !ipconfig()->properties().address.empty();
   const bool has_ipv6 =
@@ -447,6 +447,10 @@ class Network {
   // Report the current IP type metrics (v4, v6 or dual-stack) to UMA.
   void ReportIPType();
 
+  // Report to UMA the time it took since Start() to get a usable configuration
+  // for |family|, if not already done for the current connection.
+  void ReportTimeToIPConfig(net_base::IPFamily family);
+
   // Report to UMA a failure in patchpanel::NeighborLinkMonitor for a WiFi or
   // Ethernet network connection.
   void ReportNeighborLinkMonitorFailure(Technology tech,
@@ -524,6 +528,13 @@ class Network {
   bool ipv4_gateway_found_ = false;
   bool ipv6_gateway_found_ = false;
 
+  // When IP provisioning was last started, and whether the time to get a
+  // configuration has been reported for each family since then. Reset in
+  // Start().
+  base::TimeTicks start_time_;
+  bool ipv4_config_time_reported_ = false;
+  bool ipv6_config_time_reported_ = false;
+
   PortalDetector::ProbingConfiguration probing_configuration_;
   std::unique_ptr<PortalDetector> portal_detector_;
   // Only defined if PortalDetector completed at least one attempt for the
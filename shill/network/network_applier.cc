@@ -174,6 +174,9 @@ void NetworkApplier::ApplyRoutingPolicy(
   // only supported case is traffic from shill.
   uint32_t shill_uid = rule_table_->GetShillUid();
 
+  // Rules of this interface, added together once all of them are known.
+  std::vector<RoutingPolicyEntry> rules;
+
   // b/177620923 Add uid rules just before the default rule to route to the VPN
   // interface any untagged traffic owner by a uid routed through VPN
   // connections. These rules are necessary for consistency between source IP
@@ -186,7 +189,7 @@ void NetworkApplier::ApplyRoutingPolicy(
         entry.priority = kVpnUidRulePriority;
         entry.table = table_id;
         entry.uid_range = fib_rule_uid_range{uid, uid};
-        rule_table_->AddRule(interface_index, entry);
+        rules.push_back(entry);
       }
     }
   }
@@ -213,7 +216,7 @@ void NetworkApplier::ApplyRoutingPolicy(
       auto catch_all_rule = RoutingPolicyEntry(family);
       catch_all_rule.priority = kCatchallPriority;
       catch_all_rule.table = table_id;
-      rule_table_->AddRule(interface_index, catch_all_rule);
+      rules.push_back(catch_all_rule);
     }
   }
 
@@ -232,7 +235,7 @@ void NetworkApplier::ApplyRoutingPolicy(
     dst_addr_rule.dst = net_base::IPCIDR(dst_address);
     dst_addr_rule.priority = kDstRulePriority;
     dst_addr_rule.table = table_id;
-    rule_table_->AddRule(interface_index, dst_addr_rule);
+    rules.push_back(dst_addr_rule);
   }
 
   // Always set a rule for matching traffic tagged with the fwmark routing tag
@@ -245,7 +248,7 @@ void NetworkApplier::ApplyRoutingPolicy(
     if (no_ipv6 && fwmark_routing_entry.family == net_base::IPFamily::kIPv6) {
       fwmark_routing_entry.uid_range = fib_rule_uid_range{shill_uid, shill_uid};
     }
-    rule_table_->AddRule(interface_index, fwmark_routing_entry);
+    rules.push_back(fwmark_routing_entry);
   }
 
   // Add output interface rule for all interfaces, such that SO_BINDTODEVICE can
@@ -258,7 +261,7 @@ void NetworkApplier::ApplyRoutingPolicy(
     if (no_ipv6 && oif_rule.family == net_base::IPFamily::kIPv6) {
       oif_rule.uid_range = fib_rule_uid_range{shill_uid, shill_uid};
     }
-    rule_table_->AddRule(interface_index, oif_rule);
+    rules.push_back(oif_rule);
   }
 
   if (technology != Technology::kVPN) {
@@ -272,7 +275,7 @@ void NetworkApplier::ApplyRoutingPolicy(
       if (address.GetFamily() == net_base::IPFamily::kIPv6 && no_ipv6) {
         if_addr_rule.uid_range = fib_rule_uid_range{shill_uid, shill_uid};
       }
-      rule_table_->AddRule(interface_index, if_addr_rule);
+      rules.push_back(if_addr_rule);
     }
 
     for (const auto family : net_base::kIPFamilies) {
@@ -283,9 +286,10 @@ void NetworkApplier::ApplyRoutingPolicy(
       if (no_ipv6 && iif_rule.family == net_base::IPFamily::kIPv6) {
         iif_rule.uid_range = fib_rule_uid_range{shill_uid, shill_uid};
       }
-      rule_table_->AddRule(interface_index, iif_rule);
+      rules.push_back(iif_rule);
     }
   }
+  rule_table_->AddRules(interface_index, rules);
   proc_fs_->FlushRoutingCache();
 }
 
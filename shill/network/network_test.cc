@@ -2001,6 +2001,37 @@ TEST_F(NetworkStartTest, DualStackDHCPFirst) {
   VerifyIPTypeReportScheduled(Metrics::kIPTypeDualStack);
 }
 
+TEST_F(NetworkStartTest, DualStackReportTimeToIPConfig) {
+  const TestOptions test_opts = {.dhcp = true, .accept_ra = true};
+  ExpectCreateDHCPController(/*request_ip_result=*/true);
+  InvokeStart(test_opts);
+
+  dispatcher_.task_environment().FastForwardBy(base::Milliseconds(300));
+  EXPECT_CALL(metrics_,
+              SendToUMA(Metrics::kMetricTimeToIPv4ConfigMilliseconds,
+                        kTestTechnology, 300));
+  TriggerDHCPUpdateCallback();
+  Mock::VerifyAndClearExpectations(&metrics_);
+
+  // IPv6 is reported even though the connection stays on IPv4.
+  dispatcher_.task_environment().FastForwardBy(base::Milliseconds(200));
+  EXPECT_CALL(metrics_,
+              SendToUMA(Metrics::kMetricTimeToIPv6ConfigMilliseconds,
+                        kTestTechnology, 500));
+  TriggerSLAACUpdate();
+  Mock::VerifyAndClearExpectations(&metrics_);
+
+  // Further updates on the same connection are not reported.
+  EXPECT_CALL(metrics_,
+              SendToUMA(Metrics::kMetricTimeToIPv4ConfigMilliseconds, _, _))
+      .Times(0);
+  EXPECT_CALL(metrics_,
+              SendToUMA(Metrics::kMetricTimeToIPv6ConfigMilliseconds, _, _))
+      .Times(0);
+  TriggerDHCPUpdateCallback();
+  TriggerSLAACUpdate();
+}
+
 // The dual-stack VPN case, Connection should be set up with IPv6 at first, and
 // then IPv4.
 TEST_F(NetworkStartTest, DualStackLinkProtocol) {
@@ -8,6 +8,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <base/strings/string_piece.h>
@@ -242,20 +243,45 @@ RoutingPolicyService::ParseRoutingPolicyMessage(const RTNLMessage& message) {
 
 bool RoutingPolicyService::AddRule(int interface_index,
                                    const RoutingPolicyEntry& entry) {
-  if (!ApplyRule(interface_index, entry, RTNLMessage::kModeAdd,
-                 NLM_F_CREATE | NLM_F_EXCL)) {
+  if (!rtnl_handler_->SendMessage(
+          CreateRuleMessage(interface_index, entry, RTNLMessage::kModeAdd,
+                            NLM_F_CREATE | NLM_F_EXCL),
+          nullptr)) {
     return false;
   }
-  // Add entry into policy table if no identical entry exists.
+  RecordRule(interface_index, entry);
+  return true;
+}
+
+bool RoutingPolicyService::AddRules(
+    int interface_index, const std::vector<RoutingPolicyEntry>& entries) {
+  if (entries.empty()) {
+    return true;
+  }
+  std::vector<std::unique_ptr<RTNLMessage>> messages;
+  messages.reserve(entries.size());
+  for (const auto& entry : entries) {
+    messages.push_back(CreateRuleMessage(interface_index, entry,
+                                         RTNLMessage::kModeAdd,
+                                         NLM_F_CREATE | NLM_F_EXCL));
+  }
+  const bool ret = rtnl_handler_->SendMessages(std::move(messages));
+  for (const auto& entry : entries) {
+    RecordRule(interface_index, entry);
+  }
+  return ret;
+}
+
+void RoutingPolicyService::RecordRule(int interface_index,
+                                      const RoutingPolicyEntry& entry) {
   // Note that the main routing table route can be added multiple times without
   // removal so duplication check is essential here.
   auto& policy_table = policy_tables_[interface_index];
   if (std::find(policy_table.begin(), policy_table.end(), entry) !=
       policy_table.end()) {
-    return true;
+    return;
   }
   policy_table.push_back(entry);
-  return true;
 }
 
 void RoutingPolicyService::FlushRules(int interface_index) {
@@ -266,16 +292,23 @@ void RoutingPolicyService::FlushRules(int interface_index) {
     return;
   }
 
+  std::vector<std::unique_ptr<RTNLMessage>> messages;
+  messages.reserve(table->second.size());
   for (const auto& nent : table->second) {
-    ApplyRule(interface_index, nent, RTNLMessage::kModeDelete, 0);
+    messages.push_back(
+        CreateRuleMessage(interface_index, nent, RTNLMessage::kModeDelete, 0));
   }
   table->second.clear();
+  if (!messages.empty()) {
+    rtnl_handler_->SendMessages(std::move(messages));
+  }
 }
 
-bool RoutingPolicyService::ApplyRule(uint32_t interface_index,
-                                     const RoutingPolicyEntry& entry,
-                                     RTNLMessage::Mode mode,
-                                     unsigned int flags) {
+std::unique_ptr<RTNLMessage> RoutingPolicyService::CreateRuleMessage(
+    uint32_t interface_index,
+    const RoutingPolicyEntry& entry,
+    RTNLMessage::Mode mode,
+    unsigned int flags) {
   SLOG(2) << base::StringPrintf(
       "%s: index %d family %s prio %d", __func__, interface_index,
       net_base::ToString(entry.family).c_str(), entry.priority);
@@ -321,7 +354,7 @@ bool RoutingPolicyService::ApplyRule(uint32_t interface_index,
     message->SetAttribute(FRA_SRC, entry.src.address().ToBytes());
   }
 
-  return rtnl_handler_->SendMessage(std::move(message), nullptr);
+  return message;
 }
 
 const std::vector<uint32_t>& RoutingPolicyService::GetUserTrafficUids() {
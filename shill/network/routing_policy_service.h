@@ -82,6 +82,13 @@ class RoutingPolicyService {
   // Add an entry to the routing rule table.
   virtual bool AddRule(int interface_index, const RoutingPolicyEntry& entry);
 
+  // Add a set of entries to the routing rule table. The rules are sent to the
+  // kernel together in as few netlink writes as possible. All the entries are
+  // recorded even if some failed to be sent, such that FlushRules() removes the
+  // ones that made it to the kernel. Returns false if any rule failed.
+  virtual bool AddRules(int interface_index,
+                        const std::vector<RoutingPolicyEntry>& entries);
+
   // Flush all routing rules for |interface_index|.
   virtual void FlushRules(int interface_index);
 
@@ -104,10 +111,15 @@ class RoutingPolicyService {
 
   void RuleMsgHandler(const RTNLMessage& message);
 
-  bool ApplyRule(uint32_t interface_index,
-                 const RoutingPolicyEntry& entry,
-                 RTNLMessage::Mode mode,
-                 unsigned int flags);
+  // Records |entry| into the policy table of |interface_index| if no identical
+  // entry exists.
+  void RecordRule(int interface_index, const RoutingPolicyEntry& entry);
+
+  std::unique_ptr<RTNLMessage> CreateRuleMessage(
+      uint32_t interface_index,
+      const RoutingPolicyEntry& entry,
+      RTNLMessage::Mode mode,
+      unsigned int flags);
   std::optional<RoutingPolicyEntry> ParseRoutingPolicyMessage(
       const RTNLMessage& message);
 
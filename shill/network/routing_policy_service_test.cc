@@ -8,6 +8,8 @@
 #include <linux/rtnetlink.h>
 #include <sys/socket.h>
 
+#include <vector>
+
 #include <base/memory/ptr_util.h>
 #include <net-base/ip_address.h>
 
@@ -107,4 +109,40 @@ TEST_F(RoutingPolicyServiceTest, PolicyRuleAddFlush) {
   EXPECT_EQ(CountRoutingPolicyEntries(), 0);
 }
 
+TEST_F(RoutingPolicyServiceTest, PolicyRuleAddRules) {
+  Start();
+
+  const int iface_id = 3;
+  std::vector<RoutingPolicyEntry> rules;
+  for (const auto family : net_base::kIPFamilies) {
+    auto rule = RoutingPolicyEntry(family);
+    rule.priority = 100;
+    rule.table = 1001;
+    rule.oif_name = "eth0";
+    rules.push_back(rule);
+  }
+  // A duplicate entry is only recorded once.
+  rules.push_back(rules.front());
+
+  EXPECT_CALL(rtnl_handler_, DoSendMessage(_, _))
+      .Times(3)
+      .WillRepeatedly(Return(true));
+  EXPECT_TRUE(rule_table_->AddRules(iface_id, rules));
+  EXPECT_EQ(CountRoutingPolicyEntries(), 2);
+
+  // Entries are recorded even if sending failed, so that they are flushed.
+  auto rule = RoutingPolicyEntry(net_base::IPFamily::kIPv4);
+  rule.priority = 101;
+  rule.table = 1001;
+  EXPECT_CALL(rtnl_handler_, DoSendMessage(_, _)).WillOnce(Return(false));
+  EXPECT_FALSE(rule_table_->AddRules(iface_id, {rule}));
+  EXPECT_EQ(CountRoutingPolicyEntries(), 3);
+
+  EXPECT_CALL(rtnl_handler_, DoSendMessage(_, _))
+      .Times(3)
+      .WillRepeatedly(Return(true));
+  rule_table_->FlushRules(iface_id);
+  EXPECT_EQ(CountRoutingPolicyEntries(), 0);
+}
+
 }  // namespace shill
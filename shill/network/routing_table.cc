@@ -18,9 +18,12 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include <base/check.h>
 #include <base/check_op.h>
@@ -127,11 +130,34 @@ bool ParseRoutingTableMessage(const RTNLMessage& message,
 
   return true;
 }
+
+// Returns true if |a| and |b| are the same route from the point of view of
+// RouteMsgHandler(), regardless of their table.
+bool IsSameRoute(const RoutingTableEntry& a, const RoutingTableEntry& b) {
+  // clang-format off
+  return a.dst == b.dst &&
+         a.src == b.src &&
+         a.gateway == b.gateway &&
+         a.scope == b.scope &&
+         a.metric == b.metric &&
+         a.type == b.type;
+  // clang-format on
+}
 }  // namespace
 
 // These don't have named constants in the system header files, but they
 // are documented in ip-rule(8) and hardcoded in net/ipv4/fib_rules.c.
 
+RoutingTable::RouteKey::RouteKey(uint32_t table, const net_base::IPCIDR& dst)
+    : table(table),
+      prefix(dst.GetPrefixCIDR().address()),
+      prefix_length(dst.prefix_length()) {}
+
+bool RoutingTable::RouteKey::operator<(const RouteKey& b) const {
+  return std::tie(table, prefix, prefix_length) <
+         std::tie(b.table, b.prefix, b.prefix_length);
+}
+
 RoutingTable::RoutingTable() : rtnl_handler_(RTNLHandler::GetInstance()) {
   SLOG(2) << __func__;
 }
@@ -178,7 +204,10 @@ void RoutingTable::RegisterDevice(int interface_index,
     new_entry.table = table_id;
     AddRouteToKernelTable(interface_index, new_entry);
     RemoveRouteFromKernelTable(interface_index, nent);
+    EraseRouteFromIndex(interface_index, nent);
     nent.table = table_id;
+    route_index_.emplace(RouteKey(nent.table, nent.dst),
+                         std::make_pair(interface_index, nent));
   }
 
   // Set accept_ra_rt_table to -N to cause routes created by the reception of
@@ -228,7 +257,7 @@ bool RoutingTable::AddRoute(int interface_index,
   if (!AddRouteToKernelTable(interface_index, entry)) {
     return false;
   }
-  tables_[interface_index].push_back(entry);
+  InsertRoute(interface_index, entry);
   return true;
 }
 
@@ -241,6 +270,7 @@ bool RoutingTable::RemoveRoute(int interface_index,
   for (auto nent = table.begin(); nent != table.end(); ++nent) {
     if (*nent == entry) {
       table.erase(nent);
+      EraseRouteFromIndex(interface_index, entry);
       return true;
     }
   }
@@ -250,6 +280,76 @@ bool RoutingTable::RemoveRoute(int interface_index,
   return true;
 }
 
+bool RoutingTable::AddRoutes(int interface_index,
+                             const std::vector<RoutingTableEntry>& entries) {
+  for (const auto& entry : entries) {
+    if (entry.table != GetInterfaceTableId(interface_index) &&
+        entry.type != RTN_BLACKHOLE && entry.type != RTN_UNREACHABLE) {
+      LOG(ERROR) << "Can't add route to table " << entry.table
+                 << " when the interface's per-device table is "
+                 << GetInterfaceTableId(interface_index);
+      return false;
+    }
+  }
+
+  if (!ApplyRoutes(interface_index, entries, RTNLMessage::kModeAdd,
+                   NLM_F_CREATE | NLM_F_EXCL)) {
+    return false;
+  }
+  for (const auto& entry : entries) {
+    InsertRoute(interface_index, entry);
+  }
+  return true;
+}
+
+bool RoutingTable::RemoveRoutes(int interface_index,
+                                const std::vector<RoutingTableEntry>& entries) {
+  if (!ApplyRoutes(interface_index, entries, RTNLMessage::kModeDelete, 0)) {
+    return false;
+  }
+  RouteTableEntryVector& table = tables_[interface_index];
+  for (const auto& entry : entries) {
+    auto nent = std::find(table.begin(), table.end(), entry);
+    if (nent == table.end()) {
+      continue;
+    }
+    table.erase(nent);
+    EraseRouteFromIndex(interface_index, entry);
+  }
+  return true;
+}
+
+bool RoutingTable::LookupRoute(uint32_t table_id,
+                               const net_base::IPAddress& address,
+                               int* interface_index,
+                               RoutingTableEntry* entry) const {
+  // Probe the prefixes of |address| from the longest to the shortest, such
+  // that the lookup takes at most 33 (IPv4) or 129 (IPv6) searches in the
+  // index regardless of the number of routes.
+  for (int prefix_length =
+           net_base::IPCIDR::GetMaxPrefixLength(address.GetFamily());
+       prefix_length >= 0; --prefix_length) {
+    const auto dst =
+        net_base::IPCIDR::CreateFromAddressAndPrefix(address, prefix_length);
+    if (!dst) {
+      continue;
+    }
+    const auto range = route_index_.equal_range(RouteKey(table_id, *dst));
+    const std::pair<int, RoutingTableEntry>* best = nullptr;
+    for (auto it = range.first; it != range.second; ++it) {
+      if (!best || it->second.second.metric < best->second.metric) {
+        best = &it->second;
+      }
+    }
+    if (best) {
+      *interface_index = best->first;
+      *entry = best->second;
+      return true;
+    }
+  }
+  return false;
+}
+
 bool RoutingTable::GetDefaultRoute(int interface_index,
                                    net_base::IPFamily family,
                                    RoutingTableEntry* entry) {
@@ -354,8 +454,9 @@ void RoutingTable::FlushRoutes(int interface_index) {
     return;
   }
 
+  ApplyRoutes(interface_index, table->second, RTNLMessage::kModeDelete, 0);
   for (const auto& nent : table->second) {
-    RemoveRouteFromKernelTable(interface_index, nent);
+    EraseRouteFromIndex(interface_index, nent);
   }
   table->second.clear();
 }
@@ -363,20 +464,66 @@ void RoutingTable::FlushRoutes(int interface_index) {
 void RoutingTable::FlushRoutesWithTag(int tag, net_base::IPFamily family) {
   SLOG(2) << __func__;
 
+  std::vector<std::unique_ptr<RTNLMessage>> messages;
   for (auto& table : tables_) {
     for (auto nent = table.second.begin(); nent != table.second.end();) {
       if (nent->tag == tag && nent->dst.GetFamily() == family) {
-        RemoveRouteFromKernelTable(table.first, *nent);
+        SLOG(2) << __func__ << ": "
+                << " index " << table.first << " " << *nent;
+        messages.push_back(CreateRouteMessage(table.first, *nent,
+                                              RTNLMessage::kModeDelete, 0));
+        EraseRouteFromIndex(table.first, *nent);
         nent = table.second.erase(nent);
       } else {
         ++nent;
       }
     }
   }
+  if (!messages.empty()) {
+    rtnl_handler_->SendMessages(std::move(messages));
+  }
 }
 
 void RoutingTable::ResetTable(int interface_index) {
-  tables_.erase(interface_index);
+  auto table = tables_.find(interface_index);
+  if (table == tables_.end()) {
+    return;
+  }
+  for (const auto& nent : table->second) {
+    EraseRouteFromIndex(interface_index, nent);
+  }
+  tables_.erase(table);
+}
+
+void RoutingTable::InsertRoute(int interface_index,
+                               const RoutingTableEntry& entry) {
+  tables_[interface_index].push_back(entry);
+  route_index_.emplace(RouteKey(entry.table, entry.dst),
+                       std::make_pair(interface_index, entry));
+}
+
+void RoutingTable::EraseRouteFromIndex(int interface_index,
+                                       const RoutingTableEntry& entry) {
+  const auto range = route_index_.equal_range(RouteKey(entry.table, entry.dst));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.first == interface_index && it->second.second == entry) {
+      route_index_.erase(it);
+      return;
+    }
+  }
+}
+
+bool RoutingTable::HasMatchingRoute(int interface_index,
+                                    uint32_t table,
+                                    const RoutingTableEntry& entry) const {
+  const auto range = route_index_.equal_range(RouteKey(table, entry.dst));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.first == interface_index &&
+        IsSameRoute(it->second.second, entry)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 bool RoutingTable::AddRouteToKernelTable(int interface_index,
@@ -422,7 +569,6 @@ void RoutingTable::RouteMsgHandler(const RTNLMessage& message) {
   SLOG(2) << __func__ << " " << RTNLMessage::ModeToString(message.mode())
           << " index: " << interface_index << " entry: " << entry;
 
-  bool entry_exists = false;
   bool is_managed = (managed_interfaces_.count(interface_index) != 0);
   uint32_t target_table = GetInterfaceTableId(interface_index);
   // Routes that make it here are either:
@@ -438,43 +584,39 @@ void RoutingTable::RouteMsgHandler(const RTNLMessage& message) {
   // be tracked by Shill. In the future, each service could use a unique
   // protocol value, such that Shill would be able to determine which service
   // created a particular route.
+  //
+  // Lookups go through |route_index_| such that handling a message does not
+  // scan all the routes of the interface, which can be numerous with VPNs.
   RouteTableEntryVector& table = tables_[interface_index];
-  for (auto nent = table.begin(); nent != table.end();) {
-    // clang-format off
-    if (nent->dst != entry.dst ||
-        nent->src != entry.src ||
-        nent->gateway != entry.gateway ||
-        nent->scope != entry.scope ||
-        nent->metric != entry.metric ||
-        nent->type != entry.type) {
-      ++nent;
-      continue;
-    }
-    // clang-format on
-
-    if (message.mode() == RTNLMessage::kModeAdd &&
-        (is_managed || entry.table == nent->table)) {
-      // Set this to true to avoid adding the same route twice to
-      // tables_[interface_index].
-      entry_exists = true;
-      break;
+  if (message.mode() == RTNLMessage::kModeDelete) {
+    if (!HasMatchingRoute(interface_index, entry.table, entry)) {
+      return;
     }
-
-    if (message.mode() == RTNLMessage::kModeDelete &&
-        entry.table == nent->table) {
-      // Keep track of route deletions that come from outside of shill. Continue
-      // the loop for resilience to any failure scenario in which
-      // tables_[interface_index] has duplicate entries.
-      nent = table.erase(nent);
-    } else {
-      ++nent;
+    // Keep track of route deletions that come from outside of shill. Remove
+    // all the matching entries for resilience to any failure scenario in which
+    // tables_[interface_index] has duplicate entries.
+    for (auto nent = table.begin(); nent != table.end();) {
+      if (nent->table == entry.table && IsSameRoute(*nent, entry)) {
+        EraseRouteFromIndex(interface_index, *nent);
+        nent = table.erase(nent);
+      } else {
+        ++nent;
+      }
     }
+    return;
   }
 
   if (message.mode() != RTNLMessage::kModeAdd) {
     return;
   }
 
+  // Normal routes of a managed interface are always kept in its per-Device
+  // table, thus only that table and the table of |entry| need to be checked to
+  // avoid adding the same route twice to tables_[interface_index].
+  bool entry_exists =
+      HasMatchingRoute(interface_index, entry.table, entry) ||
+      (is_managed && HasMatchingRoute(interface_index, target_table, entry));
+
   // We do not want normal entries for a managed interface to be added to any
   // table but the per-Device routing table. Thus we remove the added route here
   // and re-add it to the per-Device routing table.
@@ -487,7 +629,7 @@ void RoutingTable::RouteMsgHandler(const RTNLMessage& message) {
   }
 
   if (!entry_exists) {
-    table.push_back(entry);
+    InsertRoute(interface_index, entry);
   }
 }
 
@@ -495,6 +637,32 @@ bool RoutingTable::ApplyRoute(uint32_t interface_index,
                               const RoutingTableEntry& entry,
                               RTNLMessage::Mode mode,
                               unsigned int flags) {
+  return rtnl_handler_->SendMessage(
+      CreateRouteMessage(interface_index, entry, mode, flags), nullptr);
+}
+
+bool RoutingTable::ApplyRoutes(int interface_index,
+                               const std::vector<RoutingTableEntry>& entries,
+                               RTNLMessage::Mode mode,
+                               unsigned int flags) {
+  if (entries.empty()) {
+    return true;
+  }
+  std::vector<std::unique_ptr<RTNLMessage>> messages;
+  messages.reserve(entries.size());
+  for (const auto& entry : entries) {
+    SLOG(2) << __func__ << ": "
+            << " index " << interface_index << " " << entry;
+    messages.push_back(CreateRouteMessage(interface_index, entry, mode, flags));
+  }
+  return rtnl_handler_->SendMessages(std::move(messages));
+}
+
+std::unique_ptr<RTNLMessage> RoutingTable::CreateRouteMessage(
+    uint32_t interface_index,
+    const RoutingTableEntry& entry,
+    RTNLMessage::Mode mode,
+    unsigned int flags) {
   DCHECK(entry.table != RT_TABLE_UNSPEC && entry.table != RT_TABLE_COMPAT)
       << "Attempted to apply route: " << entry;
 
@@ -532,7 +700,7 @@ bool RoutingTable::ApplyRoute(uint32_t interface_index,
         RTA_OIF, net_base::byte_utils::ToBytes<uint32_t>(interface_index));
   }
 
-  return rtnl_handler_->SendMessage(std::move(message), nullptr);
+  return message;
 }
 
 bool RoutingTable::CreateBlackholeRoute(int interface_index,
@@ -5,6 +5,7 @@
 #ifndef SHILL_NETWORK_ROUTING_TABLE_H_
 #define SHILL_NETWORK_ROUTING_TABLE_H_
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -69,6 +70,23 @@ class RoutingTable {
   // Remove an entry from the routing table.
   virtual bool RemoveRoute(int interface_index, const RoutingTableEntry& entry);
 
+  // Add or remove multiple entries of the routing table, sending the requests
+  // to the kernel in batches. AddRoutes() does not add any entry if one of
+  // |entries| would be rejected by AddRoute().
+  virtual bool AddRoutes(int interface_index,
+                         const std::vector<RoutingTableEntry>& entries);
+  virtual bool RemoveRoutes(int interface_index,
+                            const std::vector<RoutingTableEntry>& entries);
+
+  // Get the route of table |table_id| with the longest destination prefix
+  // containing |address|, preferring the lowest metric among the routes of
+  // that prefix. The route is copied into |*entry| and the index of its
+  // interface into |*interface_index|.
+  virtual bool LookupRoute(uint32_t table_id,
+                           const net_base::IPAddress& address,
+                           int* interface_index,
+                           RoutingTableEntry* entry) const;
+
   // Get the default route associated with an interface of a given addr family.
   // The route is copied into |*entry|.
   virtual bool GetDefaultRoute(int interface_index,
@@ -120,6 +138,36 @@ class RoutingTable {
   using RouteTableEntryVector = std::vector<RoutingTableEntry>;
   using RouteTables = std::unordered_map<int, RouteTableEntryVector>;
 
+  // Destination prefix of a route within a routing table. |prefix| is the
+  // destination address with its host bits cleared.
+  struct RouteKey {
+    RouteKey(uint32_t table, const net_base::IPCIDR& dst);
+
+    bool operator<(const RouteKey& b) const;
+
+    uint32_t table;
+    net_base::IPAddress prefix;
+    int prefix_length;
+  };
+  // Index of the entries of |tables_| by routing table and destination prefix.
+  // Values are the interface index and the entry.
+  using RouteIndex = std::multimap<RouteKey, std::pair<int, RoutingTableEntry>>;
+
+  // Add |entry| to |tables_| and |route_index_|.
+  void InsertRoute(int interface_index, const RoutingTableEntry& entry);
+  // Remove |entry| from |route_index_|.
+  void EraseRouteFromIndex(int interface_index, const RoutingTableEntry& entry);
+  // Returns true if there is a route of |interface_index| in table |table| with
+  // the same destination, source, gateway, scope, metric and type as |entry|.
+  bool HasMatchingRoute(int interface_index,
+                        uint32_t table,
+                        const RoutingTableEntry& entry) const;
+  // Send requests in |mode| for |entries| of |interface_index| in a batch.
+  bool ApplyRoutes(int interface_index,
+                   const std::vector<RoutingTableEntry>& entries,
+                   RTNLMessage::Mode mode,
+                   unsigned int flags);
+
   // Add an entry to the kernel routing table without modifying the internal
   // routing-table bookkeeping.
   bool AddRouteToKernelTable(int interface_index,
@@ -134,6 +182,12 @@ class RoutingTable {
                   const RoutingTableEntry& entry,
                   RTNLMessage::Mode mode,
                   unsigned int flags);
+  // Build the request of ApplyRoute().
+  std::unique_ptr<RTNLMessage> CreateRouteMessage(
+      uint32_t interface_index,
+      const RoutingTableEntry& entry,
+      RTNLMessage::Mode mode,
+      unsigned int flags);
   // Get the default route associated with an interface of a given addr family.
   // A pointer to the route is placed in |*entry|.
   virtual bool GetDefaultRouteInternal(int interface_index,
@@ -141,6 +195,7 @@ class RoutingTable {
                                        RoutingTableEntry** entry);
 
   RouteTables tables_;
+  RouteIndex route_index_;
   std::set<int> managed_interfaces_;
 
   std::unique_ptr<RTNLListener> route_listener_;
@@ -458,4 +458,142 @@ TEST_F(RoutingTableTest, CreateBlackholeRoute) {
       kTestDeviceIndex0, net_base::IPFamily::kIPv6, kMetric, kTestTable));
 }
 
+TEST_F(RoutingTableTest, LookupRoute) {
+  const uint32_t table_id =
+      RoutingTable::GetInterfaceTableId(kTestDeviceIndex0);
+  const auto default_address = net_base::IPCIDR(net_base::IPFamily::kIPv4);
+  const auto gateway_address0 =
+      *net_base::IPAddress::CreateFromString(kTestNetAddress0);
+  const auto gateway_address1 =
+      *net_base::IPAddress::CreateFromString(kTestNetAddress1);
+  const auto network16 =
+      *net_base::IPCIDR::CreateFromCIDRString("192.168.0.0/16");
+  const auto network24 =
+      *net_base::IPCIDR::CreateFromCIDRString(kTestDeviceNetAddress4);
+
+  const auto default_entry =
+      RoutingTableEntry(default_address, default_address, gateway_address0)
+          .SetMetric(10)
+          .SetTable(table_id);
+  const auto entry16 =
+      RoutingTableEntry(network16, default_address, gateway_address1)
+          .SetMetric(10)
+          .SetTable(table_id);
+  const auto entry24 =
+      RoutingTableEntry(network24, default_address,
+                        net_base::IPAddress(net_base::IPFamily::kIPv4))
+          .SetMetric(20)
+          .SetTable(table_id);
+  auto entry24_low_metric = entry24;
+  entry24_low_metric.SetMetric(5);
+  SendRouteEntry(RTNLMessage::kModeAdd, kTestDeviceIndex0, default_entry);
+  SendRouteEntry(RTNLMessage::kModeAdd, kTestDeviceIndex1, entry16);
+  SendRouteEntry(RTNLMessage::kModeAdd, kTestDeviceIndex0, entry24);
+  SendRouteEntry(RTNLMessage::kModeAdd, kTestDeviceIndex1, entry24_low_metric);
+
+  int interface_index;
+  RoutingTableEntry entry(net_base::IPFamily::kIPv4);
+  // The longest prefix wins, then the lowest metric.
+  EXPECT_TRUE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("192.168.2.2"),
+      &interface_index, &entry));
+  EXPECT_EQ(kTestDeviceIndex1, interface_index);
+  EXPECT_EQ(entry24_low_metric, entry);
+  EXPECT_TRUE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("192.168.3.1"),
+      &interface_index, &entry));
+  EXPECT_EQ(kTestDeviceIndex1, interface_index);
+  EXPECT_EQ(entry16, entry);
+  EXPECT_TRUE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("10.0.0.1"),
+      &interface_index, &entry));
+  EXPECT_EQ(kTestDeviceIndex0, interface_index);
+  EXPECT_EQ(default_entry, entry);
+
+  // Routes of other families or tables are not considered.
+  EXPECT_FALSE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString(kTestV6NetAddress0),
+      &interface_index, &entry));
+  EXPECT_FALSE(routing_table_->LookupRoute(
+      table_id + 1, *net_base::IPAddress::CreateFromString("192.168.2.2"),
+      &interface_index, &entry));
+
+  // Removed routes are no longer returned.
+  SendRouteEntry(RTNLMessage::kModeDelete, kTestDeviceIndex1,
+                 entry24_low_metric);
+  EXPECT_TRUE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("192.168.2.2"),
+      &interface_index, &entry));
+  EXPECT_EQ(kTestDeviceIndex0, interface_index);
+  EXPECT_EQ(entry24, entry);
+
+  routing_table_->ResetTable(kTestDeviceIndex1);
+  EXPECT_TRUE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("192.168.3.1"),
+      &interface_index, &entry));
+  EXPECT_EQ(kTestDeviceIndex0, interface_index);
+  EXPECT_EQ(default_entry, entry);
+
+  EXPECT_CALL(rtnl_handler_, DoSendMessage(_, _)).Times(2);
+  routing_table_->FlushRoutes(kTestDeviceIndex0);
+  EXPECT_FALSE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("10.0.0.1"),
+      &interface_index, &entry));
+}
+
+TEST_F(RoutingTableTest, AddRemoveRoutes) {
+  const uint32_t table_id =
+      RoutingTable::GetInterfaceTableId(kTestDeviceIndex0);
+  const auto default_address = net_base::IPCIDR(net_base::IPFamily::kIPv4);
+  const auto gateway_address =
+      *net_base::IPAddress::CreateFromString(kTestGatewayAddress4);
+  const std::vector<RoutingTableEntry> entries = {
+      RoutingTableEntry(
+          *net_base::IPCIDR::CreateFromCIDRString("10.0.0.0/8"),
+          default_address, gateway_address)
+          .SetTable(table_id),
+      RoutingTableEntry(
+          *net_base::IPCIDR::CreateFromCIDRString("172.16.0.0/12"),
+          default_address, gateway_address)
+          .SetTable(table_id),
+  };
+
+  // Routes to another table are rejected without sending any request.
+  auto foreign_entry = entries[0];
+  foreign_entry.SetTable(table_id + 1);
+  EXPECT_FALSE(routing_table_->AddRoutes(kTestDeviceIndex0,
+                                         {entries[0], foreign_entry}));
+  EXPECT_EQ(0, GetRoutingTables()->size());
+
+  for (const auto& entry : entries) {
+    EXPECT_CALL(rtnl_handler_,
+                DoSendMessage(IsRoutingPacket(RTNLMessage::kModeAdd,
+                                              kTestDeviceIndex0, entry,
+                                              NLM_F_CREATE | NLM_F_EXCL),
+                              _));
+  }
+  EXPECT_TRUE(routing_table_->AddRoutes(kTestDeviceIndex0, entries));
+  EXPECT_EQ(entries, (*GetRoutingTables())[kTestDeviceIndex0]);
+
+  int interface_index;
+  RoutingTableEntry entry(net_base::IPFamily::kIPv4);
+  EXPECT_TRUE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("172.20.1.1"),
+      &interface_index, &entry));
+  EXPECT_EQ(kTestDeviceIndex0, interface_index);
+  EXPECT_EQ(entries[1], entry);
+
+  for (const auto& entry : entries) {
+    EXPECT_CALL(rtnl_handler_,
+                DoSendMessage(IsRoutingPacket(RTNLMessage::kModeDelete,
+                                              kTestDeviceIndex0, entry, 0),
+                              _));
+  }
+  EXPECT_TRUE(routing_table_->RemoveRoutes(kTestDeviceIndex0, entries));
+  EXPECT_TRUE((*GetRoutingTables())[kTestDeviceIndex0].empty());
+  EXPECT_FALSE(routing_table_->LookupRoute(
+      table_id, *net_base::IPAddress::CreateFromString("172.20.1.1"),
+      &interface_index, &entry));
+}
+
 }  // namespace shill
@@ -170,6 +170,7 @@ void PortalDetector::StartTrialTask() {
   if (https_result != HttpRequest::kResultInProgress) {
     result_->https_phase = GetPortalPhaseForRequestResult(https_result);
     result_->https_status = GetPortalStatusForRequestResult(https_result);
+    result_->https_probe_completed = true;
     LOG(ERROR) << LoggingTag() << ": HTTPS probe failed to start";
     // To find the portal sign-in url, wait for the HTTP probe to complete
     // before completing the trial and calling |portal_result_callback_|.
@@ -418,7 +419,19 @@ std::string PortalDetector::LoggingTag() const {
 }
 
 bool PortalDetector::Result::IsComplete() const {
-  return http_probe_completed && https_probe_completed;
+  if (!http_probe_completed) {
+    return false;
+  }
+  if (https_probe_completed) {
+    return true;
+  }
+  // On captive portals the https probe is commonly blackholed and only ends
+  // with the request timeout. Since GetValidationState() ignores the https
+  // probe in these cases, there is no need to wait for it.
+  if (http_phase != Phase::kContent) {
+    return true;
+  }
+  return http_status == Status::kRedirect && !redirect_url_string.empty();
 }
 
 std::ostream& operator<<(std::ostream& stream, PortalDetector::Phase phase) {
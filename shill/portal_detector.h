@@ -158,7 +158,9 @@ class PortalDetector {
     bool https_probe_completed = false;
 
     // Returns true if both http and https probes have completed, successfully
-    // or not.
+    // or not, or if the http probe alone has completed with a result that
+    // decides the ValidationState regardless of the https probe: a failure
+    // before receiving any content, or a redirect to a portal sign-in page.
     bool IsComplete() const;
 
     // Returns the ValidationState value inferred from this captive portal
@@ -251,7 +253,10 @@ class PortalDetector {
   FRIEND_TEST(PortalDetectorTest, PickProbeUrlTest);
   FRIEND_TEST(PortalDetectorTest, RequestFail);
   FRIEND_TEST(PortalDetectorTest, RequestHTTPFailureHTTPSSuccess);
+  FRIEND_TEST(PortalDetectorTest, RequestHTTPFailureCompletesTrial);
   FRIEND_TEST(PortalDetectorTest, RequestRedirect);
+  FRIEND_TEST(PortalDetectorTest, RequestRedirectCompletesTrial);
+  FRIEND_TEST(PortalDetectorTest, RequestRedirectNoUrlWaitsForHttps);
   FRIEND_TEST(PortalDetectorTest, RequestSuccess);
   FRIEND_TEST(PortalDetectorTest, RequestTempRedirect);
   FRIEND_TEST(PortalDetectorTest, Restart);
@@ -509,6 +509,60 @@ TEST_F(PortalDetectorTest, RequestTempRedirect) {
   ExpectCleanupTrial();
 }
 
+TEST_F(PortalDetectorTest, RequestRedirectCompletesTrial) {
+  StartAttempt();
+
+  // A redirect with a sign-in URL completes the trial without waiting for the
+  // HTTPS probe.
+  PortalDetector::Result result;
+  result.http_phase = PortalDetector::Phase::kContent,
+  result.http_status = PortalDetector::Status::kRedirect;
+  result.https_phase = PortalDetector::Phase::kUnknown;
+  result.https_status = PortalDetector::Status::kFailure;
+  result.redirect_url_string = kHttpUrl;
+  result.probe_url_string = kHttpUrl;
+  EXPECT_CALL(callback_target(), ResultCallback(IsResult(result)));
+  EXPECT_CALL(*brillo_connection(), GetResponseHeader("Location"))
+      .WillOnce(Return(kHttpUrl));
+  ExpectRequestSuccessWithStatus(302, true);
+  ExpectCleanupTrial();
+}
+
+TEST_F(PortalDetectorTest, RequestRedirectNoUrlWaitsForHttps) {
+  StartAttempt();
+
+  EXPECT_CALL(callback_target(), ResultCallback(_)).Times(0);
+  EXPECT_CALL(*brillo_connection(), GetResponseHeader("Location"))
+      .WillOnce(Return(""));
+  ExpectRequestSuccessWithStatus(302, true);
+  EXPECT_TRUE(portal_detector()->IsInProgress());
+  Mock::VerifyAndClearExpectations(&callback_target());
+
+  PortalDetector::Result result;
+  result.http_phase = PortalDetector::Phase::kContent,
+  result.http_status = PortalDetector::Status::kRedirect;
+  result.https_phase = PortalDetector::Phase::kContent;
+  result.https_status = PortalDetector::Status::kSuccess;
+  EXPECT_CALL(callback_target(), ResultCallback(IsResult(result)));
+  ExpectRequestSuccessWithStatus(204, false);
+  ExpectCleanupTrial();
+}
+
+TEST_F(PortalDetectorTest, RequestHTTPFailureCompletesTrial) {
+  StartAttempt();
+
+  // A HTTP probe failing before receiving any content completes the trial
+  // without waiting for the HTTPS probe.
+  PortalDetector::Result result;
+  result.http_phase = PortalDetector::Phase::kDNS,
+  result.http_status = PortalDetector::Status::kTimeout;
+  result.https_phase = PortalDetector::Phase::kUnknown;
+  result.https_status = PortalDetector::Status::kFailure;
+  EXPECT_CALL(callback_target(), ResultCallback(IsResult(result)));
+  portal_detector()->HttpRequestErrorCallback(HttpRequest::kResultDNSTimeout);
+  ExpectCleanupTrial();
+}
+
 TEST_F(PortalDetectorTest, PhaseToString) {
   struct {
     PortalDetector::Phase phase;
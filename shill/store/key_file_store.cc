@@ -24,6 +24,7 @@
 #include <base/strings/string_split.h>
 #include <base/strings/string_util.h>
 #include <base/strings/stringprintf.h>
+#include <base/timer/elapsed_timer.h>
 #include <base/values.h>
 #include <brillo/scoped_umask.h>
 #include <fcntl.h>
@@ -169,14 +170,19 @@ class Group {
   Group(const Group&) = delete;
   Group& operator=(const Group&) = delete;
 
-  void Set(const std::string& key, const std::string& value) {
+  // Returns false if |key| already had |value|.
+  bool Set(const std::string& key, const std::string& value) {
     if (index_.count(key) > 0) {
+      if (index_[key]->second == value) {
+        return false;
+      }
       index_[key]->second = value;
-      return;
+      return true;
     }
 
     entries_.push_back({key, value});
     index_[key] = &entries_.back();
+    return true;
   }
 
   std::optional<std::string> Get(const std::string& key) const {
@@ -313,7 +319,9 @@ class KeyFileStore::KeyFile {
       index_[group] = &groups_.back();
     }
 
-    index_[group]->Set(key, value);
+    if (index_[group]->Set(key, value)) {
+      dirty_ = true;
+    }
   }
 
   std::optional<std::string> Get(const std::string& group,
@@ -332,7 +340,11 @@ class KeyFileStore::KeyFile {
       return false;
     }
 
-    return it->second->Delete(key);
+    if (!it->second->Delete(key)) {
+      return false;
+    }
+    dirty_ = true;
+    return true;
   }
 
   bool HasGroup(const std::string& group) const {
@@ -348,6 +360,7 @@ class KeyFileStore::KeyFile {
     Group* grp = it->second;
     index_.erase(it);
     base::EraseIf(groups_, [grp](const Group& g) { return &g == grp; });
+    dirty_ = true;
     return true;
   }
 
@@ -363,13 +376,25 @@ class KeyFileStore::KeyFile {
     const auto lines = base::SplitString(header, "\n", base::KEEP_WHITESPACE,
                                          base::SPLIT_WANT_ALL);
 
-    pre_group_comments_.clear();
+    std::list<std::string> comments;
     for (const std::string& line : lines) {
-      pre_group_comments_.push_back("#" + line);
+      comments.push_back("#" + line);
+    }
+    if (comments != pre_group_comments_) {
+      pre_group_comments_ = std::move(comments);
+      dirty_ = true;
     }
   }
 
-  bool Flush() const {
+  // Writes the key file out, unless nothing changed since it was last
+  // written. Services save all their properties whenever one of them changes,
+  // so most flushes would otherwise rewrite identical contents.
+  bool Flush() {
+    if (!dirty_ && base::PathExists(path_)) {
+      return true;
+    }
+
+    base::ElapsedTimer timer;
     std::string to_write;
     for (const std::string& line : pre_group_comments_) {
       to_write += line + '\n';
@@ -383,6 +408,9 @@ class KeyFileStore::KeyFile {
       LOG(ERROR) << "Failed to store key file: " << path_.value();
       return false;
     }
+    dirty_ = false;
+    SLOG(2) << "Wrote " << to_write.size() << " bytes to " << path_.value()
+            << " in " << timer.Elapsed();
     return true;
   }
 
@@ -402,6 +430,9 @@ class KeyFileStore::KeyFile {
   std::list<std::string> pre_group_comments_;
   std::list<Group> groups_;
   std::map<std::string, Group*> index_;
+  // Whether the contents changed since the file was last written. The first
+  // flush always writes, which normalizes the file that was read.
+  bool dirty_ = true;
 };
 
 const char KeyFileStore::kCorruptSuffix[] = ".corrupted";
@@ -1010,6 +1010,29 @@ TEST_F(KeyFileStoreTest, Flush) {
   ASSERT_TRUE(store_->Flush());
   ASSERT_FALSE(OpenCheckClose(test_file_, kGroup, kKey1, kValue1));
 }
+
+TEST_F(KeyFileStoreTest, FlushSkipsUnchangedContents) {
+  static const char kGroup[] = "string-group";
+  static const char kKey[] = "test-string";
+  static const char kValue1[] = "foo";
+  static const char kValue2[] = "bar";
+  static const char kMarker[] = "# not rewritten\n";
+  ASSERT_TRUE(store_->Open());
+  ASSERT_TRUE(store_->SetString(kGroup, kKey, kValue1));
+  ASSERT_TRUE(store_->Flush());
+
+  // Setting a key to the value it already has doesn't rewrite the file.
+  ASSERT_TRUE(base::WriteFile(test_file_, kMarker));
+  ASSERT_TRUE(store_->SetString(kGroup, kKey, kValue1));
+  ASSERT_TRUE(store_->Flush());
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(test_file_, &contents));
+  EXPECT_EQ(kMarker, contents);
+
+  ASSERT_TRUE(store_->SetString(kGroup, kKey, kValue2));
+  ASSERT_TRUE(store_->Close());
+  ASSERT_TRUE(OpenCheckClose(test_file_, kGroup, kKey, kValue2));
+}
 }  // namespace
 
 TEST_F(KeyFileStoreTest, EmptyFile) {
@@ -8,6 +8,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <base/check.h>
@@ -40,6 +41,8 @@ using KeyValueTypes = brillo::TypeList<bool,
                                        std::vector<int32_t>,
                                        std::vector<int64_t>,
                                        std::vector<double>,
+                                       std::vector<std::tuple<uint32_t,
+                                                              uint32_t>>,
 
                                        KeyValueStore,
                                        std::string,
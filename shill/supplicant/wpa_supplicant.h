@@ -163,6 +163,7 @@ class WPASupplicant {
   static constexpr char kPropertyPrivacy[] = "Privacy";
   static constexpr char kPropertyRSN[] = "RSN";
   static constexpr char kPropertyScanAllowRoam[] = "AllowRoam";
+  static constexpr char kPropertyScanChannels[] = "Channels";
   static constexpr char kPropertyScanSSIDs[] = "SSIDs";
   static constexpr char kPropertyScanType[] = "Type";
   static constexpr char kPropertySecurityProtocol[] = "proto";
@@ -62,6 +62,10 @@ class MockWiFiProvider : public WiFiProvider {
               OnEndpointUpdated,
               (const WiFiEndpointConstRefPtr&),
               (override));
+  MOCK_METHOD(void,
+              OnEndpointsUpdated,
+              (const std::vector<WiFiEndpointConstRefPtr>&),
+              (override));
   MOCK_METHOD(bool,
               OnServiceUnloaded,
               (const WiFiServiceRefPtr&, const PasspointCredentialsRefPtr&),
@@ -19,10 +19,12 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <base/check.h>
+#include <base/containers/contains.h>
 #include <base/files/file_util.h>
 #include <base/functional/bind.h>
 #include <base/logging.h>
@@ -314,6 +316,7 @@ void WiFi::Stop(EnabledStateChangedCallback callback) {
     supplicant_process_proxy()->RemoveInterface(supplicant_interface_path_);
   }
   pending_scan_results_.reset();
+  pending_endpoint_updates_.clear();
   current_service_ = nullptr;  // breaks a reference cycle
   pending_service_ = nullptr;  // breaks a reference cycle
   // Reset autoconnect cooldown time for all WiFi services to 0. When WiFi
@@ -874,7 +877,24 @@ void WiFi::ClearCachedCredentials(const WiFiService* service) {
 }
 
 void WiFi::NotifyEndpointChanged(const WiFiEndpointConstRefPtr& endpoint) {
-  provider_->OnEndpointUpdated(endpoint);
+  if (base::Contains(pending_endpoint_updates_, endpoint)) {
+    return;
+  }
+  if (pending_endpoint_updates_.empty()) {
+    dispatcher()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&WiFi::PendingEndpointUpdatesHandler,
+                       weak_ptr_factory_while_started_.GetWeakPtr()));
+  }
+  pending_endpoint_updates_.push_back(endpoint);
+}
+
+void WiFi::PendingEndpointUpdatesHandler() {
+  SLOG(this, 2) << __func__ << " with " << pending_endpoint_updates_.size()
+                << " updated endpoints";
+  std::vector<WiFiEndpointConstRefPtr> endpoints;
+  endpoints.swap(pending_endpoint_updates_);
+  provider_->OnEndpointsUpdated(endpoints);
 }
 
 std::string WiFi::AppendBgscan(WiFiService* service,
@@ -1102,6 +1122,7 @@ void WiFi::CurrentBSSChanged(const RpcIdentifier& new_bss) {
   supplicant_bss_ = new_bss;
   has_already_completed_ = false;
   is_roaming_in_progress_ = false;
+  roam_scan_interval_ = kRoamScanMinInterval;
   if (current_service_) {
     current_service_->SetIsRekeyInProgress(false);
   }
@@ -2208,6 +2229,9 @@ void WiFi::PropertiesChangedTask(const KeyValueStore& properties) {
           WPASupplicant::kSignalChangeProperty)) {
     SignalChanged(
         properties.Get<KeyValueStore>(WPASupplicant::kSignalChangeProperty));
+    // Only CQM events may trigger a roam scan: the periodic signal polls
+    // would keep scanning while the signal stays weak.
+    ScanForRoamCandidates();
   }
 }
 
@@ -2228,6 +2252,71 @@ void WiFi::SignalChanged(const KeyValueStore& properties) {
   HandleUpdatedLinkStatistics();
 }
 
+void WiFi::ScanForRoamCandidates() {
+  if (!IsConnectedToCurrentService() || !manager()->scan_allow_roam() ||
+      wifi_state_->GetPhyState() != WiFiState::PhyState::kIdle) {
+    return;
+  }
+  const int16_t signal = current_service_->SignalLevel();
+  if (signal >= bgscan_signal_threshold_dbm_) {
+    return;
+  }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (!last_roam_scan_time_.is_null() &&
+      now - last_roam_scan_time_ < roam_scan_interval_) {
+    return;
+  }
+
+  // Use the BSSes of the current service from the last scan results rather
+  // than probing every channel.
+  std::set<uint32_t> frequencies;
+  bool has_other_bss = false;
+  for (const auto& [rpcid, endpoint] : endpoint_by_rpcid_) {
+    if (provider_->FindServiceForEndpoint(endpoint) != current_service_) {
+      continue;
+    }
+    if (rpcid != supplicant_bss_) {
+      has_other_bss = true;
+    }
+    if (endpoint->frequency() != 0) {
+      frequencies.insert(endpoint->frequency());
+    }
+  }
+  if (!has_other_bss || frequencies.empty()) {
+    return;
+  }
+
+  // wpa_supplicant scans the frequency |center - width / 2| of each entry, so
+  // a width of 0 selects the channel itself.
+  std::vector<std::tuple<uint32_t, uint32_t>> channels;
+  for (const auto frequency : frequencies) {
+    channels.emplace_back(frequency, 0);
+  }
+  KeyValueStore scan_args;
+  scan_args.Set<std::string>(WPASupplicant::kPropertyScanType,
+                             WPASupplicant::kScanTypeActive);
+  scan_args.Set<std::vector<std::tuple<uint32_t, uint32_t>>>(
+      WPASupplicant::kPropertyScanChannels, channels);
+  if (current_service_->hidden_ssid()) {
+    scan_args.Set<ByteArrays>(WPASupplicant::kPropertyScanSSIDs,
+                              {current_service_->ssid()});
+  }
+  scan_args.Set<bool>(WPASupplicant::kPropertyScanAllowRoam, true);
+
+  LOG(INFO) << link_name() << ": signal " << signal << " dBm, scanning "
+            << channels.size() << " channel(s) for roam candidates";
+  last_roam_scan_time_ = now;
+  // Back off until the next roam, since scanning again is unlikely to find a
+  // better BSS than this scan.
+  roam_scan_interval_ = std::min(2 * roam_scan_interval_, kRoamScanMaxInterval);
+  if (!supplicant_interface_proxy_->Scan(scan_args)) {
+    LOG(WARNING) << "Roam scan failed";
+    return;
+  }
+  SetPhyState(WiFiState::PhyState::kBackgroundScanning,
+              WiFiState::ScanMethod::kPartial, __func__);
+}
+
 std::string WiFi::GetSuffixFromAuthMode(const std::string& auth_mode) const {
   if (auth_mode == WPASupplicant::kAuthModeWPAPSK ||
       auth_mode == WPASupplicant::kAuthModeWPA2PSK ||
@@ -414,6 +414,10 @@ class WiFi : public Device, public SupplicantEventDelegateInterface {
   // Time to wait after failing to launch a scan before resetting the scan state
   // to idle.
   static constexpr base::TimeDelta kPostScanFailedDelay = base::Seconds(10);
+  // Minimum time between two scans for roam candidates. It doubles with each
+  // scan, up to kRoamScanMaxInterval, until the device roams.
+  static constexpr base::TimeDelta kRoamScanMinInterval = base::Seconds(30);
+  static constexpr base::TimeDelta kRoamScanMaxInterval = base::Minutes(8);
   // Used when enabling MAC randomization to request that the OUI remain
   // constant and the last three octets are randomized.
   static const std::vector<unsigned char> kRandomMacMask;
@@ -474,6 +478,11 @@ class WiFi : public Device, public SupplicantEventDelegateInterface {
   void DisconnectReasonChanged(const int32_t new_disconnect_reason);
   void CurrentAuthModeChanged(const std::string& auth_mode);
   void SignalChanged(const KeyValueStore& properties);
+  // On a CQM event, if the signal of the current service is below the bgscan
+  // threshold, scans the channels where other BSSes of the service were last
+  // seen, so that wpa_supplicant can roam without waiting for a full
+  // background scan.
+  void ScanForRoamCandidates();
   // Return the correct Metrics suffix (PSK, FTPSK, EAP, FTEAP) corresponding to
   // the current service's authentication mode.
   std::string GetSuffixFromAuthMode(const std::string& auth_mode) const;
@@ -730,6 +739,10 @@ class WiFi : public Device, public SupplicantEventDelegateInterface {
   // Callback invoked to handle pending scan results from AddPendingScanResult.
   void PendingScanResultsHandler();
 
+  // Callback invoked to pass the endpoints updated since it was posted by
+  // NotifyEndpointChanged to the provider at once.
+  void PendingEndpointUpdatesHandler();
+
   // Given a NL80211_CMD_NEW_WIPHY message |nl80211_message|, parses the
   // feature flags and sets members of this WiFi class appropriately.
   void ParseFeatureFlags(const Nl80211Message& nl80211_message);
@@ -909,6 +922,11 @@ class WiFi : public Device, public SupplicantEventDelegateInterface {
   // closure for processing the pending tasks in PendingScanResultsHandler().
   std::unique_ptr<PendingScanResults> pending_scan_results_;
 
+  // Endpoints updated since the last call to PendingEndpointUpdatesHandler().
+  // Updates of the BSSes of a scan arrive as separate D-Bus signals, batching
+  // them lets services and the Manager process them once.
+  std::vector<WiFiEndpointConstRefPtr> pending_endpoint_updates_;
+
   std::unique_ptr<WiFiState> wifi_state_;
 
   // Indicates if the last scan skipped the broadcast probe.
@@ -930,6 +948,11 @@ class WiFi : public Device, public SupplicantEventDelegateInterface {
   // Timestamp of the start of last interworkign select call to the supplicant.
   std::optional<base::Time> last_interworking_select_timestamp_;
 
+  // Time of the last scan for roam candidates, and minimum time until the next
+  // one.
+  base::TimeTicks last_roam_scan_time_;
+  base::TimeDelta roam_scan_interval_ = kRoamScanMinInterval;
+
   // Holds the list of interworking matches waiting to be processed.
   std::vector<InterworkingBSS> pending_matches_;
 
@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include <base/containers/contains.h>
+#include <base/hash/hash.h>
 #include <base/logging.h>
 #include <base/notreached.h>
 #include <base/strings/string_number_conversions.h>
@@ -89,6 +90,7 @@ WiFiEndpoint::WiFiEndpoint(ControlInterface* control_interface,
       frequency_(0),
       physical_mode_(Metrics::kWiFiNetworkPhyModeUndef),
       metrics_(metrics),
+      ies_hash_(HashIEs(properties)),
       control_interface_(control_interface),
       device_(device),
       rpc_id_(rpc_id) {
@@ -175,6 +177,31 @@ void WiFiEndpoint::PropertiesChanged(const KeyValueStore& properties) {
     }
   }
 
+  // Information elements are reported again on each scan, but seldom change.
+  // Only parse them again when their content differs.
+  const uint32_t new_ies_hash = HashIEs(properties);
+  if (new_ies_hash != 0 && new_ies_hash != ies_hash_) {
+    ies_hash_ = new_ies_hash;
+    Metrics::WiFiNetworkPhyMode phy_mode = Metrics::kWiFiNetworkPhyModeUndef;
+    VendorInformation vendor_information;
+    std::string country_code;
+    SupportedFeatures supported_features;
+    if (!ParseIEs(properties, &phy_mode, &vendor_information, &country_code,
+                  &supported_features)) {
+      phy_mode = DeterminePhyModeFromFrequency(properties, frequency_);
+    }
+    // WiFi counts Passpoint capable endpoints when they are added and removed,
+    // keep the Passpoint information the endpoint was added with.
+    supported_features.hs20_information = supported_features_.hs20_information;
+    physical_mode_ = phy_mode;
+    vendor_information_ = vendor_information;
+    country_code_ = country_code;
+    supported_features_ = supported_features;
+    CheckForTetheringSignature();
+    SLOG(2) << "WiFiEndpoint " << bssid_string_ << " IEs changed";
+    should_notify = true;
+  }
+
   WiFiSecurity::Mode new_security_mode =
       ParseSecurity(properties, &security_flags_);
   if (new_security_mode != security_mode()) {
@@ -508,6 +535,16 @@ Metrics::WiFiNetworkPhyMode WiFiEndpoint::DeterminePhyModeFromFrequency(
   return phy_mode;
 }
 
+// static
+uint32_t WiFiEndpoint::HashIEs(const KeyValueStore& properties) {
+  if (!properties.Contains<std::vector<uint8_t>>(
+          WPASupplicant::kBSSPropertyIEs)) {
+    return 0;
+  }
+  return base::FastHash(
+      properties.Get<std::vector<uint8_t>>(WPASupplicant::kBSSPropertyIEs));
+}
+
 // static
 bool WiFiEndpoint::ParseIEs(const KeyValueStore& properties,
                             Metrics::WiFiNetworkPhyMode* phy_mode,
@@ -139,6 +139,7 @@ class WiFiEndpoint : public base::RefCounted<WiFiEndpoint> {
   FRIEND_TEST(WiFiEndpointTest, ParseKeyManagementMethodsEAPAndPSK);
   FRIEND_TEST(WiFiEndpointTest, HasTetheringSignature);  // vendor_information_
   FRIEND_TEST(WiFiProviderTest, OnEndpointUpdated);
+  FRIEND_TEST(WiFiProviderTest, OnEndpointsUpdated);
   FRIEND_TEST(WiFiServiceTest, GetTethering);
   FRIEND_TEST(WiFiServiceUpdateFromEndpointsTest, EndpointModified);
   // for physical_mode_
@@ -229,6 +230,10 @@ class WiFiEndpoint : public base::RefCounted<WiFiEndpoint> {
                             VendorInformation* vendor_information,
                             SupportedFeatures* supported_features);
 
+  // Returns a hash of the information elements of the BSS |properties|, or 0
+  // if they have none.
+  static uint32_t HashIEs(const KeyValueStore& properties);
+
   // Assigns a value to |has_tethering_signature_|.
   void CheckForTetheringSignature();
 
@@ -258,6 +263,9 @@ class WiFiEndpoint : public base::RefCounted<WiFiEndpoint> {
   Metrics* metrics_;
 
   SupportedFeatures supported_features_;
+  // Hash of the information elements the IE-derived fields were parsed from,
+  // such that identical IEs reported on each scan are not parsed again.
+  uint32_t ies_hash_;
 
   ControlInterface* control_interface_;
   WiFiRefPtr device_;
@@ -1060,6 +1060,40 @@ TEST_F(WiFiEndpointTest, PropertiesChangedSecurityMode) {
   EXPECT_EQ(WiFiSecurity::kNone, endpoint->security_mode());
 }
 
+TEST_F(WiFiEndpointTest, PropertiesChangedIEs) {
+  WiFiEndpointRefPtr endpoint =
+      MakeOpenEndpoint(nullptr, wifi(), "ssid", "00:00:00:00:00:01");
+  EXPECT_EQ("", endpoint->country_code());
+
+  const std::string kCountryCode1("US");
+  std::vector<uint8_t> ies1;
+  AddIEWithData(
+      IEEE_80211::kElemIdCountry,
+      std::vector<uint8_t>(kCountryCode1.begin(), kCountryCode1.end()),
+      &ies1);
+  EXPECT_CALL(*wifi(), NotifyEndpointChanged(_)).Times(1);
+  endpoint->PropertiesChanged(MakeBSSPropertiesWithIEs(ies1));
+  Mock::VerifyAndClearExpectations(wifi().get());
+  EXPECT_EQ(kCountryCode1, endpoint->country_code());
+
+  // The same IEs are not parsed again and do not cause a notification.
+  EXPECT_CALL(*wifi(), NotifyEndpointChanged(_)).Times(0);
+  endpoint->PropertiesChanged(MakeBSSPropertiesWithIEs(ies1));
+  Mock::VerifyAndClearExpectations(wifi().get());
+  EXPECT_EQ(kCountryCode1, endpoint->country_code());
+
+  const std::string kCountryCode2("FR");
+  std::vector<uint8_t> ies2;
+  AddIEWithData(
+      IEEE_80211::kElemIdCountry,
+      std::vector<uint8_t>(kCountryCode2.begin(), kCountryCode2.end()),
+      &ies2);
+  EXPECT_CALL(*wifi(), NotifyEndpointChanged(_)).Times(1);
+  endpoint->PropertiesChanged(MakeBSSPropertiesWithIEs(ies2));
+  Mock::VerifyAndClearExpectations(wifi().get());
+  EXPECT_EQ(kCountryCode2, endpoint->country_code());
+}
+
 TEST_F(WiFiEndpointTest, HasRsnWpaProperties) {
   {
     WiFiEndpointRefPtr endpoint =
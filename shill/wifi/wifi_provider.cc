@@ -5,6 +5,7 @@
 #include "shill/wifi/wifi_provider.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -515,16 +516,49 @@ void WiFiProvider::OnEndpointUpdated(const WiFiEndpointConstRefPtr& endpoint) {
     return;
   }
 
-  WiFiService* service = FindServiceForEndpoint(endpoint).get();
+  WiFiServiceRefPtr service = FindServiceForEndpoint(endpoint);
   CHECK(service);
+  if (ReassignUpdatedEndpoint(service, endpoint)) {
+    service->NotifyEndpointUpdated(endpoint);
+  }
+}
+
+void WiFiProvider::OnEndpointsUpdated(
+    const std::vector<WiFiEndpointConstRefPtr>& endpoints) {
+  if (!running_) {
+    return;
+  }
+
+  // Services are notified after all the endpoints have been assigned, once
+  // with any of their updated endpoints: each notification makes the service
+  // go through all its endpoints and emit its properties.
+  std::map<WiFiService*, WiFiEndpointConstRefPtr> updated_endpoint_by_service;
+  std::vector<WiFiServiceRefPtr> updated_services;
+  for (const auto& endpoint : endpoints) {
+    WiFiServiceRefPtr service = FindServiceForEndpoint(endpoint);
+    if (!service) {
+      SLOG(2) << __func__ << ": Ignoring removed endpoint "
+              << endpoint->bssid_string();
+      continue;
+    }
+    if (ReassignUpdatedEndpoint(service, endpoint) &&
+        updated_endpoint_by_service.emplace(service.get(), endpoint).second) {
+      updated_services.push_back(service);
+    }
+  }
+  for (const auto& service : updated_services) {
+    service->NotifyEndpointUpdated(updated_endpoint_by_service[service.get()]);
+  }
+}
 
+bool WiFiProvider::ReassignUpdatedEndpoint(
+    const WiFiServiceRefPtr& service, const WiFiEndpointConstRefPtr& endpoint) {
   // If the service still matches the endpoint in its new configuration,
   // we need only to update the service.
   if (service->ssid() == endpoint->ssid() &&
       service->mode() == endpoint->network_mode() &&
       service->IsSecurityMatch(endpoint->security_mode())) {
-    service->NotifyEndpointUpdated(endpoint);
-    return;
+    return true;
   }
 
   // The endpoint no longer matches the associated service.  Remove the
@@ -532,6 +566,7 @@ void WiFiProvider::OnEndpointUpdated(const WiFiEndpointConstRefPtr& endpoint) {
   // it again so it can be associated with a new service.
   OnEndpointRemoved(endpoint);
   OnEndpointAdded(endpoint);
+  return false;
 }
 
 bool WiFiProvider::OnServiceUnloaded(
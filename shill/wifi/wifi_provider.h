@@ -125,6 +125,12 @@ class WiFiProvider : public ProviderInterface {
   // the endpoint.
   virtual void OnEndpointUpdated(const WiFiEndpointConstRefPtr& endpoint);
 
+  // Same as OnEndpointUpdated for a batch of updated |endpoints|, but each
+  // service still matching its updated endpoints is only notified once.
+  // Endpoints that were removed since their update are ignored.
+  virtual void OnEndpointsUpdated(
+      const std::vector<WiFiEndpointConstRefPtr>& endpoints);
+
   // Called by a WiFiService when it is unloaded and no longer visible.
   // |credentials| contains the set of Passpoint credentials of the service,
   // if any.
@@ -288,6 +294,11 @@ class WiFiProvider : public ProviderInterface {
                                const WiFiSecurity& security,
                                bool is_hidden);
 
+  // Returns true if the updated |endpoint| still matches its associated
+  // |service|, otherwise re-assigns it to a new service and returns false.
+  bool ReassignUpdatedEndpoint(const WiFiServiceRefPtr& service,
+                               const WiFiEndpointConstRefPtr& endpoint);
+
   // Find a service given its properties.
   WiFiServiceRefPtr FindService(const std::vector<uint8_t>& ssid,
                                 const std::string& mode,
@@ -1816,6 +1816,48 @@ TEST_F(WiFiProviderTest, OnEndpointUpdated) {
   provider_.OnEndpointUpdated(endpoint);
 }
 
+TEST_F(WiFiProviderTest, OnEndpointsUpdated) {
+  provider_.Start();
+
+  const std::string ssid("an_ssid");
+  const std::vector<uint8_t> ssid_bytes(ssid.begin(), ssid.end());
+  WiFiEndpointRefPtr endpoint0 =
+      MakeOpenEndpoint(ssid, "00:00:00:00:00:00", 0, 0);
+  WiFiEndpointRefPtr endpoint1 =
+      MakeOpenEndpoint(ssid, "00:00:00:00:00:01", 0, 0);
+  WiFiEndpointRefPtr removed_endpoint =
+      MakeOpenEndpoint(ssid, "00:00:00:00:00:02", 0, 0);
+  MockWiFiServiceRefPtr open_service =
+      AddMockService(ssid_bytes, kModeManaged, kSecurityClassNone, false);
+  EXPECT_CALL(*open_service, AddEndpoint(_)).Times(2);
+  EXPECT_CALL(manager_, UpdateService(RefPtrMatch(open_service))).Times(2);
+  provider_.OnEndpointAdded(endpoint0);
+  provider_.OnEndpointAdded(endpoint1);
+  Mock::VerifyAndClearExpectations(open_service.get());
+  Mock::VerifyAndClearExpectations(&manager_);
+
+  // The service is notified once for both of its endpoints, and the endpoint
+  // which does not belong to a service anymore is ignored.
+  EXPECT_CALL(*open_service, NotifyEndpointUpdated(_)).Times(1);
+  EXPECT_CALL(*open_service, AddEndpoint(_)).Times(0);
+  provider_.OnEndpointsUpdated({endpoint0, removed_endpoint, endpoint1});
+  Mock::VerifyAndClearExpectations(open_service.get());
+
+  // An endpoint which no longer matches its service is transferred to another
+  // one, without notifying its former service.
+  MockWiFiServiceRefPtr rsn_service =
+      AddMockService(ssid_bytes, kModeManaged, kSecurityClassPsk, false);
+  EXPECT_CALL(*open_service, RemoveEndpoint(RefPtrMatch(endpoint1)));
+  EXPECT_CALL(*open_service, HasEndpoints()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*open_service, NotifyEndpointUpdated(RefPtrMatch(endpoint0)));
+  EXPECT_CALL(*rsn_service, AddEndpoint(RefPtrMatch(endpoint1)));
+  EXPECT_CALL(*rsn_service, NotifyEndpointUpdated(_)).Times(0);
+  EXPECT_CALL(manager_, UpdateService(RefPtrMatch(open_service)));
+  EXPECT_CALL(manager_, UpdateService(RefPtrMatch(rsn_service)));
+  endpoint1->set_security_mode(WiFiSecurity::kWpa2);
+  provider_.OnEndpointsUpdated({endpoint0, endpoint1});
+}
+
 TEST_F(WiFiProviderTest, OnEndpointUpdatedWhileStopped) {
   // If we don't call provider_.Start(), OnEndpointUpdated should not
   // cause a crash even if a service matching the endpoint does not exist.
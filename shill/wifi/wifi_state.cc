@@ -20,6 +20,7 @@ constexpr char kConnected[] = "Connected";
 constexpr char kFoundNothing[] = "FoundNothing";
 constexpr char kWaiting[] = "Waiting";
 constexpr char kFull[] = "Full";
+constexpr char kPartial[] = "Partial";
 constexpr char kNone[] = "None";
 
 std::map<shill::WiFiState::PhyState, const char*> phy_state_map = {
@@ -38,6 +39,7 @@ std::map<shill::WiFiState::EnsuredScanState, const char*>
         {shill::WiFiState::EnsuredScanState::kWaiting, kWaiting}};
 std::map<shill::WiFiState::ScanMethod, const char*> scan_method_map = {
     {shill::WiFiState::ScanMethod::kFull, kFull},
+    {shill::WiFiState::ScanMethod::kPartial, kPartial},
     {shill::WiFiState::ScanMethod::kNone, kNone}};
 
 std::string GetScanMethodString(shill::WiFiState::ScanMethod method) {
@@ -108,6 +110,8 @@ std::string WiFiState::LegacyStateString(WiFiState::PhyState state,
       switch (method) {
         case ScanMethod::kFull:
           return "FULL_START";
+        case ScanMethod::kPartial:
+          return "PARTIAL_START";
         default:
           NOTREACHED();
       }
@@ -124,6 +128,8 @@ std::string WiFiState::LegacyStateString(WiFiState::PhyState state,
           return "CONNECTING (not scan related)";
         case ScanMethod::kFull:
           return "FULL_CONNECTING";
+        case ScanMethod::kPartial:
+          return "PARTIAL_CONNECTING";
         default:
           NOTREACHED();
       }
@@ -136,6 +142,8 @@ std::string WiFiState::LegacyStateString(WiFiState::PhyState state,
           return "CONNECTED (not scan related; e.g., from a supplicant roam)";
         case ScanMethod::kFull:
           return "FULL_CONNECTED";
+        case ScanMethod::kPartial:
+          return "PARTIAL_CONNECTED";
         default:
           NOTREACHED();
       }
@@ -148,6 +156,8 @@ std::string WiFiState::LegacyStateString(WiFiState::PhyState state,
           return "CONNECT FAILED (not scan related)";
         case ScanMethod::kFull:
           return "FULL_NOCONNECTION";
+        case ScanMethod::kPartial:
+          return "PARTIAL_NOCONNECTION";
         default:
           NOTREACHED();
       }
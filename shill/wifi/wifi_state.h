@@ -37,6 +37,7 @@ class WiFiState {
   // TODO(b/266814915): Remove this once it provides no value.
   enum class ScanMethod {
     kFull,
+    kPartial,  // Scan of some channels only
     kNone,
   };
 
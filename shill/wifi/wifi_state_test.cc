@@ -45,5 +45,11 @@ TEST_F(WiFiStateTest, SetPhyStateAndEnsuredScanState) {
   EXPECT_EQ(wifi_state_.GetEnsuredScanStateString(), "Waiting");
   EXPECT_EQ(wifi_state_.GetPhyStateString(), "Scanning");
   EXPECT_EQ(wifi_state_.GetScanMethodString(), "Full");
+
+  // Set the Phy State to indicate a partial background scan.
+  wifi_state_.SetPhyState(WiFiState::PhyState::kBackgroundScanning,
+                          WiFiState::ScanMethod::kPartial);
+  EXPECT_EQ(wifi_state_.GetScanMethod(), WiFiState::ScanMethod::kPartial);
+  EXPECT_EQ(wifi_state_.GetScanMethodString(), "Partial");
 }
 }  // namespace shill
@@ -14,6 +14,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -83,6 +84,7 @@ using ::testing::AtLeast;
 using ::testing::ByMove;
 using ::testing::ContainsRegex;
 using ::testing::DoAll;
+using ::testing::ElementsAre;
 using ::testing::EndsWith;
 using ::testing::Field;
 using ::testing::HasSubstr;
@@ -1693,9 +1695,26 @@ TEST_F(WiFiMainTest, ClearCachedCredentials) {
 }
 
 TEST_F(WiFiMainTest, NotifyEndpointChanged) {
-  WiFiEndpointRefPtr endpoint = MakeEndpoint("ssid", "00:00:00:00:00:00");
-  EXPECT_CALL(*wifi_provider(), OnEndpointUpdated(EndpointMatch(endpoint)));
-  NotifyEndpointChanged(endpoint);
+  WiFiEndpointRefPtr endpoint0 = MakeEndpoint("ssid0", "00:00:00:00:00:00");
+  WiFiEndpointRefPtr endpoint1 = MakeEndpoint("ssid1", "00:00:00:00:00:01");
+  // Updates are passed to the provider at once from the event loop, and only
+  // once for each endpoint.
+  EXPECT_CALL(*wifi_provider(), OnEndpointsUpdated(_)).Times(0);
+  NotifyEndpointChanged(endpoint0);
+  NotifyEndpointChanged(endpoint1);
+  NotifyEndpointChanged(endpoint0);
+  Mock::VerifyAndClearExpectations(wifi_provider());
+
+  EXPECT_CALL(*wifi_provider(),
+              OnEndpointsUpdated(ElementsAre(EndpointMatch(endpoint0),
+                                             EndpointMatch(endpoint1))));
+  event_dispatcher_->DispatchPendingEvents();
+  Mock::VerifyAndClearExpectations(wifi_provider());
+
+  EXPECT_CALL(*wifi_provider(),
+              OnEndpointsUpdated(ElementsAre(EndpointMatch(endpoint1))));
+  NotifyEndpointChanged(endpoint1);
+  event_dispatcher_->DispatchPendingEvents();
 }
 
 TEST_F(WiFiMainTest, RemoveNetwork) {
@@ -3055,6 +3074,63 @@ TEST_F(WiFiMainTest, ScanAllowRoam) {
   event_dispatcher_->DispatchPendingEvents();
 }
 
+MATCHER_P(ScanRequestHasChannels, channels, "") {
+  using Channels = std::vector<std::tuple<uint32_t, uint32_t>>;
+  if (!arg.template Contains<Channels>(WPASupplicant::kPropertyScanChannels)) {
+    return false;
+  }
+  return arg.template Get<Channels>(WPASupplicant::kPropertyScanChannels) ==
+         channels;
+}
+
+TEST_F(WiFiMainTest, WeakSignalScansForRoamCandidates) {
+  StartWiFi();
+  MockWiFiServiceRefPtr service =
+      SetupConnectedService(RpcIdentifier(""), nullptr, nullptr);
+  AddEndpointToService(service, -60, 5180, nullptr);
+  AddEndpointToService(service, -65, 2412, nullptr);
+  ON_CALL(*service, IsConnected(_)).WillByDefault(Return(true));
+  SetScanState(WiFiState::PhyState::kIdle, WiFiState::ScanMethod::kNone,
+               __func__);
+
+  KeyValueStore props;
+  props.Set<int32_t>(WPASupplicant::kSignalChangePropertyRSSI, -80);
+  KeyValueStore cqm_event;
+  cqm_event.Set<KeyValueStore>(WPASupplicant::kSignalChangeProperty, props);
+
+  // No scan while the signal is above the bgscan threshold.
+  EXPECT_CALL(*service, SignalLevel()).WillRepeatedly(Return(-60));
+  EXPECT_CALL(*GetSupplicantInterfaceProxy(), Scan(_)).Times(0);
+  PropertiesChanged(cqm_event);
+  event_dispatcher_->DispatchPendingEvents();
+  Mock::VerifyAndClearExpectations(GetSupplicantInterfaceProxy());
+
+  // The periodic signal polls don't scan.
+  EXPECT_CALL(*service, SignalLevel()).WillRepeatedly(Return(-80));
+  EXPECT_CALL(*GetSupplicantInterfaceProxy(), Scan(_)).Times(0);
+  SignalChanged(props);
+  Mock::VerifyAndClearExpectations(GetSupplicantInterfaceProxy());
+
+  // Only the channels of the other BSSes of the service are scanned.
+  const std::vector<std::tuple<uint32_t, uint32_t>> channels = {{2412, 0},
+                                                                {5180, 0}};
+  EXPECT_CALL(*GetSupplicantInterfaceProxy(),
+              Scan(AllOf(ScanRequestHasChannels(channels), AllowRoam(true))))
+      .WillOnce(Return(true));
+  PropertiesChanged(cqm_event);
+  event_dispatcher_->DispatchPendingEvents();
+  Mock::VerifyAndClearExpectations(GetSupplicantInterfaceProxy());
+  VerifyScanState(WiFiState::PhyState::kBackgroundScanning,
+                  WiFiState::ScanMethod::kPartial);
+
+  // Roam scans are rate limited.
+  SetScanState(WiFiState::PhyState::kIdle, WiFiState::ScanMethod::kNone,
+               __func__);
+  EXPECT_CALL(*GetSupplicantInterfaceProxy(), Scan(_)).Times(0);
+  PropertiesChanged(cqm_event);
+  event_dispatcher_->DispatchPendingEvents();
+}
+
 TEST_F(WiFiMainTest, WEPSupported) {
   // Connection attempt to service with WEP security should succeed when WEP is
   // supported.
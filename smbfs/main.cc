@@ -28,6 +28,9 @@ void PrintUsage(const char* self) {
       "    -o uid=<n>          UID of the files owner.\n"
       "    -o gid=<n>          GID of the files owner.\n"
       "    -o mojo_id=<s>      Token used to establish Mojo IPC to Chrome.\n"
+      "    -o cache_timeout=<n>\n"
+      "                        Seconds to cache file attributes.\n"
+      "    -o cache_size=<n>   Maximum number of cached file attributes.\n"
       "    -t   --test         Use a fake/test backend.\n"
       "    --log-level=<l>     Log level - 0: LOG(INFO), 1: LOG(WARNING),\n"
       "                        2: LOG(ERROR), -1: VLOG(1), -2: VLOG(2), ...\n"
@@ -46,6 +49,8 @@ const struct fuse_opt options_definition[] = {
     OPT_DEF("uid=%u", uid, 0),
     OPT_DEF("gid=%u", gid, 0),
     OPT_DEF("mojo_id=%s", mojo_id, 0),
+    OPT_DEF("cache_timeout=%d", cache_timeout, 0),
+    OPT_DEF("cache_size=%u", cache_size, 0),
     OPT_DEF("-t", use_test, 1),
     OPT_DEF("--test", use_test, 1),
     OPT_DEF("--log-level=%d", log_level, 0),
@@ -43,12 +43,16 @@ MojoSession::MojoSession(
     mojo::PendingReceiver<mojom::SmbFsBootstrap> bootstrap_receiver,
     uid_t uid,
     gid_t gid,
+    base::TimeDelta metadata_cache_lifetime,
+    size_t metadata_cache_size,
     base::OnceClosure shutdown_callback)
     : bus_(std::move(bus)),
       temp_dir_(temp_dir),
       chan_(chan),
       uid_(uid),
       gid_(gid),
+      metadata_cache_lifetime_(metadata_cache_lifetime),
+      metadata_cache_size_(metadata_cache_size),
       shutdown_callback_(std::move(shutdown_callback)),
       bootstrap_impl_(std::make_unique<SmbFsBootstrapImpl>(
           std::move(bootstrap_receiver),
@@ -121,6 +125,8 @@ std::unique_ptr<SmbFilesystem> MojoSession::CreateSmbFilesystem(
   options.uid = uid_;
   options.gid = gid_;
   options.use_kerberos = kerberos_sync_.get();
+  options.metadata_cache_lifetime = metadata_cache_lifetime_;
+  options.metadata_cache_size = metadata_cache_size_;
   return std::make_unique<SmbFilesystem>(this, std::move(options));
 }
 
@@ -13,6 +13,7 @@
 
 #include <base/files/file_path.h>
 #include <base/functional/callback.h>
+#include <base/time/time.h>
 #include <dbus/bus.h>
 #include <mojo/public/cpp/bindings/pending_receiver.h>
 #include <mojo/public/cpp/bindings/pending_remote.h>
@@ -42,6 +43,8 @@ class MojoSession : public SmbFsBootstrapImpl::Delegate,
               mojo::PendingReceiver<mojom::SmbFsBootstrap> bootstrap_receiver,
               uid_t uid,
               gid_t gid,
+              base::TimeDelta metadata_cache_lifetime,
+              size_t metadata_cache_size,
               base::OnceClosure shutdown_callback);
   MojoSession(const MojoSession&) = delete;
   MojoSession& operator=(const MojoSession&) = delete;
@@ -81,6 +84,8 @@ class MojoSession : public SmbFsBootstrapImpl::Delegate,
   fuse_chan* chan_;
   const uid_t uid_;
   const gid_t gid_;
+  const base::TimeDelta metadata_cache_lifetime_;
+  const size_t metadata_cache_size_;
   base::OnceClosure shutdown_callback_;
   std::unique_ptr<SmbFsBootstrapImpl> bootstrap_impl_;
 
@@ -4,6 +4,7 @@
 
 #include "smbfs/smb_filesystem.h"
 
+#include <algorithm>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -29,13 +30,13 @@ namespace {
 constexpr char kSambaThreadName[] = "smbfs-libsmb";
 constexpr char kUrlPrefix[] = "smb://";
 
-constexpr double kAttrTimeoutSeconds = 5.0;
 constexpr mode_t kAllowedFileTypes = S_IFREG | S_IFDIR;
 constexpr mode_t kFileModeMask = kAllowedFileTypes | 0770;
 
-// Cache stat information for the latest 1024 directory entries retrieved.
-constexpr int kStatCacheSize = 1024;
-constexpr double kStatCacheTimeoutSeconds = kAttrTimeoutSeconds;
+// Amount of data fetched at once when a file is read sequentially. A single
+// large read lets libsmbclient keep several SMB2 READ requests in flight,
+// instead of waiting on one round-trip per kernel request (usually 128 KiB).
+constexpr size_t kReadAheadSize = 1024 * 1024;
 
 bool IsAllowedFileMode(mode_t mode) {
   return mode & kAllowedFileTypes;
@@ -57,9 +58,13 @@ SmbFilesystem::SmbFilesystem(Delegate* delegate, Options options)
       uid_(options.uid),
       gid_(options.gid),
       use_kerberos_(options.use_kerberos),
+      metadata_cache_lifetime_(options.metadata_cache_lifetime),
       samba_thread_(kSambaThreadName),
-      stat_cache_(kStatCacheSize) {
+      stat_cache_(options.metadata_cache_size) {
   DCHECK(delegate_);
+  // A zero-sized LRU cache would never evict anything.
+  CHECK_GT(options.metadata_cache_size, 0u);
+  CHECK(!metadata_cache_lifetime_.is_negative());
 
   // Ensure files are not owned by root.
   CHECK_GT(uid_, 0);
@@ -78,7 +83,7 @@ SmbFilesystem::SmbFilesystem(Delegate* delegate, const std::string& share_path)
     : delegate_(delegate),
       share_path_(share_path),
       samba_thread_(kSambaThreadName),
-      stat_cache_(kStatCacheSize) {
+      stat_cache_(kDefaultMetadataCacheSize) {
   DCHECK(delegate_);
 }
 
@@ -243,6 +248,17 @@ void SmbFilesystem::RemoveOpenFile(uint64_t handle) {
     return;
   }
   open_files_.erase(it);
+  read_ahead_.erase(handle);
+}
+
+void SmbFilesystem::DropReadAhead(fuse_ino_t inode) {
+  for (auto& entry : read_ahead_) {
+    ReadAheadBuffer& read_ahead = entry.second;
+    if (read_ahead.inode == inode) {
+      read_ahead.data.clear();
+      read_ahead.eof = false;
+    }
+  }
 }
 
 SMBCFILE* SmbFilesystem::LookupOpenFile(uint64_t handle) const {
@@ -372,6 +388,9 @@ void SmbFilesystem::LookupInternal(std::unique_ptr<EntryRequest> request,
       inode_map_.Forget(inode, 1);
       return;
     }
+    // The kernel usually follows up a lookup with a getattr, which can then be
+    // answered without another round-trip to the server.
+    AddCachedInodeStat(MakeStat(inode, smb_stat));
   }
 
   struct stat entry_stat = MakeStat(inode, smb_stat);
@@ -379,8 +398,8 @@ void SmbFilesystem::LookupInternal(std::unique_ptr<EntryRequest> request,
   entry.ino = inode;
   entry.generation = 1;
   entry.attr = entry_stat;
-  entry.attr_timeout = kAttrTimeoutSeconds;
-  entry.entry_timeout = kAttrTimeoutSeconds;
+  entry.attr_timeout = metadata_cache_lifetime_.InSecondsF();
+  entry.entry_timeout = metadata_cache_lifetime_.InSecondsF();
   request->ReplyEntry(entry);
 }
 
@@ -444,7 +463,7 @@ void SmbFilesystem::GetAttrInternal(std::unique_ptr<AttrRequest> request,
 
   connected_ = true;
   struct stat reply_stat = MakeStat(inode, smb_stat);
-  request->ReplyAttr(reply_stat, kAttrTimeoutSeconds);
+  request->ReplyAttr(reply_stat, metadata_cache_lifetime_.InSecondsF());
 }
 
 void SmbFilesystem::SetAttr(std::unique_ptr<AttrRequest> request,
@@ -521,8 +540,11 @@ void SmbFilesystem::SetAttrInternal(std::unique_ptr<AttrRequest> request,
 
   // Modifying the attributes invalidates any cached inode we have.
   EraseCachedInodeStat(inode);
+  if (to_set & FUSE_SET_ATTR_SIZE) {
+    DropReadAhead(inode);
+  }
 
-  request->ReplyAttr(reply_stat, kAttrTimeoutSeconds);
+  request->ReplyAttr(reply_stat, metadata_cache_lifetime_.InSecondsF());
 }
 
 int SmbFilesystem::SetFileSizeInternal(const std::string& share_file_path,
@@ -711,7 +733,7 @@ void SmbFilesystem::CreateInternal(std::unique_ptr<CreateRequest> request,
   // Force readers to see coherent user / group permission bits by not caching
   // stat structure.
   entry.attr_timeout = 0;
-  entry.entry_timeout = kAttrTimeoutSeconds;
+  entry.entry_timeout = metadata_cache_lifetime_.InSecondsF();
   request->ReplyCreate(entry, handle);
 }
 
@@ -746,6 +768,21 @@ void SmbFilesystem::ReadInternal(std::unique_ptr<BufRequest> request,
     return;
   }
 
+  // Reads at the end of the file always go to the server, in case the file
+  // has grown since.
+  ReadAheadBuffer& read_ahead = read_ahead_[file_handle];
+  read_ahead.inode = inode;
+  const off_t buffered_end = read_ahead.offset + read_ahead.data.size();
+  if (offset >= read_ahead.offset &&
+      (offset + static_cast<off_t>(size) <= buffered_end ||
+       (read_ahead.eof && offset < buffered_end))) {
+    const size_t available = std::min<size_t>(size, buffered_end - offset);
+    read_ahead.next_offset = offset + available;
+    request->ReplyBuf(read_ahead.data.data() + (offset - read_ahead.offset),
+                      available);
+    return;
+  }
+
   int error = samba_impl_->SeekFile(file, offset, SEEK_SET);
   if (error) {
     VLOG(1) << "SeekFile path: " << ShareFilePathFromInode(inode)
@@ -755,18 +792,30 @@ void SmbFilesystem::ReadInternal(std::unique_ptr<BufRequest> request,
     return;
   }
 
-  std::vector<char> buf(size);
+  // Only read ahead once the access pattern looks sequential, so random
+  // access doesn't transfer data that is never used.
+  const bool sequential = offset > 0 && offset == read_ahead.next_offset;
+  const size_t read_size = sequential ? std::max(size, kReadAheadSize) : size;
+  read_ahead.offset = offset;
+  read_ahead.data.resize(read_size);
+  read_ahead.eof = false;
   size_t bytes_read = 0;
-  error = samba_impl_->ReadFile(file, buf.data(), size, &bytes_read);
+  error = samba_impl_->ReadFile(file, read_ahead.data.data(), read_size,
+                                &bytes_read);
   if (error) {
     VLOG(1) << "ReadFile path: " << ShareFilePathFromInode(inode)
-            << " offset: " << offset << ", size: " << size
+            << " offset: " << offset << ", size: " << read_size
             << " failed: " << base::safe_strerror(error);
+    read_ahead.data.clear();
     request->ReplyError(error);
     return;
   }
+  read_ahead.data.resize(bytes_read);
+  read_ahead.eof = bytes_read < read_size;
 
-  request->ReplyBuf(buf.data(), bytes_read);
+  const size_t reply_size = std::min(size, bytes_read);
+  read_ahead.next_offset = offset + reply_size;
+  request->ReplyBuf(read_ahead.data.data(), reply_size);
 }
 
 void SmbFilesystem::Write(std::unique_ptr<WriteRequest> request,
@@ -821,8 +870,9 @@ void SmbFilesystem::WriteInternal(std::unique_ptr<WriteRequest> request,
     return;
   }
 
-  // Modifying the file invalidates any cached inode we have.
+  // Modifying the file invalidates any cached inode and data we have.
   EraseCachedInodeStat(inode);
+  DropReadAhead(inode);
 
   request->ReplyWrite(bytes_written);
 }
@@ -977,6 +1027,9 @@ void SmbFilesystem::UnlinkInternal(std::unique_ptr<SimpleRequest> request,
     return;
   }
 
+  // Don't let a later lookup find the removed file in the cache.
+  EraseCachedInodeStat(inode_map_.GetWeakInode(parent_path.Append(name)));
+
   request->ReplyOk();
 }
 
@@ -1196,7 +1249,7 @@ void SmbFilesystem::MkDirInternal(std::unique_ptr<EntryRequest> request,
   // Force readers to see coherent user / group permission bits by not caching
   // stat structure.
   entry.attr_timeout = 0;
-  entry.entry_timeout = kAttrTimeoutSeconds;
+  entry.entry_timeout = metadata_cache_lifetime_.InSecondsF();
   request->ReplyEntry(entry);
 }
 
@@ -1235,6 +1288,8 @@ void SmbFilesystem::RmDirinternal(std::unique_ptr<SimpleRequest> request,
     return;
   }
 
+  EraseCachedInodeStat(inode_map_.GetWeakInode(file_path));
+
   request->ReplyOk();
 }
 
@@ -1303,7 +1358,7 @@ void SmbFilesystem::AddCachedInodeStat(const struct stat& inode_stat) {
   StatCacheItem item;
 
   item.inode_stat = inode_stat;
-  item.expires_at = base::Time::Now() + base::Seconds(kStatCacheTimeoutSeconds);
+  item.expires_at = base::Time::Now() + metadata_cache_lifetime_;
 
   stat_cache_.Put(inode_stat.st_ino, item);
 }
@@ -51,6 +51,10 @@ class SmbFilesystem : public Filesystem {
     virtual void RequestCredentials(RequestCredentialsCallback callback) = 0;
   };
 
+  static constexpr base::TimeDelta kDefaultMetadataCacheLifetime =
+      base::Seconds(5);
+  static constexpr size_t kDefaultMetadataCacheSize = 1024;
+
   struct Options {
     Options();
     ~Options();
@@ -65,6 +69,11 @@ class SmbFilesystem : public Filesystem {
     std::unique_ptr<SmbCredential> credentials;
     bool allow_ntlm = false;
     bool use_kerberos = false;
+
+    // How long file attributes are cached, both by smbfs and by the kernel.
+    base::TimeDelta metadata_cache_lifetime = kDefaultMetadataCacheLifetime;
+    // Maximum number of entries kept in the stat cache.
+    size_t metadata_cache_size = kDefaultMetadataCacheSize;
   };
 
   enum class ConnectError {
@@ -185,6 +194,8 @@ class SmbFilesystem : public Filesystem {
   FRIEND_TEST(SmbFilesystemTest, MaybeUpdateCredentials_NoDelegate);
   FRIEND_TEST(SmbFilesystemTest, MaybeUpdateCredentials_OnlyOneRequest);
   FRIEND_TEST(SmbFilesystemTest, MaybeUpdateCredentials_IgnoreEmptyResponse);
+  FRIEND_TEST(SmbFilesystemStatCacheTest, CachedStatExpires);
+  FRIEND_TEST(SmbFilesystemStatCacheTest, EraseCachedStat);
 
   // Cache stat information when listing directories to reduce unnecessary
   // network requests.
@@ -193,6 +204,19 @@ class SmbFilesystem : public Filesystem {
     base::Time expires_at;
   };
 
+  // Data read past the end of a sequential read on an open file, used to serve
+  // the following reads without a round-trip to the server.
+  struct ReadAheadBuffer {
+    fuse_ino_t inode = 0;
+    // File offset of the first byte of |data|.
+    off_t offset = 0;
+    std::vector<char> data;
+    // Whether |data| extends to the end of the file.
+    bool eof = false;
+    // Offset just past the last read, used to detect sequential access.
+    off_t next_offset = 0;
+  };
+
   // Filesystem implementations that execute on |samba_thread_|.
   void StatFsInternal(std::unique_ptr<StatFsRequest> request, fuse_ino_t inode);
   void LookupInternal(std::unique_ptr<EntryRequest> request,
@@ -294,6 +318,10 @@ class SmbFilesystem : public Filesystem {
   // Removes |handle| from the open file table.
   void RemoveOpenFile(uint64_t handle);
 
+  // Discards read-ahead data for all open handles to |inode|, which must be
+  // done whenever the file is modified.
+  void DropReadAhead(fuse_ino_t inode);
+
   // Returns the open file referred to by |handle|. Returns nullptr if |handle|
   // does not exist.
   SMBCFILE* LookupOpenFile(uint64_t handle) const;
@@ -324,6 +352,8 @@ class SmbFilesystem : public Filesystem {
   const uid_t uid_ = 0;
   const gid_t gid_ = 0;
   const bool use_kerberos_ = false;
+  const base::TimeDelta metadata_cache_lifetime_ =
+      kDefaultMetadataCacheLifetime;
   base::Thread samba_thread_;
   InodeMap inode_map_{FUSE_ROOT_ID};
 
@@ -333,6 +363,7 @@ class SmbFilesystem : public Filesystem {
 
   std::unordered_map<uint64_t, SMBCFILE*> open_files_;
   uint64_t open_files_seq_ = 1;
+  std::unordered_map<uint64_t, ReadAheadBuffer> read_ahead_;
 
   mutable base::Lock lock_;
   std::string resolved_share_path_ = share_path_;
@@ -340,7 +371,8 @@ class SmbFilesystem : public Filesystem {
   // Interface to libsmbclient.
   std::unique_ptr<SambaInterface> samba_impl_;
 
-  // Cache stat information during ReadDir() to speed up subsequent access.
+  // Cache stat information during ReadDir() and Lookup() to speed up
+  // subsequent access.
   base::HashingLRUCache<ino_t, StatCacheItem> stat_cache_;
 
   // Whether a successful connection to the SMB server has been made. Used to
@@ -178,4 +178,46 @@ TEST_F(SmbFilesystemTest, MaybeUpdateCredentials_IgnoreEmptyResponse) {
   run_loop.Run();
 }
 
+class SmbFilesystemStatCacheTest : public testing::Test {
+ protected:
+  struct stat MakeCacheableStat(ino_t inode, off_t size) {
+    struct stat inode_stat = {0};
+    inode_stat.st_ino = inode;
+    inode_stat.st_mode = S_IFREG;
+    inode_stat.st_size = size;
+    return inode_stat;
+  }
+
+  base::test::TaskEnvironment task_environment{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME,
+      base::test::TaskEnvironment::ThreadingMode::MAIN_THREAD_ONLY,
+      base::test::TaskEnvironment::MainThreadType::IO};
+};
+
+TEST_F(SmbFilesystemStatCacheTest, CachedStatExpires) {
+  TestSmbFilesystem fs;
+  struct stat out_stat = {0};
+  EXPECT_FALSE(fs.GetCachedInodeStat(2, &out_stat));
+
+  fs.AddCachedInodeStat(MakeCacheableStat(2, 42));
+  ASSERT_TRUE(fs.GetCachedInodeStat(2, &out_stat));
+  EXPECT_EQ(42, out_stat.st_size);
+
+  task_environment.FastForwardBy(
+      SmbFilesystem::kDefaultMetadataCacheLifetime + base::Seconds(1));
+  EXPECT_FALSE(fs.GetCachedInodeStat(2, &out_stat));
+}
+
+TEST_F(SmbFilesystemStatCacheTest, EraseCachedStat) {
+  TestSmbFilesystem fs;
+  fs.AddCachedInodeStat(MakeCacheableStat(2, 42));
+  fs.AddCachedInodeStat(MakeCacheableStat(3, 43));
+
+  fs.EraseCachedInodeStat(2);
+  struct stat out_stat = {0};
+  EXPECT_FALSE(fs.GetCachedInodeStat(2, &out_stat));
+  ASSERT_TRUE(fs.GetCachedInodeStat(3, &out_stat));
+  EXPECT_EQ(43, out_stat.st_size);
+}
+
 }  // namespace smbfs
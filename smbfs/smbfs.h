@@ -22,6 +22,10 @@ struct Options {
   int use_test = 0;
   int log_level = 1;
   int foreground = 0;
+  // Attribute cache lifetime in seconds, or -1 to use the default.
+  int cache_timeout = -1;
+  // Maximum number of cached attributes, or 0 to use the default.
+  unsigned int cache_size = 0;
 
   std::string share_path;
   std::string mountpoint;
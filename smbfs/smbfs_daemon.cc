@@ -78,6 +78,13 @@ SmbFsDaemon::SmbFsDaemon(fuse_chan* chan, const Options& options)
       gid_(options.gid ? options.gid : getgid()),
       mojo_id_(options.mojo_id ? options.mojo_id : "") {
   DCHECK(chan_);
+
+  if (options.cache_timeout >= 0) {
+    metadata_cache_lifetime_ = base::Seconds(options.cache_timeout);
+  }
+  if (options.cache_size > 0) {
+    metadata_cache_size_ = options.cache_size;
+  }
 }
 
 SmbFsDaemon::~SmbFsDaemon() = default;
@@ -99,6 +106,8 @@ int SmbFsDaemon::OnInit() {
     options.uid = uid_;
     options.gid = gid_;
     options.allow_ntlm = true;
+    options.metadata_cache_lifetime = metadata_cache_lifetime_;
+    options.metadata_cache_size = metadata_cache_size_;
     std::unique_ptr<SmbFilesystem> fs =
         std::make_unique<SmbFilesystem>(&dummy_delegate, std::move(options));
     SmbFilesystem::ConnectError error = fs->EnsureConnected();
@@ -189,7 +198,7 @@ bool SmbFsDaemon::InitMojo() {
       bus_, temp_dir_.GetPath(), chan_,
       mojo::PendingReceiver<mojom::SmbFsBootstrap>(
           invitation.ExtractMessagePipe(mojom::kBootstrapPipeName)),
-      uid_, gid_,
+      uid_, gid_, metadata_cache_lifetime_, metadata_cache_size_,
       base::BindOnce(&SmbFsDaemon::OnSessionShutdown, base::Unretained(this)));
 
   return true;
@@ -13,10 +13,12 @@
 
 #include <base/files/file_path.h>
 #include <base/files/scoped_temp_dir.h>
+#include <base/time/time.h>
 #include <brillo/daemons/dbus_daemon.h>
 #include <mojo/core/embedder/scoped_ipc_support.h>
 
 #include "smbfs/mojo_session.h"
+#include "smbfs/smb_filesystem.h"
 
 namespace smbfs {
 
@@ -57,6 +59,9 @@ class SmbFsDaemon : public brillo::DBusDaemon {
   const uid_t uid_;
   const gid_t gid_;
   const std::string mojo_id_;
+  base::TimeDelta metadata_cache_lifetime_ =
+      SmbFilesystem::kDefaultMetadataCacheLifetime;
+  size_t metadata_cache_size_ = SmbFilesystem::kDefaultMetadataCacheSize;
   std::unique_ptr<FuseSession> session_;
   std::unique_ptr<Filesystem> fs_;
   base::ScopedTempDir temp_dir_;
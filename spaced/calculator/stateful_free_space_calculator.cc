@@ -8,6 +8,7 @@
 #include <sys/statvfs.h>
 
 #include <algorithm>
+#include <cstdlib>
 
 #include <base/logging.h>
 #include <base/posix/eintr_wrapper.h>
@@ -33,6 +34,14 @@ spaced::StatefulDiskSpaceState GetDiskSpaceState(int64_t free_space) {
   }
 }
 
+// Free space changes smaller than this are not signalled until the next
+// heartbeat.
+constexpr int64_t kSignalThresholdBytes = 32LL * 1024 * 1024;
+// Maximum interval between two signals, so that subscribers know the free
+// space did not change.
+constexpr base::TimeDelta kHeartbeatSignalPeriod = base::Minutes(1);
+
+// Minimum interval between two signals for a free space change, in seconds.
 int64_t GetSignalPeriod(spaced::StatefulDiskSpaceState state) {
   switch (state) {
     case spaced::StatefulDiskSpaceState::LOW:
@@ -106,14 +115,29 @@ void StatefulFreeSpaceCalculator::MaybeSignalDiskSpaceUpdate() {
   int64_t stateful_free_space = GetSize();
   base::Time now = base::Time::Now();
   spaced::StatefulDiskSpaceState state = GetDiskSpaceState(stateful_free_space);
+  base::TimeDelta since_last_signal = now - last_signalled_;
+
+  // Subscribers are told right away about state changes, rate limited about
+  // significant free space changes, and periodically otherwise.
+  bool signal = false;
+  if (!last_signalled_update_ || last_signalled_update_->state() != state) {
+    signal = true;
+  } else if (std::abs(stateful_free_space -
+                      last_signalled_update_->free_space_bytes()) >=
+             kSignalThresholdBytes) {
+    signal = since_last_signal > base::Seconds(GetSignalPeriod(state));
+  } else {
+    signal = since_last_signal > kHeartbeatSignalPeriod;
+  }
 
-  if (now - last_signalled_ > base::Seconds(GetSignalPeriod(state))) {
+  if (signal) {
     spaced::StatefulDiskSpaceUpdate payload;
 
     payload.set_state(state);
     payload.set_free_space_bytes(stateful_free_space);
 
     last_signalled_ = now;
+    last_signalled_update_ = payload;
     signal_.Run(payload);
   }
 }
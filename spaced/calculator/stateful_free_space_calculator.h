@@ -10,6 +10,8 @@
 #include <sys/stat.h>
 #include <sys/statvfs.h>
 
+#include <optional>
+
 #include <base/files/file_path.h>
 #include <base/timer/timer.h>
 #include <brillo/blkdev_utils/lvm.h>
@@ -40,6 +42,7 @@ class BRILLO_EXPORT StatefulFreeSpaceCalculator : public Calculator {
   FRIEND_TEST(StatefulFreeSpaceCalculatorTest, NoThinpoolCalculator);
   FRIEND_TEST(StatefulFreeSpaceCalculatorTest, ThinpoolCalculator);
   FRIEND_TEST(StatefulFreeSpaceCalculatorTest, SignalStatefulDiskSpaceUpdate);
+  FRIEND_TEST(StatefulFreeSpaceCalculatorTest, SignalOnlySignificantChanges);
 
   // Updates the amount of free space available on the stateful partition.
   void UpdateSize();
@@ -47,8 +50,8 @@ class BRILLO_EXPORT StatefulFreeSpaceCalculator : public Calculator {
   // In addition to update size, conditionally emit a signal to
   void UpdateSizeAndSignal();
 
-  // Signal an update on the disk space state, depending on the amount of space
-  // available and the time elapsed.
+  // Signal an update on the disk space state, depending on how much the space
+  // available changed since the last update and the time elapsed.
   void MaybeSignalDiskSpaceUpdate();
 
   base::RepeatingTimer timer_;
@@ -56,6 +59,7 @@ class BRILLO_EXPORT StatefulFreeSpaceCalculator : public Calculator {
   std::optional<brillo::Thinpool> thinpool_;
 
   base::Time last_signalled_;
+  std::optional<StatefulDiskSpaceUpdate> last_signalled_update_;
   base::RepeatingCallback<void(const StatefulDiskSpaceUpdate&)> signal_;
 };
 
@@ -43,6 +43,8 @@ class StatefulFreeSpaceCalculatorMock : public StatefulFreeSpaceCalculator {
             task_runner, time_delta_seconds, thinpool, signal),
         st_(st) {}
 
+  void set_statvfs(struct statvfs st) { st_ = st; }
+
  protected:
   int StatVFS(const base::FilePath& path, struct statvfs* st) override {
     memcpy(st, &st_, sizeof(struct statvfs));
@@ -73,10 +75,15 @@ class StatefulFreeSpaceCalculatorTest : public testing::Test {
     return base::BindRepeating([](const StatefulDiskSpaceUpdate&) {});
   }
 
+  void FastForwardBy(base::TimeDelta delta) {
+    task_environment_.FastForwardBy(delta);
+  }
+
  private:
   base::test::TaskEnvironment task_environment_{
       base::test::TaskEnvironment::ThreadingMode::MAIN_THREAD_ONLY,
-      base::test::TaskEnvironment::MainThreadType::IO};
+      base::test::TaskEnvironment::MainThreadType::IO,
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
 };
 
 TEST_F(StatefulFreeSpaceCalculatorTest, StatVfsError) {
@@ -154,4 +161,49 @@ TEST_F(StatefulFreeSpaceCalculatorTest, SignalStatefulDiskSpaceUpdate) {
   EXPECT_EQ(status, StatefulDiskSpaceState::CRITICAL);
 }
 
+TEST_F(StatefulFreeSpaceCalculatorTest, SignalOnlySignificantChanges) {
+  std::vector<StatefulDiskSpaceUpdate> updates;
+  base::RepeatingCallback callback = base::BindRepeating(
+      [](std::vector<StatefulDiskSpaceUpdate>* updates,
+         const StatefulDiskSpaceUpdate& update) { updates->push_back(update); },
+      &updates);
+
+  // 4GiB available.
+  struct statvfs st = {
+      .f_frsize = 4096, .f_blocks = 2097152, .f_bavail = 1048576, .f_fsid = 1};
+  StatefulFreeSpaceCalculatorMock calculator(st, GetTestThreadRunner(), 0,
+                                             std::nullopt, callback);
+  calculator.UpdateSizeAndSignal();
+  ASSERT_EQ(updates.size(), 1u);
+  EXPECT_EQ(updates.back().state(), StatefulDiskSpaceState::NORMAL);
+
+  // Small changes are only signalled by the heartbeat.
+  st.f_bavail -= 1024;
+  calculator.set_statvfs(st);
+  FastForwardBy(base::Seconds(10));
+  calculator.UpdateSizeAndSignal();
+  EXPECT_EQ(updates.size(), 1u);
+  FastForwardBy(base::Minutes(1));
+  calculator.UpdateSizeAndSignal();
+  ASSERT_EQ(updates.size(), 2u);
+  EXPECT_EQ(updates.back().free_space_bytes(), 4290772992);
+
+  // Significant changes are signalled after the period of the state.
+  st.f_bavail -= 65536;
+  calculator.set_statvfs(st);
+  calculator.UpdateSizeAndSignal();
+  EXPECT_EQ(updates.size(), 2u);
+  FastForwardBy(base::Seconds(10));
+  calculator.UpdateSizeAndSignal();
+  ASSERT_EQ(updates.size(), 3u);
+  EXPECT_EQ(updates.back().free_space_bytes(), 4022337536);
+
+  // State changes are signalled right away.
+  st.f_bavail = 1024;
+  calculator.set_statvfs(st);
+  calculator.UpdateSizeAndSignal();
+  ASSERT_EQ(updates.size(), 4u);
+  EXPECT_EQ(updates.back().state(), StatefulDiskSpaceState::CRITICAL);
+}
+
 }  // namespace spaced
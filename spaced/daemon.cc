@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <base/files/file_util.h>
 #include <base/files/scoped_file.h>
@@ -29,6 +30,10 @@
 namespace spaced {
 namespace {
 constexpr int64_t kCriticalRefreshPeriodSeconds = 1;
+// Clients polling the free disk space more often than the calculator refreshes
+// it get the cached value instead of running statvfs() again.
+constexpr base::TimeDelta kFreeDiskSpaceCacheTtl =
+    base::Seconds(kCriticalRefreshPeriodSeconds);
 
 base::FilePath GetRootDevice() {
   // Get the root device.
@@ -71,14 +76,20 @@ std::optional<brillo::Thinpool> GetThinpool() {
   return lvm.GetThinpool(*vg, "thinpool");
 }
 
+std::unique_ptr<DiskUsageUtil> CreateDiskUsageUtil() {
+  auto disk_usage_util =
+      std::make_unique<DiskUsageUtilImpl>(GetRootDevice(), GetThinpool());
+  disk_usage_util->EnableFreeDiskSpaceCache(kFreeDiskSpaceCacheTtl);
+  return disk_usage_util;
+}
+
 }  // namespace
 
 DBusAdaptor::DBusAdaptor(scoped_refptr<dbus::Bus> bus)
     : org::chromium::SpacedAdaptor(this),
       dbus_object_(
           nullptr, bus, dbus::ObjectPath(::spaced::kSpacedServicePath)),
-      disk_usage_util_(
-          std::make_unique<DiskUsageUtilImpl>(GetRootDevice(), GetThinpool())),
+      disk_usage_util_(CreateDiskUsageUtil()),
       task_runner_(bus->GetOriginTaskRunner()),
       stateful_free_space_calculator_(
           std::make_unique<StatefulFreeSpaceCalculator>(
@@ -133,6 +144,15 @@ int64_t DBusAdaptor::GetQuotaCurrentSpaceForProjectId(const std::string& path,
       base::FilePath(path), project_id);
 }
 
+GetQuotaCurrentSpacesForIdsReply DBusAdaptor::GetQuotaCurrentSpacesForIds(
+    const std::string& path,
+    const std::vector<uint32_t>& uids,
+    const std::vector<uint32_t>& gids,
+    const std::vector<uint32_t>& project_ids) {
+  return disk_usage_util_->GetQuotaCurrentSpacesForIds(
+      base::FilePath(path), uids, gids, project_ids);
+}
+
 SetProjectIdReply DBusAdaptor::SetProjectId(const base::ScopedFD& fd,
                                             uint32_t project_id) {
   SetProjectIdReply reply;
@@ -152,6 +172,20 @@ SetProjectInheritanceFlagReply DBusAdaptor::SetProjectInheritanceFlag(
   return reply;
 }
 
+bool DBusAdaptor::RegisterProjectIdConsumer(uint32_t project_id,
+                                            const ProjectIdConsumer& consumer) {
+  return project_id_index_.Register(project_id, consumer);
+}
+
+void DBusAdaptor::UnregisterProjectIdConsumer(uint32_t project_id) {
+  project_id_index_.Unregister(project_id);
+}
+
+StorageBreakdown DBusAdaptor::GetStorageBreakdown(const std::string& path) {
+  return project_id_index_.GetStorageBreakdown(disk_usage_util_.get(),
+                                               base::FilePath(path));
+}
+
 void DBusAdaptor::StatefulDiskSpaceUpdateCallback(
     const StatefulDiskSpaceUpdate& state) {
   SendStatefulDiskSpaceUpdateSignal(state);
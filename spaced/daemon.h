@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <base/files/scoped_file.h>
 #include <base/task/task_runner.h>
@@ -18,6 +19,7 @@
 #include "spaced/calculator/stateful_free_space_calculator.h"
 #include "spaced/dbus_adaptors/org.chromium.Spaced.h"
 #include "spaced/disk_usage.h"
+#include "spaced/project_id_index.h"
 
 namespace spaced {
 
@@ -44,16 +46,27 @@ class DBusAdaptor : public org::chromium::SpacedInterface,
                                      uint32_t gid) override;
   int64_t GetQuotaCurrentSpaceForProjectId(const std::string& path,
                                            uint32_t project_id) override;
+  GetQuotaCurrentSpacesForIdsReply GetQuotaCurrentSpacesForIds(
+      const std::string& path,
+      const std::vector<uint32_t>& uids,
+      const std::vector<uint32_t>& gids,
+      const std::vector<uint32_t>& project_ids) override;
   SetProjectIdReply SetProjectId(const base::ScopedFD& fd,
                                  uint32_t project_id) override;
   SetProjectInheritanceFlagReply SetProjectInheritanceFlag(
       const base::ScopedFD& fd, bool enable) override;
 
+  bool RegisterProjectIdConsumer(uint32_t project_id,
+                                 const ProjectIdConsumer& consumer) override;
+  void UnregisterProjectIdConsumer(uint32_t project_id) override;
+  StorageBreakdown GetStorageBreakdown(const std::string& path) override;
+
   void StatefulDiskSpaceUpdateCallback(const StatefulDiskSpaceUpdate& state);
 
  private:
   brillo::dbus_utils::DBusObject dbus_object_;
   std::unique_ptr<DiskUsageUtil> disk_usage_util_;
+  ProjectIdIndex project_id_index_;
 
   // Async. task runner. The calculations are offloaded from the D-Bus thread so
   // that slow disk usage calculations do not DoS D-Bus requests into spaced.
@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -31,6 +32,12 @@ extern "C" {
 }
 
 namespace spaced {
+namespace {
+
+// Maximum number of paths whose free disk space is cached.
+constexpr size_t kMaxCachedFreeDiskSpacePaths = 32;
+
+}  // namespace
 
 DiskUsageUtilImpl::DiskUsageUtilImpl(const base::FilePath& rootdev,
                                      std::optional<brillo::Thinpool> thinpool)
@@ -56,6 +63,14 @@ base::FilePath DiskUsageUtilImpl::GetDevice(const base::FilePath& path) {
 }
 
 int64_t DiskUsageUtilImpl::GetFreeDiskSpace(const base::FilePath& path) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  auto cached = free_disk_space_cache_.find(path);
+  if (cached != free_disk_space_cache_.end()) {
+    if (now < cached->second.expiration)
+      return cached->second.free_disk_space;
+    free_disk_space_cache_.erase(cached);
+  }
+
   // Use statvfs() to get the free space for the given path.
   struct statvfs stat;
 
@@ -66,9 +81,22 @@ int64_t DiskUsageUtilImpl::GetFreeDiskSpace(const base::FilePath& path) {
 
   int64_t free_disk_space = static_cast<int64_t>(stat.f_bavail) * stat.f_frsize;
 
+  if (free_disk_space_cache_ttl_.is_positive()) {
+    // Callers choose the paths, so bound the size of the cache.
+    if (free_disk_space_cache_.size() >= kMaxCachedFreeDiskSpacePaths)
+      free_disk_space_cache_.clear();
+    free_disk_space_cache_[path] = {free_disk_space,
+                                    now + free_disk_space_cache_ttl_};
+  }
+
   return free_disk_space;
 }
 
+void DiskUsageUtilImpl::EnableFreeDiskSpaceCache(base::TimeDelta ttl) {
+  free_disk_space_cache_ttl_ = ttl;
+  free_disk_space_cache_.clear();
+}
+
 int64_t DiskUsageUtilImpl::GetTotalDiskSpace(const base::FilePath& path) {
   // Use statvfs() to get the total space for the given path.
   struct statvfs stat;
@@ -134,18 +162,52 @@ int64_t DiskUsageUtilImpl::GetQuotaCurrentSpaceForProjectId(
   return GetQuotaCurrentSpaceForId(path, project_id, PRJQUOTA);
 }
 
+GetQuotaCurrentSpacesForIdsReply
+DiskUsageUtilImpl::GetQuotaCurrentSpacesForIds(
+    const base::FilePath& path,
+    const std::vector<uint32_t>& uids,
+    const std::vector<uint32_t>& gids,
+    const std::vector<uint32_t>& project_ids) {
+  GetQuotaCurrentSpacesForIdsReply reply;
+
+  // Resolving the device is the expensive part of a query, so only do it once.
+  const base::FilePath device = GetDevice(path);
+  if (device.empty())
+    LOG(ERROR) << "Failed to find logical device for home directory";
+
+  auto query = [&](const std::vector<uint32_t>& ids, int quota_type,
+                   google::protobuf::Map<uint32_t, int64_t>* curspaces) {
+    for (uint32_t id : ids) {
+      (*curspaces)[id] =
+          device.empty()
+              ? -1
+              : GetQuotaCurrentSpaceForIdOnDevice(device, id, quota_type);
+    }
+  };
+  query(uids, USRQUOTA, reply.mutable_curspaces_for_uids());
+  query(gids, GRPQUOTA, reply.mutable_curspaces_for_gids());
+  query(project_ids, PRJQUOTA, reply.mutable_curspaces_for_project_ids());
+
+  return reply;
+}
+
 int64_t DiskUsageUtilImpl::GetQuotaCurrentSpaceForId(const base::FilePath& path,
                                                      uint32_t id,
                                                      int quota_type) {
-  DCHECK(0 <= quota_type && quota_type < MAXQUOTAS)
-      << "Invalid quota_type: " << quota_type;
-
   const base::FilePath device = GetDevice(path);
   if (device.empty()) {
     LOG(ERROR) << "Failed to find logical device for home directory";
     return -1;
   }
 
+  return GetQuotaCurrentSpaceForIdOnDevice(device, id, quota_type);
+}
+
+int64_t DiskUsageUtilImpl::GetQuotaCurrentSpaceForIdOnDevice(
+    const base::FilePath& device, uint32_t id, int quota_type) {
+  DCHECK(0 <= quota_type && quota_type < MAXQUOTAS)
+      << "Invalid quota_type: " << quota_type;
+
   struct dqblk dq = {};
   if (QuotaCtl(QCMD(Q_GETQUOTA, quota_type), device, id, &dq) != 0) {
     PLOG(ERROR) << "quotactl failed: quota_type=" << quota_type << ", id=" << id
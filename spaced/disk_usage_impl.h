@@ -8,13 +8,16 @@
 #include <sys/quota.h>
 #include <sys/statvfs.h>
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include <base/task/task_runner.h>
 #include <base/files/file_path.h>
 #include <base/files/scoped_file.h>
+#include <base/time/time.h>
 #include <brillo/blkdev_utils/lvm.h>
 #include <brillo/brillo_export.h>
 
@@ -38,6 +41,11 @@ class BRILLO_EXPORT DiskUsageUtilImpl : public DiskUsageUtil {
                                      uint32_t gid) override;
   int64_t GetQuotaCurrentSpaceForProjectId(const base::FilePath& path,
                                            uint32_t project_id) override;
+  GetQuotaCurrentSpacesForIdsReply GetQuotaCurrentSpacesForIds(
+      const base::FilePath& path,
+      const std::vector<uint32_t>& uids,
+      const std::vector<uint32_t>& gids,
+      const std::vector<uint32_t>& project_ids) override;
   bool SetProjectId(const base::ScopedFD& fd,
                     uint32_t project_id,
                     int* out_error) override;
@@ -45,6 +53,10 @@ class BRILLO_EXPORT DiskUsageUtilImpl : public DiskUsageUtil {
                                  bool enable,
                                  int* out_error) override;
 
+  // Caches the free disk space of each path for |ttl|, so that frequent
+  // queries do not all run statvfs().
+  void EnableFreeDiskSpaceCache(base::TimeDelta ttl);
+
  protected:
   // Runs statvfs() on a given path.
   virtual int StatVFS(const base::FilePath& path, struct statvfs* st);
@@ -65,12 +77,23 @@ class BRILLO_EXPORT DiskUsageUtilImpl : public DiskUsageUtil {
   virtual int64_t GetBlockDeviceSize(const base::FilePath& device);
 
  private:
+  struct CachedFreeDiskSpace {
+    int64_t free_disk_space;
+    base::TimeTicks expiration;
+  };
+
   int64_t GetQuotaCurrentSpaceForId(const base::FilePath& path,
                                     uint32_t id,
                                     int quota_type);
+  int64_t GetQuotaCurrentSpaceForIdOnDevice(const base::FilePath& device,
+                                            uint32_t id,
+                                            int quota_type);
 
   const base::FilePath rootdev_;
   std::optional<brillo::Thinpool> thinpool_;
+
+  base::TimeDelta free_disk_space_cache_ttl_;
+  std::map<base::FilePath, CachedFreeDiskSpace> free_disk_space_cache_;
 };
 
 }  // namespace spaced
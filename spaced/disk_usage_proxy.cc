@@ -5,8 +5,10 @@
 #include "spaced/disk_usage_proxy.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <base/files/scoped_file.h>
 #include <base/functional/callback.h>
@@ -153,6 +155,29 @@ int64_t DiskUsageProxy::GetQuotaCurrentSpaceForProjectId(
   return current_space;
 }
 
+GetQuotaCurrentSpacesForIdsReply DiskUsageProxy::GetQuotaCurrentSpacesForIds(
+    const base::FilePath& path,
+    const std::vector<uint32_t>& uids,
+    const std::vector<uint32_t>& gids,
+    const std::vector<uint32_t>& project_ids) {
+  GetQuotaCurrentSpacesForIdsReply reply;
+  brillo::ErrorPtr error;
+  // Return -1 for all the ids if call fails.
+  if (!spaced_proxy_->GetQuotaCurrentSpacesForIds(
+          path.value(), uids, gids, project_ids, &reply, &error)) {
+    LOG(ERROR) << "Failed to call GetQuotaCurrentSpacesForIds, error: "
+               << error->GetMessage();
+    reply.Clear();
+    for (uint32_t uid : uids)
+      (*reply.mutable_curspaces_for_uids())[uid] = -1;
+    for (uint32_t gid : gids)
+      (*reply.mutable_curspaces_for_gids())[gid] = -1;
+    for (uint32_t project_id : project_ids)
+      (*reply.mutable_curspaces_for_project_ids())[project_id] = -1;
+  }
+  return reply;
+}
+
 bool DiskUsageProxy::SetProjectId(const base::ScopedFD& fd,
                                   uint32_t project_id,
                                   int* out_error) {
@@ -182,6 +207,40 @@ bool DiskUsageProxy::SetProjectInheritanceFlag(const base::ScopedFD& fd,
   return result.success();
 }
 
+bool DiskUsageProxy::RegisterProjectIdConsumer(
+    uint32_t project_id, const ProjectIdConsumer& consumer) {
+  bool success = false;
+  brillo::ErrorPtr error;
+  // Return false if call fails.
+  if (!spaced_proxy_->RegisterProjectIdConsumer(project_id, consumer, &success,
+                                                &error)) {
+    LOG(ERROR) << "Failed to call RegisterProjectIdConsumer, error: "
+               << error->GetMessage();
+    return false;
+  }
+  return success;
+}
+
+void DiskUsageProxy::UnregisterProjectIdConsumer(uint32_t project_id) {
+  brillo::ErrorPtr error;
+  if (!spaced_proxy_->UnregisterProjectIdConsumer(project_id, &error)) {
+    LOG(ERROR) << "Failed to call UnregisterProjectIdConsumer, error: "
+               << error->GetMessage();
+  }
+}
+
+std::optional<StorageBreakdown> DiskUsageProxy::GetStorageBreakdown(
+    const base::FilePath& path) {
+  StorageBreakdown breakdown;
+  brillo::ErrorPtr error;
+  if (!spaced_proxy_->GetStorageBreakdown(path.value(), &breakdown, &error)) {
+    LOG(ERROR) << "Failed to call GetStorageBreakdown, error: "
+               << error->GetMessage();
+    return std::nullopt;
+  }
+  return breakdown;
+}
+
 void DiskUsageProxy::OnStatefulDiskSpaceUpdate(
     const StatefulDiskSpaceUpdate& update) {
   for (SpacedObserverInterface& observer : observer_list_) {
@@ -6,6 +6,8 @@
 #define SPACED_DISK_USAGE_PROXY_H_
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <base/files/file_path.h>
 #include <base/files/scoped_file.h>
@@ -50,6 +52,11 @@ class BRILLO_EXPORT DiskUsageProxy : public DiskUsageUtil {
                                      uint32_t gid) override;
   int64_t GetQuotaCurrentSpaceForProjectId(const base::FilePath& path,
                                            uint32_t project_id) override;
+  GetQuotaCurrentSpacesForIdsReply GetQuotaCurrentSpacesForIds(
+      const base::FilePath& path,
+      const std::vector<uint32_t>& uids,
+      const std::vector<uint32_t>& gids,
+      const std::vector<uint32_t>& project_ids) override;
   bool SetProjectId(const base::ScopedFD& fd,
                     uint32_t project_id,
                     int* out_error) override;
@@ -57,6 +64,14 @@ class BRILLO_EXPORT DiskUsageProxy : public DiskUsageUtil {
                                  bool enable,
                                  int* out_error) override;
 
+  // Project ID consumers, see ProjectIdIndex.
+  bool RegisterProjectIdConsumer(uint32_t project_id,
+                                 const ProjectIdConsumer& consumer);
+  void UnregisterProjectIdConsumer(uint32_t project_id);
+  // Returns std::nullopt if the call fails.
+  std::optional<StorageBreakdown> GetStorageBreakdown(
+      const base::FilePath& path);
+
   void OnStatefulDiskSpaceUpdate(const spaced::StatefulDiskSpaceUpdate& space);
 
   void AddObserver(SpacedObserverInterface* observer);
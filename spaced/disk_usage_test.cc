@@ -17,6 +17,8 @@
 
 #include <base/logging.h>
 #include <base/strings/stringprintf.h>
+#include <base/test/task_environment.h>
+#include <base/time/time.h>
 #include <brillo/blkdev_utils/mock_lvm.h>
 
 extern "C" {
@@ -43,14 +45,19 @@ class DiskUsageUtilMock : public DiskUsageUtilImpl {
   DiskUsageUtilMock(struct statvfs st, std::optional<brillo::Thinpool> thinpool)
       : DiskUsageUtilImpl(base::FilePath("/dev/foo"), thinpool), st_(st) {}
 
+  void set_statvfs(struct statvfs st) { st_ = st; }
+  int statvfs_calls() const { return statvfs_calls_; }
+
  protected:
   int StatVFS(const base::FilePath& path, struct statvfs* st) override {
+    statvfs_calls_++;
     memcpy(st, &st_, sizeof(struct statvfs));
     return !st_.f_fsid;
   }
 
  private:
   struct statvfs st_;
+  int statvfs_calls_ = 0;
 };
 
 TEST(DiskUsageUtilTest, FailedVfsCall) {
@@ -77,6 +84,38 @@ TEST(DiskUsageUtilTest, FilesystemData) {
   EXPECT_EQ(disk_usage_mock.GetTotalDiskSpace(path), 8388608);
 }
 
+TEST(DiskUsageUtilTest, CachedFreeDiskSpace) {
+  base::test::TaskEnvironment task_environment(
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME);
+  struct statvfs st = {};
+  st.f_fsid = 1;
+  st.f_bavail = 1024;
+  st.f_blocks = 2048;
+  st.f_frsize = 4096;
+
+  DiskUsageUtilMock disk_usage_mock(st, std::nullopt);
+  disk_usage_mock.EnableFreeDiskSpaceCache(base::Seconds(1));
+  base::FilePath path("/foo/bar");
+
+  EXPECT_EQ(disk_usage_mock.GetFreeDiskSpace(path), 4194304);
+  EXPECT_EQ(disk_usage_mock.statvfs_calls(), 1);
+
+  // Queries within the TTL are served from the cache.
+  st.f_bavail = 512;
+  disk_usage_mock.set_statvfs(st);
+  task_environment.FastForwardBy(base::Milliseconds(500));
+  EXPECT_EQ(disk_usage_mock.GetFreeDiskSpace(path), 4194304);
+  EXPECT_EQ(disk_usage_mock.statvfs_calls(), 1);
+
+  // Other paths are cached separately.
+  EXPECT_EQ(disk_usage_mock.GetFreeDiskSpace(base::FilePath("/foo")), 2097152);
+  EXPECT_EQ(disk_usage_mock.statvfs_calls(), 2);
+
+  task_environment.FastForwardBy(base::Milliseconds(500));
+  EXPECT_EQ(disk_usage_mock.GetFreeDiskSpace(path), 2097152);
+  EXPECT_EQ(disk_usage_mock.statvfs_calls(), 3);
+}
+
 TEST(DiskUsageUtilTest, ThinProvisionedVolume) {
   struct statvfs st = {};
   st.f_fsid = 1;
@@ -200,6 +239,7 @@ class DiskUsageQuotaMock : public DiskUsageUtilImpl {
   void set_current_space_for_project_id(uint32_t project_id, uint64_t space) {
     project_id_to_current_space_[project_id] = space;
   }
+  int get_device_calls() const { return get_device_calls_; }
 
   int Ioctl(int fd, uint32_t request, void* ptr) override {
     switch (request) {
@@ -236,6 +276,7 @@ class DiskUsageQuotaMock : public DiskUsageUtilImpl {
 
  protected:
   base::FilePath GetDevice(const base::FilePath& path) override {
+    get_device_calls_++;
     return home_device_;
   }
 
@@ -269,6 +310,7 @@ class DiskUsageQuotaMock : public DiskUsageUtilImpl {
   std::map<uint32_t, uint64_t> project_id_to_current_space_;
   std::map<int, int> fd_to_project_id_;
   std::map<int, int> fd_to_ext_flags_;
+  int get_device_calls_ = 0;
 };
 
 TEST(DiskUsageUtilTest, QuotaNotSupportedWhenPathNotMounted) {
@@ -307,6 +349,43 @@ TEST(DiskUsageUtilTest, QuotaSupported) {
   EXPECT_EQ(disk_usage_mock.GetQuotaCurrentSpaceForProjectId(path, 101), -1);
 }
 
+TEST(DiskUsageUtilTest, QuotaCurrentSpacesForIds) {
+  DiskUsageQuotaMock disk_usage_mock(base::FilePath("/dev/bar"));
+  base::FilePath path(kQuotaSamplePath);
+  disk_usage_mock.set_current_space_for_uid(1, 10);
+  disk_usage_mock.set_current_space_for_uid(3, 15);
+  disk_usage_mock.set_current_space_for_gid(10, 20);
+  disk_usage_mock.set_current_space_for_project_id(100, 30);
+
+  GetQuotaCurrentSpacesForIdsReply reply =
+      disk_usage_mock.GetQuotaCurrentSpacesForIds(path, {1, 2, 3}, {10},
+                                                  {100, 101});
+
+  // The device is only resolved once for all the ids.
+  EXPECT_EQ(disk_usage_mock.get_device_calls(), 1);
+  ASSERT_EQ(reply.curspaces_for_uids_size(), 3);
+  EXPECT_EQ(reply.curspaces_for_uids().at(1), 10);
+  EXPECT_EQ(reply.curspaces_for_uids().at(2), -1);
+  EXPECT_EQ(reply.curspaces_for_uids().at(3), 15);
+  ASSERT_EQ(reply.curspaces_for_gids_size(), 1);
+  EXPECT_EQ(reply.curspaces_for_gids().at(10), 20);
+  ASSERT_EQ(reply.curspaces_for_project_ids_size(), 2);
+  EXPECT_EQ(reply.curspaces_for_project_ids().at(100), 30);
+  EXPECT_EQ(reply.curspaces_for_project_ids().at(101), -1);
+}
+
+TEST(DiskUsageUtilTest, QuotaCurrentSpacesForIdsWhenPathNotMounted) {
+  DiskUsageQuotaMock disk_usage_mock(base::FilePath(""));
+  base::FilePath path(kQuotaSamplePath);
+
+  GetQuotaCurrentSpacesForIdsReply reply =
+      disk_usage_mock.GetQuotaCurrentSpacesForIds(path, {0}, {1}, {2});
+
+  EXPECT_EQ(reply.curspaces_for_uids().at(0), -1);
+  EXPECT_EQ(reply.curspaces_for_gids().at(1), -1);
+  EXPECT_EQ(reply.curspaces_for_project_ids().at(2), -1);
+}
+
 TEST(DiskUsageUtilTest, SetProjectId) {
   DiskUsageQuotaMock disk_usage_mock(base::FilePath("/dev/foo"));
   const base::ScopedFD fd(open("/dev/null", O_RDONLY));
@@ -0,0 +1,77 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "spaced/project_id_index.h"
+
+#include <vector>
+
+#include <base/logging.h>
+
+namespace spaced {
+
+bool ProjectIdIndex::Register(uint32_t project_id,
+                              const ProjectIdConsumer& consumer) {
+  if (consumer.type() == CONSUMER_UNKNOWN || consumer.name().empty()) {
+    LOG(ERROR) << "Invalid consumer for project ID " << project_id;
+    return false;
+  }
+  if (consumers_.size() >= kMaxEntries && !consumers_.contains(project_id)) {
+    LOG(ERROR) << "Too many project IDs registered, ignoring " << project_id;
+    return false;
+  }
+
+  consumers_[project_id] = consumer;
+  return true;
+}
+
+void ProjectIdIndex::Unregister(uint32_t project_id) {
+  consumers_.erase(project_id);
+}
+
+StorageBreakdown ProjectIdIndex::GetStorageBreakdown(
+    DiskUsageUtil* disk_usage_util, const base::FilePath& path) const {
+  std::vector<uint32_t> project_ids;
+  project_ids.reserve(consumers_.size());
+  for (const auto& [project_id, consumer] : consumers_)
+    project_ids.push_back(project_id);
+
+  GetQuotaCurrentSpacesForIdsReply reply =
+      disk_usage_util->GetQuotaCurrentSpacesForIds(path, {}, {}, project_ids);
+
+  StorageBreakdown breakdown;
+  for (const auto& [project_id, consumer] : consumers_) {
+    int64_t current_space = -1;
+    auto it = reply.curspaces_for_project_ids().find(project_id);
+    if (it != reply.curspaces_for_project_ids().end())
+      current_space = it->second;
+
+    StorageBreakdown::Entry* entry = breakdown.add_entries();
+    entry->set_project_id(project_id);
+    *entry->mutable_consumer() = consumer;
+    entry->set_current_space(current_space);
+
+    if (current_space < 0)
+      continue;
+    switch (consumer.type()) {
+      case CONSUMER_APP:
+        breakdown.set_total_app_space(breakdown.total_app_space() +
+                                      current_space);
+        break;
+      case CONSUMER_USER:
+        breakdown.set_total_user_space(breakdown.total_user_space() +
+                                       current_space);
+        break;
+      case CONSUMER_DLC:
+        breakdown.set_total_dlc_space(breakdown.total_dlc_space() +
+                                      current_space);
+        break;
+      default:
+        break;
+    }
+  }
+
+  return breakdown;
+}
+
+}  // namespace spaced
@@ -0,0 +1,53 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SPACED_PROJECT_ID_INDEX_H_
+#define SPACED_PROJECT_ID_INDEX_H_
+
+#include <cstdint>
+#include <map>
+
+#include <base/files/file_path.h>
+#include <brillo/brillo_export.h>
+#include <spaced/proto_bindings/spaced.pb.h>
+
+#include "spaced/disk_usage.h"
+
+namespace spaced {
+
+// Maps the project IDs set on files to the consumers owning them, e.g. an
+// application, the data of a user or a DLC, so that the disk space used by
+// every consumer can be broken down from the project quotas instead of walking
+// the directories.
+//
+// The index is only kept in memory: consumers are registered again by whoever
+// assigns their project ID, e.g. when the user's home is mounted.
+class BRILLO_EXPORT ProjectIdIndex {
+ public:
+  // Maximum number of project IDs the index holds.
+  static constexpr size_t kMaxEntries = 4096;
+
+  ProjectIdIndex() = default;
+  ProjectIdIndex(const ProjectIdIndex&) = delete;
+  ProjectIdIndex& operator=(const ProjectIdIndex&) = delete;
+  ~ProjectIdIndex() = default;
+
+  // Records |consumer| as the owner of |project_id|, replacing the previous
+  // one. Returns false if |consumer| has no type or name, or the index is
+  // full.
+  bool Register(uint32_t project_id, const ProjectIdConsumer& consumer);
+  void Unregister(uint32_t project_id);
+
+  // Returns the space used by each registered project ID on the device of
+  // |path|, querying all of them in one batch.
+  StorageBreakdown GetStorageBreakdown(DiskUsageUtil* disk_usage_util,
+                                       const base::FilePath& path) const;
+
+ private:
+  std::map<uint32_t, ProjectIdConsumer> consumers_;
+};
+
+}  // namespace spaced
+
+#endif  // SPACED_PROJECT_ID_INDEX_H_
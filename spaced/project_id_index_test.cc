@@ -0,0 +1,130 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "spaced/project_id_index.h"
+
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <base/files/file_path.h>
+#include <gtest/gtest.h>
+
+#include "spaced/disk_usage_impl.h"
+
+namespace spaced {
+namespace {
+
+constexpr char kSamplePath[] = "/home/user/chronos";
+
+class DiskUsageUtilFake : public DiskUsageUtilImpl {
+ public:
+  DiskUsageUtilFake()
+      : DiskUsageUtilImpl(base::FilePath("/dev/foo"), std::nullopt) {}
+
+  void set_current_space_for_project_id(uint32_t project_id, int64_t space) {
+    project_id_to_current_space_[project_id] = space;
+  }
+  int batches() const { return batches_; }
+
+  GetQuotaCurrentSpacesForIdsReply GetQuotaCurrentSpacesForIds(
+      const base::FilePath& path,
+      const std::vector<uint32_t>& uids,
+      const std::vector<uint32_t>& gids,
+      const std::vector<uint32_t>& project_ids) override {
+    batches_++;
+    GetQuotaCurrentSpacesForIdsReply reply;
+    for (uint32_t project_id : project_ids) {
+      auto it = project_id_to_current_space_.find(project_id);
+      (*reply.mutable_curspaces_for_project_ids())[project_id] =
+          it == project_id_to_current_space_.end() ? -1 : it->second;
+    }
+    return reply;
+  }
+
+ private:
+  std::map<uint32_t, int64_t> project_id_to_current_space_;
+  int batches_ = 0;
+};
+
+ProjectIdConsumer MakeConsumer(ProjectIdConsumerType type, const char* name) {
+  ProjectIdConsumer consumer;
+  consumer.set_type(type);
+  consumer.set_name(name);
+  return consumer;
+}
+
+}  // namespace
+
+TEST(ProjectIdIndexTest, StorageBreakdown) {
+  DiskUsageUtilFake disk_usage_util;
+  disk_usage_util.set_current_space_for_project_id(20000, 100);
+  disk_usage_util.set_current_space_for_project_id(20001, 200);
+  disk_usage_util.set_current_space_for_project_id(1000, 1000);
+  disk_usage_util.set_current_space_for_project_id(3000, 50);
+
+  ProjectIdIndex index;
+  EXPECT_TRUE(index.Register(20000, MakeConsumer(CONSUMER_APP, "com.foo")));
+  EXPECT_TRUE(index.Register(20001, MakeConsumer(CONSUMER_APP, "com.bar")));
+  EXPECT_TRUE(index.Register(1000, MakeConsumer(CONSUMER_USER, "user")));
+  EXPECT_TRUE(index.Register(3000, MakeConsumer(CONSUMER_DLC, "dlc")));
+  // Not mounted, so its quota cannot be queried.
+  EXPECT_TRUE(index.Register(3001, MakeConsumer(CONSUMER_DLC, "other-dlc")));
+
+  StorageBreakdown breakdown = index.GetStorageBreakdown(
+      &disk_usage_util, base::FilePath(kSamplePath));
+
+  // All the project IDs are queried at once.
+  EXPECT_EQ(disk_usage_util.batches(), 1);
+  ASSERT_EQ(breakdown.entries_size(), 5);
+  EXPECT_EQ(breakdown.entries(0).project_id(), 1000u);
+  EXPECT_EQ(breakdown.entries(0).consumer().name(), "user");
+  EXPECT_EQ(breakdown.entries(0).current_space(), 1000);
+  EXPECT_EQ(breakdown.entries(2).project_id(), 3001u);
+  EXPECT_EQ(breakdown.entries(2).current_space(), -1);
+  EXPECT_EQ(breakdown.entries(3).consumer().name(), "com.foo");
+  EXPECT_EQ(breakdown.entries(3).current_space(), 100);
+  EXPECT_EQ(breakdown.total_app_space(), 300);
+  EXPECT_EQ(breakdown.total_user_space(), 1000);
+  EXPECT_EQ(breakdown.total_dlc_space(), 50);
+}
+
+TEST(ProjectIdIndexTest, RegisterReplacesConsumer) {
+  DiskUsageUtilFake disk_usage_util;
+  disk_usage_util.set_current_space_for_project_id(20000, 100);
+
+  ProjectIdIndex index;
+  EXPECT_TRUE(index.Register(20000, MakeConsumer(CONSUMER_APP, "com.foo")));
+  EXPECT_TRUE(index.Register(20000, MakeConsumer(CONSUMER_APP, "com.bar")));
+
+  StorageBreakdown breakdown = index.GetStorageBreakdown(
+      &disk_usage_util, base::FilePath(kSamplePath));
+  ASSERT_EQ(breakdown.entries_size(), 1);
+  EXPECT_EQ(breakdown.entries(0).consumer().name(), "com.bar");
+
+  index.Unregister(20000);
+  breakdown = index.GetStorageBreakdown(&disk_usage_util,
+                                        base::FilePath(kSamplePath));
+  EXPECT_EQ(breakdown.entries_size(), 0);
+  EXPECT_EQ(breakdown.total_app_space(), 0);
+}
+
+TEST(ProjectIdIndexTest, RejectInvalidConsumers) {
+  ProjectIdIndex index;
+  EXPECT_FALSE(index.Register(1, MakeConsumer(CONSUMER_UNKNOWN, "foo")));
+  EXPECT_FALSE(index.Register(1, MakeConsumer(CONSUMER_APP, "")));
+}
+
+TEST(ProjectIdIndexTest, BoundedSize) {
+  ProjectIdIndex index;
+  for (uint32_t i = 0; i < ProjectIdIndex::kMaxEntries; i++)
+    EXPECT_TRUE(index.Register(i, MakeConsumer(CONSUMER_APP, "app")));
+
+  EXPECT_FALSE(index.Register(ProjectIdIndex::kMaxEntries,
+                              MakeConsumer(CONSUMER_APP, "app")));
+  // Existing entries can still be updated.
+  EXPECT_TRUE(index.Register(0, MakeConsumer(CONSUMER_APP, "other-app")));
+}
+
+}  // namespace spaced
@@ -35,6 +35,7 @@ constexpr char kStatefulPartitionDir[] =
     "/mnt/stateful_partition/unencrypted/userspace_swap.tmp";
 constexpr uint32_t kMiB = 1048576;
 constexpr uint32_t kSectorSize = 512;
+constexpr uint32_t kZramPageSize = 4096;
 
 constexpr base::TimeDelta kMaxIdleAge = base::Days(30);
 constexpr uint64_t kMinFilelistDefaultValueKB = 1000000;
@@ -254,6 +255,30 @@ absl::StatusOr<uint64_t> SwapTool::GetZramSize(uint64_t mem_total) {
   return requested_size_mib * 1024 * 1024;
 }
 
+// Use a fast compression algorithm for zram, and a denser one to recompress the
+// idle pages in the background. Return true if recompression is available,
+// which needs CONFIG_ZRAM_MULTI_COMP. Failures are not fatal, zram works with
+// its default algorithm.
+bool SwapTool::SetZramCompAlgorithms() {
+  absl::Status status = SwapToolUtil::Get()->WriteFile(
+      base::FilePath(kZramSysfsDir).Append("comp_algorithm"),
+      kZramPrimaryCompAlgorithm);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to set zram compression algorithm: " << status;
+    return false;
+  }
+
+  status = SwapToolUtil::Get()->WriteFile(
+      base::FilePath(kZramSysfsDir).Append("recomp_algorithm"),
+      "algo=" + std::string(kZramRecompAlgorithm) + " priority=1");
+  if (!status.ok()) {
+    LOG(WARNING) << "zram recompression is not available: " << status;
+    return false;
+  }
+
+  return true;
+}
+
 // Run swapon to enable zram swapping.
 // swapon may fail because of races with other programs that inspect all
 // block devices, so try several times.
@@ -279,6 +304,10 @@ absl::Status SwapTool::EnableZramSwapping() {
                             " tries" + " last error: " + status.ToString());
 }
 
+void SwapTool::StopPeriodicWriteback() {
+  zram_writeback_.reset();
+}
+
 // If we're unable to setup writeback just make sure we clean up any
 // mounts.
 // Devices are cleanup while class instances are released.
@@ -519,6 +548,9 @@ absl::Status SwapTool::SwapStart() {
   if (!SwapToolUtil::Get()->RunProcessHelper({"/sbin/modprobe", "zram"}).ok())
     LOG(WARNING) << "modprobe zram failed (compiled?)";
 
+  // Compression algorithms can only be set before zram disksize.
+  bool recompression = SetZramCompAlgorithms();
+
   // Set zram disksize.
   LOG(INFO) << "setting zram size to " << *size_byte << " bytes";
   status = SwapToolUtil::Get()->WriteFile(
@@ -532,10 +564,23 @@ absl::Status SwapTool::SwapStart() {
   if (!status.ok())
     return status;
 
-  return EnableZramSwapping();
+  status = EnableZramSwapping();
+  if (!status.ok())
+    return status;
+
+  if (recompression) {
+    zram_recompression_ = std::make_unique<ZramRecompressionController>(
+        ZramRecompressionParams());
+    zram_recompression_->Start();
+  }
+
+  return absl::OkStatus();
 }
 
 absl::Status SwapTool::SwapStop() {
+  StopPeriodicWriteback();
+  zram_recompression_.reset();
+
   // Return false if swap is already off.
   absl::StatusOr<bool> on = IsZramSwapOn();
   if (!on.ok())
@@ -670,10 +715,16 @@ absl::Status SwapTool::SwapZramEnableWriteback(uint32_t size) {
   LOG(INFO) << "Enabled writeback with size " +
                    std::to_string(wb_size_bytes_ / kMiB) + "MiB";
 
+  zram_writeback_ = std::make_unique<ZramWritebackController>(
+      wb_size_bytes_ / kZramPageSize, ZramWritebackParams());
+  zram_writeback_->Start();
+
   return absl::OkStatus();
 }
 
 absl::Status SwapTool::SwapZramSetWritebackLimit(uint32_t num_pages) {
+  StopPeriodicWriteback();
+
   base::FilePath filepath =
       base::FilePath(kZramSysfsDir).Append("writeback_limit_enable");
 
@@ -687,6 +738,8 @@ absl::Status SwapTool::SwapZramSetWritebackLimit(uint32_t num_pages) {
 }
 
 absl::Status SwapTool::SwapZramMarkIdle(uint32_t age_seconds) {
+  StopPeriodicWriteback();
+
   const auto age = base::Seconds(age_seconds);
 
   // Only allow marking pages as idle between 0 sec and 30 days.
@@ -699,6 +752,8 @@ absl::Status SwapTool::SwapZramMarkIdle(uint32_t age_seconds) {
 }
 
 absl::Status SwapTool::InitiateSwapZramWriteback(uint32_t mode) {
+  StopPeriodicWriteback();
+
   base::FilePath filepath = base::FilePath(kZramSysfsDir).Append("writeback");
   std::string mode_str;
   if (mode == WRITEBACK_IDLE) {
@@ -13,6 +13,9 @@
 #include <base/files/file_path.h>
 #include <brillo/errors/error.h>
 
+#include "swap_management/zram_recompression.h"
+#include "swap_management/zram_writeback.h"
+
 namespace swap_management {
 
 class LoopDev {
@@ -69,7 +72,9 @@ class SwapTool {
   absl::Status SwapSetSwappiness(uint32_t swappiness);
   std::string SwapStatus();
 
-  // Zram writeback configuration.
+  // Zram writeback configuration. Once enabled, writeback is done
+  // periodically until one of the other functions is called, which gives
+  // control of the writeback to the caller.
   absl::Status SwapZramEnableWriteback(uint32_t size_mb);
   absl::Status SwapZramSetWritebackLimit(uint32_t num_pages);
   absl::Status SwapZramMarkIdle(uint32_t age_seconds);
@@ -84,13 +89,18 @@ class SwapTool {
   absl::Status SetDefaultLowMemoryMargin(uint64_t mem_total);
   absl::Status InitializeMMTunables(uint64_t mem_total);
   absl::StatusOr<uint64_t> GetZramSize(uint64_t mem_total);
+  bool SetZramCompAlgorithms();
   absl::Status EnableZramSwapping();
 
+  std::unique_ptr<ZramRecompressionController> zram_recompression_;
+
   uint64_t wb_size_bytes_ = 0;
   uint64_t wb_nr_blocks_ = 0;
   uint64_t stateful_block_size_ = 0;
+  std::unique_ptr<ZramWritebackController> zram_writeback_;
 
   void CleanupWriteback();
+  void StopPeriodicWriteback();
   absl::Status ZramWritebackPrerequisiteCheck(uint32_t size);
   absl::Status GetZramWritebackInfo(uint32_t size);
   absl::Status CreateDmDevicesAndEnableWriteback();
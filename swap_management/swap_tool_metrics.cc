@@ -15,6 +15,28 @@ constexpr char kSwapMetricsFile[] = "/var/lib/swap/swap_metrics";
 constexpr char kSwapStartStatus[] = "ChromeOS.SwapManagement.SwapStart.Status";
 constexpr char kSwapStopStatus[] = "ChromeOS.SwapManagement.SwapStop.Status";
 constexpr uint32_t kNumAbslStatus = 21;
+constexpr char kZramWritebackResult[] =
+    "ChromeOS.SwapManagement.ZramWriteback.Result";
+constexpr char kZramWritebackSize[] =
+    "ChromeOS.SwapManagement.ZramWriteback.SizeMiB";
+constexpr int kZramWritebackSizeMaxMiB = 1024;
+constexpr int kZramWritebackSizeBuckets = 50;
+constexpr uint64_t kMiB = 1048576;
+constexpr char kZramCompressionRatio[] =
+    "ChromeOS.SwapManagement.Zram.CompressionRatioPercent";
+constexpr int kZramCompressionRatioMin = 100;
+constexpr int kZramCompressionRatioMax = 1000;
+constexpr int kZramCompressionRatioBuckets = 50;
+constexpr char kZramRecompressionResult[] =
+    "ChromeOS.SwapManagement.ZramRecompression.Result";
+constexpr char kZramRecompressionSaved[] =
+    "ChromeOS.SwapManagement.ZramRecompression.SavedMiB";
+constexpr int kZramRecompressionSavedMaxMiB = 4096;
+constexpr int kZramRecompressionSavedBuckets = 50;
+constexpr char kZramRecompressionCpuTime[] =
+    "ChromeOS.SwapManagement.ZramRecompression.CpuTime";
+constexpr base::TimeDelta kZramRecompressionCpuTimeMax = base::Minutes(5);
+constexpr int kZramRecompressionCpuTimeBuckets = 50;
 }  // namespace
 
 SwapToolMetrics* SwapToolMetrics::Get() {
@@ -39,4 +61,39 @@ void SwapToolMetrics::ReportSwapStopStatus(absl::Status status) {
                          kNumAbslStatus);
 }
 
+void SwapToolMetrics::ReportZramWritebackResult(ZramWritebackResult result) {
+  metrics_.SendEnumToUMA(kZramWritebackResult, result);
+}
+
+void SwapToolMetrics::ReportZramWritebackSize(uint64_t size_bytes) {
+  metrics_.SendToUMA(kZramWritebackSize, static_cast<int>(size_bytes / kMiB), 1,
+                     kZramWritebackSizeMaxMiB, kZramWritebackSizeBuckets);
+}
+
+void SwapToolMetrics::ReportZramCompressionRatio(uint64_t orig_size,
+                                                 uint64_t compr_size) {
+  if (compr_size == 0)
+    return;
+  metrics_.SendToUMA(kZramCompressionRatio,
+                     static_cast<int>(orig_size * 100 / compr_size),
+                     kZramCompressionRatioMin, kZramCompressionRatioMax,
+                     kZramCompressionRatioBuckets);
+}
+
+void SwapToolMetrics::ReportZramRecompressionResult(
+    ZramRecompressionResult result) {
+  metrics_.SendEnumToUMA(kZramRecompressionResult, result);
+}
+
+void SwapToolMetrics::ReportZramRecompression(uint64_t saved_bytes,
+                                              base::TimeDelta cpu_time) {
+  metrics_.SendToUMA(kZramRecompressionSaved,
+                     static_cast<int>(saved_bytes / kMiB), 1,
+                     kZramRecompressionSavedMaxMiB,
+                     kZramRecompressionSavedBuckets);
+  metrics_.SendTimeToUMA(kZramRecompressionCpuTime, cpu_time,
+                         base::Milliseconds(1), kZramRecompressionCpuTimeMax,
+                         kZramRecompressionCpuTimeBuckets);
+}
+
 }  // namespace swap_management
@@ -5,18 +5,50 @@
 #ifndef SWAP_MANAGEMENT_SWAP_TOOL_METRICS_H_
 #define SWAP_MANAGEMENT_SWAP_TOOL_METRICS_H_
 
+#include <cstdint>
+
 #include <absl/status/status.h>
+#include <base/time/time.h>
 
 #include "metrics/metrics_library.h"
 
 namespace swap_management {
 
+// Outcome of a periodic zram writeback attempt. These values are persisted to
+// logs. Entries should not be renumbered and numeric values should never be
+// reused.
+enum class ZramWritebackResult {
+  kWritten = 0,
+  kNothingToWrite = 1,
+  kIoPressure = 2,
+  kBudgetExhausted = 3,
+  kBackingDeviceFull = 4,
+  kFailed = 5,
+  kMaxValue = kFailed,
+};
+
+// Outcome of a periodic zram recompression attempt. These values are persisted
+// to logs. Entries should not be renumbered and numeric values should never be
+// reused.
+enum class ZramRecompressionResult {
+  kRecompressed = 0,
+  kNothingToRecompress = 1,
+  kBusy = 2,
+  kFailed = 3,
+  kMaxValue = kFailed,
+};
+
 class SwapToolMetrics {
  public:
   static SwapToolMetrics* Get();
 
   void ReportSwapStartStatus(absl::Status status);
   void ReportSwapStopStatus(absl::Status status);
+  void ReportZramWritebackResult(ZramWritebackResult result);
+  void ReportZramWritebackSize(uint64_t size_bytes);
+  void ReportZramCompressionRatio(uint64_t orig_size, uint64_t compr_size);
+  void ReportZramRecompressionResult(ZramRecompressionResult result);
+  void ReportZramRecompression(uint64_t saved_bytes, base::TimeDelta cpu_time);
 
  private:
   SwapToolMetrics() = default;
@@ -4,17 +4,26 @@
 
 #include "swap_management/swap_tool.h"
 #include "swap_management/swap_tool_util.h"
+#include "swap_management/zram_recompression.h"
+#include "swap_management/zram_writeback.h"
 
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include <absl/strings/str_cat.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/test/task_environment.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 using testing::_;
+using testing::AnyNumber;
 using testing::DoAll;
 using testing::ElementsAre;
+using testing::InSequence;
+using testing::NiceMock;
 using testing::Return;
 using testing::SetArgPointee;
 using testing::StrictMock;
@@ -148,6 +157,7 @@ class SwapToolTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_;
   std::unique_ptr<SwapTool> swap_tool_;
   MockSwapToolUtil mock_util_;
 };
@@ -204,6 +214,15 @@ TEST_F(SwapToolTest, SwapStartWithoutSwapEnabled) {
   EXPECT_CALL(mock_util_,
               RunProcessHelper(ElementsAre("/sbin/modprobe", "zram")))
       .WillOnce(Return(absl::OkStatus()));
+  // SetZramCompAlgorithms
+  EXPECT_CALL(mock_util_,
+              WriteFile(base::FilePath("/sys/block/zram0/comp_algorithm"),
+                        "lz4"))
+      .WillOnce(Return(absl::OkStatus()));
+  EXPECT_CALL(mock_util_,
+              WriteFile(base::FilePath("/sys/block/zram0/recomp_algorithm"),
+                        "algo=zstd priority=1"))
+      .WillOnce(Return(absl::OkStatus()));
   EXPECT_CALL(mock_util_, WriteFile(base::FilePath("/sys/block/zram0/disksize"),
                                     kZramDisksize8G))
       .WillOnce(Return(absl::OkStatus()));
@@ -271,6 +290,15 @@ TEST_F(SwapToolTest, SwapStartWithEmptySwapZramSize) {
   EXPECT_CALL(mock_util_,
               RunProcessHelper(ElementsAre("/sbin/modprobe", "zram")))
       .WillOnce(Return(absl::OkStatus()));
+  // SetZramCompAlgorithms
+  EXPECT_CALL(mock_util_,
+              WriteFile(base::FilePath("/sys/block/zram0/comp_algorithm"),
+                        "lz4"))
+      .WillOnce(Return(absl::OkStatus()));
+  EXPECT_CALL(mock_util_,
+              WriteFile(base::FilePath("/sys/block/zram0/recomp_algorithm"),
+                        "algo=zstd priority=1"))
+      .WillOnce(Return(absl::OkStatus()));
   EXPECT_CALL(mock_util_, WriteFile(base::FilePath("/sys/block/zram0/disksize"),
                                     kZramDisksize8G))
       .WillOnce(Return(absl::OkStatus()));
@@ -453,4 +481,254 @@ TEST_F(SwapToolTest, SwapZramEnableWriteback) {
   EXPECT_THAT(swap_tool_->SwapZramEnableWriteback(128), absl::OkStatus());
 }
 
+class ZramWritebackControllerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    SwapToolUtil::OverrideForTesting(&mock_util_);
+
+    SetIoPressure("0.00");
+    ON_CALL(mock_util_, ReadFileToString(base::FilePath("/proc/meminfo"), _))
+        .WillByDefault(DoAll(SetArgPointee<1>(kMeminfoMemTotal8G),
+                             Return(absl::OkStatus())));
+    // 1GiB of data stored in zram.
+    ON_CALL(mock_util_,
+            ReadFileToString(base::FilePath("/sys/block/zram0/mm_stat"), _))
+        .WillByDefault(DoAll(
+            SetArgPointee<1>("1073741824 268435456 272629760 0 272629760 "
+                             "1024 0 2048 2048\n"),
+            Return(absl::OkStatus())));
+    ON_CALL(mock_util_,
+            ReadFileToString(
+                base::FilePath("/sys/block/zram0/writeback_limit_enable"), _))
+        .WillByDefault(
+            DoAll(SetArgPointee<1>("0\n"), Return(absl::OkStatus())));
+    ON_CALL(mock_util_, WriteFile(_, _))
+        .WillByDefault(Return(absl::OkStatus()));
+    // The files the tests don't expect calls on are read and written at will.
+    EXPECT_CALL(mock_util_, ReadFileToString(_, _)).Times(AnyNumber());
+    EXPECT_CALL(mock_util_, WriteFile(_, _)).Times(AnyNumber());
+  }
+
+ protected:
+  void SetIoPressure(const std::string& avg10) {
+    ON_CALL(mock_util_,
+            ReadFileToString(base::FilePath("/proc/pressure/io"), _))
+        .WillByDefault(DoAll(
+            SetArgPointee<1>("some avg10=" + avg10 +
+                             " avg60=0.00 avg300=0.00 total=1234\n"
+                             "full avg10=0.00 avg60=0.00 avg300=0.00 "
+                             "total=1234\n"),
+            Return(absl::OkStatus())));
+  }
+
+  void ExpectBdStat(const std::vector<std::string>& bd_stats) {
+    auto& expectation = EXPECT_CALL(
+        mock_util_,
+        ReadFileToString(base::FilePath("/sys/block/zram0/bd_stat"), _));
+    for (const auto& bd_stat : bd_stats) {
+      expectation.WillOnce(
+          DoAll(SetArgPointee<1>(bd_stat), Return(absl::OkStatus())));
+    }
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  NiceMock<MockSwapToolUtil> mock_util_;
+};
+
+TEST_F(ZramWritebackControllerTest, WritebackIdlePages) {
+  ZramWritebackParams params;
+  ZramWritebackController controller(65536, params);
+  controller.Start();
+
+  ExpectBdStat({"0 0 0\n", "1000 0 1000\n", "32768 0 32768\n"});
+  {
+    InSequence s;
+    // 20 hours plus 78% of 5 hours, as 78% of the memory is available.
+    EXPECT_CALL(mock_util_,
+                WriteFile(base::FilePath("/sys/block/zram0/idle"), "86074"));
+    EXPECT_CALL(mock_util_,
+                WriteFile(base::FilePath(
+                              "/sys/block/zram0/writeback_limit_enable"),
+                          "1"));
+    EXPECT_CALL(
+        mock_util_,
+        WriteFile(base::FilePath("/sys/block/zram0/writeback_limit"), "32768"));
+    EXPECT_CALL(mock_util_, WriteFile(base::FilePath(
+                                          "/sys/block/zram0/writeback"),
+                                      "huge_idle"));
+    EXPECT_CALL(
+        mock_util_,
+        WriteFile(base::FilePath("/sys/block/zram0/writeback_limit"), "31768"));
+    // The kernel fails the writeback once the limit is reached.
+    EXPECT_CALL(mock_util_,
+                WriteFile(base::FilePath("/sys/block/zram0/writeback"), "idle"))
+        .WillOnce(Return(absl::InvalidArgumentError("limit reached")));
+  }
+
+  task_environment_.FastForwardBy(params.period);
+}
+
+TEST_F(ZramWritebackControllerTest, RestoreWritebackLimitEnable) {
+  ZramWritebackParams params;
+  auto controller = std::make_unique<ZramWritebackController>(65536, params);
+  controller->Start();
+
+  ExpectBdStat({"0 0 0\n", "32768 0 32768\n", "32768 0 32768\n",
+                "65536 0 65536\n"});
+  // The previous value is only read by the first writeback.
+  EXPECT_CALL(mock_util_,
+              ReadFileToString(
+                  base::FilePath("/sys/block/zram0/writeback_limit_enable"), _))
+      .WillOnce(DoAll(SetArgPointee<1>("0\n"), Return(absl::OkStatus())));
+  EXPECT_CALL(
+      mock_util_,
+      WriteFile(base::FilePath("/sys/block/zram0/writeback_limit_enable"), "1"))
+      .Times(1);
+  task_environment_.FastForwardBy(params.period * 2);
+  testing::Mock::VerifyAndClearExpectations(&mock_util_);
+
+  EXPECT_CALL(
+      mock_util_,
+      WriteFile(base::FilePath("/sys/block/zram0/writeback_limit_enable"), "0"))
+      .WillOnce(Return(absl::OkStatus()));
+  controller.reset();
+}
+
+TEST_F(ZramWritebackControllerTest, PauseUnderIoPressure) {
+  ZramWritebackParams params;
+  ZramWritebackController controller(65536, params);
+  controller.Start();
+
+  SetIoPressure("25.00");
+  EXPECT_CALL(mock_util_, WriteFile(_, _)).Times(0);
+
+  task_environment_.FastForwardBy(params.period * 3);
+}
+
+TEST_F(ZramWritebackControllerTest, DailyBudget) {
+  ZramWritebackParams params;
+  params.max_pages_per_day = 4096;
+  ZramWritebackController controller(65536, params);
+  controller.Start();
+
+  // The first attempt uses the whole budget, so that the next ones are skipped
+  // for the rest of the day.
+  ExpectBdStat({"0 0 0\n", "4096 0 4096\n"});
+  EXPECT_CALL(mock_util_, WriteFile(_, _)).Times(AnyNumber());
+  EXPECT_CALL(mock_util_,
+              WriteFile(base::FilePath("/sys/block/zram0/writeback"), _))
+      .Times(1);
+  task_environment_.FastForwardBy(params.period * 3);
+  testing::Mock::VerifyAndClearExpectations(&mock_util_);
+
+  EXPECT_CALL(mock_util_, ReadFileToString(_, _)).Times(AnyNumber());
+  ExpectBdStat({"4096 0 4096\n", "8192 0 8192\n"});
+  EXPECT_CALL(mock_util_, WriteFile(_, _)).Times(AnyNumber());
+  EXPECT_CALL(mock_util_,
+              WriteFile(base::FilePath("/sys/block/zram0/writeback"), _))
+      .Times(1);
+  task_environment_.FastForwardBy(base::Days(1) - params.period * 3);
+}
+
+TEST_F(ZramWritebackControllerTest, BackingDeviceFull) {
+  ZramWritebackParams params;
+  ZramWritebackController controller(65536, params);
+  controller.Start();
+
+  ExpectBdStat({"64512 0 64512\n"});
+  EXPECT_CALL(mock_util_, WriteFile(_, _)).Times(0);
+
+  task_environment_.FastForwardBy(params.period);
+}
+
+class ZramRecompressionControllerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    SwapToolUtil::OverrideForTesting(&mock_util_);
+    ASSERT_TRUE(power_supply_dir_.CreateUniqueTempDir());
+    params_.power_supply_dir = power_supply_dir_.GetPath();
+
+    SetCpuPressure("0.00");
+    ON_CALL(mock_util_, WriteFile(_, _))
+        .WillByDefault(Return(absl::OkStatus()));
+    // The files the tests don't expect calls on are read and written at will.
+    EXPECT_CALL(mock_util_, ReadFileToString(_, _)).Times(AnyNumber());
+    EXPECT_CALL(mock_util_, WriteFile(_, _)).Times(AnyNumber());
+  }
+
+ protected:
+  void SetCpuPressure(const std::string& avg10) {
+    ON_CALL(mock_util_,
+            ReadFileToString(base::FilePath("/proc/pressure/cpu"), _))
+        .WillByDefault(DoAll(
+            SetArgPointee<1>("some avg10=" + avg10 +
+                             " avg60=0.00 avg300=0.00 total=1234\n"),
+            Return(absl::OkStatus())));
+  }
+
+  // Adds an online line power supply.
+  void Charge() {
+    base::FilePath supply = power_supply_dir_.GetPath().Append("AC");
+    ASSERT_TRUE(base::CreateDirectory(supply));
+    ON_CALL(mock_util_, ReadFileToString(supply.Append("type"), _))
+        .WillByDefault(
+            DoAll(SetArgPointee<1>("Mains\n"), Return(absl::OkStatus())));
+    ON_CALL(mock_util_, ReadFileToString(supply.Append("online"), _))
+        .WillByDefault(
+            DoAll(SetArgPointee<1>("1\n"), Return(absl::OkStatus())));
+  }
+
+  // Expects a recompression shrinking the compressed data from 400MiB to
+  // 300MiB.
+  void ExpectRecompression() {
+    EXPECT_CALL(
+        mock_util_,
+        ReadFileToString(base::FilePath("/sys/block/zram0/mm_stat"), _))
+        .WillOnce(DoAll(SetArgPointee<1>("1073741824 419430400 0 0 0 0 0\n"),
+                        Return(absl::OkStatus())))
+        .WillOnce(DoAll(SetArgPointee<1>("1073741824 314572800 0 0 0 0 0\n"),
+                        Return(absl::OkStatus())));
+    InSequence s;
+    EXPECT_CALL(mock_util_,
+                WriteFile(base::FilePath("/sys/block/zram0/idle"), "3600"));
+    EXPECT_CALL(mock_util_,
+                WriteFile(base::FilePath("/sys/block/zram0/recompress"),
+                          "type=idle"));
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::ScopedTempDir power_supply_dir_;
+  ZramRecompressionParams params_;
+  NiceMock<MockSwapToolUtil> mock_util_;
+};
+
+TEST_F(ZramRecompressionControllerTest, RecompressWhenIdle) {
+  ZramRecompressionController controller(params_);
+  controller.Start();
+
+  ExpectRecompression();
+  task_environment_.FastForwardBy(params_.period);
+}
+
+TEST_F(ZramRecompressionControllerTest, SkipWhenBusy) {
+  ZramRecompressionController controller(params_);
+  controller.Start();
+
+  SetCpuPressure("30.00");
+  EXPECT_CALL(mock_util_, WriteFile(_, _)).Times(0);
+  task_environment_.FastForwardBy(params_.period * 3);
+}
+
+TEST_F(ZramRecompressionControllerTest, RecompressWhenBusyButCharging) {
+  ZramRecompressionController controller(params_);
+  controller.Start();
+
+  SetCpuPressure("30.00");
+  Charge();
+  ExpectRecompression();
+  task_environment_.FastForwardBy(params_.period);
+}
+
 }  // namespace swap_management
@@ -9,10 +9,13 @@
 #include <limits>
 #include <utility>
 
+#include <absl/strings/numbers.h>
 #include <base/files/file_util.h>
 #include <base/logging.h>
 #include <base/rand_util.h>
 #include <base/strings/string_number_conversions.h>
+#include <base/strings/string_split.h>
+#include <base/strings/string_util.h>
 #include <brillo/process/process.h>
 #include <sys/mount.h>
 
@@ -20,6 +23,8 @@ namespace swap_management {
 
 namespace {
 SwapToolUtil* util_ = nullptr;
+
+constexpr char kPressureAvg10Prefix[] = "avg10=";
 }  // namespace
 
 SwapToolUtil* SwapToolUtil::Get() {
@@ -186,4 +191,52 @@ void ScopedFilePathTraits::Free(const base::FilePath path) {
   LOG_IF(ERROR, !status.ok()) << status;
 }
 
+absl::StatusOr<std::vector<uint64_t>> GetZramStat(const base::FilePath& path,
+                                                  size_t min_fields) {
+  std::string stat;
+  absl::Status status = SwapToolUtil::Get()->ReadFileToString(path, &stat);
+  if (!status.ok())
+    return status;
+
+  std::vector<std::string> fields = base::SplitString(
+      stat, " \t\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (fields.size() < min_fields)
+    return absl::InvalidArgumentError("Malformed " + path.value() + ": " +
+                                      stat);
+
+  std::vector<uint64_t> values(fields.size());
+  for (size_t i = 0; i < fields.size(); i++) {
+    if (!absl::SimpleAtoi(fields[i], &values[i]))
+      return absl::OutOfRangeError("Failed to convert " + fields[i] +
+                                   " to 64-bit unsigned integer.");
+  }
+  return values;
+}
+
+absl::StatusOr<double> GetPressureSomeAvg10(const base::FilePath& path) {
+  std::string pressure;
+  absl::Status status = SwapToolUtil::Get()->ReadFileToString(path, &pressure);
+  if (!status.ok())
+    return status;
+
+  std::vector<std::string> lines = base::SplitString(
+      pressure, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  for (const auto& line : lines) {
+    std::vector<std::string> fields = base::SplitString(
+        line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.size() < 2 || fields[0] != "some" ||
+        !base::StartsWith(fields[1], kPressureAvg10Prefix))
+      continue;
+
+    std::string value = fields[1].substr(sizeof(kPressureAvg10Prefix) - 1);
+    double res = 0;
+    if (!absl::SimpleAtod(value, &res))
+      return absl::OutOfRangeError("Failed to convert " + fields[1] +
+                                   " to double.");
+    return res;
+  }
+
+  return absl::NotFoundError("Could not get some avg10 in " + path.value());
+}
+
 }  // namespace swap_management
@@ -67,6 +67,16 @@ struct ScopedFilePathTraits {
 using ScopedFilePath =
     base::ScopedGeneric<base::FilePath, ScopedFilePathTraits>;
 
+// Read the whitespace separated counters of a zram stat file at |path|, such as
+// mm_stat or bd_stat, which must contain at least |min_fields| of them.
+absl::StatusOr<std::vector<uint64_t>> GetZramStat(const base::FilePath& path,
+                                                  size_t min_fields);
+
+// Return the "some avg10" value of the pressure stall information file at
+// |path|, which is the percentage of the last 10 seconds some tasks were
+// stalled on the resource.
+absl::StatusOr<double> GetPressureSomeAvg10(const base::FilePath& path);
+
 }  // namespace swap_management
 
 #endif  // SWAP_MANAGEMENT_SWAP_TOOL_UTIL_H_
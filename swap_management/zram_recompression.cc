@@ -0,0 +1,134 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "swap_management/zram_recompression.h"
+#include "swap_management/swap_tool_util.h"
+
+#include <string>
+#include <vector>
+
+#include <base/files/dir_reader_posix.h>
+#include <base/logging.h>
+#include <base/strings/string_util.h>
+#include <base/time/time.h>
+
+namespace swap_management {
+
+namespace {
+
+constexpr char kZramSysfsDir[] = "/sys/block/zram0";
+constexpr char kCpuPressureFile[] = "/proc/pressure/cpu";
+
+base::FilePath ZramSysfsFile(const std::string& name) {
+  return base::FilePath(kZramSysfsDir).Append(name);
+}
+
+// Returns the content of |path| without the trailing whitespaces, or an empty
+// string if it cannot be read.
+std::string ReadSysfsValue(const base::FilePath& path) {
+  std::string value;
+  if (!SwapToolUtil::Get()->ReadFileToString(path, &value).ok())
+    return std::string();
+  base::TrimWhitespaceASCII(value, base::TRIM_ALL, &value);
+  return value;
+}
+
+}  // namespace
+
+ZramRecompressionController::ZramRecompressionController(
+    ZramRecompressionParams params)
+    : params_(params) {}
+
+void ZramRecompressionController::Start() {
+  timer_.Start(FROM_HERE, params_.period, this,
+               &ZramRecompressionController::PeriodicRecompression);
+}
+
+void ZramRecompressionController::PeriodicRecompression() {
+  absl::StatusOr<ZramRecompressionResult> result = Recompress();
+  if (!result.ok()) {
+    LOG(ERROR) << "zram recompression failed: " << result.status();
+    SwapToolMetrics::Get()->ReportZramRecompressionResult(
+        ZramRecompressionResult::kFailed);
+    return;
+  }
+  SwapToolMetrics::Get()->ReportZramRecompressionResult(*result);
+}
+
+absl::StatusOr<ZramRecompressionResult>
+ZramRecompressionController::Recompress() {
+  if (!IsCharging()) {
+    absl::StatusOr<double> cpu_pressure =
+        GetPressureSomeAvg10(base::FilePath(kCpuPressureFile));
+    if (!cpu_pressure.ok())
+      return cpu_pressure.status();
+    if (*cpu_pressure > params_.max_cpu_pressure)
+      return ZramRecompressionResult::kBusy;
+  }
+
+  // mm_stat starts with orig_data_size and compr_data_size, in bytes.
+  absl::StatusOr<std::vector<uint64_t>> mm_stat =
+      GetZramStat(ZramSysfsFile("mm_stat"), 2);
+  if (!mm_stat.ok())
+    return mm_stat.status();
+  const uint64_t orig_size = (*mm_stat)[0];
+  const uint64_t compr_size = (*mm_stat)[1];
+  if (compr_size == 0)
+    return ZramRecompressionResult::kNothingToRecompress;
+  SwapToolMetrics::Get()->ReportZramCompressionRatio(orig_size, compr_size);
+
+  // Marking pages idle does not clear the mark of the younger ones, so this
+  // also makes writeback consider them. Writeback is bounded by its own budget
+  // anyway.
+  absl::Status status = SwapToolUtil::Get()->WriteFile(
+      ZramSysfsFile("idle"), std::to_string(params_.idle_age.InSeconds()));
+  if (!status.ok())
+    return status;
+
+  // The kernel recompresses the pages synchronously in the writing thread, so
+  // its CPU time is the cost of the recompression.
+  base::ThreadTicks start = base::ThreadTicks::Now();
+  status = SwapToolUtil::Get()->WriteFile(ZramSysfsFile("recompress"),
+                                          "type=idle");
+  if (!status.ok())
+    return status;
+  base::TimeDelta cpu_time = base::ThreadTicks::Now() - start;
+
+  mm_stat = GetZramStat(ZramSysfsFile("mm_stat"), 2);
+  if (!mm_stat.ok())
+    return mm_stat.status();
+  // The pages swapped in and out meanwhile make this approximate.
+  const uint64_t recompr_size = (*mm_stat)[1];
+  if (recompr_size >= compr_size)
+    return ZramRecompressionResult::kNothingToRecompress;
+
+  SwapToolMetrics::Get()->ReportZramRecompression(compr_size - recompr_size,
+                                                  cpu_time);
+  LOG(INFO) << "zram recompression saved " << compr_size - recompr_size
+            << " bytes in " << cpu_time;
+
+  return ZramRecompressionResult::kRecompressed;
+}
+
+bool ZramRecompressionController::IsCharging() {
+  base::DirReaderPosix dir_reader(params_.power_supply_dir.value().c_str());
+  if (!dir_reader.IsValid())
+    return false;
+
+  while (dir_reader.Next()) {
+    std::string name = dir_reader.name();
+    if (name == "." || name == "..")
+      continue;
+
+    base::FilePath supply = params_.power_supply_dir.Append(name);
+    std::string type = ReadSysfsValue(supply.Append("type"));
+    if ((type == "Mains" || type == "USB") &&
+        ReadSysfsValue(supply.Append("online")) == "1")
+      return true;
+  }
+
+  return false;
+}
+
+}  // namespace swap_management
@@ -0,0 +1,67 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SWAP_MANAGEMENT_ZRAM_RECOMPRESSION_H_
+#define SWAP_MANAGEMENT_ZRAM_RECOMPRESSION_H_
+
+#include <absl/status/status.h>
+#include <absl/status/statusor.h>
+#include <base/files/file_path.h>
+#include <base/time/time.h>
+#include <base/timer/timer.h>
+
+#include "swap_management/swap_tool_metrics.h"
+
+namespace swap_management {
+
+// Primary zram compression algorithm, fast enough for the pages swapped in and
+// out all the time.
+constexpr char kZramPrimaryCompAlgorithm[] = "lz4";
+// Secondary zram compression algorithm, denser but more expensive, used to
+// recompress the pages which stayed idle.
+constexpr char kZramRecompAlgorithm[] = "zstd";
+
+// Tunables of ZramRecompressionController.
+struct ZramRecompressionParams {
+  // Interval between two recompression attempts.
+  base::TimeDelta period = base::Minutes(30);
+  // Pages idle for this long are recompressed.
+  base::TimeDelta idle_age = base::Hours(1);
+  // When not charging, recompression only runs while tasks were stalled on
+  // the CPU for less than this percentage of the last 10 seconds.
+  double max_cpu_pressure = 5.0;
+  // Directory with the power supplies, to know whether the device is charging.
+  base::FilePath power_supply_dir = base::FilePath("/sys/class/power_supply");
+};
+
+// ZramRecompressionController periodically recompresses the idle zram pages
+// with kZramRecompAlgorithm, while the device is idle or charging so that it
+// does not compete with the user for the CPU or the battery.
+class ZramRecompressionController {
+ public:
+  explicit ZramRecompressionController(ZramRecompressionParams params);
+  ZramRecompressionController(const ZramRecompressionController&) = delete;
+  ZramRecompressionController& operator=(const ZramRecompressionController&) =
+      delete;
+
+  ~ZramRecompressionController() = default;
+
+  // Starts the periodic recompression, which stops when this is destroyed.
+  void Start();
+
+ private:
+  void PeriodicRecompression();
+  absl::StatusOr<ZramRecompressionResult> Recompress();
+
+  // Returns true if a line power supply is online.
+  bool IsCharging();
+
+  const ZramRecompressionParams params_;
+
+  base::RepeatingTimer timer_;
+};
+
+}  // namespace swap_management
+
+#endif  // SWAP_MANAGEMENT_ZRAM_RECOMPRESSION_H_
@@ -0,0 +1,223 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "swap_management/zram_writeback.h"
+#include "swap_management/swap_tool_util.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <absl/strings/numbers.h>
+#include <base/files/file_path.h>
+#include <base/logging.h>
+#include <base/strings/string_split.h>
+#include <base/strings/string_util.h>
+
+namespace swap_management {
+
+namespace {
+
+constexpr char kZramSysfsDir[] = "/sys/block/zram0";
+constexpr char kIoPressureFile[] = "/proc/pressure/io";
+constexpr char kMemInfoFile[] = "/proc/meminfo";
+constexpr uint64_t kZramPageSize = 4096;
+
+// Modes written to the zram writeback file, from the most to the least
+// profitable: idle huge pages are incompressible and unused.
+constexpr const char* kWritebackModes[] = {"huge_idle", "idle", "huge"};
+
+base::FilePath ZramSysfsFile(const std::string& name) {
+  return base::FilePath(kZramSysfsDir).Append(name);
+}
+
+// The number of pages currently stored on and written to the backing device,
+// from bd_stat.
+struct BackingDevStat {
+  uint64_t stored = 0;
+  uint64_t written = 0;
+};
+
+absl::StatusOr<BackingDevStat> GetBackingDevStat() {
+  absl::StatusOr<std::vector<uint64_t>> bd_stat =
+      GetZramStat(ZramSysfsFile("bd_stat"), 3);
+  if (!bd_stat.ok())
+    return bd_stat.status();
+  // bd_stat is "bd_count bd_reads bd_writes", in pages.
+  return BackingDevStat{.stored = (*bd_stat)[0], .written = (*bd_stat)[2]};
+}
+
+// Returns the value of the |key| entry of /proc/meminfo, in KiB.
+absl::StatusOr<uint64_t> GetMemInfoValue(const std::string& mem_info,
+                                         const std::string& key) {
+  std::vector<std::string> lines = base::SplitString(
+      mem_info, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  for (const auto& line : lines) {
+    std::vector<std::string> fields = base::SplitString(
+        line, " :", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.size() < 2 || fields[0] != key)
+      continue;
+
+    uint64_t res = 0;
+    if (!absl::SimpleAtoi(fields[1], &res))
+      return absl::OutOfRangeError("Failed to convert " + fields[1] +
+                                   " to 64-bit unsigned integer.");
+    return res;
+  }
+
+  return absl::NotFoundError("Could not get " + key + " in /proc/meminfo");
+}
+
+}  // namespace
+
+ZramWritebackController::ZramWritebackController(uint64_t backing_dev_pages,
+                                                 ZramWritebackParams params)
+    : backing_dev_pages_(backing_dev_pages), params_(params) {}
+
+ZramWritebackController::~ZramWritebackController() {
+  if (!saved_limit_enable_)
+    return;
+
+  absl::Status status = SwapToolUtil::Get()->WriteFile(
+      ZramSysfsFile("writeback_limit_enable"), *saved_limit_enable_);
+  LOG_IF(ERROR, !status.ok())
+      << "Failed to restore zram writeback_limit_enable: " << status;
+}
+
+void ZramWritebackController::Start() {
+  budget_start_ = base::TimeTicks::Now();
+  pages_written_ = 0;
+  timer_.Start(FROM_HERE, params_.period, this,
+               &ZramWritebackController::PeriodicWriteback);
+}
+
+void ZramWritebackController::PeriodicWriteback() {
+  absl::StatusOr<ZramWritebackResult> result = Writeback();
+  if (!result.ok()) {
+    LOG(ERROR) << "zram writeback failed: " << result.status();
+    SwapToolMetrics::Get()->ReportZramWritebackResult(
+        ZramWritebackResult::kFailed);
+    return;
+  }
+  SwapToolMetrics::Get()->ReportZramWritebackResult(*result);
+}
+
+absl::StatusOr<ZramWritebackResult> ZramWritebackController::Writeback() {
+  absl::StatusOr<double> io_pressure =
+      GetPressureSomeAvg10(base::FilePath(kIoPressureFile));
+  if (!io_pressure.ok())
+    return io_pressure.status();
+  if (*io_pressure > params_.max_io_pressure)
+    return ZramWritebackResult::kIoPressure;
+
+  if (base::TimeTicks::Now() - budget_start_ >= base::Days(1)) {
+    budget_start_ = base::TimeTicks::Now();
+    pages_written_ = 0;
+  }
+  uint64_t budget = params_.max_pages_per_batch;
+  if (pages_written_ < params_.max_pages_per_day)
+    budget = std::min(budget, params_.max_pages_per_day - pages_written_);
+  else
+    budget = 0;
+  if (budget < params_.min_pages)
+    return ZramWritebackResult::kBudgetExhausted;
+
+  absl::StatusOr<BackingDevStat> bd_stat = GetBackingDevStat();
+  if (!bd_stat.ok())
+    return bd_stat.status();
+  if (bd_stat->stored < backing_dev_pages_)
+    budget = std::min(budget, backing_dev_pages_ - bd_stat->stored);
+  else
+    budget = 0;
+  if (budget < params_.min_pages)
+    return ZramWritebackResult::kBackingDeviceFull;
+
+  // mm_stat starts with orig_data_size, the uncompressed size of the data
+  // stored in zram, in bytes.
+  absl::StatusOr<std::vector<uint64_t>> mm_stat =
+      GetZramStat(ZramSysfsFile("mm_stat"), 1);
+  if (!mm_stat.ok())
+    return mm_stat.status();
+  if ((*mm_stat)[0] / kZramPageSize < params_.min_pages)
+    return ZramWritebackResult::kNothingToWrite;
+
+  absl::StatusOr<base::TimeDelta> idle_age = GetIdleAge();
+  if (!idle_age.ok())
+    return idle_age.status();
+  absl::Status status = SwapToolUtil::Get()->WriteFile(
+      ZramSysfsFile("idle"), std::to_string(idle_age->InSeconds()));
+  if (!status.ok())
+    return status;
+
+  // The writeback limit is consumed by the kernel as pages are written, which
+  // bounds each batch without having to watch its progress.
+  if (!saved_limit_enable_) {
+    std::string limit_enable;
+    status = SwapToolUtil::Get()->ReadFileToString(
+        ZramSysfsFile("writeback_limit_enable"), &limit_enable);
+    if (!status.ok())
+      return status;
+    status = SwapToolUtil::Get()->WriteFile(
+        ZramSysfsFile("writeback_limit_enable"), "1");
+    if (!status.ok())
+      return status;
+    saved_limit_enable_ = std::string(
+        base::TrimWhitespaceASCII(limit_enable, base::TRIM_ALL));
+  }
+
+  const uint64_t written_before = bd_stat->written;
+  uint64_t written = 0;
+  for (const char* mode : kWritebackModes) {
+    status = SwapToolUtil::Get()->WriteFile(ZramSysfsFile("writeback_limit"),
+                                            std::to_string(budget - written));
+    if (!status.ok())
+      return status;
+
+    // The kernel fails the write once the limit is reached, so check how much
+    // was written regardless.
+    status = SwapToolUtil::Get()->WriteFile(ZramSysfsFile("writeback"), mode);
+    LOG_IF(WARNING, !status.ok())
+        << "zram writeback of " << mode << " pages stopped: " << status;
+
+    bd_stat = GetBackingDevStat();
+    if (!bd_stat.ok())
+      return bd_stat.status();
+    written = std::min(budget, bd_stat->written - written_before);
+    if (written >= budget)
+      break;
+  }
+
+  pages_written_ += written;
+  SwapToolMetrics::Get()->ReportZramWritebackSize(written * kZramPageSize);
+  LOG(INFO) << "zram writeback wrote " << written << " pages of idle age "
+            << *idle_age;
+
+  return written > 0 ? ZramWritebackResult::kWritten
+                     : ZramWritebackResult::kNothingToWrite;
+}
+
+absl::StatusOr<base::TimeDelta> ZramWritebackController::GetIdleAge() {
+  std::string mem_info;
+  absl::Status status = SwapToolUtil::Get()->ReadFileToString(
+      base::FilePath(kMemInfoFile), &mem_info);
+  if (!status.ok())
+    return status;
+
+  absl::StatusOr<uint64_t> mem_total = GetMemInfoValue(mem_info, "MemTotal");
+  if (!mem_total.ok())
+    return mem_total.status();
+  absl::StatusOr<uint64_t> mem_available =
+      GetMemInfoValue(mem_info, "MemAvailable");
+  if (!mem_available.ok())
+    return mem_available.status();
+  if (*mem_total == 0)
+    return absl::InvalidArgumentError("MemTotal is 0 in /proc/meminfo");
+
+  double available_ratio =
+      std::min(1.0, static_cast<double>(*mem_available) / *mem_total);
+  return params_.idle_min_age +
+         (params_.idle_max_age - params_.idle_min_age) * available_ratio;
+}
+
+}  // namespace swap_management
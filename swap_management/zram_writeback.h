@@ -0,0 +1,83 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SWAP_MANAGEMENT_ZRAM_WRITEBACK_H_
+#define SWAP_MANAGEMENT_ZRAM_WRITEBACK_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <absl/status/status.h>
+#include <absl/status/statusor.h>
+#include <base/time/time.h>
+#include <base/timer/timer.h>
+
+#include "swap_management/swap_tool_metrics.h"
+
+namespace swap_management {
+
+// Tunables of ZramWritebackController. Page counts are in units of 4KiB, like
+// the zram sysfs interface.
+struct ZramWritebackParams {
+  // Interval between two writeback attempts.
+  base::TimeDelta period = base::Minutes(10);
+  // Pages idle for |idle_max_age| are written back when memory is plentiful,
+  // and pages idle for |idle_min_age| when it is exhausted.
+  base::TimeDelta idle_min_age = base::Hours(20);
+  base::TimeDelta idle_max_age = base::Hours(25);
+  // Attempts which could write back fewer pages than this are skipped.
+  uint64_t min_pages = 2048;
+  // Maximum number of pages written back by a single attempt.
+  uint64_t max_pages_per_batch = 32768;
+  // Maximum number of pages written back over a day, bounding the wear of the
+  // flash.
+  uint64_t max_pages_per_day = 131072;
+  // Writeback is paused while some tasks were stalled on I/O for more than
+  // this percentage of the last 10 seconds.
+  double max_io_pressure = 10.0;
+};
+
+// ZramWritebackController periodically marks old zram pages as idle and
+// writes them back to the backing device, in batches bounded by the daily
+// writeback budget and the free space of the backing device.
+class ZramWritebackController {
+ public:
+  // |backing_dev_pages| is the capacity of the zram backing device.
+  ZramWritebackController(uint64_t backing_dev_pages,
+                          ZramWritebackParams params);
+  ZramWritebackController(const ZramWritebackController&) = delete;
+  ZramWritebackController& operator=(const ZramWritebackController&) = delete;
+
+  // Restores the writeback_limit_enable it found, if it changed it.
+  ~ZramWritebackController();
+
+  // Starts the periodic writeback, which stops when this is destroyed.
+  void Start();
+
+ private:
+  void PeriodicWriteback();
+  absl::StatusOr<ZramWritebackResult> Writeback();
+
+  // Returns the idle age pages need to be written back, which is shorter when
+  // less memory is available.
+  absl::StatusOr<base::TimeDelta> GetIdleAge();
+
+  const uint64_t backing_dev_pages_;
+  const ZramWritebackParams params_;
+
+  base::RepeatingTimer timer_;
+
+  // writeback_limit_enable before the first writeback enabled it, restored on
+  // destruction.
+  std::optional<std::string> saved_limit_enable_;
+
+  // Pages written back since |budget_start_|, reset once a day.
+  base::TimeTicks budget_start_;
+  uint64_t pages_written_ = 0;
+};
+
+}  // namespace swap_management
+
+#endif  // SWAP_MANAGEMENT_ZRAM_WRITEBACK_H_
@@ -26,6 +26,9 @@ const char kGetPerfOutput[] = "GetPerfOutput";
 const char kGetPerfOutputFd[] = "GetPerfOutputFd";
 const char kGetPerfOutputV2[] = "GetPerfOutputV2";
 const char kStopPerf[] = "StopPerf";
+const char kStartContinuousPerf[] = "StartContinuousPerf";
+const char kStopContinuousPerf[] = "StopContinuousPerf";
+const char kGetContinuousPerfSnapshot[] = "GetContinuousPerfSnapshot";
 const char kGetIpAddrs[] = "GetIpAddrs";
 const char kGetRoutes[] = "GetRoutes";
 const char kSetDebugMode[] = "SetDebugMode";
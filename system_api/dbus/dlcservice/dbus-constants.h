@@ -13,6 +13,7 @@ constexpr char kDlcServiceServiceName[] = "org.chromium.DlcService";
 
 constexpr char kInstallMethod[] = "Install";
 constexpr char kInstallDlcMethod[] = "InstallDlc";
+constexpr char kInstallBatchMethod[] = "InstallBatch";
 constexpr char kUninstallMethod[] = "Uninstall";
 constexpr char kPurgeMethod[] = "Purge";
 constexpr char kGetDlcStateMethod[] = "GetDlcState";
@@ -20,8 +20,12 @@ const char kGetQuotaCurrentSpaceForUidMethod[] = "GetQuotaCurrentSpaceForUid";
 const char kGetQuotaCurrentSpaceForGidMethod[] = "GetQuotaCurrentSpaceForGid";
 const char kGetQuotaCurrentSpaceForProjectIdMethod[] =
     "GetQuotaCurrentSpaceForProjectId";
+const char kGetQuotaCurrentSpacesForIdsMethod[] = "GetQuotaCurrentSpacesForIds";
 const char kSetProjectIdMethod[] = "SetProjectId";
 const char kSetProjectInheritanceFlagMethod[] = "SetProjectInheritanceFlag";
+const char kRegisterProjectIdConsumerMethod[] = "RegisterProjectIdConsumer";
+const char kUnregisterProjectIdConsumerMethod[] = "UnregisterProjectIdConsumer";
+const char kGetStorageBreakdownMethod[] = "GetStorageBreakdown";
 
 // Signals.
 const char kStatefulDiskSpaceUpdate[] = "StatefulDiskSpaceUpdate";
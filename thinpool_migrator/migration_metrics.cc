@@ -14,6 +14,9 @@ constexpr const char kMetricsLogPath[] = "/run/thinpool_migration/metrics";
 constexpr const int kTimeMinMs = 0;
 constexpr const int kTimeMaxMs = 30 * 1000;
 constexpr const int kTimeBuckets = 50;
+constexpr const int kThroughputMinKiBps = 1;
+constexpr const int kThroughputMaxKiBps = 4 * 1024 * 1024;
+constexpr const int kThroughputBuckets = 50;
 
 }  // namespace
 
@@ -46,6 +49,18 @@ void ReportIntMetric(const std::string& metric, int sample, int max) {
   g_metrics->SendEnumToUMA(metric, sample, max);
 }
 
+void ReportThroughputMetric(const std::string& metric,
+                            uint64_t bytes,
+                            base::TimeDelta duration) {
+  if (!g_metrics || !duration.is_positive())
+    return;
+
+  g_metrics->SendToUMA(metric,
+                       static_cast<int>(bytes / 1024 / duration.InSecondsF()),
+                       kThroughputMinKiBps, kThroughputMaxKiBps,
+                       kThroughputBuckets);
+}
+
 ScopedTimerReporter::ScopedTimerReporter(const std::string& histogram_name)
     : TimerReporter(histogram_name, kTimeMinMs, kTimeMaxMs, kTimeBuckets) {
   Start();
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include <base/time/time.h>
 #include <brillo/brillo_export.h>
 #include <metrics/metrics_library.h>
 #include <metrics/timer.h>
@@ -32,6 +33,10 @@ inline constexpr char kLvmMetadataTimeHistogram[] =
     "Platform.ThinpoolMigration.LvmMetadataTime";
 inline constexpr char kRevertTimeHistogram[] =
     "Platform.ThinpoolMigration.RevertTime";
+// Measures the throughput of partition header copies, in KiB/s, to help
+// diagnose slow storage.
+inline constexpr char kHeaderCopyThroughputHistogram[] =
+    "Platform.ThinpoolMigration.HeaderCopyThroughput";
 
 inline constexpr int kMaxTries = 5;
 
@@ -51,6 +56,11 @@ void ClearMetricsLibraryForTesting();
 // Reports an integer metric. Used for result and tries.
 void BRILLO_EXPORT ReportIntMetric(const std::string& metric, int val, int max);
 
+// Reports the throughput of processing |bytes| in |duration|, in KiB/s.
+void BRILLO_EXPORT ReportThroughputMetric(const std::string& metric,
+                                          uint64_t bytes,
+                                          base::TimeDelta duration);
+
 class ScopedTimerReporter : public chromeos_metrics::TimerReporter {
  public:
   explicit ScopedTimerReporter(const std::string& histogram_name);
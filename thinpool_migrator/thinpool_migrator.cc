@@ -4,15 +4,22 @@
 
 #include "thinpool_migrator/thinpool_migrator.h"
 
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+
+#include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <base/base64.h>
+#include <base/files/file.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
 #include <base/functional/callback_helpers.h>
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
+#include <base/timer/elapsed_timer.h>
 #include <brillo/blkdev_utils/device_mapper.h>
 #include <brillo/process/process.h>
 #include <brillo/syslog_logging.h>
@@ -31,6 +38,11 @@ constexpr const char kMigrationStatusKey[] = "thinpool_migration_status";
 constexpr const uint64_t kPartitionHeaderSize = 1ULL * 1024 * 1024;
 constexpr const uint64_t kSectorSize = 512;
 
+// I/O size used to copy data when the device doesn't report an optimal
+// transfer size, and the largest one used otherwise.
+constexpr const uint64_t kDefaultIoSize = 128ULL * 1024;
+constexpr const uint64_t kMaxIoSize = 4ULL * 1024 * 1024;
+
 // Device mapper target name.
 constexpr const char kMetadataDeviceMapperTarget[] = "thinpool-metadata-dev";
 constexpr const char kDeviceMapperPrefix[] = "/dev/mapper";
@@ -44,6 +56,17 @@ brillo::DevmapperTable GetMetadataDeviceTable(uint64_t offset,
           "%s %" PRIu64, device.value().c_str(), offset / kSectorSize)));
 }
 
+// Returns the size of the I/Os to copy data on |file| with, based on the
+// optimal transfer size of the underlying device.
+uint64_t GetIoSize(base::File* file) {
+  unsigned int io_opt = 0;
+  if (ioctl(file->GetPlatformFile(), BLKIOOPT, &io_opt) != 0 || io_opt == 0 ||
+      io_opt % kSectorSize != 0) {
+    return kDefaultIoSize;
+  }
+  return std::min<uint64_t>(io_opt, kMaxIoSize);
+}
+
 bool IsVpdSupported() {
   static bool is_vpd_supported = true;
   if (is_vpd_supported && !base::PathExists(base::FilePath(kVpdSysfsPath))) {
@@ -389,21 +412,46 @@ bool ThinpoolMigrator::ResizeStatefulFilesystem(uint64_t size) {
 bool ThinpoolMigrator::DuplicateHeader(uint64_t from,
                                        uint64_t to,
                                        uint64_t size) {
-  brillo::ProcessImpl dd;
-  dd.AddArg("/bin/dd");
-  dd.AddArg(base::StringPrintf("if=%s", block_device_.value().c_str()));
-  dd.AddArg(base::StringPrintf("skip=%lu", from / kSectorSize));
-  dd.AddArg(base::StringPrintf("of=%s", block_device_.value().c_str()));
-  dd.AddArg(base::StringPrintf("seek=%lu", to / kSectorSize));
-  dd.AddArg(base::StringPrintf("count=%lu", size / kSectorSize));
-
-  dd.SetCloseUnusedFileDescriptors(true);
-  if (dd.Run() != 0) {
-    LOG(ERROR) << "Failed to duplicate contents from " << from << " to " << to;
+  base::File file(block_device_, base::File::FLAG_OPEN |
+                                     base::File::FLAG_READ |
+                                     base::File::FLAG_WRITE);
+  if (!file.IsValid()) {
+    LOG(ERROR) << "Failed to open " << block_device_ << ": "
+               << base::File::ErrorToString(file.error_details());
     return false;
   }
 
-  sync();
+  // The copy goes one chunk at a time, each flushed before the next one is
+  // written. A copy interrupted by a reboot is resumed after the chunks that
+  // were already copied, which are only read back rather than rewritten.
+  const uint64_t io_size = GetIoSize(&file);
+  std::vector<char> source(io_size);
+  std::vector<char> destination(io_size);
+  bool resuming = true;
+  base::ElapsedTimer timer;
+  for (uint64_t offset = 0; offset < size; offset += io_size) {
+    const int len = std::min(io_size, size - offset);
+    if (file.Read(from + offset, source.data(), len) != len) {
+      PLOG(ERROR) << "Failed to read " << len << " bytes at " << from + offset;
+      return false;
+    }
+
+    if (resuming) {
+      resuming = file.Read(to + offset, destination.data(), len) == len &&
+                 std::equal(source.begin(), source.begin() + len,
+                            destination.begin());
+      if (resuming)
+        continue;
+    }
+
+    if (file.Write(to + offset, source.data(), len) != len || !file.Flush()) {
+      PLOG(ERROR) << "Failed to write " << len << " bytes at " << to + offset;
+      return false;
+    }
+  }
+
+  ReportThroughputMetric(kHeaderCopyThroughputHistogram, size,
+                         timer.Elapsed());
   return true;
 }
 
@@ -84,7 +84,9 @@ class BRILLO_EXPORT ThinpoolMigrator {
   // Restores the volume group configuration for a given volume group name.
   virtual bool RestoreVolumeGroupConfiguration(const std::string& vgname);
 
-  // Duplicates the header of the device.
+  // Copies |size| bytes at |from| to |to| on the device, in chunks sized to
+  // its optimal transfer size. Chunks already copied by an interrupted
+  // attempt are not rewritten.
   virtual bool DuplicateHeader(uint64_t from, uint64_t to, uint64_t size);
 
   // Retrieves the migration status from VPD.
@@ -6,6 +6,8 @@
 
 #include <string>
 
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
 #include <base/logging.h>
 #include <brillo/blkdev_utils/device_mapper_fake.h>
 #include <gmock/gmock.h>
@@ -45,6 +47,27 @@ class MockThinpoolMigrator : public ThinpoolMigrator {
               (override));
 };
 
+// Runs the migrator on a regular file.
+class FileThinpoolMigrator : public ThinpoolMigrator {
+ public:
+  explicit FileThinpoolMigrator(const base::FilePath& path)
+      : ThinpoolMigrator(
+            path,
+            512UL * 1024 * 1024 * 1024,
+            std::make_unique<brillo::DeviceMapper>(
+                base::BindRepeating(&brillo::fake::CreateDevmapperTask))) {}
+
+  using ThinpoolMigrator::DuplicateHeader;
+};
+
+// Returns |size| bytes of a non-repeating pattern.
+std::string GenerateHeader(size_t size) {
+  std::string header(size, '\0');
+  for (size_t i = 0; i < size; i++)
+    header[i] = static_cast<char>(i % 251);
+  return header;
+}
+
 // Go through the possibilities of migration and ensure that the state machine
 // is consistent.
 TEST(ThinpoolMigratorTest, BasicSanity) {
@@ -172,4 +195,49 @@ TEST(ThinpoolMigratorTest, LastTry_RevertMigration) {
   EXPECT_EQ(m.GetTries(), 0);
 }
 
+TEST(ThinpoolMigratorTest, DuplicateHeader) {
+  constexpr size_t kHeaderSize = 1024 * 1024 + 512;
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath device = temp_dir.GetPath().Append("device");
+  const std::string header = GenerateHeader(kHeaderSize);
+  ASSERT_TRUE(base::WriteFile(device, header + std::string(kHeaderSize, 0)));
+
+  FileThinpoolMigrator m(device);
+  EXPECT_TRUE(m.DuplicateHeader(0, kHeaderSize, kHeaderSize));
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(device, &contents));
+  EXPECT_EQ(contents, header + header);
+}
+
+TEST(ThinpoolMigratorTest, DuplicateHeader_ResumeInterruptedCopy) {
+  constexpr size_t kHeaderSize = 1024 * 1024;
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath device = temp_dir.GetPath().Append("device");
+  const std::string header = GenerateHeader(kHeaderSize);
+  // The first half of the header was copied before the interruption.
+  ASSERT_TRUE(base::WriteFile(device, header +
+                                          header.substr(0, kHeaderSize / 2) +
+                                          std::string(kHeaderSize / 2, 'x')));
+
+  FileThinpoolMigrator m(device);
+  EXPECT_TRUE(m.DuplicateHeader(0, kHeaderSize, kHeaderSize));
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(device, &contents));
+  EXPECT_EQ(contents, header + header);
+}
+
+TEST(ThinpoolMigratorTest, DuplicateHeader_ShortDevice) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath device = temp_dir.GetPath().Append("device");
+  ASSERT_TRUE(base::WriteFile(device, GenerateHeader(4096)));
+
+  FileThinpoolMigrator m(device);
+  EXPECT_FALSE(m.DuplicateHeader(8192, 0, 4096));
+}
+
 }  // namespace thinpool_migrator
@@ -38,10 +38,14 @@ std::string StringTransformer::FormatTime(const base::Time& time) {
 // doesn't contain timestamp, we add current time which is better than
 // adding nothing
 base::Time StringTransformer::GetLineTimestamp(const std::string& s) {
-  // Check if EC uptime is initialized, if not use current time
+  // Check if EC uptime is initialized, if not use current time. This is the
+  // case for every line when the EC doesn't report its uptime, so only warn
+  // once.
   if (ec_current_uptime_ms_ < 0) {
-    LOG(WARNING) << "Cannot obtain precise line timestamp - EC uptime is "
-                    "not initialized";
+    LOG_IF(WARNING, !warned_uptime_not_initialized_)
+        << "Cannot obtain precise line timestamp - EC uptime is "
+           "not initialized";
+    warned_uptime_not_initialized_ = true;
     return base::Time::UnixEpoch();
   }
 
@@ -30,6 +30,7 @@ class StringTransformer {
   base::Time GetLineTimestamp(const std::string& s);
 
   int64_t ec_current_uptime_ms_ = -1;
+  bool warned_uptime_not_initialized_ = false;
   base::Time timestamp_;
   base::Time logline_tm_;
   RE2 ec_timestamp_pattern_;
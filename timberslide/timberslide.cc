@@ -3,8 +3,8 @@
 // found in the LICENSE file.
 
 #include <algorithm>
-#include <sstream>
 #include <string>
+#include <string_view>
 
 #include <sysexits.h>
 #include <sys/types.h>
@@ -27,22 +27,9 @@ namespace {
 const char kCurrentLogExt[] = ".log";
 const char kPreviousLogExt[] = ".previous";
 const int kMaxCurrentLogSize = 10 * 1024 * 1024;
-
-// String proxy class for dealing with lines.
-class LineExtractor {
- public:
-  // Extract one line from beginning of string stream.
-  friend std::istream& operator>>(std::istream& is, LineExtractor& l) {
-    std::getline(is, l.str_);
-    return is;
-  }
-
-  // Transparently convert to std::string.
-  operator std::string() const { return str_; }
-
- private:
-  std::string str_;
-};
+// The size of the kernel's buffer for the EC console log, so that a single
+// read drains it.
+const int kReadBufferSize = 16 * 1024;
 
 }  // namespace
 
@@ -122,30 +109,36 @@ bool TimberSlide::GetEcUptime(int64_t* ec_uptime_ms) {
 std::string TimberSlide::ProcessLogBuffer(const std::string& buffer,
                                           const base::Time& now) {
   int64_t ec_current_uptime_ms = 0;
-  std::istringstream iss(buffer);
 
   if (GetEcUptime(&ec_current_uptime_ms))
     xfrm_->UpdateTimestamps(ec_current_uptime_ms, now);
 
-  auto fn_xfrm = [this](const std::string& line) {
+  // Iterate over each line and prepend the corresponding host timestamp if we
+  // have it. The last line of the buffer is terminated even if it is
+  // incomplete.
+  std::string result;
+  // Leave room for the timestamps.
+  result.reserve(buffer.size() * 2);
+  std::string line;
+  std::string_view remaining(buffer);
+  while (!remaining.empty()) {
+    size_t eol = remaining.find('\n');
+    if (eol == std::string_view::npos)
+      eol = remaining.size();
+    line.assign(remaining.substr(0, eol));
+    remaining.remove_prefix(std::min(eol + 1, remaining.size()));
+
     if (log_listener_) {
       log_listener_->OnLogLine(line);
     }
-    return xfrm_->AddHostTs(line);
-  };
-
-  // Iterate over each line and prepend the corresponding host timestamp if we
-  // have it
-  std::ostringstream oss;
-  std::transform(std::istream_iterator<LineExtractor>(iss),
-                 std::istream_iterator<LineExtractor>(),
-                 std::ostream_iterator<std::string>(oss, "\n"), fn_xfrm);
+    result.append(xfrm_->AddHostTs(line)).push_back('\n');
+  }
 
-  return oss.str();
+  return result;
 }
 
 void TimberSlide::OnEventReadable() {
-  char buffer[4096];
+  char buffer[kReadBufferSize];
   int ret;
 
   ret = TEMP_FAILURE_RETRY(
@@ -163,7 +156,7 @@ void TimberSlide::OnEventReadable() {
       ProcessLogBuffer(std::string(buffer, ret), base::Time::Now());
   ret = str.size();
 
-  if (!base::AppendToFile(current_log_, str)) {
+  if (current_log_file_.WriteAtCurrentPos(str.data(), ret) != ret) {
     PLOG(ERROR) << "Could not append to log file";
     Quit();
     return;
@@ -178,12 +171,20 @@ void TimberSlide::OnEventReadable() {
 
 void TimberSlide::RotateLogs(const base::FilePath& previous_log,
                              const base::FilePath& current_log) {
+  // Close the current log before it gets renamed.
+  current_log_file_.Close();
   CHECK(base::DeleteFile(previous_log));
 
   if (base::PathExists(current_log))
     CHECK(base::Move(current_log, previous_log));
 
-  base::WriteFile(current_log, "", 0);
+  // The log is kept open rather than reopened for each write.
+  current_log_file_.Initialize(
+      current_log, base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_APPEND);
+  if (!current_log_file_.IsValid()) {
+    LOG(ERROR) << "Could not create log file: "
+               << base::File::ErrorToString(current_log_file_.error_details());
+  }
 }
 
 }  // namespace timberslide
@@ -44,6 +44,7 @@ class TimberSlide : public brillo::Daemon {
 
   base::File device_file_;
   base::FilePath current_log_;
+  base::File current_log_file_;
   base::FilePath previous_log_;
   std::unique_ptr<base::FileDescriptorWatcher::Controller> watcher_;
   int total_size_ = 0;
@@ -52,6 +52,18 @@ TEST(TimberslideTest, ProcessLogBuffer_GetEcUptimeNotSupported) {
   EXPECT_EQ(ret, kExpectedLogsWithoutUptime);
 }
 
+TEST(TimberslideTest, ProcessLogBuffer_IncompleteAndEmptyLines) {
+  auto now = base::Time::FromDoubleT(1.0);
+  NiceMock<MockTimberSlide> mock;
+  EXPECT_CALL(mock, GetEcUptime).WillOnce(Return(false));
+  std::string ret =
+      mock.ProcessLogBuffer("[0.001000 UART]\n\n[1.000000 Sensor", now);
+  EXPECT_EQ(ret,
+            "1970-01-01T00:00:00.000000Z [0.001000 UART]\n"
+            "1970-01-01T00:00:00.000000Z \n"
+            "1970-01-01T00:00:00.000000Z [1.000000 Sensor\n");
+}
+
 class TimberslideLogLineTest : public testing::TestWithParam<bool> {};
 
 TEST_P(TimberslideLogLineTest, ProcessLogBuffer_OnLogLine) {
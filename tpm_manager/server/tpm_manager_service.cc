@@ -723,11 +723,31 @@ TpmManagerService::GetSupportedFeaturesTask(
 void TpmManagerService::GetDictionaryAttackInfo(
     const GetDictionaryAttackInfoRequest& request,
     GetDictionaryAttackInfoCallback callback) {
+  // Only join a query posted after the last DA reset, since the worker thread
+  // runs the reset before any query posted after it.
+  std::vector<GetDictionaryAttackInfoCallback>& callbacks =
+      get_dictionary_attack_info_waiting_callbacks_[dictionary_attack_resets_];
+  callbacks.emplace_back(std::move(callback));
+  if (callbacks.size() > 1) {
+    return;
+  }
   PostTaskToWorkerThread<GetDictionaryAttackInfoReply>(
-      request, std::move(callback),
+      request,
+      base::BindOnce(&TpmManagerService::DictionaryAttackInfoCallback,
+                     base::Unretained(this), dictionary_attack_resets_),
       &TpmManagerService::GetDictionaryAttackInfoTask);
 }
 
+void TpmManagerService::DictionaryAttackInfoCallback(
+    uint64_t resets, const GetDictionaryAttackInfoReply& reply) {
+  DCHECK_NE(base::PlatformThread::CurrentId(), worker_thread_->GetThreadId());
+  auto node = get_dictionary_attack_info_waiting_callbacks_.extract(resets);
+  DCHECK(node);
+  for (auto& callback : node.mapped()) {
+    std::move(callback).Run(reply);
+  }
+}
+
 std::unique_ptr<GetDictionaryAttackInfoReply>
 TpmManagerService::GetDictionaryAttackInfoTask(
     const GetDictionaryAttackInfoRequest& request) {
@@ -795,6 +815,7 @@ TpmManagerService::GetRoVerificationStatusTask(
 void TpmManagerService::ResetDictionaryAttackLock(
     const ResetDictionaryAttackLockRequest& request,
     ResetDictionaryAttackLockCallback callback) {
+  ++dictionary_attack_resets_;
   if (request.is_async()) {
     ResetDictionaryAttackLockReply reply;
     reply.set_status(STATUS_SUCCESS);
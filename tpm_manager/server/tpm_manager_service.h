@@ -5,6 +5,7 @@
 #ifndef TPM_MANAGER_SERVER_TPM_MANAGER_SERVICE_H_
 #define TPM_MANAGER_SERVER_TPM_MANAGER_SERVICE_H_
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -207,6 +208,11 @@ class TpmManagerService : public TpmNvramInterface,
   // Updating TPM status cache and calling all pending GetTpmStatus callback.
   void UpdateTpmStatusCallback(const GetTpmStatusReply& reply);
 
+  // Calling all pending GetDictionaryAttackInfo callbacks of the query posted
+  // after |resets| DA resets.
+  void DictionaryAttackInfoCallback(uint64_t resets,
+                                    const GetDictionaryAttackInfoReply& reply);
+
   // Calling the callback which is registered by SetOwnershipTakenCallback if it
   // exists.
   void NotifyTpmIsOwned();
@@ -363,6 +369,17 @@ class TpmManagerService : public TpmNvramInterface,
   // |get_tpm_status_cache_|.
   bool update_tpm_status_cache_dirty_;
 
+  // Callbacks of the GetDictionaryAttackInfo requests waiting for the DA info
+  // queries in flight, keyed by the |dictionary_attack_resets_| at which the
+  // query was posted. The DA counter changes on every failed authorization, so
+  // the reply is not cached, but the requests received while a query is in
+  // flight share its result unless a reset was requested since.
+  std::map<uint64_t, std::vector<GetDictionaryAttackInfoCallback>>
+      get_dictionary_attack_info_waiting_callbacks_;
+
+  // Number of ResetDictionaryAttackLock requests received.
+  uint64_t dictionary_attack_resets_ = 0;
+
   // Lock for |version_info_cache_|, which might be accessed from both the main
   // and worker threads.
   base::Lock version_info_cache_lock_;
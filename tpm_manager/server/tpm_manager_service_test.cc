@@ -651,6 +651,71 @@ TEST_F(TpmManagerServiceTest, GetDictionaryAttackInfo) {
   Run();
 }
 
+TEST_F(TpmManagerServiceTest, GetDictionaryAttackInfoCoalesced) {
+  EXPECT_CALL(mock_tpm_status_, GetDictionaryAttackInfo(_, _, _, _))
+      .WillOnce(DoAll(SetArgPointee<0>(5), Return(true)));
+
+  int replies = 0;
+  auto callback = [](TpmManagerServiceTestBase* self, int* replies,
+                     const GetDictionaryAttackInfoReply& reply) {
+    EXPECT_EQ(STATUS_SUCCESS, reply.status());
+    EXPECT_EQ(5, reply.dictionary_attack_counter());
+    if (++*replies == 2) {
+      self->Quit();
+    }
+  };
+
+  // Both requests are received before the DA info query finishes, so they are
+  // answered by a single TPM query.
+  GetDictionaryAttackInfoRequest request;
+  service_->GetDictionaryAttackInfo(request,
+                                    base::BindOnce(callback, this, &replies));
+  service_->GetDictionaryAttackInfo(request,
+                                    base::BindOnce(callback, this, &replies));
+  Run();
+  EXPECT_EQ(2, replies);
+}
+
+TEST_F(TpmManagerServiceTest, GetDictionaryAttackInfoNotCoalescedAfterReset) {
+  // The first query, then the reset, then the second query.
+  EXPECT_CALL(mock_tpm_status_, GetDictionaryAttackInfo(_, _, _, _))
+      .WillOnce(DoAll(SetArgPointee<0>(5), Return(true)))
+      .WillOnce(DoAll(SetArgPointee<0>(5), Return(true)))
+      .WillOnce(DoAll(SetArgPointee<0>(0), Return(true)));
+  EXPECT_CALL(mock_tpm_manager_metrics_, ReportDictionaryAttackCounter(5))
+      .Times(1);
+  EXPECT_CALL(mock_tpm_manager_metrics_,
+              ReportDictionaryAttackResetStatus(
+                  DictionaryAttackResetStatus::kResetAttemptSucceeded))
+      .Times(1);
+  EXPECT_CALL(mock_tpm_initializer_, ResetDictionaryAttackLock())
+      .WillOnce(Return(DictionaryAttackResetStatus::kResetAttemptSucceeded));
+
+  std::vector<uint32_t> counters;
+  auto callback = [](TpmManagerServiceTestBase* self,
+                     std::vector<uint32_t>* counters,
+                     const GetDictionaryAttackInfoReply& reply) {
+    EXPECT_EQ(STATUS_SUCCESS, reply.status());
+    counters->push_back(reply.dictionary_attack_counter());
+    if (counters->size() == 2) {
+      self->Quit();
+    }
+  };
+
+  // The second request is received while the first query is in flight, but
+  // after a reset was requested, so it must not share the stale counter.
+  GetDictionaryAttackInfoRequest request;
+  service_->GetDictionaryAttackInfo(request,
+                                    base::BindOnce(callback, this, &counters));
+  ResetDictionaryAttackLockRequest reset_request;
+  reset_request.set_is_async(true);
+  service_->ResetDictionaryAttackLock(reset_request, base::DoNothing());
+  service_->GetDictionaryAttackInfo(request,
+                                    base::BindOnce(callback, this, &counters));
+  Run();
+  EXPECT_EQ(counters, std::vector<uint32_t>({5, 0}));
+}
+
 TEST_F(TpmManagerServiceTest, GetDictionaryAttackInfoError) {
   EXPECT_CALL(mock_tpm_status_, GetDictionaryAttackInfo(_, _, _, _))
       .WillOnce(Return(false));
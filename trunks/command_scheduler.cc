@@ -0,0 +1,151 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "trunks/command_scheduler.h"
+
+#include <utility>
+
+#include <base/check.h>
+#include <base/functional/bind.h>
+
+#include "trunks/trunks_metrics.h"
+
+namespace trunks {
+
+namespace {
+
+constexpr char kOtherClientMetricsName[] = "Other";
+
+}  // namespace
+
+CommandScheduler::CommandScheduler(CommandTransceiver* next_transceiver,
+                                   TrunksMetrics* metrics)
+    : next_transceiver_(next_transceiver), metrics_(metrics) {}
+
+CommandScheduler::~CommandScheduler() = default;
+
+void CommandScheduler::SetClientInfo(const std::string& client,
+                                     const std::string& metrics_name,
+                                     Priority priority) {
+  client_info_[client] = ClientInfo{metrics_name, priority};
+}
+
+void CommandScheduler::RemoveClientInfo(const std::string& client) {
+  client_info_.erase(client);
+}
+
+void CommandScheduler::SendCommand(
+    const std::string& client,
+    const std::string& command,
+    CommandTransceiver::ResponseCallback callback) {
+  command_queues_[client].push_back(QueuedCommand{
+      .command = command,
+      .callback = std::move(callback),
+      .queue_time = base::TimeTicks::Now(),
+  });
+  SendNextCommand();
+}
+
+size_t CommandScheduler::queued_command_count() const {
+  size_t count = 0;
+  for (const auto& [client, commands] : command_queues_) {
+    count += commands.size();
+  }
+  return count;
+}
+
+void CommandScheduler::SendNextCommand() {
+  if (command_in_progress_ || command_queues_.empty()) {
+    return;
+  }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  auto queue_iter = ChooseNextClient(now);
+  const std::string client = queue_iter->first;
+  QueuedCommand queued_command = std::move(queue_iter->second.front());
+  queue_iter->second.pop_front();
+  if (queue_iter->second.empty()) {
+    command_queues_.erase(queue_iter);
+  }
+
+  if (client == last_client_) {
+    ++consecutive_commands_;
+  } else {
+    last_client_ = client;
+    consecutive_commands_ = 1;
+  }
+
+  const std::string metrics_name = GetClientInfo(client).metrics_name;
+  if (metrics_) {
+    metrics_->ReportCommandQueueTime(metrics_name,
+                                     now - queued_command.queue_time);
+  }
+  command_in_progress_ = true;
+  next_transceiver_->SendCommand(
+      queued_command.command,
+      base::BindOnce(&CommandScheduler::OnResponse, weak_factory_.GetWeakPtr(),
+                     metrics_name, now, std::move(queued_command.callback)));
+}
+
+std::map<std::string, std::deque<CommandScheduler::QueuedCommand>>::iterator
+CommandScheduler::ChooseNextClient(base::TimeTicks now) {
+  DCHECK(!command_queues_.empty());
+  auto best = command_queues_.end();
+  Priority best_priority = Priority::kNormal;
+  for (auto iter = command_queues_.begin(); iter != command_queues_.end();
+       ++iter) {
+    const base::TimeTicks queue_time = iter->second.front().queue_time;
+    const Priority priority =
+        GetEffectivePriority(iter->first, queue_time, now);
+    if (best == command_queues_.end() || priority < best_priority ||
+        (priority == best_priority &&
+         queue_time < best->second.front().queue_time)) {
+      best = iter;
+      best_priority = priority;
+    }
+  }
+
+  // Keep serving the last client while it has commands of the same priority.
+  auto last = command_queues_.find(last_client_);
+  if (last != command_queues_.end() &&
+      consecutive_commands_ < kMaxConsecutiveCommands &&
+      GetEffectivePriority(last->first, last->second.front().queue_time,
+                           now) == best_priority) {
+    return last;
+  }
+  return best;
+}
+
+CommandScheduler::Priority CommandScheduler::GetEffectivePriority(
+    const std::string& client,
+    base::TimeTicks queue_time,
+    base::TimeTicks now) const {
+  if (now - queue_time > kMaxQueueDelay) {
+    return Priority::kHigh;
+  }
+  return GetClientInfo(client).priority;
+}
+
+CommandScheduler::ClientInfo CommandScheduler::GetClientInfo(
+    const std::string& client) const {
+  auto iter = client_info_.find(client);
+  if (iter == client_info_.end()) {
+    return ClientInfo{kOtherClientMetricsName, Priority::kNormal};
+  }
+  return iter->second;
+}
+
+void CommandScheduler::OnResponse(const std::string& metrics_name,
+                                  base::TimeTicks send_time,
+                                  CommandTransceiver::ResponseCallback callback,
+                                  const std::string& response) {
+  if (metrics_) {
+    metrics_->ReportCommandProcessingTime(metrics_name,
+                                          base::TimeTicks::Now() - send_time);
+  }
+  command_in_progress_ = false;
+  std::move(callback).Run(response);
+  SendNextCommand();
+}
+
+}  // namespace trunks
@@ -0,0 +1,129 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TRUNKS_COMMAND_SCHEDULER_H_
+#define TRUNKS_COMMAND_SCHEDULER_H_
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include <base/memory/weak_ptr.h>
+#include <base/time/time.h>
+
+#include "trunks/command_transceiver.h"
+
+namespace trunks {
+
+class TrunksMetrics;
+
+// CommandScheduler queues the TPM commands of the clients of trunksd and sends
+// them one at a time to the next transceiver, usually a
+// BackgroundCommandTransceiver in front of the ResourceManager.
+//
+// The next command is chosen as follows:
+//   - Commands of high priority clients (e.g. u2fd, cryptohome) go first.
+//     Commands that have been waiting for more than |kMaxQueueDelay| are
+//     treated as high priority so other clients are not starved.
+//   - Consecutive commands of the same client are sent back to back, up to
+//     |kMaxConsecutiveCommands|, such that the objects and sessions of the
+//     client remain loaded in the TPM instead of being evicted by the
+//     ResourceManager to make room for the ones of other clients.
+//   - Otherwise, commands are sent in the order they were received.
+// The commands of each client are always sent in the order they were received.
+//
+// The time commands wait in the queue and the time they take to be processed
+// are reported per client.
+//
+// All methods must be called on the same thread, and the next transceiver must
+// run the response callbacks on this thread.
+class CommandScheduler {
+ public:
+  enum class Priority {
+    kHigh,
+    kNormal,
+  };
+
+  static constexpr int kMaxConsecutiveCommands = 8;
+  static constexpr base::TimeDelta kMaxQueueDelay = base::Milliseconds(500);
+
+  // The |next_transceiver| and |metrics|, if not null, must outlive this
+  // object.
+  CommandScheduler(CommandTransceiver* next_transceiver,
+                   TrunksMetrics* metrics);
+  CommandScheduler(const CommandScheduler&) = delete;
+  CommandScheduler& operator=(const CommandScheduler&) = delete;
+
+  ~CommandScheduler();
+
+  // Sets the |priority| and the name used in metrics of the client identified
+  // by |client|, e.g. its unique D-Bus name. Unknown clients have normal
+  // priority and are reported as "Other".
+  void SetClientInfo(const std::string& client,
+                     const std::string& metrics_name,
+                     Priority priority);
+
+  // Forgets the information set for |client|.
+  void RemoveClientInfo(const std::string& client);
+
+  // Queues |command| of |client|. |callback| is run with the response once the
+  // command is processed.
+  void SendCommand(const std::string& client,
+                   const std::string& command,
+                   CommandTransceiver::ResponseCallback callback);
+
+  size_t queued_command_count() const;
+
+ private:
+  struct ClientInfo {
+    std::string metrics_name;
+    Priority priority;
+  };
+
+  struct QueuedCommand {
+    std::string command;
+    CommandTransceiver::ResponseCallback callback;
+    base::TimeTicks queue_time;
+  };
+
+  // Sends the next command to |next_transceiver_| if none is being processed.
+  void SendNextCommand();
+
+  // Returns the client whose command should be sent next. |command_queues_|
+  // must not be empty.
+  std::map<std::string, std::deque<QueuedCommand>>::iterator ChooseNextClient(
+      base::TimeTicks now);
+
+  // Returns the priority of the first command of |client|, which is queued
+  // since |queue_time|.
+  Priority GetEffectivePriority(const std::string& client,
+                                base::TimeTicks queue_time,
+                                base::TimeTicks now) const;
+
+  ClientInfo GetClientInfo(const std::string& client) const;
+
+  void OnResponse(const std::string& metrics_name,
+                  base::TimeTicks send_time,
+                  CommandTransceiver::ResponseCallback callback,
+                  const std::string& response);
+
+  CommandTransceiver* next_transceiver_;
+  TrunksMetrics* metrics_;
+
+  std::map<std::string, ClientInfo> client_info_;
+  // Queued commands of the clients with at least one queued command.
+  std::map<std::string, std::deque<QueuedCommand>> command_queues_;
+  bool command_in_progress_ = false;
+  // The client of the last sent command and the number of commands of this
+  // client sent in a row.
+  std::string last_client_;
+  int consecutive_commands_ = 0;
+
+  // Declared last so weak pointers are invalidated first on destruction.
+  base::WeakPtrFactory<CommandScheduler> weak_factory_{this};
+};
+
+}  // namespace trunks
+
+#endif  // TRUNKS_COMMAND_SCHEDULER_H_
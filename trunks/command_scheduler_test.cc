@@ -0,0 +1,154 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "trunks/command_scheduler.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <base/functional/bind.h>
+#include <base/test/task_environment.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "trunks/mock_command_transceiver.h"
+
+using testing::_;
+using testing::ElementsAre;
+using testing::Invoke;
+
+namespace trunks {
+
+namespace {
+
+constexpr char kHighPriorityClient[] = ":1.1";
+constexpr char kClient[] = ":1.2";
+constexpr char kOtherClient[] = ":1.3";
+
+}  // namespace
+
+class CommandSchedulerTest : public testing::Test {
+ public:
+  CommandSchedulerTest() {
+    EXPECT_CALL(next_transceiver_, SendCommand(_, _))
+        .WillRepeatedly(Invoke(
+            [this](const std::string& command,
+                   CommandTransceiver::ResponseCallback callback) {
+              sent_commands_.push_back(command);
+              pending_callbacks_.push_back(std::move(callback));
+            }));
+    scheduler_.SetClientInfo(kHighPriorityClient, "HighPriority",
+                             CommandScheduler::Priority::kHigh);
+  }
+
+ protected:
+  void SendCommand(const std::string& client, const std::string& command) {
+    scheduler_.SendCommand(client, command,
+                           base::BindOnce(&CommandSchedulerTest::OnResponse,
+                                          base::Unretained(this)));
+  }
+
+  // Completes the command being processed, with its command as response.
+  void CompleteCommand() {
+    ASSERT_FALSE(pending_callbacks_.empty());
+    auto callback = std::move(pending_callbacks_.front());
+    pending_callbacks_.erase(pending_callbacks_.begin());
+    std::move(callback).Run(sent_commands_[responses_.size()]);
+  }
+
+  void OnResponse(const std::string& response) {
+    responses_.push_back(response);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  testing::StrictMock<MockCommandTransceiver> next_transceiver_;
+  CommandScheduler scheduler_{&next_transceiver_, nullptr};
+  std::vector<std::string> sent_commands_;
+  std::vector<CommandTransceiver::ResponseCallback> pending_callbacks_;
+  std::vector<std::string> responses_;
+};
+
+TEST_F(CommandSchedulerTest, SendsOneCommandAtATime) {
+  SendCommand(kClient, "1");
+  SendCommand(kOtherClient, "2");
+  EXPECT_THAT(sent_commands_, ElementsAre("1"));
+  EXPECT_EQ(scheduler_.queued_command_count(), 1);
+
+  CompleteCommand();
+  EXPECT_THAT(responses_, ElementsAre("1"));
+  EXPECT_THAT(sent_commands_, ElementsAre("1", "2"));
+  EXPECT_EQ(scheduler_.queued_command_count(), 0);
+
+  CompleteCommand();
+  EXPECT_THAT(responses_, ElementsAre("1", "2"));
+}
+
+TEST_F(CommandSchedulerTest, HighPriorityClientFirst) {
+  SendCommand(kClient, "1");
+  SendCommand(kOtherClient, "2");
+  SendCommand(kHighPriorityClient, "3");
+
+  CompleteCommand();
+  CompleteCommand();
+  CompleteCommand();
+  EXPECT_THAT(sent_commands_, ElementsAre("1", "3", "2"));
+}
+
+TEST_F(CommandSchedulerTest, ConsecutiveCommandsOfSameClient) {
+  SendCommand(kClient, "1");
+  SendCommand(kOtherClient, "2");
+  SendCommand(kClient, "3");
+  SendCommand(kOtherClient, "4");
+
+  for (int i = 0; i < 4; ++i) {
+    CompleteCommand();
+  }
+  EXPECT_THAT(sent_commands_, ElementsAre("1", "3", "2", "4"));
+}
+
+TEST_F(CommandSchedulerTest, MaxConsecutiveCommands) {
+  SendCommand(kClient, "first");
+  SendCommand(kOtherClient, "other");
+  for (int i = 0; i < CommandScheduler::kMaxConsecutiveCommands; ++i) {
+    SendCommand(kClient, "next");
+  }
+
+  for (int i = 0; i < CommandScheduler::kMaxConsecutiveCommands; ++i) {
+    CompleteCommand();
+  }
+  // The other client is served once the first one sent the maximum number of
+  // consecutive commands.
+  ASSERT_EQ(sent_commands_.size(),
+            CommandScheduler::kMaxConsecutiveCommands + 1);
+  EXPECT_EQ(sent_commands_.back(), "other");
+}
+
+TEST_F(CommandSchedulerTest, DelayedCommandsGetHighPriority) {
+  SendCommand(kClient, "1");
+  SendCommand(kOtherClient, "2");
+  task_environment_.FastForwardBy(CommandScheduler::kMaxQueueDelay +
+                                  base::Milliseconds(1));
+  SendCommand(kHighPriorityClient, "3");
+
+  CompleteCommand();
+  CompleteCommand();
+  CompleteCommand();
+  EXPECT_THAT(sent_commands_, ElementsAre("1", "2", "3"));
+}
+
+TEST_F(CommandSchedulerTest, RemoveClientInfo) {
+  scheduler_.RemoveClientInfo(kHighPriorityClient);
+  SendCommand(kClient, "1");
+  SendCommand(kOtherClient, "2");
+  SendCommand(kHighPriorityClient, "3");
+
+  CompleteCommand();
+  CompleteCommand();
+  CompleteCommand();
+  EXPECT_THAT(sent_commands_, ElementsAre("1", "2", "3"));
+}
+
+}  // namespace trunks
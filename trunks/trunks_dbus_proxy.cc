@@ -5,6 +5,7 @@
 #include "trunks/trunks_dbus_proxy.h"
 
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include <absl/strings/str_format.h>
@@ -12,6 +13,7 @@
 #include <base/logging.h>
 #include <libhwsec-foundation/tpm_error/tpm_error_data.h>
 #include <libhwsec-foundation/tpm_error/tpm_error_uma_reporter_impl.h>
+#include <libhwsec-foundation/tracing/tracing.h>
 
 #include "trunks/command_codes.h"
 #include "trunks/dbus_interface.h"
@@ -148,6 +150,13 @@ void TrunksDBusProxy::OnError(ResponseCallback callback, brillo::Error* error) {
 }
 
 std::string TrunksDBusProxy::SendCommandAndWait(const std::string& command) {
+  std::optional<hwsec_foundation::ScopedTrace> trace;
+  if (hwsec_foundation::IsTracingEnabled()) {
+    TPM_CC cc;
+    trace.emplace(GetCommandCode(command, cc) == TPM_RC_SUCCESS
+                      ? GetCommandString(cc)
+                      : "UnknownTpmCommand");
+  }
   std::string response = SendCommandAndWaitInternal(command);
   ReportMetrics(command, response);
   return response;
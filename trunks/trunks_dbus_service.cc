@@ -8,6 +8,10 @@
 
 #include <base/functional/bind.h>
 #include <base/logging.h>
+#include <dbus/attestation/dbus-constants.h>
+#include <dbus/cryptohome/dbus-constants.h>
+#include <dbus/message.h>
+#include <dbus/u2f/dbus-constants.h>
 
 #include "trunks/dbus_interface.h"
 #include "trunks/error_codes.h"
@@ -19,6 +23,28 @@ namespace trunks {
 using brillo::dbus_utils::AsyncEventSequencer;
 using brillo::dbus_utils::DBusMethodResponse;
 
+namespace {
+
+// The D-Bus services of the clients whose commands are scheduled with a
+// specific priority or reported separately in metrics.
+struct KnownClient {
+  const char* service_name;
+  const char* metrics_name;
+  CommandScheduler::Priority priority;
+};
+
+const KnownClient kKnownClients[] = {
+    // Latency-sensitive: user presence for security keys and user unlock.
+    {u2f::kU2FServiceName, "U2f", CommandScheduler::Priority::kHigh},
+    {user_data_auth::kUserDataAuthServiceName, "Cryptohome",
+     CommandScheduler::Priority::kHigh},
+    {attestation::kAttestationServiceName, "Attestation",
+     CommandScheduler::Priority::kNormal},
+    {"org.chromium.Chaps", "Chaps", CommandScheduler::Priority::kNormal},
+};
+
+}  // namespace
+
 TrunksDBusService::TrunksDBusService(WriteErrorTracker& write_error_tracker)
     : brillo::DBusServiceDaemon(trunks::kTrunksServiceName),
       write_error_tracker_(write_error_tracker) {}
@@ -29,10 +55,12 @@ void TrunksDBusService::RegisterDBusObjectsAsync(
       nullptr, bus_, dbus::ObjectPath(kTrunksServicePath)));
   brillo::dbus_utils::DBusInterface* dbus_interface =
       trunks_dbus_object_->AddOrGetInterface(kTrunksInterface);
-  dbus_interface->AddMethodHandler(kSendCommand, base::Unretained(this),
-                                   &TrunksDBusService::HandleSendCommand);
+  dbus_interface->AddMethodHandlerWithMessage(
+      kSendCommand, base::BindRepeating(&TrunksDBusService::HandleSendCommand,
+                                        base::Unretained(this)));
   trunks_dbus_object_->RegisterAsync(
       sequencer->GetHandler("Failed to register D-Bus object.", true));
+  WatchKnownClients();
   if (power_manager_) {
     power_manager_->Init(bus_);
   }
@@ -48,8 +76,9 @@ void TrunksDBusService::OnShutdown(int* exit_code) {
 void TrunksDBusService::HandleSendCommand(
     std::unique_ptr<DBusMethodResponse<const SendCommandResponse&>>
         response_sender,
+    dbus::Message* message,
     const SendCommandRequest& request) {
-  // Convert |response_sender| to a shared_ptr so |transceiver_| can safely
+  // Convert |response_sender| to a shared_ptr so |scheduler_| can safely
   // copy the callback.
   using SharedResponsePointer =
       std::shared_ptr<DBusMethodResponse<const SendCommandResponse&>>;
@@ -73,10 +102,39 @@ void TrunksDBusService::HandleSendCommand(
              CreateErrorResponse(SAPI_RC_BAD_PARAMETER));
     return;
   }
-  transceiver_->SendCommand(
-      request.command(),
+  scheduler_->SendCommand(
+      message->GetSender(), request.command(),
       base::BindOnce(callback, base::Unretained(this),
                      SharedResponsePointer(std::move(response_sender))));
 }
 
+void TrunksDBusService::WatchKnownClients() {
+  for (const KnownClient& client : kKnownClients) {
+    auto callback =
+        base::BindRepeating(&TrunksDBusService::OnKnownClientOwnerChanged,
+                            GetWeakPtr(), client.service_name);
+    bus_->ListenForServiceOwnerChange(client.service_name, callback);
+    bus_->GetServiceOwner(client.service_name, callback);
+  }
+}
+
+void TrunksDBusService::OnKnownClientOwnerChanged(
+    const std::string& service_name, const std::string& owner) {
+  auto owner_iter = known_client_owners_.find(service_name);
+  if (owner_iter != known_client_owners_.end()) {
+    scheduler_->RemoveClientInfo(owner_iter->second);
+    known_client_owners_.erase(owner_iter);
+  }
+  if (owner.empty()) {
+    return;
+  }
+  for (const KnownClient& client : kKnownClients) {
+    if (service_name == client.service_name) {
+      scheduler_->SetClientInfo(owner, client.metrics_name, client.priority);
+      known_client_owners_[service_name] = owner;
+      return;
+    }
+  }
+}
+
 }  // namespace trunks
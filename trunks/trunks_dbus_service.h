@@ -5,6 +5,7 @@
 #ifndef TRUNKS_TRUNKS_DBUS_SERVICE_H_
 #define TRUNKS_TRUNKS_DBUS_SERVICE_H_
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -13,10 +14,12 @@
 #include <brillo/dbus/dbus_method_response.h>
 #include <brillo/dbus/dbus_object.h>
 
+#include "trunks/command_scheduler.h"
 #include "trunks/command_transceiver.h"
 #include "trunks/power_manager.h"
 #include "trunks/resilience/write_error_tracker.h"
 #include "trunks/trunks_interface.pb.h"
+#include "trunks/trunks_metrics.h"
 
 namespace trunks {
 
@@ -36,10 +39,11 @@ class TrunksDBusService : public brillo::DBusServiceDaemon {
 
   ~TrunksDBusService() override = default;
 
-  // The |transceiver| will be the target of all incoming TPM commands. This
-  // class does not take ownership of |transceiver|.
+  // The |transceiver| will be the target of all incoming TPM commands, which
+  // are scheduled by a CommandScheduler. This class does not take ownership of
+  // |transceiver|.
   void set_transceiver(CommandTransceiver* transceiver) {
-    transceiver_ = transceiver;
+    scheduler_ = std::make_unique<CommandScheduler>(transceiver, &metrics_);
   }
 
   // The |power_manager| will be initialized with D-Bus object.
@@ -60,14 +64,28 @@ class TrunksDBusService : public brillo::DBusServiceDaemon {
   // Handles calls to the 'SendCommand' method.
   void HandleSendCommand(std::unique_ptr<brillo::dbus_utils::DBusMethodResponse<
                              const SendCommandResponse&>> response_sender,
+                         dbus::Message* message,
                          const SendCommandRequest& request);
 
+  // Starts tracking the owners of the D-Bus services of the known clients, so
+  // that their commands are scheduled according to their priority.
+  void WatchKnownClients();
+
+  // Called when the owner of the D-Bus service |service_name| of a known
+  // client changes to |owner|, which is empty if the service has no owner.
+  void OnKnownClientOwnerChanged(const std::string& service_name,
+                                 const std::string& owner);
+
   base::WeakPtr<TrunksDBusService> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
   }
 
   std::unique_ptr<brillo::dbus_utils::DBusObject> trunks_dbus_object_;
-  CommandTransceiver* transceiver_ = nullptr;
+  TrunksMetrics metrics_;
+  std::unique_ptr<CommandScheduler> scheduler_;
+  // The current unique D-Bus names of the known clients, keyed by the name of
+  // their service.
+  std::map<std::string, std::string> known_client_owners_;
   PowerManager* power_manager_ = nullptr;
   WriteErrorTracker& write_error_tracker_;
 
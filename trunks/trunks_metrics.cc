@@ -39,6 +39,10 @@ constexpr char kTransitionedWriteErrorNo[] =
 
 constexpr char kTpmErrorCode[] = "Platform.Trunks.TpmErrorCode";
 
+constexpr char kCommandQueueTime[] = "Platform.Trunks.CommandQueueTime.";
+constexpr char kCommandProcessingTime[] =
+    "Platform.Trunks.CommandProcessingTime.";
+
 }  // namespace
 
 bool TrunksMetrics::ReportTpmHandleTimeoutCommandAndTime(int error_result,
@@ -107,4 +111,22 @@ void TrunksMetrics::ReportWriteErrorNo(int prev, int next) {
   }
 }
 
+void TrunksMetrics::ReportCommandQueueTime(const std::string& client,
+                                           base::TimeDelta duration) {
+  constexpr base::TimeDelta kMin = base::Milliseconds(1);
+  constexpr base::TimeDelta kMax = base::Seconds(10);
+  constexpr int kNumBuckets = 50;
+  metrics_library_.SendTimeToUMA(kCommandQueueTime + client, duration, kMin,
+                                 kMax, kNumBuckets);
+}
+
+void TrunksMetrics::ReportCommandProcessingTime(const std::string& client,
+                                                base::TimeDelta duration) {
+  constexpr base::TimeDelta kMin = base::Milliseconds(1);
+  constexpr base::TimeDelta kMax = base::Seconds(10);
+  constexpr int kNumBuckets = 50;
+  metrics_library_.SendTimeToUMA(kCommandProcessingTime + client, duration,
+                                 kMin, kMax, kNumBuckets);
+}
+
 }  // namespace trunks
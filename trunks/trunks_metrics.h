@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include <base/time/time.h>
 #include <metrics/metrics_library.h>
 
 #include "trunks/tpm_generated.h"
@@ -37,6 +38,14 @@ class TrunksMetrics {
 
   void ReportWriteErrorNo(int prev, int next);
 
+  // These functions report how long a command of |client| waited in the
+  // queue of the CommandScheduler and how long it took to be processed by the
+  // ResourceManager and the TPM.
+  void ReportCommandQueueTime(const std::string& client,
+                              base::TimeDelta duration);
+  void ReportCommandProcessingTime(const std::string& client,
+                                   base::TimeDelta duration);
+
  private:
   MetricsLibrary metrics_library_;
 };
@@ -117,6 +117,9 @@ void UdevMonitor::RemoveTypecObserver(TypecObserver* obs) {
 bool UdevMonitor::HandleDeviceAddedRemoved(const base::FilePath& path,
                                            bool added,
                                            bool is_initial_scan) {
+  // Keep the "change" events ordered with respect to additions and removals.
+  FlushChangeEvents();
+
   auto name = path.BaseName();
   int port_num;
 
@@ -146,10 +149,30 @@ void UdevMonitor::HandleDeviceChange(const base::FilePath& path) {
   auto name = path.BaseName();
   int port_num;
 
+  if (RE2::FullMatch(name.value(), kPartnerRegex, &port_num))
+    pending_partner_changes_.insert(port_num);
+  else if (RE2::FullMatch(name.value(), kPortRegex, &port_num))
+    pending_port_changes_.insert(port_num);
+  else
+    return;
+
+  if (!change_timer_.IsRunning()) {
+    change_timer_.Start(FROM_HERE, kChangeEventCoalesceDelay, this,
+                        &UdevMonitor::FlushChangeEvents);
+  }
+}
+
+void UdevMonitor::FlushChangeEvents() {
+  change_timer_.Stop();
+  std::set<int> partner_changes;
+  std::set<int> port_changes;
+  partner_changes.swap(pending_partner_changes_);
+  port_changes.swap(pending_port_changes_);
+
   for (auto& observer : typec_observer_list_) {
-    if (RE2::FullMatch(name.value(), kPartnerRegex, &port_num))
+    for (int port_num : partner_changes)
       observer.OnPartnerChanged(port_num);
-    else if (RE2::FullMatch(name.value(), kPortRegex, &port_num))
+    for (int port_num : port_changes)
       observer.OnPortChanged(port_num);
   }
 }
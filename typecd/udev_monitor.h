@@ -9,6 +9,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -16,6 +17,8 @@
 #include <base/files/file_path.h>
 #include <base/observer_list.h>
 #include <base/observer_list_types.h>
+#include <base/time/time.h>
+#include <base/timer/timer.h>
 #include <brillo/udev/mock_udev.h>
 #include <gtest/gtest_prod.h>
 
@@ -30,6 +33,11 @@ constexpr char kUsbPdSubsystem[] = "usb_power_delivery";
 // objects / classes of these events.
 class UdevMonitor {
  public:
+  // "change" events received within this window of the first one are
+  // coalesced, so that each port's state is re-read once per burst.
+  static constexpr base::TimeDelta kChangeEventCoalesceDelay =
+      base::Milliseconds(20);
+
   UdevMonitor() = default;
 
   // Create a Udev device for enumeration and monitoring.
@@ -133,6 +141,7 @@ class UdevMonitor {
   FRIEND_TEST(UdevMonitorTest, CableAndAltModeAddition);
   FRIEND_TEST(UdevMonitorTest, PartnerChanged);
   FRIEND_TEST(UdevMonitorTest, PortChanged);
+  FRIEND_TEST(UdevMonitorTest, ChangeEventsCoalesced);
   FRIEND_TEST(UdevMonitorTest, PdDevice);
 
   // Set the |udev_| pointer to a MockUdev device. *Only* used by unit tests.
@@ -146,9 +155,14 @@ class UdevMonitor {
                                 bool added,
                                 bool is_initial_scan = false);
 
-  // Handle a udev "change" event for a Type C device.
+  // Handle a udev "change" event for a Type C device. The observers are
+  // notified after |kChangeEventCoalesceDelay|, or before the next
+  // add/remove event, whichever comes first.
   void HandleDeviceChange(const base::FilePath& path);
 
+  // Notify the observers of the pending "change" events.
+  void FlushChangeEvents();
+
   // Handle Udev events emanating from |udev_monitor_watcher_|.
   void HandleUdevEvent();
 
@@ -157,6 +171,11 @@ class UdevMonitor {
   std::unique_ptr<base::FileDescriptorWatcher::Controller>
       udev_monitor_watcher_;
   base::ObserverList<TypecObserver> typec_observer_list_;
+
+  // Ports with a pending partner or port "change" event.
+  std::set<int> pending_partner_changes_;
+  std::set<int> pending_port_changes_;
+  base::OneShotTimer change_timer_;
 };
 
 }  // namespace typecd
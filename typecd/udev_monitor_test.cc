@@ -126,7 +126,8 @@ class UdevMonitorTest : public ::testing::Test {
   UdevMonitorTest()
       : task_environment_(
             base::test::TaskEnvironment::MainThreadType::IO,
-            base::test::TaskEnvironment::ThreadPoolExecutionMode::ASYNC) {}
+            base::test::TaskEnvironment::ThreadPoolExecutionMode::ASYNC,
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
 
  protected:
   void SetUp() override {
@@ -366,6 +367,7 @@ TEST_F(UdevMonitorTest, PartnerChanged) {
   // Instead we manually call HandleUdevEvent. Effectively this is equivalent to
   // triggering the event handler using the FileDescriptorWatcher.
   monitor_->HandleUdevEvent();
+  task_environment_.FastForwardBy(UdevMonitor::kChangeEventCoalesceDelay);
   EXPECT_THAT(1, typec_observer_->GetNumPartnerChangeEvents());
 }
 
@@ -402,9 +404,47 @@ TEST_F(UdevMonitorTest, PortChanged) {
   // Instead we manually call HandleUdevEvent. Effectively this is equivalent to
   // triggering the event handler using the FileDescriptorWatcher.
   monitor_->HandleUdevEvent();
+  task_environment_.FastForwardBy(UdevMonitor::kChangeEventCoalesceDelay);
   EXPECT_TRUE(typec_observer_->PortChanged(0));
 }
 
+// Check that a burst of change events for a partner is reported once, and that
+// a following removal doesn't overtake it.
+TEST_F(UdevMonitorTest, ChangeEventsCoalesced) {
+  InitMockUdevMonitor();
+  constexpr int kNumChangeEvents = 3;
+  for (int i = 0; i < kNumChangeEvents; i++) {
+    auto device_partner_change = std::make_unique<brillo::MockUdevDevice>();
+    EXPECT_CALL(*device_partner_change, GetSysPath())
+        .WillOnce(Return(kFakePort0PartnerSysPath));
+    EXPECT_CALL(*device_partner_change, GetAction()).WillOnce(Return("change"));
+    EXPECT_CALL(*mock_udev_monitor_, ReceiveDevice())
+        .WillOnce(Return(ByMove(std::move(device_partner_change))))
+        .RetiresOnSaturation();
+  }
+
+  auto udev = std::make_unique<brillo::MockUdev>();
+  EXPECT_CALL(*udev, CreateMonitorFromNetlink(StrEq(kUdevMonitorName)))
+      .WillOnce(Return(ByMove(std::move(mock_udev_monitor_))));
+
+  monitor_->SetUdev(std::move(udev));
+  ASSERT_TRUE(monitor_->BeginMonitoring());
+
+  for (int i = 0; i < kNumChangeEvents; i++)
+    monitor_->HandleUdevEvent();
+  EXPECT_THAT(0, typec_observer_->GetNumPartnerChangeEvents());
+  task_environment_.FastForwardBy(UdevMonitor::kChangeEventCoalesceDelay);
+  EXPECT_THAT(1, typec_observer_->GetNumPartnerChangeEvents());
+
+  // A pending change is delivered before a partner removal.
+  monitor_->HandleDeviceChange(base::FilePath(kFakePort0PartnerSysPath));
+  monitor_->HandleDeviceAddedRemoved(base::FilePath(kFakePort0PartnerSysPath),
+                                     false);
+  EXPECT_THAT(2, typec_observer_->GetNumPartnerChangeEvents());
+  task_environment_.FastForwardBy(UdevMonitor::kChangeEventCoalesceDelay);
+  EXPECT_THAT(2, typec_observer_->GetNumPartnerChangeEvents());
+}
+
 // Check USB PD device event parsing for addition, removal and
 // invalid filepath cases.
 TEST_F(UdevMonitorTest, PdDevice) {
@@ -130,7 +130,7 @@ bool WebAuthnStorage::WriteRecord(const WebAuthnRecord& record) {
   VLOG(1) << "Done writing record with id " << credential_id_hex
           << " to file successfully. ";
 
-  records_.emplace_back(record);
+  AddRecord(record);
   return true;
 }
 
@@ -262,7 +262,7 @@ bool WebAuthnStorage::LoadRecords() {
       continue;
     }
 
-    records_.emplace_back(WebAuthnRecord{
+    AddRecord(WebAuthnRecord{
         .credential_id = credential_id,
         .secret = brillo::BlobFromString(secret),
         .key_blob = brillo::Blob(key_blob.begin(), key_blob.end()),
@@ -286,40 +286,37 @@ bool WebAuthnStorage::SendRecordCountToUMA(MetricsLibraryInterface* metrics) {
 
 std::optional<brillo::SecureBlob> WebAuthnStorage::GetSecretByCredentialId(
     const std::string& credential_id) {
-  for (const WebAuthnRecord& record : records_) {
-    if (record.credential_id == credential_id) {
-      return brillo::SecureBlob(record.secret);
-    }
+  const WebAuthnRecord* record = FindRecord(credential_id);
+  if (!record) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  return brillo::SecureBlob(record->secret);
 }
 
 bool WebAuthnStorage::GetSecretAndKeyBlobByCredentialId(
     const std::string& credential_id,
     brillo::SecureBlob* secret,
     brillo::Blob* key_blob) {
-  for (const WebAuthnRecord& record : records_) {
-    if (record.credential_id == credential_id) {
-      if (secret) {
-        *secret = brillo::SecureBlob(record.secret);
-      }
-      if (key_blob) {
-        *key_blob = record.key_blob;
-      }
-      return true;
-    }
+  const WebAuthnRecord* record = FindRecord(credential_id);
+  if (!record) {
+    return false;
+  }
+  if (secret) {
+    *secret = brillo::SecureBlob(record->secret);
   }
-  return false;
+  if (key_blob) {
+    *key_blob = record->key_blob;
+  }
+  return true;
 }
 
 std::optional<WebAuthnRecord> WebAuthnStorage::GetRecordByCredentialId(
     const std::string& credential_id) {
-  for (const WebAuthnRecord& record : records_) {
-    if (record.credential_id == credential_id) {
-      return record;
-    }
+  const WebAuthnRecord* record = FindRecord(credential_id);
+  if (!record) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  return *record;
 }
 
 int WebAuthnStorage::CountRecordsInTimeRange(int64_t timestamp_min,
@@ -347,6 +344,10 @@ int WebAuthnStorage::DeleteRecordsInTimeRange(int64_t timestamp_min,
     DeleteRecordWithCredentialId(record->credential_id);
   }
   records_.erase(remove_begin, records_.end());
+  record_index_.clear();
+  for (size_t i = 0; i < records_.size(); i++) {
+    record_index_.emplace(records_[i].credential_id, i);
+  }
   size_t updated_size = records_.size();
   return original_size - updated_size;
 }
@@ -355,12 +356,29 @@ void WebAuthnStorage::Reset() {
   allow_access_ = false;
   sanitized_user_.clear();
   records_.clear();
+  record_index_.clear();
 }
 
 void WebAuthnStorage::SetRootPathForTesting(const base::FilePath& root_path) {
   root_path_ = root_path;
 }
 
+void WebAuthnStorage::AddRecord(WebAuthnRecord record) {
+  // Keep the first record if the id is duplicated, like a scan of |records_|
+  // would.
+  record_index_.emplace(record.credential_id, records_.size());
+  records_.push_back(std::move(record));
+}
+
+const WebAuthnRecord* WebAuthnStorage::FindRecord(
+    const std::string& credential_id) const {
+  auto it = record_index_.find(credential_id);
+  if (it == record_index_.end()) {
+    return nullptr;
+  }
+  return &records_[it->second];
+}
+
 bool WebAuthnStorage::DeleteRecordWithCredentialId(
     const std::string& credential_id) {
   // Use the hash of credential_id for the filename because the hex encode of
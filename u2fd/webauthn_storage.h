@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <base/files/file_path.h>
@@ -92,6 +93,12 @@ class WebAuthnStorage {
  private:
   bool DeleteRecordWithCredentialId(const std::string& credential_id);
 
+  // Appends |record| to |records_| and indexes it.
+  void AddRecord(WebAuthnRecord record);
+
+  // Returns the record with |credential_id|, or nullptr if there is none.
+  const WebAuthnRecord* FindRecord(const std::string& credential_id) const;
+
   base::FilePath root_path_;
   // Whether access to storage is allowed.
   bool allow_access_ = false;
@@ -99,6 +106,9 @@ class WebAuthnStorage {
   std::string sanitized_user_;
   // All WebAuthn credential records for |sanitized_user_|.
   std::vector<WebAuthnRecord> records_;
+  // Maps the credential ids to their index in |records_|, so that looking up
+  // the credentials of an assertion doesn't scan all the records.
+  std::unordered_map<std::string, size_t> record_index_;
 };
 
 }  // namespace u2f
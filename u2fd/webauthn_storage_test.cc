@@ -181,6 +181,18 @@ TEST_F(WebAuthnStorageTest, CountAndDeleteRecords) {
   EXPECT_EQ(webauthn_storage_->CountRecordsInTimeRange(10150, 10800), 2);
   EXPECT_EQ(webauthn_storage_->CountRecordsInTimeRange(0, 100000), 4);
 
+  // The remaining records can still be looked up.
+  for (int i : {0, 3, 8, 9}) {
+    std::optional<WebAuthnRecord> record =
+        webauthn_storage_->GetRecordByCredentialId(std::string(kCredentialId) +
+                                                   std::to_string(i));
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(record->timestamp, timestamp_base + i * 100);
+  }
+  EXPECT_FALSE(webauthn_storage_
+                   ->GetRecordByCredentialId(std::string(kCredentialId) + "1")
+                   .has_value());
+
   // Delete all records.
   EXPECT_EQ(webauthn_storage_->DeleteRecordsInTimeRange(0, 100000), 4);
   EXPECT_EQ(webauthn_storage_->CountRecordsInTimeRange(0, 100000), 0);
@@ -4,7 +4,11 @@
 
 #include "ureadahead-diff/ureadahead_diff.h"
 
+#include <string>
+#include <vector>
+
 #include <base/logging.h>
+#include <base/strings/string_split.h>
 #include <brillo/flag_helper.h>
 
 namespace {
@@ -13,18 +17,61 @@ constexpr char help[] =
     "Calculate difference of two ureadahead packs. Output is written into "
     "three packs.\nCommon contains the same read operations from two source "
     "packs. Difference packs\ncontain unique read operations for the "
-    "corresponding source pack.";
+    "corresponding source pack.\n\nWith --merge, merge the packs recorded "
+    "during many boots into a single\npack with the pages read during at "
+    "least --min_packs boots, capped to\n--max_mb megabytes.";
+
+int MergePacks(const std::string& sources,
+               const std::string& output,
+               int min_packs,
+               int max_mb) {
+  if (output.empty() || min_packs < 1 || max_mb < 0) {
+    LOG(ERROR) << "Invalid merge arguments";
+    return 1;
+  }
+
+  ureadahead_diff::PackMerger merger;
+  for (const std::string& source : base::SplitString(
+           sources, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    ureadahead_diff::Pack pack;
+    if (!pack.Read(source)) {
+      LOG(ERROR) << "Failed to read " << source;
+      return 2;
+    }
+    if (!merger.AddPack(&pack)) {
+      LOG(ERROR) << source << " was recorded on another device";
+      return 2;
+    }
+  }
+
+  ureadahead_diff::Pack merged;
+  merger.Merge(min_packs, static_cast<size_t>(max_mb) << 20, &merged);
+  if (!merged.Write(output)) {
+    LOG(ERROR) << "Failed to write " << output;
+    return 4;
+  }
+
+  return 0;
 }
 
+}  // namespace
+
 int main(int argc, char* argv[]) {
   DEFINE_string(source1, "", "First source pack to process");
   DEFINE_string(source2, "", "Second source pack to process");
   DEFINE_string(common, "", "Common pack output name");
   DEFINE_string(difference1, "", "Output difference for the first pack");
   DEFINE_string(difference2, "", "Output difference for the second pack");
+  DEFINE_string(merge, "", "Comma-separated source packs to merge");
+  DEFINE_string(output, "", "Merged pack output name");
+  DEFINE_int32(min_packs, 1, "Minimum number of packs reading a merged page");
+  DEFINE_int32(max_mb, 0, "Maximum size of the merged pages, 0 for no limit");
 
   brillo::FlagHelper::Init(argc, argv, help);
 
+  if (!FLAGS_merge.empty())
+    return MergePacks(FLAGS_merge, FLAGS_output, FLAGS_min_packs, FLAGS_max_mb);
+
   if (FLAGS_source1.empty() || FLAGS_source2.empty() || FLAGS_common.empty() ||
       FLAGS_difference1.empty() || FLAGS_difference2.empty()) {
     LOG(ERROR) << "Not all arguments are provided";
@@ -7,6 +7,7 @@
 #include <fcntl.h>
 
 #include <algorithm>
+#include <tuple>
 #include <utility>
 
 #include <base/files/file_util.h>
@@ -100,6 +101,16 @@ bool FileEntry::IsEmpty() const {
   return true;
 }
 
+bool FileEntry::IsPageRead(size_t index) const {
+  return index < read_map_.size() && read_map_[index];
+}
+
+void FileEntry::SetPageRead(size_t index) {
+  if (index >= read_map_.size())
+    read_map_.resize(index + 1, false);
+  read_map_[index] = true;
+}
+
 // static
 void FileEntry::CalculateDifference(FileEntry* file1,
                                     FileEntry* file2,
@@ -303,4 +314,93 @@ bool Pack::Write(int fd) const {
   return true;
 }
 
+PackMerger::PackMerger() = default;
+PackMerger::~PackMerger() = default;
+
+bool PackMerger::AddPack(Pack* pack) {
+  if (pack_count_ && pack->dev() != dev_)
+    return false;
+  dev_ = pack->dev();
+  ++pack_count_;
+
+  const size_t file_count = pack->GetFileCount();
+  for (size_t i = 0; i < file_count; ++i) {
+    FileEntry* const file = pack->GetFile(i);
+    const PackPath& pack_path = file->pack_path();
+    auto [it, inserted] = file_indices_.emplace(
+        std::make_pair(std::string(pack_path.path), pack_path.ino),
+        files_.size());
+    if (inserted)
+      files_.emplace_back(pack_path);
+    MergedFile& merged = files_[it->second];
+
+    merged.position_sum +=
+        file_count > 1 ? static_cast<double>(i) / (file_count - 1) : 0;
+    ++merged.pack_count;
+    if (merged.page_read_counts.size() < file->GetPageCount())
+      merged.page_read_counts.resize(file->GetPageCount(), 0);
+    for (size_t page = 0; page < file->GetPageCount(); ++page) {
+      if (file->IsPageRead(page))
+        ++merged.page_read_counts[page];
+    }
+  }
+
+  return true;
+}
+
+void PackMerger::Merge(size_t min_packs, size_t max_bytes, Pack* output) const {
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+
+  std::vector<double> positions;
+  positions.reserve(files_.size());
+  for (const MergedFile& file : files_)
+    positions.push_back(file.position_sum / file.pack_count);
+
+  // Candidate pages, as read count, file index and page index.
+  std::vector<std::tuple<size_t, size_t, size_t>> pages;
+  for (size_t i = 0; i < files_.size(); ++i) {
+    const std::vector<size_t>& counts = files_[i].page_read_counts;
+    for (size_t page = 0; page < counts.size(); ++page) {
+      if (counts[page] && counts[page] >= min_packs)
+        pages.emplace_back(counts[page], i, page);
+    }
+  }
+
+  const size_t max_pages = max_bytes / page_size;
+  if (max_bytes && pages.size() > max_pages) {
+    // Keep the most frequently read pages, and then the earliest read ones.
+    std::stable_sort(pages.begin(), pages.end(),
+                     [&positions](const auto& a, const auto& b) {
+                       if (std::get<0>(a) != std::get<0>(b))
+                         return std::get<0>(a) > std::get<0>(b);
+                       return positions[std::get<1>(a)] <
+                              positions[std::get<1>(b)];
+                     });
+    pages.resize(max_pages);
+  }
+
+  std::vector<std::unique_ptr<FileEntry>> entries(files_.size());
+  for (const auto& [count, file_index, page] : pages) {
+    if (!entries[file_index]) {
+      entries[file_index] =
+          std::make_unique<FileEntry>(files_[file_index].pack_path);
+    }
+    entries[file_index]->SetPageRead(page);
+  }
+
+  std::vector<size_t> order(files_.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&positions](size_t a, size_t b) {
+                     return positions[a] < positions[b];
+                   });
+
+  output->set_dev(dev_);
+  for (size_t i : order) {
+    if (entries[i])
+      output->AddFile(std::move(entries[i]));
+  }
+}
+
 }  // namespace ureadahead_diff
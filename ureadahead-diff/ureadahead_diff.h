@@ -9,8 +9,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ureadahead_diff {
@@ -63,6 +65,15 @@ class FileEntry {
   // Returns true if file does not have any read block.
   bool IsEmpty() const;
 
+  // Returns the number of pages covered by the read map.
+  size_t GetPageCount() const { return read_map_.size(); }
+
+  // Returns true if the page at |index| is read.
+  bool IsPageRead(size_t index) const;
+
+  // Marks the page at |index| as read, extending the read map if needed.
+  void SetPageRead(size_t index);
+
   // Calculates difference of two files. It puts the common part into |common|
   // and leaves difference in |file1| and |file2] correspondingly. Note, that
   // sizes of read requests might be different and |common| will have the size
@@ -120,6 +131,9 @@ class Pack {
   // and leaves difference in |pack1| and |pack2] correspondingly.
   static void CalculateDifference(Pack* pack1, Pack* pack2, Pack* common);
 
+  dev_t dev() const { return dev_; }
+  void set_dev(dev_t dev) { dev_ = dev; }
+
  private:
   bool Read(int fd);
   bool Write(int fd) const;
@@ -130,6 +144,54 @@ class Pack {
   std::vector<std::unique_ptr<FileEntry>> files_;
 };
 
+// Merges the packs recorded during many boots of the same image into a single
+// pack that only contains the pages read during most boots.
+class PackMerger {
+ public:
+  PackMerger();
+  ~PackMerger();
+
+  PackMerger(const PackMerger&) = delete;
+  PackMerger& operator=(const PackMerger&) = delete;
+
+  // Accounts the read operations of |pack|. Returns false if |pack| was
+  // recorded on a different device than the previously added packs.
+  bool AddPack(Pack* pack);
+
+  // Returns the number of packs added.
+  size_t GetPackCount() const { return pack_count_; }
+
+  // Fills |output| with the pages read during at least |min_packs| of the
+  // added packs. When the pages take more than |max_bytes| (0 for no limit),
+  // the most frequently read ones are kept, and then the ones read earliest
+  // during boot. Files are ordered by their average position in the added
+  // packs, which approximates the time of their first access, and the pages
+  // of each file are merged into ranges in offset order so that they are read
+  // sequentially.
+  void Merge(size_t min_packs, size_t max_bytes, Pack* output) const;
+
+ private:
+  struct MergedFile {
+    explicit MergedFile(const PackPath& pack_path) : pack_path(pack_path) {}
+
+    const PackPath pack_path;
+    // Sum of the positions of the file in its packs, from 0 for the first file
+    // of a pack to 1 for the last one.
+    double position_sum = 0;
+    // Number of packs that contain the file.
+    size_t pack_count = 0;
+    // Number of packs that read each page of the file.
+    std::vector<size_t> page_read_counts;
+  };
+
+  size_t pack_count_ = 0;
+  dev_t dev_ = 0;
+
+  std::vector<MergedFile> files_;
+  // Maps the path and inode of a file to its index in |files_|.
+  std::map<std::pair<std::string, ino_t>, size_t> file_indices_;
+};
+
 }  // namespace ureadahead_diff
 
 #endif  // UREADAHEAD_DIFF_UREADAHEAD_DIFF_H_
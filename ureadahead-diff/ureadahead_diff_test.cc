@@ -277,4 +277,105 @@ TEST(Pack, InvalidFile) {
   EXPECT_FALSE(pack.Read(pack_name));
 }
 
+TEST(PackMerger, MinPacks) {
+  Pack pack1;
+  AddFileToPack(&pack1, "common", {{0, 4}});
+  AddFileToPack(&pack1, "rare", {{0, 2}});
+  Pack pack2;
+  AddFileToPack(&pack2, "common", {{2, 4}});
+  Pack pack3;
+  AddFileToPack(&pack3, "common", {{3, 1}});
+
+  PackMerger merger;
+  EXPECT_TRUE(merger.AddPack(&pack1));
+  EXPECT_TRUE(merger.AddPack(&pack2));
+  EXPECT_TRUE(merger.AddPack(&pack3));
+  EXPECT_EQ(3U, merger.GetPackCount());
+
+  Pack all;
+  merger.Merge(1 /* min_packs */, 0 /* max_bytes */, &all);
+  Pack verify_all;
+  AddFileToPack(&verify_all, "common", {{0, 6}});
+  AddFileToPack(&verify_all, "rare", {{0, 2}});
+  EXPECT_TRUE(PacksMatch(&all, &verify_all));
+
+  Pack frequent;
+  merger.Merge(2 /* min_packs */, 0 /* max_bytes */, &frequent);
+  Pack verify_frequent;
+  AddFileToPack(&verify_frequent, "common", {{2, 2}});
+  EXPECT_TRUE(PacksMatch(&frequent, &verify_frequent));
+}
+
+TEST(PackMerger, OrderByPosition) {
+  Pack pack1;
+  AddFileToPack(&pack1, "first", {{0, 1}});
+  AddFileToPack(&pack1, "second", {{0, 1}});
+  AddFileToPack(&pack1, "third", {{0, 1}});
+  Pack pack2;
+  AddFileToPack(&pack2, "second", {{0, 1}});
+  AddFileToPack(&pack2, "first", {{0, 1}});
+  AddFileToPack(&pack2, "third", {{0, 1}});
+  Pack pack3;
+  AddFileToPack(&pack3, "first", {{0, 1}});
+  AddFileToPack(&pack3, "third", {{0, 1}});
+  AddFileToPack(&pack3, "second", {{0, 1}});
+
+  PackMerger merger;
+  EXPECT_TRUE(merger.AddPack(&pack1));
+  EXPECT_TRUE(merger.AddPack(&pack2));
+  EXPECT_TRUE(merger.AddPack(&pack3));
+
+  Pack merged;
+  merger.Merge(1 /* min_packs */, 0 /* max_bytes */, &merged);
+  Pack verify;
+  AddFileToPack(&verify, "first", {{0, 1}});
+  AddFileToPack(&verify, "second", {{0, 1}});
+  AddFileToPack(&verify, "third", {{0, 1}});
+  EXPECT_TRUE(PacksMatch(&merged, &verify));
+}
+
+TEST(PackMerger, MaxBytes) {
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+
+  Pack pack1;
+  AddFileToPack(&pack1, "early", {{0, 2}});
+  AddFileToPack(&pack1, "late", {{0, 2}, {10, 1}});
+  Pack pack2;
+  AddFileToPack(&pack2, "early", {{0, 1}});
+  AddFileToPack(&pack2, "late", {{0, 2}});
+
+  PackMerger merger;
+  EXPECT_TRUE(merger.AddPack(&pack1));
+  EXPECT_TRUE(merger.AddPack(&pack2));
+
+  // The pages read twice are kept first, the early ones first.
+  Pack merged;
+  merger.Merge(1 /* min_packs */, 2 * page_size, &merged);
+  Pack verify;
+  AddFileToPack(&verify, "early", {{0, 1}});
+  AddFileToPack(&verify, "late", {{0, 1}});
+  EXPECT_TRUE(PacksMatch(&merged, &verify));
+
+  // Then the pages read once.
+  Pack larger;
+  merger.Merge(1 /* min_packs */, 4 * page_size, &larger);
+  Pack verify_larger;
+  AddFileToPack(&verify_larger, "early", {{0, 2}});
+  AddFileToPack(&verify_larger, "late", {{0, 2}});
+  EXPECT_TRUE(PacksMatch(&larger, &verify_larger));
+}
+
+TEST(PackMerger, DifferentDevice) {
+  Pack pack1;
+  AddFileToPack(&pack1, "test", {{0, 1}});
+  Pack pack2;
+  pack2.set_dev(1);
+  AddFileToPack(&pack2, "test", {{0, 1}});
+
+  PackMerger merger;
+  EXPECT_TRUE(merger.AddPack(&pack1));
+  EXPECT_FALSE(merger.AddPack(&pack2));
+  EXPECT_EQ(1U, merger.GetPackCount());
+}
+
 }  // namespace ureadahead_diff
@@ -594,6 +594,67 @@ void dm_bht_set_buffer(struct dm_bht* bht, void* buffer) {
   }
 }
 
+/**
+ * dm_bht_compute_entries - computes the hashes of a range of entries
+ * @bht: pointer to a dm_bht_create()d bht
+ * @depth: depth of the entries, which must be above the block level
+ * @first: index of the first entry to compute
+ * @count: number of entries to compute
+ *
+ * Returns 0 on success, and <0 when an error has occurred.
+ *
+ * The entries at @depth + 1 must be computed first. Disjoint ranges of
+ * entries may be computed in parallel.
+ */
+int dm_bht_compute_entries(struct dm_bht* bht,
+                           int depth,
+                           unsigned int first,
+                           unsigned int count) {
+  struct dm_bht_level* level = dm_bht_get_level(bht, depth);
+  struct dm_bht_level* child_level = level + 1;
+  struct dm_bht_entry* entry = level->entries + first;
+  struct dm_bht_entry* child =
+      child_level->entries + (first << bht->node_count_shift);
+  unsigned int i, j;
+  int r;
+
+  for (i = first; i < first + count; i++, entry++) {
+    unsigned int node_count = bht->node_count;
+
+    memset(entry->nodes, 0, PAGE_SIZE);
+    entry->state = DM_BHT_ENTRY_READY;
+
+    if (i == (level->count - 1))
+      node_count = child_level->count % bht->node_count;
+    if (node_count == 0)
+      node_count = bht->node_count;
+    for (j = 0; j < node_count; j++, child++) {
+      uint8_t* digest = dm_bht_node(bht, entry, j);
+
+      r = dm_bht_compute_hash(bht, child->nodes, digest);
+      if (r) {
+        DLOG(ERROR) << "Failed to update (d=" << depth << ",i=" << i << ")";
+        return r;
+      }
+    }
+  }
+  return 0;
+}
+
+/**
+ * dm_bht_compute_root - computes the root digest from the top level
+ * @bht: pointer to a dm_bht_create()d bht
+ *
+ * Returns 0 on success, and <0 when an error has occurred.
+ */
+int dm_bht_compute_root(struct dm_bht* bht) {
+  int r =
+      dm_bht_compute_hash(bht, bht->levels[0].entries->nodes, bht->root_digest);
+  if (r)
+    DLOG(ERROR) << "Failed to update root hash";
+  return r;
+}
+
 /**
  * dm_bht_compute - computes and updates all non-block-level hashes in a tree
  * @bht: pointer to a dm_bht_create()d bht
@@ -605,42 +666,15 @@ void dm_bht_set_buffer(struct dm_bht* bht, void* buffer) {
  * hashes below.
  */
 int dm_bht_compute(struct dm_bht* bht) {
-  int depth, r = 0;
+  int depth, r;
 
   for (depth = bht->depth - 2; depth >= 0; depth--) {
-    struct dm_bht_level* level = dm_bht_get_level(bht, depth);
-    struct dm_bht_level* child_level = level + 1;
-    struct dm_bht_entry* entry = level->entries;
-    struct dm_bht_entry* child = child_level->entries;
-    unsigned int i, j;
-
-    for (i = 0; i < level->count; i++, entry++) {
-      unsigned int count = bht->node_count;
-
-      memset(entry->nodes, 0, PAGE_SIZE);
-      entry->state = DM_BHT_ENTRY_READY;
-
-      if (i == (level->count - 1))
-        count = child_level->count % bht->node_count;
-      if (count == 0)
-        count = bht->node_count;
-      for (j = 0; j < count; j++, child++) {
-        uint8_t* digest = dm_bht_node(bht, entry, j);
-
-        r = dm_bht_compute_hash(bht, child->nodes, digest);
-        if (r) {
-          DLOG(ERROR) << "Failed to update (d=" << depth << ",i=" << i << ")";
-          goto out;
-        }
-      }
-    }
+    r = dm_bht_compute_entries(bht, depth, 0,
+                               dm_bht_get_level(bht, depth)->count);
+    if (r)
+      return r;
   }
-  r = dm_bht_compute_hash(bht, bht->levels[0].entries->nodes, bht->root_digest);
-  if (r)
-    DLOG(ERROR) << "Failed to update root hash";
-
-out:
-  return r;
+  return dm_bht_compute_root(bht);
 }
 
 /**
@@ -177,6 +177,14 @@ int dm_bht_compute_hash(struct dm_bht* bht,
  */
 BRILLO_EXPORT
 int dm_bht_compute(struct dm_bht* bht);
+/* Building blocks of dm_bht_compute() to compute the levels in parallel. */
+BRILLO_EXPORT
+int dm_bht_compute_entries(struct dm_bht* bht,
+                           int depth,
+                           unsigned int first,
+                           unsigned int count);
+BRILLO_EXPORT
+int dm_bht_compute_root(struct dm_bht* bht);
 BRILLO_EXPORT
 void dm_bht_set_buffer(struct dm_bht* bht, void* buffer);
 BRILLO_EXPORT
@@ -237,6 +245,7 @@ class DmBhtInterface {
   virtual void SetBuffer(void* buffer) = 0;
   virtual sector_t Sectors() = 0;
   virtual unsigned int DigestSize() = 0;
+  // May be called concurrently for different blocks.
   virtual int StoreBlock(unsigned int block, uint8_t* block_data) = 0;
   virtual int Compute() = 0;
   virtual void HexDigest(uint8_t* hexdigest, int available) = 0;
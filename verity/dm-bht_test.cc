@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -62,6 +63,44 @@ TEST(DmBht, CreateZeroPopulateDestroy) {
   free(data);
 }
 
+TEST(DmBht, ComputeEntriesMatchesCompute) {
+  // Three levels, with a partial last entry at each level.
+  const unsigned int total_blocks = 128 * 128 * 2 + 5;
+  uint8_t* data = static_cast<uint8_t*>(my_memalign(PAGE_SIZE, PAGE_SIZE));
+  struct dm_bht bht, ranged_bht;
+  EXPECT_EQ(0, dm_bht_create(&bht, total_blocks, "sha256"));
+  EXPECT_EQ(0, dm_bht_create(&ranged_bht, total_blocks, "sha256"));
+  std::vector<uint8_t> hash_data(verity_to_bytes(dm_bht_sectors(&bht)));
+  std::vector<uint8_t> ranged_hash_data(hash_data.size());
+  dm_bht_set_buffer(&bht, hash_data.data());
+  dm_bht_set_buffer(&ranged_bht, ranged_hash_data.data());
+
+  for (unsigned int block = 0; block < total_blocks; ++block) {
+    memset(data, block & 0xff, PAGE_SIZE);
+    EXPECT_EQ(0, dm_bht_store_block(&bht, block, data));
+    EXPECT_EQ(0, dm_bht_store_block(&ranged_bht, block, data));
+  }
+  EXPECT_EQ(0, dm_bht_compute(&bht));
+
+  // Computes each level in ranges of 3 entries.
+  ASSERT_EQ(3, ranged_bht.depth);
+  for (int depth = ranged_bht.depth - 2; depth >= 0; --depth) {
+    const unsigned int count = dm_bht_get_level(&ranged_bht, depth)->count;
+    for (unsigned int first = 0; first < count; first += 3) {
+      EXPECT_EQ(0, dm_bht_compute_entries(&ranged_bht, depth, first,
+                                          std::min(3u, count - first)));
+    }
+  }
+  EXPECT_EQ(0, dm_bht_compute_root(&ranged_bht));
+
+  EXPECT_EQ(hash_data, ranged_hash_data);
+  EXPECT_EQ(0, memcmp(bht.root_digest, ranged_bht.root_digest,
+                      sizeof(bht.root_digest)));
+  EXPECT_EQ(0, dm_bht_destroy(&bht));
+  EXPECT_EQ(0, dm_bht_destroy(&ranged_bht));
+  free(data);
+}
+
 class MemoryBhtTest : public ::testing::Test {
  public:
   void SetUp() { bht_ = NULL; }
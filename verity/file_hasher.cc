@@ -14,17 +14,24 @@
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <base/bits.h>
 #include <base/check.h>
+#include <base/check_op.h>
 #include <base/files/file.h>
+#include <base/functional/bind.h>
+#include <base/functional/callback.h>
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
 #include <base/strings/string_util.h>
 
 #include "verity/file_hasher.h"
+#include "verity/range_hasher.h"
 
 namespace verity {
 
@@ -43,6 +50,50 @@ int64_t GetFileSize(base::File* file) {
   }
   return file->GetLength();
 }
+
+// Number of blocks read at once by a thread hashing blocks in parallel.
+constexpr uint32_t kBlocksPerRead = 256;
+
+// Minimum number of entries of a tree level computed by a thread, so that
+// small levels are not worth starting threads for.
+constexpr unsigned int kMinEntriesPerThread = 64;
+
+// Stores the hashes of |count| blocks from |first|, where block 0 is at
+// |offset| in |source|.
+bool HashBlocks(base::File* source,
+                int64_t offset,
+                struct dm_bht* tree,
+                uint32_t first,
+                uint32_t count) {
+  std::vector<char> buffer(kBlocksPerRead * PAGE_SIZE);
+  for (uint32_t block = first; block < first + count;) {
+    const uint32_t blocks = std::min(kBlocksPerRead, first + count - block);
+    const int size = blocks * PAGE_SIZE;
+    if (source->Read(offset + int64_t{block} * PAGE_SIZE, buffer.data(),
+                     size) != size) {
+      PLOG(ERROR) << "Failed to read from block: " << block;
+      return false;
+    }
+    for (uint32_t i = 0; i < blocks; ++i, ++block) {
+      if (dm_bht_store_block(
+              tree, block,
+              reinterpret_cast<uint8_t*>(&buffer[i * PAGE_SIZE]))) {
+        LOG(ERROR) << "Failed to store block " << block;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Computes |count| entries from |first| of the tree level at |depth|.
+bool HashEntries(struct dm_bht* tree,
+                 int depth,
+                 uint32_t first,
+                 uint32_t count) {
+  return !dm_bht_compute_entries(tree, depth, first, count);
+}
+
 }  // namespace
 
 FileHasher::~FileHasher() {
@@ -100,6 +151,9 @@ bool FileHasher::Store() {
 }
 
 bool FileHasher::Hash() {
+  if (num_threads_ > 1)
+    return HashInParallel();
+
   // TODO(wad) abstract size when dm-bht needs to do break from PAGE_SIZE
   uint8_t block_data[PAGE_SIZE];
   uint32_t block = 0;
@@ -119,6 +173,40 @@ bool FileHasher::Hash() {
   return !dm_bht_compute(&tree_);
 }
 
+bool FileHasher::HashInParallel() {
+  const int64_t offset = source_->Seek(base::File::FROM_CURRENT, 0);
+  if (offset < 0) {
+    PLOG(ERROR) << "Failed to get the position in the source";
+    return false;
+  }
+
+  // Each thread reads and hashes a contiguous range of blocks, so that reads
+  // stay sequential.
+  if (!HashInRanges(
+          block_limit_, num_threads_,
+          base::BindRepeating(&HashBlocks, source_.get(), offset, &tree_))) {
+    return false;
+  }
+
+  // The upper levels are computed from the bottom up, as each one depends on
+  // the one below.
+  for (int depth = tree_.depth - 2; depth >= 0; --depth) {
+    const unsigned int count = dm_bht_get_level(&tree_, depth)->count;
+    if (!HashInRanges(
+            count,
+            std::min<uint32_t>(num_threads_, count / kMinEntriesPerThread),
+            base::BindRepeating(&HashEntries, &tree_, depth))) {
+      return false;
+    }
+  }
+  return !dm_bht_compute_root(&tree_);
+}
+
+void FileHasher::set_num_threads(int num_threads) {
+  DCHECK_GE(num_threads, 1);
+  num_threads_ = num_threads;
+}
+
 void FileHasher::set_salt(const char* salt) {
   if (!strcmp(salt, "random"))
     salt = RandomSalt();
@@ -47,7 +47,16 @@ class BRILLO_EXPORT FileHasher {
   virtual void set_salt(const char* salt);
   virtual const char* salt(void) { return salt_; }
 
+  // Sets the number of threads used by Hash(). With more than one thread, the
+  // blocks are read from the current position of the source with pread() and
+  // each level of the tree is split among the threads. The tree is the same
+  // whatever the number of threads.
+  virtual void set_num_threads(int num_threads);
+
  private:
+  // Hashes the blocks and the tree levels on |num_threads_| threads.
+  bool HashInParallel();
+
   std::unique_ptr<base::File> source_;
   std::unique_ptr<base::File> destination_;
   uint64_t block_limit_;
@@ -58,6 +67,7 @@ class BRILLO_EXPORT FileHasher {
   struct dm_bht tree_;
   sector_t sectors_;
   bool initialized_;
+  int num_threads_ = 1;
 
   FileHasher(const FileHasher&) = delete;
   FileHasher& operator=(const FileHasher&) = delete;
@@ -0,0 +1,74 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by the GPL v2 license that can
+// be found in the LICENSE file.
+//
+// Benchmark of FileHasher::Hash() on a 256 MiB image with various numbers of
+// threads. The hashed bytes per second are reported as "bytes_per_second".
+
+#include <memory>
+#include <string>
+
+#include <base/check.h>
+#include <base/check_op.h>
+#include <base/files/file.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <benchmark/benchmark.h>
+
+#include "verity/file_hasher.h"
+
+namespace verity {
+
+namespace {
+
+constexpr int kImageBlocks = 64 * 1024;
+
+// Creates the image once, so that it is in the page cache for all the runs.
+const base::FilePath& GetImagePath() {
+  static base::ScopedTempDir* temp_dir = [] {
+    auto* dir = new base::ScopedTempDir();
+    CHECK(dir->CreateUniqueTempDir());
+    base::File image(dir->GetPath().Append("image.bin"),
+                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    CHECK(image.IsValid());
+    std::string block(PAGE_SIZE, '\0');
+    for (int i = 0; i < kImageBlocks; ++i) {
+      block[0] = static_cast<char>(i);
+      CHECK_EQ(image.WriteAtCurrentPos(block.data(), block.size()),
+               static_cast<int>(block.size()));
+    }
+    return dir;
+  }();
+  static const base::FilePath path = temp_dir->GetPath().Append("image.bin");
+  return path;
+}
+
+}  // namespace
+
+static void BM_Hash(benchmark::State& state) {
+  const base::FilePath& image_path = GetImagePath();
+  for (auto _ : state) {
+    FileHasher hasher(
+        std::make_unique<base::File>(
+            image_path, base::File::FLAG_OPEN | base::File::FLAG_READ),
+        std::make_unique<base::File>(base::FilePath("/dev/null"),
+                                     base::File::FLAG_OPEN |
+                                         base::File::FLAG_WRITE),
+        0, kSha256HashName);
+    CHECK(hasher.Initialize());
+    hasher.set_num_threads(state.range(0));
+    CHECK(hasher.Hash());
+  }
+  state.SetBytesProcessed(state.iterations() * kImageBlocks * PAGE_SIZE);
+}
+BENCHMARK(BM_Hash)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace verity
+
+BENCHMARK_MAIN();
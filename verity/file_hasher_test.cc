@@ -4,10 +4,13 @@
 //
 // Tests for verity::FileHasher
 
+#include <memory>
+#include <string>
 #include <utility>
 
 #include <base/files/file_util.h>
 #include <base/files/scoped_temp_dir.h>
+#include <base/strings/string_number_conversions.h>
 #include <gtest/gtest.h>
 
 #include "verity/file_hasher.h"
@@ -63,6 +66,54 @@ TEST_F(FileHasherTest, EndToEnd) {
             "23456789abcdef0123456789abcdef0123456789");
 }
 
+TEST_F(FileHasherTest, EndToEndMultipleThreads) {
+  verity::FileHasher hasher(std::move(small_file_), std::move(target_file_), 0,
+                            kSha256HashName);
+  EXPECT_TRUE(hasher.Initialize());
+  hasher.set_salt(reinterpret_cast<const char*>(kSalt));
+  hasher.set_num_threads(4);
+  EXPECT_TRUE(hasher.Hash());
+  EXPECT_TRUE(hasher.Store());
+
+  EXPECT_EQ(hasher.GetTable(true),
+            "0 16 verity payload=ROOT_DEV hashtree=HASH_DEV hashstart=16 "
+            "alg=sha256 root_hexdigest=21f0268f4a293d8110074c678a651c638d"
+            "56a610dd2662975a35d451d3258018 salt=abcdef0123456789abcdef01"
+            "23456789abcdef0123456789abcdef0123456789");
+}
+
+TEST_F(FileHasherTest, MultipleThreadsSameTree) {
+  // Enough blocks for several reads per thread and a partial last entry.
+  constexpr int kBlocks = 128 * 7 + 3;
+  std::string image;
+  for (int i = 0; i < kBlocks; ++i)
+    image.append(PAGE_SIZE, static_cast<char>(i));
+  const base::FilePath image_path = temp_dir_.GetPath().Append("image.bin");
+  ASSERT_TRUE(base::WriteFile(image_path, image));
+
+  std::string tables[2];
+  std::string trees[2];
+  for (int i = 0; i < 2; ++i) {
+    const base::FilePath tree_path =
+        temp_dir_.GetPath().Append("tree" + base::NumberToString(i));
+    verity::FileHasher hasher(
+        std::make_unique<base::File>(
+            image_path, base::File::FLAG_OPEN | base::File::FLAG_READ),
+        std::make_unique<base::File>(
+            tree_path, base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE),
+        0, kSha256HashName);
+    ASSERT_TRUE(hasher.Initialize());
+    hasher.set_salt(reinterpret_cast<const char*>(kSalt));
+    hasher.set_num_threads(i == 0 ? 1 : 3);
+    EXPECT_TRUE(hasher.Hash());
+    EXPECT_TRUE(hasher.Store());
+    tables[i] = hasher.GetTable(true);
+    ASSERT_TRUE(base::ReadFileToString(tree_path, &trees[i]));
+  }
+  EXPECT_EQ(tables[0], tables[1]);
+  EXPECT_EQ(trees[0], trees[1]);
+}
+
 TEST_F(FileHasherTest, BadSourceFile) {
   verity::FileHasher hasher(nullptr, std::move(target_file_), 0,
                             kSha256HashName);
@@ -0,0 +1,63 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by the GPL v2 license that can
+// be found in the LICENSE file.
+
+#include "verity/range_hasher.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <base/threading/simple_thread.h>
+
+namespace verity {
+
+namespace {
+
+// Runs a RangeHasher on a range of items on a thread of the pool.
+class HashTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  HashTask(RangeHasher hasher, uint32_t first, uint32_t count)
+      : hasher_(std::move(hasher)), first_(first), count_(count) {}
+  HashTask(const HashTask&) = delete;
+  HashTask& operator=(const HashTask&) = delete;
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override { success_ = hasher_.Run(first_, count_); }
+
+  bool success() const { return success_; }
+
+ private:
+  RangeHasher hasher_;
+  const uint32_t first_;
+  const uint32_t count_;
+  bool success_ = false;
+};
+
+}  // namespace
+
+bool HashInRanges(uint32_t count, uint32_t max_tasks, RangeHasher hasher) {
+  const uint32_t num_tasks = std::max(1u, std::min(max_tasks, count));
+  const uint32_t items_per_task = (count + num_tasks - 1) / num_tasks;
+  std::vector<std::unique_ptr<HashTask>> tasks;
+  for (uint32_t first = 0; first < count; first += items_per_task) {
+    tasks.push_back(std::make_unique<HashTask>(
+        hasher, first, std::min(items_per_task, count - first)));
+  }
+
+  if (tasks.size() <= 1) {
+    for (auto& task : tasks)
+      task->Run();
+  } else {
+    base::DelegateSimpleThreadPool pool("verity_hasher", tasks.size());
+    for (auto& task : tasks)
+      pool.AddWork(task.get());
+    pool.Start();
+    pool.JoinAll();
+  }
+  return std::all_of(tasks.begin(), tasks.end(),
+                     [](const auto& task) { return task->success(); });
+}
+
+}  // namespace verity
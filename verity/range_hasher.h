@@ -0,0 +1,29 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by the GPL v2 license that can
+// be found in the LICENSE file.
+//
+// Helper splitting the hashing of blocks or tree entries across threads.
+#ifndef VERITY_RANGE_HASHER_H_
+#define VERITY_RANGE_HASHER_H_
+
+#include <stdint.h>
+
+#include <base/functional/callback.h>
+#include <brillo/brillo_export.h>
+
+namespace verity {
+
+// Hashes |count| items, i.e. blocks or tree entries, from |first|. Returns
+// false on failure. It is run concurrently on disjoint ranges.
+using RangeHasher =
+    base::RepeatingCallback<bool(uint32_t first, uint32_t count)>;
+
+// Splits |count| items into up to |max_tasks| contiguous ranges hashed by
+// |hasher| on a thread pool. Returns false if a range failed.
+BRILLO_EXPORT bool HashInRanges(uint32_t count,
+                                uint32_t max_tasks,
+                                RangeHasher hasher);
+
+}  // namespace verity
+
+#endif  // VERITY_RANGE_HASHER_H_
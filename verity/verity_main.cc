@@ -33,6 +33,7 @@ void print_usage(const char* name) {
       "  hashtree          Path to a hash tree to create or read from\n"
       "  root_hexdigest    Digest of the root node (in hex) for verification\n"
       "  salt              Salt (in hex)\n"
+      "  num_threads       Number of threads hashing the image (default: 1)\n"
       "\n",
       name);
 }
@@ -43,7 +44,8 @@ int verity_create(const std::string& alg,
                   const std::string& image_path,
                   unsigned int image_blocks,
                   const std::string& hash_path,
-                  const std::string& salt) {
+                  const std::string& salt,
+                  int num_threads) {
   auto source = std::make_unique<base::File>(
       base::FilePath(image_path),
       base::File::FLAG_OPEN | base::File::FLAG_READ);
@@ -61,6 +63,7 @@ int verity_create(const std::string& alg,
   LOG_IF(FATAL, !hasher.Initialize()) << "Failed to initialize hasher";
   if (!salt.empty())
     hasher.set_salt(salt.c_str());
+  hasher.set_num_threads(num_threads);
   LOG_IF(FATAL, !hasher.Hash()) << "Failed to hash hasher";
   LOG_IF(FATAL, !hasher.Store()) << "Failed to store hasher";
   hasher.PrintTable(true);
@@ -72,6 +75,7 @@ int main(int argc, char** argv) {
   verity_mode_t mode = VERITY_CREATE;
   std::string alg, payload, hashtree, salt;
   unsigned int payload_blocks = 0;
+  int num_threads = 1;
 
   // TODO(b/269707854): Use flag arguments + update callers to verity tool.
   for (int i = 1; i < argc; i++) {
@@ -100,6 +104,8 @@ int main(int argc, char** argv) {
       // Silently drop the mode for now...
     } else if (key == "salt") {
       salt = val;
+    } else if (key == "num_threads") {
+      CHECK(base::StringToInt(val, &num_threads) && num_threads >= 1);
     } else {
       fprintf(stderr, "bogus key: '%s'\n", key.c_str());
       print_usage(argv[0]);
@@ -116,7 +122,8 @@ int main(int argc, char** argv) {
   }
 
   if (mode == VERITY_CREATE) {
-    return verity_create(alg, payload, payload_blocks, hashtree, salt);
+    return verity_create(alg, payload, payload_blocks, hashtree, salt,
+                         num_threads);
   } else {
     LOG(FATAL) << "Verification not done yet";
   }
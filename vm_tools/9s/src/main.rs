@@ -10,7 +10,7 @@ use libc::gid_t;
 use std::ffi::CString;
 use std::fmt;
 use std::fs::{remove_file, File};
-use std::io::{self, BufReader, BufWriter};
+use std::io;
 use std::net;
 use std::num::ParseIntError;
 use std::os::raw::c_uint;
@@ -33,7 +33,9 @@ use log::warn;
 use vsock::VsockListener;
 use vsock::VMADDR_CID_ANY;
 
-const DEFAULT_BUFFER_SIZE: usize = 8192;
+mod pipeline;
+
+use pipeline::ClientStream;
 
 // Address family identifiers.
 const VSOCK: &str = "vsock:";
@@ -177,34 +179,23 @@ struct ServerParams {
     gid_map: p9::ServerGidMap,
 }
 
-fn handle_client<R: io::Read, W: io::Write>(
-    server_params: Arc<ServerParams>,
-    mut reader: R,
-    mut writer: W,
-) -> io::Result<()> {
+fn handle_client<S: ClientStream>(server_params: Arc<ServerParams>, stream: S) -> io::Result<()> {
     let params: ServerParams = (*server_params).clone();
     let mut server = p9::Server::new(PathBuf::from(&params.root), params.uid_map, params.gid_map)?;
 
-    loop {
-        server.handle_message(&mut reader, &mut writer)?;
-    }
+    pipeline::serve(stream, |reader, writer| {
+        server.handle_message(reader, writer)
+    })
 }
 
-fn spawn_server_thread<
-    R: 'static + io::Read + Send,
-    W: 'static + io::Write + Send,
-    D: 'static + fmt::Display + Send,
->(
+fn spawn_server_thread<S: ClientStream, D: 'static + fmt::Display + Send>(
     server_params: &Arc<ServerParams>,
-    reader: R,
-    writer: W,
+    stream: S,
     peer: D,
 ) {
-    let reader = BufReader::with_capacity(DEFAULT_BUFFER_SIZE, reader);
-    let writer = BufWriter::with_capacity(DEFAULT_BUFFER_SIZE, writer);
     let params = server_params.clone();
     thread::spawn(move || {
-        if let Err(e) = handle_client(params, reader, writer) {
+        if let Err(e) = handle_client(params, stream) {
             error!("error while handling client {}: {}", peer, e);
         }
     });
@@ -226,7 +217,7 @@ fn run_vsock_server(
         }
 
         info!("accepted connection from {}", peer);
-        spawn_server_thread(&server_params, stream.try_clone()?, stream, peer);
+        spawn_server_thread(&server_params, stream, peer);
     }
 }
 
@@ -258,7 +249,7 @@ fn run_unix_server(server_params: Arc<ServerParams>, listener: UnixListener) ->
         let peer = UnixSocketAddr(peer);
 
         info!("accepted connection from {}", peer);
-        spawn_server_thread(&server_params, stream.try_clone()?, stream, peer);
+        spawn_server_thread(&server_params, stream, peer);
     }
 }
 
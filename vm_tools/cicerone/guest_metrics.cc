@@ -96,6 +96,13 @@ constexpr char kCrostiniDiskBytesWritten[] =
     "Crostini.Disk.StatefulWritesDaily";
 constexpr char kCrostiniDiskBytesWrittenGuest[] = "crostini-disk-kb-written";
 
+constexpr char kCrostiniContainerLxdStartTime[] =
+    "Crostini.ContainerStartup.LxdStartTime";
+constexpr char kCrostiniContainerGarconStartTime[] =
+    "Crostini.ContainerStartup.GarconStartTime";
+constexpr char kCrostiniContainerStartTime[] =
+    "Crostini.ContainerStartup.TotalTime";
+
 // Helper function that maps an fsck result to it's respective enum.
 BorealisFsckResult MapFsckResultToEnum(int fsck_result) {
   // See exit codes for fsck from: https://linux.die.net/man/8/fsck.
@@ -317,6 +324,19 @@ bool GuestMetrics::HandleMetric(const std::string& owner_id,
   return true;
 }
 
+void GuestMetrics::ReportContainerStartup(base::TimeDelta lxd_start_time,
+                                          base::TimeDelta garcon_start_time) {
+  // Startups taking longer than a few minutes are lumped together.
+  metrics_lib_->SendTimeToUMA(kCrostiniContainerLxdStartTime, lxd_start_time,
+                              base::Milliseconds(1), base::Minutes(5), 50);
+  metrics_lib_->SendTimeToUMA(kCrostiniContainerGarconStartTime,
+                              garcon_start_time, base::Milliseconds(1),
+                              base::Minutes(5), 50);
+  metrics_lib_->SendTimeToUMA(kCrostiniContainerStartTime,
+                              lxd_start_time + garcon_start_time,
+                              base::Milliseconds(1), base::Minutes(10), 50);
+}
+
 void GuestMetrics::UpdateDailyMetrics(chromeos_metrics::CumulativeMetrics* cm) {
   // This is a no-op; currently all metric data is accumulated in HandleMetric.
 }
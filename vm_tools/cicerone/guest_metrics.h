@@ -73,6 +73,12 @@ class GuestMetrics {
                             const std::string& name,
                             int value);
 
+  // Called by Service class once garcon reports in after a container startup,
+  // with the time LXD took to start the container and the time garcon took to
+  // report in after that.
+  virtual void ReportContainerStartup(base::TimeDelta lxd_start_time,
+                                      base::TimeDelta garcon_start_time);
+
   // Called by |daily_metrics_| regularly to gather metrics to be reported
   // daily.
   void UpdateDailyMetrics(chromeos_metrics::CumulativeMetrics* cm);
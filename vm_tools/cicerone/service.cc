@@ -652,15 +652,23 @@ void Service::LxdContainerStarting(const uint32_t cid,
   switch (status) {
     case Service::StartStatus::STARTED:
       proto.set_status(LxdContainerStartingSignal::STARTED);
+      vm->UpdateLxdContainerState(container_name,
+                                  VirtualMachine::LxdContainerState::STARTED);
       break;
     case Service::StartStatus::CANCELLED:
       proto.set_status(LxdContainerStartingSignal::CANCELLED);
+      vm->UpdateLxdContainerState(container_name,
+                                  VirtualMachine::LxdContainerState::STOPPED);
       break;
     case Service::StartStatus::FAILED:
       proto.set_status(LxdContainerStartingSignal::FAILED);
+      vm->UpdateLxdContainerState(container_name,
+                                  VirtualMachine::LxdContainerState::FAILED);
       break;
     case Service::StartStatus::STARTING:
       proto.set_status(LxdContainerStartingSignal::STARTING);
+      vm->UpdateLxdContainerState(container_name,
+                                  VirtualMachine::LxdContainerState::STARTING);
       break;
     default:
       proto.set_status(LxdContainerStartingSignal::UNKNOWN);
@@ -706,6 +714,8 @@ void Service::LxdContainerStopping(const uint32_t cid,
   switch (status) {
     case Service::StopStatus::STOPPED:
       proto.set_status(LxdContainerStoppingSignal::STOPPED);
+      vm->UpdateLxdContainerState(container_name,
+                                  VirtualMachine::LxdContainerState::STOPPED);
       break;
     case Service::StopStatus::STOPPING:
       proto.set_status(LxdContainerStoppingSignal::STOPPING);
@@ -747,6 +757,7 @@ void Service::ContainerStartupCompleted(const std::string& container_token,
   }
 
   Container* container = vm->GetPendingContainerForToken(container_token);
+  bool garcon_restarted = false;
   if (!container) {
     // This could be a garcon restart.
     container = vm->GetContainerForToken(container_token);
@@ -755,9 +766,16 @@ void Service::ContainerStartupCompleted(const std::string& container_token,
       event->Signal();
       return;
     }
+    garcon_restarted = true;
   }
   std::string string_ip;
-  if (!vm->IsContainerless()) {
+  if (garcon_restarted &&
+      vm->GetLxdContainerState(container->name()) ==
+          VirtualMachine::LxdContainerState::RUNNING &&
+      !container->ipv4_address().IsZero()) {
+    // The container kept running, and so its address.
+    string_ip = container->ipv4_address().ToString();
+  } else if (!vm->IsContainerless()) {
     VirtualMachine::LxdContainerInfo info;
     std::string error;
     VirtualMachine::GetLxdContainerInfoStatus status =
@@ -784,6 +802,13 @@ void Service::ContainerStartupCompleted(const std::string& container_token,
   LOG(INFO) << "Startup of container " << container_name << " at IP "
             << string_ip << " for VM " << vm_name << " completed.";
 
+  std::optional<VirtualMachine::LxdContainerStartupPhases> phases =
+      vm->TakeLxdContainerStartupPhases(container_name);
+  if (phases && guest_metrics_) {
+    guest_metrics_->ReportContainerStartup(phases->lxd_start,
+                                           phases->garcon_start);
+  }
+
   std::string username;
   std::string homedir;
   if (owner_id == primary_owner_id_ && string_ip != "0.0.0.0") {
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include <base/check.h>
@@ -177,6 +178,7 @@ bool VirtualMachine::RegisterContainer(const std::string& container_token,
   }
 
   iter->second->ConnectToGarcon(garcon_addr);
+  UpdateLxdContainerState(iter->second->name(), LxdContainerState::RUNNING);
 
   return true;
 }
@@ -186,6 +188,7 @@ bool VirtualMachine::UnregisterContainer(const std::string& container_token) {
   if (iter == containers_.end()) {
     return false;
   }
+  UpdateLxdContainerState(iter->second->name(), LxdContainerState::STOPPED);
   containers_.erase(iter);
   return true;
 }
@@ -378,6 +381,14 @@ VirtualMachine::StartLxdContainerStatus VirtualMachine::StartLxdContainer(
     return VirtualMachine::StartLxdContainerStatus::FAILED;
   }
 
+  // Always ask tremplin: the container or its garcon may have died since
+  // garcon reported in, which the cached state doesn't know about.
+  LxdContainerState state = GetLxdContainerState(container_name);
+  if (state != LxdContainerState::STARTING &&
+      state != LxdContainerState::STARTED) {
+    UpdateLxdContainerState(container_name, LxdContainerState::STARTING);
+  }
+
   vm_tools::tremplin::StartContainerRequest request;
   vm_tools::tremplin::StartContainerResponse response;
 
@@ -394,6 +405,7 @@ VirtualMachine::StartLxdContainerStatus VirtualMachine::StartLxdContainer(
   if (!status.ok()) {
     LOG(ERROR) << "StartContainer RPC failed: " << status.error_message();
     out_error->assign(status.error_message());
+    UpdateLxdContainerState(container_name, LxdContainerState::FAILED);
     return VirtualMachine::StartLxdContainerStatus::FAILED;
   }
 
@@ -417,21 +429,84 @@ VirtualMachine::StartLxdContainerStatus VirtualMachine::StartLxdContainer(
     case tremplin::StartContainerResponse::STARTING:
       return VirtualMachine::StartLxdContainerStatus::STARTING;
     case tremplin::StartContainerResponse::STARTED:
+      UpdateLxdContainerState(container_name, LxdContainerState::STARTED);
       return VirtualMachine::StartLxdContainerStatus::STARTED;
     case tremplin::StartContainerResponse::REMAPPING:
       return VirtualMachine::StartLxdContainerStatus::REMAPPING;
     case tremplin::StartContainerResponse::RUNNING:
+      // The container was already running, so this is not a startup to
+      // report. Garcon may not have reported in yet.
+      if (state != LxdContainerState::RUNNING) {
+        lxd_container_states_[container_name] = {LxdContainerState::STARTED};
+      }
       return VirtualMachine::StartLxdContainerStatus::RUNNING;
     case tremplin::StartContainerResponse::FAILED:
       LOG(ERROR) << "Failed to start LXD container: "
                  << response.failure_reason();
       out_error->assign(response.failure_reason());
+      UpdateLxdContainerState(container_name, LxdContainerState::FAILED);
       return VirtualMachine::StartLxdContainerStatus::FAILED;
     default:
       return VirtualMachine::StartLxdContainerStatus::UNKNOWN;
   }
 }
 
+void VirtualMachine::UpdateLxdContainerState(
+    const std::string& container_name, LxdContainerState state) {
+  LxdContainerStateEntry& entry = lxd_container_states_[container_name];
+  const base::TimeTicks now = base::TimeTicks::Now();
+  switch (state) {
+    case LxdContainerState::STARTING:
+      // Tremplin sends STARTING as a heartbeat during a startup.
+      if (entry.state != LxdContainerState::STARTING) {
+        entry.start_requested = now;
+        entry.lxd_started = base::TimeTicks();
+      }
+      break;
+    case LxdContainerState::STARTED:
+      if (entry.state != LxdContainerState::STARTED)
+        entry.lxd_started = now;
+      break;
+    case LxdContainerState::RUNNING:
+      break;
+    case LxdContainerState::UNKNOWN:
+    case LxdContainerState::STOPPED:
+    case LxdContainerState::FAILED:
+      entry.start_requested = base::TimeTicks();
+      entry.lxd_started = base::TimeTicks();
+      break;
+  }
+  entry.state = state;
+}
+
+VirtualMachine::LxdContainerState VirtualMachine::GetLxdContainerState(
+    const std::string& container_name) const {
+  auto iter = lxd_container_states_.find(container_name);
+  if (iter == lxd_container_states_.end()) {
+    return LxdContainerState::UNKNOWN;
+  }
+  return iter->second.state;
+}
+
+std::optional<VirtualMachine::LxdContainerStartupPhases>
+VirtualMachine::TakeLxdContainerStartupPhases(
+    const std::string& container_name) {
+  auto iter = lxd_container_states_.find(container_name);
+  if (iter == lxd_container_states_.end() ||
+      iter->second.state != LxdContainerState::RUNNING ||
+      iter->second.start_requested.is_null() ||
+      iter->second.lxd_started.is_null()) {
+    return std::nullopt;
+  }
+  LxdContainerStateEntry& entry = iter->second;
+  LxdContainerStartupPhases phases = {
+      entry.lxd_started - entry.start_requested,
+      base::TimeTicks::Now() - entry.lxd_started};
+  entry.start_requested = base::TimeTicks();
+  entry.lxd_started = base::TimeTicks();
+  return phases;
+}
+
 VirtualMachine::StopLxdContainerStatus VirtualMachine::StopLxdContainer(
     const std::string& container_name, std::string* out_error) {
   DCHECK(out_error);
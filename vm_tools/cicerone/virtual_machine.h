@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include <base/time/time.h>
 #include <vm_applications/apps.pb.h>
 #include <vm_cicerone/cicerone_service.pb.h>
 #include <vm_protos/proto_bindings/container_guest.grpc.pb.h>
@@ -156,6 +157,27 @@ class VirtualMachine {
     FAILED,
   };
 
+  // State of an LXD container, as last reported by tremplin and garcon.
+  enum class LxdContainerState {
+    UNKNOWN,
+    // Tremplin is starting the container.
+    STARTING,
+    // LXD started the container, and garcon has yet to report in.
+    STARTED,
+    // Garcon reported in.
+    RUNNING,
+    STOPPED,
+    FAILED,
+  };
+
+  // Durations of the phases of a container startup.
+  struct LxdContainerStartupPhases {
+    // From the start request to LXD starting the container.
+    base::TimeDelta lxd_start;
+    // From LXD starting the container to garcon reporting in.
+    base::TimeDelta garcon_start;
+  };
+
   // Info about the LXD container.
   struct LxdContainerInfo {
     // The IPv4 address of the container.
@@ -301,6 +323,21 @@ class VirtualMachine {
       bool disable_audio_capture,
       std::string* out_error);
 
+  // Updates the cached state of |container_name|, from the events of tremplin
+  // and garcon.
+  void UpdateLxdContainerState(const std::string& container_name,
+                               LxdContainerState state);
+
+  // Returns the cached state of |container_name|.
+  LxdContainerState GetLxdContainerState(
+      const std::string& container_name) const;
+
+  // Returns the durations of the phases of the last startup of
+  // |container_name| once it is running, and forgets them so that each
+  // startup is only reported once.
+  std::optional<LxdContainerStartupPhases> TakeLxdContainerStartupPhases(
+      const std::string& container_name);
+
   // Stop an LXD container.
   StopLxdContainerStatus StopLxdContainer(const std::string& container_name,
                                           std::string* out_error);
@@ -409,6 +446,20 @@ class VirtualMachine {
   // and we don't want to invalidate an in-use token.
   std::map<std::string, std::unique_ptr<Container>> pending_containers_;
 
+  struct LxdContainerStateEntry {
+    LxdContainerState state = LxdContainerState::UNKNOWN;
+    // When the current startup was requested, and when LXD started the
+    // container.
+    base::TimeTicks start_requested;
+    base::TimeTicks lxd_started;
+  };
+
+  // Mapping of container name to its cached state. This is kept up to date by
+  // the events of tremplin and garcon, and used to time the startups and to
+  // recognize garcon restarts. It is not authoritative: a container or its
+  // garcon can die without an event.
+  std::map<std::string, LxdContainerStateEntry> lxd_container_states_;
+
   // Mapping of container name to OsRelease proto as reported by tremplin.
   // This data can change during a session if a user upgrades their container.
   std::map<std::string, OsRelease> container_os_releases_;
@@ -130,6 +130,56 @@ TEST_F(VirtualMachineTest, VerifyVmTypes) {
   EXPECT_EQ(plugin_vm_.GetType(), VirtualMachine::VmType::PLUGIN_VM);
 }
 
+TEST_F(VirtualMachineTest, LxdContainerStateFollowsEvents) {
+  using LxdContainerState = VirtualMachine::LxdContainerState;
+  EXPECT_EQ(LxdContainerState::UNKNOWN,
+            termina_vm_.GetLxdContainerState(kFakeContainerName1));
+
+  termina_vm_.UpdateLxdContainerState(kFakeContainerName1,
+                                      LxdContainerState::STARTING);
+  // Heartbeats keep the startup going.
+  termina_vm_.UpdateLxdContainerState(kFakeContainerName1,
+                                      LxdContainerState::STARTING);
+  termina_vm_.UpdateLxdContainerState(kFakeContainerName1,
+                                      LxdContainerState::STARTED);
+  EXPECT_FALSE(
+      termina_vm_.TakeLxdContainerStartupPhases(kFakeContainerName1));
+
+  std::string token = termina_vm_.GenerateContainerToken(kFakeContainerName1);
+  EXPECT_TRUE(termina_vm_.RegisterContainer(token, kFakeGarconPort1, kFakeIp1));
+  EXPECT_EQ(LxdContainerState::RUNNING,
+            termina_vm_.GetLxdContainerState(kFakeContainerName1));
+  EXPECT_EQ(LxdContainerState::UNKNOWN,
+            termina_vm_.GetLxdContainerState(kFakeContainerName2));
+  auto phases = termina_vm_.TakeLxdContainerStartupPhases(kFakeContainerName1);
+  ASSERT_TRUE(phases);
+  EXPECT_GE(phases->lxd_start, base::TimeDelta());
+  EXPECT_GE(phases->garcon_start, base::TimeDelta());
+
+  // A garcon restart is not a startup.
+  EXPECT_TRUE(termina_vm_.RegisterContainer(token, kFakeGarconPort1, kFakeIp1));
+  EXPECT_FALSE(
+      termina_vm_.TakeLxdContainerStartupPhases(kFakeContainerName1));
+
+  EXPECT_TRUE(termina_vm_.UnregisterContainer(token));
+  EXPECT_EQ(LxdContainerState::STOPPED,
+            termina_vm_.GetLxdContainerState(kFakeContainerName1));
+}
+
+TEST_F(VirtualMachineTest, FailedStartupIsNotReported) {
+  using LxdContainerState = VirtualMachine::LxdContainerState;
+  termina_vm_.UpdateLxdContainerState(kFakeContainerName1,
+                                      LxdContainerState::STARTING);
+  termina_vm_.UpdateLxdContainerState(kFakeContainerName1,
+                                      LxdContainerState::FAILED);
+
+  // Garcon reporting in without LXD starting the container again.
+  std::string token = termina_vm_.GenerateContainerToken(kFakeContainerName1);
+  EXPECT_TRUE(termina_vm_.RegisterContainer(token, kFakeGarconPort1, kFakeIp1));
+  EXPECT_FALSE(
+      termina_vm_.TakeLxdContainerStartupPhases(kFakeContainerName1));
+}
+
 class UpgradeContainerTest : public VirtualMachineTest {
  public:
   void SetUp() override {
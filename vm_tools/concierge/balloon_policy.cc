@@ -7,7 +7,9 @@
 #include <inttypes.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <optional>
+#include <utility>
 
 #include <base/check.h>
 #include <base/files/file_util.h>
@@ -379,6 +381,163 @@ int64_t LimitCacheBalloonPolicy::MaxFree() {
   return guest_zoneinfo_.totalreserve + MAX_OOM_MIN_FREE;
 }
 
+WorkingSetBalloonPolicy::WorkingSetBalloonPolicy(
+    const MemoryMargins& margins,
+    const Params& params,
+    WorkingSetCallback get_working_set,
+    const std::string& vm)
+    : margins_(margins),
+      params_(params),
+      get_working_set_(std::move(get_working_set)) {
+  DCHECK_LT(params.deflate_psi_threshold, params.inflate_psi_threshold);
+  DCHECK_LE(params.min_step, params.max_step);
+  LOG(INFO) << "BalloonInit: { "
+            << "\"type\": \"WorkingSetBalloonPolicy\","
+            << "\"vm\": \"" << vm << "\","
+            << "\"moderate_margin\": " << margins.moderate << ","
+            << "\"critical_margin\": " << margins.critical << ","
+            << "\"inflate_psi_threshold\": " << params.inflate_psi_threshold
+            << ","
+            << "\"deflate_psi_threshold\": " << params.deflate_psi_threshold
+            << ","
+            << "\"working_set_bins\": " << params.working_set_bins << ","
+            << "\"guest_free_headroom\": " << params.guest_free_headroom
+            << ","
+            << "\"min_step\": " << params.min_step << ","
+            << "\"max_step\": " << params.max_step << " }";
+  LOG(INFO) << "BalloonTrace Format [vm_name, balloon_size_MIB, "
+            << "balloon_delta_MIB, host_psi, host_under_pressure, "
+            << "chromeos_available_MIB, guest_free_MIB, "
+            << "guest_working_set_MIB, guest_cold_cache_MIB]";
+}
+
+int64_t WorkingSetBalloonPolicy::ComputeBalloonDelta(
+    const BalloonStats& stats,
+    uint64_t host_available,
+    bool game_mode,
+    const std::string& vm,
+    int64_t total_available_memory,
+    ComponentMemoryMargins component_margins) {
+  const std::optional<double> host_psi = HostMemoryPressure(false);
+  if (!host_psi) {
+    return 0;
+  }
+  // Without a working set the cold memory of the guest is unknown.
+  const std::optional<BalloonWorkingSet> working_set = get_working_set_.Run();
+  if (!working_set) {
+    return 0;
+  }
+  return ComputeBalloonDeltaImpl(*host_psi, *working_set, stats,
+                                 host_available, vm);
+}
+
+int64_t WorkingSetBalloonPolicy::ComputeBalloonDeltaImpl(
+    double host_psi,
+    const BalloonWorkingSet& working_set,
+    const BalloonStats& stats,
+    int64_t host_available,
+    const std::string& vm) {
+  // Start reclaiming from the guests once the host stalls on memory or is
+  // about to discard tabs, and keep at it until both are resolved.
+  const int64_t critical_margin = margins_.critical;
+  const int64_t moderate_margin = margins_.moderate;
+  if (host_psi >= params_.inflate_psi_threshold ||
+      host_available < critical_margin) {
+    host_under_pressure_ = true;
+  } else if (host_psi < params_.deflate_psi_threshold &&
+             host_available >= moderate_margin) {
+    host_under_pressure_ = false;
+  }
+
+  const int64_t guest_free = stats.stats_ffi.free_memory;
+  const int64_t guest_unreclaimable =
+      stats.stats_ffi.shared_memory + stats.stats_ffi.unevictable_memory;
+  const int64_t guest_cache =
+      std::max(stats.stats_ffi.disk_caches - guest_unreclaimable,
+               static_cast<int64_t>(0));
+  // The page cache which is not part of the working set can be dropped
+  // without the guest refaulting it soon.
+  const int64_t working_set_file = static_cast<int64_t>(
+      working_set.YoungFileMemory(params_.working_set_bins));
+  const int64_t cold_cache =
+      std::max(guest_cache - working_set_file, static_cast<int64_t>(0));
+  const int64_t excess_free = guest_free - params_.guest_free_headroom;
+
+  int64_t delta = 0;
+  if (host_under_pressure_) {
+    delta = std::max(excess_free, static_cast<int64_t>(0)) + cold_cache;
+  } else if (excess_free < 0) {
+    // Only give back what the guest is short of, the rest of the balloon
+    // stays with the host until the guest needs it.
+    delta = -std::min(-excess_free, static_cast<int64_t>(stats.balloon_actual));
+  }
+
+  // Reduce how often we change the balloon size, since every change costs the
+  // guest VM exits.
+  if (std::abs(delta) < params_.min_step) {
+    return 0;
+  }
+  delta = std::clamp(delta, -params_.max_step, params_.max_step);
+
+  LOG(INFO) << "BalloonTrace[" << vm
+            << ","
+            // Balloon size.
+            << (stats.balloon_actual / MiB(1))
+            << ","
+            // The amount we are changing the balloon.
+            << (delta / MiB(1)) << "," << host_psi << ","
+            << host_under_pressure_
+            << ","
+            // ChromeOS Available.
+            << (host_available / MiB(1)) << "," << (guest_free / MiB(1))
+            << ","
+            // Memory in the youngest generations of the guest.
+            << (working_set.YoungMemory(params_.working_set_bins) / MiB(1))
+            << "," << (cold_cache / MiB(1)) << "]";
+
+  return delta;
+}
+
+std::optional<double> HostMemoryPressure(bool log_on_error) {
+  static constexpr char kProcPressureMemory[] = "/proc/pressure/memory";
+  const base::FilePath pressure_path(kProcPressureMemory);
+  std::string pressure;
+  if (!base::ReadFileToString(pressure_path, &pressure)) {
+    if (log_on_error) {
+      LOG(ERROR) << "Failed to read /proc/pressure/memory";
+    }
+    return std::nullopt;
+  }
+  return ParseMemoryPressure(pressure);
+}
+
+std::optional<double> ParseMemoryPressure(const std::string& pressure) {
+  auto lines = base::SplitStringPiece(pressure, "\n", base::TRIM_WHITESPACE,
+                                      base::SPLIT_WANT_NONEMPTY);
+  for (auto line : lines) {
+    if (!base::StartsWith(line, "some ")) {
+      continue;
+    }
+    auto cols = base::SplitStringPiece(line, " ", base::TRIM_WHITESPACE,
+                                       base::SPLIT_WANT_NONEMPTY);
+    for (auto col : cols) {
+      static constexpr char kAvg10Prefix[] = "avg10=";
+      double avg10;
+      if (base::StartsWith(col, kAvg10Prefix)) {
+        if (!base::StringToDouble(col.substr(sizeof(kAvg10Prefix) - 1),
+                                  &avg10)) {
+          LOG(ERROR) << "Failed to parse memory pressure line \"" << line
+                     << "\"";
+          return std::nullopt;
+        }
+        return std::optional<double>(avg10);
+      }
+    }
+  }
+  LOG(ERROR) << "Failed to find the some avg10 memory pressure";
+  return std::nullopt;
+}
+
 std::optional<uint64_t> HostZoneLowSum(bool log_on_error) {
   static constexpr char kProcZoneinfo[] = "/proc/zoneinfo";
   const base::FilePath zoneinfo_path(kProcZoneinfo);
@@ -6,11 +6,14 @@
 
 #include <crosvm/crosvm_control.h>
 
+#include <algorithm>
 #include <limits>
 #include <optional>
 #include <stdint.h>
 #include <string>
 
+#include <base/functional/callback.h>
+
 #include "vm_tools/concierge/byte_unit.h"
 
 namespace vm_tools {
@@ -52,6 +55,26 @@ struct BalloonWorkingSet {
   uint64_t AnonMemoryAt(int i) const { return working_set_ffi.ws[i].bytes[0]; }
   // Returns file-backed memory count for the given bin in this working set.
   uint64_t FileMemoryAt(int i) const { return working_set_ffi.ws[i].bytes[1]; }
+
+  // Returns sum of all memory in the |num_bins| youngest bins of this working
+  // set.
+  uint64_t YoungMemory(int num_bins) const {
+    uint64_t total = 0;
+    for (int i = 0; i < std::min<int64_t>(num_bins, kWorkingSetNumBins); ++i) {
+      total += AnonMemoryAt(i) + FileMemoryAt(i);
+    }
+    return total;
+  }
+
+  // Returns file-backed memory in the |num_bins| youngest bins of this working
+  // set.
+  uint64_t YoungFileMemory(int num_bins) const {
+    uint64_t total = 0;
+    for (int i = 0; i < std::min<int64_t>(num_bins, kWorkingSetNumBins); ++i) {
+      total += FileMemoryAt(i);
+    }
+    return total;
+  }
 };
 
 // Add the respective bins for two working sets and return a new one.
@@ -259,6 +282,101 @@ class LimitCacheBalloonPolicy : public BalloonPolicyInterface {
                                                int64_t margin);
 };
 
+// Sizes the balloon of a VM from the working set of the guest, i.e. the memory
+// in the youngest MGLRU generations reported by virtio-balloon, and from the
+// memory pressure stall information (PSI) of the host. When the host is about
+// to stall on reclaim, the free memory and the cold page cache the guest holds
+// beyond its working set are moved to the host. Once the host is no longer
+// under pressure, memory is given back to guests running short of free
+// memory. Running it for every VM moves memory between the VMs through the
+// host.
+class WorkingSetBalloonPolicy : public BalloonPolicyInterface {
+ public:
+  struct Params {
+    // Host PSI, as the percentage of time some tasks stalled on memory over
+    // the last 10 seconds, at or above which the host is under pressure.
+    double inflate_psi_threshold;
+
+    // Host PSI below which the host is no longer under pressure. Lower than
+    // |inflate_psi_threshold| so that the balloon does not flip between
+    // inflating and deflating.
+    double deflate_psi_threshold;
+
+    // Number of the youngest working set bins the working set is made of.
+    int working_set_bins;
+
+    // Free memory the guest keeps on top of its working set.
+    int64_t guest_free_headroom;
+
+    // Balloon size changes smaller than |min_step| are skipped, to limit the
+    // VM exits caused by ballooning, and larger ones are capped at |max_step|.
+    int64_t min_step;
+    int64_t max_step;
+  };
+
+  // Returns the working set of the guest, or std::nullopt if it is not
+  // available yet.
+  using WorkingSetCallback =
+      base::RepeatingCallback<std::optional<BalloonWorkingSet>()>;
+
+  WorkingSetBalloonPolicy(const MemoryMargins& margins,
+                          const Params& params,
+                          WorkingSetCallback get_working_set,
+                          const std::string& vm);
+  WorkingSetBalloonPolicy(const WorkingSetBalloonPolicy&) = delete;
+  WorkingSetBalloonPolicy& operator=(const WorkingSetBalloonPolicy&) = delete;
+
+  int64_t ComputeBalloonDelta(
+      const BalloonStats& stats,
+      uint64_t host_available,
+      bool game_mode,
+      const std::string& vm,
+      int64_t total_available_memory,
+      ComponentMemoryMargins component_margins) override;
+
+  // Computes the balloon delta from the sampled host PSI and guest working
+  // set. Exposed for testing and for replaying recorded traces.
+  int64_t ComputeBalloonDeltaImpl(double host_psi,
+                                  const BalloonWorkingSet& working_set,
+                                  const BalloonStats& stats,
+                                  int64_t host_available,
+                                  const std::string& vm);
+
+  // Deflating to save processes is left to LMKD.
+  bool DeflateBalloonToSaveProcess(int proc_size,
+                                   int proc_oom_score,
+                                   uint64_t& new_balloon_size,
+                                   uint64_t& freed_space) override {
+    return false;
+  }
+
+  // Ignore this because WorkingSetBalloonPolicy does not cache the balloon
+  // size.
+  void UpdateCurrentBalloonSize(uint64_t size) override {}
+
+  bool host_under_pressure() const { return host_under_pressure_; }
+
+ private:
+  // ChromeOS's memory margins.
+  const MemoryMargins margins_;
+
+  // Tunable parameters of the policy.
+  const Params params_;
+
+  const WorkingSetCallback get_working_set_;
+
+  // Whether the host was last found under memory pressure.
+  bool host_under_pressure_ = false;
+};
+
+// Returns the "some avg10" value of the host's /proc/pressure/memory, i.e. the
+// percentage of time some tasks stalled on memory over the last 10 seconds.
+// Returns std::nullopt on error.
+std::optional<double> HostMemoryPressure(bool log_on_error);
+
+// Parses the "some avg10" value from the contents of /proc/pressure/memory.
+std::optional<double> ParseMemoryPressure(const std::string& pressure);
+
 // Computes the sum of all of ChromeOS's zone's low watermarks. To help
 // initialize LimitCacheBalloonPolicy. Returns std::nullopt on error.
 std::optional<uint64_t> HostZoneLowSum(bool log_on_error);
@@ -5,10 +5,13 @@
 #include "vm_tools/concierge/balloon_policy.h"
 #include "vm_tools/concierge/vm_util.h"
 
+#include <algorithm>
+#include <optional>
 #include <string>
 
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
+#include <base/functional/bind.h>
 #include <base/json/json_reader.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -651,5 +654,220 @@ TEST(BalloonPolicyTest, BalloonWorkingSetSum) {
   }
 }
 
+namespace {
+
+constexpr WorkingSetBalloonPolicy::Params kWorkingSetParams = {
+    .inflate_psi_threshold = 10.0,
+    .deflate_psi_threshold = 1.0,
+    .working_set_bins = 2,
+    .guest_free_headroom = MiB(256),
+    .min_step = MiB(16),
+    .max_step = MiB(512)};
+constexpr MemoryMargins kWorkingSetMargins = {.critical = MiB(400),
+                                              .moderate = MiB(2000)};
+
+// Returns a working set with |anon| and |file| bytes in each bin.
+BalloonWorkingSet MakeWorkingSet(uint64_t anon, uint64_t file) {
+  BalloonWSFfi ffi;
+  for (unsigned i = 0; i < BalloonWorkingSet::kWorkingSetNumBins; ++i) {
+    ffi.ws[i] = {i, {anon, file}};
+  }
+  return {ffi, 0};
+}
+
+WorkingSetBalloonPolicy::WorkingSetCallback NoWorkingSet() {
+  return base::BindRepeating(
+      []() -> std::optional<BalloonWorkingSet> { return std::nullopt; });
+}
+
+}  // namespace
+
+// Test that the some avg10 value is parsed from /proc/pressure/memory.
+TEST(BalloonPolicyTest, ParseMemoryPressure) {
+  EXPECT_EQ(12.5,
+            ParseMemoryPressure(
+                "some avg10=12.50 avg60=3.00 avg300=1.00 total=1234\n"
+                "full avg10=6.00 avg60=1.00 avg300=0.50 total=567\n"));
+  EXPECT_EQ(std::nullopt, ParseMemoryPressure(""));
+  EXPECT_EQ(std::nullopt,
+            ParseMemoryPressure(
+                "full avg10=6.00 avg60=1.00 avg300=0.50 total=567\n"));
+  EXPECT_EQ(std::nullopt,
+            ParseMemoryPressure("some avg10=abc avg60=3.00 total=1234\n"));
+}
+
+// Test that the guest gives its free memory and the cache outside its working
+// set to the host under pressure, but keeps its working set.
+TEST(BalloonPolicyTest, WorkingSetInflatesUnderPressure) {
+  WorkingSetBalloonPolicy policy(kWorkingSetMargins, kWorkingSetParams,
+                                 NoWorkingSet(), "test");
+  const BalloonWorkingSet working_set = MakeWorkingSet(MiB(100), MiB(200));
+  const BalloonStats stats = {{.free_memory = MiB(1256),
+                               .disk_caches = MiB(700),
+                               .unevictable_memory = MiB(100)}};
+
+  // No pressure, the guest has more free memory than its headroom.
+  EXPECT_EQ(0, policy.ComputeBalloonDeltaImpl(0.0, working_set, stats,
+                                              MiB(3000), "test"));
+  EXPECT_FALSE(policy.host_under_pressure());
+
+  // Stalls on the host: 1000 MiB of excess free memory and 600 - 2 * 200 MiB of
+  // cold cache, capped at max_step.
+  EXPECT_EQ(kWorkingSetParams.max_step,
+            policy.ComputeBalloonDeltaImpl(20.0, working_set, stats, MiB(3000),
+                                           "test"));
+  EXPECT_TRUE(policy.host_under_pressure());
+
+  // Once the excess free memory is gone, only the cold cache is reclaimed.
+  const BalloonStats low_free_stats = {{.free_memory = MiB(256),
+                                        .disk_caches = MiB(700),
+                                        .unevictable_memory = MiB(100)}};
+  EXPECT_EQ(MiB(200), policy.ComputeBalloonDeltaImpl(20.0, working_set,
+                                                     low_free_stats, MiB(3000),
+                                                     "test"));
+
+  // Nothing is left outside of the working set.
+  const BalloonStats hot_stats = {{.free_memory = MiB(256),
+                                   .disk_caches = MiB(400)}};
+  EXPECT_EQ(0, policy.ComputeBalloonDeltaImpl(20.0, working_set, hot_stats,
+                                              MiB(3000), "test"));
+}
+
+// Test that the host is considered under pressure from the inflate threshold
+// until the pressure drops below the deflate threshold.
+TEST(BalloonPolicyTest, WorkingSetPressureHysteresis) {
+  WorkingSetBalloonPolicy policy(kWorkingSetMargins, kWorkingSetParams,
+                                 NoWorkingSet(), "test");
+  const BalloonWorkingSet working_set = MakeWorkingSet(MiB(100), MiB(100));
+  const BalloonStats stats = {{.free_memory = MiB(256)}, MiB(1000)};
+
+  policy.ComputeBalloonDeltaImpl(5.0, working_set, stats, MiB(3000), "test");
+  EXPECT_FALSE(policy.host_under_pressure());
+  policy.ComputeBalloonDeltaImpl(10.0, working_set, stats, MiB(3000), "test");
+  EXPECT_TRUE(policy.host_under_pressure());
+  policy.ComputeBalloonDeltaImpl(5.0, working_set, stats, MiB(3000), "test");
+  EXPECT_TRUE(policy.host_under_pressure());
+  // Still below the moderate margin.
+  policy.ComputeBalloonDeltaImpl(0.5, working_set, stats, MiB(1000), "test");
+  EXPECT_TRUE(policy.host_under_pressure());
+  policy.ComputeBalloonDeltaImpl(0.5, working_set, stats, MiB(3000), "test");
+  EXPECT_FALSE(policy.host_under_pressure());
+  // Below the critical margin without stalls.
+  policy.ComputeBalloonDeltaImpl(0.0, working_set, stats, MiB(300), "test");
+  EXPECT_TRUE(policy.host_under_pressure());
+}
+
+// Test that the balloon deflates only by what the guest is short of, once the
+// host has recovered.
+TEST(BalloonPolicyTest, WorkingSetDeflatesWhenGuestShort) {
+  WorkingSetBalloonPolicy policy(kWorkingSetMargins, kWorkingSetParams,
+                                 NoWorkingSet(), "test");
+  const BalloonWorkingSet working_set = MakeWorkingSet(MiB(100), MiB(100));
+
+  const BalloonStats short_stats = {{.free_memory = MiB(56)}, MiB(1000)};
+  EXPECT_EQ(-MiB(200), policy.ComputeBalloonDeltaImpl(
+                           0.0, working_set, short_stats, MiB(3000), "test"));
+
+  // The balloon can not deflate below zero.
+  const BalloonStats small_balloon_stats = {{.free_memory = MiB(56)}, MiB(50)};
+  EXPECT_EQ(-MiB(50),
+            policy.ComputeBalloonDeltaImpl(0.0, working_set,
+                                           small_balloon_stats, MiB(3000),
+                                           "test"));
+
+  // Small changes are skipped.
+  const BalloonStats almost_stats = {{.free_memory = MiB(250)}, MiB(1000)};
+  EXPECT_EQ(0, policy.ComputeBalloonDeltaImpl(0.0, working_set, almost_stats,
+                                              MiB(3000), "test"));
+}
+
+// Test that no balloon change is made without a working set.
+TEST(BalloonPolicyTest, WorkingSetUnavailable) {
+  WorkingSetBalloonPolicy policy(kWorkingSetMargins, kWorkingSetParams,
+                                 NoWorkingSet(), "test");
+  const BalloonStats stats = {{.free_memory = MiB(2000)}};
+  EXPECT_EQ(0, policy.ComputeBalloonDelta(stats, MiB(100), false, "test", 0,
+                                          {}));
+}
+
+// Replays a recorded-style trace of the host pressure and guest memory usage
+// through the policy, applying each balloon change to a simulated guest.
+TEST(BalloonPolicyTest, WorkingSetTraceReplay) {
+  struct TraceSample {
+    double host_psi;
+    int64_t host_available;
+    // Memory the guest uses outside of its page cache and free memory.
+    int64_t guest_used;
+    // Page cache the guest wants, of which |working_set_file| is hot.
+    int64_t guest_cache;
+    int64_t working_set_file;
+  };
+  constexpr int64_t kGuestTotal = MiB(4096);
+  // The host comes under pressure while the guest idles with a large cache,
+  // then recovers while the guest starts using more memory.
+  const TraceSample kTrace[] = {
+      {0.0, MiB(3000), MiB(1000), MiB(1500), MiB(300)},
+      {0.5, MiB(2800), MiB(1000), MiB(1500), MiB(300)},
+      {12.0, MiB(900), MiB(1000), MiB(1500), MiB(300)},
+      {25.0, MiB(600), MiB(1000), MiB(1500), MiB(300)},
+      {15.0, MiB(800), MiB(1000), MiB(1500), MiB(300)},
+      {6.0, MiB(1500), MiB(1000), MiB(1500), MiB(300)},
+      {3.0, MiB(1900), MiB(1000), MiB(1500), MiB(300)},
+      {8.0, MiB(1700), MiB(1000), MiB(1500), MiB(300)},
+      {0.8, MiB(2500), MiB(1500), MiB(1500), MiB(300)},
+      {0.2, MiB(2600), MiB(2000), MiB(1500), MiB(300)},
+      {0.0, MiB(2600), MiB(2500), MiB(1500), MiB(300)},
+      {0.0, MiB(2700), MiB(2500), MiB(1500), MiB(300)},
+  };
+
+  WorkingSetBalloonPolicy policy(kWorkingSetMargins, kWorkingSetParams,
+                                 NoWorkingSet(), "test");
+  int64_t balloon = 0;
+  int direction_changes = 0;
+  int64_t last_delta = 0;
+  int64_t max_balloon = 0;
+  for (const TraceSample& sample : kTrace) {
+    // The guest fills what the balloon leaves it with its used memory first,
+    // then with cache, and keeps the rest free.
+    const int64_t guest_memory = kGuestTotal - balloon;
+    const int64_t guest_cache =
+        std::clamp(guest_memory - sample.guest_used, static_cast<int64_t>(0),
+                   sample.guest_cache);
+    const int64_t guest_free = std::max(
+        guest_memory - sample.guest_used - guest_cache,
+        static_cast<int64_t>(0));
+    const BalloonStats stats = {
+        {.free_memory = guest_free, .disk_caches = guest_cache},
+        static_cast<uint64_t>(balloon)};
+    const BalloonWorkingSet working_set = MakeWorkingSet(
+        MiB(100), sample.working_set_file / kWorkingSetParams.working_set_bins);
+
+    const int64_t delta = policy.ComputeBalloonDeltaImpl(
+        sample.host_psi, working_set, stats, sample.host_available, "test");
+    if (delta != 0) {
+      if ((delta > 0) != (last_delta > 0) && last_delta != 0) {
+        ++direction_changes;
+      }
+      last_delta = delta;
+    }
+    balloon = std::max(balloon + delta, static_cast<int64_t>(0));
+    max_balloon = std::max(max_balloon, balloon);
+
+    // Inflating never takes the hot part of the guest's cache.
+    if (delta > 0) {
+      EXPECT_GE(kGuestTotal - balloon,
+                sample.guest_used +
+                    std::min(sample.working_set_file, sample.guest_cache));
+    }
+  }
+
+  // The pressure moved the guest's free memory and cold cache to the host.
+  EXPECT_GT(max_balloon, MiB(1000));
+  // The balloon was given back as the guest needed it, without flipping back
+  // and forth during the pressure.
+  EXPECT_LT(balloon, max_balloon);
+  EXPECT_LE(direction_changes, 1);
+}
+
 }  // namespace concierge
 }  // namespace vm_tools
@@ -5,6 +5,7 @@
 #include <archive.h>
 #include <archive_entry.h>
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -13,12 +14,14 @@
 
 #include <base/check.h>
 #include <base/files/file.h>
+#include <base/files/file_enumerator.h>
 #include <base/files/file_util.h>
 #include <base/logging.h>
 #include <base/memory/ptr_util.h>
 #include <base/stl_util.h>
 #include <base/strings/string_number_conversions.h>
 #include <base/strings/stringprintf.h>
+#include <base/system/sys_info.h>
 #include <base/uuid.h>
 
 #include "vm_tools/concierge/disk_image.h"
@@ -31,6 +34,36 @@ namespace {
 
 constexpr gid_t kPluginVmGid = 20128;
 
+// Size of the unit st_blocks is counted in.
+constexpr int64_t kStatBlockSize = 512;
+
+// Size of the zero-filled buffer the holes of sparse files are written from.
+constexpr size_t kZeroBufferSize = 1 << 20;
+
+// Compressing with zstd leaves some of the CPUs to the rest of the system.
+constexpr int kMaxZstdThreads = 4;
+
+// Returns the disk space allocated to |path|, or to the files under it if it
+// is a directory. This is what is actually read when exporting a sparse disk
+// image.
+int64_t ComputeAllocatedSize(const base::FilePath& path) {
+  struct stat st;
+  if (stat(path.value().c_str(), &st) != 0) {
+    return 0;
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    return st.st_blocks * kStatBlockSize;
+  }
+
+  int64_t size = 0;
+  base::FileEnumerator files(path, true /* recursive */,
+                             base::FileEnumerator::FILES);
+  for (base::FilePath file = files.Next(); !file.empty(); file = files.Next()) {
+    size += files.GetInfo().stat().st_blocks * kStatBlockSize;
+  }
+  return size;
+}
+
 }  // namespace
 
 namespace vm_tools {
@@ -219,16 +252,19 @@ VmExportOperation::VmExportOperation(const VmId vm_id,
       out_fd_(std::move(out_fd)),
       out_digest_fd_(std::move(out_digest_fd)),
       copying_data_(false),
+      entry_size_(0),
+      entry_offset_(0),
+      pending_block_(nullptr),
+      pending_block_size_(0),
+      pending_block_offset_(0),
       out_fmt_(std::move(out_fmt)),
       sha256_(crypto::SecureHash::Create(crypto::SecureHash::SHA256)) {
   base::File::Info info;
-  if (GetFileInfo(src_image_path_, &info) && !info.is_directory) {
-    set_source_size(info.size);
-    image_is_directory_ = false;
-  } else {
-    set_source_size(ComputeDirectorySize(src_image_path_));
-    image_is_directory_ = true;
-  }
+  image_is_directory_ =
+      !GetFileInfo(src_image_path_, &info) || info.is_directory;
+  // The holes of sparse images are not read, so the progress is based on the
+  // allocated size rather than the apparent one.
+  set_source_size(ComputeAllocatedSize(src_image_path_));
 }
 
 VmExportOperation::~VmExportOperation() {
@@ -299,6 +335,37 @@ bool VmExportOperation::PrepareOutput() {
         return false;
       }
       break;
+    case ArchiveFormat::TAR_ZSTD: {
+      ret = archive_write_add_filter_zstd(out_.get());
+      if (ret != ARCHIVE_OK) {
+        set_failure_reason(base::StringPrintf(
+            "libarchive: failed to initialize zstd filter: %s, %s",
+            archive_error_string(out_.get()),
+            strerror(archive_errno(out_.get()))));
+        return false;
+      }
+
+      // Older zstd libraries compress on a single thread only, which is
+      // slower but still produces a valid archive.
+      const std::string threads = base::NumberToString(std::clamp(
+          base::SysInfo::NumberOfProcessors() / 2, 1, kMaxZstdThreads));
+      ret = archive_write_set_filter_option(out_.get(), "zstd", "threads",
+                                            threads.c_str());
+      if (ret != ARCHIVE_OK) {
+        LOG(WARNING) << "libarchive: failed to compress with " << threads
+                     << " zstd threads: " << archive_error_string(out_.get());
+      }
+
+      ret = archive_write_set_format_pax_restricted(out_.get());
+      if (ret != ARCHIVE_OK) {
+        set_failure_reason(base::StringPrintf(
+            "libarchive: failed to initialize pax format: %s, %s",
+            archive_error_string(out_.get()),
+            strerror(archive_errno(out_.get()))));
+        return false;
+      }
+      break;
+    }
   }
 
   ret = archive_write_open(out_.get(), reinterpret_cast<void*>(this),
@@ -413,13 +480,15 @@ bool VmExportOperation::ExecuteIo(uint64_t io_limit) {
         break;
       }
 
-      copying_data_ = archive_entry_size(entry) > 0;
+      entry_size_ = archive_entry_size(entry);
+      entry_offset_ = 0;
+      pending_block_ = nullptr;
+      copying_data_ = entry_size_ > 0;
     }
 
     if (copying_data_) {
-      uint64_t bytes_read = CopyEntry(io_limit);
-      io_limit -= std::min(bytes_read, io_limit);
-      AccumulateProcessedSize(bytes_read);
+      uint64_t bytes_copied = CopyEntry(io_limit);
+      io_limit -= std::min(bytes_copied, io_limit);
     }
 
     if (!copying_data_) {
@@ -436,32 +505,63 @@ bool VmExportOperation::ExecuteIo(uint64_t io_limit) {
 }
 
 uint64_t VmExportOperation::CopyEntry(uint64_t io_limit) {
-  uint64_t bytes_read = 0;
+  static const uint8_t kZeros[kZeroBufferSize] = {};
+  // The tar formats record the holes of sparse files found by the reader and
+  // skip the zeros written for them, zip stores and compresses them.
+  const bool holes_are_skipped = out_fmt_ != ArchiveFormat::ZIP;
+  uint64_t bytes_copied = 0;
 
   do {
-    uint8_t buf[16384];
-    int count = archive_read_data(in_.get(), buf, sizeof(buf));
-    if (count == 0) {
-      // No more data
-      copying_data_ = false;
-      break;
+    if (!pending_block_) {
+      int ret = archive_read_data_block(in_.get(), &pending_block_,
+                                        &pending_block_size_,
+                                        &pending_block_offset_);
+      if (ret == ARCHIVE_EOF) {
+        // Only the hole at the end of the file, if any, is left.
+        pending_block_ = kZeros;
+        pending_block_size_ = 0;
+        pending_block_offset_ = entry_size_;
+      } else if (ret != ARCHIVE_OK) {
+        MarkFailed("failed to read data block", in_.get());
+        break;
+      } else {
+        bytes_copied += pending_block_size_;
+        AccumulateProcessedSize(pending_block_size_);
+      }
     }
 
-    if (count < 0) {
-      MarkFailed("failed to read data block", in_.get());
-      break;
+    if (entry_offset_ < pending_block_offset_) {
+      // Fill the hole before the block.
+      const size_t count = static_cast<size_t>(std::min<int64_t>(
+          pending_block_offset_ - entry_offset_, sizeof(kZeros)));
+      if (archive_write_data(out_.get(), kZeros, count) < ARCHIVE_OK) {
+        MarkFailed("failed to write hole", out_.get());
+        break;
+      }
+      entry_offset_ += count;
+      if (!holes_are_skipped) {
+        bytes_copied += count;
+      }
+      continue;
     }
 
-    bytes_read += count;
-
-    int ret = archive_write_data(out_.get(), buf, count);
-    if (ret < ARCHIVE_OK) {
+    if (pending_block_size_ > 0 &&
+        archive_write_data(out_.get(), pending_block_, pending_block_size_) <
+            ARCHIVE_OK) {
       MarkFailed("failed to write data block", out_.get());
       break;
     }
-  } while (bytes_read < io_limit);
+    entry_offset_ += pending_block_size_;
+    pending_block_ = nullptr;
 
-  return bytes_read;
+    if (entry_offset_ >= entry_size_) {
+      // No more data
+      copying_data_ = false;
+      break;
+    }
+  } while (bytes_copied < io_limit);
+
+  return bytes_copied;
 }
 
 void VmExportOperation::Finalize() {
@@ -591,9 +691,12 @@ bool PluginVmImportOperation::PrepareOutput() {
     return false;
   }
 
+  // Zip archives do not record the holes of the exported images, so look for
+  // blocks of zeros to leave holes for.
   int ret = archive_write_disk_set_options(
       out_.get(), ARCHIVE_EXTRACT_SECURE_SYMLINKS |
-                      ARCHIVE_EXTRACT_SECURE_NODOTDOT | ARCHIVE_EXTRACT_OWNER);
+                      ARCHIVE_EXTRACT_SECURE_NODOTDOT | ARCHIVE_EXTRACT_OWNER |
+                      ARCHIVE_EXTRACT_SPARSE);
   if (ret != ARCHIVE_OK) {
     set_failure_reason("libarchive: failed to initialize filter");
     return false;
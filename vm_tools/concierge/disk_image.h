@@ -136,6 +136,8 @@ using ArchiveWriter = std::unique_ptr<struct archive, ArchiveWriteDeleter>;
 enum class ArchiveFormat {
   ZIP,
   TAR_GZ,
+  // Compressed with zstd on several threads.
+  TAR_ZSTD,
 };
 
 class VmExportOperation : public DiskImageOperation {
@@ -174,8 +176,10 @@ class VmExportOperation : public DiskImageOperation {
 
   void MarkFailed(const char* msg, struct archive* a);
 
-  // Copies up to |io_limit| bytes of one file of the image.
-  // Returns number of bytes read.
+  // Copies up to |io_limit| bytes of one file of the image. Only the data
+  // blocks of sparse files are read, their holes are written as zeros unless
+  // the output format records them. Returns number of bytes read or written
+  // as zeros.
   uint64_t CopyEntry(uint64_t io_limit);
 
   // Path to the directory containing source image.
@@ -192,6 +196,17 @@ class VmExportOperation : public DiskImageOperation {
   // entry.
   bool copying_data_;
 
+  // Size of the archive entry being copied and how much of it, including the
+  // holes, has been written.
+  int64_t entry_size_;
+  int64_t entry_offset_;
+
+  // Data block read from the archive entry being copied which is not yet
+  // written, because the hole before it is still being written.
+  const void* pending_block_;
+  size_t pending_block_size_;
+  int64_t pending_block_offset_;
+
   // If true, disk image is a directory potentially containing multiple files.
   // If false, disk image is a single file.
   bool image_is_directory_;
@@ -10,6 +10,8 @@
 #include <utility>
 
 #include <base/check.h>
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
 #include <base/logging.h>
 #include <brillo/errors/error.h>
 #include <dlcservice/proto_bindings/dlcservice.pb.h>
@@ -33,6 +35,14 @@ DlcHelper::~DlcHelper() = default;
 std::optional<std::string> DlcHelper::GetRootPath(const std::string& dlc_id,
                                                   std::string* out_error) {
   DCHECK(out_error);
+  const auto cached = root_paths_.find(dlc_id);
+  if (cached != root_paths_.end()) {
+    if (base::PathExists(base::FilePath(cached->second))) {
+      return cached->second;
+    }
+    root_paths_.erase(cached);
+  }
+
   dlcservice::DlcState state;
   brillo::ErrorPtr error;
 
@@ -53,8 +63,18 @@ std::optional<std::string> DlcHelper::GetRootPath(const std::string& dlc_id,
     return std::nullopt;
   }
 
+  root_paths_[dlc_id] = state.root_path();
   return state.root_path();
 }
 
+void DlcHelper::PrefetchRootPaths(const std::vector<std::string>& dlc_ids) {
+  for (const std::string& dlc_id : dlc_ids) {
+    std::string error;
+    if (!GetRootPath(dlc_id, &error)) {
+      VLOG(1) << "Not prefetching " << dlc_id << ": " << error;
+    }
+  }
+}
+
 }  // namespace concierge
 }  // namespace vm_tools
@@ -5,9 +5,11 @@
 #ifndef VM_TOOLS_CONCIERGE_DLC_HELPER_H_
 #define VM_TOOLS_CONCIERGE_DLC_HELPER_H_
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "base/memory/scoped_refptr.h"
 
@@ -42,13 +44,23 @@ class DlcHelper {
 
   // Determine the path where the |dlc_id| DLC is located. If it is not
   // installed, or some error occurs, returns nullopt and sets |out_error|.
-  // Assumes that |out_error| is valid (non-null).
+  // Assumes that |out_error| is valid (non-null). The root paths found are
+  // cached for as long as they exist, so that dlcservice is only asked again
+  // once the DLC is uninstalled.
   std::optional<std::string> GetRootPath(const std::string& dlc_id,
                                          std::string* out_error);
 
+  // Looks up the root paths of the installed DLCs among |dlc_ids| ahead of
+  // the first GetRootPath() call for them. DLCs which are not installed are
+  // skipped.
+  void PrefetchRootPaths(const std::vector<std::string>& dlc_ids);
+
  private:
   std::unique_ptr<org::chromium::DlcServiceInterfaceProxyInterface>
       dlcservice_handle_;
+
+  // Root paths of the installed DLCs found so far, by DLC id.
+  std::map<std::string, std::string> root_paths_;
 };
 
 }  // namespace concierge
@@ -10,6 +10,7 @@
 #include <optional>
 #include <utility>
 
+#include "base/files/scoped_temp_dir.h"
 #include "base/memory/scoped_refptr.h"
 #include "dlcservice/proto_bindings/dlcservice.pb.h"
 #include "dlcservice/dbus-proxy-mocks.h"  //NOLINT (build/include_alpha)
@@ -85,6 +86,63 @@ TEST_F(DlcHelperTest, InstalledReturnsRootPath) {
   EXPECT_EQ(root_path.value(), "/path/to/dlc/root");
 }
 
+TEST_F(DlcHelperTest, CachesExistingRootPath) {
+  base::ScopedTempDir root_dir;
+  ASSERT_TRUE(root_dir.CreateUniqueTempDir());
+  const std::string root_path = root_dir.GetPath().value();
+
+  MockHandlePtr handle = GetMockHandle();
+  EXPECT_CALL(*handle, GetDlcState(_, _, _, _))
+      .WillOnce(testing::Invoke(
+          [&root_path](const std::string& in_id,
+                       dlcservice::DlcState* out_state, brillo::ErrorPtr* error,
+                       int /*timeout_ms*/) -> bool {
+            out_state->set_state(dlcservice::DlcState_State_INSTALLED);
+            out_state->set_root_path(root_path);
+            return true;
+          }));
+
+  DlcHelper helper(std::move(handle));
+  helper.PrefetchRootPaths({"foobar"});
+
+  // The prefetched path is returned without asking dlcservice again.
+  std::string error;
+  EXPECT_EQ(helper.GetRootPath("foobar", &error), root_path);
+  EXPECT_TRUE(error.empty());
+}
+
+TEST_F(DlcHelperTest, RequeriesRemovedRootPath) {
+  base::ScopedTempDir root_dir;
+  ASSERT_TRUE(root_dir.CreateUniqueTempDir());
+  const std::string root_path = root_dir.GetPath().value();
+
+  MockHandlePtr handle = GetMockHandle();
+  EXPECT_CALL(*handle, GetDlcState(_, _, _, _))
+      .WillOnce(testing::Invoke(
+          [&root_path](const std::string& in_id,
+                       dlcservice::DlcState* out_state, brillo::ErrorPtr* error,
+                       int /*timeout_ms*/) -> bool {
+            out_state->set_state(dlcservice::DlcState_State_INSTALLED);
+            out_state->set_root_path(root_path);
+            return true;
+          }))
+      .WillOnce(testing::Invoke(
+          [](const std::string& in_id, dlcservice::DlcState* out_state,
+             brillo::ErrorPtr* error, int /*timeout_ms*/) -> bool {
+            out_state->set_state(dlcservice::DlcState_State_NOT_INSTALLED);
+            return true;
+          }));
+
+  DlcHelper helper(std::move(handle));
+  std::string error;
+  EXPECT_EQ(helper.GetRootPath("foobar", &error), root_path);
+
+  // Once the DLC is uninstalled its root path is looked up again.
+  ASSERT_TRUE(root_dir.Delete());
+  EXPECT_FALSE(helper.GetRootPath("foobar", &error).has_value());
+  EXPECT_FALSE(error.empty());
+}
+
 }  // namespace
 }  // namespace concierge
 }  // namespace vm_tools
@@ -21,6 +21,10 @@ namespace {
 // Constants related to logging Vm Start and Vm Stop times.
 constexpr char kVmStartMetricsTag[] = "Start";
 constexpr char kVmStopMetricsTag[] = "Stop";
+constexpr char kVmStartImageSetupMetricsTag[] = "StartImageSetup";
+constexpr char kVmStartGpuCacheSetupMetricsTag[] = "StartGpuCacheSetup";
+constexpr char kVmStartBootMetricsTag[] = "StartBoot";
+constexpr char kVmStartGuestSetupMetricsTag[] = "StartGuestSetup";
 constexpr char kDurationSuffix[] = "Duration";
 // Modify this as per the max timeout here -
 // https://source.chromium.org/chromiumos/chromiumos/codesearch/+/main:src/platform2/vm_tools/init/vm_concierge.conf;l=46?q=file:vm_concierge.conf.
@@ -43,6 +47,18 @@ std::string GetVirtualizationMetricsName(apps::VmType vm_type,
     case DurationRecorder::Event::kVmStop:
       event_name = kVmStopMetricsTag;
       break;
+    case DurationRecorder::Event::kVmStartImageSetup:
+      event_name = kVmStartImageSetupMetricsTag;
+      break;
+    case DurationRecorder::Event::kVmStartGpuCacheSetup:
+      event_name = kVmStartGpuCacheSetupMetricsTag;
+      break;
+    case DurationRecorder::Event::kVmStartBoot:
+      event_name = kVmStartBootMetricsTag;
+      break;
+    case DurationRecorder::Event::kVmStartGuestSetup:
+      event_name = kVmStartGuestSetupMetricsTag;
+      break;
     default:
       NOTREACHED();
       LOG(ERROR) << "Unknown vm event for MetricsInstrumenter: " << event_name;
@@ -22,6 +22,15 @@ class DurationRecorder {
   enum Event {
     kVmStart = 1,
     kVmStop,
+    // Steps of kVmStart.
+    // Looking up the VM images and opening them and the disks.
+    kVmStartImageSetup,
+    // Preparing the GPU and shader caches.
+    kVmStartGpuCacheSetup,
+    // From launching crosvm until maitre'd is ready.
+    kVmStartBoot,
+    // Configuring the guest once maitre'd is ready.
+    kVmStartGuestSetup,
   };
 
   DurationRecorder(const raw_ref<MetricsLibraryInterface> metrics,
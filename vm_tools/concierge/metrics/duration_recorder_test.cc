@@ -31,4 +31,22 @@ TEST(DurationRecorderTest, GetMetricsName) {
   }
 }
 
+TEST(DurationRecorderTest, GetStartStepMetricsName) {
+  EXPECT_EQ(
+      internal::GetVirtualizationMetricsName(
+          apps::VmType::TERMINA, DurationRecorder::Event::kVmStartImageSetup),
+      "Virtualization.TERMINA.StartImageSetup.Duration");
+  EXPECT_EQ(internal::GetVirtualizationMetricsName(
+                apps::VmType::BOREALIS,
+                DurationRecorder::Event::kVmStartGpuCacheSetup),
+            "Virtualization.BOREALIS.StartGpuCacheSetup.Duration");
+  EXPECT_EQ(internal::GetVirtualizationMetricsName(
+                apps::VmType::TERMINA, DurationRecorder::Event::kVmStartBoot),
+            "Virtualization.TERMINA.StartBoot.Duration");
+  EXPECT_EQ(
+      internal::GetVirtualizationMetricsName(
+          apps::VmType::TERMINA, DurationRecorder::Event::kVmStartGuestSetup),
+      "Virtualization.TERMINA.StartGuestSetup.Duration");
+}
+
 }  // namespace vm_tools::concierge::metrics
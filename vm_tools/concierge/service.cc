@@ -178,6 +178,9 @@ constexpr const char* kPluginVmImageExtensions[] = {kPluginVmImageExtension,
 // The Id of the DLC that supplies the Bios for the Bruschetta VM.
 constexpr char kBruschettaBiosDlcId[] = "edk2-ovmf-dlc";
 
+// The Id of the DLC that supplies the Termina VM image.
+constexpr char kTerminaDlcId[] = "termina-dlc";
+
 // File path for the Bruschetta Bios file inside the DLC root.
 constexpr char kBruschettaBiosDlcPath[] = "opt/CROSVM_CODE.fd";
 
@@ -909,6 +912,26 @@ apps::VmType ClassifyVm(const StartVmRequest& request) {
   return apps::VmType::UNKNOWN;
 }
 
+// Looks up the DLCs the image of |vm| is made of on |dbus_task_runner|, so
+// that GetImageSpec() finds their root paths cached. Returns a future that
+// is ready once they are looked up.
+Future<void> PrefetchVmImageDlcs(
+    scoped_refptr<base::TaskRunner> dbus_task_runner,
+    DlcHelper* dlc_helper,
+    const VirtualMachineSpec& vm) {
+  std::vector<std::string> dlc_ids;
+  for (const std::string& dlc_id :
+       {vm.bios_dlc_id(), vm.dlc_id(), vm.tools_dlc_id()}) {
+    if (!dlc_id.empty()) {
+      dlc_ids.push_back(dlc_id);
+    }
+  }
+  return AsyncNoReject(dbus_task_runner,
+                       base::BindOnce(&DlcHelper::PrefetchRootPaths,
+                                      base::Unretained(dlc_helper),
+                                      std::move(dlc_ids)));
+}
+
 }  // namespace
 
 base::FilePath Service::GetVmGpuCachePathInternal(const std::string& owner_id,
@@ -1504,6 +1527,12 @@ bool Service::Init() {
       base::FilePath(kL1TFFilePath), base::FilePath(kMDSFilePath));
 
   dlcservice_client_ = std::make_unique<DlcHelper>(bus_);
+  // Concierge is started along with the user session, so this warms up the
+  // lookup of the Termina image ahead of the first VM start.
+  bus_->GetDBusTaskRunner()->PostTask(
+      FROM_HERE, base::BindOnce(&DlcHelper::PrefetchRootPaths,
+                                base::Unretained(dlcservice_client_.get()),
+                                std::vector<std::string>{kTerminaDlcId}));
 
   // TODO(b/269214379): Wait for completion for RegisterAsync on
   // chromeos-dbus-bindings after we complete migration and remove
@@ -1782,6 +1811,72 @@ StartVmResponse Service::StartVmInternal(
     return response;
   }
 
+  if (request.name().size() > kMaxVmNameLength) {
+    LOG(ERROR) << "VM name is too long";
+
+    response.set_failure_reason("VM name is too long");
+    return response;
+  }
+
+  if (request.enable_vulkan() && !request.enable_gpu()) {
+    LOG(ERROR) << "Vulkan enabled without GPU";
+    response.set_failure_reason("Vulkan enabled without GPU");
+    return response;
+  }
+
+  if (request.enable_big_gl() && !request.enable_gpu()) {
+    LOG(ERROR) << "Big GL enabled without GPU";
+    response.set_failure_reason("Big GL enabled without GPU");
+    return response;
+  }
+
+  if (request.enable_virtgpu_native_context() && !request.enable_gpu()) {
+    LOG(ERROR) << "Virtgpu native context enabled without GPU";
+    response.set_failure_reason("Virtgpu native context enabled without GPU");
+    return response;
+  }
+
+  // The VM images are looked up on the D-Bus thread while the GPU caches,
+  // which do not depend on them, are prepared here.
+  std::optional<metrics::DurationRecorder> image_setup_recorder(
+      std::in_place, raw_ref<MetricsLibraryInterface>::from_ptr(metrics_.get()),
+      classification, metrics::DurationRecorder::Event::kVmStartImageSetup);
+  Future<void> image_dlcs_prefetched = PrefetchVmImageDlcs(
+      bus_->GetDBusTaskRunner(), dlcservice_client_.get(), request.vm());
+
+  // Enable the render server for Vulkan.
+  const bool enable_render_server = request.enable_vulkan();
+  // Enable foz db list (dynamic un/loading for RO mesa shader cache) only for
+  // Borealis, for now.
+  const bool enable_foz_db_list = classification == apps::VmType::BOREALIS;
+
+  VMGpuCacheSpec gpu_cache_spec;
+  std::optional<base::FilePath> precompiled_cache_path;
+  {
+    metrics::DurationRecorder gpu_cache_setup_recorder(
+        raw_ref<MetricsLibraryInterface>::from_ptr(metrics_.get()),
+        classification,
+        metrics::DurationRecorder::Event::kVmStartGpuCacheSetup);
+    if (request.enable_gpu()) {
+      gpu_cache_spec =
+          PrepareVmGpuCachePaths(request.owner_id(), request.name(),
+                                 enable_render_server, enable_foz_db_list);
+    }
+    if (enable_foz_db_list) {
+      auto prepare_result = PrepareShaderCache(
+          request.owner_id(), request.name(), bus_, shadercached_proxy_);
+      if (prepare_result.has_value()) {
+        precompiled_cache_path =
+            base::FilePath(prepare_result.value().precompiled_cache_path());
+      } else {
+        LOG(ERROR) << "Unable to initialize shader cache: "
+                   << prepare_result.error();
+      }
+    }
+  }
+
+  image_dlcs_prefetched.Get();
+
   // Exists just to keep FDs around for crosvm to inherit
   std::vector<brillo::SafeFD> owned_fds;
   auto root_fd_result = brillo::SafeFD::Root();
@@ -1942,6 +2037,8 @@ StartVmResponse Service::StartVmInternal(
                          .block_id = "cr-extra-disk"});
   }
 
+  image_setup_recorder.reset();
+
   // Create the runtime directory.
   base::FilePath runtime_dir;
   if (!base::CreateTemporaryDirInDir(base::FilePath(kRuntimeDir), "vm.",
@@ -1953,46 +2050,9 @@ StartVmResponse Service::StartVmInternal(
     return response;
   }
 
-  if (request.name().size() > kMaxVmNameLength) {
-    LOG(ERROR) << "VM name is too long";
-
-    response.set_failure_reason("VM name is too long");
-    return response;
-  }
   base::FilePath log_path =
       GetVmLogPath(request.owner_id(), request.name(), kCrosvmLogSocketExt);
 
-  if (request.enable_vulkan() && !request.enable_gpu()) {
-    LOG(ERROR) << "Vulkan enabled without GPU";
-    response.set_failure_reason("Vulkan enabled without GPU");
-    return response;
-  }
-
-  if (request.enable_big_gl() && !request.enable_gpu()) {
-    LOG(ERROR) << "Big GL enabled without GPU";
-    response.set_failure_reason("Big GL enabled without GPU");
-    return response;
-  }
-
-  if (request.enable_virtgpu_native_context() && !request.enable_gpu()) {
-    LOG(ERROR) << "Virtgpu native context enabled without GPU";
-    response.set_failure_reason("Virtgpu native context enabled without GPU");
-    return response;
-  }
-
-  // Enable the render server for Vulkan.
-  const bool enable_render_server = request.enable_vulkan();
-  // Enable foz db list (dynamic un/loading for RO mesa shader cache) only for
-  // Borealis, for now.
-  const bool enable_foz_db_list = classification == apps::VmType::BOREALIS;
-
-  VMGpuCacheSpec gpu_cache_spec;
-  if (request.enable_gpu()) {
-    gpu_cache_spec =
-        PrepareVmGpuCachePaths(request.owner_id(), request.name(),
-                               enable_render_server, enable_foz_db_list);
-  }
-
   // Allocate resources for the VM.
   uint32_t vsock_cid = vsock_cid_pool_.Allocate();
   if (vsock_cid == 0) {
@@ -2090,19 +2150,10 @@ StartVmResponse Service::StartVmInternal(
       .AppendCustomParam("--vcpu-cgroup-path",
                          base::FilePath(kTerminaVcpuCpuCgroup).value())
       .SetRenderServerCachePath(std::move(gpu_cache_spec.render_server));
-  if (enable_foz_db_list) {
-    auto prepare_result = PrepareShaderCache(request.owner_id(), request.name(),
-                                             bus_, shadercached_proxy_);
-    if (prepare_result.has_value()) {
-      auto precompiled_cache_path =
-          base::FilePath(prepare_result.value().precompiled_cache_path());
-      vm_builder.SetFozDbListPath(std::move(gpu_cache_spec.foz_db_list))
-          .SetPrecompiledCachePath(precompiled_cache_path)
-          .AppendSharedDir(CreateShaderSharedDataParam(precompiled_cache_path));
-    } else {
-      LOG(ERROR) << "Unable to initialize shader cache: "
-                 << prepare_result.error();
-    }
+  if (precompiled_cache_path) {
+    vm_builder.SetFozDbListPath(std::move(gpu_cache_spec.foz_db_list))
+        .SetPrecompiledCachePath(*precompiled_cache_path)
+        .AppendSharedDir(CreateShaderSharedDataParam(*precompiled_cache_path));
   }
   if (!image_spec.rootfs.empty()) {
     vm_builder.SetRootfs({.device = std::move(rootfs_device),
@@ -2139,6 +2190,9 @@ StartVmResponse Service::StartVmInternal(
     }
   }
 
+  std::optional<metrics::DurationRecorder> boot_recorder(
+      std::in_place, raw_ref<MetricsLibraryInterface>::from_ptr(metrics_.get()),
+      classification, metrics::DurationRecorder::Event::kVmStartBoot);
   auto vm = TerminaVm::Create(TerminaVm::Config{
       .vsock_cid = vsock_cid,
       .network_client = std::move(network_client),
@@ -2178,8 +2232,12 @@ StartVmResponse Service::StartVmInternal(
     response.set_failure_reason(std::to_string(vm_start_checker_status));
     return response;
   }
+  boot_recorder.reset();
 
   // maitre'd is ready.  Finish setting up the VM.
+  metrics::DurationRecorder guest_setup_recorder(
+      raw_ref<MetricsLibraryInterface>::from_ptr(metrics_.get()),
+      classification, metrics::DurationRecorder::Event::kVmStartGuestSetup);
   if (!vm->ConfigureNetwork(nameservers_, search_domains_)) {
     LOG(ERROR) << "Failed to configure VM network";
 
@@ -3379,7 +3437,8 @@ ExportDiskImageResponse Service::ExportDiskImageInternal(
   ArchiveFormat fmt;
   switch (location) {
     case STORAGE_CRYPTOHOME_ROOT:
-      fmt = ArchiveFormat::TAR_GZ;
+      fmt = request.zstd_compression() ? ArchiveFormat::TAR_ZSTD
+                                       : ArchiveFormat::TAR_GZ;
       break;
     case STORAGE_CRYPTOHOME_PLUGINVM:
       fmt = ArchiveFormat::ZIP;
@@ -39,6 +39,8 @@
 #include <vm_concierge/concierge_service.pb.h>
 
 #include "vm_tools/common/vm_id.h"
+#include "vm_tools/concierge/balloon_policy.h"
+#include "vm_tools/concierge/byte_unit.h"
 #include "vm_tools/concierge/future.h"
 #include "vm_tools/concierge/tap_device_builder.h"
 #include "vm_tools/concierge/vm_base_impl.h"
@@ -83,6 +85,17 @@ constexpr char kRenderServerCacheSizeStringBorealis[] = "1000M";
 // operations.
 constexpr int kInvalidDiskIndex = -1;
 
+// Borealis runs with working set reporting, so its balloon is sized from its
+// working set.
+constexpr WorkingSetBalloonPolicy::Params kBorealisWorkingSetPolicyParams = {
+    .inflate_psi_threshold = 10.0,
+    .deflate_psi_threshold = 1.0,
+    .working_set_bins = 2,
+    .guest_free_headroom = MiB(256),
+    .min_step = MiB(16),
+    .max_step = MiB(512),
+};
+
 // Helper function to convert spaced enum to vm_tools equivalent.
 vm_tools::StatefulDiskSpaceState MapSpacedStateToGuestState(
     spaced::StatefulDiskSpaceState state) {
@@ -1050,6 +1063,18 @@ VmBaseImpl::Info TerminaVm::GetInfo() const {
   return info;
 }
 
+const std::unique_ptr<BalloonPolicyInterface>& TerminaVm::GetBalloonPolicy(
+    const MemoryMargins& margins, const std::string& vm) {
+  if (!balloon_policy_ && classification_ == apps::BOREALIS) {
+    balloon_policy_ = std::make_unique<WorkingSetBalloonPolicy>(
+        margins, kBorealisWorkingSetPolicyParams,
+        base::BindRepeating(&TerminaVm::GetBalloonWorkingSet,
+                            base::Unretained(this)),
+        vm);
+  }
+  return VmBaseImpl::GetBalloonPolicy(margins, vm);
+}
+
 void TerminaVm::set_kernel_version_for_testing(std::string kernel_version) {
   kernel_version_ = kernel_version;
 }
@@ -209,6 +209,8 @@ class TerminaVm final : public VmBaseImpl {
   // otherwise.
   bool Shutdown() override;
   VmBaseImpl::Info GetInfo() const override;
+  const std::unique_ptr<BalloonPolicyInterface>& GetBalloonPolicy(
+      const MemoryMargins& margins, const std::string& vm) override;
   bool AttachUsbDevice(uint8_t bus,
                        uint8_t addr,
                        uint16_t vid,
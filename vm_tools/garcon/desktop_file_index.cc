@@ -0,0 +1,79 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm_tools/garcon/desktop_file_index.h"
+
+#include <utility>
+
+#include <base/logging.h>
+
+namespace vm_tools {
+namespace garcon {
+
+void DesktopFileIndex::StartScan() {
+  scan_entries_.clear();
+}
+
+const DesktopFile* DesktopFileIndex::AddFile(const base::FilePath& file_path,
+                                             base::Time last_modified,
+                                             int64_t size) {
+  auto [it, inserted] = scan_entries_.try_emplace(file_path);
+  Entry& entry = it->second;
+  if (!inserted) {
+    return entry.desktop_file.get();
+  }
+
+  auto cached = entries_.find(file_path);
+  if (cached != entries_.end() &&
+      cached->second.last_modified == last_modified &&
+      cached->second.size == size) {
+    entry = std::move(cached->second);
+    return entry.desktop_file.get();
+  }
+
+  entry.last_modified = last_modified;
+  entry.size = size;
+  entry.desktop_file = DesktopFile::ParseDesktopFile(file_path);
+  if (!entry.desktop_file) {
+    LOG(WARNING) << "Failed parsing the .desktop file: " << file_path.value();
+  }
+  return entry.desktop_file.get();
+}
+
+void DesktopFileIndex::FinishScan() {
+  // Forget the .desktop files which were removed.
+  entries_ = std::move(scan_entries_);
+  scan_entries_.clear();
+}
+
+std::optional<std::string> DesktopFileIndex::GetPackageId(
+    const base::FilePath& file_path) const {
+  auto it = entries_.find(file_path);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return it->second.package_id;
+}
+
+void DesktopFileIndex::SetPackageId(const base::FilePath& file_path,
+                                    const std::string& package_id,
+                                    uint64_t generation) {
+  if (generation != package_ids_generation_) {
+    return;
+  }
+  auto it = entries_.find(file_path);
+  if (it != entries_.end()) {
+    it->second.package_id = package_id;
+  }
+}
+
+void DesktopFileIndex::InvalidatePackageIds() {
+  package_ids_generation_++;
+  for (auto& [file_path, entry] : entries_) {
+    entry.package_id.reset();
+  }
+}
+
+}  // namespace garcon
+}  // namespace vm_tools
@@ -0,0 +1,90 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef VM_TOOLS_GARCON_DESKTOP_FILE_INDEX_H_
+#define VM_TOOLS_GARCON_DESKTOP_FILE_INDEX_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <base/files/file_path.h>
+#include <base/time/time.h>
+
+#include "vm_tools/garcon/desktop_file.h"
+
+namespace vm_tools {
+namespace garcon {
+
+// Keeps the .desktop files found by the last scan of the .desktop file
+// directories, so that a file is only parsed again, and its package only looked
+// up again, once it changes.
+class DesktopFileIndex {
+ public:
+  DesktopFileIndex() = default;
+  DesktopFileIndex(const DesktopFileIndex&) = delete;
+  DesktopFileIndex& operator=(const DesktopFileIndex&) = delete;
+
+  ~DesktopFileIndex() = default;
+
+  // Starts a new scan. The files which are not added before FinishScan() is
+  // called are forgotten.
+  void StartScan();
+
+  // Adds the .desktop file at |file_path| to the current scan. It is parsed
+  // again only if its |last_modified| time or |size| changed since the last
+  // scan. Returns nullptr if it failed to parse. The returned pointer remains
+  // valid until the next scan is finished.
+  const DesktopFile* AddFile(const base::FilePath& file_path,
+                             base::Time last_modified,
+                             int64_t size);
+
+  // Finishes the current scan.
+  void FinishScan();
+
+  // Returns the package owning the file at |file_path|, or an empty string if
+  // there is none. Returns std::nullopt if it is not known.
+  std::optional<std::string> GetPackageId(
+      const base::FilePath& file_path) const;
+
+  // Records the package owning the file at |file_path|, which was looked up
+  // when package_ids_generation() was |generation|. It is dropped if the
+  // package IDs were invalidated since.
+  void SetPackageId(const base::FilePath& file_path,
+                    const std::string& package_id,
+                    uint64_t generation);
+
+  // Forgets all the package IDs, since packages were installed or removed.
+  void InvalidatePackageIds();
+
+  // Incremented each time the package IDs are invalidated.
+  uint64_t package_ids_generation() const { return package_ids_generation_; }
+
+ private:
+  struct Entry {
+    base::Time last_modified;
+    int64_t size = 0;
+
+    // Null if the file failed to parse.
+    std::unique_ptr<DesktopFile> desktop_file;
+
+    // The package owning the file, empty if there is none, once PackageKit
+    // was queried for it.
+    std::optional<std::string> package_id;
+  };
+
+  // The files found by the last finished scan, keyed by path.
+  std::map<base::FilePath, Entry> entries_;
+  // The files found by the current scan.
+  std::map<base::FilePath, Entry> scan_entries_;
+
+  uint64_t package_ids_generation_ = 0;
+};
+
+}  // namespace garcon
+}  // namespace vm_tools
+
+#endif  // VM_TOOLS_GARCON_DESKTOP_FILE_INDEX_H_
@@ -0,0 +1,121 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm_tools/garcon/desktop_file_index.h"
+
+#include <optional>
+#include <string>
+
+#include <base/check.h>
+#include <base/files/file_path.h>
+#include <base/files/file_util.h>
+#include <base/files/scoped_temp_dir.h>
+#include <base/time/time.h>
+#include <gtest/gtest.h>
+
+namespace vm_tools {
+namespace garcon {
+
+namespace {
+
+constexpr char kDesktopFileContents[] =
+    "[Desktop Entry]\n"
+    "Type=Application\n"
+    "Name=Test\n";
+
+class DesktopFileIndexTest : public ::testing::Test {
+ public:
+  DesktopFileIndexTest() {
+    CHECK(temp_dir_.CreateUniqueTempDir());
+    apps_dir_ = temp_dir_.GetPath().Append("applications");
+    CHECK(base::CreateDirectory(apps_dir_));
+    file_path_ = apps_dir_.Append("test.desktop");
+    CHECK(base::WriteFile(file_path_, kDesktopFileContents));
+  }
+  DesktopFileIndexTest(const DesktopFileIndexTest&) = delete;
+  DesktopFileIndexTest& operator=(const DesktopFileIndexTest&) = delete;
+
+  ~DesktopFileIndexTest() override = default;
+
+  // Scans the test .desktop file only, as if it had |last_modified|.
+  const DesktopFile* Scan(base::Time last_modified) {
+    index_.StartScan();
+    const DesktopFile* desktop_file = index_.AddFile(
+        file_path_, last_modified, sizeof(kDesktopFileContents) - 1);
+    index_.FinishScan();
+    return desktop_file;
+  }
+
+ protected:
+  base::ScopedTempDir temp_dir_;
+  base::FilePath apps_dir_;
+  base::FilePath file_path_;
+  DesktopFileIndex index_;
+};
+
+TEST_F(DesktopFileIndexTest, UnchangedFileIsKept) {
+  const base::Time last_modified = base::Time::Now();
+  const DesktopFile* desktop_file = Scan(last_modified);
+  ASSERT_NE(desktop_file, nullptr);
+  EXPECT_EQ(desktop_file->app_id(), "test");
+
+  EXPECT_EQ(Scan(last_modified), desktop_file);
+}
+
+TEST_F(DesktopFileIndexTest, ModifiedFileIsParsedAgain) {
+  const base::Time last_modified = base::Time::Now();
+  Scan(last_modified);
+  index_.SetPackageId(file_path_, "test;1.0;amd64;main",
+                      index_.package_ids_generation());
+
+  ASSERT_NE(Scan(last_modified + base::Seconds(1)), nullptr);
+  EXPECT_EQ(index_.GetPackageId(file_path_), std::nullopt);
+}
+
+TEST_F(DesktopFileIndexTest, RemovedFileIsForgotten) {
+  Scan(base::Time::Now());
+  index_.SetPackageId(file_path_, "test;1.0;amd64;main",
+                      index_.package_ids_generation());
+
+  index_.StartScan();
+  index_.FinishScan();
+  EXPECT_EQ(index_.GetPackageId(file_path_), std::nullopt);
+}
+
+TEST_F(DesktopFileIndexTest, PackageIdIsCached) {
+  const base::Time last_modified = base::Time::Now();
+  Scan(last_modified);
+  EXPECT_EQ(index_.GetPackageId(file_path_), std::nullopt);
+
+  index_.SetPackageId(file_path_, "test;1.0;amd64;main",
+                      index_.package_ids_generation());
+  Scan(last_modified);
+  EXPECT_EQ(index_.GetPackageId(file_path_), "test;1.0;amd64;main");
+}
+
+TEST_F(DesktopFileIndexTest, PackageIdsAreInvalidated) {
+  const base::Time last_modified = base::Time::Now();
+  Scan(last_modified);
+  index_.SetPackageId(file_path_, "test;1.0;amd64;main",
+                      index_.package_ids_generation());
+
+  // A package was installed or removed, without touching the .desktop file.
+  index_.InvalidatePackageIds();
+  Scan(last_modified);
+  EXPECT_EQ(index_.GetPackageId(file_path_), std::nullopt);
+}
+
+TEST_F(DesktopFileIndexTest, PackageIdLookedUpBeforeInvalidationIsDropped) {
+  Scan(base::Time::Now());
+  const uint64_t generation = index_.package_ids_generation();
+
+  index_.InvalidatePackageIds();
+  index_.SetPackageId(file_path_, "test;1.0;amd64;main", generation);
+  EXPECT_EQ(index_.GetPackageId(file_path_), std::nullopt);
+}
+
+}  // namespace
+
+}  // namespace garcon
+}  // namespace vm_tools
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -372,6 +373,11 @@ void HostNotifier::OnInstallCompletion(const std::string& command_uuid,
       FROM_HERE,
       base::BindOnce(&SendInstallStatusToHost, base::Unretained(stub_.get()),
                      std::move(progress_info)));
+  // Packages may have been upgraded or replaced without changing their
+  // .desktop files, so the cached package IDs can't be trusted anymore.
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&DesktopFileIndex::InvalidatePackageIds,
+                                base::Unretained(&desktop_file_index_)));
 }
 
 void HostNotifier::OnInstallProgress(
@@ -406,6 +412,11 @@ void HostNotifier::OnUninstallCompletion(bool success,
       FROM_HERE,
       base::BindOnce(&SendUninstallStatusToHost, base::Unretained(stub_.get()),
                      std::move(info)));
+  // Packages may have been upgraded or replaced without changing their
+  // .desktop files, so the cached package IDs can't be trusted anymore.
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&DesktopFileIndex::InvalidatePackageIds,
+                                base::Unretained(&desktop_file_index_)));
 }
 
 void HostNotifier::OnUninstallProgress(uint32_t percent_progress) {
@@ -688,6 +699,8 @@ void HostNotifier::SendAppListToHost() {
   // recursively and then perform the search.
   std::vector<base::FilePath> search_paths =
       DesktopFile::GetPathsForDesktopFiles();
+  // Only the .desktop files which changed since the last run are parsed.
+  desktop_file_index_.StartScan();
   for (auto curr_path : search_paths) {
     base::FileEnumerator file_enum(curr_path, true,
                                    base::FileEnumerator::FILES);
@@ -696,13 +709,12 @@ void HostNotifier::SendAppListToHost() {
       if (enum_path.FinalExtension() != kDesktopFileExtension) {
         continue;
       }
-      // We have a .desktop file path, parse it and then add it to the
+      // We have a .desktop file path, get it parsed and then add it to the
       // protobuf if it parses successfully.
-      std::unique_ptr<DesktopFile> desktop_file =
-          DesktopFile::ParseDesktopFile(enum_path);
+      const base::FileEnumerator::FileInfo info = file_enum.GetInfo();
+      const DesktopFile* desktop_file = desktop_file_index_.AddFile(
+          enum_path, info.GetLastModifiedTime(), info.GetSize());
       if (!desktop_file) {
-        LOG(WARNING) << "Failed parsing the .desktop file: "
-                     << enum_path.value();
         continue;
       }
 
@@ -779,6 +791,8 @@ void HostNotifier::SendAppListToHost() {
   CHECK_EQ(callback_state->desktop_files_for_application.size(),
            callback_state->request.application_size());
 
+  desktop_file_index_.FinishScan();
+
   // We now want to query all the .desktop files to see what package owns them.
   // Unforuntately, this requires D-Bus calls to the PackageKit, and we are on
   // the D-Bus thread. So we can't receive the results until this function
@@ -788,6 +802,8 @@ void HostNotifier::SendAppListToHost() {
   // that file and also kick off the query for the next file until all files
   // have been queried.
   callback_state->num_package_id_queries_completed = 0;
+  callback_state->package_ids_generation =
+      desktop_file_index_.package_ids_generation();
 
   // Clear this in case it was set, this all happens on the same thread.
   // Clear this now, not when the package_id callbacks are complete, in case
@@ -806,17 +822,42 @@ void HostNotifier::SendAppListToHost() {
 
 void HostNotifier::RequestNextPackageIdOrCompleteUpdateApplicationList(
     std::unique_ptr<AppListBuilderState> state) {
+  // Reuse the package_id of the .desktop files which didn't change.
+  while (state->num_package_id_queries_completed <
+         state->desktop_files_for_application.size()) {
+    std::optional<std::string> package_id = desktop_file_index_.GetPackageId(
+        state->desktop_files_for_application
+            [state->num_package_id_queries_completed]);
+    if (!package_id) {
+      break;
+    }
+    if (!package_id->empty()) {
+      state->request
+          .mutable_application(state->num_package_id_queries_completed)
+          ->set_package_id(*package_id);
+    }
+    state->num_package_id_queries_completed++;
+  }
+
   if ((state->num_package_id_queries_completed >=
        state->desktop_files_for_application.size())) {
     // We have finished all package_id queries. This data is ready to send to
-    // the host.
+    // the host, unless it already has it.
     send_app_list_to_host_in_progress_ = false;
+    std::string app_list = state->request.SerializeAsString();
+    if (app_list == last_app_list_sent_) {
+      VLOG(3) << "Application list unchanged";
+      NotifyHostOfPendingAppListUpdates();
+      return;
+    }
     vm_tools::EmptyMessage empty;
     grpc::ClientContext ctx;
     grpc::Status status =
         stub_->UpdateApplicationList(&ctx, state->request, &empty);
     VLOG(3) << "UpdatedApplicationList\n" << state->request.DebugString();
-    if (!status.ok()) {
+    if (status.ok()) {
+      last_app_list_sent_ = std::move(app_list);
+    } else {
       LOG(WARNING) << "Failed to notify host of the application list: "
                    << status.error_message();
     }
@@ -849,6 +890,14 @@ void HostNotifier::PackageIdCallback(
   } else if (!success) {
     LOG(ERROR) << "Failed to get Package Info: " << error;
   }
+  if (success) {
+    // Remember the result for the next application list.
+    desktop_file_index_.SetPackageId(
+        state->desktop_files_for_application
+            [state->num_package_id_queries_completed],
+        pkg_found ? pkg_info.package_id : std::string(),
+        state->package_ids_generation);
+  }
 
   state->num_package_id_queries_completed++;
   task_runner_->PostTask(
@@ -22,6 +22,7 @@
 #include <base/memory/weak_ptr.h>
 
 #include "vm_tools/garcon/ansible_playbook_application.h"
+#include "vm_tools/garcon/desktop_file_index.h"
 #include "vm_tools/garcon/package_kit_proxy.h"
 
 namespace vm_tools {
@@ -142,6 +143,10 @@ class HostNotifier : public PackageKitProxy::PackageKitObserver,
     // Thus, also the index of the next .desktop file we need to query for
     // its package_id.
     int num_package_id_queries_completed = 0;
+
+    // The package IDs generation of |desktop_file_index_| when the queries
+    // started.
+    uint64_t package_ids_generation = 0;
   };
 
   explicit HostNotifier(const std::string& token);
@@ -221,6 +226,13 @@ class HostNotifier : public PackageKitProxy::PackageKitObserver,
   // completed yet.
   bool send_app_list_to_host_in_progress_;
 
+  // The .desktop files found by the last SendAppListToHost.
+  DesktopFileIndex desktop_file_index_;
+
+  // The application list last sent to the host, serialized. An identical list
+  // is not sent again.
+  std::string last_app_list_sent_;
+
   // True if there is currently a delayed task pending for updating the
   // MIME types list.
   bool update_mime_types_posted_;
@@ -5,12 +5,17 @@
 #include "vm_tools/garcon/icon_finder.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include <base/files/file.h>
 #include <base/files/file_path.h>
 #include <base/files/file_util.h>
 #include <base/logging.h>
+#include <base/no_destructor.h>
+#include <base/synchronization/lock.h>
 #include <base/strings/string_split.h>
 #include <base/strings/stringprintf.h>
 #include "vm_tools/garcon/desktop_file.h"
@@ -43,15 +48,81 @@ std::vector<base::FilePath> GetPathsForIconIndexDirs() {
   return retval;
 }
 
+// Caches the index.theme files of the icon theme directories, and the
+// directories they list for each icon size, so that they are only parsed again
+// after they change rather than for every icon looked up.
+class IconIndexCache {
+ public:
+  IconIndexCache() = default;
+  IconIndexCache(const IconIndexCache&) = delete;
+  IconIndexCache& operator=(const IconIndexCache&) = delete;
+
+  static IconIndexCache* Get() {
+    static base::NoDestructor<IconIndexCache> cache;
+    return cache.get();
+  }
+
+  // Stores the directories to search for an icon of |icon_size| and |scale|
+  // in the theme of |icon_dir| into |paths|. Returns false if the theme has no
+  // index.theme file.
+  bool GetPathsForIcons(const base::FilePath& icon_dir,
+                        int icon_size,
+                        int scale,
+                        std::vector<base::FilePath>* paths) {
+    base::File::Info info;
+    if (!base::GetFileInfo(icon_dir.Append("index.theme"), &info))
+      info = base::File::Info();
+
+    base::AutoLock lock(lock_);
+    Entry& entry = entries_[icon_dir];
+    if (!entry.parsed || entry.last_modified != info.last_modified ||
+        entry.size != info.size) {
+      entry.parsed = true;
+      entry.last_modified = info.last_modified;
+      entry.size = info.size;
+      entry.index_file = info.size ? IconIndexFile::ParseIconIndexFile(icon_dir)
+                                   : nullptr;
+      entry.paths.clear();
+    }
+    if (!entry.index_file)
+      return false;
+
+    auto it = entry.paths.find({icon_size, scale});
+    if (it == entry.paths.end()) {
+      it = entry.paths
+               .emplace(std::make_pair(icon_size, scale),
+                        entry.index_file->GetPathsForSizeAndScale(icon_size,
+                                                                  scale))
+               .first;
+    }
+    *paths = it->second;
+    return true;
+  }
+
+ private:
+  struct Entry {
+    bool parsed = false;
+    base::Time last_modified;
+    int64_t size = 0;
+    std::unique_ptr<IconIndexFile> index_file;
+    // Directories to search, keyed by icon size and scale.
+    std::map<std::pair<int, int>, std::vector<base::FilePath>> paths;
+  };
+
+  // Icons may be looked up from several gRPC threads.
+  base::Lock lock_;
+  std::map<base::FilePath, Entry> entries_;
+};
+
 }  // namespace
 
 std::vector<base::FilePath> GetPathsForIcons(const base::FilePath& icon_dir,
                                              int icon_size,
                                              int scale) {
-  std::unique_ptr<IconIndexFile> icon_index_file =
-      IconIndexFile::ParseIconIndexFile(icon_dir);
-  if (icon_index_file) {
-    return icon_index_file->GetPathsForSizeAndScale(icon_size, scale);
+  std::vector<base::FilePath> paths;
+  if (IconIndexCache::Get()->GetPathsForIcons(icon_dir, icon_size, scale,
+                                              &paths)) {
+    return paths;
   } else {
     // Index files aren't always present, so do our best to try to find
     // something that'll work.
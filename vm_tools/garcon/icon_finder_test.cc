@@ -127,6 +127,39 @@ TEST_F(IconFinderTest, CorrectDirsReturned) {
   EXPECT_TRUE(GetPathsForIcons(icon_theme_dir(), 48, 1) == expected_dirs);
 }
 
+// This test verifies that the cached index.theme file is parsed again once it
+// changes.
+TEST_F(IconFinderTest, IndexThemeChangeIsPickedUp) {
+  EXPECT_EQ(GetPathsForIcons(icon_theme_dir(), 48, 1).size(), 6u);
+
+  WriteIndexThemeFile(
+      "[Icon Theme]\n"
+      "Name=Hicolor\n"
+      "Directories=48x48/apps\n"
+      "\n"
+      "[48x48/apps]\n"
+      "Size=48\n"
+      "Type=Threshold\n");
+  std::vector<base::FilePath> expected_dirs = {icon_dir()};
+  EXPECT_EQ(GetPathsForIcons(icon_theme_dir(), 48, 1), expected_dirs);
+  // The cached directories are returned again.
+  EXPECT_EQ(GetPathsForIcons(icon_theme_dir(), 48, 1), expected_dirs);
+
+  WriteIndexThemeFile(
+      "[Icon Theme]\n"
+      "Name=Hicolor\n"
+      "Directories=48x48/apps,scalable/apps\n"
+      "\n"
+      "[48x48/apps]\n"
+      "Size=48\n"
+      "Type=Threshold\n"
+      "\n"
+      "[scalable/apps]\n"
+      "Size=48\n"
+      "Type=Scalable\n");
+  EXPECT_EQ(GetPathsForIcons(icon_theme_dir(), 48, 1).size(), 2u);
+}
+
 // This test verifies that empty dir is returned when no desktop file exists.
 TEST_F(IconFinderTest, NoDesktopfileNoDir) {
   EXPECT_TRUE(LocateIconFile("gimp.desktop", 48, 1) == base::FilePath());
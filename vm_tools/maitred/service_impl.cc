@@ -82,6 +82,12 @@ constexpr char kZoneInfoPath[] = "/usr/share/zoneinfo";
 
 constexpr int64_t kGiB = 1024 * 1024 * 1024;
 
+// Largest 9P message size to negotiate with the server. The kernel defaults to
+// a few pages, which takes a round trip per few pages of file I/O. This is the
+// largest message size for the fd transport, and the server may negotiate a
+// smaller one.
+constexpr int k9PMsize = 1024 * 1024;
+
 constexpr char kLogindManagerInterface[] = "org.freedesktop.login1.Manager";
 constexpr char kLogindServicePath[] = "/org/freedesktop/login1";
 constexpr char kLogindServiceName[] = "org.freedesktop.login1";
@@ -1024,8 +1030,9 @@ grpc::Status ServiceImpl::Mount9P(grpc::ServerContext* ctx,
 
   // Do the mount.
   string data = base::StringPrintf(
-      "trans=fd,rfdno=%d,wfdno=%d,cache=none,access=any,version=9p2000.L",
-      server.get(), server.get());
+      "trans=fd,rfdno=%d,wfdno=%d,msize=%d,cache=none,access=any,"
+      "version=9p2000.L",
+      server.get(), server.get(), k9PMsize);
   if (mount("9p", request->target().c_str(), "9p", MS_NOSUID | MS_NODEV,
             data.c_str()) != 0) {
     response->set_error(errno);
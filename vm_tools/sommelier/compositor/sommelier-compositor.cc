@@ -7,6 +7,7 @@
 #include "../sommelier-tracing.h"    // NOLINT(build/include_directory)
 #include "../sommelier-transform.h"  // NOLINT(build/include_directory)
 #include "../sommelier-xshape.h"     // NOLINT(build/include_directory)
+#include "sommelier-copy.h"          // NOLINT(build/include_directory)
 #include "sommelier-dma-buf.h"       // NOLINT(build/include_directory)
 
 #include <assert.h>
@@ -21,6 +22,8 @@
 #include <wayland-client.h>
 #include <wayland-util.h>
 
+#include <vector>
+
 #include "drm-server-protocol.h"  // NOLINT(build/include_directory)
 #include "linux-dmabuf-unstable-v1-client-protocol.h"  // NOLINT(build/include_directory)
 #include "linux-explicit-synchronization-unstable-v1-client-protocol.h"  // NOLINT(build/include_directory)
@@ -532,13 +535,56 @@ static void sl_host_surface_frame(struct wl_client* client,
                            host_callback);
 }
 
-static void copy_damaged_rect(sl_host_surface* host,
-                              pixman_box32_t* rect,
-                              bool shaped,
-                              double scale_x,
-                              double scale_y,
-                              double offset_x,
-                              double offset_y) {
+// Returns the rect enclosing |rect| after applying scale and offset, clipped
+// to the contents of |host|.
+static pixman_box32_t transform_damaged_rect(sl_host_surface* host,
+                                             const pixman_box32_t* rect,
+                                             double scale_x,
+                                             double scale_y,
+                                             double offset_x,
+                                             double offset_y) {
+  int32_t x1, y1, x2, y2;
+
+  x1 = rect->x1 * scale_x + offset_x;
+  y1 = rect->y1 * scale_y + offset_y;
+  x2 = rect->x2 * scale_x + offset_x + 0.5;
+  y2 = rect->y2 * scale_y + offset_y + 0.5;
+
+  x1 = MAX(0, x1);
+  y1 = MAX(0, y1);
+  x2 = MIN(static_cast<int32_t>(host->contents_width), x2);
+  y2 = MIN(static_cast<int32_t>(host->contents_height), y2);
+
+  return {x1, y1, x2, y2};
+}
+
+// Adds the rects of |region|, after applying scale and offset, to |damage|.
+static void union_damaged_rects(sl_host_surface* host,
+                                pixman_region32_t* region,
+                                double scale_x,
+                                double scale_y,
+                                double offset_x,
+                                double offset_y,
+                                pixman_region32_t* damage) {
+  int n;
+  pixman_box32_t* rect = pixman_region32_rectangles(region, &n);
+  while (n--) {
+    pixman_box32_t box = transform_damaged_rect(host, rect, scale_x, scale_y,
+                                                offset_x, offset_y);
+    if (box.x1 < box.x2 && box.y1 < box.y2) {
+      pixman_region32_union_rect(damage, damage, box.x1, box.y1,
+                                 box.x2 - box.x1, box.y2 - box.y1);
+    }
+    ++rect;
+  }
+}
+
+// Appends the copies of each plane needed for the damaged |rect|, in buffer
+// coordinates, to |copies|.
+static void append_damaged_rect_copies(sl_host_surface* host,
+                                       const pixman_box32_t* rect,
+                                       bool shaped,
+                                       std::vector<sl_copy_rect>* copies) {
   uint8_t* src_addr = static_cast<uint8_t*>(host->contents_shm_mmap->addr);
   uint8_t* dst_addr = static_cast<uint8_t*>(host->current_buffer->mmap->addr);
   size_t* src_offset = host->contents_shm_mmap->offset;
@@ -548,7 +594,6 @@ static void copy_damaged_rect(sl_host_surface* host,
   size_t* y_ss = host->contents_shm_mmap->y_ss;
   size_t bpp = host->contents_shm_mmap->bpp;
   size_t num_planes = host->contents_shm_mmap->num_planes;
-  int32_t x1, y1, x2, y2;
   size_t null_set[3] = {0, 0, 0};
   size_t shape_stride[3] = {0, 0, 0};
 
@@ -565,38 +610,26 @@ static void copy_damaged_rect(sl_host_surface* host,
         pixman_image_get_stride(host->current_buffer->shape_image);
   }
 
-  // Enclosing rect after applying scale and offset.
-  x1 = rect->x1 * scale_x + offset_x;
-  y1 = rect->y1 * scale_y + offset_y;
-  x2 = rect->x2 * scale_x + offset_x + 0.5;
-  y2 = rect->y2 * scale_y + offset_y + 0.5;
-
-  x1 = MAX(0, x1);
-  y1 = MAX(0, y1);
-  x2 = MIN(static_cast<int32_t>(host->contents_width), x2);
-  y2 = MIN(static_cast<int32_t>(host->contents_height), y2);
-
-  if (x1 < x2 && y1 < y2) {
-    size_t i;
-
-    for (i = 0; i < num_planes; ++i) {
-      uint8_t* src_base = src_addr + src_offset[i];
-      uint8_t* dst_base = dst_addr + dst_offset[i];
-      uint8_t* src = src_base + y1 * src_stride[i] + x1 * bpp;
-      uint8_t* dst = dst_base + y1 * dst_stride[i] + x1 * bpp;
-      int32_t width = x2 - x1;
-      int32_t height = (y2 - y1) / y_ss[i];
-      size_t bytes = width * bpp;
-
-      while (height--) {
-        memcpy(dst, src, bytes);
-        dst += dst_stride[i];
-        src += src_stride[i];
-      }
-    }
+  for (size_t i = 0; i < num_planes; ++i) {
+    uint8_t* src_base = src_addr + src_offset[i];
+    uint8_t* dst_base = dst_addr + dst_offset[i];
+    sl_copy_rect copy;
+    copy.src = src_base + rect->y1 * src_stride[i] + rect->x1 * bpp;
+    copy.src_stride = src_stride[i];
+    copy.dst = dst_base + rect->y1 * dst_stride[i] + rect->x1 * bpp;
+    copy.dst_stride = dst_stride[i];
+    copy.bytes = (rect->x2 - rect->x1) * bpp;
+    copy.rows = (rect->y2 - rect->y1) / y_ss[i];
+    copies->push_back(copy);
   }
 }
 
+// Returns the engine copying the damaged contents on commit.
+static CopyEngine* sl_copy_engine() {
+  static CopyEngine engine(CopyEngine::DefaultNumWorkers());
+  return &engine;
+}
+
 static void sl_host_surface_commit(struct wl_client* client,
                                    struct wl_resource* resource) {
   auto resource_id = try_wl_resource_get_id(resource);
@@ -666,33 +699,37 @@ static void sl_host_surface_commit(struct wl_client* client,
       host->current_buffer->mmap->begin_write(host->current_buffer->mmap->fd,
                                               host->ctx);
 
-    // Copy damaged regions (surface-relative coordinates).
+    // Merge the damaged regions in buffer coordinates, so that the pixels
+    // damaged in both the surface and buffer coordinates, and the overlapping
+    // rects after scaling, are only copied once.
+    pixman_region32_t damage;
+    pixman_region32_init(&damage);
+    union_damaged_rects(host, &host->current_buffer->surface_damage,
+                        contents_scale_x, contents_scale_y,
+                        wl_fixed_to_double(contents_offset_x),
+                        wl_fixed_to_double(contents_offset_y), &damage);
+    union_damaged_rects(host, &host->current_buffer->buffer_damage, 1.0, 1.0,
+                        0.0, 0.0, &damage);
+
+    std::vector<sl_copy_rect> copies;
     int n;
-    pixman_box32_t* rect =
-        pixman_region32_rectangles(&host->current_buffer->surface_damage, &n);
+    pixman_box32_t* rect = pixman_region32_rectangles(&damage, &n);
     while (n--) {
-      TRACE_EVENT("surface",
-                  "sl_host_surface_commit: memcpy_loop (surface damage)");
-      copy_damaged_rect(host, rect, host->contents_shaped, contents_scale_x,
-                        contents_scale_y, wl_fixed_to_double(contents_offset_x),
-                        wl_fixed_to_double(contents_offset_y));
+      append_damaged_rect_copies(host, rect, host->contents_shaped, &copies);
       ++rect;
     }
+    pixman_region32_fini(&damage);
 
-    // Copy damaged regions (buffer-relative coordinates).
-    //
-    // In theory, if we've accumulated both surface damage and buffer damage,
-    // it might be more efficient to first transform and union the regions, so
-    // that we won't ever copy the same pixel twice.
-    // In practice, wl_surface::damage_buffer obsoletes wl_surface::damage, and
-    // it doesn't seem worthwhile to optimize for the edge case in which an app
-    // uses both in the same frame.
-    rect = pixman_region32_rectangles(&host->current_buffer->buffer_damage, &n);
-    while (n--) {
-      TRACE_EVENT("surface",
-                  "sl_host_surface_commit: memcpy_loop (buffer damage)");
-      copy_damaged_rect(host, rect, host->contents_shaped, 1.0, 1.0, 0.0, 0.0);
-      ++rect;
+    {
+      TRACE_EVENT("surface", "sl_host_surface_commit: copy damage",
+                  "num_rects", copies.size());
+      sl_copy_engine()->Copy(copies.data(), copies.size());
+    }
+    if (host->ctx->timing != nullptr) {
+      size_t bytes = 0;
+      for (const sl_copy_rect& copy : copies)
+        bytes += copy.bytes * copy.rows;
+      host->ctx->timing->UpdateFrameCopy(bytes);
     }
 
     if (host->current_buffer->mmap->end_write)
@@ -704,6 +741,8 @@ static void sl_host_surface_commit(struct wl_client* client,
 
     wl_list_remove(&host->current_buffer->link);
     wl_list_insert(&host->busy_buffers, &host->current_buffer->link);
+  } else if (host->proxy_buffer && host->ctx->timing != nullptr) {
+    host->ctx->timing->UpdateFramePassthrough();
   }
 
   if (host->contents_width && host->contents_height) {
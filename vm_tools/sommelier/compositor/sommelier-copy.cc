@@ -0,0 +1,161 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sommelier-copy.h"  // NOLINT(build/include_directory)
+
+#include <string.h>
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Copies a row with non-temporal stores, falling back to memcpy() where they
+// are not available.
+void copy_row_non_temporal(uint8_t* dst, const uint8_t* src, size_t bytes) {
+#if defined(__SSE2__)
+  // Streaming stores need an aligned destination.
+  size_t head = (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15;
+  head = std::min(head, bytes);
+  memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  bytes -= head;
+
+  for (; bytes >= 64; bytes -= 64, dst += 64, src += 64) {
+    const __m128i* s = reinterpret_cast<const __m128i*>(src);
+    __m128i* d = reinterpret_cast<__m128i*>(dst);
+    __m128i a = _mm_loadu_si128(s);
+    __m128i b = _mm_loadu_si128(s + 1);
+    __m128i c = _mm_loadu_si128(s + 2);
+    __m128i e = _mm_loadu_si128(s + 3);
+    _mm_stream_si128(d, a);
+    _mm_stream_si128(d + 1, b);
+    _mm_stream_si128(d + 2, c);
+    _mm_stream_si128(d + 3, e);
+  }
+#endif
+  memcpy(dst, src, bytes);
+}
+
+}  // namespace
+
+CopyEngine::CopyEngine(size_t num_workers) {
+  for (size_t i = 0; i < num_workers; ++i)
+    workers_.emplace_back(&CopyEngine::WorkerMain, this);
+}
+
+CopyEngine::~CopyEngine() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_)
+    worker.join();
+}
+
+// static
+size_t CopyEngine::DefaultNumWorkers() {
+  // Leave at least half of the CPUs to the clients, which render the frames.
+  return std::min<size_t>(std::thread::hardware_concurrency() / 2, 3);
+}
+
+void CopyEngine::Copy(const sl_copy_rect* rects, size_t count) {
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < count; ++i)
+    total_bytes += rects[i].bytes * rects[i].rows;
+
+  bands_.clear();
+  const bool parallel = !workers_.empty() && total_bytes >= kMinParallelBytes;
+  for (size_t i = 0; i < count; ++i) {
+    const sl_copy_rect& rect = rects[i];
+    if (!rect.bytes || !rect.rows)
+      continue;
+    size_t band_rows = rect.rows;
+    if (parallel) {
+      band_rows = std::max<size_t>(
+          kMinBandBytes / rect.bytes,
+          (rect.rows + workers_.size()) / (workers_.size() + 1));
+      band_rows = std::clamp<size_t>(band_rows, 1, rect.rows);
+    }
+    for (size_t row = 0; row < rect.rows; row += band_rows) {
+      bands_.push_back({&rect, row, std::min(band_rows, rect.rows - row)});
+    }
+  }
+
+  if (!parallel || bands_.size() < 2) {
+    next_band_ = 0;
+    RunBands(bands_.data(), bands_.size());
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    next_band_ = 0;
+    num_bands_ = bands_.size();
+    ++generation_;
+  }
+  work_cv_.notify_all();
+  RunBands(bands_.data(), bands_.size());
+
+  // All the bands are taken once RunBands() returns, so wait for the workers
+  // still copying theirs.
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+  num_bands_ = 0;
+}
+
+// static
+void CopyEngine::CopyBand(const Band& band) {
+  const sl_copy_rect& rect = *band.rect;
+  const uint8_t* src = rect.src + band.first_row * rect.src_stride;
+  uint8_t* dst = rect.dst + band.first_row * rect.dst_stride;
+  const bool non_temporal = rect.bytes * rect.rows >= kMinNonTemporalBytes;
+  for (size_t row = 0; row < band.rows; ++row) {
+    if (non_temporal)
+      copy_row_non_temporal(dst, src, rect.bytes);
+    else
+      memcpy(dst, src, rect.bytes);
+    src += rect.src_stride;
+    dst += rect.dst_stride;
+  }
+}
+
+void CopyEngine::RunBands(const Band* bands, size_t num_bands) {
+  for (size_t i = next_band_++; i < num_bands; i = next_band_++)
+    CopyBand(bands[i]);
+#if defined(__SSE2__)
+  // Make the non-temporal stores visible before reporting the copy as done.
+  _mm_sfence();
+#endif
+}
+
+void CopyEngine::WorkerMain() {
+  uint64_t seen_generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this, seen_generation] {
+      return quit_ || generation_ != seen_generation;
+    });
+    if (quit_)
+      return;
+    seen_generation = generation_;
+    // The copy may be over already.
+    if (num_bands_ == 0)
+      continue;
+
+    ++busy_workers_;
+    const Band* bands = bands_.data();
+    const size_t num_bands = num_bands_;
+    lock.unlock();
+    RunBands(bands, num_bands);
+    lock.lock();
+    if (--busy_workers_ == 0)
+      done_cv_.notify_all();
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef VM_TOOLS_SOMMELIER_COMPOSITOR_SOMMELIER_COPY_H_
+#define VM_TOOLS_SOMMELIER_COMPOSITOR_SOMMELIER_COPY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A rectangle of |rows| rows of |bytes| bytes, to be copied from |src| to
+// |dst|.
+struct sl_copy_rect {
+  const uint8_t* src;
+  size_t src_stride;
+  uint8_t* dst;
+  size_t dst_stride;
+  size_t bytes;
+  size_t rows;
+};
+
+// Copies the damaged rectangles of surfaces into their output buffers.
+//
+// Batches larger than kMinParallelBytes are split in bands of rows, which are
+// copied by the worker threads and the calling thread together. Rectangles
+// larger than kMinNonTemporalBytes are written with non-temporal stores where
+// available, so that the output buffer, which is only read by the host, does
+// not evict the cache.
+class CopyEngine {
+ public:
+  static const size_t kMinParallelBytes = 1024 * 1024;
+  static const size_t kMinBandBytes = 256 * 1024;
+  static const size_t kMinNonTemporalBytes = 512 * 1024;
+
+  // Starts |num_workers| worker threads. With none, the copies are done on
+  // the calling thread only.
+  explicit CopyEngine(size_t num_workers);
+  CopyEngine(const CopyEngine&) = delete;
+  CopyEngine& operator=(const CopyEngine&) = delete;
+  ~CopyEngine();
+
+  // Returns the number of worker threads to use on this machine.
+  static size_t DefaultNumWorkers();
+
+  // Copies the |count| rectangles of |rects|, and returns once done.
+  void Copy(const sl_copy_rect* rects, size_t count);
+
+ private:
+  // A band of rows of a rectangle.
+  struct Band {
+    const sl_copy_rect* rect;
+    size_t first_row;
+    size_t rows;
+  };
+
+  static void CopyBand(const Band& band);
+  void RunBands(const Band* bands, size_t num_bands);
+  void WorkerMain();
+
+  std::vector<std::thread> workers_;
+  std::vector<Band> bands_;
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  // The following are guarded by |mutex_|.
+  uint64_t generation_ = 0;
+  size_t num_bands_ = 0;
+  size_t busy_workers_ = 0;
+  bool quit_ = false;
+
+  // Index of the next band to copy.
+  std::atomic<size_t> next_band_{0};
+};
+
+#endif  // VM_TOOLS_SOMMELIER_COMPOSITOR_SOMMELIER_COPY_H_
@@ -7,7 +7,11 @@
 #include "../sommelier-util.h"     // NOLINT(build/include_directory)
 
 #include <assert.h>
+#include <fcntl.h>
+#include <libdrm/drm_fourcc.h>
+#include <linux/udmabuf.h>
 #include <stdlib.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 #include <wayland-client.h>
 
@@ -19,6 +23,12 @@ struct sl_host_shm_pool {
   struct wl_resource* resource;
   struct wl_shm_pool* proxy;
   int fd;
+  int32_t size;
+  // A dma-buf of the pool memory shared with the host, with
+  // --shm-passthrough.
+  int dmabuf_fd;
+  size_t dmabuf_size;
+  bool dmabuf_failed;
 };
 
 struct sl_host_shm {
@@ -123,6 +133,85 @@ static size_t sl_size_for_shm_format(uint32_t format,
   return total_size;
 }
 
+// Returns the udmabuf device, or -1 if the kernel doesn't provide it.
+static int sl_udmabuf_device() {
+  static int fd = open("/dev/udmabuf", O_RDWR | O_CLOEXEC);
+  return fd;
+}
+
+// Returns a dma-buf of the pool memory which the channel can send to the
+// host, or -1 if the pool can't be shared.
+static int sl_host_shm_pool_get_dmabuf(struct sl_host_shm_pool* host) {
+  if (host->dmabuf_fd >= 0 || host->dmabuf_failed)
+    return host->dmabuf_fd;
+
+  // Don't try again until the pool is resized.
+  host->dmabuf_failed = true;
+  int device = sl_udmabuf_device();
+  if (device < 0)
+    return -1;
+
+  // The udmabuf driver only takes whole pages of memfds sealed against
+  // shrinking, and fails otherwise.
+  struct udmabuf_create create = {};
+  create.memfd = host->fd;
+  create.flags = UDMABUF_FLAGS_CLOEXEC;
+  create.offset = 0;
+  create.size = host->size & ~(static_cast<int64_t>(getpagesize()) - 1);
+  if (!create.size)
+    return -1;
+  int fd = ioctl(device, UDMABUF_CREATE, &create);
+  if (fd < 0)
+    return -1;
+
+  if (!host->shm->ctx->channel->supports_dmabuf_import(fd)) {
+    close(fd);
+    return -1;
+  }
+
+  host->dmabuf_fd = fd;
+  host->dmabuf_size = create.size;
+  host->dmabuf_failed = false;
+  return fd;
+}
+
+// Creates a host buffer sharing the memory of the pool, so that it is not
+// copied on commit. Returns nullptr if the pool can't be shared, in which case
+// the contents are copied to an output buffer.
+static struct wl_buffer* sl_host_shm_pool_create_dmabuf_proxy(
+    struct sl_host_shm_pool* host,
+    int32_t offset,
+    int32_t width,
+    int32_t height,
+    int32_t stride,
+    uint32_t format) {
+  struct sl_context* ctx = host->shm->ctx;
+  if (!ctx->use_shm_passthrough || !ctx->linux_dmabuf || offset < 0)
+    return nullptr;
+
+  int dmabuf_fd = sl_host_shm_pool_get_dmabuf(host);
+  if (dmabuf_fd < 0 ||
+      offset + sl_size_for_shm_format(format, height, stride) >
+          host->dmabuf_size) {
+    return nullptr;
+  }
+
+  struct zwp_linux_buffer_params_v1* buffer_params =
+      zwp_linux_dmabuf_v1_create_params(ctx->linux_dmabuf->internal);
+  size_t num_planes = sl_shm_num_planes_for_shm_format(format);
+  for (size_t i = 0; i < num_planes; ++i) {
+    zwp_linux_buffer_params_v1_add(
+        buffer_params, dmabuf_fd, i,
+        offset + sl_offset_for_shm_format_plane(format, height, stride, i),
+        stride, DRM_FORMAT_MOD_LINEAR >> 32,
+        DRM_FORMAT_MOD_LINEAR & 0xffffffff);
+  }
+  struct wl_buffer* proxy = zwp_linux_buffer_params_v1_create_immed(
+      buffer_params, width, height, sl_drm_format_for_shm_format(format), 0);
+  zwp_linux_buffer_params_v1_destroy(buffer_params);
+  return proxy;
+}
+
 static void sl_host_shm_pool_create_host_buffer(struct wl_client* client,
                                                 struct wl_resource* resource,
                                                 uint32_t id,
@@ -144,8 +233,13 @@ static void sl_host_shm_pool_create_host_buffer(struct wl_client* client,
     return;
   }
 
-  struct sl_host_buffer* host_buffer = sl_create_host_buffer(
-      host->shm->ctx, client, id, nullptr, width, height, /*is_drm=*/false);
+  // Buffers shared with the host are attached as is, like dma-bufs. Their
+  // mmap is still created for shaped windows.
+  struct wl_buffer* proxy = sl_host_shm_pool_create_dmabuf_proxy(
+      host, offset, width, height, stride, format);
+  struct sl_host_buffer* host_buffer =
+      sl_create_host_buffer(host->shm->ctx, client, id, proxy, width, height,
+                            /*is_drm=*/proxy != nullptr);
 
   host_buffer->shm_format = format;
   host_buffer->shm_mmap = sl_mmap_create(
@@ -178,6 +272,14 @@ static void sl_host_shm_pool_resize(struct wl_client* client,
 
   if (host->proxy)
     wl_shm_pool_resize(host->proxy, size);
+
+  // Share the whole pool with the next buffers. The dma-buf of the previous
+  // size is kept alive by the host buffers created from it.
+  host->size = size;
+  if (host->dmabuf_fd >= 0)
+    close(host->dmabuf_fd);
+  host->dmabuf_fd = -1;
+  host->dmabuf_failed = false;
 }
 
 static const struct wl_shm_pool_interface sl_shm_pool_implementation = {
@@ -190,6 +292,8 @@ static void sl_destroy_host_shm_pool(struct wl_resource* resource) {
 
   if (host->fd >= 0)
     close(host->fd);
+  if (host->dmabuf_fd >= 0)
+    close(host->dmabuf_fd);
   if (host->proxy)
     wl_shm_pool_destroy(host->proxy);
   wl_resource_set_user_data(resource, nullptr);
@@ -207,6 +311,10 @@ static void sl_shm_create_host_pool(struct wl_client* client,
 
   host_shm_pool->shm = host->shm;
   host_shm_pool->fd = -1;
+  host_shm_pool->size = size;
+  host_shm_pool->dmabuf_fd = -1;
+  host_shm_pool->dmabuf_size = 0;
+  host_shm_pool->dmabuf_failed = false;
   host_shm_pool->proxy = nullptr;
   host_shm_pool->resource =
       wl_resource_create(client, &wl_shm_pool_interface, 1, id);
@@ -53,6 +53,8 @@ class FrameLog:
         Type Surface_ID Buffer_ID Delta_Time   # header line 1
         a 12 20 4237.44                        # line 2
         ....
+        FrameCopies 1800 3732480000            # copy counters
+        FramePassthroughs 0
         EndTime 3972 1655330324.7              # last line
         Last line format: (EndTime, last event id, time since epoch (s))
         """
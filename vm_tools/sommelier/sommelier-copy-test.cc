@@ -0,0 +1,129 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <vector>
+
+#include "compositor/sommelier-copy.h"  // NOLINT(build/include_directory)
+
+namespace vm_tools {
+namespace sommelier {
+namespace {
+
+// A 32bpp image, with some padding at the end of the rows.
+struct Image {
+  Image(size_t width, size_t height, uint8_t seed)
+      : width(width),
+        height(height),
+        stride(width * 4 + 64),
+        data(stride * height) {
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<uint8_t>(i * 31 + seed);
+  }
+
+  // Returns the copy of the rect at |x|, |y| from this image to |dst|.
+  sl_copy_rect CopyTo(Image* dst,
+                      size_t x,
+                      size_t y,
+                      size_t rect_width,
+                      size_t rect_height) const {
+    return {data.data() + y * stride + x * 4,
+            stride,
+            dst->data.data() + y * dst->stride + x * 4,
+            dst->stride,
+            rect_width * 4,
+            rect_height};
+  }
+
+  // Returns true if the pixels of the rect are the same in both images.
+  bool RectEquals(const Image& other,
+                  size_t x,
+                  size_t y,
+                  size_t rect_width,
+                  size_t rect_height) const {
+    for (size_t row = y; row < y + rect_height; ++row) {
+      if (memcmp(data.data() + row * stride + x * 4,
+                 other.data.data() + row * other.stride + x * 4,
+                 rect_width * 4)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t width;
+  size_t height;
+  size_t stride;
+  std::vector<uint8_t> data;
+};
+
+class CopyEngineTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(CopyEngineTest, CopiesOnlyTheRects) {
+  CopyEngine engine(GetParam());
+  const Image src(1920, 1080, 1);
+  Image dst(1920, 1080, 2);
+  const Image original_dst = dst;
+
+  // A large rect, at an odd offset to test the unaligned stores, and a small
+  // one.
+  std::vector<sl_copy_rect> rects = {
+      src.CopyTo(&dst, 3, 5, 1501, 1000),
+      src.CopyTo(&dst, 1600, 10, 7, 3),
+  };
+  engine.Copy(rects.data(), rects.size());
+
+  EXPECT_TRUE(dst.RectEquals(src, 3, 5, 1501, 1000));
+  EXPECT_TRUE(dst.RectEquals(src, 1600, 10, 7, 3));
+  EXPECT_TRUE(dst.RectEquals(original_dst, 0, 0, 1920, 5));
+  EXPECT_TRUE(dst.RectEquals(original_dst, 0, 5, 3, 1000));
+  EXPECT_TRUE(dst.RectEquals(original_dst, 1504, 13, 416, 992));
+  EXPECT_TRUE(dst.RectEquals(original_dst, 0, 1005, 1920, 75));
+  // The padding at the end of the rows is left alone.
+  EXPECT_EQ(0, memcmp(dst.data.data() + dst.width * 4,
+                      original_dst.data.data() + dst.width * 4, 64));
+}
+
+TEST_P(CopyEngineTest, CopiesRepeatedly) {
+  CopyEngine engine(GetParam());
+  for (uint8_t seed = 0; seed < 20; ++seed) {
+    const Image src(1024, 768, seed);
+    Image dst(1024, 768, seed + 1);
+    sl_copy_rect rect = src.CopyTo(&dst, 0, 0, 1024, 768);
+    engine.Copy(&rect, 1);
+    EXPECT_TRUE(dst.RectEquals(src, 0, 0, 1024, 768));
+  }
+}
+
+// Records the time to copy the full frames of a HiDPI output in the test
+// report.
+TEST_P(CopyEngineTest, FrameTimeBenchmark) {
+  constexpr int kFrames = 10;
+  CopyEngine engine(GetParam());
+  const Image src(3840, 2160, 1);
+  Image dst(3840, 2160, 2);
+  sl_copy_rect rect = src.CopyTo(&dst, 0, 0, 3840, 2160);
+
+  // Fault the pages in before timing.
+  engine.Copy(&rect, 1);
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kFrames; ++i)
+    engine.Copy(&rect, 1);
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  EXPECT_TRUE(dst.RectEquals(src, 0, 0, 3840, 2160));
+  RecordProperty("frame_copy_us", static_cast<int>(elapsed.count() / kFrames));
+}
+
+INSTANTIATE_TEST_SUITE_P(CopyEngineTest,
+                         CopyEngineTest,
+                         ::testing::Values(0, 3));
+
+}  // namespace
+}  // namespace sommelier
+}  // namespace vm_tools
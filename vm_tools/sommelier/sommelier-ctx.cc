@@ -186,6 +186,7 @@ void sl_context_init_default(struct sl_context* ctx) {
   ctx->enable_x11_move_windows = false;
   ctx->trace_system = false;
   ctx->use_direct_scale = false;
+  ctx->use_shm_passthrough = false;
   ctx->stable_scaling = false;
 
   wl_list_init(&ctx->accelerators);
@@ -199,6 +199,7 @@ struct sl_context {
   bool use_explicit_fence;
   bool use_virtgpu_channel;
   bool use_direct_scale;
+  bool use_shm_passthrough;
 
   // Experimental feature flags to be cleaned up.
   bool enable_x11_move_windows;  // TODO(b/247452928): Clean this up.
@@ -52,6 +52,17 @@ void Timing::UpdateLastRelease(int buffer_id) {
   event_id++;
 }
 
+// Count a commit whose damaged contents were copied to the host.
+void Timing::UpdateFrameCopy(size_t bytes) {
+  copied_frames++;
+  copied_bytes += bytes;
+}
+
+// Count a commit of a buffer attached to the host surface without a copy.
+void Timing::UpdateFramePassthrough() {
+  passthrough_frames++;
+}
+
 // Output the recorded actions to the timing log file.
 void Timing::OutputLog() {
   if (event_id == 0) {
@@ -91,6 +102,10 @@ void Timing::OutputLog() {
             << std::endl;
   }
 
+  outfile << "FrameCopies " << copied_frames << " " << copied_bytes
+          << std::endl;
+  outfile << "FramePassthroughs " << passthrough_frames << std::endl;
+
   std::stringstream nsec;
   nsec << std::setw(9) << std::setfill('0') << last_event.tv_nsec;
   outfile << "EndTime " << event_id - 1 << " " << last_event.tv_sec << "."
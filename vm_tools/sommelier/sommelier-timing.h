@@ -5,6 +5,7 @@
 #ifndef VM_TOOLS_SOMMELIER_SOMMELIER_TIMING_H_
 #define VM_TOOLS_SOMMELIER_SOMMELIER_TIMING_H_
 
+#include <stddef.h>
 #include <stdint.h>
 #include <time.h>
 
@@ -18,6 +19,8 @@ class Timing {
   void UpdateLastAttach(int surface_id, int buffer_id);
   void UpdateLastCommit(int surface_id);
   void UpdateLastRelease(int buffer_id);
+  void UpdateFrameCopy(size_t bytes);
+  void UpdateFramePassthrough();
   void OutputLog();
 
  private:
@@ -44,6 +47,11 @@ class Timing {
   BufferAction actions[kMaxNumActions];
   int event_id = 0;
   int saves = 0;
+  // Commits whose contents were copied to an output buffer, and the bytes
+  // copied, versus commits of buffers shared with the host as is.
+  int64_t copied_frames = 0;
+  int64_t copied_bytes = 0;
+  int64_t passthrough_frames = 0;
   const char* filename;
   timespec last_event;
 
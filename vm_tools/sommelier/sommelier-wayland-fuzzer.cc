@@ -35,6 +35,7 @@ class FuzzChannel : public WaylandChannel {
   int32_t init() override { return 0; }
 
   bool supports_dmabuf() override { return false; }
+  bool supports_dmabuf_import(int dmabuf_fd) override { return false; }
 
   int32_t create_context(int& out_channel_fd) override {
     int sv[2];
@@ -3388,6 +3388,8 @@ static void sl_print_usage() {
       "  --glamor\t\t\tUse glamor to accelerate X11 clients\n"
       "  --timing-filename=PATH\tPath to timing output log\n"
       "  --direct-scale\t\tEnable direct scaling mode\n"
+      "  --shm-passthrough\t\tShare shm buffers with the host compositor\n"
+      "\tinstead of copying them, where supported.\n"
 #ifdef PERFETTO_TRACING
       "  --trace-filename=PATH\t\tPath to Perfetto trace filename\n"
       "  --trace-system\t\tPerfetto trace to system daemon\n"
@@ -3852,6 +3854,8 @@ int real_main(int argc, char** argv) {
       ctx.enable_x11_move_windows = true;
     } else if (strstr(arg, "--virtgpu-channel") == arg) {
       ctx.use_virtgpu_channel = true;
+    } else if (strstr(arg, "--shm-passthrough") == arg) {
+      ctx.use_shm_passthrough = true;
     } else if (strstr(arg, "--noop-driver") == arg) {
       noop_driver = true;
     } else if (strstr(arg, "--stable-scaling") == arg) {
@@ -31,6 +31,7 @@ class MockWaylandChannel : public WaylandChannel {
 
   MOCK_METHOD(int32_t, init, (), (override));
   MOCK_METHOD(bool, supports_dmabuf, (), (override));
+  MOCK_METHOD(bool, supports_dmabuf_import, (int dmabuf_fd), (override));
   MOCK_METHOD(int32_t,
               create_context,
               (int& out_socket_fd),
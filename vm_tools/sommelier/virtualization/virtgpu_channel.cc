@@ -206,6 +206,20 @@ bool VirtGpuChannel::supports_dmabuf() {
   return supports_dmabuf_;
 }
 
+bool VirtGpuChannel::supports_dmabuf_import(int dmabuf_fd) {
+  // The guest kernel backs imported dma-bufs with guest blob resources when
+  // it supports it, which send() then shares like any other blob.
+  uint32_t gem_handle;
+  if (drmPrimeFDToHandle(virtgpu_, dmabuf_fd, &gem_handle))
+    return false;
+
+  struct drm_virtgpu_resource_info drm_res_info = {};
+  drm_res_info.bo_handle = gem_handle;
+  int ret = drmIoctl(virtgpu_, DRM_IOCTL_VIRTGPU_RESOURCE_INFO, &drm_res_info);
+  close_gem_handle(gem_handle);
+  return ret == 0 && drm_res_info.res_handle;
+}
+
 int32_t VirtGpuChannel::create_ring(uint32_t& out_handle,
                                     uint32_t& out_res_id,
                                     void*& out_addr) {
@@ -57,6 +57,11 @@ bool VirtWaylandChannel::supports_dmabuf() {
   return supports_dmabuf_;
 }
 
+bool VirtWaylandChannel::supports_dmabuf_import(int dmabuf_fd) {
+  // Only buffers allocated by virtwl can be sent.
+  return false;
+}
+
 int32_t VirtWaylandChannel::create_context(int& out_channel_fd) {
   int ret;
   struct virtwl_ioctl_new new_ctx = {
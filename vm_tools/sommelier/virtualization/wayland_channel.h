@@ -88,6 +88,11 @@ class WaylandChannel {
   // protocol.
   virtual bool supports_dmabuf() = 0;
 
+  // Returns true if `dmabuf_fd`, a dma-buf which was not allocated by the
+  // channel, can be sent to the host.  This lets Sommelier share guest memory
+  // with the host compositor instead of copying it.
+  virtual bool supports_dmabuf_import(int dmabuf_fd) = 0;
+
   // Creates a new context for handling the wayland command stream.  Returns 0
   // on success, and a pollable `out_channel_fd`.  This fd represents the
   // connection to the host compositor, and used for subsequent `send` and
@@ -171,6 +176,7 @@ class VirtWaylandChannel : public WaylandChannel {
 
   int32_t init() override;
   bool supports_dmabuf() override;
+  bool supports_dmabuf_import(int dmabuf_fd) override;
   int32_t create_context(int& out_channel_fd) override;
   int32_t create_pipe(int& out_pipe_fd) override;
   int32_t send(const struct WaylandSendReceive& send) override;
@@ -205,6 +211,7 @@ class VirtGpuChannel : public WaylandChannel {
 
   int32_t init() override;
   bool supports_dmabuf() override;
+  bool supports_dmabuf_import(int dmabuf_fd) override;
   int32_t create_context(int& out_channel_fd) override;
   int32_t create_pipe(int& out_pipe_fd) override;
   int32_t send(const struct WaylandSendReceive& send) override;
@@ -47,7 +47,9 @@ namespace syslog {
 namespace {
 
 // Maximum size the buffer can reach before logs are immediately flushed.
-constexpr size_t kBufferThreshold = 4096;
+// Verbose workloads fill it in bursts, so it is large enough to amortize the
+// cost of a request over many records.
+constexpr size_t kBufferThreshold = 64 * 1024;
 
 // Size of the largest syslog record as defined by RFC3164.
 constexpr size_t kMaxSyslogRecord = 1024;
@@ -133,10 +135,8 @@ bool Collector::StartWatcher(base::TimeDelta flush_period) {
     return false;
   }
 
-  // Start a timer to periodically flush logs.
-  timer_.Start(
-      FROM_HERE, flush_period,
-      base::BindRepeating(&Collector::FlushLogs, weak_factory_.GetWeakPtr()));
+  // The timer is started when the first log record is buffered.
+  flush_period_ = flush_period;
 
   // Start a new log request buffer.
   syslog_request_ = pb::Arena::CreateMessage<vm_tools::LogRequest>(&arena_);
@@ -152,11 +152,20 @@ void Collector::OnSyslogReadable() {
     more = ReadOneSyslogRecord();
 
     // Send all buffered records immediately if we've crossed the threshold.
-    if (buffered_size_ > kBufferThreshold) {
+    if (buffered_size_ > kBufferThreshold)
       FlushLogs();
-      timer_.Reset();
-    }
   }
+
+  if (syslog_request_->records_size() > 0)
+    StartTimer();
+}
+
+void Collector::StartTimer() {
+  if (timer_.IsRunning())
+    return;
+  timer_.Start(
+      FROM_HERE, flush_period_,
+      base::BindOnce(&Collector::FlushLogs, weak_factory_.GetWeakPtr()));
 }
 
 void Collector::FlushLogs() {
@@ -168,11 +177,13 @@ void Collector::FlushLogs() {
   if (syslog_request_->records_size() > 0) {
     if (!SendUserLogs()) {
       // Try again later - maybe logs are being rotated.
+      StartTimer();
       return;
     }
   }
 
   // Reset everything.
+  timer_.Stop();
   arena_.Reset();
   syslog_request_ = pb::Arena::CreateMessage<vm_tools::LogRequest>(&arena_);
   buffered_size_ = 0;
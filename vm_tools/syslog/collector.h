@@ -42,10 +42,10 @@ class Collector {
 
   const LogRequest& syslog_request() const { return *syslog_request_; }
 
-  // Periodic interval for flushing buffered logs.
+  // Longest time logs are buffered before being flushed.
   static constexpr base::TimeDelta kFlushPeriod = base::Milliseconds(5000);
 
-  // Periodic interval for flushing buffered logs during testing.
+  // Longest time logs are buffered before being flushed during testing.
   static constexpr base::TimeDelta kFlushPeriodForTesting =
       base::Milliseconds(500);
 
@@ -63,13 +63,18 @@ class Collector {
   // Size of all the currently buffered log records.
   size_t buffered_size_;
 
-  // Timer used for periodically flushing buffered log records.
-  base::RepeatingTimer timer_;
+  // Timer flushing the buffered log records |flush_period_| after the first
+  // one was buffered.
+  base::OneShotTimer timer_;
+  base::TimeDelta flush_period_;
 
   // Reads one log record from the socket and adds it to |syslog_request_|.
   // Returns true if there may still be more data to read from the socket.
   bool ReadOneSyslogRecord();
 
+  // Starts |timer_| if it is not running already.
+  void StartTimer();
+
   base::WeakPtrFactory<Collector> weak_factory_{this};
 };
 
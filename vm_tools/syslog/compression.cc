@@ -0,0 +1,83 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm_tools/syslog/compression.h"
+
+#include <zstd.h>
+
+#include <string>
+
+#include <base/logging.h>
+
+using std::string;
+
+namespace vm_tools {
+namespace syslog {
+namespace {
+
+// Log records are mostly text and compress well even at the fastest levels,
+// which keep the CPU time of the guest down.
+constexpr int kCompressionLevel = 1;
+
+}  // namespace
+
+bool CompressLogRequest(const vm_tools::LogRequest& request,
+                        vm_tools::LogRequest* compressed) {
+  string serialized;
+  if (!request.SerializeToString(&serialized)) {
+    LOG(ERROR) << "Failed to serialize log request";
+    return false;
+  }
+
+  string* out = compressed->mutable_zstd_records();
+  out->resize(ZSTD_compressBound(serialized.size()));
+  size_t size = ZSTD_compress(out->data(), out->size(), serialized.data(),
+                              serialized.size(), kCompressionLevel);
+  if (ZSTD_isError(size)) {
+    LOG(ERROR) << "Failed to compress log request: "
+               << ZSTD_getErrorName(size);
+    return false;
+  }
+  out->resize(size);
+  return true;
+}
+
+bool DecompressLogRequest(const vm_tools::LogRequest& request,
+                          vm_tools::LogRequest* decompressed) {
+  if (request.zstd_records().empty()) {
+    *decompressed = request;
+    return true;
+  }
+  if (request.records_size() > 0) {
+    LOG(ERROR) << "Log request has both plain and compressed records";
+    return false;
+  }
+
+  const string& in = request.zstd_records();
+  unsigned long long size =  // NOLINT(runtime/int)
+      ZSTD_getFrameContentSize(in.data(), in.size());
+  if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN ||
+      size > kMaxDecompressedRequestSize) {
+    LOG(ERROR) << "Invalid compressed log request size";
+    return false;
+  }
+
+  string serialized(size, '\0');
+  size_t ret = ZSTD_decompress(serialized.data(), serialized.size(),
+                               in.data(), in.size());
+  if (ZSTD_isError(ret) || ret != size) {
+    LOG(ERROR) << "Failed to decompress log request";
+    return false;
+  }
+
+  if (!decompressed->ParseFromString(serialized) ||
+      !decompressed->zstd_records().empty()) {
+    LOG(ERROR) << "Failed to parse decompressed log request";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace syslog
+}  // namespace vm_tools
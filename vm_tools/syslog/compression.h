@@ -0,0 +1,40 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef VM_TOOLS_SYSLOG_COMPRESSION_H_
+#define VM_TOOLS_SYSLOG_COMPRESSION_H_
+
+#include <stddef.h>
+
+#include <vm_protos/proto_bindings/vm_host.grpc.pb.h>
+
+namespace vm_tools {
+namespace syslog {
+
+// gRPC metadata with which the host announces that it accepts LogRequests
+// with |zstd_records|.
+constexpr char kAcceptEncodingMetadata[] = "vm-syslog-accept-encoding";
+constexpr char kZstdEncoding[] = "zstd";
+
+// Requests smaller than this are sent uncompressed.
+constexpr size_t kMinCompressedRequestSize = 1024;
+
+// Largest request accepted once decompressed, to bound the memory used by a
+// misbehaving guest.
+constexpr size_t kMaxDecompressedRequestSize = 16 * 1024 * 1024;
+
+// Stores the records of |request| compressed into |compressed|. Returns false
+// on failure.
+bool CompressLogRequest(const vm_tools::LogRequest& request,
+                        vm_tools::LogRequest* compressed);
+
+// Stores the records of |request| into |decompressed|, decompressing them if
+// they are compressed. Returns false if the request is malformed.
+bool DecompressLogRequest(const vm_tools::LogRequest& request,
+                          vm_tools::LogRequest* decompressed);
+
+}  // namespace syslog
+}  // namespace vm_tools
+
+#endif  // VM_TOOLS_SYSLOG_COMPRESSION_H_
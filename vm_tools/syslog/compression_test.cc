@@ -0,0 +1,69 @@
+// Copyright 2024 The ChromiumOS Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include <google/protobuf/util/message_differencer.h>
+#include <gtest/gtest.h>
+#include <vm_protos/proto_bindings/vm_host.pb.h>
+
+#include "vm_tools/syslog/compression.h"
+
+using google::protobuf::util::MessageDifferencer;
+using std::string;
+
+namespace vm_tools {
+namespace syslog {
+namespace {
+
+vm_tools::LogRequest MakeRequest(int num_records) {
+  vm_tools::LogRequest request;
+  for (int i = 0; i < num_records; ++i) {
+    vm_tools::LogRecord* record = request.add_records();
+    record->set_severity(vm_tools::INFO);
+    record->mutable_timestamp()->set_seconds(1700000000 + i);
+    record->set_content("container[42]: processed request " +
+                        std::to_string(i));
+  }
+  return request;
+}
+
+}  // namespace
+
+TEST(CompressionTest, RoundTrip) {
+  const vm_tools::LogRequest request = MakeRequest(500);
+
+  vm_tools::LogRequest compressed;
+  ASSERT_TRUE(CompressLogRequest(request, &compressed));
+  EXPECT_EQ(compressed.records_size(), 0);
+  EXPECT_LT(compressed.ByteSizeLong(), request.ByteSizeLong() / 4);
+
+  vm_tools::LogRequest decompressed;
+  ASSERT_TRUE(DecompressLogRequest(compressed, &decompressed));
+  EXPECT_TRUE(MessageDifferencer::Equals(request, decompressed));
+}
+
+TEST(CompressionTest, PlainRequestIsCopied) {
+  const vm_tools::LogRequest request = MakeRequest(3);
+
+  vm_tools::LogRequest decompressed;
+  ASSERT_TRUE(DecompressLogRequest(request, &decompressed));
+  EXPECT_TRUE(MessageDifferencer::Equals(request, decompressed));
+}
+
+TEST(CompressionTest, MalformedRequestIsRejected) {
+  vm_tools::LogRequest decompressed;
+
+  vm_tools::LogRequest garbage;
+  garbage.set_zstd_records("not zstd");
+  EXPECT_FALSE(DecompressLogRequest(garbage, &decompressed));
+
+  vm_tools::LogRequest both;
+  ASSERT_TRUE(CompressLogRequest(MakeRequest(3), &both));
+  both.add_records()->set_content("plain");
+  EXPECT_FALSE(DecompressLogRequest(both, &decompressed));
+}
+
+}  // namespace syslog
+}  // namespace vm_tools
@@ -4,20 +4,21 @@
 
 #include "vm_tools/syslog/forwarder.h"
 
+#include <limits.h>
 #include <stdint.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
 
+#include <algorithm>
 #include <array>
 #include <cinttypes>
-#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <base/check.h>
-#include <base/files/file_util.h>
 #include <base/logging.h>
+#include <base/posix/eintr_wrapper.h>
 #include <base/strings/stringprintf.h>
 
 #include "vm_tools/syslog/scrubber.h"
@@ -26,6 +27,42 @@ using std::string;
 
 namespace vm_tools {
 namespace syslog {
+namespace {
+
+struct iovec MakeIovec(const string& str) {
+  return {
+      .iov_base = static_cast<void*>(const_cast<char*>(str.data())),
+      .iov_len = str.size(),
+  };
+}
+
+// Writes all of |iovs| to |fd| with as few writev() calls as possible.
+bool WriteIovecs(int fd, std::vector<struct iovec> iovs) {
+  struct iovec* iov = iovs.data();
+  size_t remaining = iovs.size();
+  while (remaining > 0) {
+    ssize_t written = HANDLE_EINTR(
+        writev(fd, iov, std::min<size_t>(remaining, IOV_MAX)));
+    if (written < 0)
+      return false;
+
+    // Skip what was written, which may end in the middle of an iovec.
+    size_t bytes = written;
+    while (remaining > 0 && bytes >= iov->iov_len) {
+      bytes -= iov->iov_len;
+      ++iov;
+      --remaining;
+    }
+    if (remaining > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + bytes;
+      iov->iov_len -= bytes;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 Forwarder::Forwarder(base::ScopedFD destination, bool is_socket_destination)
     : destination_(std::move(destination)),
       is_socket_destination_(is_socket_destination) {}
@@ -108,15 +145,23 @@ grpc::Status Forwarder::ForwardLogs(int64_t cid,
                           "failed to send log records to syslog daemon");
     }
   } else {
-    // Write messages to file
-    std::ostringstream lines_stream;
+    // Write messages to file, straight from the strings built above.
+    const string space(" ");
+    const string newline("\n");
+    constexpr uint8_t kLineIovCount = 7;
+    std::vector<struct iovec> lines;
+    lines.reserve(request.records_size() * kLineIovCount);
     for (int i = 0; i < request.records_size(); ++i) {
-      lines_stream << timestamps[i] << " " << priorities[i] << " " << prefix
-                   << contents[i] << "\n";
+      lines.push_back(MakeIovec(timestamps[i]));
+      lines.push_back(MakeIovec(space));
+      lines.push_back(MakeIovec(priorities[i]));
+      lines.push_back(MakeIovec(space));
+      lines.push_back(MakeIovec(prefix));
+      lines.push_back(MakeIovec(contents[i]));
+      lines.push_back(MakeIovec(newline));
     }
-    const std::string lines = lines_stream.str();
-    if (!base::WriteFileDescriptor(destination_.get(), lines)) {
-      PLOG(ERROR) << "Failed to write log records to file" << lines;
+    if (!WriteIovecs(destination_.get(), std::move(lines))) {
+      PLOG(ERROR) << "Failed to write log records to file";
       return grpc::Status(grpc::INTERNAL,
                           "failed to write log records to file");
     }
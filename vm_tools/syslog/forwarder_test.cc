@@ -2,12 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stdio.h>
 #include <sys/socket.h>
 #include <time.h>
+#include <unistd.h>
 
 #include <memory>
 #include <string>
 
+#include <base/files/file_util.h>
 #include <base/files/scoped_file.h>
 #include <grpcpp/grpcpp.h>
 #include <gtest/gtest.h>
@@ -137,5 +140,35 @@ TEST(ForwarderTest, EndToEnd) {
   }
 }
 
+TEST(ForwarderTest, FileDestination) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+
+  base::ScopedFD receiver(fds[0]);
+  auto forwarder = std::make_unique<Forwarder>(base::ScopedFD(fds[1]),
+                                               /*is_socket_destination=*/false);
+
+  vm_tools::LogRequest request;
+  string expected;
+  for (int i = 0; i < 1000; ++i) {
+    vm_tools::LogRecord* record = request.add_records();
+    record->set_severity(vm_tools::ERROR);
+    struct tm timestamp = kEndToEndTests[0].tm;
+    record->mutable_timestamp()->set_seconds(mktime(&timestamp));
+    record->set_content("line " + std::to_string(i));
+    expected +=
+        "Jan 17 23:54:11 <11>  VM(0): line " + std::to_string(i) + "\n";
+  }
+
+  ASSERT_TRUE(forwarder->ForwardLogs(0, request).ok());
+  forwarder.reset();
+
+  // All of the records fit in the pipe buffer.
+  base::ScopedFILE file(fdopen(receiver.release(), "r"));
+  string written;
+  ASSERT_TRUE(base::ReadStreamToString(file.get(), &written));
+  EXPECT_EQ(expected, written);
+}
+
 }  // namespace syslog
 }  // namespace vm_tools
@@ -37,6 +37,7 @@
 #include <chromeos/scoped_minijail.h>
 #include <grpcpp/grpcpp.h>
 
+#include "vm_tools/syslog/compression.h"
 #include "vm_tools/syslog/parser.h"
 
 namespace pb = google::protobuf;
@@ -133,8 +134,17 @@ bool GuestCollector::SendUserLogs() {
   vm_tools::EmptyMessage response;
   grpc::Status status;
 
+  // Compress large batches once the host has announced that it accepts them.
+  const vm_tools::LogRequest* request = &syslog_request();
+  vm_tools::LogRequest compressed;
+  if (host_accepts_zstd_ &&
+      request->ByteSizeLong() >= kMinCompressedRequestSize &&
+      CompressLogRequest(*request, &compressed)) {
+    request = &compressed;
+  }
+
   grpc::ClientContext ctx;
-  status = stub_->CollectUserLogs(&ctx, syslog_request(), &response);
+  status = stub_->CollectUserLogs(&ctx, *request, &response);
 
   if (!status.ok()) {
     LOG(ERROR) << "Failed to send user logs to LogCollector service.  Error "
@@ -142,6 +152,10 @@ bool GuestCollector::SendUserLogs() {
                << status.error_message();
     return false;
   }
+
+  const auto& metadata = ctx.GetServerInitialMetadata();
+  auto it = metadata.find(kAcceptEncodingMetadata);
+  host_accepts_zstd_ = it != metadata.end() && it->second == kZstdEncoding;
   return true;
 }
 
@@ -61,6 +61,9 @@ class GuestCollector : public Collector {
   // Connection to the LogCollector service on the host.
   std::unique_ptr<vm_tools::LogCollector::Stub> stub_;
 
+  // Whether the LogCollector service accepts compressed records.
+  bool host_accepts_zstd_ = false;
+
   base::WeakPtrFactory<GuestCollector> weak_factory_;
 };
 
@@ -32,6 +32,7 @@
 #include <vm_protos/proto_bindings/vm_host.grpc.pb.h>
 
 #include "vm_tools/common/naming.h"
+#include "vm_tools/syslog/compression.h"
 #include "vm_tools/syslog/rotator.h"
 
 namespace vm_tools {
@@ -343,10 +344,21 @@ grpc::Status LogPipeManager::CollectUserLogs(grpc::ServerContext* ctx,
                                              EmptyMessage* response) {
   DCHECK(ctx);
   DCHECK(request);
+  // Let the guest compress the following requests.
+  ctx->AddInitialMetadata(kAcceptEncodingMetadata, kZstdEncoding);
+
   // Write these logs immediately, since they were already buffered on the
   // GuestCollector.
   int64_t cid = CidFromCtx(*ctx);
-  return WriteSyslogRecords(cid, *request);
+  if (request->zstd_records().empty())
+    return WriteSyslogRecords(cid, *request);
+
+  LogRequest decompressed;
+  if (!DecompressLogRequest(*request, &decompressed)) {
+    return grpc::Status(grpc::INVALID_ARGUMENT,
+                        "failed to decompress log records");
+  }
+  return WriteSyslogRecords(cid, decompressed);
 }
 
 grpc::Status LogPipeManager::WriteSyslogRecords(int64_t cid,
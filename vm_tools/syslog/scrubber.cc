@@ -8,6 +8,8 @@
 #include <syslog.h>
 #include <time.h>
 
+#include <algorithm>
+
 #include <base/strings/stringprintf.h>
 #include <base/strings/utf_string_conversion_utils.h>
 #include <base/third_party/icu/icu_utf.h>
@@ -83,7 +85,14 @@ string ParseProtoTimestamp(const vm_tools::Timestamp& timestamp) {
 }
 
 string ScrubProtoContent(const string& content) {
+  // Most log lines are printable ASCII, which is left as is.
+  if (std::all_of(content.begin(), content.end(),
+                  [](char c) { return c >= 0x20 && c < 0x7f; })) {
+    return content;
+  }
+
   string result;
+  result.reserve(content.size());
 
   for (size_t idx = 0; idx < content.size(); ++idx) {
     base_icu::UChar32 code_point;
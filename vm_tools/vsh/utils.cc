@@ -10,9 +10,12 @@
 #include <unistd.h>
 
 #include <arpa/inet.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 
+#include <iterator>
+
 #include <base/files/file_util.h>
 #include <base/functional/bind.h>
 #include <base/posix/eintr_wrapper.h>
@@ -24,6 +27,10 @@ namespace vm_tools {
 namespace vsh {
 namespace {
 
+// Layout of the header of raw stream frames.
+constexpr int kFrameStreamShift = 24;
+constexpr uint32_t kFrameSizeMask = (1u << kFrameStreamShift) - 1;
+
 bool SendAllBytes(int sockfd, const uint8_t* buf, uint32_t buf_size) {
   if (!base::WriteFileDescriptor(
           sockfd, base::as_bytes(base::make_span(buf, buf_size)))) {
@@ -100,6 +107,121 @@ bool RecvMessage(int sockfd, MessageLite* message) {
   return true;
 }
 
+bool SendDataFrame(int sockfd, int stream, const char* data, size_t size) {
+  if (stream <= 0 || stream > UINT8_MAX) {
+    LOG(ERROR) << "Invalid stream for data frame: " << stream;
+    return false;
+  }
+  if (size > kMaxRawDataSize) {
+    LOG(ERROR) << "Data frame too large: " << size;
+    return false;
+  }
+
+  const uint32_t header =
+      htole32(static_cast<uint32_t>(stream) << kFrameStreamShift | size);
+  const struct iovec iovs[] = {
+      {
+          .iov_base = const_cast<uint32_t*>(&header),
+          .iov_len = sizeof(header),
+      },
+      {
+          .iov_base = const_cast<char*>(data),
+          .iov_len = size,
+      },
+  };
+  ssize_t ret = HANDLE_EINTR(writev(sockfd, iovs, std::size(iovs)));
+  if (ret < 0) {
+    PLOG(ERROR) << "Failed to write data frame to socket";
+    return false;
+  }
+
+  // Finish a partial write.
+  size_t written = ret;
+  if (written < sizeof(header)) {
+    if (!SendAllBytes(sockfd,
+                      reinterpret_cast<const uint8_t*>(&header) + written,
+                      sizeof(header) - written)) {
+      return false;
+    }
+    written = sizeof(header);
+  }
+  written -= sizeof(header);
+  return SendAllBytes(sockfd, reinterpret_cast<const uint8_t*>(data) + written,
+                      size - written);
+}
+
+bool RecvFrame(int sockfd,
+               int* stream,
+               std::string* data,
+               MessageLite* message) {
+  uint32_t header;
+  if (!base::ReadFromFD(sockfd, reinterpret_cast<char*>(&header),
+                        sizeof(header))) {
+    LOG(ERROR) << "Failed to read frame from socket";
+    return false;
+  }
+  header = le32toh(header);
+  *stream = header >> kFrameStreamShift;
+  const uint32_t size = header & kFrameSizeMask;
+
+  if (*stream != 0) {
+    if (size > kMaxRawDataSize) {
+      LOG(ERROR) << "Data frame size of " << size << " exceeds max size "
+                 << kMaxRawDataSize;
+      return false;
+    }
+    data->resize(size);
+    if (!base::ReadFromFD(sockfd, data->data(), size)) {
+      LOG(ERROR) << "Failed to read data frame from socket";
+      return false;
+    }
+    return true;
+  }
+
+  if (size > kMaxMessageSize) {
+    LOG(ERROR) << "Message size of " << size << " exceeds max message size "
+               << kMaxMessageSize;
+    return false;
+  }
+
+  uint8_t payload[kMaxMessageSize];
+  if (!base::ReadFromFD(sockfd, reinterpret_cast<char*>(payload), size)) {
+    LOG(ERROR) << "Failed to read message from socket";
+    return false;
+  }
+
+  if (!message->ParseFromArray(payload, size)) {
+    LOG(ERROR) << "Failed to parse message";
+    return false;
+  }
+
+  return true;
+}
+
+ssize_t ReadCoalesced(int fd, char* buf, size_t size) {
+  ssize_t count = HANDLE_EINTR(read(fd, buf, size));
+  if (count <= 0) {
+    return count;
+  }
+
+  size_t total = count;
+  while (total < size) {
+    struct pollfd pollfd = {.fd = fd, .events = POLLIN};
+    if (HANDLE_EINTR(poll(&pollfd, 1, 0)) <= 0 ||
+        !(pollfd.revents & POLLIN)) {
+      break;
+    }
+    count = HANDLE_EINTR(read(fd, buf + total, size - total));
+    // EOF and errors are left to the next call.
+    if (count <= 0) {
+      break;
+    }
+    total += count;
+  }
+
+  return total;
+}
+
 // Posts a shutdown task to the main message loop.
 void Shutdown() {
   brillo::MessageLoop::current()->PostTask(FROM_HERE,
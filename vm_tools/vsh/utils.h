@@ -33,6 +33,9 @@ constexpr int kMaxDataSize = 4000;
 // Maximum size allowed for a single protobuf message.
 constexpr int kMaxMessageSize = 4096;
 
+// Maximum amount of data that can be sent in a single raw data frame.
+constexpr int kMaxRawDataSize = 64 * 1024;
+
 // Reserved keyword for connecting to the VM shell instead of a container.
 // All lxd containers must also be valid hostnames, so any string that is
 // not a valid hostname will work here without colliding with lxd's naming.
@@ -44,6 +47,30 @@ bool SendMessage(int sockfd, const google::protobuf::MessageLite& message);
 // Receives a protobuf MessageLite from the given socket fd.
 bool RecvMessage(int sockfd, google::protobuf::MessageLite* message);
 
+// In the raw stream mode negotiated by SetupConnectionRequest.raw_stream, the
+// server sends its output as raw data frames instead of DataMessages. The
+// header of a frame holds the size of its payload in the low 24 bits and, in
+// the high 8 bits, the StdioStream of the data or 0 if the payload is a
+// protobuf message. Frames sent by SendMessage() are therefore message frames.
+
+// Sends |size| bytes of |data| from |stream| as a raw data frame to the given
+// socket fd, without copying them.
+bool SendDataFrame(int sockfd, int stream, const char* data, size_t size);
+
+// Receives a frame of the raw stream mode from the given socket fd. For a data
+// frame, |stream| is set to its StdioStream and the payload is stored in
+// |data|. For a message frame, |stream| is set to 0 and the payload is parsed
+// into |message|.
+bool RecvFrame(int sockfd,
+               int* stream,
+               std::string* data,
+               google::protobuf::MessageLite* message);
+
+// Reads up to |size| bytes from |fd| into |buf|, waiting only for the first
+// ones. Output which arrives while it is being read is coalesced into the same
+// buffer. Returns the result of read() if nothing could be read.
+ssize_t ReadCoalesced(int fd, char* buf, size_t size);
+
 // Posts a task to the main message loop to shut down.
 void Shutdown();
 
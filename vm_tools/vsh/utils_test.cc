@@ -4,7 +4,21 @@
 
 #include "vm_tools/vsh/utils.h"
 
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
 #include <base/files/file_util.h>
+#include <base/files/scoped_file.h>
+#include <base/posix/eintr_wrapper.h>
 #include <gtest/gtest.h>
 #include <vm_protos/proto_bindings/vsh.pb.h>
 
@@ -55,6 +69,179 @@ TEST(VshTest, SendAndRecvHostMessage) {
   EXPECT_EQ(received_data.data(), msg);
 }
 
+TEST(VshTest, SendAndRecvFrames) {
+  constexpr char msg[] = "stderr output";
+  int pipe_fds[2];
+
+  ASSERT_TRUE(base::CreateLocalNonBlockingPipe(pipe_fds));
+  base::ScopedFD fd_read(pipe_fds[0]);
+  base::ScopedFD fd_write(pipe_fds[1]);
+
+  ASSERT_TRUE(SendDataFrame(fd_write.get(), STDERR_STREAM, msg,
+                            sizeof(msg) - 1));
+  ASSERT_TRUE(SendDataFrame(fd_write.get(), STDOUT_STREAM, nullptr, 0));
+  HostMessage sent;
+  sent.mutable_status_message()->set_status(EXITED);
+  ASSERT_TRUE(SendMessage(fd_write.get(), sent));
+
+  int stream;
+  std::string data;
+  HostMessage received;
+  ASSERT_TRUE(RecvFrame(fd_read.get(), &stream, &data, &received));
+  EXPECT_EQ(stream, STDERR_STREAM);
+  EXPECT_EQ(data, msg);
+
+  ASSERT_TRUE(RecvFrame(fd_read.get(), &stream, &data, &received));
+  EXPECT_EQ(stream, STDOUT_STREAM);
+  EXPECT_TRUE(data.empty());
+
+  // Messages are received as message frames.
+  ASSERT_TRUE(RecvFrame(fd_read.get(), &stream, &data, &received));
+  EXPECT_EQ(stream, 0);
+  EXPECT_EQ(received.status_message().status(), EXITED);
+}
+
+TEST(VshTest, SendDataFrameTooLarge) {
+  std::string data(kMaxRawDataSize + 1, 'x');
+  EXPECT_FALSE(SendDataFrame(-1, STDOUT_STREAM, data.data(), data.size()));
+  EXPECT_FALSE(SendDataFrame(-1, 0, data.data(), 1));
+}
+
+TEST(VshTest, ReadCoalesced) {
+  int pipe_fds[2];
+
+  ASSERT_TRUE(base::CreateLocalNonBlockingPipe(pipe_fds));
+  base::ScopedFD fd_read(pipe_fds[0]);
+  base::ScopedFD fd_write(pipe_fds[1]);
+
+  for (const char* chunk : {"abc", "def", "ghi"}) {
+    ASSERT_TRUE(base::WriteFileDescriptor(fd_write.get(), chunk));
+  }
+
+  char buf[16];
+  EXPECT_EQ(4, ReadCoalesced(fd_read.get(), buf, 4));
+  EXPECT_EQ(std::string(buf, 4), "abcd");
+  // The rest is read without waiting for more.
+  EXPECT_EQ(5, ReadCoalesced(fd_read.get(), buf, sizeof(buf)));
+  EXPECT_EQ(std::string(buf, 5), "efghi");
+
+  fd_write.reset();
+  EXPECT_EQ(0, ReadCoalesced(fd_read.get(), buf, sizeof(buf)));
+}
+
+namespace {
+
+// Forwards the output of a program writing lines to a tty, like vshd does with
+// the given framing, and returns the throughput in MiB/s.
+double ForwardTtyOutput(bool raw_stream) {
+  constexpr size_t kTotalSize = 32 * 1024 * 1024;
+  constexpr size_t kLineSize = 128;
+  // Bounds each wait, so that the test fails instead of hanging if one end
+  // stops.
+  constexpr int kTimeoutSeconds = 30;
+
+  base::ScopedFD ptm(HANDLE_EINTR(posix_openpt(O_RDWR | O_NOCTTY)));
+  EXPECT_TRUE(ptm.is_valid());
+  EXPECT_EQ(0, grantpt(ptm.get()));
+  EXPECT_EQ(0, unlockpt(ptm.get()));
+  base::ScopedFD pts(
+      HANDLE_EINTR(open(ptsname(ptm.get()), O_RDWR | O_NOCTTY)));
+  EXPECT_TRUE(pts.is_valid());
+  struct termios termios;
+  EXPECT_EQ(0, tcgetattr(pts.get(), &termios));
+  cfmakeraw(&termios);
+  EXPECT_EQ(0, tcsetattr(pts.get(), TCSANOW, &termios));
+
+  int sock_fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sock_fds));
+  base::ScopedFD server_sock(sock_fds[0]);
+  base::ScopedFD client_sock(sock_fds[1]);
+  const struct timeval timeout = {.tv_sec = kTimeoutSeconds};
+  EXPECT_EQ(0, setsockopt(server_sock.get(), SOL_SOCKET, SO_SNDTIMEO,
+                          &timeout, sizeof(timeout)));
+  EXPECT_EQ(0, setsockopt(client_sock.get(), SOL_SOCKET, SO_RCVTIMEO,
+                          &timeout, sizeof(timeout)));
+
+  const auto start = std::chrono::steady_clock::now();
+  std::thread program([&pts] {
+    const std::string line(kLineSize - 1, 'x');
+    for (size_t written = 0; written < kTotalSize; written += kLineSize) {
+      if (!base::WriteFileDescriptor(pts.get(), line + "\n")) {
+        return;
+      }
+    }
+  });
+  std::thread client([&client_sock, raw_stream] {
+    size_t received = 0;
+    while (received < kTotalSize) {
+      int stream = STDOUT_STREAM;
+      std::string data;
+      HostMessage host_message;
+      bool ok =
+          raw_stream
+              ? RecvFrame(client_sock.get(), &stream, &data, &host_message)
+              : RecvMessage(client_sock.get(), &host_message);
+      if (!ok) {
+        return;
+      }
+      received += raw_stream ? data.size()
+                             : host_message.data_message().data().size();
+    }
+  });
+
+  char buf[kMaxRawDataSize];
+  size_t forwarded = 0;
+  while (forwarded < kTotalSize) {
+    struct pollfd pollfd = {.fd = ptm.get(), .events = POLLIN};
+    if (HANDLE_EINTR(poll(&pollfd, 1, kTimeoutSeconds * 1000)) <= 0) {
+      ADD_FAILURE() << "Timed out waiting for the tty output";
+      break;
+    }
+    ssize_t count =
+        raw_stream ? ReadCoalesced(ptm.get(), buf, kMaxRawDataSize)
+                   : HANDLE_EINTR(read(ptm.get(), buf, kMaxDataSize));
+    if (count <= 0) {
+      ADD_FAILURE() << "Failed to read from the tty";
+      break;
+    }
+    bool sent;
+    if (raw_stream) {
+      sent = SendDataFrame(server_sock.get(), STDOUT_STREAM, buf, count);
+    } else {
+      HostMessage host_message;
+      host_message.mutable_data_message()->set_stream(STDOUT_STREAM);
+      host_message.mutable_data_message()->set_data(buf, count);
+      sent = SendMessage(server_sock.get(), host_message);
+    }
+    if (!sent) {
+      ADD_FAILURE() << "Failed to forward the tty output";
+      break;
+    }
+    forwarded += count;
+  }
+
+  // Closing the tty unblocks the program if it was not fully read.
+  ptm.reset();
+  program.join();
+  server_sock.reset();
+  client.join();
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(forwarded, kTotalSize);
+  return kTotalSize / (1024.0 * 1024.0) / elapsed.count();
+}
+
+}  // namespace
+
+// Records the throughput of the tty output forwarding with both framings in the
+// test report.
+TEST(VshTest, TtyThroughputBenchmark) {
+  RecordProperty("message_throughput_mib_per_s",
+                 static_cast<int>(ForwardTtyOutput(/*raw_stream=*/false)));
+  RecordProperty("raw_throughput_mib_per_s",
+                 static_cast<int>(ForwardTtyOutput(/*raw_stream=*/true)));
+}
+
 TEST(VshTest, WriteKernelLog) {
   std::string msg("log message");
   int pipe_fds[2];
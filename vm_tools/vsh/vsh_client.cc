@@ -88,6 +88,7 @@ VshClient::VshClient(base::ScopedFD sock_fd,
                      base::ScopedFD stderr_fd)
     : sock_fd_(std::move(sock_fd)),
       container_shell_pid_(0),
+      raw_stream_(false),
       stdout_fd_(std::move(stdout_fd)),
       stderr_fd_(std::move(stderr_fd)),
       exit_code_(kDefaultExitCode) {}
@@ -104,6 +105,8 @@ bool VshClient::Init(const std::string& user,
   // 3) If the client receives READY, the server and client may exchange
   //    HostMessage and GuestMessage protobufs, with GuestMessages flowing
   //    from client(host) to server(guest), and vice versa for HostMessages.
+  //    If the response enables the raw stream mode, the server output is sent
+  //    as raw data frames instead of DataMessages.
   // 4) If the client or server receives a message with a new ConnectionStatus
   //    that does not indicate READY, the recepient must exit.
   SetupConnectionRequest connection_request;
@@ -121,6 +124,7 @@ bool VshClient::Init(const std::string& user,
     connection_request.set_cwd(cwd);
   }
   connection_request.set_nopty(!interactive);
+  connection_request.set_raw_stream(true);
 
   auto env = connection_request.mutable_env();
 
@@ -178,6 +182,7 @@ bool VshClient::Init(const std::string& user,
   }
 
   container_shell_pid_ = connection_response.pid();
+  raw_stream_ = connection_response.raw_stream();
 
   sock_watcher_ = base::FileDescriptorWatcher::WatchReadable(
       sock_fd_.get(), base::BindRepeating(&VshClient::HandleVsockReadable,
@@ -262,47 +267,37 @@ bool VshClient::HandleWindowResizeSignal(
 // Receives a host message from the guest and takes action.
 void VshClient::HandleVsockReadable() {
   HostMessage host_message;
-  if (!RecvMessage(sock_fd_.get(), &host_message)) {
-    PLOG(ERROR) << "Failed to receive message from server";
+  if (!raw_stream_) {
+    if (!RecvMessage(sock_fd_.get(), &host_message)) {
+      PLOG(ERROR) << "Failed to receive message from server";
+      Shutdown();
+      return;
+    }
+
+    HandleHostMessage(host_message);
+    return;
+  }
+
+  int stream;
+  std::string data;
+  if (!RecvFrame(sock_fd_.get(), &stream, &data, &host_message)) {
+    PLOG(ERROR) << "Failed to receive frame from server";
     Shutdown();
     return;
   }
 
-  HandleHostMessage(host_message);
+  if (stream) {
+    HandleData(static_cast<StdioStream>(stream), data);
+  } else {
+    HandleHostMessage(host_message);
+  }
 }
 
 void VshClient::HandleHostMessage(const HostMessage& msg) {
   switch (msg.msg_case()) {
     case HostMessage::kDataMessage: {
       // Data messages from the guest should go to stdout/stderr.
-      DataMessage data_message = msg.data_message();
-      int target_fd = -1;
-      switch (data_message.stream()) {
-        case STDOUT_STREAM:
-          target_fd = stdout_fd_.get();
-          break;
-        case STDERR_STREAM:
-          target_fd = stderr_fd_.get();
-          break;
-        default:
-          LOG(ERROR) << "Invalid stream type from guest: "
-                     << data_message.stream();
-          return;
-      }
-
-      if (data_message.data().size() == 0) {
-        // On EOF from guest, close the host-side fd.
-        if (data_message.stream() == STDOUT_STREAM) {
-          stdout_fd_.reset();
-        } else {
-          stderr_fd_.reset();
-        }
-      }
-
-      if (!base::WriteFileDescriptor(target_fd, data_message.data())) {
-        PLOG(ERROR) << "Failed to write data to fd " << target_fd;
-        return;
-      }
+      HandleData(msg.data_message().stream(), msg.data_message().data());
       break;
     }
     case HostMessage::kStatusMessage: {
@@ -326,6 +321,36 @@ void VshClient::HandleHostMessage(const HostMessage& msg) {
   }
 }
 
+// Writes output from the guest to stdout/stderr.
+void VshClient::HandleData(StdioStream stream, const std::string& data) {
+  int target_fd = -1;
+  switch (stream) {
+    case STDOUT_STREAM:
+      target_fd = stdout_fd_.get();
+      break;
+    case STDERR_STREAM:
+      target_fd = stderr_fd_.get();
+      break;
+    default:
+      LOG(ERROR) << "Invalid stream type from guest: " << stream;
+      return;
+  }
+
+  if (data.size() == 0) {
+    // On EOF from guest, close the host-side fd.
+    if (stream == STDOUT_STREAM) {
+      stdout_fd_.reset();
+    } else {
+      stderr_fd_.reset();
+    }
+  }
+
+  if (!base::WriteFileDescriptor(target_fd, data)) {
+    PLOG(ERROR) << "Failed to write data to fd " << target_fd;
+    return;
+  }
+}
+
 // Forwards input from the host to the remote pseudoterminal.
 void VshClient::HandleStdinReadable() {
   uint8_t buf[kMaxDataSize];
@@ -60,6 +60,7 @@ class VshClient {
   bool HandleWindowResizeSignal(const struct signalfd_siginfo& siginfo);
   void HandleVsockReadable();
   void HandleHostMessage(const HostMessage& msg);
+  void HandleData(StdioStream stream, const std::string& data);
   void HandleStdinReadable();
   bool SendCurrentWindowSize();
   bool GetCurrentWindowSize(struct winsize* ws);
@@ -67,6 +68,8 @@ class VshClient {
 
   base::ScopedFD sock_fd_;
   int32_t container_shell_pid_;
+  // Whether the server sends its output as raw data frames.
+  bool raw_stream_;
   std::unique_ptr<base::FileDescriptorWatcher::Controller> sock_watcher_;
   std::unique_ptr<base::FileDescriptorWatcher::Controller> stdin_watcher_;
 
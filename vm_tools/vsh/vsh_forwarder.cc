@@ -77,6 +77,7 @@ VshForwarder::VshForwarder(base::ScopedFD sock_fd,
     : sock_fd_(std::move(sock_fd)),
       inherit_env_(inherit_env),
       interactive_(true),
+      raw_stream_(false),
       exit_pending_(false),
       default_user_(std::move(default_user)),
       allow_to_switch_user_(allow_to_switch_user) {}
@@ -171,6 +172,7 @@ bool VshForwarder::Init() {
   }
 
   interactive_ = !connection_request.nopty();
+  raw_stream_ = connection_request.raw_stream();
   int stdin_pipe[2];
   int stdout_pipe[2];
   int stderr_pipe[2];
@@ -314,6 +316,7 @@ bool VshForwarder::SendConnectionResponse(ConnectionStatus status,
   connection_response.set_description(description);
   if (status == READY) {
     connection_response.set_pid(target_pid_);
+    connection_response.set_raw_stream(raw_stream_);
   }
 
   if (!SendMessage(sock_fd_.get(), connection_response)) {
@@ -615,11 +618,9 @@ void VshForwarder::HandleVsockReadable() {
 
 // Forwards output from the guest to the host.
 void VshForwarder::HandleTargetReadable(int fd, StdioStream stream_type) {
-  char buf[kMaxDataSize];
-  HostMessage host_message;
-  DataMessage* data_message = host_message.mutable_data_message();
-
-  ssize_t count = HANDLE_EINTR(read(fd, buf, sizeof(buf)));
+  char buf[kMaxRawDataSize];
+  ssize_t count =
+      ReadCoalesced(fd, buf, raw_stream_ ? kMaxRawDataSize : kMaxDataSize);
 
   if (count < 0) {
     // It's likely that we'll get an EIO before getting a SIGCHLD, so don't
@@ -650,10 +651,18 @@ void VshForwarder::HandleTargetReadable(int fd, StdioStream stream_type) {
     }
   }
 
-  data_message->set_stream(stream_type);
-  data_message->set_data(buf, count);
+  bool sent;
+  if (raw_stream_) {
+    sent = SendDataFrame(sock_fd_.get(), stream_type, buf, count);
+  } else {
+    HostMessage host_message;
+    DataMessage* data_message = host_message.mutable_data_message();
+    data_message->set_stream(stream_type);
+    data_message->set_data(buf, count);
+    sent = SendMessage(sock_fd_.get(), host_message);
+  }
 
-  if (!SendMessage(sock_fd_.get(), host_message)) {
+  if (!sent) {
     LOG(ERROR) << "Failed to forward stdio to host";
     Shutdown();
   }
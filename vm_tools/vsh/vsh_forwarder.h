@@ -64,6 +64,8 @@ class VshForwarder {
   base::ScopedFD sock_fd_;
   bool inherit_env_;
   bool interactive_;
+  // Whether the output is sent as raw data frames.
+  bool raw_stream_;
 
   brillo::AsynchronousSignalHandler signal_handler_;
 